@@ -85,6 +85,9 @@
     defined(__OpenBSD__) || defined(__NetBSD__) || defined(__APPLE__)
 #  define HAVE_WAIT4    1
 #endif
+#if defined(__linux__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#  define HAVE_VFORK    1
+#endif
 
 #if defined(__APPLE__)
 /* Up until OS X 10.7, waitid(P_ALL, ...) will return success, but will not
@@ -718,6 +721,66 @@ err_free:
     return -1;
 }
 
+#ifdef HAVE_VFORK
+static int vforkfd_fallback(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
+{
+    Header *header;
+    ProcessInfo *info;
+    struct pipe_payload payload;
+    pid_t pid;
+    int death_pipe[2];
+    int ret;
+
+    (void) pthread_once(&forkfd_initialization, forkfd_initialize);
+
+    info = allocateInfo(&header);
+    if (info == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /* create the pipe before we fork */
+    if (create_pipe(death_pipe, flags) == -1)
+        goto err_free; /* failed to create the pipes, pass errno */
+
+    /*
+     * Unlike forkfd_fork_fallback(), we can't hold the child until we've
+     * stored its PID: we're suspended until it calls execve(2) or _exit(2).
+     * If it exits quickly, the SIGCHLD handler may not find it, so we check
+     * whether it has already exited after storing the PID, like spawnfd()
+     * does.
+     */
+    pid = vfork();
+    if (pid == 0) {
+        /* this is the child process; it shares our memory, so don't touch any */
+        close(death_pipe[0]);
+        close(death_pipe[1]);
+        _exit(childFn(token));
+    }
+    if (pid == -1)
+        goto err_close; /* failed to fork, pass errno */
+    if (ppid)
+        *ppid = pid;
+
+    info->deathPipe = death_pipe[1];
+    ffd_atomic_store(&info->pid, pid, FFD_ATOMIC_RELEASE);
+
+    /* check if the child has already exited */
+    if (tryReaping(pid, &payload))
+        notifyAndFreeInfo(header, info, &payload);
+
+    return death_pipe[0];
+
+err_close:
+    EINTR_LOOP(ret, close(death_pipe[0]));
+    EINTR_LOOP(ret, close(death_pipe[1]));
+err_free:
+    /* free the info pointer */
+    freeInfo(header, info);
+    return -1;
+}
+#endif
+
 /**
  * @brief forkfd returns a file descriptor representing a child process
  * @return a file descriptor, or -1 in case of failure
@@ -797,8 +860,10 @@ int forkfd(int flags, pid_t *ppid)
  * documentation, including that of actually using fork(2) and no other
  * implementation.
  *
- * Currently, only on Linux will this function have any behavior different from
- * forkfd(). In all other systems, it is equivalent to the following code:
+ * On Linux, OpenBSD and NetBSD, this function uses vfork(2) (or clone(2) with
+ * CLONE_VFORK) instead of fork(2) unless @c FFD_USE_FORK is passed, which
+ * avoids copying the parent's page tables. In all other systems, it is
+ * equivalent to the following code:
  *
  * @code
  *     int ffd = forkfd(flags, &pid);
@@ -814,6 +879,9 @@ int vforkfd(int flags, pid_t *ppid, int (*childFn)(void *), void *token)
         fd = system_vforkfd(flags, ppid, childFn, token, &system_forkfd_works);
         if (system_forkfd_works || disable_fork_fallback())
             return fd;
+#ifdef HAVE_VFORK
+        return vforkfd_fallback(flags, ppid, childFn, token);
+#endif
     }
 
     fd = forkfd_fork_fallback(flags, ppid);
@@ -13,6 +13,7 @@
 #include <QtConcurrent/qtconcurrentthreadengine.h>
 
 #include <iterator>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -220,6 +221,7 @@ public:
     {
         BlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, iterationCount);
         ResultReporter<T> resultReporter = createResultsReporter();
+        int slice = -1;
 
         for(;;) {
             if (this->isCanceled())
@@ -231,10 +233,8 @@ public:
                 break;
 
             // Atomically reserve a block of iterationCount for this thread.
-            const int beginIndex = currentIndex.fetchAndAddRelease(currentBlockSize);
-            const int endIndex = qMin(beginIndex + currentBlockSize, iterationCount);
-
-            if (beginIndex >= endIndex) {
+            int beginIndex, endIndex;
+            if (!reserveBlock(currentBlockSize, slice, beginIndex, endIndex)) {
                 // No more work
                 break;
             }
@@ -303,7 +303,53 @@ public:
         return ThreadFinished;
     }
 
+protected:
+    // Splits a for-iteration into one contiguous slice of iterations per
+    // pool thread. Each thread works through a slice of its own from front
+    // to back, so it keeps touching the same part of the sequence, and then
+    // helps with the slices of the others. Only subclasses that don't need
+    // results in order should call this from their constructor.
+    void partitionIterations()
+    {
+        if (!forIteration || iterationCount <= 0)
+            return;
+        sliceCount = qBound(1, ThreadEngineBase::threadPool->maxThreadCount(), iterationCount);
+        slices.reset(new Slice[sliceCount]);
+        for (int i = 0; i < sliceCount; ++i) {
+            slices[i].next.storeRelaxed(int(qint64(iterationCount) * i / sliceCount));
+            slices[i].end = int(qint64(iterationCount) * (i + 1) / sliceCount);
+        }
+    }
+
 private:
+    // Reserves the next block of at most blockSize iterations for the
+    // calling thread, whose slice is kept in slice; returns false if there
+    // are none left.
+    bool reserveBlock(int blockSize, int &slice, int &beginIndex, int &endIndex)
+    {
+        if (!slices) {
+            beginIndex = currentIndex.fetchAndAddRelease(blockSize);
+            endIndex = qMin(beginIndex + blockSize, iterationCount);
+            return beginIndex < endIndex;
+        }
+
+        if (slice < 0)
+            slice = nextSlice.fetchAndAddRelaxed(1) % sliceCount;
+        for (int i = 0; i < sliceCount; ++i) {
+            Slice &s = slices[(slice + i) % sliceCount];
+            if (s.next.loadRelaxed() >= s.end)
+                continue;
+            beginIndex = s.next.fetchAndAddRelaxed(blockSize);
+            endIndex = qMin(beginIndex + blockSize, s.end);
+            if (beginIndex < endIndex) {
+                // currentIndex counts the reserved iterations for shouldStartThread()
+                currentIndex.fetchAndAddRelease(endIndex - beginIndex);
+                return true;
+            }
+        }
+        return false;
+    }
+
     ResultReporter<T> createResultsReporter()
     {
         if constexpr (!std::is_same_v<T, void>)
@@ -323,6 +369,16 @@ public:
     const bool forIteration;
     bool progressReportingEnabled;
     DefaultValueContainer<ResultType> defaultValue;
+
+private:
+    struct alignas(64) Slice
+    {
+        QAtomicInt next;
+        int end;
+    };
+    std::unique_ptr<Slice[]> slices;
+    int sliceCount = 0;
+    QAtomicInt nextSlice;
 };
 
 } // namespace QtConcurrent
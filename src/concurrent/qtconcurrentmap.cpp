@@ -101,8 +101,14 @@
     \value OrderedReduce Reduction is done in the order of the
     original sequence.
     \value SequentialReduce Reduction is done sequentially: only one
-    thread will enter the reduce function at a time. (Parallel reduction
-    might be supported in a future version of Qt Concurrent.)
+    thread will enter the reduce function at a time.
+    \value [since 6.7] ParallelReduce Reduction is done in parallel and in
+    an arbitrary order: each thread reduces results into its own partial
+    result, which starts out default-constructed, and the partial results
+    are passed to the reduce function in place of an intermediate result
+    at the end. This requires the reduce function to be associative and to
+    accept a partial result as its second argument; if it doesn't,
+    UnorderedReduce is used instead.
 */
 
 /*!
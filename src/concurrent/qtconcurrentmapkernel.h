@@ -27,7 +27,11 @@ public:
     template <typename F = MapFunctor>
     MapKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&_map)
         : IterateKernel<Iterator, void>(pool, begin, end), map(std::forward<F>(_map))
-    { }
+    {
+        // in-place maps are often bound by memory bandwidth, and have no
+        // results to deliver in order
+        this->partitionIterations();
+    }
 
     bool runIteration(Iterator it, int, void *) override
     {
@@ -16,6 +16,7 @@
 #include <QtCore/qthreadpool.h>
 
 #include <mutex>
+#include <type_traits>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,8 +67,8 @@ public:
 enum ReduceOption {
     UnorderedReduce = 0x1,
     OrderedReduce = 0x2,
-    SequentialReduce = 0x4
-    // ParallelReduce = 0x8
+    SequentialReduce = 0x4,
+    ParallelReduce = 0x8
 };
 Q_DECLARE_FLAGS(ReduceOptions, ReduceOption)
 #ifndef Q_QDOC
@@ -86,6 +87,14 @@ class ReduceKernel
     const int threadCount;
     ResultsMap resultsMap;
 
+    // ParallelReduce needs a reduce function that can also combine two
+    // partial results; without one, it falls back to UnorderedReduce.
+    static constexpr bool canReduceInParallel =
+            std::is_default_constructible_v<ReduceResultType>
+            && std::is_invocable_v<ReduceFunctor &, ReduceResultType &, const ReduceResultType &>;
+    // partial results that are not being reduced into by a thread
+    QList<ReduceResultType> partialResults;
+
     bool canReduce(int begin) const
     {
         return (((reduceOptions & UnorderedReduce)
@@ -116,7 +125,9 @@ class ReduceKernel
 
 public:
     ReduceKernel(QThreadPool *pool, ReduceOptions _reduceOptions)
-        : reduceOptions(_reduceOptions), progress(0), resultsMapSize(0),
+        : reduceOptions(canReduceInParallel || !(_reduceOptions & ParallelReduce)
+                        ? _reduceOptions : ReduceOptions(UnorderedReduce)),
+          progress(0), resultsMapSize(0),
           threadCount(pool->maxThreadCount())
     { }
 
@@ -125,6 +136,19 @@ public:
                    const IntermediateResults<T> &result)
     {
         std::unique_lock<QMutex> locker(mutex);
+        if constexpr (canReduceInParallel) {
+            if (reduceOptions & ParallelReduce) {
+                // only hold the lock to pick a partial result to reduce into
+                ReduceResultType partial =
+                        partialResults.isEmpty() ? ReduceResultType() : partialResults.takeLast();
+                locker.unlock();
+                reduceResult(reduce, partial, result);
+                locker.lock();
+                partialResults.append(std::move(partial));
+                return;
+            }
+        }
+
         if (!canReduce(result.begin)) {
             ++resultsMapSize;
             resultsMap.insert(result.begin, result);
@@ -182,6 +206,11 @@ public:
     // final reduction
     void finish(ReduceFunctor &reduce, ReduceResultType &r)
     {
+        if constexpr (canReduceInParallel) {
+            for (const ReduceResultType &partial : std::as_const(partialResults))
+                std::invoke(reduce, r, partial);
+            partialResults.clear();
+        }
         reduceResults(reduce, r, resultsMap);
     }
 
@@ -26,3 +26,14 @@ void printError(const char* msg)
 //! [4]
 CONFIG += console
 //! [4]
+
+
+//! [5]
+QFile file("catalog.json");
+if (file.open(QIODevice::ReadOnly | QIODevice::MemoryMapped)) {
+    // doc references the mapped file contents, it is not copied
+    const QByteArray doc = file.readAll();
+    const QJsonDocument json = QJsonDocument::fromJson(doc);
+    file.close(); // doc must not be used after this
+}
+//! [5]
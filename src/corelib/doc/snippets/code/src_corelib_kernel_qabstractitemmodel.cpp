@@ -129,3 +129,20 @@ QVariant MyModel::data(const QModelIndex &index, int role) const
     return roleData.data();
 }
 //! [16]
+
+//! [17]
+// the display and decoration roles of the first 50 rows of a two-column table
+const int rows = 50;
+const int columns = 2;
+std::vector<QModelRoleData> roleData;
+roleData.reserve(rows * columns * 2);
+for (int item = 0; item < rows * columns; ++item) {
+    roleData.emplace_back(Qt::DisplayRole);
+    roleData.emplace_back(Qt::DecorationRole);
+}
+
+model->multiDataForRange(model->index(0, 0), model->index(rows - 1, columns - 1), roleData);
+
+// roleData[0] and roleData[1] now hold the data of row 0, column 0,
+// roleData[2] and roleData[3] the data of row 0, column 1, and so on
+//! [17]
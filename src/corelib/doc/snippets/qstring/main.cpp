@@ -223,6 +223,16 @@ void Widget::argFunction()
     //! [11-qstringview]
     }
 
+    {
+    //! [format]
+    int i;                // current file's number
+    int total;            // number of files to process
+    QByteArray fileName;  // current file's name, in UTF-8
+
+    QString status = QString::format(u"Processing file %1 of %2: %3", i, total, fileName);
+    //! [format]
+    }
+
     //! [12] //! [13]
     QString str;
     //! [12]
@@ -25,6 +25,10 @@
 #include "private/qcoreapplication_p.h"
 #include "private/qsimd_p.h"
 #include <qtcore_tracepoints_p.h>
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(cborstreamwriter)
+#  include "qcborstreamwriter.h"
+#  define QLOGGING_HAVE_CBOR
+#endif
 #endif
 #ifdef Q_OS_WIN
 #include <qt_windows.h>
@@ -123,6 +127,13 @@ static QT_PREPEND_NAMESPACE(qint64) qt_gettid()
 #include <memory>
 #include <vector>
 
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(thread) && defined(Q_OS_UNIX)
+#  include <condition_variable>
+#  include <mutex>
+#  include <thread>
+#  define QLOGGING_HAVE_ASYNC_STDERR
+#endif
+
 #include <stdio.h>
 
 QT_BEGIN_NAMESPACE
@@ -1912,8 +1923,192 @@ static bool wasm_default_message_handler(QtMsgType type,
 
 // --------------------------------------------------------------------------
 
+#ifdef QLOGGING_HAVE_ASYNC_STDERR
+namespace {
+// Writes formatted messages to stderr from a background thread, so that
+// threads logging a lot do not serialize on (possibly blocking) writes to a
+// terminal or pipe. Messages are still formatted on the calling thread, as
+// the pattern may refer to the thread, the time or the backtrace.
+//
+// Enabled by setting QT_LOGGING_ASYNC to "block" (or 1), which makes loggers
+// wait when too much output is pending, or to "drop", which discards their
+// messages instead and reports how many were lost.
+class AsyncStderrWriter
+{
+public:
+    enum Policy { Block, Drop };
+
+    explicit AsyncStderrWriter(Policy policy)
+        : policy(policy), owner(getpid()), thread([this] { run(); })
+    {
+        thread.detach();
+    }
+
+    static AsyncStderrWriter *instance()
+    {
+        // intentionally leaked: messages may be logged until the very end
+        static AsyncStderrWriter *writer = []() -> AsyncStderrWriter * {
+            const QByteArray value = qgetenv("QT_LOGGING_ASYNC");
+            if (value.isEmpty() || value == "0")
+                return nullptr;
+            atexit([] { writer->flush(); });
+            return new AsyncStderrWriter(value == "drop" ? Drop : Block);
+        }();
+        return writer;
+    }
+
+    void write(QByteArray &&line)
+    {
+        if (getpid() != owner) {
+            // forked child: the writer thread does not exist here
+            fwrite(line.constData(), 1, line.size(), stderr);
+            fflush(stderr);
+            return;
+        }
+
+        std::unique_lock lock(mutex);
+        if (!queue.empty() && queuedBytes + line.size() > MaxQueuedBytes) {
+            if (policy == Drop) {
+                ++dropped;
+                return;
+            }
+            progress.wait(lock, [&] {
+                return queue.empty() || queuedBytes + line.size() <= MaxQueuedBytes;
+            });
+        }
+        queuedBytes += line.size();
+        queue.push_back(std::move(line));
+        ++queuedCount;
+        if (queue.size() == 1)
+            hasWork.notify_one();
+    }
+
+    // Waits until everything logged so far has been written.
+    void flush()
+    {
+        if (getpid() != owner)
+            return;
+        std::unique_lock lock(mutex);
+        const quint64 target = queuedCount;
+        progress.wait(lock, [&] { return writtenCount >= target; });
+    }
+
+private:
+    static constexpr qsizetype MaxQueuedBytes = 1024 * 1024;
+
+    void run()
+    {
+        std::vector<QByteArray> batch;
+        std::unique_lock lock(mutex);
+        for (;;) {
+            hasWork.wait(lock, [&] { return !queue.empty(); });
+            batch.swap(queue);
+            const quint64 batchEnd = queuedCount;
+            const quint64 lost = std::exchange(dropped, 0);
+            queuedBytes = 0;
+            progress.notify_all();
+            lock.unlock();
+
+            for (const QByteArray &line : std::as_const(batch))
+                fwrite(line.constData(), 1, line.size(), stderr);
+            if (lost)
+                fprintf(stderr, "(%llu log messages dropped)\n", qulonglong(lost));
+            fflush(stderr);
+            batch.clear();
+
+            lock.lock();
+            writtenCount = batchEnd;
+            progress.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable hasWork;
+    std::condition_variable progress;   // queue drained or batch written
+    std::vector<QByteArray> queue;
+    qsizetype queuedBytes = 0;
+    quint64 queuedCount = 0;
+    quint64 writtenCount = 0;
+    quint64 dropped = 0;
+    const Policy policy;
+    const pid_t owner;
+    std::thread thread;
+};
+} // unnamed namespace
+#endif // QLOGGING_HAVE_ASYNC_STDERR
+
+static void writeToStderr(QByteArray &&data)
+{
+#ifdef QLOGGING_HAVE_ASYNC_STDERR
+    if (AsyncStderrWriter *writer = AsyncStderrWriter::instance()) {
+        writer->write(std::move(data));
+        return;
+    }
+#endif
+
+    fwrite(data.constData(), 1, data.size(), stderr);
+    fflush(stderr);
+}
+
+#ifdef QLOGGING_HAVE_CBOR
+static bool cborOutputRequested()
+{
+    static const bool cbor = qgetenv("QT_LOGGING_FORMAT") == "cbor";
+    return cbor;
+}
+
+/*!
+    \internal
+
+    Encodes the message as one CBOR map, for tools that collect the log
+    output and would otherwise have to parse the formatted text.
+*/
+static QByteArray cborLogRecord(QtMsgType type, const QMessageLogContext &context,
+                                const QString &message)
+{
+    static constexpr const char *typeNames[] = {
+        "debug", "warning", "critical", "fatal", "info"
+    };
+    static_assert(QtDebugMsg == 0 && QtWarningMsg == 1 && QtCriticalMsg == 2
+                  && QtFatalMsg == 3 && QtInfoMsg == 4);
+
+    QByteArray record;
+    QCborStreamWriter writer(&record);
+    writer.startMap();
+    writer.append("time"_L1);
+    writer.append(QDateTime::currentMSecsSinceEpoch());
+    writer.append("type"_L1);
+    writer.append(QLatin1StringView(typeNames[type]));
+    writer.append("category"_L1);
+    writer.append(QLatin1StringView(context.category ? context.category : "default"));
+    writer.append("thread"_L1);
+    writer.append(qint64(qt_gettid()));
+    if (context.file) {
+        writer.append("file"_L1);
+        writer.append(QLatin1StringView(context.file));
+        writer.append("line"_L1);
+        writer.append(qint64(context.line));
+    }
+    if (context.function) {
+        writer.append("function"_L1);
+        writer.append(QLatin1StringView(qCleanupFuncinfo(context.function)));
+    }
+    writer.append("message"_L1);
+    writer.append(message);
+    writer.endMap();
+    return record;
+}
+#endif // QLOGGING_HAVE_CBOR
+
 static void stderr_message_handler(QtMsgType type, const QMessageLogContext &context, const QString &message)
 {
+#ifdef QLOGGING_HAVE_CBOR
+    if (cborOutputRequested()) {
+        writeToStderr(cborLogRecord(type, context, message));
+        return;
+    }
+#endif
+
     QString formattedMessage = qFormatLogMessage(type, context, message);
 
     // print nothing if message pattern didn't apply / was empty.
@@ -1921,8 +2116,9 @@ static void stderr_message_handler(QtMsgType type, const QMessageLogContext &con
     if (formattedMessage.isNull())
         return;
 
-    fprintf(stderr, "%s\n", formattedMessage.toLocal8Bit().constData());
-    fflush(stderr);
+    QByteArray line = std::move(formattedMessage).toLocal8Bit();
+    line += '\n';
+    writeToStderr(std::move(line));
 }
 
 /*!
@@ -2023,6 +2219,12 @@ static void qt_message_print(const QString &message)
 
 static void qt_message_fatal(QtMsgType, const QMessageLogContext &context, const QString &message)
 {
+#ifdef QLOGGING_HAVE_ASYNC_STDERR
+    // make sure the message (and what came before it) is out before we abort
+    if (AsyncStderrWriter *writer = AsyncStderrWriter::instance())
+        writer->flush();
+#endif
+
 #if defined(Q_CC_MSVC_ONLY) && defined(QT_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
     wchar_t contextFileL[256];
     // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
@@ -2124,6 +2326,21 @@ void qErrnoWarning(int code, const char *msg, ...)
     application aborts immediately after handling that message. Custom
     message handlers should not attempt to exit an application on their own.
 
+    On Unix systems, setting the \c QT_LOGGING_ASYNC environment variable to
+    \c block or \c drop makes the default message handler hand messages
+    destined for stderr over to a background thread, instead of writing them
+    on the thread that logged them. When too much output is pending, \c block
+    makes the logging threads wait, while \c drop discards their messages
+    and reports how many were lost. Pending output is flushed before the
+    application exits or aborts on a fatal message.
+
+    If the \c QT_LOGGING_FORMAT environment variable is set to \c cbor, the
+    default message handler writes each message to stderr as a
+    \l{RFC 7049}{CBOR} map instead of formatting it with the message pattern.
+    The map contains the \c time (in milliseconds since the epoch), \c type,
+    \c category, \c thread and \c message keys, as well as \c file,
+    \c line and \c function if that information is available.
+
     Only one message handler can be defined, since this is usually
     done on an application-wide basis to control debug output.
 
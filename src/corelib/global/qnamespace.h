@@ -1282,6 +1282,8 @@ namespace Qt {
         BlockingQueuedConnection,
         UniqueConnection =  0x80,
         SingleShotConnection = 0x100,
+        BatchedConnection = 0x200,
+        CoalescedConnection = 0x400,
     };
 
     enum ShortcutContext {
@@ -10,6 +10,7 @@
 #include <qendian.h>
 #include <qmutex.h>
 #include <qobjectdefs.h>
+#include <qtenvironmentvariables.h>
 
 #include <errno.h>
 
@@ -375,6 +376,31 @@ struct QRandomGenerator::SystemAndGlobalGenerators
         new (&rng->storage.engine()) RandomEngine(self()->sys);
     }
 
+    static bool perThreadGlobal()
+    {
+        // see the documentation of global()
+        static const bool enabled = qEnvironmentVariableIsSet("QT_RANDOMGENERATOR_PER_THREAD");
+        return enabled;
+    }
+
+    static RandomEngine &threadEngine()
+    {
+        // Constant-initialized, so that accessing it needs no guard; the
+        // engine itself is only seeded on first use.
+        struct PerThread {
+            bool seeded;
+            alignas(RandomEngine) uchar data[sizeof(RandomEngine)];
+        };
+        static thread_local PerThread perThread = {};
+
+        auto engine = reinterpret_cast<RandomEngine *>(perThread.data);
+        if (Q_UNLIKELY(!perThread.seeded)) {
+            new (engine) RandomEngine(self()->sys);
+            perThread.seeded = true;
+        }
+        return *engine;
+    }
+
     struct PRNGLocker
     {
         const bool locked;
@@ -535,6 +561,11 @@ inline QRandomGenerator::SystemGenerator &QRandomGenerator::SystemGenerator::sel
     by any thread without external locking. Note that thread-safety does not
     extend to copying those objects: they should always be used by reference.
 
+    Accessing global() from many threads at the same time makes them wait for
+    each other. Applications that do so a lot, and that don't need the
+    sequence of global() to be reproducible, can set the
+    \c QT_RANDOMGENERATOR_PER_THREAD environment variable, see global().
+
     \section1 Standard C++ Library compatibility
 
     QRandomGenerator is modeled after the requirements for random number
@@ -1039,6 +1070,13 @@ inline QRandomGenerator::SystemGenerator &QRandomGenerator::SystemGenerator::sel
     Note, however, that if there are other threads accessing the global object,
     those threads may obtain samples at unpredictable intervals.
 
+    Since Qt 6.7, if the \c QT_RANDOMGENERATOR_PER_THREAD environment variable
+    is set when the object is first used, each thread instead draws from a
+    generator of its own, seeded with system() the first time the thread uses
+    the object. Threads then never wait for each other, but copies of the
+    object, and comparisons with it, no longer reflect the values it
+    produces.
+
     \sa securelySeeded(), system()
 */
 
@@ -1212,6 +1250,12 @@ void QRandomGenerator::discard(unsigned long long z)
     if (Q_UNLIKELY(type == SystemRNG))
         return;
 
+    if (this == SystemAndGlobalGenerators::globalNoInit()
+            && SystemAndGlobalGenerators::perThreadGlobal()) {
+        SystemAndGlobalGenerators::threadEngine().discard(z);
+        return;
+    }
+
     SystemAndGlobalGenerators::PRNGLocker lock(this);
     storage.engine().discard(z);
 }
@@ -1250,6 +1294,10 @@ quint64 QRandomGenerator::_fillRange(void *buffer, qptrdiff count)
 
     if (type == SystemRNG || Q_UNLIKELY(uint(qt_randomdevice_control.loadAcquire()) & (UseSystemRNG|SetRandomData))) {
         SystemGenerator::self().generate(begin, end);
+    } else if (this == SystemAndGlobalGenerators::globalNoInit()
+               && SystemAndGlobalGenerators::perThreadGlobal()) {
+        RandomEngine &engine = SystemAndGlobalGenerators::threadEngine();
+        std::generate(begin, end, [&engine]() { return engine(); });
     } else {
         SystemAndGlobalGenerators::PRNGLocker lock(this);
         std::generate(begin, end, [this]() { return storage.engine()(); });
@@ -1260,6 +1308,60 @@ quint64 QRandomGenerator::_fillRange(void *buffer, qptrdiff count)
     return begin[0] | (quint64(begin[1]) << 32);
 }
 
+/*!
+    \since 6.7
+
+    Fills the range from \a begin to \a end with random doubles in the
+    canonical range [0, 1), the same values that as many calls to
+    generateDouble() would return. This draws all the random bits from the
+    generator at once, which, for global(), means taking its lock only once,
+    and converts them in a loop that the compiler can vectorize.
+
+    \sa generateDouble(), fillRange()
+ */
+void QRandomGenerator::generateDouble(double *begin, double *end)
+{
+    static_assert(sizeof(double) == 2 * sizeof(quint32));
+    Q_ASSERT(begin <= end);
+    if (begin == end)
+        return;
+
+    // Generate the bits in place; each double is made like generateDouble()
+    // makes it from generate64(), that is from two 32-bit values with the
+    // first one as the low half.
+    _fillRange(begin, 2 * (end - begin));
+    const quint64 limit = Q_UINT64_C(1) << std::numeric_limits<double>::digits;
+    for (double *it = begin; it != end; ++it) {
+        quint32 halves[2];
+        memcpy(halves, it, sizeof(halves));
+        quint64 x = halves[0] | (quint64(halves[1]) << 32);
+        x >>= std::numeric_limits<quint64>::digits - std::numeric_limits<double>::digits;
+        *it = double(x) / double(limit);
+    }
+}
+
+/*!
+    \since 6.7
+    \overload
+
+    Fills the range from \a begin to \a end with random 32-bit quantities in
+    the range between 0 (inclusive) and \a highest (exclusive), the same
+    values that as many calls to bounded(\a highest) would return, at the
+    cost of one call into the generator.
+
+    \sa bounded(), fillRange()
+ */
+void QRandomGenerator::bounded(quint32 highest, quint32 *begin, quint32 *end)
+{
+    Q_ASSERT(begin <= end);
+    if (begin == end)
+        return;
+
+    _fillRange(begin, end - begin);
+    for (quint32 *it = begin; it != end; ++it)
+        *it = quint32((quint64(*it) * highest) >> 32);
+}
+
 // helper function to call fillBuffer, since we need something to be
 // argument-dependent
 template <typename Generator, typename FillBufferType, typename T>
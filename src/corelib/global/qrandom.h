@@ -68,6 +68,7 @@ public:
         x >>= std::numeric_limits<quint64>::digits - std::numeric_limits<double>::digits;
         return double(x) / double(limit);
     }
+    Q_CORE_EXPORT void generateDouble(double *begin, double *end);
 
     double bounded(double highest)
     {
@@ -82,6 +83,8 @@ public:
         return quint32(value);
     }
 
+    Q_CORE_EXPORT void bounded(quint32 highest, quint32 *begin, quint32 *end);
+
     quint32 bounded(quint32 lowest, quint32 highest)
     {
         Q_ASSERT(highest > lowest);
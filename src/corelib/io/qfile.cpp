@@ -867,6 +867,12 @@ QFile::copy(const QString &fileName, const QString &newName)
     QIODevice::ReadWrite. It may also have additional flags, such as
     QIODevice::Text and QIODevice::Unbuffered.
 
+    With QIODevice::ReadOnly, QIODevice::MemoryMapped maps the whole file
+    into memory, so that it is read without system calls and without copying
+    it into the device's buffer:
+
+    \snippet code/src_corelib_io_qfile.cpp 5
+
     \note In \l{QIODevice::}{WriteOnly} or \l{QIODevice::}{ReadWrite}
     mode, if the relevant file does not already exist, this function
     will try to create a new file before opening it. The file will be
@@ -894,6 +900,8 @@ bool QFile::open(OpenMode mode)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered)) {
+        if (!d->mapContents(mode))
+            mode &= ~MemoryMapped;
         QIODevice::open(mode);
         if (mode & Append)
             seek(size());
@@ -939,6 +947,8 @@ bool QFile::open(OpenMode mode, QFile::Permissions permissions)
 
     // QIODevice provides the buffering, so there's no need to request it from the file engine.
     if (d->engine()->open(mode | QIODevice::Unbuffered, permissions)) {
+        if (!d->mapContents(mode))
+            mode &= ~MemoryMapped;
         QIODevice::open(mode);
         if (mode & Append)
             seek(size());
@@ -1009,6 +1019,8 @@ bool QFile::open(FILE *fh, OpenMode mode, FileHandleFlags handleFlags)
 
     // QIODevice provides the buffering, so request unbuffered file engines
     if (d->openExternalFile(mode | Unbuffered, fh, handleFlags)) {
+        if (!d->mapContents(mode))
+            mode &= ~MemoryMapped;
         QIODevice::open(mode);
         if (!(mode & Append) && !isSequential()) {
             qint64 pos = (qint64)QT_FTELL(fh);
@@ -1061,6 +1073,8 @@ bool QFile::open(int fd, OpenMode mode, FileHandleFlags handleFlags)
 
     // QIODevice provides the buffering, so request unbuffered file engines
     if (d->openExternalFile(mode | Unbuffered, fd, handleFlags)) {
+        if (!d->mapContents(mode))
+            mode &= ~MemoryMapped;
         QIODevice::open(mode);
         if (!(mode & Append) && !isSequential()) {
             qint64 pos = (qint64)QT_LSEEK(fd, QT_OFF_T(0), SEEK_CUR);
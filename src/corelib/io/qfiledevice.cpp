@@ -5,6 +5,13 @@
 #include "qfiledevice.h"
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
+#include "qfilesystemengine_p.h"
+#include "qfile.h"
+#if QT_CONFIG(temporaryfile)
+#include "qtemporaryfile.h"
+#endif
+
+#include <private/qbytearray_p.h>
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -301,6 +308,7 @@ void QFileDevice::close()
         return;
     bool flushed = flush();
     QIODevice::close();
+    d->unmapContents();
 
     // reset write buffer
     d->lastWasWrite = false;
@@ -389,7 +397,10 @@ bool QFileDevice::seek(qint64 off)
     if (!d->ensureFlushed())
         return false;
 
-    if (!d->fileEngine->seek(off) || !QIODevice::seek(off)) {
+    // Reads from the mapping don't use the file engine's position; it is
+    // only updated when reading past the end of the mapping.
+    const bool engineSeek = d->mapping.isNull();
+    if ((engineSeek && !d->fileEngine->seek(off)) || !QIODevice::seek(off)) {
         QFileDevice::FileError err = d->fileEngine->error();
         if (err == QFileDevice::UnspecifiedError)
             err = QFileDevice::PositionError;
@@ -409,6 +420,20 @@ qint64 QFileDevice::readLineData(char *data, qint64 maxlen)
     if (!d->ensureFlushed())
         return -1;
 
+    if (!d->mapping.isNull()) {
+        if (d->devicePos < d->mapping.size()) {
+            const char *start = d->mapping.data() + d->devicePos;
+            const qint64 available = qMin(maxlen, d->mapping.size() - d->devicePos);
+            const void *newline = memchr(start, '\n', size_t(available));
+            const qint64 read = newline ? static_cast<const char *>(newline) - start + 1
+                                        : available;
+            memcpy(data, start, size_t(read));
+            return read;
+        }
+        if (!d->fileEngine->seek(d->devicePos))
+            return -1;
+    }
+
     qint64 read;
     if (d->fileEngine->supportsExtension(QAbstractFileEngine::FastReadLineExtension)) {
         read = d->fileEngine->readLine(data, maxlen);
@@ -438,6 +463,18 @@ qint64 QFileDevice::readData(char *data, qint64 len)
     if (!d->ensureFlushed())
         return -1;
 
+    if (!d->mapping.isNull()) {
+        if (d->devicePos < d->mapping.size()) {
+            const qint64 read = qMin(len, d->mapping.size() - d->devicePos);
+            memcpy(data, d->mapping.data() + d->devicePos, size_t(read));
+            return read;
+        }
+        if (!d->fileEngine->seek(d->devicePos)) {
+            d->setError(QFileDevice::ReadError, d->fileEngine->errorString());
+            return -1;
+        }
+    }
+
     const qint64 read = d->fileEngine->read(data, len);
     if (read < 0) {
         QFileDevice::FileError err = d->fileEngine->error();
@@ -454,6 +491,140 @@ qint64 QFileDevice::readData(char *data, qint64 len)
     return read;
 }
 
+/*!
+    \internal
+
+    Maps the whole file into memory for a file opened with
+    QIODevice::MemoryMapped in \a mode. Returns \c false, leaving the file to
+    be read through the file engine, if the file is opened for writing or in
+    text mode, or cannot be mapped.
+*/
+bool QFileDevicePrivate::mapContents(QIODevice::OpenMode mode)
+{
+    Q_ASSERT(mapping.isNull());
+    if (!(mode & QIODevice::MemoryMapped) || (mode & (QIODevice::WriteOnly | QIODevice::Text)))
+        return false;
+    if (fileEngine->isSequential()
+            || !fileEngine->supportsExtension(QAbstractFileEngine::MapExtension)) {
+        return false;
+    }
+
+    const qint64 size = fileEngine->size();
+    if (size <= 0 || size >= MaxByteArraySize)
+        return false;
+
+    uchar *address = fileEngine->map(0, size, QFileDevice::NoOptions);
+    if (!address)
+        return false;
+    mapping = QByteArrayView(address, qsizetype(size));
+    return true;
+}
+
+/*!
+    \internal
+*/
+void QFileDevicePrivate::unmapContents()
+{
+    if (mapping.isNull())
+        return;
+    uchar *address = reinterpret_cast<uchar *>(const_cast<char *>(mapping.data()));
+    mapping = QByteArrayView();
+    fileEngine->unmap(address);
+}
+
+/*!
+    \internal
+
+    Returns \c true if reading and writing go straight to the file engine's
+    native handle, that is, the file was opened through QFile or
+    QTemporaryFile and not through a subclass that may reimplement
+    readData() or writeData().
+*/
+bool QFileDevicePrivate::hasNativeDataPath() const
+{
+#ifdef QT_NO_QOBJECT
+    return false;
+#else
+    Q_Q(const QFileDevice);
+    if (!fileEngine || fileEngine->handle() < 0 || fileEngine->isSequential())
+        return false;
+    const QMetaObject *mo = q->metaObject();
+#if QT_CONFIG(temporaryfile)
+    if (mo == &QTemporaryFile::staticMetaObject)
+        return true;
+#endif
+    return mo == &QFile::staticMetaObject;
+#endif
+}
+
+/*!
+    \internal
+*/
+qint64 QFileDevicePrivate::transferToNative(QIODevicePrivate *target, qint64 maxSize)
+{
+#if defined(Q_OS_UNIX) && !defined(QT_NO_QOBJECT)
+    Q_Q(QFileDevice);
+    if (!hasNativeDataPath() || !ensureFlushed())
+        return 0;
+    maxSize = qMin(maxSize, q->size() - pos);
+    if (maxSize <= 0)
+        return 0;
+
+    qint64 targetOffset = -1;
+    const int targetHandle = target->nativeWriteHandle(&targetOffset);
+    if (targetHandle < 0)
+        return 0;
+
+    // Use explicit offsets rather than the position of the handle, so that
+    // this works regardless of where the engine left it.
+    const qint64 transferred = QFileSystemEngine::transferData(fileEngine->handle(), pos,
+                                                               targetHandle, targetOffset,
+                                                               maxSize);
+    if (transferred > 0) {
+        // update ourselves first: the target may emit signals
+        q->seek(pos + transferred);
+        target->nativeWritten(transferred);
+    }
+    return transferred;
+#else
+    Q_UNUSED(target);
+    Q_UNUSED(maxSize);
+    return 0;
+#endif
+}
+
+/*!
+    \internal
+*/
+int QFileDevicePrivate::nativeWriteHandle(qint64 *offset)
+{
+#if defined(Q_OS_UNIX) && !defined(QT_NO_QOBJECT)
+    Q_Q(QFileDevice);
+    // O_APPEND files can't be written at an offset
+    if (!hasNativeDataPath() || (openMode & QIODevice::Append) || !q->flush())
+        return -1;
+    *offset = pos;
+    return fileEngine->handle();
+#else
+    Q_UNUSED(offset);
+    return -1;
+#endif
+}
+
+/*!
+    \internal
+*/
+void QFileDevicePrivate::nativeWritten(qint64 size)
+{
+#ifndef QT_NO_QOBJECT
+    Q_Q(QFileDevice);
+    cachedSize = 0;
+    q->seek(pos + size);
+#else
+    Q_UNUSED(size);
+#endif
+}
+
 /*!
     \internal
 */
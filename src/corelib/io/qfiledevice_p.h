@@ -51,6 +51,15 @@ protected:
 
     bool putCharHelper(char c) override;
 
+    bool mapContents(QIODevice::OpenMode mode);
+    void unmapContents();
+    QByteArrayView mappedContents() const override { return mapping; }
+
+    bool hasNativeDataPath() const;
+    qint64 transferToNative(QIODevicePrivate *target, qint64 maxSize) override;
+    int nativeWriteHandle(qint64 *offset) override;
+    void nativeWritten(qint64 size) override;
+
     void setError(QFileDevice::FileError err);
     void setError(QFileDevice::FileError err, const QString &errorString);
     void setError(QFileDevice::FileError err, int errNum);
@@ -61,6 +70,9 @@ protected:
     QFileDevice::FileHandleFlags handleFlags;
     QFileDevice::FileError error;
 
+    // the whole file, when opened with QIODevice::MemoryMapped
+    QByteArrayView mapping;
+
     bool lastWasWrite;
 };
 
@@ -91,7 +91,10 @@ public:
                              QFileSystemMetaData::MetaDataFlags what);
 #if defined(Q_OS_UNIX)
     static bool cloneFile(int srcfd, int dstfd, const QFileSystemMetaData &knownData);
+    static qint64 transferData(int srcfd, qint64 srcOffset, int dstfd, qint64 dstOffset,
+                               qint64 size);
     static bool fillMetaData(int fd, QFileSystemMetaData &data); // what = PosixStatFlags
+    static bool fillMetaData(int dirfd, const char *name, QFileSystemMetaData &data);
     static QByteArray id(int fd);
     static bool setFileTime(int fd, const QDateTime &newDate,
                             QAbstractFileEngine::FileTime whatTime, QSystemError &error);
@@ -58,6 +58,7 @@ extern "C" NSString *NSTemporaryDirectory();
 #if defined(Q_OS_LINUX)
 #  include <sys/ioctl.h>
 #  include <sys/sendfile.h>
+#  include <sys/syscall.h>
 #  include <linux/fs.h>
 
 // in case linux/fs.h is too old and doesn't define it:
@@ -842,6 +843,51 @@ QString QFileSystemEngine::bundleName(const QFileSystemEntry &entry)
 #endif
 
 //static
+//static
+bool QFileSystemEngine::fillMetaData(int dirfd, const char *name, QFileSystemMetaData &data)
+{
+    // Same as fillMetaData(entry, data, PosixStatFlags | LinkType) above, but
+    // resolves the name relative to an open directory, which saves the kernel
+    // from walking the full path again for every entry of a directory that
+    // is being iterated. Returns false without touching data if statx(2)
+    // isn't available or the entry is gone, so the caller falls back to the
+    // path-based lookups.
+#ifdef STATX_BASIC_STATS
+    struct statx statxBuffer;
+    if (qt_real_statx(dirfd, name, AT_SYMLINK_NOFOLLOW, &statxBuffer) != 0)
+        return false;
+
+    data.entryFlags &= ~(QFileSystemMetaData::PosixStatFlags | QFileSystemMetaData::LinkType);
+    if (S_ISLNK(statxBuffer.stx_mode)) {
+        data.entryFlags |= QFileSystemMetaData::LinkType;
+        if (qt_real_statx(dirfd, name, 0, &statxBuffer) == 0) {
+            data.fillFromStatxBuf(statxBuffer);
+        } else {
+            // dangling symlink
+            data.birthTime_ = 0;
+            data.metadataChangeTime_ = 0;
+            data.modificationTime_ = 0;
+            data.accessTime_ = 0;
+            data.size_ = 0;
+            data.userId_ = (uint) -2;
+            data.groupId_ = (uint) -2;
+        }
+    } else {
+        data.fillFromStatxBuf(statxBuffer);
+    }
+
+    data.knownFlagsMask |= QFileSystemMetaData::PosixStatFlags
+            | QFileSystemMetaData::ExistsAttribute
+            | QFileSystemMetaData::LinkType;
+    return true;
+#else
+    Q_UNUSED(dirfd);
+    Q_UNUSED(name);
+    Q_UNUSED(data);
+    return false;
+#endif
+}
+
 bool QFileSystemEngine::fillMetaData(const QFileSystemEntry &entry, QFileSystemMetaData &data,
         QFileSystemMetaData::MetaDataFlags what)
 {
@@ -1081,6 +1127,52 @@ bool QFileSystemEngine::cloneFile(int srcfd, int dstfd, const QFileSystemMetaDat
 #endif
 }
 
+// Moves up to \a size bytes starting at \a srcOffset in \a srcfd to \a dstfd
+// inside the kernel: at \a dstOffset if that isn't negative, otherwise at
+// the current position of \a dstfd (for sockets and pipes). Returns the
+// number of bytes moved, which is 0 if the kernel can't do it for these
+// descriptors; the caller then copies the data itself.
+//static
+qint64 QFileSystemEngine::transferData(int srcfd, qint64 srcOffset, int dstfd, qint64 dstOffset,
+                                       qint64 size)
+{
+#if defined(Q_OS_LINUX)
+    // both system calls are limited in the kernel to 2G - 4k
+    const qint64 MaxChunkSize = 0x7ffff000;
+
+    qint64 transferred = 0;
+    while (transferred < size) {
+        const size_t chunkSize = size_t(qMin(size - transferred, MaxChunkSize));
+        ssize_t n = 0;
+        if (dstOffset >= 0) {
+#  ifdef __NR_copy_file_range
+            loff_t in = srcOffset + transferred;
+            loff_t out = dstOffset + transferred;
+            n = ::syscall(__NR_copy_file_range, srcfd, &in, dstfd, &out, chunkSize, 0u);
+#  endif
+        } else {
+            off_t in = off_t(srcOffset + transferred);
+            if (in != srcOffset + transferred)
+                break;      // off_t is too small for this offset
+            n = ::sendfile(dstfd, srcfd, &in, chunkSize);
+        }
+        if (n == -1 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;      // end of file, would block, or not supported
+        transferred += n;
+    }
+    return transferred;
+#else
+    Q_UNUSED(srcfd);
+    Q_UNUSED(srcOffset);
+    Q_UNUSED(dstfd);
+    Q_UNUSED(dstOffset);
+    Q_UNUSED(size);
+    return 0;
+#endif
+}
+
 // Note: if \a shouldMkdirFirst is false, we assume the caller did try to mkdir
 // before calling this function.
 static bool createDirectoryWithParents(const QByteArray &nativeName, mode_t mode,
@@ -58,6 +58,7 @@ private:
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
     int lastError;
+    bool prefetchMetaData;
 #endif
 
     Q_DISABLE_COPY_MOVE(QFileSystemIterator)
@@ -4,6 +4,7 @@
 #include "qplatformdefs.h"
 #include "qfilesystemiterator_p.h"
 
+#include <private/qfilesystemengine_p.h>
 #include <private/qstringconverter_p.h>
 
 #ifndef QT_NO_FILESYSTEMITERATOR
@@ -30,9 +31,14 @@ QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Fi
     , dirEntry(nullptr)
     , lastError(0)
 {
-    Q_UNUSED(filters);
-    Q_UNUSED(nameFilters);
-    Q_UNUSED(flags);
+    // QDirIterator needs to know the type of (almost) every entry, and for
+    // symlinks whether the target exists, unless it lists everything in a
+    // single directory. Entries whose type readdir() can't tell are then
+    // stat'ed right away, relative to the directory being read.
+    prefetchMetaData = !nameFilters.isEmpty()
+            || (flags & QDirIterator::Subdirectories)
+            || !(filters & QDir::System)
+            || (filters & (QDir::Dirs | QDir::Files)) != (QDir::Dirs | QDir::Files);
 
     if ((dir = QT_OPENDIR(nativePath.constData())) == nullptr) {
         lastError = errno;
@@ -61,6 +67,10 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
             if (checkNameDecodable(dirEntry->d_name, len)) {
                 fileEntry = QFileSystemEntry(nativePath + QByteArray(dirEntry->d_name, len), QFileSystemEntry::FromNativePath());
                 metaData.fillFromDirEnt(*dirEntry);
+                if (prefetchMetaData && (metaData.isLink()
+                        || !metaData.hasFlags(QFileSystemMetaData::DirectoryType))) {
+                    QFileSystemEngine::fillMetaData(dirfd(dir), dirEntry->d_name, metaData);
+                }
                 return true;
             }
         } else {
@@ -8,6 +8,7 @@
 #include <qdir.h>
 #include <qfileinfo.h>
 #include <qloggingcategory.h>
+#include <qmetaobject.h>
 #include <qset.h>
 #include <qtimer.h>
 
@@ -112,7 +113,13 @@ void QFileSystemWatcherPrivate::_q_fileChanged(const QString &path, bool removed
     }
     if (removed)
         files.removeAll(path);
+    if (coalescingInterval > std::chrono::milliseconds::zero()) {
+        queueChange(pendingFiles, path);
+        return;
+    }
     emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (q->isSignalConnected(QMetaMethod::fromSignal(&QFileSystemWatcher::filesChanged)))
+        emit q->filesChanged(QStringList(path), QFileSystemWatcher::QPrivateSignal());
 }
 
 void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool removed)
@@ -125,7 +132,59 @@ void QFileSystemWatcherPrivate::_q_directoryChanged(const QString &path, bool re
     }
     if (removed)
         directories.removeAll(path);
+    if (coalescingInterval > std::chrono::milliseconds::zero()) {
+        queueChange(pendingDirectories, path);
+        return;
+    }
     emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (q->isSignalConnected(QMetaMethod::fromSignal(&QFileSystemWatcher::directoriesChanged)))
+        emit q->directoriesChanged(QStringList(path), QFileSystemWatcher::QPrivateSignal());
+}
+
+void QFileSystemWatcherPrivate::queueChange(QStringList &pending, const QString &path)
+{
+    Q_Q(QFileSystemWatcher);
+    if (pendingPaths.contains(path))
+        return;
+    pendingPaths.insert(path);
+    pending.append(path);
+
+    if (!coalescingTimer) {
+        coalescingTimer = new QTimer(q);
+        coalescingTimer->setSingleShot(true);
+        QObject::connect(coalescingTimer, &QTimer::timeout, q,
+                         [this] { flushPendingChanges(); });
+    }
+    // The window starts with the first change, so that a steady stream of
+    // changes cannot postpone delivery indefinitely.
+    if (!coalescingTimer->isActive())
+        coalescingTimer->start(coalescingInterval);
+}
+
+void QFileSystemWatcherPrivate::flushPendingChanges()
+{
+    Q_Q(QFileSystemWatcher);
+    if (coalescingTimer)
+        coalescingTimer->stop();
+
+    // Paths unwatched with removePaths() in the meantime are no longer in
+    // pendingPaths and are dropped; taking each path out of the set as it is
+    // kept also drops duplicates of paths that were removed and re-added.
+    const auto notPending = [this](const QString &path) { return !pendingPaths.remove(path); };
+    QStringList changedFiles = std::exchange(pendingFiles, {});
+    QStringList changedDirectories = std::exchange(pendingDirectories, {});
+    changedFiles.removeIf(notPending);
+    changedDirectories.removeIf(notPending);
+    pendingPaths.clear();
+
+    for (const QString &path : std::as_const(changedFiles))
+        emit q->fileChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (!changedFiles.isEmpty())
+        emit q->filesChanged(changedFiles, QFileSystemWatcher::QPrivateSignal());
+    for (const QString &path : std::as_const(changedDirectories))
+        emit q->directoryChanged(path, QFileSystemWatcher::QPrivateSignal());
+    if (!changedDirectories.isEmpty())
+        emit q->directoriesChanged(changedDirectories, QFileSystemWatcher::QPrivateSignal());
 }
 
 #if defined(Q_OS_WIN)
@@ -408,6 +467,13 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     if (d->poller)
         p = d->poller->removePaths(p, &d->files, &d->directories);
 
+    if (!d->pendingPaths.isEmpty()) {
+        for (const QString &path : paths) {
+            if (!p.contains(path))
+                d->pendingPaths.remove(path);
+        }
+    }
+
     return p;
 }
 
@@ -439,6 +505,81 @@ QStringList QFileSystemWatcher::removePaths(const QStringList &paths)
     \sa fileChanged()
 */
 
+/*!
+    \fn void QFileSystemWatcher::filesChanged(const QStringList &paths)
+    \since 6.7
+
+    This signal is emitted with the \a paths of all watched files that
+    were modified, renamed or removed from disk. Each path is listed once,
+    in the order in which the changes were first noticed.
+
+    Unless a coalescingInterval() is set, the list holds a single path and
+    the signal is emitted right after the corresponding fileChanged().
+
+    \sa directoriesChanged(), setCoalescingInterval()
+*/
+
+/*!
+    \fn void QFileSystemWatcher::directoriesChanged(const QStringList &paths)
+    \since 6.7
+
+    This signal is emitted with the \a paths of all watched directories
+    that were modified or removed from disk. Each path is listed once, in
+    the order in which the changes were first noticed.
+
+    Unless a coalescingInterval() is set, the list holds a single path and
+    the signal is emitted right after the corresponding directoryChanged().
+
+    \sa filesChanged(), setCoalescingInterval()
+*/
+
+/*!
+    \since 6.7
+
+    Sets the time during which changes are collected before they are
+    reported to \a interval.
+
+    By default the interval is zero, and every change notification of the
+    underlying system is reported as soon as it arrives. With a positive
+    interval, the first change starts a window of that length; further
+    changes of the same path within the window are merged, and when it
+    elapses fileChanged() and directoryChanged() are emitted once for every
+    changed path, followed by a single filesChanged() and
+    directoriesChanged() with all of them. This keeps bursts of writes,
+    such as a build or a large copy, from turning into a storm of signals.
+
+    Setting the interval to zero reports pending changes immediately.
+
+    \sa coalescingInterval()
+*/
+void QFileSystemWatcher::setCoalescingInterval(std::chrono::milliseconds interval)
+{
+    Q_D(QFileSystemWatcher);
+    if (interval < std::chrono::milliseconds::zero())
+        interval = std::chrono::milliseconds::zero();
+    d->coalescingInterval = interval;
+    if (d->pendingPaths.isEmpty())
+        return;
+    if (interval == std::chrono::milliseconds::zero())
+        d->flushPendingChanges();
+    else if (d->coalescingTimer->isActive())
+        d->coalescingTimer->start(interval);
+}
+
+/*!
+    \since 6.7
+
+    Returns the time during which changes are collected before they are
+    reported.
+
+    \sa setCoalescingInterval()
+*/
+std::chrono::milliseconds QFileSystemWatcher::coalescingInterval() const
+{
+    Q_D(const QFileSystemWatcher);
+    return d->coalescingInterval;
+}
+
 /*!
     \fn QStringList QFileSystemWatcher::directories() const
 
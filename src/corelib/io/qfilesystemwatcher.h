@@ -6,6 +6,8 @@
 
 #include <QtCore/qobject.h>
 
+#include <chrono>
+
 QT_REQUIRE_CONFIG(filesystemwatcher);
 
 QT_BEGIN_NAMESPACE
@@ -31,9 +33,14 @@ public:
     QStringList files() const;
     QStringList directories() const;
 
+    void setCoalescingInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds coalescingInterval() const;
+
 Q_SIGNALS:
     void fileChanged(const QString &path, QPrivateSignal);
     void directoryChanged(const QString &path, QPrivateSignal);
+    void filesChanged(const QStringList &paths, QPrivateSignal);
+    void directoriesChanged(const QStringList &paths, QPrivateSignal);
 
 private:
     Q_PRIVATE_SLOT(d_func(), void _q_fileChanged(const QString &path, bool removed))
@@ -238,13 +238,11 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
         QFileInfo fi(path);
         bool isDir = fi.isDir();
         auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
-        if (isDir) {
-            if (directories->contains(path))
-                continue;
-        } else {
-            if (files->contains(path))
-                continue;
-        }
+        // look the path up in our own hash rather than in the (possibly
+        // very long) lists, which would make adding many paths quadratic
+        const auto existing = pathToID.constFind(path);
+        if (existing != pathToID.cend() && (*existing < 0) == isDir)
+            continue;
 
         int wd = inotify_add_watch(inotifyFd,
                                    QFile::encodeName(path),
@@ -23,9 +23,14 @@ QT_REQUIRE_CONFIG(filesystemwatcher);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+
+#include <chrono>
 
 QT_BEGIN_NAMESPACE
 
+class QTimer;
+
 class QFileSystemWatcherEngine : public QObject
 {
     Q_OBJECT
@@ -68,6 +73,15 @@ public:
     QFileSystemWatcherEngine *native, *poller;
     QStringList files, directories;
 
+    // changes collected during the coalescing interval, in arrival order
+    std::chrono::milliseconds coalescingInterval{0};
+    QTimer *coalescingTimer = nullptr;
+    QStringList pendingFiles, pendingDirectories;
+    QSet<QString> pendingPaths;
+
+    void queueChange(QStringList &pending, const QString &path);
+    void flushPendingChanges();
+
     // private slots
     void _q_fileChanged(const QString &path, bool removed);
     void _q_directoryChanged(const QString &path, bool removed);
@@ -13,6 +13,7 @@
 #include "private/qtools_p.h"
 
 #include <algorithm>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -301,6 +302,18 @@ QIODevicePrivate::~QIODevicePrivate()
                      classes might use this flag in the future, but until then
                      using this flag with any classes other than QFile may
                      result in undefined behavior. (since Qt 5.11)
+    \value MemoryMapped The file is mapped into memory when it is opened for
+                     reading only. Reads copy the data directly from the
+                     mapping, and the overloads of read(), readAll(),
+                     readLine() and peek() returning a QByteArray return one
+                     referencing the mapped memory, as if created with
+                     QByteArray::fromRawData(), instead of a copy. Such byte
+                     arrays must not be used after the device is closed. If
+                     the file cannot be mapped, for instance because it is
+                     not a regular file or is opened for writing or in
+                     \c Text mode, it is read as if this flag had not been
+                     given, and openMode() does not include it. This flag
+                     currently only affects QFile. (since Qt 6.7)
 
     Certain flags, such as \c Unbuffered and \c Truncate, are
     meaningless when used with some subclasses. Some of these
@@ -1037,7 +1050,8 @@ qint64 QIODevicePrivate::read(char *data, qint64 maxSize, bool peeking)
 {
     Q_Q(QIODevice);
 
-    const bool buffered = (readBufferChunkSize != 0 && (openMode & QIODevice::Unbuffered) == 0);
+    const bool buffered = (readBufferChunkSize != 0
+                           && (openMode & (QIODevice::Unbuffered | QIODevice::MemoryMapped)) == 0);
     const bool sequential = isSequential();
     const bool keepDataInBuffer = sequential
                                   ? peeking || transactionStarted
@@ -1187,6 +1201,13 @@ QByteArray QIODevice::read(qint64 maxSize)
     QByteArray result;
     CHECK_READABLE(read, result);
 
+    if (d->openMode & MemoryMapped) {
+        CHECK_MAXLEN(read, result);
+        result = d->readMapped(maxSize);
+        if (!result.isNull())
+            return result;
+    }
+
     // Try to prevent the data from being copied, if we have a chunk
     // with the same size in the read buffer.
     if (maxSize == d->buffer.nextDataBlockSize() && !d->transactionStarted
@@ -1235,6 +1256,13 @@ QByteArray QIODevice::readAll()
     CHECK_READABLE(read, result);
 
     qint64 readBytes = (d->isSequential() ? Q_INT64_C(0) : size());
+    // Hand out the mapped contents, unless the file grew since it was mapped.
+    if ((d->openMode & MemoryMapped) && d->pos < readBytes
+            && readBytes <= d->mappedContents().size()) {
+        result = d->readMapped(readBytes - d->pos);
+        if (!result.isNull())
+            return result;
+    }
     if (readBytes == 0) {
         // Size is unknown, read incrementally.
         qint64 readChunkSize = qMax(qint64(d->buffer.chunkSize()),
@@ -1450,6 +1478,10 @@ QByteArray QIODevice::readLine(qint64 maxSize)
         // Size is unknown, read incrementally.
         maxSize = MaxByteArraySize - 1;
 
+        result = d->readLineMapped(maxSize);
+        if (!result.isNull())
+            return result;
+
         // The first iteration needs to leave an extra byte for the terminating null
         result.resize(1);
 
@@ -1465,6 +1497,10 @@ QByteArray QIODevice::readLine(qint64 maxSize)
         CHECK_LINEMAXLEN(readLine, result);
         CHECK_MAXBYTEARRAYSIZE(readLine);
 
+        result = d->readLineMapped(maxSize);
+        if (!result.isNull())
+            return result;
+
         result.resize(maxSize);
         readBytes = d->readLine(result.data(), result.size());
     }
@@ -1845,6 +1881,104 @@ QByteArray QIODevicePrivate::peek(qint64 maxSize)
     return result;
 }
 
+/*!
+    \internal
+
+    Returns the contents of a device opened with QIODevice::MemoryMapped
+    that are mapped into memory, or a null view if there are none.
+*/
+QByteArrayView QIODevicePrivate::mappedContents() const
+{
+    return QByteArrayView();
+}
+
+/*!
+    \internal
+
+    Moves up to \a maxSize bytes from the current position of this device
+    to \a target without copying them through user space, for transferTo().
+    Returns the number of bytes moved; 0 means that transferTo() has to copy
+    the data itself. Only called when the read buffer is empty.
+*/
+qint64 QIODevicePrivate::transferToNative(QIODevicePrivate *target, qint64 maxSize)
+{
+    Q_UNUSED(target);
+    Q_UNUSED(maxSize);
+    return 0;
+}
+
+/*!
+    \internal
+
+    Returns the native descriptor through which data may be written to this
+    device directly, bypassing writeData() and any write buffer, or -1 if
+    there is none. If the data must be written at an offset, it is stored in
+    \a offset; it is left at -1 for descriptors without one, like sockets.
+
+    A successful write is reported with nativeWritten().
+*/
+int QIODevicePrivate::nativeWriteHandle(qint64 *offset)
+{
+    Q_UNUSED(offset);
+    return -1;
+}
+
+/*!
+    \internal
+
+    Updates the state of the device after \a size bytes were written to the
+    descriptor returned by nativeWriteHandle().
+*/
+void QIODevicePrivate::nativeWritten(qint64 size)
+{
+    Q_UNUSED(size);
+}
+
+/*!
+    \internal
+
+    Returns at most \a maxSize bytes from the current position as a byte
+    array referencing the mapped contents of the device, advancing the
+    position unless \a peeking is \c true. Returns a null QByteArray if the
+    data cannot be read without copying it, in which case the caller falls
+    back to a regular read.
+*/
+QByteArray QIODevicePrivate::readMapped(qint64 maxSize, bool peeking)
+{
+    if (!(openMode & QIODevice::MemoryMapped) || (openMode & QIODevice::Text)
+            || !buffer.isEmpty() || isSequential()) {
+        return QByteArray();
+    }
+
+    const QByteArrayView contents = mappedContents();
+    if (pos >= contents.size())
+        return QByteArray();
+
+    const qsizetype size = qsizetype(qMin(maxSize, contents.size() - pos));
+    QByteArray result = QByteArray::fromRawData(contents.data() + pos, size);
+    if (!peeking) {
+        pos += size;
+        devicePos = pos;
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Like readMapped(), but returns a line of at most \a maxSize - 1 bytes,
+    as QIODevice::readLine() does.
+*/
+QByteArray QIODevicePrivate::readLineMapped(qint64 maxSize)
+{
+    const QByteArray line = readMapped(maxSize - 1, true);
+    if (line.isNull())
+        return line;
+
+    const qsizetype newline = line.indexOf('\n');
+    return readMapped(newline >= 0 ? newline + 1 : line.size());
+}
+
 /*! \fn bool QIODevice::getChar(char *c)
 
     Reads one character from the device and stores it in \a c. If \a c
@@ -1912,6 +2046,12 @@ QByteArray QIODevice::peek(qint64 maxSize)
     CHECK_MAXBYTEARRAYSIZE(peek);
     CHECK_READABLE(peek, QByteArray());
 
+    if (d->openMode & MemoryMapped) {
+        QByteArray result = d->readMapped(maxSize, true);
+        if (!result.isNull())
+            return result;
+    }
+
     return d->peek(maxSize);
 }
 
@@ -2046,6 +2186,82 @@ qint64 QIODevice::skipData(qint64 maxSize)
     return d_func()->skipByReading(maxSize);
 }
 
+/*!
+    \since 6.7
+
+    Transfers up to \a maxSize bytes from this device to \a target, or all
+    of the data up to the end of this device if \a maxSize is -1. Returns
+    the number of bytes transferred, or -1 on error.
+
+    This function does not wait: like read(), it only transfers the data
+    that is already available for reading. It stops early if \a target
+    does not accept all the data written to it; data is only consumed from
+    this device once \a target has accepted it.
+
+    When this device is a QFile and \a target is another QFile or a
+    QTcpSocket, the operating system may move the data between the two
+    without copying it into the application, using \c copy_file_range() or
+    \c sendfile() on Linux. Otherwise, and for data that is already in this
+    device's read buffer, the data is copied through a single intermediate
+    buffer in chunks.
+
+    Data moved directly into a socket does not pass through its write
+    buffer. Data that the socket cannot take right away is written to it
+    with write() as usual, so pass a smaller \a maxSize to transfer large
+    files in portions.
+
+    \sa read(), write(), skip()
+*/
+qint64 QIODevice::transferTo(QIODevice *target, qint64 maxSize)
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(transferTo, qint64(-1));
+    if (maxSize < -1) {
+        checkWarnMessage(this, "transferTo", "Called with maxSize < -1");
+        return qint64(-1);
+    }
+    if (!target || target == this) {
+        checkWarnMessage(this, "transferTo", "Called with an invalid target device");
+        return qint64(-1);
+    }
+    if (!target->isWritable()) {
+        checkWarnMessage(this, "transferTo", "Target device is not writable");
+        return qint64(-1);
+    }
+    if (maxSize == -1)
+        maxSize = std::numeric_limits<qint64>::max();
+
+    qint64 transferred = 0;
+    if (d->buffer.isEmpty() && !d->transactionStarted
+            && !((d->openMode | target->d_func()->openMode) & Text)) {
+        transferred = d->transferToNative(target->d_func(), maxSize);
+    }
+
+    // Copy whatever is left through a buffer. Peek first, so that no data is
+    // lost if the target refuses part of it.
+    char chunk[16384];
+    while (transferred < maxSize) {
+        const qint64 peeked = peek(chunk, qMin<qint64>(maxSize - transferred, sizeof(chunk)));
+        if (peeked <= 0) {
+            if (peeked < 0 && transferred == 0)
+                return qint64(-1);
+            break;
+        }
+
+        const qint64 written = target->write(chunk, peeked);
+        if (written <= 0) {
+            if (written < 0 && transferred == 0)
+                return qint64(-1);
+            break;
+        }
+        skip(written);
+        transferred += written;
+        if (written < peeked)
+            break;
+    }
+    return transferred;
+}
+
 /*!
     Blocks until new data is available for reading and the readyRead()
     signal has been emitted, or until \a msecs milliseconds have
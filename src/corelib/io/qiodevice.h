@@ -92,6 +92,7 @@ public:
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
     qint64 skip(qint64 maxSize);
+    qint64 transferTo(QIODevice *target, qint64 maxSize = -1);
 
     virtual bool waitForReadyRead(int msecs);
     virtual bool waitForBytesWritten(int msecs);
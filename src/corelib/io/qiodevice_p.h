@@ -66,6 +66,7 @@ public:
         inline qint64 nextDataBlockSize() const { return (m_buf ? m_buf->nextDataBlockSize() : Q_INT64_C(0)); }
         inline const char *readPointer() const { return (m_buf ? m_buf->readPointer() : nullptr); }
         inline const char *readPointerAtPosition(qint64 pos, qint64 &length) const { Q_ASSERT(m_buf); return m_buf->readPointerAtPosition(pos, length); }
+        inline qsizetype readBlocks(QByteArrayView *blocks, qsizetype maxCount) const { return (m_buf ? m_buf->readBlocks(blocks, maxCount) : 0); }
         inline void free(qint64 bytes) { Q_ASSERT(m_buf); m_buf->free(bytes); }
         inline char *reserve(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserve(bytes); }
         inline char *reserveFront(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserveFront(bytes); }
@@ -148,7 +149,13 @@ public:
     qint64 readLine(char *data, qint64 maxSize);
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
+    virtual QByteArrayView mappedContents() const;
+    QByteArray readMapped(qint64 maxSize, bool peeking = false);
+    QByteArray readLineMapped(qint64 maxSize);
     qint64 skipByReading(qint64 maxSize);
+    virtual qint64 transferToNative(QIODevicePrivate *target, qint64 maxSize);
+    virtual int nativeWriteHandle(qint64 *offset);
+    virtual void nativeWritten(qint64 size);
     void write(const char *data, qint64 size);
 
     inline bool isWriteChunkCached(const char *data, qint64 size) const
@@ -4,11 +4,26 @@
 #include "qloggingcategory.h"
 #include "qloggingregistry_p.h"
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 
 const char qtDefaultCategoryName[] = "default";
 Q_GLOBAL_STATIC(QLoggingCategory, qtDefaultCategory, qtDefaultCategoryName)
 
+namespace {
+// Implements the generic cell rate algorithm, which is equivalent to a token
+// bucket holding messagesPerSecond tokens, but needs a single atomic: each
+// message moves the theoretical arrival time one interval into the future,
+// and messages are rejected while that time is more than a second ahead.
+struct RateLimit
+{
+    QBasicAtomicInt messagesPerSecond = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QBasicAtomicInteger<qint64> theoreticalArrival = Q_BASIC_ATOMIC_INITIALIZER(0);
+    QBasicAtomicInteger<quint64> suppressed = Q_BASIC_ATOMIC_INITIALIZER(0);
+};
+} // unnamed namespace
+
 /*!
     \class QLoggingCategory
     \inmodule QtCore
@@ -196,6 +211,7 @@ QLoggingCategory::~QLoggingCategory()
 {
     if (QLoggingRegistry *reg = QLoggingRegistry::instance())
         reg->unregisterCategory(this);
+    delete static_cast<RateLimit *>(d);
 }
 
 /*!
@@ -288,6 +304,84 @@ void QLoggingCategory::setEnabled(QtMsgType type, bool enable)
     }
 }
 
+/*!
+    \since 6.7
+
+    Limits the number of messages logged through this category to
+    \a messagesPerSecond, with bursts of up to \a messagesPerSecond messages.
+    A value of 0 removes the limit, which is the default.
+
+    The limit is applied by the \l qCDebug(), \l qCInfo(), \l qCWarning() and
+    \l qCCritical() macros before their arguments are evaluated, so
+    suppressed messages cost neither formatting nor output. Fatal messages
+    are never suppressed. Once messages are allowed again, an informational
+    message states how many were suppressed.
+
+    \note The first call to this function for a given category must not
+    race with messages being logged through it. Changing the limit later is
+    thread-safe.
+
+    \sa rateLimit()
+*/
+void QLoggingCategory::setRateLimit(int messagesPerSecond)
+{
+    if (!d) {
+        if (messagesPerSecond <= 0)
+            return;
+        d = new RateLimit;
+    }
+    static_cast<RateLimit *>(d)->messagesPerSecond.storeRelaxed(qMax(messagesPerSecond, 0));
+}
+
+/*!
+    \since 6.7
+
+    Returns the maximum number of messages per second logged through this
+    category, or 0 if there is no limit.
+
+    \sa setRateLimit()
+*/
+int QLoggingCategory::rateLimit() const
+{
+    return d ? static_cast<const RateLimit *>(d)->messagesPerSecond.loadRelaxed() : 0;
+}
+
+/*!
+    \fn bool QLoggingCategory::isWithinRateLimit() const
+    \internal
+
+    Returns \c true if a message may be logged under the rate limit set with
+    setRateLimit(), consuming one of the allowed messages.
+*/
+
+bool QLoggingCategory::acquireRateLimitToken() const
+{
+    using namespace std::chrono;
+    auto *limit = static_cast<RateLimit *>(d);
+    const int perSecond = limit->messagesPerSecond.loadRelaxed();
+    if (perSecond <= 0)
+        return true;
+
+    const qint64 interval = nanoseconds(1s).count() / perSecond;
+    const qint64 tolerance = interval * (perSecond - 1);
+    const qint64 now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    qint64 arrival = limit->theoreticalArrival.loadRelaxed();
+    qint64 next;
+    do {
+        next = qMax(arrival, now);
+        if (next - now > tolerance) {
+            limit->suppressed.fetchAndAddRelaxed(1);
+            return false;
+        }
+    } while (!limit->theoreticalArrival.testAndSetRelaxed(arrival, next + interval, arrival));
+
+    if (const quint64 count = limit->suppressed.fetchAndStoreRelaxed(0)) {
+        QMessageLogger(nullptr, 0, nullptr, name).info("%llu messages suppressed by the rate limit",
+                                                       qulonglong(count));
+    }
+    return true;
+}
+
 /*!
     \fn QLoggingCategory &QLoggingCategory::operator()()
 
@@ -26,6 +26,12 @@ public:
 
     const char *categoryName() const { return name; }
 
+    void setRateLimit(int messagesPerSecond);
+    int rateLimit() const;
+
+    // internal, used by the qCDebug() etc. macros
+    bool isWithinRateLimit() const { return Q_LIKELY(!d) || acquireRateLimitToken(); }
+
     // allows usage of both factory method and variable in qCX macros
     QLoggingCategory &operator()() { return *this; }
     const QLoggingCategory &operator()() const { return *this; }
@@ -39,8 +45,9 @@ public:
 
 private:
     void init(const char *category, QtMsgType severityLevel);
+    bool acquireRateLimitToken() const;
 
-    Q_DECL_UNUSED_MEMBER void *d; // reserved for future use
+    void *d; // rate limit, if any
     const char *name;
 
     struct AtomicBools {
@@ -88,9 +95,12 @@ template <QtMsgType Which> struct QLoggingCategoryMacroHolder
             control = cat.isCriticalEnabled();
         } else if constexpr (Which == QtFatalMsg) {
             control = true;
+            return;
         } else {
             static_assert(QtPrivate::value_dependent_false<Which>(), "Unknown Qt message type");
         }
+        if (control)
+            control = cat.isWithinRateLimit();
     }
     const char *name() const { return category->categoryName(); }
     explicit operator bool() const { return Q_UNLIKELY(control); }
@@ -765,9 +765,9 @@ doExecChild(char **argv, char **envp, int workingDirFd, const QProcessPrivate *d
 
 // IMPORTANT:
 //
-// This function is called in a vfork() context on some OSes (notably, Linux
-// with forkfd), so it MUST NOT modify any non-local variable because it's
-// still sharing memory with the parent process.
+// This function is called in a vfork() context on some OSes (Linux, OpenBSD
+// and NetBSD with forkfd), so it MUST NOT modify any non-local variable
+// because it's still sharing memory with the parent process.
 void QProcessPrivate::execChild(int workingDir, char **argv, char **envp) const noexcept
 {
     QtVforkSafe::ignore_sigpipe();      // reset the signal that we ignored
@@ -5,6 +5,7 @@
 #include "qresource.h"
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
+#include "qhash.h"
 #include "qset.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
@@ -25,6 +26,8 @@
 #include "private/qtools_p.h"
 #include "private/qsystemerror_p.h"
 
+#include <algorithm>
+
 #ifndef QT_NO_COMPRESS
 #  include <zconf.h>
 #  include <zlib.h>
@@ -102,7 +105,8 @@ public:
         // must match rcc.h
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        CompressedZstdChunked = 0x08
     };
 
 private:
@@ -120,6 +124,7 @@ public:
     virtual ~QResourceRoot() { }
     int findNode(const QString &path, const QLocale &locale=QLocale()) const;
     inline bool isContainer(int node) const { return flags(node) & Directory; }
+    inline bool isChunked(int node) const { return flags(node) & CompressedZstdChunked; }
     QResource::Compression compressionAlgo(int node)
     {
         uint compressionFlags = flags(node) & (Compressed | CompressedZstd);
@@ -163,10 +168,24 @@ static QString cleanPath(const QString &_path)
 Q_DECLARE_TYPEINFO(QResourceRoot, Q_RELOCATABLE_TYPE);
 
 typedef QList<QResourceRoot*> ResourceList;
+
+struct QResourceNode
+{
+    QResourceRoot *root;
+    int node;           // -1 if the path is a parent of the root's mapping root
+};
+Q_DECLARE_TYPEINFO(QResourceNode, Q_PRIMITIVE_TYPE);
+typedef QList<QResourceNode> ResourceNodeList;
+
 struct QResourceGlobalData
 {
     QRecursiveMutex resourceMutex;
     ResourceList resourceList;
+
+    // Memoized results of looking up a path in every root of resourceList,
+    // keyed by the path and the locale. Must be cleared whenever
+    // resourceList changes, as it holds pointers to the roots.
+    QHash<std::pair<QString, quint32>, ResourceNodeList> nodeCache;
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
@@ -176,6 +195,9 @@ static inline QRecursiveMutex &resourceMutex()
 static inline ResourceList *resourceList()
 { return &resourceGlobalData->resourceList; }
 
+static inline void resourceListChanged()
+{ resourceGlobalData->nodeCache.clear(); }
+
 /*!
     \class QResource
     \inmodule QtCore
@@ -275,7 +297,8 @@ public:
     mutable QStringList children;
     mutable quint8 compressionAlgo;
     bool container;
-    /* 2 or 6 padding bytes */
+    bool chunked;
+    /* 1 or 5 padding bytes */
 
     QResource *q_ptr;
     Q_DECLARE_PUBLIC(QResource)
@@ -290,6 +313,7 @@ void QResourcePrivate::clear()
     children.clear();
     lastModified = 0;
     container = 0;
+    chunked = false;
     for (int i = 0; i < related.size(); ++i) {
         QResourceRoot *root = related.at(i);
         if (!root->ref.deref())
@@ -298,25 +322,55 @@ void QResourcePrivate::clear()
     related.clear();
 }
 
+// must be called with resourceMutex() locked
+static const ResourceNodeList &findResourceNodes(const QString &file, const QLocale &locale)
+{
+    // Large applications do tens of thousands of lookups, many of them for
+    // files that don't exist, against many roots. Don't let the cache grow
+    // without bounds if someone probes random paths, though.
+    constexpr qsizetype MaxCachedPaths = 16 * 1024;
+
+    QResourceGlobalData *global = resourceGlobalData;
+    const std::pair<QString, quint32> key(file, quint32(locale.language()) << 16
+                                                | quint32(locale.territory()));
+    auto it = global->nodeCache.constFind(key);
+    if (it != global->nodeCache.constEnd())
+        return *it;
+
+    if (global->nodeCache.size() >= MaxCachedPaths)
+        global->nodeCache.clear();
+
+    ResourceNodeList nodes;
+    const QString cleaned = cleanPath(file);
+    for (QResourceRoot *res : std::as_const(global->resourceList)) {
+        const int node = res->findNode(cleaned, locale);
+        if (node != -1)
+            nodes.append({ res, node });
+        else if (res->mappingRootSubdir(file))
+            nodes.append({ res, -1 });
+    }
+    return *global->nodeCache.insert(key, std::move(nodes));
+}
+
 bool QResourcePrivate::load(const QString &file)
 {
     related.clear();
     const auto locker = qt_scoped_lock(resourceMutex());
-    const ResourceList *list = resourceList();
-    QString cleaned = cleanPath(file);
-    for (int i = 0; i < list->size(); ++i) {
-        QResourceRoot *res = list->at(i);
-        const int node = res->findNode(cleaned, locale);
+    for (const QResourceNode &match : findResourceNodes(file, locale)) {
+        QResourceRoot *res = match.root;
+        const int node = match.node;
         if (node != -1) {
             if (related.isEmpty()) {
                 container = res->isContainer(node);
                 if (!container) {
                     data = res->data(node, &size);
                     compressionAlgo = res->compressionAlgo(node);
+                    chunked = res->isChunked(node);
                 } else {
                     data = nullptr;
                     size = 0;
                     compressionAlgo = QResource::NoCompression;
+                    chunked = false;
                 }
                 lastModified = res->lastModified(node);
             } else if (res->isContainer(node) != container) {
@@ -325,11 +379,12 @@ bool QResourcePrivate::load(const QString &file)
             }
             res->ref.ref();
             related.append(res);
-        } else if (res->mappingRootSubdir(file)) {
+        } else {
             container = true;
             data = nullptr;
             size = 0;
             compressionAlgo = QResource::NoCompression;
+            chunked = false;
             lastModified = 0;
             res->ref.ref();
             related.append(res);
@@ -411,8 +466,22 @@ qint64 QResourcePrivate::uncompressedSize() const
 
     case QResource::ZstdCompression: {
 #if QT_CONFIG(zstd)
-        size_t n = ZSTD_getFrameContentSize(data, size);
-        return ZSTD_isError(n) ? -1 : qint64(n);
+        if (!chunked) {
+            size_t n = ZSTD_getFrameContentSize(data, size);
+            return ZSTD_isError(n) ? -1 : qint64(n);
+        }
+
+        // rcc -zstd-chunked stores a sequence of independent frames
+        qint64 total = 0;
+        for (qint64 offset = 0; offset < size; ) {
+            size_t frameSize = ZSTD_findFrameCompressedSize(data + offset, size - offset);
+            size_t n = ZSTD_getFrameContentSize(data + offset, size - offset);
+            if (ZSTD_isError(frameSize) || ZSTD_isError(n))
+                return -1;
+            total += n;
+            offset += frameSize;
+        }
+        return total;
 #else
         // This should not happen because we've refused to load such resource
         Q_ASSERT(!"QResource: Qt built without support for Zstd compression");
@@ -988,6 +1057,7 @@ Q_CORE_EXPORT bool qRegisterResourceData(int version, const unsigned char *tree,
             QResourceRoot *root = new QResourceRoot(version, tree, name, data);
             root->ref.ref();
             list->append(root);
+            resourceListChanged();
         }
         return true;
     }
@@ -1007,6 +1077,7 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
         for (int i = 0; i < list->size();) {
             if (*list->at(i) == res) {
                 QResourceRoot *root = list->takeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref())
                     delete root;
             } else {
@@ -1077,7 +1148,7 @@ public:
         acceptableFlags |= Compressed;
 #endif
         if (QT_CONFIG(zstd))
-            acceptableFlags |= CompressedZstd;
+            acceptableFlags |= CompressedZstd | CompressedZstdChunked;
         if (file_flags & ~acceptableFlags)
             return false;
 
@@ -1217,6 +1288,7 @@ bool QResource::registerResource(const QString &rccFilename, const QString &reso
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
         resourceList()->append(root);
+        resourceListChanged();
         return true;
     }
     delete root;
@@ -1246,6 +1318,7 @@ bool QResource::unregisterResource(const QString &rccFilename, const QString &re
             QDynamicFileResourceRoot *root = reinterpret_cast<QDynamicFileResourceRoot *>(res);
             if (root->mappingFile() == rccFilename && root->mappingRoot() == r) {
                 list->removeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1286,6 +1359,7 @@ bool QResource::registerResource(const uchar *rccData, const QString &resourceRo
         root->ref.ref();
         const auto locker = qt_scoped_lock(resourceMutex());
         resourceList()->append(root);
+        resourceListChanged();
         return true;
     }
     delete root;
@@ -1315,6 +1389,7 @@ bool QResource::unregisterResource(const uchar *rccData, const QString &resource
             QDynamicBufferResourceRoot *root = reinterpret_cast<QDynamicBufferResourceRoot *>(res);
             if (root->mappingBuffer() == rccData && root->mappingRoot() == r) {
                 list->removeAt(i);
+                resourceListChanged();
                 if (!root->ref.deref()) {
                     delete root;
                     return true;
@@ -1336,11 +1411,29 @@ private:
     uchar *map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags);
     bool unmap(uchar *ptr);
     void uncompress() const;
+    bool indexFrames();
+    qint64 readFrames(char *data, qint64 len);
     qint64 offset;
     QResource resource;
     mutable QByteArray uncompressed;
+#if QT_CONFIG(zstd)
+    // Resources compressed with rcc -zstd-chunked are made of independent
+    // frames. Instead of decompressing everything on open(), we record where
+    // each frame starts and decompress only the ones that are read.
+    struct Frame {
+        qint64 compressedOffset;
+        qint64 uncompressedOffset;
+    };
+    QList<Frame> frames;        // with a trailing end marker
+    QByteArray frameBuffer;
+    qsizetype bufferedFrame = -1;
+    ZSTD_DCtx *zstdContext = nullptr;
+#endif
 protected:
     QResourceFileEnginePrivate() : offset(0) { }
+#if QT_CONFIG(zstd)
+    ~QResourceFileEnginePrivate() { ZSTD_freeDCtx(zstdContext); }
+#endif
 };
 
 bool QResourceFileEngine::caseSensitive() const
@@ -1377,7 +1470,7 @@ bool QResourceFileEngine::open(QIODevice::OpenMode flags,
     }
     if (flags & QIODevice::WriteOnly)
         return false;
-    if (d->resource.compressionAlgorithm() != QResource::NoCompression) {
+    if (d->resource.compressionAlgorithm() != QResource::NoCompression && !d->indexFrames()) {
         d->uncompress();
         if (d->uncompressed.isNull()) {
             d->errorString = QSystemError::stdString(EIO);
@@ -1410,6 +1503,15 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
         len = size() - d->offset;
     if (len <= 0)
         return 0;
+#if QT_CONFIG(zstd)
+    if (!d->frames.isEmpty()) {
+        len = d->readFrames(data, len);
+        if (len < 0) {
+            setError(QFile::ReadError, QSystemError::stdString(EIO));
+            return -1;
+        }
+    } else
+#endif
     if (!d->uncompressed.isNull())
         memcpy(data, d->uncompressed.constData() + d->offset, len);
     else
@@ -1421,6 +1523,10 @@ qint64 QResourceFileEngine::read(char *data, qint64 len)
 qint64 QResourceFileEngine::size() const
 {
     Q_D(const QResourceFileEngine);
+#if QT_CONFIG(zstd)
+    if (!d->frames.isEmpty())
+        return d->frames.constLast().uncompressedOffset;
+#endif
     return d->resource.isValid() ? d->resource.uncompressedSize() : 0;
 }
 
@@ -1594,6 +1700,93 @@ void QResourceFileEnginePrivate::uncompress() const
     uncompressed = resource.uncompressedData();
 }
 
+bool QResourceFileEnginePrivate::indexFrames()
+{
+#if QT_CONFIG(zstd)
+    if (!frames.isEmpty())
+        return true;
+    if (resource.compressionAlgorithm() != QResource::ZstdCompression)
+        return false;
+
+    const uchar *data = resource.data();
+    const qint64 size = resource.size();
+    QList<Frame> index;
+    qint64 uncompressedOffset = 0;
+    for (qint64 compressedOffset = 0; compressedOffset < size; ) {
+        size_t frameSize = ZSTD_findFrameCompressedSize(data + compressedOffset,
+                                                        size - compressedOffset);
+        size_t n = ZSTD_getFrameContentSize(data + compressedOffset, size - compressedOffset);
+        if (ZSTD_isError(frameSize) || ZSTD_isError(n))
+            return false;
+        if (qint64(frameSize) == size)
+            return false;   // a single frame is best decompressed in one go
+        index.append({ compressedOffset, uncompressedOffset });
+        compressedOffset += frameSize;
+        uncompressedOffset += n;
+    }
+    index.append({ size, uncompressedOffset });
+    frames = std::move(index);
+    return true;
+#else
+    return false;
+#endif
+}
+
+qint64 QResourceFileEnginePrivate::readFrames(char *data, qint64 len)
+{
+#if QT_CONFIG(zstd)
+    const auto frameAfter = std::upper_bound(frames.cbegin(), frames.cend(), offset,
+                                             [](qint64 pos, const Frame &frame) {
+        return pos < frame.uncompressedOffset;
+    });
+    qsizetype i = std::distance(frames.cbegin(), frameAfter) - 1;
+
+    if (!zstdContext)
+        zstdContext = ZSTD_createDCtx();
+
+    qint64 done = 0;
+    while (done < len) {
+        const Frame &frame = frames.at(i);
+        const Frame &next = frames.at(i + 1);
+        const uchar *src = resource.data() + frame.compressedOffset;
+        const size_t srcSize = next.compressedOffset - frame.compressedOffset;
+        const qint64 frameSize = next.uncompressedOffset - frame.uncompressedOffset;
+        const qint64 frameOffset = offset + done - frame.uncompressedOffset;
+        const qint64 chunk = qMin(len - done, frameSize - frameOffset);
+
+        if (frameOffset == 0 && chunk == frameSize && i != bufferedFrame) {
+            // the whole frame is wanted, so skip the intermediate buffer
+            size_t n = ZSTD_decompressDCtx(zstdContext, data + done, chunk, src, srcSize);
+            if (ZSTD_isError(n) || qint64(n) != chunk) {
+                qWarning("QResource: error decompressing zstd content: %s", ZSTD_getErrorName(n));
+                return -1;
+            }
+        } else {
+            if (i != bufferedFrame) {
+                bufferedFrame = -1;
+                frameBuffer.resize(frameSize);
+                size_t n = ZSTD_decompressDCtx(zstdContext, frameBuffer.data(), frameSize,
+                                               src, srcSize);
+                if (ZSTD_isError(n) || qint64(n) != frameSize) {
+                    qWarning("QResource: error decompressing zstd content: %s",
+                             ZSTD_getErrorName(n));
+                    return -1;
+                }
+                bufferedFrame = i;
+            }
+            memcpy(data + done, frameBuffer.constData() + frameOffset, chunk);
+        }
+        done += chunk;
+        ++i;
+    }
+    return done;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+#endif
+}
+
 #endif // !defined(QT_BOOTSTRAPPED)
 
 QT_END_NAMESPACE
@@ -1358,6 +1358,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 
     if (mustReadFile) {
         confFile->unparsedIniSections.clear();
+        confFile->unparsedIniData.clear();
         confFile->originalKeys.clear();
 
         QFile file(confFile->name);
@@ -1379,8 +1380,8 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
             } else
 #endif
             if (format <= QSettings::IniFormat) {
-                QByteArray data = file.readAll();
-                ok = readIniFile(data, &confFile->unparsedIniSections);
+                confFile->unparsedIniData = file.readAll();
+                ok = readIniFile(confFile->unparsedIniData, &confFile->unparsedIniSections);
             } else if (readFunc) {
                 QSettings::SettingsMap tempNewKeys;
                 ok = readFunc(file, tempNewKeys);
@@ -1453,6 +1454,7 @@ void QConfFileSettingsPrivate::syncConfFile(QConfFile *confFile)
 
         if (ok) {
             confFile->unparsedIniSections.clear();
+            confFile->unparsedIniData.clear();
             confFile->originalKeys = mergedKeys;
             confFile->addedKeys.clear();
             confFile->removedKeys.clear();
@@ -1571,6 +1573,9 @@ break_out_of_outer_loop:
     Returns \c false on parse error. However, as many keys are read as
     possible, so if the user doesn't check the status he will get the
     most out of the file anyway.
+
+    The unparsed sections refer to \a data without copying it, unless a
+    section appears more than once, so \a data must outlive them.
 */
 bool QConfFileSettingsPrivate::readIniFile(QByteArrayView data,
                                            UnparsedSettingsMap *unparsedIniSections)
@@ -1580,9 +1585,13 @@ bool QConfFileSettingsPrivate::readIniFile(QByteArrayView data,
         QByteArray &sectionData = (*unparsedIniSections)[QSettingsKey(currentSection, \
                                                                       IniCaseSensitivity, \
                                                                       sectionPosition)]; \
-        if (!sectionData.isEmpty()) \
+        const QByteArrayView sectionBytes = data.first(lineStart).sliced(currentSectionStart); \
+        if (sectionData.isEmpty()) { \
+            sectionData = QByteArray::fromRawData(sectionBytes.data(), sectionBytes.size()); \
+        } else { \
             sectionData.append('\n'); \
-        sectionData += data.first(lineStart).sliced(currentSectionStart); \
+            sectionData += sectionBytes; \
+        } \
         sectionPosition = ++position; \
     }
 
@@ -1825,6 +1834,7 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
             setStatus(QSettings::FormatError);
     }
     confFile->unparsedIniSections.clear();
+    confFile->unparsedIniData.clear();
 }
 
 void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
@@ -1852,6 +1862,8 @@ void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
     if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
         setStatus(QSettings::FormatError);
     confFile->unparsedIniSections.erase(i);
+    if (confFile->unparsedIniSections.isEmpty())
+        confFile->unparsedIniData.clear();
 }
 
 /*!
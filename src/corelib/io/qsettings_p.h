@@ -127,6 +127,8 @@ public:
     QDateTime timeStamp;
     qint64 size;
     UnparsedSettingsMap unparsedIniSections;
+    // The file contents that unparsedIniSections refer to
+    QByteArray unparsedIniData;
     ParsedSettingsMap originalKeys;
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
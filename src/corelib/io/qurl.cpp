@@ -404,6 +404,8 @@
 #include "private/qdir_p.h"
 #include <private/qtools_p.h>
 
+#include <string_view>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -530,9 +532,10 @@ public:
     void setUserName(const QString &value, qsizetype from, qsizetype end);
     void setPassword(const QString &value, qsizetype from, qsizetype end);
     bool setHost(const QString &value, qsizetype from, qsizetype end, QUrl::ParsingMode mode);
-    void setPath(const QString &value, qsizetype from, qsizetype end);
-    void setQuery(const QString &value, qsizetype from, qsizetype end);
-    void setFragment(const QString &value, qsizetype from, qsizetype end);
+    // isPlain: the value is known to need no recoding, see isPlainUrl()
+    void setPath(const QString &value, qsizetype from, qsizetype end, bool isPlain = false);
+    void setQuery(const QString &value, qsizetype from, qsizetype end, bool isPlain = false);
+    void setFragment(const QString &value, qsizetype from, qsizetype end, bool isPlain = false);
 
     inline bool hasScheme() const { return sectionIsPresent & Scheme; }
     inline bool hasAuthority() const { return sectionIsPresent & Authority; }
@@ -1103,22 +1106,28 @@ inline void QUrlPrivate::setPassword(const QString &value, qsizetype from, qsize
     password = recodeFromUser(value, passwordInIsolation, from, end);
 }
 
-inline void QUrlPrivate::setPath(const QString &value, qsizetype from, qsizetype end)
+inline void QUrlPrivate::setPath(const QString &value, qsizetype from, qsizetype end,
+                                 bool isPlain)
 {
     // sectionIsPresent |= Path; // not used, save some cycles
-    path = recodeFromUser(value, pathInIsolation, from, end);
+    path = isPlain ? value.mid(from, end - from)
+                   : recodeFromUser(value, pathInIsolation, from, end);
 }
 
-inline void QUrlPrivate::setFragment(const QString &value, qsizetype from, qsizetype end)
+inline void QUrlPrivate::setFragment(const QString &value, qsizetype from, qsizetype end,
+                                     bool isPlain)
 {
     sectionIsPresent |= Fragment;
-    fragment = recodeFromUser(value, fragmentInIsolation, from, end);
+    fragment = isPlain ? value.mid(from, end - from)
+                       : recodeFromUser(value, fragmentInIsolation, from, end);
 }
 
-inline void QUrlPrivate::setQuery(const QString &value, qsizetype from, qsizetype iend)
+inline void QUrlPrivate::setQuery(const QString &value, qsizetype from, qsizetype iend,
+                                  bool isPlain)
 {
     sectionIsPresent |= Query;
-    query = recodeFromUser(value, queryInIsolation, from, iend);
+    query = isPlain ? value.mid(from, iend - from)
+                    : recodeFromUser(value, queryInIsolation, from, iend);
 }
 
 // Host handling
@@ -1356,6 +1365,36 @@ QUrlPrivate::setHost(const QString &value, qsizetype from, qsizetype iend, QUrl:
     return true;
 }
 
+static constexpr quint64 plainUrlCharacterMask(int half) noexcept
+{
+    // the characters that validateComponent() forbids or qt_urlRecode()
+    // always encodes, and the percent sign
+    constexpr std::string_view notPlain = "\"%<>\\^`{|}";
+    quint64 mask = 0;
+    for (int c = 0x21; c < 0x7f; ++c) {
+        if (c / 64 == half && notPlain.find(char(c)) == std::string_view::npos)
+            mask |= Q_UINT64_C(1) << (c % 64);
+    }
+    return mask;
+}
+
+/*
+    Returns true if \a url consists of printable US-ASCII characters that
+    may appear in a URL as they are, and has nothing percent-encoded. The
+    path, query and fragment of such a URL are the same in all formatting
+    options and valid in StrictMode, so parse() copies them without
+    recoding or validating them. Most URLs in practice are like that.
+*/
+static bool isPlainUrl(QStringView url) noexcept
+{
+    constexpr quint64 masks[2] = { plainUrlCharacterMask(0), plainUrlCharacterMask(1) };
+    for (char16_t c : url) {
+        if (c >= 0x80 || !((masks[c / 64] >> (c % 64)) & 1))
+            return false;
+    }
+    return true;
+}
+
 inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode)
 {
     //   URI-reference = URI / relative-ref
@@ -1377,6 +1416,7 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
     const qsizetype len = url.size();
     const QChar *const begin = url.constData();
     const ushort *const data = reinterpret_cast<const ushort *>(begin);
+    const bool isPlain = isPlainUrl(url);
 
     for (qsizetype i = 0; i < len; ++i) {
         size_t uc = data[i];
@@ -1422,7 +1462,7 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
 
         // even if we failed to set the authority properly, let's try to recover
         pathStart = authorityEnd;
-        setPath(url, pathStart, hierEnd);
+        setPath(url, pathStart, hierEnd, isPlain);
     } else {
         userName.clear();
         password.clear();
@@ -1431,18 +1471,18 @@ inline void QUrlPrivate::parse(const QString &url, QUrl::ParsingMode parsingMode
         pathStart = hierStart;
 
         if (hierStart < hierEnd)
-            setPath(url, hierStart, hierEnd);
+            setPath(url, hierStart, hierEnd, isPlain);
         else
             path.clear();
     }
 
     if (size_t(question) < size_t(hash))
-        setQuery(url, question + 1, qMin<size_t>(hash, len));
+        setQuery(url, question + 1, qMin<size_t>(hash, len), isPlain);
 
     if (hash != -1)
-        setFragment(url, hash + 1, len);
+        setFragment(url, hash + 1, len, isPlain);
 
-    if (error || parsingMode == QUrl::TolerantMode)
+    if (error || parsingMode == QUrl::TolerantMode || isPlain)
         return;
 
     // The parsing so far was partially tolerant of errors, except for the
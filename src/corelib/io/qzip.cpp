@@ -8,7 +8,13 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
 
+#include <atomic>
 #include <memory>
 
 #include <zlib.h>
@@ -153,6 +159,90 @@ static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sour
     return err;
 }
 
+#if QT_CONFIG(thread)
+// Large entries are compressed in chunks on several threads, the way pigz
+// does it: each chunk is a raw deflate stream primed with the data before
+// it, and all but the last end with a sync flush instead of a final block,
+// so that they concatenate into a single deflate stream. This costs a few
+// bytes per chunk over compressing the whole entry at once.
+static constexpr qsizetype ParallelDeflateThreshold = 1024 * 1024;
+static constexpr qsizetype ParallelDeflateChunkSize = 256 * 1024;
+static constexpr qsizetype DeflateWindowSize = 1 << MAX_WBITS;
+
+static int deflateChunk(QByteArray *out, const uchar *data, qsizetype size,
+                        qsizetype dictionarySize, bool last)
+{
+    z_stream stream = {};
+    int err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    if (err != Z_OK)
+        return err;
+    if (dictionarySize)
+        err = deflateSetDictionary(&stream, data - dictionarySize, uInt(dictionarySize));
+    if (err == Z_OK) {
+        // leave room for the empty stored block written by the sync flush
+        out->resize(qsizetype(deflateBound(&stream, uLong(size))) + 16);
+        stream.next_in = const_cast<Bytef *>(data);
+        stream.avail_in = uInt(size);
+        stream.next_out = reinterpret_cast<Bytef *>(out->data());
+        stream.avail_out = uInt(out->size());
+        err = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        const bool complete = last ? err == Z_STREAM_END
+                                   : err == Z_OK && stream.avail_in == 0 && stream.avail_out != 0;
+        if (complete) {
+            out->resize(qsizetype(stream.total_out));
+            err = Z_OK;
+        } else if (err == Z_OK || err == Z_STREAM_END) {
+            err = Z_BUF_ERROR;
+        }
+    }
+    deflateEnd(&stream);
+    return err;
+}
+
+static int parallelDeflate(QByteArray *out, const QByteArray &contents)
+{
+    const auto data = reinterpret_cast<const uchar *>(contents.constData());
+    const qsizetype chunkCount = (contents.size() + ParallelDeflateChunkSize - 1) / ParallelDeflateChunkSize;
+    QList<QByteArray> chunks(chunkCount);
+    QList<int> results(chunkCount, Z_OK);
+    QByteArray *const chunkData = chunks.data();
+    int *const resultData = results.data();
+
+    std::atomic<qsizetype> nextChunk = 0;
+    auto work = [&] {
+        for (qsizetype i = nextChunk++; i < chunkCount; i = nextChunk++) {
+            const qsizetype offset = i * ParallelDeflateChunkSize;
+            resultData[i] = deflateChunk(&chunkData[i], data + offset,
+                                         qMin(ParallelDeflateChunkSize, contents.size() - offset),
+                                         qMin(DeflateWindowSize, offset), i == chunkCount - 1);
+        }
+    };
+
+    // This thread takes chunks too, and only helpers that could be started
+    // right away are waited for, so this can't deadlock on a busy pool
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore helpersDone;
+    int helpers = 0;
+    const qsizetype maxHelpers = qMin(qsizetype(QThread::idealThreadCount()), chunkCount) - 1;
+    while (helpers < maxHelpers && pool->tryStart([&] { work(); helpersDone.release(); }))
+        ++helpers;
+    work();
+    helpersDone.acquire(helpers);
+
+    qsizetype size = 0;
+    for (qsizetype i = 0; i < chunkCount; ++i) {
+        if (results.at(i) != Z_OK)
+            return results.at(i);
+        size += chunks.at(i).size();
+    }
+    out->clear();
+    out->reserve(size);
+    for (const QByteArray &chunk : std::as_const(chunks))
+        out->append(chunk);
+    return Z_OK;
+}
+#endif // QT_CONFIG(thread)
+
 
 namespace WindowsFileAttributes {
 enum {
@@ -644,11 +734,17 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     if (compression == QZipWriter::AlwaysCompress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
 
+        int res = Z_BUF_ERROR;
+#if QT_CONFIG(thread)
+        // compressing on this thread only is the fallback if that fails
+        if (contents.size() >= ParallelDeflateThreshold && QThread::idealThreadCount() > 1)
+            res = parallelDeflate(&data, contents);
+#endif
+
        ulong len = contents.size();
         // shamelessly copied form zlib
         len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
+        while (res != Z_OK) {
             data.resize(len);
             res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.size());
 
@@ -664,7 +760,9 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
                 len *= 2;
                 break;
             }
-        } while (res == Z_BUF_ERROR);
+            if (res != Z_BUF_ERROR)
+                break;
+        }
     }
 // TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
     writeUInt(header.h.compressed_size, data.size());
@@ -0,0 +1,326 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsharedmemorychannel_p.h"
+
+#include <QtCore/qcoreapplication.h>
+
+#include <atomic>
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static constexpr quint32 ChannelMagic = 0x51534d43;     // "QSMC"
+static constexpr quint32 ChannelVersion = 1;
+
+// Each frame starts with the size of the message and is padded to 8 bytes,
+// so that a frame header never straddles the end of the ring
+static constexpr quint64 FrameAlignment = 8;
+static constexpr quint64 FrameHeaderSize = 8;
+static constexpr quint32 WrapMarker = 0xffffffff;
+
+/*!
+    \internal
+    The start of the segment, followed by the ring. head and tail count the
+    bytes ever written and consumed, so the ring is empty when they are
+    equal; they are only written by the producer and the consumer
+    respectively, and are kept on cache lines of their own.
+*/
+struct QSharedMemoryChannel::Header
+{
+    std::atomic<quint32> magic = 0;
+    quint32 version = ChannelVersion;
+    quint64 capacity = 0;
+    alignas(64) std::atomic<quint64> head = 0;
+    alignas(64) std::atomic<quint64> tail = 0;
+    alignas(64) std::atomic<int> consumerWaiting = 0;
+    std::atomic<int> producerWaiting = 0;
+};
+
+// The atomics are shared between processes
+static_assert(std::atomic<quint64>::is_always_lock_free);
+static_assert(std::atomic<int>::is_always_lock_free);
+
+static quint64 frameSizeFor(qsizetype messageSize) noexcept
+{
+    return (FrameHeaderSize + quint64(messageSize) + FrameAlignment - 1) & ~(FrameAlignment - 1);
+}
+
+/*!
+    \internal
+    \class QSharedMemoryChannel
+    \inmodule QtCore
+    \since 6.7
+
+    Passes messages from one process to another through a ring buffer in
+    shared memory. \a name identifies the channel: it is turned into the
+    keys of the QSharedMemory segment and of the two QSystemSemaphores with
+    platformSafeKey().
+
+    One process calls create() and the other attach(); then one of them
+    only calls send() or trySend(), and the other only peek(), tryPeek(),
+    pop() and receive().
+
+    A blocked call only returns when the other side makes progress, so a
+    side must not block on a peer that may have exited; and a thread
+    running an event loop should use tryPeek() or trySend() instead.
+*/
+
+QSharedMemoryChannel::QSharedMemoryChannel(const QString &name)
+    : name(name), dataAvailable(QNativeIpcKey()), spaceAvailable(QNativeIpcKey())
+{
+}
+
+QSharedMemoryChannel::~QSharedMemoryChannel()
+{
+    if (memory.isAttached())
+        memory.detach();
+}
+
+void QSharedMemoryChannel::setKeys(QSystemSemaphore::AccessMode mode)
+{
+    memory.setNativeKey(QSharedMemory::platformSafeKey(name));
+    dataAvailable.setNativeKey(QSystemSemaphore::platformSafeKey(name + u"-data"_s), 0, mode);
+    spaceAvailable.setNativeKey(QSystemSemaphore::platformSafeKey(name + u"-space"_s), 0, mode);
+}
+
+/*!
+    \internal
+    Creates the channel with room for \a capacity bytes of frames, rounded
+    up to a multiple of 8. Each message takes 8 bytes more than its size,
+    rounded up to a multiple of 8. Returns \c false if the segment could
+    not be created, for instance because the channel exists already.
+*/
+bool QSharedMemoryChannel::create(qsizetype capacity)
+{
+    static_assert(sizeof(Header) % FrameAlignment == 0);
+    Q_ASSERT(!header);
+    const quint64 ringSize =
+            (quint64(qMax(capacity, qsizetype(64))) + FrameAlignment - 1) & ~(FrameAlignment - 1);
+
+    // The semaphores must exist by the time attach() can see the header
+    setKeys(QSystemSemaphore::Create);
+    if (!memory.create(qsizetype(sizeof(Header) + ringSize))) {
+        error = memory.errorString();
+        return false;
+    }
+
+    header = new (memory.data()) Header;
+    header->capacity = ringSize;
+    ring = static_cast<char *>(memory.data()) + sizeof(Header);
+    header->magic.store(ChannelMagic, std::memory_order_release);
+    return true;
+}
+
+/*!
+    \internal
+    Attaches to a channel created by another QSharedMemoryChannel with the
+    same name.
+*/
+bool QSharedMemoryChannel::attach()
+{
+    Q_ASSERT(!header);
+    setKeys(QSystemSemaphore::Open);
+    if (!memory.attach()) {
+        error = memory.errorString();
+        return false;
+    }
+
+    auto candidate = static_cast<Header *>(memory.data());
+    if (size_t(memory.size()) < sizeof(Header)
+            || candidate->magic.load(std::memory_order_acquire) != ChannelMagic
+            || candidate->version != ChannelVersion
+            || size_t(memory.size()) < sizeof(Header) + candidate->capacity) {
+        error = QCoreApplication::translate("QSharedMemoryChannel",
+                                            "%1: not a channel").arg(name);
+        memory.detach();
+        return false;
+    }
+
+    header = candidate;
+    ring = static_cast<char *>(memory.data()) + sizeof(Header);
+    return true;
+}
+
+qsizetype QSharedMemoryChannel::capacity() const noexcept
+{
+    return header ? qsizetype(header->capacity) : 0;
+}
+
+/*!
+    \internal
+    Returns the size of the largest message that can be sent. It is limited
+    to half of the ring, so that a message always fits once the consumer
+    has caught up, wherever the previous one ended.
+*/
+qsizetype QSharedMemoryChannel::maxMessageSize() const noexcept
+{
+    return header ? qsizetype(header->capacity / 2 - FrameHeaderSize) : 0;
+}
+
+/*!
+    \internal
+    Appends \a message to the channel, waiting for the consumer to make
+    room for it if needed. Returns \c false if the message is too large or
+    waiting failed.
+*/
+bool QSharedMemoryChannel::send(QByteArrayView message)
+{
+    return write(message, true);
+}
+
+/*!
+    \internal
+    Appends \a message to the channel if there is room for it right now.
+*/
+bool QSharedMemoryChannel::trySend(QByteArrayView message)
+{
+    return write(message, false);
+}
+
+bool QSharedMemoryChannel::write(QByteArrayView message, bool wait)
+{
+    Q_ASSERT(header);
+    if (message.size() > maxMessageSize()) {
+        error = QCoreApplication::translate("QSharedMemoryChannel",
+                                            "%1: message too large").arg(name);
+        return false;
+    }
+
+    const quint64 capacity = header->capacity;
+    const quint64 frameSize = frameSizeFor(message.size());
+    quint64 head = header->head.load(std::memory_order_relaxed);
+    const quint64 contiguous = capacity - head % capacity;
+    // a frame that doesn't fit before the end of the ring starts over at
+    // its beginning, wasting the rest
+    const quint64 needed = frameSize <= contiguous ? frameSize : contiguous + frameSize;
+    auto hasRoom = [&] { return capacity - (head - header->tail.load()) >= needed; };
+
+    while (!hasRoom()) {
+        if (!wait)
+            return false;
+        // Announce that we are going to sleep, then check again: either we
+        // see the consumer's progress, or it sees the flag and wakes us up.
+        // A wakeup may be left over from a previous round, hence the loop.
+        header->producerWaiting.store(1);
+        if (hasRoom()) {
+            header->producerWaiting.store(0, std::memory_order_relaxed);
+            break;
+        }
+        if (!spaceAvailable.acquire()) {
+            error = spaceAvailable.errorString();
+            return false;
+        }
+    }
+
+    if (frameSize > contiguous) {
+        memcpy(ring + head % capacity, &WrapMarker, sizeof(WrapMarker));
+        head += contiguous;
+    }
+    char *frame = ring + head % capacity;
+    const quint32 size = quint32(message.size());
+    memcpy(frame, &size, sizeof(size));
+    memcpy(frame + FrameHeaderSize, message.data(), size_t(message.size()));
+    header->head.store(head + frameSize);
+
+    if (header->consumerWaiting.exchange(0))
+        dataAvailable.release();
+    return true;
+}
+
+/*!
+    \internal
+    Returns the oldest message in the channel, waiting for one if there is
+    none. The view points into shared memory and stays valid until pop() is
+    called. Returns a null view if waiting failed.
+*/
+QByteArrayView QSharedMemoryChannel::peek()
+{
+    QByteArrayView message;
+    readFrame(&message, true);
+    return message;
+}
+
+/*!
+    \internal
+    Sets \a message to the oldest message in the channel and returns \c true
+    if there is one.
+*/
+bool QSharedMemoryChannel::tryPeek(QByteArrayView *message)
+{
+    return readFrame(message, false);
+}
+
+/*!
+    \internal
+    Removes the message returned by the last peek() or tryPeek() from the
+    channel, letting the producer reuse its space.
+*/
+void QSharedMemoryChannel::pop()
+{
+    Q_ASSERT(currentFrameSize);
+    advanceTail(header->tail.load(std::memory_order_relaxed) + currentFrameSize);
+    currentFrameSize = 0;
+}
+
+/*!
+    \internal
+    Returns a copy of the oldest message in the channel and removes it,
+    waiting for one if there is none.
+*/
+QByteArray QSharedMemoryChannel::receive()
+{
+    const QByteArrayView message = peek();
+    if (message.isNull())
+        return {};
+    QByteArray result = message.toByteArray();
+    pop();
+    return result;
+}
+
+bool QSharedMemoryChannel::readFrame(QByteArrayView *message, bool wait)
+{
+    Q_ASSERT(header);
+    const quint64 capacity = header->capacity;
+    quint64 tail = header->tail.load(std::memory_order_relaxed);
+
+    for (;;) {
+        if (header->head.load(std::memory_order_acquire) == tail) {
+            if (!wait)
+                return false;
+            // see write()
+            header->consumerWaiting.store(1);
+            if (header->head.load() != tail) {
+                header->consumerWaiting.store(0, std::memory_order_relaxed);
+            } else if (!dataAvailable.acquire()) {
+                error = dataAvailable.errorString();
+                return false;
+            }
+            continue;
+        }
+
+        const quint64 offset = tail % capacity;
+        quint32 size;
+        memcpy(&size, ring + offset, sizeof(size));
+        if (size == WrapMarker) {
+            tail += capacity - offset;
+            advanceTail(tail);
+            continue;
+        }
+
+        currentFrameSize = frameSizeFor(size);
+        *message = QByteArrayView(ring + offset + FrameHeaderSize, qsizetype(size));
+        return true;
+    }
+}
+
+void QSharedMemoryChannel::advanceTail(quint64 tail)
+{
+    header->tail.store(tail);
+    if (header->producerWaiting.exchange(0))
+        spaceAvailable.release();
+}
+
+QT_END_NAMESPACE
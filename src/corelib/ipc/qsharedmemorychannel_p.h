@@ -0,0 +1,86 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSHAREDMEMORYCHANNEL_P_H
+#define QSHAREDMEMORYCHANNEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qsharedmemory.h>
+#include <QtCore/qsystemsemaphore.h>
+
+QT_REQUIRE_CONFIG(sharedmemory);
+QT_REQUIRE_CONFIG(systemsemaphore);
+
+QT_BEGIN_NAMESPACE
+
+// A one-way channel of messages between two processes: a ring buffer in a
+// QSharedMemory segment, where the producer appends length-prefixed frames
+// and the consumer reads them in place. Both ends only touch their own
+// position in the ring, so passing a message takes no lock and no system
+// call. A side only sleeps, on one of two QSystemSemaphores, when the ring
+// is empty or full, after announcing it in the segment so that the other
+// side knows to wake it up.
+//
+// There must be one producer and one consumer at a time, be they in the
+// same process or not.
+class Q_CORE_EXPORT QSharedMemoryChannel
+{
+public:
+    explicit QSharedMemoryChannel(const QString &name);
+    ~QSharedMemoryChannel();
+    Q_DISABLE_COPY_MOVE(QSharedMemoryChannel)
+
+    // capacity is rounded up to a multiple of 8 bytes
+    bool create(qsizetype capacity);
+    bool attach();
+    bool isValid() const noexcept { return header != nullptr; }
+    QString errorString() const { return error; }
+
+    qsizetype capacity() const noexcept;
+    qsizetype maxMessageSize() const noexcept;
+
+    // Producer side: blocks while the ring is full
+    bool send(QByteArrayView message);
+    bool trySend(QByteArrayView message);
+
+    // Consumer side: the view returned by peek() points into the ring and
+    // stays valid until pop()
+    QByteArrayView peek();
+    bool tryPeek(QByteArrayView *message);
+    void pop();
+    QByteArray receive();
+
+private:
+    struct Header;
+
+    void setKeys(QSystemSemaphore::AccessMode mode);
+    bool write(QByteArrayView message, bool wait);
+    bool readFrame(QByteArrayView *message, bool wait);
+    void advanceTail(quint64 tail);
+
+    QString name;
+    QString error;
+    QSharedMemory memory;
+    QSystemSemaphore dataAvailable;
+    QSystemSemaphore spaceAvailable;
+    Header *header = nullptr;
+    char *ring = nullptr;
+    quint64 currentFrameSize = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSHAREDMEMORYCHANNEL_P_H
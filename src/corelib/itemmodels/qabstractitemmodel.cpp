@@ -3671,6 +3671,55 @@ void QAbstractItemModel::multiData(const QModelIndex &index, QModelRoleDataSpan
         d.setData(data(index, d.role()));
 }
 
+/*!
+    \since 6.7
+
+    Fills the \a roleDataSpan with the requested data for all the items
+    from \a topLeft to \a bottomRight, which must have the same parent.
+
+    The span holds one group of QModelRoleData objects for every item in
+    the range, row by row, and within a row column by column. All groups
+    have the same size, so the span's size must be a multiple of the number
+    of items. The roles in the groups are usually the same, but do not have
+    to be.
+
+    \snippet code/src_corelib_kernel_qabstractitemmodel.cpp 17
+
+    The default implementation calls multiData() for each item in the range.
+    A subclass can reimplement this function to look up the storage for a
+    whole block of rows and columns at once, for example to read all
+    visible rows of a table from a contiguous buffer. The same rules as for
+    multiData() apply: the data for a role that the model cannot provide
+    must be cleared, and the roles in the span must not be modified.
+
+    \note It is illegal to pass invalid model indexes to this function.
+
+    \sa multiData(), QModelRoleDataSpan
+*/
+void QAbstractItemModel::multiDataForRange(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                           QModelRoleDataSpan roleDataSpan) const
+{
+    Q_ASSERT(checkIndex(topLeft, CheckIndexOption::IndexIsValid));
+    Q_ASSERT(checkIndex(bottomRight, CheckIndexOption::IndexIsValid));
+    Q_ASSERT(topLeft.parent() == bottomRight.parent());
+
+    const int rows = bottomRight.row() - topLeft.row() + 1;
+    const int columns = bottomRight.column() - topLeft.column() + 1;
+    if (rows <= 0 || columns <= 0)
+        return;
+    const qsizetype rolesPerItem = roleDataSpan.size() / (qsizetype(rows) * columns);
+    Q_ASSERT(rolesPerItem * rows * columns == roleDataSpan.size());
+
+    const QModelIndex parent = topLeft.parent();
+    QModelRoleData *roleData = roleDataSpan.data();
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        for (int column = topLeft.column(); column <= bottomRight.column(); ++column) {
+            multiData(index(row, column, parent), QModelRoleDataSpan(roleData, rolesPerItem));
+            roleData += rolesPerItem;
+        }
+    }
+}
+
 /*!
     \class QAbstractTableModel
     \inmodule QtCore
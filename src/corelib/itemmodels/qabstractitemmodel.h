@@ -326,6 +326,8 @@ public:
     [[nodiscard]] bool checkIndex(const QModelIndex &index, CheckIndexOptions options = CheckIndexOption::NoOption) const;
 
     virtual void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const;
+    virtual void multiDataForRange(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                   QModelRoleDataSpan roleDataSpan) const;
 
 Q_SIGNALS:
     void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
@@ -559,6 +559,14 @@ void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
         QT_STRINGIFY_SLOT(_q_rowsAboutToBeInserted(QModelIndex,int,int)),
         QT_STRINGIFY_SIGNAL(columnsAboutToBeInserted(QModelIndex,int,int)),
         QT_STRINGIFY_SLOT(_q_columnsAboutToBeInserted(QModelIndex,int,int)),
+        QT_STRINGIFY_SIGNAL(rowsRemoved(QModelIndex,int,int)),
+        QT_STRINGIFY_SLOT(_q_modelChanged()),
+        QT_STRINGIFY_SIGNAL(columnsRemoved(QModelIndex,int,int)),
+        QT_STRINGIFY_SLOT(_q_modelChanged()),
+        QT_STRINGIFY_SIGNAL(rowsInserted(QModelIndex,int,int)),
+        QT_STRINGIFY_SLOT(_q_modelChanged()),
+        QT_STRINGIFY_SIGNAL(columnsInserted(QModelIndex,int,int)),
+        QT_STRINGIFY_SLOT(_q_modelChanged()),
         QT_STRINGIFY_SIGNAL(rowsAboutToBeMoved(QModelIndex,int,int,QModelIndex,int)),
         QT_STRINGIFY_SLOT(_q_layoutAboutToBeChanged()),
         QT_STRINGIFY_SIGNAL(columnsAboutToBeMoved(QModelIndex,int,int,QModelIndex,int)),
@@ -571,8 +579,12 @@ void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
         QT_STRINGIFY_SLOT(_q_layoutAboutToBeChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
         QT_STRINGIFY_SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
         QT_STRINGIFY_SLOT(_q_layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
+        QT_STRINGIFY_SIGNAL(modelAboutToBeReset()),
+        QT_STRINGIFY_SLOT(_q_modelAboutToChange()),
         QT_STRINGIFY_SIGNAL(modelReset()),
         QT_STRINGIFY_SLOT(reset()),
+        QT_STRINGIFY_SIGNAL(modelReset()),
+        QT_STRINGIFY_SLOT(_q_modelChanged()),
         QT_STRINGIFY_SIGNAL(destroyed(QObject*)),
         QT_STRINGIFY_SLOT(_q_modelDestroyed())
     );
@@ -589,6 +601,7 @@ void QItemSelectionModelPrivate::initModel(QAbstractItemModel *m)
 
     // Caller has to call notify(), unless calling during construction (the common case).
     model.setValueBypassingBindings(m);
+    _q_modelChanged();
 
     if (model.value()) {
         for (int i = 0; i < connections.count(); i += 2)
@@ -641,6 +654,7 @@ QItemSelection QItemSelectionModelPrivate::expandSelection(const QItemSelection
 void QItemSelectionModelPrivate::_q_rowsAboutToBeRemoved(const QModelIndex &parent,
                                                          int start, int end)
 {
+    _q_modelAboutToChange();
     Q_Q(QItemSelectionModel);
     Q_ASSERT(start <= end);
     finalize();
@@ -724,6 +738,7 @@ void QItemSelectionModelPrivate::_q_rowsAboutToBeRemoved(const QModelIndex &pare
 void QItemSelectionModelPrivate::_q_columnsAboutToBeRemoved(const QModelIndex &parent,
                                                             int start, int end)
 {
+    _q_modelAboutToChange();
     Q_Q(QItemSelectionModel);
 
     // update current index
@@ -761,6 +776,7 @@ void QItemSelectionModelPrivate::_q_columnsAboutToBeRemoved(const QModelIndex &p
 void QItemSelectionModelPrivate::_q_columnsAboutToBeInserted(const QModelIndex &parent,
                                                              int start, int end)
 {
+    _q_modelAboutToChange();
     Q_UNUSED(end);
     finalize();
     QList<QItemSelectionRange> split;
@@ -791,6 +807,7 @@ void QItemSelectionModelPrivate::_q_columnsAboutToBeInserted(const QModelIndex &
 void QItemSelectionModelPrivate::_q_rowsAboutToBeInserted(const QModelIndex &parent,
                                                           int start, int end)
 {
+    _q_modelAboutToChange();
     Q_Q(QItemSelectionModel);
     Q_UNUSED(end);
     finalize();
@@ -831,6 +848,7 @@ void QItemSelectionModelPrivate::_q_rowsAboutToBeInserted(const QModelIndex &par
 */
 void QItemSelectionModelPrivate::_q_layoutAboutToBeChanged(const QList<QPersistentModelIndex> &, QAbstractItemModel::LayoutChangeHint hint)
 {
+    _q_modelAboutToChange();
     savedPersistentIndexes.clear();
     savedPersistentCurrentIndexes.clear();
     savedPersistentRowLengths.clear();
@@ -996,6 +1014,8 @@ static bool qt_PersistentModelIndexLessThan(const QPersistentModelIndex &i1, con
 */
 void QItemSelectionModelPrivate::_q_layoutChanged(const QList<QPersistentModelIndex> &, QAbstractItemModel::LayoutChangeHint hint)
 {
+    _q_modelChanged();
+
     // special case for when all indexes are selected
     if (tableSelected && tableColCount == model->columnCount(tableParent)
         && tableRowCount == model->rowCount(tableParent)) {
@@ -1084,6 +1104,70 @@ void QItemSelectionModelPrivate::_q_modelDestroyed()
     model.notify();
 }
 
+/*!
+    \internal
+
+    Returns \c true if one of the valid ranges contains \a index.
+
+    Views call isSelected() for every visible item, so once the selection
+    consists of more than a handful of ranges (for instance after selecting
+    many disjoint rows with Ctrl+click), the ranges are looked up in
+    rangeIndex rather than tested one by one. The index is rebuilt on the
+    first lookup after the ranges, or the rows and columns of the model,
+    changed. While the model is changing, the persistent indexes of the
+    ranges may already have moved, so the ranges are always tested then.
+*/
+bool QItemSelectionModelPrivate::rangesContain(const QModelIndex &index) const
+{
+    constexpr qsizetype MinimumRangesToIndex = 16;
+    if (ranges.size() < MinimumRangesToIndex || modelChanging) {
+        for (const QItemSelectionRange &range : ranges) {
+            if (range.isValid() && range.contains(index))
+                return true;
+        }
+        return false;
+    }
+
+    if (rangeIndexDirty) {
+        rangeIndex.clear();
+        for (const QItemSelectionRange &range : ranges) {
+            if (range.isValid()) {
+                rangeIndex[range.parent()].push_back({range.top(), range.bottom(),
+                                                      range.left(), range.right(), 0});
+            }
+        }
+        for (std::vector<RangeSpan> &spans : rangeIndex) {
+            std::sort(spans.begin(), spans.end(), [](const RangeSpan &lhs, const RangeSpan &rhs) {
+                return lhs.top < rhs.top;
+            });
+            int maxBottom = -1;
+            for (RangeSpan &span : spans) {
+                maxBottom = qMax(maxBottom, span.bottom);
+                span.maxBottom = maxBottom;
+            }
+        }
+        rangeIndexDirty = false;
+    }
+
+    const auto spans = rangeIndex.constFind(index.parent());
+    if (spans == rangeIndex.cend())
+        return false;
+    const int row = index.row();
+    const int column = index.column();
+    // walk back from the last span starting at or above row, until
+    // none of the remaining spans reaches down to it
+    auto it = std::upper_bound(spans->cbegin(), spans->cend(), row,
+                               [](int row, const RangeSpan &span) { return row < span.top; });
+    while (it != spans->cbegin()) {
+        --it;
+        if (it->maxBottom < row)
+            break;
+        if (it->bottom >= row && it->left <= column && it->right >= column)
+            return true;
+    }
+    return false;
+}
+
 /*!
     \class QItemSelectionModel
     \inmodule QtCore
@@ -1292,6 +1376,7 @@ void QItemSelectionModel::select(const QItemSelection &selection, QItemSelection
     // it might call select() on this selection model before any such QItemSelectionModelPrivate::_q_modelReset() slot
     // is invoked, so it would not be cleared yet. We clear it invalid ranges in it here.
     d->ranges.removeIf(QtFunctionObjects::IsNotValid());
+    d->invalidateRangeIndex();
 
     QItemSelection old = d->ranges;
     old.merge(d->currentSelection, d->currentCommand);
@@ -1422,15 +1507,8 @@ bool QItemSelectionModel::isSelected(const QModelIndex &index) const
     if (d->model != index.model() || !index.isValid())
         return false;
 
-    bool selected = false;
     //  search model ranges
-    QList<QItemSelectionRange>::const_iterator it = d->ranges.begin();
-    for (; it != d->ranges.end(); ++it) {
-        if ((*it).isValid() && (*it).contains(index)) {
-            selected = true;
-            break;
-        }
-    }
+    bool selected = d->rangesContain(index);
 
     // check  currentSelection
     if (d->currentSelection.size()) {
@@ -1909,21 +1987,37 @@ void QItemSelectionModel::emitSelectionChanged(const QItemSelection &newSelectio
     QItemSelection deselected = oldSelection;
     QItemSelection selected = newSelection;
 
-    // remove equal ranges
-    bool advance;
-    for (int o = 0; o < deselected.size(); ++o) {
-        advance = true;
-        for (int s = 0; s < selected.size() && o < deselected.size();) {
-            if (deselected.at(o) == selected.at(s)) {
-                deselected.removeAt(o);
-                selected.removeAt(s);
-                advance = false;
-            } else {
-                ++s;
+    // remove equal ranges, finding them by their corners, as the selections
+    // may consist of a large number of ranges
+    using Corners = std::pair<QModelIndex, QModelIndex>;
+    const auto cornersOf = [](const QItemSelectionRange &range) {
+        return Corners(range.topLeft(), range.bottomRight());
+    };
+    QHash<Corners, QList<qsizetype>> unmatchedSelected;
+    unmatchedSelected.reserve(selected.size());
+    for (qsizetype s = 0; s < selected.size(); ++s)
+        unmatchedSelected[cornersOf(selected.at(s))].append(s);
+    QList<bool> matchedSelected(selected.size(), false);
+    deselected.removeIf([&](const QItemSelectionRange &range) {
+        const auto candidates = unmatchedSelected.find(cornersOf(range));
+        if (candidates == unmatchedSelected.end())
+            return false;
+        for (auto s = candidates->begin(); s != candidates->end(); ++s) {
+            if (selected.at(*s) == range) {
+                matchedSelected[*s] = true;
+                candidates->erase(s);
+                return true;
             }
         }
-        if (advance)
-            ++o;
+        return false;
+    });
+    if (matchedSelected.contains(true)) {
+        QItemSelection remaining;
+        for (qsizetype s = 0; s < selected.size(); ++s) {
+            if (!matchedSelected.at(s))
+                remaining.append(selected.at(s));
+        }
+        selected.swap(remaining);
     }
 
     // find intersections
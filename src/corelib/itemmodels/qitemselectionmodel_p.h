@@ -19,6 +19,10 @@
 #include "private/qobject_p.h"
 #include "private/qproperty_p.h"
 
+#include <QtCore/qhash.h>
+
+#include <vector>
+
 QT_REQUIRE_CONFIG(itemmodel);
 
 QT_BEGIN_NAMESPACE
@@ -43,9 +47,15 @@ public:
     void _q_layoutAboutToBeChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoLayoutChangeHint);
     void _q_layoutChanged(const QList<QPersistentModelIndex> &parents = QList<QPersistentModelIndex>(), QAbstractItemModel::LayoutChangeHint hint = QAbstractItemModel::NoLayoutChangeHint);
     void _q_modelDestroyed();
+    void _q_modelAboutToChange() { modelChanging = true; }
+    void _q_modelChanged() { modelChanging = false; rangeIndexDirty = true; }
+
+    void invalidateRangeIndex() { rangeIndexDirty = true; }
 
+    bool rangesContain(const QModelIndex &index) const;
     inline void remove(QList<QItemSelectionRange> &r)
     {
+        invalidateRangeIndex();
         QList<QItemSelectionRange>::const_iterator it = r.constBegin();
         for (; it != r.constEnd(); ++it)
             ranges.removeAll(*it);
@@ -53,6 +63,7 @@ public:
 
     inline void finalize()
     {
+        invalidateRangeIndex();
         ranges.merge(currentSelection, currentCommand);
         if (!currentSelection.isEmpty())  // ### perhaps this should be in QList
             currentSelection.clear();
@@ -76,6 +87,21 @@ public:
     bool tableSelected;
     QPersistentModelIndex tableParent;
     int tableColCount, tableRowCount;
+
+    // rows and columns of the valid ranges, grouped by parent and sorted by top,
+    // so that rangesContain() need not test each range of a large selection
+    struct RangeSpan
+    {
+        int top;
+        int bottom;
+        int left;
+        int right;
+        int maxBottom; // largest bottom of this span and the ones sorted before it
+    };
+    mutable QHash<QModelIndex, std::vector<RangeSpan>> rangeIndex;
+    mutable bool rangeIndexDirty = true;
+    // persistent indexes may move before the model announces that it changed
+    bool modelChanging = false;
 };
 
 QT_END_NAMESPACE
@@ -8,11 +8,24 @@
 #include <qdatetime.h>
 #include <qpair.h>
 #include <qstringlist.h>
+#if QT_CONFIG(icu)
+#include <qcollator.h>
+#include <qscopeguard.h>
+#endif
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -78,6 +91,85 @@ private:
 };
 
 
+// Filtering or sorting is only split into concurrent tasks if each of them gets at least
+// this many rows; below that, the overhead of the thread pool is larger than what is gained.
+static constexpr int MinimumRowsPerConcurrentTask = 4096;
+
+/*
+    Calls \a function for each task from 0 to \a taskCount - 1. Unless Qt was built without
+    thread support, the tasks run concurrently on the global QThreadPool and the calling thread,
+    and the function returns once all of them have finished. Tasks that the pool cannot start
+    right away run on the calling thread, so this never waits for a busy pool.
+*/
+template <typename Function>
+static void qRunConcurrentTasks(int taskCount, Function function)
+{
+#if QT_CONFIG(thread)
+    if (taskCount > 1) {
+        QThreadPool *pool = QThreadPool::globalInstance();
+        QSemaphore finished;
+        int started = 0;
+        for (int task = 1; task < taskCount; ++task) {
+            if (pool->tryStart([&function, &finished, task] { function(task); finished.release(); }))
+                ++started;
+            else
+                function(task);
+        }
+        function(0);
+        finished.acquire(started);
+        return;
+    }
+#endif
+    for (int task = 0; task < taskCount; ++task)
+        function(task);
+}
+
+/*
+    Returns the items of \a items for which \a select returns true, in their original order.
+    \a select is called concurrently from \a taskCount tasks.
+*/
+template <typename Select>
+static QList<int> qConcurrentSelect(const QList<int> &items, int taskCount, Select select)
+{
+    const qsizetype count = items.size();
+    std::unique_ptr<bool[]> selected(new bool[count]);
+    qRunConcurrentTasks(taskCount, [&](int task) {
+        const qsizetype end = count * (task + 1) / taskCount;
+        for (qsizetype i = count * task / taskCount; i < end; ++i)
+            selected[i] = select(items.at(i));
+    });
+    QList<int> result;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (selected[i])
+            result.append(items.at(i));
+    }
+    return result;
+}
+
+/*
+    Sorts \a items with \a lessThan like std::stable_sort. The items are split into
+    \a taskCount ranges, which are sorted concurrently, and then merged pairwise, with the
+    merges of each round running concurrently as well.
+*/
+template <typename LessThan>
+static void qConcurrentStableSort(QList<int> &items, int taskCount, LessThan lessThan)
+{
+    const qsizetype count = items.size();
+    int *data = items.data();
+    const auto bound = [count, taskCount](int task) { return count * qMin(task, taskCount) / taskCount; };
+    qRunConcurrentTasks(taskCount, [&](int task) {
+        std::stable_sort(data + bound(task), data + bound(task + 1), lessThan);
+    });
+    for (int width = 1; width < taskCount; width *= 2) {
+        const int merges = (taskCount + 2 * width - 1) / (2 * width);
+        qRunConcurrentTasks(merges, [&](int merge) {
+            const int first = merge * 2 * width;
+            std::inplace_merge(data + bound(first), data + bound(first + width),
+                               data + bound(first + 2 * width), lessThan);
+        });
+    }
+}
+
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
 //it avoids readding rows to the mapping that are currently being removed
@@ -166,6 +258,12 @@ public:
 
     void setDynamicSortFilterForwarder(bool enable) { q_func()->setDynamicSortFilter(enable); }
 
+    void setConcurrentSortFilterForwarder(bool enable) { q_func()->setConcurrentSortFilter(enable); }
+    void concurrentSortFilterChangedForwarder(bool enable)
+    {
+        emit q_func()->concurrentSortFilterChanged(enable);
+    }
+
     void setFilterCaseSensitivityForwarder(Qt::CaseSensitivity cs)
     {
         q_func()->setFilterCaseSensitivity(cs);
@@ -219,6 +317,11 @@ public:
             &QSortFilterProxyModelPrivate::setAutoAcceptChildRowsForwarder,
             &QSortFilterProxyModelPrivate::autoAcceptChildRowsChangedForwarder, false)
 
+    Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
+            QSortFilterProxyModelPrivate, bool, concurrent_sortfilter,
+            &QSortFilterProxyModelPrivate::setConcurrentSortFilterForwarder,
+            &QSortFilterProxyModelPrivate::concurrentSortFilterChangedForwarder, false)
+
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(QSortFilterProxyModelPrivate, bool, dynamic_sortfilter,
                                        &QSortFilterProxyModelPrivate::setDynamicSortFilterForwarder,
                                        true)
@@ -333,6 +436,37 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    int concurrent_task_count(qsizetype row_count) const;
+#if QT_CONFIG(icu)
+    // While sort_source_rows() sorts strings locale-aware, lessThan() compares
+    // collation keys of the rows instead. The keys are only created when
+    // lessThan() is first called, so reimplementations that don't call it
+    // don't pay for them.
+    struct LocaleAwareSortKeys
+    {
+        LocaleAwareSortKeys(const QModelIndex &parent, int column, const QList<int> &rows,
+                            int task_count)
+            : source_parent(parent), column(column), source_rows(rows), task_count(task_count)
+        {}
+
+        QModelIndex source_parent;
+        int column;
+        // A copy, since the rows are reordered while the keys are created
+        const QList<int> source_rows;
+        int task_count;
+        std::once_flag created;
+        bool valid = false;
+        // Index into keys by source row, -1 for an empty string
+        std::vector<qsizetype> key_index;
+        QList<QCollatorSortKey> keys;
+    };
+    mutable LocaleAwareSortKeys *sort_keys = nullptr;
+    void create_sort_keys(LocaleAwareSortKeys *sortKeys) const;
+    std::optional<bool> sort_keys_less_than(const QModelIndex &source_left,
+                                            const QModelIndex &source_right) const;
+#endif
+    QList<int> filter_source_rows(const QList<int> &source_rows, const QModelIndex &source_parent,
+                                  bool accepted, int task_count) const;
     QList<QPair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
         const QList<int> &proxy_to_source, const QList<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -484,10 +618,16 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
     Mapping *m = new Mapping;
 
     int source_rows = model->rowCount(source_parent);
-    m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
+    if (const int task_count = concurrent_task_count(source_rows); task_count > 1) {
+        QList<int> all_source_rows(source_rows);
+        std::iota(all_source_rows.begin(), all_source_rows.end(), 0);
+        m->source_rows = filter_source_rows(all_source_rows, source_parent, true, task_count);
+    } else {
+        m->source_rows.reserve(source_rows);
+        for (int i = 0; i < source_rows; ++i) {
+            if (filterAcceptsRowInternal(i, source_parent))
+                m->source_rows.append(i);
+        }
     }
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
@@ -682,18 +822,143 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
+        const int task_count = concurrent_task_count(source_rows.size());
+#if QT_CONFIG(icu)
+        // In the C locale, QCollator's sort keys don't order like its compare()
+        std::optional<LocaleAwareSortKeys> sortKeys;
+        if (sort_localeaware && source_rows.size() > 2
+            && QLocale().collation().language() != QLocale::C) {
+            sortKeys.emplace(source_parent, source_sort_column, source_rows, task_count);
+            sort_keys = &*sortKeys;
+        }
+        const auto resetSortKeys = qScopeGuard([this] { sort_keys = nullptr; });
+#endif
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), lt);
+            if (task_count > 1)
+                qConcurrentStableSort(source_rows, task_count, lt);
+            else
+                std::stable_sort(source_rows.begin(), source_rows.end(), lt);
         } else {
             QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q);
-            std::stable_sort(source_rows.begin(), source_rows.end(), gt);
+            if (task_count > 1)
+                qConcurrentStableSort(source_rows, task_count, gt);
+            else
+                std::stable_sort(source_rows.begin(), source_rows.end(), gt);
         }
     } else { // restore the source model order
         std::stable_sort(source_rows.begin(), source_rows.end());
     }
 }
 
+#if QT_CONFIG(icu)
+void QSortFilterProxyModelPrivate::create_sort_keys(LocaleAwareSortKeys *sortKeys) const
+{
+    const QList<int> &rows = sortKeys->source_rows;
+    QStringList strings;
+    strings.reserve(rows.size());
+    for (int row : rows) {
+        const QVariant value = model->index(row, sortKeys->column, sortKeys->source_parent)
+                                       .data(sort_role);
+        // isVariantLessThan() only compares strings the same way for all rows
+        if (value.userType() != QMetaType::QString)
+            return;
+        strings.append(value.toString());
+    }
+
+    sortKeys->key_index.assign(*std::max_element(rows.cbegin(), rows.cend()) + 1, -1);
+    QStringList nonEmpty;
+    nonEmpty.reserve(strings.size());
+    for (qsizetype i = 0; i < strings.size(); ++i) {
+        if (!strings.at(i).isEmpty()) {
+            sortKeys->key_index[rows.at(i)] = nonEmpty.size();
+            nonEmpty.append(std::move(strings[i]));
+        }
+    }
+
+    // QCollator is not thread-safe, so each task uses its own
+    const int task_count = sortKeys->task_count;
+    std::vector<QList<QCollatorSortKey>> keys(task_count);
+    qRunConcurrentTasks(task_count, [&](int task) {
+        const qsizetype begin = nonEmpty.size() * task / task_count;
+        const qsizetype end = nonEmpty.size() * (task + 1) / task_count;
+        keys[task] = QCollator().sortKeys(nonEmpty.mid(begin, end - begin));
+    });
+    sortKeys->keys.reserve(nonEmpty.size());
+    for (const QList<QCollatorSortKey> &taskKeys : keys)
+        sortKeys->keys.append(taskKeys);
+    sortKeys->valid = true;
+}
+
+/*
+    Compares source_left and source_right by their sort keys, if they are
+    being sorted with keys; otherwise returns std::nullopt.
+*/
+std::optional<bool> QSortFilterProxyModelPrivate::sort_keys_less_than(
+        const QModelIndex &source_left, const QModelIndex &source_right) const
+{
+    LocaleAwareSortKeys *sortKeys = sort_keys;
+    if (!sortKeys || source_left.column() != sortKeys->column
+        || source_right.column() != sortKeys->column || source_left.model() != model
+        || source_right.model() != model || source_left.parent() != sortKeys->source_parent
+        || source_right.parent() != sortKeys->source_parent) {
+        return std::nullopt;
+    }
+    std::call_once(sortKeys->created, [this, sortKeys] { create_sort_keys(sortKeys); });
+    if (!sortKeys->valid)
+        return std::nullopt;
+    const std::vector<qsizetype> &keyIndex = sortKeys->key_index;
+    const size_t leftRow = size_t(source_left.row());
+    const size_t rightRow = size_t(source_right.row());
+    if (leftRow >= keyIndex.size() || rightRow >= keyIndex.size())
+        return std::nullopt;
+    // Like QString::localeAwareCompare(), empty strings sort first
+    const qsizetype left = keyIndex[leftRow];
+    const qsizetype right = keyIndex[rightRow];
+    if (left < 0 || right < 0)
+        return left < 0 && right >= 0;
+    return sortKeys->keys.at(left).compare(sortKeys->keys.at(right)) < 0;
+}
+#endif // QT_CONFIG(icu)
+
+/*!
+  \internal
+
+  Returns the number of concurrent tasks to split filtering or sorting
+  \a row_count rows into, or 1 if the work should be done on the calling
+  thread only.
+*/
+int QSortFilterProxyModelPrivate::concurrent_task_count(qsizetype row_count) const
+{
+#if QT_CONFIG(thread)
+    // property reads from other threads do not register as dependencies of a binding
+    if (!concurrent_sortfilter || row_count < 2 * MinimumRowsPerConcurrentTask
+        || QtPrivate::isAnyBindingEvaluating()) {
+        return 1;
+    }
+    const int max_tasks = QThreadPool::globalInstance()->maxThreadCount() + 1;
+    return int(qMin<qsizetype>(max_tasks, row_count / MinimumRowsPerConcurrentTask));
+#else
+    Q_UNUSED(row_count);
+    return 1;
+#endif
+}
+
+/*!
+  \internal
+
+  Returns the rows of \a source_rows for which filterAcceptsRowInternal()
+  returns \a accepted, calling it from \a task_count concurrent tasks.
+*/
+QList<int> QSortFilterProxyModelPrivate::filter_source_rows(
+    const QList<int> &source_rows, const QModelIndex &source_parent,
+    bool accepted, int task_count) const
+{
+    return qConcurrentSelect(source_rows, task_count, [&](int source_row) {
+        return filterAcceptsRowInternal(source_row, source_parent) == accepted;
+    });
+}
+
 /*!
   \internal
 
@@ -1327,27 +1592,38 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     const QModelIndex &source_parent, Qt::Orientation orient)
 {
     Q_Q(QSortFilterProxyModel);
-    // Figure out which mapped items to remove
     QList<int> source_items_remove;
-    for (int i = 0; i < proxy_to_source.size(); ++i) {
-        const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
-            // This source item does not satisfy the filter, so it must be removed
-            source_items_remove.append(source_item);
-        }
-    }
-    // Figure out which non-mapped items to insert
     QList<int> source_items_insert;
-    int source_count = source_to_proxy.size();
-    for (int source_item = 0; source_item < source_count; ++source_item) {
-        if (source_to_proxy.at(source_item) == -1) {
+    const int task_count = orient == Qt::Vertical ? concurrent_task_count(source_to_proxy.size()) : 1;
+    if (task_count > 1) {
+        source_items_remove = filter_source_rows(proxy_to_source, source_parent, false, task_count);
+        QList<int> source_items_unmapped;
+        for (int source_item = 0; source_item < source_to_proxy.size(); ++source_item) {
+            if (source_to_proxy.at(source_item) == -1)
+                source_items_unmapped.append(source_item);
+        }
+        source_items_insert = filter_source_rows(source_items_unmapped, source_parent, true, task_count);
+    } else {
+        // Figure out which mapped items to remove
+        for (int i = 0; i < proxy_to_source.size(); ++i) {
+            const int source_item = proxy_to_source.at(i);
             if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
-                // This source item satisfies the filter, so it must be added
-                source_items_insert.append(source_item);
+                ? !filterAcceptsRowInternal(source_item, source_parent)
+                : !q->filterAcceptsColumn(source_item, source_parent)) {
+                // This source item does not satisfy the filter, so it must be removed
+                source_items_remove.append(source_item);
+            }
+        }
+        // Figure out which non-mapped items to insert
+        int source_count = source_to_proxy.size();
+        for (int source_item = 0; source_item < source_count; ++source_item) {
+            if (source_to_proxy.at(source_item) == -1) {
+                if ((orient == Qt::Vertical)
+                    ? filterAcceptsRowInternal(source_item, source_parent)
+                    : q->filterAcceptsColumn(source_item, source_parent)) {
+                    // This source item satisfies the filter, so it must be added
+                    source_items_insert.append(source_item);
+                }
             }
         }
     }
@@ -3065,6 +3341,58 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.7
+    \property QSortFilterProxyModel::concurrentSortFilter
+    \brief whether rows may be filtered and sorted concurrently.
+
+    When this property is true, the proxy model splits filtering and sorting
+    large numbers of rows into tasks that run on the global QThreadPool as
+    well as on the calling thread. The calling thread still waits for the
+    result, and the proxy model is updated with the same signals as without
+    this property.
+
+    Only enable this if filterAcceptsRow() and lessThan(), including the
+    default implementations' use of the source model's index() and data(),
+    can safely be called from several threads at once, as long as the source
+    model is not modified.
+
+    The default value is false.
+
+    \sa filterAcceptsRow(), lessThan(), QThreadPool::globalInstance()
+*/
+
+/*!
+    \since 6.7
+    \fn void QSortFilterProxyModel::concurrentSortFilterChanged(bool concurrentSortFilter)
+
+    \brief This signal is emitted when the value of the \a concurrentSortFilter property is changed.
+
+    \sa concurrentSortFilter
+*/
+bool QSortFilterProxyModel::concurrentSortFilter() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->concurrent_sortfilter;
+}
+
+void QSortFilterProxyModel::setConcurrentSortFilter(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->concurrent_sortfilter.removeBindingUnlessInWrapper();
+    if (d->concurrent_sortfilter == enable)
+        return;
+    // the filtered and sorted rows stay the same, only the way they are computed changes
+    d->concurrent_sortfilter.setValueBypassingBindings(enable);
+    d->concurrent_sortfilter.notify(); // also emits a signal
+}
+
+QBindable<bool> QSortFilterProxyModel::bindableConcurrentSortFilter()
+{
+    Q_D(QSortFilterProxyModel);
+    return QBindable<bool>(&d->concurrent_sortfilter);
+}
+
 /*!
    \since 4.3
 
@@ -3182,6 +3510,10 @@ void QSortFilterProxyModel::invalidateRowsFilter()
 bool QSortFilterProxyModel::lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const
 {
     Q_D(const QSortFilterProxyModel);
+#if QT_CONFIG(icu)
+    if (const auto less = d->sort_keys_less_than(source_left, source_right))
+        return *less;
+#endif
     QVariant l = (source_left.model() ? source_left.model()->data(source_left, d->sort_role) : QVariant());
     QVariant r = (source_right.model() ? source_right.model()->data(source_right, d->sort_role) : QVariant());
     return QAbstractItemModelPrivate::isVariantLessThan(l, r, d->sort_casesensitivity, d->sort_localeaware);
@@ -46,6 +46,8 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(bool concurrentSortFilter READ concurrentSortFilter WRITE setConcurrentSortFilter
+               NOTIFY concurrentSortFilterChanged BINDABLE bindableConcurrentSortFilter)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -101,6 +103,10 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    bool concurrentSortFilter() const;
+    void setConcurrentSortFilter(bool enable);
+    QBindable<bool> bindableConcurrentSortFilter();
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -168,6 +174,7 @@ Q_SIGNALS:
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
     void autoAcceptChildRowsChanged(bool autoAcceptChildRows);
+    void concurrentSortFilterChanged(bool concurrentSortFilter);
 
 private:
     Q_DECLARE_PRIVATE(QSortFilterProxyModel)
@@ -10,6 +10,7 @@
 #include "qcoreevent.h"
 #include "qcoreevent_p.h"
 #include "qeventloop.h"
+#include "qeventloopstatistics_p.h"
 #endif
 #include "qmetaobject.h"
 #include <private/qproperty_p.h>
@@ -337,7 +338,9 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 
 qsizetype qGlobalPostedEventsCount()
 {
-    const QPostEventList &l = QThreadData::current()->postEventList;
+    QPostEventList &l = QThreadData::current()->postEventList;
+    const auto locker = qt_scoped_lock(l.mutex);
+    l.flushInbox();
     return l.size() - l.startOffset;
 }
 
@@ -487,6 +490,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.flushInbox();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1345,7 +1349,7 @@ void QCoreApplication::processEvents(QEventLoop::ProcessEventsFlags flags)
     QThreadData *data = QThreadData::current();
     if (!data->hasEventDispatcher())
         return;
-    data->eventDispatcher.loadRelaxed()->processEvents(flags);
+    QEventLoopStatisticsCollector::processEvents(data, flags);
 }
 
 /*!
@@ -1382,7 +1386,7 @@ void QCoreApplication::processEvents(QEventLoop::ProcessEventsFlags flags, int m
         return;
     QElapsedTimer start;
     start.start();
-    while (data->eventDispatcher.loadRelaxed()->processEvents(flags & ~QEventLoop::WaitForMoreEvents)) {
+    while (QEventLoopStatisticsCollector::processEvents(data, flags & ~QEventLoop::WaitForMoreEvents)) {
         if (start.elapsed() > ms)
             break;
     }
@@ -1585,6 +1589,55 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     return locker;
 }
 
+/*!
+    \internal
+
+    Queued calls posted from another thread are neither compressed nor have
+    a loop level to remember, so they are handed over through the lock-free
+    inbox of the receiver's thread. The receiver's thread moves them into its
+    list in one batch, which spares the posting threads from contending for
+    the list's mutex, and only the first post into an empty inbox needs to
+    wake up the event dispatcher.
+
+    Returns \c false if \a event has to be posted the regular way.
+*/
+bool QCoreApplicationPrivate::postEventToInbox(QObject *receiver, QEvent *event, int priority)
+{
+    if (event->type() != QEvent::MetaCall)
+        return false;
+
+    QObjectPrivate *d = QObjectPrivate::get(receiver);
+    QThreadData *data = d->threadData.loadAcquire();
+    if (!data || data == QThreadData::current(false))
+        return false;
+
+    QPostEventList &list = data->postEventList;
+    // QObject::moveToThread() waits for inboxWriters to drop to zero after
+    // changing threadData, so if the receiver still lives in data's thread
+    // now, data's inbox is the right one.
+    list.inboxWriters.ref();
+    if (d->threadData.loadAcquire() != data) {
+        list.inboxWriters.deref();
+        return false;
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    ++d->postedEvents;
+    const bool wasEmpty = list.pushToInbox(
+            QPostEvent(receiver, event, priority, QEventLoopStatisticsCollector::postTimestamp()));
+    list.inboxWriters.deref();
+
+    if (wasEmpty) {
+        if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire()) {
+            if (Q_UNLIKELY(QEventLoopStatisticsCollector::isEnabled()))
+                QEventLoopStatisticsCollector::get(data)->recordWakeUp();
+            dispatcher->wakeUp();
+        }
+    }
+    return true;
+}
+
 /*!
     \since 4.3
 
@@ -1623,6 +1676,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    if (QCoreApplicationPrivate::postEventToInbox(receiver, event, priority))
+        return;
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1631,6 +1687,7 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     }
 
     QThreadData *data = locker.threadData;
+    data->postEventList.flushInbox();
 
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
@@ -1671,7 +1728,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     // properly owned in the postEventList
     std::unique_ptr<QEvent> eventDeleter(event);
     Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
-    data->postEventList.addEvent(QPostEvent(receiver, event, priority));
+    data->postEventList.addEvent(QPostEvent(receiver, event, priority,
+                                            QEventLoopStatisticsCollector::postTimestamp()));
     Q_UNUSED(eventDeleter.release());
     event->m_posted = true;
     ++receiver->d_func()->postedEvents;
@@ -1679,8 +1737,11 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     locker.unlock();
 
     QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
-    if (dispatcher)
+    if (dispatcher) {
+        if (Q_UNLIKELY(QEventLoopStatisticsCollector::isEnabled()))
+            QEventLoopStatisticsCollector::get(data)->recordWakeUp();
         dispatcher->wakeUp();
+    }
 }
 
 /*!
@@ -1778,6 +1839,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.flushInbox();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1791,6 +1853,12 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     data->canWait = true;
 
+    QEventLoopStatisticsCollector *statistics = nullptr;
+    if (Q_UNLIKELY(QEventLoopStatisticsCollector::isEnabled())) {
+        statistics = QEventLoopStatisticsCollector::get(data);
+        statistics->recordQueueDepth(data->postEventList.size() - data->postEventList.startOffset);
+    }
+
     // okay. here is the tricky loop. be careful about optimizing
     // this, it looks the way it does for good reasons.
     qsizetype startOffset = data->postEventList.startOffset;
@@ -1887,6 +1955,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         pe.event->m_posted = false;
         QEvent *e = pe.event;
         QObject * r = pe.receiver;
+        const quint32 postedAt = pe.postedAt;
 
         --r->d_func()->postedEvents;
         Q_ASSERT(r->d_func()->postedEvents >= 0);
@@ -1901,7 +1970,17 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         QScopedPointer<QEvent> event_deleter(e); // will delete the event (with the mutex unlocked)
 
         // after all that work, it's time to deliver the event.
-        QCoreApplication::sendEvent(r, e);
+        if (Q_UNLIKELY(statistics)) {
+            const int type = e->type();
+            const char *className = r->metaObject()->className();
+            QElapsedTimer timer;
+            timer.start();
+            QCoreApplication::sendEvent(r, e);
+            statistics->recordDelivery(type, postedAt, className,
+                                       std::chrono::nanoseconds(timer.nsecsElapsed()));
+        } else {
+            QCoreApplication::sendEvent(r, e);
+        }
 
         // careful when adding anything below this point - the
         // sendEvent() call might invalidate any invariants this
@@ -1934,6 +2013,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
+    data->postEventList.flushInbox();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1997,6 +2077,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.flushInbox();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -2186,6 +2267,7 @@ bool QCoreApplication::installTranslator(QTranslator *translationFile)
     {
         QWriteLocker locker(&d->translateMutex);
         d->translators.prepend(translationFile);
+        d->translatorsChanged();
     }
 
 #ifndef QT_NO_TRANSLATION_BUILDER
@@ -2220,6 +2302,7 @@ bool QCoreApplication::removeTranslator(QTranslator *translationFile)
     QCoreApplicationPrivate *d = self->d_func();
     QWriteLocker locker(&d->translateMutex);
     if (d->translators.removeAll(translationFile)) {
+        d->translatorsChanged();
 #ifndef QT_NO_QOBJECT
         locker.unlock();
         if (!self->closingDown()) {
@@ -2232,6 +2315,67 @@ bool QCoreApplication::removeTranslator(QTranslator *translationFile)
     return false;
 }
 
+// called with translateMutex locked for writing
+void QCoreApplicationPrivate::translatorsChanged()
+{
+    // A QTranslator subclass may not give the same translation every time
+    // it is asked, so only remember the translations of plain QTranslators
+    canCacheTranslations = std::all_of(translators.cbegin(), translators.cend(),
+                                       [](const QTranslator *translator) {
+        return translator->metaObject() == &QTranslator::staticMetaObject;
+    });
+    translationCache.clear();
+}
+
+// called when an installed translator is loaded or unloaded
+void QCoreApplicationPrivate::clearTranslationCache()
+{
+    if (QCoreApplication::self)
+        QCoreApplication::self->d_func()->translationCache.clear();
+}
+
+// Keeps the cache from growing without bound when many different strings are
+// translated, for instance generated ones
+static constexpr qsizetype MaxCachedTranslations = 4096;
+
+size_t QTranslationCache::keyFor(const char *context, const char *sourceText,
+                                 const char *disambiguation, int n) noexcept
+{
+    return qHashMulti(0, QByteArrayView(context), QByteArrayView(sourceText),
+                      QByteArrayView(disambiguation), n);
+}
+
+bool QTranslationCache::find(size_t key, const char *context, const char *sourceText,
+                             const char *disambiguation, int n, QString *translation) const
+{
+    const auto locker = qt_scoped_lock(mutex);
+    const auto it = entries.constFind(key);
+    // on a collision of the keys, the entry is for another string
+    if (it == entries.cend() || it->n != n
+            || QByteArrayView(it->sourceText) != QByteArrayView(sourceText)
+            || QByteArrayView(it->context) != QByteArrayView(context)
+            || QByteArrayView(it->disambiguation) != QByteArrayView(disambiguation)) {
+        return false;
+    }
+    *translation = it->translation;
+    return true;
+}
+
+void QTranslationCache::insert(size_t key, const char *context, const char *sourceText,
+                               const char *disambiguation, int n, const QString &translation)
+{
+    const auto locker = qt_scoped_lock(mutex);
+    if (entries.size() >= MaxCachedTranslations && !entries.contains(key))
+        entries.clear();
+    entries.insert(key, { context, sourceText, disambiguation, n, translation });
+}
+
+void QTranslationCache::clear()
+{
+    const auto locker = qt_scoped_lock(mutex);
+    entries.clear();
+}
+
 static void replacePercentN(QString *result, int n)
 {
     if (n >= 0) {
@@ -2305,13 +2449,23 @@ QString QCoreApplication::translate(const char *context, const char *sourceText,
         QCoreApplicationPrivate *d = self->d_func();
         QReadLocker locker(&d->translateMutex);
         if (!d->translators.isEmpty()) {
-            QList<QTranslator*>::ConstIterator it;
-            QTranslator *translationFile;
-            for (it = d->translators.constBegin(); it != d->translators.constEnd(); ++it) {
-                translationFile = *it;
-                result = translationFile->translate(context, sourceText, disambiguation, n);
-                if (!result.isNull())
-                    break;
+            const bool useCache = d->canCacheTranslations;
+            const size_t key = useCache
+                    ? QTranslationCache::keyFor(context, sourceText, disambiguation, n) : 0;
+            if (!useCache || !d->translationCache.find(key, context, sourceText,
+                                                       disambiguation, n, &result)) {
+                QList<QTranslator*>::ConstIterator it;
+                QTranslator *translationFile;
+                for (it = d->translators.constBegin(); it != d->translators.constEnd(); ++it) {
+                    translationFile = *it;
+                    result = translationFile->translate(context, sourceText, disambiguation, n);
+                    if (!result.isNull())
+                        break;
+                }
+                if (result.isNull())
+                    result = QString::fromUtf8(sourceText);
+                if (useCache)
+                    d->translationCache.insert(key, context, sourceText, disambiguation, n, result);
             }
         }
     }
@@ -19,6 +19,8 @@
 #if QT_CONFIG(commandlineparser)
 #include "QtCore/qcommandlineoption.h"
 #endif
+#include "QtCore/qhash.h"
+#include "QtCore/qmutex.h"
 #include "QtCore/qreadwritelock.h"
 #include "QtCore/qtranslator.h"
 #if QT_CONFIG(settings)
@@ -43,6 +45,35 @@ class QAbstractEventDispatcher;
 class QEvent;
 #endif
 
+#ifndef QT_NO_TRANSLATION
+// Remembers what the installed translators returned for the strings
+// QCoreApplication::translate() was asked for, so that translating a string
+// again doesn't ask each of them in turn. It holds the translations before
+// %n is replaced, which depends on the locale.
+class QTranslationCache
+{
+public:
+    static size_t keyFor(const char *context, const char *sourceText,
+                         const char *disambiguation, int n) noexcept;
+    bool find(size_t key, const char *context, const char *sourceText,
+              const char *disambiguation, int n, QString *translation) const;
+    void insert(size_t key, const char *context, const char *sourceText,
+                const char *disambiguation, int n, const QString &translation);
+    void clear();
+
+private:
+    struct Entry {
+        QByteArray context;
+        QByteArray sourceText;
+        QByteArray disambiguation;
+        int n;
+        QString translation;
+    };
+    mutable QMutex mutex;
+    QHash<size_t, Entry> entries;
+};
+#endif
+
 class Q_CORE_EXPORT QCoreApplicationPrivate
 #ifndef QT_NO_QOBJECT
     : public QObjectPrivate
@@ -119,6 +150,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static bool postEventToInbox(QObject *receiver, QEvent *event, int priority);
 #endif // QT_NO_QOBJECT
 
     int &argc;
@@ -133,7 +165,11 @@ public:
 #ifndef QT_NO_TRANSLATION
     QTranslatorList translators;
     QReadWriteLock translateMutex;
+    QTranslationCache translationCache;
+    bool canCacheTranslations = true;
     static bool isTranslatorInstalled(QTranslator *translator);
+    void translatorsChanged();
+    static void clearTranslationCache();
 #endif
 
     QCoreApplicationPrivate::Type application_type;
@@ -823,6 +823,7 @@ void QCoreApplicationPrivate::removePostedTimerEvent(QObject *object, int timerI
     QThreadData *data = object->d_func()->threadData.loadRelaxed();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.flushInbox();
     if (data->postEventList.size() == 0)
         return;
     for (int i = 0; i < data->postEventList.size(); ++i) {
@@ -195,7 +195,6 @@ void QEventDispatcherCoreFoundation::startingUp()
 QEventDispatcherCoreFoundation::~QEventDispatcherCoreFoundation()
 {
     invalidateTimer();
-    qDeleteAll(m_timerInfoList);
 
     m_cfSocketNotifier.removeSocketNotifiers();
 }
@@ -14,15 +14,24 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <private/qtrace_p.h>
+
+#include <qtcore_tracepoints_p.h>
 
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <limits>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -39,6 +48,10 @@
 
 QT_BEGIN_NAMESPACE
 
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_processEvents_entry, QObject *dispatcher, int flags);
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_processEvents_exit);
+Q_TRACE_POINT(qtcore, QEventDispatcherUNIX_wakeUp, QObject *dispatcher);
+
 static const char *socketType(QSocketNotifier::Type type)
 {
     switch (type) {
@@ -190,12 +203,33 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (epollRequested()) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd == -1) {
+            qErrnoWarning("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+            return;
+        }
+
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = threadPipe.fds[0];
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1) {
+            qErrnoWarning("QEventDispatcherUNIXPrivate: Unable to add thread pipe to epoll set");
+            qt_safe_close(epollFd);
+            epollFd = -1;
+        }
+    }
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
 }
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
@@ -272,6 +306,103 @@ int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
     return n_activated;
 }
 
+#if QT_CONFIG(epoll)
+/*!
+    \internal
+
+    Returns \c true if the QT_EVENT_DISPATCHER_EPOLL environment variable
+    asks for socket notifiers to be kept in a persistent epoll(7) set instead
+    of being passed to poll() on every iteration of the event loop.
+*/
+bool QEventDispatcherUNIXPrivate::epollRequested()
+{
+    return qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0;
+}
+
+// The poll() and epoll() event bits share their values on Linux, which lets
+// the epoll path reuse the pollfd-based bookkeeping.
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI);
+static_assert(EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, short events, bool added)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    if (epollFallbackFds.contains(fd)) {
+        if (!events)
+            epollFallbackFds.removeOne(fd);
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = events;
+    ev.data.fd = fd;
+
+    if (!events) {
+        // the fd may already have been closed, which removes it from the set
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev);
+        return;
+    }
+
+    int ret = epoll_ctl(epollFd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+    if (ret == -1 && added && errno == EEXIST)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    else if (ret == -1 && !added && errno == ENOENT)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+
+    // epoll refuses regular files (EPERM) and invalid descriptors (EBADF);
+    // keep poll() semantics for those, which reports them as always ready
+    // or as POLLNVAL respectively.
+    if (ret == -1)
+        epollFallbackFds.append(fd);
+}
+
+int QEventDispatcherUNIXPrivate::processEpollEvents(const timespec *tm)
+{
+    Q_ASSERT(epollFd >= 0);
+
+    static const timespec zeroTimeout = { 0, 0 };
+
+    pollfds.clear();
+    if (!epollFallbackFds.isEmpty()) {
+        for (int fd : std::as_const(epollFallbackFds))
+            pollfds.append(qt_make_pollfd(fd, socketNotifiers.value(fd).events()));
+        if (qt_safe_poll(pollfds.data(), pollfds.size(), &zeroTimeout) > 0)
+            tm = &zeroTimeout;
+    }
+
+    int timeout = -1;
+    if (tm) {
+        // round up, so that we don't wake up before the next timer is due
+        const qint64 msecs = qint64(tm->tv_sec) * 1000 + (tm->tv_nsec + 999999) / 1000000;
+        timeout = int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+    }
+
+    epoll_event events[256];
+    const int n = epoll_wait(epollFd, events, int(std::size(events)), timeout);
+    if (n == -1) {
+        if (errno != EINTR) {
+            qErrnoWarning("epoll_wait");
+            if (QT_CONFIG(poll_exit_on_error))
+                abort();
+        }
+        return 0;
+    }
+
+    int nevents = 0;
+    for (int i = 0; i < n; ++i) {
+        pollfd pfd = qt_make_pollfd(events[i].data.fd, 0);
+        pfd.revents = short(events[i].events);
+        if (pfd.fd == threadPipe.fds[0])
+            nevents += threadPipe.check(pfd);
+        else
+            pollfds.append(pfd);
+    }
+
+    return nevents + activateSocketNotifiers();
+}
+#endif // QT_CONFIG(epoll)
+
 QEventDispatcherUNIX::QEventDispatcherUNIX(QObject *parent)
     : QAbstractEventDispatcher(*new QEventDispatcherUNIXPrivate, parent)
 { }
@@ -375,7 +506,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const bool added = sn_set.isEmpty();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollInterest(sockfd, sn_set.events(), added);
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -416,6 +556,11 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollInterest(sockfd, sn_set.events(), false);
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -423,6 +568,7 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
 bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
 {
     Q_D(QEventDispatcherUNIX);
+    Q_TRACE_SCOPE(QEventDispatcherUNIX_processEvents, this, flags.toInt());
     d->interrupt.storeRelaxed(0);
 
     // we are awake, broadcast it
@@ -451,6 +597,17 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
+    int nevents = 0;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && include_notifiers) {
+        nevents += d->processEpollEvents(tm);
+        if (include_timers)
+            nevents += d->activateTimers();
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
@@ -461,8 +618,6 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
 
-    int nevents = 0;
-
     switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
     case -1:
         qErrnoWarning("qt_safe_poll");
@@ -501,6 +656,7 @@ int QEventDispatcherUNIX::remainingTime(int timerId)
 void QEventDispatcherUNIX::wakeUp()
 {
     Q_D(QEventDispatcherUNIX);
+    Q_TRACE(QEventDispatcherUNIX_wakeUp, this);
     d->threadPipe.wakeUp();
 }
 
@@ -103,9 +103,23 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    static bool epollRequested();
+    void updateEpollInterest(int fd, short events, bool added);
+    int processEpollEvents(const timespec *tm);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
+#if QT_CONFIG(epoll)
+    // when >= 0, the socket notifiers are kept registered in this epoll set
+    // instead of being rebuilt into pollfds on every iteration
+    int epollFd = -1;
+    // fds refused by epoll_ctl (e.g. regular files), polled without blocking
+    QList<int> epollFallbackFds;
+#endif
+
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
 
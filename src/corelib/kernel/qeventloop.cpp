@@ -10,6 +10,7 @@
 
 #include "qobject_p.h"
 #include "qeventloop_p.h"
+#include "qeventloopstatistics_p.h"
 #include <private/qthread_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -97,7 +98,7 @@ bool QEventLoop::processEvents(ProcessEventsFlags flags)
     auto threadData = d->threadData.loadRelaxed();
     if (!threadData->hasEventDispatcher())
         return false;
-    return threadData->eventDispatcher.loadRelaxed()->processEvents(flags);
+    return QEventLoopStatisticsCollector::processEvents(threadData, flags);
 }
 
 /*!
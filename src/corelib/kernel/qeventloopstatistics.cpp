@@ -0,0 +1,384 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qeventloopstatistics.h"
+#include "qeventloopstatistics_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qelapsedtimer.h>
+
+#include <algorithm>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QEventLoopStatistics
+    \inmodule QtCore
+    \since 6.7
+    \brief The QEventLoopStatistics class is a snapshot of how a thread's
+    event loop has been performing.
+
+    \ingroup events
+    \ingroup shared
+
+    Collecting the statistics is opt-in: nothing is recorded until
+    setEnabled() has been called, and while disabled the event loop only
+    pays for checking a flag. Once enabled, each thread records:
+
+    \list
+    \li for each event type, a histogram of the time posted events spent
+        waiting in the thread's queue before they were delivered;
+    \li for each receiver class, how many posted events were delivered to
+        its objects and how much time their event handlers took;
+    \li how often the thread's event dispatcher was woken up to deliver
+        events posted from elsewhere, and the longest queue seen;
+    \li how many times QEventLoop::processEvents() was called and how long
+        the calls took, including time spent waiting for events.
+    \endlist
+
+    Call forThread() to take a snapshot for a thread, for instance from a
+    timer that exports the values to a monitoring system. The snapshot does
+    not change when more events are delivered; call forThread() again to
+    get new values.
+
+    Only events that go through the queue, that is, that were posted with
+    QCoreApplication::postEvent() (including queued signal-slot
+    connections), are recorded. Events sent directly with
+    QCoreApplication::sendEvent() are not.
+
+    Histogram bucket \c{i} counts the events whose latency was at most
+    latencyBucketUpperBound(\c{i}) and more than the bound of the bucket
+    before it. The counts are not cumulative.
+*/
+
+/*!
+    \variable QEventLoopStatistics::LatencyBucketCount
+
+    The number of buckets in each latency histogram.
+*/
+
+Q_CONSTINIT QBasicAtomicInt QEventLoopStatisticsCollector::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+quint32 QEventLoopStatisticsCollector::currentTimestamp() noexcept
+{
+    using namespace std::chrono;
+    const auto now = duration_cast<microseconds>(steady_clock::now().time_since_epoch());
+    // 0 means "not timed"
+    return std::max(quint32(now.count()), 1u);
+}
+
+QEventLoopStatisticsCollector *QEventLoopStatisticsCollector::get(QThreadData *data)
+{
+    QEventLoopStatisticsCollector *collector = data->statistics.loadAcquire();
+    if (Q_LIKELY(collector))
+        return collector;
+    // wake ups are recorded from the posting thread, so we may race
+    auto created = new QEventLoopStatisticsCollector;
+    if (data->statistics.testAndSetOrdered(nullptr, created, collector))
+        return created;
+    delete created;
+    return collector;
+}
+
+static int latencyBucket(quint32 latency)
+{
+    // bucket i holds latencies of up to 2^i microseconds
+    if (latency <= 1)
+        return 0;
+    const int bucket = 32 - qCountLeadingZeroBits(latency - 1);
+    return std::min(bucket, QEventLoopStatistics::LatencyBucketCount - 1);
+}
+
+void QEventLoopStatisticsCollector::recordQueueDepth(qsizetype depth)
+{
+    QMutexLocker locker(&mutex);
+    data.maximumQueueDepth = std::max(data.maximumQueueDepth, depth);
+}
+
+void QEventLoopStatisticsCollector::recordDelivery(int eventType, quint32 postedAt,
+                                                   const char *className,
+                                                   std::chrono::nanoseconds time)
+{
+    QMutexLocker locker(&mutex);
+    // events posted before the statistics were enabled carry no timestamp
+    if (postedAt) {
+        const quint32 latency = currentTimestamp() - postedAt;
+        ++data.latencies[eventType][latencyBucket(latency)];
+    }
+    auto it = data.receivers.find(QByteArray::fromRawData(className, qstrlen(className)));
+    if (it == data.receivers.end())
+        it = data.receivers.insert(QByteArray(className), {});
+    ++it->events;
+    it->time += time;
+}
+
+bool QEventLoopStatisticsCollector::timedProcessEvents(QThreadData *threadData,
+                                                       QEventLoop::ProcessEventsFlags flags)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool result = threadData->eventDispatcher.loadRelaxed()->processEvents(flags);
+    const std::chrono::nanoseconds time(timer.nsecsElapsed());
+
+    QEventLoopStatisticsCollector *collector = get(threadData);
+    QMutexLocker locker(&collector->mutex);
+    ++collector->data.processEventsCount;
+    collector->data.processEventsTime += time;
+    return result;
+}
+
+QEventLoopStatisticsData QEventLoopStatisticsCollector::snapshot() const
+{
+    QMutexLocker locker(&mutex);
+    QEventLoopStatisticsData result = data;
+    result.wakeUps = wakeUps.loadRelaxed();
+    return result;
+}
+
+void QEventLoopStatisticsCollector::reset()
+{
+    QMutexLocker locker(&mutex);
+    data = {};
+    wakeUps.storeRelaxed(0);
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QEventLoopStatisticsPrivate)
+
+/*!
+    \fn QEventLoopStatistics::QEventLoopStatistics()
+
+    Constructs an empty snapshot, in which all counts are zero.
+*/
+
+/*!
+    Constructs a copy of \a other.
+*/
+QEventLoopStatistics::QEventLoopStatistics(const QEventLoopStatistics &other) noexcept = default;
+
+/*!
+    \fn QEventLoopStatistics::QEventLoopStatistics(QEventLoopStatistics &&other)
+
+    Move-constructs a snapshot from \a other.
+*/
+
+/*!
+    Assigns \a other to this snapshot and returns a reference to it.
+*/
+QEventLoopStatistics &QEventLoopStatistics::operator=(const QEventLoopStatistics &other) noexcept = default;
+
+/*!
+    \fn QEventLoopStatistics &QEventLoopStatistics::operator=(QEventLoopStatistics &&other)
+
+    Move-assigns \a other to this snapshot and returns a reference to it.
+*/
+
+/*!
+    \fn void QEventLoopStatistics::swap(QEventLoopStatistics &other)
+
+    Swaps this snapshot with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Destroys the snapshot.
+*/
+QEventLoopStatistics::~QEventLoopStatistics() = default;
+
+/*!
+    Enables the collection of statistics in all threads if \a enable is
+    \c true, and stops it otherwise. Values collected so far are kept.
+
+    \sa isEnabled(), reset()
+*/
+void QEventLoopStatistics::setEnabled(bool enable)
+{
+    QEventLoopStatisticsCollector::enabled.storeRelaxed(enable);
+}
+
+/*!
+    Returns \c true if statistics are being collected.
+
+    \sa setEnabled()
+*/
+bool QEventLoopStatistics::isEnabled() noexcept
+{
+    return QEventLoopStatisticsCollector::isEnabled();
+}
+
+/*!
+    Returns a snapshot of the statistics collected for the event loop of
+    \a thread. If nothing was recorded for it, all counts are zero.
+
+    \threadsafe
+*/
+QEventLoopStatistics QEventLoopStatistics::forThread(QThread *thread)
+{
+    QEventLoopStatistics result;
+    if (!thread)
+        return result;
+    const QEventLoopStatisticsCollector *collector =
+            QThreadData::get2(thread)->statistics.loadAcquire();
+    if (!collector)
+        return result;
+    result.d = new QEventLoopStatisticsPrivate;
+    result.d->data = collector->snapshot();
+    return result;
+}
+
+/*!
+    Discards the statistics collected so far for the event loop of
+    \a thread.
+
+    \threadsafe
+*/
+void QEventLoopStatistics::reset(QThread *thread)
+{
+    if (!thread)
+        return;
+    if (QEventLoopStatisticsCollector *collector =
+            QThreadData::get2(thread)->statistics.loadAcquire()) {
+        collector->reset();
+    }
+}
+
+/*!
+    Returns the largest latency counted in histogram bucket \a bucket. The
+    bounds double from one bucket to the next, starting at one microsecond.
+    The last bucket, LatencyBucketCount - 1, has no upper bound and this
+    function returns std::chrono::microseconds::max() for it.
+
+    \sa latencyHistogram()
+*/
+std::chrono::microseconds QEventLoopStatistics::latencyBucketUpperBound(int bucket) noexcept
+{
+    if (bucket >= LatencyBucketCount - 1)
+        return std::chrono::microseconds::max();
+    return std::chrono::microseconds(qint64(1) << std::max(bucket, 0));
+}
+
+/*!
+    Returns the types of the events for which a latency was recorded, in
+    ascending order.
+
+    \sa latencyHistogram(), QEvent::Type
+*/
+QList<int> QEventLoopStatistics::eventTypes() const
+{
+    if (!d)
+        return {};
+    QList<int> types = d->data.latencies.keys();
+    std::sort(types.begin(), types.end());
+    return types;
+}
+
+/*!
+    Returns the latency histogram for events of type \a eventType: the time
+    between posting an event and starting its delivery. The list has
+    LatencyBucketCount entries, or none if no event of that type was
+    delivered.
+
+    \sa latencyBucketUpperBound(), deliveredEventCount()
+*/
+QList<quint64> QEventLoopStatistics::latencyHistogram(int eventType) const
+{
+    if (!d)
+        return {};
+    const auto it = d->data.latencies.constFind(eventType);
+    if (it == d->data.latencies.cend())
+        return {};
+    return QList<quint64>(it->cbegin(), it->cend());
+}
+
+/*!
+    Returns the number of events of type \a eventType whose latency was
+    recorded; this is the sum of the latencyHistogram() buckets.
+*/
+quint64 QEventLoopStatistics::deliveredEventCount(int eventType) const noexcept
+{
+    if (!d)
+        return 0;
+    const auto it = d->data.latencies.constFind(eventType);
+    if (it == d->data.latencies.cend())
+        return 0;
+    return std::accumulate(it->cbegin(), it->cend(), quint64(0));
+}
+
+/*!
+    Returns the class names of the objects that received posted events, in
+    ascending order.
+
+    \sa receiverTime(), receiverEventCount()
+*/
+QList<QByteArray> QEventLoopStatistics::receiverClasses() const
+{
+    if (!d)
+        return {};
+    QList<QByteArray> classes = d->data.receivers.keys();
+    std::sort(classes.begin(), classes.end());
+    return classes;
+}
+
+/*!
+    Returns the total time spent delivering posted events to objects of the
+    class \a className, as returned by QMetaObject::className().
+*/
+std::chrono::nanoseconds QEventLoopStatistics::receiverTime(QByteArrayView className) const
+{
+    if (!d)
+        return {};
+    const auto it = d->data.receivers.constFind(
+            QByteArray::fromRawData(className.data(), className.size()));
+    return it == d->data.receivers.cend() ? std::chrono::nanoseconds() : it->time;
+}
+
+/*!
+    Returns the number of posted events delivered to objects of the class
+    \a className.
+*/
+quint64 QEventLoopStatistics::receiverEventCount(QByteArrayView className) const
+{
+    if (!d)
+        return 0;
+    const auto it = d->data.receivers.constFind(
+            QByteArray::fromRawData(className.data(), className.size()));
+    return it == d->data.receivers.cend() ? 0 : it->events;
+}
+
+/*!
+    Returns how many times the thread's event dispatcher was woken up
+    because an event was posted to the thread.
+*/
+quint64 QEventLoopStatistics::wakeUpCount() const noexcept
+{
+    return d ? d->data.wakeUps : 0;
+}
+
+/*!
+    Returns how many times QEventLoop::processEvents() was called for the
+    thread, including the calls made by QEventLoop::exec().
+*/
+quint64 QEventLoopStatistics::processEventsCount() const noexcept
+{
+    return d ? d->data.processEventsCount : 0;
+}
+
+/*!
+    Returns the total time spent in QEventLoop::processEvents(), including
+    the time spent waiting for events to arrive.
+*/
+std::chrono::nanoseconds QEventLoopStatistics::processEventsTime() const noexcept
+{
+    return d ? d->data.processEventsTime : std::chrono::nanoseconds();
+}
+
+/*!
+    Returns the largest number of events found waiting in the thread's
+    queue when it started delivering them.
+*/
+qsizetype QEventLoopStatistics::maximumQueueDepth() const noexcept
+{
+    return d ? d->data.maximumQueueDepth : 0;
+}
+
+QT_END_NAMESPACE
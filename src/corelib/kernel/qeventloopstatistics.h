@@ -0,0 +1,63 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTLOOPSTATISTICS_H
+#define QEVENTLOOPSTATISTICS_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+
+class QEventLoopStatisticsPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QEventLoopStatisticsPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QEventLoopStatistics
+{
+public:
+    static constexpr int LatencyBucketCount = 24;
+
+    QEventLoopStatistics() noexcept = default;
+    QEventLoopStatistics(const QEventLoopStatistics &other) noexcept;
+    QEventLoopStatistics(QEventLoopStatistics &&other) noexcept = default;
+    QEventLoopStatistics &operator=(const QEventLoopStatistics &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QEventLoopStatistics)
+    ~QEventLoopStatistics();
+
+    void swap(QEventLoopStatistics &other) noexcept { d.swap(other.d); }
+
+    static void setEnabled(bool enable);
+    static bool isEnabled() noexcept;
+
+    static QEventLoopStatistics forThread(QThread *thread);
+    static void reset(QThread *thread);
+
+    static std::chrono::microseconds latencyBucketUpperBound(int bucket) noexcept;
+
+    QList<int> eventTypes() const;
+    QList<quint64> latencyHistogram(int eventType) const;
+    quint64 deliveredEventCount(int eventType) const noexcept;
+
+    QList<QByteArray> receiverClasses() const;
+    std::chrono::nanoseconds receiverTime(QByteArrayView className) const;
+    quint64 receiverEventCount(QByteArrayView className) const;
+
+    quint64 wakeUpCount() const noexcept;
+    quint64 processEventsCount() const noexcept;
+    std::chrono::nanoseconds processEventsTime() const noexcept;
+    qsizetype maximumQueueDepth() const noexcept;
+
+private:
+    QExplicitlySharedDataPointer<QEventLoopStatisticsPrivate> d;
+};
+
+Q_DECLARE_SHARED(QEventLoopStatistics)
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_H
@@ -0,0 +1,94 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTLOOPSTATISTICS_P_H
+#define QEVENTLOOPSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qeventloopstatistics.h"
+
+#include <QtCore/qabstracteventdispatcher.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <private/qthread_p.h>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+struct QEventLoopStatisticsData
+{
+    struct ReceiverTime
+    {
+        quint64 events = 0;
+        std::chrono::nanoseconds time = {};
+    };
+    using Histogram = std::array<quint64, QEventLoopStatistics::LatencyBucketCount>;
+
+    QHash<int, Histogram> latencies;
+    QHash<QByteArray, ReceiverTime> receivers;
+    quint64 wakeUps = 0;
+    quint64 processEventsCount = 0;
+    std::chrono::nanoseconds processEventsTime = {};
+    qsizetype maximumQueueDepth = 0;
+};
+
+class QEventLoopStatisticsPrivate : public QSharedData
+{
+public:
+    QEventLoopStatisticsData data;
+};
+
+// Owned by QThreadData, created the first time something is recorded for
+// its thread while the statistics are enabled.
+class QEventLoopStatisticsCollector
+{
+public:
+    static bool isEnabled() noexcept { return enabled.loadRelaxed(); }
+    static QEventLoopStatisticsCollector *get(QThreadData *data);
+
+    // Microseconds on a wrapping 32-bit clock, or 0 while disabled; it fits
+    // in the padding of QPostEvent.
+    static quint32 postTimestamp() noexcept
+    { return Q_UNLIKELY(isEnabled()) ? currentTimestamp() : 0; }
+    static quint32 currentTimestamp() noexcept;
+
+    // Runs the dispatcher of data's thread, which must exist
+    static bool processEvents(QThreadData *data, QEventLoop::ProcessEventsFlags flags)
+    {
+        if (Q_LIKELY(!isEnabled()))
+            return data->eventDispatcher.loadRelaxed()->processEvents(flags);
+        return timedProcessEvents(data, flags);
+    }
+    static bool timedProcessEvents(QThreadData *data, QEventLoop::ProcessEventsFlags flags);
+
+    void recordWakeUp() noexcept { wakeUps.ref(); }
+    void recordQueueDepth(qsizetype depth);
+    void recordDelivery(int eventType, quint32 postedAt, const char *className,
+                        std::chrono::nanoseconds time);
+
+    QEventLoopStatisticsData snapshot() const;
+    void reset();
+
+    static QBasicAtomicInt enabled;
+
+private:
+    mutable QMutex mutex;
+    QEventLoopStatisticsData data;
+    QAtomicInteger<quint64> wakeUps;
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_P_H
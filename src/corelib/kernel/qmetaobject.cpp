@@ -11,6 +11,8 @@
 #include <qcoreapplication.h>
 #include <qcoreevent.h>
 #include <qdatastream.h>
+#include <qhash.h>
+#include <qreadwritelock.h>
 #include <qstringlist.h>
 #include <qthread.h>
 #include <qvariant.h>
@@ -178,6 +180,7 @@ public:
     { return static_cast<const QMetaMethodPrivate *>(q); }
 
     inline QByteArray signature() const;
+    inline bool hasSignature(QByteArrayView signature) const;
     inline QByteArray name() const;
     inline int typesDataIndex() const;
     inline const char *rawReturnTypeName() const;
@@ -710,6 +713,89 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
 }
 
 
+namespace {
+// Remembers where indexOfMethod(), indexOfSignal(), indexOfSlot() and
+// indexOfProperty() found a name, per meta-object, so that looking the same
+// name up again doesn't decode the signature and walk the whole class
+// hierarchy. Meta-objects built at run time can be freed, and another one
+// created at the same address, so a cached index is only returned after
+// checking that the method or property it designates still has that name.
+struct QMetaObjectIndexCache
+{
+    enum Kind { Method, Signal, Slot, Property };
+    struct Key
+    {
+        const QMetaObject *metaObject;
+        Kind kind;
+        QByteArray name;
+
+        friend bool operator==(const Key &lhs, const Key &rhs) noexcept
+        {
+            return lhs.metaObject == rhs.metaObject && lhs.kind == rhs.kind
+                    && lhs.name == rhs.name;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.metaObject, int(key.kind), key.name);
+        }
+    };
+    // the cache starts over once it is full
+    static constexpr qsizetype MaxSize = 4096;
+
+    QReadWriteLock lock;
+    QHash<Key, int> indexes;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QMetaObjectIndexCache, metaObjectIndexCache)
+
+template <typename Lookup, typename IsValid>
+static int cachedIndexOf(const QMetaObject *mo, QMetaObjectIndexCache::Kind kind,
+                         QByteArrayView name, Lookup lookup, IsValid isValid)
+{
+    QMetaObjectIndexCache *cache = metaObjectIndexCache();
+    if (!cache)
+        return lookup();
+
+    int index;
+    {
+        QReadLocker locker(&cache->lock);
+        index = cache->indexes.value({ mo, kind, QByteArray::fromRawData(name.data(), name.size()) },
+                                     -1);
+    }
+    if (index >= 0 && isValid(index))
+        return index;
+
+    index = lookup();
+    // names that only match after normalization, or through type aliases,
+    // aren't worth caching, as their entries would never be found valid
+    if (index >= 0 && isValid(index)) {
+        QWriteLocker locker(&cache->lock);
+        if (cache->indexes.size() >= QMetaObjectIndexCache::MaxSize)
+            cache->indexes.clear();
+        cache->indexes.insert({ mo, kind, name.toByteArray() }, index);
+    }
+    return index;
+}
+
+template <typename Lookup>
+static int cachedIndexOfMethod(const QMetaObject *mo, QMetaObjectIndexCache::Kind kind,
+                               const char *signature, Lookup lookup)
+{
+    const QByteArrayView view(signature);
+    return cachedIndexOf(mo, kind, view, lookup, [&](int index) {
+        if (index >= mo->methodCount())
+            return false;
+        const QMetaMethod method = mo->method(index);
+        const bool isSignal = method.methodType() == QMetaMethod::Signal;
+        if ((kind == QMetaObjectIndexCache::Signal && !isSignal)
+                || (kind == QMetaObjectIndexCache::Slot && isSignal)) {
+            return false;
+        }
+        return QMetaMethodPrivate::get(&method)->hasSignature(view);
+    });
+}
+
 /*!
     \since 4.5
 
@@ -738,15 +824,17 @@ int QMetaObject::indexOfConstructor(const char *constructor) const
 */
 int QMetaObject::indexOfMethod(const char *method) const
 {
-    const QMetaObject *m = this;
-    int i;
-    Q_ASSERT(priv(m->d.data)->revision >= 7);
-    QArgumentTypeArray types;
-    QByteArray name = QMetaObjectPrivate::decodeMethodSignature(method, types);
-    i = QMetaObjectPrivate::indexOfMethodRelative<0>(&m, name, types.size(), types.constData());
-    if (i >= 0)
-        i += m->methodOffset();
-    return i;
+    return cachedIndexOfMethod(this, QMetaObjectIndexCache::Method, method, [&] {
+        const QMetaObject *m = this;
+        int i;
+        Q_ASSERT(priv(m->d.data)->revision >= 7);
+        QArgumentTypeArray types;
+        QByteArray name = QMetaObjectPrivate::decodeMethodSignature(method, types);
+        i = QMetaObjectPrivate::indexOfMethodRelative<0>(&m, name, types.size(), types.constData());
+        if (i >= 0)
+            i += m->methodOffset();
+        return i;
+    });
 }
 
 // Parses a string of comma-separated types into QArgumentTypes.
@@ -803,15 +891,17 @@ QByteArray QMetaObjectPrivate::decodeMethodSignature(
 */
 int QMetaObject::indexOfSignal(const char *signal) const
 {
-    const QMetaObject *m = this;
-    int i;
-    Q_ASSERT(priv(m->d.data)->revision >= 7);
-    QArgumentTypeArray types;
-    QByteArray name = QMetaObjectPrivate::decodeMethodSignature(signal, types);
-    i = QMetaObjectPrivate::indexOfSignalRelative(&m, name, types.size(), types.constData());
-    if (i >= 0)
-        i += m->methodOffset();
-    return i;
+    return cachedIndexOfMethod(this, QMetaObjectIndexCache::Signal, signal, [&] {
+        const QMetaObject *m = this;
+        int i;
+        Q_ASSERT(priv(m->d.data)->revision >= 7);
+        QArgumentTypeArray types;
+        QByteArray name = QMetaObjectPrivate::decodeMethodSignature(signal, types);
+        i = QMetaObjectPrivate::indexOfSignalRelative(&m, name, types.size(), types.constData());
+        if (i >= 0)
+            i += m->methodOffset();
+        return i;
+    });
 }
 
 /*!
@@ -850,15 +940,17 @@ int QMetaObjectPrivate::indexOfSignalRelative(const QMetaObject **baseObject,
 */
 int QMetaObject::indexOfSlot(const char *slot) const
 {
-    const QMetaObject *m = this;
-    int i;
-    Q_ASSERT(priv(m->d.data)->revision >= 7);
-    QArgumentTypeArray types;
-    QByteArray name = QMetaObjectPrivate::decodeMethodSignature(slot, types);
-    i = QMetaObjectPrivate::indexOfSlotRelative(&m, name, types.size(), types.constData());
-    if (i >= 0)
-        i += m->methodOffset();
-    return i;
+    return cachedIndexOfMethod(this, QMetaObjectIndexCache::Slot, slot, [&] {
+        const QMetaObject *m = this;
+        int i;
+        Q_ASSERT(priv(m->d.data)->revision >= 7);
+        QArgumentTypeArray types;
+        QByteArray name = QMetaObjectPrivate::decodeMethodSignature(slot, types);
+        i = QMetaObjectPrivate::indexOfSlotRelative(&m, name, types.size(), types.constData());
+        if (i >= 0)
+            i += m->methodOffset();
+        return i;
+    });
 }
 
 // same as indexOfSignalRelative but for slots.
@@ -1099,28 +1191,33 @@ int QMetaObject::indexOfEnumerator(const char *name) const
 */
 int QMetaObject::indexOfProperty(const char *name) const
 {
-    const QMetaObject *m = this;
-    while (m) {
-        const QMetaObjectPrivate *d = priv(m->d.data);
-        for (int i = 0; i < d->propertyCount; ++i) {
-            const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
-            const char *prop = rawStringData(m, data.name());
-            if (strcmp(name, prop) == 0) {
-                i += m->propertyOffset();
-                return i;
+    auto lookup = [&] {
+        const QMetaObject *m = this;
+        while (m) {
+            const QMetaObjectPrivate *d = priv(m->d.data);
+            for (int i = 0; i < d->propertyCount; ++i) {
+                const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
+                const char *prop = rawStringData(m, data.name());
+                if (strcmp(name, prop) == 0) {
+                    i += m->propertyOffset();
+                    return i;
+                }
             }
+            m = m->d.superdata;
         }
-        m = m->d.superdata;
-    }
 
-    if (priv(this->d.data)->flags & DynamicMetaObject) {
-        QAbstractDynamicMetaObject *me =
-            const_cast<QAbstractDynamicMetaObject *>(static_cast<const QAbstractDynamicMetaObject *>(this));
+        if (priv(this->d.data)->flags & DynamicMetaObject) {
+            QAbstractDynamicMetaObject *me =
+                const_cast<QAbstractDynamicMetaObject *>(static_cast<const QAbstractDynamicMetaObject *>(this));
 
-        return me->createProperty(name, nullptr);
-    }
+            return me->createProperty(name, nullptr);
+        }
 
-    return -1;
+        return -1;
+    };
+    return cachedIndexOf(this, QMetaObjectIndexCache::Property, name, lookup, [&](int index) {
+        return index < propertyCount() && qstrcmp(property(index).name(), name) == 0;
+    });
 }
 
 /*!
@@ -1871,6 +1968,31 @@ QByteArray QMetaMethodPrivate::signature() const
     return result;
 }
 
+// Same as signature() == \a signature, without building the signature
+bool QMetaMethodPrivate::hasSignature(QByteArrayView signature) const
+{
+    Q_ASSERT(priv(mobj->d.data)->revision >= 7);
+    const QLatin1StringView methodName = stringDataView(mobj, data.name());
+    if (!signature.startsWith(QByteArrayView(methodName.data(), methodName.size())))
+        return false;
+    signature = signature.sliced(methodName.size());
+    if (!signature.startsWith('('))
+        return false;
+    signature = signature.sliced(1);
+    for (int i = 0; i < parameterCount(); ++i) {
+        if (i) {
+            if (!signature.startsWith(','))
+                return false;
+            signature = signature.sliced(1);
+        }
+        const QByteArrayView typeName(rawTypeNameFromTypeInfo(mobj, parameterTypeInfo(i)));
+        if (!signature.startsWith(typeName))
+            return false;
+        signature = signature.sliced(typeName.size());
+    }
+    return signature == ")";
+}
+
 QByteArray QMetaMethodPrivate::name() const
 {
     Q_ASSERT(priv(mobj->d.data)->revision >= 7);
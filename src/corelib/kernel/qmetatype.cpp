@@ -24,6 +24,9 @@
 #include "qvariant.h"
 #include "qdatastream.h"
 
+#include <private/qlocking_p.h>
+#include <private/qreadmostlylock_p.h>
+
 #if QT_CONFIG(regularexpression)
 #  include "qregularexpression.h"
 #endif
@@ -56,8 +59,11 @@
 # include "qline.h"
 #endif
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <new>
+#include <shared_mutex>
 #include <cstring>
 
 QT_BEGIN_NAMESPACE
@@ -109,15 +115,17 @@ struct QMetaTypeCustomRegistry
         // we got here because cti->typeId is 0, so this is a custom meta type
         // (not read-only)
         auto ti = const_cast<QtPrivate::QMetaTypeInterface *>(cti);
+        // normalize before locking, so that concurrent lookups of other
+        // types do not wait for it
+        const QByteArray name =
+#ifndef QT_NO_QOBJECT
+                QMetaObject::normalizedType
+#endif
+                (ti->name);
         {
             QWriteLocker l(&lock);
             if (int id = ti->typeId.loadRelaxed())
                 return id;
-            QByteArray name =
-#ifndef QT_NO_QOBJECT
-                    QMetaObject::normalizedType
-#endif
-                    (ti->name);
             if (auto ti2 = aliases.value(name)) {
                 const auto id = ti2->typeId.loadRelaxed();
                 ti->typeId.storeRelaxed(id);
@@ -947,13 +955,51 @@ void QMetaType::unregisterMetaType(QMetaType type)
 
 
 
-static const struct { const char * typeName; int typeNameLength; int type; } types[] = {
+namespace {
+struct StaticTypeName
+{
+    const char *typeName;
+    int typeNameLength;
+    int type;
+
+    // orders by length first, which is the cheapest to compare
+    friend constexpr bool operator<(const StaticTypeName &lhs, const StaticTypeName &rhs) noexcept
+    {
+        if (lhs.typeNameLength != rhs.typeNameLength)
+            return lhs.typeNameLength < rhs.typeNameLength;
+        for (int i = 0; i < lhs.typeNameLength; ++i) {
+            if (lhs.typeName[i] != rhs.typeName[i])
+                return uchar(lhs.typeName[i]) < uchar(rhs.typeName[i]);
+        }
+        return false;
+    }
+};
+
+constexpr StaticTypeName unsortedTypes[] = {
     QT_FOR_EACH_STATIC_TYPE(QT_ADD_STATIC_METATYPE)
     QT_FOR_EACH_STATIC_ALIAS_TYPE(QT_ADD_STATIC_METATYPE_ALIASES_ITER)
     QT_ADD_STATIC_METATYPE(_, QMetaTypeId2<qreal>::MetaType, qreal)
-    {nullptr, 0, QMetaType::UnknownType}
 };
 
+// std::sort is not constexpr in C++17; a stable insertion sort keeps the
+// first of equal names first, like the linear search this replaces did
+template <size_t N>
+constexpr std::array<StaticTypeName, N> sortedTypeNames(const StaticTypeName (&names)[N])
+{
+    std::array<StaticTypeName, N> result = {};
+    for (size_t i = 0; i < N; ++i) {
+        size_t j = i;
+        for (; j > 0 && names[i] < result[j - 1]; --j)
+            result[j] = result[j - 1];
+        result[j] = names[i];
+    }
+    return result;
+}
+} // unnamed namespace
+
+// the names of the static types, sorted at compile time for binary search
+static constexpr auto types = sortedTypeNames(unsortedTypes);
+
 static const struct : QMetaTypeModuleHelper
 {
     template<typename T, typename LiteralWrapper =
@@ -1654,19 +1700,19 @@ class QMetaTypeFunctionRegistry
 public:
     ~QMetaTypeFunctionRegistry()
     {
-        const QWriteLocker locker(&lock);
+        const auto locker = qt_scoped_lock(lock);
         map.clear();
     }
 
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
+        const std::shared_lock locker(lock);
         return map.contains(k);
     }
 
     bool insertIfNotContains(Key k, const T &f)
     {
-        const QWriteLocker locker(&lock);
+        const auto locker = qt_scoped_lock(lock);
         const qsizetype oldSize = map.size();
         auto &e = map[k];
         if (map.size() == oldSize) // already present
@@ -1677,7 +1723,7 @@ public:
 
     const T *function(Key k) const
     {
-        const QReadLocker locker(&lock);
+        const std::shared_lock locker(lock);
         auto it = map.find(k);
         return it == map.end() ? nullptr : std::addressof(*it);
     }
@@ -1685,11 +1731,12 @@ public:
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
+        const auto locker = qt_scoped_lock(lock);
         map.remove(k);
     }
 private:
-    mutable QReadWriteLock lock;
+    // looked up on every conversion, but only written at registration
+    mutable QReadMostlyLock lock;
     QHash<Key, T> map;
 };
 
@@ -2351,6 +2398,10 @@ bool QMetaType::convert(QMetaType fromType, const void *from, QMetaType toType,
     int fromTypeId = fromType.id();
     int toTypeId = toType.id();
 
+    // the most common conversions need neither the module helper nor a lookup
+    if (QtMetaTypePrivate::convertArithmetic(fromTypeId, from, toTypeId, to))
+        return true;
+
     if (auto moduleHelper = qModuleHelperForType(qMax(fromTypeId, toTypeId))) {
         if (moduleHelper->convert(from, fromTypeId, to, toTypeId))
             return true;
@@ -2676,12 +2727,11 @@ bool QMetaType::hasRegisteredMutableViewFunction(QMetaType fromType, QMetaType t
 */
 static inline int qMetaTypeStaticType(const char *typeName, int length)
 {
-    int i = 0;
-    while (types[i].typeName && ((length != types[i].typeNameLength)
-                                 || memcmp(typeName, types[i].typeName, length))) {
-        ++i;
-    }
-    return types[i].type;
+    const StaticTypeName key = { typeName, length, QMetaType::UnknownType };
+    const auto it = std::lower_bound(types.begin(), types.end(), key);
+    if (it == types.end() || key < *it)
+        return QMetaType::UnknownType;
+    return it->type;
 }
 
 /*
@@ -18,6 +18,9 @@
 #include <QtCore/private/qglobal_p.h>
 #include "qmetatype.h"
 
+#include <QtCore/q20type_traits.h>
+#include <QtCore/qnumeric.h>
+
 QT_BEGIN_NAMESPACE
 
 #define QMETATYPE_CONVERTER(To, From, assign_and_return) \
@@ -202,6 +205,61 @@ inline void destruct(const QtPrivate::QMetaTypeInterface *iface, void *where)
         iface->dtor(iface, where);
 }
 
+// Calls f with a reference to the value at p, if typeId is one of the
+// builtin arithmetic types. Returns false for all other types.
+template <typename Void, typename F>
+inline bool visitArithmetic(int typeId, Void *p, F &&f)
+{
+    static_assert(std::is_void_v<Void>);
+    // const if p is
+    auto value = [p](auto *type) -> auto & {
+        using T = std::remove_pointer_t<decltype(type)>;
+        return *static_cast<std::conditional_t<std::is_const_v<Void>, const T, T> *>(p);
+    };
+#define QT_VISIT_ARITHMETIC(MetaTypeName, RealType) \
+    case QMetaType::MetaTypeName: \
+        f(value(static_cast<RealType *>(nullptr))); \
+        return true;
+
+    switch (typeId) {
+    QT_VISIT_ARITHMETIC(Bool, bool)
+    QT_VISIT_ARITHMETIC(Char, char)
+    QT_VISIT_ARITHMETIC(SChar, signed char)
+    QT_VISIT_ARITHMETIC(UChar, uchar)
+    QT_VISIT_ARITHMETIC(Short, short)
+    QT_VISIT_ARITHMETIC(UShort, ushort)
+    QT_VISIT_ARITHMETIC(Int, int)
+    QT_VISIT_ARITHMETIC(UInt, uint)
+    QT_VISIT_ARITHMETIC(Long, long)
+    QT_VISIT_ARITHMETIC(ULong, ulong)
+    QT_VISIT_ARITHMETIC(LongLong, qlonglong)
+    QT_VISIT_ARITHMETIC(ULongLong, qulonglong)
+    QT_VISIT_ARITHMETIC(Float, float)
+    QT_VISIT_ARITHMETIC(Double, double)
+    }
+#undef QT_VISIT_ARITHMETIC
+    return false;
+}
+
+// Converts between the builtin arithmetic types with the same rules as
+// QMetaType::convert(), but without going through the module helper.
+// Returns false if either type is not one of them.
+inline bool convertArithmetic(int fromTypeId, const void *from, int toTypeId, void *to)
+{
+    bool converted = false;
+    visitArithmetic(fromTypeId, from, [&](const auto &source) {
+        converted = visitArithmetic(toTypeId, to, [&](auto &result) {
+            using From = q20::remove_cvref_t<decltype(source)>;
+            using To = q20::remove_cvref_t<decltype(result)>;
+            if constexpr (std::is_floating_point_v<From> && !std::is_floating_point_v<To>)
+                result = To(qRound64(source));
+            else
+                result = To(source);
+        });
+    });
+    return converted;
+}
+
 const char *typedefNameForType(const QtPrivate::QMetaTypeInterface *type_d);
 
 template<typename T>
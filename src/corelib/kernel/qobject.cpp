@@ -23,6 +23,7 @@
 #include <private/qthread_p.h>
 #include <qdebug.h>
 #include <qpair.h>
+#include <qpointer.h>
 #include <qvarlengtharray.h>
 #include <qscopeguard.h>
 #include <qset.h>
@@ -34,9 +35,12 @@
 #include <private/qhooks_p.h>
 #include <qtcore_tracepoints_p.h>
 
+#include <algorithm>
+#include <atomic>
 #include <new>
 #include <mutex>
 #include <memory>
+#include <utility>
 
 #include <ctype.h>
 #include <limits.h>
@@ -317,6 +321,7 @@ inline void QObjectPrivate::addConnection(int signal, Connection *c)
     c->id = ++cd->currentConnectionId;
     c->prevConnectionList = connectionList.last.loadRelaxed();
     connectionList.last.storeRelaxed(c);
+    cd->connectionAdded(c);
 
     QObjectPrivate *rd = QObjectPrivate::get(c->receiver.loadRelaxed());
     rd->ensureConnectionData();
@@ -332,6 +337,12 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
 {
     Q_ASSERT(c->receiver.loadRelaxed());
     ConnectionList &connections = signalVector.loadRelaxed()->at(c->signal_index);
+    --connectionCount;
+    if (receiverIndex) {
+        receiverIndex->remove({ c->signal_index, c->receiver.loadRelaxed() }, c);
+        if (connectionCount == 0)
+            receiverIndex.reset();
+    }
     c->receiver.storeRelaxed(nullptr);
     QThreadData *td = c->receiverThreadData.loadRelaxed();
     if (td)
@@ -394,6 +405,67 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
 
 }
 
+/*!
+  \internal
+  Counts the connection \a c that was just appended to its signal's list,
+  and indexes it by receiver if the object has enough connections for that
+  to pay off. The first time this happens, all the object's connections
+  are indexed.
+ */
+void QObjectPrivate::ConnectionData::connectionAdded(QObjectPrivate::Connection *c)
+{
+    ++connectionCount;
+    if (receiverIndex) {
+        receiverIndex->insert({ c->signal_index, c->receiver.loadRelaxed() }, c);
+        return;
+    }
+    if (connectionCount <= ReceiverIndexThreshold)
+        return;
+
+    receiverIndex = std::make_unique<ReceiverIndex>();
+    receiverIndex->reserve(connectionCount);
+    for (int signal = -1; signal < signalVectorCount(); ++signal) {
+        Connection *cc = connectionsForSignal(signal).first.loadRelaxed();
+        for (; cc; cc = cc->nextConnectionList.loadRelaxed()) {
+            if (QObject *r = cc->receiver.loadRelaxed())
+                receiverIndex->insert({ signal, r }, cc);
+        }
+    }
+}
+
+/*!
+  \internal
+  Returns the connections from \a signal to \a receiver, in the order they
+  were made.
+
+  The signalSlotLock() of the sender must be locked while calling this
+  function.
+ */
+QObjectPrivate::ConnectionData::ConnectionsToReceiver
+QObjectPrivate::ConnectionData::connectionsTo(int signal, const QObject *receiver)
+{
+    ConnectionsToReceiver result;
+    if (receiverIndex) {
+        auto [it, end] = std::as_const(*receiverIndex).equal_range({ signal, receiver });
+        for (; it != end; ++it)
+            result.append(*it);
+        // connections are appended to their signal's list, so their ids
+        // grow along it
+        std::sort(result.begin(), result.end(), [](Connection *lhs, Connection *rhs) {
+            return lhs->id < rhs->id;
+        });
+        return result;
+    }
+    if (signal >= signalVectorCount())
+        return result;
+    Connection *c = connectionsForSignal(signal).first.loadRelaxed();
+    for (; c; c = c->nextConnectionList.loadRelaxed()) {
+        if (c->receiver.loadRelaxed() == receiver)
+            result.append(c);
+    }
+    return result;
+}
+
 void QObjectPrivate::ConnectionData::cleanOrphanedConnectionsImpl(QObject *sender, LockPolicy lockPolicy)
 {
     QBasicMutex *senderMutex = signalSlotLock(sender);
@@ -1120,8 +1192,81 @@ QObject::~QObject()
         d->setParent_helper(nullptr);
 }
 
+/*
+    Collects the emissions queued through a Qt::BatchedConnection until the
+    receiver's thread gets to them, so that only one event is posted for all
+    of them. The connection and the posted QBatchedMetaCallEvent both hold a
+    reference.
+*/
+struct QQueuedConnectionBatch
+{
+    explicit QQueuedConnectionBatch(bool latestOnly) : latestOnly(latestOnly) { }
+    ~QQueuedConnectionBatch() { qDeleteAll(pending); }
+
+    void ref() { refCount.ref(); }
+    void deref()
+    {
+        if (!refCount.deref())
+            delete this;
+    }
+
+    QAtomicInt refCount = 1;
+    QBasicMutex mutex;
+    QList<QMetaCallEvent *> pending;
+    QEvent *postedEvent = nullptr; // the event that delivers pending, if posted
+    const bool latestOnly;         // Qt::CoalescedConnection
+};
+
+namespace {
+class QBatchedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(QQueuedConnectionBatch *batch, const QObject *sender, int signalId)
+        : QAbstractMetaCallEvent(sender, signalId), batch(batch)
+    {
+        batch->ref();
+    }
+    ~QBatchedMetaCallEvent() override
+    {
+        // if the event is dropped without being delivered, so are the emissions
+        QList<QMetaCallEvent *> undelivered;
+        {
+            QBasicMutexLocker locker(&batch->mutex);
+            if (batch->postedEvent == this) {
+                batch->postedEvent = nullptr;
+                undelivered.swap(batch->pending);
+            }
+        }
+        qDeleteAll(undelivered);
+        batch->deref();
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        QList<QMetaCallEvent *> events;
+        {
+            QBasicMutexLocker locker(&batch->mutex);
+            batch->postedEvent = nullptr;
+            events.swap(batch->pending);
+        }
+        // a slot may delete the receiver
+        QPointer<QObject> guard(object);
+        for (QMetaCallEvent *event : std::as_const(events)) {
+            if (guard)
+                event->placeMetaCall(object);
+            delete event;
+        }
+    }
+
+private:
+    QQueuedConnectionBatch *batch;
+};
+} // unnamed namespace
+
 inline QObjectPrivate::Connection::~Connection()
 {
+    if (batch)
+        batch->deref();
     if (ownArgumentTypes) {
         const int *v = argumentTypes.loadRelaxed();
         if (v != &DIRECT_CONNECTION_ONLY)
@@ -1671,8 +1816,29 @@ void QObject::moveToThread(QThread *targetThread)
     if (threadPrivate && !bindingStatus) {
         bindingStatus = threadPrivate->addObjectWithPendingBindingStatusChange(this);
     }
+    currentData->postEventList.flushInbox();
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+    // Threads posting to the object through the inbox of currentData (see
+    // QCoreApplication::postEvent()) may have looked at threadData before it
+    // changed; once they are done, hand their events to the right list.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    currentData->postEventList.waitForInboxWriters();
+    int eventsMoved = 0;
+    for (auto *node = currentData->postEventList.takeInbox(); node; ) {
+        if (node->event.receiver->d_func()->threadData.loadRelaxed() == targetData) {
+            targetData->postEventList.addEvent(node->event);
+            ++eventsMoved;
+        } else {
+            currentData->postEventList.addEvent(node->event);
+        }
+        delete std::exchange(node, node->next);
+    }
+    if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.loadRelaxed()->wakeUp();
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3454,16 +3620,11 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
 
     QObjectPrivate::ConnectionData *scd  = QObjectPrivate::get(s)->connections.loadRelaxed();
     if (type & Qt::UniqueConnection && scd) {
-        if (scd->signalVectorCount() > signal_index) {
-            const QObjectPrivate::Connection *c2 = scd->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
-
-            int method_index_absolute = method_index + method_offset;
+        int method_index_absolute = method_index + method_offset;
 
-            while (c2) {
-                if (!c2->isSlotObject && c2->receiver.loadRelaxed() == receiver && c2->method() == method_index_absolute)
-                    return nullptr;
-                c2 = c2->nextConnectionList.loadRelaxed();
-            }
+        for (const QObjectPrivate::Connection *c2 : scd->connectionsTo(signal_index, receiver)) {
+            if (!c2->isSlotObject && c2->method() == method_index_absolute)
+                return nullptr;
         }
     }
     type &= ~Qt::UniqueConnection;
@@ -3471,6 +3632,10 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & (Qt::BatchedConnection | Qt::CoalescedConnection);
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~(Qt::BatchedConnection | Qt::CoalescedConnection);
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3488,6 +3653,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    if (isBatched)
+        c->batch = new QQueuedConnectionBatch(isCoalesced);
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3538,28 +3705,45 @@ bool QMetaObjectPrivate::disconnectHelper(QObjectPrivate::ConnectionData *connec
 {
     bool success = false;
 
-    auto &connectionList = connections->connectionsForSignal(signalIndex);
-    auto *c = connectionList.first.loadRelaxed();
-    while (c) {
-        QObject *r = c->receiver.loadRelaxed();
-        if (r && (receiver == nullptr || (r == receiver
+    auto matches = [&](const QObjectPrivate::Connection *c, const QObject *r) {
+        return r && (receiver == nullptr || (r == receiver
                            && (method_index < 0 || (!c->isSlotObject && c->method() == method_index))
-                           && (slot == nullptr || (c->isSlotObject && c->slotObj->compare(slot)))))) {
-            bool needToUnlock = false;
-            QBasicMutex *receiverMutex = nullptr;
-            if (r) {
-                receiverMutex = signalSlotLock(r);
-                // need to relock this receiver and sender in the correct order
-                needToUnlock = QOrderedMutexLocker::relock(senderMutex, receiverMutex);
-            }
-            if (c->receiver.loadRelaxed())
-                connections->removeConnection(c);
+                           && (slot == nullptr || (c->isSlotObject && c->slotObj->compare(slot)))));
+    };
+    auto remove = [&](QObjectPrivate::Connection *c, QObject *r) {
+        QBasicMutex *receiverMutex = signalSlotLock(r);
+        // need to relock this receiver and sender in the correct order
+        bool needToUnlock = QOrderedMutexLocker::relock(senderMutex, receiverMutex);
+        if (c->receiver.loadRelaxed())
+            connections->removeConnection(c);
+
+        if (needToUnlock)
+            receiverMutex->unlock();
 
-            if (needToUnlock)
-                receiverMutex->unlock();
+        success = true;
+    };
 
-            success = true;
+    if (receiver) {
+        // removed connections aren't deleted while the caller holds a
+        // reference to the connection data, so the list stays valid
+        const auto candidates = connections->connectionsTo(signalIndex, receiver);
+        for (QObjectPrivate::Connection *c : candidates) {
+            QObject *r = c->receiver.loadRelaxed();
+            if (matches(c, r)) {
+                remove(c, r);
+                if (disconnectType == DisconnectOne)
+                    return success;
+            }
+        }
+        return success;
+    }
 
+    auto &connectionList = connections->connectionsForSignal(signalIndex);
+    auto *c = connectionList.first.loadRelaxed();
+    while (c) {
+        QObject *r = c->receiver.loadRelaxed();
+        if (matches(c, r)) {
+            remove(c, r);
             if (disconnectType == DisconnectOne)
                 return success;
         }
@@ -3851,6 +4035,25 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
+    if (QQueuedConnectionBatch *batch = c->batch) {
+        QMetaCallEvent *dropped = nullptr;
+        QBatchedMetaCallEvent *batchEvent = nullptr;
+        {
+            QBasicMutexLocker batchLocker(&batch->mutex);
+            if (batch->latestOnly && !batch->pending.isEmpty())
+                dropped = std::exchange(batch->pending.last(), ev);
+            else
+                batch->pending.append(ev);
+            if (!batch->postedEvent)
+                batch->postedEvent = batchEvent = new QBatchedMetaCallEvent(batch, sender, signal);
+        }
+        if (batchEvent)
+            QCoreApplication::postEvent(receiver, batchEvent);
+        locker.unlock();
+        delete dropped;
+        return;
+    }
+
     QCoreApplication::postEvent(receiver, ev);
 }
 
@@ -5101,15 +5304,10 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
 
     if (type & Qt::UniqueConnection && slot && QObjectPrivate::get(s)->connections.loadRelaxed()) {
         QObjectPrivate::ConnectionData *connections = QObjectPrivate::get(s)->connections.loadRelaxed();
-        if (connections->signalVectorCount() > signal_index) {
-            const QObjectPrivate::Connection *c2 = connections->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
-
-            while (c2) {
-                if (c2->receiver.loadRelaxed() == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
-                    slotObj->destroyIfLastRef();
-                    return QMetaObject::Connection();
-                }
-                c2 = c2->nextConnectionList.loadRelaxed();
+        for (const QObjectPrivate::Connection *c2 : connections->connectionsTo(signal_index, receiver)) {
+            if (c2->isSlotObject && c2->slotObj->compare(slot)) {
+                slotObj->destroyIfLastRef();
+                return QMetaObject::Connection();
             }
         }
     }
@@ -5118,6 +5316,10 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isBatched = type & (Qt::BatchedConnection | Qt::CoalescedConnection);
+    const bool isCoalesced = type & Qt::CoalescedConnection;
+    type &= ~(Qt::BatchedConnection | Qt::CoalescedConnection);
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5136,6 +5338,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    if (isBatched)
+        c->batch = new QQueuedConnectionBatch(isCoalesced);
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
@@ -21,10 +21,17 @@
 // Gammaray need access to the structs in this file.
 
 #include <QtCore/qobject.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/private/qobject_p.h>
 
+#include <memory>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
+struct QQueuedConnectionBatch;
+
 // ConnectionList is a singly-linked list
 struct QObjectPrivate::ConnectionList
 {
@@ -93,6 +100,8 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
+    // emissions waiting to be delivered for Qt::BatchedConnection
+    QQueuedConnectionBatch *batch = nullptr;
     Connection() : ownArgumentTypes(true) { }
     ~Connection();
     int method() const
@@ -144,6 +153,16 @@ struct QObjectPrivate::ConnectionData
     Sender *currentSender = nullptr; // object currently activating the object
     std::atomic<TaggedSignalVector> orphaned = {};
 
+    // Once an object has many outgoing connections, they are also indexed
+    // by signal and receiver, so that disconnecting a receiver or checking
+    // for a Qt::UniqueConnection doesn't walk all the connections of the
+    // signal. The index is only used with the signalSlotLock() held, never
+    // by activate().
+    static constexpr int ReceiverIndexThreshold = 64;
+    using ReceiverIndex = QMultiHash<std::pair<int, const QObject *>, Connection *>;
+    std::unique_ptr<ReceiverIndex> receiverIndex;
+    int connectionCount = 0;
+
     ~ConnectionData()
     {
         Q_ASSERT(ref.loadRelaxed() == 0);
@@ -160,6 +179,10 @@ struct QObjectPrivate::ConnectionData
     // must be called on the senders connection data
     // assumes the senders and receivers lock are held
     void removeConnection(Connection *c);
+    // assumes the senders lock is held
+    void connectionAdded(Connection *c);
+    using ConnectionsToReceiver = QVarLengthArray<Connection *, 4>;
+    ConnectionsToReceiver connectionsTo(int signal, const QObject *receiver);
     enum LockPolicy {
         NeedToLock,
         // Beware that we need to temporarily release the lock
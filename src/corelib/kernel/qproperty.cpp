@@ -6,6 +6,7 @@
 
 #include <qscopedvaluerollback.h>
 #include <QScopeGuard>
+#include <QtCore/qhash.h>
 #include <QtCore/qloggingcategory.h>
 #include <QThread>
 #include <QtCore/qmetaobject.h>
@@ -122,10 +123,27 @@ struct QPropertyDelayedNotifications
         binding updates and notifications used in non-deferred updates).
      */
      void evaluateBindings(PendingBindingObserverList &bindingObservers, qsizetype index, QBindingStatus *status) {
+        auto *bindingData = restoreBindingData(index);
+        if (!bindingData)
+            return;
+
+        QPropertyBindingDataPointer bindingDataPointer{bindingData};
+        QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
+        if (observer)
+            observer.evaluateBindings(bindingObservers, status);
+    }
+
+    /*!
+        \internal
+        Restores the original binding data of the QPropertyProxyBindingData at position
+        \a index, which was modified in addProperty. Returns the binding data, or \nullptr
+        if the property has been destroyed in the meantime.
+     */
+    const QPropertyBindingData *restoreBindingData(qsizetype index) {
         auto *delayed = delayedProperties + index;
         auto *bindingData = delayed->originalBindingData;
         if (!bindingData)
-            return;
+            return nullptr;
 
         bindingData->d_ptr = delayed->d_ptr;
         Q_ASSERT(!(bindingData->d_ptr & QPropertyBindingData::DelayedNotificationBit));
@@ -133,11 +151,24 @@ struct QPropertyDelayedNotifications
             if (auto observer = reinterpret_cast<QPropertyObserver *>(bindingData->d_ptr))
                 observer->prev = reinterpret_cast<QPropertyObserver **>(&bindingData->d_ptr);
         }
+        return bindingData;
+    }
 
-        QPropertyBindingDataPointer bindingDataPointer{bindingData};
-        QPropertyObserverPointer observer = bindingDataPointer.firstObserver();
-        if (observer)
-            observer.evaluateBindings(bindingObservers, status);
+    /*!
+        \internal
+        Returns the first observer of the property at position \a index, without restoring its
+        binding data.
+     */
+    QPropertyObserverPointer firstObserver(qsizetype index) const {
+        const auto *delayed = delayedProperties + index;
+        if (!delayed->originalBindingData)
+            return {};
+        if (delayed->d_ptr & QPropertyBindingData::BindingBit) {
+            auto *binding = reinterpret_cast<QPropertyBindingPrivate *>(
+                        delayed->d_ptr - QPropertyBindingData::BindingBit);
+            return binding->firstObserver;
+        }
+        return { reinterpret_cast<QPropertyObserver *>(delayed->d_ptr) };
     }
 
     /*!
@@ -165,6 +196,127 @@ struct QPropertyDelayedNotifications
     }
 };
 
+/*!
+    \internal
+
+    QPropertyBindingScheduler evaluates the bindings depending on the properties changed in a
+    property update group. Evaluating the observers of each changed property recursively
+    would evaluate a binding once for every path leading to it; instead, all dependent
+    bindings are sorted topologically first, and each of them is then evaluated at most once,
+    after all the bindings it depends on have been evaluated.
+
+    \sa Qt::endPropertyUpdateGroup
+*/
+struct QPropertyBindingScheduler
+{
+    enum State : quint8 {
+        Visiting,   // on the stack of sort
+        Sorted,     // in sortedBindings, but no dependency has changed (yet)
+        Dirty,      // in sortedBindings, and needs to be evaluated
+        Unchanged,  // evaluated to the value it had before
+        Changed     // evaluated to a new value, needs to notify its observers
+    };
+    QHash<QPropertyBindingPrivate *, State> states;
+    // in reverse topological order; keeps the bindings alive until the group has ended
+    std::vector<QPropertyBindingPrivatePtr> sortedBindings;
+    bool hasCycle = false;
+
+    template <typename Callback>
+    static void forEachDependentBinding(QPropertyObserverPointer observer, Callback callback)
+    {
+        for (QPropertyObserver *o = observer.ptr; o; o = o->next.data()) {
+            if (QPropertyObserver::ObserverTag(o->next.tag()) == QPropertyObserver::ObserverNotifiesBinding)
+                callback(o->binding);
+        }
+    }
+
+    /*!
+        \internal
+        Schedules the bindings depending on a changed property, whose observers start at
+        \a observer, and everything depending on them.
+     */
+    void addChangedProperty(QPropertyObserverPointer observer)
+    {
+        forEachDependentBinding(observer, [this](QPropertyBindingPrivate *binding) {
+            sort(binding);
+            auto it = states.find(binding);
+            if (it.value() == Sorted)
+                it.value() = Dirty;
+        });
+    }
+
+    void sort(QPropertyBindingPrivate *binding)
+    {
+        if (auto it = states.constFind(binding); it != states.constEnd()) {
+            // a binding loop; leave reporting it to evaluateRecursive
+            if (it.value() == Visiting)
+                hasCycle = true;
+            return;
+        }
+        states.insert(binding, Visiting);
+        forEachDependentBinding(binding->firstObserver, [this](QPropertyBindingPrivate *dependent) {
+            sort(dependent);
+        });
+        states.insert(binding, Sorted);
+        sortedBindings.emplace_back(binding);
+    }
+
+    /*!
+        \internal
+        Evaluates the dirty bindings in dependency order. A binding whose value has changed
+        makes the bindings depending on it dirty. Bindings which picked up a new dependency
+        during this evaluation, and so were not sorted, are evaluated recursively, as outside
+        of a group, and added to \a bindingObservers.
+     */
+    void evaluate(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+    {
+        for (auto it = sortedBindings.crbegin(), end = sortedBindings.crend(); it != end; ++it) {
+            auto *binding = static_cast<QPropertyBindingPrivate *>(it->data());
+            auto state = states.find(binding);
+            // skip the binding if it has been removed from its property while evaluating
+            // another one
+            if (state.value() != Dirty || !binding->propertyDataPtr)
+                continue;
+            const bool changed = binding->evaluateNonRecursive_inline(status);
+            state.value() = changed ? Changed : Unchanged;
+            if (!changed)
+                continue;
+
+            QPropertyObserver *observer = binding->firstObserver.ptr;
+            while (observer) {
+                QPropertyObserver *next = observer->next.data();
+                if (QPropertyObserver::ObserverTag(observer->next.tag()) == QPropertyObserver::ObserverNotifiesBinding) {
+                    auto dependent = states.find(observer->binding);
+                    if (dependent == states.end() || dependent.value() >= Unchanged) {
+                        QPropertyObserverNodeProtector protector(observer);
+                        QBindingObserverPtr bindingObserver(observer);
+                        if (observer->binding->evaluateRecursive_inline(bindingObservers, status))
+                            bindingObservers.push_back(std::move(bindingObserver));
+                        next = protector.next();
+                    } else if (dependent.value() == Sorted) {
+                        dependent.value() = Dirty;
+                    }
+                }
+                observer = next;
+            }
+        }
+    }
+
+    /*!
+        \internal
+        Sends the change notifications of the evaluated bindings, in the order in which they
+        were evaluated.
+     */
+    void notify()
+    {
+        for (auto it = sortedBindings.crbegin(), end = sortedBindings.crend(); it != end; ++it) {
+            auto *binding = static_cast<QPropertyBindingPrivate *>(it->data());
+            if (states.value(binding) == Changed)
+                binding->notifyNonRecursive();
+        }
+    }
+};
+
 Q_CONSTINIT static thread_local QBindingStatus bindingStatus;
 
 /*!
@@ -202,6 +354,9 @@ void Qt::beginPropertyUpdateGroup()
     Ends a property update group. If the outermost group has been ended, and deferred
     binding evaluations and notifications happen now.
 
+    Each binding depending on properties changed in the group is evaluated at most once,
+    after the bindings it depends on.
+
     \warning Calling endPropertyUpdateGroup without a preceding call to beginPropertyUpdateGroup
     results in undefined behavior.
 
@@ -218,12 +373,27 @@ void Qt::endPropertyUpdateGroup()
     groupUpdateData = nullptr;
     // ensures that bindings are kept alive until endPropertyUpdateGroup concludes
     PendingBindingObserverList bindingObservers;
-    // update all delayed properties
+    QPropertyBindingScheduler scheduler;
     auto start = data;
-    while (data) {
+    for (; data; data = data->next) {
         for (qsizetype i = 0; i < data->used; ++i)
-            data->evaluateBindings(bindingObservers, i, status);
-        data = data->next;
+            scheduler.addChangedProperty(data->firstObserver(i));
+    }
+    data = start;
+    if (!scheduler.hasCycle) {
+        // restore all delayed properties, then evaluate each dependent binding once
+        for (; data; data = data->next) {
+            for (qsizetype i = 0; i < data->used; ++i)
+                data->restoreBindingData(i);
+        }
+        scheduler.evaluate(bindingObservers, status);
+        scheduler.notify();
+    } else {
+        // update all delayed properties, letting evaluateRecursive report the binding loop
+        for (; data; data = data->next) {
+            for (qsizetype i = 0; i < data->used; ++i)
+                data->evaluateBindings(bindingObservers, i, status);
+        }
     }
     // notify all delayed notifications from binding evaluation
     for (const QBindingObserverPtr &observer: bindingObservers) {
@@ -227,9 +227,12 @@ class Q_CORE_EXPORT QPropertyBindingPrivate : public QtPrivate::RefCounted
 private:
     friend struct QPropertyBindingDataPointer;
     friend class QPropertyBindingPrivatePtr;
+    friend struct QPropertyBindingScheduler;
 
     using ObserverArray = std::array<QPropertyObserver, 4>;
 
+    bool Q_ALWAYS_INLINE evaluate_inline(PendingBindingObserverList *bindingObservers, QBindingStatus *status);
+
 private:
 
     // used to detect binding loops for lazy evaluated properties
@@ -369,6 +372,7 @@ public:
     bool evaluateRecursive(PendingBindingObserverList &bindingObservers, QBindingStatus *status = nullptr);
 
     bool Q_ALWAYS_INLINE evaluateRecursive_inline(PendingBindingObserverList &bindingObservers, QBindingStatus *status);
+    bool Q_ALWAYS_INLINE evaluateNonRecursive_inline(QBindingStatus *status);
 
     void notifyNonRecursive(const PendingBindingObserverList &bindingObservers);
     enum NotificationState : bool { Delayed, Sent };
@@ -790,6 +794,23 @@ struct QUntypedBindablePrivate
 };
 
 inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObserverList &bindingObservers, QBindingStatus *status)
+{
+    return evaluate_inline(&bindingObservers, status);
+}
+
+/*!
+    \internal
+
+    Evaluates the binding, but unlike evaluateRecursive_inline() does not evaluate the
+    bindings depending on it. Used by QPropertyBindingScheduler, which evaluates those
+    itself, in dependency order.
+ */
+inline bool QPropertyBindingPrivate::evaluateNonRecursive_inline(QBindingStatus *status)
+{
+    return evaluate_inline(nullptr, status);
+}
+
+inline bool QPropertyBindingPrivate::evaluate_inline(PendingBindingObserverList *bindingObservers, QBindingStatus *status)
 {
     if (updating) {
         error = QPropertyBindingError(QPropertyBindingError::BindingLoop);
@@ -824,11 +845,11 @@ inline bool QPropertyBindingPrivate::evaluateRecursive_inline(PendingBindingObse
     // If there was a change, we must set pendingNotify.
     // If there was not, we must not clear it, as that only should happen in notifyRecursive
     pendingNotify = pendingNotify || changed;
-    if (!changed || !firstObserver)
+    if (!changed || !firstObserver || !bindingObservers)
         return changed;
 
     firstObserver.noSelfDependencies(this);
-    firstObserver.evaluateBindings(bindingObservers, status);
+    firstObserver.evaluateBindings(*bindingObservers, status);
     return true;
 }
 
@@ -27,23 +27,53 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
 QTimerInfoList::QTimerInfoList() = default;
 
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
+    qDeleteAll(wheelTimers);
+}
+
 steady_clock::time_point QTimerInfoList::updateCurrentTime()
 {
     currentTime = steady_clock::now();
     return currentTime;
 }
 
+// the tick of the timer wheel at which a timeout has passed
+static qint64 wheelTick(steady_clock::time_point timeout)
+{
+    return ceil<milliseconds>(timeout.time_since_epoch()).count();
+}
+
+/*! \internal
+    Returns the earliest timeout of all timers, or time_point::max() if there
+    are none. Coarse timers are only accurate to the tick of the wheel.
+*/
+steady_clock::time_point QTimerInfoList::firstTimeout() const
+{
+    steady_clock::time_point first = steady_clock::time_point::max();
+    if (!timers.isEmpty())
+        first = timers.constFirst()->timeout;
+    if (expired) {
+        first = std::min(first, expired->timeout);
+    } else if (const qint64 tick = wheelFirstTick(); tick >= 0) {
+        first = std::min(first, steady_clock::time_point(milliseconds(tick)));
+    }
+    return first;
+}
+
 /*! \internal
     Updates the currentTime member to the current time, and returns \c true if
     the first timer's timeout is in the future (after currentTime).
 
-    The list is sorted by timeout, thus it's enough to check the first timer only.
+    The list is sorted by timeout and the timer wheel knows its earliest tick,
+    thus it's enough to check the first timer of each only.
 */
 bool QTimerInfoList::hasPendingTimers()
 {
     if (isEmpty())
         return false;
-    return updateCurrentTime() < constFirst()->timeout;
+    return updateCurrentTime() < firstTimeout();
 }
 
 /*
@@ -51,13 +81,165 @@ bool QTimerInfoList::hasPendingTimers()
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
+    qsizetype index = timers.size();
     while (index--) {
-        const QTimerInfo * const t = at(index);
+        const QTimerInfo * const t = timers.at(index);
         if (!(ti->timeout < t->timeout))
             break;
     }
-    insert(index+1, ti);
+    timers.insert(index+1, ti);
+}
+
+// the slot lists are LIFO; this restores the order timers were added in
+static QTimerInfo *reversed(QTimerInfo *t)
+{
+    QTimerInfo *first = nullptr;
+    while (t) {
+        QTimerInfo *next = t->wheelNext;
+        t->wheelNext = first;
+        first = t;
+        t = next;
+    }
+    return first;
+}
+
+/*
+  insert a coarse timer into the slot of the timer wheel its timeout falls in
+*/
+void QTimerInfoList::wheelInsert(QTimerInfo *t)
+{
+    const qint64 tick = std::max(wheelTick(t->timeout), wheelTime);
+    qint64 slotTick = tick;
+    const qint64 delta = tick - wheelTime;
+    int level = 0;
+    while (level < WheelLevels - 1 && (delta >> (WheelBits * (level + 1))))
+        ++level;
+    if (delta >> (WheelBits * WheelLevels)) // beyond the last level
+        slotTick = wheelTime + (qint64(1) << (WheelBits * WheelLevels)) - 1;
+    const int slot = int((slotTick >> (WheelBits * level)) & (WheelSlots - 1));
+
+    QTimerInfo *&head = wheel[level * WheelSlots + slot];
+    t->wheelSlot = level * WheelSlots + slot;
+    t->wheelPrev = &head;
+    t->wheelNext = head;
+    if (head)
+        head->wheelPrev = &t->wheelNext;
+    head = t;
+    wheelOccupied[level] |= quint64(1) << slot;
+
+    if (wheelFirst >= 0)
+        wheelFirst = std::min(wheelFirst, tick);
+}
+
+/*
+  remove a coarse timer from its slot, or from the list of expired timers
+*/
+void QTimerInfoList::wheelUnlink(QTimerInfo *t)
+{
+    *t->wheelPrev = t->wheelNext;
+    if (t->wheelNext)
+        t->wheelNext->wheelPrev = t->wheelPrev;
+    else if (t->wheelSlot < 0)
+        expiredTail = t->wheelPrev;
+    if (t->wheelSlot >= 0 && !wheel[t->wheelSlot])
+        wheelOccupied[t->wheelSlot / WheelSlots] &= ~(quint64(1) << (t->wheelSlot % WheelSlots));
+    if (wheelFirst >= 0 && wheelTick(t->timeout) <= wheelFirst)
+        wheelFirst = -1;
+    t->wheelNext = nullptr;
+    t->wheelPrev = nullptr;
+    t->wheelSlot = -1;
+}
+
+/*
+  process the ticks of the timer wheel up to and including \a until, moving
+  the timers that expire to the list of expired timers
+*/
+void QTimerInfoList::wheelAdvance(qint64 until)
+{
+    auto isOccupied = [](quint64 occupied) { return occupied != 0; };
+    while (wheelTime <= until) {
+        if (std::none_of(std::begin(wheelOccupied), std::end(wheelOccupied), isOccupied)) {
+            wheelTime = until + 1;
+            break;
+        }
+
+        const int index = int(wheelTime & (WheelSlots - 1));
+        if (index == 0) {
+            // a new round of the first level: cascade the timers of the slots
+            // of the upper levels that begin now into the lower levels
+            for (int level = 1; level < WheelLevels; ++level) {
+                const int slot = int((wheelTime >> (WheelBits * level)) & (WheelSlots - 1));
+                QTimerInfo *t = reversed(std::exchange(wheel[level * WheelSlots + slot], nullptr));
+                wheelOccupied[level] &= ~(quint64(1) << slot);
+                while (t)
+                    wheelInsert(std::exchange(t, t->wheelNext));
+                if (slot != 0)
+                    break;
+            }
+        }
+
+        if (QTimerInfo *t = reversed(std::exchange(wheel[index], nullptr))) {
+            wheelOccupied[0] &= ~(quint64(1) << index);
+            while (t) {
+                QTimerInfo *next = t->wheelNext;
+                t->wheelSlot = -1;
+                t->wheelPrev = expiredTail;
+                t->wheelNext = nullptr;
+                *expiredTail = t;
+                expiredTail = &t->wheelNext;
+                t = next;
+            }
+        }
+
+        // skip the empty slots, but stop at the next round for cascading
+        const quint64 later = index == WheelSlots - 1 ? 0 : wheelOccupied[0] >> (index + 1);
+        const qint64 next = later ? wheelTime + 1 + qCountTrailingZeroBits(later)
+                                  : (wheelTime | (WheelSlots - 1)) + 1;
+        wheelTime = std::min(next, until + 1);
+    }
+
+    if (wheelFirst >= 0 && wheelFirst < wheelTime)
+        wheelFirst = -1;
+}
+
+/*
+  returns the earliest tick at which a timer in the timer wheel expires, or
+  -1 if the wheel is empty
+*/
+qint64 QTimerInfoList::wheelFirstTick() const
+{
+    if (wheelFirst >= 0)
+        return wheelFirst;
+
+    qint64 first = -1;
+    for (int level = 0; level < WheelLevels; ++level) {
+        const quint64 occupied = wheelOccupied[level];
+        if (!occupied)
+            continue;
+        // look at the slots from the current one on, wrapping around; unless
+        // its round begins with the tick that comes next, the current slot
+        // has been cascaded already, so whatever is in it is a round later
+        const int shift = WheelBits * level;
+        const int current = int((wheelTime >> shift) & (WheelSlots - 1));
+        const bool cascaded = wheelTime & ((qint64(1) << shift) - 1);
+        const int start = (cascaded ? current + 1 : current) & (WheelSlots - 1);
+        const quint64 rotated = start ? (occupied >> start) | (occupied << (WheelSlots - start))
+                                      : occupied;
+        const int slot = (start + int(qCountTrailingZeroBits(rotated))) & (WheelSlots - 1);
+
+        qint64 tick;
+        if (level == 0) {
+            // all timers in a slot of the first level expire on the same tick
+            tick = wheelTime + ((slot - current) & (WheelSlots - 1));
+        } else {
+            tick = std::numeric_limits<qint64>::max();
+            for (const QTimerInfo *t = wheel[level * WheelSlots + slot]; t; t = t->wheelNext)
+                tick = std::min(tick, std::max(wheelTick(t->timeout), wheelTime));
+        }
+        first = first < 0 ? tick : std::min(first, tick);
+    }
+    wheelFirst = first;
+    return first;
 }
 
 static constexpr milliseconds roundToMillisecond(nanoseconds val)
@@ -238,12 +420,18 @@ bool QTimerInfoList::timerWait(timespec &tm)
 
     auto isWaiting = [](QTimerInfo *tinfo) { return !tinfo->activateRef; };
     // Find first waiting timer not already active
-    auto it = std::find_if(cbegin(), cend(), isWaiting);
-    if (it == cend())
+    auto it = std::find_if(timers.cbegin(), timers.cend(), isWaiting);
+    steady_clock::time_point first = it == timers.cend() ? steady_clock::time_point::max()
+                                                         : (*it)->timeout;
+    if (expired) {
+        first = now;
+    } else if (const qint64 tick = wheelFirstTick(); tick >= 0) {
+        first = std::min(first, steady_clock::time_point(milliseconds(tick)));
+    }
+    if (first == steady_clock::time_point::max())
         return false;
 
-    QTimerInfo *t = *it;
-    nanoseconds timeToWait = t->timeout - now;
+    nanoseconds timeToWait = first - now;
     if (timeToWait > 0ns)
         tm = durationToTimespec(roundToMillisecond(timeToWait));
     else
@@ -266,15 +454,18 @@ milliseconds QTimerInfoList::remainingDuration(int timerId)
 {
     const steady_clock::time_point now = updateCurrentTime();
 
-    auto it = findTimerById(timerId);
-    if (it == cend()) {
+    const QTimerInfo *t = wheelTimers.value(timerId);
+    if (!t) {
+        auto it = findTimerById(timerId);
+        if (it == timers.cend()) {
 #ifndef QT_NO_DEBUG
-        qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", timerId);
+            qWarning("QTimerInfoList::timerRemainingTime: timer id %i not found", timerId);
 #endif
-        return -1ms;
+            return -1ms;
+        }
+        t = *it;
     }
 
-    const QTimerInfo *t = *it;
     if (now < t->timeout) // time to wait
         return roundToMillisecond(t->timeout - now);
     return 0ms;
@@ -331,23 +522,47 @@ void QTimerInfoList::registerTimer(int timerId, milliseconds interval,
             t->timeout += 1s;
     }
 
-    timerInsert(t);
+    if (t->timerType == Qt::PreciseTimer) {
+        timerInsert(t);
+    } else {
+        // an empty wheel can start over at the current time
+        auto isOccupied = [](quint64 occupied) { return occupied != 0; };
+        if (std::none_of(std::begin(wheelOccupied), std::end(wheelOccupied), isOccupied)) {
+            const qint64 now = floor<milliseconds>(currentTime.time_since_epoch()).count();
+            wheelTime = std::max(wheelTime, now);
+        }
+        wheelTimers.insert(t->id, t);
+        wheelInsert(t);
+    }
 }
 
-bool QTimerInfoList::unregisterTimer(int timerId)
+/*
+  set timer inactive and delete it, after it has been taken out of the list or wheel
+*/
+void QTimerInfoList::removeTimer(QTimerInfo *t)
 {
-    auto it = findTimerById(timerId);
-    if (it == cend())
-        return false; // id not found
-
-    // set timer inactive
-    QTimerInfo *t = *it;
     if (t == firstTimerInfo)
         firstTimerInfo = nullptr;
     if (t->activateRef)
         *(t->activateRef) = nullptr;
     delete t;
-    erase(it);
+}
+
+bool QTimerInfoList::unregisterTimer(int timerId)
+{
+    if (QTimerInfo *t = wheelTimers.take(timerId)) {
+        wheelUnlink(t);
+        removeTimer(t);
+        return true;
+    }
+
+    auto it = findTimerById(timerId);
+    if (it == timers.cend())
+        return false; // id not found
+
+    QTimerInfo *t = *it;
+    timers.erase(it);
+    removeTimer(t);
     return true;
 }
 
@@ -355,16 +570,22 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    for (auto it = wheelTimers.begin(); it != wheelTimers.end(); ) {
+        QTimerInfo *t = it.value();
+        if (t->obj == object) {
+            it = wheelTimers.erase(it);
+            wheelUnlink(t);
+            removeTimer(t);
+        } else {
+            ++it;
+        }
+    }
+    for (qsizetype i = 0; i < timers.size(); ++i) {
+        QTimerInfo *t = timers.at(i);
         if (t->obj == object) {
             // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
+            timers.removeAt(i);
+            removeTimer(t);
             // move back one so that we don't skip the new current item
             --i;
         }
@@ -375,13 +596,30 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (const QTimerInfo *const t : std::as_const(*this)) {
+    for (const QTimerInfo *const t : std::as_const(timers)) {
+        if (t->obj == object)
+            list.emplaceBack(t->id, t->interval.count(), t->timerType);
+    }
+    for (const QTimerInfo *const t : std::as_const(wheelTimers)) {
         if (t->obj == object)
             list.emplaceBack(t->id, t->interval.count(), t->timerType);
     }
     return list;
 }
 
+/*
+  returns the timer that should be activated next, if any has expired
+*/
+QTimerInfo *QTimerInfoList::firstExpired(steady_clock::time_point now) const
+{
+    QTimerInfo *t = nullptr;
+    if (!timers.isEmpty() && !(now < timers.constFirst()->timeout))
+        t = timers.constFirst();
+    if (expired && (!t || expired->timeout < t->timeout))
+        t = expired;
+    return t;
+}
+
 /*
     Activate pending timers, returning how many where activated.
 */
@@ -394,20 +632,20 @@ int QTimerInfoList::activateTimers()
 
     const steady_clock::time_point now = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << now;
+    wheelAdvance(floor<milliseconds>(now.time_since_epoch()).count());
     // Find out how many timer have expired
     auto stillActive = [&now](const QTimerInfo *t) { return now < t->timeout; };
     // Find first one still active (list is sorted by timeout)
-    auto it = std::find_if(cbegin(), cend(), stillActive);
-    auto maxCount = it - cbegin();
+    auto it = std::find_if(timers.cbegin(), timers.cend(), stillActive);
+    auto maxCount = it - timers.cbegin();
+    for (const QTimerInfo *t = expired; t; t = t->wheelNext)
+        ++maxCount;
 
     int n_act = 0;
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (now < currentTimerInfo->timeout)
+        QTimerInfo *currentTimerInfo = firstExpired(now);
+        if (!currentTimerInfo)
             break; // no timer has expired
 
         if (!firstTimerInfo) {
@@ -421,13 +659,20 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        const bool inWheel = currentTimerInfo->wheelPrev;
+        if (inWheel)
+            wheelUnlink(currentTimerInfo);
+        else
+            timers.removeFirst();
 
         // determine next timeout time
         calculateNextTimeout(currentTimerInfo, now);
 
         // reinsert timer
-        timerInsert(currentTimerInfo);
+        if (inWheel)
+            wheelInsert(currentTimerInfo);
+        else
+            timerInsert(currentTimerInfo);
         if (currentTimerInfo->interval > 0ms)
             n_act++;
 
@@ -18,6 +18,7 @@
 #include <QtCore/private/qglobal_p.h>
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timespec
 #include <chrono>
@@ -32,15 +33,24 @@ struct QTimerInfo {
     std::chrono::steady_clock::time_point timeout; // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+
+    // coarse timers only: links in the timer wheel slot, or in the list of
+    // expired timers (slot -1), that the timer is in
+    QTimerInfo *wheelNext = nullptr;
+    QTimerInfo **wheelPrev = nullptr;
+    int wheelSlot = -1;
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+class Q_CORE_EXPORT QTimerInfoList
 {
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo = nullptr;
 
+    Q_DISABLE_COPY_MOVE(QTimerInfoList)
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     std::chrono::steady_clock::time_point currentTime;
 
@@ -60,14 +70,45 @@ public:
     int activateTimers();
     bool hasPendingTimers();
 
-    QList::const_iterator findTimerById(int timerId) const
+    bool isEmpty() const { return timers.isEmpty() && wheelTimers.isEmpty(); }
+    qsizetype size() const { return timers.size() + wheelTimers.size(); }
+
+    QList<QTimerInfo *>::const_iterator findTimerById(int timerId) const
     {
         auto matchesId = [timerId](const QTimerInfo *t) { return t->id == timerId; };
-        return std::find_if(cbegin(), cend(), matchesId);
+        return std::find_if(timers.cbegin(), timers.cend(), matchesId);
     }
 
 private:
     std::chrono::steady_clock::time_point updateCurrentTime();
+    std::chrono::steady_clock::time_point firstTimeout() const;
+    QTimerInfo *firstExpired(std::chrono::steady_clock::time_point now) const;
+    void removeTimer(QTimerInfo *t);
+
+    void wheelInsert(QTimerInfo *t);
+    void wheelUnlink(QTimerInfo *t);
+    void wheelAdvance(qint64 until);
+    qint64 wheelFirstTick() const;
+
+    // Qt::PreciseTimer timers, sorted by timeout
+    QList<QTimerInfo *> timers;
+
+    // Qt::CoarseTimer and Qt::VeryCoarseTimer timers live in a hierarchical
+    // timer wheel of millisecond ticks instead, so that starting and
+    // stopping them takes constant time. Level n has WheelSlots slots of
+    // WheelSlots^n ticks each; timers further ahead than the last level
+    // reaches wait in its last slot.
+    static constexpr int WheelBits = 6;
+    static constexpr int WheelSlots = 1 << WheelBits;
+    static constexpr int WheelLevels = 6;
+    QTimerInfo *wheel[WheelLevels * WheelSlots] = {};
+    quint64 wheelOccupied[WheelLevels] = {};
+    qint64 wheelTime = 0; // the first tick not processed yet
+    mutable qint64 wheelFirst = -1; // cached result of wheelFirstTick(), or -1
+    // expired timers taken from the wheel, in the order they expired
+    QTimerInfo *expired = nullptr;
+    QTimerInfo **expiredTail = &expired;
+    QHash<int, QTimerInfo *> wheelTimers;
 };
 
 QT_END_NAMESPACE
@@ -78,6 +78,18 @@ template <uint... Nx> constexpr auto stringData(const char (&...strings)[Nx])
 
 #  define QT_MOC_HAS_STRINGDATA       1
 
+// For QMetaObject::IndexOfMethod: if the signal pointer in _a[1] is signal,
+// stores its index in _a[0]. Moc calls it once for each signal, instead of
+// spelling out the comparison, to keep the generated code short.
+template <typename Func>
+inline bool indexOfMethod(void **_a, Func signal, int index) noexcept
+{
+    if (*reinterpret_cast<Func *>(_a[1]) != signal)
+        return false;
+    *reinterpret_cast<int *>(_a[0]) = index;
+    return true;
+}
+
 } // namespace QtMocHelpers
 QT_END_NAMESPACE
 
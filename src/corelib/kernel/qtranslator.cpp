@@ -1056,9 +1056,11 @@ void QTranslatorPrivate::clear()
     language.clear();
     filePath.clear();
 
-    if (QCoreApplicationPrivate::isTranslatorInstalled(q))
+    if (QCoreApplicationPrivate::isTranslatorInstalled(q)) {
+        QCoreApplicationPrivate::clearTranslationCache();
         QCoreApplication::postEvent(QCoreApplication::instance(),
                                     new QEvent(QEvent::LanguageChange));
+    }
 }
 
 /*!
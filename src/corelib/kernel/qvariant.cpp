@@ -2145,6 +2145,63 @@ bool QVariant::convert(QMetaType targetType)
     return ok;
 }
 
+/*!
+    \since 6.7
+
+    Converts the \a count variants starting at \a variants to \a targetType,
+    and assigns the results to the \a count objects of that type starting at
+    \a target. Objects whose variant cannot be converted are set to a
+    default-constructed value, as qvariant_cast() would return.
+
+    Returns \c true if all variants could be converted; otherwise returns
+    \c false.
+
+    Converting many values of the same type at once, for example all the
+    values of a column of query results, is faster than calling value() on
+    each of them: the conversions between the arithmetic types, which are the
+    most common, are done directly.
+
+    \sa convert(), value()
+*/
+bool QVariant::convert(const QVariant *variants, qsizetype count, QMetaType targetType, void *target)
+{
+    const QtPrivate::QMetaTypeInterface *iface = targetType.iface();
+    if (!iface)
+        return false;
+    const int targetTypeId = targetType.id();
+    auto out = static_cast<char *>(target);
+    bool ok = true;
+    for (qsizetype i = 0; i < count; ++i, out += iface->size) {
+        const Private &d = variants[i].d;
+        const QtPrivate::QMetaTypeInterface *from = d.typeInterface();
+        if (from && QtMetaTypePrivate::convertArithmetic(from->typeId.loadRelaxed(), d.storage(),
+                                                         targetTypeId, out)) {
+            continue;
+        }
+        if (!QMetaType::convert(d.type(), d.storage(), targetType, out)) {
+            QtMetaTypePrivate::destruct(iface, out);
+            QtMetaTypePrivate::defaultConstruct(iface, out);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/*!
+    \fn template <typename T> bool QVariant::convert(const QVariant *variants, qsizetype count, T *target)
+    \since 6.7
+    \overload
+
+    Converts the \a count variants starting at \a variants to \c T, and
+    assigns the results to the \a count objects starting at \a target.
+    Returns \c true if all variants could be converted.
+
+    \code
+    QList<double> prices(values.size());
+    QVariant::convert(values.constData(), values.size(), prices.data());
+    \endcode
+*/
+
 /*!
   \fn bool QVariant::convert(int type, void *ptr) const
   \internal
@@ -2349,6 +2406,21 @@ template <typename Numeric> static QPartialOrdering spaceShip(Numeric lhs, Numer
     return smaller ? QPartialOrdering::Less : QPartialOrdering::Greater;
 }
 
+// Compares values of the same builtin arithmetic type directly, instead of
+// through the equals and lessThan functions of their QMetaTypeInterface
+static std::optional<QPartialOrdering>
+arithmeticCompare(const QtPrivate::QMetaTypeInterface *iface, const void *lhs, const void *rhs)
+{
+    std::optional<QPartialOrdering> result;
+    if (iface) {
+        QtMetaTypePrivate::visitArithmetic(iface->typeId.loadRelaxed(), lhs, [&](const auto &l) {
+            using T = q20::remove_cvref_t<decltype(l)>;
+            result = spaceShip<T>(l, *static_cast<const T *>(rhs));
+        });
+    }
+    return result;
+}
+
 static QPartialOrdering integralCompare(uint promotedType, const QVariant::Private *d1, const QVariant::Private *d2)
 {
     // use toLongLong to retrieve the data, it gets us all the bits
@@ -2424,6 +2496,8 @@ bool QVariant::equals(const QVariant &v) const
     if (!metatype.isValid())
         return true;
 
+    if (auto r = arithmeticCompare(metatype.iface(), d.storage(), v.d.storage()))
+        return *r == QPartialOrdering::Equivalent;
     return metatype.equals(d.storage(), v.d.storage());
 }
 
@@ -2462,6 +2536,8 @@ QPartialOrdering QVariant::compare(const QVariant &lhs, const QVariant &rhs)
 #endif
         return QPartialOrdering::Unordered;
     }
+    if (auto r = arithmeticCompare(t.iface(), lhs.d.storage(), rhs.d.storage()))
+        return *r;
     return t.compare(lhs.constData(), rhs.constData());
 }
 
@@ -342,6 +342,10 @@ public:
     bool canConvert(QMetaType targetType) const
     { return QMetaType::canConvert(d.type(), targetType); }
     bool convert(QMetaType type);
+    static bool convert(const QVariant *variants, qsizetype count, QMetaType targetType, void *target);
+    template <typename T>
+    static bool convert(const QVariant *variants, qsizetype count, T *target)
+    { return convert(variants, count, QMetaType::fromType<T>(), target); }
 
     bool canView(QMetaType targetType) const
     { return QMetaType::canView(d.type(), targetType); }
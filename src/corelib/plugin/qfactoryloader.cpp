@@ -251,6 +251,7 @@ void QFactoryLoader::update()
     }
     if (!d->extraSearchPath.isEmpty())
         d->updateSinglePath(d->extraSearchPath);
+    qt_savePluginMetaDataCache();
 #else
     Q_D(QFactoryLoader);
     qCDebug(lcFactoryLoader) << "ignoring" << d->iid
@@ -6,6 +6,8 @@
 
 #include <q20algorithm.h>
 #include <qbytearraymatcher.h>
+#include <qcborarray.h>
+#include <qcbormap.h>
 #include <qdebug.h>
 #include <qendian.h>
 #include <qfile.h>
@@ -14,7 +16,11 @@
 #include <qmap.h>
 #include <qmutex.h>
 #include <qoperatingsystemversion.h>
+#if QT_CONFIG(temporaryfile)
+#include <qsavefile.h>
+#endif
 #include <qstringlist.h>
+#include <qtimezone.h>
 
 #ifdef Q_OS_DARWIN
 #  include <private/qcore_mac_p.h>
@@ -200,6 +206,126 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
     return { i, s_len - i };
 }
 
+/*
+  With QT_PLUGIN_METADATA_CACHE set to a file name, the metadata found in
+  plugins is kept in that file between runs, keyed on the plugin's file name,
+  size and modification time, so that plugins don't need to be opened and
+  parsed again. QFactoryLoader saves it after scanning a directory.
+*/
+namespace {
+struct PluginMetaDataCache
+{
+    static constexpr int FormatVersion = 1;
+
+    struct Entry
+    {
+        qint64 size;
+        qint64 lastModified;
+        QByteArray metaData;
+    };
+
+    QMutex mutex;
+    const QString fileName = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+    QHash<QString, Entry> entries;
+    bool loaded = false;
+    bool dirty = false;
+
+    void load();
+    void save();
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(PluginMetaDataCache, pluginMetaDataCache)
+
+static std::pair<qint64, qint64> fileStamp(const QString &fileName)
+{
+    const QFileInfo fi(fileName);
+    return { fi.size(), fi.lastModified(QTimeZone::UTC).toMSecsSinceEpoch() };
+}
+
+void PluginMetaDataCache::load()
+{
+    loaded = true;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QCborArray contents = QCborValue::fromCbor(file.readAll()).toArray();
+    if (contents.at(0).toInteger() != FormatVersion)
+        return;
+    const QCborMap map = contents.at(1).toMap();
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+        const QCborArray entry = it.value().toArray();
+        entries.insert(it.key().toString(), { entry.at(0).toInteger(), entry.at(1).toInteger(),
+                                              entry.at(2).toByteArray() });
+    }
+    qCDebug(qt_lcDebugPlugins, "Read the metadata of %lld plugins from %ls",
+            qlonglong(entries.size()), qUtf16Printable(fileName));
+}
+
+void PluginMetaDataCache::save()
+{
+    QCborMap map;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        map.insert(it.key(), QCborArray{ it->size, it->lastModified, it->metaData });
+    const QByteArray data = QCborArray{ FormatVersion, map }.toCborValue().toCbor();
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(fileName);
+#else
+    QFile file(fileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()
+#if QT_CONFIG(temporaryfile)
+        || !file.commit()
+#endif
+        ) {
+        qCWarning(qt_lcDebugPlugins, "%ls: cannot write the plugin metadata cache: %ls",
+                  qUtf16Printable(fileName), qUtf16Printable(file.errorString()));
+    }
+    dirty = false;
+}
+
+static bool lookupCachedMetaData(const QString &library, QPluginParsedMetaData *metaData)
+{
+    PluginMetaDataCache *cache = pluginMetaDataCache();
+    if (!cache || cache->fileName.isEmpty())
+        return false;
+
+    QMutexLocker locker(&cache->mutex);
+    if (!cache->loaded)
+        cache->load();
+    const auto it = cache->entries.constFind(library);
+    if (it == cache->entries.cend())
+        return false;
+    const auto [size, lastModified] = fileStamp(library);
+    if (size != it->size || lastModified != it->lastModified)
+        return false;
+    return metaData->parse(it->metaData);
+}
+
+static void insertCachedMetaData(const QString &library, QByteArrayView rawMetaData)
+{
+    PluginMetaDataCache *cache = pluginMetaDataCache();
+    if (!cache || cache->fileName.isEmpty())
+        return;
+
+    const auto [size, lastModified] = fileStamp(library);
+    QMutexLocker locker(&cache->mutex);
+    cache->entries.insert(library, { size, lastModified, rawMetaData.toByteArray() });
+    cache->dirty = true;
+}
+
+void qt_savePluginMetaDataCache()
+{
+    PluginMetaDataCache *cache = pluginMetaDataCache();
+    if (!cache || cache->fileName.isEmpty())
+        return;
+
+    QMutexLocker locker(&cache->mutex);
+    if (cache->dirty)
+        cache->save();
+}
+
 /*
   This opens the specified library, mmaps it into memory, and searches
   for the QT_PLUGIN_VERIFICATION_DATA.  The advantage of this approach is that
@@ -264,6 +390,7 @@ static QLibraryScanResult findPatternUnloaded(const QString &library, QLibraryPr
             qCDebug(qt_lcDebugPlugins, "Found metadata in lib %ls, metadata=\n%s\n",
                     qUtf16Printable(library),
                     QJsonDocument(lib->metaData.toJson()).toJson().constData());
+            insertCachedMetaData(library, QByteArrayView(filedata + r.pos, r.length));
             return r;
         }
     } else {
@@ -726,7 +853,10 @@ void QLibraryPrivate::updatePluginState()
     }
 #endif
 
-    if (!pHnd.loadRelaxed()) {
+    if (!pHnd.loadRelaxed() && lookupCachedMetaData(fileName, &metaData)) {
+        qCDebug(qt_lcDebugPlugins, "Using cached metadata of lib %ls", qUtf16Printable(fileName));
+        success = true;
+    } else if (!pHnd.loadRelaxed()) {
         // scan for the plugin metadata without loading
         QLibraryScanResult result = findPatternUnloaded(fileName, this);
 #if defined(Q_OF_MACH_O)
@@ -34,6 +34,8 @@ QT_BEGIN_NAMESPACE
 
 Q_DECLARE_LOGGING_CATEGORY(qt_lcDebugPlugins)
 
+void qt_savePluginMetaDataCache();
+
 struct QLibraryScanResult
 {
     qsizetype pos;
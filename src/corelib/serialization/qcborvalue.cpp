@@ -281,6 +281,26 @@ Q_DECL_UNUSED static constexpr quint64 MaximumPreallocatedElementCount =
     \sa toDiagnosticNotation()
  */
 
+/*!
+    \enum QCborValue::DecodingOption
+    \since 6.7
+
+    This enum is used in the options argument to fromCbor(), to modify how
+    the data is decoded.
+
+    \value NoDecodingOptions (Default) Copies all strings and byte arrays out
+                             of the CBOR data.
+    \value ShareSourceData   Strings and byte arrays that are not too short
+                             refer to the bytes of the CBOR data instead of
+                             copying them. The decoded values keep the
+                             implicitly shared QByteArray holding the CBOR
+                             data alive, so this uses less memory and time
+                             when most of the data is kept, and more memory
+                             if only a small part of it is.
+
+    \sa fromCbor()
+ */
+
 /*!
     \enum QCborValue::Type
 
@@ -846,7 +866,7 @@ static QCborValue::Type convertToExtendedType(QCborContainerPrivate *d)
             // force the size to 16
             char buf[sizeof(QUuid)] = {};
             if (b)
-                memcpy(buf, b->byte(), qMin(sizeof(buf), size_t(b->len)));
+                memcpy(buf, b->byte(), qMin(sizeof(buf), size_t(b->size())));
             replaceByteData(buf, sizeof(buf), {});
 
             return QCborValue::Uuid;
@@ -1014,9 +1034,9 @@ void QCborContainerPrivate::replaceAt_complex(Element &e, const QCborValue &valu
         // Copy string data, if any
         if (const ByteData *b = value.container->byteData(value.n)) {
             if (this == value.container)
-                e.value = addByteData(b->toByteArray(), b->len);
+                e.value = addByteData(b->toByteArray(), b->size());
             else
-                e.value = addByteData(b->byte(), b->len);
+                e.value = addByteData(b->byte(), b->size());
         }
 
         if (disp == MoveContainer)
@@ -1049,14 +1069,15 @@ QCborValue QCborContainerPrivate::extractAt_complex(Element e)
     auto b = byteData(e);
     auto container = new QCborContainerPrivate;
 
-    if (b->len + qsizetype(sizeof(*b)) < data.size() / 4) {
+    if (b->storageSize() < data.size() / 4) {
         // make a shallow copy of the byte data
-        container->appendByteData(b->byte(), b->len, e.type, e.flags);
-        usedData -= b->len + qsizetype(sizeof(*b));
+        container->appendByteData(b->byte(), b->size(), e.type, e.flags);
+        usedData -= b->storageSize();
         compact(elements.size());
     } else {
         // just share with the original byte data
         container->data = data;
+        container->source = source;
         container->elements.reserve(1);
         container->elements.append(e);
     }
@@ -1124,8 +1145,8 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
     const ByteData *b1 = c1 ? c1->byteData(e1) : nullptr;
     const ByteData *b2 = c2 ? c2->byteData(e2) : nullptr;
     if (b1 || b2) {
-        auto len1 = b1 ? b1->len : 0;
-        auto len2 = b2 ? b2->len : 0;
+        auto len1 = b1 ? b1->size() : 0;
+        auto len2 = b2 ? b2->size() : 0;
 
         if (e1.flags & Element::StringIsUtf16)
             len1 /= 2;
@@ -1374,14 +1395,14 @@ static void encodeToCbor(QCborStreamWriter &writer, const QCborContainerPrivate
 
         case QCborValue::ByteArray:
             if (b)
-                return writer.appendByteString(b->byte(), b->len);
+                return writer.appendByteString(b->byte(), b->size());
             return writer.appendByteString("", 0);
 
         case QCborValue::String:
             if (b) {
                 if (e.flags & Element::StringIsUtf16)
                     return writer.append(b->asStringView());
-                return writer.appendTextString(b->byte(), b->len);
+                return writer.appendTextString(b->byte(), b->size());
             }
             return writer.append(QLatin1StringView());
 
@@ -1495,7 +1516,8 @@ static qsizetype clampedContainerLength(const QCborStreamReader &reader)
     return len << mapShift;
 }
 
-static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                                             const QByteArray &source)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1508,6 +1530,7 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
         QExplicitlySharedDataPointer u(new QCborContainerPrivate);
         if (qsizetype len = clampedContainerLength(reader))
             u->elements.reserve(len);
+        u->source = source;
         d = u.take();
     }
 
@@ -1528,7 +1551,8 @@ static inline QCborContainerPrivate *createContainerFromCbor(QCborStreamReader &
     return d;
 }
 
-static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth)
+static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRecursionDepth,
+                                      const QByteArray &source)
 {
     if (Q_UNLIKELY(remainingRecursionDepth == 0)) {
         QCborContainerPrivate::setErrorInReader(reader, { QCborError::NestingTooDeep });
@@ -1536,6 +1560,7 @@ static QCborValue taggedValueFromCbor(QCborStreamReader &reader, int remainingRe
     }
 
     auto d = new QCborContainerPrivate;
+    d->source = source;
     d->append(reader.toTag());
     reader.next();
 
@@ -1566,11 +1591,54 @@ inline void QCborContainerPrivate::setErrorInReader(QCborStreamReader &reader, Q
 
 extern QCborStreamReader::StringResultCode qt_cbor_append_string_chunk(QCborStreamReader &reader, QByteArray *data);
 
+bool QCborContainerPrivate::borrowStringFromCbor(QCborStreamReader &reader)
+{
+    // strings shorter than this are cheaper to copy than to point to
+    constexpr quint64 MinimumBorrowedSize = 32;
+    if (!reader.isLengthKnown() || reader.length() < MinimumBorrowedSize)
+        return false;
+
+    // the reader was created on source, so its offsets are ours too
+    const qint64 offset = reader.currentOffset();
+    Q_ASSERT(offset >= 0 && offset < source.size());
+    const quint8 additionalInformation = quint8(source.at(offset)) & 0x1f;
+    if (additionalInformation < 24 || additionalInformation > 27)
+        return false;
+    const qsizetype headerSize = 1 + (qsizetype(1) << (additionalInformation - 24));
+    const quint64 len = reader.length();
+    if (len > quint64(source.size() - offset - headerSize))
+        return false;           // truncated, let the copying code report it
+
+    Element e = {};
+    e.type = (reader.isByteArray() ? QCborValue::ByteArray : QCborValue::String);
+    e.flags = Element::HasByteData;
+    const char *ptr = source.constData() + offset + headerSize;
+    if (e.type == QCborValue::String) {
+        // the copying code reports these errors too
+        if (len > quint64(MaxStringSize))
+            return false;
+        const auto utf8result = QUtf8::isValidUtf8(QByteArrayView(ptr, qsizetype(len)));
+        if (!utf8result.isValidUtf8)
+            return false;
+        if (utf8result.isValidAscii)
+            e.flags |= Element::StringIsAscii;
+    }
+
+    if (reader.next()) {
+        e.value = addBorrowedByteData(ptr, qsizetype(len));
+        elements.append(e);
+    }
+    return true;
+}
+
 void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 {
     if (reader.lastError() != QCborError::NoError)
         return;
 
+    if (!source.isNull() && borrowStringFromCbor(reader))
+        return;
+
     qsizetype rawlen = reader.currentStringChunkSize();
     QByteArray::size_type len = rawlen;
     if (rawlen < 0)
@@ -1648,8 +1716,8 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
         Q_ASSERT(data.isDetached());
         const char *ptr = data.constData() + e.value;
         auto b = new (const_cast<char *>(ptr)) ByteData;
-        b->len = data.size() - e.value - int(sizeof(*b));
-        usedData += b->len;
+        b->rawLen = data.size() - e.value - int(sizeof(*b));
+        usedData += b->rawLen;
 
         if (isAscii) {
             // set the flag if it is US-ASCII only (as it often is)
@@ -1659,7 +1727,7 @@ void QCborContainerPrivate::decodeStringFromCbor(QCborStreamReader &reader)
 
         // check that this UTF-8 text string can be loaded onto a QString
         if (e.type == QCborValue::String) {
-            if (Q_UNLIKELY(b->len > MaxStringSize)) {
+            if (Q_UNLIKELY(b->rawLen > MaxStringSize)) {
                 setErrorInReader(reader, { QCborError::DataTooLarge });
                 status = QCborStreamReader::Error;
             }
@@ -1694,11 +1762,11 @@ void QCborContainerPrivate::decodeValueFromCbor(QCborStreamReader &reader, int r
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         return append(makeValue(t == QCborStreamReader::Array ? QCborValue::Array : QCborValue::Map, -1,
-                                createContainerFromCbor(reader, remainingRecursionDepth),
+                                createContainerFromCbor(reader, remainingRecursionDepth, source),
                                 MoveContainer));
 
     case QCborStreamReader::Tag:
-        return append(taggedValueFromCbor(reader, remainingRecursionDepth));
+        return append(taggedValueFromCbor(reader, remainingRecursionDepth, source));
 
     case QCborStreamReader::Invalid:
         return;                 // probably a decode error
@@ -2394,6 +2462,11 @@ QCborValueRef QCborValue::operator[](qint64 key)
     \sa toCbor(), toDiagnosticNotation(), toVariant(), toJsonValue()
  */
 QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
+{
+    return QCborContainerPrivate::decodeFromCbor(reader, QByteArray());
+}
+
+QCborValue QCborContainerPrivate::decodeFromCbor(QCborStreamReader &reader, const QByteArray &source)
 {
     QCborValue result;
     auto t = reader.type();
@@ -2422,9 +2495,10 @@ QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
     case QCborStreamReader::ByteArray:
     case QCborStreamReader::String:
         result.n = 0;
-        result.t = reader.isString() ? String : ByteArray;
+        result.t = reader.isString() ? QCborValue::String : QCborValue::ByteArray;
         result.container = new QCborContainerPrivate;
         result.container->ref.ref();
+        result.container->source = source;
         result.container->decodeStringFromCbor(reader);
         break;
 
@@ -2432,13 +2506,13 @@ QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
     case QCborStreamReader::Array:
     case QCborStreamReader::Map:
         result.n = -1;
-        result.t = reader.isArray() ? Array : Map;
-        result.container = createContainerFromCbor(reader, MaximumRecursionDepth);
+        result.t = reader.isArray() ? QCborValue::Array : QCborValue::Map;
+        result.container = createContainerFromCbor(reader, MaximumRecursionDepth, source);
         break;
 
     // tag
     case QCborStreamReader::Tag:
-        result = taggedValueFromCbor(reader, MaximumRecursionDepth);
+        result = taggedValueFromCbor(reader, MaximumRecursionDepth, source);
         break;
     }
 
@@ -2468,9 +2542,38 @@ QCborValue QCborValue::fromCbor(QCborStreamReader &reader)
     \sa toCbor(), toDiagnosticNotation(), toVariant(), toJsonValue()
  */
 QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
+{
+    return fromCbor(ba, error, NoDecodingOptions);
+}
+
+/*!
+    \overload
+    \since 6.7
+
+    Decodes one item from the CBOR stream found in the byte array \a ba,
+    using the options specified in \a opts, and returns the equivalent
+    representation. Errors are stored in \a error, if it is not \nullptr,
+    as in the overload above.
+
+    With QCborValue::ShareSourceData, the strings and byte arrays of the
+    result refer to the data in \a ba instead of being copied. This is
+    useful to decode large messages, for instance the contents of a memory
+    mapped file or of a network reply.
+
+    \sa toCbor(), DecodingOption
+ */
+QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error,
+                                DecodingOptions opts)
 {
     QCborStreamReader reader(ba);
-    QCborValue result = fromCbor(reader);
+    QByteArray source;
+    if (opts & ShareSourceData) {
+        source = ba;
+        // raw data we were not given ownership of may go away
+        if (source.isNull() || !source.data_ptr()->isMutable())
+            source = QByteArray(ba.constData(), ba.size());
+    }
+    QCborValue result = QCborContainerPrivate::decodeFromCbor(reader, source);
     if (error) {
         error->error = reader.lastError();
         error->offset = reader.currentOffset();
@@ -69,6 +69,12 @@ public:
     };
     Q_DECLARE_FLAGS(DiagnosticNotationOptions, DiagnosticNotationOption)
 
+    enum DecodingOption {
+        NoDecodingOptions   = 0x00,
+        ShareSourceData     = 0x01
+    };
+    Q_DECLARE_FLAGS(DecodingOptions, DecodingOption)
+
     // different from QCborStreamReader::Type because we have more types
     enum Type : int {
         Integer         = 0x00,
@@ -247,6 +253,8 @@ public:
 #if QT_CONFIG(cborstreamreader)
     static QCborValue fromCbor(QCborStreamReader &reader);
     static QCborValue fromCbor(const QByteArray &ba, QCborParserError *error = nullptr);
+    static QCborValue fromCbor(const QByteArray &ba, QCborParserError *error,
+                               DecodingOptions opts);
     static QCborValue fromCbor(const char *data, qsizetype len, QCborParserError *error = nullptr)
     { return fromCbor(QByteArray(data, int(len)), error); }
     static QCborValue fromCbor(const quint8 *data, qsizetype len, QCborParserError *error = nullptr)
@@ -584,6 +592,7 @@ private:
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(QCborValue::EncodingOptions)
 Q_DECLARE_OPERATORS_FOR_FLAGS(QCborValue::DiagnosticNotationOptions)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QCborValue::DecodingOptions)
 
 Q_CORE_EXPORT size_t qHash(const QCborValue &value, size_t seed = 0);
 
@@ -67,22 +67,38 @@ static_assert(sizeof(Element) == 16);
 
 struct ByteData
 {
-    QByteArray::size_type len;
+    // Negative for bytes borrowed from QCborContainerPrivate::source: the
+    // record is then followed by a pointer to them instead of the bytes.
+    QByteArray::size_type rawLen;
 
-    const char *byte() const        { return reinterpret_cast<const char *>(this + 1); }
-    char *byte()                    { return reinterpret_cast<char *>(this + 1); }
+    QByteArray::size_type size() const { return isBorrowed() ? -rawLen : rawLen; }
+    bool isBorrowed() const         { return rawLen < 0; }
+    qsizetype storageSize() const
+    { return qsizetype(sizeof(ByteData)) + (isBorrowed() ? qsizetype(sizeof(char *)) : rawLen); }
+
+    const char *byte() const
+    {
+        if (Q_UNLIKELY(isBorrowed())) {
+            const char *ptr;
+            memcpy(&ptr, this + 1, sizeof(ptr));
+            return ptr;
+        }
+        return reinterpret_cast<const char *>(this + 1);
+    }
+    char *byte()                    { Q_ASSERT(!isBorrowed()); return reinterpret_cast<char *>(this + 1); }
+    // UTF-16 strings are never borrowed
     const QChar *utf16() const      { return reinterpret_cast<const QChar *>(this + 1); }
     QChar *utf16()                  { return reinterpret_cast<QChar *>(this + 1); }
 
-    QByteArray toByteArray() const  { return QByteArray(byte(), len); }
-    QString toString() const        { return QString(utf16(), len / 2); }
-    QString toUtf8String() const    { return QString::fromUtf8(byte(), len); }
+    QByteArray toByteArray() const  { return QByteArray(byte(), size()); }
+    QString toString() const        { return QString(utf16(), rawLen / 2); }
+    QString toUtf8String() const    { return QString::fromUtf8(byte(), size()); }
 
-    QByteArray asByteArrayView() const { return QByteArray::fromRawData(byte(), len); }
-    QLatin1StringView asLatin1() const  { return {byte(), len}; }
-    QUtf8StringView asUtf8StringView() const { return QUtf8StringView(byte(), len); }
-    QStringView asStringView() const{ return QStringView(utf16(), len / 2); }
-    QString asQStringRaw() const    { return QString::fromRawData(utf16(), len / 2); }
+    QByteArray asByteArrayView() const { return QByteArray::fromRawData(byte(), size()); }
+    QLatin1StringView asLatin1() const  { return {byte(), size()}; }
+    QUtf8StringView asUtf8StringView() const { return QUtf8StringView(byte(), size()); }
+    QStringView asStringView() const{ return QStringView(utf16(), rawLen / 2); }
+    QString asQStringRaw() const    { return QString::fromRawData(utf16(), rawLen / 2); }
 };
 static_assert(std::is_trivial<ByteData>::value);
 static_assert(std::is_standard_layout<ByteData>::value);
@@ -101,6 +117,9 @@ public:
     QByteArray::size_type usedData = 0;
     QByteArray data;
     QList<QtCbor::Element> elements;
+    // The CBOR buffer this container was decoded from, if its strings borrow
+    // from it instead of being copied into data (see ByteData::isBorrowed()).
+    QByteArray source;
 
     void deref() { if (!ref.deref()) delete this; }
     void compact(qsizetype reserved);
@@ -127,13 +146,32 @@ public:
 
         char *ptr = data.begin() + offset;
         auto b = new (ptr) QtCbor::ByteData;
-        b->len = len;
+        b->rawLen = len;
         if (block)
             memcpy(b->byte(), block, len);
 
         return offset;
     }
 
+    qptrdiff addBorrowedByteData(const char *block, qsizetype len)
+    {
+        Q_ASSERT(len > 0);
+        Q_ASSERT(block >= source.constBegin() && block + len <= source.constEnd());
+        qptrdiff offset = data.size();
+        offset += alignof(QtCbor::ByteData) - 1;
+        offset &= ~(alignof(QtCbor::ByteData) - 1);
+
+        qptrdiff increment = qptrdiff(sizeof(QtCbor::ByteData) + sizeof(block));
+        usedData += increment;
+        data.resize(offset + increment);
+
+        char *ptr = data.begin() + offset;
+        auto b = new (ptr) QtCbor::ByteData;
+        b->rawLen = -len;
+        memcpy(ptr + sizeof(QtCbor::ByteData), &block, sizeof(block));
+        return offset;
+    }
+
     const QtCbor::ByteData *byteData(QtCbor::Element e) const
     {
         if ((e.flags & QtCbor::Element::HasByteData) == 0)
@@ -144,7 +182,7 @@ public:
         Q_ASSERT(offset + sizeof(QtCbor::ByteData) <= size_t(data.size()));
 
         auto b = reinterpret_cast<const QtCbor::ByteData *>(data.constData() + offset);
-        Q_ASSERT(offset + sizeof(*b) + size_t(b->len) <= size_t(data.size()));
+        Q_ASSERT(offset + size_t(b->storageSize()) <= size_t(data.size()));
         return b;
     }
     const QtCbor::ByteData *byteData(qsizetype idx) const
@@ -178,7 +216,7 @@ public:
             e.container = nullptr;
             e.flags = {};
         } else if (auto b = byteData(e)) {
-            usedData -= b->len + sizeof(QtCbor::ByteData);
+            usedData -= b->storageSize();
         }
         replaceAt_internal(e, value, disp);
     }
@@ -331,12 +369,12 @@ public:
 
     static int compareUtf8(const QtCbor::ByteData *b, QLatin1StringView s)
     {
-        return QUtf8::compareUtf8(QByteArrayView(b->byte(), b->len), s);
+        return QUtf8::compareUtf8(QByteArrayView(b->byte(), b->size()), s);
     }
 
     static int compareUtf8(const QtCbor::ByteData *b, QStringView s)
     {
-        return QUtf8::compareUtf8(QByteArrayView(b->byte(), b->len), s);
+        return QUtf8::compareUtf8(QByteArrayView(b->byte(), b->size()), s);
     }
 
     template<typename String>
@@ -438,8 +476,10 @@ public:
     template <typename KeyType> static QCborValueRef findOrAddMapKey(QCborValueRef self, KeyType key);
 
 #if QT_CONFIG(cborstreamreader)
+    static QCborValue decodeFromCbor(QCborStreamReader &reader, const QByteArray &source);
     void decodeValueFromCbor(QCborStreamReader &reader, int remainingStackDepth);
     void decodeStringFromCbor(QCborStreamReader &reader);
+    bool borrowStringFromCbor(QCborStreamReader &reader);
     static inline void setErrorInReader(QCborStreamReader &reader, QCborError error);
 #endif
 };
@@ -1401,6 +1401,168 @@ int QDataStream::skipRawData(int len)
     return skipResult;
 }
 
+/*!
+    \fn template <typename T> QDataStream &QDataStream::readArray(T *data, qsizetype count)
+    \since 6.7
+
+    Reads \a count values of type \c T from the stream into the array
+    \a data and returns a reference to the stream. The result is the same as
+    reading each value with operator>>(), but the data is read from the
+    device in one go and then byte-swapped in place, if needed, which is much
+    faster for large arrays.
+
+    This function is only available for the integral types other than
+    \c bool, and for \c float and \c double. Floating point values are read
+    with the current floatingPointPrecision().
+
+    If reading fails, the status is set and the values in \a data are zero.
+
+    QList of these types is read this way by operator>>().
+
+    \sa writeArray(), readRawData()
+*/
+
+/*!
+    \fn template <typename T> QDataStream &QDataStream::writeArray(const T *data, qsizetype count)
+    \since 6.7
+
+    Writes the \a count values of type \c T in the array \a data to the
+    stream and returns a reference to the stream. The result is the same as
+    writing each value with operator<<(), but takes far fewer calls to the
+    device.
+
+    This function is only available for the types supported by readArray().
+
+    QList of these types is written this way by operator<<().
+
+    \sa readArray(), writeRawData()
+*/
+
+static void bswapArray(const void *source, qsizetype count, int size, void *dest)
+{
+    switch (size) {
+    case 2:
+        qbswap<2>(source, count, dest);
+        break;
+    case 4:
+        qbswap<4>(source, count, dest);
+        break;
+    case 8:
+        qbswap<8>(source, count, dest);
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+// readBlock() takes an int
+static constexpr int MaxArrayChunk = 1 << 30;
+
+// Returns true if values of size bytes are stored with a different layout
+// than they have in memory and need to go through the operators.
+static bool needsConversion(const QDataStream &s, int size, bool isFloat)
+{
+    if (isFloat) {
+        if (s.version() < QDataStream::Qt_4_6)
+            return false;
+        const bool doublePrecision =
+                s.floatingPointPrecision() == QDataStream::DoublePrecision;
+        return doublePrecision != (size == 8);
+    }
+    // before Qt 3.3, 64-bit integers were written as two 32-bit halves
+    return size == 8 && s.version() < 6;
+}
+
+QDataStream &QDataStream::readArrayHelper(void *data, qsizetype count, int size, bool isFloat)
+{
+    if (!dev) {
+        memset(data, 0, count * size);
+        CHECK_STREAM_PRECOND(*this)
+    }
+    char *p = static_cast<char *>(data);
+
+    if (needsConversion(*this, size, isFloat)) {
+        for (qsizetype i = 0; i < count; ++i, p += size) {
+            if (size == 4) {
+                float f;
+                *this >> f;
+                memcpy(p, &f, sizeof(f));
+            } else if (isFloat) {
+                double d;
+                *this >> d;
+                memcpy(p, &d, sizeof(d));
+            } else {
+                qint64 v;
+                *this >> v;
+                memcpy(p, &v, sizeof(v));
+            }
+        }
+        if (q_status != Ok)
+            memset(data, 0, count * size);
+        return *this;
+    }
+
+    for (qsizetype remaining = count * size; remaining > 0; ) {
+        const int chunk = int(qMin(remaining, qsizetype(MaxArrayChunk)));
+        if (readBlock(p, chunk) != chunk) {
+            memset(data, 0, count * size);
+            return *this;
+        }
+        p += chunk;
+        remaining -= chunk;
+    }
+    if (!noswap && size > 1)
+        bswapArray(data, count, size, data);
+    return *this;
+}
+
+QDataStream &QDataStream::writeArrayHelper(const void *data, qsizetype count, int size,
+                                           bool isFloat)
+{
+    CHECK_STREAM_WRITE_PRECOND(*this)
+    const char *p = static_cast<const char *>(data);
+
+    if (needsConversion(*this, size, isFloat)) {
+        for (qsizetype i = 0; i < count && q_status == Ok; ++i, p += size) {
+            if (size == 4) {
+                float f;
+                memcpy(&f, p, sizeof(f));
+                *this << f;
+            } else if (isFloat) {
+                double d;
+                memcpy(&d, p, sizeof(d));
+                *this << d;
+            } else {
+                qint64 v;
+                memcpy(&v, p, sizeof(v));
+                *this << v;
+            }
+        }
+        return *this;
+    }
+
+    if (noswap || size == 1) {
+        if (dev->write(p, count * size) != count * size)
+            q_status = WriteFailed;
+        return *this;
+    }
+
+    // swap through a buffer, the caller's data is const
+    alignas(8) char buffer[16 * 1024];
+    const qsizetype perChunk = sizeof(buffer) / size;
+    while (count > 0) {
+        const qsizetype n = qMin(count, perChunk);
+        bswapArray(p, n, size, buffer);
+        if (dev->write(buffer, n * size) != n * size) {
+            q_status = WriteFailed;
+            break;
+        }
+        p += n * size;
+        count -= n;
+    }
+    return *this;
+}
+
 /*!
     \fn template <class T1, class T2> QDataStream &operator<<(QDataStream &out, const std::pair<T1, T2> &pair)
     \since 6.0
@@ -25,6 +25,12 @@ class QIODevice;
 class QDataStreamPrivate;
 namespace QtPrivate {
 class StreamStateSaver;
+template <typename T>
+constexpr bool IsDataStreamBulkType =
+        (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8)
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+template <typename T>
+using IfDataStreamBulkType = std::enable_if_t<IsDataStreamBulkType<T>, bool>;
 }
 class Q_CORE_EXPORT QDataStream : public QIODeviceBase
 {
@@ -167,6 +173,13 @@ public:
 
     int skipRawData(int len);
 
+    template <typename T, QtPrivate::IfDataStreamBulkType<T> = true>
+    QDataStream &readArray(T *data, qsizetype count)
+    { return readArrayHelper(data, count, int(sizeof(T)), std::is_floating_point_v<T>); }
+    template <typename T, QtPrivate::IfDataStreamBulkType<T> = true>
+    QDataStream &writeArray(const T *data, qsizetype count)
+    { return writeArrayHelper(data, count, int(sizeof(T)), std::is_floating_point_v<T>); }
+
     void startTransaction();
     bool commitTransaction();
     void rollbackTransaction();
@@ -186,6 +199,8 @@ private:
     Status q_status;
 
     int readBlock(char *data, int len);
+    QDataStream &readArrayHelper(void *data, qsizetype count, int size, bool isFloat);
+    QDataStream &writeArrayHelper(const void *data, qsizetype count, int size, bool isFloat);
     friend class QtPrivate::StreamStateSaver;
 };
 
@@ -221,14 +236,28 @@ QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
     quint32 n;
     s >> n;
     c.reserve(n);
-    for (quint32 i = 0; i < n; ++i) {
-        typename Container::value_type t;
-        s >> t;
-        if (s.status() != QDataStream::Ok) {
-            c.clear();
-            break;
+    if constexpr (IsDataStreamBulkType<typename Container::value_type>) {
+        // don't zero-fill memory for a corrupt size that there is no data for
+        constexpr quint32 ChunkSize = 1024 * 1024;
+        for (quint32 i = 0; i < n; i += ChunkSize) {
+            const quint32 chunk = qMin(n - i, ChunkSize);
+            c.resize(i + chunk);
+            s.readArray(c.data() + i, chunk);
+            if (s.status() != QDataStream::Ok) {
+                c.clear();
+                break;
+            }
+        }
+    } else {
+        for (quint32 i = 0; i < n; ++i) {
+            typename Container::value_type t;
+            s >> t;
+            if (s.status() != QDataStream::Ok) {
+                c.clear();
+                break;
+            }
+            c.append(t);
         }
-        c.append(t);
     }
 
     return s;
@@ -417,7 +446,12 @@ inline QDataStreamIfHasIStreamOperatorsContainer<QList<T>, T> operator>>(QDataSt
 template<typename T>
 inline QDataStreamIfHasOStreamOperatorsContainer<QList<T>, T> operator<<(QDataStream &s, const QList<T> &v)
 {
-    return QtPrivate::writeSequentialContainer(s, v);
+    if constexpr (QtPrivate::IsDataStreamBulkType<T>) {
+        s << quint32(v.size());
+        return s.writeArray(v.constData(), v.size());
+    } else {
+        return QtPrivate::writeSequentialContainer(s, v);
+    }
 }
 
 template <typename T>
@@ -18,6 +18,7 @@
 
 #include <qjsonvalue.h>
 #include <qcborvalue.h>
+#include <qhash.h>
 #include <private/qcborvalue_p.h>
 
 #if QT_VERSION < QT_VERSION_CHECK(7, 0, 0) && !defined(QT_BOOTSTRAPPED)
@@ -210,6 +211,13 @@ class Variant
 public:
     static QJsonObject toJsonObject(const QVariantMap &map);
     static QJsonArray toJsonArray(const QVariantList &list);
+
+    // Maps converted together, like the records of an array, tend to have
+    // the same keys, which then share one string each in the result.
+    using KeyPool = QHash<QStringView, QString>;
+    static QVariant toVariant(const QCborValue &value, KeyPool &keys);
+    static QVariantList toVariantList(const QCborArray &array, KeyPool &keys);
+    static QVariantMap toVariantMap(const QCborMap &map, KeyPool &keys);
 };
 
 } // namespace QJsonPrivate
@@ -47,7 +47,7 @@ static QString encodeByteArray(const QCborContainerPrivate *d, qsizetype idx, QC
     if (!b)
         return QString();
 
-    QByteArray data = QByteArray::fromRawData(b->byte(), b->len);
+    QByteArray data = QByteArray::fromRawData(b->byte(), b->size());
     if (encoding == QCborKnownTags::ExpectedBase16)
         data = data.toHex();
     else if (encoding == QCborKnownTags::ExpectedBase64)
@@ -83,7 +83,7 @@ static QString maybeEncodeTag(const QCborContainerPrivate *d)
     case qint64(QCborKnownTags::Uuid):
 #ifndef QT_BOOTSTRAPPED
         if (const ByteData *b = d->byteData(e); e.type == QCborValue::ByteArray && b
-                && b->len == sizeof(QUuid))
+                && b->size() == sizeof(QUuid))
             return QUuid::fromRfc4122(b->asByteArrayView()).toString(QUuid::WithoutBraces);
 #endif
         break;
@@ -792,11 +792,45 @@ QCborValue QCborValue::fromVariant(const QVariant &variant)
         QCborValue::toVariant(), QCborMap::toVariantMap()
  */
 QVariantList QCborArray::toVariantList() const
+{
+    QJsonPrivate::Variant::KeyPool keys;
+    return QJsonPrivate::Variant::toVariantList(*this, keys);
+}
+
+QVariant QJsonPrivate::Variant::toVariant(const QCborValue &value, KeyPool &keys)
+{
+    switch (value.type()) {
+    case QCborValue::Array:
+        return toVariantList(value.toArray(), keys);
+    case QCborValue::Map:
+        return toVariantMap(value.toMap(), keys);
+    case QCborValue::Tag:
+        // ignore tags
+        return toVariant(value.taggedValue(), keys);
+    default:
+        return value.toVariant();
+    }
+}
+
+QVariantList QJsonPrivate::Variant::toVariantList(const QCborArray &array, KeyPool &keys)
 {
     QVariantList retval;
-    retval.reserve(size());
-    for (qsizetype i = 0; i < size(); ++i)
-        retval.append(d->valueAt(i).toVariant());
+    retval.reserve(array.size());
+    for (qsizetype i = 0; i < array.size(); ++i)
+        retval.append(toVariant(array.d->valueAt(i), keys));
+    return retval;
+}
+
+QVariantMap QJsonPrivate::Variant::toVariantMap(const QCborMap &map, KeyPool &keys)
+{
+    QVariantMap retval;
+    for (qsizetype i = 0; i < 2 * map.size(); i += 2) {
+        const QString key = makeString(map.d.data(), i);
+        auto it = keys.constFind(QStringView(key));
+        if (it == keys.cend())
+            it = keys.insert(QStringView(key), key);
+        retval.insert(*it, toVariant(map.d->valueAt(i + 1), keys));
+    }
     return retval;
 }
 
@@ -880,9 +914,12 @@ QCborArray QCborArray::fromJsonArray(QJsonArray &&array) noexcept
  */
 QVariantMap QCborMap::toVariantMap() const
 {
+    // The keys of this map are all different; only nested maps share them
+    QJsonPrivate::Variant::KeyPool keys;
     QVariantMap retval;
     for (qsizetype i = 0; i < 2 * size(); i += 2)
-        retval.insert(makeString(d.data(), i), d->valueAt(i + 1).toVariant());
+        retval.insert(makeString(d.data(), i),
+                      QJsonPrivate::Variant::toVariant(d->valueAt(i + 1), keys));
     return retval;
 }
 
@@ -904,10 +941,12 @@ QVariantMap QCborMap::toVariantMap() const
  */
 QVariantHash QCborMap::toVariantHash() const
 {
+    QJsonPrivate::Variant::KeyPool keys;
     QVariantHash retval;
     retval.reserve(size());
     for (qsizetype i = 0; i < 2 * size(); i += 2)
-        retval.insert(makeString(d.data(), i), d->valueAt(i + 1).toVariant());
+        retval.insert(makeString(d.data(), i),
+                      QJsonPrivate::Variant::toVariant(d->valueAt(i + 1), keys));
     return retval;
 }
 
@@ -11,7 +11,11 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include <private/qsimd_p.h>
 #include <private/qtools_p.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -47,6 +51,7 @@ using namespace QtMiscUtils;
 #define JSONERR_DEEP_NEST   QT_TRANSLATE_NOOP("QJsonParseError", "too deeply nested document")
 #define JSONERR_DOC_LARGE   QT_TRANSLATE_NOOP("QJsonParseError", "too large document")
 #define JSONERR_GARBAGEEND  QT_TRANSLATE_NOOP("QJsonParseError", "garbage at the end of the document")
+#define JSONERR_PREMATURE_END QT_TRANSLATE_NOOP("QJsonParseError", "premature end of document")
 
 /*!
     \class QJsonParseError
@@ -82,6 +87,9 @@ using namespace QtMiscUtils;
     \value DeepNesting              The JSON document is too deeply nested for the parser to parse it
     \value DocumentTooLarge         The JSON document is too large for the parser to parse it
     \value GarbageAtEnd             The parsed document contains additional garbage characters at the end
+    \value PrematureEndOfDocument   The input ended before a complete JSON value could be read.
+                                    This is only reported by QJsonStreamReader, and it can
+                                    continue once more data is available (since Qt 6.7).
 
 */
 
@@ -157,6 +165,9 @@ QString QJsonParseError::errorString() const
     case GarbageAtEnd:
         sz = JSONERR_GARBAGEEND;
         break;
+    case PrematureEndOfDocument:
+        sz = JSONERR_PREMATURE_END;
+        break;
     }
 #ifndef QT_BOOTSTRAPPED
     return QCoreApplication::translate("QJsonParseError", sz);
@@ -251,8 +262,101 @@ void Parser::eatBOM()
         json += 3;
 }
 
+/*
+    Vectorized scanning helpers. Each returns a pointer to the first byte in
+    [ptr, end) for which the scalar code needs to take over, or to the start
+    of the final, shorter than a vector, part of the input.
+*/
+#if defined(__SSE2__)
+static inline uint jsonWhitespaceMask(__m128i data)
+{
+    const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(' ')),
+                                       _mm_cmpeq_epi8(data, _mm_set1_epi8('\t')));
+    const __m128i newline = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\n')),
+                                         _mm_cmpeq_epi8(data, _mm_set1_epi8('\r')));
+    return _mm_movemask_epi8(_mm_or_si128(space, newline));
+}
+
+// bit set for each byte that is not plain US-ASCII string content
+static inline uint jsonStringSpecialMask(__m128i data)
+{
+    const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('"')),
+                                         _mm_cmpeq_epi8(data, _mm_set1_epi8('\\')));
+    // the sign bit of non-ASCII bytes is picked up by the movemask below
+    return _mm_movemask_epi8(_mm_or_si128(special, data));
+}
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+// four bits per byte of the 0x00/0xff comparison result
+static inline quint64 neonByteMask(uint8x16_t cmp)
+{
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+static inline quint64 jsonNonWhitespaceMask(uint8x16_t data)
+{
+    const uint8x16_t space = vorrq_u8(vceqq_u8(data, vdupq_n_u8(' ')),
+                                      vceqq_u8(data, vdupq_n_u8('\t')));
+    const uint8x16_t newline = vorrq_u8(vceqq_u8(data, vdupq_n_u8('\n')),
+                                        vceqq_u8(data, vdupq_n_u8('\r')));
+    return neonByteMask(vmvnq_u8(vorrq_u8(space, newline)));
+}
+
+static inline quint64 jsonStringSpecialMask(uint8x16_t data)
+{
+    const uint8x16_t special = vorrq_u8(vceqq_u8(data, vdupq_n_u8('"')),
+                                        vceqq_u8(data, vdupq_n_u8('\\')));
+    return neonByteMask(vorrq_u8(special, vcgeq_u8(data, vdupq_n_u8(0x80))));
+}
+#endif
+
+static inline const char *skipWhitespaceRun(const char *ptr, const char *end)
+{
+#if defined(__SSE2__)
+    for ( ; ptr + 16 <= end; ptr += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const uint mask = jsonWhitespaceMask(data);
+        if (mask != 0xffff)
+            return ptr + qCountTrailingZeroBits(~mask);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    for ( ; ptr + 16 <= end; ptr += 16) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uchar *>(ptr));
+        if (const quint64 mask = jsonNonWhitespaceMask(data))
+            return ptr + qCountTrailingZeroBits(mask) / 4;
+    }
+#else
+    Q_UNUSED(end);
+#endif
+    return ptr;
+}
+
+static inline const char *skipPlainAsciiRun(const char *ptr, const char *end)
+{
+#if defined(__SSE2__)
+    for ( ; ptr + 16 <= end; ptr += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        if (const uint mask = jsonStringSpecialMask(data))
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    for ( ; ptr + 16 <= end; ptr += 16) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uchar *>(ptr));
+        if (const quint64 mask = jsonStringSpecialMask(data))
+            return ptr + qCountTrailingZeroBits(mask) / 4;
+    }
+#else
+    Q_UNUSED(end);
+#endif
+    return ptr;
+}
+
 bool Parser::eatSpace()
 {
+    // deeply indented documents have long runs of whitespace
+    if (json < end && *json <= Space)
+        json = skipWhitespaceRun(json, end);
+
     while (json < end) {
         if (*json > Space)
             break;
@@ -681,10 +785,19 @@ bool Parser::parseValue()
 
 */
 
-bool Parser::parseNumber()
-{
-    BEGIN << "parseNumber" << json;
+/*!
+    \internal
+
+    Scans the number starting at \a json and stores it in \a value, as an
+    integer if it can be represented exactly as one. A number must be followed
+    by another character, as that is the only way to tell that it is complete.
+    On return, \a json points past the number, or at the location of the
+    error.
 
+    This is shared between the parser and QJsonStreamReader.
+*/
+QJsonParseError::ParseError QJsonPrivate::scanNumber(const char *&json, const char *end, QCborValue *value)
+{
     const char *start = json;
     bool isInt = true;
 
@@ -719,10 +832,8 @@ bool Parser::parseNumber()
             ++json;
     }
 
-    if (json >= end) {
-        lastError = QJsonParseError::TerminationByNumber;
-        return false;
-    }
+    if (json >= end)
+        return QJsonParseError::TerminationByNumber;
 
     const QByteArray number = QByteArray::fromRawData(start, json - start);
     DEBUG << "numberstring" << number;
@@ -731,26 +842,35 @@ bool Parser::parseNumber()
         bool ok;
         qlonglong n = number.toLongLong(&ok);
         if (ok) {
-            container->append(QCborValue(n));
-            END;
-            return true;
+            *value = QCborValue(n);
+            return QJsonParseError::NoError;
         }
     }
 
     bool ok;
     double d = number.toDouble(&ok);
 
-    if (!ok) {
-        lastError = QJsonParseError::IllegalNumber;
-        return false;
-    }
+    if (!ok)
+        return QJsonParseError::IllegalNumber;
 
     qint64 n;
     if (convertDoubleTo(d, &n))
-        container->append(QCborValue(n));
+        *value = QCborValue(n);
     else
-        container->append(QCborValue(d));
+        *value = QCborValue(d);
+    return QJsonParseError::NoError;
+}
+
+bool Parser::parseNumber()
+{
+    BEGIN << "parseNumber" << json;
+
+    QCborValue value;
+    lastError = scanNumber(json, end, &value);
+    if (lastError != QJsonParseError::NoError)
+        return false;
 
+    container->append(value);
     END;
     return true;
 }
@@ -847,6 +967,63 @@ static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *re
     return true;
 }
 
+// Strings with escape sequences are unescaped into this buffer first; short
+// ones, such as most member names, fit without allocating.
+using UnescapedString = QVarLengthArray<char16_t, 64>;
+
+static void appendAsciiRun(UnescapedString &str, const char *begin, const char *end)
+{
+    const qsizetype size = str.size();
+    str.resize(size + (end - begin));
+    std::copy(reinterpret_cast<const uchar *>(begin), reinterpret_cast<const uchar *>(end),
+              str.data() + size);
+}
+
+static void appendUcs4(UnescapedString &str, char32_t ch)
+{
+    const auto chars = QChar::fromUcs4(ch);
+    str.append(chars.begin(), chars.size());
+}
+
+/*!
+    \internal
+
+    Scans the string following an opening quote at \a json, up to and
+    including the closing quote, and stores it in \a result. On return,
+    \a json points past the closing quote, or at the location of the error.
+
+    This is shared between the parser and QJsonStreamReader.
+*/
+QJsonParseError::ParseError QJsonPrivate::scanString(const char *&json, const char *end, QString *result)
+{
+    UnescapedString str;
+    while (json < end) {
+        if (const char *run = skipPlainAsciiRun(json, end); run != json) {
+            appendAsciiRun(str, json, run);
+            json = run;
+            continue;
+        }
+
+        char32_t ch = 0;
+        if (*json == '"')
+            break;
+        if (*json == '\\') {
+            if (!scanEscapeSequence(json, end, &ch))
+                return QJsonParseError::IllegalEscapeSequence;
+        } else {
+            if (!scanUtf8Char(json, end, &ch))
+                return QJsonParseError::IllegalUTF8String;
+        }
+        appendUcs4(str, ch);
+    }
+
+    if (json >= end)
+        return QJsonParseError::UnterminatedString;
+    ++json;
+    *result = QStringView(str.constData(), str.size()).toString();
+    return QJsonParseError::NoError;
+}
+
 bool Parser::parseString()
 {
     const char *start = json;
@@ -857,6 +1034,10 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        json = skipPlainAsciiRun(json, end);
+        if (json >= end)
+            break;
+
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -897,8 +1078,14 @@ bool Parser::parseString()
 
     json = start;
 
-    QString ucs4;
+    UnescapedString ucs4;
     while (json < end) {
+        if (const char *run = skipPlainAsciiRun(json, end); run != json) {
+            appendAsciiRun(ucs4, json, run);
+            json = run;
+            continue;
+        }
+
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -913,7 +1100,7 @@ bool Parser::parseString()
                 return false;
             }
         }
-        ucs4.append(QChar::fromUcs4(ch));
+        appendUcs4(ucs4, ch);
     }
     ++json;
 
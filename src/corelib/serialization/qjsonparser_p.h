@@ -23,6 +23,9 @@ QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
+QJsonParseError::ParseError scanNumber(const char *&json, const char *end, QCborValue *value);
+QJsonParseError::ParseError scanString(const char *&json, const char *end, QString *result);
+
 class Parser
 {
 public:
@@ -0,0 +1,699 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include <private/qjsonparser_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+   \class QJsonStreamReader
+   \inmodule QtCore
+   \ingroup json
+   \ingroup qtserialization
+   \reentrant
+   \since 6.7
+
+   \brief The QJsonStreamReader class is a pull parser for JSON text, operating
+   on either a QByteArray or QIODevice.
+
+   QJsonStreamReader decodes JSON one value at a time, without building a
+   QJsonDocument. It is meant for documents that are too large to be held in
+   memory as a tree, for streams delivered in pieces (for example, from a
+   network socket) and for sequences of JSON values such as newline-delimited
+   JSON, where each top-level value is returned in turn.
+
+   The API mirrors that of QCborStreamReader. Scalars are pre-parsed, so
+   toBool(), toDouble() and toInteger() are \c const and next() must be called
+   to advance. readString() returns the string and advances automatically.
+   Arrays and objects must be entered with enterContainer() and left with
+   leaveContainer(), which skips any elements that were not read. Inside an
+   object, elements alternate between the member name (always a String) and
+   the member value.
+
+   \section1 Incremental parsing
+
+   If the input ends in the middle of a value, lastError() reports
+   QJsonParseError::PrematureEndOfDocument and the reader stays positioned on
+   the incomplete element. When reading from a QIODevice, the reader pulls more
+   data from it on its own; in either case, after more data is available (via
+   addData() or the device), call reparse() to resume. Reaching the end of the
+   input between two top-level values is not an error: the reader then reports
+   an Invalid type with no error. Since a number may continue in data that is
+   not yet available, a number at the top level is only reported once it is
+   followed by whitespace.
+
+   \sa QJsonDocument, QCborStreamReader
+ */
+
+/*!
+   \enum QJsonStreamReader::Type
+
+   This enumeration contains all possible JSON types as decoded by
+   QJsonStreamReader.
+
+   \value Null          The null literal.
+   \value False         The false literal.
+   \value True          The true literal.
+   \value Double        A number. Use toDouble() or toInteger() to obtain its value.
+   \value String        A string. Use readString() to obtain its value.
+   \value Array         An array. Use enterContainer() to read its elements.
+   \value Object        An object. Use enterContainer() to read its members.
+   \value Invalid       No element: the end of a container or of the input was
+                        reached, or an error occurred.
+ */
+
+// JSON does not limit the nesting depth, but the DOM parser does
+static constexpr int nestingLimit = 1024;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum { ReadChunkSize = 64 * 1024 };
+    enum ScanResult { Scanned, NeedData, NeedDataAtTopLevel };
+
+    struct Container {
+        QJsonStreamReader::Type type;
+        bool keyNext;       // objects only: the next element is a member name
+    };
+
+    struct State {
+        QVarLengthArray<Container, 16> containers;
+        QCborValue value;
+        qint64 scanOffset;
+        qint64 itemOffset;
+        qint64 itemEnd;
+        quint8 type;
+        bool afterItem;
+        bool atEnd;
+    };
+
+    QJsonStreamReaderPrivate(const QByteArray &data) : buffer(data) {}
+    QJsonStreamReaderPrivate(QIODevice *device) : device(device) {}
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qint64 bufferOffset = 0;    // stream offset of buffer[0]
+    qint64 keepOffset = 0;      // data before this offset may be discarded
+
+    // everything below is in stream offsets
+    State state = { {}, {}, 0, 0, 0, QJsonStreamReader::Invalid, false, false };
+    QJsonParseError::ParseError lastError = QJsonParseError::NoError;
+
+    const char *ptr(qint64 offset) const
+    { return buffer.constData() + (offset - bufferOffset); }
+    qint64 offsetOf(const char *p) const
+    { return bufferOffset + (p - buffer.constData()); }
+
+    void compact();
+    bool fetchMore();
+    ScanResult scan();
+    void setError(QJsonParseError::ParseError error, const char *where);
+    void preparse();
+    void consume(qint64 end);
+    void enter();
+    void leave();
+    bool skipItem(int maxRecursion);
+};
+
+void QJsonStreamReaderPrivate::compact()
+{
+    // Removing from the front of a QByteArray only moves its begin pointer,
+    // so this is cheap even when called often.
+    const qsizetype drop = qsizetype(qMin(keepOffset - bufferOffset, qint64(buffer.size())));
+    if (drop > 0) {
+        buffer.remove(0, drop);
+        bufferOffset += drop;
+    }
+}
+
+bool QJsonStreamReaderPrivate::fetchMore()
+{
+    if (!device)
+        return false;
+
+    compact();
+    qint64 avail = device->bytesAvailable();
+    if (avail <= 0 && device->isSequential())
+        return false;
+    const qsizetype oldSize = buffer.size();
+    const qsizetype toRead = qsizetype(qBound(qint64(1), avail, qint64(ReadChunkSize)));
+    buffer.resize(oldSize + toRead);
+    const qint64 n = device->read(buffer.data() + oldSize, toRead);
+    buffer.resize(oldSize + qMax(qint64(0), n));
+    return n > 0;
+}
+
+void QJsonStreamReaderPrivate::setError(QJsonParseError::ParseError error, const char *where)
+{
+    lastError = error;
+    state.type = QJsonStreamReader::Invalid;
+    state.itemOffset = offsetOf(where);
+}
+
+static const char *skipJsonSpace(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+static bool matchesLiteralPrefix(const char *p, const char *end, QLatin1StringView literal)
+{
+    const qsizetype n = qMin(qsizetype(end - p), literal.size());
+    return memcmp(p, literal.data(), n) == 0;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scan()
+{
+    const char *p = ptr(state.scanOffset);
+    const char *end = buffer.constData() + buffer.size();
+    state.atEnd = false;
+
+    // a UTF-8 BOM is only allowed at the start of the stream
+    if (state.scanOffset == 0 && !state.afterItem && state.containers.isEmpty()) {
+        static const char bom[] = "\xef\xbb\xbf";
+        if (matchesLiteralPrefix(p, end, QLatin1StringView(bom, 3))) {
+            if (end - p < 3)
+                return NeedDataAtTopLevel;
+            p += 3;
+        }
+    }
+
+    p = skipJsonSpace(p, end);
+    if (p == end)
+        return state.containers.isEmpty() ? NeedDataAtTopLevel : NeedData;
+
+    if (!state.containers.isEmpty()) {
+        const Container &c = state.containers.last();
+        const bool isArray = c.type == QJsonStreamReader::Array;
+        const char closer = isArray ? ']' : '}';
+        if (state.afterItem) {
+            if (!isArray && !c.keyNext) {
+                // we just read a member name
+                if (*p != ':') {
+                    setError(QJsonParseError::MissingNameSeparator, p);
+                    return Scanned;
+                }
+                p = skipJsonSpace(p + 1, end);
+            } else if (*p != closer) {
+                if (*p != ',') {
+                    setError(isArray ? QJsonParseError::MissingValueSeparator
+                                     : QJsonParseError::UnterminatedObject, p);
+                    return Scanned;
+                }
+                p = skipJsonSpace(p + 1, end);
+                if (p < end && *p == closer) {
+                    setError(QJsonParseError::MissingObject, p);
+                    return Scanned;
+                }
+            }
+            if (p == end)
+                return NeedData;
+        }
+
+        if (*p == closer && (isArray || c.keyNext)) {
+            state.type = QJsonStreamReader::Invalid;
+            state.atEnd = true;
+            state.itemOffset = offsetOf(p);
+            state.itemEnd = state.itemOffset + 1;
+            return Scanned;
+        }
+        if (!isArray && c.keyNext && *p != '"') {
+            setError(QJsonParseError::UnterminatedObject, p);
+            return Scanned;
+        }
+    }
+
+    state.itemOffset = offsetOf(p);
+    switch (*p) {
+    case '[':
+    case '{':
+        state.type = *p == '[' ? QJsonStreamReader::Array : QJsonStreamReader::Object;
+        state.itemEnd = state.itemOffset + 1;
+        return Scanned;
+
+    case '"': {
+        // find the closing quote first, so the decoder never sees a partial string
+        const char *q = p + 1;
+        for (;;) {
+            while (q < end && *q != '"' && *q != '\\')
+                ++q;
+            if (q >= end)
+                return NeedData;
+            if (*q == '"')
+                break;
+            q += 2;
+        }
+
+        QString str;
+        const char *s = p + 1;
+        const QJsonParseError::ParseError err = QJsonPrivate::scanString(s, q + 1, &str);
+        if (err != QJsonParseError::NoError) {
+            setError(err, s);
+            return Scanned;
+        }
+        state.type = QJsonStreamReader::String;
+        state.value = std::move(str);
+        state.itemEnd = offsetOf(s);
+        return Scanned;
+    }
+
+    case 't':
+    case 'f':
+    case 'n': {
+        const QLatin1StringView literal = *p == 't' ? "true"_L1 : *p == 'f' ? "false"_L1 : "null"_L1;
+        if (!matchesLiteralPrefix(p, end, literal)) {
+            setError(QJsonParseError::IllegalValue, p);
+            return Scanned;
+        }
+        if (end - p < literal.size())
+            return NeedData;
+        state.type = *p == 't' ? QJsonStreamReader::True
+                : *p == 'f' ? QJsonStreamReader::False : QJsonStreamReader::Null;
+        state.itemEnd = state.itemOffset + literal.size();
+        return Scanned;
+    }
+
+    case ',':
+        setError(QJsonParseError::IllegalValue, p);
+        return Scanned;
+
+    case ']':
+    case '}':
+    case ':':
+        setError(QJsonParseError::MissingObject, p);
+        return Scanned;
+
+    default: {
+        const char *s = p;
+        QCborValue number;
+        const QJsonParseError::ParseError err = QJsonPrivate::scanNumber(s, end, &number);
+        if (err == QJsonParseError::TerminationByNumber)
+            return NeedData;        // the number may continue in the next chunk
+        if (err != QJsonParseError::NoError) {
+            setError(err, p);
+            return Scanned;
+        }
+        state.type = QJsonStreamReader::Double;
+        state.value = std::move(number);
+        state.itemEnd = offsetOf(s);
+        return Scanned;
+    }
+    }
+}
+
+void QJsonStreamReaderPrivate::preparse()
+{
+    lastError = QJsonParseError::NoError;
+    for (;;) {
+        const ScanResult r = scan();
+        if (r == Scanned)
+            return;
+        if (fetchMore())
+            continue;
+
+        state.type = QJsonStreamReader::Invalid;
+        if (r == NeedDataAtTopLevel) {
+            // clean end of input between top-level values
+            state.atEnd = true;
+            state.itemOffset = bufferOffset + buffer.size();
+            state.itemEnd = state.itemOffset;
+        } else {
+            lastError = QJsonParseError::PrematureEndOfDocument;
+            state.itemOffset = state.scanOffset;
+        }
+        return;
+    }
+}
+
+void QJsonStreamReaderPrivate::consume(qint64 end)
+{
+    state.scanOffset = end;
+    state.afterItem = true;
+    if (!state.containers.isEmpty()) {
+        Container &c = state.containers.last();
+        if (c.type == QJsonStreamReader::Object)
+            c.keyNext = !c.keyNext;
+    }
+    state.value = QCborValue();
+}
+
+void QJsonStreamReaderPrivate::enter()
+{
+    state.containers.append({ QJsonStreamReader::Type(state.type), true });
+    state.scanOffset = state.itemEnd;
+    state.afterItem = false;
+    preparse();
+}
+
+void QJsonStreamReaderPrivate::leave()
+{
+    Q_ASSERT(state.atEnd && !state.containers.isEmpty());
+    state.containers.removeLast();
+    consume(state.itemEnd);
+    preparse();
+}
+
+bool QJsonStreamReaderPrivate::skipItem(int maxRecursion)
+{
+    if (state.type != QJsonStreamReader::Array && state.type != QJsonStreamReader::Object) {
+        consume(state.itemEnd);
+        preparse();
+        return true;
+    }
+
+    if (maxRecursion < 0 || state.containers.size() >= nestingLimit) {
+        lastError = QJsonParseError::DeepNesting;
+        return false;
+    }
+
+    // if the container is incomplete, stay positioned on it so the caller
+    // can add data and try again
+    const State saved = state;
+    enter();
+    while (lastError == QJsonParseError::NoError && !state.atEnd)
+        skipItem(maxRecursion - 1);
+    if (lastError == QJsonParseError::PrematureEndOfDocument)
+        state = saved;
+    if (lastError != QJsonParseError::NoError)
+        return false;
+    leave();
+    return true;
+}
+
+/*!
+   Creates a QJsonStreamReader object with no source data. After construction,
+   QJsonStreamReader reports the Invalid type. Add data with addData() or set a
+   source device with setDevice().
+ */
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate(QByteArray()))
+{
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   \overload
+
+   Creates a QJsonStreamReader object that will parse the JSON text in \a data.
+ */
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate(data))
+{
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   \overload
+
+   Creates a QJsonStreamReader object that will parse the JSON text read from
+   \a device. QJsonStreamReader does not take ownership of \a device, so it
+   must remain valid until this object is destroyed.
+ */
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate(device))
+{
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   Destroys this QJsonStreamReader object and frees any associated resources.
+ */
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+   Sets the source of data to \a device, resetting the decoder to its initial
+   state.
+ */
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    clear();
+    d->device = device;
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   Returns the QIODevice that was set with either setDevice() or the
+   QJsonStreamReader constructor. If this object was reading from a QByteArray,
+   this function returns \nullptr instead.
+ */
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+   Adds \a data to the input buffer. Call reparse() afterwards if lastError()
+   was reporting QJsonParseError::PrematureEndOfDocument, or if the reader had
+   reached the end of the input.
+
+   This function does nothing if the reader is operating on a QIODevice.
+ */
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+   \overload
+
+   Adds \a len bytes of data starting at \a data to the input buffer.
+ */
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->keepOffset = d->state.scanOffset;
+    d->compact();
+    d->buffer.append(data, len);
+}
+
+/*!
+   Reparses the current element after more data was made available, either
+   with addData() or by the device. Call this function after lastError()
+   reported QJsonParseError::PrematureEndOfDocument, or when isInvalid() is
+   \c true at the end of the top-level input, to find out whether more values
+   follow.
+ */
+void QJsonStreamReader::reparse()
+{
+    d->keepOffset = d->state.scanOffset;
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   Clears the decoder state and resets the input source data to an empty byte
+   array. After this function is called, QJsonStreamReader reports the Invalid
+   type.
+ */
+void QJsonStreamReader::clear()
+{
+    d.reset(new QJsonStreamReaderPrivate(QByteArray()));
+    d->preparse();
+    type_ = d->state.type;
+}
+
+/*!
+   Returns the last error in decoding the stream, if any, or
+   QJsonParseError::NoError.
+
+   \sa errorString()
+ */
+QJsonParseError::ParseError QJsonStreamReader::lastError() const
+{
+    return d->lastError;
+}
+
+/*!
+   Returns a human-readable description of lastError().
+ */
+QString QJsonStreamReader::errorString() const
+{
+    QJsonParseError error;
+    error.error = d->lastError;
+    return error.errorString();
+}
+
+/*!
+   Returns the offset in the input stream of the element being decoded. If an
+   error was detected, returns the offset at which it was found.
+ */
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->state.itemOffset;
+}
+
+/*!
+   Returns the number of containers that this stream has entered with
+   enterContainer() but not yet left.
+ */
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->state.containers.size());
+}
+
+/*!
+   Returns either QJsonStreamReader::Array or QJsonStreamReader::Object,
+   indicating which container the current element is in, or
+   QJsonStreamReader::Invalid at the top level.
+ */
+QJsonStreamReader::Type QJsonStreamReader::parentContainerType() const
+{
+    if (d->state.containers.isEmpty())
+        return Invalid;
+    return d->state.containers.last().type;
+}
+
+/*!
+   Returns \c true if there are more elements to be decoded in the current
+   container (or at the top level), \c false if the end was reached or a fatal
+   error occurred. An incomplete element is still counted as a next element.
+ */
+bool QJsonStreamReader::hasNext() const
+{
+    return !d->state.atEnd && (d->lastError == QJsonParseError::NoError
+                               || d->lastError == QJsonParseError::PrematureEndOfDocument);
+}
+
+/*!
+   Advances to the next element, skipping the current one. If the current
+   element is a container, it is skipped along with all its contents, up to a
+   nesting depth of \a maxRecursion.
+
+   Returns \c true if the current element was skipped. If the input ends
+   before a container being skipped does, this function returns \c false with
+   lastError() set to QJsonParseError::PrematureEndOfDocument and the reader
+   stays positioned on the container. lastError() may also report that error
+   after a successful skip, if the element that follows is incomplete.
+ */
+bool QJsonStreamReader::next(int maxRecursion)
+{
+    if (d->lastError != QJsonParseError::NoError || d->state.atEnd || isInvalid())
+        return false;
+
+    d->keepOffset = d->state.scanOffset;
+    const bool ok = d->skipItem(maxRecursion);
+    type_ = d->state.type;
+    return ok;
+}
+
+bool QJsonStreamReader::_enterContainer_helper()
+{
+    if (d->lastError != QJsonParseError::NoError)
+        return false;
+    if (d->state.containers.size() >= nestingLimit) {
+        d->lastError = QJsonParseError::DeepNesting;
+        type_ = Invalid;
+        return false;
+    }
+
+    d->keepOffset = d->state.scanOffset;
+    d->enter();
+    type_ = d->state.type;
+    return true;
+}
+
+/*!
+   Leaves the current container, skipping any elements that were not read, and
+   advances to the element that follows it. Returns \c true on success.
+
+   \sa enterContainer(), containerDepth()
+ */
+bool QJsonStreamReader::leaveContainer()
+{
+    Q_ASSERT(containerDepth() > 0);
+    if (d->lastError != QJsonParseError::NoError)
+        return false;
+
+    d->keepOffset = d->state.scanOffset;
+    while (d->lastError == QJsonParseError::NoError && !d->state.atEnd)
+        d->skipItem(10000);
+    if (d->lastError != QJsonParseError::NoError) {
+        type_ = d->state.type;
+        return false;
+    }
+    d->leave();
+    type_ = d->state.type;
+    return true;
+}
+
+QString QJsonStreamReader::_readString_helper()
+{
+    QString result = d->state.value.toString();
+    next();
+    return result;
+}
+
+double QJsonStreamReader::_toDouble_helper() const
+{
+    return d->state.value.toDouble();
+}
+
+/*!
+   Returns the current number as an integer, if it is a whole number that fits
+   in a qint64. Otherwise, or if the current element is not a number, returns
+   \a defaultValue.
+ */
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    if (isDouble() && d->state.value.isInteger())
+        return d->state.value.toInteger();
+    return defaultValue;
+}
+
+/*!
+   \fn bool QJsonStreamReader::isValid() const
+   Returns \c true if the current element is not Invalid.
+ */
+
+/*!
+   \fn QJsonStreamReader::Type QJsonStreamReader::type() const
+   Returns the type of the current element.
+ */
+
+/*!
+   \fn bool QJsonStreamReader::enterContainer()
+
+   Enters the array or object that is the current element and positions the
+   reader on its first element (or its end, if it is empty). Returns \c true
+   if the container was entered.
+
+   \sa leaveContainer(), next()
+ */
+
+/*!
+   \fn QString QJsonStreamReader::readString()
+
+   Returns the current string and advances to the next element.
+ */
+
+/*!
+   \fn bool QJsonStreamReader::toBool() const
+   Returns the current boolean value.
+ */
+
+/*!
+   \fn double QJsonStreamReader::toDouble() const
+   Returns the current number.
+ */
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,103 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+/* X11 headers use these values too, but as defines */
+#if defined(False) && defined(True)
+#  undef True
+#  undef False
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum Type : quint8 {
+        Null,
+        False,
+        True,
+        Double,
+        String,
+        Array,
+        Object,
+
+        Invalid = 0xff
+    };
+    Q_ENUM(Type)
+
+    QJsonStreamReader();
+    explicit QJsonStreamReader(const QByteArray &data);
+    explicit QJsonStreamReader(QIODevice *device);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void reparse();
+    void clear();
+
+    QJsonParseError::ParseError lastError() const;
+    QString errorString() const;
+
+    qint64 currentOffset() const;
+
+    bool isValid() const            { return !isInvalid(); }
+
+    int containerDepth() const;
+    QJsonStreamReader::Type parentContainerType() const;
+    bool hasNext() const;
+    bool next(int maxRecursion = 10000);
+
+    Type type() const               { return QJsonStreamReader::Type(type_); }
+    bool isNull() const             { return type() == Null; }
+    bool isFalse() const            { return type() == False; }
+    bool isTrue() const             { return type() == True; }
+    bool isBool() const             { return isFalse() || isTrue(); }
+    bool isDouble() const           { return type() == Double; }
+    bool isString() const           { return type() == String; }
+    bool isArray() const            { return type() == Array; }
+    bool isObject() const           { return type() == Object; }
+    bool isInvalid() const          { return type() == Invalid; }
+
+    bool isContainer() const        { return isObject() || isArray(); }
+    bool enterContainer()           { Q_ASSERT(isContainer()); return _enterContainer_helper(); }
+    bool leaveContainer();
+
+    QString readString()            { Q_ASSERT(isString()); return _readString_helper(); }
+    bool toBool() const             { Q_ASSERT(isBool()); return isTrue(); }
+    double toDouble() const         { Q_ASSERT(isDouble()); return _toDouble_helper(); }
+    qint64 toInteger(qint64 defaultValue = 0) const;
+
+private:
+    bool _enterContainer_helper();
+    QString _readString_helper();
+    double _toDouble_helper() const;
+
+    friend QJsonStreamReaderPrivate;
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+    quint8 type_;
+};
+
+QT_END_NAMESPACE
+
+#if defined(QT_X11_DEFINES_FOUND)
+#  define True  1
+#  define False 0
+#endif
+
+#endif // QJSONSTREAMREADER_H
@@ -16,8 +16,10 @@
 #include <qcoreapplication.h>
 
 #include <private/qoffsetstringarray_p.h>
+#include <private/qsimd_p.h>
 #include <private/qtools_p.h>
 
+#include <algorithm>
 #include <iterator>
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
@@ -1137,6 +1139,145 @@ bool QXmlStreamReaderPrivate::scanAttType()
     return false;
 }
 
+namespace {
+// The run scanners below return the length of the run of characters at the
+// start of [ptr, end) that the corresponding fastScan function would copy to
+// textBuffer one by one without any further processing. They stop at
+// anything that needs special treatment, including line breaks and
+// non-ASCII name characters, which the character by character loops handle.
+
+// text content: stops at controls (including \t, \n and \r), '&', '<', ']'
+// and the non-characters U+FFFE and U+FFFF
+struct ContentRun
+{
+    static bool isSpecial(char16_t c) noexcept
+    { return c < 0x20 || c == u'&' || c == u'<' || c == u']' || c >= 0xfffe; }
+#ifdef __SSE2__
+    static __m128i specialMask(__m128i data) noexcept
+    {
+        const __m128i controls = _mm_cmpeq_epi16(_mm_subs_epu16(data, _mm_set1_epi16(0x1f)),
+                                                 _mm_setzero_si128());
+        const __m128i nonchars = _mm_cmpeq_epi16(_mm_adds_epu16(data, _mm_set1_epi16(1)),
+                                                 _mm_set1_epi16(-1));
+        const __m128i amp = _mm_cmpeq_epi16(data, _mm_set1_epi16('&'));
+        const __m128i lt = _mm_cmpeq_epi16(data, _mm_set1_epi16('<'));
+        const __m128i bracket = _mm_cmpeq_epi16(data, _mm_set1_epi16(']'));
+        return _mm_or_si128(_mm_or_si128(controls, nonchars),
+                            _mm_or_si128(_mm_or_si128(amp, lt), bracket));
+    }
+#endif
+};
+
+// attribute values: like text content, but quotes end the value and ']'
+// has no special meaning
+struct LiteralRun
+{
+    static bool isSpecial(char16_t c) noexcept
+    {
+        return c < 0x20 || c == u'&' || c == u'<' || c == u'"' || c == u'\''
+                || c >= 0xfffe;
+    }
+#ifdef __SSE2__
+    static __m128i specialMask(__m128i data) noexcept
+    {
+        const __m128i controls = _mm_cmpeq_epi16(_mm_subs_epu16(data, _mm_set1_epi16(0x1f)),
+                                                 _mm_setzero_si128());
+        const __m128i nonchars = _mm_cmpeq_epi16(_mm_adds_epu16(data, _mm_set1_epi16(1)),
+                                                 _mm_set1_epi16(-1));
+        const __m128i amp = _mm_cmpeq_epi16(data, _mm_set1_epi16('&'));
+        const __m128i lt = _mm_cmpeq_epi16(data, _mm_set1_epi16('<'));
+        const __m128i dquote = _mm_cmpeq_epi16(data, _mm_set1_epi16('"'));
+        const __m128i squote = _mm_cmpeq_epi16(data, _mm_set1_epi16('\''));
+        return _mm_or_si128(_mm_or_si128(controls, nonchars),
+                            _mm_or_si128(_mm_or_si128(amp, lt), _mm_or_si128(dquote, squote)));
+    }
+#endif
+};
+
+// blanks between markup: only spaces and tabs, line breaks are counted
+struct SpaceRun
+{
+    static bool isSpecial(char16_t c) noexcept
+    { return c != u' ' && c != u'\t'; }
+#ifdef __SSE2__
+    static __m128i specialMask(__m128i data) noexcept
+    {
+        const __m128i space = _mm_cmpeq_epi16(data, _mm_set1_epi16(' '));
+        const __m128i tab = _mm_cmpeq_epi16(data, _mm_set1_epi16('\t'));
+        return _mm_xor_si128(_mm_or_si128(space, tab), _mm_set1_epi16(-1));
+    }
+#endif
+};
+
+// names: ASCII letters, digits, '-', '.' and '_'; the colon is left to
+// fastScanName(), which keeps track of the prefix
+struct NameRun
+{
+    static bool isSpecial(char16_t c) noexcept
+    {
+        return !(QtMiscUtils::isAsciiLetterOrNumber(c) || c == u'-' || c == u'.'
+                 || c == u'_');
+    }
+#ifdef __SSE2__
+    static __m128i specialMask(__m128i data) noexcept
+    {
+        // unsigned x <= n is (x -sat n) == 0
+        const auto inRange = [](__m128i x, char16_t first, char16_t last) {
+            const __m128i offset = _mm_sub_epi16(x, _mm_set1_epi16(short(first)));
+            return _mm_cmpeq_epi16(_mm_subs_epu16(offset, _mm_set1_epi16(short(last - first))),
+                                   _mm_setzero_si128());
+        };
+        const __m128i letter = inRange(_mm_or_si128(data, _mm_set1_epi16(0x20)), u'a', u'z');
+        const __m128i digit = inRange(data, u'0', u'9');
+        const __m128i punct = _mm_or_si128(inRange(data, u'-', u'.'),
+                                           _mm_cmpeq_epi16(data, _mm_set1_epi16('_')));
+        return _mm_xor_si128(_mm_or_si128(_mm_or_si128(letter, digit), punct),
+                             _mm_set1_epi16(-1));
+    }
+#endif
+};
+
+template <typename Run>
+qsizetype scanRun(const char16_t *ptr, const char16_t *end) noexcept
+{
+    const char16_t *const begin = ptr;
+#ifdef __SSE2__
+    while (end - ptr >= 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        if (const uint mask = _mm_movemask_epi8(Run::specialMask(data)))
+            return ptr - begin + qCountTrailingZeroBits(mask) / sizeof(char16_t);
+        ptr += 8;
+    }
+#endif
+    while (ptr != end && !Run::isSpecial(*ptr))
+        ++ptr;
+    return ptr - begin;
+}
+} // unnamed namespace
+
+/*!
+  \internal
+
+  Appends to textBuffer the run of characters at the current position of
+  readBuffer, of at most \a maxLength characters, that \c Run does not
+  consider special, and returns its length. The characters are consumed. Nothing is done if
+  characters were put back, since they have to be read first.
+ */
+template <typename Run>
+inline qsizetype QXmlStreamReaderPrivate::appendRun(qsizetype maxLength)
+{
+    if (putStack.size())
+        return 0;
+    const char16_t *ptr = reinterpret_cast<const char16_t *>(readBuffer.constData()) + readBufferPos;
+    const qsizetype available = qMin(readBuffer.size() - readBufferPos, maxLength);
+    const qsizetype len = scanRun<Run>(ptr, ptr + available);
+    if (len) {
+        textBuffer.append(QStringView(ptr, len));
+        readBufferPos += len;
+    }
+    return len;
+}
+
 /*!
  \internal
 
@@ -1153,7 +1294,7 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanLiteralContent()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    while ((n += appendRun<LiteralRun>(), c = getChar()) != StreamEOF) {
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1203,7 +1344,7 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanSpace()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    while ((n += appendRun<SpaceRun>(), c = getChar()) != StreamEOF) {
         switch (c) {
         case '\r':
             if ((c = filterCarriageReturn()) == 0)
@@ -1236,7 +1377,17 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    while (true) {
+        if (const qsizetype len = appendRun<ContentRun>()) {
+            if (isWhitespace) {
+                const QStringView run = QStringView(textBuffer).last(len);
+                isWhitespace = std::all_of(run.begin(), run.end(),
+                                           [](QChar ch) { return ch == u' '; });
+            }
+            n += len;
+        }
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1298,10 +1449,11 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanContentCharList()
 
 inline qsizetype QXmlStreamReaderPrivate::fastScanName(qint16 *prefix)
 {
+    constexpr qsizetype MaxNameLength = 4096;
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
-        if (n >= 4096) {
+    while ((n += appendRun<NameRun>(MaxNameLength - n), c = getChar()) != StreamEOF) {
+        if (n >= MaxNameLength) {
             // This is too long to be a sensible name, and
             // can exhaust memory, or the range of decltype(*prefix)
             return 0;
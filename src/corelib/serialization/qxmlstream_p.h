@@ -20,6 +20,7 @@
 #include <QCoreApplication> // Q_DECLARE_TR_FUNCTIONS
 
 
+#include <limits>
 #include <memory>
 
 #ifndef QXMLSTREAM_P_H
@@ -495,6 +496,7 @@ public:
 
     // scan optimization functions. Not strictly necessary but LALR is
     // not very well suited for scanning fast
+    template <typename Run> qsizetype appendRun(qsizetype maxLength = (std::numeric_limits<qsizetype>::max)());
     qsizetype fastScanLiteralContent();
     qsizetype fastScanSpace();
     qsizetype fastScanContentCharList();
@@ -0,0 +1,238 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QAHOCORASICK_P_H
+#define QAHOCORASICK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qlist.h>
+#include <QtCore/private/qglobal_p.h>
+
+#include <algorithm>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+/*
+    An Aho-Corasick automaton for finding any of a set of patterns in one pass,
+    as used by QMultiByteArrayMatcher and QMultiStringMatcher.
+
+    The automaton is built as a DFA: every state has a transition for every
+    character class, so scanning costs one table lookup per code unit. Code
+    units that do not occur in any pattern all share class 0, which keeps the
+    table at one row per trie node and one column per distinct code unit used
+    by the patterns.
+
+    Empty patterns are left to the caller.
+*/
+template <typename Char>
+class QAhoCorasick
+{
+public:
+    using Pattern = QList<Char>;
+
+    QAhoCorasick() = default;
+    explicit QAhoCorasick(const QList<Pattern> &patterns);
+
+    bool isEmpty() const noexcept { return transitions.isEmpty(); }
+    qsizetype maximumLength() const noexcept { return maxLength; }
+
+    // Calls callback(position, patternIndex) for each match in data[from, size),
+    // ordered by the position the matches end at, until it returns false.
+    // Code units are passed through fold() first.
+    template <typename Fold, typename Callback>
+    void forEachMatch(const Char *data, qsizetype from, qsizetype size, Fold fold,
+                      Callback callback) const;
+
+    // Returns the match starting first, and the lowest pattern index among
+    // those starting there; {-1, -1} if there is none.
+    template <typename Fold>
+    std::pair<qsizetype, qsizetype> firstMatch(const Char *data, qsizetype from,
+                                               qsizetype size, Fold fold) const;
+
+private:
+    static constexpr bool isLatin1(Char c) noexcept
+    {
+        if constexpr (sizeof(Char) == 1)
+            return true;
+        else
+            return c < 256;
+    }
+    qint32 classOf(Char c) const noexcept
+    {
+        if (isLatin1(c))
+            return latin1Classes[uchar(c)];
+        const auto it = std::lower_bound(otherClasses.cbegin(), otherClasses.cend(), c,
+                                         [](const auto &entry, Char c) { return entry.first < c; });
+        return it != otherClasses.cend() && it->first == c ? it->second : 0;
+    }
+    qint32 next(qint32 state, Char c) const noexcept
+    {
+        return transitions.at(state * classCount + classOf(c));
+    }
+    template <typename Callback>
+    bool forEachOutput(qint32 state, Callback &&callback) const
+    {
+        for ( ; state >= 0; state = dictionaryLinks.at(state)) {
+            for (qint32 i = outputBegin.at(state), end = outputBegin.at(state + 1); i < end; ++i) {
+                if (!callback(outputs.at(i)))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    qint32 latin1Classes[256] = {};
+    QList<std::pair<Char, qint32>> otherClasses; // sorted by code unit
+    qint32 classCount = 1;
+    QList<qint32> transitions;      // state * classCount + class
+    QList<qint32> dictionaryLinks;  // longest proper suffix state with outputs, or -1
+    QList<qint32> outputBegin;      // patterns ending in state s: outputs[outputBegin[s], outputBegin[s + 1])
+    QList<qint32> outputs;
+    QList<qsizetype> lengths;
+    qsizetype maxLength = 0;
+};
+
+template <typename Char>
+QAhoCorasick<Char>::QAhoCorasick(const QList<Pattern> &patterns)
+{
+    for (const Pattern &pattern : patterns) {
+        for (Char c : pattern) {
+            if (classOf(c))
+                continue;
+            if (isLatin1(c)) {
+                latin1Classes[uchar(c)] = classCount++;
+            } else {
+                const auto it = std::lower_bound(otherClasses.begin(), otherClasses.end(), c,
+                                                 [](const auto &entry, Char c) { return entry.first < c; });
+                otherClasses.insert(it, { c, classCount++ });
+            }
+        }
+    }
+
+    // the trie; missing transitions are -1 for now
+    QList<QList<qint32>> ownPatterns(1);
+    transitions.fill(-1, classCount);
+    lengths.reserve(patterns.size());
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const Pattern &pattern = patterns.at(i);
+        lengths.append(pattern.size());
+        if (pattern.isEmpty())
+            continue;
+        maxLength = qMax(maxLength, pattern.size());
+        qint32 state = 0;
+        for (Char c : pattern) {
+            const qsizetype index = state * classCount + classOf(c);
+            state = transitions.at(index);
+            if (state < 0) {
+                state = qint32(ownPatterns.size());
+                transitions[index] = state;
+                transitions.resize(transitions.size() + classCount, -1);
+                ownPatterns.emplace_back();
+            }
+        }
+        ownPatterns[state].append(qint32(i));
+    }
+    if (maxLength == 0) {
+        transitions.clear();
+        return;
+    }
+
+    // breadth-first: failure links, dictionary links and the DFA transitions
+    const qsizetype stateCount = ownPatterns.size();
+    QList<qint32> failure(stateCount, 0);
+    dictionaryLinks.fill(-1, stateCount);
+    QList<qint32> queue;
+    queue.reserve(stateCount);
+    for (qint32 c = 0; c < classCount; ++c) {
+        qint32 &state = transitions[c];
+        if (state < 0)
+            state = 0;
+        else
+            queue.append(state);
+    }
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const qint32 state = queue.at(head);
+        const qint32 fail = failure.at(state);
+        dictionaryLinks[state] = ownPatterns.at(fail).isEmpty() ? dictionaryLinks.at(fail) : fail;
+        for (qint32 c = 0; c < classCount; ++c) {
+            const qint32 target = transitions.at(state * classCount + c);
+            const qint32 fallback = transitions.at(fail * classCount + c);
+            if (target < 0) {
+                transitions[state * classCount + c] = fallback;
+            } else {
+                failure[target] = fallback;
+                queue.append(target);
+            }
+        }
+    }
+
+    outputBegin.reserve(stateCount + 1);
+    for (const QList<qint32> &own : std::as_const(ownPatterns)) {
+        outputBegin.append(qint32(outputs.size()));
+        outputs.append(own);
+    }
+    outputBegin.append(qint32(outputs.size()));
+}
+
+template <typename Char>
+template <typename Fold, typename Callback>
+void QAhoCorasick<Char>::forEachMatch(const Char *data, qsizetype from, qsizetype size,
+                                      Fold fold, Callback callback) const
+{
+    if (isEmpty())
+        return;
+    qint32 state = 0;
+    for (qsizetype i = from; i < size; ++i) {
+        state = next(state, fold(data[i]));
+        const bool proceed = forEachOutput(state, [&](qint32 pattern) {
+            return callback(i + 1 - lengths.at(pattern), qsizetype(pattern));
+        });
+        if (!proceed)
+            return;
+    }
+}
+
+template <typename Char>
+template <typename Fold>
+std::pair<qsizetype, qsizetype>
+QAhoCorasick<Char>::firstMatch(const Char *data, qsizetype from, qsizetype size, Fold fold) const
+{
+    std::pair<qsizetype, qsizetype> best(-1, -1);
+    if (isEmpty())
+        return best;
+    qint32 state = 0;
+    for (qsizetype i = from; i < size; ++i) {
+        // a match ending here or later cannot start before the best one
+        if (best.first >= 0 && i + 1 - maxLength > best.first)
+            break;
+        state = next(state, fold(data[i]));
+        forEachOutput(state, [&](qint32 pattern) {
+            const qsizetype position = i + 1 - lengths.at(pattern);
+            if (best.first < 0 || position < best.first
+                || (position == best.first && pattern < best.second)) {
+                best = { position, qsizetype(pattern) };
+            }
+            return true;
+        });
+    }
+    return best;
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QAHOCORASICK_P_H
@@ -3748,6 +3748,9 @@ auto QtPrivate::toSignedInteger(QByteArrayView data, int base) -> ParsedNumber<q
     if (data.isEmpty())
         return {};
 
+    if (qlonglong i; qt_parseShortDecimal(data.data(), data.size(), base, true, &i))
+        return ParsedNumber(i);
+
     bool ok = false;
     const auto i = QLocaleData::bytearrayToLongLong(data, base, &ok);
     if (ok)
@@ -3766,6 +3769,9 @@ auto QtPrivate::toUnsignedInteger(QByteArrayView data, int base) -> ParsedNumber
     if (data.isEmpty())
         return {};
 
+    if (qlonglong u; qt_parseShortDecimal(data.data(), data.size(), base, false, &u))
+        return ParsedNumber(qulonglong(u));
+
     bool ok = false;
     const auto u = QLocaleData::bytearrayToUnsLongLong(data, base, &ok);
     if (ok)
@@ -4051,6 +4057,8 @@ double QByteArray::toDouble(bool *ok) const
 
 auto QtPrivate::toDouble(QByteArrayView a) noexcept -> ParsedNumber<double>
 {
+    if (double d; qt_parseShortDouble(a.data(), a.size(), &d))
+        return ParsedNumber{d};
     auto r = qt_asciiToDouble(a.data(), a.size(), WhitespacesAllowed);
     if (r.ok())
         return ParsedNumber{r.result};
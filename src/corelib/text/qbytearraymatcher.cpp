@@ -3,6 +3,11 @@
 
 #include "qbytearraymatcher.h"
 
+#include <private/qahocorasick_p.h>
+#include <private/qsimd_p.h>
+#include <qvarlengtharray.h>
+
+#include <algorithm>
 #include <limits.h>
 
 QT_BEGIN_NAMESPACE
@@ -307,6 +312,391 @@ qsizetype qFindByteArray(
     return -1;
 }
 
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.7
+    \brief The QMultiByteArrayMatcher class finds any of a set of byte
+    sequences in a byte array in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    Searching a byte array for many patterns with one QByteArrayMatcher per
+    pattern takes one pass over the data for each of them.
+    QMultiByteArrayMatcher prepares all patterns together, and then finds
+    every match of any of them in one pass, however many patterns there are.
+
+    Create the QMultiByteArrayMatcher with the list of patterns, then call
+    indexIn() for the first match, or matches() for all of them. Matches are
+    reported with the position they start at and the index of the pattern in
+    the list returned by patterns().
+
+    Small sets of patterns are searched for with a vectorized filter on
+    processors that support it; large sets use an Aho-Corasick automaton.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \since 6.7
+
+    \brief The Match struct describes an occurrence of one of the patterns
+    of a QMultiByteArrayMatcher.
+
+    \sa QMultiByteArrayMatcher::matches()
+*/
+
+/*!
+    \variable QMultiByteArrayMatcher::Match::position
+
+    The position in the searched data at which the match starts.
+*/
+
+/*!
+    \variable QMultiByteArrayMatcher::Match::patternIndex
+
+    The index of the pattern that matched in
+    QMultiByteArrayMatcher::patterns().
+*/
+
+// Teddy: on x86 with SSSE3, small sets of patterns are found by looking up the
+// nibbles of the first bytes at each position in per-bucket bit masks, and then
+// comparing the candidates with the patterns in the buckets that fit.
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+#  define QT_MULTIBYTEARRAYMATCHER_TEDDY
+static constexpr qsizetype TeddyMaximumPatterns = 64;
+#endif
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    explicit QMultiByteArrayMatcherPrivate(const QList<QByteArray> &patterns);
+
+    bool matchesAt(const uchar *data, qsizetype size, qsizetype position,
+                   qsizetype pattern) const noexcept
+    {
+        const QByteArray &p = patterns.at(pattern);
+        return position + p.size() <= size && memcmp(data + position, p.constData(), p.size()) == 0;
+    }
+
+    QList<QByteArray> patterns;
+    QList<qsizetype> emptyPatterns;
+    QtPrivate::QAhoCorasick<uchar> automaton;
+#ifdef QT_MULTIBYTEARRAYMATCHER_TEDDY
+    int teddyLength = 0; // number of leading bytes in the masks; 0 if not used
+    alignas(16) uchar teddyLow[3][16] = {};
+    alignas(16) uchar teddyHigh[3][16] = {};
+    QList<qsizetype> teddyBuckets[8];
+#endif
+};
+
+QMultiByteArrayMatcherPrivate::QMultiByteArrayMatcherPrivate(const QList<QByteArray> &patterns)
+    : patterns(patterns)
+{
+    qsizetype nonEmpty = 0;
+    qsizetype minLength = std::numeric_limits<qsizetype>::max();
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        if (patterns.at(i).isEmpty()) {
+            emptyPatterns.append(i);
+        } else {
+            ++nonEmpty;
+            minLength = qMin(minLength, patterns.at(i).size());
+        }
+    }
+    if (!nonEmpty)
+        return;
+
+#ifdef QT_MULTIBYTEARRAYMATCHER_TEDDY
+    if (nonEmpty <= TeddyMaximumPatterns && qCpuHasFeature(SSSE3)) {
+        teddyLength = int(qMin(minLength, qsizetype(3)));
+        uint bucket = 0;
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            const QByteArray &pattern = patterns.at(i);
+            if (pattern.isEmpty())
+                continue;
+            teddyBuckets[bucket].append(i);
+            for (int j = 0; j < teddyLength; ++j) {
+                const uchar c = uchar(pattern.at(j));
+                teddyLow[j][c & 0xf] |= 1u << bucket;
+                teddyHigh[j][c >> 4] |= 1u << bucket;
+            }
+            bucket = (bucket + 1) % 8;
+        }
+        return;
+    }
+#endif
+
+    QList<QtPrivate::QAhoCorasick<uchar>::Pattern> units;
+    units.reserve(patterns.size());
+    for (const QByteArray &pattern : patterns) {
+        const auto begin = reinterpret_cast<const uchar *>(pattern.constData());
+        units.emplace_back(begin, begin + pattern.size());
+    }
+    automaton = QtPrivate::QAhoCorasick<uchar>(units);
+}
+
+#ifdef QT_MULTIBYTEARRAYMATCHER_TEDDY
+// Calls candidate(position, buckets) for each position in [from, size) whose
+// first bytes fit the masks of at least one bucket, in order, until it
+// returns false.
+template <int Length, typename Candidate>
+static void QT_FUNCTION_TARGET(SSSE3)
+teddyScan(const QMultiByteArrayMatcherPrivate *d, const uchar *data, qsizetype from, qsizetype size,
+          Candidate candidate)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    __m128i low[Length];
+    __m128i high[Length];
+    for (int j = 0; j < Length; ++j) {
+        low[j] = _mm_load_si128(reinterpret_cast<const __m128i *>(d->teddyLow[j]));
+        high[j] = _mm_load_si128(reinterpret_cast<const __m128i *>(d->teddyHigh[j]));
+    }
+
+    qsizetype i = from;
+    for ( ; i + 16 + Length - 1 <= size; i += 16) {
+        __m128i buckets = _mm_set1_epi8(-1);
+        for (int j = 0; j < Length; ++j) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + j));
+            const __m128i lo = _mm_shuffle_epi8(low[j], _mm_and_si128(bytes, nibble));
+            const __m128i hi = _mm_shuffle_epi8(high[j], _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+            buckets = _mm_and_si128(buckets, _mm_and_si128(lo, hi));
+        }
+        uint mask = ~uint(_mm_movemask_epi8(_mm_cmpeq_epi8(buckets, _mm_setzero_si128()))) & 0xffff;
+        if (!mask)
+            continue;
+        alignas(16) uchar bits[16];
+        _mm_store_si128(reinterpret_cast<__m128i *>(bits), buckets);
+        do {
+            const uint offset = qCountTrailingZeroBits(mask);
+            if (!candidate(i + offset, uint(bits[offset])))
+                return;
+            mask &= mask - 1;
+        } while (mask);
+    }
+
+    for ( ; i + Length <= size; ++i) {
+        uint bits = 0xff;
+        for (int j = 0; j < Length; ++j) {
+            const uchar c = data[i + j];
+            bits &= d->teddyLow[j][c & 0xf] & d->teddyHigh[j][c >> 4];
+        }
+        if (bits && !candidate(i, bits))
+            return;
+    }
+}
+
+// Calls match(position, patternIndex) for every match, ordered by position
+// and then by pattern index, until it returns false.
+template <typename Match>
+static void teddyForEachMatch(const QMultiByteArrayMatcherPrivate *d, const uchar *data,
+                              qsizetype from, qsizetype size, Match match)
+{
+    const auto candidate = [&](qsizetype position, uint buckets) {
+        QVarLengthArray<qsizetype, 16> found;
+        for ( ; buckets; buckets &= buckets - 1) {
+            for (qsizetype pattern : d->teddyBuckets[qCountTrailingZeroBits(buckets)]) {
+                if (d->matchesAt(data, size, position, pattern))
+                    found.append(pattern);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        for (qsizetype pattern : std::as_const(found)) {
+            if (!match(position, pattern))
+                return false;
+        }
+        return true;
+    };
+    switch (d->teddyLength) {
+    case 1:
+        teddyScan<1>(d, data, from, size, candidate);
+        break;
+    case 2:
+        teddyScan<2>(d, data, from, size, candidate);
+        break;
+    case 3:
+        teddyScan<3>(d, data, from, size, candidate);
+        break;
+    }
+}
+#endif // QT_MULTIBYTEARRAYMATCHER_TEDDY
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiByteArrayMatcherPrivate)
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+
+    Constructs a matcher without patterns, which does not match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+
+/*!
+    Constructs a matcher that searches for any of \a patterns.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QList<QByteArray> &patterns)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiByteArrayMatcher::QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+
+    \note The moved-from object \a other can only be destroyed or assigned
+    to.
+*/
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher() = default;
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    An empty pattern matches at every position, including the end of the
+    searched data.
+
+    \sa patterns()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QList<QByteArray> &patterns)
+{
+    d.reset(patterns.isEmpty() ? nullptr : new QMultiByteArrayMatcherPrivate(patterns));
+}
+
+/*!
+    Returns the patterns that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QByteArray> QMultiByteArrayMatcher::patterns() const
+{
+    return d ? d->patterns : QList<QByteArray>();
+}
+
+/*!
+    Searches \a data, from byte position \a from (default 0, i.e. from the
+    first byte), for any of the patterns. Returns the position of the first
+    match in \a data, or -1 if no match was found.
+
+    If \a patternIndex is not \nullptr, the index of the pattern that matched
+    is stored in it. If more than one pattern matches at that position, it is
+    the lowest index among them.
+
+    \sa matches()
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(QByteArrayView data, qsizetype from,
+                                          qsizetype *patternIndex) const
+{
+    if (from < 0)
+        from = 0;
+    std::pair<qsizetype, qsizetype> best(-1, -1);
+    if (d && from <= data.size()) {
+        const auto bytes = reinterpret_cast<const uchar *>(data.data());
+#ifdef QT_MULTIBYTEARRAYMATCHER_TEDDY
+        if (d->teddyLength) {
+            teddyForEachMatch(d.data(), bytes, from, data.size(),
+                              [&best](qsizetype position, qsizetype pattern) {
+                best = { position, pattern };
+                return false;
+            });
+        } else
+#endif
+        {
+            best = d->automaton.firstMatch(bytes, from, data.size(), [](uchar c) { return c; });
+        }
+        // an empty pattern matches right away
+        if (!d->emptyPatterns.isEmpty()) {
+            const qsizetype empty = d->emptyPatterns.first();
+            if (best.first != from || empty < best.second)
+                best = { from, empty };
+        }
+    }
+    if (patternIndex)
+        *patternIndex = best.second;
+    return best.first;
+}
+
+/*!
+    Searches \a data, from byte position \a from (default 0, i.e. from the
+    first byte), for all occurrences of any of the patterns, and returns
+    them ordered by position, and then by pattern index.
+
+    Overlapping matches are all reported, as are matches of different
+    patterns at the same position.
+
+    \sa indexIn()
+*/
+QList<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matches(QByteArrayView data,
+                                                                     qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+    QList<Match> result;
+    if (!d || from > data.size())
+        return result;
+
+    const auto bytes = reinterpret_cast<const uchar *>(data.data());
+    const auto append = [&result](qsizetype position, qsizetype pattern) {
+        result.append({ position, pattern });
+        return true;
+    };
+    bool sorted = true;
+#ifdef QT_MULTIBYTEARRAYMATCHER_TEDDY
+    if (d->teddyLength) {
+        teddyForEachMatch(d.data(), bytes, from, data.size(), append);
+    } else
+#endif
+    {
+        // the automaton reports matches by the position they end at
+        d->automaton.forEachMatch(bytes, from, data.size(), [](uchar c) { return c; }, append);
+        sorted = false;
+    }
+    if (!d->emptyPatterns.isEmpty()) {
+        for (qsizetype position = from; position <= data.size(); ++position) {
+            for (qsizetype pattern : d->emptyPatterns)
+                result.append({ position, pattern });
+        }
+        sorted = false;
+    }
+    if (!sorted) {
+        std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) {
+            return lhs.position < rhs.position
+                    || (lhs.position == rhs.position && lhs.patternIndex < rhs.patternIndex);
+        });
+    }
+    return result;
+}
+
 /*!
     \class QStaticByteArrayMatcherBase
     \since 5.9
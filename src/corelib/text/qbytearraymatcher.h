@@ -5,6 +5,8 @@
 #define QBYTEARRAYMATCHER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 
 #include <QtCore/q20algorithm.h>
 #include <iterator>
@@ -61,6 +63,46 @@ private:
     };
 };
 
+class QMultiByteArrayMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiByteArrayMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position;
+        qsizetype patternIndex;
+
+        friend bool operator==(const Match &lhs, const Match &rhs) noexcept
+        { return lhs.position == rhs.position && lhs.patternIndex == rhs.patternIndex; }
+        friend bool operator!=(const Match &lhs, const Match &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiByteArrayMatcher() noexcept = default;
+    explicit QMultiByteArrayMatcher(const QList<QByteArray> &patterns);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other) noexcept;
+    QMultiByteArrayMatcher(QMultiByteArrayMatcher &&other) noexcept = default;
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiByteArrayMatcher)
+    ~QMultiByteArrayMatcher();
+
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    void setPatterns(const QList<QByteArray> &patterns);
+    QList<QByteArray> patterns() const;
+
+    qsizetype indexIn(QByteArrayView data, qsizetype from = 0,
+                      qsizetype *patternIndex = nullptr) const;
+    QList<Match> matches(QByteArrayView data, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+
 class QStaticByteArrayMatcherBase
 {
     alignas(16)
@@ -82,6 +82,7 @@ public:
     { return compare(s1, s2) < 0; }
 
     QCollatorSortKey sortKey(const QString &string) const;
+    QList<QCollatorSortKey> sortKeys(const QStringList &strings) const;
 
     static int defaultCompare(QStringView s1, QStringView s2);
     static QCollatorSortKey defaultSortKey(QStringView key);
@@ -18,8 +18,10 @@
 #include <stdlib.h>
 #include <time.h>
 
-#include <limits>
+#include <algorithm>
 #include <charconv>
+#include <cmath>
+#include <limits>
 
 #if defined(Q_OS_LINUX) && !defined(__UCLIBC__)
 #    include <fenv.h>
@@ -42,6 +44,45 @@ using namespace QtMiscUtils;
 
 QT_CLOCALE_HOLDER
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+// Produces the same digits as libdouble-conversion's SHORTEST mode, the
+// shortest ones that read back as d, but considerably faster: the standard
+// libraries implement std::to_chars() with Ryu or similar algorithms.
+// Returns false if the digits do not fit in buf.
+static bool shortestDigits(double d, char *buf, qsizetype bufSize,
+                           bool &sign, int &length, int &decpt)
+{
+    // d.ddde+XXX at most
+    char scientific[32];
+    const auto res = std::to_chars(scientific, scientific + sizeof scientific,
+                                   std::abs(d), std::chars_format::scientific);
+    if (res.ec != std::errc())
+        return false;
+    const char *e = std::find(scientific, res.ptr, 'e');
+    Q_ASSERT(e != res.ptr);
+
+    int digits = 0;
+    for (const char *p = scientific; p < e; ++p) {
+        if (*p == '.')
+            continue;
+        if (digits == bufSize)
+            return false;
+        buf[digits++] = *p;
+    }
+    int exponent = 0;
+    const char *p = e + 1;
+    const bool negativeExponent = *p == '-';
+    if (*p == '-' || *p == '+')
+        ++p;
+    std::from_chars(p, res.ptr, exponent);
+
+    sign = std::signbit(d);
+    length = digits;
+    decpt = (negativeExponent ? -exponent : exponent) + 1;
+    return true;
+}
+#endif
+
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
                       char *buf, qsizetype bufSize,
                       bool &sign, int &length, int &decpt)
@@ -85,6 +126,12 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision,
         precision = 1; // 0 significant digits is silently converted to 1
 
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    if (precision == QLocale::FloatingPointShortest
+        && shortestDigits(d, buf, bufSize, sign, length, decpt)) {
+        return;
+    }
+#endif
     // one digit before the decimal dot, counts as significant digit for DoubleToStringConverter
     if (form == QLocaleData::DFExponent && precision >= 0)
         ++precision;
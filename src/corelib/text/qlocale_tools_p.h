@@ -15,6 +15,7 @@
 // We mean it.
 //
 
+#include <QtCore/private/qtools_p.h>
 #include "qlocale_p.h"
 #include "qstring.h"
 
@@ -93,6 +94,68 @@ template <typename UcsInt>
 [[nodiscard]] QSimpleParsedNumber<qlonglong> qstrntoll(const char *nptr, qsizetype size, int base);
 [[nodiscard]] QSimpleParsedNumber<qulonglong> qstrntoull(const char *nptr, qsizetype size, int base);
 
+// Fast paths for the common case of a plain decimal number, a sign followed
+// by at most 18 digits (or 15 for doubles, with an optional fraction) and
+// nothing else. They return false for anything they don't handle, which the
+// caller must then pass to the general parser above.
+template <typename Char>
+[[nodiscard]] inline bool qt_parseShortDecimal(const Char *p, qsizetype size, int base,
+                                               bool allowNegative, qlonglong *result) noexcept
+{
+    if ((base != 10 && base != 0) || size <= 0)
+        return false;
+    const Char *const stop = p + size;
+    const bool negative = *p == Char('-');
+    if (negative && !allowNegative)
+        return false;
+    if (negative || *p == Char('+'))
+        ++p;
+    // With base 0, a leading '0' selects octal, hex or binary
+    if (p == stop || stop - p > 18 || (base == 0 && *p == Char('0') && stop - p > 1))
+        return false;
+    qlonglong value = 0;
+    for (; p != stop; ++p) {
+        if (!QtMiscUtils::isAsciiDigit(*p))
+            return false;
+        value = value * 10 + (*p - Char('0'));
+    }
+    *result = negative ? -value : value;
+    return true;
+}
+
+template <typename Char>
+[[nodiscard]] inline bool qt_parseShortDouble(const Char *p, qsizetype size, double *result) noexcept
+{
+    // Digits and fraction are exact as doubles, so one division rounds correctly
+    constexpr double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+                                       1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+    const Char *const stop = p + size;
+    const bool negative = p != stop && *p == Char('-');
+    if (negative)
+        ++p;
+    if (p == stop || !QtMiscUtils::isAsciiDigit(*p))
+        return false;
+    qint64 mantissa = 0;
+    int digits = 0;
+    int fractionDigits = -1;
+    for (; p != stop; ++p) {
+        if (*p == Char('.') && fractionDigits < 0) {
+            fractionDigits = 0;
+            continue;
+        }
+        if (!QtMiscUtils::isAsciiDigit(*p) || ++digits > 15)
+            return false;
+        mantissa = mantissa * 10 + (*p - Char('0'));
+        if (fractionDigits >= 0)
+            ++fractionDigits;
+    }
+    if (fractionDigits == 0) // "1." is left to the general parser
+        return false;
+    const double value = double(mantissa) / powersOfTen[qMax(fractionDigits, 0)];
+    *result = negative ? -value : value;
+    return true;
+}
+
 QT_END_NAMESPACE
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "qregularexpression.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -23,6 +24,9 @@
 
 #include <pcre2.h>
 
+#include <atomic>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -430,6 +434,19 @@ using namespace Qt::StringLiterals;
     \c{QT_ENABLE_REGEXP_JIT} environment variable to a non-zero or zero value
     respectively.
 
+    \section1 Compiled Patterns
+
+    The compiled (and JIT-compiled) form of a pattern is kept in a process-wide
+    cache, keyed by the pattern string and the pattern options. Creating a
+    QRegularExpression with a pattern that was used recently, for instance a
+    temporary object in a function that is called often, therefore does not
+    compile the pattern again. Only the least recently used patterns are
+    dropped from the cache.
+
+    Once compiled, a pattern can be matched by many threads at the same time,
+    even through the same QRegularExpression object, without them having to
+    wait for one another.
+
     \sa QRegularExpressionMatch, QRegularExpressionMatchIterator
 */
 
@@ -700,6 +717,30 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    The result of compiling a pattern with a set of pattern options. It is
+    never modified after it has been created, and PCRE2 allows a compiled
+    (and JIT-compiled) pattern to be used by several threads at once, so the
+    same object is shared by all the QRegularExpressionPrivate objects that
+    use that pattern, through QRegularExpressionCache.
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    QRegularExpressionCompiledPattern(const QString &pattern,
+                                      QRegularExpression::PatternOptions patternOptions);
+    ~QRegularExpressionCompiledPattern();
+    Q_DISABLE_COPY_MOVE(QRegularExpressionCompiledPattern)
+
+    void getPatternInfo(const QString &pattern);
+    void optimizePattern();
+
+    pcre2_code_16 *code = nullptr;
+    int errorCode = 0;
+    qsizetype errorOffset = -1;
+    int capturingCount = 0;
+    bool usingCrLfNewlines = false;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -708,8 +749,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -727,20 +766,23 @@ struct QRegularExpressionPrivate : QSharedData
     QRegularExpression::PatternOptions patternOptions;
     QString pattern;
 
-    // *All* of the following members are managed while holding this mutex,
+    // *All* of the following members are set while holding this mutex,
     // except for isDirty which is set to true by QRegularExpression setters
-    // (right after a detach happened).
+    // (right after a detach happened). Once isDirty has been cleared they are
+    // only read, so matching does not need to lock.
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The compiled pattern is shared with the cache and with other
+    // QRegularExpressionPrivate objects using the same pattern and options;
+    // the other members are copied from it. When the private is copied
+    // (i.e. a detach happened) they are reset.
+    QExplicitlySharedDataPointer<const QRegularExpressionCompiledPattern> compiled;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
     int capturingCount;
     bool usingCrLfNewlines;
-    bool isDirty;
+    std::atomic<bool> isDirty;
 };
 
 struct QRegularExpressionMatchPrivate : QSharedData
@@ -868,7 +910,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiled.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -878,29 +920,25 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 
 /*!
     \internal
+
+    Compiles \a pattern with the given \a patternOptions, and JIT-compiles
+    it if the JIT is enabled.
 */
-void QRegularExpressionPrivate::compilePattern()
+QRegularExpressionCompiledPattern::QRegularExpressionCompiledPattern(const QString &pattern,
+                                                                     QRegularExpression::PatternOptions patternOptions)
 {
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
-                                       pattern.size(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       nullptr);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(reinterpret_cast<PCRE2_SPTR16>(pattern.constData()),
+                            pattern.size(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            nullptr);
+
+    if (!code) {
         errorOffset = qsizetype(patternErrorOffset);
         return;
     } else {
@@ -909,21 +947,29 @@ void QRegularExpressionPrivate::compilePattern()
     }
 
     optimizePattern();
-    getPatternInfo();
+    getPatternInfo(pattern);
 }
 
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+QRegularExpressionCompiledPattern::~QRegularExpressionCompiledPattern()
 {
-    Q_ASSERT(compiledPattern);
+    pcre2_code_free_16(code);
+}
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+/*!
+    \internal
+*/
+void QRegularExpressionCompiledPattern::getPatternInfo(const QString &pattern)
+{
+    Q_ASSERT(code);
+
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -933,13 +979,87 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
     unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
     if (Q_UNLIKELY(hasJOptionChanged)) {
         qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
     }
 }
 
+namespace {
+/*
+    The process-wide cache of compiled patterns. Patterns are compiled
+    without holding the lock, so that threads compiling different patterns
+    do not wait for each other; if two threads compile the same pattern at
+    the same time, the first one to insert it wins.
+*/
+class QRegularExpressionCache
+{
+public:
+    using CompiledPattern = QExplicitlySharedDataPointer<const QRegularExpressionCompiledPattern>;
+
+    CompiledPattern fetch(const QString &pattern, QRegularExpression::PatternOptions options)
+    {
+        const Key key(pattern, options.toInt());
+        {
+            QMutexLocker locker(&mutex);
+            if (const CompiledPattern *entry = cache.object(key))
+                return *entry;
+        }
+
+        CompiledPattern compiled(new QRegularExpressionCompiledPattern(pattern, options));
+
+        QMutexLocker locker(&mutex);
+        if (const CompiledPattern *entry = cache.object(key))
+            return *entry;
+        cache.insert(key, new CompiledPattern(compiled));
+        return compiled;
+    }
+
+private:
+    using Key = std::pair<QString, int>;
+
+    // the cost of an entry is 1: compiled patterns are usually small
+    enum { MaximumCachedPatterns = 256 };
+
+    QMutex mutex;
+    QCache<Key, CompiledPattern> cache{MaximumCachedPatterns};
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QRegularExpressionCache, regularExpressionCache)
+
+/*!
+    \internal
+
+    Fetches the compiled pattern from the cache (compiling it if needed), the
+    first time it is called after the pattern or the pattern options changed.
+    Once that has happened, calling it again is just an atomic load.
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    if (!isDirty.load(std::memory_order_acquire))
+        return;
+
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty.load(std::memory_order_relaxed))
+        return;
+
+    cleanCompiledPattern();
+
+    QRegularExpressionCache *cache = regularExpressionCache();
+    compiled = cache ? cache->fetch(pattern, patternOptions)
+                     : QExplicitlySharedDataPointer<const QRegularExpressionCompiledPattern>(
+                               new QRegularExpressionCompiledPattern(pattern, patternOptions));
+    compiledPattern = compiled->code;
+    errorCode = compiled->errorCode;
+    errorOffset = compiled->errorOffset;
+    capturingCount = compiled->capturingCount;
+    usingCrLfNewlines = compiled->usingCrLfNewlines;
+
+    isDirty.store(false, std::memory_order_release);
+}
 
 /*
     Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
@@ -955,6 +1075,29 @@ struct PcreJitStackFree
     }
 };
 Q_CONSTINIT static thread_local std::unique_ptr<pcre2_jit_stack_16, PcreJitStackFree> jitStacks;
+
+/*
+    The match context and the match data used by doMatch(), kept per thread
+    so that matching neither allocates them every time nor needs to share
+    them between threads.
+*/
+struct PcreMatchContextFree
+{
+    void operator()(pcre2_match_context_16 *context)
+    {
+        pcre2_match_context_free_16(context);
+    }
+};
+Q_CONSTINIT static thread_local std::unique_ptr<pcre2_match_context_16, PcreMatchContextFree> matchContexts;
+
+struct PcreMatchDataFree
+{
+    void operator()(pcre2_match_data_16 *matchData)
+    {
+        pcre2_match_data_free_16(matchData);
+    }
+};
+Q_CONSTINIT static thread_local std::unique_ptr<pcre2_match_data_16, PcreMatchDataFree> matchDatas;
 }
 
 /*!
@@ -965,6 +1108,32 @@ static pcre2_jit_stack_16 *qtPcreCallback(void *)
     return jitStacks.get();
 }
 
+/*!
+    \internal
+*/
+static pcre2_match_context_16 *threadMatchContext()
+{
+    if (!matchContexts) {
+        matchContexts.reset(pcre2_match_context_create_16(nullptr));
+        pcre2_jit_stack_assign_16(matchContexts.get(), &qtPcreCallback, nullptr);
+    }
+    return matchContexts.get();
+}
+
+/*!
+    \internal
+
+    Returns this thread's match data, making sure it has room for the
+    offsets of \a capturingCount capturing groups plus the whole match.
+*/
+static pcre2_match_data_16 *threadMatchData(int capturingCount)
+{
+    const uint32_t pairs = uint32_t(capturingCount) + 1;
+    if (!matchDatas || pcre2_get_ovector_count_16(matchDatas.get()) < pairs)
+        matchDatas.reset(pcre2_match_data_create_16(pairs, nullptr));
+    return matchDatas.get();
+}
+
 /*!
     \internal
 */
@@ -992,19 +1161,19 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us, before the compiled
+    pattern is shared with other threads.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledPattern::optimizePattern()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
 /*!
@@ -1141,9 +1310,8 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
         previousMatchWasEmpty = true;
     }
 
-    pcre2_match_context_16 *matchContext = pcre2_match_context_create_16(nullptr);
-    pcre2_jit_stack_assign_16(matchContext, &qtPcreCallback, nullptr);
-    pcre2_match_data_16 *matchData = pcre2_match_data_create_from_pattern_16(compiledPattern, nullptr);
+    pcre2_match_context_16 *matchContext = threadMatchContext();
+    pcre2_match_data_16 *matchData = threadMatchData(capturingCount);
 
     // PCRE does not accept a null pointer as subject string, even if
     // its length is zero. We however allow it in input: a QStringView
@@ -1256,9 +1424,6 @@ void QRegularExpressionPrivate::doMatch(QRegularExpressionMatchPrivate *priv,
             capturedOffsets[0] -= maximumLookBehind;
         }
     }
-
-    pcre2_match_data_free_16(matchData);
-    pcre2_match_context_free_16(matchContext);
 }
 
 /*!
@@ -791,6 +791,71 @@ const char16_t *QtPrivate::qustrchr(QStringView str, char16_t c) noexcept
     return std::find(n, e, c);
 }
 
+/*!
+ * \internal
+ *
+ * Returns a bit mask of the positions at which the character \a c occurs in
+ * \a str: bit \c i is set if \c{str[i] == c}. \a str must not hold more
+ * than 64 characters.
+ *
+ * This lets callers that need every occurrence (such as splitting on a
+ * single character) find them with one vector scan per 64 characters rather
+ * than one qustrchr() call per occurrence.
+ */
+quint64 QtPrivate::qustrchrMask(QStringView str, char16_t c) noexcept
+{
+    Q_ASSERT(str.size() <= 64);
+    const char16_t *n = str.utf16();
+    const qsizetype size = str.size();
+    quint64 result = 0;
+    qsizetype i = 0;
+
+#ifdef __SSE2__
+    // Compare 16 characters at a time and pack the two 8-lane results into
+    // bytes, so that PMOVMSKB yields one bit per character.
+    if constexpr (UseAvx2) {
+        const __m256i mch256 = _mm256_set1_epi16(short(c));
+        for ( ; i + 32 <= size; i += 32) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(n + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(n + i + 16));
+            __m256i packed = _mm256_packs_epi16(_mm256_cmpeq_epi16(a, mch256),
+                                                _mm256_cmpeq_epi16(b, mch256));
+            // PACKSSWB works per 128-bit lane; put the quadwords back in order
+            packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+            result |= quint64(uint(_mm256_movemask_epi8(packed))) << i;
+        }
+    }
+
+    const __m128i mch = _mm_set1_epi16(short(c));
+    for ( ; i + 16 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n + i + 8));
+        __m128i packed = _mm_packs_epi16(_mm_cmpeq_epi16(a, mch), _mm_cmpeq_epi16(b, mch));
+        result |= quint64(uint(_mm_movemask_epi8(packed))) << i;
+    }
+    if (i + 8 <= size) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n + i));
+        __m128i packed = _mm_packs_epi16(_mm_cmpeq_epi16(a, mch), _mm_setzero_si128());
+        result |= quint64(uint(_mm_movemask_epi8(packed))) << i;
+        i += 8;
+    }
+#elif defined(__ARM_NEON__)
+    const uint16x8_t vmask = { 1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7 };
+    const uint16x8_t ch_vec = vdupq_n_u16(c);
+    for ( ; i + 8 <= size; i += 8) {
+        uint16x8_t data = vld1q_u16(reinterpret_cast<const uint16_t *>(n + i));
+        uint mask = vaddvq_u16(vandq_u16(vceqq_u16(data, ch_vec), vmask));
+        result |= quint64(mask) << i;
+    }
+#endif
+
+    for ( ; i < size; ++i) {
+        if (n[i] == c)
+            result |= quint64(1) << i;
+    }
+    return result;
+}
+
 // Note: ptr on output may be off by one and point to a preceding US-ASCII
 // character. Usually harmless.
 bool qt_is_ascii(const char *&ptr, const char *end) noexcept
@@ -6971,6 +7036,44 @@ QString QString::toUpper_helper(QString &str)
     return QUnicodeTables::convertCase(str, QUnicodeTables::UpperCase);
 }
 
+/*!
+    \fn template <typename...Args> QString QString::format(QStringView pattern, const Args &...args)
+    \fn template <typename...Args> QString QString::format(QLatin1StringView pattern, const Args &...args)
+    \since 6.7
+
+    Returns a copy of \a pattern with each occurrence of \c{%N} replaced by
+    the corresponding argument from \a args, the way the multi-argument
+    arg() does: the first of the \a args replaces the \c{%N} with the
+    lowest \c{N}, the second the next-lowest \c{N} etc.
+
+    Unlike a chain of arg() calls, the pattern is scanned once and the
+    result is written into a single allocation, and a placeholder in the
+    text of an argument is never replaced.
+
+    The following types are supported, and using any other type is a
+    compile-time error:
+
+    \list
+    \li anything that implicitly converts to QStringView, and
+        QLatin1StringView;
+    \li QChar, QLatin1Char, \c char16_t and \c char, which is taken as
+        Latin-1;
+    \li anything that implicitly converts to QByteArrayView, such as
+        QByteArray and string literals, which is taken as UTF-8;
+    \li integers, which are written in decimal, like QString::number();
+    \li floating-point numbers, which are written with as few digits as
+        represent them exactly, like QString::number() with a precision of
+        QLocale::FloatingPointShortest.
+    \endlist
+
+    Numbers are always formatted as in the C locale; use arg() or QLocale
+    for localized text, field widths and other number formats.
+
+    \snippet qstring/main.cpp format
+
+    \sa arg(), asprintf()
+*/
+
 /*!
     \since 5.5
 
@@ -7389,6 +7492,13 @@ static Int toIntegral(QStringView string, bool *ok, int base)
     }
 #endif
 
+    if (qlonglong value; qt_parseShortDecimal(string.utf16(), string.size(), base,
+                                              std::is_signed_v<Int>, &value)) {
+        if (ok)
+            *ok = true;
+        return Int(value);
+    }
+
     QVarLengthArray<uchar> latin1(string.size());
     qt_to_latin1(latin1.data(), string.utf16(), string.size());
     if constexpr (std::is_signed_v<Int>)
@@ -7650,6 +7760,11 @@ double QString::toDouble(bool *ok) const
 double QStringView::toDouble(bool *ok) const
 {
     QStringView string = qt_trimmed(*this);
+    if (double value; qt_parseShortDouble(string.utf16(), string.size(), &value)) {
+        if (ok != nullptr)
+            *ok = true;
+        return value;
+    }
     QVarLengthArray<uchar> latin1(string.size());
     qt_to_latin1(latin1.data(), string.utf16(), string.size());
     auto r = qt_asciiToDouble(reinterpret_cast<const char *>(latin1.data()), string.size());
@@ -7913,6 +8028,24 @@ static ResultList splitString(const StringSource &source, QStringView sep,
     typename StringSource::size_type start = 0;
     typename StringSource::size_type end;
     typename StringSource::size_type extra = 0;
+    if (sep.size() == 1 && (cs == Qt::CaseSensitive || !QtPrivate::Tok::isCaseSensitive(sep.front()))) {
+        // single character: find the separators 64 characters at a time
+        const QStringView str(source.constData(), source.size());
+        const char16_t c = sep.front().unicode();
+        for (qsizetype window = 0; window < str.size(); window += 64) {
+            quint64 separators = QtPrivate::qustrchrMask(str.sliced(window, qMin(str.size() - window, qsizetype(64))), c);
+            while (separators) {
+                end = window + qCountTrailingZeroBits(separators);
+                separators &= separators - 1;
+                if (start != end || behavior == Qt::KeepEmptyParts)
+                    list.append(source.sliced(start, end - start));
+                start = end + 1;
+            }
+        }
+        if (start != source.size() || behavior == Qt::KeepEmptyParts)
+            list.append(source.sliced(start));
+        return list;
+    }
     while ((end = QtPrivate::findString(QStringView(source.constData(), source.size()), start + extra, sep, cs)) != -1) {
         if (start != end || behavior == Qt::KeepEmptyParts)
             list.append(source.sliced(start, end - start));
@@ -8888,9 +9021,12 @@ struct Part
         : tag{QtPrivate::ArgBase::U16}, number{num}, data{s.utf16()}, size{s.size()} {}
     constexpr Part(QLatin1StringView s, int num = -1)
         : tag{QtPrivate::ArgBase::L1}, number{num}, data{s.data()}, size{s.size()} {}
+    constexpr Part(QByteArrayView utf8, int num = -1)
+        : tag{QtPrivate::ArgBase::U8}, number{num}, data{utf8.data()}, size{utf8.size()} {}
 
     void reset(QStringView s) noexcept { *this = {s, number}; }
     void reset(QLatin1StringView s) noexcept { *this = {s, number}; }
+    void reset(QByteArrayView utf8) noexcept { *this = {utf8, number}; }
 
     QtPrivate::ArgBase::Tag tag;
     int number;
@@ -8956,7 +9092,33 @@ static ArgIndexToPlaceholderMap makeArgIndexToPlaceholderMap(const ParseResult &
     return result;
 }
 
-static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const ArgIndexToPlaceholderMap &argIndexToPlaceholderMap, const QtPrivate::ArgBase *args[])
+// The text of the numeric arguments of QString::format(), by argument index
+struct FormattedNumbers
+{
+    struct Integer { char text[24]; }; // sign and 20 digits
+    QVarLengthArray<Integer, ExpectedParts/2> integers;
+    QVarLengthArray<QString, 4> doubles;
+};
+
+// Formats like QString::number(), but into the caller's buffer
+static QLatin1StringView integerToLatin1(FormattedNumbers::Integer &buffer,
+                                         const QtPrivate::QIntegerArg &arg) noexcept
+{
+    char *const end = std::end(buffer.text);
+    char *p = end;
+    const bool negative = arg.tag == QtPrivate::ArgBase::Int && qlonglong(arg.value) < 0;
+    qulonglong value = negative ? 0 - arg.value : arg.value;
+    do {
+        *--p = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (negative)
+        *--p = '-';
+    return QLatin1StringView(p, end - p);
+}
+
+static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const ArgIndexToPlaceholderMap &argIndexToPlaceholderMap,
+                                                     const QtPrivate::ArgBase *args[], FormattedNumbers &numbers)
 {
     using namespace QtPrivate;
     qsizetype totalSize = 0;
@@ -8964,17 +9126,37 @@ static qsizetype resolveStringRefsAndReturnTotalSize(ParseResult &parts, const A
         if (part.number != -1) {
             const auto it = std::find(argIndexToPlaceholderMap.begin(), argIndexToPlaceholderMap.end(), part.number);
             if (it != argIndexToPlaceholderMap.end()) {
-                const auto &arg = *args[it - argIndexToPlaceholderMap.begin()];
+                const qsizetype index = it - argIndexToPlaceholderMap.begin();
+                const auto &arg = *args[index];
                 switch (arg.tag) {
                 case ArgBase::L1:
                     part.reset(static_cast<const QLatin1StringArg&>(arg).string);
                     break;
                 case ArgBase::U8:
-                    Q_UNREACHABLE(); // waiting for QUtf8String...
+                    part.reset(static_cast<const QUtf8StringArg&>(arg).string);
                     break;
                 case ArgBase::U16:
                     part.reset(static_cast<const QStringViewArg&>(arg).string);
                     break;
+                case ArgBase::Char:
+                    part.reset(QStringView(&static_cast<const QCharArg&>(arg).ch, 1));
+                    break;
+                case ArgBase::Int:
+                case ArgBase::UInt:
+                    if (numbers.integers.isEmpty())
+                        numbers.integers.resize(argIndexToPlaceholderMap.size());
+                    part.reset(integerToLatin1(numbers.integers[index],
+                                               static_cast<const QIntegerArg&>(arg)));
+                    break;
+                case ArgBase::Double:
+                    if (numbers.doubles.isEmpty())
+                        numbers.doubles.resize(argIndexToPlaceholderMap.size());
+                    if (numbers.doubles.at(index).isNull()) {
+                        numbers.doubles[index] = QString::number(static_cast<const QDoubleArg&>(arg).value,
+                                                                 'g', QLocale::FloatingPointShortest);
+                    }
+                    part.reset(QStringView(numbers.doubles.at(index)));
+                    break;
                 }
             }
         }
@@ -9004,11 +9186,15 @@ static QString argToQStringImpl(StringView pattern, size_t numArgs, const QtPriv
                  int(numArgs - argIndexToPlaceholderMap.size()), qUtf16Printable(to_string(pattern)));
 
     // 5
-    const qsizetype totalSize = resolveStringRefsAndReturnTotalSize(parts, argIndexToPlaceholderMap, args);
+    FormattedNumbers numbers;
+    const qsizetype totalSize = resolveStringRefsAndReturnTotalSize(parts, argIndexToPlaceholderMap, args, numbers);
 
     // 6:
+    // UTF-8 never takes more UTF-16 code units than it has bytes, so the
+    // result only ever needs to be shrunk afterwards
     QString result(totalSize, Qt::Uninitialized);
     auto out = const_cast<QChar*>(result.constData());
+    bool shrink = false;
 
     for (const Part &part : parts) {
         switch (part.tag) {
@@ -9017,18 +9203,30 @@ static QString argToQStringImpl(StringView pattern, size_t numArgs, const QtPriv
                 qt_from_latin1(reinterpret_cast<char16_t*>(out),
                                reinterpret_cast<const char*>(part.data), part.size);
             }
+            out += part.size;
             break;
-        case QtPrivate::ArgBase::U8:
-            Q_UNREACHABLE(); // waiting for QUtf8String
+        case QtPrivate::ArgBase::U8: {
+            QChar *end = QUtf8::convertToUnicode(out, QByteArrayView(static_cast<const char *>(part.data), part.size));
+            shrink |= end - out != part.size;
+            out = end;
             break;
+        }
         case QtPrivate::ArgBase::U16:
             if (part.size)
                 memcpy(out, part.data, part.size * sizeof(QChar));
+            out += part.size;
+            break;
+        case QtPrivate::ArgBase::Char:
+        case QtPrivate::ArgBase::Int:
+        case QtPrivate::ArgBase::UInt:
+        case QtPrivate::ArgBase::Double:
+            Q_UNREACHABLE(); // resolved to strings in step 5
             break;
         }
-        out += part.size;
     }
 
+    if (shrink)
+        result.truncate(out - result.constData());
     return result;
 }
 
@@ -268,6 +268,11 @@ public:
     arg(Args &&...args) const
     { return qToStringViewIgnoringNull(*this).arg(std::forward<Args>(args)...); }
 
+    template <typename...Args>
+    [[nodiscard]] static QString format(QStringView pattern, const Args &...args);
+    template <typename...Args>
+    [[nodiscard]] static QString format(QLatin1StringView pattern, const Args &...args);
+
     static QString vasprintf(const char *format, va_list ap) Q_ATTRIBUTE_FORMAT_PRINTF(1, 0);
     static QString asprintf(const char *format, ...) Q_ATTRIBUTE_FORMAT_PRINTF(1, 2);
 
@@ -1411,7 +1416,7 @@ inline QString &&asString(QString &&s)              { return std::move(s); }
 namespace QtPrivate {
 
 struct ArgBase {
-    enum Tag : uchar { L1, U8, U16 } tag;
+    enum Tag : uchar { L1, U8, U16, Char, Int, UInt, Double } tag;
 };
 
 struct QStringViewArg : ArgBase {
@@ -1426,6 +1431,31 @@ struct QLatin1StringArg : ArgBase {
     constexpr explicit QLatin1StringArg(QLatin1StringView v) noexcept : ArgBase{L1}, string{v} {}
 };
 
+struct QUtf8StringArg : ArgBase {
+    QByteArrayView string;
+    QUtf8StringArg() = default;
+    constexpr explicit QUtf8StringArg(QByteArrayView v) noexcept : ArgBase{U8}, string{v} {}
+};
+
+struct QCharArg : ArgBase {
+    char16_t ch;
+    QCharArg() = default;
+    constexpr explicit QCharArg(char16_t c) noexcept : ArgBase{Char}, ch{c} {}
+};
+
+struct QIntegerArg : ArgBase {
+    qulonglong value;
+    QIntegerArg() = default;
+    constexpr explicit QIntegerArg(qlonglong v) noexcept : ArgBase{Int}, value{qulonglong(v)} {}
+    constexpr explicit QIntegerArg(qulonglong v) noexcept : ArgBase{UInt}, value{v} {}
+};
+
+struct QDoubleArg : ArgBase {
+    double value;
+    QDoubleArg() = default;
+    constexpr explicit QDoubleArg(double v) noexcept : ArgBase{Double}, value{v} {}
+};
+
 [[nodiscard]] Q_CORE_EXPORT QString argToQString(QStringView pattern, size_t n, const ArgBase **args);
 [[nodiscard]] Q_CORE_EXPORT QString argToQString(QLatin1StringView pattern, size_t n, const ArgBase **args);
 
@@ -1441,6 +1471,37 @@ constexpr inline QStringViewArg   qStringLikeToArg(QStringView s) noexcept { ret
           inline QStringViewArg   qStringLikeToArg(const QChar &c) noexcept { return QStringViewArg{QStringView{&c, 1}}; }
 constexpr inline QLatin1StringArg qStringLikeToArg(QLatin1StringView s) noexcept { return QLatin1StringArg{s}; }
 
+// The arguments of QString::format(); byte arrays are UTF-8
+template <typename T>
+constexpr auto qFormatArg(const T &value) noexcept
+{
+    if constexpr (std::is_same_v<T, char>) {
+        return QCharArg{char16_t(uchar(value))};
+    } else if constexpr (std::is_same_v<T, QChar> || std::is_same_v<T, QLatin1Char>
+                         || std::is_same_v<T, char16_t>) {
+        return QCharArg{QChar(value).unicode()};
+    } else if constexpr (std::is_same_v<T, QLatin1StringView>) {
+        return QLatin1StringArg{value};
+    } else if constexpr (std::is_same_v<T, QString>) {
+        return QStringViewArg{qToStringViewIgnoringNull(value)};
+    } else if constexpr (std::is_convertible_v<const T &, QStringView>) {
+        return QStringViewArg{QStringView(value)};
+    } else if constexpr (std::is_convertible_v<const T &, QByteArrayView>) {
+        return QUtf8StringArg{QByteArrayView(value)};
+    } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        if constexpr (std::is_signed_v<T>)
+            return QIntegerArg{qlonglong(value)};
+        else
+            return QIntegerArg{qulonglong(value)};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return QDoubleArg{double(value)};
+    } else {
+        static_assert(QtPrivate::type_dependent_false<T>::value,
+                      "QString::format() does not support arguments of this type");
+        return QStringViewArg{};
+    }
+}
+
 } // namespace QtPrivate
 
 template <typename...Args>
@@ -1457,6 +1518,20 @@ QString QLatin1StringView::arg(Args &&...args) const
     return QtPrivate::argToQStringDispatch(*this, QtPrivate::qStringLikeToArg(args)...);
 }
 
+template <typename...Args>
+Q_ALWAYS_INLINE
+QString QString::format(QStringView pattern, const Args &...args)
+{
+    return QtPrivate::argToQStringDispatch(pattern, QtPrivate::qFormatArg(args)...);
+}
+
+template <typename...Args>
+Q_ALWAYS_INLINE
+QString QString::format(QLatin1StringView pattern, const Args &...args)
+{
+    return QtPrivate::argToQStringDispatch(pattern, QtPrivate::qFormatArg(args)...);
+}
+
 template <typename T>
 qsizetype erase(QString &s, const T &t)
 {
@@ -463,6 +463,235 @@ static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t
 }
 #endif
 
+#if defined(__SSE2__)
+// Fast paths for runs of non-ASCII characters whose UTF-8 sequences all have
+// the same length, as in Cyrillic, Greek or Arabic (two bytes), CJK (three
+// bytes) or emoji (four bytes) text. Each one converts the longest prefix of
+// a block whose characters are all valid and of that length, and leaves
+// anything else, including invalid sequences, to the scalar code. They may
+// store past the converted characters, but never past where the stateless
+// worst case lets the caller's buffer end.
+
+// Returns the number of leading lanes of \a lanes bytes each that are set in
+// the byte mask \a valid.
+static Q_ALWAYS_INLINE qsizetype simdValidLanes(uint valid, int lanes, int laneSize)
+{
+    return qMin<qsizetype>(qCountTrailingZeroBits(~valid) / laneSize, lanes);
+}
+
+static inline qsizetype simdDecodeUtf8TwoByte(char16_t *dst, const uchar *src)
+{
+    // lanes of 0b10xx'xxxx'110y'yyyy, with a lead byte of at least 0xc2
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i pattern = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xc0e0))),
+                                            _mm_set1_epi16(short(0x80c0)));
+    const __m128i overlong = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1e)),
+                                             _mm_setzero_si128());
+    const uint valid = _mm_movemask_epi8(_mm_andnot_si128(overlong, pattern));
+    const qsizetype n = simdValidLanes(valid, 8, 2);
+    if (n) {
+        const __m128i high = _mm_slli_epi16(_mm_and_si128(data, _mm_set1_epi16(0x1f)), 6);
+        const __m128i low = _mm_and_si128(_mm_srli_epi16(data, 8), _mm_set1_epi16(0x3f));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(high, low));
+    }
+    return n;
+}
+
+static inline qsizetype simdDecodeUtf8FourByte(char16_t *dst, const uchar *src)
+{
+    // lanes of 0b10xx'xxxx'10xx'xxxx'10xx'xxxx'1111'0xxx, U+10000 to U+10FFFF
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i pattern = _mm_cmpeq_epi32(_mm_and_si128(data, _mm_set1_epi32(int(0xc0c0c0f8))),
+                                            _mm_set1_epi32(int(0x808080f0)));
+    const __m128i mask = _mm_set1_epi32(0x3f);
+    __m128i ucs4 = _mm_slli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x07)), 18);
+    ucs4 = _mm_or_si128(ucs4, _mm_and_si128(_mm_slli_epi32(data, 4), _mm_slli_epi32(mask, 12)));
+    ucs4 = _mm_or_si128(ucs4, _mm_and_si128(_mm_srli_epi32(data, 10), _mm_slli_epi32(mask, 6)));
+    ucs4 = _mm_or_si128(ucs4, _mm_and_si128(_mm_srli_epi32(data, 24), mask));
+    const __m128i offset = _mm_sub_epi32(ucs4, _mm_set1_epi32(0x10000));
+    const __m128i inRange = _mm_cmpeq_epi32(_mm_srli_epi32(offset, 20), _mm_setzero_si128());
+    const uint valid = _mm_movemask_epi8(_mm_and_si128(pattern, inRange));
+    const qsizetype n = simdValidLanes(valid, 4, 4);
+    if (n) {
+        const __m128i high = _mm_or_si128(_mm_srli_epi32(offset, 10), _mm_set1_epi32(0xd800));
+        const __m128i low = _mm_or_si128(_mm_and_si128(offset, _mm_set1_epi32(0x3ff)),
+                                         _mm_set1_epi32(0xdc00));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(high, _mm_slli_epi32(low, 16)));
+    }
+    return n;
+}
+
+static inline qsizetype simdEncodeUtf8TwoByte(uchar *dst, const char16_t *src)
+{
+    // U+0080 to U+07FF
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i fits = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))), zero);
+    const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))), zero);
+    const uint valid = _mm_movemask_epi8(_mm_andnot_si128(ascii, fits));
+    const qsizetype n = simdValidLanes(valid, 8, 2);
+    if (n) {
+        const __m128i lead = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+        const __m128i trail = _mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)),
+                                           _mm_set1_epi16(0x80));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(lead, _mm_slli_epi16(trail, 8)));
+    }
+    return n;
+}
+
+static inline qsizetype simdEncodeUtf8FourByte(uchar *dst, const char16_t *src)
+{
+    // lanes of a high surrogate followed by a low one
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i pattern = _mm_cmpeq_epi32(_mm_and_si128(data, _mm_set1_epi32(int(0xfc00fc00))),
+                                            _mm_set1_epi32(int(0xdc00d800)));
+    const uint valid = _mm_movemask_epi8(pattern);
+    const qsizetype n = simdValidLanes(valid, 4, 4);
+    if (n) {
+        const __m128i mask = _mm_set1_epi32(0x3f);
+        __m128i ucs4 = _mm_slli_epi32(_mm_and_si128(data, _mm_set1_epi32(0x3ff)), 10);
+        ucs4 = _mm_or_si128(ucs4, _mm_and_si128(_mm_srli_epi32(data, 16), _mm_set1_epi32(0x3ff)));
+        ucs4 = _mm_add_epi32(ucs4, _mm_set1_epi32(0x10000));
+        __m128i utf8 = _mm_or_si128(_mm_srli_epi32(ucs4, 18), _mm_set1_epi32(0x808080f0));
+        utf8 = _mm_or_si128(utf8, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(ucs4, 12), mask), 8));
+        utf8 = _mm_or_si128(utf8, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(ucs4, 6), mask), 16));
+        utf8 = _mm_or_si128(utf8, _mm_slli_epi32(_mm_and_si128(ucs4, mask), 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), utf8);
+    }
+    return n;
+}
+
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+// Three-byte sequences need PSHUFB to move between 3- and 2-byte strides.
+static qsizetype QT_FUNCTION_TARGET(SSSE3) simdDecodeUtf8ThreeByte(char16_t *dst, const uchar *src)
+{
+    // five sequences of 0b1110'xxxx 0b10xx'xxxx 0b10xx'xxxx in the first 15 bytes
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i mask = _mm_setr_epi8(char(0xf0), char(0xc0), char(0xc0), char(0xf0),
+                                       char(0xc0), char(0xc0), char(0xf0), char(0xc0),
+                                       char(0xc0), char(0xf0), char(0xc0), char(0xc0),
+                                       char(0xf0), char(0xc0), char(0xc0), 0);
+    const __m128i pattern = _mm_setr_epi8(char(0xe0), char(0x80), char(0x80), char(0xe0),
+                                          char(0x80), char(0x80), char(0xe0), char(0x80),
+                                          char(0x80), char(0xe0), char(0x80), char(0x80),
+                                          char(0xe0), char(0x80), char(0x80), 0);
+    uint bytes = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(data, mask), pattern));
+    bytes &= bytes >> 1;
+    bytes &= bytes >> 1;    // bit 3 * i: all three bytes of sequence i match
+
+    // lanes of lead and first continuation byte, and of the second one
+    const __m128i leads = _mm_shuffle_epi8(data, _mm_setr_epi8(1, 0, 4, 3, 7, 6, 10, 9, 13, 12,
+                                                               -1, -1, -1, -1, -1, -1));
+    const __m128i trails = _mm_shuffle_epi8(data, _mm_setr_epi8(2, -1, 5, -1, 8, -1, 11, -1, 14, -1,
+                                                                -1, -1, -1, -1, -1, -1));
+    __m128i utf16 = _mm_slli_epi16(_mm_and_si128(leads, _mm_set1_epi16(0x0f00)), 4);
+    utf16 = _mm_or_si128(utf16, _mm_slli_epi16(_mm_and_si128(leads, _mm_set1_epi16(0x3f)), 6));
+    utf16 = _mm_or_si128(utf16, _mm_and_si128(trails, _mm_set1_epi16(0x3f)));
+
+    // neither overlong nor a surrogate
+    const __m128i top = _mm_and_si128(utf16, _mm_set1_epi16(short(0xf800)));
+    const __m128i invalid = _mm_or_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()),
+                                         _mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800))));
+    const uint values = ~_mm_movemask_epi8(invalid);
+
+    qsizetype n = 0;
+    while (n < 5 && (bytes >> (3 * n) & 1) && (values >> (2 * n) & 1))
+        ++n;
+    if (n)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), utf16);
+    return n;
+}
+
+static qsizetype QT_FUNCTION_TARGET(SSSE3) simdEncodeUtf8ThreeByte(uchar *dst, const char16_t *src)
+{
+    // U+0800 to U+FFFF, except for surrogates
+    const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i top = _mm_and_si128(data, _mm_set1_epi16(short(0xf800)));
+    const __m128i invalid = _mm_or_si128(_mm_cmpeq_epi16(top, _mm_setzero_si128()),
+                                         _mm_cmpeq_epi16(top, _mm_set1_epi16(short(0xd800))));
+    const uint valid = ~_mm_movemask_epi8(invalid) & 0xffff;
+    const qsizetype n = simdValidLanes(valid, 8, 2);
+    if (n) {
+        const __m128i mask = _mm_set1_epi16(0x3f);
+        const __m128i trail = _mm_set1_epi16(0x80);
+        __m128i leads = _mm_or_si128(_mm_srli_epi16(data, 12), _mm_set1_epi16(0xe0));
+        leads = _mm_or_si128(leads, _mm_slli_epi16(_mm_or_si128(_mm_and_si128(_mm_srli_epi16(data, 6), mask), trail), 8));
+        const __m128i trails = _mm_or_si128(_mm_and_si128(data, mask), trail);
+
+        // pack the four byte lanes of each character into three bytes
+        const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                         _mm_shuffle_epi8(_mm_unpacklo_epi16(leads, trails), pack));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 12),
+                         _mm_shuffle_epi8(_mm_unpackhi_epi16(leads, trails), pack));
+    }
+    return n;
+}
+#  endif
+
+static inline bool simdDecodeNonAscii(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    if (end - src < 16)
+        return false;
+    const uchar b = *src;
+    qsizetype n = 0;
+    if ((b & 0xe0) == 0xc0) {
+        n = simdDecodeUtf8TwoByte(dst, src);
+        dst += n;
+        src += 2 * n;
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    } else if ((b & 0xf0) == 0xe0) {
+        if (qCpuHasFeature(SSSE3)) {
+            n = simdDecodeUtf8ThreeByte(dst, src);
+            dst += n;
+            src += 3 * n;
+        }
+#  endif
+    } else if ((b & 0xf8) == 0xf0) {
+        n = simdDecodeUtf8FourByte(dst, src);
+        dst += 2 * n;
+        src += 4 * n;
+    }
+    return n;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    if (end - src < 16)
+        return false;
+    const char16_t u = *src;
+    qsizetype n = 0;
+    if (u < 0x80) {
+        return false;
+    } else if (u < 0x800) {
+        n = simdEncodeUtf8TwoByte(dst, src);
+        dst += 2 * n;
+        src += n;
+    } else if (QChar::isHighSurrogate(u)) {
+        n = simdEncodeUtf8FourByte(dst, src);
+        dst += 4 * n;
+        src += 2 * n;
+#  if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    } else if (qCpuHasFeature(SSSE3)) {
+        n = simdEncodeUtf8ThreeByte(dst, src);
+        dst += 3 * n;
+        src += n;
+#  endif
+    }
+    return n;
+}
+#else
+static inline bool simdDecodeNonAscii(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static inline bool simdEncodeNonAscii(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -481,6 +710,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
             break;
 
         do {
+            if (simdEncodeNonAscii(dst, src, end))
+                continue;
             char16_t u = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end);
             if (res < 0) {
@@ -547,6 +778,8 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
             break;
 
         do {
+            if (simdEncodeNonAscii(cursor, src, end))
+                continue;
             char16_t uc = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
             if (Q_LIKELY(res >= 0))
@@ -650,6 +883,8 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in) noexcept
                 break;
 
             do {
+                if (simdDecodeNonAscii(dst, src, end))
+                    continue;
                 uchar b = *src++;
                 const qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
                 if (res < 0) {
@@ -751,6 +986,8 @@ char16_t *QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, QStringConve
     while (res >= 0 && src < end) {
         if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdDecodeNonAscii(dst, src, end))
+            continue;
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -4,6 +4,10 @@
 
 #include "qstringmatcher.h"
 
+#include <private/qahocorasick_p.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static constexpr qsizetype FoldBufferCapacity = 256;
@@ -306,6 +310,266 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
     \sa setCaseSensitivity()
 */
 
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.7
+    \brief The QMultiStringMatcher class finds any of a set of strings in a
+    Unicode string in a single pass.
+
+    \ingroup tools
+    \ingroup string-processing
+    \ingroup shared
+
+    Searching a string for many patterns with one QStringMatcher per pattern
+    takes one pass over the string for each of them. QMultiStringMatcher
+    prepares all patterns together, as an Aho-Corasick automaton, and then
+    finds every match of any of them in one pass, however many patterns there
+    are.
+
+    Create the QMultiStringMatcher with the list of patterns, then call
+    indexIn() for the first match, or matches() for all of them. Matches are
+    reported with the position they start at and the index of the pattern in
+    the list returned by patterns().
+
+    When searching case-insensitively, each UTF-16 code unit is compared by
+    its case folding (see QChar::toCaseFolded()).
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \since 6.7
+
+    \brief The Match struct describes an occurrence of one of the patterns
+    of a QMultiStringMatcher.
+
+    \sa QMultiStringMatcher::matches()
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::position
+
+    The position in the searched string at which the match starts.
+*/
+
+/*!
+    \variable QMultiStringMatcher::Match::patternIndex
+
+    The index of the pattern that matched in QMultiStringMatcher::patterns().
+*/
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QList<QString> &patterns, Qt::CaseSensitivity cs);
+
+    char16_t fold(char16_t c) const noexcept
+    {
+        return cs == Qt::CaseSensitive ? c : char16_t(QChar::toCaseFolded(c));
+    }
+
+    QList<QString> patterns;
+    QList<qsizetype> emptyPatterns;
+    QtPrivate::QAhoCorasick<char16_t> automaton;
+    Qt::CaseSensitivity cs;
+};
+
+QMultiStringMatcherPrivate::QMultiStringMatcherPrivate(const QList<QString> &patterns,
+                                                       Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    QList<QtPrivate::QAhoCorasick<char16_t>::Pattern> units;
+    units.reserve(patterns.size());
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        if (pattern.isEmpty())
+            emptyPatterns.append(i);
+        auto &folded = units.emplace_back();
+        folded.reserve(pattern.size());
+        for (QChar c : pattern)
+            folded.append(fold(c.unicode()));
+    }
+    automaton = QtPrivate::QAhoCorasick<char16_t>(units);
+}
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher()
+
+    Constructs a matcher without patterns, which does not match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+
+/*!
+    Constructs a matcher that searches for any of \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QList<QString> &patterns, Qt::CaseSensitivity cs)
+    : q_cs(cs)
+{
+    setPatterns(patterns);
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+
+    \note The moved-from object \a other can only be destroyed or assigned
+    to.
+*/
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) noexcept = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps this matcher with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    An empty pattern matches at every position, including the end of the
+    searched string.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setPatterns(const QList<QString> &patterns)
+{
+    d.reset(patterns.isEmpty() ? nullptr : new QMultiStringMatcherPrivate(patterns, q_cs));
+}
+
+/*!
+    Returns the patterns that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QList<QString> QMultiStringMatcher::patterns() const
+{
+    return d ? d->patterns : QList<QString>();
+}
+
+/*!
+    Sets the case sensitivity of the search to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs == q_cs)
+        return;
+    q_cs = cs;
+    if (d)
+        setPatterns(d->patterns);
+}
+
+/*!
+    \fn Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+
+    Returns the case sensitivity of the search.
+
+    \sa setCaseSensitivity()
+*/
+
+/*!
+    Searches the string \a str, from character position \a from (default 0,
+    i.e. from the first character), for any of the patterns. Returns the
+    position of the first match in \a str, or -1 if no match was found.
+
+    If \a patternIndex is not \nullptr, the index of the pattern that matched
+    is stored in it. If more than one pattern matches at that position, it is
+    the lowest index among them.
+
+    \sa matches()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from,
+                                       qsizetype *patternIndex) const
+{
+    if (from < 0)
+        from = 0;
+    std::pair<qsizetype, qsizetype> best(-1, -1);
+    if (d && from <= str.size()) {
+        best = d->automaton.firstMatch(str.utf16(), from, str.size(),
+                                       [this](char16_t c) { return d->fold(c); });
+        // an empty pattern matches right away
+        if (!d->emptyPatterns.isEmpty()) {
+            const qsizetype empty = d->emptyPatterns.first();
+            if (best.first != from || empty < best.second)
+                best = { from, empty };
+        }
+    }
+    if (patternIndex)
+        *patternIndex = best.second;
+    return best.first;
+}
+
+/*!
+    Searches the string \a str, from character position \a from (default 0,
+    i.e. from the first character), for all occurrences of any of the
+    patterns, and returns them ordered by position, and then by pattern
+    index.
+
+    Overlapping matches are all reported, as are matches of different
+    patterns at the same position.
+
+    \sa indexIn()
+*/
+QList<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView str,
+                                                               qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+    QList<Match> result;
+    if (!d || from > str.size())
+        return result;
+
+    // the automaton reports matches by the position they end at
+    d->automaton.forEachMatch(str.utf16(), from, str.size(),
+                              [this](char16_t c) { return d->fold(c); },
+                              [&result](qsizetype position, qsizetype pattern) {
+        result.append({ position, pattern });
+        return true;
+    });
+    if (!d->emptyPatterns.isEmpty()) {
+        for (qsizetype position = from; position <= str.size(); ++position) {
+            for (qsizetype pattern : std::as_const(d->emptyPatterns))
+                result.append({ position, pattern });
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const Match &lhs, const Match &rhs) {
+        return lhs.position < rhs.position
+                || (lhs.position == rhs.position && lhs.patternIndex < rhs.patternIndex);
+    });
+    return result;
+}
+
 /*!
     \internal
 */
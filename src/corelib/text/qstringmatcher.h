@@ -5,6 +5,8 @@
 #ifndef QSTRINGMATCHER_H
 #define QSTRINGMATCHER_H
 
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
 
@@ -50,6 +52,54 @@ private:
     uchar q_skiptable[256] = {};
 };
 
+class QMultiStringMatcherPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QMultiStringMatcherPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position;
+        qsizetype patternIndex;
+
+        friend bool operator==(const Match &lhs, const Match &rhs) noexcept
+        { return lhs.position == rhs.position && lhs.patternIndex == rhs.patternIndex; }
+        friend bool operator!=(const Match &lhs, const Match &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    QMultiStringMatcher() noexcept = default;
+    explicit QMultiStringMatcher(const QList<QString> &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other) noexcept;
+    QMultiStringMatcher(QMultiStringMatcher &&other) noexcept = default;
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other) noexcept;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QMultiStringMatcher)
+    ~QMultiStringMatcher();
+
+    void swap(QMultiStringMatcher &other) noexcept
+    {
+        d.swap(other.d);
+        std::swap(q_cs, other.q_cs);
+    }
+
+    void setPatterns(const QList<QString> &patterns);
+    QList<QString> patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const noexcept { return q_cs; }
+
+    qsizetype indexIn(QStringView str, qsizetype from = 0,
+                      qsizetype *patternIndex = nullptr) const;
+    QList<Match> matches(QStringView str, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+    Qt::CaseSensitivity q_cs = Qt::CaseSensitive;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+
 QT_END_NAMESPACE
 
 #endif // QSTRINGMATCHER_H
@@ -21,6 +21,11 @@ protected:
 
     struct tokenizer_state {
         qsizetype start, end, extra;
+        // For single-character needles: the positions of the needle in
+        // [window, window + 64), found by a single scan. Not part of the
+        // state proper, so not compared.
+        qsizetype window = -1;
+        quint64 separators = 0;
         friend constexpr bool operator==(tokenizer_state lhs, tokenizer_state rhs) noexcept
         { return lhs.start == rhs.start && lhs.end == rhs.end && lhs.extra == rhs.extra; }
         friend constexpr bool operator!=(tokenizer_state lhs, tokenizer_state rhs) noexcept
@@ -40,6 +45,8 @@ class QStringTokenizerBase : protected QStringTokenizerBaseBase
         tokenizer_state state;
     };
     inline next_result next(tokenizer_state state) const noexcept;
+    inline qsizetype findSeparator(tokenizer_state &state) const noexcept;
+    qsizetype scanSeparators(tokenizer_state &state, qsizetype from) const noexcept;
     inline next_result toFront() const noexcept { return next({}); }
 public:
     constexpr explicit QStringTokenizerBase(Haystack haystack, Needle needle, Qt::SplitBehavior sb, Qt::CaseSensitivity cs) noexcept
@@ -120,6 +127,7 @@ private:
 };
 
 QT_BEGIN_INCLUDE_NAMESPACE
+#include <QtCore/qalgorithms.h>
 #include <QtCore/qstringview.h>
 QT_END_INCLUDE_NAMESPACE
 
@@ -127,6 +135,15 @@ namespace QtPrivate {
 namespace Tok {
 
     constexpr qsizetype size(QChar) noexcept { return 1; }
+
+    // Whether case-insensitive matching of ch can match other characters.
+    // Only US-ASCII non-letters are known not to; no other character folds
+    // to them.
+    constexpr bool isCaseSensitive(QChar ch) noexcept
+    {
+        const char16_t c = ch.unicode();
+        return c >= 0x80 || (c >= u'A' && c <= u'Z') || (c >= u'a' && c <= u'z');
+    }
     template <typename String>
     constexpr qsizetype size(const String &s) noexcept { return static_cast<qsizetype>(s.size()); }
 
@@ -394,7 +411,7 @@ auto QStringTokenizerBase<Haystack, Needle>::next(tokenizer_state state) const n
             // already at end:
             return {{}, false, state};
         }
-        state.end = m_haystack.indexOf(m_needle, state.start + state.extra, m_cs);
+        state.end = findSeparator(state);
         Haystack result;
         if (state.end >= 0) {
             // token separator found => return intermediate element:
@@ -412,6 +429,48 @@ auto QStringTokenizerBase<Haystack, Needle>::next(tokenizer_state state) const n
     }
 }
 
+template <typename Haystack, typename Needle>
+qsizetype QStringTokenizerBase<Haystack, Needle>::findSeparator(tokenizer_state &state) const noexcept
+{
+    const qsizetype from = state.start + state.extra;
+    if constexpr (std::is_same_v<Haystack, QStringView> && std::is_same_v<Needle, QChar>) {
+        // the next separator may already be known from the last scan (if
+        // there was none, window is -1 and separators is 0)
+        const std::size_t offset = std::size_t(from - state.window);
+        if (offset < 64) {
+            const quint64 separators = state.separators & (~quint64(0) << offset);
+            if (separators)
+                return state.window + qCountTrailingZeroBits(separators);
+        }
+        return scanSeparators(state, from);
+    } else {
+        return m_haystack.indexOf(m_needle, from, m_cs);
+    }
+}
+
+template <typename Haystack, typename Needle>
+Q_NEVER_INLINE qsizetype
+QStringTokenizerBase<Haystack, Needle>::scanSeparators(tokenizer_state &state, qsizetype from) const noexcept
+{
+    if (m_cs == Qt::CaseInsensitive && QtPrivate::Tok::isCaseSensitive(m_needle))
+        return m_haystack.indexOf(m_needle, from, m_cs);
+
+    // Scan 64 characters at a time and remember where the needle occurs,
+    // so that findSeparator() can find the following ones without a scan.
+    const qsizetype size = m_haystack.size();
+    if (state.window >= 0 && std::size_t(from - state.window) < 64)
+        from = state.window + 64; // nothing left in the current window
+    for ( ; from < size; from += 64) {
+        state.window = from;
+        state.separators = QtPrivate::qustrchrMask(
+                    m_haystack.sliced(from, (std::min)(size - from, qsizetype(64))),
+                    m_needle.unicode());
+        if (state.separators)
+            return from + qCountTrailingZeroBits(state.separators);
+    }
+    return -1;
+}
+
 QT_END_NAMESPACE
 
 #endif /* QSTRINGTOKENIZER_H */
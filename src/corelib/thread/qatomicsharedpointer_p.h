@@ -0,0 +1,78 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QATOMICSHAREDPOINTER_P_H
+#define QATOMICSHAREDPOINTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qreadmostlylock_p.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <mutex>
+#include <shared_mutex>
+
+QT_BEGIN_NAMESPACE
+
+// Publishes immutable snapshots of some data to many readers, RCU style: a
+// writer builds a new T and stores it, readers either use the current one
+// in place with read() or keep it alive with load(). The pointer is guarded
+// by a QReadMostlyLock, so readers on different cores don't contend, and
+// store() waits for readers of the previous snapshot before dropping its
+// reference; the snapshot itself is freed when its last QSharedPointer goes.
+template <typename T>
+class QAtomicSharedPointer
+{
+public:
+    QAtomicSharedPointer() = default;
+    explicit QAtomicSharedPointer(QSharedPointer<const T> value) noexcept
+        : current(std::move(value))
+    {}
+    Q_DISABLE_COPY_MOVE(QAtomicSharedPointer)
+
+    [[nodiscard]] QSharedPointer<const T> load() const
+    {
+        const std::shared_lock locker(lock);
+        return current;
+    }
+
+    // Calls f with the current snapshot, or nullptr, without touching its
+    // reference count. f must not call store() or exchange() on this object.
+    template <typename Function>
+    decltype(auto) read(Function f) const
+    {
+        const std::shared_lock locker(lock);
+        return f(current.get());
+    }
+
+    void store(QSharedPointer<const T> value)
+    {
+        // the old snapshot, if we held the last reference, is deleted here,
+        // after the lock was released
+        value = exchange(std::move(value));
+    }
+
+    [[nodiscard]] QSharedPointer<const T> exchange(QSharedPointer<const T> value)
+    {
+        const std::unique_lock locker(lock);
+        current.swap(value);
+        return value;
+    }
+
+private:
+    mutable QReadMostlyLock lock;
+    QSharedPointer<const T> current;
+};
+
+QT_END_NAMESPACE
+
+#endif // QATOMICSHAREDPOINTER_P_H
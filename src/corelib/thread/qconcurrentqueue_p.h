@@ -0,0 +1,181 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCONCURRENTQUEUE_P_H
+#define QCONCURRENTQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qsemaphore.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+// A bounded queue for passing values between any number of producer and
+// consumer threads. The values are kept in a ring of cells, each with a
+// sequence number telling whether it is free for the producer or holds a
+// value for the consumer of a given round (Dmitry Vyukov's bounded MPMC
+// queue), so producers and consumers don't need a mutex. Two semaphores
+// count the free and the used cells to let push() and pop() block.
+//
+// A consumer running an event loop can set a ready handler instead of
+// blocking: it is called in the context object's thread when values
+// became available, once for any number of values pushed until it runs,
+// and must then pop until tryPop() returns nothing.
+template <typename T>
+class QConcurrentQueue
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit QConcurrentQueue(qsizetype capacity)
+        : mask(qNextPowerOfTwo(quint64(qMax(capacity, qsizetype(2)) - 1)) - 1),
+          cells(new Cell[mask + 1]),
+          freeCells(int(mask + 1))
+    {
+        for (size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    ~QConcurrentQueue()
+    {
+        while (tryPop())
+            ;
+    }
+    Q_DISABLE_COPY_MOVE(QConcurrentQueue)
+
+    qsizetype capacity() const noexcept { return qsizetype(mask + 1); }
+
+    // Sets the function to call in context's thread when values become
+    // available. Must be called before any value is pushed; context and
+    // the queue must outlive the events posted to context.
+    template <typename Functor>
+    void setReadyHandler(QObject *context, Functor handler)
+    {
+        readyContext = context;
+        readyHandler = std::move(handler);
+    }
+
+    void push(T value)
+    {
+        freeCells.acquire();
+        enqueue(std::move(value));
+    }
+    bool tryPush(T value)
+    {
+        if (!freeCells.tryAcquire())
+            return false;
+        enqueue(std::move(value));
+        return true;
+    }
+
+    T pop()
+    {
+        usedCells.acquire();
+        return dequeue();
+    }
+    std::optional<T> tryPop()
+    {
+        if (!usedCells.tryAcquire())
+            return std::nullopt;
+        return dequeue();
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // The semaphores guarantee that a cell is reserved for us, but its
+    // previous consumer (or producer) may still be busy with it
+    void enqueue(T &&value)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = qptrdiff(sequence) - qptrdiff(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                qYieldCpu();
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        usedCells.release();
+
+        if (readyContext && !readyPending.exchange(true, std::memory_order_acq_rel)) {
+            QMetaObject::invokeMethod(readyContext, [this] {
+                readyPending.store(false, std::memory_order_release);
+                readyHandler();
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    T dequeue()
+    {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = qptrdiff(sequence) - qptrdiff(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                qYieldCpu();
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T *stored = std::launder(reinterpret_cast<T *>(cell->storage));
+        T value = std::move(*stored);
+        stored->~T();
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        freeCells.release();
+        return value;
+    }
+
+    const size_t mask;
+    const std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos = 0;
+    alignas(64) std::atomic<size_t> dequeuePos = 0;
+    QSemaphore freeCells;
+    QSemaphore usedCells;
+
+    QObject *readyContext = nullptr;
+    std::function<void()> readyHandler;
+    std::atomic<bool> readyPending = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTQUEUE_P_H
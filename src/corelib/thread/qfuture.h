@@ -14,6 +14,10 @@
 
 #include <type_traits>
 
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
+
 QT_REQUIRE_CONFIG(future);
 
 QT_BEGIN_NAMESPACE
@@ -537,6 +541,51 @@ static QFuture<T> makeReadyFuture()
 
 } // namespace QtFuture
 
+#if defined(__cpp_lib_coroutine) || defined(Q_QDOC)
+
+namespace QtPrivate {
+
+template <typename T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(QFuture<T> &&f) : future(std::move(f)) { }
+
+    bool await_ready() const { return future.isFinished(); }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // Resume in the thread that finishes the future, whether it
+        // succeeds, fails or is canceled. This object may be gone by the
+        // time then() returns.
+        future.then(QtFuture::Launch::Sync, [handle](const QFuture<T> &) { handle.resume(); })
+              .onCanceled([handle] { handle.resume(); });
+    }
+
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+            future.waitForFinished();
+        else if constexpr (std::is_copy_constructible_v<T>)
+            return future.result();
+        else
+            return future.takeResult();
+    }
+
+private:
+    QFuture<T> future;
+};
+
+} // namespace QtPrivate
+
+template <typename T>
+auto operator co_await(QFuture<T> future)
+{
+    return QtPrivate::FutureAwaiter<T>(std::move(future));
+}
+
+#endif // __cpp_lib_coroutine
+
 Q_DECLARE_SEQUENTIAL_ITERATOR(Future)
 
 QT_END_NAMESPACE
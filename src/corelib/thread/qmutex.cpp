@@ -12,6 +12,9 @@
 #include "qfutex_p.h"
 #include "qthread.h"
 #include "qmutex_p.h"
+#include <private/qsimd_p.h>
+#include <private/qtrace_p.h>
+#include <qtcore_tracepoints_p.h>
 
 #ifndef QT_ALWAYS_USE_FUTEX
 #include "private/qfreelist_p.h"
@@ -25,6 +28,23 @@ static inline QMutexPrivate *dummyFutexValue()
     return reinterpret_cast<QMutexPrivate *>(quintptr(3));
 }
 
+Q_TRACE_POINT(qtcore, QMutex_lock_contended_entry, const void *mutex);
+Q_TRACE_POINT(qtcore, QMutex_lock_contended_exit, const void *mutex);
+
+// How many times lockInternal() checks a contended mutex before sleeping on
+// the futex. Like glibc's adaptive mutexes, it follows a moving average of
+// how many checks it took to get a mutex recently, so that locks held for
+// a few instructions are taken without a syscall while long-held ones don't
+// waste CPU time. QBasicMutex has no room for it, so it is kept per thread.
+static constexpr int MaxMutexSpinCount = 100;
+Q_CONSTINIT static thread_local int mutexSpinEstimate = 10;
+
+static bool isMultiProcessor() noexcept
+{
+    static const bool multi = QThread::idealThreadCount() > 1;
+    return multi;
+}
+
 /*
     \class QBasicMutex
     \inmodule QtCore
@@ -641,6 +661,27 @@ void QRecursiveMutex::unlock() noexcept
 void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
 {
     if (futexAvailable()) {
+        // Spin for a while if the owner may be about to unlock: that is only
+        // worth it while nobody is waiting yet (otherwise we'd be jumping
+        // the queue) and if the owner can run at the same time as we do.
+        if (isMultiProcessor()) {
+            const int maxSpins = qMin(2 * mutexSpinEstimate + 10, MaxMutexSpinCount);
+            int spins = 0;
+            for (; spins < maxSpins; ++spins) {
+                QMutexPrivate *current = d_ptr.loadRelaxed();
+                if (current == dummyFutexValue())
+                    break;
+                if (!current && d_ptr.testAndSetAcquire(nullptr, dummyLocked())) {
+                    mutexSpinEstimate += (spins - mutexSpinEstimate) / 8;
+                    return;
+                }
+                qYieldCpu();
+            }
+            mutexSpinEstimate += (spins - mutexSpinEstimate) / 8;
+        }
+
+        Q_TRACE(QMutex_lock_contended_entry, this);
+
         // note we must set to dummyFutexValue because there could be other threads
         // also waiting
         while (d_ptr.fetchAndStoreAcquire(dummyFutexValue()) != nullptr) {
@@ -650,6 +691,7 @@ void QBasicMutex::lockInternal() QT_MUTEX_LOCK_NOEXCEPT
             // we got woken up, so try to acquire the mutex
         }
         Q_ASSERT(d_ptr.loadRelaxed());
+        Q_TRACE(QMutex_lock_contended_exit, this);
     } else {
         lockInternal(-1);
     }
@@ -0,0 +1,64 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qreadmostlylock_p.h"
+
+#include <private/qsimd_p.h>
+
+#include <thread>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    Returns the reader counter the calling thread uses. Threads are given
+    consecutive counters in the order they first take a read lock, so that
+    up to StripeCount of them never share one.
+*/
+int QReadMostlyLock::stripeIndex() noexcept
+{
+    Q_CONSTINIT static std::atomic<int> nextIndex = 0;
+    Q_CONSTINIT static thread_local int index = -1;
+    if (Q_UNLIKELY(index < 0))
+        index = nextIndex.fetch_add(1, std::memory_order_relaxed) % StripeCount;
+    return index;
+}
+
+/*!
+    \internal
+    Called by lock_shared() after it incremented \a readers and found a
+    writer active: backs off so that the writer can proceed and waits for it
+    to finish.
+*/
+void QReadMostlyLock::lockSharedSlowPath(std::atomic<int> &readers) noexcept
+{
+    do {
+        readers.fetch_sub(1, std::memory_order_release);
+        { std::lock_guard locker(writerMutex); }
+        readers.fetch_add(1);
+    } while (writerActive.load());
+}
+
+void QReadMostlyLock::lock() noexcept
+{
+    writerMutex.lock();
+    writerActive.store(true);
+    // Readers hold their lock for a short time, so spin, at first without
+    // even giving up the CPU
+    for (Stripe &stripe : stripes) {
+        for (int spins = 0; stripe.readers.load() != 0; ++spins) {
+            if (spins < 100)
+                qYieldCpu();
+            else
+                std::this_thread::yield();
+        }
+    }
+}
+
+void QReadMostlyLock::unlock() noexcept
+{
+    writerActive.store(false);
+    writerMutex.unlock();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,98 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREADMOSTLYLOCK_P_H
+#define QREADMOSTLYLOCK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the implementation.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#if QT_CONFIG(thread)
+#include <atomic>
+#include <mutex>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#if QT_CONFIG(thread)
+
+// A non-recursive read-write lock for data that is read far more often than
+// it is written, like type registries. Readers only touch a counter that is
+// one of several, each on its own cache line, picked by the calling thread,
+// so they don't contend with readers on other cores. A writer raises a flag
+// that sends new readers to wait on the writer mutex, then waits for all
+// counters to drop to zero: writing is therefore much more expensive than
+// with QReadWriteLock, and so is the lock's size.
+//
+// It meets the SharedMutex requirements, so std::shared_lock and
+// qt_scoped_lock() can be used with it. Like a non-recursive QReadWriteLock,
+// taking a read lock again in a thread that already holds one can deadlock
+// if a writer is waiting.
+class Q_CORE_EXPORT QReadMostlyLock
+{
+public:
+    constexpr QReadMostlyLock() noexcept = default;
+    Q_DISABLE_COPY_MOVE(QReadMostlyLock)
+
+    void lock_shared() noexcept
+    {
+        std::atomic<int> &readers = stripes[stripeIndex()].readers;
+        // sequentially consistent, to pair with the writer's store to
+        // writerActive and its loads of the reader counts
+        readers.fetch_add(1);
+        if (Q_UNLIKELY(writerActive.load()))
+            lockSharedSlowPath(readers);
+    }
+    void unlock_shared() noexcept
+    {
+        stripes[stripeIndex()].readers.fetch_sub(1, std::memory_order_release);
+    }
+
+    void lock() noexcept;
+    void unlock() noexcept;
+
+private:
+    static constexpr int StripeCount = 32;
+
+    static int stripeIndex() noexcept;
+    void lockSharedSlowPath(std::atomic<int> &readers) noexcept;
+
+    struct alignas(64) Stripe
+    {
+        std::atomic<int> readers = 0;
+    };
+
+    Stripe stripes[StripeCount] = {};
+    alignas(64) std::atomic<bool> writerActive = false;
+    std::mutex writerMutex;
+};
+
+#else // !QT_CONFIG(thread)
+
+class QReadMostlyLock
+{
+public:
+    constexpr QReadMostlyLock() noexcept = default;
+    Q_DISABLE_COPY_MOVE(QReadMostlyLock)
+
+    void lock_shared() noexcept {}
+    void unlock_shared() noexcept {}
+    void lock() noexcept {}
+    void unlock() noexcept {}
+};
+
+#endif // QT_CONFIG(thread)
+
+QT_END_NAMESPACE
+
+#endif // QREADMOSTLYLOCK_P_H
@@ -144,6 +144,17 @@ void ResultStoreBase::syncResultCount()
 void ResultStoreBase::insertResultItemIfValid(int index, ResultItem &resultItem)
 {
     if (resultItem.isValid()) {
+        if (m_results.isEmpty() || m_results.lastKey() < index) {
+            // Results usually arrive in order: append with an end hint, and
+            // since nothing is stored past the new item, only extend the
+            // count of consecutive results if this item continues them.
+            m_results.insert(m_results.constEnd(), index, resultItem);
+            if (index == resultCount)
+                resultCount += resultItem.count();
+            else if (index < resultCount)
+                syncResultCount();
+            return;
+        }
         m_results[index] = resultItem;
         syncResultCount();
     } else {
@@ -167,6 +178,11 @@ int ResultStoreBase::insertResultItem(int index, ResultItem &resultItem)
 
 bool ResultStoreBase::containsValidResultItem(int index) const
 {
+    // Outside of filter mode, every stored result lies before insertIndex,
+    // which makes the check for in-order results free.
+    if (!m_filterMode && (index == -1 || index >= insertIndex))
+        return false;
+
     // index might refer to either visible or pending result
     const bool inPending = m_filterMode && index != -1 && index > insertIndex;
     const auto &store = inPending ? pendingResults : m_results;
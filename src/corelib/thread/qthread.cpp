@@ -13,8 +13,10 @@
 
 #include "qthread_p.h"
 #include "private/qcoreapplication_p.h"
+#include "private/qeventloopstatistics_p.h"
 
 #include <limits>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -40,6 +42,45 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+bool QPostEventList::pushToInbox(const QPostEvent &ev)
+{
+    InboxNode *node = new InboxNode{ ev, inbox.loadRelaxed() };
+    while (!inbox.testAndSetRelease(node->next, node, node->next))
+        ;
+    return !node->next;
+}
+
+QPostEventList::InboxNode *QPostEventList::takeInbox()
+{
+    InboxNode *node = inbox.fetchAndStoreAcquire(nullptr);
+    // the inbox is a stack, so reverse it
+    InboxNode *first = nullptr;
+    while (node) {
+        InboxNode *next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+    return first;
+}
+
+void QPostEventList::flushInbox()
+{
+    if (inboxIsEmpty())
+        return;
+    for (InboxNode *node = takeInbox(); node; ) {
+        addEvent(node->event);
+        delete std::exchange(node, node->next);
+    }
+}
+
+void QPostEventList::waitForInboxWriters()
+{
+    // a writer only needs a handful of instructions to finish its push
+    while (inboxWriters.loadAcquire())
+        QThread::yieldCurrentThread();
+}
+
 
 /*
   QThreadData
@@ -47,7 +88,7 @@ void QPostEventList::addEvent(const QPostEvent &ev)
 
 QThreadData::QThreadData(int initialRefCount)
     : _ref(initialRefCount), loopLevel(0), scopeLevel(0),
-      eventDispatcher(nullptr),
+      eventDispatcher(nullptr), statistics(nullptr),
       quitNow(false), canWait(true), isAdopted(false), requiresCoreApplication(true)
 {
     // fprintf(stderr, "QThreadData %p created\n", this);
@@ -81,6 +122,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.flushInbox();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -90,6 +132,8 @@ QThreadData::~QThreadData()
         }
     }
 
+    delete statistics.loadRelaxed();
+
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
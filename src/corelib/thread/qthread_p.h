@@ -35,6 +35,7 @@ QT_BEGIN_NAMESPACE
 
 class QAbstractEventDispatcher;
 class QEventLoop;
+class QEventLoopStatisticsCollector;
 
 class QPostEvent
 {
@@ -42,11 +43,12 @@ public:
     QObject *receiver;
     QEvent *event;
     int priority;
+    quint32 postedAt; // see QEventLoopStatisticsCollector::postTimestamp()
     inline QPostEvent()
-        : receiver(nullptr), event(nullptr), priority(0)
+        : receiver(nullptr), event(nullptr), priority(0), postedAt(0)
     { }
-    inline QPostEvent(QObject *r, QEvent *e, int p)
-        : receiver(r), event(e), priority(p)
+    inline QPostEvent(QObject *r, QEvent *e, int p, quint32 t = 0)
+        : receiver(r), event(e), priority(p), postedAt(t)
     { }
 };
 Q_DECLARE_TYPEINFO(QPostEvent, Q_RELOCATABLE_TYPE);
@@ -72,10 +74,33 @@ public:
 
     QMutex mutex;
 
+    // Events posted from other threads that can bypass the mutex (see
+    // QCoreApplication::postEvent()) are pushed onto this lock-free stack
+    // instead. Whoever locks the mutex to look at the list must call
+    // flushInbox() first, which moves them into the list in one batch.
+    struct InboxNode
+    {
+        QPostEvent event;
+        InboxNode *next;
+    };
+    QAtomicPointer<InboxNode> inbox;
+    // number of threads that are about to push onto the inbox; see
+    // QObject::moveToThread()
+    QAtomicInt inboxWriters;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
 
+    // returns true if the inbox was empty before, in which case the caller
+    // has to wake up the event dispatcher
+    bool pushToInbox(const QPostEvent &ev);
+    // returns the events in the inbox in the order they were posted
+    InboxNode *takeInbox();
+    void flushInbox();
+    bool inboxIsEmpty() const { return !inbox.loadAcquire(); }
+    void waitForInboxWriters();
+
 private:
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
@@ -307,7 +332,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && postEventList.inboxIsEmpty();
     }
 
 private:
@@ -322,6 +347,7 @@ public:
     QAtomicPointer<QThread> thread;
     QAtomicPointer<void> threadId;
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
+    QAtomicPointer<QEventLoopStatisticsCollector> statistics;
     QList<void *> tls;
 
     bool quitNow;
@@ -224,9 +224,13 @@ QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *dat
     return new QEventDispatcherWasm();
 #elif !defined(QT_NO_GLIB)
     const bool isQtMainThread = data->thread.loadAcquire() == QCoreApplicationPrivate::mainThread();
-    if (qEnvironmentVariableIsEmpty("QT_NO_GLIB")
-        && (isQtMainThread || qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB"))
-        && QEventDispatcherGlib::versionSupported())
+    bool useGlib = qEnvironmentVariableIsEmpty("QT_NO_GLIB")
+            && (isQtMainThread || qEnvironmentVariableIsEmpty("QT_NO_THREADED_GLIB"));
+#  if QT_CONFIG(epoll)
+    // an explicit request for the epoll backend overrides the glib default
+    useGlib = useGlib && !QEventDispatcherUNIXPrivate::epollRequested();
+#  endif
+    if (useGlib && QEventDispatcherGlib::versionSupported())
         return new QEventDispatcherGlib;
     else
         return new QEventDispatcherUNIX;
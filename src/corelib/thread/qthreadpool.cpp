@@ -6,6 +6,10 @@
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
 
+#include <private/qtrace_p.h>
+
+#include <qtcore_tracepoints_p.h>
+
 #include <algorithm>
 #include <memory>
 
@@ -13,6 +17,10 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+Q_TRACE_POINT(qtcore, QThreadPool_enqueueTask, QObject *pool, void *runnable, int priority);
+Q_TRACE_POINT(qtcore, QRunnable_run_entry, void *runnable);
+Q_TRACE_POINT(qtcore, QRunnable_run_exit, void *runnable);
+
 /*
     QThread wrapper, provides synchronization against a ThreadPool
 */
@@ -24,11 +32,25 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    void pushLocalTask(QRunnable *runnable);
+    QRunnable *popLocalTask();
+    QRunnable *stealLocalTask();
+    bool tryTakeLocalTask(QRunnable *runnable);
+    QList<QRunnable *> takeLocalTasks();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Work-stealing mode: tasks started from this thread. Only this thread
+    // pushes and pops at the back (LIFO), other threads steal at the front.
+    QMutex localQueueMutex;
+    QList<QRunnable *> localQueue;
+    quint32 stealSeed;
 };
 
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -38,7 +60,7 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr), stealSeed(quint32(quintptr(this) >> 4) | 1)
 {
     setStackSize(manager->stackSize);
 }
@@ -48,6 +70,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -55,27 +78,33 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
+                    Q_TRACE(QRunnable_run_entry, r);
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
+                    Q_TRACE(QRunnable_run_exit, r);
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // tasks this thread queued itself don't need the pool's lock
+                } while ((r = popLocalTask()));
                 locker.relock();
             }
 
@@ -83,9 +112,13 @@ void QThreadPoolThread::run()
             if (manager->tooManyThreadsActive())
                 break;
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
-                break;
+            // all work is done, look for some in the other threads' queues
+            if (manager->queue.isEmpty()) {
+                r = manager->stealTask(this);
+                if (!r)
+                    break;
+                continue;
+            }
 
             QueuePage *page = manager->queue.first();
             r = page->pop();
@@ -94,6 +127,7 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updatePriorityHint();
         } while (true);
 
         // this thread is about to be deleted, do not wait or expire
@@ -131,6 +165,41 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+void QThreadPoolThread::pushLocalTask(QRunnable *runnable)
+{
+    Q_ASSERT(currentPoolThread == this);
+    QMutexLocker locker(&localQueueMutex);
+    localQueue.append(runnable);
+}
+
+QRunnable *QThreadPoolThread::popLocalTask()
+{
+    Q_ASSERT(currentPoolThread == this);
+    // queued work of a higher priority runs first, local tasks are priority 0
+    if (manager->hasHighPriorityWork.load(std::memory_order_relaxed))
+        return nullptr;
+    QMutexLocker locker(&localQueueMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeLast();
+}
+
+QRunnable *QThreadPoolThread::stealLocalTask()
+{
+    QMutexLocker locker(&localQueueMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeFirst();
+}
+
+bool QThreadPoolThread::tryTakeLocalTask(QRunnable *runnable)
+{
+    QMutexLocker locker(&localQueueMutex);
+    return localQueue.removeOne(runnable);
+}
+
+QList<QRunnable *> QThreadPoolThread::takeLocalTasks()
+{
+    QMutexLocker locker(&localQueueMutex);
+    return std::exchange(localQueue, {});
+}
+
 
 /*
     \internal
@@ -188,6 +257,7 @@ inline bool comparePriority(int priority, const QueuePage *p)
 void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
+    Q_TRACE(QThreadPool_enqueueTask, q_func(), runnable, priority);
     for (QueuePage *page : std::as_const(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -196,6 +266,75 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updatePriorityHint();
+}
+
+/*!
+    \internal
+
+    Must be called with the mutex held whenever the front of the queue
+    changes, so that workers popping their local queues without the mutex
+    know whether work of a higher priority is waiting.
+*/
+void QThreadPoolPrivate::updatePriorityHint()
+{
+    const bool high = !queue.isEmpty() && queue.first()->priority() > 0;
+    hasHighPriorityWork.store(high, std::memory_order_relaxed);
+}
+
+/*!
+    \internal
+
+    Queues \a runnable on \a thread's local queue, which is drained by
+    \a thread without taking the pool's mutex. If the mutex isn't contended,
+    the oldest local task is offered to an idle or new thread right away;
+    otherwise idle threads will steal it when they next look for work.
+*/
+void QThreadPoolPrivate::enqueueLocalTask(QThreadPoolThread *thread, QRunnable *runnable)
+{
+    thread->pushLocalTask(runnable);
+
+    if (!mutex.tryLock())
+        return;
+    if (!areAllThreadsActive()) {
+        if (QRunnable *task = thread->stealLocalTask()) {
+            const bool started = tryStart(task);
+            Q_ASSERT(started);
+        }
+    }
+    mutex.unlock();
+}
+
+/*!
+    \internal
+
+    Takes the oldest task from the local queue of a randomly chosen thread
+    other than \a thief. Must be called with the mutex held.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    if (!workStealing.load(std::memory_order_relaxed) || allThreads.size() < 2)
+        return nullptr;
+
+    // xorshift, good enough to spread the thieves over the victims
+    quint32 &seed = thief->stealSeed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    const qsizetype start = seed % allThreads.size();
+    for (int pass = 0; pass < 2; ++pass) {
+        qsizetype i = 0;
+        for (QThreadPoolThread *victim : std::as_const(allThreads)) {
+            const bool inRange = pass == 0 ? i >= start : i < start;
+            ++i;
+            if (!inRange || victim == thief)
+                continue;
+            if (QRunnable *r = victim->stealLocalTask())
+                return r;
+        }
+    }
+    return nullptr;
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -220,6 +359,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             queue.removeFirst();
             delete page;
         }
+        updatePriorityHint();
     }
 }
 
@@ -309,6 +449,16 @@ bool QThreadPoolPrivate::waitForDone(int msecs)
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        const QList<QRunnable *> tasks = thread->takeLocalTasks();
+        for (QRunnable *r : tasks) {
+            if (r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
     while (!queue.isEmpty()) {
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
@@ -321,6 +471,7 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updatePriorityHint();
 }
 
 /*!
@@ -354,10 +505,16 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 d->queue.removeOne(page);
                 delete page;
             }
+            d->updatePriorityHint();
             return true;
         }
     }
 
+    for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+        if (thread->tryTakeLocalTask(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -375,7 +532,9 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     // If autoDelete() is false, runnable might already be deleted after run(), so check status now.
     const bool del = runnable->autoDelete();
 
+    Q_TRACE(QRunnable_run_entry, runnable);
     runnable->run();
+    Q_TRACE(QRunnable_run_exit, runnable);
 
     if (del)
         delete runnable;
@@ -510,6 +669,13 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    QThreadPoolThread *current = currentPoolThread;
+    if (priority == 0 && current && current->manager == d
+            && d->workStealing.load(std::memory_order_relaxed)) {
+        d->enqueueLocalTask(current, runnable);
+        return;
+    }
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -658,6 +824,42 @@ int QThreadPool::activeThreadCount() const
     return d->activeThreadCount();
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether runnables started from the pool's own threads are queued
+    per thread.
+    \since 6.7
+
+    By default, all runnables that cannot be started right away are added to
+    a single queue protected by the thread pool's lock. When this property is
+    \c true, a runnable passed to start() with the default priority from
+    within one of the pool's own threads is instead added to a queue owned by
+    that thread. The thread runs its own runnables most-recently-queued
+    first, without taking the thread pool's lock, and threads that run out of
+    work take the oldest runnables from the queue of a randomly chosen
+    other thread.
+
+    Runnables started with a priority greater than 0 are still run before
+    the ones queued per thread, and the ones started with a negative
+    priority after them.
+
+    This is useful for workloads where many small runnables are started
+    from within other runnables, as the thread pool's lock is otherwise
+    taken for every one of them.
+
+    The default value is \c false.
+*/
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load(std::memory_order_relaxed);
+}
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled, std::memory_order_relaxed);
+}
+
 /*!
     Reserves one thread, disregarding activeThreadCount() and maxThreadCount().
 
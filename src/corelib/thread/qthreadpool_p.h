@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -134,6 +136,10 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    void updatePriorityHint();
+    void enqueueLocalTask(QThreadPoolThread *thread, QRunnable *runnable);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -150,6 +156,9 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    std::atomic<bool> workStealing = false;
+    std::atomic<bool> hasHighPriorityWork = false;
 };
 
 QT_END_NAMESPACE
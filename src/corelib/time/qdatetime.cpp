@@ -4146,22 +4146,51 @@ QString QDateTime::toString(Qt::DateFormat format) const
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
         const QPair<QDate, QTime> p = getDateTime(d);
-        buf = toStringIsoDate(p.first);
-        if (buf.isEmpty())
+        const auto parts = QCalendar().partsFromDate(p.first);
+        if (!parts.isValid() || parts.year < 0 || parts.year > 9999)
             return QString();   // failed to convert
-        buf += u'T' + p.second.toString(format);
+        // Written out directly rather than with QString::asprintf(), as this
+        // is the usual form in logs and data interchange:
+        // yyyy-MM-ddTHH:mm:ss[.zzz][Z|+HH:mm]
+        char16_t out[29];
+        char16_t *end = out;
+        const auto put = [&end](int value, int digits) {
+            for (int i = digits - 1; i >= 0; --i, value /= 10)
+                end[i] = char16_t(u'0' + value % 10);
+            end += digits;
+        };
+        put(parts.year, 4);
+        *end++ = u'-';
+        put(parts.month, 2);
+        *end++ = u'-';
+        put(parts.day, 2);
+        *end++ = u'T';
+        put(p.second.hour(), 2);
+        *end++ = u':';
+        put(p.second.minute(), 2);
+        *end++ = u':';
+        put(p.second.second(), 2);
+        if (format == Qt::ISODateWithMs) {
+            *end++ = u'.';
+            put(p.second.msec(), 3);
+        }
         switch (getSpec(d)) {
         case Qt::UTC:
-            buf += u'Z';
+            *end++ = u'Z';
             break;
         case Qt::OffsetFromUTC:
-        case Qt::TimeZone:
-            buf += toOffsetString(Qt::ISODate, offsetFromUtc());
+        case Qt::TimeZone: {
+            const int offset = offsetFromUtc();
+            *end++ = offset >= 0 ? u'+' : u'-';
+            put(qAbs(offset) / int(SECS_PER_HOUR), 2);
+            *end++ = u':';
+            put((qAbs(offset) / 60) % 60, 2);
             break;
+        }
         default:
             break;
         }
-        return buf;
+        return QStringView(out, end).toString();
     }
     }
 }
@@ -5143,6 +5172,89 @@ QDateTime QDateTime::fromSecsSinceEpoch(qint64 secs)
     \overload
     \since 6.0
 */
+/*
+    Fast path of QDateTime::fromString() for the layout most ISO 8601 and
+    RFC 3339 timestamps use, "yyyy-MM-ddTHH:mm:ss", optionally followed by a
+    fraction of a second and by Z or [+-]HH:mm. Returns false for anything
+    else, including values the general code has to check more closely, which
+    is then left to it; the results of both agree.
+*/
+static bool fromFixedIsoString(QStringView string, QDateTime *result)
+{
+    const qsizetype size = string.size();
+    if (size < 19)
+        return false;
+    const auto digit = [string](qsizetype i) {
+        const char16_t c = string[i].unicode();
+        return c >= u'0' && c <= u'9' ? int(c - u'0') : -1;
+    };
+    // The value of the n digits at i, or -1 if they are not all digits
+    const auto number = [&digit](qsizetype i, qsizetype n) {
+        int value = 0;
+        for (const qsizetype end = i + n; i < end; ++i) {
+            const int d = digit(i);
+            if (d < 0)
+                return -1;
+            value = value * 10 + d;
+        }
+        return value;
+    };
+
+    const char16_t separator = string[10].unicode();
+    if (string[4] != u'-' || string[7] != u'-' || string[13] != u':' || string[16] != u':'
+        || (separator != u'T' && separator != u't' && separator != u' ')) {
+        return false;
+    }
+    const int year = number(0, 4), month = number(5, 2), day = number(8, 2);
+    const int hour = number(11, 2), minute = number(14, 2), second = number(17, 2);
+    // Hour 24 and invalid values go the long way
+    if (year <= 0 || month < 0 || day < 0 || hour < 0 || hour > 23
+        || minute < 0 || minute >= MINS_PER_HOUR || second < 0 || second >= SECS_PER_MIN) {
+        return false;
+    }
+
+    qsizetype pos = 19;
+    int msec = 0;
+    if (pos < size && (string[pos] == u'.' || string[pos] == u',')) {
+        const qsizetype start = ++pos;
+        qulonglong fraction = 0;
+        for (int d; pos < size && (d = digit(pos)) >= 0; ++pos)
+            fraction = fraction * 10 + d;
+        const qsizetype digits = pos - start;
+        if (digits == 0 || digits > 9)
+            return false;
+        // Rounded as in fromIsoTimeString(), but leave rounding up to the
+        // next second to it
+        msec = qRound(MSECS_PER_SEC * (fraction * std::pow(0.1, digits)));
+        if (msec == MSECS_PER_SEC)
+            return false;
+    }
+
+    QTimeZone zone = QTimeZone::LocalTime;
+    if (pos < size) {
+        const char16_t c = string[pos].unicode();
+        if ((c == u'Z' || c == u'z') && pos + 1 == size) {
+            zone = QTimeZone::UTC;
+        } else if ((c == u'+' || c == u'-') && pos + 6 == size && string[pos + 3] == u':') {
+            const int offsetHours = number(pos + 1, 2), offsetMinutes = number(pos + 4, 2);
+            if (offsetHours < 0 || offsetHours > 23 || offsetMinutes < 0
+                || offsetMinutes >= MINS_PER_HOUR) {
+                return false;
+            }
+            const int offset = (offsetHours * 60 + offsetMinutes) * 60;
+            zone = QTimeZone::fromSecondsAheadOfUtc(c == u'-' ? -offset : offset);
+        } else {
+            return false;
+        }
+    }
+
+    const QDate date(year, month, day);
+    if (!date.isValid())
+        return false;
+    *result = QDateTime(date, QTime(hour, minute, second, msec), zone);
+    return true;
+}
+
 QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
 {
     if (string.isEmpty())
@@ -5161,6 +5273,10 @@ QDateTime QDateTime::fromString(QStringView string, Qt::DateFormat format)
     }
     case Qt::ISODate:
     case Qt::ISODateWithMs: {
+        QDateTime fixed;
+        if (fromFixedIsoString(string, &fixed))
+            return fixed;
+
         const int size = string.size();
         if (size < 10)
             return QDateTime();
@@ -267,8 +267,13 @@ struct QTzTimeZoneCacheEntry
 {
     QList<QTzTransitionTime> m_tranTimes;
     QList<QTzTransitionRule> m_tranRules;
-    QList<QByteArray> m_abbreviations;
+    QList<QString> m_abbreviations;
     QByteArray m_posixRule;
+    // The transitions m_posixRule gives for the years from the one before
+    // the last of m_tranTimes until m_posixTransitionsEnd, computed once
+    // instead of for each lookup
+    QList<QTimeZonePrivate::Data> m_posixTransitions;
+    qint64 m_posixTransitionsEnd = 0;
     QTzTransitionRule m_preZoneRule;
     bool m_hasDst;
 };
@@ -330,7 +335,7 @@ private:
     mutable QExplicitlySharedDataPointer<const QIcuTimeZonePrivate> m_icu;
 #endif
     QTzTimeZoneCacheEntry cached_data;
-    QList<QTzTransitionTime> tranCache() const { return cached_data.m_tranTimes; }
+    const QList<QTzTransitionTime> &tranCache() const { return cached_data.m_tranTimes; }
 };
 #endif // Q_OS_UNIX
 
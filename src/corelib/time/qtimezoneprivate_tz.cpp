@@ -855,7 +855,7 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
     QList<int> abbrindList;
     abbrindList.reserve(size);
     for (auto it = abbrevMap.cbegin(), end = abbrevMap.cend(); it != end; ++it) {
-        ret.m_abbreviations.append(it.value());
+        ret.m_abbreviations.append(QString::fromUtf8(it.value()));
         abbrindList.append(it.key());
     }
     // Map tz_abbrind from map's keys (as initially read) to abbrindList's
@@ -949,6 +949,22 @@ QTzTimeZoneCacheEntry QTzTimeZoneCache::findEntry(const QByteArray &ianaId)
         ret.m_tranTimes.append(tran);
     }
 
+    // Most lookups are for recent times, after the last transition of the
+    // file, and need the POSIX rule's transitions for the years around them:
+    // work these out once for the years in common use.
+    if (!ret.m_posixRule.isEmpty() && !ret.m_tranTimes.isEmpty()) {
+        constexpr int posixTransitionsEndYear = 2100;
+        const qint64 lastTran = ret.m_tranTimes.last().atMSecsSinceEpoch;
+        const int lastTranYear = QDateTime::fromMSecsSinceEpoch(lastTran, QTimeZone::UTC).date().year();
+        if (lastTranYear < posixTransitionsEndYear) {
+            ret.m_posixTransitions = calculatePosixTransitions(ret.m_posixRule, lastTranYear - 1,
+                                                               posixTransitionsEndYear, lastTran);
+            // getPosixTransitions() needs the year after the one looked up
+            ret.m_posixTransitionsEnd = QDate(posixTransitionsEndYear, 1, 1)
+                    .startOfDay(QTimeZone::UTC).toMSecsSinceEpoch();
+        }
+    }
+
     return ret;
 }
 
@@ -1132,12 +1148,17 @@ QTimeZonePrivate::Data QTzTimeZonePrivate::dataForTzTransition(QTzTransitionTime
 QTimeZonePrivate::Data QTzTimeZonePrivate::dataFromRule(QTzTransitionRule rule,
                                                         qint64 msecsSinceEpoch) const
 {
-    return { QString::fromUtf8(cached_data.m_abbreviations.at(rule.abbreviationIndex)),
+    return { cached_data.m_abbreviations.at(rule.abbreviationIndex),
              msecsSinceEpoch, rule.stdOffset + rule.dstOffset, rule.stdOffset, rule.dstOffset };
 }
 
 QList<QTimeZonePrivate::Data> QTzTimeZonePrivate::getPosixTransitions(qint64 msNear) const
 {
+    // Only called for times after the last transition, so the table starts
+    // early enough; it may hold more years than needed, which is harmless.
+    if (msNear < cached_data.m_posixTransitionsEnd && !cached_data.m_posixTransitions.isEmpty())
+        return cached_data.m_posixTransitions;
+
     const int year = QDateTime::fromMSecsSinceEpoch(msNear, QTimeZone::UTC).date().year();
     // The Data::atMSecsSinceEpoch of the single entry if zone is constant:
     qint64 atTime = tranCache().isEmpty() ? msNear : tranCache().last().atMSecsSinceEpoch;
@@ -6,6 +6,7 @@
 #include <QtCore/private/qnumeric_p.h>
 #include <QtCore/private/qtools_p.h>
 #include <QtCore/qmath.h>
+#include <QtCore/qmonotonicarena.h>
 
 #include <QtCore/qbytearray.h>  // QBA::value_type
 #include <QtCore/qstring.h>  // QString::value_type
@@ -137,26 +138,32 @@ static inline qsizetype calculateBlockSize(qsizetype &capacity, qsizetype object
     }
 }
 
+namespace {
+// QArrayData with strictest alignment requirements supported by malloc()
+struct alignas(std::max_align_t) AlignedQArrayData : QArrayData
+{
+};
+}
+
 static QArrayData *allocateData(qsizetype allocSize)
 {
-    QArrayData *header = static_cast<QArrayData *>(::malloc(size_t(allocSize)));
+    QArrayData::ArrayOptions flags = QArrayData::ArrayOptionDefault;
+    void *memory = QtPrivate::qArenaAllocate(size_t(allocSize), alignof(AlignedQArrayData));
+    if (memory)
+        flags = QArrayData::ArenaAllocated;
+    else
+        memory = ::malloc(size_t(allocSize));
+
+    QArrayData *header = static_cast<QArrayData *>(memory);
     if (header) {
         header->ref_.storeRelaxed(1);
-        header->flags = {};
+        header->flags = flags;
         header->alloc = 0;
     }
     return header;
 }
 
 
-namespace {
-// QArrayData with strictest alignment requirements supported by malloc()
-struct alignas(std::max_align_t) AlignedQArrayData : QArrayData
-{
-};
-}
-
-
 void *QArrayData::allocate(QArrayData **dptr, qsizetype objectSize, qsizetype alignment,
         qsizetype capacity, QArrayData::AllocationOption option) noexcept
 {
@@ -221,7 +228,16 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
     if (Q_UNLIKELY(allocSize < 0))  // handle overflow. cannot reallocate reliably
         return qMakePair(data, dataPointer);
 
-    QArrayData *header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    QArrayData *header;
+    if (data && data->flags & ArenaAllocated) {
+        bool inArena;
+        header = static_cast<QArrayData *>(QtPrivate::qArenaReallocate(data, size_t(allocSize),
+                                                                       &inArena));
+        if (header && !inArena)
+            header->flags &= ~ArenaAllocated;
+    } else {
+        header = static_cast<QArrayData *>(::realloc(data, size_t(allocSize)));
+    }
     if (header) {
         header->alloc = capacity;
         dataPointer = reinterpret_cast<char *>(header) + offset;
@@ -240,7 +256,10 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
-    ::free(data);
+    if (data && data->flags & ArenaAllocated)
+        QtPrivate::qArenaFree(data);
+    else
+        ::free(data);
 }
 
 QT_END_NAMESPACE
@@ -27,7 +27,8 @@ struct QArrayData
 
    enum ArrayOption {
         ArrayOptionDefault = 0,
-        CapacityReserved     = 0x1  //!< the capacity was reserved by the user, try to keep it
+        CapacityReserved     = 0x1,  //!< the capacity was reserved by the user, try to keep it
+        ArenaAllocated       = 0x100 //!< the memory comes from a QMonotonicArena
     };
     Q_DECLARE_FLAGS(ArrayOptions, ArrayOption)
 
@@ -95,7 +95,10 @@ public:
     {
         if (!deref()) {
             (*this)->destroyAll();
-            free(d);
+            if (Q_UNLIKELY(d->flags & QArrayData::ArenaAllocated))
+                Data::deallocate(d);
+            else
+                free(d);
         }
     }
 
@@ -456,7 +459,7 @@ public:
         dataPtr += (position == QArrayData::GrowsAtBeginning)
                 ? n + qMax(0, (header->alloc - from.size - n) / 2)
                 : from.freeSpaceAtBegin();
-        header->flags = from.flags();
+        header->flags |= from.flags() & ~QArrayData::ArenaAllocated;
         return QArrayDataPointer(header, dataPtr);
     }
 
@@ -169,6 +169,83 @@ qsizetype QBitArray::count(bool on) const
     return on ? numBits : size() - numBits;
 }
 
+// Returns the index of the first bit at or after from that differs from
+// the bits of skip (0x00 or 0xff), or -1 if there is none in the n bytes
+static qsizetype findNextBit(const uchar *bits, qsizetype n, qsizetype from, uchar skip)
+{
+    qsizetype i = from >> 3;
+    if (i >= n)
+        return -1;
+    // the bits of the first byte before from are masked out
+    const uchar first = uchar((bits[i] ^ skip) & (0xff << (from & 7)));
+    if (first)
+        return (i << 3) + qCountTrailingZeroBits(first);
+
+    const quint64 skipWord = skip ? ~quint64(0) : 0;
+    for (++i; i + qsizetype(sizeof(quint64)) <= n; i += sizeof(quint64)) {
+        const quint64 v = qFromLittleEndian<quint64>(bits + i) ^ skipWord;
+        if (v)
+            return (i << 3) + qCountTrailingZeroBits(v);
+    }
+    for (; i < n; ++i) {
+        const uchar v = bits[i] ^ skip;
+        if (v)
+            return (i << 3) + qCountTrailingZeroBits(v);
+    }
+    return -1;
+}
+
+/*!
+    \since 6.7
+
+    Returns the index of the first bit set to 1 at or after position
+    \a from, or -1 if there is none. Together with findNextClear(), this
+    allows iterating over the set or cleared bits of a large array a
+    machine word at a time:
+
+    \code
+    for (qsizetype i = bits.findNextSet(0); i != -1; i = bits.findNextSet(i + 1))
+        process(i);
+    \endcode
+
+    \a from must not be negative; if it is size() or greater, -1 is
+    returned.
+
+    \sa findNextClear(), count(), testBit()
+*/
+qsizetype QBitArray::findNextSet(qsizetype from) const
+{
+    Q_ASSERT(from >= 0);
+    if (from >= size())
+        return -1;
+    // the padding bits are always 0, so they are never found
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    return findNextBit(bits, d.size() - 1, from, 0);
+}
+
+/*!
+    \since 6.7
+
+    Returns the index of the first bit set to 0 at or after position
+    \a from, or -1 if there is none.
+
+    \a from must not be negative; if it is size() or greater, -1 is
+    returned.
+
+    \sa findNextSet(), count(), testBit()
+*/
+qsizetype QBitArray::findNextClear(qsizetype from) const
+{
+    Q_ASSERT(from >= 0);
+    const qsizetype sz = size();
+    if (from >= sz)
+        return -1;
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const qsizetype i = findNextBit(bits, d.size() - 1, from, 0xff);
+    // ignore the padding bits
+    return i < sz ? i : -1;
+}
+
 /*!
     Resizes the bit array to \a size bits.
 
@@ -516,17 +593,32 @@ quint32 QBitArray::toUInt32(QSysInfo::Endian endianness, bool *ok) const noexcep
     \sa operator&(), operator|=(), operator^=(), operator~()
 */
 
+// Combines the n bytes of src into dst with op, a word at a time
+template <typename Op>
+static void combineBits(uchar *dst, const uchar *src, qsizetype n, Op op)
+{
+    while (n >= qsizetype(sizeof(quint64))) {
+        qToUnaligned(op(qFromUnaligned<quint64>(dst), qFromUnaligned<quint64>(src)), dst);
+        dst += sizeof(quint64);
+        src += sizeof(quint64);
+        n -= sizeof(quint64);
+    }
+    while (n-- > 0) {
+        *dst = uchar(op(*dst, *src));
+        ++dst;
+        ++src;
+    }
+}
+
 QBitArray &QBitArray::operator&=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    qsizetype p = d.size() - 1 - n;
-    while (n-- > 0)
-        *a1++ &= *a2++;
-    while (p-- > 0)
-        *a1++ = 0;
+    qsizetype n = qMax(other.d.size() - 1, qsizetype(0));
+    combineBits(a1, a2, n, [](auto x, auto y) { return x & y; });
+    if (d.size() - 1 > n)
+        memset(a1 + n, 0, d.size() - 1 - n);
     return *this;
 }
 
@@ -551,8 +643,8 @@ QBitArray &QBitArray::operator|=(const QBitArray &other)
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
     qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ |= *a2++;
+    if (n > 0)
+        combineBits(a1, a2, n, [](auto x, auto y) { return x | y; });
     return *this;
 }
 
@@ -577,8 +669,8 @@ QBitArray &QBitArray::operator^=(const QBitArray &other)
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
     qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ ^= *a2++;
+    if (n > 0)
+        combineBits(a1, a2, n, [](auto x, auto y) { return x ^ y; });
     return *this;
 }
 
@@ -600,6 +692,11 @@ QBitArray QBitArray::operator~() const
     uchar *a2 = reinterpret_cast<uchar *>(a.d.data()) + 1;
     qsizetype n = d.size() - 1;
 
+    for (; n >= qsizetype(sizeof(quint64)); n -= sizeof(quint64)) {
+        qToUnaligned(~qFromUnaligned<quint64>(a1), a2);
+        a1 += sizeof(quint64);
+        a2 += sizeof(quint64);
+    }
     while (n-- > 0)
         *a2++ = ~*a1++;
 
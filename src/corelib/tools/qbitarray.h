@@ -31,6 +31,8 @@ public:
     inline qsizetype size() const { return (d.size() << 3) - *d.constData(); }
     inline qsizetype count() const { return (d.size() << 3) - *d.constData(); }
     qsizetype count(bool on) const;
+    qsizetype findNextSet(qsizetype from) const;
+    qsizetype findNextClear(qsizetype from) const;
 
     inline bool isEmpty() const { return d.isEmpty(); }
     inline bool isNull() const { return d.isNull(); }
@@ -0,0 +1,282 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCONCURRENTCACHE_H
+#define QCONCURRENTCACHE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+template <class Key, class T>
+class QConcurrentCache
+{
+    struct Entry
+    {
+        Key key;
+        QSharedPointer<T> object;
+        qsizetype cost;
+        // set by lookups, cleared by the clock hand on its way to the next victim
+        mutable QAtomicInt referenced;
+        bool inUse;
+    };
+
+    struct Evicted
+    {
+        QSharedPointer<T> object;
+        qsizetype cost;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable QReadWriteLock lock;
+        QHash<Key, qsizetype> index;
+        // Entries keep their position while in use, so that the order in which
+        // the clock hand visits them does not change
+        QList<Entry> entries;
+        QList<qsizetype> freeEntries;
+        qsizetype hand = 0;
+
+        bool isEmpty() const noexcept { return entries.size() == freeEntries.size(); }
+
+        void insert(const Key &key, QSharedPointer<T> &&object, qsizetype cost)
+        {
+            // new objects get one turn of the hand before they can be evicted
+            Entry entry{ key, std::move(object), cost, 1, true };
+            if (freeEntries.isEmpty()) {
+                index.insert(key, entries.size());
+                entries.append(std::move(entry));
+            } else {
+                const qsizetype i = freeEntries.takeLast();
+                index.insert(key, i);
+                entries[i] = std::move(entry);
+            }
+        }
+
+        Evicted takeAt(qsizetype i)
+        {
+            Entry &entry = entries[i];
+            index.remove(entry.key);
+            Evicted taken{ std::move(entry.object), entry.cost };
+            entry.inUse = false;
+            if (freeEntries.size() + 1 == entries.size()) {
+                // that was the last one, start over
+                entries.clear();
+                freeEntries.clear();
+                hand = 0;
+            } else {
+                freeEntries.append(i);
+            }
+            return taken;
+        }
+
+        // CLOCK: skip, and clear, the entries that were used since the hand
+        // last passed them. This ends after at most one full turn.
+        Evicted evict()
+        {
+            Q_ASSERT(!isEmpty());
+            for (;; ++hand) {
+                if (hand >= entries.size())
+                    hand = 0;
+                Entry &entry = entries[hand];
+                if (!entry.inUse)
+                    continue;
+                if (!entry.referenced.loadRelaxed())
+                    return takeAt(hand++);
+                entry.referenced.storeRelaxed(0);
+            }
+        }
+    };
+
+    size_t seed;
+    std::unique_ptr<Shard[]> shards;
+    size_t shardMask;
+    QAtomicInteger<qsizetype> mx;
+    QAtomicInteger<qsizetype> total = 0;
+    QAtomicInteger<qsizetype> count_ = 0;
+    mutable QAtomicInteger<size_t> evictionShard = 0;
+
+    Shard &shardFor(const Key &key) const noexcept
+    {
+        // QHash uses the low bits of the same hash for its buckets
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        return shards[(hash >> (sizeof(size_t) * 4)) & shardMask];
+    }
+
+    bool takeObject(const Key &key, QSharedPointer<T> *object)
+    {
+        Shard &shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        const auto it = shard.index.constFind(key);
+        if (it == shard.index.cend())
+            return false;
+        Evicted taken = shard.takeAt(*it);
+        total.fetchAndSubRelaxed(taken.cost);
+        count_.fetchAndSubRelaxed(1);
+        *object = std::move(taken.object);
+        return true;
+    }
+
+    void trim(qsizetype m)
+    {
+        // evict from one shard after the other, so that all of them shrink
+        while (total.loadRelaxed() > m && count_.loadRelaxed() > 0) {
+            Shard &shard = shards[evictionShard.fetchAndAddRelaxed(1) & shardMask];
+            QSharedPointer<T> evicted;
+            {
+                QWriteLocker locker(&shard.lock);
+                if (shard.isEmpty())
+                    continue;
+                Evicted taken = shard.evict();
+                total.fetchAndSubRelaxed(taken.cost);
+                count_.fetchAndSubRelaxed(1);
+                evicted = std::move(taken.object);
+            }
+            // the object is deleted here, after unlocking, if nobody else holds it
+        }
+    }
+
+    Q_DISABLE_COPY_MOVE(QConcurrentCache)
+
+public:
+    explicit QConcurrentCache(qsizetype maxCost = 100, qsizetype shardCount = 16)
+        : seed(QHashSeed::globalSeed()), mx(maxCost)
+    {
+        static_assert(std::is_nothrow_destructible_v<Key>, "Types with throwing destructors are not supported in Qt containers.");
+        static_assert(std::is_nothrow_destructible_v<T>, "Types with throwing destructors are not supported in Qt containers.");
+
+        size_t n = 1;
+        while (n < size_t(qMax(shardCount, qsizetype(1))))
+            n *= 2;
+        shards.reset(new Shard[n]);
+        shardMask = n - 1;
+    }
+    ~QConcurrentCache() = default;
+
+    qsizetype shardCount() const noexcept { return qsizetype(shardMask + 1); }
+
+    qsizetype maxCost() const noexcept { return mx.loadRelaxed(); }
+    void setMaxCost(qsizetype m)
+    {
+        mx.storeRelaxed(m);
+        trim(m);
+    }
+    qsizetype totalCost() const noexcept { return total.loadRelaxed(); }
+
+    qsizetype size() const noexcept { return count_.loadRelaxed(); }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return !size(); }
+
+    QList<Key> keys() const
+    {
+        QList<Key> k;
+        k.reserve(size());
+        for (size_t i = 0; i <= shardMask; ++i) {
+            QReadLocker locker(&shards[i].lock);
+            for (const Entry &entry : std::as_const(shards[i].entries)) {
+                if (entry.inUse)
+                    k.append(entry.key);
+            }
+        }
+        return k;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i <= shardMask; ++i) {
+            Shard &shard = shards[i];
+            QList<Entry> entries;
+            {
+                QWriteLocker locker(&shard.lock);
+                entries.swap(shard.entries);
+                shard.freeEntries.clear();
+                shard.index.clear();
+                shard.hand = 0;
+                for (const Entry &entry : std::as_const(entries)) {
+                    if (entry.inUse) {
+                        total.fetchAndSubRelaxed(entry.cost);
+                        count_.fetchAndSubRelaxed(1);
+                    }
+                }
+            }
+        }
+    }
+
+    bool insert(const Key &key, T *object, qsizetype cost = 1)
+    {
+        if (cost > maxCost()) {
+            remove(key);
+            delete object;
+            return false;
+        }
+        QSharedPointer<T> ptr(object);
+        trim(maxCost() - cost);
+        Shard &shard = shardFor(key);
+        {
+            QWriteLocker locker(&shard.lock);
+            const auto it = shard.index.constFind(key);
+            if (it != shard.index.cend()) {
+                // the replaced object is deleted after unlocking
+                Entry &entry = shard.entries[*it];
+                ptr.swap(entry.object);
+                total.fetchAndAddRelaxed(cost - entry.cost);
+                entry.cost = cost;
+                entry.referenced.storeRelaxed(1);
+            } else {
+                shard.insert(key, std::move(ptr), cost);
+                total.fetchAndAddRelaxed(cost);
+                count_.fetchAndAddRelaxed(1);
+            }
+        }
+        // other threads may have inserted since we made room
+        trim(maxCost());
+        return true;
+    }
+
+    QSharedPointer<T> object(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        const auto it = shard.index.constFind(key);
+        if (it == shard.index.cend())
+            return nullptr;
+        const Entry &entry = shard.entries.at(*it);
+        if (!entry.referenced.loadRelaxed())
+            entry.referenced.storeRelaxed(1);
+        return entry.object;
+    }
+    QSharedPointer<T> operator[](const Key &key) const
+    {
+        return object(key);
+    }
+    bool contains(const Key &key) const
+    {
+        const Shard &shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.index.contains(key);
+    }
+
+    bool remove(const Key &key)
+    {
+        QSharedPointer<T> removed;
+        return takeObject(key, &removed);
+    }
+
+    QSharedPointer<T> take(const Key &key)
+    {
+        QSharedPointer<T> taken;
+        takeObject(key, &taken);
+        return taken;
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_H
@@ -10,6 +10,7 @@
 #include <qmutex.h>
 #include <qvarlengtharray.h>
 #include <private/qlocking_p.h>
+#include <private/qsimd_p.h>
 
 #include <array>
 #include <climits>
@@ -122,6 +123,418 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+#if !defined(USING_OPENSSL30) && !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) \
+    && defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define QT_CRYPTOGRAPHICHASH_SHA_NI
+#  define QT_FUNCTION_TARGET_STRING_SHA_NI    QT_FUNCTION_TARGET_STRING_SHA "," QT_FUNCTION_TARGET_STRING_SSE4_1
+
+namespace {
+/*
+    SHA-1 and SHA-224/256 using the x86 SHA extensions.
+
+    The kernels are written for a number of independent lanes, each hashing its
+    own message. The round instructions have a long latency, so interleaving two
+    messages keeps the execution units busy; this is what hashMany() uses. All
+    loops have constant trip counts so that the lanes live in registers.
+*/
+template <int Lanes>
+struct Sha1Ni
+{
+    __m128i abcd[Lanes];
+    __m128i e[Lanes];
+    __m128i previous[Lanes];
+    __m128i w[Lanes][4];
+};
+
+template <int Round, int Lanes>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE void sha1NiRounds(Sha1Ni<Lanes> &s)
+{
+    for (int n = 0; n < Lanes; ++n) {
+        __m128i &w = s.w[n][Round & 3];
+        __m128i e;
+        if constexpr (Round == 0) {
+            e = _mm_add_epi32(s.e[n], w);
+        } else {
+            if constexpr (Round >= 4) {
+                w = _mm_sha1msg1_epu32(w, s.w[n][(Round - 3) & 3]);
+                w = _mm_xor_si128(w, s.w[n][(Round - 2) & 3]);
+                w = _mm_sha1msg2_epu32(w, s.w[n][(Round - 1) & 3]);
+            }
+            e = _mm_sha1nexte_epu32(s.previous[n], w);
+        }
+        s.previous[n] = s.abcd[n];
+        s.abcd[n] = _mm_sha1rnds4_epu32(s.abcd[n], e, Round / 5);
+    }
+}
+
+template <int Lanes, int... Rounds>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE
+void sha1NiBlock(Sha1Ni<Lanes> &s, const uchar *const (&blocks)[Lanes],
+                 std::integer_sequence<int, Rounds...>)
+{
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd[Lanes];
+    __m128i e[Lanes];
+    for (int n = 0; n < Lanes; ++n) {
+        abcd[n] = s.abcd[n];
+        e[n] = s.e[n];
+        for (int i = 0; i < 4; ++i) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[n] + 16 * i));
+            s.w[n][i] = _mm_shuffle_epi8(data, mask);
+        }
+    }
+    (sha1NiRounds<Rounds>(s), ...);
+    for (int n = 0; n < Lanes; ++n) {
+        s.e[n] = _mm_sha1nexte_epu32(s.previous[n], e[n]);
+        s.abcd[n] = _mm_add_epi32(s.abcd[n], abcd[n]);
+    }
+}
+
+template <int Lanes>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE
+void sha1NiProcess(quint32 *const (&h)[Lanes], const uchar *(&blocks)[Lanes], qsizetype count)
+{
+    Sha1Ni<Lanes> s;
+    for (int n = 0; n < Lanes; ++n) {
+        s.abcd[n] = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h[n])), 0x1b);
+        s.e[n] = _mm_set_epi32(int(h[n][4]), 0, 0, 0);
+    }
+    for ( ; count; --count) {
+        sha1NiBlock(s, blocks, std::make_integer_sequence<int, 20>());
+        for (int n = 0; n < Lanes; ++n)
+            blocks[n] += 64;
+    }
+    for (int n = 0; n < Lanes; ++n) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(h[n]), _mm_shuffle_epi32(s.abcd[n], 0x1b));
+        h[n][4] = quint32(_mm_extract_epi32(s.e[n], 3));
+    }
+}
+
+template <int Lanes>
+struct Sha256Ni
+{
+    __m128i abef[Lanes];
+    __m128i cdgh[Lanes];
+    __m128i w[Lanes][4];
+};
+
+template <int Round, int Lanes>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE void sha256NiRounds(Sha256Ni<Lanes> &s)
+{
+    static const quint32 K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    const __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(K + 4 * Round));
+    for (int n = 0; n < Lanes; ++n) {
+        __m128i &w = s.w[n][Round & 3];
+        if constexpr (Round >= 4) {
+            const __m128i previous = s.w[n][(Round - 1) & 3];
+            w = _mm_sha256msg1_epu32(w, s.w[n][(Round - 3) & 3]);
+            w = _mm_add_epi32(w, _mm_alignr_epi8(previous, s.w[n][(Round - 2) & 3], 4));
+            w = _mm_sha256msg2_epu32(w, previous);
+        }
+        const __m128i wk = _mm_add_epi32(w, k);
+        s.cdgh[n] = _mm_sha256rnds2_epu32(s.cdgh[n], s.abef[n], wk);
+        s.abef[n] = _mm_sha256rnds2_epu32(s.abef[n], s.cdgh[n], _mm_shuffle_epi32(wk, 0x0e));
+    }
+}
+
+template <int Lanes, int... Rounds>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE
+void sha256NiBlock(Sha256Ni<Lanes> &s, const uchar *const (&blocks)[Lanes],
+                   std::integer_sequence<int, Rounds...>)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i abef[Lanes];
+    __m128i cdgh[Lanes];
+    for (int n = 0; n < Lanes; ++n) {
+        abef[n] = s.abef[n];
+        cdgh[n] = s.cdgh[n];
+        for (int i = 0; i < 4; ++i) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[n] + 16 * i));
+            s.w[n][i] = _mm_shuffle_epi8(data, mask);
+        }
+    }
+    (sha256NiRounds<Rounds>(s), ...);
+    for (int n = 0; n < Lanes; ++n) {
+        s.abef[n] = _mm_add_epi32(s.abef[n], abef[n]);
+        s.cdgh[n] = _mm_add_epi32(s.cdgh[n], cdgh[n]);
+    }
+}
+
+template <int Lanes>
+QT_FUNCTION_TARGET(SHA_NI) Q_ALWAYS_INLINE
+void sha256NiProcess(quint32 *const (&h)[Lanes], const uchar *(&blocks)[Lanes], qsizetype count)
+{
+    Sha256Ni<Lanes> s;
+    for (int n = 0; n < Lanes; ++n) {
+        const __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h[n]));
+        const __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i *>(h[n] + 4));
+        const __m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+        const __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+        s.abef[n] = _mm_alignr_epi8(cdab, efgh, 8);
+        s.cdgh[n] = _mm_blend_epi16(efgh, cdab, 0xf0);
+    }
+    for ( ; count; --count) {
+        sha256NiBlock(s, blocks, std::make_integer_sequence<int, 16>());
+        for (int n = 0; n < Lanes; ++n)
+            blocks[n] += 64;
+    }
+    for (int n = 0; n < Lanes; ++n) {
+        const __m128i feba = _mm_shuffle_epi32(s.abef[n], 0x1b);
+        const __m128i dchg = _mm_shuffle_epi32(s.cdgh[n], 0xb1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(h[n]), _mm_blend_epi16(feba, dchg, 0xf0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(h[n] + 4), _mm_alignr_epi8(dchg, feba, 8));
+    }
+}
+
+QT_FUNCTION_TARGET(SHA_NI) void sha1NiBlocks(quint32 *h, const uchar *data, qsizetype count)
+{
+    const uchar *blocks[] = { data };
+    sha1NiProcess<1>({ h }, blocks, count);
+}
+
+QT_FUNCTION_TARGET(SHA_NI) void sha1NiBlocks2(quint32 *h1, const uchar *data1,
+                                              quint32 *h2, const uchar *data2, qsizetype count)
+{
+    const uchar *blocks[] = { data1, data2 };
+    sha1NiProcess<2>({ h1, h2 }, blocks, count);
+}
+
+QT_FUNCTION_TARGET(SHA_NI) void sha256NiBlocks(quint32 *h, const uchar *data, qsizetype count)
+{
+    const uchar *blocks[] = { data };
+    sha256NiProcess<1>({ h }, blocks, count);
+}
+
+QT_FUNCTION_TARGET(SHA_NI) void sha256NiBlocks2(quint32 *h1, const uchar *data1,
+                                                quint32 *h2, const uchar *data2, qsizetype count)
+{
+    const uchar *blocks[] = { data1, data2 };
+    sha256NiProcess<2>({ h1, h2 }, blocks, count);
+}
+
+bool hasShaNi() noexcept
+{
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+}
+
+// Writes the padding that SHA-1 and SHA-2 append to a message of bitCount bits,
+// preceded by the \a size bytes that did not fill a whole block. Returns the
+// number of blocks (1 or 2) written to \a tail.
+qsizetype shaPadding(uchar (&tail)[128], const uchar *rest, qsizetype size, quint64 bitCount) noexcept
+{
+    Q_ASSERT(size < 64);
+    const qsizetype blocks = size < 56 ? 1 : 2;
+    memcpy(tail, rest, size);
+    tail[size] = 0x80;
+    memset(tail + size + 1, 0, blocks * 64 - 8 - size - 1);
+    qToBigEndian(bitCount, tail + blocks * 64 - 8);
+    return blocks;
+}
+
+struct Sha1Words
+{
+    explicit Sha1Words(const Sha1State &state) noexcept
+        : h{ state.h0, state.h1, state.h2, state.h3, state.h4 }
+    {}
+    void store(Sha1State &state) const noexcept
+    {
+        state.h0 = h[0];
+        state.h1 = h[1];
+        state.h2 = h[2];
+        state.h3 = h[3];
+        state.h4 = h[4];
+    }
+    quint32 h[5];
+};
+
+void sha1NiUpdate(Sha1State *state, const uchar *data, qint64 length) noexcept
+{
+    const qint64 rest = qint64(state->messageSize & 63);
+    state->messageSize += length;
+    Sha1Words words(*state);
+    if (rest) {
+        const qint64 n = qMin(64 - rest, length);
+        memcpy(state->buffer + rest, data, n);
+        if (rest + n < 64)
+            return;
+        sha1NiBlocks(words.h, state->buffer, 1);
+        data += n;
+        length -= n;
+    }
+    sha1NiBlocks(words.h, data, length / 64);
+    words.store(*state);
+    memcpy(state->buffer, data + (length & ~Q_INT64_C(63)), length & 63);
+}
+
+void sha1NiFinalize(Sha1State *state) noexcept
+{
+    uchar tail[128];
+    const qsizetype blocks = shaPadding(tail, state->buffer, qsizetype(state->messageSize & 63),
+                                        state->messageSize << 3);
+    Sha1Words words(*state);
+    sha1NiBlocks(words.h, tail, blocks);
+    words.store(*state);
+}
+
+void sha256NiInput(SHA256Context *context, const uchar *data, qsizetype length) noexcept
+{
+    if (!length || context->Computed || context->Corrupted) {
+        // let the reference implementation deal with the error states
+        SHA256Input(context, data, uint(length));
+        return;
+    }
+    const quint64 bitCount = (quint64(context->Length_High) << 32) | context->Length_Low;
+    const quint64 newBitCount = bitCount + quint64(length) * 8;
+    if (newBitCount < bitCount)
+        context->Corrupted = shaInputTooLong;
+    context->Length_High = uint32_t(newBitCount >> 32);
+    context->Length_Low = uint32_t(newBitCount);
+
+    const qsizetype rest = context->Message_Block_Index;
+    if (rest) {
+        const qsizetype n = qMin(64 - rest, length);
+        memcpy(context->Message_Block + rest, data, n);
+        context->Message_Block_Index = int_least16_t(rest + n);
+        if (rest + n < 64)
+            return;
+        sha256NiBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+        data += n;
+        length -= n;
+    }
+    sha256NiBlocks(context->Intermediate_Hash, data, length / 64);
+    memcpy(context->Message_Block, data + (length & ~qsizetype(63)), length & 63);
+    context->Message_Block_Index = int_least16_t(length & 63);
+}
+
+void sha256NiFinalize(SHA256Context *context) noexcept
+{
+    if (context->Computed || context->Corrupted)
+        return;
+    uchar tail[128];
+    const quint64 bitCount = (quint64(context->Length_High) << 32) | context->Length_Low;
+    const qsizetype blocks = shaPadding(tail, context->Message_Block,
+                                        context->Message_Block_Index, bitCount);
+    sha256NiBlocks(context->Intermediate_Hash, tail, blocks);
+    context->Computed = 1;
+}
+
+// A message as the sequence of its complete blocks followed by the padded tail
+class ShaNiMessage
+{
+public:
+    explicit ShaNiMessage(QByteArrayView message) noexcept
+        : data(reinterpret_cast<const uchar *>(message.data())),
+          dataBlocks(message.size() / 64),
+          blocks(dataBlocks + shaPadding(tail, data + dataBlocks * 64, message.size() & 63,
+                                         quint64(message.size()) << 3))
+    {}
+
+    bool atEnd() const noexcept { return position == blocks; }
+    const uchar *current() const noexcept
+    { return position < dataBlocks ? data + position * 64 : tail + (position - dataBlocks) * 64; }
+    qsizetype available() const noexcept
+    { return position < dataBlocks ? dataBlocks - position : blocks - position; }
+    void advance(qsizetype count) noexcept { position += count; }
+
+private:
+    uchar tail[128];
+    const uchar *data;
+    qsizetype dataBlocks;
+    qsizetype blocks;
+    qsizetype position = 0;
+};
+
+using ShaNiBlocks = void (*)(quint32 *, const uchar *, qsizetype);
+using ShaNiBlocks2 = void (*)(quint32 *, const uchar *, quint32 *, const uchar *, qsizetype);
+
+void shaNiHash(quint32 *h, ShaNiMessage &message, ShaNiBlocks process) noexcept
+{
+    while (!message.atEnd()) {
+        const qsizetype count = message.available();
+        process(h, message.current(), count);
+        message.advance(count);
+    }
+}
+
+void shaNiHash2(quint32 *h1, ShaNiMessage &message1, quint32 *h2, ShaNiMessage &message2,
+                ShaNiBlocks process, ShaNiBlocks2 process2) noexcept
+{
+    while (!message1.atEnd() && !message2.atEnd()) {
+        const qsizetype count = qMin(message1.available(), message2.available());
+        process2(h1, message1.current(), h2, message2.current(), count);
+        message1.advance(count);
+        message2.advance(count);
+    }
+    shaNiHash(h1, message1, process);
+    shaNiHash(h2, message2, process);
+}
+
+QList<QByteArray> shaNiHashMany(const QList<QByteArrayView> &messages,
+                                QCryptographicHash::Algorithm method)
+{
+    quint32 iv[8];
+    int words;
+    ShaNiBlocks process;
+    ShaNiBlocks2 process2;
+    if (method == QCryptographicHash::Sha1) {
+        Sha1State state;
+        sha1InitState(&state);
+        memcpy(iv, Sha1Words(state).h, sizeof(Sha1Words::h));
+        words = 5;
+        process = sha1NiBlocks;
+        process2 = sha1NiBlocks2;
+    } else {
+        SHA256Context context;
+        if (method == QCryptographicHash::Sha224)
+            SHA224Reset(&context);
+        else
+            SHA256Reset(&context);
+        memcpy(iv, context.Intermediate_Hash, sizeof(iv));
+        words = method == QCryptographicHash::Sha224 ? SHA224HashSize / 4 : SHA256HashSize / 4;
+        process = sha256NiBlocks;
+        process2 = sha256NiBlocks2;
+    }
+
+    QList<QByteArray> result;
+    result.reserve(messages.size());
+    const auto digest = [&](const quint32 *h) {
+        QByteArray hash(words * 4, Qt::Uninitialized);
+        for (int i = 0; i < words; ++i)
+            qToBigEndian(h[i], hash.data() + 4 * i);
+        result.append(std::move(hash));
+    };
+
+    qsizetype i = 0;
+    for ( ; i + 1 < messages.size(); i += 2) {
+        quint32 h1[8];
+        quint32 h2[8];
+        memcpy(h1, iv, sizeof(iv));
+        memcpy(h2, iv, sizeof(iv));
+        ShaNiMessage message1(messages.at(i));
+        ShaNiMessage message2(messages.at(i + 1));
+        shaNiHash2(h1, message1, h2, message2, process, process2);
+        digest(h1);
+        digest(h2);
+    }
+    if (i < messages.size()) {
+        ShaNiMessage message(messages.at(i));
+        shaNiHash(iv, message, process);
+        digest(iv);
+    }
+    return result;
+}
+} // unnamed namespace
+#endif // QT_CRYPTOGRAPHICHASH_SHA_NI
+
 template <size_t N>
 class QSmallByteArray
 {
@@ -846,6 +1259,12 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+            if (hasShaNi()) {
+                sha1NiUpdate(&sha1Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             sha1Update(&sha1Context, (const unsigned char *)data, length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -861,9 +1280,21 @@ void QCryptographicHashPrivate::State::addData(QCryptographicHash::Algorithm met
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+            if (hasShaNi()) {
+                sha256NiInput(&sha224Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha256:
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+            if (hasShaNi()) {
+                sha256NiInput(&sha256Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha384:
@@ -1025,6 +1456,11 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha1: {
         Sha1State copy = sha1Context;
         result.resizeForOverwrite(20);
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+        if (hasShaNi())
+            sha1NiFinalize(&copy);
+        else
+#endif
         sha1FinalizeState(&copy);
         sha1ToHash(&copy, result.data());
         break;
@@ -1050,12 +1486,20 @@ void QCryptographicHashPrivate::State::finalizeUnchecked(QCryptographicHash::Alg
     case QCryptographicHash::Sha224: {
         SHA224Context copy = sha224Context;
         result.resizeForOverwrite(SHA224HashSize);
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+        if (hasShaNi())
+            sha256NiFinalize(&copy);
+#endif
         SHA224Result(&copy, result.data());
         break;
     }
     case QCryptographicHash::Sha256: {
         SHA256Context copy = sha256Context;
         result.resizeForOverwrite(SHA256HashSize);
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+        if (hasShaNi())
+            sha256NiFinalize(&copy);
+#endif
         SHA256Result(&copy, result.data());
         break;
     }
@@ -1126,6 +1570,33 @@ QByteArray QCryptographicHash::hash(QByteArrayView data, Algorithm method)
     return hash.resultView().toByteArray();
 }
 
+/*!
+  \since 6.7
+
+  Returns the hashes of each of the \a messages using \a method, in the same
+  order as the messages.
+
+  This gives the same results as calling hash() for each message, but can be
+  considerably faster when hashing many small messages: for SHA-1, SHA-224 and
+  SHA-256, Qt can hash two messages at once on processors that have the SHA
+  instruction set extensions.
+
+  \sa hash()
+*/
+QList<QByteArray> QCryptographicHash::hashMany(const QList<QByteArrayView> &messages,
+                                               Algorithm method)
+{
+#ifdef QT_CRYPTOGRAPHICHASH_SHA_NI
+    if ((method == Sha1 || method == Sha224 || method == Sha256) && hasShaNi())
+        return shaNiHashMany(messages, method);
+#endif
+    QList<QByteArray> result;
+    result.reserve(messages.size());
+    for (QByteArrayView message : messages)
+        result.append(hash(message, method));
+    return result;
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -7,6 +7,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -91,6 +92,7 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QList<QByteArray> hashMany(const QList<QByteArrayView> &messages, Algorithm method);
     static int hashLength(Algorithm method);
     static bool supportsAlgorithm(Algorithm method);
 private:
@@ -0,0 +1,595 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDENSEHASH_H
+#define QDENSEHASH_H
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qsimd.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QDenseHashPrivate {
+
+// Every slot has a control byte: Empty, Deleted, or the lowest seven bits of
+// the hash of the key stored in it. The control bytes are matched a group at
+// a time, and a lookup stops at the first group that has an empty slot.
+enum Control : signed char {
+    Empty = -128,   // 0b1000'0000
+    Deleted = -2,   // 0b1111'1110
+};
+
+template <typename T, int Shift>
+struct BitMask
+{
+    T mask;
+
+    explicit operator bool() const noexcept { return mask != 0; }
+    qsizetype lowest() const noexcept { return qCountTrailingZeroBits(mask) >> Shift; }
+    void clearLowest() noexcept { mask &= mask - 1; }
+};
+
+#if QT_COMPILER_USES(sse2)
+struct Group
+{
+    static constexpr qsizetype Width = 16;
+    using Mask = BitMask<uint, 0>;
+
+    explicit Group(const signed char *bytes) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes)))
+    {}
+
+    Mask match(signed char h2) const noexcept
+    { return movemask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))); }
+    Mask matchEmpty() const noexcept
+    { return movemask(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(Empty))); }
+    Mask matchEmptyOrDeleted() const noexcept
+    { return movemask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)); }
+
+private:
+    static Mask movemask(__m128i v) noexcept { return Mask{ uint(_mm_movemask_epi8(v)) }; }
+    __m128i ctrl;
+};
+#elif QT_COMPILER_USES(neon) && defined(Q_PROCESSOR_ARM_64) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+struct Group
+{
+    static constexpr qsizetype Width = 8;
+    using Mask = BitMask<quint64, 3>;
+
+    explicit Group(const signed char *bytes) noexcept
+        : ctrl(vld1_s8(bytes))
+    {}
+
+    Mask match(signed char h2) const noexcept
+    { return toMask(vceq_s8(ctrl, vdup_n_s8(h2))); }
+    Mask matchEmpty() const noexcept
+    { return toMask(vceq_s8(ctrl, vdup_n_s8(Empty))); }
+    Mask matchEmptyOrDeleted() const noexcept
+    { return toMask(vcgt_s8(vdup_n_s8(-1), ctrl)); }
+
+private:
+    static Mask toMask(uint8x8_t v) noexcept
+    { return Mask{ vget_lane_u64(vreinterpret_u64_u8(v), 0) & 0x8080808080808080ULL }; }
+    int8x8_t ctrl;
+};
+#else
+// Eight control bytes in a word, matched with bit tricks. match() can report
+// a slot whose control byte differs from h2 when an earlier byte matched;
+// callers compare the keys anyway.
+struct Group
+{
+    static constexpr qsizetype Width = 8;
+    using Mask = BitMask<quint64, 3>;
+
+    explicit Group(const signed char *bytes) noexcept
+        : ctrl(qFromLittleEndian<quint64>(bytes))
+    {}
+
+    Mask match(signed char h2) const noexcept
+    {
+        const quint64 x = ctrl ^ (Lsbs * uchar(h2));
+        return Mask{ (x - Lsbs) & ~x & Msbs };
+    }
+    Mask matchEmpty() const noexcept
+    { return Mask{ ctrl & ~(ctrl << 6) & Msbs }; }
+    Mask matchEmptyOrDeleted() const noexcept
+    { return Mask{ ctrl & ~(ctrl << 7) & Msbs }; }
+
+private:
+    static constexpr quint64 Lsbs = 0x0101010101010101ULL;
+    static constexpr quint64 Msbs = 0x8080808080808080ULL;
+    quint64 ctrl;
+};
+#endif
+
+// The groups of a table, in the order a key with the given hash visits
+// them. Groups are aligned to Group::Width; the triangular steps visit all
+// of them since their number is a power of two.
+struct ProbeSequence
+{
+    ProbeSequence(size_t hash, qsizetype capacity) noexcept
+        : mask(capacity / Group::Width - 1), group(qsizetype(hash >> 7) & mask)
+    {}
+
+    qsizetype offset() const noexcept { return group * Group::Width; }
+    void next() noexcept { group = (group + ++step) & mask; }
+
+    qsizetype mask;
+    qsizetype group;
+    qsizetype step = 0;
+};
+
+inline signed char h2(size_t hash) noexcept { return static_cast<signed char>(hash & 0x7f); }
+
+template <typename Key, typename T>
+struct Node
+{
+    Key key;
+    T value;
+
+    template <typename K, typename... Args>
+    Node(K &&k, Args &&...args)
+        : key(std::forward<K>(k)), value(std::forward<Args>(args)...)
+    {}
+};
+
+} // namespace QDenseHashPrivate
+
+template <typename Key, typename T>
+class QDenseHash
+{
+    using Node = QDenseHashPrivate::Node<Key, T>;
+    using Group = QDenseHashPrivate::Group;
+    using ProbeSequence = QDenseHashPrivate::ProbeSequence;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = T;
+    using size_type = qsizetype;
+    using difference_type = qptrdiff;
+    using reference = T &;
+    using const_reference = const T &;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QDenseHash;
+        friend class const_iterator;
+
+        QDenseHash *h = nullptr;
+        qsizetype i = 0;
+
+        iterator(QDenseHash *hash, qsizetype index) noexcept : h(hash), i(index) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+
+        constexpr iterator() noexcept = default;
+
+        const Key &key() const noexcept { return h->nodes[i].key; }
+        T &value() const noexcept { return h->nodes[i].value; }
+        T &operator*() const noexcept { return h->nodes[i].value; }
+        T *operator->() const noexcept { return &h->nodes[i].value; }
+
+        iterator &operator++() noexcept
+        {
+            i = h->nextOccupied(i + 1);
+            return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept
+        { return lhs.h == rhs.h && lhs.i == rhs.i; }
+        friend bool operator!=(const iterator &lhs, const iterator &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    class const_iterator
+    {
+        friend class QDenseHash;
+
+        const QDenseHash *h = nullptr;
+        qsizetype i = 0;
+
+        const_iterator(const QDenseHash *hash, qsizetype index) noexcept : h(hash), i(index) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = const T *;
+        using reference = const T &;
+
+        constexpr const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : h(o.h), i(o.i) {}
+
+        const Key &key() const noexcept { return h->nodes[i].key; }
+        const T &value() const noexcept { return h->nodes[i].value; }
+        const T &operator*() const noexcept { return h->nodes[i].value; }
+        const T *operator->() const noexcept { return &h->nodes[i].value; }
+
+        const_iterator &operator++() noexcept
+        {
+            i = h->nextOccupied(i + 1);
+            return *this;
+        }
+        const_iterator operator++(int) noexcept
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return lhs.h == rhs.h && lhs.i == rhs.i; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    using Iterator = iterator;
+    using ConstIterator = const_iterator;
+
+    QDenseHash() noexcept = default;
+    QDenseHash(std::initializer_list<std::pair<Key, T>> list)
+        : QDenseHash()
+    {
+        reserve(qsizetype(list.size()));
+        for (const auto &[key, value] : list)
+            insert(key, value);
+    }
+    QDenseHash(const QDenseHash &other)
+        : QDenseHash()
+    {
+        if (other.isEmpty())
+            return;
+        // same layout, deleted slots included, so that lookups probe alike
+        allocate(other.cap);
+        for (qsizetype i = 0; i < cap; ++i) {
+            if (other.ctrl[i] >= 0)
+                new (nodes + i) Node(std::as_const(other.nodes[i]));
+            ctrl[i] = other.ctrl[i];
+        }
+        sz = other.sz;
+        growthLeft = other.growthLeft;
+    }
+    QDenseHash(QDenseHash &&other) noexcept
+        : ctrl(std::exchange(other.ctrl, nullptr)),
+          nodes(std::exchange(other.nodes, nullptr)),
+          cap(std::exchange(other.cap, 0)),
+          sz(std::exchange(other.sz, 0)),
+          growthLeft(std::exchange(other.growthLeft, 0))
+    {}
+    QDenseHash &operator=(const QDenseHash &other)
+    {
+        if (this != &other) {
+            QDenseHash copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QDenseHash)
+    ~QDenseHash()
+    {
+        destroyNodes();
+        deallocate();
+    }
+
+    void swap(QDenseHash &other) noexcept
+    {
+        qt_ptr_swap(ctrl, other.ctrl);
+        qt_ptr_swap(nodes, other.nodes);
+        std::swap(cap, other.cap);
+        std::swap(sz, other.sz);
+        std::swap(growthLeft, other.growthLeft);
+    }
+
+    qsizetype size() const noexcept { return sz; }
+    qsizetype count() const noexcept { return sz; }
+    bool isEmpty() const noexcept { return sz == 0; }
+    bool empty() const noexcept { return sz == 0; }
+    qsizetype capacity() const noexcept { return cap; }
+
+    void reserve(qsizetype size)
+    {
+        const qsizetype needed = capacityForSize(size);
+        if (needed > cap)
+            rehash(needed);
+    }
+    void squeeze()
+    {
+        const qsizetype needed = sz ? capacityForSize(sz) : 0;
+        if (needed < cap)
+            rehash(needed);
+    }
+    void clear() noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        destroyNodes();
+        deallocate();
+    }
+
+    bool contains(const Key &key) const noexcept { return findIndex(key) >= 0; }
+
+    T value(const Key &key) const noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return i >= 0 ? nodes[i].value : T();
+    }
+    T value(const Key &key, const T &defaultValue) const noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return i >= 0 ? nodes[i].value : defaultValue;
+    }
+    T &operator[](const Key &key) { return *tryEmplace(key).first; }
+    const T operator[](const Key &key) const noexcept { return value(key); }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        auto [it, inserted] = tryEmplace(key, value);
+        if (!inserted)
+            *it = value;
+        return it;
+    }
+    template <typename... Args>
+    iterator emplace(const Key &key, Args &&...args)
+    { return emplace(Key(key), std::forward<Args>(args)...); }
+    template <typename... Args>
+    iterator emplace(Key &&key, Args &&...args)
+    {
+        auto [it, inserted] = tryEmplace(std::move(key), std::forward<Args>(args)...);
+        if (!inserted)
+            *it = T(std::forward<Args>(args)...);
+        return it;
+    }
+
+    bool remove(const Key &key)
+    {
+        const qsizetype i = findIndex(key);
+        if (i < 0)
+            return false;
+        eraseAt(i);
+        return true;
+    }
+    T take(const Key &key)
+    {
+        const qsizetype i = findIndex(key);
+        if (i < 0)
+            return T();
+        T t = std::move(nodes[i].value);
+        eraseAt(i);
+        return t;
+    }
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it.h == this && it.i < cap && ctrl[it.i] >= 0);
+        eraseAt(it.i);
+        return iterator(this, nextOccupied(it.i + 1));
+    }
+
+    iterator find(const Key &key) noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return i >= 0 ? iterator(this, i) : end();
+    }
+    const_iterator find(const Key &key) const noexcept { return constFind(key); }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        const qsizetype i = findIndex(key);
+        return i >= 0 ? const_iterator(this, i) : constEnd();
+    }
+
+    iterator begin() noexcept { return iterator(this, nextOccupied(0)); }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator constBegin() const noexcept { return const_iterator(this, nextOccupied(0)); }
+    iterator end() noexcept { return iterator(this, cap); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constEnd() const noexcept { return const_iterator(this, cap); }
+
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(sz);
+        for (auto it = begin(); it != end(); ++it)
+            result.append(it.key());
+        return result;
+    }
+    QList<T> values() const
+    {
+        QList<T> result;
+        result.reserve(sz);
+        for (auto it = begin(); it != end(); ++it)
+            result.append(it.value());
+        return result;
+    }
+
+    friend bool operator==(const QDenseHash &lhs, const QDenseHash &rhs)
+    {
+        if (lhs.sz != rhs.sz)
+            return false;
+        for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+            const qsizetype i = rhs.findIndex(it.key());
+            if (i < 0 || !(rhs.nodes[i].value == it.value()))
+                return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const QDenseHash &lhs, const QDenseHash &rhs)
+    { return !(lhs == rhs); }
+
+private:
+    static constexpr size_t alignment() noexcept
+    { return qMax(alignof(Node), size_t(Group::Width)); }
+    static constexpr qsizetype nodeOffset(qsizetype capacity) noexcept
+    { return (capacity + qsizetype(alignof(Node)) - 1) & ~(qsizetype(alignof(Node)) - 1); }
+    // tables are at most 7/8 full, so that lookups end soon
+    static constexpr qsizetype maxLoad(qsizetype capacity) noexcept
+    { return capacity - capacity / 8; }
+    static qsizetype capacityForSize(qsizetype size) noexcept
+    {
+        qsizetype capacity = Group::Width;
+        while (maxLoad(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+
+    static size_t hashOf(const Key &key)
+    { return QHashPrivate::calculateHash(key, QHashSeed::globalSeed()); }
+
+    qsizetype nextOccupied(qsizetype i) const noexcept
+    {
+        while (i < cap && ctrl[i] < 0)
+            ++i;
+        return i;
+    }
+
+    qsizetype findIndex(const Key &key) const noexcept
+    {
+        if (!cap)
+            return -1;
+        const size_t hash = hashOf(key);
+        const signed char h2 = QDenseHashPrivate::h2(hash);
+        for (ProbeSequence seq(hash, cap); ; seq.next()) {
+            const Group group(ctrl + seq.offset());
+            for (auto m = group.match(h2); m; m.clearLowest()) {
+                const qsizetype i = seq.offset() + m.lowest();
+                if (nodes[i].key == key)
+                    return i;
+            }
+            if (group.matchEmpty())
+                return -1;
+        }
+    }
+
+    qsizetype findFreeSlot(size_t hash) const noexcept
+    {
+        for (ProbeSequence seq(hash, cap); ; seq.next()) {
+            const Group group(ctrl + seq.offset());
+            if (auto m = group.matchEmptyOrDeleted())
+                return seq.offset() + m.lowest();
+        }
+    }
+
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args)
+    {
+        qsizetype i = findIndex(key);
+        if (i >= 0)
+            return { iterator(this, i), false };
+
+        if (!growthLeft) {
+            // with many deleted slots, clean them up instead of growing
+            rehash(!cap ? Group::Width : sz * 32 <= cap * 25 ? cap : cap * 2);
+        }
+        const size_t hash = hashOf(key);
+        i = findFreeSlot(hash);
+        new (nodes + i) Node(std::forward<K>(key), std::forward<Args>(args)...);
+        if (ctrl[i] == QDenseHashPrivate::Empty)
+            --growthLeft;
+        ctrl[i] = QDenseHashPrivate::h2(hash);
+        ++sz;
+        return { iterator(this, i), true };
+    }
+
+    void eraseAt(qsizetype i) noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        nodes[i].~Node();
+        --sz;
+        // if this group has an empty slot, no lookup ever went past it, so
+        // this slot can become empty too
+        const qsizetype groupStart = i & ~(Group::Width - 1);
+        if (Group(ctrl + groupStart).matchEmpty()) {
+            ctrl[i] = QDenseHashPrivate::Empty;
+            ++growthLeft;
+        } else {
+            ctrl[i] = QDenseHashPrivate::Deleted;
+        }
+    }
+
+    void allocate(qsizetype capacity)
+    {
+        Q_ASSERT(capacity >= Group::Width && !(capacity & (capacity - 1)));
+        const size_t bytes = size_t(nodeOffset(capacity)) + size_t(capacity) * sizeof(Node);
+        void *memory = ::operator new(bytes, std::align_val_t(alignment()));
+        ctrl = static_cast<signed char *>(memory);
+        nodes = reinterpret_cast<Node *>(ctrl + nodeOffset(capacity));
+        memset(ctrl, QDenseHashPrivate::Empty, size_t(capacity));
+        cap = capacity;
+        sz = 0;
+        growthLeft = maxLoad(capacity);
+    }
+
+    void deallocate() noexcept
+    {
+        if (ctrl)
+            ::operator delete(ctrl, std::align_val_t(alignment()));
+        ctrl = nullptr;
+        nodes = nullptr;
+        cap = 0;
+        sz = 0;
+        growthLeft = 0;
+    }
+
+    void destroyNodes() noexcept(std::is_nothrow_destructible_v<Node>)
+    {
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            for (qsizetype i = 0; i < cap; ++i) {
+                if (ctrl[i] >= 0)
+                    nodes[i].~Node();
+            }
+        }
+    }
+
+    void rehash(qsizetype capacity)
+    {
+        QDenseHash old;
+        swap(old);
+        if (!capacity)
+            return;
+        allocate(capacity);
+        for (qsizetype j = 0; j < old.cap; ++j) {
+            if (old.ctrl[j] < 0)
+                continue;
+            Node &n = old.nodes[j];
+            const size_t hash = hashOf(n.key);
+            const qsizetype i = findFreeSlot(hash);
+            new (nodes + i) Node(std::move(n));
+            n.~Node();
+            old.ctrl[j] = QDenseHashPrivate::Deleted;
+            ctrl[i] = QDenseHashPrivate::h2(hash);
+            ++sz;
+            --growthLeft;
+        }
+    }
+
+    signed char *ctrl = nullptr;
+    Node *nodes = nullptr;
+    qsizetype cap = 0;
+    qsizetype sz = 0;
+    qsizetype growthLeft = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDENSEHASH_H
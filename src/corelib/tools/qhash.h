@@ -10,6 +10,7 @@
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qiterator.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qmonotonicarena.h>
 #include <QtCore/qrefcount.h>
 
 #include <initializer_list>
@@ -254,6 +255,7 @@ struct Span {
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
+    bool entriesInArena = false;
     Span() noexcept
     {
         memset(offsets, SpanConstants::UnusedEntry, sizeof(offsets));
@@ -271,7 +273,7 @@ struct Span {
                         entries[o].node().~Node();
                 }
             }
-            delete[] entries;
+            freeEntries(entries, entriesInArena);
             entries = nullptr;
         }
     }
@@ -391,7 +393,8 @@ struct Span {
             alloc = SpanConstants::NEntries / 8 * 5;
         else
             alloc = allocated + SpanConstants::NEntries/8;
-        Entry *newEntries = new Entry[alloc];
+        bool newEntriesInArena;
+        Entry *newEntries = allocateEntries(alloc, newEntriesInArena);
         // we only add storage if the previous storage was fully filled, so
         // simply copy the old data over
         if constexpr (isRelocatable<Node>()) {
@@ -406,10 +409,25 @@ struct Span {
         for (size_t i = allocated; i < alloc; ++i) {
             newEntries[i].nextFree() = uchar(i + 1);
         }
-        delete[] entries;
+        freeEntries(entries, entriesInArena);
         entries = newEntries;
+        entriesInArena = newEntriesInArena;
         allocated = uchar(alloc);
     }
+
+    static Entry *allocateEntries(size_t count, bool &inArena)
+    {
+        void *memory = QtPrivate::qArenaAllocate(count * sizeof(Entry), alignof(Entry));
+        inArena = memory != nullptr;
+        return inArena ? static_cast<Entry *>(memory) : new Entry[count];
+    }
+    static void freeEntries(Entry *entries, bool inArena) noexcept
+    {
+        if (inArena)
+            QtPrivate::qArenaFree(entries);
+        else
+            delete[] entries;
+    }
 };
 
 // QHash uses a power of two growth policy.
@@ -452,6 +470,7 @@ struct Data
     using iterator = QHashPrivate::iterator<Node>;
 
     QtPrivate::RefCount ref = {{1}};
+    bool spansInArena = false;
     size_t size = 0;
     size_t numBuckets = 0;
     size_t seed = 0;
@@ -536,6 +555,7 @@ struct Data
         struct R {
             Span *spans;
             size_t nSpans;
+            bool inArena;
         };
 
         constexpr qptrdiff MaxSpanCount = (std::numeric_limits<qptrdiff>::max)() / sizeof(Span);
@@ -547,13 +567,33 @@ struct Data
         }
 
         size_t nSpans = numBuckets >> SpanConstants::SpanShift;
-        return R{ new Span[nSpans], nSpans };
+        if (void *memory = QtPrivate::qArenaAllocate(nSpans * sizeof(Span), alignof(Span))) {
+            Span *spans = static_cast<Span *>(memory);
+            for (size_t i = 0; i < nSpans; ++i)
+                new (spans + i) Span;
+            return R{ spans, nSpans, true };
+        }
+        return R{ new Span[nSpans], nSpans, false };
+    }
+
+    static void freeSpans(Span *spans, size_t nSpans, bool inArena)
+            noexcept(std::is_nothrow_destructible<Node>::value)
+    {
+        if (!inArena) {
+            delete[] spans;
+            return;
+        }
+        for (size_t i = 0; i < nSpans; ++i)
+            spans[i].~Span();
+        QtPrivate::qArenaFree(spans);
     }
 
     Data(size_t reserve = 0)
     {
         numBuckets = GrowthPolicy::bucketsForCapacity(reserve);
-        spans = allocateSpans(numBuckets).spans;
+        auto r = allocateSpans(numBuckets);
+        spans = r.spans;
+        spansInArena = r.inArena;
         seed = QHashSeed::globalSeed();
     }
 
@@ -577,12 +617,15 @@ struct Data
     {
         auto r = allocateSpans(numBuckets);
         spans = r.spans;
+        spansInArena = r.inArena;
         reallocationHelper(other, r.nSpans, false);
     }
     Data(const Data &other, size_t reserved) : size(other.size), seed(other.seed)
     {
         numBuckets = GrowthPolicy::bucketsForCapacity(qMax(size, reserved));
-        spans = allocateSpans(numBuckets).spans;
+        auto r = allocateSpans(numBuckets);
+        spans = r.spans;
+        spansInArena = r.inArena;
         size_t otherNSpans = other.numBuckets >> SpanConstants::SpanShift;
         reallocationHelper(other, otherNSpans, true);
     }
@@ -608,7 +651,7 @@ struct Data
 
     void clear()
     {
-        delete[] spans;
+        freeSpans(spans, numBuckets >> SpanConstants::SpanShift, spansInArena);
         spans = nullptr;
         size = 0;
         numBuckets = 0;
@@ -640,7 +683,10 @@ struct Data
 
         Span *oldSpans = spans;
         size_t oldBucketCount = numBuckets;
-        spans = allocateSpans(newBucketCount).spans;
+        const bool oldSpansInArena = spansInArena;
+        auto r = allocateSpans(newBucketCount);
+        spans = r.spans;
+        spansInArena = r.inArena;
         numBuckets = newBucketCount;
         size_t oldNSpans = oldBucketCount >> SpanConstants::SpanShift;
 
@@ -657,7 +703,7 @@ struct Data
             }
             span.freeData();
         }
-        delete[] oldSpans;
+        freeSpans(oldSpans, oldNSpans, oldSpansInArena);
     }
 
     size_t nextBucket(size_t bucket) const noexcept
@@ -767,7 +813,7 @@ struct Data
 
     ~Data()
     {
-        delete [] spans;
+        freeSpans(spans, numBuckets >> SpanConstants::SpanShift, spansInArena);
     }
 };
 
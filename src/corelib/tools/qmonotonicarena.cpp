@@ -0,0 +1,253 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qmonotonicarena.h"
+
+#include <QtCore/qassert.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qminmax.h>
+
+#include <cstddef>
+#include <stdlib.h>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMonotonicArena
+    \inmodule QtCore
+    \since 6.7
+    \reentrant
+
+    \brief The QMonotonicArena class lets the containers of a thread allocate
+    from memory blocks that are released in one go.
+
+    While a QMonotonicArena exists, it is the current arena of the thread that
+    created it, and QList, QString, QByteArray and QHash take the memory for
+    their elements from it instead of from the heap. The arena hands the
+    memory out by advancing a pointer through blocks of blockSize() bytes,
+    which is much cheaper than \c malloc() and \c free() for the many small,
+    short-lived containers that processing a single request or a single frame
+    often creates:
+
+    \code
+    void Server::handle(const Request &request)
+    {
+        QMonotonicArena arena;
+        const QList<QByteArray> headers = request.headers();
+        QHash<QByteArray, QByteArray> fields;
+        ...
+    } // all of the above is released here
+    \endcode
+
+    Memory that a container frees is only reused if it was the last piece the
+    arena handed out, as is the case with a list that grows; otherwise it
+    stays in use until the whole block it belongs to is released. A block is
+    released once the arena has moved on to the next one, or was destroyed,
+    and all containers that allocated from it have freed their memory. It is
+    therefore safe to let containers outlive the arena, or to pass them to
+    other threads, but the memory of the block they use is not returned to the
+    system before they are gone.
+
+    Allocations larger than a quarter of blockSize() are left to the heap.
+
+    Arenas nest: the most recently created one is the current arena of its
+    thread, until it is destroyed. Arenas must be destroyed on the thread that
+    created them, in the reverse order of their creation, which is what
+    happens naturally when they are local variables.
+
+    \sa current()
+*/
+
+Q_CONSTINIT static thread_local QMonotonicArena *currentArena = nullptr;
+
+// the number of arenas that exist on any thread, so that allocating does not
+// have to look at the thread-local variable while no arena is in use
+Q_CONSTINIT static QBasicAtomicInt arenaCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+struct alignas(std::max_align_t) QMonotonicArena::Block
+{
+    // allocations that are still in use, plus one while the arena allocates from this block
+    QBasicAtomicInt live;
+};
+
+struct QMonotonicArenaAllocator
+{
+    using Block = QMonotonicArena::Block;
+
+    struct alignas(std::max_align_t) Header
+    {
+        Block *block;
+        size_t size;
+    };
+
+    static char *alignUp(char *p, size_t alignment) noexcept
+    {
+        return reinterpret_cast<char *>((quintptr(p) + alignment - 1) & ~quintptr(alignment - 1));
+    }
+
+    static Header *headerOf(void *ptr) noexcept
+    {
+        return static_cast<Header *>(ptr) - 1;
+    }
+
+    // Returns true if ptr is the last allocation of an arena of this thread
+    static bool isTopOf(QMonotonicArena *arena, void *ptr) noexcept
+    {
+        const Header *header = headerOf(ptr);
+        return arena && arena->m_block == header->block
+                && static_cast<char *>(ptr) + header->size == arena->m_cursor;
+    }
+
+    static void release(Block *block) noexcept
+    {
+        if (!block->live.deref())
+            ::free(block);
+    }
+
+    static bool addBlock(QMonotonicArena *arena) noexcept
+    {
+        auto block = static_cast<Block *>(::malloc(sizeof(Block) + size_t(arena->m_blockSize)));
+        if (!block)
+            return false;
+        block->live.storeRelaxed(1);
+        if (arena->m_block)
+            release(arena->m_block);
+        arena->m_block = block;
+        arena->m_cursor = reinterpret_cast<char *>(block + 1);
+        arena->m_limit = arena->m_cursor + arena->m_blockSize;
+        return true;
+    }
+
+    static void *allocate(QMonotonicArena *arena, size_t size, size_t alignment) noexcept
+    {
+        alignment = qMax(alignment, alignof(Header));
+        if (size > size_t(arena->m_blockSize) / 4
+            || sizeof(Header) + alignment + size > size_t(arena->m_blockSize)) {
+            return nullptr;
+        }
+
+        char *p = nullptr;
+        if (arena->m_block)
+            p = alignUp(arena->m_cursor + sizeof(Header), alignment);
+        if (!p || arena->m_limit - p < qptrdiff(size)) {
+            if (!addBlock(arena))
+                return nullptr;
+            p = alignUp(arena->m_cursor + sizeof(Header), alignment);
+        }
+
+        Header *header = headerOf(p);
+        header->block = arena->m_block;
+        header->size = size;
+        arena->m_block->live.ref();
+        arena->m_cursor = p + size;
+        arena->m_bytesAllocated += qsizetype(size);
+        return p;
+    }
+
+    static void *reallocate(void *ptr, size_t size, bool *inArena) noexcept
+    {
+        Header *header = headerOf(ptr);
+
+        // resize in place if nothing was allocated after it
+        QMonotonicArena *arena = currentArena;
+        if (isTopOf(arena, ptr) && size <= size_t(arena->m_limit - static_cast<char *>(ptr))) {
+            if (size > header->size)
+                arena->m_bytesAllocated += qsizetype(size - header->size);
+            arena->m_cursor = static_cast<char *>(ptr) + size;
+            header->size = size;
+            *inArena = true;
+            return ptr;
+        }
+
+        void *result = QtPrivate::qArenaAllocate(size, alignof(Header));
+        *inArena = result != nullptr;
+        if (!result)
+            result = ::malloc(size);
+        if (!result)
+            return nullptr;
+        memcpy(result, ptr, qMin(size, header->size));
+        free(ptr);
+        return result;
+    }
+
+    static void free(void *ptr) noexcept
+    {
+        Header *header = headerOf(ptr);
+        Block *block = header->block;
+
+        // the last allocation can be handed out again
+        QMonotonicArena *arena = currentArena;
+        if (isTopOf(arena, ptr))
+            arena->m_cursor = reinterpret_cast<char *>(header);
+        release(block);
+    }
+};
+
+/*!
+    Creates an arena that allocates blocks of \a blockSize bytes and makes it
+    the current arena of the calling thread.
+*/
+QMonotonicArena::QMonotonicArena(qsizetype blockSize)
+    : m_previous(currentArena), m_blockSize(qMax(blockSize, qsizetype(1024)))
+{
+    currentArena = this;
+    arenaCount.ref();
+}
+
+/*!
+    Makes the arena that was current before this one was created the current
+    arena again, and releases the blocks that are not in use anymore.
+*/
+QMonotonicArena::~QMonotonicArena()
+{
+    Q_ASSERT_X(currentArena == this, "QMonotonicArena",
+               "Arenas must be destroyed on their thread, in reverse order of creation");
+    currentArena = m_previous;
+    arenaCount.deref();
+    if (m_block)
+        QMonotonicArenaAllocator::release(m_block);
+}
+
+/*!
+    \fn qsizetype QMonotonicArena::blockSize() const
+
+    Returns the size of the blocks this arena allocates from the heap.
+*/
+
+/*!
+    \fn qsizetype QMonotonicArena::bytesAllocated() const
+
+    Returns the number of bytes that containers have allocated from this arena
+    so far.
+*/
+
+/*!
+    Returns the current arena of the calling thread, or \nullptr if it has
+    none.
+*/
+QMonotonicArena *QMonotonicArena::current() noexcept
+{
+    return currentArena;
+}
+
+void *QtPrivate::qArenaAllocate(size_t size, size_t alignment) noexcept
+{
+    if (!arenaCount.loadRelaxed())
+        return nullptr;
+    QMonotonicArena *arena = currentArena;
+    return arena ? QMonotonicArenaAllocator::allocate(arena, size, alignment) : nullptr;
+}
+
+void *QtPrivate::qArenaReallocate(void *ptr, size_t size, bool *inArena) noexcept
+{
+    return QMonotonicArenaAllocator::reallocate(ptr, size, inArena);
+}
+
+void QtPrivate::qArenaFree(void *ptr) noexcept
+{
+    if (ptr)
+        QMonotonicArenaAllocator::free(ptr);
+}
+
+QT_END_NAMESPACE
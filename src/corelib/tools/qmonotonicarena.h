@@ -0,0 +1,52 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QMONOTONICARENA_H
+#define QMONOTONICARENA_H
+
+#include <QtCore/qtcoreexports.h>
+#include <QtCore/qtypes.h>
+#include <QtCore/qtclasshelpermacros.h>
+
+#include <stddef.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QMonotonicArena
+{
+public:
+    explicit QMonotonicArena(qsizetype blockSize = 64 * 1024);
+    ~QMonotonicArena();
+
+    qsizetype blockSize() const noexcept { return m_blockSize; }
+    qsizetype bytesAllocated() const noexcept { return m_bytesAllocated; }
+
+    static QMonotonicArena *current() noexcept;
+
+private:
+    Q_DISABLE_COPY_MOVE(QMonotonicArena)
+
+    struct Block;
+    friend struct QMonotonicArenaAllocator;
+
+    Block *m_block = nullptr;
+    char *m_cursor = nullptr;
+    char *m_limit = nullptr;
+    QMonotonicArena *m_previous = nullptr;
+    qsizetype m_blockSize;
+    qsizetype m_bytesAllocated = 0;
+};
+
+namespace QtPrivate {
+// Memory from the current thread's QMonotonicArena. qArenaAllocate() returns
+// nullptr if there is none, or if the request is too large for it; callers
+// fall back to malloc() then. qArenaReallocate() and qArenaFree() may be
+// called on any thread.
+[[nodiscard]] Q_CORE_EXPORT void *qArenaAllocate(size_t size, size_t alignment) noexcept;
+[[nodiscard]] Q_CORE_EXPORT void *qArenaReallocate(void *ptr, size_t size, bool *inArena) noexcept;
+Q_CORE_EXPORT void qArenaFree(void *ptr) noexcept;
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QMONOTONICARENA_H
@@ -71,6 +71,25 @@ const char *QRingBuffer::readPointerAtPosition(qint64 pos, qint64 &length) const
     return nullptr;
 }
 
+/*!
+    \internal
+
+    Stores the contiguous blocks of data the buffer consists of, starting at
+    its beginning, in \a blocks, at most \a maxCount of them. Returns the
+    number of blocks stored.
+*/
+qsizetype QRingBuffer::readBlocks(QByteArrayView *blocks, qsizetype maxCount) const
+{
+    qsizetype count = 0;
+    for (const QRingChunk &chunk : buffers) {
+        if (count == maxCount)
+            break;
+        if (chunk.size() > 0)
+            blocks[count++] = QByteArrayView(chunk.data(), chunk.size());
+    }
+    return count;
+}
+
 void QRingBuffer::free(qint64 bytes)
 {
     Q_ASSERT(bytes <= bufferSize);
@@ -92,9 +92,17 @@ static bool initialize()
 
 bool _tracepoint_enabled(const QCtfTracePointEvent &point)
 {
-    if (!initialize())
+    if (!initialize()) {
+        // Only remember the answer once loading can no longer be retried
+        if (s_triedLoading || s_shutdown)
+            point.state.storeRelaxed(QCtfTracePointEvent::Disabled);
         return false;
-    return s_plugin ? s_plugin->tracepointEnabled(point) : false;
+    }
+    // The session configuration is fixed once it has been loaded
+    const bool enabled = s_plugin ? s_plugin->tracepointEnabled(point) : false;
+    point.state.storeRelaxed(enabled ? QCtfTracePointEvent::Enabled
+                                     : QCtfTracePointEvent::Disabled);
+    return enabled;
 }
 
 void _do_tracepoint(const QCtfTracePointEvent &point, const QByteArray &arr)
@@ -18,6 +18,7 @@
 
 #include <qtcoreexports.h>
 #include <qobject.h>
+#include <qatomic.h>
 
 QT_REQUIRE_CONFIG(library);
 
@@ -56,6 +57,10 @@ struct Q_CORE_EXPORT QCtfTracePointEvent
     const QString metadata;
     const int size;
     const bool variableSize;
+    // Whether the tracepoint is enabled, cached after the first query so
+    // that disabled tracepoints cost a single relaxed load.
+    enum State { Unknown, Disabled, Enabled };
+    mutable QBasicAtomicInt state = Q_BASIC_ATOMIC_INITIALIZER(Unknown);
 
     QCtfTracePointEvent(const QCtfTracePointProvider &provider, const QString &name, const QString &metadata, int size, bool variableSize)
         : provider(provider), eventName(name), metadata(metadata), size(size), variableSize(variableSize)
@@ -70,6 +75,17 @@ Q_CORE_EXPORT bool _tracepoint_enabled(const QCtfTracePointEvent &point);
 Q_CORE_EXPORT void _do_tracepoint(const QCtfTracePointEvent &point, const QByteArray &arr);
 Q_CORE_EXPORT QCtfTracePointPrivate *_initialize_tracepoint(const QCtfTracePointEvent &point);
 
+inline bool _tracepoint_enabled_cached(const QCtfTracePointEvent &point)
+{
+    switch (point.state.loadRelaxed()) {
+    case QCtfTracePointEvent::Disabled:
+        return false;
+    case QCtfTracePointEvent::Enabled:
+        return true;
+    }
+    return _tracepoint_enabled(point);
+}
+
 #ifndef BUILD_LIBRARY
 #include <QtCore/qbytearray.h>
 #include <QtCore/qstring.h>
@@ -198,7 +214,7 @@ inline QByteArray toByteArrayFromFlags(QFlags<T> value)
     _DEFINE_METADATA(provider, name, metadata)
 
 #define tracepoint_enabled(provider, event) \
-    _tracepoint_enabled(_ctf_ ## event)
+    Q_UNLIKELY(_tracepoint_enabled_cached(_ctf_ ## event))
 
 #define do_tracepoint(provider, event, ...)         \
 {                                                   \
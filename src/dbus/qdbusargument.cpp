@@ -794,6 +794,33 @@ const QDBusArgument &QDBusArgument::operator>>(QByteArray &arg) const
     return *this;
 }
 
+/*!
+    \internal
+    Appends the \a count elements at \a data, of the fixed-size basic type
+    with the D-Bus type code \a typeCode, as one array to \a arg.
+*/
+void QtPrivate::qdbusAppendFixedArray(QDBusArgument &arg, char typeCode,
+                                      const void *data, qsizetype count)
+{
+    QDBusArgumentPrivate *&d = QDBusArgumentPrivate::dRef(arg);
+    if (QDBusArgumentPrivate::checkWrite(d))
+        d->marshaller()->appendFixedArray(typeCode, data, count);
+}
+
+/*!
+    \internal
+    If \a arg is at an array of the fixed-size basic type with the D-Bus
+    type code \a typeCode, points \a data to its elements, moves past it and
+    returns the number of elements. Otherwise, returns -1.
+*/
+qsizetype QtPrivate::qdbusFixedArray(const QDBusArgument &arg, char typeCode, const void **data)
+{
+    QDBusArgumentPrivate *&d = QDBusArgumentPrivate::dRef(arg);
+    if (!QDBusArgumentPrivate::checkReadAndDetach(d))
+        return -1;
+    return d->demarshaller()->toFixedArray(typeCode, data);
+}
+
 /*!
     Opens a new D-Bus structure suitable for appending new arguments.
 
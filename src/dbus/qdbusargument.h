@@ -190,10 +190,48 @@ Q_DBUS_EXPORT const QDBusArgument &operator>>(const QDBusArgument &a, QLineF &li
 Q_DBUS_EXPORT QDBusArgument &operator<<(QDBusArgument &a, const QLineF &line);
 #endif
 
+namespace QtPrivate {
+// The D-Bus type code of T if it is a basic type of fixed size, whose
+// arrays are transferred as one block of memory
+template <typename T> constexpr char qdbusFixedTypeCode() noexcept
+{
+    if constexpr (std::is_same_v<T, uchar>)
+        return 'y';
+    else if constexpr (std::is_same_v<T, short>)
+        return 'n';
+    else if constexpr (std::is_same_v<T, ushort>)
+        return 'q';
+    else if constexpr (std::is_same_v<T, int>)
+        return 'i';
+    else if constexpr (std::is_same_v<T, uint>)
+        return 'u';
+    else if constexpr (std::is_same_v<T, qlonglong>)
+        return 'x';
+    else if constexpr (std::is_same_v<T, qulonglong>)
+        return 't';
+    else if constexpr (std::is_same_v<T, double>)
+        return 'd';
+    else
+        return 0;
+}
+
+Q_DBUS_EXPORT void qdbusAppendFixedArray(QDBusArgument &arg, char typeCode,
+                                         const void *data, qsizetype count);
+Q_DBUS_EXPORT qsizetype qdbusFixedArray(const QDBusArgument &arg, char typeCode,
+                                        const void **data);
+} // namespace QtPrivate
+
 template<template <typename> class Container, typename T,
          typename = typename Container<T>::iterator>
 inline QDBusArgument &operator<<(QDBusArgument &arg, const Container<T> &list)
 {
+    if constexpr (std::is_same_v<Container<T>, QList<T>>
+                  && QtPrivate::qdbusFixedTypeCode<T>() != 0) {
+        QtPrivate::qdbusAppendFixedArray(arg, QtPrivate::qdbusFixedTypeCode<T>(),
+                                         list.constData(), list.size());
+        return arg;
+    }
+
     arg.beginArray(QMetaType::fromType<T>());
     typename Container<T>::const_iterator it = list.begin();
     typename Container<T>::const_iterator end = list.end();
@@ -207,6 +245,18 @@ template<template <typename> class Container, typename T,
          typename = typename Container<T>::iterator>
 inline const QDBusArgument &operator>>(const QDBusArgument &arg, Container<T> &list)
 {
+    if constexpr (std::is_same_v<Container<T>, QList<T>>
+                  && QtPrivate::qdbusFixedTypeCode<T>() != 0) {
+        const void *data;
+        const qsizetype count =
+                QtPrivate::qdbusFixedArray(arg, QtPrivate::qdbusFixedTypeCode<T>(), &data);
+        if (count >= 0) {
+            const T *begin = static_cast<const T *>(data);
+            list.assign(begin, begin + count);
+            return arg;
+        }
+    }
+
     arg.beginArray();
     list.clear();
     while (!arg.atEnd()) {
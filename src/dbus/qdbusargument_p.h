@@ -54,6 +54,8 @@ public:
     }
     static inline QDBusArgumentPrivate *d(QDBusArgument &q)
     { return q.d; }
+    static inline QDBusArgumentPrivate *&dRef(const QDBusArgument &q)
+    { return q.d; }
 
 public:
     DBusMessage *message;
@@ -90,6 +92,7 @@ public:
     void append(const QStringList &arg);
     void append(const QByteArray &arg);
     bool append(const QDBusVariant &arg); // this one can fail
+    void appendFixedArray(int type, const void *data, qsizetype count);
 
     QDBusMarshaller *beginStructure();
     QDBusMarshaller *endStructure();
@@ -148,6 +151,7 @@ public:
     QDBusVariant toVariant();
     QStringList toStringList();
     QByteArray toByteArray();
+    qsizetype toFixedArray(int type, const void **data);
 
     QDBusDemarshaller *beginStructure();
     QDBusDemarshaller *endStructure();
@@ -26,7 +26,7 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qpointer.h>
-#include <QtCore/qreadwritelock.h>
+#include <QtCore/private/qreadmostlylock_p.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qvarlengtharray.h>
 
@@ -300,8 +300,10 @@ public:
     TimeoutHash timeouts;
     PendingMessageList pendingMessages;
 
-    // the master lock protects our own internal state
-    QReadWriteLock lock;
+    // the master lock protects our own internal state; it is taken for
+    // reading to look up the object tree for every incoming call, on the
+    // connection's thread and the callers' threads
+    QReadMostlyLock lock;
     QDBusError lastError;
 
     QStringList serviceNames;
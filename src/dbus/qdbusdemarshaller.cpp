@@ -323,6 +323,24 @@ QByteArray QDBusDemarshaller::toByteArray()
     return QByteArray();
 }
 
+// Returns the number of elements of the array of the fixed-size basic type
+// at the current position and points data to them in the message, or -1 if
+// there is no such array there
+qsizetype QDBusDemarshaller::toFixedArray(int type, const void **data)
+{
+    if (q_dbus_message_iter_get_arg_type(&iterator) != DBUS_TYPE_ARRAY
+            || q_dbus_message_iter_get_element_type(&iterator) != type)
+        return -1;
+
+    DBusMessageIter sub;
+    q_dbus_message_iter_recurse(&iterator, &sub);
+    q_dbus_message_iter_next(&iterator);
+    int len = 0;
+    *data = nullptr;
+    q_dbus_message_iter_get_fixed_array(&sub, data, &len);
+    return len;
+}
+
 bool QDBusDemarshaller::atEnd()
 {
     // dbus_message_iter_has_next is broken if the list has one single element
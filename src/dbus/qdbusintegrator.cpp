@@ -35,6 +35,7 @@
 #include "qdbusthreaddebug_p.h"
 
 #include <algorithm>
+#include <shared_mutex>
 #ifdef interface
 #undef interface
 #endif
@@ -293,7 +294,7 @@ static void qDBusNewConnection(DBusServer *server, DBusConnection *connection, v
     // QDBusServer's thread in order to enable it after the
     // QDBusServer::newConnection() signal has been received by the
     // application's code
-    QReadLocker serverLock(&serverConnection->lock);
+    const std::shared_lock serverLock(serverConnection->lock);
     newConnection->enableDispatchDelayed(serverConnection->serverObject);
 }
 
@@ -1043,7 +1044,8 @@ QDBusConnectionPrivate::~QDBusConnectionPrivate()
 
     auto lastMode = mode; // reset on connection close
     closeConnection();
-    qDeleteAll(cachedMetaObjects);
+    // the cached meta objects are shared by all connections, see
+    // QDBusMetaObject::createMetaObject()
 
     if (lastMode == ClientMode || lastMode == PeerMode) {
         // the bus service object holds a reference back to us;
@@ -2524,7 +2526,7 @@ QString QDBusConnectionPrivate::getNameOwner(const QString& serviceName)
 
     {
         // acquire a read lock for the cache
-        QReadLocker locker(&lock);
+        const std::shared_lock locker(lock);
         WatchedServicesHash::ConstIterator it = watchedServices.constFind(serviceName);
         if (it != watchedServices.constEnd())
             return it->owner;
@@ -156,6 +156,25 @@ inline void QDBusMarshaller::append(const QByteArray &arg)
     q_dbus_message_iter_close_container(&iterator, &subiterator);
 }
 
+// Appends an array of a fixed-size basic type in one go, instead of
+// element by element
+void QDBusMarshaller::appendFixedArray(int type, const void *data, qsizetype count)
+{
+    const char signature[] = { char(type), '\0' };
+    if (ba) {
+        if (!skipSignature) {
+            *ba += DBUS_TYPE_ARRAY_AS_STRING;
+            *ba += signature;
+        }
+        return;
+    }
+
+    DBusMessageIter subiterator;
+    q_dbus_message_iter_open_container(&iterator, DBUS_TYPE_ARRAY, signature, &subiterator);
+    q_dbus_message_iter_append_fixed_array(&subiterator, type, &data, int(count));
+    q_dbus_message_iter_close_container(&iterator, &subiterator);
+}
+
 inline bool QDBusMarshaller::append(const QDBusVariant &arg)
 {
     if (ba) {
@@ -6,6 +6,7 @@
 
 #include <QtCore/qbytearray.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qvarlengtharray.h>
 
@@ -18,6 +19,7 @@
 
 #include <private/qmetaobject_p.h>
 #include <private/qmetaobjectbuilder_p.h>
+#include <private/qlocking_p.h>
 
 #ifndef QT_NO_DBUS
 
@@ -567,6 +569,38 @@ void QDBusMetaObjectGenerator::writeWithoutXml(const QString &interface)
 /////////
 // class QDBusMetaObject
 
+namespace {
+// Meta objects generated from the same introspection data are identical, no
+// matter which connection, service or object path it came from, so they are
+// generated once per process and shared by the caches of all connections.
+// They are kept until the library is unloaded.
+struct SharedMetaObjects
+{
+    QMutex mutex;
+    QHash<QString, QDBusMetaObject *> byIntrospection;
+
+    ~SharedMetaObjects() { qDeleteAll(byIntrospection); }
+};
+}
+Q_GLOBAL_STATIC(SharedMetaObjects, sharedMetaObjects)
+
+static QDBusMetaObject *sharedMetaObject(const QString &name,
+                                         const QDBusIntrospection::Interface &data)
+{
+    SharedMetaObjects *shared = sharedMetaObjects();
+    if (!shared)
+        return nullptr;
+    const auto locker = qt_scoped_lock(shared->mutex);
+    QDBusMetaObject *&obj = shared->byIntrospection[data.introspection];
+    if (!obj) {
+        obj = new QDBusMetaObject;
+        QDBusMetaObjectGenerator generator(name, &data);
+        generator.write(obj);
+        obj->cached = true;
+    }
+    return obj;
+}
+
 QDBusMetaObject *QDBusMetaObject::createMetaObject(const QString &interface, const QString &xml,
                                                    QHash<QString, QDBusMetaObject *> &cache,
                                                    QDBusError &error)
@@ -582,6 +616,12 @@ QDBusMetaObject *QDBusMetaObject::createMetaObject(const QString &interface, con
         bool us = it.key() == interface;
 
         QDBusMetaObject *obj = cache.value(it.key(), 0);
+        if (!obj && !it.key().startsWith("local."_L1)) {
+            // not in this connection's cache; share with the other ones
+            obj = sharedMetaObject(it.key(), *it.value());
+            if (obj)
+                cache.insert(it.key(), obj);
+        }
         if (!obj && (us || !interface.startsWith("local."_L1 ))) {
             // not in cache; create
             obj = new QDBusMetaObject;
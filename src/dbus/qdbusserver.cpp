@@ -87,7 +87,7 @@ QDBusServer::~QDBusServer()
         return;
 
     QMutexLocker locker(&manager->mutex);
-    QWriteLocker writeLocker(&d->lock);
+    const auto writeLocker = qt_scoped_lock(d->lock);
     for (const QString &name : std::as_const(d->serverConnectionNames))
         manager->removeConnection(name);
     d->serverConnectionNames.clear();
@@ -97,14 +97,14 @@ struct QDBusReadLocker: QDBusLockerBase
         : self(s), action(a)
     {
         reportThreadAction(action, BeforeLock, self);
-        self->lock.lockForRead();
+        self->lock.lock_shared();
         reportThreadAction(action, AfterLock, self);
     }
 
     inline ~QDBusReadLocker()
     {
         reportThreadAction(action, BeforeUnlock, self);
-        self->lock.unlock();
+        self->lock.unlock_shared();
         reportThreadAction(action, AfterUnlock, self);
     }
 };
@@ -117,7 +117,7 @@ struct QDBusWriteLocker: QDBusLockerBase
         : self(s), action(a)
     {
         reportThreadAction(action, BeforeLock, self);
-        self->lock.lockForWrite();
+        self->lock.lock();
         reportThreadAction(action, AfterLock, self);
     }
 
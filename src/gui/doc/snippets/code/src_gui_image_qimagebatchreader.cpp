@@ -0,0 +1,30 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+#include <QHash>
+#include <QImage>
+#include <QImageBatchReader>
+#include <QStringList>
+
+namespace src_gui_image_qimagebatchreader {
+void showThumbnail(const QString &fileName, const QImage &image);
+
+void wrapper0(const QStringList &fileNames) {
+
+//! [0]
+auto reader = new QImageBatchReader;
+reader->setScaledSize(QSize(256, 256));
+reader->setMemoryBudget(256 * 1024 * 1024);
+
+QHash<int, QString> files;
+for (const QString &fileName : fileNames)
+    files.insert(reader->read(fileName), fileName);
+
+QObject::connect(reader, &QImageBatchReader::imageRead, reader,
+                 [files](int id, const QImage &image) {
+    showThumbnail(files.value(id), image);
+});
+QObject::connect(reader, &QImageBatchReader::finished, reader, &QObject::deleteLater);
+//! [0]
+
+} // wrapper0
+} // src_gui_image_qimagebatchreader
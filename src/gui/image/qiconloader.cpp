@@ -14,6 +14,13 @@
 #include <QtCore/qmath.h>
 #include <QtCore/QList>
 #include <QtCore/QDir>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QMap>
+#if QT_CONFIG(temporaryfile)
+#include <QtCore/QSaveFile>
+#endif
+#include <QtCore/QStandardPaths>
+#include <QtCore/QSysInfo>
 #include <QtCore/qloggingcategory.h>
 #if QT_CONFIG(settings)
 #include <QtCore/QSettings>
@@ -138,6 +145,7 @@ void QIconLoader::updateSystemTheme()
 void QIconLoader::invalidateKey()
 {
     m_themeKey++;
+    m_missingIcons.clear();
 
     QIconPrivate::clearIconCache();
 }
@@ -162,6 +170,7 @@ void QIconLoader::setFallbackThemeName(const QString &themeName)
 {
     qCDebug(lcIconLoader) << "Setting fallback theme name to" << themeName;
     m_userFallbackTheme = themeName;
+    m_missingIcons.clear();
 }
 
 void QIconLoader::setThemeSearchPath(const QStringList &searchPaths)
@@ -331,6 +340,265 @@ QList<const char *> QIconCacheGtkReader::lookup(QStringView name)
     return ret;
 }
 
+/*!
+    \internal
+    An index of the icons in a theme directory, used when the directory has
+    no up-to-date icon-theme.cache: each subdirectory of the theme is listed
+    once, rather than probed for every icon name, which takes thousands of
+    stat() calls in applications using many icons, most of them for icons
+    that are not there.
+
+    The index is kept in the cache location, in a file named after the
+    directory and its subdirectories, and reused as long as none of the
+    subdirectories was modified. It is looked up in place, in a memory
+    mapping of that file. If the file can't be written, the index is kept
+    in memory only. Setting QT_DISABLE_ICON_THEME_INDEX turns it off.
+*/
+class QIconDirIndex
+{
+public:
+    enum FileType { Png = 0x1, Svg = 0x2 };
+
+    QIconDirIndex(const QString &themeDir, const QList<QIconDirInfo> &subDirs);
+    // Returns which of the files of an icon each subdirectory has, or an
+    // empty list if the index is not usable
+    QList<quint8> lookup(QStringView name);
+
+private:
+    void load();
+    bool setData(const uchar *data, qsizetype size, const QList<qint64> &modificationTimes);
+    QByteArray build(const QList<qint64> &modificationTimes) const;
+
+    quint32 read32(qsizetype offset) const
+    {
+        if (offset < 0 || offset > m_size - 4 || (offset & 0x3))
+            return 0;
+        quint32 value;
+        memcpy(&value, m_data + offset, sizeof(value));
+        return value;
+    }
+
+    QString m_themeDir;
+    QStringList m_subDirs;
+    QFile m_file;
+    QByteArray m_built;
+    const uchar *m_data = nullptr;
+    qsizetype m_size = 0;
+    bool m_loaded = false;
+};
+
+static const quint32 ICONINDEX_MAGIC = 0x51494958; // "QIIX"
+static const quint32 ICONINDEX_VERSION = 1;
+// magic, version, number of subdirectories, number of names
+static const int ICONINDEX_HEADER_SIZE = 4 * int(sizeof(quint32));
+
+/*
+    The index file consists of the header, followed by:
+    - the modification time of each subdirectory, as two quint32s, or -1 for
+      a subdirectory that does not exist;
+    - for each icon name, in strcmp() order, the offsets of the name and of
+      the list of its subdirectories;
+    - the lists, each a count followed by entries holding the index of a
+      subdirectory shifted left by two, or'ed with the FileTypes there;
+    - the names, as nul-terminated UTF-8.
+    All values are quint32s in host byte order.
+*/
+
+QIconDirIndex::QIconDirIndex(const QString &themeDir, const QList<QIconDirInfo> &subDirs)
+    : m_themeDir(themeDir)
+{
+    m_subDirs.reserve(subDirs.size());
+    for (const QIconDirInfo &dirInfo : subDirs)
+        m_subDirs.append(dirInfo.path);
+}
+
+static QString iconIndexFileName(const QString &themeDir, const QStringList &subDirs)
+{
+    // resources don't change, and listing them is cheap
+    if (themeDir.startsWith(u':'))
+        return QString();
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty())
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QFileInfo(themeDir).absoluteFilePath().toUtf8());
+    for (const QString &subDir : subDirs) {
+        hash.addData("\n");
+        hash.addData(subDir.toUtf8());
+    }
+    return cacheDir + "/qticonindex-"_L1 + QSysInfo::buildAbi() + u'/'
+            + QString::fromLatin1(hash.result().toHex());
+}
+
+void QIconDirIndex::load()
+{
+    m_loaded = true;
+
+    // one stat() per subdirectory, to validate the index
+    QList<qint64> modificationTimes;
+    modificationTimes.reserve(m_subDirs.size());
+    for (const QString &subDir : std::as_const(m_subDirs)) {
+        const QFileInfo info(m_themeDir + u'/' + subDir);
+        modificationTimes.append(info.isDir()
+                                 ? info.lastModified(QTimeZone::UTC).toMSecsSinceEpoch() : -1);
+    }
+
+    const QString fileName = iconIndexFileName(m_themeDir, m_subDirs);
+    if (!fileName.isEmpty()) {
+        m_file.setFileName(fileName);
+        if (m_file.open(QFile::ReadOnly)) {
+            const qsizetype size = m_file.size();
+            const uchar *data = m_file.map(0, size);
+            if (data && setData(data, size, modificationTimes)) {
+                qCDebug(lcIconLoader) << "Using icon index" << fileName << "for" << m_themeDir;
+                return;
+            }
+            m_file.close();
+        }
+    }
+
+    m_built = build(modificationTimes);
+    const bool ok = setData(reinterpret_cast<const uchar *>(m_built.constData()), m_built.size(),
+                            modificationTimes);
+    Q_ASSERT(ok);
+    Q_UNUSED(ok);
+    qCDebug(lcIconLoader) << "Built icon index for" << m_themeDir;
+
+#if QT_CONFIG(temporaryfile)
+    if (!fileName.isEmpty()) {
+        QDir::root().mkpath(QFileInfo(fileName).path());
+        QSaveFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly) || file.write(m_built) != m_built.size()
+                || !file.commit()) {
+            qCDebug(lcIconLoader) << "Could not write icon index" << fileName;
+        }
+    }
+#endif
+}
+
+bool QIconDirIndex::setData(const uchar *data, qsizetype size, const QList<qint64> &modificationTimes)
+{
+    m_data = data;
+    m_size = size;
+
+    const quint32 dirCount = read32(8);
+    const qsizetype timesSize = 8 * qsizetype(dirCount);
+    if (read32(0) != ICONINDEX_MAGIC || read32(4) != ICONINDEX_VERSION
+            || dirCount != quint32(modificationTimes.size())
+            || ICONINDEX_HEADER_SIZE + timesSize + 8 * qsizetype(read32(12)) > m_size
+            || memcmp(m_data + ICONINDEX_HEADER_SIZE, modificationTimes.constData(), timesSize) != 0) {
+        m_data = nullptr;
+        m_size = 0;
+        return false;
+    }
+    return true;
+}
+
+QByteArray QIconDirIndex::build(const QList<qint64> &modificationTimes) const
+{
+    QMap<QByteArray, QList<quint32>> icons;
+    for (qsizetype i = 0; i < m_subDirs.size(); ++i) {
+        if (modificationTimes.at(i) < 0)
+            continue;
+        const QStringList files = QDir(m_themeDir + u'/' + m_subDirs.at(i))
+                .entryList(QDir::Files | QDir::Hidden);
+        for (const QString &file : files) {
+            quint32 type;
+            if (file.endsWith(".png"_L1))
+                type = Png;
+            else if (file.endsWith(".svg"_L1))
+                type = Svg;
+            else
+                continue;
+            QList<quint32> &entries = icons[QStringView(file).chopped(4).toUtf8()];
+            if (!entries.isEmpty() && entries.constLast() >> 2 == quint32(i))
+                entries.last() |= type;
+            else
+                entries.append(quint32(i) << 2 | type);
+        }
+    }
+
+    const quint32 dirCount = quint32(m_subDirs.size());
+    const quint32 nameCount = quint32(icons.size());
+    quint32 listOffset = ICONINDEX_HEADER_SIZE + 8 * dirCount + 8 * nameCount;
+    quint32 namesOffset = listOffset;
+    for (const QList<quint32> &entries : std::as_const(icons))
+        namesOffset += 4 * (1 + quint32(entries.size()));
+
+    QList<quint32> index = { ICONINDEX_MAGIC, ICONINDEX_VERSION, dirCount, nameCount };
+    index.resize(namesOffset / 4);
+    memcpy(index.data() + ICONINDEX_HEADER_SIZE / 4, modificationTimes.constData(), 8 * dirCount);
+    QByteArray names;
+    qsizetype slot = (ICONINDEX_HEADER_SIZE + 8 * dirCount) / 4;
+    for (auto it = icons.cbegin(); it != icons.cend(); ++it) {
+        index[slot++] = namesOffset + quint32(names.size());
+        index[slot++] = listOffset;
+        names += it.key();
+        names += '\0';
+
+        qsizetype listSlot = listOffset / 4;
+        index[listSlot++] = quint32(it->size());
+        for (quint32 entry : *it)
+            index[listSlot++] = entry;
+        listOffset = quint32(listSlot * 4);
+    }
+
+    QByteArray data(reinterpret_cast<const char *>(index.constData()), index.size() * 4);
+    return data + names;
+}
+
+QList<quint8> QIconDirIndex::lookup(QStringView name)
+{
+    if (!m_loaded)
+        load();
+
+    QList<quint8> result;
+    if (!m_data)
+        return result;
+
+    const quint32 dirCount = read32(8);
+    const QByteArray nameUtf8 = name.toUtf8();
+    const qsizetype table = ICONINDEX_HEADER_SIZE + 8 * qsizetype(dirCount);
+    result.resize(dirCount);
+
+    // binary search over the names
+    quint32 low = 0;
+    quint32 high = read32(12);
+    while (low < high) {
+        const quint32 mid = low + (high - low) / 2;
+        const quint32 nameOffset = read32(table + 8 * qsizetype(mid));
+        if (nameOffset >= m_size || !memchr(m_data + nameOffset, 0, m_size - nameOffset))
+            return {};
+        const int cmp = strcmp(reinterpret_cast<const char *>(m_data + nameOffset), nameUtf8);
+        if (cmp < 0) {
+            low = mid + 1;
+        } else if (cmp > 0) {
+            high = mid;
+        } else {
+            const quint32 listOffset = read32(table + 8 * qsizetype(mid) + 4);
+            const quint32 count = read32(listOffset);
+            if (listOffset + 4 * (1 + qsizetype(count)) > m_size)
+                return {};
+            for (quint32 i = 0; i < count; ++i) {
+                const quint32 entry = read32(listOffset + 4 * (1 + qsizetype(i)));
+                if (entry >> 2 >= dirCount)
+                    return {};
+                result[entry >> 2] = quint8(entry & 0x3);
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+static bool useIconDirIndex()
+{
+    static const bool use = !qEnvironmentVariableIsSet("QT_DISABLE_ICON_THEME_INDEX");
+    return use;
+}
+
 QIconTheme::QIconTheme(const QString &themeName)
         : m_valid(false)
 {
@@ -404,6 +672,12 @@ QIconTheme::QIconTheme(const QString &themeName)
             m_parents.append("hicolor"_L1);
     }
 #endif // settings
+
+    if (useIconDirIndex()) {
+        m_dirIndexes.reserve(m_contentDirs.size());
+        for (const QString &contentDir : std::as_const(m_contentDirs))
+            m_dirIndexes << QSharedPointer<QIconDirIndex>::create(contentDir, m_keyList);
+    }
 }
 
 QDebug operator<<(QDebug debug, const std::unique_ptr<QIconLoaderEngineEntry> &entry)
@@ -469,12 +743,21 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                 }
             }
 
+            // Otherwise, look in our own index of the directory; the
+            // subdirectories are then those of the theme, in the same order
+            QList<quint8> indexed;
+            if (!cache->isValid() && i < theme.m_dirIndexes.size())
+                indexed = theme.m_dirIndexes.at(i)->lookup(iconNameFallback);
+            auto exists = [&](int j, QIconDirIndex::FileType type, const QString &path) {
+                return indexed.isEmpty() ? QFile::exists(path) : (indexed.at(j) & type) != 0;
+            };
+
             QString contentDir = contentDirs.at(i) + u'/';
             for (int j = 0; j < subDirs.size() ; ++j) {
                 const QIconDirInfo &dirInfo = subDirs.at(j);
                 const QString subDir = contentDir + dirInfo.path + u'/';
                 const QString pngPath = subDir + pngIconName;
-                if (QFile::exists(pngPath)) {
+                if (exists(j, QIconDirIndex::Png, pngPath)) {
                     auto iconEntry = std::make_unique<PixmapEntry>();
                     iconEntry->dir = dirInfo;
                     iconEntry->filename = pngPath;
@@ -483,7 +766,7 @@ QThemeIconInfo QIconLoader::findIconHelper(const QString &themeName,
                     info.entries.insert(info.entries.begin(), std::move(iconEntry));
                 } else if (m_supportsSvg) {
                     const QString svgPath = subDir + svgIconName;
-                    if (QFile::exists(svgPath)) {
+                    if (exists(j, QIconDirIndex::Svg, svgPath)) {
                         auto iconEntry = std::make_unique<ScalableEntry>();
                         iconEntry->dir = dirInfo;
                         iconEntry->filename = svgPath;
@@ -574,10 +857,19 @@ QThemeIconInfo QIconLoader::loadIcon(const QString &name) const
 
     QThemeIconInfo iconInfo;
     if (!themeName().isEmpty()) {
+        // Looking up an icon that isn't there visits every directory of
+        // the theme and of the themes it inherits, so remember the misses
+        if (m_missingIcons.contains(name)) {
+            qCDebug(lcIconLoader) << "Icon" << name << "is known to be missing";
+            return iconInfo;
+        }
+
         QStringList visited;
         iconInfo = findIconHelper(themeName(), name, visited);
         if (iconInfo.entries.empty())
             iconInfo = lookupFallbackIcon(name);
+        if (iconInfo.entries.empty())
+            m_missingIcons.insert(name);
     }
 
     qCDebug(lcIconLoader) << "Resulting icon entries" << iconInfo.entries;
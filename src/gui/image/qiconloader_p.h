@@ -25,6 +25,7 @@
 #include <private/qfactoryloader_p.h>
 #include <QtCore/QHash>
 #include <QtCore/QList>
+#include <QtCore/QSet>
 #include <QtCore/QTypeInfo>
 
 #include <vector>
@@ -120,6 +121,7 @@ private:
 };
 
 class QIconCacheGtkReader;
+class QIconDirIndex;
 
 class QIconTheme
 {
@@ -137,6 +139,7 @@ private:
     bool m_valid;
 public:
     QList<QSharedPointer<QIconCacheGtkReader>> m_gtkCaches;
+    QList<QSharedPointer<QIconDirIndex>> m_dirIndexes;
 };
 
 class Q_GUI_EXPORT QIconLoader
@@ -178,6 +181,7 @@ private:
     mutable QStringList m_iconDirs;
     mutable QHash <QString, QIconTheme> themeList;
     mutable QStringList m_fallbackDirs;
+    mutable QSet<QString> m_missingIcons;
 };
 
 QT_END_NAMESPACE
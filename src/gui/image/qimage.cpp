@@ -5129,7 +5129,8 @@ void QImage::applyColorTransform(const QColorTransform &transform)
     if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
         QSemaphore semaphore;
         int y = 0;
-        for (int i = 0; i < segments; ++i) {
+        // the last segment is done by this thread instead of waiting idle
+        for (int i = 0; i < segments - 1; ++i) {
             int yn = (height() - y) / (segments - i);
             threadPool->start([&, y, yn]() {
                 transformSegment(y, y + yn);
@@ -5137,7 +5138,8 @@ void QImage::applyColorTransform(const QColorTransform &transform)
             });
             y += yn;
         }
-        semaphore.acquire(segments);
+        transformSegment(y, height());
+        semaphore.acquire(segments - 1);
     } else
 #endif
         transformSegment(0, height());
@@ -0,0 +1,368 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qimagebatchreader.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qimagereader.h>
+
+#include <private/qobject_p.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QImageBatchReader
+    \inmodule QtGui
+    \since 6.7
+    \brief The QImageBatchReader class reads many image files in parallel.
+
+    \ingroup painting
+
+    QImageBatchReader reads images with QImageReader on the threads of a
+    QThreadPool, so that loading a large number of files, for instance the
+    thumbnails of a gallery, does not block the thread that needs them.
+    Call read() for each file; it returns an id and the image is delivered
+    later with the imageRead() signal, or readFailed() if it could not be
+    read. Both signals are emitted in the thread the batch reader lives in,
+    in the order in which the reads complete. finished() is emitted once no
+    reads are left.
+
+    \snippet code/src_gui_image_qimagebatchreader.cpp 0
+
+    The reads do not all start at once. At most maximumConcurrentReads() run
+    at the same time, and the others wait in a queue until a running read
+    has been delivered. Since delivery happens in the receiving thread,
+    reading pauses while that thread is too busy to take the results.
+
+    setMemoryBudget() additionally limits the memory used by images that are
+    being decoded or are waiting to be delivered, which matters when some of
+    the files are very large. The size of each image is estimated from its
+    header before it is decoded.
+
+    \sa QImageReader
+*/
+
+/*!
+    \fn void QImageBatchReader::imageRead(int id, const QImage &image)
+
+    This signal is emitted when the read with the id \a id has produced
+    \a image.
+
+    \sa read()
+*/
+
+/*!
+    \fn void QImageBatchReader::readFailed(int id, const QString &errorString)
+
+    This signal is emitted when the read with the id \a id failed;
+    \a errorString is the error reported by QImageReader.
+
+    \sa read(), QImageReader::errorString()
+*/
+
+/*!
+    \fn void QImageBatchReader::finished()
+
+    This signal is emitted when the last pending read has been delivered.
+
+    \sa pendingCount()
+*/
+
+namespace {
+
+// State shared with the reads running in the thread pool, which may still
+// be running when the QImageBatchReader is destroyed.
+struct QImageBatchReaderShared
+{
+    QMutex mutex;
+    QWaitCondition budgetAvailable;
+    QImageBatchReader *receiver = nullptr;
+    qsizetype memoryBudget = 0;
+    qsizetype reservedBytes = 0;
+
+    // Waits until bytes fit in the memory budget; an image that does not
+    // fit even on its own is read when nothing else is reserved.
+    bool reserve(qsizetype bytes)
+    {
+        QMutexLocker locker(&mutex);
+        while (receiver && memoryBudget > 0 && reservedBytes > 0
+               && reservedBytes + bytes > memoryBudget) {
+            budgetAvailable.wait(&mutex);
+        }
+        if (!receiver)
+            return false;
+        reservedBytes += bytes;
+        return true;
+    }
+
+    void release(qsizetype bytes)
+    {
+        if (!bytes)
+            return;
+        QMutexLocker locker(&mutex);
+        reservedBytes -= bytes;
+        budgetAvailable.wakeAll();
+    }
+};
+
+} // unnamed namespace
+
+class QImageBatchReaderPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QImageBatchReader)
+public:
+    struct Request
+    {
+        int id;
+        QString fileName;
+        QByteArray format;
+    };
+
+    void startReads();
+    void deliver(quint64 generation, int id, const QImage &image, const QString &errorString,
+                 qsizetype reservedBytes);
+
+    std::shared_ptr<QImageBatchReaderShared> shared = std::make_shared<QImageBatchReaderShared>();
+    QThreadPool *threadPool = nullptr;
+    QQueue<Request> queue;
+    QSize scaledSize;
+    quint64 generation = 0;
+    int maximumConcurrentReads = QThread::idealThreadCount();
+    int running = 0;
+    int lastId = 0;
+    bool finishPending = false;
+};
+
+static qsizetype estimatedImageBytes(const QImageReader &reader, QSize scaledSize)
+{
+    const QSize size = scaledSize.isValid() ? scaledSize : reader.size();
+    if (!size.isValid())
+        return 0;
+    // Like QImageIOHandler::allocateImage(), assume at least 32 bits per pixel
+    const int depth = QImage::toPixelFormat(reader.imageFormat()).bitsPerPixel();
+    return qsizetype(size.width()) * size.height() * (qMax(depth, 32) / 8);
+}
+
+void QImageBatchReaderPrivate::startReads()
+{
+    QThreadPool *pool = threadPool ? threadPool : QThreadPool::globalInstance();
+    while (!queue.isEmpty() && running < qMax(maximumConcurrentReads, 1)) {
+        Request request = queue.dequeue();
+        ++running;
+        pool->start([shared = shared, request = std::move(request), size = scaledSize,
+                     generation = generation]() {
+            QImageReader reader(request.fileName, request.format);
+            if (size.isValid())
+                reader.setScaledSize(size);
+            const qsizetype bytes = estimatedImageBytes(reader, size);
+            if (!shared->reserve(bytes))
+                return;
+            QImage image = reader.read();
+            const QString errorString = image.isNull() ? reader.errorString() : QString();
+
+            QMutexLocker locker(&shared->mutex);
+            if (QImageBatchReader *receiver = shared->receiver) {
+                QMetaObject::invokeMethod(receiver,
+                        [receiver, generation, id = request.id, image = std::move(image),
+                         errorString, bytes]() {
+                            receiver->d_func()->deliver(generation, id, image, errorString, bytes);
+                        }, Qt::QueuedConnection);
+            } else {
+                shared->reservedBytes -= bytes;
+            }
+        });
+    }
+}
+
+void QImageBatchReaderPrivate::deliver(quint64 readGeneration, int id, const QImage &image,
+                                       const QString &errorString, qsizetype reservedBytes)
+{
+    Q_Q(QImageBatchReader);
+    shared->release(reservedBytes);
+    --running;
+    const bool wasCanceled = readGeneration != generation;
+    startReads();
+    if (!wasCanceled) {
+        if (image.isNull())
+            emit q->readFailed(id, errorString);
+        else
+            emit q->imageRead(id, image);
+    }
+    if (finishPending && !running && queue.isEmpty()) {
+        finishPending = false;
+        emit q->finished();
+    }
+}
+
+/*!
+    Constructs a batch reader with the given \a parent.
+*/
+QImageBatchReader::QImageBatchReader(QObject *parent)
+    : QObject(*new QImageBatchReaderPrivate, parent)
+{
+    Q_D(QImageBatchReader);
+    d->shared->receiver = this;
+}
+
+/*!
+    Destroys the batch reader. Reads that have not started are dropped, and
+    the results of those still running are discarded when they complete;
+    the destructor does not wait for them.
+*/
+QImageBatchReader::~QImageBatchReader()
+{
+    Q_D(QImageBatchReader);
+    QMutexLocker locker(&d->shared->mutex);
+    d->shared->receiver = nullptr;
+    d->shared->budgetAvailable.wakeAll();
+}
+
+/*!
+    Sets the thread pool the images are read in to \a pool. If \a pool is
+    \nullptr, which is the default, QThreadPool::globalInstance() is used.
+
+    \sa threadPool()
+*/
+void QImageBatchReader::setThreadPool(QThreadPool *pool)
+{
+    Q_D(QImageBatchReader);
+    d->threadPool = pool;
+}
+
+/*!
+    Returns the thread pool set with setThreadPool(), or \nullptr if the
+    global thread pool is used.
+*/
+QThreadPool *QImageBatchReader::threadPool() const
+{
+    Q_D(const QImageBatchReader);
+    return d->threadPool;
+}
+
+/*!
+    Sets the largest number of images that are read at the same time to
+    \a count. The default is QThread::idealThreadCount().
+
+    \sa maximumConcurrentReads()
+*/
+void QImageBatchReader::setMaximumConcurrentReads(int count)
+{
+    Q_D(QImageBatchReader);
+    d->maximumConcurrentReads = count;
+    d->startReads();
+}
+
+/*!
+    Returns the largest number of images that are read at the same time.
+
+    \sa setMaximumConcurrentReads()
+*/
+int QImageBatchReader::maximumConcurrentReads() const
+{
+    Q_D(const QImageBatchReader);
+    return d->maximumConcurrentReads;
+}
+
+/*!
+    Sets the memory budget to \a bytes. A read only starts decoding once
+    the estimated size of its image, added to that of the images already
+    being decoded or waiting to be delivered, fits in the budget. An image
+    bigger than the whole budget is decoded when no other image is. The
+    default is 0, which means there is no limit.
+
+    \sa memoryBudget()
+*/
+void QImageBatchReader::setMemoryBudget(qsizetype bytes)
+{
+    Q_D(QImageBatchReader);
+    QMutexLocker locker(&d->shared->mutex);
+    d->shared->memoryBudget = bytes;
+    d->shared->budgetAvailable.wakeAll();
+}
+
+/*!
+    Returns the memory budget in bytes, or 0 if there is none.
+
+    \sa setMemoryBudget()
+*/
+qsizetype QImageBatchReader::memoryBudget() const
+{
+    Q_D(const QImageBatchReader);
+    QMutexLocker locker(&d->shared->mutex);
+    return d->shared->memoryBudget;
+}
+
+/*!
+    Sets the size the images are scaled to to \a size, as with
+    QImageReader::setScaledSize(). Image formats that can decode at a
+    reduced size do so. The new size applies to the reads started from now
+    on.
+
+    \sa scaledSize()
+*/
+void QImageBatchReader::setScaledSize(const QSize &size)
+{
+    Q_D(QImageBatchReader);
+    d->scaledSize = size;
+}
+
+/*!
+    Returns the size images are scaled to, or an invalid size if they are
+    not scaled.
+
+    \sa setScaledSize()
+*/
+QSize QImageBatchReader::scaledSize() const
+{
+    Q_D(const QImageBatchReader);
+    return d->scaledSize;
+}
+
+/*!
+    Queues the file \a fileName for reading, and returns the id that the
+    imageRead() or readFailed() signal will carry for it. If \a format is
+    not empty, it is passed on to QImageReader.
+*/
+int QImageBatchReader::read(const QString &fileName, const QByteArray &format)
+{
+    Q_D(QImageBatchReader);
+    const int id = ++d->lastId;
+    d->queue.enqueue({ id, fileName, format });
+    d->finishPending = true;
+    d->startReads();
+    return id;
+}
+
+/*!
+    Cancels all pending reads. Queued reads are dropped; reads that are
+    already running complete, but their results are not delivered.
+    finished() is not emitted for the canceled reads.
+*/
+void QImageBatchReader::cancel()
+{
+    Q_D(QImageBatchReader);
+    d->queue.clear();
+    d->finishPending = false;
+    ++d->generation;
+}
+
+/*!
+    Returns the number of reads that have been queued with read() and not
+    yet delivered. Canceled reads that are still running are included.
+*/
+int QImageBatchReader::pendingCount() const
+{
+    Q_D(const QImageBatchReader);
+    return d->queue.size() + d->running;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qimagebatchreader.cpp"
@@ -0,0 +1,58 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QIMAGEBATCHREADER_H
+#define QIMAGEBATCHREADER_H
+
+#include <QtGui/qtguiglobal.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QImage;
+class QThreadPool;
+
+class QImageBatchReaderPrivate;
+class Q_GUI_EXPORT QImageBatchReader : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QImageBatchReader)
+public:
+    explicit QImageBatchReader(QObject *parent = nullptr);
+    ~QImageBatchReader() override;
+
+    void setThreadPool(QThreadPool *pool);
+    QThreadPool *threadPool() const;
+
+    void setMaximumConcurrentReads(int count);
+    int maximumConcurrentReads() const;
+
+    void setMemoryBudget(qsizetype bytes);
+    qsizetype memoryBudget() const;
+
+    void setScaledSize(const QSize &size);
+    QSize scaledSize() const;
+
+    int read(const QString &fileName, const QByteArray &format = QByteArray());
+    void cancel();
+
+    int pendingCount() const;
+
+Q_SIGNALS:
+    void imageRead(int id, const QImage &image);
+    void readFailed(int id, const QString &errorString);
+    void finished();
+
+private:
+    Q_DISABLE_COPY(QImageBatchReader)
+};
+
+QT_END_NAMESPACE
+
+#endif // QIMAGEBATCHREADER_H
@@ -1178,6 +1178,12 @@ extern void qt_imageTransform(QImage &src, QImageIOHandler::Transformations orie
     which always constructs a new image; especially when reading several
     images with the same format and size.
 
+    If \a image is not shared with other images, the image data is then
+    decoded straight into its memory. This includes images constructed on a
+    buffer you provide, so an application can have images decoded into
+    memory it manages itself. Not all image formats support this; check
+    that \l{QImage::}{constBits()} has not changed after reading.
+
     \snippet code/src_gui_image_qimagereader.cpp 2
 
     For image formats that support animation, calling read() repeatedly will
@@ -22,6 +22,12 @@
 #include "qdebug.h"
 #include <QtCore/private/qlocking_p.h>
 
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#include <private/qthreadpool_p.h>
+#endif
+
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
@@ -337,30 +343,185 @@ bool QPicture::play(QPainter *painter)
         return false;
 
     d->pictb.open(QIODevice::ReadOnly);                // open buffer device
-    QDataStream s;
-    s.setDevice(&d->pictb);                        // attach data stream to buffer
+    const bool ok = replay(painter, &d->pictb);
+    d->pictb.close();
+    return ok;
+}
+
+/*!
+  \internal
+  Positions a stream on \a device at the first record, and returns the number
+  of records.
+*/
+static quint32 readPictureHeader(QDataStream &s, int formatMajor)
+{
     s.device()->seek(10);                        // go directly to the data
-    s.setVersion(d->formatMajor == 4 ? 3 : d->formatMajor);
+    s.setVersion(formatMajor == 4 ? 3 : formatMajor);
 
     quint8  c, clen;
     quint32 nrecords;
     s >> c >> clen;
     Q_ASSERT(c == QPicturePrivate::PdcBegin);
     // bounding rect was introduced in ver 4. Read in checkFormat().
-    if (d->formatMajor >= 4) {
+    if (formatMajor >= 4) {
         qint32 dummy;
         s >> dummy >> dummy >> dummy >> dummy;
     }
     s >> nrecords;
+    return nrecords;
+}
+
+/*!
+  \internal
+  Replays the picture data read from \a device, which must be open, using
+  \a painter.
+*/
+bool QPicture::replay(QPainter *painter, QIODevice *device)
+{
+    Q_D(QPicture);
+    QDataStream s(device);                        // attach data stream to buffer
+    const quint32 nrecords = readPictureHeader(s, d->formatMajor);
     if (!exec(painter, s, nrecords)) {
         qWarning("QPicture::play: Format error");
-        d->pictb.close();
         return false;
     }
-    d->pictb.close();
     return true;                                // no end-command
 }
 
+#if QT_CONFIG(thread)
+/*!
+  \internal
+  Returns \c true if the records in \a data can be replayed in bands by
+  threads other than the GUI thread: they must not contain pixmaps, and
+  must not set up a view transformation, which would apply on top of the
+  translation to the band.
+*/
+static bool canReplayInThreads(const QByteArray &data, int formatMajor)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream s(&buffer);
+    quint32 nrecords = readPictureHeader(s, formatMajor);
+    while (nrecords-- && !s.atEnd()) {
+        quint8 c, tiny_len;
+        qint32 len;
+        s >> c >> tiny_len;
+        if (tiny_len == 255)
+            s >> len;
+        else
+            len = tiny_len;
+        switch (c) {
+        case QPicturePrivate::PdcDrawPixmap:
+        case QPicturePrivate::PdcDrawTiledPixmap:
+        case QPicturePrivate::PdcSetVXform:
+        case QPicturePrivate::PdcSetWindow:
+        case QPicturePrivate::PdcSetViewport:
+            return false;
+        default:
+            break;
+        }
+        if (len < 0 || s.skipRawData(len) != len)
+            return false;
+    }
+    return s.status() == QDataStream::Ok;
+}
+#endif
+
+/*!
+    \since 6.7
+    \overload
+
+    Replays the picture onto \a image, and returns \c true if successful;
+    otherwise returns \c false.
+
+    The image is split into horizontal bands that are painted at the same
+    time by threads of a thread pool internal to Qt GUI. Each band replays
+    the whole picture, clipped to the band, so this is faster than painting
+    the commands directly when the rasterization and blending of large
+    areas dominates, for instance when filling paths or drawing
+    antialiased curves across a large image. The result is the same as
+    with a QPainter opened on \a image, except for differences in how
+    antialiasing is rounded at the band boundaries.
+
+    Pictures containing pixmaps are replayed in the calling thread, since
+    pixmaps cannot be used in other threads, and so are pictures that set
+    a window or viewport on the painter. The same applies when this
+    function is called from a thread of the pool, or when \a image is too
+    small to be split.
+
+    \sa QPainter::drawPicture()
+*/
+bool QPicture::play(QImage *image)
+{
+    Q_D(QPicture);
+
+    if (!image || image->isNull())
+        return false;
+    if (d->pictb.size() == 0)                        // nothing recorded
+        return true;
+    if (!d->formatOk && !d->checkFormat())
+        return false;
+
+    auto playSerially = [&] {
+        QPainter painter(image);
+        return play(&painter);
+    };
+
+#if QT_CONFIG(thread)
+    constexpr int MinimumBandHeight = 64;
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (!threadPool || threadPool->contains(QThread::currentThread()))
+        return playSerially();
+    const int bands = qMin(threadPool->maxThreadCount(), image->height() / MinimumBandHeight);
+    if (bands <= 1)
+        return playSerially();
+
+    const QByteArray data = d->pictb.data();
+    if (!canReplayInThreads(data, d->formatMajor))
+        return playSerially();
+
+    // detach now, the bands write to the image's pixels directly
+    uchar *bits = image->bits();
+    const qsizetype bytesPerLine = image->bytesPerLine();
+    const int height = image->height();
+
+    QSemaphore semaphore;
+    QAtomicInt failed;
+    auto playBand = [&](int y, int bandHeight) {
+        QImage band(bits + y * bytesPerLine, image->width(), bandHeight, bytesPerLine,
+                    image->format());
+        band.setColorTable(image->colorTable());
+        band.setDotsPerMeterX(image->dotsPerMeterX());
+        band.setDotsPerMeterY(image->dotsPerMeterY());
+        band.setDevicePixelRatio(image->devicePixelRatio());
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        QPainter painter(&band);
+        painter.translate(0, -y / image->devicePixelRatio());
+        if (!replay(&painter, &buffer))
+            failed.storeRelaxed(1);
+    };
+
+    int y = 0;
+    for (int i = 0; i < bands - 1; ++i) {
+        const int bandHeight = (height - y) / (bands - i);
+        threadPool->start([&, y, bandHeight]() {
+            playBand(y, bandHeight);
+            semaphore.release(1);
+        });
+        y += bandHeight;
+    }
+    playBand(y, height - y);
+    semaphore.acquire(bands - 1);
+    return !failed.loadRelaxed();
+#else
+    return playSerially();
+#endif
+}
+
 
 //
 // QFakeDevice is used to create fonts with a custom DPI
@@ -14,6 +14,7 @@ QT_BEGIN_NAMESPACE
 
 #ifndef QT_NO_PICTURE
 
+class QImage;
 class QPicturePrivate;
 class Q_GUI_EXPORT QPicture : public QPaintDevice
 {
@@ -31,6 +32,7 @@ public:
     virtual void setData(const char* data, uint size);
 
     bool play(QPainter *p);
+    bool play(QImage *image);
 
     bool load(QIODevice *dev);
     bool load(const QString &fileName);
@@ -59,6 +61,7 @@ protected:
 
 private:
     bool exec(QPainter *p, QDataStream &ds, int i);
+    bool replay(QPainter *painter, QIODevice *device);
 
     QExplicitlySharedDataPointer<QPicturePrivate> d_ptr;
     friend class QPicturePaintEngine;
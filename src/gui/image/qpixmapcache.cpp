@@ -7,6 +7,11 @@
 #include "qpixmapcache_p.h"
 #include "qthread.h"
 #include "qcoreapplication.h"
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+#include "qsharedimagecache_p.h"
+#endif
+
+#include <memory>
 
 using namespace std::chrono_literals;
 
@@ -50,6 +55,10 @@ QT_BEGIN_NAMESPACE
     with QPixmapCache} explains how to use QPixmapCache to speed up
     applications by caching the results of painting.
 
+    Processes that render the same pixmaps, for instance several
+    applications using the same style, can share the pixmaps stored with
+    string keys by calling attachSharedCache() with a common name.
+
     \note QPixmapCache is only usable from the application's main thread.
     Access from other threads will be ignored and return failure.
 
@@ -431,6 +440,15 @@ QPixmapCache::KeyData* QPMCache::getKeyData(QPixmapCache::Key *key)
 
 Q_GLOBAL_STATIC(QPMCache, pm_cache)
 
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+Q_GLOBAL_STATIC(std::unique_ptr<QSharedImageCache>, shared_cache)
+
+static QSharedImageCache *sharedCache()
+{
+    return shared_cache.exists() ? shared_cache->get() : nullptr;
+}
+#endif
+
 int Q_AUTOTEST_EXPORT q_QPixmapCache_keyHashSize()
 {
     return pm_cache()->size();
@@ -457,6 +475,18 @@ bool QPixmapCache::find(const QString &key, QPixmap *pixmap)
     if (!qt_pixmapcache_thread_test())
         return false;
     QPixmap *ptr = pm_cache()->object(key);
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (!ptr) {
+        QImage image;
+        if (QSharedImageCache *shared = sharedCache(); shared && shared->find(key, &image)) {
+            const QPixmap found = QPixmap::fromImage(std::move(image));
+            pm_cache()->insert(key, found, cost(found));
+            if (pixmap)
+                *pixmap = found;
+            return true;
+        }
+    }
+#endif
     if (ptr && pixmap)
         *pixmap = *ptr;
     return ptr != nullptr;
@@ -501,13 +531,19 @@ bool QPixmapCache::find(const Key &key, QPixmap *pixmap)
     The function returns \c true if the object was inserted into the
     cache; otherwise it returns \c false.
 
-    \sa setCacheLimit()
+    If a shared cache is attached, the pixmap is also stored there.
+
+    \sa setCacheLimit(), attachSharedCache()
 */
 
 bool QPixmapCache::insert(const QString &key, const QPixmap &pixmap)
 {
     if (!qt_pixmapcache_thread_test())
         return false;
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (QSharedImageCache *shared = sharedCache(); shared && !pixmap.isNull())
+        shared->insert(key, pixmap.toImage());
+#endif
     return pm_cache()->insert(key, pixmap, cost(pixmap));
 }
 
@@ -584,12 +620,17 @@ void QPixmapCache::setCacheLimit(int n)
 }
 
 /*!
-  Removes the pixmap associated with \a key from the cache.
+  Removes the pixmap associated with \a key from the cache, and from the
+  shared cache if one is attached.
 */
 void QPixmapCache::remove(const QString &key)
 {
     if (!qt_pixmapcache_thread_test())
         return;
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    if (QSharedImageCache *shared = sharedCache())
+        shared->remove(key);
+#endif
     pm_cache()->remove(key);
 }
 
@@ -611,6 +652,9 @@ void QPixmapCache::remove(const Key &key)
 
 /*!
     Removes all pixmaps from the cache.
+
+    The shared cache, if one is attached, is left alone, since other
+    processes may still be using its pixmaps.
 */
 
 void QPixmapCache::clear()
@@ -626,6 +670,54 @@ void QPixmapCache::clear()
     }
 }
 
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+/*!
+    \since 6.7
+
+    Attaches the cache to the shared memory cache called \a name, creating
+    it with a size of \a sizeKB kilobytes if no process has done so yet.
+    Returns \c true on success; otherwise returns \c false.
+
+    While attached, pixmaps inserted with a string key are also stored in
+    the shared cache, and find() looks there for the pixmaps that are not
+    in the cache of this process, so that a pixmap rendered by one process
+    can be reused by all others attached to the same name. When the shared
+    cache is full, the least recently used pixmaps are evicted from it.
+    Pixmaps inserted with a QPixmapCache::Key are never shared.
+
+    Sharing copies the pixels of each pixmap into and out of the shared
+    memory, so it pays off for pixmaps that are expensive to render.
+
+    \sa detachSharedCache(), QSharedMemory
+*/
+bool QPixmapCache::attachSharedCache(const QString &name, int sizeKB)
+{
+    if (!qt_pixmapcache_thread_test())
+        return false;
+    auto shared = std::make_unique<QSharedImageCache>(name);
+    if (!shared->attach(qsizetype(sizeKB) * 1024))
+        return false;
+    *shared_cache() = std::move(shared);
+    return true;
+}
+
+/*!
+    \since 6.7
+
+    Detaches the cache from the shared memory cache. The pixmaps already
+    found in the shared cache stay in the cache of this process.
+
+    \sa attachSharedCache()
+*/
+void QPixmapCache::detachSharedCache()
+{
+    if (!qt_pixmapcache_thread_test())
+        return;
+    if (shared_cache.exists())
+        shared_cache->reset();
+}
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+
 Q_AUTOTEST_EXPORT void qt_qpixmapcache_flush_detached_pixmaps() // for tst_qpixmapcache
 {
     if (!qt_pixmapcache_thread_test())
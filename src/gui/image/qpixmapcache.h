@@ -50,6 +50,10 @@ public:
     static void remove(const QString &key);
     static void remove(const Key &key);
     static void clear();
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    static bool attachSharedCache(const QString &name, int sizeKB);
+    static void detachSharedCache();
+#endif
 };
 Q_DECLARE_SHARED(QPixmapCache::Key)
 
@@ -85,6 +85,7 @@ public:
     int compression;
     QString description;
     QSize scaledSize;
+    QRect clipRect;
     QStringList readTexts;
     QColorSpace colorSpace;
     ColorSpaceState colorSpaceState;
@@ -206,7 +207,8 @@ void qpiw_flush_fn(png_structp /* png_ptr */)
 }
 
 static
-bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scaledSize, bool *doScaledRead)
+bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scaledSize, QRect rect,
+              bool *doRowRead)
 {
     png_uint_32 width = 0;
     png_uint_32 height = 0;
@@ -361,12 +363,19 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
             format = QImage::Format_RGB32;
         }
         QSize outSize(width,height);
-        if (!scaledSize.isEmpty() && quint32(scaledSize.width()) <= width &&
-            quint32(scaledSize.height()) <= height && scaledSize != outSize && interlace_method == PNG_INTERLACE_NONE) {
-            // Do inline downscaling
-            outSize = scaledSize;
-            if (doScaledRead)
-                *doScaledRead = true;
+        if (interlace_method == PNG_INTERLACE_NONE) {
+            // Do inline clipping and downscaling
+            if (rect.size() != outSize) {
+                outSize = rect.size();
+                if (doRowRead)
+                    *doRowRead = true;
+            }
+            if (!scaledSize.isEmpty() && scaledSize.width() <= outSize.width() &&
+                scaledSize.height() <= outSize.height() && scaledSize != outSize) {
+                outSize = scaledSize;
+                if (doRowRead)
+                    *doRowRead = true;
+            }
         }
         if (!QImageIOHandler::allocateImage(outSize, format, &image))
             return false;
@@ -384,8 +393,11 @@ bool setup_qt(QImage& image, png_structp png_ptr, png_infop info_ptr, QSize scal
     return true;
 }
 
-static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop info_ptr,
-                              QPngHandlerPrivate::AllocatedMemoryPointers &amp, QSize scaledSize)
+// Reads the rows of \a rect, downscaling them to the size of outImage with a
+// box filter if it is smaller. Rows below the rectangle are not decoded.
+// Returns true if all rows of the image were read.
+static bool read_image_rows(QImage *outImage, png_structp png_ptr, png_infop info_ptr,
+                            QPngHandlerPrivate::AllocatedMemoryPointers &amp, QRect rect)
 {
 
     png_uint_32 width = 0;
@@ -401,57 +413,75 @@ static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop i
     uchar *data = outImage->bits();
     qsizetype bpl = outImage->bytesPerLine();
 
-    if (scaledSize.isEmpty() || !width || !height)
-        return;
+    if (rect.isEmpty() || !width || !height)
+        return false;
 
-    const quint32 iysz = height;
-    const quint32 ixsz = width;
-    const quint32 oysz = scaledSize.height();
-    const quint32 oxsz = scaledSize.width();
+    const quint32 iysz = rect.height();
+    const quint32 ixsz = rect.width();
+    const quint32 oysz = outImage->height();
+    const quint32 oxsz = outImage->width();
     const quint32 ibw = 4*width;
-    amp.accRow = new quint32[ibw];
-    memset(amp.accRow, 0, ibw*sizeof(quint32));
+    const quint32 cbw = 4*ixsz;
     amp.inRow = new png_byte[ibw];
     memset(amp.inRow, 0, ibw*sizeof(png_byte));
-    amp.outRow = new uchar[ibw];
-    memset(amp.outRow, 0, ibw*sizeof(uchar));
-    qint32 rval = 0;
-    for (quint32 oy=0; oy<oysz; oy++) {
-        // Store the rest of the previous input row, if any
-        for (quint32 i=0; i < ibw; i++)
-            amp.accRow[i] = rval*amp.inRow[i];
-        // Accumulate the next input rows
-        for (rval = iysz-rval; rval > 0; rval-=oysz) {
-            png_read_row(png_ptr, amp.inRow, nullptr);
-            quint32 fact = qMin(oysz, quint32(rval));
-            for (quint32 i=0; i < ibw; i++)
-                amp.accRow[i] += fact*amp.inRow[i];
+    const png_byte *inRow = amp.inRow + 4*rect.left();
+
+    for (int y = 0; y < rect.top(); ++y)
+        png_read_row(png_ptr, amp.inRow, nullptr);
+
+    if (oxsz == ixsz && oysz == iysz) {
+        for (quint32 y = 0; y < iysz; ++y) {
+            if (ixsz == width) {
+                png_read_row(png_ptr, data, nullptr);
+            } else {
+                png_read_row(png_ptr, amp.inRow, nullptr);
+                memcpy(data, inRow, cbw);
+            }
+            data += bpl;
         }
-        rval *= -1;
-
-        // We have a full output row, store it
-        for (quint32 i=0; i < ibw; i++)
-            amp.outRow[i] = uchar(amp.accRow[i]/iysz);
-
-        quint32 a[4] = {0, 0, 0, 0};
-        qint32 cval = oxsz;
-        quint32 ix = 0;
-        for (quint32 ox=0; ox<oxsz; ox++) {
-            for (quint32 i=0; i < 4; i++)
-                a[i] = cval * amp.outRow[ix+i];
-            for (cval = ixsz - cval; cval > 0; cval-=oxsz) {
-                ix += 4;
-                if (ix >= ibw)
-                    break;            // Safety belt, should not happen
-                quint32 fact = qMin(oxsz, quint32(cval));
+    } else {
+        amp.accRow = new quint32[cbw];
+        memset(amp.accRow, 0, cbw*sizeof(quint32));
+        amp.outRow = new uchar[cbw];
+        memset(amp.outRow, 0, cbw*sizeof(uchar));
+        qint32 rval = 0;
+        for (quint32 oy=0; oy<oysz; oy++) {
+            // Store the rest of the previous input row, if any
+            for (quint32 i=0; i < cbw; i++)
+                amp.accRow[i] = rval*inRow[i];
+            // Accumulate the next input rows
+            for (rval = iysz-rval; rval > 0; rval-=oysz) {
+                png_read_row(png_ptr, amp.inRow, nullptr);
+                quint32 fact = qMin(oysz, quint32(rval));
+                for (quint32 i=0; i < cbw; i++)
+                    amp.accRow[i] += fact*inRow[i];
+            }
+            rval *= -1;
+
+            // We have a full output row, store it
+            for (quint32 i=0; i < cbw; i++)
+                amp.outRow[i] = uchar(amp.accRow[i]/iysz);
+
+            quint32 a[4] = {0, 0, 0, 0};
+            qint32 cval = oxsz;
+            quint32 ix = 0;
+            for (quint32 ox=0; ox<oxsz; ox++) {
+                for (quint32 i=0; i < 4; i++)
+                    a[i] = cval * amp.outRow[ix+i];
+                for (cval = ixsz - cval; cval > 0; cval-=oxsz) {
+                    ix += 4;
+                    if (ix >= cbw)
+                        break;            // Safety belt, should not happen
+                    quint32 fact = qMin(oxsz, quint32(cval));
+                    for (quint32 i=0; i < 4; i++)
+                        a[i] += fact * amp.outRow[ix+i];
+                }
+                cval *= -1;
                 for (quint32 i=0; i < 4; i++)
-                    a[i] += fact * amp.outRow[ix+i];
+                    data[(4*ox)+i] = uchar(a[i]/ixsz);
             }
-            cval *= -1;
-            for (quint32 i=0; i < 4; i++)
-                data[(4*ox)+i] = uchar(a[i]/ixsz);
+            data += bpl;
         }
-        data += bpl;
     }
     amp.deallocate();
 
@@ -461,6 +491,7 @@ static void read_image_scaled(QImage *outImage, png_structp png_ptr, png_infop i
     if (unit_type == PNG_OFFSET_PIXEL)
         outImage->setOffset(QPoint(offset_x*oxsz/ixsz, offset_y*oysz/iysz));
 
+    return quint32(rect.bottom()) == height - 1;
 }
 
 extern "C" {
@@ -632,8 +663,16 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         colorSpaceState = GammaChrm;
     }
 
-    bool doScaledRead = false;
-    if (!setup_qt(*outImage, png_ptr, info_ptr, scaledSize, &doScaledRead)) {
+    const QRect imageRect(0, 0, png_get_image_width(png_ptr, info_ptr),
+                          png_get_image_height(png_ptr, info_ptr));
+    // Clip rects reaching outside the image are left to QImage::copy(), and
+    // the scaling has to wait for it.
+    const bool clipWhileReading = clipRect.isValid() && imageRect.contains(clipRect);
+    const QRect rect = clipWhileReading ? clipRect : imageRect;
+    const QSize inlineScaledSize = clipRect.isValid() && !clipWhileReading ? QSize() : scaledSize;
+
+    bool doRowRead = false;
+    if (!setup_qt(*outImage, png_ptr, info_ptr, inlineScaledSize, rect, &doRowRead)) {
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
         png_ptr = nullptr;
         amp.deallocate();
@@ -641,8 +680,9 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         return false;
     }
 
-    if (doScaledRead) {
-        read_image_scaled(outImage, png_ptr, info_ptr, amp, scaledSize);
+    bool readAllRows = true;
+    if (doRowRead) {
+        readAllRows = read_image_rows(outImage, png_ptr, info_ptr, amp, rect);
     } else {
         png_uint_32 width = 0;
         png_uint_32 height = 0;
@@ -686,9 +726,12 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     }
 
     state = ReadingEnd;
-    png_read_end(png_ptr, end_info);
-
-    readPngTexts(end_info);
+    // When the rows after a clip rect were skipped, the rest of the image
+    // data, and any text chunks following it, are not read.
+    if (readAllRows) {
+        png_read_end(png_ptr, end_info);
+        readPngTexts(end_info);
+    }
     for (int i = 0; i < readTexts.size()-1; i+=2)
         outImage->setText(readTexts.at(i), readTexts.at(i+1));
 
@@ -697,6 +740,8 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     amp.deallocate();
     state = Ready;
 
+    if (clipRect.isValid() && (!doRowRead || !clipWhileReading))
+        *outImage = outImage->copy(clipRect);
     if (scaledSize.isValid() && outImage->size() != scaledSize)
         *outImage = outImage->scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 
@@ -1200,6 +1245,7 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == Quality
         || option == CompressionRatio
         || option == Size
+        || option == ClipRect
         || option == ScaledSize;
 }
 
@@ -1223,6 +1269,8 @@ QVariant QPngHandler::option(ImageOption option) const
                      png_get_image_height(d->png_ptr, d->info_ptr));
     else if (option == ScaledSize)
         return d->scaledSize;
+    else if (option == ClipRect)
+        return d->clipRect;
     else if (option == ImageFormat)
         return d->readImageFormat();
     return QVariant();
@@ -1240,6 +1288,8 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->description = value.toString();
     else if (option == ScaledSize)
         d->scaledSize = value.toSize();
+    else if (option == ClipRect)
+        d->clipRect = value.toRect();
 }
 
 QT_END_NAMESPACE
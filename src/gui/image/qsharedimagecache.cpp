@@ -0,0 +1,269 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsharedimagecache_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+#include <QtGui/qimage.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// Bump Version whenever the layout changes; processes with different
+// layouts must not share a segment.
+static constexpr quint32 Magic = 0x51504d43; // "QPMC"
+static constexpr quint32 Version = 1;
+static constexpr qint64 Alignment = 16;
+
+struct QSharedImageCache::Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 entryCount;
+    quint32 pointerSize;
+    qint64 dataOffset;
+    qint64 dataSize;
+    quint64 clock;
+};
+
+// An entry is free when its hash is 0; hashKey() never returns 0.
+struct QSharedImageCache::Entry
+{
+    quint64 hash;
+    quint64 lastUsed;
+    qint64 offset;     // into the data area
+    qint64 size;       // of the key and the pixels
+    qint32 keyLength;  // in UTF-16 code units
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    qint32 reserved;
+    double devicePixelRatio;
+};
+
+static qint64 aligned(qint64 size)
+{
+    return (size + Alignment - 1) & ~(Alignment - 1);
+}
+
+QSharedImageCache::QSharedImageCache(const QString &name)
+    : memory(QSharedMemory::platformSafeKey(name))
+{
+}
+
+QSharedImageCache::~QSharedImageCache() = default;
+
+// The hash has to be the same in all processes, so unlike qHash() it is
+// not seeded: 64-bit FNV-1a.
+quint64 QSharedImageCache::hashKey(QStringView key) noexcept
+{
+    quint64 hash = 0xcbf29ce484222325ull;
+    for (QChar c : key) {
+        hash = (hash ^ c.unicode()) * 0x100000001b3ull;
+    }
+    return hash ? hash : 1;
+}
+
+QSharedImageCache::Header *QSharedImageCache::header() const
+{
+    return static_cast<Header *>(const_cast<void *>(memory.constData()));
+}
+
+QSharedImageCache::Entry *QSharedImageCache::entries() const
+{
+    return reinterpret_cast<Entry *>(header() + 1);
+}
+
+uchar *QSharedImageCache::data() const
+{
+    return reinterpret_cast<uchar *>(header()) + header()->dataOffset;
+}
+
+bool QSharedImageCache::attach(qsizetype size)
+{
+    if (memory.isAttached())
+        return true;
+    if (!memory.create(size) && !(memory.error() == QSharedMemory::AlreadyExists && memory.attach()))
+        return false;
+
+    // Whichever process gets the lock first on a fresh, zero-filled
+    // segment lays it out.
+    memory.lock();
+    Header *h = header();
+    const qint64 segmentSize = memory.size();
+    if (h->magic == 0) {
+        const qint64 entryCount = qBound(qint64(16), segmentSize / (16 * 1024), qint64(4096));
+        h->entryCount = quint32(entryCount);
+        h->pointerSize = sizeof(void *);
+        h->dataOffset = aligned(sizeof(Header) + entryCount * sizeof(Entry));
+        h->dataSize = (segmentSize - h->dataOffset) & ~(Alignment - 1);
+        h->clock = 0;
+        h->version = Version;
+        h->magic = Magic;
+    }
+    const bool compatible = h->magic == Magic && h->version == Version
+            && h->pointerSize == sizeof(void *) && h->dataSize > 0;
+    memory.unlock();
+
+    if (!compatible) {
+        qWarning("QSharedImageCache: Segment %ls has an incompatible layout",
+                 qUtf16Printable(memory.nativeIpcKey().nativeKey()));
+        memory.detach();
+        return false;
+    }
+    return true;
+}
+
+qsizetype QSharedImageCache::dataSize() const
+{
+    return memory.isAttached() ? header()->dataSize : 0;
+}
+
+QSharedImageCache::Entry *QSharedImageCache::findEntry(QStringView key, quint64 hash) const
+{
+    Entry *e = entries();
+    for (quint32 i = 0; i < header()->entryCount; ++i) {
+        if (e[i].hash != hash || e[i].keyLength != key.size())
+            continue;
+        const auto *storedKey = reinterpret_cast<const char16_t *>(data() + e[i].offset);
+        if (QStringView(storedKey, e[i].keyLength) == key)
+            return &e[i];
+    }
+    return nullptr;
+}
+
+void QSharedImageCache::evictLeastRecentlyUsed()
+{
+    Entry *e = entries();
+    Entry *oldest = nullptr;
+    for (quint32 i = 0; i < header()->entryCount; ++i) {
+        if (e[i].hash && (!oldest || e[i].lastUsed < oldest->lastUsed))
+            oldest = &e[i];
+    }
+    if (oldest)
+        oldest->hash = 0;
+}
+
+// Returns the offset of a free range of size bytes in the data area,
+// evicting entries until there is one, or -1 if size does not fit at all.
+qint64 QSharedImageCache::allocate(qint64 size)
+{
+    const qint64 dataSize = header()->dataSize;
+    if (size > dataSize)
+        return -1;
+    const Entry *e = entries();
+    const quint32 entryCount = header()->entryCount;
+    QVarLengthArray<std::pair<qint64, qint64>, 256> used;
+    while (true) {
+        used.clear();
+        for (quint32 i = 0; i < entryCount; ++i) {
+            if (e[i].hash)
+                used.append({ e[i].offset, e[i].size });
+        }
+        if (qsizetype(used.size()) == qsizetype(entryCount)) {
+            evictLeastRecentlyUsed();
+            continue;
+        }
+        std::sort(used.begin(), used.end());
+        qint64 start = 0;
+        for (const auto &[offset, length] : std::as_const(used)) {
+            if (offset - start >= size)
+                return start;
+            start = offset + length;
+        }
+        if (dataSize - start >= size)
+            return start;
+        evictLeastRecentlyUsed();
+    }
+}
+
+bool QSharedImageCache::find(QStringView key, QImage *image)
+{
+    if (!memory.isAttached() || !memory.lock())
+        return false;
+    Entry *entry = findEntry(key, hashKey(key));
+    if (entry) {
+        entry->lastUsed = ++header()->clock;
+        if (image) {
+            QImage result(entry->width, entry->height, QImage::Format(entry->format));
+            if (result.isNull()) {
+                entry = nullptr;
+            } else {
+                const uchar *pixels = data() + entry->offset + aligned(entry->keyLength * 2);
+                const qsizetype lineSize = qMin(result.bytesPerLine(), qsizetype(entry->bytesPerLine));
+                for (int y = 0; y < entry->height; ++y)
+                    memcpy(result.scanLine(y), pixels + y * qsizetype(entry->bytesPerLine), lineSize);
+                result.setDevicePixelRatio(entry->devicePixelRatio);
+                *image = std::move(result);
+            }
+        }
+    }
+    memory.unlock();
+    return entry != nullptr;
+}
+
+bool QSharedImageCache::insert(QStringView key, const QImage &image)
+{
+    if (image.isNull() || image.format() == QImage::Format_Indexed8 || image.depth() < 8)
+        return false;
+    if (!memory.isAttached() || !memory.lock())
+        return false;
+
+    const quint64 hash = hashKey(key);
+    if (Entry *old = findEntry(key, hash))
+        old->hash = 0;
+
+    const qint64 keySize = aligned(key.size() * 2);
+    const qint64 size = keySize + aligned(image.sizeInBytes());
+    // Don't let a single image flush the whole cache
+    const qint64 offset = size <= header()->dataSize / 4 ? allocate(size) : -1;
+    Entry *entry = nullptr;
+    if (offset >= 0) {
+        Entry *e = entries();
+        for (quint32 i = 0; i < header()->entryCount && !entry; ++i) {
+            if (!e[i].hash)
+                entry = &e[i];
+        }
+    }
+    if (entry) {
+        uchar *block = data() + offset;
+        memcpy(block, key.utf16(), key.size() * 2);
+        memcpy(block + keySize, image.constBits(), image.sizeInBytes());
+        entry->lastUsed = ++header()->clock;
+        entry->offset = offset;
+        entry->size = size;
+        entry->keyLength = qint32(key.size());
+        entry->width = image.width();
+        entry->height = image.height();
+        entry->bytesPerLine = qint32(image.bytesPerLine());
+        entry->format = image.format();
+        entry->reserved = 0;
+        entry->devicePixelRatio = image.devicePixelRatio();
+        entry->hash = hash;
+    }
+    memory.unlock();
+    return entry != nullptr;
+}
+
+void QSharedImageCache::remove(QStringView key)
+{
+    if (!memory.isAttached() || !memory.lock())
+        return;
+    if (Entry *entry = findEntry(key, hashKey(key)))
+        entry->hash = 0;
+    memory.unlock();
+}
+
+void QSharedImageCache::clear()
+{
+    if (!memory.isAttached() || !memory.lock())
+        return;
+    Entry *e = entries();
+    for (quint32 i = 0; i < header()->entryCount; ++i)
+        e[i].hash = 0;
+    memory.unlock();
+}
+
+QT_END_NAMESPACE
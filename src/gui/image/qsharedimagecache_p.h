@@ -0,0 +1,71 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSHAREDIMAGECACHE_P_H
+#define QSHAREDIMAGECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtCore/qsharedmemory.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(sharedmemory);
+QT_REQUIRE_CONFIG(systemsemaphore);
+
+QT_BEGIN_NAMESPACE
+
+class QImage;
+
+// An LRU cache of images, keyed by strings, in a shared memory segment that
+// all processes using the same name see. The segment starts with a header,
+// followed by a fixed table of entries and the data area, in which each
+// entry's key and pixels are allocated first-fit; the least recently used
+// entries are evicted to make room.
+class Q_GUI_EXPORT QSharedImageCache
+{
+public:
+    explicit QSharedImageCache(const QString &name);
+    ~QSharedImageCache();
+
+    // Creates the segment with the given size, or attaches to an existing
+    // one, whose size is then kept.
+    bool attach(qsizetype size);
+    bool isAttached() const { return memory.isAttached(); }
+    qsizetype dataSize() const;
+
+    bool find(QStringView key, QImage *image);
+    bool insert(QStringView key, const QImage &image);
+    void remove(QStringView key);
+    void clear();
+
+    static quint64 hashKey(QStringView key) noexcept;
+
+private:
+    Q_DISABLE_COPY_MOVE(QSharedImageCache)
+
+    struct Header;
+    struct Entry;
+
+    Header *header() const;
+    Entry *entries() const;
+    uchar *data() const;
+    Entry *findEntry(QStringView key, quint64 hash) const;
+    qint64 allocate(qint64 size);
+    void evictLeastRecentlyUsed();
+
+    QSharedMemory memory;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSHAREDIMAGECACHE_P_H
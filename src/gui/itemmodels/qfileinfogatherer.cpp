@@ -17,6 +17,11 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+// The files of a directory are stat()ed on several threads, by rounds small
+// enough to keep the updates flowing, each thread taking at least a chunk
+static constexpr qsizetype StatRoundSize = 4096;
+static constexpr qsizetype StatChunkSize = 256;
+
 #ifdef QT_BUILD_INTERNAL
 Q_CONSTINIT static QBasicAtomicInt fetchedRoot = Q_BASIC_ATOMIC_INITIALIZER(false);
 Q_AUTOTEST_EXPORT void qt_test_resetFetchedRoot()
@@ -49,6 +54,10 @@ QFileInfoGatherer::QFileInfoGatherer(QObject *parent)
     : QThread(parent)
     , m_iconProvider(&defaultProvider)
 {
+#if QT_CONFIG(thread)
+    statPool.setObjectName("QFileInfoGatherer stat pool"_L1);
+    statPool.setThreadPriority(LowPriority);
+#endif
     start(LowPriority);
 }
 
@@ -296,10 +305,13 @@ void QFileInfoGatherer::run()
     }
 }
 
+/*
+    Returns the information about \a fileInfo, except for its icon, which
+    QFileSystemModel only fetches when it is displayed.
+*/
 QExtendedInformation QFileInfoGatherer::getInfo(const QFileInfo &fileInfo) const
 {
     QExtendedInformation info(fileInfo);
-    info.icon = m_iconProvider->icon(fileInfo);
     info.displayType = m_iconProvider->type(fileInfo);
 #if QT_CONFIG(filesystemwatcher)
     // ### Not ready to listen all modifications by default
@@ -367,18 +379,29 @@ void QFileInfoGatherer::getFileInfos(const QString &path, const QStringList &fil
     QList<QPair<QString, QFileInfo>> updatedFiles;
     QStringList filesToCheck = files;
 
-    QStringList allFiles;
     if (files.isEmpty()) {
-        QDirIterator dirIt(path, QDir::AllEntries | QDir::System | QDir::Hidden);
-        while (!abort.loadRelaxed() && dirIt.hasNext()) {
-            fileInfo = dirIt.nextFileInfo();
-            fileInfo.stat();
-            allFiles.append(fileInfo.fileName());
-            fetch(fileInfo, base, firstTime, updatedFiles, path);
+        // Reading the directory is fast, so the model learns about removed
+        // files right away; the file information then comes in batches
+        QFileInfoList infoList;
+        QStringList allFiles;
+        {
+            QDirIterator dirIt(path, QDir::AllEntries | QDir::System | QDir::Hidden);
+            while (!abort.loadRelaxed() && dirIt.hasNext()) {
+                infoList.append(dirIt.nextFileInfo());
+                allFiles.append(infoList.constLast().fileName());
+            }
+        }
+        if (!allFiles.isEmpty())
+            emit newListOfFiles(path, allFiles);
+
+        for (qsizetype done = 0; !abort.loadRelaxed() && done < infoList.size(); ) {
+            const qsizetype roundEnd = qMin(done + StatRoundSize, infoList.size());
+            statFileInfos(infoList.data() + done, roundEnd - done);
+            for (qsizetype i = done; i < roundEnd; ++i)
+                fetch(infoList.at(i), base, firstTime, updatedFiles, path);
+            done = roundEnd;
         }
     }
-    if (!allFiles.isEmpty())
-        emit newListOfFiles(path, allFiles);
 
     QStringList::const_iterator filesIt = filesToCheck.constBegin();
     while (!abort.loadRelaxed() && filesIt != filesToCheck.constEnd()) {
@@ -392,6 +415,37 @@ void QFileInfoGatherer::getFileInfos(const QString &path, const QStringList &fil
     emit directoryLoaded(path);
 }
 
+/*
+    Fills the metadata of the \a count file infos starting at \a infos,
+    spreading them over the threads of statPool. This matters for
+    directories with many files, and even more so on network file systems,
+    where each stat() waits for the server.
+ */
+void QFileInfoGatherer::statFileInfos(QFileInfo *infos, qsizetype count)
+{
+    qsizetype chunkSize = count;
+#if QT_CONFIG(thread)
+    const qsizetype chunkCount = qMin((count + StatChunkSize - 1) / StatChunkSize,
+                                      qsizetype(statPool.maxThreadCount()) + 1);
+    if (chunkCount > 1) {
+        chunkSize = (count + chunkCount - 1) / chunkCount;
+        for (qsizetype start = chunkSize; start < count; start += chunkSize) {
+            const qsizetype end = qMin(start + chunkSize, count);
+            statPool.start([infos, start, end] {
+                for (qsizetype i = start; i < end; ++i)
+                    infos[i].stat();
+            });
+        }
+    }
+#endif
+    // this thread takes the first chunk
+    for (qsizetype i = 0; i < chunkSize; ++i)
+        infos[i].stat();
+#if QT_CONFIG(thread)
+    statPool.waitForDone();
+#endif
+}
+
 void QFileInfoGatherer::fetch(const QFileInfo &fileInfo, QElapsedTimer &base, bool &firstTime,
                               QList<QPair<QString, QFileInfo>> &updatedFiles, const QString &path)
 {
@@ -18,6 +18,9 @@
 #include <QtGui/private/qtguiglobal_p.h>
 
 #include <qthread.h>
+#if QT_CONFIG(thread)
+#include <qthreadpool.h>
+#endif
 #include <qmutex.h>
 #include <qwaitcondition.h>
 #if QT_CONFIG(filesystemwatcher)
@@ -112,6 +115,8 @@ public:
 
     QString displayType;
     QIcon icon;
+    // icons are only fetched once a view asks for them
+    bool iconFetched = false;
 
 private :
     QFileInfo mFileInfo;
@@ -163,6 +168,7 @@ private:
     void run() override;
     // called by run():
     void getFileInfos(const QString &path, const QStringList &files);
+    void statFileInfos(QFileInfo *infos, qsizetype count);
     void fetch(const QFileInfo &info, QElapsedTimer &base, bool &firstTime,
                QList<QPair<QString, QFileInfo>> &updatedFiles, const QString &path);
 
@@ -176,6 +182,9 @@ private:
     QStack<QStringList> files;
     // end protected by mutex
     QAtomicInt abort;
+#if QT_CONFIG(thread)
+    QThreadPool statPool; // only used by run()
+#endif
 
 #if QT_CONFIG(filesystemwatcher)
     QFileSystemWatcher *m_watcher = nullptr;
@@ -9,6 +9,7 @@
 #include <qurl.h>
 #include <qdebug.h>
 #include <QtCore/qcollator.h>
+#include <QtCore/qelapsedtimer.h>
 #if QT_CONFIG(regularexpression)
 #  include <QtCore/qregularexpression.h>
 #endif
@@ -487,6 +488,8 @@ void QFileSystemModel::timerEvent(QTimerEvent *event)
         }
 #endif
         d->toFetch.clear();
+    } else if (event->timerId() == d->iconTimer.timerId()) {
+        d->fetchPendingIcons();
     }
 }
 
@@ -845,7 +848,52 @@ QIcon QFileSystemModelPrivate::icon(const QModelIndex &index) const
 {
     if (!index.isValid())
         return QIcon();
-    return node(index)->icon();
+    QFileSystemNode *indexNode = node(index);
+#if QT_CONFIG(filesystemwatcher)
+    // Icon providers can take long, and only the icons of the files on
+    // display are needed, so they are fetched when they are first asked for,
+    // in the background of the event loop. Until then, the generic icons
+    // are used.
+    if (indexNode->info && !indexNode->info->iconFetched) {
+        Q_Q(const QFileSystemModel);
+        QFileSystemModelPrivate *p = const_cast<QFileSystemModelPrivate*>(this);
+        p->pendingIcons.append(index.sibling(index.row(), NameColumn));
+        if (!iconTimer.isActive())
+            p->iconTimer.start(0, const_cast<QFileSystemModel*>(q));
+    }
+#endif
+    return indexNode->icon();
+}
+
+/*!
+    \internal
+
+    Fetches the icons in pendingIcons, for a few milliseconds at most.
+*/
+void QFileSystemModelPrivate::fetchPendingIcons()
+{
+#if QT_CONFIG(filesystemwatcher)
+    Q_Q(QFileSystemModel);
+    QAbstractFileIconProvider *provider = fileInfoGatherer.iconProvider();
+    QElapsedTimer timer;
+    timer.start();
+    qsizetype fetched = 0;
+    while (fetched < pendingIcons.size() && timer.elapsed() < 10) {
+        // the icon may have been asked for several times, or the file be gone
+        const QModelIndex index = pendingIcons.at(fetched++);
+        if (!index.isValid())
+            continue;
+        QFileSystemNode *indexNode = node(index);
+        if (!indexNode->info || indexNode->info->iconFetched)
+            continue;
+        indexNode->info->icon = provider->icon(indexNode->fileInfo());
+        indexNode->info->iconFetched = true;
+        emit q->dataChanged(index, index, { Qt::DecorationRole });
+    }
+    pendingIcons.remove(0, fetched);
+#endif
+    if (pendingIcons.isEmpty())
+        iconTimer.stop();
 }
 
 /*!
@@ -906,6 +954,8 @@ bool QFileSystemModel::setData(const QModelIndex &idx, const QVariant &value, in
         nodeToRename->isVisible = true;
         parentNode->children[newName] = nodeToRename.release();
         parentNode->visibleChildren.insert(visibleLocation, newName);
+        // the new name is out of place, the children can't just be merged
+        parentNode->sortedColumn = -1;
 
         d->delayedSort();
         emit fileRenamed(parentPath, oldName, newName);
@@ -1084,7 +1134,8 @@ private:
 
     Sort all of the children of parent
 */
-void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent)
+void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent,
+                                           bool mergeAppended)
 {
     Q_Q(QFileSystemModel);
     QFileSystemModelPrivate::QFileSystemNode *indexNode = node(parent);
@@ -1092,24 +1143,44 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
         return;
 
     QList<QFileSystemModelPrivate::QFileSystemNode *> values;
+    QFileSystemModelSorter ms(column);
 
-    for (auto iterator = indexNode->children.constBegin(), cend = indexNode->children.constEnd(); iterator != cend; ++iterator) {
-        if (filtersAcceptsNode(iterator.value())) {
-            values.append(iterator.value());
-        } else {
-            iterator.value()->isVisible = false;
+    if (mergeAppended && indexNode->sortedColumn == column) {
+        // Only the children appended since the last sort are out of place:
+        // sort them and merge them with the others, which is much cheaper
+        // than sorting everything again while a large directory is loading
+        if (indexNode->dirtyChildrenIndex != -1) {
+            values.reserve(indexNode->visibleChildren.size());
+            for (const QString &childName : std::as_const(indexNode->visibleChildren))
+                values.append(indexNode->children.value(childName));
+            const auto appended = values.begin() + indexNode->dirtyChildrenIndex;
+            std::sort(appended, values.end(), ms);
+            std::inplace_merge(values.begin(), appended, values.end(), ms);
+        }
+    } else {
+        for (auto iterator = indexNode->children.constBegin(), cend = indexNode->children.constEnd(); iterator != cend; ++iterator) {
+            if (filtersAcceptsNode(iterator.value())) {
+                values.append(iterator.value());
+            } else {
+                iterator.value()->isVisible = false;
+            }
         }
+        std::sort(values.begin(), values.end(), ms);
+        indexNode->sortedColumn = column;
+        // make sure the list is rebuilt below
+        indexNode->dirtyChildrenIndex = 0;
     }
-    QFileSystemModelSorter ms(column);
-    std::sort(values.begin(), values.end(), ms);
-    // First update the new visible list
-    indexNode->visibleChildren.clear();
-    //No more dirty item we reset our internal dirty index
-    indexNode->dirtyChildrenIndex = -1;
-    indexNode->visibleChildren.reserve(values.size());
-    for (QFileSystemNode *node : std::as_const(values)) {
-        indexNode->visibleChildren.append(node->fileName);
-        node->isVisible = true;
+
+    if (indexNode->dirtyChildrenIndex != -1) {
+        // First update the new visible list
+        indexNode->visibleChildren.clear();
+        //No more dirty item we reset our internal dirty index
+        indexNode->dirtyChildrenIndex = -1;
+        indexNode->visibleChildren.reserve(values.size());
+        for (QFileSystemNode *node : std::as_const(values)) {
+            indexNode->visibleChildren.append(node->fileName);
+            node->isVisible = true;
+        }
     }
 
     if (!disableRecursiveSort) {
@@ -1118,7 +1189,7 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
             QFileSystemModelPrivate::QFileSystemNode *indexNode = node(childIndex);
             //Only do a recursive sort on visible nodes
             if (indexNode->isVisible)
-                sortChildren(column, childIndex);
+                sortChildren(column, childIndex, mergeAppended);
         }
     }
 }
@@ -1129,7 +1200,8 @@ void QFileSystemModelPrivate::sortChildren(int column, const QModelIndex &parent
 void QFileSystemModel::sort(int column, Qt::SortOrder order)
 {
     Q_D(QFileSystemModel);
-    if (d->sortOrder == order && d->sortColumn == column && !d->forceSort)
+    if (d->sortOrder == order && d->sortColumn == column && !d->forceSort
+            && !d->appendedChildren)
         return;
 
     emit layoutAboutToBeChanged();
@@ -1141,12 +1213,16 @@ void QFileSystemModel::sort(int column, Qt::SortOrder order)
         oldNodes.append(pair);
     }
 
-    if (!(d->sortColumn == column && d->sortOrder != order && !d->forceSort)) {
+    // If only the order changed, the children don't need to be sorted again;
+    // if only children were added, they are merged with the sorted ones
+    const bool mergeOnly = d->sortColumn == column && !d->forceSort;
+    if (!mergeOnly || d->sortOrder == order || d->appendedChildren) {
         //we sort only from where we are, don't need to sort all the model
-        d->sortChildren(column, index(rootPath()));
+        d->sortChildren(column, index(rootPath()), mergeOnly);
         d->sortColumn = column;
         d->forceSort = false;
     }
+    d->appendedChildren = false;
     d->sortOrder = order;
 
     QModelIndexList newList;
@@ -1850,7 +1926,7 @@ void QFileSystemModelPrivate::removeNode(QFileSystemModelPrivate::QFileSystemNod
     delete node;
     // cleanup sort files after removing rather then re-sorting which is O(n)
     if (vLocation >= 0)
-        parentNode->visibleChildren.removeAt(vLocation);
+        parentNode->removeVisibleChild(vLocation);
     if (vLocation >= 0 && !indexHidden)
         q->endRemoveRows();
 }
@@ -1901,7 +1977,7 @@ void QFileSystemModelPrivate::removeVisibleFile(QFileSystemNode *parentNode, int
         q->beginRemoveRows(parent, translateVisibleLocation(parentNode, vLocation),
                                        translateVisibleLocation(parentNode, vLocation));
     parentNode->children.value(parentNode->visibleChildren.at(vLocation))->isVisible = false;
-    parentNode->visibleChildren.removeAt(vLocation);
+    parentNode->removeVisibleChild(vLocation);
     if (!indexHidden)
         q->endRemoveRows();
 }
@@ -2010,9 +2086,13 @@ void QFileSystemModelPrivate::_q_fileSystemChanged(const QString &path,
         addVisibleFiles(parentNode, newFiles);
     }
 
-    if (newFiles.size() > 0 || (sortColumn != 0 && rowsToUpdate.size() > 0)) {
+    if (sortColumn != 0 && rowsToUpdate.size() > 0) {
         forceSort = true;
         delayedSort();
+    } else if (newFiles.size() > 0) {
+        // the new files are at the end of visibleChildren, see sortChildren()
+        appendedChildren = true;
+        delayedSort();
     }
 #else
     Q_UNUSED(path);
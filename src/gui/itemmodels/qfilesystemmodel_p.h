@@ -149,9 +149,17 @@ public:
         inline int visibleLocation(const QString &childName) {
             return visibleChildren.indexOf(childName);
         }
+        // keeps the unsorted children at the end, see sortChildren()
+        void removeVisibleChild(int location) {
+            visibleChildren.removeAt(location);
+            if (location < dirtyChildrenIndex)
+                --dirtyChildrenIndex;
+        }
         void updateIcon(QAbstractFileIconProvider *iconProvider, const QString &path) {
-            if (info)
+            if (info) {
                 info->icon = iconProvider->icon(QFileInfo(path));
+                info->iconFetched = true;
+            }
             for (QFileSystemNode *child : std::as_const(children)) {
                 //On windows the root (My computer) has no path so we don't want to add a / for nothing (e.g. /C:/)
                 if (!path.isEmpty()) {
@@ -184,6 +192,9 @@ public:
         QExtendedInformation *info = nullptr;
         QFileSystemNode *parent;
         int dirtyChildrenIndex = -1;
+        // the column by which the visibleChildren before dirtyChildrenIndex
+        // are sorted, or -1 if they aren't
+        int sortedColumn = -1;
         bool populatedChildren = false;
         bool isVisible = false;
     };
@@ -210,7 +221,7 @@ public:
     QFileSystemNode* addNode(QFileSystemNode *parentNode, const QString &fileName, const QFileInfo &info);
     void addVisibleFiles(QFileSystemNode *parentNode, const QStringList &newFiles);
     void removeVisibleFile(QFileSystemNode *parentNode, int visibleLocation);
-    void sortChildren(int column, const QModelIndex &parent);
+    void sortChildren(int column, const QModelIndex &parent, bool mergeAppended = false);
 
     inline int translateVisibleLocation(QFileSystemNode *parent, int row) const {
         if (sortOrder != Qt::AscendingOrder) {
@@ -242,6 +253,7 @@ public:
     }
 
     QIcon icon(const QModelIndex &index) const;
+    void fetchPendingIcons();
     QString name(const QModelIndex &index) const;
     QString displayName(const QModelIndex &index) const;
     QString filePath(const QModelIndex &index) const;
@@ -283,10 +295,16 @@ public:
 
     QBasicTimer fetchingTimer;
 
+    // the name column indexes of the nodes whose icons were asked for
+    QList<QPersistentModelIndex> pendingIcons;
+    QBasicTimer iconTimer;
+
     QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::AllDirs;
     int sortColumn = 0;
     Qt::SortOrder sortOrder = Qt::AscendingOrder;
     bool forceSort = true;
+    // new children were appended to sorted ones, see sortChildren()
+    bool appendedChildren = false;
     bool readOnly = true;
     bool setRootPath = false;
     bool nameFilterDisables = true; // false on windows, true on mac and unix
@@ -16,6 +16,7 @@
 #include <private/qstandarditemmodel_p.h>
 #include <qdebug.h>
 #include <algorithm>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -86,6 +87,9 @@ void QStandardItemPrivate::setChild(int row, int column, QStandardItem *item,
     int index = childIndex(row, column);
     Q_ASSERT(index != -1);
     QStandardItem *oldItem = children.at(index);
+    // the new item, or the lack of one, replaces the values in compact storage
+    if (!oldItem && hasCompactChildren())
+        model->d_func()->clearCompactData(row, column, emitChanged && !item);
     if (item == oldItem)
         return;
 
@@ -132,6 +136,16 @@ void QStandardItemPrivate::setChild(int row, int column, QStandardItem *item,
 }
 
 
+/*!
+  \internal
+  Returns \c true if this is the invisible root item of a model that keeps
+  the children without items in compact storage.
+*/
+bool QStandardItemPrivate::hasCompactChildren() const
+{
+    return model && model->d_func()->compactStorage && model->d_func()->root.data() == q_ptr;
+}
+
 /*!
   \internal
 */
@@ -295,36 +309,84 @@ void QStandardItemPrivate::sortChildren(int column, Qt::SortOrder order)
     if (column >= columnCount())
         return;
 
-    QList<QPair<QStandardItem*, int> > sortable;
+    const bool compact = hasCompactChildren();
+    QList<int> sourceRows;
     QList<int> unsortable;
 
-    sortable.reserve(rowCount());
+    sourceRows.reserve(rowCount());
     unsortable.reserve(rowCount());
 
-    for (int row = 0; row < rowCount(); ++row) {
-        QStandardItem *itm = q->child(row, column);
-        if (itm)
-            sortable.append(QPair<QStandardItem*,int>(itm, row));
-        else
-            unsortable.append(row);
-    }
+    if (compact) {
+        // The cells in compact storage compare like the items they would be
+        // turned into
+        struct SortKey
+        {
+            QStandardItem *item;
+            QVariant value;
+            int row;
+        };
+        const QStandardItemModelPrivate *model_d = model->d_func();
+        const int role = model->sortRole();
+        QList<SortKey> sortable;
+        sortable.reserve(rowCount());
 
-    if (order == Qt::AscendingOrder) {
-        QStandardItemModelLessThan lt;
-        std::stable_sort(sortable.begin(), sortable.end(), lt);
+        for (int row = 0; row < rowCount(); ++row) {
+            QStandardItem *itm = children.at(childIndex(row, column));
+            if (itm)
+                sortable.append(SortKey{ itm, QVariant(), row });
+            else if (model_d->hasCompactData(row, column))
+                sortable.append(SortKey{ nullptr, model_d->compactData(row, column, role), row });
+            else
+                unsortable.append(row);
+        }
+
+        auto lessThan = [role](const SortKey &l, const SortKey &r) {
+            if (l.item && r.item)
+                return *(l.item) < *(r.item);
+            return QAbstractItemModelPrivate::isVariantLessThan(
+                    l.item ? l.item->data(role) : l.value,
+                    r.item ? r.item->data(role) : r.value);
+        };
+        if (order == Qt::AscendingOrder) {
+            std::stable_sort(sortable.begin(), sortable.end(), lessThan);
+        } else {
+            std::stable_sort(sortable.begin(), sortable.end(),
+                             [&lessThan](const SortKey &l, const SortKey &r) {
+                return lessThan(r, l);
+            });
+        }
+        for (const SortKey &key : std::as_const(sortable))
+            sourceRows.append(key.row);
     } else {
-        QStandardItemModelGreaterThan gt;
-        std::stable_sort(sortable.begin(), sortable.end(), gt);
+        QList<QPair<QStandardItem*, int> > sortable;
+        sortable.reserve(rowCount());
+
+        for (int row = 0; row < rowCount(); ++row) {
+            QStandardItem *itm = q->child(row, column);
+            if (itm)
+                sortable.append(QPair<QStandardItem*,int>(itm, row));
+            else
+                unsortable.append(row);
+        }
+
+        if (order == Qt::AscendingOrder) {
+            QStandardItemModelLessThan lt;
+            std::stable_sort(sortable.begin(), sortable.end(), lt);
+        } else {
+            QStandardItemModelGreaterThan gt;
+            std::stable_sort(sortable.begin(), sortable.end(), gt);
+        }
+        for (const auto &entry : std::as_const(sortable))
+            sourceRows.append(entry.second);
     }
+    sourceRows += unsortable;
 
     QModelIndexList changedPersistentIndexesFrom, changedPersistentIndexesTo;
     QList<QStandardItem*> sorted_children(children.size());
     for (int i = 0; i < rowCount(); ++i) {
-        int r = (i < sortable.size()
-                 ? sortable.at(i).second
-                 : unsortable.at(i - sortable.size()));
+        int r = sourceRows.at(i);
         for (int c = 0; c < columnCount(); ++c) {
-            QStandardItem *itm = q->child(r, c);
+            QStandardItem *itm = children.at(childIndex(r, c));
             sorted_children[childIndex(i, c)] = itm;
             if (model) {
                 QModelIndex from = model->createIndex(r, c, q);
@@ -338,6 +400,8 @@ void QStandardItemPrivate::sortChildren(int column, Qt::SortOrder order)
     }
 
     children = sorted_children;
+    if (compact)
+        model->d_func()->permuteCompactRows(sourceRows);
 
     if (model) {
         model->changePersistentIndexList(changedPersistentIndexesFrom, changedPersistentIndexesTo);
@@ -383,7 +447,7 @@ void QStandardItemPrivate::setModel(QStandardItemModel *mod)
   \internal
 */
 QStandardItemModelPrivate::QStandardItemModelPrivate()
-    : root(new QStandardItem), itemPrototype(nullptr)
+    : root(new QStandardItem), itemPrototype(nullptr), compactStorage(false)
 {
     root->setFlags(Qt::ItemIsDropEnabled);
 }
@@ -423,6 +487,190 @@ void QStandardItemModelPrivate::_q_emitItemChanged(const QModelIndex &topLeft,
     }
 }
 
+/*!
+    \internal
+    Returns the value of \a role in the top-level cell at (\a row, \a column)
+    in compact storage.
+*/
+QVariant QStandardItemModelPrivate::compactData(int row, int column, int role) const
+{
+    const int r = (role == Qt::EditRole) ? Qt::DisplayRole : role;
+    for (const QStandardItemCompactRole &compactRole : compactColumns.at(column)) {
+        if (compactRole.role == r)
+            return compactRole.values.at(row);
+    }
+    return QVariant();
+}
+
+/*!
+    \internal
+*/
+QMap<int, QVariant> QStandardItemModelPrivate::compactItemData(int row, int column) const
+{
+    QMap<int, QVariant> result;
+    for (const QStandardItemCompactRole &compactRole : compactColumns.at(column)) {
+        // Qt::UserRole - 1 is used internally to store the flags
+        const QVariant &value = compactRole.values.at(row);
+        if (value.isValid() && compactRole.role != Qt::UserRole - 1)
+            result.insert(compactRole.role, value);
+    }
+    return result;
+}
+
+/*!
+    \internal
+*/
+bool QStandardItemModelPrivate::hasCompactData(int row, int column) const
+{
+    const QStandardItemCompactColumn &compactColumn = compactColumns.at(column);
+    return std::any_of(compactColumn.cbegin(), compactColumn.cend(),
+                       [row](const QStandardItemCompactRole &compactRole) {
+        return compactRole.values.at(row).isValid();
+    });
+}
+
+/*!
+    \internal
+    Sets the values of \a roles in the top-level cell at (\a row, \a column)
+    in compact storage, the same way QStandardItem::setData() would.
+*/
+void QStandardItemModelPrivate::setCompactData(int row, int column,
+                                               const QMap<int, QVariant> &roles)
+{
+    Q_Q(QStandardItemModel);
+    QStandardItemCompactColumn &compactColumn = compactColumns[column];
+    QList<int> changedRoles;
+    for (auto it = roles.cbegin(); it != roles.cend(); ++it) {
+        const int role = (it.key() == Qt::EditRole) ? Qt::DisplayRole : it.key();
+        const QVariant &value = it.value();
+        auto compactRole = std::find_if(compactColumn.begin(), compactColumn.end(),
+                                        [role](const QStandardItemCompactRole &compactRole) {
+            return compactRole.role == role;
+        });
+        if (compactRole == compactColumn.end()) {
+            if (!value.isValid())
+                continue;
+            // the array of a role is only allocated once a cell has a value for it
+            compactColumn.append(QStandardItemCompactRole{ role,
+                                                           QList<QVariant>(root->rowCount()) });
+            compactRole = compactColumn.end() - 1;
+        }
+        QVariant &current = compactRole->values[row];
+        if (current.userType() == value.userType() && current == value)
+            continue;
+        current = value;
+        if (!changedRoles.contains(role)) {
+            changedRoles.append(role);
+            if (role == Qt::DisplayRole)
+                changedRoles.append(Qt::EditRole);
+        }
+    }
+    if (!changedRoles.isEmpty()) {
+        const QModelIndex index = q->index(row, column);
+        emit q->dataChanged(index, index, changedRoles);
+    }
+}
+
+/*!
+    \internal
+    Removes the values of the top-level cell at (\a row, \a column) from
+    compact storage.
+*/
+void QStandardItemModelPrivate::clearCompactData(int row, int column, bool emitChanged)
+{
+    Q_Q(QStandardItemModel);
+    bool changed = false;
+    for (QStandardItemCompactRole &compactRole : compactColumns[column]) {
+        QVariant &value = compactRole.values[row];
+        if (value.isValid()) {
+            value = QVariant();
+            changed = true;
+        }
+    }
+    if (changed && emitChanged) {
+        const QModelIndex index = q->index(row, column);
+        emit q->dataChanged(index, index, QList<int>{});
+    }
+}
+
+/*!
+    \internal
+    Creates an item holding the values of the top-level cell at (\a row,
+    \a column) in compact storage, and puts it in the place of the values.
+    Returns \nullptr if the cell has no values.
+*/
+QStandardItem *QStandardItemModelPrivate::materializeCompactCell(int row, int column)
+{
+    Q_Q(QStandardItemModel);
+    if (!compactStorage || !hasCompactData(row, column))
+        return nullptr;
+
+    QStandardItem *item = createItem();
+    QList<QStandardItemData> &values = item->d_func()->values;
+    for (QStandardItemCompactRole &compactRole : compactColumns[column]) {
+        QVariant &value = compactRole.values[row];
+        if (!value.isValid())
+            continue;
+        // the values override the ones of the item prototype
+        auto it = std::find_if(values.begin(), values.end(),
+                               [&compactRole](const QStandardItemData &data) {
+            return data.role == compactRole.role;
+        });
+        if (it != values.end())
+            it->value = std::exchange(value, QVariant());
+        else
+            values.append(QStandardItemData(compactRole.role, std::exchange(value, QVariant())));
+    }
+
+    QStandardItemPrivate *root_d = root->d_func();
+    const int index = root_d->childIndex(row, column);
+    Q_ASSERT(index != -1 && root_d->children.at(index) == nullptr);
+    item->d_func()->setParentAndModel(root.data(), q);
+    root_d->children.replace(index, item);
+    item->d_func()->lastKnownIndex = index;
+    return item;
+}
+
+/*!
+    \internal
+*/
+void QStandardItemModelPrivate::insertCompactRows(int row, int count)
+{
+    for (QStandardItemCompactColumn &compactColumn : compactColumns) {
+        for (QStandardItemCompactRole &compactRole : compactColumn)
+            compactRole.values.insert(row, count, QVariant());
+    }
+}
+
+/*!
+    \internal
+*/
+void QStandardItemModelPrivate::removeCompactRows(int row, int count)
+{
+    for (QStandardItemCompactColumn &compactColumn : compactColumns) {
+        for (QStandardItemCompactRole &compactRole : compactColumn)
+            compactRole.values.remove(row, count);
+    }
+}
+
+/*!
+    \internal
+    Reorders the rows in compact storage, so that row \c i holds the values
+    that were in row \c{sourceRows[i]}.
+*/
+void QStandardItemModelPrivate::permuteCompactRows(const QList<int> &sourceRows)
+{
+    for (QStandardItemCompactColumn &compactColumn : compactColumns) {
+        for (QStandardItemCompactRole &compactRole : compactColumn) {
+            QList<QVariant> values;
+            values.reserve(sourceRows.size());
+            for (int sourceRow : sourceRows)
+                values.append(std::move(compactRole.values[sourceRow]));
+            compactRole.values.swap(values);
+        }
+    }
+}
+
 /*!
     \internal
 */
@@ -622,8 +870,11 @@ void QStandardItemModelPrivate::rowsInserted(QStandardItem *parent,
                                              int row, int count)
 {
     Q_Q(QStandardItemModel);
-    if (parent == root.data())
+    if (parent == root.data()) {
         rowHeaderItems.insert(row, count, nullptr);
+        if (compactStorage)
+            insertCompactRows(row, count);
+    }
     q->endInsertRows();
 }
 
@@ -634,8 +885,11 @@ void QStandardItemModelPrivate::columnsInserted(QStandardItem *parent,
                                                 int column, int count)
 {
     Q_Q(QStandardItemModel);
-    if (parent == root.data())
+    if (parent == root.data()) {
         columnHeaderItems.insert(column, count, nullptr);
+        if (compactStorage)
+            compactColumns.insert(column, count, QStandardItemCompactColumn());
+    }
     q->endInsertColumns();
 }
 
@@ -654,6 +908,8 @@ void QStandardItemModelPrivate::rowsRemoved(QStandardItem *parent,
             delete oldItem;
         }
         rowHeaderItems.remove(row, count);
+        if (compactStorage)
+            removeCompactRows(row, count);
     }
     q->endRemoveRows();
 }
@@ -673,6 +929,8 @@ void QStandardItemModelPrivate::columnsRemoved(QStandardItem *parent,
             delete oldItem;
         }
         columnHeaderItems.remove(column, count);
+        if (compactStorage)
+            compactColumns.remove(column, count);
     }
     q->endRemoveColumns();
 }
@@ -1829,7 +2087,11 @@ void QStandardItem::setChild(int row, int column, QStandardItem *item)
     Returns the child item at (\a row, \a column) if one has been set; otherwise
     returns \nullptr.
 
-    \sa setChild(), takeChild(), parent()
+    If this is the invisible root item of a model with compact storage, the
+    item is created if the cell has values in compact storage.
+
+    \sa setChild(), takeChild(), parent(),
+    QStandardItemModel::setCompactStorageEnabled()
 */
 QStandardItem *QStandardItem::child(int row, int column) const
 {
@@ -1837,7 +2099,10 @@ QStandardItem *QStandardItem::child(int row, int column) const
     int index = d->childIndex(row, column);
     if (index == -1)
         return nullptr;
-    return d->children.at(index);
+    QStandardItem *item = d->children.at(index);
+    if (!item && d->hasCompactChildren())
+        item = d->model->d_func()->materializeCompactCell(row, column);
+    return item;
 }
 
 /*!
@@ -1857,7 +2122,7 @@ QStandardItem *QStandardItem::takeChild(int row, int column)
     int index = d->childIndex(row, column);
     if (index != -1) {
         QModelIndex changedIdx;
-        item = d->children.at(index);
+        item = child(row, column);
         if (item && d->model) {
             QStandardItemPrivate *const item_d = item->d_func();
             const int savedRows = item_d->rows;
@@ -1902,6 +2167,10 @@ QList<QStandardItem*> QStandardItem::takeRow(int row)
     QList<QStandardItem*> items;
     if ((row < 0) || (row >= rowCount()))
         return items;
+    if (d->hasCompactChildren()) {
+        for (int column = 0; column < columnCount(); ++column)
+            child(row, column);
+    }
     if (d->model)
         d->model->d_func()->rowsAboutToBeRemoved(this, row, row);
 
@@ -1936,6 +2205,10 @@ QList<QStandardItem*> QStandardItem::takeColumn(int column)
     QList<QStandardItem*> items;
     if ((column < 0) || (column >= columnCount()))
         return items;
+    if (d->hasCompactChildren()) {
+        for (int row = 0; row < rowCount(); ++row)
+            child(row, column);
+    }
     if (d->model)
         d->model->d_func()->columnsAboutToBeRemoved(this, column, column);
 
@@ -2163,7 +2436,9 @@ QDataStream &operator<<(QDataStream &out, const QStandardItem &item)
 
     You are, of course, not required to use the item-based approach; you could
     instead rely entirely on the QAbstractItemModel interface when working with
-    the model, or use a combination of the two as appropriate.
+    the model, or use a combination of the two as appropriate. When a large
+    table is mostly accessed that way, enabling compact storage with
+    setCompactStorageEnabled() avoids allocating an item for every cell.
 
     \sa QStandardItem, {Model/View Programming}, QAbstractItemModel,
     {itemviews/simpletreemodel}{Simple Tree Model example},
@@ -2257,6 +2532,7 @@ void QStandardItemModel::clear()
     d->root.reset(new QStandardItem);
     d->root->setFlags(Qt::ItemIsDropEnabled);
     d->root->d_func()->setModel(this);
+    d->compactColumns.clear();
     qDeleteAll(d->columnHeaderItems);
     d->columnHeaderItems.clear();
     qDeleteAll(d->rowHeaderItems);
@@ -2602,6 +2878,69 @@ const QStandardItem *QStandardItemModel::itemPrototype() const
     return d->itemPrototype;
 }
 
+/*!
+    \since 6.7
+
+    Sets whether the model keeps the values of its top-level cells in compact
+    storage to \a enable. By default, compact storage is disabled.
+
+    Normally, every cell that has data has a QStandardItem of its own, which
+    makes large tables expensive. With compact storage, setting the data of
+    a top-level cell that has no item, with setData() or setItemData(),
+    stores the values in arrays kept per column and role instead; data(),
+    itemData(), flags() and clearItemData() use them directly, and sorting
+    treats them as if they were items.
+
+    An item is only created for such a cell, using itemPrototype(), when one
+    is asked for: by item(), itemFromIndex(), takeItem(), takeRow(),
+    takeColumn(), findItems(), or by QStandardItem::child() on the
+    invisibleRootItem(). The item then takes over the values of the cell.
+    Items set with setItem() or inserted with appendRow() and similar
+    functions, and their children, are not affected.
+
+    Disabling compact storage creates the items for all the cells that have
+    values in it.
+
+    \sa isCompactStorageEnabled()
+*/
+void QStandardItemModel::setCompactStorageEnabled(bool enable)
+{
+    Q_D(QStandardItemModel);
+    if (d->compactStorage == enable)
+        return;
+    if (enable) {
+        d->compactColumns.resize(d->root->columnCount());
+        d->compactStorage = true;
+        return;
+    }
+
+    QStandardItemPrivate *root_d = d->root->d_func();
+    for (int column = 0; column < d->compactColumns.size(); ++column) {
+        if (d->compactColumns.at(column).isEmpty())
+            continue;
+        for (int row = 0; row < root_d->rowCount(); ++row) {
+            if (!root_d->children.at(root_d->childIndex(row, column)))
+                d->materializeCompactCell(row, column);
+        }
+    }
+    d->compactColumns.clear();
+    d->compactStorage = false;
+}
+
+/*!
+    \since 6.7
+
+    Returns \c true if the model keeps the values of its top-level cells in
+    compact storage.
+
+    \sa setCompactStorageEnabled()
+*/
+bool QStandardItemModel::isCompactStorageEnabled() const
+{
+    Q_D(const QStandardItemModel);
+    return d->compactStorage;
+}
+
 /*!
     \since 4.2
 
@@ -2827,8 +3166,11 @@ int QStandardItemModel::columnCount(const QModelIndex &parent) const
 QVariant QStandardItemModel::data(const QModelIndex &index, int role) const
 {
     Q_D(const QStandardItemModel);
-    QStandardItem *item = d->itemFromIndex(index);
-    return item ? item->data(role) : QVariant();
+    if (QStandardItem *item = d->itemFromIndex(index))
+        return item->data(role);
+    if (d->isCompactIndex(index))
+        return d->compactData(index.row(), index.column(), role);
+    return QVariant();
 }
 
 /*!
@@ -2854,6 +3196,11 @@ Qt::ItemFlags QStandardItemModel::flags(const QModelIndex &index) const
     QStandardItem *item = d->itemFromIndex(index);
     if (item)
         return item->flags();
+    if (d->isCompactIndex(index)) {
+        const QVariant v = d->compactData(index.row(), index.column(), Qt::UserRole - 1);
+        if (v.isValid())
+            return Qt::ItemFlags(v.toInt());
+    }
     return Qt::ItemIsSelectable
         |Qt::ItemIsEnabled
         |Qt::ItemIsEditable
@@ -2949,6 +3296,8 @@ QMap<int, QVariant> QStandardItemModel::itemData(const QModelIndex &index) const
 {
     Q_D(const QStandardItemModel);
     const QStandardItem *const item = d->itemFromIndex(index);
+    if (!item && d->isCompactIndex(index))
+        return d->compactItemData(index.row(), index.column());
     if (!item || item == d->root.data())
         return QMap<int, QVariant>();
     return item->d_func()->itemData();
@@ -3009,6 +3358,11 @@ bool QStandardItemModel::setData(const QModelIndex &index, const QVariant &value
 {
     if (!index.isValid())
         return false;
+    Q_D(QStandardItemModel);
+    if (d->isCompactIndex(index)) {
+        d->setCompactData(index.row(), index.column(), {{ role, value }});
+        return true;
+    }
     QStandardItem *item = itemFromIndex(index);
     if (item == nullptr)
         return false;
@@ -3024,6 +3378,10 @@ bool QStandardItemModel::clearItemData(const QModelIndex &index)
     if (!checkIndex(index, CheckIndexOption::IndexIsValid))
         return false;
     Q_D(QStandardItemModel);
+    if (d->isCompactIndex(index)) {
+        d->clearCompactData(index.row(), index.column(), true);
+        return true;
+    }
     QStandardItem *item = d->itemFromIndex(index);
     if (!item)
         return false;
@@ -3070,6 +3428,11 @@ bool QStandardItemModel::setHeaderData(int section, Qt::Orientation orientation,
 */
 bool QStandardItemModel::setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles)
 {
+    Q_D(QStandardItemModel);
+    if (d->isCompactIndex(index)) {
+        d->setCompactData(index.row(), index.column(), roles);
+        return true;
+    }
     QStandardItem *item = itemFromIndex(index);
     if (item == nullptr)
         return false;
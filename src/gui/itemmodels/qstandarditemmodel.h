@@ -362,6 +362,9 @@ public:
     const QStandardItem *itemPrototype() const;
     void setItemPrototype(const QStandardItem *item);
 
+    void setCompactStorageEnabled(bool enable);
+    bool isCompactStorageEnabled() const;
+
     QList<QStandardItem*> findItems(const QString &text,
                                     Qt::MatchFlags flags = Qt::MatchExactly,
                                     int column = 0) const;
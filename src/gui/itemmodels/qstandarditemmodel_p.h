@@ -69,6 +69,17 @@ inline QDebug &operator<<(QDebug &debug, const QStandardItemData &data)
 
 #endif // QT_NO_DATASTREAM
 
+// The values of one role in a column of the compact storage, one per row;
+// an invalid QVariant means that the cell has no value for the role
+struct QStandardItemCompactRole
+{
+    int role;
+    QList<QVariant> values;
+};
+Q_DECLARE_TYPEINFO(QStandardItemCompactRole, Q_RELOCATABLE_TYPE);
+
+using QStandardItemCompactColumn = QList<QStandardItemCompactRole>;
+
 class QStandardItemPrivate
 {
     Q_DECLARE_PUBLIC(QStandardItem)
@@ -144,6 +155,8 @@ public:
         parent = par;
     }
 
+    bool hasCompactChildren() const;
+
     void changeFlags(bool enable, Qt::ItemFlags f);
     void setItemData(const QMap<int, QVariant> &roles);
     QMap<int, QVariant> itemData() const;
@@ -189,8 +202,30 @@ public:
         QStandardItem *parent = static_cast<QStandardItem*>(index.internalPointer());
         if (parent == nullptr)
             return nullptr;
-        return parent->child(index.row(), index.column());
+        // unlike QStandardItem::child(), this doesn't create items for the
+        // cells in compact storage
+        const QStandardItemPrivate *parent_d = parent->d_func();
+        const int childIndex = parent_d->childIndex(index.row(), index.column());
+        return childIndex == -1 ? nullptr : parent_d->children.at(childIndex);
+    }
+
+    inline bool isCompactIndex(const QModelIndex &index) const {
+        Q_Q(const QStandardItemModel);
+        if (!compactStorage || index.model() != q || index.internalPointer() != root.data())
+            return false;
+        const QStandardItemPrivate *root_d = root->d_func();
+        const int childIndex = root_d->childIndex(index.row(), index.column());
+        return childIndex != -1 && root_d->children.at(childIndex) == nullptr;
     }
+    QVariant compactData(int row, int column, int role) const;
+    QMap<int, QVariant> compactItemData(int row, int column) const;
+    bool hasCompactData(int row, int column) const;
+    void setCompactData(int row, int column, const QMap<int, QVariant> &roles);
+    void clearCompactData(int row, int column, bool emitChanged);
+    QStandardItem *materializeCompactCell(int row, int column);
+    void insertCompactRows(int row, int count);
+    void removeCompactRows(int row, int count);
+    void permuteCompactRows(const QList<int> &sourceRows);
 
     void sort(QStandardItem *parent, int column, Qt::SortOrder order);
     void itemChanged(QStandardItem *item, const QList<int> &roles = QList<int>());
@@ -213,6 +248,9 @@ public:
     QHash<int, QByteArray> roleNames;
     QScopedPointer<QStandardItem> root;
     const QStandardItem *itemPrototype;
+    // column-major storage of the top-level cells that have no item
+    QList<QStandardItemCompactColumn> compactColumns;
+    bool compactStorage;
     Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(QStandardItemModelPrivate, int, sortRole, Qt::DisplayRole)
 };
 
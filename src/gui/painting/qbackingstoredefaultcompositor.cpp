@@ -102,12 +102,12 @@ QRhiTexture *QBackingStoreDefaultCompositor::toTexture(const QImage &sourceImage
     if (dirtyRegion.isEmpty() && !resized)
         return m_texture;
 
-    if (needsConversion)
-        image = image.convertToFormat(QImage::Format_RGBA8888);
-    else
-        image.detach(); // if it was just wrapping data, that's no good, we need ownership, so detach
-
     if (resized) {
+        if (needsConversion)
+            image = image.convertToFormat(QImage::Format_RGBA8888);
+        else
+            image.detach(); // if it was just wrapping data, that's no good, we need ownership, so detach
+
         if (!m_texture)
             m_texture = rhi->newTexture(QRhiTexture::RGBA8, image.size());
         else
@@ -115,14 +115,37 @@ QRhiTexture *QBackingStoreDefaultCompositor::toTexture(const QImage &sourceImage
         m_texture->create();
         resourceUpdates->uploadTexture(m_texture, image);
     } else {
-        QRect imageRect = image.rect();
-        QRect rect = dirtyRegion.boundingRect() & imageRect;
-        QRhiTextureSubresourceUploadDescription subresDesc(image);
-        subresDesc.setSourceTopLeft(rect.topLeft());
-        subresDesc.setSourceSize(rect.size());
-        subresDesc.setDestinationTopLeft(rect.topLeft());
-        QRhiTextureUploadDescription uploadDesc(QRhiTextureUploadEntry(0, 0, subresDesc));
-        resourceUpdates->uploadTexture(m_texture, uploadDesc);
+        // Copy and upload only the dirty parts, instead of detaching (and
+        // so copying) the entire image on every flush. A region made of many
+        // small rects is uploaded as its bounding rect instead, as each
+        // upload has a fixed cost as well.
+        const QRect imageRect = image.rect();
+        QVarLengthArray<QRect, 8> rects;
+        if (dirtyRegion.rectCount() <= 8) {
+            for (const QRect &r : dirtyRegion) {
+                const QRect rect = r & imageRect;
+                if (!rect.isEmpty())
+                    rects.append(rect);
+            }
+        } else {
+            const QRect rect = dirtyRegion.boundingRect() & imageRect;
+            if (!rect.isEmpty())
+                rects.append(rect);
+        }
+        QVarLengthArray<QRhiTextureUploadEntry, 8> entries;
+        for (const QRect &rect : std::as_const(rects)) {
+            QImage subImage = image.copy(rect);
+            if (needsConversion)
+                subImage = std::move(subImage).convertToFormat(QImage::Format_RGBA8888);
+            QRhiTextureSubresourceUploadDescription subresDesc(subImage);
+            subresDesc.setDestinationTopLeft(rect.topLeft());
+            entries.append(QRhiTextureUploadEntry(0, 0, subresDesc));
+        }
+        if (!entries.isEmpty()) {
+            QRhiTextureUploadDescription uploadDesc;
+            uploadDesc.setEntries(entries.cbegin(), entries.cend());
+            resourceUpdates->uploadTexture(m_texture, uploadDesc);
+        }
     }
 
     return m_texture;
@@ -399,6 +422,15 @@ void QBackingStoreDefaultCompositor::updatePerQuadData(PerQuadData *d, QRhiTextu
 void QBackingStoreDefaultCompositor::updateUniforms(PerQuadData *d, QRhiResourceUpdateBatch *resourceUpdates,
                                                     const QMatrix4x4 &target, const QMatrix3x3 &source, UpdateUniformOption option)
 {
+    // The geometry rarely changes between flushes, and the buffer keeps
+    // its contents for all frames in flight.
+    if (d->uniformsValid && d->lastTarget == target && d->lastSource == source && d->lastOption == option)
+        return;
+    d->lastTarget = target;
+    d->lastSource = source;
+    d->lastOption = option;
+    d->uniformsValid = true;
+
     resourceUpdates->updateDynamicBuffer(d->ubuf, 0, 64, target.constData());
     updateMatrix3x3(resourceUpdates, d->ubuf, source);
     float opacity = 1.0f;
@@ -17,6 +17,8 @@
 
 #include <qpa/qplatformbackingstore.h>
 #include <rhi/qrhi.h>
+#include <QtGui/qgenericmatrix.h>
+#include <QtGui/qmatrix4x4.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -73,6 +75,10 @@ private:
         QRhiShaderResourceBindings *srbExtra = nullptr; // may be null (used for stereo)
         QRhiTexture *lastUsedTexture = nullptr;
         QRhiTexture *lastUsedTextureExtra = nullptr;    // may be null (used for stereo)
+        QMatrix4x4 lastTarget;
+        QMatrix3x3 lastSource;
+        UpdateUniformOption lastOption = NoOption;
+        bool uniformsValid = false;
         bool isValid() const { return ubuf && srb; }
         void reset() {
             delete ubuf;
@@ -85,6 +91,7 @@ private:
             }
             lastUsedTexture = nullptr;
             lastUsedTextureExtra = nullptr;
+            uniformsValid = false;
         }
     };
     PerQuadData m_widgetQuadData;
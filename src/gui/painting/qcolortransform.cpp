@@ -388,6 +388,152 @@ inline int getAlpha<QRgba64>(const QRgba64 &p)
 {    return p.alpha(); }
 #endif
 
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+// AVX2 versions of the 8-bit loads and stores, handling eight pixels at a
+// time with the table lookups done by gathers. They return how many pixels
+// they handled; the rest are left to the SSE2 loops.
+
+static inline QT_FUNCTION_TARGET(ARCH_HASWELL)
+__m256i gatherTrcLut(const ushort *table, __m256i idx)
+{
+    // The tables are padded so that the 32-bit load at the last index stays
+    // within the QColorTrcLut.
+    const __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), idx, 2);
+    return _mm256_and_si256(v, _mm256_set1_epi32(0xffff));
+}
+
+static inline QT_FUNCTION_TARGET(ARCH_HASWELL)
+void storeColorVectors(QColorVector *buffer, __m256 r, __m256 g, __m256 b)
+{
+    const __m256 w = _mm256_setzero_ps();
+    const __m256 rg0 = _mm256_unpacklo_ps(r, g);
+    const __m256 rg1 = _mm256_unpackhi_ps(r, g);
+    const __m256 bw0 = _mm256_unpacklo_ps(b, w);
+    const __m256 bw1 = _mm256_unpackhi_ps(b, w);
+    // pixels 0 and 4, 1 and 5, ...
+    const __m256 p04 = _mm256_shuffle_ps(rg0, bw0, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 p15 = _mm256_shuffle_ps(rg0, bw0, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 p26 = _mm256_shuffle_ps(rg1, bw1, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 p37 = _mm256_shuffle_ps(rg1, bw1, _MM_SHUFFLE(3, 2, 3, 2));
+    _mm256_storeu_ps(&buffer[0].x, _mm256_permute2f128_ps(p04, p15, 0x20));
+    _mm256_storeu_ps(&buffer[2].x, _mm256_permute2f128_ps(p26, p37, 0x20));
+    _mm256_storeu_ps(&buffer[4].x, _mm256_permute2f128_ps(p04, p15, 0x31));
+    _mm256_storeu_ps(&buffer[6].x, _mm256_permute2f128_ps(p26, p37, 0x31));
+}
+
+static inline QT_FUNCTION_TARGET(ARCH_HASWELL)
+void loadColorVectors(const QColorVector *buffer, __m256 &r, __m256 &g, __m256 &b)
+{
+    const __m256 p01 = _mm256_loadu_ps(&buffer[0].x);
+    const __m256 p23 = _mm256_loadu_ps(&buffer[2].x);
+    const __m256 p45 = _mm256_loadu_ps(&buffer[4].x);
+    const __m256 p67 = _mm256_loadu_ps(&buffer[6].x);
+    const __m256 p04 = _mm256_permute2f128_ps(p01, p45, 0x20);
+    const __m256 p15 = _mm256_permute2f128_ps(p01, p45, 0x31);
+    const __m256 p26 = _mm256_permute2f128_ps(p23, p67, 0x20);
+    const __m256 p37 = _mm256_permute2f128_ps(p23, p67, 0x31);
+    const __m256d rg01 = _mm256_castps_pd(_mm256_unpacklo_ps(p04, p15));
+    const __m256d bw01 = _mm256_castps_pd(_mm256_unpackhi_ps(p04, p15));
+    const __m256d rg23 = _mm256_castps_pd(_mm256_unpacklo_ps(p26, p37));
+    const __m256d bw23 = _mm256_castps_pd(_mm256_unpackhi_ps(p26, p37));
+    r = _mm256_castpd_ps(_mm256_unpacklo_pd(rg01, rg23));
+    g = _mm256_castpd_ps(_mm256_unpackhi_pd(rg01, rg23));
+    b = _mm256_castpd_ps(_mm256_unpacklo_pd(bw01, bw23));
+}
+
+template<bool Premultiplied>
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype loadRgb32_avx2(QColorVector *buffer, const QRgb *src, const qsizetype len,
+                         const QColorTransformPrivate *d_ptr)
+{
+    const __m256 iFF00 = _mm256_set1_ps(1.0f / (255 * 256));
+    const __m256 v4080 = _mm256_set1_ps(4080.f);
+    const __m256i vFF = _mm256_set1_epi32(0xff);
+    const __m256i vMax = _mm256_set1_epi32(255 * 16);
+    const ushort *rTable = d_ptr->colorSpaceIn->lut[0]->m_toLinear;
+    const ushort *gTable = d_ptr->colorSpaceIn->lut[1]->m_toLinear;
+    const ushort *bTable = d_ptr->colorSpaceIn->lut[2]->m_toLinear;
+    qsizetype i = 0;
+    for (; i + 8 <= len; i += 8) {
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i ridx = _mm256_and_si256(_mm256_srli_epi32(p, 16), vFF);
+        __m256i gidx = _mm256_and_si256(_mm256_srli_epi32(p, 8), vFF);
+        __m256i bidx = _mm256_and_si256(p, vFF);
+        if constexpr (Premultiplied) {
+            const __m256 va = _mm256_cvtepi32_ps(_mm256_srli_epi32(p, 24));
+            // Approximate 1/a:
+            __m256 via = _mm256_rcp_ps(va);
+            via = _mm256_sub_ps(_mm256_add_ps(via, via), _mm256_mul_ps(via, _mm256_mul_ps(via, va)));
+            // Handle zero alpha
+            via = _mm256_andnot_ps(_mm256_cmp_ps(va, _mm256_setzero_ps(), _CMP_EQ_OQ), via);
+            via = _mm256_mul_ps(via, v4080);
+            ridx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(ridx), via));
+            gidx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(gidx), via));
+            bidx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(bidx), via));
+            // Invalid premultiplied colors could go out of range
+            ridx = _mm256_min_epi32(ridx, vMax);
+            gidx = _mm256_min_epi32(gidx, vMax);
+            bidx = _mm256_min_epi32(bidx, vMax);
+        } else {
+            ridx = _mm256_slli_epi32(ridx, 4);
+            gidx = _mm256_slli_epi32(gidx, 4);
+            bidx = _mm256_slli_epi32(bidx, 4);
+        }
+        const __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(gatherTrcLut(rTable, ridx)), iFF00);
+        const __m256 g = _mm256_mul_ps(_mm256_cvtepi32_ps(gatherTrcLut(gTable, gidx)), iFF00);
+        const __m256 b = _mm256_mul_ps(_mm256_cvtepi32_ps(gatherTrcLut(bTable, bidx)), iFF00);
+        storeColorVectors(buffer + i, r, g, b);
+    }
+    return i;
+}
+
+enum class Rgb32StoreMode { Opaque, Unpremultiplied, Premultiplied };
+
+template<Rgb32StoreMode Mode>
+static QT_FUNCTION_TARGET(ARCH_HASWELL)
+qsizetype storeRgb32_avx2(QRgb *dst, const QRgb *src, const QColorVector *buffer, const qsizetype len,
+                          const QColorTransformPrivate *d_ptr)
+{
+    const __m256 v4080 = _mm256_set1_ps(4080.f);
+    const __m256 iFF00 = _mm256_set1_ps(1.0f / (255 * 256));
+    const ushort *rTable = d_ptr->colorSpaceOut->lut[0]->m_fromLinear;
+    const ushort *gTable = d_ptr->colorSpaceOut->lut[1]->m_fromLinear;
+    const ushort *bTable = d_ptr->colorSpaceOut->lut[2]->m_fromLinear;
+    qsizetype i = 0;
+    for (; i + 8 <= len; i += 8) {
+        __m256 r, g, b;
+        loadColorVectors(buffer + i, r, g, b);
+        __m256i vr = gatherTrcLut(rTable, _mm256_cvtps_epi32(_mm256_mul_ps(r, v4080)));
+        __m256i vg = gatherTrcLut(gTable, _mm256_cvtps_epi32(_mm256_mul_ps(g, v4080)));
+        __m256i vb = gatherTrcLut(bTable, _mm256_cvtps_epi32(_mm256_mul_ps(b, v4080)));
+        __m256i va;
+        if constexpr (Mode == Rgb32StoreMode::Opaque) {
+            va = _mm256_set1_epi32(0xff000000);
+        } else {
+            // src may be the same as dst, so read it before storing
+            va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            va = _mm256_slli_epi32(_mm256_srli_epi32(va, 24), 24);
+        }
+        if constexpr (Mode == Rgb32StoreMode::Premultiplied) {
+            const __m256 vaf = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(va, 24)), iFF00);
+            vr = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(vr), vaf));
+            vg = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(vg), vaf));
+            vb = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(vb), vaf));
+        } else {
+            const __m256i v80 = _mm256_set1_epi32(0x80);
+            vr = _mm256_srli_epi32(_mm256_add_epi32(vr, v80), 8);
+            vg = _mm256_srli_epi32(_mm256_add_epi32(vg, v80), 8);
+            vb = _mm256_srli_epi32(_mm256_add_epi32(vb, v80), 8);
+        }
+        __m256i p = _mm256_or_si256(va, _mm256_slli_epi32(vr, 16));
+        p = _mm256_or_si256(p, _mm256_slli_epi32(vg, 8));
+        p = _mm256_or_si256(p, vb);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), p);
+    }
+    return i;
+}
+#endif
+
 template<typename T>
 static void loadPremultiplied(QColorVector *buffer, const T *src, const qsizetype len, const QColorTransformPrivate *d_ptr);
 template<typename T>
@@ -427,7 +573,14 @@ static void loadPremultiplied(QColorVector *buffer, const T *src, const qsizetyp
     const __m128 v4080 = _mm_set1_ps(4080.f);
     const __m128 iFF00 = _mm_set1_ps(1.0f / (255 * 256));
     constexpr bool isARGB = isArgb<T>();
-    for (qsizetype i = 0; i < len; ++i) {
+    qsizetype i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (qCpuHasFeature(ArchHaswell))
+            i = loadRgb32_avx2<true>(buffer, src, len, d_ptr);
+    }
+#endif
+    for (; i < len; ++i) {
         __m128i v;
         loadP<T>(src[i], v);
         __m128 vf = _mm_cvtepi32_ps(v);
@@ -535,7 +688,14 @@ void loadUnpremultiplied(QColorVector *buffer, const T *src, const qsizetype len
 {
     constexpr bool isARGB = isArgb<T>();
     const __m128 iFF00 = _mm_set1_ps(1.0f / (255 * 256));
-    for (qsizetype i = 0; i < len; ++i) {
+    qsizetype i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (qCpuHasFeature(ArchHaswell))
+            i = loadRgb32_avx2<false>(buffer, src, len, d_ptr);
+    }
+#endif
+    for (; i < len; ++i) {
         __m128i v;
         loadPU<T>(src[i], v);
         const int ridx = isARGB ? _mm_extract_epi16(v, 4) : _mm_extract_epi16(v, 0);
@@ -799,7 +959,14 @@ static void storePremultiplied(T *dst, const T *src, const QColorVector *buffer,
     const __m128 v4080 = _mm_set1_ps(4080.f);
     const __m128 iFF00 = _mm_set1_ps(1.0f / (255 * 256));
     constexpr bool isARGB = isArgb<T>();
-    for (qsizetype i = 0; i < len; ++i) {
+    qsizetype i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (qCpuHasFeature(ArchHaswell))
+            i = storeRgb32_avx2<Rgb32StoreMode::Premultiplied>(dst, src, buffer, len, d_ptr);
+    }
+#endif
+    for (; i < len; ++i) {
         const int a = getAlpha<T>(src[i]);
         __m128 vf = _mm_loadu_ps(&buffer[i].x);
         __m128i v = _mm_cvtps_epi32(_mm_mul_ps(vf, v4080));
@@ -880,7 +1047,14 @@ static void storeUnpremultiplied(T *dst, const T *src, const QColorVector *buffe
 {
     const __m128 v4080 = _mm_set1_ps(4080.f);
     constexpr bool isARGB = isArgb<T>();
-    for (qsizetype i = 0; i < len; ++i) {
+    qsizetype i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (qCpuHasFeature(ArchHaswell))
+            i = storeRgb32_avx2<Rgb32StoreMode::Unpremultiplied>(dst, src, buffer, len, d_ptr);
+    }
+#endif
+    for (; i < len; ++i) {
         const int a = getAlpha<T>(src[i]);
         __m128 vf = _mm_loadu_ps(&buffer[i].x);
         __m128i v = _mm_cvtps_epi32(_mm_mul_ps(vf, v4080));
@@ -937,7 +1111,14 @@ static void storeOpaque(T *dst, const T *src, const QColorVector *buffer, const
     Q_UNUSED(src);
     const __m128 v4080 = _mm_set1_ps(4080.f);
     constexpr bool isARGB = isArgb<T>();
-    for (qsizetype i = 0; i < len; ++i) {
+    qsizetype i = 0;
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if constexpr (std::is_same_v<T, QRgb>) {
+        if (qCpuHasFeature(ArchHaswell))
+            i = storeRgb32_avx2<Rgb32StoreMode::Opaque>(dst, src, buffer, len, d_ptr);
+    }
+#endif
+    for (; i < len; ++i) {
         __m128 vf = _mm_loadu_ps(&buffer[i].x);
         __m128i v = _mm_cvtps_epi32(_mm_mul_ps(vf, v4080));
         const int ridx = _mm_extract_epi16(v, 0);
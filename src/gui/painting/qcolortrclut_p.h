@@ -190,6 +190,7 @@ public:
     // the tables small enough to fit in most inner caches.
     ushort m_toLinear[(255 * 16) + 1]; // [0-4080] -> [0-65280]
     ushort m_fromLinear[(255 * 16) + 1]; // [0-4080] -> [0-65280]
+    ushort m_gatherPadding; // SIMD gathers load 32 bits for each entry
 
 private:
     QColorTrcLut() { } // force uninitialized members
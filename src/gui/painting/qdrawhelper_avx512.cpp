@@ -0,0 +1,293 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qdrawhelper_p.h"
+#include "qdrawhelper_x86_p.h"
+#include "qdrawingprimitive_sse2_p.h"
+#include "qrgba64_p.h"
+
+#if defined(QT_DRAWHELPER_USE_AVX512)
+
+QT_BEGIN_NAMESPACE
+
+// The AVX-512 versions process 16 ARGB32 or 8 RGBA64 pixels per iteration,
+// and handle the pixels at the ends of a span with masked loads and stores
+// instead of scalar prologues and epilogues. They produce the same results
+// as the AVX2 versions.
+
+// See BYTE_MUL_SSE2 for details.
+inline static void Q_DECL_VECTORCALL
+BYTE_MUL_AVX512(__m512i &pixelVector, __m512i alphaChannel, __m512i colorMask, __m512i half)
+{
+    __m512i pixelVectorAG = _mm512_srli_epi16(pixelVector, 8);
+    __m512i pixelVectorRB = _mm512_and_si512(pixelVector, colorMask);
+
+    pixelVectorAG = _mm512_mullo_epi16(pixelVectorAG, alphaChannel);
+    pixelVectorRB = _mm512_mullo_epi16(pixelVectorRB, alphaChannel);
+
+    pixelVectorRB = _mm512_add_epi16(pixelVectorRB, _mm512_srli_epi16(pixelVectorRB, 8));
+    pixelVectorAG = _mm512_add_epi16(pixelVectorAG, _mm512_srli_epi16(pixelVectorAG, 8));
+    pixelVectorRB = _mm512_add_epi16(pixelVectorRB, half);
+    pixelVectorAG = _mm512_add_epi16(pixelVectorAG, half);
+
+    pixelVectorRB = _mm512_srli_epi16(pixelVectorRB, 8);
+    pixelVectorAG = _mm512_andnot_si512(colorMask, pixelVectorAG);
+
+    pixelVector = _mm512_or_si512(pixelVectorAG, pixelVectorRB);
+}
+
+inline static void Q_DECL_VECTORCALL
+BYTE_MUL_RGB64_AVX512(__m512i &pixelVector, __m512i alphaChannel, __m512i colorMask, __m512i half)
+{
+    __m512i pixelVectorAG = _mm512_srli_epi32(pixelVector, 16);
+    __m512i pixelVectorRB = _mm512_and_si512(pixelVector, colorMask);
+
+    pixelVectorAG = _mm512_mullo_epi32(pixelVectorAG, alphaChannel);
+    pixelVectorRB = _mm512_mullo_epi32(pixelVectorRB, alphaChannel);
+
+    pixelVectorRB = _mm512_add_epi32(pixelVectorRB, _mm512_srli_epi32(pixelVectorRB, 16));
+    pixelVectorAG = _mm512_add_epi32(pixelVectorAG, _mm512_srli_epi32(pixelVectorAG, 16));
+    pixelVectorRB = _mm512_add_epi32(pixelVectorRB, half);
+    pixelVectorAG = _mm512_add_epi32(pixelVectorAG, half);
+
+    pixelVectorRB = _mm512_srli_epi32(pixelVectorRB, 16);
+    pixelVectorAG = _mm512_andnot_si512(colorMask, pixelVectorAG);
+
+    pixelVector = _mm512_or_si512(pixelVectorAG, pixelVectorRB);
+}
+
+// See INTERPOLATE_PIXEL_255_SSE2 for details.
+inline static void Q_DECL_VECTORCALL
+INTERPOLATE_PIXEL_255_AVX512(__m512i srcVector, __m512i &dstVector, __m512i alphaChannel, __m512i oneMinusAlphaChannel, __m512i colorMask, __m512i half)
+{
+    const __m512i srcVectorAG = _mm512_srli_epi16(srcVector, 8);
+    const __m512i dstVectorAG = _mm512_srli_epi16(dstVector, 8);
+    const __m512i srcVectorRB = _mm512_and_si512(srcVector, colorMask);
+    const __m512i dstVectorRB = _mm512_and_si512(dstVector, colorMask);
+    const __m512i srcVectorAGalpha = _mm512_mullo_epi16(srcVectorAG, alphaChannel);
+    const __m512i srcVectorRBalpha = _mm512_mullo_epi16(srcVectorRB, alphaChannel);
+    const __m512i dstVectorAGoneMinusAlpha = _mm512_mullo_epi16(dstVectorAG, oneMinusAlphaChannel);
+    const __m512i dstVectorRBoneMinusAlpha = _mm512_mullo_epi16(dstVectorRB, oneMinusAlphaChannel);
+    __m512i finalAG = _mm512_add_epi16(srcVectorAGalpha, dstVectorAGoneMinusAlpha);
+    __m512i finalRB = _mm512_add_epi16(srcVectorRBalpha, dstVectorRBoneMinusAlpha);
+    finalAG = _mm512_add_epi16(finalAG, _mm512_srli_epi16(finalAG, 8));
+    finalRB = _mm512_add_epi16(finalRB, _mm512_srli_epi16(finalRB, 8));
+    finalAG = _mm512_add_epi16(finalAG, half);
+    finalRB = _mm512_add_epi16(finalRB, half);
+    finalAG = _mm512_andnot_si512(colorMask, finalAG);
+    finalRB = _mm512_srli_epi16(finalRB, 8);
+
+    dstVector = _mm512_or_si512(finalAG, finalRB);
+}
+
+static inline __mmask16 tailMask16(int count)
+{
+    return count >= 16 ? __mmask16(0xffff) : __mmask16((1u << count) - 1);
+}
+
+static inline __mmask8 tailMask8(int count)
+{
+    return count >= 8 ? __mmask8(0xff) : __mmask8((1u << count) - 1);
+}
+
+// Copies the alpha of each ARGB32 pixel to the two 16-bit halves of it.
+static inline __m512i alphaShuffleMask32()
+{
+    return _mm512_broadcast_i32x4(_mm_set_epi8(char(0xff), 15, char(0xff), 15, char(0xff), 11, char(0xff), 11,
+                                               char(0xff), 7, char(0xff), 7, char(0xff), 3, char(0xff), 3));
+}
+
+// Copies the alpha of each RGBA64 pixel to the two 32-bit halves of it.
+static inline __m512i alphaShuffleMask64()
+{
+    return _mm512_broadcast_i32x4(_mm_set_epi8(char(0xff), char(0xff), 15, 14, char(0xff), char(0xff), 15, 14,
+                                               char(0xff), char(0xff), 7, 6, char(0xff), char(0xff), 7, 6));
+}
+
+// See BLEND_SOURCE_OVER_ARGB32_SSE2 for details.
+static void BLEND_SOURCE_OVER_ARGB32_AVX512(quint32 *dst, const quint32 *src, int length)
+{
+    const __m512i half = _mm512_set1_epi16(0x80);
+    const __m512i one = _mm512_set1_epi16(0xff);
+    const __m512i colorMask = _mm512_set1_epi32(0x00ff00ff);
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i alphaShuffleMask = alphaShuffleMask32();
+
+    for (int x = 0; x < length; x += 16) {
+        const __mmask16 mask = tailMask16(length - x);
+        const __m512i srcVector = _mm512_maskz_loadu_epi32(mask, &src[x]);
+        if (!_mm512_test_epi32_mask(srcVector, alphaMask))
+            continue;       // all transparent
+        const __mmask16 opaque =
+                _mm512_cmpeq_epi32_mask(_mm512_and_si512(srcVector, alphaMask), alphaMask);
+        if (opaque == mask) {
+            _mm512_mask_storeu_epi32(&dst[x], mask, srcVector);
+        } else {
+            __m512i alphaChannel = _mm512_shuffle_epi8(srcVector, alphaShuffleMask);
+            alphaChannel = _mm512_sub_epi16(one, alphaChannel);
+            __m512i dstVector = _mm512_maskz_loadu_epi32(mask, &dst[x]);
+            BYTE_MUL_AVX512(dstVector, alphaChannel, colorMask, half);
+            dstVector = _mm512_add_epi8(dstVector, srcVector);
+            _mm512_mask_storeu_epi32(&dst[x], mask, dstVector);
+        }
+    }
+}
+
+// See BLEND_SOURCE_OVER_ARGB32_WITH_CONST_ALPHA_SSE2 for details.
+static void BLEND_SOURCE_OVER_ARGB32_WITH_CONST_ALPHA_AVX512(quint32 *dst, const quint32 *src, int length, int const_alpha)
+{
+    const __m512i half = _mm512_set1_epi16(0x80);
+    const __m512i one = _mm512_set1_epi16(0xff);
+    const __m512i colorMask = _mm512_set1_epi32(0x00ff00ff);
+    const __m512i alphaMask = _mm512_set1_epi32(0xff000000);
+    const __m512i alphaShuffleMask = alphaShuffleMask32();
+    const __m512i constAlphaVector = _mm512_set1_epi16(short(const_alpha));
+
+    for (int x = 0; x < length; x += 16) {
+        const __mmask16 mask = tailMask16(length - x);
+        __m512i srcVector = _mm512_maskz_loadu_epi32(mask, &src[x]);
+        if (!_mm512_test_epi32_mask(srcVector, alphaMask))
+            continue;       // all transparent
+        BYTE_MUL_AVX512(srcVector, constAlphaVector, colorMask, half);
+
+        __m512i alphaChannel = _mm512_shuffle_epi8(srcVector, alphaShuffleMask);
+        alphaChannel = _mm512_sub_epi16(one, alphaChannel);
+        __m512i dstVector = _mm512_maskz_loadu_epi32(mask, &dst[x]);
+        BYTE_MUL_AVX512(dstVector, alphaChannel, colorMask, half);
+        dstVector = _mm512_add_epi8(dstVector, srcVector);
+        _mm512_mask_storeu_epi32(&dst[x], mask, dstVector);
+    }
+}
+
+void qt_blend_argb32_on_argb32_avx512(uchar *destPixels, int dbpl,
+                                      const uchar *srcPixels, int sbpl,
+                                      int w, int h,
+                                      int const_alpha)
+{
+    if (const_alpha == 256) {
+        for (int y = 0; y < h; ++y) {
+            const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+            quint32 *dst = reinterpret_cast<quint32 *>(destPixels);
+            BLEND_SOURCE_OVER_ARGB32_AVX512(dst, src, w);
+            destPixels += dbpl;
+            srcPixels += sbpl;
+        }
+    } else if (const_alpha != 0) {
+        const_alpha = (const_alpha * 255) >> 8;
+        for (int y = 0; y < h; ++y) {
+            const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+            quint32 *dst = reinterpret_cast<quint32 *>(destPixels);
+            BLEND_SOURCE_OVER_ARGB32_WITH_CONST_ALPHA_AVX512(dst, src, w, const_alpha);
+            destPixels += dbpl;
+            srcPixels += sbpl;
+        }
+    }
+}
+
+void qt_blend_rgb32_on_rgb32_avx512(uchar *destPixels, int dbpl,
+                                    const uchar *srcPixels, int sbpl,
+                                    int w, int h,
+                                    int const_alpha)
+{
+    if (const_alpha == 256) {
+        for (int y = 0; y < h; ++y) {
+            const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+            quint32 *dst = reinterpret_cast<quint32 *>(destPixels);
+            ::memcpy(dst, src, w * sizeof(uint));
+            srcPixels += sbpl;
+            destPixels += dbpl;
+        }
+        return;
+    }
+    if (const_alpha == 0)
+        return;
+
+    const __m512i half = _mm512_set1_epi16(0x80);
+    const __m512i colorMask = _mm512_set1_epi32(0x00ff00ff);
+
+    const_alpha = (const_alpha * 255) >> 8;
+    int one_minus_const_alpha = 255 - const_alpha;
+    const __m512i constAlphaVector = _mm512_set1_epi16(short(const_alpha));
+    const __m512i oneMinusConstAlpha = _mm512_set1_epi16(short(one_minus_const_alpha));
+    for (int y = 0; y < h; ++y) {
+        const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+        quint32 *dst = reinterpret_cast<quint32 *>(destPixels);
+
+        for (int x = 0; x < w; x += 16) {
+            const __mmask16 mask = tailMask16(w - x);
+            const __m512i srcVector = _mm512_maskz_loadu_epi32(mask, &src[x]);
+            __m512i dstVector = _mm512_maskz_loadu_epi32(mask, &dst[x]);
+            INTERPOLATE_PIXEL_255_AVX512(srcVector, dstVector, constAlphaVector, oneMinusConstAlpha, colorMask, half);
+            _mm512_mask_storeu_epi32(&dst[x], mask, dstVector);
+        }
+
+        srcPixels += sbpl;
+        destPixels += dbpl;
+    }
+}
+
+void QT_FASTCALL comp_func_SourceOver_avx512(uint *destPixels, const uint *srcPixels, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256);
+
+    const quint32 *src = (const quint32 *) srcPixels;
+    quint32 *dst = (quint32 *) destPixels;
+
+    if (const_alpha == 255)
+        BLEND_SOURCE_OVER_ARGB32_AVX512(dst, src, length);
+    else
+        BLEND_SOURCE_OVER_ARGB32_WITH_CONST_ALPHA_AVX512(dst, src, length, const_alpha);
+}
+
+#if QT_CONFIG(raster_64bit)
+void QT_FASTCALL comp_func_SourceOver_rgb64_avx512(QRgba64 *dst, const QRgba64 *src, int length, uint const_alpha)
+{
+    Q_ASSERT(const_alpha < 256); // const_alpha is in [0-255]
+    const __m512i half = _mm512_set1_epi32(0x8000);
+    const __m512i one  = _mm512_set1_epi32(0xffff);
+    const __m512i colorMask = _mm512_set1_epi32(0x0000ffff);
+    const __m512i alphaMask = _mm512_set1_epi64(qint64(Q_UINT64_C(0xffff000000000000)));
+    const __m512i alphaShuffleMask = alphaShuffleMask64();
+
+    if (const_alpha == 255) {
+        for (int x = 0; x < length; x += 8) {
+            const __mmask8 mask = tailMask8(length - x);
+            const __m512i srcVector = _mm512_maskz_loadu_epi64(mask, &src[x]);
+            if (!_mm512_test_epi64_mask(srcVector, alphaMask))
+                continue;   // all transparent
+            const __mmask8 opaque =
+                    _mm512_cmpeq_epi64_mask(_mm512_and_si512(srcVector, alphaMask), alphaMask);
+            if (opaque == mask) {
+                _mm512_mask_storeu_epi64(&dst[x], mask, srcVector);
+            } else {
+                __m512i alphaChannel = _mm512_shuffle_epi8(srcVector, alphaShuffleMask);
+                alphaChannel = _mm512_sub_epi32(one, alphaChannel);
+                __m512i dstVector = _mm512_maskz_loadu_epi64(mask, &dst[x]);
+                BYTE_MUL_RGB64_AVX512(dstVector, alphaChannel, colorMask, half);
+                dstVector = _mm512_add_epi16(dstVector, srcVector);
+                _mm512_mask_storeu_epi64(&dst[x], mask, dstVector);
+            }
+        }
+    } else {
+        const __m512i constAlphaVector = _mm512_set1_epi32(const_alpha | (const_alpha << 8));
+        for (int x = 0; x < length; x += 8) {
+            const __mmask8 mask = tailMask8(length - x);
+            __m512i srcVector = _mm512_maskz_loadu_epi64(mask, &src[x]);
+            if (!_mm512_test_epi64_mask(srcVector, alphaMask))
+                continue;   // all transparent
+            BYTE_MUL_RGB64_AVX512(srcVector, constAlphaVector, colorMask, half);
+
+            __m512i alphaChannel = _mm512_shuffle_epi8(srcVector, alphaShuffleMask);
+            alphaChannel = _mm512_sub_epi32(one, alphaChannel);
+            __m512i dstVector = _mm512_maskz_loadu_epi64(mask, &dst[x]);
+            BYTE_MUL_RGB64_AVX512(dstVector, alphaChannel, colorMask, half);
+            dstVector = _mm512_add_epi16(dstVector, srcVector);
+            _mm512_mask_storeu_epi64(&dst[x], mask, dstVector);
+        }
+    }
+}
+#endif
+
+QT_END_NAMESPACE
+
+#endif
@@ -20,6 +20,12 @@
 
 QT_BEGIN_NAMESPACE
 
+// matches the avx512core SIMD part in CMake
+#if defined(QT_COMPILER_SUPPORTS_AVX512CD) && defined(QT_COMPILER_SUPPORTS_AVX512BW) \
+    && defined(QT_COMPILER_SUPPORTS_AVX512DQ) && defined(QT_COMPILER_SUPPORTS_AVX512VL)
+#  define QT_DRAWHELPER_USE_AVX512
+#endif
+
 #ifdef __SSE2__
 void qt_memfill64_sse2(quint64 *dest, quint64 value, qsizetype count);
 void qt_memfill32_sse2(quint32 *dest, quint32 value, qsizetype count);
@@ -8,6 +8,7 @@
 #include <private/qpainterpath_p.h>
 #include <private/qfontengine_p.h>
 #include <private/qstatictext_p.h>
+#include <private/qtransform_p.h>
 
 #include <qvarlengtharray.h>
 #include <qdebug.h>
@@ -123,6 +124,39 @@ struct StrokeHandler {
     QDataBuffer<QPainterPath::ElementType> types;
 };
 
+// The outline from the last time a path that is drawn repeatedly was
+// stroked with a non-cosmetic pen. It does not depend on the transform,
+// except for dashes, which are clipped to the device and whose flattening
+// depends on the scale.
+struct StrokeCache {
+    QList<qreal> pts;
+    QList<QPainterPath::ElementType> types;
+    uint flags = 0;
+    QPen pen;
+    QTransform matrix;
+    QRectF clipRect;
+
+    bool matches(const QPen &otherPen, const QTransform &otherMatrix, const QRectF &otherClipRect) const
+    {
+        if (!qpen_fast_equals(pen, otherPen)
+            && (pen.widthF() != otherPen.widthF() || pen.style() != otherPen.style()
+                || pen.capStyle() != otherPen.capStyle() || pen.joinStyle() != otherPen.joinStyle()
+                || pen.miterLimit() != otherPen.miterLimit()
+                || (pen.style() > Qt::SolidLine
+                    && (pen.dashPattern() != otherPen.dashPattern()
+                        || pen.dashOffset() != otherPen.dashOffset())))) {
+            return false;
+        }
+        return pen.style() == Qt::SolidLine
+                || (matrix == otherMatrix && clipRect == otherClipRect);
+    }
+
+    static void cleanup(QPaintEngineEx *, void *data)
+    {
+        delete static_cast<StrokeCache *>(data);
+    }
+};
+
 
 QPaintEngineExPrivate::QPaintEngineExPrivate()
     : dasher(&stroker),
@@ -452,6 +486,29 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
 
     // ### Perspective Xforms are currently not supported...
     if (!pen.isCosmetic()) {
+        // A path that is stroked a second time is assumed to be static,
+        // so its outline is kept for the next time. Subclasses cache their
+        // own data for the engine, so the outline is stored under the
+        // stroke handler instead, which lives as long as the engine.
+        QPaintEngineEx *cacheKey = reinterpret_cast<QPaintEngineEx *>(d->strokeHandler);
+        StrokeCache *cache = nullptr;
+        if (path.isCacheable()) {
+            if (QVectorPath::CacheEntry *entry = path.lookupCacheData(cacheKey)) {
+                cache = static_cast<StrokeCache *>(entry->data);
+                if (!cache->types.isEmpty() && cache->matches(pen, state()->matrix, clipRect)) {
+                    QVectorPath strokePath(cache->pts.constData(), cache->types.size(),
+                                           cache->types.constData(), cache->flags);
+                    fill(strokePath, pen.brush());
+                    return;
+                }
+            } else {
+                cache = new StrokeCache;
+                path.addCacheData(cacheKey, cache, StrokeCache::cleanup);
+            }
+        } else {
+            path.makeCacheable();
+        }
+
         // We include cosmetic pens in this case to avoid having to
         // change the current transform. Normal transformed,
         // non-cosmetic pens will be transformed as part of fill
@@ -501,6 +558,16 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
         if (!d->strokeHandler->types.size()) // an empty path...
             return;
 
+        if (cache) {
+            const int typeCount = d->strokeHandler->types.size();
+            cache->pts.assign(d->strokeHandler->pts.data(), d->strokeHandler->pts.data() + typeCount * 2);
+            cache->types.assign(d->strokeHandler->types.data(), d->strokeHandler->types.data() + typeCount);
+            cache->flags = flags;
+            cache->pen = pen;
+            cache->matrix = state()->matrix;
+            cache->clipRect = clipRect;
+        }
+
         QVectorPath strokePath(d->strokeHandler->pts.data(),
                                d->strokeHandler->types.size(),
                                d->strokeHandler->types.data(),
@@ -512,55 +579,51 @@ void QPaintEngineEx::stroke(const QVectorPath &path, const QPen &inPen)
             QPainterPath painterPath = state()->matrix.map(path.convertToPainterPath());
             d->activeStroker->strokePath(painterPath, d->strokeHandler, QTransform());
         } else {
+            // map all the points in one go, rather than one at a time
+            QVarLengthArray<QPointF, 256> mapped(pointCount);
+            qt_mapPoints(state()->matrix, reinterpret_cast<const QPointF *>(points),
+                         mapped.data(), pointCount);
+            const QPointF *pts = mapped.constData();
+            const QPointF *lastPt = pts + pointCount;
+
             d->activeStroker->setCurveThresholdFromTransform(QTransform());
             d->activeStroker->begin(d->strokeHandler);
             if (types) {
-                while (points < lastPoint) {
+                while (pts < lastPt) {
                     switch (*types) {
-                    case QPainterPath::MoveToElement: {
-                        QPointF pt = (*(const QPointF *) points) * state()->matrix;
-                        d->activeStroker->moveTo(pt.x(), pt.y());
-                        points += 2;
+                    case QPainterPath::MoveToElement:
+                        d->activeStroker->moveTo(pts->x(), pts->y());
+                        ++pts;
                         ++types;
                         break;
-                    }
-                    case QPainterPath::LineToElement: {
-                        QPointF pt = (*(const QPointF *) points) * state()->matrix;
-                        d->activeStroker->lineTo(pt.x(), pt.y());
-                        points += 2;
+                    case QPainterPath::LineToElement:
+                        d->activeStroker->lineTo(pts->x(), pts->y());
+                        ++pts;
                         ++types;
                         break;
-                    }
-                    case QPainterPath::CurveToElement: {
-                        QPointF c1 = ((const QPointF *) points)[0] * state()->matrix;
-                        QPointF c2 = ((const QPointF *) points)[1] * state()->matrix;
-                        QPointF e =  ((const QPointF *) points)[2] * state()->matrix;
-                        d->activeStroker->cubicTo(c1.x(), c1.y(), c2.x(), c2.y(), e.x(), e.y());
-                        points += 6;
+                    case QPainterPath::CurveToElement:
+                        d->activeStroker->cubicTo(pts[0].x(), pts[0].y(), pts[1].x(), pts[1].y(),
+                                                  pts[2].x(), pts[2].y());
+                        pts += 3;
                         types += 3;
                         flags |= QVectorPath::CurvedShapeMask;
                         break;
-                    }
                     default:
                         break;
                     }
                 }
-                if (path.hasImplicitClose()) {
-                    QPointF pt = * ((const QPointF *) path.points()) * state()->matrix;
-                    d->activeStroker->lineTo(pt.x(), pt.y());
-                }
+                if (path.hasImplicitClose())
+                    d->activeStroker->lineTo(mapped.at(0).x(), mapped.at(0).y());
 
             } else {
-                QPointF p = ((const QPointF *)points)[0] * state()->matrix;
-                d->activeStroker->moveTo(p.x(), p.y());
-                points += 2;
-                while (points < lastPoint) {
-                    QPointF p = ((const QPointF *)points)[0] * state()->matrix;
-                    d->activeStroker->lineTo(p.x(), p.y());
-                    points += 2;
+                d->activeStroker->moveTo(pts->x(), pts->y());
+                ++pts;
+                while (pts < lastPt) {
+                    d->activeStroker->lineTo(pts->x(), pts->y());
+                    ++pts;
                 }
                 if (path.hasImplicitClose())
-                    d->activeStroker->lineTo(p.x(), p.y());
+                    d->activeStroker->lineTo(mapped.at(0).x(), mapped.at(0).y());
             }
             d->activeStroker->end();
         }
@@ -1581,6 +1581,216 @@ QPainterPath QPathClipper::clip(Operation operation)
     return path;
 }
 
+struct QCrossingEdge
+{
+    int edge;
+    qreal x;
+
+    bool operator<(const QCrossingEdge &edge) const
+    {
+        return x < edge.x;
+    }
+};
+Q_DECLARE_TYPEINFO(QCrossingEdge, Q_PRIMITIVE_TYPE);
+
+static bool crossesAt(const QWingedEdge &list, int i, qreal y, QCrossingEdge *crossing)
+{
+    const QPathEdge *edge = list.edge(i);
+    QPointF a = *list.vertex(edge->first);
+    QPointF b = *list.vertex(edge->second);
+
+    if ((a.y() < y && b.y() > y) || (a.y() > y && b.y() < y)) {
+        const qreal intersection = a.x() + (b.x() - a.x()) * (y - a.y()) / (b.y() - a.y());
+        *crossing = { i, intersection };
+        return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+    Finds the edges of \a list that cross a horizontal line. Small lists are
+    simply scanned; for larger ones the edges are sorted by their top, and a
+    tree holding the lowest bottom of each run of them lets findCrossings()
+    skip the runs that end above the line, so that a line costs about as
+    much as the number of edges it crosses rather than of all edges.
+
+    The edges must not move while the index is in use.
+*/
+class QCrossingEdgeIndex
+{
+public:
+    explicit QCrossingEdgeIndex(const QWingedEdge &list);
+
+    QList<QCrossingEdge> findCrossings(qreal y) const;
+
+private:
+    enum { MinIndexedEdgeCount = 64 };
+
+    struct Span
+    {
+        qreal top;
+        qreal bottom;
+        int edge;
+    };
+
+    qreal build(int node, int begin, int end);
+    void collect(int node, int begin, int end, int limit, qreal y, QList<int> *edges) const;
+
+    const QWingedEdge &list;
+    QList<Span> spans; // sorted by top
+    QList<qreal> bottoms; // the lowest bottom below each node of the tree
+};
+
+QCrossingEdgeIndex::QCrossingEdgeIndex(const QWingedEdge &list)
+    : list(list)
+{
+    if (list.edgeCount() < MinIndexedEdgeCount)
+        return;
+
+    spans.reserve(list.edgeCount());
+    for (int i = 0; i < list.edgeCount(); ++i) {
+        const QPathEdge *edge = list.edge(i);
+        const qreal ya = list.vertex(edge->first)->y;
+        const qreal yb = list.vertex(edge->second)->y;
+        spans.append({ qMin(ya, yb), qMax(ya, yb), i });
+    }
+    std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b) {
+        return a.top < b.top;
+    });
+
+    bottoms.resize(4 * spans.size());
+    build(1, 0, spans.size());
+}
+
+qreal QCrossingEdgeIndex::build(int node, int begin, int end)
+{
+    if (end - begin == 1)
+        return bottoms[node] = spans.at(begin).bottom;
+
+    const int mid = (begin + end) / 2;
+    return bottoms[node] = qMax(build(2 * node, begin, mid), build(2 * node + 1, mid, end));
+}
+
+void QCrossingEdgeIndex::collect(int node, int begin, int end, int limit, qreal y,
+                                 QList<int> *edges) const
+{
+    // the spans from limit on don't start above y
+    if (begin >= limit || bottoms.at(node) <= y)
+        return;
+
+    if (end - begin == 1) {
+        edges->append(spans.at(begin).edge);
+        return;
+    }
+
+    const int mid = (begin + end) / 2;
+    collect(2 * node, begin, mid, limit, y, edges);
+    collect(2 * node + 1, mid, end, limit, y, edges);
+}
+
+QList<QCrossingEdge> QCrossingEdgeIndex::findCrossings(qreal y) const
+{
+    QList<QCrossingEdge> crossings;
+    QCrossingEdge crossing;
+
+    if (spans.isEmpty()) {
+        for (int i = 0; i < list.edgeCount(); ++i) {
+            if (crossesAt(list, i, y, &crossing))
+                crossings << crossing;
+        }
+        return crossings;
+    }
+
+    const auto limit = std::partition_point(spans.cbegin(), spans.cend(), [y](const Span &span) {
+        return span.top < y;
+    });
+    QList<int> edges;
+    collect(1, 0, spans.size(), limit - spans.cbegin(), y, &edges);
+
+    // report the edges in the order a scan would, so that sorting the
+    // crossings gives the same result
+    std::sort(edges.begin(), edges.end());
+    crossings.reserve(edges.size());
+    for (int i : std::as_const(edges)) {
+        if (crossesAt(list, i, y, &crossing))
+            crossings << crossing;
+    }
+    return crossings;
+}
+
+/*!
+    \internal
+    Finds the biggest of the gaps between consecutive values of the sorted
+    \a coords in a range of them, in constant time, using a table of the
+    biggest gap in each range of a power of two length.
+*/
+class QBiggestGapTable
+{
+public:
+    explicit QBiggestGapTable(const QList<qreal> &coords);
+
+    // Returns the index of the first biggest gap between coords[first] and
+    // coords[last], that is of i with first <= i < last
+    int find(int first, int last) const;
+
+private:
+    int bigger(int i, int j) const
+    {
+        const qreal a = gaps.at(i);
+        const qreal b = gaps.at(j);
+        return b > a || (b == a && j < i) ? j : i;
+    }
+
+    QList<qreal> gaps;
+    QList<QList<int>> levels;
+};
+
+QBiggestGapTable::QBiggestGapTable(const QList<qreal> &coords)
+{
+    if (coords.size() < 2)
+        return;
+
+    gaps.reserve(coords.size() - 1);
+    for (qsizetype i = 0; i < coords.size() - 1; ++i)
+        gaps.append(coords.at(i + 1) - coords.at(i));
+
+    QList<int> level(gaps.size());
+    for (int i = 0; i < level.size(); ++i)
+        level[i] = i;
+    levels.append(level);
+
+    for (int width = 1; 2 * width <= gaps.size(); width *= 2) {
+        const QList<int> &previous = levels.constLast();
+        QList<int> next(gaps.size() - 2 * width + 1);
+        for (int i = 0; i < next.size(); ++i)
+            next[i] = bigger(previous.at(i), previous.at(i + width));
+        levels.append(std::move(next));
+    }
+}
+
+int QBiggestGapTable::find(int first, int last) const
+{
+    Q_ASSERT(first < last);
+    const int length = last - first;
+    int k = 0;
+    while ((2 << k) <= length)
+        ++k;
+    const QList<int> &level = levels.at(k);
+    return bigger(level.at(first), level.at(last - (1 << k)));
+}
+
+// y_coords is sorted, and holds no two values that compare fuzzily equal
+static int fuzzyIndexOf(const QList<qreal> &y_coords, qreal y)
+{
+    const auto it = std::lower_bound(y_coords.cbegin(), y_coords.cend(), y);
+    if (it != y_coords.cbegin() && qFuzzyCompare(*(it - 1), y))
+        return it - 1 - y_coords.cbegin();
+    if (it != y_coords.cend() && qFuzzyCompare(*it, y))
+        return it - y_coords.cbegin();
+    return qFuzzyFind(y_coords.cbegin(), y_coords.cend(), y) - y_coords.cbegin();
+}
+
 bool QPathClipper::doClip(QWingedEdge &list, ClipperMode mode)
 {
     QList<qreal> y_coords;
@@ -1598,68 +1808,55 @@ bool QPathClipper::doClip(QWingedEdge &list, ClipperMode mode)
     }
 #endif
 
-    bool found;
-    do {
-        found = false;
-        int index = 0;
-        qreal maxHeight = 0;
-        for (int i = 0; i < list.edgeCount(); ++i) {
-            QPathEdge *edge = list.edge(i);
-
-            // have both sides of this edge already been handled?
-            if ((edge->flag & 0x3) == 0x3)
-                continue;
-
-            QPathVertex *a = list.vertex(edge->first);
-            QPathVertex *b = list.vertex(edge->second);
-
-            if (qFuzzyCompare(a->y, b->y))
-                continue;
-
-            found = true;
+    // Handle the edges from the tallest to the shortest, the first of
+    // them on ties. Handling an edge only ever sets flags, and doesn't move
+    // or add any edge, so this order can be worked out up front.
+    QList<int> edges;
+    edges.reserve(list.edgeCount());
+    for (int i = 0; i < list.edgeCount(); ++i) {
+        const QPathEdge *edge = list.edge(i);
+        if (!qFuzzyCompare(list.vertex(edge->first)->y, list.vertex(edge->second)->y))
+            edges << i;
+    }
+    auto heightOf = [&list](int i) {
+        const QPathEdge *edge = list.edge(i);
+        return qAbs(list.vertex(edge->first)->y - list.vertex(edge->second)->y);
+    };
+    std::stable_sort(edges.begin(), edges.end(), [&heightOf](int a, int b) {
+        return heightOf(a) > heightOf(b);
+    });
 
-            qreal height = qAbs(a->y - b->y);
-            if (height > maxHeight) {
-                index = i;
-                maxHeight = height;
-            }
-        }
+    const QCrossingEdgeIndex crossingEdges(list);
+    const QBiggestGapTable gaps(y_coords);
 
-        if (found) {
-            QPathEdge *edge = list.edge(index);
+    for (int index : std::as_const(edges)) {
+        QPathEdge *edge = list.edge(index);
 
-            QPathVertex *a = list.vertex(edge->first);
-            QPathVertex *b = list.vertex(edge->second);
+        // have both sides of this edge already been handled?
+        if ((edge->flag & 0x3) == 0x3)
+            continue;
 
-            // FIXME: this can be optimized by using binary search
-            const int first = qFuzzyFind(y_coords.cbegin(), y_coords.cend(), qMin(a->y, b->y)) - y_coords.cbegin();
-            const int last = qFuzzyFind(y_coords.cbegin() + first, y_coords.cend(), qMax(a->y, b->y)) - y_coords.cbegin();
+        QPathVertex *a = list.vertex(edge->first);
+        QPathVertex *b = list.vertex(edge->second);
 
-            Q_ASSERT(first < y_coords.size() - 1);
-            Q_ASSERT(last < y_coords.size());
+        const int first = fuzzyIndexOf(y_coords, qMin(a->y, b->y));
+        const int last = fuzzyIndexOf(y_coords, qMax(a->y, b->y));
 
-            qreal biggestGap = y_coords.at(first + 1) - y_coords.at(first);
-            int bestIdx = first;
-            for (int i = first + 1; i < last; ++i) {
-                qreal gap = y_coords.at(i + 1) - y_coords.at(i);
+        Q_ASSERT(first < y_coords.size() - 1);
+        Q_ASSERT(last < y_coords.size());
 
-                if (gap > biggestGap) {
-                    bestIdx = i;
-                    biggestGap = gap;
-                }
-            }
-            const qreal bestY = 0.5 * (y_coords.at(bestIdx) + y_coords.at(bestIdx + 1));
+        const int bestIdx = last > first ? gaps.find(first, last) : first;
+        const qreal bestY = 0.5 * (y_coords.at(bestIdx) + y_coords.at(bestIdx + 1));
 
 #ifdef QDEBUG_CLIPPER
-            printf("y: %.9f, gap: %.9f\n", bestY, biggestGap);
+        printf("y: %.9f, gap: %.9f\n", bestY, y_coords.at(bestIdx + 1) - y_coords.at(bestIdx));
 #endif
 
-            if (handleCrossingEdges(list, bestY, mode) && mode == CheckMode)
-                return true;
+        if (handleCrossingEdges(list, crossingEdges, bestY, mode) && mode == CheckMode)
+            return true;
 
-            edge->flag |= 0x3;
-        }
-    } while (found);
+        edge->flag |= 0x3;
+    }
 
     if (mode == ClipMode)
         list.simplify();
@@ -1689,18 +1886,6 @@ static void traverse(QWingedEdge &list, int edge, QPathEdge::Traversal traversal
     } while (status.edge != edge);
 }
 
-struct QCrossingEdge
-{
-    int edge;
-    qreal x;
-
-    bool operator<(const QCrossingEdge &edge) const
-    {
-        return x < edge.x;
-    }
-};
-Q_DECLARE_TYPEINFO(QCrossingEdge, Q_PRIMITIVE_TYPE);
-
 static bool bool_op(bool a, bool b, QPathClipper::Operation op)
 {
     switch (op) {
@@ -1743,26 +1928,10 @@ bool QWingedEdge::isInside(qreal x, qreal y) const
     return winding & 1;
 }
 
-static QList<QCrossingEdge> findCrossings(const QWingedEdge &list, qreal y)
-{
-    QList<QCrossingEdge> crossings;
-    for (int i = 0; i < list.edgeCount(); ++i) {
-        const QPathEdge *edge = list.edge(i);
-        QPointF a = *list.vertex(edge->first);
-        QPointF b = *list.vertex(edge->second);
-
-        if ((a.y() < y && b.y() > y) || (a.y() > y && b.y() < y)) {
-            const qreal intersection = a.x() + (b.x() - a.x()) * (y - a.y()) / (b.y() - a.y());
-            const QCrossingEdge edge = { i, intersection };
-            crossings << edge;
-        }
-    }
-    return crossings;
-}
-
-bool QPathClipper::handleCrossingEdges(QWingedEdge &list, qreal y, ClipperMode mode)
+bool QPathClipper::handleCrossingEdges(QWingedEdge &list, const QCrossingEdgeIndex &index,
+                                       qreal y, ClipperMode mode)
 {
-    QList<QCrossingEdge> crossings = findCrossings(list, y);
+    QList<QCrossingEdge> crossings = index.findCrossings(y);
 
     Q_ASSERT(!crossings.isEmpty());
     std::sort(crossings.begin(), crossings.end());
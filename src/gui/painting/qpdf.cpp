@@ -20,6 +20,13 @@
 #include <qnumeric.h>
 #include <qtemporaryfile.h>
 #include <quuid.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
+
+#include <atomic>
 
 #ifndef QT_NO_COMPRESS
 #include <zlib.h>
@@ -1518,6 +1525,7 @@ bool QPdfEngine::begin(QPaintDevice *pdev)
     d->pages.clear();
     d->imageCache.clear();
     d->alphaCache.clear();
+    d->deferredStreams.clear();
 
     setActive(true);
     d->writeHeader();
@@ -2049,7 +2057,6 @@ void QPdfEnginePrivate::writePage()
     *currentPage << "Q Q\n";
 
     uint pageStream = requestObject();
-    uint pageStreamLength = requestObject();
     uint resources = requestObject();
     uint annots = requestObject();
 
@@ -2115,6 +2122,13 @@ void QPdfEnginePrivate::writePage()
     }
     xprintf("]\nendobj\n");
 
+    QIODevice *content = currentPage->stream();
+    if (canDeferStream(content->size())) {
+        writeDeferredStream(pageStream, QByteArray(), content->readAll());
+        return;
+    }
+
+    uint pageStreamLength = requestObject();
     addXrefEntry(pageStream);
     xprintf("<<\n"
             "/Length %d 0 R\n", pageStreamLength); // object number for stream length object
@@ -2123,7 +2137,6 @@ void QPdfEnginePrivate::writePage()
 
     xprintf(">>\n");
     xprintf("stream\n");
-    QIODevice *content = currentPage->stream();
     int len = writeCompressed(content);
     xprintf("\nendstream\n"
             "endobj\n");
@@ -2140,6 +2153,7 @@ void QPdfEnginePrivate::writeTail()
     writeDestsRoot();
     writeAttachmentRoot();
     writeNamesRoot();
+    flushDeferredStreams();
 
     addXrefEntry(xrefPositions.size(),false);
     xprintf("xref\n"
@@ -2336,37 +2350,138 @@ int QPdfEnginePrivate::writeCompressed(const char *src, int len)
     return len;
 }
 
+struct QPdfEnginePrivate::DeferredStream
+{
+    enum State { Queued, Running, Done };
+
+    int object;
+    QByteArray dictionary;
+    QByteArray data; // compressed by compress()
+    std::atomic<int> state = Queued;
+#if QT_CONFIG(thread)
+    QSemaphore done;
+#endif
+
+    // Returns false if another thread has started compressing already
+    bool compress()
+    {
+        int expected = Queued;
+        if (!state.compare_exchange_strong(expected, Running))
+            return false;
+#ifndef QT_NO_COMPRESS
+        // strip the size qCompress() puts in front of the zlib stream
+        constexpr qsizetype HeaderSize = 4;
+        const QByteArray compressed = qCompress(data);
+        if (compressed.isNull())
+            qWarning("QPdfStream::writeCompressed: Error in compress()");
+        data = compressed.isNull() ? QByteArray() : compressed.sliced(HeaderSize);
+#endif
+        state = Done;
+        return true;
+    }
+};
+
+// Only streams that are compressed anyway, and that are small enough to
+// be held in memory for a while, are deferred
+bool QPdfEnginePrivate::canDeferStream(qint64 size) const
+{
+#if QT_CONFIG(thread)
+    return do_compress && size <= QPdfPage::chunkSize() && QThread::idealThreadCount() > 1;
+#else
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+// Writes the stream object with the given dictionary entries and compressed
+// data later on, after the objects being written now
+void QPdfEnginePrivate::writeDeferredStream(int object, const QByteArray &dictionary,
+                                            const QByteArray &data)
+{
+    auto deferred = std::make_shared<DeferredStream>();
+    deferred->object = object;
+    deferred->dictionary = dictionary;
+    deferred->data = data;
+#if QT_CONFIG(thread)
+    QThreadPool::globalInstance()->start([deferred] {
+        if (deferred->compress())
+            deferred->done.release();
+    });
+    const qsizetype maxPending = QThread::idealThreadCount();
+#else
+    const qsizetype maxPending = 0;
+#endif
+    deferredStreams.append(std::move(deferred));
+
+    // keep the memory held by pending streams bounded
+    flushDeferredStreams(maxPending);
+}
+
+// Writes all but the keep most recently added deferred streams
+void QPdfEnginePrivate::flushDeferredStreams(qsizetype keep)
+{
+    const qsizetype count = deferredStreams.size() - keep;
+    for (qsizetype i = 0; i < count; ++i) {
+        DeferredStream *deferred = deferredStreams.at(i).get();
+        // if no pool thread got to it yet, don't wait for one
+        if (!deferred->compress()) {
+#if QT_CONFIG(thread)
+            deferred->done.acquire();
+#endif
+        }
+
+        addXrefEntry(deferred->object);
+        write("<<\n" + deferred->dictionary
+              + "/Filter /FlateDecode\n"
+                "/Length " + QByteArray::number(deferred->data.size()) + "\n"
+                ">>\n"
+                "stream\n");
+        write(deferred->data);
+        xprintf("\nendstream\n"
+                "endobj\n");
+    }
+    if (count > 0)
+        deferredStreams.remove(0, count);
+}
+
 int QPdfEnginePrivate::writeImage(const QByteArray &data, int width, int height, int depth,
                                   int maskObject, int softMaskObject, bool dct, bool isMono)
 {
-    int image = addXrefEntry(-1);
-    xprintf("<<\n"
-            "/Type /XObject\n"
-            "/Subtype /Image\n"
-            "/Width %d\n"
-            "/Height %d\n", width, height);
+    QByteArray dictionary = "/Type /XObject\n"
+                            "/Subtype /Image\n"
+                            "/Width " + QByteArray::number(width) + "\n"
+                            "/Height " + QByteArray::number(height) + "\n";
 
     if (depth == 1) {
         if (!isMono) {
-            xprintf("/ImageMask true\n"
-                    "/Decode [1 0]\n");
+            dictionary += "/ImageMask true\n"
+                          "/Decode [1 0]\n";
         } else {
-            xprintf("/BitsPerComponent 1\n"
-                    "/ColorSpace /DeviceGray\n");
+            dictionary += "/BitsPerComponent 1\n"
+                          "/ColorSpace /DeviceGray\n";
         }
     } else {
-        xprintf("/BitsPerComponent 8\n"
-                "/ColorSpace %s\n", (depth == 32) ? "/DeviceRGB" : "/DeviceGray");
+        dictionary += "/BitsPerComponent 8\n"
+                      "/ColorSpace ";
+        dictionary += (depth == 32) ? "/DeviceRGB\n" : "/DeviceGray\n";
     }
     if (maskObject > 0)
-        xprintf("/Mask %d 0 R\n", maskObject);
+        dictionary += "/Mask " + QByteArray::number(maskObject) + " 0 R\n";
     if (softMaskObject > 0)
-        xprintf("/SMask %d 0 R\n", softMaskObject);
+        dictionary += "/SMask " + QByteArray::number(softMaskObject) + " 0 R\n";
+    if (interpolateImages)
+        dictionary += "/Interpolate true\n";
+
+    if (!dct && canDeferStream(data.size())) {
+        const int image = requestObject();
+        writeDeferredStream(image, dictionary, data);
+        return image;
+    }
 
+    int image = addXrefEntry(-1);
+    write("<<\n" + dictionary);
     int lenobj = requestObject();
     xprintf("/Length %d 0 R\n", lenobj);
-    if (interpolateImages)
-        xprintf("/Interpolate true\n");
     int len = 0;
     if (dct) {
         //qDebug("DCT");
@@ -27,6 +27,8 @@
 #include "private/qstroker_p.h"
 #include "qpagelayout.h"
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 const char *qt_real_to_string(qreal val, char *buf);
@@ -298,6 +300,14 @@ private:
     inline int writeCompressed(const QByteArray &data) { return writeCompressed(data.constData(), data.size()); }
     int writeCompressed(QIODevice *dev);
 
+    // Streams compressed on the thread pool while painting goes on; they
+    // are written in the order they were added, a few at a time
+    struct DeferredStream;
+    QList<std::shared_ptr<DeferredStream>> deferredStreams;
+    bool canDeferStream(qint64 size) const;
+    void writeDeferredStream(int object, const QByteArray &dictionary, const QByteArray &data);
+    void flushDeferredStreams(qsizetype keep = 0);
+
     struct AttachmentInfo
     {
         AttachmentInfo (const QString &fileName, const QByteArray &data, const QString &mimeType)
@@ -1543,12 +1543,43 @@ static void QT_FASTCALL storeRGBA64FromARGB32(uchar *dest, const uint *src, int
         d[i] = QRgba64::fromArgb32(src[i]);
 }
 
+// The half-float formats are converted to and from single precision a
+// chunk at a time with qFloatFromFloat16() and qFloatToFloat16(), which use
+// the F16C or NEON conversion instructions when available, and the
+// remaining work is done on floats.
+static constexpr int Float16ChunkSize = 64;
+
+template <typename Convert>
+static inline void readRGBA16FInChunks(const QRgbaFloat16 *s, int count, Convert convert)
+{
+    QRgbaFloat32 buf[Float16ChunkSize];
+    for (int i = 0; i < count; i += Float16ChunkSize) {
+        const int n = qMin(count - i, Float16ChunkSize);
+        qFloatFromFloat16(reinterpret_cast<float *>(buf), reinterpret_cast<const qfloat16 *>(s + i), n * 4);
+        for (int j = 0; j < n; ++j)
+            convert(i + j, buf[j]);
+    }
+}
+
+template <typename Convert>
+static inline void writeRGBA16FInChunks(QRgbaFloat16 *d, int count, Convert convert)
+{
+    QRgbaFloat32 buf[Float16ChunkSize];
+    for (int i = 0; i < count; i += Float16ChunkSize) {
+        const int n = qMin(count - i, Float16ChunkSize);
+        for (int j = 0; j < n; ++j)
+            buf[j] = convert(i + j);
+        qFloatToFloat16(reinterpret_cast<qfloat16 *>(d + i), reinterpret_cast<const float *>(buf), n * 4);
+    }
+}
+
 static const uint *QT_FASTCALL fetchRGB16FToRGB32(uint *buffer, const uchar *src, int index, int count,
                                                   const QList<QRgb> *, QDitherInfo *)
 {
     const QRgbaFloat16 *s = reinterpret_cast<const QRgbaFloat16 *>(src) + index;
-    for (int i = 0; i < count; ++i)
-        buffer[i] = s[i].toArgb32();
+    readRGBA16FInChunks(s, count, [buffer](int i, QRgbaFloat32 c) {
+        buffer[i] = c.toArgb32();
+    });
     return buffer;
 }
 
@@ -1556,16 +1587,18 @@ static void QT_FASTCALL storeRGB16FFromRGB32(uchar *dest, const uint *src, int i
                                              const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i)
-        d[i] = QRgbaFloat16::fromArgb32(src[i]);
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        return QRgbaFloat32::fromArgb32(src[i]);
+    });
 }
 
 static const uint *QT_FASTCALL fetchRGBA16FToARGB32PM(uint *buffer, const uchar *src, int index, int count,
                                                       const QList<QRgb> *, QDitherInfo *)
 {
     const QRgbaFloat16 *s = reinterpret_cast<const QRgbaFloat16 *>(src) + index;
-    for (int i = 0; i < count; ++i)
-        buffer[i] = s[i].premultiplied().toArgb32();
+    readRGBA16FInChunks(s, count, [buffer](int i, QRgbaFloat32 c) {
+        buffer[i] = c.premultiplied().toArgb32();
+    });
     return buffer;
 }
 
@@ -1573,10 +1606,10 @@ static const QRgba64 *QT_FASTCALL fetchRGBA16FToRGBA64PM(QRgba64 *buffer, const
                                                          const QList<QRgb> *, QDitherInfo *)
 {
     const QRgbaFloat16 *s = reinterpret_cast<const QRgbaFloat16 *>(src) + index;
-    for (int i = 0; i < count; ++i) {
-        QRgbaFloat16 c = s[i].premultiplied();
+    readRGBA16FInChunks(s, count, [buffer](int i, QRgbaFloat32 c) {
+        c = c.premultiplied();
         buffer[i] = QRgba64::fromRgba64(c.red16(), c.green16(), c.blue16(), c.alpha16());
-    }
+    });
     return buffer;
 }
 
@@ -1584,18 +1617,18 @@ static void QT_FASTCALL storeRGBA16FFromARGB32PM(uchar *dest, const uint *src, i
                                                  const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i)
-        d[i] = QRgbaFloat16::fromArgb32(src[i]).unpremultiplied();
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        return QRgbaFloat32::fromArgb32(src[i]).unpremultiplied();
+    });
 }
 
 static const QRgba64 *QT_FASTCALL fetchRGBA16FPMToRGBA64PM(QRgba64 *buffer, const uchar *src, int index, int count,
                                                            const QList<QRgb> *, QDitherInfo *)
 {
     const QRgbaFloat16 *s = reinterpret_cast<const QRgbaFloat16 *>(src) + index;
-    for (int i = 0; i < count; ++i) {
-        QRgbaFloat16 c = s[i];
+    readRGBA16FInChunks(s, count, [buffer](int i, QRgbaFloat32 c) {
         buffer[i] = QRgba64::fromRgba64(c.red16(), c.green16(), c.blue16(), c.alpha16());
-    }
+    });
     return buffer;
 }
 
@@ -1866,26 +1899,29 @@ static void QT_FASTCALL storeRGBX16FFromRGBA64PM(uchar *dest, const QRgba64 *src
                                                  const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i) {
-        d[i] = qConvertRgb64ToRgbaF16(src[i]).unpremultiplied();
-        d[i].setAlpha(1.0);
-    }
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        QRgbaFloat32 c = qConvertRgb64ToRgbaF32(src[i]).unpremultiplied();
+        c.setAlpha(1.0f);
+        return c;
+    });
 }
 
 static void QT_FASTCALL storeRGBA16FFromRGBA64PM(uchar *dest, const QRgba64 *src, int index, int count,
                                                  const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i)
-        d[i] = qConvertRgb64ToRgbaF16(src[i]).unpremultiplied();
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        return qConvertRgb64ToRgbaF32(src[i]).unpremultiplied();
+    });
 }
 
 static void QT_FASTCALL storeRGBA16FPMFromRGBA64PM(uchar *dest, const QRgba64 *src, int index, int count,
                                                    const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i)
-        d[i] = qConvertRgb64ToRgbaF16(src[i]);
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        return qConvertRgb64ToRgbaF32(src[i]);
+    });
 }
 
 static void QT_FASTCALL storeRGBX32FFromRGBA64PM(uchar *dest, const QRgba64 *src, int index, int count,
@@ -2070,10 +2106,9 @@ static const QRgbaFloat32 *QT_FASTCALL fetchRGBA16FToRGBA32F(QRgbaFloat32 *buffe
                                                          const QList<QRgb> *, QDitherInfo *)
 {
     const QRgbaFloat16 *s = reinterpret_cast<const QRgbaFloat16 *>(src) + index;
-    for (int i = 0; i < count; ++i) {
-        auto c = s[i].premultiplied();
-        buffer[i] = QRgbaFloat32 { c.r, c.g, c.b, c.a};
-    }
+    qFloatFromFloat16(reinterpret_cast<float *>(buffer), reinterpret_cast<const qfloat16 *>(s), count * 4);
+    for (int i = 0; i < count; ++i)
+        buffer[i] = buffer[i].premultiplied();
     return buffer;
 }
 
@@ -2224,20 +2259,20 @@ static void QT_FASTCALL storeRGBX16FFromRGBA32F(uchar *dest, const QRgbaFloat32
                                                 const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i) {
-        auto s = src[i].unpremultiplied();
-        d[i] = QRgbaFloat16{ qfloat16(s.r), qfloat16(s.g), qfloat16(s.b), qfloat16(1.0f) };
-    }
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        QRgbaFloat32 s = src[i].unpremultiplied();
+        s.setAlpha(1.0f);
+        return s;
+    });
 }
 
 static void QT_FASTCALL storeRGBA16FFromRGBA32F(uchar *dest, const QRgbaFloat32 *src, int index, int count,
                                                const QList<QRgb> *, QDitherInfo *)
 {
     QRgbaFloat16 *d = reinterpret_cast<QRgbaFloat16 *>(dest) + index;
-    for (int i = 0; i < count; ++i) {
-        auto s = src[i].unpremultiplied();
-        d[i] = QRgbaFloat16{ qfloat16(s.r), qfloat16(s.g), qfloat16(s.b), qfloat16(s.a) };
-    }
+    writeRGBA16FInChunks(d, count, [src](int i) {
+        return src[i].unpremultiplied();
+    });
 }
 
 static void QT_FASTCALL storeRGBA16FPMFromRGBA32F(uchar *dest, const QRgbaFloat32 *src, int index, int count,
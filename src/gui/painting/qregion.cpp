@@ -12,6 +12,7 @@
 #include "qbitmap.h"
 #include "qtransform.h"
 
+#include <algorithm>
 #include <memory>
 #include <private/qdebug_p.h>
 
@@ -620,10 +621,42 @@ bool QRegion::intersects(const QRegion &region) const
     if (rectCount() == 1 && region.rectCount() == 1)
         return true;
 
-    for (const QRect &myRect : *this)
-        for (const QRect &otherRect : region)
-            if (rect_intersects(myRect, otherRect))
-                return true;
+    // The rectangles of both regions are sorted into bands by y, and by x
+    // within a band, so they can be walked in parallel.
+    const QRect *r1 = begin();
+    const QRect *r1End = end();
+    const QRect *r2 = region.begin();
+    const QRect *r2End = region.end();
+    while (r1 != r1End && r2 != r2End) {
+        if (r1->bottom() < r2->top()) {
+            ++r1;
+        } else if (r2->bottom() < r1->top()) {
+            ++r2;
+        } else {
+            // The current bands overlap vertically; look for an overlap in x
+            const QRect *band1End = r1;
+            while (band1End != r1End && band1End->top() == r1->top())
+                ++band1End;
+            const QRect *band2End = r2;
+            while (band2End != r2End && band2End->top() == r2->top())
+                ++band2End;
+            for (const QRect *i = r1, *j = r2; i != band1End && j != band2End;) {
+                if (i->right() < j->left())
+                    ++i;
+                else if (j->right() < i->left())
+                    ++j;
+                else
+                    return true;
+            }
+            // Move on from the band that ends first
+            const int bottom1 = r1->bottom();
+            const int bottom2 = r2->bottom();
+            if (bottom1 <= bottom2)
+                r1 = band1End;
+            if (bottom2 <= bottom1)
+                r2 = band2End;
+        }
+    }
     return false;
 }
 
@@ -4276,8 +4309,14 @@ bool QRegion::intersects(const QRect &rect) const
     if (d->qt_rgn->numRects == 1)
         return true;
 
-    for (const QRect &rect : *this) {
-        if (rect_intersects(r, rect))
+    // The bands are sorted by y and do not overlap, so the bottoms of the
+    // rectangles never decrease: skip the bands above r, and stop below it.
+    const QRect *rectsEnd = end();
+    const QRect *it = std::partition_point(begin(), rectsEnd, [&r](const QRect &rect) {
+        return rect.bottom() < r.top();
+    });
+    for (; it != rectsEnd && it->top() <= r.bottom(); ++it) {
+        if (rect_intersects(r, *it))
             return true;
     }
     return false;
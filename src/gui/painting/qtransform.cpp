@@ -1,6 +1,7 @@
 // Copyright (C) 2021 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #include "qtransform.h"
+#include "qtransform_p.h"
 
 #include "qdatastream.h"
 #include "qdebug.h"
@@ -13,6 +14,7 @@
 #include <qnumeric.h>
 
 #include <private/qbezier_p.h>
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -61,6 +63,87 @@ static void nanWarning(const char *func)
         }                                                               \
     } while (0)
 
+// Maps count points through the affine part of transform. The coordinates
+// of each point are two consecutive qreals, and the points are stride
+// qreals apart; src and dst may be the same.
+static void mapPointsAffine(const QTransform &transform, const qreal *src, qreal *dst,
+                            qsizetype count, qsizetype stride)
+{
+    const qreal m11 = transform.m11();
+    const qreal m12 = transform.m12();
+    const qreal m21 = transform.m21();
+    const qreal m22 = transform.m22();
+    const qreal dx = transform.dx();
+    const qreal dy = transform.dy();
+    qsizetype i = 0;
+
+#if !defined(QT_COORD_TYPE)
+#  if defined(__AVX__)
+    // two points at a time
+    if (stride == 2) {
+        const __m256d c0 = _mm256_setr_pd(m11, m12, m11, m12);
+        const __m256d c1 = _mm256_setr_pd(m21, m22, m21, m22);
+        const __m256d t = _mm256_setr_pd(dx, dy, dx, dy);
+        for (; i + 1 < count; i += 2) {
+            const __m256d p = _mm256_loadu_pd(src + i * 2);
+            const __m256d x = _mm256_permute_pd(p, 0x0);
+            const __m256d y = _mm256_permute_pd(p, 0xf);
+            _mm256_storeu_pd(dst + i * 2,
+                             _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, c0), _mm256_mul_pd(y, c1)), t));
+        }
+    }
+#  endif
+#  if defined(__SSE2__)
+    const __m128d c0 = _mm_setr_pd(m11, m12);
+    const __m128d c1 = _mm_setr_pd(m21, m22);
+    const __m128d t = _mm_setr_pd(dx, dy);
+    for (; i < count; ++i) {
+        const __m128d p = _mm_loadu_pd(src + i * stride);
+        const __m128d x = _mm_unpacklo_pd(p, p);
+        const __m128d y = _mm_unpackhi_pd(p, p);
+        _mm_storeu_pd(dst + i * stride, _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, c0), _mm_mul_pd(y, c1)), t));
+    }
+#  elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const qreal coefficients[] = { m11, m12, m21, m22, dx, dy };
+    const float64x2_t c0 = vld1q_f64(coefficients);
+    const float64x2_t c1 = vld1q_f64(coefficients + 2);
+    const float64x2_t t = vld1q_f64(coefficients + 4);
+    for (; i < count; ++i) {
+        const float64x2_t p = vld1q_f64(src + i * stride);
+        const float64x2_t x = vdupq_laneq_f64(p, 0);
+        const float64x2_t y = vdupq_laneq_f64(p, 1);
+        vst1q_f64(dst + i * stride, vaddq_f64(vaddq_f64(vmulq_f64(x, c0), vmulq_f64(y, c1)), t));
+    }
+#  endif
+#endif // !QT_COORD_TYPE
+
+    for (; i < count; ++i) {
+        const qreal x = src[i * stride];
+        const qreal y = src[i * stride + 1];
+        dst[i * stride] = m11 * x + m21 * y + dx;
+        dst[i * stride + 1] = m12 * x + m22 * y + dy;
+    }
+}
+
+void qt_mapPoints(const QTransform &transform, const QPointF *src, QPointF *dst, qsizetype count)
+{
+    switch (transform.type()) {
+    case QTransform::TxNone:
+        if (src != dst)
+            std::copy(src, src + count, dst);
+        break;
+    case QTransform::TxProject:
+        for (qsizetype i = 0; i < count; ++i)
+            dst[i] = transform.map(src[i]);
+        break;
+    default:
+        static_assert(sizeof(QPointF) == 2 * sizeof(qreal));
+        mapPointsAffine(transform, reinterpret_cast<const qreal *>(src),
+                        reinterpret_cast<qreal *>(dst), count, 2);
+        break;
+    }
+}
+
 /*!
     \class QTransform
     \brief The QTransform class specifies 2D transformations of a coordinate system.
@@ -1422,15 +1505,8 @@ QPolygonF QTransform::map(const QPolygonF &a) const
     if (t >= QTransform::TxProject)
         return mapProjective(*this, a);
 
-    int size = a.size();
-    int i;
-    QPolygonF p(size);
-    const QPointF *da = a.constData();
-    QPointF *dp = p.data();
-
-    for(i = 0; i < size; ++i) {
-        MAP(da[i].xp, da[i].yp, dp[i].xp, dp[i].yp);
-    }
+    QPolygonF p(a.size());
+    qt_mapPoints(*this, a.constData(), p.data(), a.size());
     return p;
 }
 
@@ -1679,10 +1755,11 @@ QPainterPath QTransform::map(const QPainterPath &path) const
     } else {
         copy.detach();
         // Full xform
-        for (int i=0; i<path.elementCount(); ++i) {
-            QPainterPath::Element &e = copy.d_ptr->elements[i];
-            MAP(e.x, e.y, e.x, e.y);
-        }
+        static_assert(offsetof(QPainterPath::Element, y) == offsetof(QPainterPath::Element, x) + sizeof(qreal));
+        static_assert(sizeof(QPainterPath::Element) % sizeof(qreal) == 0);
+        auto points = reinterpret_cast<qreal *>(copy.d_ptr->elements.data());
+        mapPointsAffine(*this, points, points, copy.d_ptr->elements.size(),
+                        sizeof(QPainterPath::Element) / sizeof(qreal));
     }
 
     return copy;
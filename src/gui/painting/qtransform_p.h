@@ -0,0 +1,30 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTRANSFORM_P_H
+#define QTRANSFORM_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/qtransform.h>
+
+QT_BEGIN_NAMESPACE
+
+// Maps count points from src to dst, which may be the same array, with the
+// affine part of the transform hoisted out of the loop and vectorized
+Q_GUI_EXPORT void qt_mapPoints(const QTransform &transform, const QPointF *src, QPointF *dst,
+                               qsizetype count);
+
+QT_END_NAMESPACE
+
+#endif // QTRANSFORM_P_H
@@ -11,7 +11,12 @@ QT_BEGIN_NAMESPACE
 class QAbstractEventDispatcher *QtGenericUnixDispatcher::createUnixEventDispatcher()
 {
 #if !defined(QT_NO_GLIB) && !defined(Q_OS_WIN)
-    if (qEnvironmentVariableIsEmpty("QT_NO_GLIB") && QEventDispatcherGlib::versionSupported())
+    bool useGlib = qEnvironmentVariableIsEmpty("QT_NO_GLIB");
+#  if QT_CONFIG(epoll)
+    // an explicit request for the epoll backend overrides the glib default
+    useGlib = useGlib && !QEventDispatcherUNIXPrivate::epollRequested();
+#  endif
+    if (useGlib && QEventDispatcherGlib::versionSupported())
         return new QPAEventDispatcherGlib();
     else
 #endif
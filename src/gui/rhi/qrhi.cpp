@@ -4,6 +4,12 @@
 #include "qrhi_p.h"
 #include <qmath.h>
 #include <QLoggingCategory>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 #include "qrhinull_p.h"
 #ifndef QT_NO_OPENGL
@@ -662,6 +668,15 @@ Q_LOGGING_CATEGORY(QRHI_LOG_INFO, "qt.rhi.general")
     mechanisms for shader/program binaries provided by Qt. Writing to those may
     get disabled whenever this flag is set since storing program binaries to
     multiple caches is not sensible.
+
+    \value EnablePersistentPipelineCache Makes the QRhi manage the pipeline
+    cache on disk by itself. This implies EnablePipelineCacheDataSave. create()
+    loads the data saved by an earlier run with the same backend and graphics
+    device into the pipeline cache, and the destructor saves the contents of
+    the cache for the next run. The data is stored in a file under
+    QStandardPaths::CacheLocation. Data from a different Qt version or driver
+    version is rejected by setPipelineCacheData() and then replaced when the
+    QRhi is destroyed. This enum value has been introduced in Qt 6.7.
  */
 
 /*!
@@ -966,6 +981,27 @@ Q_LOGGING_CATEGORY(QRHI_LOG_INFO, "qt.rhi.general")
     \value ThreeDimensionalTextureMipmaps Indicates that generating 3D texture
     mipmaps are supported. In practice this feature will be unsupported with
     Direct 3D 12.
+
+    \value SecondaryCommandBuffers Indicates that native command buffers
+    recorded by the application, possibly on other threads, can be executed
+    in a render pass with QRhiCommandBuffer::executeSecondaryCommandBuffers().
+    In practice this feature will be supported with Vulkan and Direct 3D 12
+    only. This enum value has been introduced in Qt 6.7.
+
+    \value DrawIndirect Indicates that draw calls with parameters sourced from
+    a buffer, QRhiCommandBuffer::drawIndirect() and
+    QRhiCommandBuffer::drawIndexedIndirect(), are supported, together with the
+    QRhiBuffer::IndirectBuffer usage. When the Compute feature is supported
+    as well, QRhiCommandBuffer::dispatchIndirect() is available too. In
+    practice this feature will be supported with Vulkan, and with OpenGL 4.3
+    or OpenGL ES 3.1 and newer. This enum value has been introduced in Qt 6.7.
+
+    \value DrawIndirectMulti Indicates that an indirect draw call with a
+    \c drawCount larger than 1 is executed as a single draw command. When
+    not supported, but DrawIndirect is, such calls are still accepted, but
+    they are split into one command per draw by the backend. In practice this
+    feature will be supported with Vulkan when the implementation reports the
+    \c multiDrawIndirect feature. This enum value has been introduced in Qt 6.7.
  */
 
 /*!
@@ -3525,6 +3561,16 @@ QRhi *QRhiResource::rhi() const
     can only be combined with the types Immutable or Static, and is only
     available when the \l{QRhi::Compute}{Compute feature} is reported as
     supported.
+
+    \value IndirectBuffer Indirect buffer. This allows the QRhiBuffer to be
+    used as the source of the draw or dispatch parameters in
+    QRhiCommandBuffer::drawIndirect(),
+    QRhiCommandBuffer::drawIndexedIndirect(), and
+    QRhiCommandBuffer::dispatchIndirect(). It can be combined with
+    StorageBuffer so that the parameters can be generated by a compute
+    shader. Only available when the \l{QRhi::DrawIndirect}{DrawIndirect
+    feature} is reported as supported. This enum value has been introduced in
+    Qt 6.7.
  */
 
 /*!
@@ -7874,6 +7920,8 @@ QRhi::~QRhi()
 
     runCleanup();
 
+    d->savePersistentPipelineCache();
+
     d->destroy();
     delete d;
 }
@@ -7894,6 +7942,52 @@ void QRhiImplementation::prepareForCreate(QRhi *rhi, QRhi::Implementation impl,
     implThread = QThread::currentThread();
 }
 
+// The data is specific to the device as well, so each device gets its own
+// file, instead of having the runs on different GPUs overwrite each other.
+// Driver updates are caught by the headers the backends put into the data.
+void QRhiImplementation::loadPersistentPipelineCache()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty())
+        return;
+
+    const QRhiDriverInfo info = driverInfo();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.deviceName);
+    hash.addData(QByteArray::number(info.deviceId));
+    hash.addData(QByteArray::number(info.vendorId));
+    persistentPipelineCacheFile = dir + QLatin1String("/qtpipelinecache-")
+            + QLatin1String(QRhi::backendName(implType)) + QLatin1Char('-')
+            + QLatin1String(hash.result().toHex().left(16));
+
+    QFile f(persistentPipelineCacheFile);
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+    const QByteArray data = f.readAll();
+    qCDebug(QRHI_LOG_INFO, "Loaded %lld bytes of pipeline cache data from %s",
+            qint64(data.size()), qPrintable(persistentPipelineCacheFile));
+    setPipelineCacheData(data);
+}
+
+void QRhiImplementation::savePersistentPipelineCache()
+{
+    if (persistentPipelineCacheFile.isEmpty())
+        return;
+
+    const QByteArray data = pipelineCacheData();
+    if (data.isEmpty())
+        return;
+
+    QDir().mkpath(QFileInfo(persistentPipelineCacheFile).absolutePath());
+    QSaveFile f(persistentPipelineCacheFile);
+    if (f.open(QIODevice::WriteOnly) && f.write(data) == data.size() && f.commit()) {
+        qCDebug(QRHI_LOG_INFO, "Saved %lld bytes of pipeline cache data to %s",
+                qint64(data.size()), qPrintable(persistentPipelineCacheFile));
+    } else {
+        qWarning("Failed to write pipeline cache data to %s", qPrintable(persistentPipelineCacheFile));
+    }
+}
+
 /*!
     \return a new QRhi instance with a backend for the graphics API specified
     by \a impl with the specified \a flags.
@@ -7981,9 +8075,14 @@ QRhi *QRhi::create(Implementation impl, QRhiInitParams *params, Flags flags, QRh
     }
 
     if (r->d) {
+        if (flags.testFlag(EnablePersistentPipelineCache))
+            flags |= EnablePipelineCacheDataSave;
         r->d->prepareForCreate(r.get(), impl, flags);
-        if (r->d->create(flags))
+        if (r->d->create(flags)) {
+            if (flags.testFlag(EnablePersistentPipelineCache))
+                r->d->loadPersistentPipelineCache();
             return r.release();
+        }
     }
 
     return nullptr;
@@ -9123,6 +9222,102 @@ void QRhiCommandBuffer::drawIndexed(quint32 indexCount,
     m_rhi->drawIndexed(this, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
+/*!
+    Records a non-indexed draw, or \a drawCount of them, with the parameters
+    read from \a indirectBuffer at the GPU timeline, starting at
+    \a indirectBufferOffset. The buffer must have been created with the
+    QRhiBuffer::IndirectBuffer usage.
+
+    Each draw reads four 32-bit unsigned integers, laid out as in the
+    following struct, which matches VkDrawIndirectCommand:
+
+    \badcode
+    struct DrawIndirectCommand {
+        quint32 vertexCount;
+        quint32 instanceCount;
+        quint32 firstVertex;
+        quint32 firstInstance;
+    };
+    \endcode
+
+    \a stride is the distance in bytes between the parameters of successive
+    draws. 0, the default, means they are tightly packed, that is, 16 bytes.
+    \a indirectBufferOffset and \a stride must be multiples of 4.
+
+    When the QRhi::DrawIndirectMulti feature is not supported, a \a drawCount
+    larger than 1 is executed as separate draw commands, which is functionally
+    equivalent, but more expensive on the CPU side.
+
+    \note This is only available when the QRhi::DrawIndirect feature is
+    reported as supported.
+
+    \note This function can only be called inside a render pass, meaning
+    between a beginPass() and endPass() call.
+
+    \since 6.7
+    \sa drawIndexedIndirect(), dispatchIndirect()
+ */
+void QRhiCommandBuffer::drawIndirect(QRhiBuffer *indirectBuffer,
+                                     quint32 indirectBufferOffset,
+                                     quint32 drawCount,
+                                     quint32 stride)
+{
+    if (drawCount == 0)
+        return;
+    if (stride == 0)
+        stride = 4 * sizeof(quint32);
+    m_rhi->drawIndirect(this, indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
+/*!
+    Records an indexed draw, or \a drawCount of them, with the parameters
+    read from \a indirectBuffer at the GPU timeline, starting at
+    \a indirectBufferOffset. The index buffer is the one set with
+    setVertexInput(). \a indirectBuffer must have been created with the
+    QRhiBuffer::IndirectBuffer usage.
+
+    Each draw reads five 32-bit values, laid out as in the following struct,
+    which matches VkDrawIndexedIndirectCommand:
+
+    \badcode
+    struct DrawIndexedIndirectCommand {
+        quint32 indexCount;
+        quint32 instanceCount;
+        quint32 firstIndex;
+        qint32 vertexOffset;
+        quint32 firstInstance;
+    };
+    \endcode
+
+    \a stride is the distance in bytes between the parameters of successive
+    draws. 0, the default, means they are tightly packed, that is, 20 bytes.
+    \a indirectBufferOffset and \a stride must be multiples of 4.
+
+    \note With OpenGL the index buffer offset given to setVertexInput() must
+    be 0, because the first index is the only offset the indirect parameters
+    can express there.
+
+    \note This is only available when the QRhi::DrawIndirect feature is
+    reported as supported.
+
+    \note This function can only be called inside a render pass, meaning
+    between a beginPass() and endPass() call.
+
+    \since 6.7
+    \sa drawIndirect(), QRhi::DrawIndirectMulti
+ */
+void QRhiCommandBuffer::drawIndexedIndirect(QRhiBuffer *indirectBuffer,
+                                            quint32 indirectBufferOffset,
+                                            quint32 drawCount,
+                                            quint32 stride)
+{
+    if (drawCount == 0)
+        return;
+    if (stride == 0)
+        stride = 5 * sizeof(quint32);
+    m_rhi->drawIndexedIndirect(this, indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
 /*!
     Records a named debug group on the command buffer with the specified \a
     name. This is shown in graphics debugging tools such as
@@ -9245,6 +9440,33 @@ void QRhiCommandBuffer::dispatch(int x, int y, int z)
     m_rhi->dispatch(this, x, y, z);
 }
 
+/*!
+    Records a compute dispatch with the number of workgroups read from
+    \a indirectBuffer at the GPU timeline, starting at
+    \a indirectBufferOffset, which must be a multiple of 4. The buffer must
+    have been created with the QRhiBuffer::IndirectBuffer usage and holds
+    three 32-bit unsigned integers, the workgroup counts in the X, Y, and Z
+    dimensions.
+
+    This allows a compute pass to decide how much work a subsequent dispatch
+    does without reading the data back to the CPU. When the parameters are
+    written by an earlier dispatch in the same pass, the necessary barrier is
+    inserted automatically.
+
+    \note This is only available when both the QRhi::Compute and
+    QRhi::DrawIndirect features are reported as supported.
+
+    \note This function can only be called inside a compute pass, meaning
+    between a beginComputePass() and endComputePass() call.
+
+    \since 6.7
+    \sa dispatch()
+ */
+void QRhiCommandBuffer::dispatchIndirect(QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset)
+{
+    m_rhi->dispatchIndirect(this, indirectBuffer, indirectBufferOffset);
+}
+
 /*!
     \return a pointer to a backend-specific QRhiNativeHandles subclass, such as
     QRhiVulkanCommandBufferNativeHandles. The returned value is \nullptr when
@@ -9318,6 +9540,54 @@ void QRhiCommandBuffer::endExternal()
     m_rhi->endExternal(this);
 }
 
+/*!
+    Executes \a count native command buffers from \a commandBuffers, in order,
+    at the current point of the render pass.
+
+    This allows recording the contents of a render pass on several threads:
+    the application records parts of the pass into native command buffers
+    on worker threads, by calling the graphics API directly, and then hands
+    them over on the thread of the QRhi in the order they have to execute.
+    The QRhiCommandBuffer's own commands recorded before and after this
+    call execute before and after them.
+
+    \note This is only available when the QRhi::SecondaryCommandBuffers
+    feature is reported as supported. Like with beginExternal(), the render
+    pass must have been started with QRhiCommandBuffer::ExternalContent. The
+    function must not be called between beginExternal() and endExternal().
+
+    Each element of \a commandBuffers points to a backend-specific
+    QRhiNativeHandles subclass:
+
+    \list
+    \li With Vulkan, a QRhiVulkanCommandBufferNativeHandles with a secondary
+    command buffer, recorded with
+    \c VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT against the render
+    pass in QRhiVulkanRenderPassNativeHandles and subpass 0. The
+    framebuffer can be left as VK_NULL_HANDLE in the inheritance info.
+    \li With Direct 3D 12, a QRhiD3D12CommandBufferNativeHandles with a
+    closed bundle, that is, an \c ID3D12GraphicsCommandList of type
+    \c D3D12_COMMAND_LIST_TYPE_BUNDLE.
+    \endlist
+
+    The command buffers, and the command pools or allocators they come from,
+    are owned by the application, which must keep them alive until the
+    frame has completed on the GPU. The resources they use must be in the
+    state a draw call in the pass would need; QRhi does not track them.
+
+    \note All QRhiCommandBuffer state must be assumed as invalid after calling
+    this function. Pipelines, vertex and index buffers, and other state must be
+    set again if more draw calls are recorded afterwards.
+
+    \since 6.7
+    \sa beginExternal(), QRhi::SecondaryCommandBuffers
+ */
+void QRhiCommandBuffer::executeSecondaryCommandBuffers(int count, const QRhiNativeHandles *const *commandBuffers)
+{
+    if (count > 0)
+        m_rhi->executeSecondaryCommandBuffers(this, count, commandBuffers);
+}
+
 /*!
     \return the last available timestamp, in seconds. The value indicates the
     elapsed time on the GPU during the last completed frame.
@@ -839,7 +839,8 @@ public:
         VertexBuffer = 1 << 0,
         IndexBuffer = 1 << 1,
         UniformBuffer = 1 << 2,
-        StorageBuffer = 1 << 3
+        StorageBuffer = 1 << 3,
+        IndirectBuffer = 1 << 4
     };
     Q_DECLARE_FLAGS(UsageFlags, UsageFlag)
 
@@ -1653,6 +1654,16 @@ public:
                      qint32 vertexOffset = 0,
                      quint32 firstInstance = 0);
 
+    void drawIndirect(QRhiBuffer *indirectBuffer,
+                      quint32 indirectBufferOffset = 0,
+                      quint32 drawCount = 1,
+                      quint32 stride = 0);
+
+    void drawIndexedIndirect(QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset = 0,
+                             quint32 drawCount = 1,
+                             quint32 stride = 0);
+
     void debugMarkBegin(const QByteArray &name);
     void debugMarkEnd();
     void debugMarkMsg(const QByteArray &msg);
@@ -1661,10 +1672,12 @@ public:
     void endComputePass(QRhiResourceUpdateBatch *resourceUpdates = nullptr);
     void setComputePipeline(QRhiComputePipeline *ps);
     void dispatch(int x, int y, int z);
+    void dispatchIndirect(QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset = 0);
 
     const QRhiNativeHandles *nativeHandles();
     void beginExternal();
     void endExternal();
+    void executeSecondaryCommandBuffers(int count, const QRhiNativeHandles *const *commandBuffers);
 
     double lastCompletedGpuTime();
 
@@ -1771,7 +1784,8 @@ public:
         EnableDebugMarkers = 1 << 0,
         PreferSoftwareRenderer = 1 << 1,
         EnablePipelineCacheDataSave = 1 << 2,
-        EnableTimestamps = 1 << 3
+        EnableTimestamps = 1 << 3,
+        EnablePersistentPipelineCache = 1 << 4
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
@@ -1822,7 +1836,10 @@ public:
         OneDimensionalTextureMipmaps,
         HalfAttributes,
         RenderToOneDimensionalTexture,
-        ThreeDimensionalTextureMipmaps
+        ThreeDimensionalTextureMipmaps,
+        SecondaryCommandBuffers,
+        DrawIndirect,
+        DrawIndirectMulti
     };
 
     enum BeginFrameFlag {
@@ -105,6 +105,10 @@ public:
     virtual void drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
                              quint32 instanceCount, quint32 firstIndex,
                              qint32 vertexOffset, quint32 firstInstance) = 0;
+    virtual void drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                              quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) = 0;
+    virtual void drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                     quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) = 0;
 
     virtual void debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name) = 0;
     virtual void debugMarkEnd(QRhiCommandBuffer *cb) = 0;
@@ -116,10 +120,14 @@ public:
     virtual void endComputePass(QRhiCommandBuffer *cb, QRhiResourceUpdateBatch *resourceUpdates) = 0;
     virtual void setComputePipeline(QRhiCommandBuffer *cb, QRhiComputePipeline *ps) = 0;
     virtual void dispatch(QRhiCommandBuffer *cb, int x, int y, int z) = 0;
+    virtual void dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                  quint32 indirectBufferOffset) = 0;
 
     virtual const QRhiNativeHandles *nativeHandles(QRhiCommandBuffer *cb) = 0;
     virtual void beginExternal(QRhiCommandBuffer *cb) = 0;
     virtual void endExternal(QRhiCommandBuffer *cb) = 0;
+    virtual void executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                                const QRhiNativeHandles *const *commandBuffers) = 0;
     virtual double lastCompletedGpuTime(QRhiCommandBuffer *cb) = 0;
 
     virtual QList<int> supportedSampleCounts() const = 0;
@@ -142,6 +150,8 @@ public:
     virtual void setPipelineCacheData(const QByteArray &data) = 0;
 
     void prepareForCreate(QRhi *rhi, QRhi::Implementation impl, QRhi::Flags flags);
+    void loadPersistentPipelineCache();
+    void savePersistentPipelineCache();
 
     bool isCompressedFormat(QRhiTexture::Format format) const;
     void compressedFormatInfo(QRhiTexture::Format format, const QSize &size,
@@ -240,6 +250,7 @@ private:
     QVarLengthArray<QRhi::CleanupCallback, 4> cleanupCallbacks;
     QElapsedTimer pipelineCreationTimer;
     qint64 accumulatedPipelineCreationTime = 0;
+    QString persistentPipelineCacheFile;
 
     friend class QRhi;
     friend class QRhiResourceUpdateBatchPrivate;
@@ -606,6 +617,7 @@ public:
     };
 
     enum BufferStage {
+        BufDrawIndirectStage,
         BufVertexInputStage,
         BufVertexStage,
         BufTCStage,
@@ -621,7 +633,8 @@ public:
         BufUniformRead,
         BufStorageLoad,
         BufStorageStore,
-        BufStorageLoadStore
+        BufStorageLoadStore,
+        BufIndirectRead
     };
 
     void registerBuffer(QRhiBuffer *buf, int slot, BufferAccess *access, BufferStage *stage,
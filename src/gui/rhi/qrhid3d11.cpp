@@ -588,6 +588,12 @@ bool QRhiD3D11::isFeatureSupported(QRhi::Feature feature) const
         return true;
     case QRhi::ThreeDimensionalTextureMipmaps:
         return true;
+    case QRhi::SecondaryCommandBuffers:
+        return false;
+    case QRhi::DrawIndirect:
+        return false;
+    case QRhi::DrawIndirectMulti:
+        return false;
     default:
         Q_UNREACHABLE();
         return false;
@@ -1217,6 +1223,26 @@ void QRhiD3D11::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
     cmd.args.drawIndexed.firstInstance = firstInstance;
 }
 
+void QRhiD3D11::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
+void QRhiD3D11::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                    quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
 void QRhiD3D11::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
     if (!debugMarkers || !annotations)
@@ -1275,6 +1301,14 @@ void QRhiD3D11::endExternal(QRhiCommandBuffer *cb)
     }
 }
 
+void QRhiD3D11::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                               const QRhiNativeHandles *const *commandBuffers)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(count);
+    Q_UNUSED(commandBuffers);
+}
+
 double QRhiD3D11::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     QD3D11CommandBuffer *cbD = QRHI_RES(QD3D11CommandBuffer, cb);
@@ -2124,6 +2158,14 @@ void QRhiD3D11::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
     cmd.args.dispatch.z = UINT(z);
 }
 
+void QRhiD3D11::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                 quint32 indirectBufferOffset)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+}
+
 static inline QPair<int, int> mapBinding(int binding,
                                          int stageIndex,
                                          const QShader::NativeResourceBindingMap *nativeResourceBindingMaps[])
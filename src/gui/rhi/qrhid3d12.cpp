@@ -638,6 +638,12 @@ bool QRhiD3D12::isFeatureSupported(QRhi::Feature feature) const
         return true;
     case QRhi::ThreeDimensionalTextureMipmaps:
         return false; // we generate mipmaps ourselves with compute and this is not implemented
+    case QRhi::SecondaryCommandBuffers:
+        return true;
+    case QRhi::DrawIndirect:
+        return false;
+    case QRhi::DrawIndirectMulti:
+        return false;
     }
     return false;
 }
@@ -1308,6 +1314,26 @@ void QRhiD3D12::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
                                        firstInstance);
 }
 
+void QRhiD3D12::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
+void QRhiD3D12::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                    quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
 void QRhiD3D12::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
     if (!debugMarkers)
@@ -1373,6 +1399,25 @@ void QRhiD3D12::endExternal(QRhiCommandBuffer *cb)
     }
 }
 
+void QRhiD3D12::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                               const QRhiNativeHandles *const *commandBuffers)
+{
+    QD3D12CommandBuffer *cbD = QRHI_RES(QD3D12CommandBuffer, cb);
+    if (cbD->recordingPass != QD3D12CommandBuffer::RenderPass) {
+        qWarning("executeSecondaryCommandBuffers() is only supported in a render pass");
+        return;
+    }
+
+    // Bundles are executed right away on the direct command list. The state
+    // they set stays set afterwards, so nothing cached is valid anymore.
+    for (int i = 0; i < count; ++i) {
+        const auto *h = static_cast<const QRhiD3D12CommandBufferNativeHandles *>(commandBuffers[i]);
+        if (h && h->commandList)
+            cbD->cmdList->ExecuteBundle(static_cast<ID3D12GraphicsCommandList *>(h->commandList));
+    }
+    cbD->resetPerPassState();
+}
+
 double QRhiD3D12::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     Q_UNUSED(cb);
@@ -1858,6 +1903,14 @@ void QRhiD3D12::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
     cbD->cmdList->Dispatch(UINT(x), UINT(y), UINT(z));
 }
 
+void QRhiD3D12::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                 quint32 indirectBufferOffset)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+}
+
 bool QD3D12DescriptorHeap::create(ID3D12Device *device,
                                   quint32 descriptorCount,
                                   D3D12_DESCRIPTOR_HEAP_TYPE heapType,
@@ -311,6 +311,18 @@ QT_BEGIN_NAMESPACE
 #define GL_SHADER_STORAGE_BARRIER_BIT      0x00002000
 #endif
 
+#ifndef GL_COMMAND_BARRIER_BIT
+#define GL_COMMAND_BARRIER_BIT             0x00000040
+#endif
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER            0x8F3F
+#endif
+
+#ifndef GL_DISPATCH_INDIRECT_BUFFER
+#define GL_DISPATCH_INDIRECT_BUFFER        0x90EE
+#endif
+
 #ifndef GL_TEXTURE_FETCH_BARRIER_BIT
 #define GL_TEXTURE_FETCH_BARRIER_BIT       0x00000008
 #endif
@@ -887,6 +899,10 @@ bool QRhiGles2::create(QRhi::Flags flags)
     else
         caps.compute = caps.ctxMajor > 4 || (caps.ctxMajor == 4 && caps.ctxMinor >= 3); // 4.3
 
+    // glDraw*Indirect is ES 3.1 and GL 4.0, glDispatchComputeIndirect comes
+    // with compute; require the latter for both.
+    caps.drawIndirect = caps.compute;
+
     if (caps.compute) {
         f->glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, &caps.maxThreadsPerThreadGroup);
         GLint tgPerDim[3];
@@ -1371,6 +1387,12 @@ bool QRhiGles2::isFeatureSupported(QRhi::Feature feature) const
         return caps.texture1D;
     case QRhi::ThreeDimensionalTextureMipmaps:
         return caps.texture3D;
+    case QRhi::SecondaryCommandBuffers:
+        return false;
+    case QRhi::DrawIndirect:
+        return caps.drawIndirect;
+    case QRhi::DrawIndirectMulti:
+        return false;
     default:
         Q_UNREACHABLE_RETURN(false);
     }
@@ -1913,6 +1935,43 @@ void QRhiGles2::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
     cmd.args.drawIndexed.baseVertex = vertexOffset;
 }
 
+void QRhiGles2::enqueueDrawIndirect(QGles2CommandBuffer *cbD, QGles2CommandBuffer::Command::Cmd cmdType,
+                                    QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset,
+                                    quint32 drawCount, quint32 stride)
+{
+    Q_ASSERT(cbD->recordingPass == QGles2CommandBuffer::RenderPass);
+    QGles2Buffer *bufD = QRHI_RES(QGles2Buffer, indirectBuffer);
+    Q_ASSERT(bufD->m_usage.testFlag(QRhiBuffer::IndirectBuffer));
+
+    QGles2CommandBuffer::Command &cmd(cbD->commands.get());
+    cmd.cmd = cmdType;
+    cmd.args.drawIndirect.ps = cbD->currentGraphicsPipeline;
+    cmd.args.drawIndirect.buffer = bufD->buffer;
+    cmd.args.drawIndirect.offset = indirectBufferOffset;
+    cmd.args.drawIndirect.drawCount = drawCount;
+    cmd.args.drawIndirect.stride = stride;
+
+    if (cbD->passNeedsResourceTracking) {
+        QRhiPassResourceTracker &passResTracker(cbD->passResTrackers[cbD->currentPassResTrackerIndex]);
+        trackedRegisterBuffer(&passResTracker, bufD, QRhiPassResourceTracker::BufIndirectRead,
+                              QRhiPassResourceTracker::BufDrawIndirectStage);
+    }
+}
+
+void QRhiGles2::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    enqueueDrawIndirect(QRHI_RES(QGles2CommandBuffer, cb), QGles2CommandBuffer::Command::DrawIndirect,
+                        indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
+void QRhiGles2::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                    quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    enqueueDrawIndirect(QRHI_RES(QGles2CommandBuffer, cb), QGles2CommandBuffer::Command::DrawIndexedIndirect,
+                        indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
 void QRhiGles2::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
     if (!debugMarkers)
@@ -2008,6 +2067,14 @@ void QRhiGles2::endExternal(QRhiCommandBuffer *cb)
         enqueueBindFramebuffer(cbD->currentTarget, cbD);
 }
 
+void QRhiGles2::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                               const QRhiNativeHandles *const *commandBuffers)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(count);
+    Q_UNUSED(commandBuffers);
+}
+
 double QRhiGles2::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     Q_UNUSED(cb);
@@ -2146,7 +2213,8 @@ static inline GLbitfield barriersForBuffer()
         | GL_ELEMENT_ARRAY_BARRIER_BIT
         | GL_UNIFORM_BARRIER_BIT
         | GL_BUFFER_UPDATE_BARRIER_BIT
-        | GL_SHADER_STORAGE_BARRIER_BIT;
+        | GL_SHADER_STORAGE_BARRIER_BIT
+        | GL_COMMAND_BARRIER_BIT;
 }
 
 static inline GLbitfield barriersForTexture()
@@ -2738,6 +2806,8 @@ static inline QGles2Buffer::Access toGlAccess(QRhiPassResourceTracker::BufferAcc
         return QGles2Buffer::AccessStorageWrite;
     case QRhiPassResourceTracker::BufStorageLoadStore:
         return QGles2Buffer::AccessStorageReadWrite;
+    case QRhiPassResourceTracker::BufIndirectRead:
+        return QGles2Buffer::AccessIndirect;
     default:
         Q_UNREACHABLE();
         break;
@@ -3129,6 +3199,32 @@ void QRhiGles2::executeCommandBuffer(QRhiCommandBuffer *cb)
             }
         }
             break;
+        case QGles2CommandBuffer::Command::DrawIndirect:
+        case QGles2CommandBuffer::Command::DrawIndexedIndirect:
+        {
+            QGles2GraphicsPipeline *psD = QRHI_RES(QGles2GraphicsPipeline, cmd.args.drawIndirect.ps);
+            if (!psD) {
+                qWarning("No graphics pipeline active for indirect draw; ignored");
+                break;
+            }
+            const bool indexed = cmd.cmd == QGles2CommandBuffer::Command::DrawIndexedIndirect;
+            // The first index in the arguments is relative to the start of
+            // the buffer, there is nothing to add the offset to.
+            if (indexed && state.indexOffset)
+                qWarning("drawIndexedIndirect() does not support index buffer offsets with OpenGL");
+            // There is no glMultiDraw*Indirect in ES, so one call per draw
+            f->glBindBuffer(GL_DRAW_INDIRECT_BUFFER, cmd.args.drawIndirect.buffer);
+            quintptr ofs = cmd.args.drawIndirect.offset;
+            for (quint32 i = 0; i < cmd.args.drawIndirect.drawCount; ++i) {
+                if (indexed)
+                    f->glDrawElementsIndirect(psD->drawMode, state.indexType, reinterpret_cast<const void *>(ofs));
+                else
+                    f->glDrawArraysIndirect(psD->drawMode, reinterpret_cast<const void *>(ofs));
+                ofs += cmd.args.drawIndirect.stride;
+            }
+            f->glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+            break;
         case QGles2CommandBuffer::Command::BindGraphicsPipeline:
             executeBindGraphicsPipeline(cbD, QRHI_RES(QGles2GraphicsPipeline, cmd.args.bindGraphicsPipeline.ps));
             break;
@@ -3451,6 +3547,11 @@ void QRhiGles2::executeCommandBuffer(QRhiCommandBuffer *cb)
         case QGles2CommandBuffer::Command::Dispatch:
             f->glDispatchCompute(cmd.args.dispatch.x, cmd.args.dispatch.y, cmd.args.dispatch.z);
             break;
+        case QGles2CommandBuffer::Command::DispatchIndirect:
+            f->glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, cmd.args.dispatchIndirect.buffer);
+            f->glDispatchComputeIndirect(GLintptr(cmd.args.dispatchIndirect.offset));
+            f->glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+            break;
         case QGles2CommandBuffer::Command::BarriersForPass:
         {
             if (!caps.compute)
@@ -4383,14 +4484,16 @@ inline void qrhigl_accumulateComputeResource(T *writtenResources, QRhiResource *
         writtenResources->insert(resource, { access, true });
 }
 
-void QRhiGles2::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
+void QRhiGles2::enqueueDispatchBarriers(QGles2CommandBuffer *cbD, QRhiBuffer *indirectBuffer)
 {
-    QGles2CommandBuffer *cbD = QRHI_RES(QGles2CommandBuffer, cb);
-    Q_ASSERT(cbD->recordingPass == QGles2CommandBuffer::ComputePass);
+    GLbitfield barriers = 0;
 
-    if (cbD->currentComputeSrb) {
-        GLbitfield barriers = 0;
+    // The arguments of an indirect dispatch may have been written by an
+    // earlier dispatch in the same pass.
+    if (indirectBuffer && cbD->computePassState.writtenResources.contains(indirectBuffer))
+        barriers |= GL_COMMAND_BARRIER_BIT;
 
+    if (cbD->currentComputeSrb) {
         // The key in the writtenResources map indicates that the resource was
         // written in a previous dispatch, whereas the value accumulates the
         // access mask in the current one.
@@ -4444,13 +4547,21 @@ void QRhiGles2::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
             else
                 ++it;
         }
+    }
 
-        if (barriers) {
-            QGles2CommandBuffer::Command &cmd(cbD->commands.get());
-            cmd.cmd = QGles2CommandBuffer::Command::Barrier;
-            cmd.args.barrier.barriers = barriers;
-        }
+    if (barriers) {
+        QGles2CommandBuffer::Command &cmd(cbD->commands.get());
+        cmd.cmd = QGles2CommandBuffer::Command::Barrier;
+        cmd.args.barrier.barriers = barriers;
     }
+}
+
+void QRhiGles2::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
+{
+    QGles2CommandBuffer *cbD = QRHI_RES(QGles2CommandBuffer, cb);
+    Q_ASSERT(cbD->recordingPass == QGles2CommandBuffer::ComputePass);
+
+    enqueueDispatchBarriers(cbD, nullptr);
 
     QGles2CommandBuffer::Command &cmd(cbD->commands.get());
     cmd.cmd = QGles2CommandBuffer::Command::Dispatch;
@@ -4459,6 +4570,28 @@ void QRhiGles2::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
     cmd.args.dispatch.z = GLuint(z);
 }
 
+void QRhiGles2::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                 quint32 indirectBufferOffset)
+{
+    QGles2CommandBuffer *cbD = QRHI_RES(QGles2CommandBuffer, cb);
+    Q_ASSERT(cbD->recordingPass == QGles2CommandBuffer::ComputePass);
+    QGles2Buffer *bufD = QRHI_RES(QGles2Buffer, indirectBuffer);
+    Q_ASSERT(bufD->m_usage.testFlag(QRhiBuffer::IndirectBuffer));
+
+    enqueueDispatchBarriers(cbD, indirectBuffer);
+
+    QGles2CommandBuffer::Command &cmd(cbD->commands.get());
+    cmd.cmd = QGles2CommandBuffer::Command::DispatchIndirect;
+    cmd.args.dispatchIndirect.buffer = bufD->buffer;
+    cmd.args.dispatchIndirect.offset = indirectBufferOffset;
+
+    if (cbD->passNeedsResourceTracking) {
+        QRhiPassResourceTracker &passResTracker(cbD->passResTrackers[cbD->currentPassResTrackerIndex]);
+        trackedRegisterBuffer(&passResTracker, bufD, QRhiPassResourceTracker::BufIndirectRead,
+                              QRhiPassResourceTracker::BufDrawIndirectStage);
+    }
+}
+
 static inline GLenum toGlShaderType(QRhiShaderStage::Type type)
 {
     switch (type) {
@@ -50,7 +50,8 @@ struct QGles2Buffer : public QRhiBuffer
         AccessStorageRead,
         AccessStorageWrite,
         AccessStorageReadWrite,
-        AccessUpdate
+        AccessUpdate,
+        AccessIndirect
     };
     struct UsageState {
         Access access;
@@ -319,6 +320,8 @@ struct QGles2CommandBuffer : public QRhiCommandBuffer
             BindIndexBuffer,
             Draw,
             DrawIndexed,
+            DrawIndirect,
+            DrawIndexedIndirect,
             BindGraphicsPipeline,
             BindShaderResources,
             BindFramebuffer,
@@ -334,6 +337,7 @@ struct QGles2CommandBuffer : public QRhiCommandBuffer
             GenMip,
             BindComputePipeline,
             Dispatch,
+            DispatchIndirect,
             BarriersForPass,
             Barrier
         };
@@ -382,6 +386,13 @@ struct QGles2CommandBuffer : public QRhiCommandBuffer
                 quint32 baseInstance;
                 qint32 baseVertex;
             } drawIndexed;
+            struct {
+                QRhiGraphicsPipeline *ps;
+                GLuint buffer;
+                quint32 offset;
+                quint32 drawCount;
+                quint32 stride;
+            } drawIndirect; // also for DrawIndexedIndirect
             struct {
                 QRhiGraphicsPipeline *ps;
             } bindGraphicsPipeline;
@@ -510,6 +521,10 @@ struct QGles2CommandBuffer : public QRhiCommandBuffer
                 GLuint y;
                 GLuint z;
             } dispatch;
+            struct {
+                GLuint buffer;
+                quint32 offset;
+            } dispatchIndirect;
             struct {
                 int trackerIndex;
             } barriersForPass;
@@ -791,6 +806,11 @@ public:
                      quint32 instanceCount, quint32 firstIndex,
                      qint32 vertexOffset, quint32 firstInstance) override;
 
+    void drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                      quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) override;
+    void drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) override;
+
     void debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name) override;
     void debugMarkEnd(QRhiCommandBuffer *cb) override;
     void debugMarkMsg(QRhiCommandBuffer *cb, const QByteArray &msg) override;
@@ -801,10 +821,14 @@ public:
     void endComputePass(QRhiCommandBuffer *cb, QRhiResourceUpdateBatch *resourceUpdates) override;
     void setComputePipeline(QRhiCommandBuffer *cb, QRhiComputePipeline *ps) override;
     void dispatch(QRhiCommandBuffer *cb, int x, int y, int z) override;
+    void dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                          quint32 indirectBufferOffset) override;
 
     const QRhiNativeHandles *nativeHandles(QRhiCommandBuffer *cb) override;
     void beginExternal(QRhiCommandBuffer *cb) override;
     void endExternal(QRhiCommandBuffer *cb) override;
+    void executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                        const QRhiNativeHandles *const *commandBuffers) override;
     double lastCompletedGpuTime(QRhiCommandBuffer *cb) override;
 
     QList<int> supportedSampleCounts() const override;
@@ -838,6 +862,10 @@ public:
                                QGles2Buffer *bufD,
                                QRhiPassResourceTracker::BufferAccess access,
                                QRhiPassResourceTracker::BufferStage stage);
+    void enqueueDrawIndirect(QGles2CommandBuffer *cbD, QGles2CommandBuffer::Command::Cmd cmdType,
+                             QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset,
+                             quint32 drawCount, quint32 stride);
+    void enqueueDispatchBarriers(QGles2CommandBuffer *cbD, QRhiBuffer *indirectBuffer);
     void trackedRegisterTexture(QRhiPassResourceTracker *passResTracker,
                                 QGles2Texture *texD,
                                 QRhiPassResourceTracker::TextureAccess access,
@@ -950,6 +978,7 @@ public:
               instancing(false),
               baseVertex(false),
               compute(false),
+              drawIndirect(false),
               textureCompareMode(false),
               properMapBuffer(false),
               nonBaseLevelFramebufferTexture(false),
@@ -1003,6 +1032,7 @@ public:
         uint instancing : 1;
         uint baseVertex : 1;
         uint compute : 1;
+        uint drawIndirect : 1;
         uint textureCompareMode : 1;
         uint properMapBuffer : 1;
         uint nonBaseLevelFramebufferTexture : 1;
@@ -833,6 +833,12 @@ bool QRhiMetal::isFeatureSupported(QRhi::Feature feature) const
         return false;
     case QRhi::ThreeDimensionalTextureMipmaps:
         return true;
+    case QRhi::SecondaryCommandBuffers:
+        return false;
+    case QRhi::DrawIndirect:
+        return false;
+    case QRhi::DrawIndirectMulti:
+        return false;
     default:
         Q_UNREACHABLE();
         return false;
@@ -2214,6 +2220,26 @@ void QRhiMetal::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
     }
 }
 
+void QRhiMetal::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
+void QRhiMetal::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                    quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
 void QRhiMetal::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
     if (!debugMarkers)
@@ -2265,6 +2291,14 @@ void QRhiMetal::endExternal(QRhiCommandBuffer *cb)
     cbD->resetPerPassCachedState();
 }
 
+void QRhiMetal::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                               const QRhiNativeHandles *const *commandBuffers)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(count);
+    Q_UNUSED(commandBuffers);
+}
+
 double QRhiMetal::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     QMetalCommandBuffer *cbD = QRHI_RES(QMetalCommandBuffer, cb);
@@ -3017,6 +3051,14 @@ void QRhiMetal::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
       threadsPerThreadgroup: psD->d->localSize];
 }
 
+void QRhiMetal::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                 quint32 indirectBufferOffset)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+}
+
 static void qrhimtl_releaseBuffer(const QRhiMetalData::DeferredReleaseEntry &e)
 {
     for (int i = 0; i < QMTL_FRAMES_IN_FLIGHT; ++i)
@@ -303,6 +303,26 @@ void QRhiNull::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
     Q_UNUSED(firstInstance);
 }
 
+void QRhiNull::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                            quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
+void QRhiNull::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                   quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+    Q_UNUSED(drawCount);
+    Q_UNUSED(stride);
+}
+
 void QRhiNull::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
     Q_UNUSED(cb);
@@ -334,6 +354,14 @@ void QRhiNull::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
     Q_UNUSED(z);
 }
 
+void QRhiNull::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                quint32 indirectBufferOffset)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(indirectBuffer);
+    Q_UNUSED(indirectBufferOffset);
+}
+
 const QRhiNativeHandles *QRhiNull::nativeHandles(QRhiCommandBuffer *cb)
 {
     Q_UNUSED(cb);
@@ -350,6 +378,14 @@ void QRhiNull::endExternal(QRhiCommandBuffer *cb)
     Q_UNUSED(cb);
 }
 
+void QRhiNull::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                              const QRhiNativeHandles *const *commandBuffers)
+{
+    Q_UNUSED(cb);
+    Q_UNUSED(count);
+    Q_UNUSED(commandBuffers);
+}
+
 double QRhiNull::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     Q_UNUSED(cb);
@@ -753,6 +753,8 @@ bool QRhiVulkan::create(QRhi::Flags flags)
 
     caps.nonFillPolygonMode = physDevFeatures.fillModeNonSolid;
 
+    caps.multiDrawIndirect = physDevFeatures.multiDrawIndirect;
+
     if (!importedAllocator) {
         VmaVulkanFunctions funcs = {};
         funcs.vkGetInstanceProcAddr = wrap_vkGetInstanceProcAddr;
@@ -850,6 +852,8 @@ void QRhiVulkan::destroy()
 
     descriptorPools.clear();
 
+    destroyStagingAreas();
+
     if (timestampQueryPool) {
         df->vkDestroyQueryPool(dev, timestampQueryPool, nullptr);
         timestampQueryPool = VK_NULL_HANDLE;
@@ -2019,6 +2023,7 @@ void QRhiVulkan::prepareNewFrame(QRhiCommandBuffer *cb)
     // slot's previous commands to complete so this here is safe regardless.
 
     executeDeferredReleases();
+    resetStagingArea(currentFrameSlot);
 
     QRHI_RES(QVkCommandBuffer, cb)->resetState();
 
@@ -2604,9 +2609,49 @@ inline void qrhivk_accumulateComputeResource(T *writtenResources, QRhiResource *
 
 void QRhiVulkan::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
 {
-    QVkCommandBuffer *cbD = QRHI_RES(QVkCommandBuffer, cb);
+    recordDispatch(QRHI_RES(QVkCommandBuffer, cb), x, y, z, nullptr, 0);
+}
+
+void QRhiVulkan::dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                  quint32 indirectBufferOffset)
+{
+    recordDispatch(QRHI_RES(QVkCommandBuffer, cb), 0, 0, 0,
+                   QRHI_RES(QVkBuffer, indirectBuffer), indirectBufferOffset);
+}
+
+// With indirectBufD the group counts come from that buffer instead of x, y, z.
+void QRhiVulkan::recordDispatch(QVkCommandBuffer *cbD, int x, int y, int z,
+                                QVkBuffer *indirectBufD, quint32 indirectBufferOffset)
+{
     Q_ASSERT(cbD->recordingPass == QVkCommandBuffer::ComputePass);
 
+    VkBuffer indirectBuf = VK_NULL_HANDLE;
+    if (indirectBufD) {
+        Q_ASSERT(indirectBufD->m_usage.testFlag(QRhiBuffer::IndirectBuffer));
+        indirectBufD->lastActiveFrameSlot = currentFrameSlot;
+        if (indirectBufD->m_type == QRhiBuffer::Dynamic)
+            executeBufferHostWritesForSlot(indirectBufD, currentFrameSlot);
+        const int slot = indirectBufD->m_type == QRhiBuffer::Dynamic ? currentFrameSlot : 0;
+        indirectBuf = indirectBufD->buffers[slot];
+        QRhiPassResourceTracker &passResTracker(cbD->passResTrackers[cbD->currentPassResTrackerIndex]);
+        trackedRegisterBuffer(&passResTracker, indirectBufD, slot,
+                              QRhiPassResourceTracker::BufIndirectRead,
+                              QRhiPassResourceTracker::BufDrawIndirectStage);
+    }
+
+    // The arguments may have been written by an earlier dispatch in the
+    // same pass; that needs a barrier of its own, since the stage differs.
+    VkBufferMemoryBarrier indirectBarrier = {};
+    if (indirectBufD && cbD->computePassState.writtenResources.contains(indirectBufD)) {
+        indirectBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        indirectBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        indirectBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        indirectBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        indirectBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        indirectBarrier.buffer = indirectBuf;
+        indirectBarrier.size = VK_WHOLE_SIZE;
+    }
+
     // When there are multiple dispatches, read-after-write and
     // write-after-write need a barrier.
     QVarLengthArray<VkImageMemoryBarrier, 8> imageBarriers;
@@ -2705,7 +2750,16 @@ void QRhiVulkan::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
                                      bufferBarriers.size(), bufferBarriers.constData(),
                                      0, nullptr);
         }
-        df->vkCmdDispatch(secondaryCb, uint32_t(x), uint32_t(y), uint32_t(z));
+        if (indirectBarrier.buffer) {
+            df->vkCmdPipelineBarrier(secondaryCb, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                                     0, 0, nullptr,
+                                     1, &indirectBarrier,
+                                     0, nullptr);
+        }
+        if (indirectBuf)
+            df->vkCmdDispatchIndirect(secondaryCb, indirectBuf, indirectBufferOffset);
+        else
+            df->vkCmdDispatch(secondaryCb, uint32_t(x), uint32_t(y), uint32_t(z));
     } else {
         if (!imageBarriers.isEmpty()) {
             QVkCommandBuffer::Command &cmd(cbD->commands.get());
@@ -2725,11 +2779,26 @@ void QRhiVulkan::dispatch(QRhiCommandBuffer *cb, int x, int y, int z)
             cmd.args.bufferBarrier.index = cbD->pools.bufferBarrier.size();
             cbD->pools.bufferBarrier.append(bufferBarriers.constData(), bufferBarriers.size());
         }
+        if (indirectBarrier.buffer) {
+            QVkCommandBuffer::Command &cmd(cbD->commands.get());
+            cmd.cmd = QVkCommandBuffer::Command::BufferBarrier;
+            cmd.args.bufferBarrier.srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            cmd.args.bufferBarrier.dstStageMask = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+            cmd.args.bufferBarrier.count = 1;
+            cmd.args.bufferBarrier.index = cbD->pools.bufferBarrier.size();
+            cbD->pools.bufferBarrier.append(indirectBarrier);
+        }
         QVkCommandBuffer::Command &cmd(cbD->commands.get());
-        cmd.cmd = QVkCommandBuffer::Command::Dispatch;
-        cmd.args.dispatch.x = x;
-        cmd.args.dispatch.y = y;
-        cmd.args.dispatch.z = z;
+        if (indirectBuf) {
+            cmd.cmd = QVkCommandBuffer::Command::DispatchIndirect;
+            cmd.args.dispatchIndirect.buf = indirectBuf;
+            cmd.args.dispatchIndirect.ofs = indirectBufferOffset;
+        } else {
+            cmd.cmd = QVkCommandBuffer::Command::Dispatch;
+            cmd.args.dispatch.x = x;
+            cmd.args.dispatch.y = y;
+            cmd.args.dispatch.z = z;
+        }
     }
 }
 
@@ -3088,6 +3157,100 @@ VkDeviceSize QRhiVulkan::subresUploadByteSize(const QRhiTextureSubresourceUpload
     return size;
 }
 
+static const VkDeviceSize QVK_STAGING_AREA_MIN_SIZE = 4 * 1024 * 1024;
+static const VkDeviceSize QVK_STAGING_AREA_MAX_SIZE = 64 * 1024 * 1024;
+
+// Makes the staging area at least size bytes large, within the
+// limits. Must not be called while the area is in use by the GPU.
+static bool qrhivk_ensureStagingArea(QRhiVulkan::StagingArea *area, VkDeviceSize size,
+                                     QVkAllocator allocator)
+{
+    size = qBound(QVK_STAGING_AREA_MIN_SIZE,
+                  VkDeviceSize(qNextPowerOfTwo(quint64(size - 1))),
+                  QVK_STAGING_AREA_MAX_SIZE);
+    if (area->buffer && area->size >= size)
+        return true;
+
+    if (area->buffer) {
+        vmaUnmapMemory(toVmaAllocator(allocator), toVmaAllocation(area->allocation));
+        vmaDestroyBuffer(toVmaAllocator(allocator), area->buffer, toVmaAllocation(area->allocation));
+        area->buffer = VK_NULL_HANDLE;
+        area->allocation = nullptr;
+        area->p = nullptr;
+        area->size = 0;
+    }
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+    VmaAllocation allocation;
+    VkResult err = vmaCreateBuffer(toVmaAllocator(allocator), &bufferInfo, &allocInfo,
+                                   &area->buffer, &allocation, nullptr);
+    if (err != VK_SUCCESS) {
+        qWarning("Failed to create staging area of size %llu: %d", quint64(size), err);
+        area->buffer = VK_NULL_HANDLE;
+        return false;
+    }
+    void *p = nullptr;
+    err = vmaMapMemory(toVmaAllocator(allocator), allocation, &p);
+    if (err != VK_SUCCESS) {
+        qWarning("Failed to map staging area: %d", err);
+        vmaDestroyBuffer(toVmaAllocator(allocator), area->buffer, allocation);
+        area->buffer = VK_NULL_HANDLE;
+        return false;
+    }
+    area->allocation = allocation;
+    area->p = static_cast<char *>(p);
+    area->size = size;
+    return true;
+}
+
+// Returns the mapped start of the current slot's staging area, with *buf
+// and *offset set to where size bytes can be written, or null when the
+// caller has to create a staging buffer of its own.
+char *QRhiVulkan::allocateStaging(VkDeviceSize size, VkBuffer *buf, VkDeviceSize *offset)
+{
+    StagingArea &area(stagingArea[currentFrameSlot]);
+    // bufferOffset must be a multiple of the texel block size as well
+    const VkDeviceSize align = qMax<VkDeviceSize>(texbufAlign, 16);
+    const VkDeviceSize ofs = aligned(area.used, align);
+    area.demand = aligned(area.demand, align) + size;
+    if (!area.buffer && !qrhivk_ensureStagingArea(&area, size, allocator))
+        return nullptr;
+    if (ofs + size > area.size)
+        return nullptr;
+    area.used = ofs + size;
+    *buf = area.buffer;
+    *offset = ofs;
+    return area.p;
+}
+
+// Called when the frameSlot's previous frame has completed.
+void QRhiVulkan::resetStagingArea(int frameSlot)
+{
+    StagingArea &area(stagingArea[frameSlot]);
+    if (area.buffer && area.demand > area.size)
+        qrhivk_ensureStagingArea(&area, area.demand, allocator);
+    area.used = 0;
+    area.demand = 0;
+}
+
+void QRhiVulkan::destroyStagingAreas()
+{
+    for (StagingArea &area : stagingArea) {
+        if (area.buffer) {
+            vmaUnmapMemory(toVmaAllocator(allocator), toVmaAllocation(area.allocation));
+            vmaDestroyBuffer(toVmaAllocator(allocator), area.buffer, toVmaAllocation(area.allocation));
+        }
+        area = {};
+    }
+}
+
 void QRhiVulkan::prepareUploadSubres(QVkTexture *texD, int layer, int level,
                                      const QRhiTextureSubresourceUploadDescription &subresDesc,
                                      size_t *curOfs, void *mp,
@@ -3357,31 +3520,41 @@ void QRhiVulkan::enqueueResourceUpdates(QVkCommandBuffer *cbD, QRhiResourceUpdat
             }
 
             Q_ASSERT(!utexD->stagingBuffers[currentFrameSlot]);
-            VkBufferCreateInfo bufferInfo = {};
-            bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferInfo.size = stagingSize;
-            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-            VmaAllocationCreateInfo allocInfo = {};
-            allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-
-            VmaAllocation allocation;
-            VkResult err = vmaCreateBuffer(toVmaAllocator(allocator), &bufferInfo, &allocInfo,
-                                           &utexD->stagingBuffers[currentFrameSlot], &allocation, nullptr);
-            if (err != VK_SUCCESS) {
-                qWarning("Failed to create image staging buffer of size %d: %d", int(stagingSize), err);
-                continue;
-            }
-            utexD->stagingAllocations[currentFrameSlot] = allocation;
-
             BufferImageCopyList copyInfos;
             size_t curOfs = 0;
             void *mp = nullptr;
-            VmaAllocation a = toVmaAllocation(utexD->stagingAllocations[currentFrameSlot]);
-            err = vmaMapMemory(toVmaAllocator(allocator), a, &mp);
-            if (err != VK_SUCCESS) {
-                qWarning("Failed to map image data: %d", err);
-                continue;
+            VkBuffer stagingBuf = VK_NULL_HANDLE;
+            VkDeviceSize stagingOfs = 0;
+            VmaAllocation a = nullptr;
+            if (char *p = allocateStaging(stagingSize, &stagingBuf, &stagingOfs)) {
+                mp = p;
+                curOfs = size_t(stagingOfs);
+                a = toVmaAllocation(stagingArea[currentFrameSlot].allocation);
+            } else {
+                VkBufferCreateInfo bufferInfo = {};
+                bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = stagingSize;
+                bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+                VmaAllocationCreateInfo allocInfo = {};
+                allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+
+                VmaAllocation allocation;
+                VkResult err = vmaCreateBuffer(toVmaAllocator(allocator), &bufferInfo, &allocInfo,
+                                               &utexD->stagingBuffers[currentFrameSlot], &allocation, nullptr);
+                if (err != VK_SUCCESS) {
+                    qWarning("Failed to create image staging buffer of size %d: %d", int(stagingSize), err);
+                    continue;
+                }
+                utexD->stagingAllocations[currentFrameSlot] = allocation;
+                stagingBuf = utexD->stagingBuffers[currentFrameSlot];
+
+                a = allocation;
+                err = vmaMapMemory(toVmaAllocator(allocator), a, &mp);
+                if (err != VK_SUCCESS) {
+                    qWarning("Failed to map image data: %d", err);
+                    continue;
+                }
             }
 
             for (int layer = 0, maxLayer = u.subresDesc.size(); layer < maxLayer; ++layer) {
@@ -3395,30 +3568,34 @@ void QRhiVulkan::enqueueResourceUpdates(QVkCommandBuffer *cbD, QRhiResourceUpdat
                     }
                 }
             }
-            vmaFlushAllocation(toVmaAllocator(allocator), a, 0, stagingSize);
-            vmaUnmapMemory(toVmaAllocator(allocator), a);
+            vmaFlushAllocation(toVmaAllocator(allocator), a, stagingOfs, stagingSize);
+            if (utexD->stagingBuffers[currentFrameSlot])
+                vmaUnmapMemory(toVmaAllocator(allocator), a);
 
             trackedImageBarrier(cbD, utexD, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
             QVkCommandBuffer::Command &cmd(cbD->commands.get());
             cmd.cmd = QVkCommandBuffer::Command::CopyBufferToImage;
-            cmd.args.copyBufferToImage.src = utexD->stagingBuffers[currentFrameSlot];
+            cmd.args.copyBufferToImage.src = stagingBuf;
             cmd.args.copyBufferToImage.dst = utexD->image;
             cmd.args.copyBufferToImage.dstLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
             cmd.args.copyBufferToImage.count = copyInfos.size();
             cmd.args.copyBufferToImage.bufferImageCopyIndex = cbD->pools.bufferImageCopy.size();
             cbD->pools.bufferImageCopy.append(copyInfos.constData(), copyInfos.size());
 
-            // no reuse of staging, this is intentional
-            QRhiVulkan::DeferredReleaseEntry e;
-            e.type = QRhiVulkan::DeferredReleaseEntry::StagingBuffer;
-            e.lastActiveFrameSlot = currentFrameSlot;
-            e.stagingBuffer.stagingBuffer = utexD->stagingBuffers[currentFrameSlot];
-            e.stagingBuffer.stagingAllocation = utexD->stagingAllocations[currentFrameSlot];
-            utexD->stagingBuffers[currentFrameSlot] = VK_NULL_HANDLE;
-            utexD->stagingAllocations[currentFrameSlot] = nullptr;
-            releaseQueue.append(e);
+            // A dedicated staging buffer is not reused, this is intentional;
+            // the staging area takes care of the common case.
+            if (utexD->stagingBuffers[currentFrameSlot]) {
+                QRhiVulkan::DeferredReleaseEntry e;
+                e.type = QRhiVulkan::DeferredReleaseEntry::StagingBuffer;
+                e.lastActiveFrameSlot = currentFrameSlot;
+                e.stagingBuffer.stagingBuffer = utexD->stagingBuffers[currentFrameSlot];
+                e.stagingBuffer.stagingAllocation = utexD->stagingAllocations[currentFrameSlot];
+                utexD->stagingBuffers[currentFrameSlot] = VK_NULL_HANDLE;
+                utexD->stagingAllocations[currentFrameSlot] = nullptr;
+                releaseQueue.append(e);
+            }
 
             // Similarly to buffers, transitioning away from DST is done later,
             // when a renderpass using the texture is encountered.
@@ -4009,6 +4186,14 @@ void QRhiVulkan::recordPrimaryCommandBuffer(QVkCommandBuffer *cbD)
                                  cmd.args.drawIndexed.firstIndex, cmd.args.drawIndexed.vertexOffset,
                                  cmd.args.drawIndexed.firstInstance);
             break;
+        case QVkCommandBuffer::Command::DrawIndirect:
+            df->vkCmdDrawIndirect(cbD->cb, cmd.args.drawIndirect.buf, cmd.args.drawIndirect.ofs,
+                                  cmd.args.drawIndirect.drawCount, cmd.args.drawIndirect.stride);
+            break;
+        case QVkCommandBuffer::Command::DrawIndexedIndirect:
+            df->vkCmdDrawIndexedIndirect(cbD->cb, cmd.args.drawIndirect.buf, cmd.args.drawIndirect.ofs,
+                                         cmd.args.drawIndirect.drawCount, cmd.args.drawIndirect.stride);
+            break;
         case QVkCommandBuffer::Command::DebugMarkerBegin:
 #ifdef VK_EXT_debug_utils
             cmd.args.debugMarkerBegin.label.pLabelName =
@@ -4034,6 +4219,9 @@ void QRhiVulkan::recordPrimaryCommandBuffer(QVkCommandBuffer *cbD)
         case QVkCommandBuffer::Command::Dispatch:
             df->vkCmdDispatch(cbD->cb, uint32_t(cmd.args.dispatch.x), uint32_t(cmd.args.dispatch.y), uint32_t(cmd.args.dispatch.z));
             break;
+        case QVkCommandBuffer::Command::DispatchIndirect:
+            df->vkCmdDispatchIndirect(cbD->cb, cmd.args.dispatchIndirect.buf, cmd.args.dispatchIndirect.ofs);
+            break;
         case QVkCommandBuffer::Command::ExecuteSecondary:
             df->vkCmdExecuteCommands(cbD->cb, 1, &cmd.args.executeSecondary.cb);
             break;
@@ -4058,6 +4246,8 @@ static inline VkAccessFlags toVkAccess(QRhiPassResourceTracker::BufferAccess acc
         return VK_ACCESS_SHADER_WRITE_BIT;
     case QRhiPassResourceTracker::BufStorageLoadStore:
         return VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    case QRhiPassResourceTracker::BufIndirectRead:
+        return VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
     default:
         Q_UNREACHABLE();
         break;
@@ -4068,6 +4258,8 @@ static inline VkAccessFlags toVkAccess(QRhiPassResourceTracker::BufferAccess acc
 static inline VkPipelineStageFlags toVkPipelineStage(QRhiPassResourceTracker::BufferStage stage)
 {
     switch (stage) {
+    case QRhiPassResourceTracker::BufDrawIndirectStage:
+        return VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
     case QRhiPassResourceTracker::BufVertexInputStage:
         return VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
     case QRhiPassResourceTracker::BufVertexStage:
@@ -4436,6 +4628,12 @@ bool QRhiVulkan::isFeatureSupported(QRhi::Feature feature) const
         return true;
     case QRhi::ThreeDimensionalTextureMipmaps:
         return true;
+    case QRhi::SecondaryCommandBuffers:
+        return true;
+    case QRhi::DrawIndirect:
+        return true;
+    case QRhi::DrawIndirectMulti:
+        return caps.multiDrawIndirect;
     default:
         Q_UNREACHABLE_RETURN(false);
     }
@@ -5170,6 +5368,61 @@ void QRhiVulkan::drawIndexed(QRhiCommandBuffer *cb, quint32 indexCount,
     }
 }
 
+void QRhiVulkan::recordDrawIndirect(QVkCommandBuffer *cbD, QVkCommandBuffer::Command::Cmd cmdType,
+                                    QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset,
+                                    quint32 drawCount, quint32 stride)
+{
+    Q_ASSERT(cbD->recordingPass == QVkCommandBuffer::RenderPass);
+    QVkBuffer *bufD = QRHI_RES(QVkBuffer, indirectBuffer);
+    Q_ASSERT(bufD->m_usage.testFlag(QRhiBuffer::IndirectBuffer));
+    bufD->lastActiveFrameSlot = currentFrameSlot;
+    if (bufD->m_type == QRhiBuffer::Dynamic)
+        executeBufferHostWritesForSlot(bufD, currentFrameSlot);
+
+    const int slot = bufD->m_type == QRhiBuffer::Dynamic ? currentFrameSlot : 0;
+    const VkBuffer vkbuf = bufD->buffers[slot];
+    QRhiPassResourceTracker &passResTracker(cbD->passResTrackers[cbD->currentPassResTrackerIndex]);
+    trackedRegisterBuffer(&passResTracker, bufD, slot,
+                          QRhiPassResourceTracker::BufIndirectRead,
+                          QRhiPassResourceTracker::BufDrawIndirectStage);
+
+    // Without multiDrawIndirect the draw count must be 0 or 1
+    const quint32 callCount = caps.multiDrawIndirect ? 1 : drawCount;
+    const quint32 countPerCall = caps.multiDrawIndirect ? drawCount : 1;
+    VkDeviceSize ofs = indirectBufferOffset;
+    for (quint32 i = 0; i < callCount; ++i) {
+        if (cbD->passUsesSecondaryCb) {
+            const VkCommandBuffer secondaryCb = cbD->activeSecondaryCbStack.last();
+            if (cmdType == QVkCommandBuffer::Command::DrawIndexedIndirect)
+                df->vkCmdDrawIndexedIndirect(secondaryCb, vkbuf, ofs, countPerCall, stride);
+            else
+                df->vkCmdDrawIndirect(secondaryCb, vkbuf, ofs, countPerCall, stride);
+        } else {
+            QVkCommandBuffer::Command &cmd(cbD->commands.get());
+            cmd.cmd = cmdType;
+            cmd.args.drawIndirect.buf = vkbuf;
+            cmd.args.drawIndirect.ofs = ofs;
+            cmd.args.drawIndirect.drawCount = countPerCall;
+            cmd.args.drawIndirect.stride = stride;
+        }
+        ofs += stride;
+    }
+}
+
+void QRhiVulkan::drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                              quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    recordDrawIndirect(QRHI_RES(QVkCommandBuffer, cb), QVkCommandBuffer::Command::DrawIndirect,
+                       indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
+void QRhiVulkan::drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                                     quint32 indirectBufferOffset, quint32 drawCount, quint32 stride)
+{
+    recordDrawIndirect(QRHI_RES(QVkCommandBuffer, cb), QVkCommandBuffer::Command::DrawIndexedIndirect,
+                       indirectBuffer, indirectBufferOffset, drawCount, stride);
+}
+
 void QRhiVulkan::debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name)
 {
 #ifdef VK_EXT_debug_utils
@@ -5318,6 +5571,39 @@ void QRhiVulkan::endExternal(QRhiCommandBuffer *cb)
     cbD->resetCachedState();
 }
 
+void QRhiVulkan::executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                                const QRhiNativeHandles *const *commandBuffers)
+{
+    QVkCommandBuffer *cbD = QRHI_RES(QVkCommandBuffer, cb);
+    if (cbD->recordingPass != QVkCommandBuffer::RenderPass || !cbD->passUsesSecondaryCb || cbD->inExternal) {
+        qWarning("executeSecondaryCommandBuffers() is only supported in a render pass started with "
+                 "QRhiCommandBuffer::ExternalContent, outside beginExternal() - endExternal().");
+        return;
+    }
+    if (count <= 0)
+        return;
+
+    // The application's command buffers go between the secondary command
+    // buffer we were recording into and a new one, so that they execute in
+    // order with the commands before and after. They are not ours, so they
+    // are not added to the release queue.
+    VkCommandBuffer secondaryCb = cbD->activeSecondaryCbStack.last();
+    cbD->activeSecondaryCbStack.removeLast();
+    endAndEnqueueSecondaryCommandBuffer(secondaryCb, cbD);
+
+    for (int i = 0; i < count; ++i) {
+        const auto *h = static_cast<const QRhiVulkanCommandBufferNativeHandles *>(commandBuffers[i]);
+        if (!h || !h->commandBuffer)
+            continue;
+        QVkCommandBuffer::Command &cmd(cbD->commands.get());
+        cmd.cmd = QVkCommandBuffer::Command::ExecuteSecondary;
+        cmd.args.executeSecondary.cb = h->commandBuffer;
+    }
+
+    cbD->activeSecondaryCbStack.append(startSecondaryCommandBuffer(maybeRenderTargetData(cbD)));
+    cbD->resetCachedState();
+}
+
 double QRhiVulkan::lastCompletedGpuTime(QRhiCommandBuffer *cb)
 {
     QVkCommandBuffer *cbD = QRHI_RES(QVkCommandBuffer, cb);
@@ -5360,6 +5646,8 @@ static inline VkBufferUsageFlagBits toVkBufferUsage(QRhiBuffer::UsageFlags usage
         u |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
     if (usage.testFlag(QRhiBuffer::StorageBuffer))
         u |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    if (usage.testFlag(QRhiBuffer::IndirectBuffer))
+        u |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
     return VkBufferUsageFlagBits(u);
 }
 
@@ -390,11 +390,14 @@ struct QVkCommandBuffer : public QRhiCommandBuffer
             SetStencilRef,
             Draw,
             DrawIndexed,
+            DrawIndirect,
+            DrawIndexedIndirect,
             DebugMarkerBegin,
             DebugMarkerEnd,
             DebugMarkerInsert,
             TransitionPassResources,
             Dispatch,
+            DispatchIndirect,
             ExecuteSecondary
         };
         Cmd cmd;
@@ -500,6 +503,12 @@ struct QVkCommandBuffer : public QRhiCommandBuffer
                 uint32_t firstInstance;
             } drawIndexed;
             struct {
+                VkBuffer buf;
+                VkDeviceSize ofs;
+                uint32_t drawCount;
+                uint32_t stride;
+            } drawIndirect; // also for DrawIndexedIndirect
+            struct {
 #ifdef VK_EXT_debug_utils
                 VkDebugUtilsLabelEXT label;
                 int labelNameIndex;
@@ -519,6 +528,10 @@ struct QVkCommandBuffer : public QRhiCommandBuffer
             struct {
                 int x, y, z;
             } dispatch;
+            struct {
+                VkBuffer buf;
+                VkDeviceSize ofs;
+            } dispatchIndirect;
             struct {
                 VkCommandBuffer cb;
             } executeSecondary;
@@ -709,6 +722,11 @@ public:
                      quint32 instanceCount, quint32 firstIndex,
                      qint32 vertexOffset, quint32 firstInstance) override;
 
+    void drawIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                      quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) override;
+    void drawIndexedIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                             quint32 indirectBufferOffset, quint32 drawCount, quint32 stride) override;
+
     void debugMarkBegin(QRhiCommandBuffer *cb, const QByteArray &name) override;
     void debugMarkEnd(QRhiCommandBuffer *cb) override;
     void debugMarkMsg(QRhiCommandBuffer *cb, const QByteArray &msg) override;
@@ -719,10 +737,14 @@ public:
     void endComputePass(QRhiCommandBuffer *cb, QRhiResourceUpdateBatch *resourceUpdates) override;
     void setComputePipeline(QRhiCommandBuffer *cb, QRhiComputePipeline *ps) override;
     void dispatch(QRhiCommandBuffer *cb, int x, int y, int z) override;
+    void dispatchIndirect(QRhiCommandBuffer *cb, QRhiBuffer *indirectBuffer,
+                          quint32 indirectBufferOffset) override;
 
     const QRhiNativeHandles *nativeHandles(QRhiCommandBuffer *cb) override;
     void beginExternal(QRhiCommandBuffer *cb) override;
     void endExternal(QRhiCommandBuffer *cb) override;
+    void executeSecondaryCommandBuffers(QRhiCommandBuffer *cb, int count,
+                                        const QRhiNativeHandles *const *commandBuffers) override;
     double lastCompletedGpuTime(QRhiCommandBuffer *cb) override;
 
     QList<int> supportedSampleCounts() const override;
@@ -778,6 +800,9 @@ public:
                                                          VkSemaphore *waitSem, VkSemaphore *signalSem);
     void waitCommandCompletion(int frameSlot);
     VkDeviceSize subresUploadByteSize(const QRhiTextureSubresourceUploadDescription &subresDesc) const;
+    char *allocateStaging(VkDeviceSize size, VkBuffer *buf, VkDeviceSize *offset);
+    void resetStagingArea(int frameSlot);
+    void destroyStagingAreas();
     using BufferImageCopyList = QVarLengthArray<VkBufferImageCopy, 16>;
     void prepareUploadSubres(QVkTexture *texD, int layer, int level,
                              const QRhiTextureSubresourceUploadDescription &subresDesc,
@@ -787,6 +812,11 @@ public:
     void executeBufferHostWritesForSlot(QVkBuffer *bufD, int slot);
     void enqueueTransitionPassResources(QVkCommandBuffer *cbD);
     void recordPrimaryCommandBuffer(QVkCommandBuffer *cbD);
+    void recordDrawIndirect(QVkCommandBuffer *cbD, QVkCommandBuffer::Command::Cmd cmdType,
+                            QRhiBuffer *indirectBuffer, quint32 indirectBufferOffset,
+                            quint32 drawCount, quint32 stride);
+    void recordDispatch(QVkCommandBuffer *cbD, int x, int y, int z,
+                        QVkBuffer *indirectBuffer, quint32 indirectBufferOffset);
     void trackedRegisterBuffer(QRhiPassResourceTracker *passResTracker,
                                QVkBuffer *bufD,
                                int slot,
@@ -865,6 +895,7 @@ public:
         bool tessellation = false;
         bool geometryShader = false;
         bool nonFillPolygonMode = false;
+        bool multiDrawIndirect = false;
         QVersionNumber apiVersion;
     } caps;
 
@@ -909,6 +940,19 @@ public:
         int timestampQueryIndex = -1;
     } ofr;
 
+    // Persistently mapped upload memory, one linear area per frame slot,
+    // reused once the slot's previous frame has completed. What does not fit
+    // gets a staging buffer of its own, and the area grows to the demand
+    // seen in the slot when it comes around again.
+    struct StagingArea {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        QVkAlloc allocation = nullptr;
+        char *p = nullptr;
+        VkDeviceSize size = 0;
+        VkDeviceSize used = 0;
+        VkDeviceSize demand = 0;
+    } stagingArea[QVK_FRAMES_IN_FLIGHT];
+
     struct TextureReadback {
         int activeFrameSlot = -1;
         QRhiReadbackDescription desc;
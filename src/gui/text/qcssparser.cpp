@@ -1904,8 +1904,32 @@ quint64 Selector::pseudoClass(quint64 *negated) const
 
 ///////////////////////////////////////////////////////////////////////////////
 // StyleSheet
+static void collectAttributeNames(const StyleRule &rule, QStringList *names)
+{
+    for (const Selector &selector : rule.selectors) {
+        for (const BasicSelector &basicSelector : selector.basicSelectors) {
+            for (const AttributeSelector &attributeSelector : basicSelector.attributeSelectors)
+                names->append(attributeSelector.name);
+        }
+    }
+}
+
 void StyleSheet::buildIndexes(Qt::CaseSensitivity nameCaseSensitivity)
 {
+    attributeNames.clear();
+    for (const StyleRule &rule : std::as_const(styleRules))
+        collectAttributeNames(rule, &attributeNames);
+    for (const StyleRule &rule : std::as_const(nameIndex))
+        collectAttributeNames(rule, &attributeNames);
+    for (const StyleRule &rule : std::as_const(idIndex))
+        collectAttributeNames(rule, &attributeNames);
+    for (const MediaRule &mediaRule : std::as_const(mediaRules)) {
+        for (const StyleRule &rule : mediaRule.styleRules)
+            collectAttributeNames(rule, &attributeNames);
+    }
+    attributeNames.sort();
+    attributeNames.removeDuplicates();
+
     QList<StyleRule> universals;
     for (int i = 0; i < styleRules.size(); ++i) {
         const StyleRule &rule = styleRules.at(i);
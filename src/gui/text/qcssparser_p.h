@@ -609,6 +609,8 @@ struct StyleSheet
     int depth; // applicable only for inline style sheets
     QMultiHash<QString, StyleRule> nameIndex;
     QMultiHash<QString, StyleRule> idIndex;
+    // Sorted names of the attributes that any selector tests
+    QStringList attributeNames;
 
     Q_GUI_EXPORT void buildIndexes(Qt::CaseSensitivity nameCaseSensitivity = Qt::CaseSensitive);
 };
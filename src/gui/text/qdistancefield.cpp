@@ -6,6 +6,21 @@
 #include <private/qdatabuffer_p.h>
 #include <private/qimage_p.h>
 #include <private/qpathsimplifier_p.h>
+#include <qcryptographichash.h>
+#include <qdir.h>
+#include <qfile.h>
+#if QT_CONFIG(temporaryfile)
+#include <qsavefile.h>
+#endif
+#include <qstandardpaths.h>
+#include <qsysinfo.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
+
+#include <atomic>
 
 QT_BEGIN_NAMESPACE
 
@@ -839,13 +854,17 @@ QDistanceFieldData *QDistanceFieldData::create(const QSize &size)
     return data;
 }
 
-QDistanceFieldData *QDistanceFieldData::create(const QPainterPath &path, bool doubleResolution)
+static QSize distanceFieldSize(const QPainterPath &path, bool doubleResolution)
 {
     int dfMargin = QT_DISTANCEFIELD_RADIUS(doubleResolution) / QT_DISTANCEFIELD_SCALE(doubleResolution);
     int glyphWidth = qCeil(path.boundingRect().width() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + dfMargin * 2;
     int glyphHeight = qCeil(path.boundingRect().height() / QT_DISTANCEFIELD_SCALE(doubleResolution)) + dfMargin * 2;
+    return QSize(glyphWidth, glyphHeight);
+}
 
-    QDistanceFieldData *data = create(QSize(glyphWidth, glyphHeight));
+QDistanceFieldData *QDistanceFieldData::create(const QPainterPath &path, bool doubleResolution)
+{
+    QDistanceFieldData *data = create(distanceFieldSize(path, doubleResolution));
 
     makeDistanceField(data,
                       path,
@@ -854,6 +873,123 @@ QDistanceFieldData *QDistanceFieldData::create(const QPainterPath &path, bool do
     return data;
 }
 
+// The distance fields of glyphs can be kept on disk, so that an application
+// showing large amounts of text doesn't have to make them again every time
+// it starts. This is enabled by setting QT_ENABLE_DISTANCEFIELD_DISK_CACHE,
+// or QT_DISTANCEFIELD_DISK_CACHE_DIR to the directory to use. The fields
+// are stored one per file, named after a hash of the font file, of the
+// distance field settings and of the glyph index.
+
+static const quint32 DISTANCEFIELD_CACHE_MAGIC = 0x51444643; // "QDFC"
+static const quint32 DISTANCEFIELD_CACHE_VERSION = 1;
+static const int DISTANCEFIELD_CACHE_HEADER_SIZE = 4 * int(sizeof(quint32));
+
+static QString distanceFieldCacheDir()
+{
+    static const QString dir = [] {
+        QString dir = qEnvironmentVariable("QT_DISTANCEFIELD_DISK_CACHE_DIR");
+        if (dir.isEmpty() && qEnvironmentVariableIntValue("QT_ENABLE_DISTANCEFIELD_DISK_CACHE")) {
+            const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+            if (!cacheLocation.isEmpty())
+                dir = cacheLocation + "/qtdistancefieldcache-"_L1 + QSysInfo::buildAbi();
+        }
+        if (!dir.isEmpty()) {
+            QDir::root().mkpath(dir);
+            if (!QFileInfo(dir).isWritable()) {
+                qCDebug(lcDistanceField) << "disk cache directory" << dir << "is not writable";
+                return QString();
+            }
+            dir += u'/';
+            qCDebug(lcDistanceField) << "using the disk cache in" << dir;
+        }
+        return dir;
+    }();
+    return dir;
+}
+
+// Returns the prefix of the cache files of the glyphs of font, or an empty
+// string if they are not to be cached. The font file is identified by its
+// head table, which holds a checksum of the whole file and the time it was
+// last modified, and by its name table.
+static QString distanceFieldCachePrefix(const QRawFont &font, bool doubleResolution)
+{
+    const QString dir = distanceFieldCacheDir();
+    if (dir.isEmpty())
+        return QString();
+
+    const QByteArray head = font.fontTable("head");
+    if (head.isEmpty())
+        return QString();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(head);
+    hash.addData(font.fontTable("name"));
+    hash.addData(font.familyName().toUtf8());
+    hash.addData(font.styleName().toUtf8());
+    const int settings[] = {
+        int(DISTANCEFIELD_CACHE_VERSION),
+        int(font.hintingPreference()),
+        int(doubleResolution),
+        QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution),
+        QT_DISTANCEFIELD_SCALE(doubleResolution),
+        QT_DISTANCEFIELD_RADIUS(doubleResolution)
+    };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(settings), sizeof(settings)));
+    return dir + QString::fromLatin1(hash.result().toHex()) + u'-';
+}
+
+static QDistanceFieldData *loadCachedDistanceField(const QString &prefix, glyph_t glyph)
+{
+    QFile file(prefix + QString::number(glyph));
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+    const QByteArray contents = file.readAll();
+    if (contents.size() < DISTANCEFIELD_CACHE_HEADER_SIZE)
+        return nullptr;
+
+    quint32 header[4];
+    memcpy(header, contents.constData(), sizeof(header));
+    const quint32 width = header[2];
+    const quint32 height = header[3];
+    if (header[0] != DISTANCEFIELD_CACHE_MAGIC || header[1] != DISTANCEFIELD_CACHE_VERSION
+            || width > 0xffff || height > 0xffff
+            || contents.size() != DISTANCEFIELD_CACHE_HEADER_SIZE + qsizetype(width * height)) {
+        qCDebug(lcDistanceField) << "ignoring invalid cache file" << file.fileName();
+        return nullptr;
+    }
+
+    QDistanceFieldData *data = QDistanceFieldData::create(QSize(width, height));
+    if (data->data)
+        memcpy(data->data, contents.constData() + DISTANCEFIELD_CACHE_HEADER_SIZE, data->nbytes);
+    data->glyph = glyph;
+    return data;
+}
+
+static void saveCachedDistanceField(const QString &prefix, const QDistanceFieldData *data)
+{
+    QByteArray contents(DISTANCEFIELD_CACHE_HEADER_SIZE + data->nbytes, Qt::Uninitialized);
+    const quint32 header[4] = {
+        DISTANCEFIELD_CACHE_MAGIC,
+        DISTANCEFIELD_CACHE_VERSION,
+        quint32(data->width),
+        quint32(data->height)
+    };
+    memcpy(contents.data(), header, sizeof(header));
+    if (data->nbytes)
+        memcpy(contents.data() + DISTANCEFIELD_CACHE_HEADER_SIZE, data->data, data->nbytes);
+
+    // another process may be writing the same glyph, so write the file
+    // under another name and move it in place
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(prefix + QString::number(data->glyph));
+    if (!file.open(QIODevice::WriteOnly) || file.write(contents) != contents.size() || !file.commit())
+        qCDebug(lcDistanceField) << "could not write cache file" << file.fileName();
+#else
+    Q_UNUSED(prefix);
+    Q_UNUSED(contents);
+#endif
+}
+
 
 QDistanceField::QDistanceField()
     : d(new QDistanceFieldData)
@@ -903,15 +1039,84 @@ glyph_t QDistanceField::glyph() const
 
 void QDistanceField::setGlyph(const QRawFont &font, glyph_t glyph, bool doubleResolution)
 {
+    *this = fromGlyphs(font, { glyph }, doubleResolution).constFirst();
+}
+
+/*!
+    \internal
+    Returns the distance fields of \a glyphs of \a font, in the same order.
+
+    Making the distance field of a glyph takes long compared to drawing it,
+    so the fields are made on the global thread pool, the calling thread
+    taking its share of them. The glyph outlines are extracted on the
+    calling thread, so the font does not need to be used from other
+    threads. The fields are read from, and written to, the disk cache when
+    it is enabled.
+*/
+QList<QDistanceField> QDistanceField::fromGlyphs(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                                 bool doubleResolution)
+{
+    QList<QDistanceField> fields(glyphs.size());
+    const QString cachePrefix = distanceFieldCachePrefix(font, doubleResolution);
+
     QRawFont renderFont = font;
     renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution) * QT_DISTANCEFIELD_SCALE(doubleResolution));
 
-    QPainterPath path = renderFont.pathForGlyph(glyph);
-    path.translate(-path.boundingRect().topLeft());
-    path.setFillRule(Qt::WindingFill);
+    struct Job {
+        QPainterPath path;
+        QDistanceFieldData *data;
+    };
+    QList<Job> jobs;
+    for (qsizetype i = 0; i < glyphs.size(); ++i) {
+        const glyph_t glyph = glyphs.at(i);
+        if (!cachePrefix.isEmpty()) {
+            if (QDistanceFieldData *data = loadCachedDistanceField(cachePrefix, glyph)) {
+                fields[i] = QDistanceField(data);
+                continue;
+            }
+        }
 
-    d = QDistanceFieldData::create(path, doubleResolution);
-    d->glyph = glyph;
+        QPainterPath path = renderFont.pathForGlyph(glyph);
+        path.translate(-path.boundingRect().topLeft());
+        path.setFillRule(Qt::WindingFill);
+
+        QDistanceFieldData *data = QDistanceFieldData::create(distanceFieldSize(path, doubleResolution));
+        data->glyph = glyph;
+        fields[i] = QDistanceField(data);
+        jobs.append({ std::move(path), data });
+    }
+    if (jobs.isEmpty())
+        return fields;
+
+    // read the settings here, they are not meant to be read concurrently
+    const int dfScale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    const int offs = QT_DISTANCEFIELD_RADIUS(doubleResolution) / dfScale;
+    std::atomic<qsizetype> nextJob = 0;
+    auto work = [&] {
+        for (qsizetype i = nextJob++; i < jobs.size(); i = nextJob++) {
+            const Job &job = jobs.at(i);
+            makeDistanceField(job.data, job.path, dfScale, offs);
+            if (!cachePrefix.isEmpty() && job.data->data)
+                saveCachedDistanceField(cachePrefix, job.data);
+        }
+    };
+
+#if QT_CONFIG(thread)
+    // This thread takes glyphs too, and only helpers that could be started
+    // right away are waited for, so this can't deadlock on a busy pool
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore helpersDone;
+    int helpers = 0;
+    const qsizetype maxHelpers = qMin(qsizetype(QThread::idealThreadCount()), jobs.size()) - 1;
+    while (helpers < maxHelpers && pool->tryStart([&] { work(); helpersDone.release(); }))
+        ++helpers;
+    work();
+    helpersDone.acquire(helpers);
+#else
+    work();
+#endif
+
+    return fields;
 }
 
 void QDistanceField::setGlyph(QFontEngine *fontEngine, glyph_t glyph, bool doubleResolution)
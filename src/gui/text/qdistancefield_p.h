@@ -65,6 +65,9 @@ public:
     void setGlyph(const QRawFont &font, glyph_t glyph, bool doubleResolution = false);
     void setGlyph(QFontEngine *fontEngine, glyph_t glyph, bool doubleResolution = false);
 
+    static QList<QDistanceField> fromGlyphs(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                            bool doubleResolution = false);
+
     int width() const;
     int height() const;
 
@@ -242,6 +242,53 @@ QFixed QFontEngine::averageCharWidth() const
     return bb.xoff;
 }
 
+/*!
+    \internal
+
+    Returns the advances of the glyphs for the 256 Latin-1 characters, or
+    -1 for the characters that the font has no glyph for. The advances are
+    the same as the ones shaping produces as long as latin1ShapingIsTrivial()
+    returns \c true.
+*/
+const QFixed *QFontEngine::latin1Advances() const
+{
+    if (!m_latin1Advances) {
+        QVarLengthGlyphLayoutArray glyphs(256);
+        for (uint ch = 0; ch < 256; ++ch)
+            glyphs.glyphs[ch] = glyphIndex(ch);
+        recalcAdvances(&glyphs, { });
+        m_latin1Advances.reset(new QFixed[256]);
+        for (int i = 0; i < 256; ++i)
+            m_latin1Advances[i] = glyphs.glyphs[i] ? glyphs.advances[i] : QFixed(-1);
+    }
+    return m_latin1Advances.get();
+}
+
+/*!
+    \internal
+
+    Returns \c true if the font has none of the tables with which shaping
+    could substitute or position glyphs, so that the advance of Latin-1
+    text is just the sum of the advances of its characters.
+*/
+bool QFontEngine::latin1ShapingIsTrivial() const
+{
+    if (m_latin1ShapingIsTrivial < 0) {
+        static const uint shapingTables[] = {
+            MAKE_TAG('G', 'S', 'U', 'B'), MAKE_TAG('G', 'P', 'O', 'S'),
+            MAKE_TAG('k', 'e', 'r', 'n'), MAKE_TAG('m', 'o', 'r', 'x'),
+            MAKE_TAG('k', 'e', 'r', 'x'), MAKE_TAG('S', 'i', 'l', 'f')
+        };
+        m_latin1ShapingIsTrivial = 1;
+        for (uint tag : shapingTables) {
+            uint length = 0;
+            if (getSfntTableData(tag, nullptr, &length) && length > 0)
+                m_latin1ShapingIsTrivial = 0;
+        }
+    }
+    return m_latin1ShapingIsTrivial;
+}
+
 bool QFontEngine::supportsTransformation(const QTransform &transform) const
 {
     return transform.type() < QTransform::TxProject;
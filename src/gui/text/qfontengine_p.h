@@ -19,8 +19,10 @@
 #include "QtCore/qatomic.h"
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qhashfunctions.h>
+#include <memory>
 #include "private/qtextengine_p.h"
 #include "private/qfont_p.h"
+#include "private/qtextshapingcache_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -208,6 +210,9 @@ public:
     virtual qreal minLeftBearing() const;
     virtual qreal minRightBearing() const;
 
+    const QFixed *latin1Advances() const;
+    bool latin1ShapingIsTrivial() const;
+
     virtual void getGlyphBearings(glyph_t glyph, qreal *leftBearing = nullptr, qreal *rightBearing = nullptr);
 
     inline bool canRender(uint ucs4) const { return glyphIndex(ucs4) != 0; }
@@ -329,6 +334,8 @@ public:
     GlyphFormat glyphFormat;
     int m_subPixelPositionCount; // Number of positions within a single pixel for this cache
 
+    QTextShapingCache *shapingCache() const { return &m_shapingCache; }
+
 protected:
     explicit QFontEngine(Type type);
 
@@ -359,10 +366,13 @@ private:
     };
     typedef std::list<GlyphCacheEntry> GlyphCaches;
     mutable QHash<const void *, GlyphCaches> m_glyphCaches;
+    mutable QTextShapingCache m_shapingCache;
 
 private:
     mutable qreal m_minLeftBearing;
     mutable qreal m_minRightBearing;
+    mutable std::unique_ptr<QFixed[]> m_latin1Advances;
+    mutable qint8 m_latin1ShapingIsTrivial = -1;
 };
 Q_DECLARE_TYPEINFO(QFontEngine::KernPair, Q_PRIMITIVE_TYPE);
 
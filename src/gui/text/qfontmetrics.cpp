@@ -496,6 +496,43 @@ static constexpr QLatin1Char s_variableLengthStringSeparator('\x9c');
 
     \sa boundingRect()
 */
+// Sums the advances of the characters of text without laying it out, which
+// is only possible for Latin-1 text that shaping would not change. Returns
+// false if text has to be laid out.
+static bool latin1HorizontalAdvance(QFontPrivate *d, QStringView text, QFixed *advance)
+{
+    if (d->capital != QFont::MixedCase || d->letterSpacing != 0 || d->wordSpacing != 0
+            || !d->features.isEmpty()) {
+        return false;
+    }
+    for (QChar ch : text) {
+        const char16_t uc = ch.unicode();
+        // Control characters and the soft hyphen are treated specially
+        if (uc < 0x20 || (uc >= 0x7f && uc < 0xa0) || uc == 0xad || uc > 0xff)
+            return false;
+    }
+
+    QFontEngine *engine = d->engineForScript(QChar::Script_Common);
+    if (engine->type() == QFontEngine::Multi)
+        engine = static_cast<QFontEngineMulti *>(engine)->engine(0);
+    if ((d->request.styleStrategy & QFont::PreferNoShaping) == 0
+            && !engine->latin1ShapingIsTrivial()) {
+        return false;
+    }
+
+    const QFixed *advances = engine->latin1Advances();
+    QFixed sum;
+    for (QChar ch : text) {
+        const QFixed charAdvance = advances[ch.unicode()];
+        // Characters the font has no glyph for come from a fallback font
+        if (charAdvance < 0)
+            return false;
+        sum += charAdvance;
+    }
+    *advance = sum;
+    return true;
+}
+
 int QFontMetrics::horizontalAdvance(const QString &text, int len) const
 {
     int pos = (len >= 0)
@@ -509,6 +546,10 @@ int QFontMetrics::horizontalAdvance(const QString &text, int len) const
     if (len == 0)
         return 0;
 
+    QFixed advance;
+    if (latin1HorizontalAdvance(d.data(), QStringView(text).left(len), &advance))
+        return qRound(advance);
+
     QStackTextEngine layout(text, QFont(d.data()));
     return qRound(layout.width(0, len));
 }
@@ -1423,6 +1464,10 @@ qreal QFontMetricsF::horizontalAdvance(const QString &text, int length) const
     if (length == 0)
         return 0;
 
+    QFixed advance;
+    if (latin1HorizontalAdvance(d.data(), QStringView(text).left(length), &advance))
+        return advance.toReal();
+
     QStackTextEngine layout(text, QFont(d.data()));
     layout.itemize();
     return layout.width(0, length).toReal();
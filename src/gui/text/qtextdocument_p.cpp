@@ -1643,7 +1643,13 @@ void QTextDocumentPrivate::compressPieceTable()
 
     //qDebug() << "unreachable bytes:" << unreachableCharacterCount * sizeof(QChar) << " -- limit" << garbageCollectionThreshold << "text size =" << text.size() << "capacity:" << text.capacity();
 
+    // Compressing copies all the text that is still in use, so wait until
+    // there is at least half as much garbage; otherwise, removing text
+    // bit by bit from a huge document, like trimming a log, would copy the
+    // whole document again and again.
+    const qsizetype reachableCharacterCount = text.size() - unreachableCharacterCount;
     bool compressTable = unreachableCharacterCount * sizeof(QChar) > garbageCollectionThreshold
+                         && unreachableCharacterCount >= reachableCharacterCount / 2
                          && text.size() >= text.capacity() * 0.9;
     if (!compressTable)
         return;
@@ -23,6 +23,7 @@
 #include <qvarlengtharray.h>
 #include <limits.h>
 #include <qbasictimer.h>
+#include <qelapsedtimer.h>
 #include "private/qfunctions_p.h"
 #include <qloggingcategory.h>
 
@@ -3998,8 +3999,19 @@ void QTextDocumentLayoutPrivate::ensureLayoutedByPosition(int position) const
 
 void QTextDocumentLayoutPrivate::layoutStep() const
 {
+    // Size the steps by how long they take rather than by the number of
+    // characters, which may take very different times to lay out, so that
+    // laying out a large document in the background does not make the
+    // event loop stall.
+    constexpr qint64 stepDurationMs = 16;
+    QElapsedTimer stepTimer;
+    stepTimer.start();
     ensureLayoutedByPosition(currentLazyLayoutPosition + lazyLayoutStepSize);
-    lazyLayoutStepSize = qMin(200000, lazyLayoutStepSize * 2);
+    const qint64 elapsed = stepTimer.elapsed();
+    if (elapsed < stepDurationMs / 2)
+        lazyLayoutStepSize = qMin(200000, lazyLayoutStepSize * 2);
+    else if (elapsed > stepDurationMs)
+        lazyLayoutStepSize = qMax(1000, lazyLayoutStepSize / 2);
 }
 
 void QTextDocumentLayout::setCursorWidth(int width)
@@ -1437,6 +1437,43 @@ void QTextEngine::shapeText(int item) const
             letterSpacing *= font.d->dpi / qt_defaultDpiY();
     }
 
+    QTextShapingCache::Key cacheKey;
+    const bool useShapingCache = itemLength <= QTextShapingCache::MaximumTextLength;
+    if (useShapingCache) {
+        cacheKey.text = QString::fromRawData(reinterpret_cast<const QChar *>(string), itemLength);
+        cacheKey.features = features;
+        cacheKey.letterSpacing = letterSpacing;
+        cacheKey.wordSpacing = wordSpacing;
+        cacheKey.script = si.analysis.script;
+        cacheKey.bidiLevel = si.analysis.bidiLevel;
+        cacheKey.flags = si.analysis.flags;
+        cacheKey.kerning = kerningEnabled;
+        cacheKey.letterSpacingIsAbsolute = letterSpacingIsAbsolute;
+        cacheKey.designMetrics = option.useDesignMetrics();
+        cacheKey.shaping = shapingEnabled;
+
+        QTextShapingCache::Entry cached;
+        if (fontEngine->shapingCache()->find(cacheKey, &cached)) {
+            if (Q_UNLIKELY(!ensureSpace(cached.numGlyphs)))
+                Q_UNREACHABLE_RETURN();
+            si.num_glyphs = cached.numGlyphs;
+            si.width = cached.width;
+            si.ascent = cached.ascent;
+            si.descent = cached.descent;
+            si.leading = cached.leading;
+            const QGlyphLayout source(const_cast<char *>(cached.glyphs.constData()), cached.numGlyphs);
+            QGlyphLayout glyphs = shapedGlyphs(&si);
+            memcpy(static_cast<void *>(glyphs.offsets), source.offsets, si.num_glyphs * sizeof(QFixedPoint));
+            memcpy(glyphs.glyphs, source.glyphs, si.num_glyphs * sizeof(glyph_t));
+            memcpy(static_cast<void *>(glyphs.advances), source.advances, si.num_glyphs * sizeof(QFixed));
+            memcpy(static_cast<void *>(glyphs.justifications), source.justifications, si.num_glyphs * sizeof(QGlyphJustification));
+            memcpy(glyphs.attributes, source.attributes, si.num_glyphs * sizeof(QGlyphAttributes));
+            memcpy(logClusters(&si), cached.logClusters.constData(), itemLength * sizeof(ushort));
+            layoutData->used += si.num_glyphs;
+            return;
+        }
+    }
+
     // split up the item into parts that come from different font engines
     // k * 3 entries, array[k] == index in string, array[k + 1] == index in glyphs, array[k + 2] == engine index
     QList<uint> itemBoundaries;
@@ -1588,6 +1625,27 @@ void QTextEngine::shapeText(int item) const
 
     for (int i = 0; i < si.num_glyphs; ++i)
         si.width += glyphs.advances[i] * !glyphs.attributes[i].dontPrint;
+
+    if (useShapingCache) {
+        QTextShapingCache::Entry entry;
+        entry.numGlyphs = si.num_glyphs;
+        entry.width = si.width;
+        entry.ascent = si.ascent;
+        entry.descent = si.descent;
+        entry.leading = si.leading;
+        entry.glyphs.resize(si.num_glyphs * QGlyphLayout::SpaceNeeded);
+        QGlyphLayout target(entry.glyphs.data(), si.num_glyphs);
+        memcpy(static_cast<void *>(target.offsets), glyphs.offsets, si.num_glyphs * sizeof(QFixedPoint));
+        memcpy(target.glyphs, glyphs.glyphs, si.num_glyphs * sizeof(glyph_t));
+        memcpy(static_cast<void *>(target.advances), glyphs.advances, si.num_glyphs * sizeof(QFixed));
+        memcpy(static_cast<void *>(target.justifications), glyphs.justifications, si.num_glyphs * sizeof(QGlyphJustification));
+        memcpy(target.attributes, glyphs.attributes, si.num_glyphs * sizeof(QGlyphAttributes));
+        const ushort *clusters = logClusters(&si);
+        entry.logClusters.assign(clusters, clusters + itemLength);
+        // The key must not refer to the layout's string
+        cacheKey.text = QString(cacheKey.text.constData(), cacheKey.text.size());
+        fontEngine->shapingCache()->insert(cacheKey, entry);
+    }
 }
 
 #if QT_CONFIG(harfbuzz)
@@ -0,0 +1,51 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtextshapingcache_p.h"
+
+QT_BEGIN_NAMESPACE
+
+// The cost of an entry is its size in bytes
+static constexpr qsizetype shapingCacheLimit = 256 * 1024;
+
+size_t qHash(const QTextShapingCache::Key &key, size_t seed) noexcept
+{
+    // The features are in no particular order, so combine them commutatively
+    size_t features = 0;
+    for (auto it = key.features.cbegin(), end = key.features.cend(); it != end; ++it)
+        features += qHashMulti(0, it.key(), it.value());
+    return qHashMulti(seed, key.text, key.letterSpacing.value(), key.wordSpacing.value(),
+                      key.script, key.bidiLevel, key.flags, key.kerning,
+                      key.letterSpacingIsAbsolute, key.designMetrics, key.shaping, features);
+}
+
+QTextShapingCache::QTextShapingCache()
+    : cache(shapingCacheLimit)
+{
+}
+
+bool QTextShapingCache::find(const Key &key, Entry *entry) const
+{
+    QMutexLocker locker(&mutex);
+    const Entry *cached = cache.object(key);
+    if (!cached)
+        return false;
+    *entry = *cached;
+    return true;
+}
+
+void QTextShapingCache::insert(const Key &key, const Entry &entry)
+{
+    const qsizetype cost = key.text.size() * sizeof(QChar) + entry.glyphs.size()
+            + entry.logClusters.size() * sizeof(ushort) + qsizetype(sizeof(Key) + sizeof(Entry));
+    QMutexLocker locker(&mutex);
+    cache.insert(key, new Entry(entry), cost);
+}
+
+void QTextShapingCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    cache.clear();
+}
+
+QT_END_NAMESPACE
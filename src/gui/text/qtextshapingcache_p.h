@@ -0,0 +1,91 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTEXTSHAPINGCACHE_P_H
+#define QTEXTSHAPINGCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/private/qfixed_p.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+// Results of QTextEngine::shapeText() for short items, kept by the font
+// engine they were shaped with, so that strings that are laid out again
+// and again, such as the cells of item views, are shaped only once. The
+// least recently used results are dropped when the cache is full.
+class Q_GUI_EXPORT QTextShapingCache
+{
+public:
+    struct Key
+    {
+        QString text; // after case mapping
+        QHash<quint32, quint32> features;
+        QFixed letterSpacing;
+        QFixed wordSpacing;
+        ushort script = 0;
+        ushort bidiLevel = 0;
+        ushort flags = 0;
+        bool kerning = false;
+        bool letterSpacingIsAbsolute = false;
+        bool designMetrics = false;
+        bool shaping = false;
+
+        friend bool operator==(const Key &lhs, const Key &rhs) noexcept
+        {
+            return lhs.text == rhs.text && lhs.letterSpacing == rhs.letterSpacing
+                    && lhs.wordSpacing == rhs.wordSpacing && lhs.script == rhs.script
+                    && lhs.bidiLevel == rhs.bidiLevel && lhs.flags == rhs.flags
+                    && lhs.kerning == rhs.kerning
+                    && lhs.letterSpacingIsAbsolute == rhs.letterSpacingIsAbsolute
+                    && lhs.designMetrics == rhs.designMetrics && lhs.shaping == rhs.shaping
+                    && lhs.features == rhs.features;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept;
+    };
+
+    struct Entry
+    {
+        QByteArray glyphs; // numGlyphs glyphs, laid out as by QGlyphLayout(char *, int)
+        QList<ushort> logClusters;
+        QFixed width;
+        QFixed ascent;
+        QFixed descent;
+        QFixed leading;
+        int numGlyphs = 0;
+    };
+
+    // Longer items are rarely repeated verbatim
+    static constexpr qsizetype MaximumTextLength = 256;
+
+    QTextShapingCache();
+
+    bool find(const Key &key, Entry *entry) const;
+    void insert(const Key &key, const Entry &entry);
+    void clear();
+
+private:
+    Q_DISABLE_COPY_MOVE(QTextShapingCache)
+
+    mutable QMutex mutex;
+    mutable QCache<Key, Entry> cache;
+};
+
+QT_END_NAMESPACE
+
+#endif // QTEXTSHAPINGCACHE_P_H
@@ -7,8 +7,16 @@
 #include <QtGui/private/qfontengine_ft_p.h>
 
 #include <QtCore/QList>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QSysInfo>
 
 #include <qpa/qplatformnativeinterface.h>
 #include <qpa/qplatformscreen.h>
@@ -29,6 +37,8 @@
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 static inline int mapToQtWeightForRange(int fcweight, int fcLower, int fcUpper, int qtLower, int qtUpper)
 {
     return qtLower + ((fcweight - fcLower) * (qtUpper - qtLower)) / (fcUpper - fcLower);
@@ -366,7 +376,78 @@ static inline bool requiresOpenType(int writingSystem)
             || writingSystem == QFontDatabase::Khmer || writingSystem == QFontDatabase::Nko);
 }
 
-static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::ApplicationFont *applicationFont = nullptr)
+namespace {
+// One call made by populateFromPattern() to register a font, or an alias
+// if aliasedFamilyName is set, as stored in the font database snapshot.
+struct FontRegistration
+{
+    QString familyName;
+    QString styleName;
+    QString foundryName;
+    QString fileName;
+    QString aliasedFamilyName;
+    double pixelSize = 0;
+    quint64 writingSystems = 0;
+    qint32 indexValue = 0;
+    qint32 weight = QFont::Normal;
+    qint32 style = QFont::StyleNormal;
+    qint32 stretch = QFont::Unstretched;
+    bool antialiased = true;
+    bool scalable = true;
+    bool fixedPitch = false;
+};
+
+QDataStream &operator<<(QDataStream &out, const FontRegistration &r)
+{
+    return out << r.familyName << r.styleName << r.foundryName << r.fileName
+               << r.aliasedFamilyName << r.pixelSize << r.writingSystems << r.indexValue
+               << r.weight << r.style << r.stretch << r.antialiased << r.scalable
+               << r.fixedPitch;
+}
+
+QDataStream &operator>>(QDataStream &in, FontRegistration &r)
+{
+    return in >> r.familyName >> r.styleName >> r.foundryName >> r.fileName
+              >> r.aliasedFamilyName >> r.pixelSize >> r.writingSystems >> r.indexValue
+              >> r.weight >> r.style >> r.stretch >> r.antialiased >> r.scalable
+              >> r.fixedPitch;
+}
+} // unnamed namespace
+
+static_assert(QFontDatabase::WritingSystemsCount <= 64);
+
+static quint64 writingSystemsMask(const QSupportedWritingSystems &writingSystems)
+{
+    quint64 mask = 0;
+    for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+        if (writingSystems.supported(QFontDatabase::WritingSystem(i)))
+            mask |= quint64(1) << i;
+    }
+    return mask;
+}
+
+static void registerFromSnapshot(const FontRegistration &r)
+{
+    if (!r.aliasedFamilyName.isEmpty()) {
+        QPlatformFontDatabase::registerAliasToFontFamily(r.aliasedFamilyName, r.familyName);
+        return;
+    }
+    QSupportedWritingSystems writingSystems;
+    for (int i = 0; i < QFontDatabase::WritingSystemsCount; ++i) {
+        if (r.writingSystems & (quint64(1) << i))
+            writingSystems.setSupported(QFontDatabase::WritingSystem(i));
+    }
+    FontFile *fontFile = new FontFile;
+    fontFile->fileName = r.fileName;
+    fontFile->indexValue = r.indexValue;
+    QPlatformFontDatabase::registerFont(r.familyName, r.styleName, r.foundryName,
+                                        QFont::Weight(r.weight), QFont::Style(r.style),
+                                        QFont::Stretch(r.stretch), r.antialiased, r.scalable,
+                                        int(r.pixelSize), r.fixedPitch, writingSystems, fontFile);
+}
+
+static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::ApplicationFont *applicationFont = nullptr,
+                                QList<FontRegistration> *registrations = nullptr)
 {
     QString familyName;
     QString familyNameLang;
@@ -491,6 +572,24 @@ static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::Applic
     QPlatformFontDatabase::registerFont(familyName,styleName,QLatin1StringView((const char *)foundry_value),weight,style,stretch,antialias,scalable,pixel_size,fixedPitch,writingSystems,fontFile);
 //        qDebug() << familyName << (const char *)foundry_value << weight << style << &writingSystems << scalable << true << pixel_size;
 
+    FontRegistration registration;
+    if (registrations) {
+        registration.familyName = familyName;
+        registration.styleName = styleName;
+        registration.foundryName = QLatin1StringView((const char *)foundry_value);
+        registration.fileName = fontFile->fileName;
+        registration.pixelSize = pixel_size;
+        registration.writingSystems = writingSystemsMask(writingSystems);
+        registration.indexValue = indexValue;
+        registration.weight = weight;
+        registration.style = style;
+        registration.stretch = stretch;
+        registration.antialiased = antialias;
+        registration.scalable = scalable;
+        registration.fixedPitch = fixedPitch;
+        registrations->append(registration);
+    }
+
     for (int k = 1; FcPatternGetString(pattern, FC_FAMILY, k, &value) == FcResultMatch; ++k) {
         const QString altFamilyName = QString::fromUtf8((const char *)value);
         // Extra family names can be aliases or subfamilies.
@@ -521,13 +620,108 @@ static void populateFromPattern(FcPattern *pattern, QFontDatabasePrivate::Applic
             }
             FontFile *altFontFile = new FontFile(*fontFile);
             QPlatformFontDatabase::registerFont(altFamilyName, altStyleName, QLatin1StringView((const char *)foundry_value),weight,style,stretch,antialias,scalable,pixel_size,fixedPitch,writingSystems,altFontFile);
+            if (registrations) {
+                FontRegistration altRegistration = registration;
+                altRegistration.familyName = altFamilyName;
+                altRegistration.styleName = altStyleName;
+                registrations->append(altRegistration);
+            }
         } else {
             QPlatformFontDatabase::registerAliasToFontFamily(familyName, altFamilyName);
+            if (registrations) {
+                FontRegistration alias;
+                alias.familyName = altFamilyName;
+                alias.aliasedFamilyName = familyName;
+                registrations->append(alias);
+            }
         }
     }
 
 }
 
+// The snapshot of the registrations made by populateFontDatabase() is
+// only used while nothing fontconfig enumerates may have changed: the
+// fingerprint covers the fontconfig version, its configuration files and
+// the modification times of all font directories, which change whenever a
+// font is added to or removed from them.
+static constexpr quint32 SnapshotMagic = 0x51464344; // "QFCD"
+static constexpr quint32 SnapshotVersion = 1;
+
+static QString fontDatabaseSnapshotPath()
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheDir.isEmpty())
+        return QString();
+    return cacheDir + "/qtfontdatabase/fontconfig-"_L1 + QString::number(QSysInfo::WordSize);
+}
+
+static void addStringsToFingerprint(QCryptographicHash *hash, FcStrList *list)
+{
+    if (!list)
+        return;
+    while (const FcChar8 *path = FcStrListNext(list)) {
+        const QString fileName = QFile::decodeName(reinterpret_cast<const char *>(path));
+        const QFileInfo info(fileName);
+        hash->addData(QByteArrayView(reinterpret_cast<const char *>(path)));
+        const qint64 modified = info.exists()
+                ? info.lastModified().toMSecsSinceEpoch() : -1;
+        hash->addData(QByteArrayView(reinterpret_cast<const char *>(&modified), sizeof(modified)));
+    }
+    FcStrListDone(list);
+}
+
+static QByteArray fontDatabaseFingerprint()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    const int versions[] = { FcGetVersion(), QT_VERSION, int(SnapshotVersion) };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(versions), sizeof(versions)));
+    addStringsToFingerprint(&hash, FcConfigGetConfigFiles(nullptr));
+    addStringsToFingerprint(&hash, FcConfigGetFontDirs(nullptr));
+    return hash.result();
+}
+
+static bool readFontDatabaseSnapshot(const QString &path, const QByteArray &fingerprint,
+                                     QList<FontRegistration> *registrations)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const uchar *mapped = file.map(0, file.size());
+    const QByteArray contents = mapped
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size())
+            : file.readAll();
+
+    QDataStream in(contents);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray storedFingerprint;
+    in >> magic >> version;
+    if (magic != SnapshotMagic || version != SnapshotVersion)
+        return false;
+    in >> storedFingerprint;
+    if (storedFingerprint != fingerprint)
+        return false;
+    in >> *registrations;
+    // The strings are deep copies, so the mapping can go away
+    return in.status() == QDataStream::Ok;
+}
+
+static void writeFontDatabaseSnapshot(const QString &path, const QByteArray &fingerprint,
+                                      const QList<FontRegistration> &registrations)
+{
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << SnapshotMagic << SnapshotVersion << fingerprint << registrations;
+    if (out.status() == QDataStream::Ok)
+        file.commit();
+}
+
 QFontconfigDatabase::~QFontconfigDatabase()
 {
     FcConfigDestroy(FcConfigGetCurrent());
@@ -536,6 +730,25 @@ QFontconfigDatabase::~QFontconfigDatabase()
 void QFontconfigDatabase::populateFontDatabase()
 {
     FcInit();
+
+    // Listing the fonts and matching their languages against all writing
+    // systems is the bulk of the start-up cost, so it can be skipped by
+    // replaying a snapshot of the result.
+    const QString snapshotPath = qEnvironmentVariableIntValue("QT_FONTDATABASE_SNAPSHOT") > 0
+            ? fontDatabaseSnapshotPath() : QString();
+    QByteArray fingerprint;
+    QList<FontRegistration> registrations;
+    if (!snapshotPath.isEmpty()) {
+        fingerprint = fontDatabaseFingerprint();
+        if (readFontDatabaseSnapshot(snapshotPath, fingerprint, &registrations)) {
+            for (const FontRegistration &registration : std::as_const(registrations))
+                registerFromSnapshot(registration);
+            registerDefaultFonts();
+            return;
+        }
+        registrations.clear();
+    }
+
     FcFontSet  *fonts;
 
     {
@@ -564,10 +777,18 @@ void QFontconfigDatabase::populateFontDatabase()
     }
 
     for (int i = 0; i < fonts->nfont; i++)
-        populateFromPattern(fonts->fonts[i]);
+        populateFromPattern(fonts->fonts[i], nullptr, snapshotPath.isEmpty() ? nullptr : &registrations);
 
     FcFontSetDestroy (fonts);
 
+    if (!snapshotPath.isEmpty())
+        writeFontDatabaseSnapshot(snapshotPath, fingerprint, registrations);
+
+    registerDefaultFonts();
+}
+
+void QFontconfigDatabase::registerDefaultFonts()
+{
     struct FcDefaultFont {
         const char *qtname;
         const char *rawname;
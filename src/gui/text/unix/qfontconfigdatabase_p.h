@@ -37,6 +37,7 @@ public:
     QFont defaultFont() const override;
 
 private:
+    void registerDefaultFonts();
     void setupFontEngine(QFontEngineFT *engine, const QFontDef &fontDef) const;
 };
 
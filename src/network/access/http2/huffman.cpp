@@ -459,15 +459,36 @@ HuffmanDecoder::HuffmanDecoder()
 
 bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
 {
+    const quint64 streamEnd = inputStream.bitLength();
+    quint64 offset = inputStream.streamOffset();
+    // No code is shorter than minCodeLength bits:
+    outputBuffer.reserve(outputBuffer.size() + qsizetype((streamEnd - offset) / minCodeLength));
+
+    // A code is looked up in the 32 bits that follow 'offset'. We peek
+    // 64 bits at a time, so that most codes do not need a read of their own,
+    // and only move the stream's offset when we are done.
+    quint64 window = 0;
+    quint64 windowOffset = 0;
+    quint64 windowLength = 0;
+    const auto finish = [&inputStream, &offset](bool result) {
+        inputStream.skipBits(offset - inputStream.streamOffset());
+        return result;
+    };
+
     while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
+        if (offset >= streamEnd)
+            return finish(true);
+
+        const quint32 readBits = quint32(std::min<quint64>(32, streamEnd - offset));
+        if (offset + readBits > windowOffset + windowLength) {
+            windowLength = inputStream.peekBits(offset, 64, &window);
+            windowOffset = offset;
+        }
+        const quint32 chunk = quint32((window << (offset - windowOffset)) >> 32);
 
         if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            offset += readBits;
+            return finish(padding_is_valid(chunk, readBits));
         }
 
         quint32 tableIndex = 0;
@@ -486,18 +507,18 @@ bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuf
         }
 
         if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+            offset += readBits;
+            return finish(padding_is_valid(chunk, readBits));
         }
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+            offset += readBits;
+            return finish(false);
         }
 
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
+        outputBuffer.append(char(entry.byteValue));
+        offset += entry.bitLength;
     }
 
     return false;
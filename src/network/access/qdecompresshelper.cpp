@@ -6,6 +6,8 @@
 #include <QtCore/private/qbytearray_p.h>
 #include <QtCore/qiodevice.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <limits>
 #include <zlib.h>
@@ -66,6 +68,74 @@ ZSTD_DStream *toZstandardPointer(void *ptr)
     return static_cast<ZSTD_DStream *>(ptr);
 }
 #endif
+
+// Decoders of finished replies, reset and kept for the next ones: a reply
+// that is small, or HTTP/2 and HTTP/3 traffic with many of them, would
+// otherwise spend a good part of its decompression time allocating the
+// decoder state and its window. Brotli offers no way to reset a decoder,
+// so its decoders are not kept.
+class DecoderPool
+{
+public:
+    ~DecoderPool()
+    {
+        for (z_stream *stream : std::as_const(zlibStreams)) {
+            inflateEnd(stream);
+            delete stream;
+        }
+#if QT_CONFIG(zstd)
+        for (ZSTD_DStream *stream : std::as_const(zstdStreams))
+            ZSTD_freeDStream(stream);
+#endif
+    }
+
+    z_stream *takeZlibStream()
+    {
+        QMutexLocker locker(&mutex);
+        return zlibStreams.isEmpty() ? nullptr : zlibStreams.takeLast();
+    }
+
+    bool recycle(z_stream *stream)
+    {
+        if (inflateReset(stream) != Z_OK)
+            return false;
+        QMutexLocker locker(&mutex);
+        if (zlibStreams.size() >= MaxPooledDecoders)
+            return false;
+        zlibStreams.append(stream);
+        return true;
+    }
+
+#if QT_CONFIG(zstd)
+    ZSTD_DStream *takeZstdStream()
+    {
+        QMutexLocker locker(&mutex);
+        return zstdStreams.isEmpty() ? nullptr : zstdStreams.takeLast();
+    }
+
+    bool recycle(ZSTD_DStream *stream)
+    {
+        if (ZSTD_isError(ZSTD_DCtx_reset(stream, ZSTD_reset_session_only)))
+            return false;
+        QMutexLocker locker(&mutex);
+        if (zstdStreams.size() >= MaxPooledDecoders)
+            return false;
+        zstdStreams.append(stream);
+        return true;
+    }
+#endif
+
+private:
+    static constexpr qsizetype MaxPooledDecoders = 8;
+
+    QMutex mutex;
+    QVarLengthArray<z_stream *, MaxPooledDecoders> zlibStreams;
+#if QT_CONFIG(zstd)
+    QVarLengthArray<ZSTD_DStream *, MaxPooledDecoders> zstdStreams;
+#endif
+};
+
+Q_GLOBAL_STATIC(DecoderPool, decoderPool)
 }
 
 bool QDecompressHelper::isSupportedEncoding(const QByteArray &encoding)
@@ -119,14 +189,20 @@ bool QDecompressHelper::setEncoding(ContentEncoding ce)
         break;
     case Deflate:
     case GZip: {
-        z_stream *inflateStream = new z_stream;
-        memset(inflateStream, 0, sizeof(z_stream));
-        // "windowBits can also be greater than 15 for optional gzip decoding.
-        // Add 32 to windowBits to enable zlib and gzip decoding with automatic header detection"
-        // http://www.zlib.net/manual.html
-        if (inflateInit2(inflateStream, MAX_WBITS + 32) != Z_OK) {
-            delete inflateStream;
-            inflateStream = nullptr;
+        // Both are decoded the same way, so they share pooled decoders
+        z_stream *inflateStream = nullptr;
+        if (DecoderPool *pool = decoderPool())
+            inflateStream = pool->takeZlibStream();
+        if (!inflateStream) {
+            inflateStream = new z_stream;
+            memset(inflateStream, 0, sizeof(z_stream));
+            // "windowBits can also be greater than 15 for optional gzip decoding.
+            // Add 32 to windowBits to enable zlib and gzip decoding with automatic header detection"
+            // http://www.zlib.net/manual.html
+            if (inflateInit2(inflateStream, MAX_WBITS + 32) != Z_OK) {
+                delete inflateStream;
+                inflateStream = nullptr;
+            }
         }
         decoderPointer = inflateStream;
         break;
@@ -140,7 +216,10 @@ bool QDecompressHelper::setEncoding(ContentEncoding ce)
         break;
     case Zstandard:
 #if QT_CONFIG(zstd)
-        decoderPointer = ZSTD_createDStream();
+        if (DecoderPool *pool = decoderPool())
+            decoderPointer = pool->takeZstdStream();
+        if (!decoderPointer)
+            decoderPointer = ZSTD_createDStream();
 #else
         Q_UNREACHABLE();
 #endif
@@ -522,9 +601,11 @@ void QDecompressHelper::clear()
     case Deflate:
     case GZip: {
         z_stream *inflateStream = toZlibPointer(decoderPointer);
-        if (inflateStream)
+        DecoderPool *pool = decoderPool();
+        if (inflateStream && !(pool && pool->recycle(inflateStream))) {
             inflateEnd(inflateStream);
-        delete inflateStream;
+            delete inflateStream;
+        }
         break;
     }
     case Brotli: {
@@ -538,7 +619,8 @@ void QDecompressHelper::clear()
     case Zstandard: {
 #if QT_CONFIG(zstd)
         ZSTD_DStream *zstdStream = toZstandardPointer(decoderPointer);
-        if (zstdStream)
+        DecoderPool *pool = decoderPool();
+        if (zstdStream && !(pool && pool->recycle(zstdStream)))
             ZSTD_freeDStream(zstdStream);
 #endif
         break;
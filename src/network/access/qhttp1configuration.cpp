@@ -84,6 +84,10 @@ QHttp1Configuration::~QHttp1Configuration()
 
     If \a number is ≤ 0, does nothing. If \a number is > 255, 255 is used.
 
+    The number of connections of a host is fixed when the first request to it
+    is made. Requests to the same host that ask for a different number of
+    connections are served by a separate set of connections.
+
     \sa numberOfConnectionsPerHost
 */
 void QHttp1Configuration::setNumberOfConnectionsPerHost(qsizetype number)
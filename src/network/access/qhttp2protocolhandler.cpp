@@ -488,14 +488,22 @@ bool QHttp2ProtocolHandler::sendDATA(Stream &stream)
     const auto replyPrivate = reply->d_func();
     Q_ASSERT(replyPrivate);
 
+    // -1 when the size is not known in advance: then the data is sent until
+    // the upload device ends
+    const qint64 contentLength = request.contentLength();
+    bool atEnd = false;
     auto slot = std::min<qint32>(sessionSendWindowSize, stream.sendWindow);
-    while (replyPrivate->totallyUploadedData < request.contentLength() && slot) {
+    while ((contentLength == -1 || replyPrivate->totallyUploadedData < contentLength) && slot) {
         qint64 chunkSize = 0;
         const uchar *src =
             reinterpret_cast<const uchar *>(stream.data()->readPointer(slot, chunkSize));
 
-        if (chunkSize == -1)
-            return false;
+        if (chunkSize == -1) {
+            if (contentLength != -1)
+                return false;
+            atEnd = true;
+            break;
+        }
 
         if (!src || !chunkSize) {
             // Stream is not suspended by the flow control,
@@ -513,12 +521,11 @@ bool QHttp2ProtocolHandler::sendDATA(Stream &stream)
         stream.sendWindow -= bytesWritten;
         sessionSendWindowSize -= bytesWritten;
         replyPrivate->totallyUploadedData += bytesWritten;
-        emit reply->dataSendProgress(replyPrivate->totallyUploadedData,
-                                     request.contentLength());
+        emit reply->dataSendProgress(replyPrivate->totallyUploadedData, contentLength);
         slot = std::min(sessionSendWindowSize, stream.sendWindow);
     }
 
-    if (replyPrivate->totallyUploadedData == request.contentLength()) {
+    if (atEnd || replyPrivate->totallyUploadedData == contentLength) {
         frameWriter.start(FrameType::DATA, FrameFlag::END_STREAM, stream.streamID);
         frameWriter.setPayloadSize(0);
         frameWriter.write(*m_socket);
@@ -4,6 +4,7 @@
 #include "qhttpheaderparser_p.h"
 
 #include <algorithm>
+#include <array>
 
 QT_BEGIN_NAMESPACE
 
@@ -25,11 +26,21 @@ void QHttpHeaderParser::clear()
 
 static bool fieldNameCheck(QByteArrayView name)
 {
+    // Every byte of every field name is checked, so look them up in a table
     static constexpr QByteArrayView otherCharacters("!#$%&'*+-.^_`|~");
-    static const auto fieldNameChar = [](char c) {
-        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9')
-                || otherCharacters.contains(c);
-    };
+    static constexpr auto fieldNameChars = [] {
+        std::array<bool, 256> table = {};
+        for (char c = 'a'; c <= 'z'; ++c)
+            table[uchar(c)] = true;
+        for (char c = 'A'; c <= 'Z'; ++c)
+            table[uchar(c)] = true;
+        for (char c = '0'; c <= '9'; ++c)
+            table[uchar(c)] = true;
+        for (char c : otherCharacters)
+            table[uchar(c)] = true;
+        return table;
+    }();
+    const auto fieldNameChar = [](char c) { return fieldNameChars[uchar(c)]; };
 
     return !name.empty() && std::all_of(name.begin(), name.end(), fieldNameChar);
 }
@@ -53,6 +64,8 @@ bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
         return false;
 
     QList<QPair<QByteArray, QByteArray>> result;
+    // there is at most a field per line
+    result.reserve(qMin(header.count('\n'), maxFieldCount));
     while (!header.empty()) {
         const qsizetype colon = header.indexOf(':');
         if (colon == -1) // if no colon check if empty headers
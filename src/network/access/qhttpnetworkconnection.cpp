@@ -248,8 +248,11 @@ void QHttpNetworkConnectionPrivate::prepareRequest(HttpMessagePair &messagePair)
             request.setContentLength(uploadDeviceSize);
         } else if (contentLength != -1 && uploadDeviceSize == -1) {
             // everything OK, the user supplied us the contentLength
-        } else if (Q_UNLIKELY(contentLength == -1 && uploadDeviceSize == -1)) {
-            qFatal("QHttpNetworkConnectionPrivate: Neither content-length nor upload device size were given");
+        } else if (contentLength == -1 && uploadDeviceSize == -1) {
+            // the size is not known in advance: the body is streamed in chunks
+            // (HTTP/2 drops this header, it has no use for it)
+            if (request.headerField("transfer-encoding").isEmpty())
+                request.setHeaderField("Transfer-Encoding", "chunked");
         }
     }
 #endif
@@ -16,6 +16,10 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+// How many bytes readHeader() and getChunkSize() look at at once; they
+// search them for the end of what they read, and only consume up to it
+static constexpr qsizetype PeekSize = 4096;
+
 QHttpNetworkReply::QHttpNetworkReply(const QUrl &url, QObject *parent)
     : QObject(*new QHttpNetworkReplyPrivate(url), parent)
 {
@@ -458,36 +462,39 @@ qint64 QHttpNetworkReplyPrivate::readHeader(QAbstractSocket *socket)
     }
 
     qint64 bytes = 0;
-    char c = 0;
     bool allHeaders = false;
-    qint64 haveRead = 0;
-    do {
-        haveRead = socket->read(&c, 1);
-        if (haveRead == 0) {
-            // read more later
-            break;
-        } else if (haveRead == -1) {
-            // connection broke down
-            return -1;
-        } else {
-            fragment.append(c);
-            bytes++;
-
-            if (c == '\n') {
-                // check for possible header endings. As per HTTP rfc,
-                // the header endings will be marked by CRLFCRLF. But
-                // we will allow CRLFCRLF, CRLFLF, LFCRLF, LFLF
-                if (fragment.endsWith("\n\r\n")
-                    || fragment.endsWith("\n\n"))
-                    allHeaders = true;
-
-                // there is another case: We have no headers. Then the fragment equals just the line ending
-                if ((fragment.size() == 2 && fragment.endsWith("\r\n"))
-                    || (fragment.size() == 1 && fragment.endsWith("\n")))
-                    allHeaders = true;
+    while (!allHeaders) {
+        // Look at what is available without consuming it, find the end of
+        // the headers, and only take the bytes up to it out of the socket
+        const qsizetype oldSize = fragment.size();
+        fragment.resize(oldSize + PeekSize);
+        const qint64 peeked = socket->peek(fragment.data() + oldSize, PeekSize);
+        if (peeked <= 0) {
+            fragment.truncate(oldSize);
+            if (peeked < 0) // connection broke down
+                return -1;
+            break; // read more later
+        }
+        fragment.truncate(oldSize + peeked);
+
+        qsizetype end = fragment.size();
+        for (qsizetype i = fragment.indexOf('\n', oldSize); i != -1; i = fragment.indexOf('\n', i + 1)) {
+            const QByteArrayView head = QByteArrayView(fragment).first(i + 1);
+            // check for possible header endings. As per HTTP rfc,
+            // the header endings will be marked by CRLFCRLF. But
+            // we will allow CRLFCRLF, CRLFLF, LFCRLF, LFLF
+            // there is another case: We have no headers. Then the fragment equals just the line ending
+            if (head.endsWith("\n\r\n") || head.endsWith("\n\n") || head == "\r\n" || head == "\n") {
+                allHeaders = true;
+                end = i + 1;
+                break;
             }
         }
-    } while (!allHeaders && haveRead > 0);
+        fragment.truncate(end);
+        if (socket->skip(end - oldSize) != end - oldSize)
+            return -1;
+        bytes += end - oldSize;
+    }
 
     // we received all headers now parse them
     if (allHeaders) {
@@ -699,37 +706,41 @@ qint64 QHttpNetworkReplyPrivate::readReplyBodyChunked(QAbstractSocket *socket, Q
 qint64 QHttpNetworkReplyPrivate::getChunkSize(QAbstractSocket *socket, qint64 *chunkSize)
 {
     qint64 bytes = 0;
-    char crlf[2];
     *chunkSize = -1;
 
-    int bytesAvailable = socket->bytesAvailable();
-    // FIXME rewrite to permanent loop without bytesAvailable
-    while (bytesAvailable > bytes) {
-        qint64 sniffedBytes = socket->peek(crlf, 2);
-        int fragmentSize = fragment.size();
-
-        // check the next two bytes for a "\r\n", skip blank lines
-        if ((fragmentSize && sniffedBytes == 2 && crlf[0] == '\r' && crlf[1] == '\n')
-           ||(fragmentSize > 1 && fragment.endsWith('\r')  && crlf[0] == '\n'))
-        {
-            bytes += socket->read(crlf, 1);     // read the \r or \n
-            if (crlf[0] == '\r')
-                bytes += socket->read(crlf, 1); // read the \n
-            bool ok = false;
+    while (*chunkSize == -1) {
+        const qsizetype oldSize = fragment.size();
+        fragment.resize(oldSize + PeekSize);
+        const qint64 peeked = socket->peek(fragment.data() + oldSize, PeekSize);
+        if (peeked <= 0) {
+            fragment.truncate(oldSize);
+            return peeked < 0 ? -1 : bytes; // FIXME
+        }
+        fragment.truncate(oldSize + peeked);
+
+        // the size ends with the first "\r\n" that follows something,
+        // blank lines before it are skipped
+        qsizetype end = fragment.size();
+        bool found = false;
+        for (qsizetype i = fragment.indexOf('\n', qMax(oldSize, qsizetype(2))); i != -1;
+             i = fragment.indexOf('\n', i + 1)) {
+            if (fragment.at(i - 1) == '\r') {
+                end = i + 1;
+                found = true;
+                break;
+            }
+        }
+        if (socket->skip(end - oldSize) != end - oldSize)
+            return -1;
+        bytes += end - oldSize;
+
+        if (found) {
+            QByteArrayView size = QByteArrayView(fragment).first(end - 2);
             // ignore the chunk-extension
-            fragment = fragment.mid(0, fragment.indexOf(';')).trimmed();
-            *chunkSize = fragment.toLong(&ok, 16);
+            if (const qsizetype semicolon = size.indexOf(';'); semicolon != -1)
+                size.truncate(semicolon);
+            *chunkSize = size.trimmed().toLong(nullptr, 16);
             fragment.clear();
-            break; // size done
-        } else {
-            // read the fragment to the buffer
-            char c = 0;
-            qint64 haveRead = socket->read(&c, 1);
-            if (haveRead < 0) {
-                return -1; // FIXME
-            }
-            bytes += haveRead;
-            fragment.append(c);
         }
     }
 
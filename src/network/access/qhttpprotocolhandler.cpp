@@ -322,6 +322,10 @@ bool QHttpProtocolHandler::sendRequest()
             break;
         }
 
+        // a body of unknown size (see QHttpNetworkConnectionPrivate::prepareRequest())
+        // is sent with chunked transfer encoding until the upload device ends
+        const bool chunked = m_channel->bytesTotal == -1;
+
         // only feed the QTcpSocket buffer when there is less than 32 kB in it;
         // note that the headers do not count towards these limits.
         const qint64 socketBufferFill = 32*1024;
@@ -346,10 +350,27 @@ bool QHttpProtocolHandler::sendRequest()
         {
             // get pointer to upload data
             qint64 currentReadSize = 0;
-            const qint64 desiredReadSize = qMin(socketWriteMaxSize, m_channel->bytesTotal - m_channel->written);
+            const qint64 desiredReadSize = chunked
+                    ? socketWriteMaxSize
+                    : qMin(socketWriteMaxSize, m_channel->bytesTotal - m_channel->written);
             const char *readPointer = uploadByteDevice->readPointer(desiredReadSize, currentReadSize);
 
-            if (currentReadSize == -1) {
+            if (currentReadSize == -1 && chunked) {
+                // end of the body: send the last chunk, and the headers if the body was empty
+                const bool headerPending = !m_header.isEmpty();
+                QByteArray lastChunk = std::exchange(m_header, {});
+                lastChunk += "0\r\n\r\n";
+                if (m_socket->write(lastChunk) != lastChunk.size()) {
+                    m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
+                    return false;
+                }
+                if (headerPending)
+                    QMetaObject::invokeMethod(m_reply, "requestSent", Qt::QueuedConnection);
+                emit m_reply->dataSendProgress(m_channel->written, m_channel->written);
+                m_channel->state = QHttpNetworkConnectionChannel::WaitingState;
+                sendRequest();
+                break;
+            } else if (currentReadSize == -1) {
                 // premature eof happened
                 m_connection->d_func()->emitReplyError(m_socket, m_reply, QNetworkReply::UnknownNetworkError);
                 return false;
@@ -365,7 +386,20 @@ bool QHttpProtocolHandler::sendRequest()
                     return false;
                 }
                 qint64 currentWriteSize;
-                if (m_header.isEmpty()) {
+                if (chunked) {
+                    // chunk-size CRLF chunk-data CRLF
+                    const bool headerPending = !m_header.isEmpty();
+                    QByteArray chunkHeader = std::exchange(m_header, {});
+                    chunkHeader += QByteArray::number(currentReadSize, 16) + "\r\n";
+                    currentWriteSize = -1;
+                    if (m_socket->write(chunkHeader) == chunkHeader.size()) {
+                        currentWriteSize = m_socket->write(readPointer, currentReadSize);
+                        if (m_socket->write("\r\n", 2) != 2)
+                            currentWriteSize = -1;
+                    }
+                    if (headerPending)
+                        QMetaObject::invokeMethod(m_reply, "requestSent", Qt::QueuedConnection);
+                } else if (m_header.isEmpty()) {
                     currentWriteSize = m_socket->write(readPointer, currentReadSize);
                 } else {
                     // assemble header and data and send them together
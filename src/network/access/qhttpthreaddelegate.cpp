@@ -9,6 +9,7 @@
 #include <QAuthenticator>
 #include <QEventLoop>
 #include <QCryptographicHash>
+#include <QCoreApplication>
 
 #include "private/qhttpnetworkreply_p.h"
 #include "private/qnetworkaccesscache_p.h"
@@ -89,7 +90,8 @@ static QNetworkReply::NetworkError statusCodeFromHttp(int httpStatusCode, const
 }
 
 
-static QByteArray makeCacheKey(QUrl &url, QNetworkProxy *proxy, const QString &peerVerifyName)
+static QByteArray makeCacheKey(QUrl &url, QNetworkProxy *proxy, const QString &peerVerifyName,
+                               qsizetype connectionCount)
 {
     QString result;
     QUrl copy = url;
@@ -137,6 +139,10 @@ static QByteArray makeCacheKey(QUrl &url, QNetworkProxy *proxy, const QString &p
 #endif
     if (!peerVerifyName.isEmpty())
         result += u':' + peerVerifyName;
+    // A connection cannot change its number of channels once created, so
+    // requests asking for a different number must not share it.
+    if (connectionCount != QHttp1Configuration().numberOfConnectionsPerHost())
+        result += u":channels=" + QString::number(connectionCount);
     return "http-connection:" + std::move(result).toLatin1();
 }
 
@@ -191,6 +197,8 @@ QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     , pendingDownloadProgress()
     , synchronous(false)
     , connectionCacheExpiryTimeoutSeconds(-1)
+    , decompressedSafetyCheckThreshold(-1)
+    , downloadSegments(1)
     , incomingStatusCode(0)
     , isPipeliningUsed(false)
     , isHttp2Used(false)
@@ -201,6 +209,10 @@ QHttpThreadDelegate::QHttpThreadDelegate(QObject *parent) :
     , httpConnection(nullptr)
     , httpReply(nullptr)
     , synchronousRequestLoop(nullptr)
+    , downloadFileSize(0)
+    , downloadFileTotal(-1)
+    , downloadFilePosition(0)
+    , downloadFileEnd(-1)
 {
 }
 
@@ -283,21 +295,25 @@ void QHttpThreadDelegate::startRequest()
         }
     }
 
+    const qsizetype connectionCount = http1Parameters.numberOfConnectionsPerHost();
 #ifndef QT_NO_NETWORKPROXY
     if (transparentProxy.type() != QNetworkProxy::NoProxy)
-        cacheKey = makeCacheKey(urlCopy, &transparentProxy, httpRequest.peerVerifyName());
+        cacheKey = makeCacheKey(urlCopy, &transparentProxy, httpRequest.peerVerifyName(),
+                                connectionCount);
     else if (cacheProxy.type() != QNetworkProxy::NoProxy)
-        cacheKey = makeCacheKey(urlCopy, &cacheProxy, httpRequest.peerVerifyName());
+        cacheKey = makeCacheKey(urlCopy, &cacheProxy, httpRequest.peerVerifyName(),
+                                connectionCount);
     else
 #endif
-        cacheKey = makeCacheKey(urlCopy, nullptr, httpRequest.peerVerifyName());
+        cacheKey = makeCacheKey(urlCopy, nullptr, httpRequest.peerVerifyName(),
+                                connectionCount);
 
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
-        httpConnection = new QNetworkAccessCachedHttpConnection(http1Parameters.numberOfConnectionsPerHost(), urlCopy.host(), urlCopy.port(), ssl,
+        httpConnection = new QNetworkAccessCachedHttpConnection(connectionCount, urlCopy.host(), urlCopy.port(), ssl,
                                                                 connectionType);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
@@ -395,6 +411,7 @@ void QHttpThreadDelegate::abortRequest()
         delete httpReply;
         httpReply = nullptr;
     }
+    abortDownloadSegments();
 
     // Got aborted by the timeout timer
     if (synchronous) {
@@ -436,6 +453,18 @@ void QHttpThreadDelegate::readyReadSlot()
     if (!downloadBuffer.isNull())
         return;
 
+    if (downloadFile) {
+        while (httpReply && httpReply->readAnyAvailable()) {
+            if (!writeDownloadFile(httpReply->readAny()))
+                return;
+        }
+        emitDownloadFileProgress();
+        // httpReply is released once it has written its segment
+        if (!httpReply)
+            finishDownloadSegments();
+        return;
+    }
+
     if (readBufferMaxSize) {
         if (bytesEmitted < readBufferMaxSize) {
             qint64 sizeEmitted = 0;
@@ -473,6 +502,26 @@ void QHttpThreadDelegate::finishedSlot()
     qDebug() << "QHttpThreadDelegate::finishedSlot() thread=" << QThread::currentThreadId() << "result=" << httpReply->statusCode();
 #endif
 
+    if (downloadFile) {
+        while (httpReply && httpReply->readAnyAvailable()) {
+            if (!writeDownloadFile(httpReply->readAny()))
+                return;
+        }
+        if (downloadFileEnd >= 0) {
+            if (httpReply) {
+                downloadFileFailed(QNetworkReply::ProtocolFailure,
+                                   QCoreApplication::translate("QNetworkReply",
+                                                               "Segmented download of %1 failed")
+                                           .arg(httpRequest.url().toString()));
+            } else {
+                finishDownloadSegments();
+            }
+            return;
+        }
+        if (!closeDownloadFile())
+            return;
+    }
+
     // If there is still some data left emit that now
     while (httpReply->readAnyAvailable()) {
         pendingDownloadData->fetchAndAddRelease(1);
@@ -539,6 +588,7 @@ void QHttpThreadDelegate::finishedWithErrorSlot(QNetworkReply::NetworkError erro
     if (ssl)
         emit sslConfigurationChanged(httpReply->sslConfiguration());
 #endif
+    downloadFile.reset();
     emit error(errorCode,detail);
     emit downloadFinished();
 
@@ -619,6 +669,299 @@ void QHttpThreadDelegate::headerChangedSlot()
                           removedContentLength,
                           isHttp2Used,
                           isCompressed);
+
+    if (!downloadFileName.isEmpty() && !downloadFile && writesBodyToFile(incomingStatusCode))
+        openDownloadFile();
+}
+
+bool QHttpThreadDelegate::openDownloadFile()
+{
+    downloadFile = std::make_unique<QFile>(downloadFileName);
+    if (!downloadFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        downloadFileFailed(QNetworkReply::UnknownContentError,
+                           QCoreApplication::translate("QNetworkReply", "Cannot open %1: %2")
+                                   .arg(downloadFileName, downloadFile->errorString()));
+        return false;
+    }
+    downloadFileSize = 0;
+
+    // Decompress here as QNetworkReplyHttpImpl would, unless the user asked
+    // for a specific encoding
+    if (isCompressed && httpRequest.headerField("accept-encoding").isEmpty()) {
+        downloadFileDecompressor.setDecompressedSafetyCheckThreshold(
+                decompressedSafetyCheckThreshold);
+        if (!downloadFileDecompressor.setEncoding(httpReply->headerField("content-encoding"))) {
+            downloadFileFailed(QNetworkReply::UnknownContentError,
+                               QCoreApplication::translate("QHttp",
+                                                           "Failed to initialize decompression: %1")
+                                       .arg(downloadFileDecompressor.errorString()));
+            return false;
+        }
+    }
+    downloadFileTotal = downloadFileDecompressor.isValid() ? -1 : httpReply->contentLength();
+
+    if (downloadSegments > 1 && !downloadFileDecompressor.isValid())
+        return startDownloadSegments();
+    return true;
+}
+
+// Writes to the current position of the file if position is -1
+bool QHttpThreadDelegate::writeDownloadFileAt(qint64 position, const char *data, qint64 size)
+{
+    if ((position >= 0 && !downloadFile->seek(position))
+            || downloadFile->write(data, size) != size) {
+        downloadFileFailed(QNetworkReply::UnknownContentError,
+                           QCoreApplication::translate("QNetworkReply", "Error writing to %1: %2")
+                                   .arg(downloadFileName, downloadFile->errorString()));
+        return false;
+    }
+    downloadFileSize += size;
+    return true;
+}
+
+// Writes data received by httpReply
+bool QHttpThreadDelegate::writeDownloadFile(const QByteArray &data)
+{
+    if (downloadFileEnd >= 0) {
+        // httpReply only writes the first segment
+        const qint64 size = qMin(qint64(data.size()), downloadFileEnd - downloadFilePosition);
+        if (!writeDownloadFileAt(downloadFilePosition, data.constData(), size))
+            return false;
+        downloadFilePosition += size;
+        if (downloadFilePosition == downloadFileEnd) {
+            // the rest comes with the other segments, stop transferring it
+            httpReply->disconnect(this);
+            httpReply->abort();
+            QMetaObject::invokeMethod(httpReply, "deleteLater", Qt::QueuedConnection);
+            httpReply = nullptr;
+        }
+        return true;
+    }
+
+    if (!downloadFileDecompressor.isValid())
+        return writeDownloadFileAt(-1, data.constData(), data.size());
+
+    downloadFileDecompressor.feed(data);
+    char buffer[16 * 1024];
+    while (downloadFileDecompressor.hasData()) {
+        const qsizetype bytesRead = downloadFileDecompressor.read(buffer, sizeof(buffer));
+        if (!downloadFileDecompressor.isValid()) {
+            downloadFileFailed(QNetworkReply::UnknownContentError,
+                               QCoreApplication::translate("QHttp", "Decompression failed: %1")
+                                       .arg(downloadFileDecompressor.errorString()));
+            return false;
+        }
+        if (bytesRead > 0 && !writeDownloadFileAt(-1, buffer, bytesRead))
+            return false;
+    }
+    return true;
+}
+
+void QHttpThreadDelegate::emitDownloadFileProgress()
+{
+    pendingDownloadProgress->fetchAndAddRelease(1);
+    emit downloadFileProgress(downloadFileSize, downloadFileTotal);
+}
+
+// The file is complete by the time the reply finishes
+bool QHttpThreadDelegate::closeDownloadFile()
+{
+    if (!downloadFile->flush()) {
+        downloadFileFailed(QNetworkReply::UnknownContentError,
+                           QCoreApplication::translate("QNetworkReply", "Error writing to %1: %2")
+                                   .arg(downloadFileName, downloadFile->errorString()));
+        return false;
+    }
+    downloadFile.reset();
+    pendingDownloadProgress->fetchAndAddRelease(1);
+    emit downloadFileProgress(downloadFileSize, downloadFileSize);
+    return true;
+}
+
+// Ends the request from a slot connected to httpReply or to a segment, so
+// they can't be deleted right away
+void QHttpThreadDelegate::downloadFileFailed(QNetworkReply::NetworkError errorCode,
+                                             const QString &detail)
+{
+    abortDownloadSegments();
+    if (httpReply) {
+        httpReply->abort();
+        finishedWithErrorSlot(errorCode, detail);
+        return;
+    }
+
+    downloadFile.reset();
+    emit error(errorCode, detail);
+    emit downloadFinished();
+    QMetaObject::invokeMethod(this, "deleteLater", Qt::QueuedConnection);
+}
+
+/*
+    With DownloadSegmentsAttribute, once the headers of a large enough
+    resource arrive, httpReply is left to transfer the first part of it and
+    the other parts are requested with Range requests, sent on the same
+    connection so that they are spread over its channels, or over HTTP/2
+    streams. Every segment writes to its own part of the file. If-Range
+    makes sure that the parts all come from the same version of the
+    resource, or the download fails.
+*/
+bool QHttpThreadDelegate::startDownloadSegments()
+{
+    const qint64 size = httpReply->contentLength();
+    if (incomingStatusCode != 200 || httpRequest.operation() != QHttpNetworkRequest::Get
+            || !httpReply->headerField("accept-ranges").toLower().contains("bytes")) {
+        return true;
+    }
+    const int count = int(qMin(qint64(downloadSegments), size / MinimumDownloadSegmentSize));
+    if (count < 2)
+        return true;
+    QByteArray validator = httpReply->headerField("etag");
+    if (validator.isEmpty() || validator.startsWith("W/")) // If-Range needs a strong one
+        validator = httpReply->headerField("last-modified");
+    if (validator.isEmpty())
+        return true;
+
+    if (!downloadFile->resize(size)) {
+        downloadFileFailed(QNetworkReply::UnknownContentError,
+                           QCoreApplication::translate("QNetworkReply", "Error writing to %1: %2")
+                                   .arg(downloadFileName, downloadFile->errorString()));
+        return false;
+    }
+
+    const qint64 segmentSize = size / count;
+    downloadFilePosition = 0;
+    downloadFileEnd = segmentSize;
+    downloadFileSegments.reserve(count - 1);
+    for (int i = 1; i < count; ++i) {
+        const qint64 start = i * segmentSize;
+        const qint64 end = i == count - 1 ? size : start + segmentSize;
+        QHttpNetworkRequest request = httpRequest;
+        request.setHeaderField("Range", "bytes=" + QByteArray::number(start) + '-'
+                                       + QByteArray::number(end - 1));
+        request.setHeaderField("If-Range", validator);
+        // the ranges have to be of the representation httpReply got
+        if (request.headerField("accept-encoding").isEmpty())
+            request.setHeaderField("Accept-Encoding", "identity");
+
+        QHttpNetworkReply *reply = httpConnection->sendRequest(request);
+        reply->setParent(this);
+        downloadFileSegments.push_back({ reply, start, end });
+        connect(reply, &QHttpNetworkReply::headerChanged, this, [this, reply] {
+            downloadSegmentHeaderChanged(reply);
+        });
+        connect(reply, &QHttpNetworkReply::readyRead, this, [this, reply] {
+            downloadSegmentReadyRead(reply);
+        });
+        connect(reply, &QHttpNetworkReply::finished, this, [this, reply] {
+            downloadSegmentFinished(reply);
+        });
+        connect(reply, &QHttpNetworkReply::finishedWithError, this,
+                [this](QNetworkReply::NetworkError errorCode, const QString &detail) {
+            downloadFileFailed(errorCode, detail);
+        });
+        if (reply->errorCode() != QNetworkReply::NoError) {
+            downloadFileFailed(reply->errorCode(), reply->errorString());
+            return false;
+        }
+    }
+    return true;
+}
+
+QHttpThreadDelegate::DownloadSegment *QHttpThreadDelegate::findDownloadSegment(QHttpNetworkReply *reply)
+{
+    for (DownloadSegment &segment : downloadFileSegments) {
+        if (segment.reply == reply)
+            return &segment;
+    }
+    return nullptr;
+}
+
+void QHttpThreadDelegate::downloadSegmentFailed()
+{
+    downloadFileFailed(QNetworkReply::ProtocolFailure,
+                       QCoreApplication::translate("QNetworkReply",
+                                                   "Segmented download of %1 failed")
+                               .arg(httpRequest.url().toString()));
+}
+
+void QHttpThreadDelegate::downloadSegmentHeaderChanged(QHttpNetworkReply *reply)
+{
+    const DownloadSegment *segment = findDownloadSegment(reply);
+    if (!segment)
+        return;
+
+    // Content-Range: bytes <first>-<last>/<size>
+    const QByteArray range = "bytes " + QByteArray::number(segment->position) + '-'
+            + QByteArray::number(segment->end - 1) + '/';
+    if (reply->statusCode() != 206 || reply->isCompressed() != isCompressed
+            || !reply->headerField("content-range").trimmed().startsWith(range)) {
+        downloadSegmentFailed();
+    }
+}
+
+void QHttpThreadDelegate::downloadSegmentReadyRead(QHttpNetworkReply *reply)
+{
+    DownloadSegment *segment = findDownloadSegment(reply);
+    if (!segment)
+        return;
+
+    while (reply->readAnyAvailable()) {
+        const QByteArray data = reply->readAny();
+        if (data.size() > segment->end - segment->position) {
+            downloadSegmentFailed();
+            return;
+        }
+        if (!writeDownloadFileAt(segment->position, data.constData(), data.size()))
+            return;
+        segment->position += data.size();
+    }
+    emitDownloadFileProgress();
+}
+
+void QHttpThreadDelegate::downloadSegmentFinished(QHttpNetworkReply *reply)
+{
+    downloadSegmentReadyRead(reply);
+    DownloadSegment *segment = findDownloadSegment(reply);
+    if (!segment)
+        return;
+    if (segment->position != segment->end) {
+        downloadSegmentFailed();
+        return;
+    }
+
+    reply->disconnect(this);
+    QMetaObject::invokeMethod(reply, "deleteLater", Qt::QueuedConnection);
+    segment->reply = nullptr;
+    finishDownloadSegments();
+}
+
+// Finishes the request once httpReply and all the segments are done
+void QHttpThreadDelegate::finishDownloadSegments()
+{
+    if (httpReply)
+        return;
+    for (const DownloadSegment &segment : downloadFileSegments) {
+        if (segment.reply)
+            return;
+    }
+    downloadFileSegments.clear();
+    if (!closeDownloadFile())
+        return;
+
+    emit downloadFinished();
+    QMetaObject::invokeMethod(this, "deleteLater", Qt::QueuedConnection);
+}
+
+void QHttpThreadDelegate::abortDownloadSegments()
+{
+    for (const DownloadSegment &segment : downloadFileSegments) {
+        if (!segment.reply)
+            continue;
+        segment.reply->disconnect(this);
+        segment.reply->abort();
+        QMetaObject::invokeMethod(segment.reply, "deleteLater", Qt::QueuedConnection);
+    }
+    downloadFileSegments.clear();
 }
 
 void QHttpThreadDelegate::synchronousHeaderChangedSlot()
@@ -30,7 +30,11 @@
 #include "qhttp2configuration.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
+#include <QFile>
+
+#include <vector>
 #include "private/qnoncontiguousbytedevice_p.h"
+#include "private/qdecompresshelper_p.h"
 #include "qnetworkaccessauthenticationmanager_p.h"
 #include <QtNetwork/private/http2protocol_p.h>
 
@@ -71,6 +75,12 @@ public:
     std::shared_ptr<QNetworkAccessAuthenticationManager> authenticationManager;
     bool synchronous;
     qint64 connectionCacheExpiryTimeoutSeconds;
+    // If set, the body of a successful reply is written to this file
+    // instead of being emitted with downloadData()
+    QString downloadFileName;
+    qint64 decompressedSafetyCheckThreshold;
+    // Number of parts the download to downloadFileName may be split into
+    int downloadSegments;
 
     // outgoing, Retrieved in the synchronous HTTP case
     QByteArray synchronousDownloadData;
@@ -88,6 +98,8 @@ public:
 
     bool isCompressed;
 
+    static bool writesBodyToFile(int statusCode) { return statusCode >= 200 && statusCode < 300; }
+
 protected:
     // The zerocopy download buffer, if used:
     QSharedPointer<char> downloadBuffer;
@@ -99,6 +111,40 @@ protected:
     // Used for implementing the synchronous HTTP, see startRequestSynchronously()
     QEventLoop *synchronousRequestLoop;
 
+    // Used for downloading to downloadFileName
+    std::unique_ptr<QFile> downloadFile;
+    QDecompressHelper downloadFileDecompressor;
+    qint64 downloadFileSize; // written so far, by all segments
+    qint64 downloadFileTotal;
+    // When the download is segmented, httpReply writes the first segment,
+    // from downloadFilePosition to downloadFileEnd; downloadFileEnd is -1
+    // otherwise
+    qint64 downloadFilePosition;
+    qint64 downloadFileEnd;
+    struct DownloadSegment
+    {
+        QHttpNetworkReply *reply; // nullptr once done
+        qint64 position;
+        qint64 end;
+    };
+    std::vector<DownloadSegment> downloadFileSegments;
+    static constexpr qint64 MinimumDownloadSegmentSize = 1024 * 1024;
+
+    bool openDownloadFile();
+    bool writeDownloadFileAt(qint64 position, const char *data, qint64 size);
+    bool writeDownloadFile(const QByteArray &data);
+    void emitDownloadFileProgress();
+    bool closeDownloadFile();
+    void downloadFileFailed(QNetworkReply::NetworkError errorCode, const QString &detail);
+    bool startDownloadSegments();
+    DownloadSegment *findDownloadSegment(QHttpNetworkReply *reply);
+    void downloadSegmentFailed();
+    void downloadSegmentHeaderChanged(QHttpNetworkReply *reply);
+    void downloadSegmentReadyRead(QHttpNetworkReply *reply);
+    void downloadSegmentFinished(QHttpNetworkReply *reply);
+    void finishDownloadSegments();
+    void abortDownloadSegments();
+
 signals:
     void authenticationRequired(const QHttpNetworkRequest &request, QAuthenticator *);
 #ifndef QT_NO_NETWORKPROXY
@@ -115,6 +161,7 @@ signals:
     void downloadMetaData(const QList<QPair<QByteArray,QByteArray> > &, int, const QString &, bool,
                           QSharedPointer<char>, qint64, qint64, bool, bool);
     void downloadProgress(qint64, qint64);
+    void downloadFileProgress(qint64, qint64);
     void downloadData(const QByteArray &);
     void error(QNetworkReply::NetworkError, const QString &);
     void downloadFinished();
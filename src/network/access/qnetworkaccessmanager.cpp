@@ -8,6 +8,7 @@
 #include "qnetworkrequest.h"
 #include "qnetworkreply.h"
 #include "qnetworkreply_p.h"
+#include "private/qnetworkproxy_p.h"
 #include "qnetworkcookie.h"
 #include "qnetworkcookiejar.h"
 #include "qabstractnetworkcache.h"
@@ -1600,6 +1601,14 @@ QList<QNetworkProxy> QNetworkAccessManagerPrivate::queryProxy(const QNetworkProx
 
     return proxies;
 }
+
+// Whether queryProxy() would have to wait for the system to evaluate its
+// proxy configuration
+bool QNetworkAccessManagerPrivate::needsSystemProxyLookup(const QNetworkProxyQuery &query) const
+{
+    return !proxyFactory && proxy.type() == QNetworkProxy::DefaultProxy
+            && QNetworkProxyLookup::needsSystemLookup(query);
+}
 #endif
 
 void QNetworkAccessManagerPrivate::clearAuthenticationCache(QNetworkAccessManager *manager)
@@ -7,6 +7,9 @@
 #include "QtNetwork/qnetworkcookie.h"
 #include "QtCore/qurl.h"
 #include "QtCore/qdatetime.h"
+
+#include <algorithm>
+
 #if QT_CONFIG(topleveldomain)
 #include "private/qtldurl_p.h"
 #else
@@ -94,7 +97,12 @@ QNetworkCookieJar::~QNetworkCookieJar()
 */
 QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 {
-    return d_func()->allCookies;
+    Q_D(const QNetworkCookieJar);
+    if (!d->allCookiesValid) {
+        d->allCookies = d->cookies.values();
+        d->allCookiesValid = true;
+    }
+    return d->allCookies;
 }
 
 /*!
@@ -109,7 +117,73 @@ QList<QNetworkCookie> QNetworkCookieJar::allCookies() const
 void QNetworkCookieJar::setAllCookies(const QList<QNetworkCookie> &cookieList)
 {
     Q_D(QNetworkCookieJar);
-    d->allCookies = cookieList;
+    d->setAllCookies(cookieList);
+}
+
+void QNetworkCookieJarPrivate::setAllCookies(const QList<QNetworkCookie> &cookieList)
+{
+    cookies.clear();
+    serialsByDomain.clear();
+    for (const QNetworkCookie &cookie : cookieList)
+        addCookie(cookie);
+    allCookies = cookieList;
+    allCookiesValid = true;
+}
+
+void QNetworkCookieJarPrivate::addCookie(const QNetworkCookie &cookie)
+{
+    const quint64 serial = nextSerial++;
+    cookies.insert(serial, cookie);
+    serialsByDomain[cookie.domain()].append(serial);
+    allCookiesValid = false;
+}
+
+bool QNetworkCookieJarPrivate::removeCookie(const QNetworkCookie &cookie)
+{
+    // cookies with the same identifier have the same domain
+    const auto it = serialsByDomain.find(cookie.domain());
+    if (it == serialsByDomain.end())
+        return false;
+    QList<quint64> &serials = it.value();
+    for (qsizetype i = 0; i < serials.size(); ++i) {
+        const auto cookieIt = cookies.find(serials.at(i));
+        if (cookieIt->hasSameIdentifier(cookie)) {
+            cookies.erase(cookieIt);
+            serials.remove(i);
+            if (serials.isEmpty())
+                serialsByDomain.erase(it);
+            allCookiesValid = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the cookies whose domain matches host (see isParentDomain()),
+// in the order they were added.
+QList<QNetworkCookie> QNetworkCookieJarPrivate::cookiesForHost(const QString &host) const
+{
+    QList<quint64> serials;
+    const auto collect = [&](const QString &domain) {
+        const auto it = serialsByDomain.constFind(domain);
+        if (it != serialsByDomain.cend())
+            serials += it.value();
+    };
+    // The host itself, with and without a leading dot, and every parent
+    // domain with one
+    collect(host);
+    collect(u'.' + host);
+    for (qsizetype i = host.indexOf(u'.'); i != -1; i = host.indexOf(u'.', i + 1))
+        collect(host.mid(i));
+    std::sort(serials.begin(), serials.end());
+    // host may itself start with a dot, then two of the keys are the same
+    serials.erase(std::unique(serials.begin(), serials.end()), serials.end());
+
+    QList<QNetworkCookie> result;
+    result.reserve(serials.size());
+    for (quint64 serial : std::as_const(serials))
+        result += cookies.value(serial);
+    return result;
 }
 
 static inline bool isParentPath(const QString &path, const QString &reference)
@@ -202,9 +276,10 @@ QList<QNetworkCookie> QNetworkCookieJar::cookiesForUrl(const QUrl &url) const
     QList<QNetworkCookie> result;
     bool isEncrypted = url.scheme() == "https"_L1;
 
-    // scan our cookies for something that matches
-    QList<QNetworkCookie>::ConstIterator it = d->allCookies.constBegin(),
-                                        end = d->allCookies.constEnd();
+    // scan the cookies of the url's domains for something that matches
+    const QList<QNetworkCookie> candidates = d->cookiesForHost(url.host());
+    QList<QNetworkCookie>::ConstIterator it = candidates.constBegin(),
+                                        end = candidates.constEnd();
     for ( ; it != end; ++it) {
         if (!isParentDomain(url.host(), it->domain()))
             continue;
@@ -265,7 +340,7 @@ bool QNetworkCookieJar::insertCookie(const QNetworkCookie &cookie)
     deleteCookie(cookie);
 
     if (!isDeletion) {
-        d->allCookies += cookie;
+        d->addCookie(cookie);
         return true;
     }
     return false;
@@ -299,14 +374,7 @@ bool QNetworkCookieJar::updateCookie(const QNetworkCookie &cookie)
 bool QNetworkCookieJar::deleteCookie(const QNetworkCookie &cookie)
 {
     Q_D(QNetworkCookieJar);
-    QList<QNetworkCookie>::Iterator it;
-    for (it = d->allCookies.begin(); it != d->allCookies.end(); ++it) {
-        if (it->hasSameIdentifier(cookie)) {
-            d->allCookies.erase(it);
-            return true;
-        }
-    }
-    return false;
+    return d->removeCookie(cookie);
 }
 
 /*!
@@ -19,12 +19,29 @@
 #include "private/qobject_p.h"
 #include "qnetworkcookie.h"
 
+#include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+
 QT_BEGIN_NAMESPACE
 
 class QNetworkCookieJarPrivate: public QObjectPrivate
 {
 public:
-    QList<QNetworkCookie> allCookies;
+    void setAllCookies(const QList<QNetworkCookie> &cookieList);
+    void addCookie(const QNetworkCookie &cookie);
+    bool removeCookie(const QNetworkCookie &cookie);
+    QList<QNetworkCookie> cookiesForHost(const QString &host) const;
+
+    // The cookies are kept in the order they were added, keyed by a serial
+    // number, and indexed by their domain: a lookup only needs to look at the
+    // cookies of the host and of the domains it is in.
+    QMap<quint64, QNetworkCookie> cookies;
+    QHash<QString, QList<quint64>> serialsByDomain;
+    quint64 nextSerial = 0;
+
+    // cookies.values(), built on demand
+    mutable QList<QNetworkCookie> allCookies;
+    mutable bool allCookiesValid = true;
 
     Q_DECLARE_PUBLIC(QNetworkCookieJar)
 };
@@ -22,6 +22,8 @@
 #define CACHE_POSTFIX ".d"_L1
 #define CACHE_VERSION 8
 #define DATA_DIR "data"_L1
+#define INDEX_FILE "index"_L1
+#define INDEX_MAGIC 0xe8a1d7c3
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -80,6 +82,8 @@ QNetworkDiskCache::~QNetworkDiskCache()
 {
     Q_D(QNetworkDiskCache);
     qDeleteAll(d->inserting);
+    if (d->indexValid)
+        d->saveIndex();
 }
 
 /*!
@@ -109,6 +113,8 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    if (d->indexValid)
+        d->saveIndex();
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -117,6 +123,11 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
 
     d->dataDirectory = d->cacheDirectory + DATA_DIR + QString::number(CACHE_VERSION) + u'/';
     d->prepareLayout();
+
+    d->index.clear();
+    d->indexedSize = 0;
+    d->indexValid = d->loadIndex();
+    d->currentCacheSize = d->indexValid ? d->indexedSize : -1;
 }
 
 /*!
@@ -259,8 +270,10 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         // commit() invalidates the file-engine, and size() will create a new
         // one, pointing at an empty filename.
         qint64 size = cacheItem->file->size();
-        if (cacheItem->file->commit())
+        if (cacheItem->file->commit()) {
             currentCacheSize += size;
+            indexInsert(fileName, size);
+        }
         // Delete and unset the QSaveFile, it's invalid now.
         delete std::exchange(cacheItem->file, nullptr);
     }
@@ -310,6 +323,7 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     qint64 size = info.size();
     if (QFile::remove(file)) {
         currentCacheSize -= size;
+        indexRemove(file);
         return true;
     }
     return false;
@@ -384,6 +398,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             buffer.reset(new QBuffer);
             buffer->setData(file->readAll());
         }
+        d->indexTouch(file->fileName());
     }
     buffer->open(QBuffer::ReadOnly);
     return buffer.release();
@@ -455,8 +470,10 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
 
     When the current size of the cache is greater than the maximumCacheSize()
     older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    maximumCacheSize() starting with the least recently used ones. The last use
+    of a file is tracked while the cache is alive and stored in an index file
+    in cacheDirectory() when it is destroyed; files the index does not know
+    about are dated by their creation time.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -481,41 +498,32 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    const QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
+    if (!d->indexValid)
+        d->buildIndex();
+
+    qint64 totalSize = d->indexedSize;
+    const qint64 goal = (maximumCacheSize() * 9) / 10;
+    if (totalSize < goal)
+        return totalSize; // Nothing to do
 
     struct CacheItem
     {
-        std::chrono::milliseconds msecs;
+        qint64 lastUse;
         QString path;
-        qint64 size = 0;
+        qint64 size;
     };
     std::vector<CacheItem> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QFileInfo info = it.nextFileInfo();
-        if (!info.fileName().endsWith(CACHE_POSTFIX))
-            continue;
-
-        QDateTime fileTime = info.birthTime(QTimeZone::UTC);
-        if (!fileTime.isValid())
-            fileTime = info.metadataChangeTime(QTimeZone::UTC);
-        const std::chrono::milliseconds msecs{fileTime.toMSecsSinceEpoch()};
-        const qint64 size = info.size();
-        cacheItems.push_back(CacheItem{msecs, info.filePath(), size});
-        totalSize += size;
-    }
-
-    const qint64 goal = (maximumCacheSize() * 9) / 10;
-    if (totalSize < goal)
-        return totalSize; // Nothing to do
+    cacheItems.reserve(d->index.size());
+    for (auto it = d->index.cbegin(), end = d->index.cend(); it != end; ++it)
+        cacheItems.push_back(CacheItem{it->lastUse, it.key(), it->size});
 
-    auto byFileTime = [&](const auto &a, const auto &b) { return a.msecs < b.msecs; };
-    std::sort(cacheItems.begin(), cacheItems.end(), byFileTime);
+    auto byLastUse = [](const CacheItem &a, const CacheItem &b) { return a.lastUse < b.lastUse; };
+    std::sort(cacheItems.begin(), cacheItems.end(), byLastUse);
 
     [[maybe_unused]] int removedFiles = 0; // used under QNETWORKDISKCACHE_DEBUG
     for (const CacheItem &cached : cacheItems) {
         QFile::remove(cached.path);
+        d->indexRemove(cached.path);
         ++removedFiles;
         totalSize -= cached.size;
         if (totalSize < goal)
@@ -546,6 +554,130 @@ void QNetworkDiskCache::clear()
     d->maximumCacheSize = size;
 }
 
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+/*!
+    Rebuilds the index by walking the cache directory, used when no up to
+    date index file was found.
+ */
+void QNetworkDiskCachePrivate::buildIndex()
+{
+    index.clear();
+    indexedSize = 0;
+
+    const QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
+    QDirIterator it(cacheDirectory, filters, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFileInfo info = it.nextFileInfo();
+        if (!info.fileName().endsWith(CACHE_POSTFIX))
+            continue;
+
+        QDateTime fileTime = info.birthTime(QTimeZone::UTC);
+        if (!fileTime.isValid())
+            fileTime = info.metadataChangeTime(QTimeZone::UTC);
+        const qint64 size = info.size();
+        index.insert(QDir::cleanPath(info.filePath()), IndexEntry{size, fileTime.toMSecsSinceEpoch()});
+        indexedSize += size;
+    }
+    indexValid = true;
+}
+
+/*!
+    Loads the index written by saveIndex(). The file is removed once loaded,
+    so that a process that does not shut down cleanly leaves no stale index
+    behind and the next one walks the directory instead.
+ */
+bool QNetworkDiskCachePrivate::loadIndex()
+{
+    QFile file(indexFileName());
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    const qint64 fileSize = file.size();
+    const uchar *mapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    const QByteArray data = mapped
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), fileSize)
+            : file.readAll();
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    qint32 version = 0;
+    qint64 count = 0;
+    in >> magic >> version >> count;
+    bool ok = in.status() == QDataStream::Ok && magic == INDEX_MAGIC
+            && version == CACHE_VERSION && count >= 0;
+    if (ok) {
+        index.reserve(count);
+        for (qint64 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            QString name;
+            IndexEntry entry;
+            in >> name >> entry.size >> entry.lastUse;
+            index.insert(cacheDirectory + name, entry);
+            indexedSize += entry.size;
+        }
+        ok = in.status() == QDataStream::Ok;
+    }
+    if (mapped)
+        file.unmap(const_cast<uchar *>(mapped));
+    file.remove();
+
+    if (!ok) {
+        index.clear();
+        indexedSize = 0;
+    }
+    return ok;
+}
+
+void QNetworkDiskCachePrivate::saveIndex() const
+{
+    QSaveFile file(indexFileName());
+    if (!file.open(QFile::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint32(INDEX_MAGIC) << qint32(CACHE_VERSION) << qint64(index.size());
+    // all cache files live below cacheDirectory, which ends with a slash
+    for (auto it = index.cbegin(), end = index.cend(); it != end; ++it)
+        out << it.key().mid(cacheDirectory.size()) << it->size << it->lastUse;
+    file.commit();
+}
+
+void QNetworkDiskCachePrivate::indexInsert(const QString &fileName, qint64 size)
+{
+    if (!indexValid)
+        return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    auto it = index.find(fileName);
+    if (it != index.end()) {
+        indexedSize += size - it->size;
+        *it = IndexEntry{size, now};
+    } else {
+        index.insert(fileName, IndexEntry{size, now});
+        indexedSize += size;
+    }
+}
+
+void QNetworkDiskCachePrivate::indexRemove(const QString &fileName)
+{
+    auto it = index.find(fileName);
+    if (it == index.end())
+        return;
+    indexedSize -= it->size;
+    index.erase(it);
+}
+
+void QNetworkDiskCachePrivate::indexTouch(const QString &fileName)
+{
+    auto it = index.find(fileName);
+    if (it != index.end())
+        it->lastUse = QDateTime::currentMSecsSinceEpoch();
+}
+
 /*!
     Given a URL, generates a unique enough filename (and subdirectory)
  */
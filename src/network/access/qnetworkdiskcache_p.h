@@ -70,6 +70,20 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    // In-memory index of the cache files, so that expire() does not have
+    // to walk the cache directory
+    struct IndexEntry {
+        qint64 size;
+        qint64 lastUse;     // msecs since epoch
+    };
+    QString indexFileName() const;
+    void buildIndex();
+    bool loadIndex();
+    void saveIndex() const;
+    void indexInsert(const QString &fileName, qint64 size);
+    void indexRemove(const QString &fileName);
+    void indexTouch(const QString &fileName);
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
@@ -77,6 +91,9 @@ public:
     qint64 currentCacheSize;
 
     QHash<QIODevice*, QCacheItem*> inserting;
+    QHash<QString, IndexEntry> index;
+    qint64 indexedSize = 0;
+    bool indexValid = false;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
 
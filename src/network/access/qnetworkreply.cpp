@@ -480,6 +480,37 @@ bool QNetworkReply::isSequential() const
     return true;
 }
 
+/*!
+    \since 6.7
+
+    Reads the next block of downloaded data and returns it, or returns an
+    empty QByteArray if no data is currently available.
+
+    Unlike read() and readAll(), this function does not copy the data
+    when it is held in the reply's read buffer: the returned QByteArray
+    shares the memory that the data was received into. The size of each
+    block is decided by the network backend, so call this function
+    repeatedly until it returns an empty byte array to consume all
+    available data. Blocks that were partially read with read() and data
+    that the backend still has to decode, such as compressed content, are
+    returned as a copy.
+
+    \sa read(), bytesAvailable()
+*/
+QByteArray QNetworkReply::readChunk()
+{
+    Q_D(QNetworkReply);
+
+    // QIODevice::read() hands out the buffered chunk itself when asked for
+    // exactly its size.
+    qint64 size = d->buffer.nextDataBlockSize();
+    if (size == 0)
+        size = qMin(bytesAvailable(), qint64(d->readBufferChunkSize));
+    if (size <= 0)
+        return QByteArray();
+    return read(size);
+}
+
 /*!
     Returns the size of the read buffer, in bytes.
 
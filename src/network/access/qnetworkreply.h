@@ -85,6 +85,8 @@ public:
     qint64 readBufferSize() const;
     virtual void setReadBufferSize(qint64 size);
 
+    QByteArray readChunk();
+
     QNetworkAccessManager *manager() const;
     QNetworkAccessManager::Operation operation() const;
     QNetworkRequest request() const;
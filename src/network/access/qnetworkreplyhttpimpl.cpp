@@ -12,6 +12,7 @@
 #include "qnetworkrequest_p.h"
 #include "qnetworkcookie.h"
 #include "qnetworkcookie_p.h"
+#include "private/qnetworkproxy_p.h"
 #include "QtCore/qdatetime.h"
 #include "QtCore/qelapsedtimer.h"
 #include "QtNetwork/qsslconfiguration.h"
@@ -37,6 +38,27 @@ using namespace QtMiscUtils;
 
 class QNetworkProxy;
 
+namespace {
+// The HTTP thread shared by requests with Http2SharedConnectionAttribute set
+struct SharedHttpThread
+{
+    SharedHttpThread() : thread(new QThread)
+    {
+        thread->setObjectName(QStringLiteral("Qt shared HTTP thread"));
+        thread->start();
+    }
+    ~SharedHttpThread()
+    {
+        thread->quit();
+        thread->wait(QDeadlineTimer(5000));
+        if (thread->isFinished())
+            delete thread;
+    }
+    QThread *thread;
+};
+}
+Q_GLOBAL_STATIC(SharedHttpThread, sharedHttpThread)
+
 static inline bool isSeparator(char c)
 {
     static const char separators[] = "()<>@,;:\\\"/[]?={}";
@@ -196,15 +218,10 @@ QNetworkReplyHttpImpl::QNetworkReplyHttpImpl(QNetworkAccessManager* const manage
                                   false).toBool();
 
             if (bufferingDisallowed) {
-                // if a valid content-length header for the request was supplied, we can disable buffering
-                // if not, we will buffer anyway
-                if (request.header(QNetworkRequest::ContentLengthHeader).isValid()) {
-                    QMetaObject::invokeMethod(this, "_q_startOperation", Qt::QueuedConnection);
-                    // FIXME make direct call?
-                } else {
-                    d->state = d->Buffering;
-                    QMetaObject::invokeMethod(this, "_q_bufferOutgoingData", Qt::QueuedConnection);
-                }
+                // without a content-length header for the request, the data is streamed
+                // with chunked transfer encoding (or HTTP/2 DATA frames) as it arrives
+                QMetaObject::invokeMethod(this, "_q_startOperation", Qt::QueuedConnection);
+                // FIXME make direct call?
             } else {
                 // _q_startOperation will be called when the buffering has finished.
                 d->state = d->Buffering;
@@ -472,6 +489,10 @@ QNetworkReplyHttpImplPrivate::~QNetworkReplyHttpImplPrivate()
  */
 bool QNetworkReplyHttpImplPrivate::loadFromCacheIfAllowed(QHttpNetworkRequest &httpRequest)
 {
+    // The cached data would end up in the reply instead of the file
+    if (!downloadFileName.isEmpty())
+        return false;
+
     QNetworkRequest::CacheLoadControl CacheLoadControlAttribute =
         (QNetworkRequest::CacheLoadControl)request.attribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork).toInt();
     if (CacheLoadControlAttribute == QNetworkRequest::AlwaysNetwork) {
@@ -619,6 +640,22 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
 {
     Q_Q(QNetworkReplyHttpImpl);
 
+#if !defined(QT_NO_NETWORKPROXY) && QT_CONFIG(future)
+    // Looking up the system proxies may mean evaluating a PAC script, so
+    // don't block the user's thread on it; post the request once they're known
+    if (!synchronous && !resolvedProxies
+            && managerPrivate->needsSystemProxyLookup(QNetworkProxyQuery(newHttpRequest.url()))) {
+        QNetworkProxyLookup::proxyForQuery(QNetworkProxyQuery(newHttpRequest.url()))
+                .then(q, [this, newHttpRequest](QList<QNetworkProxy> proxies) {
+                    if (state != Working) // aborted or timed out in the meantime
+                        return;
+                    resolvedProxies = std::move(proxies);
+                    postRequest(newHttpRequest);
+                });
+        return;
+    }
+#endif
+
     QThread *thread = nullptr;
     if (synchronous) {
         // A synchronous HTTP request uses its own thread
@@ -626,12 +663,19 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
         thread->setObjectName(QStringLiteral("Qt HTTP synchronous thread"));
         QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
         thread->start();
+    } else if (newHttpRequest.attribute(QNetworkRequest::Http2SharedConnectionAttribute).toBool()) {
+        // Connections are cached per HTTP thread, so requests from all managers
+        // that opt in end up in the same cache.
+        thread = sharedHttpThread()->thread;
     } else {
         // We use the manager-global thread.
         // At some point we could switch to having multiple threads if it makes sense.
         thread = managerPrivate->createThread();
     }
 
+    if (!synchronous)
+        downloadFileName = newHttpRequest.attribute(QNetworkRequest::DownloadFileAttribute).toString();
+
     QUrl url = newHttpRequest.url();
     httpRequest.setUrl(url);
     httpRequest.setRedirectCount(newHttpRequest.maximumRedirectsAllowed());
@@ -648,7 +692,13 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     QNetworkProxy transparentProxy, cacheProxy;
 
     // FIXME the proxy stuff should be done in the HTTP thread
-    const auto proxies = managerPrivate->queryProxy(QNetworkProxyQuery(newHttpRequest.url()));
+    QList<QNetworkProxy> proxies;
+    if (resolvedProxies) {
+        proxies = std::move(*resolvedProxies);
+        resolvedProxies.reset();
+    } else {
+        proxies = managerPrivate->queryProxy(QNetworkProxyQuery(newHttpRequest.url()));
+    }
     for (const QNetworkProxy &p : proxies) {
         // use the first proxy that works
         // for non-encrypted connections, any transparent or HTTP proxy
@@ -845,6 +895,15 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
             delegate->downloadBufferMaximumSize = 128*1024;
         }
 
+        if (!downloadFileName.isEmpty()) {
+            delegate->downloadFileName = downloadFileName;
+            delegate->decompressedSafetyCheckThreshold =
+                    newHttpRequest.decompressedSafetyCheckThreshold();
+            delegate->downloadSegments =
+                    newHttpRequest.attribute(QNetworkRequest::DownloadSegmentsAttribute, 1).toInt();
+            delegate->downloadBufferMaximumSize = 0;
+        }
+
 
         // These atomic integers are used for signal compression
         delegate->pendingDownloadData = pendingDownloadDataEmissions;
@@ -863,6 +922,8 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
                 q, &QNetworkReply::requestSent, Qt::QueuedConnection);
         connect(delegate, &QHttpThreadDelegate::downloadMetaData, this,
                 &QNetworkReplyHttpImplPrivate::replyDownloadMetaData, Qt::QueuedConnection);
+        connect(delegate, &QHttpThreadDelegate::downloadFileProgress, this,
+                &QNetworkReplyHttpImplPrivate::replyDownloadFileProgress, Qt::QueuedConnection);
         QObject::connect(delegate, SIGNAL(downloadProgress(qint64,qint64)),
                 q, SLOT(replyDownloadProgressSlot(qint64,qint64)),
                 Qt::QueuedConnection);
@@ -1342,7 +1403,9 @@ void QNetworkReplyHttpImplPrivate::replyDownloadMetaData(const QList<QPair<QByte
     // somwehat unknown (presumed legacy compatibility) reasons treated as
     // disabling our decompression:
     const bool autoDecompress = request.rawHeader("accept-encoding").isEmpty();
-    const bool shouldDecompress = isCompressed && autoDecompress;
+    // The HTTP thread decompresses what it writes to the download file
+    const bool bodyInFile = !downloadFileName.isEmpty() && QHttpThreadDelegate::writesBodyToFile(sc);
+    const bool shouldDecompress = isCompressed && autoDecompress && !bodyInFile;
     // reconstruct the HTTP header
     QList<QPair<QByteArray, QByteArray> > headerMap = hm;
     QList<QPair<QByteArray, QByteArray> >::ConstIterator it = headerMap.constBegin(),
@@ -1484,6 +1547,33 @@ void QNetworkReplyHttpImplPrivate::replyDownloadProgressSlot(qint64 bytesReceive
     }
 }
 
+void QNetworkReplyHttpImplPrivate::replyDownloadFileProgress(qint64 bytesWritten,
+                                                             qint64 bytesTotal)
+{
+    Q_Q(QNetworkReplyHttpImpl);
+
+    // If we're closed just ignore this data
+    if (!q->isOpen())
+        return;
+
+    int pendingSignals = pendingDownloadProgressEmissions->fetchAndSubAcquire(1) - 1;
+    if (pendingSignals > 0) {
+        // Let's ignore this signal and look at the next one coming in
+        // (signal compression)
+        return;
+    }
+
+    bytesDownloaded = bytesWritten;
+    setupTransferTimeout();
+
+    // Nothing can be read from the reply, so there is no readyRead()
+    if (bytesWritten == bytesTotal
+            || downloadProgressSignalChoke.elapsed() >= progressSignalInterval) {
+        downloadProgressSignalChoke.restart();
+        emit q->downloadProgress(bytesDownloaded, bytesTotal);
+    }
+}
+
 void QNetworkReplyHttpImplPrivate::httpAuthenticationRequired(const QHttpNetworkRequest &request,
                                                            QAuthenticator *auth)
 {
@@ -2168,7 +2258,8 @@ void QNetworkReplyHttpImplPrivate::createCache()
 {
     // check if we can save and if we're allowed to
     if (!managerPrivate->networkCache
-        || !request.attribute(QNetworkRequest::CacheSaveControlAttribute, true).toBool())
+        || !request.attribute(QNetworkRequest::CacheSaveControlAttribute, true).toBool()
+        || !downloadFileName.isEmpty())
         return;
     cacheEnabled = true;
 }
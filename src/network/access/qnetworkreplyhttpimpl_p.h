@@ -40,6 +40,7 @@ Q_MOC_INCLUDE(<QtNetwork/QAuthenticator>)
 #include <private/qdecompresshelper_p.h>
 
 #include <memory>
+#include <optional>
 
 QT_REQUIRE_CONFIG(http);
 
@@ -191,6 +192,8 @@ public:
     QUrl urlForLastAuthentication;
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy lastProxyAuthentication;
+    // The proxies looked up without blocking, for the next postRequest()
+    std::optional<QList<QNetworkProxy>> resolvedProxies;
 #endif
 
 
@@ -229,6 +232,10 @@ public:
 
     QDecompressHelper decompressHelper;
 
+    // DownloadFileAttribute of the request, the HTTP thread writes the
+    // body of successful replies to it
+    QString downloadFileName;
+
     bool loadFromCacheIfAllowed(QHttpNetworkRequest &httpRequest);
     void invalidateCache();
     bool sendCacheContents(const QNetworkCacheMetaData &metaData);
@@ -247,6 +254,7 @@ public:
     void replyDownloadMetaData(const QList<QPair<QByteArray,QByteArray> > &, int, const QString &,
                                bool, QSharedPointer<char>, qint64, qint64, bool, bool);
     void replyDownloadProgressSlot(qint64,qint64);
+    void replyDownloadFileProgress(qint64 bytesWritten, qint64 bytesTotal);
     void httpAuthenticationRequired(const QHttpNetworkRequest &request, QAuthenticator *auth);
     void httpError(QNetworkReply::NetworkError error, const QString &errorString);
 #ifndef QT_NO_SSL
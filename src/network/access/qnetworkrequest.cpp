@@ -179,8 +179,12 @@ QT_IMPL_METATYPE_EXTERN_TAGGED(QNetworkRequest::RedirectPolicy, QNetworkRequest_
         Requests only, type: QMetaType::Bool (default: false)
         Indicates whether the QNetworkAccessManager code is
         allowed to buffer the upload data, e.g. when doing a HTTP POST.
-        When using this flag with sequential upload data, the ContentLengthHeader
-        header must be set.
+        When using this flag with sequential upload data, and the
+        ContentLengthHeader header is not set, the data is sent as it
+        becomes available, using chunked transfer encoding with HTTP/1.1
+        (since Qt 6.7; before, the data was buffered anyway). Such a
+        request cannot be resent, for instance after a redirect that keeps
+        the method or a request for authentication: it fails instead.
 
     \value HttpPipeliningAllowedAttribute
         Requests only, type: QMetaType::Bool (default: false)
@@ -316,6 +320,52 @@ QT_IMPL_METATYPE_EXTERN_TAGGED(QNetworkRequest::RedirectPolicy, QNetworkRequest_
         same-origin requests. This only affects the WebAssembly platform.
         (This value was introduced in 6.5.)
 
+    \value Http2SharedConnectionAttribute
+        Requests only, type: QMetaType::Bool (default: false)
+        Indicates that the HTTP connection used for this request may be
+        shared with requests made by other QNetworkAccessManager instances,
+        including managers living in other threads, that set this attribute
+        too. Such requests are processed in a single process-wide thread, so
+        one HTTP/2 connection and its header compression state serve all of
+        them. Connection-based authentication state is shared along with the
+        connection, so only set this attribute for managers that use the
+        same credentials. Has no effect on synchronous requests.
+        (This value was introduced in 6.7.)
+
+    \value DownloadFileAttribute
+        Requests only, type: QMetaType::QString (default: empty)
+        The path of a local file to which the body of a successful (2xx)
+        HTTP reply is written, by the thread that does the network
+        transfer. The data never passes through the reply, which then
+        has nothing to read and does not emit readyRead(), but still
+        emits downloadProgress() and finished(). The file is created or
+        truncated when the headers of the reply arrive, is complete by
+        the time finished() is emitted, and keeps what was received so
+        far if the download fails. If the file cannot be opened or
+        written, the reply fails with QNetworkReply::UnknownContentError. Compressed content is
+        decompressed as it would be for the reply. Other replies, such
+        as errors and redirections, are delivered through the reply as
+        usual. Requests with this attribute are neither loaded from nor
+        saved to the network cache. Has no effect on synchronous requests
+        and on schemes other than HTTP and HTTPS.
+        (This value was introduced in 6.7.)
+
+    \value DownloadSegmentsAttribute
+        Requests only, type: QMetaType::Int (default: 1)
+        The number of parts into which a download to the file given by
+        DownloadFileAttribute may be split. Once the headers of a GET
+        reply with status 200 arrive, if the server accepts byte ranges
+        and identifies the resource with a strong ETag or a Last-Modified
+        date, the reply only transfers the first part of the body, and the
+        other parts are requested in parallel with range requests, on
+        other connections to the same host or, with HTTP/2, on other
+        streams. Every part is at least one megabyte, so small resources
+        are not split, and neither is compressed content that is
+        decompressed into the file. If a part does not match the rest of
+        the resource, the reply fails with QNetworkReply::ProtocolFailure.
+        Has no effect without DownloadFileAttribute.
+        (This value was introduced in 6.7.)
+
     \value User
         Special type. Additional information can be passed in
         QVariants with types ranging from User to UserMax. The default
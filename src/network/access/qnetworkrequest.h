@@ -65,6 +65,9 @@ public:
         ConnectionCacheExpiryTimeoutSecondsAttribute,
         Http2CleartextAllowedAttribute,
         UseCredentialsAttribute,
+        Http2SharedConnectionAttribute,
+        DownloadFileAttribute,
+        DownloadSegmentsAttribute,
 
         User = 1000,
         UserMax = 32767
@@ -100,6 +100,24 @@ ci.ifa_prefered = ci.ifa_valid = 0;
 }
 ")
 
+# sendmmsg
+qt_config_compile_test(sendmmsg
+    LABEL "sendmmsg() and recvmmsg()"
+    CODE
+"#include <sys/types.h>
+#include <sys/socket.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct mmsghdr msgs[2] = {};
+sendmmsg(0, msgs, 2, 0);
+recvmmsg(0, msgs, 2, 0, nullptr);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # res_setserver
 qt_config_compile_test(res_setservers
     LABEL "res_setservers()"
@@ -235,6 +253,10 @@ qt_feature("linux-netlink" PRIVATE
     LABEL "Linux AF_NETLINK"
     CONDITION LINUX AND NOT ANDROID AND TEST_linux_netlink
 )
+qt_feature("sendmmsg" PRIVATE
+    LABEL "sendmmsg() and recvmmsg()"
+    CONDITION UNIX AND TEST_sendmmsg
+)
 qt_feature("res_setservers" PRIVATE
     LABEL "res_setservers()"
     CONDITION QT_FEATURE_libresolv AND TEST_res_setservers
@@ -1087,9 +1087,9 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 }
 #endif
 
-// cache for 60 seconds
+// cache for 60 seconds, or 10 seconds if the host was not found
 // cache 128 items
-QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(128)
+QHostInfoCache::QHostInfoCache() : max_age(60), negative_max_age(10), enabled(true), cache(128)
 {
 #ifdef QT_QHOSTINFO_CACHE_DISABLED_BY_DEFAULT
     enabled.store(false, std::memory_order_relaxed);
@@ -1102,7 +1102,8 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        const int age = element->info.error() == QHostInfo::NoError ? max_age : negative_max_age;
+        if (element->age.elapsed() < age*1000)
             *valid = true;
         return element->info;
 
@@ -1116,8 +1117,9 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
 void QHostInfoCache::put(const QString &name, const QHostInfo &info)
 {
-    // if the lookup failed, don't cache
-    if (info.error() != QHostInfo::NoError)
+    // if the lookup failed for other reasons than the host not existing,
+    // don't cache: the error may well be gone on the next try
+    if (info.error() != QHostInfo::NoError && info.error() != QHostInfo::HostNotFound)
         return;
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
@@ -187,6 +187,7 @@
 */
 
 #include "qnetworkproxy.h"
+#include "qnetworkproxy_p.h"
 
 #ifndef QT_NO_NETWORKPROXY
 
@@ -200,11 +201,20 @@
 #endif
 
 #include "qauthenticator.h"
+#include "qdeadlinetimer.h"
 #include "qdebug.h"
+#include "qhash.h"
 #include "qmutex.h"
 #include "qstringlist.h"
 #include "qurl.h"
 
+#if QT_CONFIG(future)
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+
+#include <memory>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -261,6 +271,7 @@ public:
     {
         QMutexLocker lock(&mutex);
         useSystemProxies = enable;
+        clearSystemProxyCache();
 
         if (useSystemProxies) {
             if (applicationLevelProxy)
@@ -299,8 +310,43 @@ public:
     }
 
     QList<QNetworkProxy> proxyForQuery(const QNetworkProxyQuery &query);
+    bool needsSystemLookup(const QNetworkProxyQuery &query);
+
+    int systemProxyCacheLifetime()
+    {
+        QMutexLocker lock(&mutex);
+        return systemProxyLifetime;
+    }
+
+    void setSystemProxyCacheLifetime(int msecs)
+    {
+        QMutexLocker lock(&mutex);
+        systemProxyLifetime = qMax(msecs, 0);
+        clearSystemProxyCache();
+    }
 
 private:
+    // The system proxies are cached per host: a PAC script may tell URLs of
+    // the same host apart, but the cache is opt-in
+    struct CachedSystemProxies
+    {
+        QList<QNetworkProxy> proxies;
+        QDeadlineTimer expiry;
+    };
+    static constexpr qsizetype MaxCachedSystemProxies = 256;
+
+    static QString systemProxyCacheKey(const QNetworkProxyQuery &query)
+    {
+        return QString::number(int(query.queryType())) + u' ' + query.protocolTag() + u' '
+                + query.peerHostName() + u' ' + QString::number(query.peerPort());
+    }
+
+    void clearSystemProxyCache()
+    {
+        systemProxyCache.clear();
+        ++systemProxyCacheGeneration;
+    }
+
     QRecursiveMutex mutex;
     QNetworkProxy *applicationLevelProxy;
     QNetworkProxyFactory *applicationLevelProxyFactory;
@@ -311,8 +357,19 @@ private:
     QHttpSocketEngineHandler *httpSocketEngineHandler;
 #endif
     bool useSystemProxies;
+    int systemProxyLifetime = 0;
+    quint64 systemProxyCacheGeneration = 0;
+    QHash<QString, CachedSystemProxies> systemProxyCache;
 };
 
+static bool isLocalHostQuery(const QNetworkProxyQuery &query)
+{
+    QHostAddress parsed;
+    QString hostname = query.url().host();
+    return hostname == "localhost"_L1 || hostname.startsWith("localhost."_L1)
+            || (parsed.setAddress(hostname) && (parsed.isLoopback()));
+}
+
 QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery &query)
 {
     QMutexLocker locker(&mutex);
@@ -320,10 +377,7 @@ QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery
     QList<QNetworkProxy> result;
 
     // don't look for proxies for a local connection
-    QHostAddress parsed;
-    QString hostname = query.url().host();
-    if (hostname == "localhost"_L1 || hostname.startsWith("localhost."_L1)
-            || (parsed.setAddress(hostname) && (parsed.isLoopback()))) {
+    if (isLocalHostQuery(query)) {
         result << QNetworkProxy(QNetworkProxy::NoProxy);
         return result;
     }
@@ -333,7 +387,28 @@ QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery
             && applicationLevelProxy->type() != QNetworkProxy::DefaultProxy) {
             result << *applicationLevelProxy;
         } else if (useSystemProxies) {
-            result = QNetworkProxyFactory::systemProxyForQuery(query);
+            const QString key = systemProxyCacheKey(query);
+            const auto it = systemProxyCache.constFind(key);
+            if (it != systemProxyCache.cend() && !it->expiry.hasExpired()) {
+                result = it->proxies;
+            } else {
+                // don't keep the other threads waiting while the system
+                // evaluates a PAC script
+                const quint64 generation = systemProxyCacheGeneration;
+                locker.unlock();
+                result = QNetworkProxyFactory::systemProxyForQuery(query);
+                locker.relock();
+                if (systemProxyLifetime > 0 && generation == systemProxyCacheGeneration) {
+                    if (systemProxyCache.size() >= MaxCachedSystemProxies) {
+                        systemProxyCache.removeIf([](const auto &entry) {
+                            return entry.value().expiry.hasExpired();
+                        });
+                        if (systemProxyCache.size() >= MaxCachedSystemProxies)
+                            systemProxyCache.clear();
+                    }
+                    systemProxyCache.insert(key, { result, QDeadlineTimer(systemProxyLifetime) });
+                }
+            }
 
             // Make sure NoProxy is in the list, so that QTcpServer can work:
             // it searches for the first proxy that can has the ListeningCapability capability
@@ -356,6 +431,18 @@ QList<QNetworkProxy> QGlobalNetworkProxy::proxyForQuery(const QNetworkProxyQuery
     return result;
 }
 
+bool QGlobalNetworkProxy::needsSystemLookup(const QNetworkProxyQuery &query)
+{
+    QMutexLocker locker(&mutex);
+    if (!useSystemProxies || applicationLevelProxyFactory || isLocalHostQuery(query)
+            || (applicationLevelProxy
+                && applicationLevelProxy->type() != QNetworkProxy::DefaultProxy)) {
+        return false;
+    }
+    const auto it = systemProxyCache.constFind(systemProxyCacheKey(query));
+    return it == systemProxyCache.cend() || it->expiry.hasExpired();
+}
+
 Q_GLOBAL_STATIC(QGlobalNetworkProxy, globalNetworkProxy)
 
 namespace {
@@ -1507,6 +1594,83 @@ QList<QNetworkProxy> QNetworkProxyFactory::proxyForQuery(const QNetworkProxyQuer
     return globalNetworkProxy()->proxyForQuery(query);
 }
 
+/*!
+    \since 6.7
+
+    Returns how long, in milliseconds, the proxies that systemProxyForQuery()
+    returns are reused for further queries for the same host. The default
+    is 0, meaning that the system is asked for every query.
+
+    \sa setSystemProxyCacheLifetime()
+*/
+int QNetworkProxyFactory::systemProxyCacheLifetime()
+{
+    if (globalNetworkProxy())
+        return globalNetworkProxy()->systemProxyCacheLifetime();
+    return 0;
+}
+
+/*!
+    \since 6.7
+
+    When the platform-specific proxy settings are in use, keeps the proxies
+    that the system returned for a query for \a msecs milliseconds, and
+    returns them from proxyForQuery() for further queries with the same
+    type, protocol, host and port instead of asking the system again. This
+    saves evaluating a PAC script, which may take long, for every request,
+    but a script that selects proxies by the path of URLs is then only
+    evaluated for the first URL of every host.
+
+    Calling this function, or setUseSystemConfiguration(), clears the
+    cached proxies. A value of 0 disables the cache.
+
+    \sa systemProxyCacheLifetime(), usesSystemConfiguration()
+*/
+void QNetworkProxyFactory::setSystemProxyCacheLifetime(int msecs)
+{
+    if (globalNetworkProxy())
+        globalNetworkProxy()->setSystemProxyCacheLifetime(msecs);
+}
+
+bool QNetworkProxyLookup::needsSystemLookup(const QNetworkProxyQuery &query)
+{
+    return globalNetworkProxy() && globalNetworkProxy()->needsSystemLookup(query);
+}
+
+#if QT_CONFIG(future)
+namespace {
+// Looking up proxies mostly waits, on PAC scripts or on libproxy's lock,
+// so it gets threads of its own
+class QProxyLookupPool : public QThreadPool
+{
+public:
+    QProxyLookupPool() { setMaxThreadCount(4); }
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QProxyLookupPool, proxyLookupPool)
+
+QFuture<QList<QNetworkProxy>> QNetworkProxyLookup::proxyForQuery(const QNetworkProxyQuery &query)
+{
+    auto promise = std::make_shared<QPromise<QList<QNetworkProxy>>>();
+    QFuture<QList<QNetworkProxy>> future = promise->future();
+    promise->start();
+
+    QThreadPool *pool = proxyLookupPool();
+    if (!pool) {
+        promise->addResult(QNetworkProxyFactory::proxyForQuery(query));
+        promise->finish();
+        return future;
+    }
+    pool->start([promise, query] {
+        if (!promise->isCanceled())
+            promise->addResult(QNetworkProxyFactory::proxyForQuery(query));
+        promise->finish();
+    });
+    return future;
+}
+#endif // QT_CONFIG(future)
+
 #ifndef QT_NO_DEBUG_STREAM
 QDebug operator<<(QDebug debug, const QNetworkProxy &proxy)
 {
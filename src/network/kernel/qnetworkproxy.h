@@ -165,6 +165,8 @@ public:
     static void setApplicationProxyFactory(QNetworkProxyFactory *factory);
     static QList<QNetworkProxy> proxyForQuery(const QNetworkProxyQuery &query);
     static QList<QNetworkProxy> systemProxyForQuery(const QNetworkProxyQuery &query = QNetworkProxyQuery());
+    static int systemProxyCacheLifetime();
+    static void setSystemProxyCacheLifetime(int msecs);
 };
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -0,0 +1,49 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QNETWORKPROXY_P_H
+#define QNETWORKPROXY_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include <QtNetwork/qnetworkproxy.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
+
+#ifndef QT_NO_NETWORKPROXY
+
+QT_BEGIN_NAMESPACE
+
+// Lets QNetworkAccessManager look up the system proxies without blocking
+// the thread that starts the requests: evaluating a PAC script may take
+// hundreds of milliseconds.
+namespace QNetworkProxyLookup {
+
+// Whether QNetworkProxyFactory::proxyForQuery() would have to ask the
+// system for the proxies, rather than answer from the application proxy or
+// from the cache of system proxies
+Q_NETWORK_EXPORT bool needsSystemLookup(const QNetworkProxyQuery &query);
+#if QT_CONFIG(future)
+// Runs QNetworkProxyFactory::proxyForQuery() in a thread pool
+Q_NETWORK_EXPORT QFuture<QList<QNetworkProxy>> proxyForQuery(const QNetworkProxyQuery &query);
+#endif
+
+} // namespace QNetworkProxyLookup
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_NETWORKPROXY
+
+#endif // QNETWORKPROXY_P_H
@@ -430,6 +430,7 @@
 
 #include "qabstractsocket.h"
 #include "qabstractsocket_p.h"
+#include "qtcpsocket.h"
 
 #include "private/qhostinfo_p.h"
 
@@ -452,6 +453,8 @@
 
 #include <time.h>
 
+#include <algorithm>
+
 #define Q_CHECK_SOCKETENGINE(returnValue) do { \
     if (!d->socketEngine) { \
         return returnValue; \
@@ -486,6 +489,59 @@ static bool isProxyError(QAbstractSocket::SocketError error)
     }
 }
 
+// Alternates between the address families, starting with the family of the
+// first address, as the resolver sorted them by preference (RFC 8305,
+// section 4). A broken path for one family then only delays the connection
+// by the connection attempt delay.
+static QList<QHostAddress> interleavedByFamily(const QList<QHostAddress> &addresses)
+{
+    if (addresses.size() < 2)
+        return addresses;
+
+    const QAbstractSocket::NetworkLayerProtocol firstFamily = addresses.first().protocol();
+    QList<QHostAddress> first;
+    QList<QHostAddress> second;
+    for (const QHostAddress &address : addresses)
+        (address.protocol() == firstFamily ? first : second).append(address);
+
+    QList<QHostAddress> result;
+    result.reserve(addresses.size());
+    for (qsizetype i = 0; i < qMax(first.size(), second.size()); ++i) {
+        if (i < first.size())
+            result.append(first.at(i));
+        if (i < second.size())
+            result.append(second.at(i));
+    }
+    return result;
+}
+
+QAbstractSocketConnectionAttempt::QAbstractSocketConnectionAttempt(QAbstractSocketPrivate *d,
+                                                                   QAbstractSocketEngine *engine,
+                                                                   const QHostAddress &host)
+    : d(d), engine(engine), host(host)
+{
+    engine->setReceiver(this);
+}
+
+QAbstractSocketConnectionAttempt::~QAbstractSocketConnectionAttempt()
+{
+    if (engine) {
+        engine->close();
+        engine->disconnect();
+        delete engine;
+    }
+}
+
+QAbstractSocketEngine *QAbstractSocketConnectionAttempt::takeEngine()
+{
+    return std::exchange(engine, nullptr);
+}
+
+void QAbstractSocketConnectionAttempt::connectionNotification()
+{
+    d->connectionAttemptFinished(this);
+}
+
 /*! \internal
 
     Constructs a QAbstractSocketPrivate. Initializes all members.
@@ -524,6 +580,9 @@ void QAbstractSocketPrivate::resetSocketLayer()
     }
     if (connectTimer)
         connectTimer->stop();
+    if (attemptDelayTimer)
+        attemptDelayTimer->stop();
+    connectionAttempts.clear();
 }
 
 /*! \internal
@@ -552,7 +611,10 @@ bool QAbstractSocketPrivate::initSocketLayer(QAbstractSocket::NetworkLayerProtoc
     else protocolStr = "UnknownNetworkLayerProtocol"_L1;
 #endif
 
+    // Keep the connection attempts that the new one will race against
+    auto attempts = std::move(connectionAttempts);
     resetSocketLayer();
+    connectionAttempts = std::move(attempts);
     socketEngine = QAbstractSocketEngine::createSocketEngine(q->socketType(), proxyInUse, q);
     if (!socketEngine) {
         setError(QAbstractSocket::UnsupportedSocketOperationError,
@@ -759,11 +821,20 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
-
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    qint64 written;
+    const qint64 nextSize = writeBuffer.nextDataBlockSize();
+    if (socketType == QAbstractSocket::TcpSocket && nextSize < writeBuffer.size()) {
+        // The buffer consists of several chunks, for instance QByteArrays
+        // that were appended without copying. Hand them to the engine
+        // together; 256 of them are more than a socket buffer takes at once.
+        QVarLengthArray<QByteArrayView, 256> blocks(256);
+        blocks.resize(writeBuffer.readBlocks(blocks.data(), blocks.size()));
+        written = socketEngine->writeBlocks(blocks.constData(), blocks.size());
+    } else {
+        // Attempt to write it all in one chunk.
+        const char *ptr = writeBuffer.readPointer();
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -944,6 +1015,9 @@ void QAbstractSocketPrivate::_q_startConnecting(const QHostInfo &hostInfo)
     qDebug("QAbstractSocketPrivate::_q_startConnecting(hostInfo == %s)", s.toLatin1().constData());
 #endif
 
+    if (connectionAttemptDelay.count() > 0)
+        addresses = interleavedByFamily(addresses);
+
     // Try all addresses twice.
     addresses += addresses;
 
@@ -987,6 +1061,13 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
     Q_Q(QAbstractSocket);
     do {
         // Check for more pending addresses
+        if (addresses.isEmpty() && !connectionAttempts.empty()) {
+            // Wait for the most recent of the attempts that are still running
+            auto attempt = std::move(connectionAttempts.back());
+            connectionAttempts.pop_back();
+            adoptConnectionAttempt(std::move(attempt));
+            return;
+        }
         if (addresses.isEmpty()) {
 #if defined(QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocketPrivate::_q_connectToNextAddress(), all addresses failed.");
@@ -1064,6 +1145,23 @@ void QAbstractSocketPrivate::_q_connectToNextAddress()
         // Wait for a write notification that will eventually call
         // _q_testConnection().
         socketEngine->setWriteNotificationEnabled(true);
+
+        // Try the next address in parallel if this one does not connect
+        // within the connection attempt delay (RFC 8305, section 5).
+        if (!addresses.isEmpty() && addresses.first() != host && canRaceConnectionAttempts()
+            && std::none_of(connectionAttempts.cbegin(), connectionAttempts.cend(),
+                            [next = addresses.first()](const auto &attempt) {
+                                return attempt->host == next;
+                            })) {
+            if (!attemptDelayTimer) {
+                attemptDelayTimer = new QTimer(q);
+                attemptDelayTimer->setSingleShot(true);
+                QObject::connect(attemptDelayTimer, &QTimer::timeout, q,
+                                 [this] { startNextConnectionAttempt(); },
+                                 Qt::DirectConnection);
+            }
+            attemptDelayTimer->start(connectionAttemptDelay);
+        }
         break;
     } while (state != QAbstractSocket::ConnectedState);
 }
@@ -1077,6 +1175,8 @@ void QAbstractSocketPrivate::_q_testConnection()
 {
     if (connectTimer)
         connectTimer->stop();
+    if (attemptDelayTimer)
+        attemptDelayTimer->stop();
 
     if (socketEngine) {
         if (socketEngine->state() == QAbstractSocket::ConnectedState) {
@@ -1121,6 +1221,7 @@ void QAbstractSocketPrivate::_q_abortConnectionAttempt()
     connectTimer->stop();
 
     if (addresses.isEmpty()) {
+        connectionAttempts.clear();
         state = QAbstractSocket::UnconnectedState;
         setError(QAbstractSocket::SocketTimeoutError,
                  QAbstractSocket::tr("Connection timed out"));
@@ -1131,6 +1232,93 @@ void QAbstractSocketPrivate::_q_abortConnectionAttempt()
     }
 }
 
+/*! \internal
+
+    Returns \c true if connection attempts to several addresses can run in
+    parallel. This is only done for direct TCP connections that are driven
+    by an event loop.
+*/
+bool QAbstractSocketPrivate::canRaceConnectionAttempts() const
+{
+    Q_Q(const QAbstractSocket);
+    return connectionAttemptDelay.count() > 0
+            && q->socketType() == QAbstractSocket::TcpSocket
+            && cachedSocketDescriptor == -1
+#ifndef QT_NO_NETWORKPROXY
+            && proxyInUse.type() == QNetworkProxy::NoProxy
+#endif
+            && threadData.loadRelaxed()->hasEventDispatcher();
+}
+
+/*! \internal
+
+    Called when the connection attempt delay has passed without the current
+    attempt completing. Leaves that attempt running and starts connecting to
+    the next address; whichever connects first is used.
+*/
+void QAbstractSocketPrivate::startNextConnectionAttempt()
+{
+    if (state != QAbstractSocket::ConnectingState || !socketEngine
+        || socketEngine->state() != QAbstractSocket::ConnectingState || addresses.isEmpty()) {
+        return;
+    }
+
+#if defined(QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::startNextConnectionAttempt(), %s is slow to connect",
+           host.toString().toLatin1().constData());
+#endif
+    connectionAttempts.push_back(
+            std::make_unique<QAbstractSocketConnectionAttempt>(this, socketEngine, host));
+    socketEngine = nullptr;
+    _q_connectToNextAddress();
+}
+
+/*! \internal
+
+    Called when the earlier connection attempt \a attempt has either
+    connected or failed. If it connected, it replaces the current attempt.
+*/
+void QAbstractSocketPrivate::connectionAttemptFinished(QAbstractSocketConnectionAttempt *attempt)
+{
+    const auto it = std::find_if(connectionAttempts.begin(), connectionAttempts.end(),
+                                 [attempt](const auto &a) { return a.get() == attempt; });
+    if (it == connectionAttempts.end())
+        return;
+    std::unique_ptr<QAbstractSocketConnectionAttempt> finished = std::move(*it);
+    connectionAttempts.erase(it);
+
+    // A failed attempt is simply dropped, the others carry on
+    if (state != QAbstractSocket::ConnectingState
+        || finished->engine->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+#if defined(QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::connectionAttemptFinished(), %s won the race",
+           finished->host.toString().toLatin1().constData());
+#endif
+    adoptConnectionAttempt(std::move(finished));
+    _q_testConnection();
+}
+
+/*! \internal
+
+    Makes the engine of \a attempt the socket's engine, replacing the
+    current one. The other running attempts are kept.
+*/
+void QAbstractSocketPrivate::adoptConnectionAttempt(std::unique_ptr<QAbstractSocketConnectionAttempt> attempt)
+{
+    auto others = std::move(connectionAttempts);
+    resetSocketLayer();
+    connectionAttempts = std::move(others);
+
+    host = attempt->host;
+    socketEngine = attempt->takeEngine();
+    socketEngine->setReceiver(this);
+    if (connectTimer && socketEngine->state() == QAbstractSocket::ConnectingState)
+        connectTimer->start(DefaultConnectTimeout);
+}
+
 /*! \internal
 
     Reads data from the socket layer into the read buffer. Returns
@@ -1232,6 +1420,37 @@ void QAbstractSocketPrivate::emitBytesWritten(qint64 bytes, int channel)
     emit q->channelBytesWritten(channel, bytes);
 }
 
+/*! \internal
+
+    Lets QIODevice::transferTo() send data straight to the socket while
+    nothing is waiting in the write buffer. Only plain, directly connected
+    QTcpSockets qualify: subclasses such as QSslSocket transform the data
+    in writeData(), and proxy engines may frame it.
+*/
+int QAbstractSocketPrivate::nativeWriteHandle(qint64 *offset)
+{
+#ifdef Q_OS_UNIX
+    Q_Q(QAbstractSocket);
+    if (socketType != QAbstractSocket::TcpSocket || state != QAbstractSocket::ConnectedState
+            || !socketEngine || !socketEngine->inherits("QNativeSocketEngine")
+            || !writeBuffer.isEmpty() || q->metaObject() != &QTcpSocket::staticMetaObject) {
+        return -1;
+    }
+    *offset = -1;
+    return int(socketEngine->socketDescriptor());
+#else
+    Q_UNUSED(offset);
+    return -1;
+#endif
+}
+
+/*! \internal
+*/
+void QAbstractSocketPrivate::nativeWritten(qint64 size)
+{
+    emitBytesWritten(size);
+}
+
 /*! \internal
 
     Sets up the internal state after the connection has succeeded.
@@ -1240,6 +1459,11 @@ void QAbstractSocketPrivate::fetchConnectionParameters()
 {
     Q_Q(QAbstractSocket);
 
+    // The connection is established, stop the attempts racing it
+    connectionAttempts.clear();
+    if (attemptDelayTimer)
+        attemptDelayTimer->stop();
+
     peerName = hostName;
     if (socketEngine) {
         if (q->isReadable()) {
@@ -1722,6 +1946,49 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
     connectToHost(address.toString(), port, openMode);
 }
 
+/*!
+    \since 6.7
+
+    Returns the connection attempt delay.
+
+    \sa setConnectionAttemptDelay()
+*/
+std::chrono::milliseconds QAbstractSocket::connectionAttemptDelay() const
+{
+    Q_D(const QAbstractSocket);
+    return d->connectionAttemptDelay;
+}
+
+/*!
+    \since 6.7
+
+    Sets the connection attempt delay to \a delay.
+
+    When a host name resolves to several addresses, connectToHost() tries
+    them in turn, alternating between IPv6 and IPv4 addresses. If
+    connecting to an address has not succeeded or failed after the
+    connection attempt delay, a connection attempt to the next address is
+    started without abandoning the first; the socket uses whichever
+    connects first. This follows the "Happy Eyeballs" algorithm of
+    RFC 8305, and avoids long delays when one address family is broken on
+    the network.
+
+    The default is 250 milliseconds. A delay of zero disables this: the
+    addresses are then tried one after another, in the order in which they
+    were resolved.
+
+    Attempts only run in parallel for TCP sockets that connect without a
+    proxy and have an event loop; waitForConnected() tries the addresses
+    one after another.
+
+    \sa connectionAttemptDelay(), connectToHost()
+*/
+void QAbstractSocket::setConnectionAttemptDelay(std::chrono::milliseconds delay)
+{
+    Q_D(QAbstractSocket);
+    d->connectionAttemptDelay = qMax(delay, std::chrono::milliseconds(0));
+}
+
 /*!
     Returns the number of bytes that are waiting to be written. The
     bytes are written when control goes back to the event loop or
@@ -17,6 +17,8 @@
 #include <QtCore/qdebug.h>
 #endif
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -142,6 +144,9 @@ public:
     void connectToHost(const QHostAddress &address, quint16 port, OpenMode mode = ReadWrite);
     virtual void disconnectFromHost();
 
+    std::chrono::milliseconds connectionAttemptDelay() const;
+    void setConnectionAttemptDelay(std::chrono::milliseconds delay);
+
     bool isValid() const;
 
     qint64 bytesAvailable() const override;
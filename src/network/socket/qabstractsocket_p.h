@@ -24,9 +24,39 @@
 #include "private/qabstractsocketengine_p.h"
 #include "qnetworkproxy.h"
 
+#include <chrono>
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
+class QAbstractSocketPrivate;
+
+// A connection attempt that keeps running after the next address has been
+// tried in parallel (RFC 8305). It only listens for the outcome.
+class QAbstractSocketConnectionAttempt : public QAbstractSocketEngineReceiver
+{
+public:
+    QAbstractSocketConnectionAttempt(QAbstractSocketPrivate *d, QAbstractSocketEngine *engine,
+                                     const QHostAddress &host);
+    ~QAbstractSocketConnectionAttempt() override;
+
+    QAbstractSocketEngine *takeEngine();
+
+    void readNotification() override {}
+    void writeNotification() override {}
+    void closeNotification() override {}
+    void exceptionNotification() override {}
+    void connectionNotification() override;
+#ifndef QT_NO_NETWORKPROXY
+    void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) override {}
+#endif
+
+    QAbstractSocketPrivate *d;
+    QAbstractSocketEngine *engine;
+    QHostAddress host;
+};
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
@@ -60,6 +90,11 @@ public:
     void _q_testConnection();
     void _q_abortConnectionAttempt();
 
+    bool canRaceConnectionAttempts() const;
+    void startNextConnectionAttempt();
+    void connectionAttemptFinished(QAbstractSocketConnectionAttempt *attempt);
+    void adoptConnectionAttempt(std::unique_ptr<QAbstractSocketConnectionAttempt> attempt);
+
     bool emittedReadyRead = false;
     bool emittedBytesWritten = false;
 
@@ -104,6 +139,9 @@ public:
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
+    int nativeWriteHandle(qint64 *offset) override;
+    void nativeWritten(qint64 size) override;
+
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
@@ -113,6 +151,11 @@ public:
 
     QTimer *connectTimer = nullptr;
 
+    // Earlier connection attempts still running next to socketEngine
+    std::vector<std::unique_ptr<QAbstractSocketConnectionAttempt>> connectionAttempts;
+    QTimer *attemptDelayTimer = nullptr;
+    std::chrono::milliseconds connectionAttemptDelay{250};
+
     int hostLookupId = -1;
 
     QAbstractSocket::SocketType socketType = QAbstractSocket::UnknownSocketType;
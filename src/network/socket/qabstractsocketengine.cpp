@@ -233,6 +233,77 @@ int QAbstractSocketEngine::outboundStreamCount() const
     return d_func()->outboundStreamCount;
 }
 
+/*!
+    Writes the \a count blocks of data in \a blocks to the socket, in
+    order, and returns the number of bytes written, or -1 if an error
+    occurred before anything was written.
+
+    This implementation calls write() for each block until one of them is
+    not written completely; engines that can write several blocks at once
+    reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeBlocks(const QByteArrayView *blocks, qsizetype count)
+{
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 written = write(blocks[i].data(), blocks[i].size());
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < blocks[i].size())
+            break;
+    }
+    return total;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count pending datagrams of at most \a maxSize bytes each
+    into \a data, and their IP header fields into \a headers according to
+    \a options. Returns the number of datagrams read, or the negative result
+    of readDatagram() if not even the first one could be read.
+
+    This implementation calls readDatagram() for each datagram; engines
+    that can read several datagrams at once reimplement it.
+*/
+qint64 QAbstractSocketEngine::readDatagrams(QByteArray *data, QIpPacketHeader *headers, qint64 count,
+                                            qint64 maxSize, PacketHeaderOptions options)
+{
+    QByteArray buffer(maxSize, Qt::Uninitialized);
+    qint64 read = 0;
+    for (; read < count; ++read) {
+        if (read && !hasPendingDatagrams())
+            break;
+        const qint64 size = readDatagram(buffer.data(), maxSize, headers + read, options);
+        if (size < 0)
+            return read ? read : size;
+        data[read] = QByteArray(buffer.constData(), size);
+    }
+    return read;
+}
+
+/*!
+    Writes the \a count datagrams in \a data to the destinations in
+    \a headers. Returns the number of datagrams written, or the negative
+    result of writeDatagram() if not even the first one could be written.
+
+    This implementation calls writeDatagram() for each datagram; engines
+    that can write several datagrams at once reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeDatagrams(const QByteArray *data, const QIpPacketHeader *headers,
+                                             qint64 count)
+{
+    qint64 written = 0;
+    for (; written < count; ++written) {
+        const qint64 sent = writeDatagram(data[written].constData(), data[written].size(),
+                                          headers[written]);
+        if (sent < 0)
+            return written ? written : sent;
+    }
+    return written;
+}
+#endif // QT_NO_UDPSOCKET
+
 QT_END_NAMESPACE
 
 #include "moc_qabstractsocketengine_p.cpp"
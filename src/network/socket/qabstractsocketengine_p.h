@@ -71,7 +71,8 @@ public:
         ReceivePacketInformation,
         ReceiveHopLimit,
         MaxStreamsSocketOption,
-        PathMtuInformation
+        PathMtuInformation,
+        PortLoadBalancing
     };
 
     enum PacketHeaderOption {
@@ -105,6 +106,7 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeBlocks(const QByteArrayView *blocks, qsizetype count);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -118,6 +120,11 @@ public:
 
     virtual bool hasPendingDatagrams() const = 0;
     virtual qint64 pendingDatagramSize() const = 0;
+
+    virtual qint64 readDatagrams(QByteArray *data, QIpPacketHeader *headers, qint64 count,
+                                 qint64 maxSize, PacketHeaderOptions options = WantNone);
+    virtual qint64 writeDatagrams(const QByteArray *data, const QIpPacketHeader *headers,
+                                  qint64 count);
 #endif // QT_NO_UDPSOCKET
 
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
@@ -74,6 +74,12 @@ using namespace Qt::StringLiterals;
     The listening socket will be created in the abstract namespace. This flag is specific to Linux.
     In case of other platforms, for the sake of code portability, this flag is equivalent
     to WorldAccessOption.
+    \value SequentialPacketOption
+    The listening socket will be a \c SOCK_SEQPACKET socket, which keeps the
+    boundaries of the messages, and the clients must connect with
+    QLocalSocket::SequentialPacketOption. This flag is supported on Linux,
+    Android and FreeBSD (since 6.7); listen() fails on other Unix systems,
+    and the flag is ignored on Windows.
 
     \sa socketOptions
 */
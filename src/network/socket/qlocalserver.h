@@ -33,7 +33,8 @@ public:
         GroupAccessOption = 0x2,
         OtherAccessOption = 0x4,
         WorldAccessOption = 0x7,
-        AbstractNamespaceOption = 0x8
+        AbstractNamespaceOption = 0x8,
+        SequentialPacketOption = 0x10
     };
     Q_ENUM(SocketOption)
     Q_DECLARE_FLAGS(SocketOptions, SocketOption)
@@ -94,7 +94,9 @@ bool QLocalServerPrivate::listen(const QString &requestedServerName)
     }
 
     // create the unix socket
-    listenSocket = qt_safe_socket(PF_UNIX, SOCK_STREAM, 0);
+    const int type = socketOptions.value().testFlag(QLocalServer::SequentialPacketOption)
+            ? SOCK_SEQPACKET : SOCK_STREAM;
+    listenSocket = qt_safe_socket(PF_UNIX, type, 0);
     if (-1 == listenSocket) {
         setError("QLocalServer::listen"_L1);
         closeServer();
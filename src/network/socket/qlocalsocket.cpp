@@ -40,6 +40,14 @@ QT_BEGIN_NAMESPACE
     \value AbstractNamespaceOption
     The socket will try to connect to an abstract address. This flag is specific
     to Linux and Android. On other platforms is ignored.
+    \value SequentialPacketOption
+    The socket will use a \c SOCK_SEQPACKET socket, which keeps the
+    boundaries of the messages: each call to write() sends one message, and
+    the receiver reads them with readMessage(). The server must have been
+    set up with QLocalServer::SequentialPacketOption. This flag is supported
+    on Linux, Android and FreeBSD (since 6.7); connecting fails with
+    UnsupportedSocketOperationError on other Unix systems, and the flag is
+    ignored on Windows, where readMessage() returns nothing.
 
     \sa socketOptions
 */
@@ -492,6 +500,102 @@ bool QLocalSocket::isSequential() const
     return true;
 }
 
+/*!
+    \fn bool QLocalSocket::writeFileDescriptors(const QList<int> &descriptors)
+    \since 6.7
+
+    Passes \a descriptors to the peer along with the next byte written to
+    the socket, so that both processes can use the same open files, for
+    instance to share a memory buffer without copying it. The socket keeps
+    copies of the descriptors until then, so the caller can close its own
+    right away.
+
+    Returns \c false if the socket is not connected, if the descriptors
+    could not be copied or if too many of them would be passed with one
+    byte. This function is supported on Unix only, where at most 253
+    descriptors are passed with one byte; on other platforms it always
+    returns \c false.
+
+    \sa readFileDescriptors()
+*/
+
+/*!
+    \fn QList<int> QLocalSocket::readFileDescriptors()
+    \since 6.7
+
+    Returns the file descriptors that the peer passed with
+    writeFileDescriptors() and that arrived with the data available so far,
+    and forgets them: the caller owns them and must close them. Descriptors
+    that are not read are closed when the socket is.
+
+    This function is supported on Unix only.
+
+    \sa writeFileDescriptors()
+*/
+
+/*!
+    \fn bool QLocalSocket::hasPendingMessages() const
+    \since 6.7
+
+    Returns \c true if a whole message can be read with readMessage(). The
+    socket must have been connected with SequentialPacketOption.
+
+    \sa pendingMessageSize(), readMessage()
+*/
+
+/*!
+    \fn qint64 QLocalSocket::pendingMessageSize() const
+    \since 6.7
+
+    Returns the size of the next message readMessage() returns, or -1 if
+    there is none.
+
+    \sa hasPendingMessages(), readMessage()
+*/
+
+/*!
+    \fn QByteArray QLocalSocket::readMessage()
+    \since 6.7
+
+    Reads the next message the peer sent with one call to write() on a
+    socket connected with SequentialPacketOption, or returns an empty
+    QByteArray if there is none.
+
+    Don't mix this function with read() and other functions reading a
+    number of bytes, and don't limit the readBufferSize(): messages would
+    be truncated.
+
+    \sa hasPendingMessages(), pendingMessageSize()
+*/
+
+#if defined(QT_LOCALSOCKET_TCP) || defined(Q_OS_WIN)
+bool QLocalSocket::writeFileDescriptors(const QList<int> &descriptors)
+{
+    Q_UNUSED(descriptors);
+    return false;
+}
+
+QList<int> QLocalSocket::readFileDescriptors()
+{
+    return QList<int>();
+}
+
+bool QLocalSocket::hasPendingMessages() const
+{
+    return false;
+}
+
+qint64 QLocalSocket::pendingMessageSize() const
+{
+    return -1;
+}
+
+QByteArray QLocalSocket::readMessage()
+{
+    return QByteArray();
+}
+#endif
+
 /*!
     \enum QLocalSocket::LocalSocketError
 
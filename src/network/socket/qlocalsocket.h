@@ -51,7 +51,8 @@ public:
 
     enum SocketOption {
         NoOptions = 0x00,
-        AbstractNamespaceOption = 0x01
+        AbstractNamespaceOption = 0x01,
+        SequentialPacketOption = 0x02
     };
     Q_DECLARE_FLAGS(SocketOptions, SocketOption)
     Q_FLAG(SocketOptions)
@@ -89,6 +90,13 @@ public:
     SocketOptions socketOptions() const;
     QBindable<SocketOptions> bindableSocketOptions();
 
+    bool writeFileDescriptors(const QList<int> &descriptors);
+    QList<int> readFileDescriptors();
+
+    bool hasPendingMessages() const;
+    qint64 pendingMessageSize() const;
+    QByteArray readMessage();
+
     LocalSocketState state() const;
     bool waitForBytesWritten(int msecs = 30000) override;
     bool waitForConnected(int msecs = 30000);
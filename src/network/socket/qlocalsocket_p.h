@@ -41,6 +41,8 @@ struct sockaddr_un;
 
 QT_BEGIN_NAMESPACE
 
+class QNativeSocketEngine;
+
 #if !defined(Q_OS_WIN) || defined(QT_LOCALSOCKET_TCP)
 
 class QLocalUnixSocket : public QTcpSocket
@@ -118,11 +120,18 @@ public:
     void describeSocket(qintptr socketDescriptor);
     static bool parseSockaddr(const sockaddr_un &addr, uint len,
                               QString &fullServerName, QString &serverName, bool &abstractNamespace);
+    QNativeSocketEngine *socketEngine() const;
+    void setUpSocketEngine();
+    void discardReceivedData();
     QSocketNotifier *delayConnect;
     QTimer *connectTimer;
     QString connectingName;
     int connectingSocket;
     QIODevice::OpenMode connectingOpenMode;
+    // filled by the socket engine
+    QList<int> receivedFileDescriptors;
+    QList<qint64> receivedPacketSizes;
+    bool sequentialPackets = false;
 #endif
     QLocalSocket::LocalSocketState state;
     QString serverName;
@@ -4,6 +4,8 @@
 #include "qlocalsocket.h"
 #include "qlocalsocket_p.h"
 #include "qnet_unix_p.h"
+#include "private/qabstractsocket_p.h"
+#include "private/qnativesocketengine_p.h"
 
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -17,6 +19,8 @@
 #include <qelapsedtimer.h>
 #include <qstringconverter.h>
 
+#include <utility>
+
 #ifdef Q_OS_VXWORKS
 #  include <selectLib.h>
 #endif
@@ -46,7 +50,7 @@ static QLocalSocket::SocketOptions optionsForPlatform(QLocalSocket::SocketOption
     // For OS that does not support abstract namespace the AbstractNamespaceOption
     // option is cleared.
     if (!PlatformSupportsAbstractNamespace)
-        return QLocalSocket::NoOptions;
+        return srcOptions.setFlag(QLocalSocket::AbstractNamespaceOption, false);
     return srcOptions;
 }
 }
@@ -228,7 +232,9 @@ void QLocalSocket::connectToServer(OpenMode openMode)
     }
 
     // create the socket
-    if (-1 == (d->connectingSocket = qt_safe_socket(PF_UNIX, SOCK_STREAM, 0, O_NONBLOCK))) {
+    const int type = d->socketOptions.value().testFlag(SequentialPacketOption)
+            ? SOCK_SEQPACKET : SOCK_STREAM;
+    if (-1 == (d->connectingSocket = qt_safe_socket(PF_UNIX, type, 0, O_NONBLOCK))) {
         d->setErrorAndEmit(UnsupportedSocketOperationError, "QLocalSocket::connectToServer"_L1);
         return;
     }
@@ -322,6 +328,7 @@ void QLocalSocketPrivate::_q_connectToSocket()
     fullServerName = connectingPathName;
     if (unixSocket.setSocketDescriptor(connectingSocket,
         QAbstractSocket::ConnectedState, connectingOpenMode)) {
+        setUpSocketEngine();
         q->QIODevice::open(connectingOpenMode);
         q->emit connected();
     } else {
@@ -355,12 +362,22 @@ bool QLocalSocket::setSocketDescriptor(qintptr socketDescriptor,
     QIODevice::open(openMode);
     d->state = socketState;
     d->describeSocket(socketDescriptor);
-    return d->unixSocket.setSocketDescriptor(socketDescriptor,
-                                             newSocketState, openMode);
+    if (!d->unixSocket.setSocketDescriptor(socketDescriptor, newSocketState, openMode))
+        return false;
+    d->setUpSocketEngine();
+    return true;
 }
 
 void QLocalSocketPrivate::describeSocket(qintptr socketDescriptor)
 {
+    int type = 0;
+    QT_SOCKOPTLEN_T typeSize = sizeof(type);
+    if (::getsockopt(socketDescriptor, SOL_SOCKET, SO_TYPE, &type, &typeSize) == 0) {
+        QLocalSocket::SocketOptions options = socketOptions.value();
+        socketOptions = options.setFlag(QLocalSocket::SequentialPacketOption,
+                                        type == SOCK_SEQPACKET);
+    }
+
     bool abstractAddress = false;
 
     struct ::sockaddr_un addr;
@@ -417,6 +434,39 @@ bool QLocalSocketPrivate::parseSockaddr(const struct ::sockaddr_un &addr,
     return true;
 }
 
+QNativeSocketEngine *QLocalSocketPrivate::socketEngine() const
+{
+    auto socketPrivate = static_cast<const QAbstractSocketPrivate *>(QObjectPrivate::get(&unixSocket));
+    return qobject_cast<QNativeSocketEngine *>(socketPrivate->socketEngine);
+}
+
+/*!
+    \internal
+
+    Makes the socket engine of a newly connected socket receive file
+    descriptors, and packet sizes in SequentialPacketOption mode, into this
+    object, so that they stay available after the engine was deleted on
+    disconnection.
+*/
+void QLocalSocketPrivate::setUpSocketEngine()
+{
+    sequentialPackets = socketOptions.value().testFlag(QLocalSocket::SequentialPacketOption);
+    if (QNativeSocketEngine *engine = socketEngine()) {
+        engine->setReceivedDataSinks(&receivedFileDescriptors,
+                                     sequentialPackets ? &receivedPacketSizes : nullptr);
+    }
+}
+
+void QLocalSocketPrivate::discardReceivedData()
+{
+    if (QNativeSocketEngine *engine = socketEngine())
+        engine->setReceivedDataSinks(nullptr, nullptr);
+    for (int descriptor : std::as_const(receivedFileDescriptors))
+        qt_safe_close(descriptor);
+    receivedFileDescriptors.clear();
+    receivedPacketSizes.clear();
+}
+
 void QLocalSocketPrivate::_q_abortConnectionAttempt()
 {
     Q_Q(QLocalSocket);
@@ -465,9 +515,77 @@ qint64 QLocalSocket::skipData(qint64 maxSize)
 qint64 QLocalSocket::writeData(const char *data, qint64 c)
 {
     Q_D(QLocalSocket);
+    if (d->sequentialPackets && c > 0) {
+        // each write() is sent as one packet
+        if (QNativeSocketEngine *engine = d->socketEngine()) {
+            engine->addPacketBoundary(engine->totalBytesWritten() + d->unixSocket.bytesToWrite()
+                                      + c);
+        }
+    }
     return d->unixSocket.writeData(data, c);
 }
 
+bool QLocalSocket::writeFileDescriptors(const QList<int> &descriptors)
+{
+    Q_D(QLocalSocket);
+    QNativeSocketEngine *engine = d->socketEngine();
+    if (!engine || d->state != ConnectedState) {
+        qWarning("QLocalSocket::writeFileDescriptors: The socket is not connected");
+        return false;
+    }
+    if (descriptors.isEmpty())
+        return true;
+
+    // the caller may close its descriptors before they are sent
+    QList<int> copies;
+    copies.reserve(descriptors.size());
+    auto closeCopies = [&copies] {
+        for (int copy : std::as_const(copies))
+            qt_safe_close(copy);
+    };
+    for (int descriptor : descriptors) {
+        const int copy = qt_safe_dup(descriptor);
+        if (copy == -1) {
+            closeCopies();
+            return false;
+        }
+        copies.append(copy);
+    }
+
+    const qint64 position = engine->totalBytesWritten() + d->unixSocket.bytesToWrite();
+    if (!engine->attachFileDescriptors(position, copies)) {
+        closeCopies();
+        return false;
+    }
+    return true;
+}
+
+QList<int> QLocalSocket::readFileDescriptors()
+{
+    Q_D(QLocalSocket);
+    return std::exchange(d->receivedFileDescriptors, {});
+}
+
+bool QLocalSocket::hasPendingMessages() const
+{
+    Q_D(const QLocalSocket);
+    return !d->receivedPacketSizes.isEmpty();
+}
+
+qint64 QLocalSocket::pendingMessageSize() const
+{
+    Q_D(const QLocalSocket);
+    return d->receivedPacketSizes.isEmpty() ? -1 : d->receivedPacketSizes.constFirst();
+}
+
+QByteArray QLocalSocket::readMessage()
+{
+    Q_D(QLocalSocket);
+    if (d->receivedPacketSizes.isEmpty())
+        return QByteArray();
+    return read(d->receivedPacketSizes.takeFirst());
+}
+
 void QLocalSocket::abort()
 {
     Q_D(QLocalSocket);
@@ -498,6 +616,7 @@ void QLocalSocket::close()
     Q_D(QLocalSocket);
 
     QIODevice::close();
+    d->discardReceivedData();
     d->unixSocket.close();
     d->cancelDelayedConnect();
     if (d->connectingSocket != -1)
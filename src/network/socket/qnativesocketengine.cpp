@@ -866,6 +866,57 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count datagrams of at most \a maxSize bytes each into
+    \a data and their headers into \a headers. Where the operating system
+    supports it, the datagrams are read with as few system calls as
+    possible. Returns the number of datagrams read, or -1 if an error
+    occurred before the first one.
+
+    \sa readDatagram(), writeDatagrams()
+*/
+qint64 QNativeSocketEngine::readDatagrams(QByteArray *data, QIpPacketHeader *headers, qint64 count,
+                                          qint64 maxSize, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#if QT_CONFIG(sendmmsg)
+    return d->nativeReceiveDatagrams(data, headers, count, maxSize, options);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::readDatagrams(data, headers, count, maxSize, options);
+#endif
+}
+
+/*!
+    Writes the \a count datagrams in \a data to the destinations in
+    \a headers. Where the operating system supports it, the datagrams are
+    written with as few system calls as possible. Returns the number of
+    datagrams written, or -1 if an error occurred before the first one.
+
+    \sa writeDatagram(), readDatagrams()
+*/
+qint64 QNativeSocketEngine::writeDatagrams(const QByteArray *data, const QIpPacketHeader *headers,
+                                           qint64 count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#if QT_CONFIG(sendmmsg)
+    return d->nativeSendDatagrams(data, headers, count);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::writeDatagrams(data, headers, count);
+#endif
+}
+#endif // QT_NO_UDPSOCKET
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -882,6 +933,87 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+#ifndef Q_OS_WIN
+/*!
+    Writes the \a count blocks in \a blocks to the socket with a single
+    system call, and returns the number of bytes written, or -1 if an error
+    occurred.
+*/
+qint64 QNativeSocketEngine::writeBlocks(const QByteArrayView *blocks, qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeBlocks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeBlocks(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteBlocks(blocks, count);
+}
+
+/*!
+    Returns the number of bytes written to the socket since it was
+    initialized.
+*/
+qint64 QNativeSocketEngine::totalBytesWritten() const
+{
+    Q_D(const QNativeSocketEngine);
+    return d->totalBytesWritten;
+}
+
+/*!
+    Sends \a descriptors with SCM_RIGHTS along with the byte at \a position
+    in the stream of bytes written to this Unix domain socket, taking
+    ownership of them: they are closed once sent, or when the socket is
+    closed. Writes stop before \a position until then.
+
+    Returns \c false, without taking ownership, if that would attach more
+    than MaxFileDescriptorsPerWrite descriptors to one byte.
+*/
+bool QNativeSocketEngine::attachFileDescriptors(qint64 position, QList<int> descriptors)
+{
+    Q_D(QNativeSocketEngine);
+    Q_ASSERT(position >= d->totalBytesWritten);
+    auto &pending = d->pendingFileDescriptors;
+    if (!pending.isEmpty() && pending.constLast().position == position) {
+        if (pending.constLast().descriptors.size() + descriptors.size()
+                > MaxFileDescriptorsPerWrite) {
+            return false;
+        }
+        pending.last().descriptors += descriptors;
+        return true;
+    }
+    if (descriptors.size() > MaxFileDescriptorsPerWrite)
+        return false;
+    Q_ASSERT(pending.isEmpty() || pending.constLast().position < position);
+    pending.append({ position, std::move(descriptors) });
+    return true;
+}
+
+/*!
+    Makes writes stop at \a position in the stream of bytes written to the
+    socket, so that the bytes before and after it are never sent with the
+    same system call. On a SOCK_SEQPACKET socket, this ends a packet.
+*/
+void QNativeSocketEngine::addPacketBoundary(qint64 position)
+{
+    Q_D(QNativeSocketEngine);
+    Q_ASSERT(d->packetBoundaries.isEmpty() || d->packetBoundaries.constLast() < position);
+    d->packetBoundaries.append(position);
+}
+
+/*!
+    Makes read() receive the file descriptors passed with SCM_RIGHTS on
+    this Unix domain socket and append them to \a descriptors, which takes
+    ownership of them, and append the size of each packet read to
+    \a packetSizes, if not \nullptr. The lists must outlive the engine, or
+    this function must be called again with \nullptr.
+*/
+void QNativeSocketEngine::setReceivedDataSinks(QList<int> *descriptors,
+                                               QList<qint64> *packetSizes)
+{
+    Q_D(QNativeSocketEngine);
+    d->receivedFileDescriptors = descriptors;
+    d->receivedPacketSizes = packetSizes;
+}
+#endif
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -947,6 +1079,11 @@ void QNativeSocketEngine::close()
     d->peerPort = 0;
     d->peerAddress.clear();
     d->inboundStreamCount = d->outboundStreamCount = 0;
+#ifndef Q_OS_WIN
+    d->discardPendingFileDescriptors();
+    d->packetBoundaries.clear();
+    d->totalBytesWritten = 0;
+#endif
     if (d->readNotifier) {
         qDeleteInEventHandler(d->readNotifier);
         d->readNotifier = nullptr;
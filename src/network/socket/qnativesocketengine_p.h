@@ -123,6 +123,9 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+#ifndef Q_OS_WIN
+    qint64 writeBlocks(const QByteArrayView *blocks, qsizetype count) override;
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -141,6 +144,12 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#ifndef QT_NO_UDPSOCKET
+    qint64 readDatagrams(QByteArray *data, QIpPacketHeader *headers, qint64 count, qint64 maxSize,
+                         PacketHeaderOptions options = WantNone) override;
+    qint64 writeDatagrams(const QByteArray *data, const QIpPacketHeader *headers,
+                          qint64 count) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
@@ -167,6 +176,16 @@ public:
     bool isExceptionNotificationEnabled() const override;
     void setExceptionNotificationEnabled(bool enable) override;
 
+#ifndef Q_OS_WIN
+    // For Unix domain sockets, used by QLocalSocket. Positions count the
+    // bytes written to the socket since it was initialized.
+    static constexpr qsizetype MaxFileDescriptorsPerWrite = 253;
+    qint64 totalBytesWritten() const;
+    bool attachFileDescriptors(qint64 position, QList<int> descriptors);
+    void addPacketBoundary(qint64 position);
+    void setReceivedDataSinks(QList<int> *descriptors, QList<qint64> *packetSizes);
+#endif
+
 public Q_SLOTS:
     // non-virtual override;
     void connectionNotification();
@@ -144,8 +144,39 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(sendmmsg)
+    // The most datagrams nativeReceiveDatagrams() and nativeSendDatagrams()
+    // pass to one system call
+    static constexpr qint64 MaxDatagramsPerCall = 64;
+    qint64 nativeReceiveDatagrams(QByteArray *data, QIpPacketHeader *headers, qint64 count,
+                                  qint64 maxSize, QAbstractSocketEngine::PacketHeaderOptions options);
+    qint64 nativeSendDatagrams(const QByteArray *data, const QIpPacketHeader *headers, qint64 count);
+    QByteArray datagramBuffer;
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifndef Q_OS_WIN
+    qint64 nativeWriteBlocks(const QByteArrayView *blocks, qsizetype count);
+
+    // Descriptors to send with SCM_RIGHTS along with the byte at position,
+    // owned until then
+    struct PendingFileDescriptors
+    {
+        qint64 position;
+        QList<int> descriptors;
+    };
+    QList<PendingFileDescriptors> pendingFileDescriptors;
+    // Positions that one write must not cross, so that each packet of a
+    // SOCK_SEQPACKET socket is sent with one system call
+    QList<qint64> packetBoundaries;
+    qint64 totalBytesWritten = 0;
+    // Where nativeRead() stores the descriptors received with SCM_RIGHTS
+    // and the sizes of the packets read; nativeRead() uses recvmsg() only
+    // if the former is set
+    QList<int> *receivedFileDescriptors = nullptr;
+    QList<qint64> *receivedPacketSizes = nullptr;
+    void discardPendingFileDescriptors();
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
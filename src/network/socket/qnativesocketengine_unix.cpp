@@ -14,6 +14,8 @@
 #ifdef Q_OS_WASM
 #include <private/qeventdispatcher_wasm_p.h>
 #endif
+#include <limits.h>
+#include <limits>
 #include <time.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -179,6 +181,16 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
 #endif
         }
         break;
+
+    case QNativeSocketEngine::PortLoadBalancing:
+#if defined(SO_REUSEPORT_LB)
+        n = SO_REUSEPORT_LB;
+#elif defined(SO_REUSEPORT) && defined(Q_OS_LINUX)
+        // Elsewhere, SO_REUSEPORT does not spread connections over the
+        // sockets sharing the port
+        n = SO_REUSEPORT;
+#endif
+        break;
     }
 }
 
@@ -876,18 +888,91 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
-{
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+// The size, in quintptrs, of the control buffer for the ancillary data
+// nativeReceiveDatagram() and nativeReceiveDatagrams() can parse
+static constexpr size_t ReceiveControlBufferSize =
+        (CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
-                   + CMSG_SPACE(sizeof(sockaddr_dl))
+         + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
 #ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+         + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+         + sizeof(quintptr) - 1) / sizeof(quintptr);
+
+static void qt_socket_parseDatagramHeader(const qt_sockaddr *aa, msghdr *msg, quint16 localPort,
+                                          QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
+        }
+
+#ifdef IP_PKTINFO
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
+#else
+#  ifdef IP_RECVDSTADDR
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
+#  endif
+#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
+#  endif
+#endif
+
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
+
+#ifndef QT_NO_SCTP
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+
+            header->streamNumber = int(rcvInfo->sinfo_stream);
+        }
+#endif
+    }
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    // we use quintptr to force the alignment
+    quintptr cbuf[ReceiveControlBufferSize];
 
     struct msghdr msg;
     struct iovec vec;
@@ -935,69 +1020,7 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
             header->clear();
     } else if (options != QAbstractSocketEngine::WantNone) {
         Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
-
-#ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
-#else
-#  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
-#  endif
-#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
-#  endif
-#endif
-
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
-
-#ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
-
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
-        }
+        qt_socket_parseDatagramHeader(&aa, &msg, localPort, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1139,6 +1162,180 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#if QT_CONFIG(sendmmsg)
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagrams(QByteArray *data, QIpPacketHeader *headers,
+                                                          qint64 count, qint64 maxSize,
+                                                          QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    struct Message
+    {
+        // we use quintptr to force the alignment
+        quintptr cbuf[ReceiveControlBufferSize];
+        qt_sockaddr aa;
+        iovec vec;
+    };
+
+    const bool wantSender = options & QAbstractSocketEngine::WantDatagramSender;
+    const bool wantControl = options & (QAbstractSocketEngine::WantDatagramHopLimit
+                                        | QAbstractSocketEngine::WantDatagramDestination
+                                        | QAbstractSocketEngine::WantStreamNumber);
+    // we need to receive at least one byte, even if our user isn't interested in it
+    const qint64 slotSize = qMax(maxSize, qint64(1));
+    // Don't keep more than 1 MB around for large datagrams
+    const qint64 maxBatch = qBound(qint64(1), (1024 * 1024) / slotSize, MaxDatagramsPerCall);
+
+    qint64 received = 0;
+    while (received < count) {
+        const qint64 batch = qMin(count - received, maxBatch);
+        if (datagramBuffer.size() < batch * slotSize)
+            datagramBuffer.resize(batch * slotSize);
+
+        QVarLengthArray<mmsghdr, 16> msgs(batch);
+        QVarLengthArray<Message, 16> messages(batch);
+        memset(msgs.data(), 0, batch * sizeof(mmsghdr));
+        for (qint64 i = 0; i < batch; ++i) {
+            Message &m = messages[i];
+            msghdr &msg = msgs[i].msg_hdr;
+            m.vec.iov_base = datagramBuffer.data() + i * slotSize;
+            m.vec.iov_len = slotSize;
+            msg.msg_iov = &m.vec;
+            msg.msg_iovlen = 1;
+            if (wantSender) {
+                memset(&m.aa, 0, sizeof(m.aa));
+                msg.msg_name = &m.aa;
+                msg.msg_namelen = sizeof(m.aa);
+            }
+            if (wantControl) {
+                msg.msg_control = m.cbuf;
+                msg.msg_controllen = sizeof(m.cbuf);
+            }
+        }
+
+        const int result = qt_safe_recvmmsg(socketDescriptor, msgs.data(), uint(batch), 0);
+        if (result < 0) {
+            // Report what was read so far; a persistent error shows up
+            // again on the next read.
+            if (received)
+                break;
+            switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+            case EWOULDBLOCK:
+#endif
+            case EAGAIN:
+                // No datagram was available for reading
+                return -2;
+            case ECONNREFUSED:
+                setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+                break;
+            default:
+                setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+            }
+            return -1;
+        }
+
+        for (int i = 0; i < result; ++i) {
+            const char *ptr = datagramBuffer.constData() + i * slotSize;
+            data[received + i] = QByteArray(ptr, maxSize ? qMin(qint64(msgs[i].msg_len), maxSize) : 0);
+            if (options != QAbstractSocketEngine::WantNone)
+                qt_socket_parseDatagramHeader(&messages[i].aa, &msgs[i].msg_hdr, localPort,
+                                              &headers[received + i]);
+        }
+        received += result;
+        // A short batch means the receive queue has been drained
+        if (result < batch)
+            break;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%lli, %lli) == %lli",
+           count, maxSize, received);
+#endif
+
+    return received;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagrams(const QByteArray *data,
+                                                       const QIpPacketHeader *headers, qint64 count)
+{
+    // Datagrams that need ancillary data go through nativeSendDatagram(),
+    // the others are sent in batches.
+    const auto needsControlMessage = [](const QIpPacketHeader &header) {
+        return header.hopLimit != -1 || header.ifindex != 0 || !header.senderAddress.isNull()
+                || header.streamNumber != -1;
+    };
+
+    qint64 sent = 0;
+    while (sent < count) {
+        if (needsControlMessage(headers[sent])) {
+            const qint64 result = nativeSendDatagram(data[sent].constData(), data[sent].size(),
+                                                     headers[sent]);
+            if (result < 0)
+                return sent ? sent : result;
+            ++sent;
+            continue;
+        }
+
+        qint64 batch = 1;
+        while (batch < MaxDatagramsPerCall && sent + batch < count
+               && !needsControlMessage(headers[sent + batch])) {
+            ++batch;
+        }
+
+        QVarLengthArray<mmsghdr, 16> msgs(batch);
+        QVarLengthArray<iovec, 16> vecs(batch);
+        QVarLengthArray<qt_sockaddr, 16> addresses(batch);
+        memset(msgs.data(), 0, batch * sizeof(mmsghdr));
+        for (qint64 i = 0; i < batch; ++i) {
+            const QByteArray &datagram = data[sent + i];
+            const QIpPacketHeader &header = headers[sent + i];
+            msghdr &msg = msgs[i].msg_hdr;
+            vecs[i].iov_base = const_cast<char *>(datagram.constData());
+            vecs[i].iov_len = datagram.size();
+            msg.msg_iov = &vecs[i];
+            msg.msg_iovlen = 1;
+            if (header.destinationPort != 0) {
+                memset(&addresses[i], 0, sizeof(qt_sockaddr));
+                msg.msg_name = &addresses[i].a;
+                setPortAndAddress(header.destinationPort, header.destinationAddress,
+                                  &addresses[i], &msg.msg_namelen);
+            }
+        }
+
+        const int result = qt_safe_sendmmsg(socketDescriptor, msgs.data(), uint(batch), 0);
+        if (result < 0) {
+            // The datagram that failed is the first one of the next write
+            if (sent)
+                break;
+            switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+            case EWOULDBLOCK:
+#endif
+            case EAGAIN:
+                return -2;
+            case EMSGSIZE:
+                setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+                break;
+            case ECONNRESET:
+                setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+                break;
+            default:
+                setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
+            }
+            return -1;
+        }
+        sent += result;
+        if (result < batch)
+            break;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%lli) == %lli", count, sent);
+#endif
+
+    return sent;
+}
+#endif // QT_CONFIG(sendmmsg)
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1155,8 +1352,10 @@ bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 
     // Determine local address
     memset(&sa, 0, sizeof(sa));
+    int socketFamily = AF_UNSPEC;
     if (::getsockname(socketDescriptor, &sa.a, &sockAddrSize) == 0) {
         qt_socket_getPortAndAddress(&sa, &localPort, &localAddress);
+        socketFamily = sa.a.sa_family;
 
         // Determine protocol family
         switch (sa.a.sa_family) {
@@ -1238,6 +1437,9 @@ bool QNativeSocketEnginePrivate::fetchConnectionParameters()
         } else {
             if (value == SOCK_DGRAM)
                 socketType = QAbstractSocket::UdpSocket;
+            else if (value == SOCK_SEQPACKET && socketFamily == AF_UNIX)
+                // QLocalSocket keeps the packet boundaries
+                socketType = QAbstractSocket::TcpSocket;
             else
                 socketType = QAbstractSocket::UnknownSocketType;
         }
@@ -1274,8 +1476,15 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 {
     Q_Q(QNativeSocketEngine);
 
+    if (!pendingFileDescriptors.isEmpty() || !packetBoundaries.isEmpty()) {
+        const QByteArrayView block(data, len);
+        return nativeWriteBlocks(&block, 1);
+    }
+
     ssize_t writtenBytes;
     writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
+    if (writtenBytes > 0)
+        totalBytesWritten += writtenBytes;
 
     if (writtenBytes < 0) {
         switch (errno) {
@@ -1303,6 +1512,109 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWriteBlocks(const QByteArrayView *blocks, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+#ifdef IOV_MAX
+    count = qMin(count, qsizetype(IOV_MAX));
+#endif
+    // Stop at the next byte that has descriptors attached, or at the end of
+    // the current packet
+    const PendingFileDescriptors *attached = nullptr;
+    qint64 limit = std::numeric_limits<qint64>::max();
+    if (!pendingFileDescriptors.isEmpty()) {
+        qsizetype next = 0;
+        if (pendingFileDescriptors.constFirst().position == totalBytesWritten) {
+            attached = &pendingFileDescriptors.constFirst();
+            next = 1;
+        }
+        if (next < pendingFileDescriptors.size())
+            limit = pendingFileDescriptors.at(next).position - totalBytesWritten;
+    }
+    if (!packetBoundaries.isEmpty())
+        limit = qMin(limit, packetBoundaries.constFirst() - totalBytesWritten);
+
+    QVarLengthArray<iovec, 32> vecs(count);
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 size = qMin(qint64(blocks[i].size()), limit - total);
+        vecs[i].iov_base = const_cast<char *>(blocks[i].data());
+        vecs[i].iov_len = size;
+        total += size;
+        if (total == limit) {
+            count = i + 1;
+            break;
+        }
+    }
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vecs.data();
+    msg.msg_iovlen = count;
+
+    QVarLengthArray<cmsghdr, 4> control;
+    if (attached) {
+        const size_t descriptorsSize = attached->descriptors.size() * sizeof(int);
+        const size_t controlSize = CMSG_SPACE(descriptorsSize);
+        control.resize((controlSize + sizeof(cmsghdr) - 1) / sizeof(cmsghdr));
+        memset(control.data(), 0, controlSize);
+        msg.msg_control = control.data();
+        msg.msg_controllen = controlSize;
+        cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg);
+        cmsgptr->cmsg_level = SOL_SOCKET;
+        cmsgptr->cmsg_type = SCM_RIGHTS;
+        cmsgptr->cmsg_len = CMSG_LEN(descriptorsSize);
+        memcpy(CMSG_DATA(cmsgptr), attached->descriptors.constData(), descriptorsSize);
+    }
+
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+
+    if (writtenBytes > 0) {
+        totalBytesWritten += writtenBytes;
+        if (attached) {
+            // the receiver has its own copies now
+            for (int descriptor : attached->descriptors)
+                qt_safe_close(descriptor);
+            pendingFileDescriptors.removeFirst();
+        }
+        while (!packetBoundaries.isEmpty() && packetBoundaries.constFirst() <= totalBytesWritten)
+            packetBoundaries.removeFirst();
+    } else if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteBlocks(%lld) == %i", qint64(count),
+           (int) writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
+void QNativeSocketEnginePrivate::discardPendingFileDescriptors()
+{
+    for (const PendingFileDescriptors &pending : std::as_const(pendingFileDescriptors)) {
+        for (int descriptor : pending.descriptors)
+            qt_safe_close(descriptor);
+    }
+    pendingFileDescriptors.clear();
+}
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -1314,7 +1626,48 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     }
 
     ssize_t r = 0;
-    r = qt_safe_read(socketDescriptor, data, maxSize);
+    if (receivedFileDescriptors) {
+        // Unix domain socket used by QLocalSocket
+        iovec vec;
+        vec.iov_base = data;
+        vec.iov_len = maxSize;
+        union {
+            cmsghdr header;
+            char buffer[CMSG_SPACE(QNativeSocketEngine::MaxFileDescriptorsPerWrite * sizeof(int))];
+        } control;
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &vec;
+        msg.msg_iovlen = 1;
+        msg.msg_control = &control;
+        msg.msg_controllen = sizeof(control);
+        int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+        flags |= MSG_CMSG_CLOEXEC;
+#endif
+        EINTR_LOOP(r, ::recvmsg(socketDescriptor, &msg, flags));
+
+        if (r >= 0) {
+            for (cmsghdr *cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
+                 cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
+                if (cmsgptr->cmsg_level != SOL_SOCKET || cmsgptr->cmsg_type != SCM_RIGHTS)
+                    continue;
+                const size_t count = (cmsgptr->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (size_t i = 0; i < count; ++i) {
+                    int descriptor;
+                    memcpy(&descriptor, CMSG_DATA(cmsgptr) + i * sizeof(int), sizeof(int));
+#ifndef MSG_CMSG_CLOEXEC
+                    ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+#endif
+                    receivedFileDescriptors->append(descriptor);
+                }
+            }
+            if (receivedPacketSizes && r > 0)
+                receivedPacketSizes->append(r);
+        }
+    } else {
+        r = qt_safe_read(socketDescriptor, data, maxSize);
+    }
 
     if (r < 0) {
         r = -1;
@@ -216,6 +216,7 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
         break;
 
     case QAbstractSocketEngine::PathMtuInformation:
+    case QAbstractSocketEngine::PortLoadBalancing:
         break;          // not supported on Windows
     }
 }
@@ -156,6 +156,29 @@ static inline int qt_safe_recvmsg(int sockfd, struct msghdr *msg, int flags)
     return ret;
 }
 
+#if QT_CONFIG(sendmmsg)
+static inline int qt_safe_sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+#ifdef MSG_NOSIGNAL
+    flags |= MSG_NOSIGNAL;
+#else
+    qt_ignore_sigpipe();
+#endif
+
+    int ret;
+    EINTR_LOOP(ret, ::sendmmsg(sockfd, msgvec, vlen, flags));
+    return ret;
+}
+
+static inline int qt_safe_recvmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    int ret;
+
+    EINTR_LOOP(ret, ::recvmmsg(sockfd, msgvec, vlen, flags, nullptr));
+    return ret;
+}
+#endif // QT_CONFIG(sendmmsg)
+
 QT_END_NAMESPACE
 
 #endif // QNET_UNIX_P_H
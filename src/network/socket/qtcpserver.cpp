@@ -43,6 +43,11 @@
     use waitForNewConnection(), which blocks until either a
     connection is available or a timeout expires.
 
+    A server that has to accept connections at a high rate can spread
+    this work over several threads with setAcceptThreadCount(). The
+    connections are then delivered with the connectionAccepted() signal, in
+    the thread that accepted them.
+
     \sa QTcpSocket, {Fortune Server}, {Threaded Fortune Server},
         {Torrent Example}
 */
@@ -73,6 +78,21 @@
     \sa pauseAccepting(), resumeAccepting()
 */
 
+/*! \fn void QTcpServer::connectionAccepted(QTcpSocket *socket)
+    \since 6.7
+
+    This signal is emitted when one of the threads set up with
+    setAcceptThreadCount() has accepted a connection. \a socket is a
+    connected QTcpSocket that lives in that thread and has no parent; the
+    receiver takes ownership of it.
+
+    The signal is emitted in the accepting thread, so it should be
+    connected with Qt::DirectConnection to handle the connection there. If
+    nothing is connected to it, accepted connections are closed right away.
+
+    \sa setAcceptThreadCount()
+*/
+
 #include "qtcpserver.h"
 #include "qtcpserver_p.h"
 
@@ -83,6 +103,8 @@
 #include "qabstractsocketengine_p.h"
 #include "qtcpsocket.h"
 #include "qnetworkproxy.h"
+#include "qmetaobject.h"
+#include "qthread.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -91,6 +113,48 @@ QT_BEGIN_NAMESPACE
         return returnValue; \
     } } while (0)
 
+/*! \internal
+
+    Owns one of the listening sockets of a QTcpServer with accept threads,
+    and lives in the thread that accepts its connections.
+*/
+class QTcpServerAcceptor : public QObject, public QAbstractSocketEngineReceiver
+{
+public:
+    QTcpServerAcceptor(QTcpServerPrivate *server, QAbstractSocketEngine *engine)
+        : server(server), engine(engine)
+    {
+        engine->setParent(this);
+        engine->setReceiver(this);
+    }
+
+    QTcpServerPrivate *server;
+    QAbstractSocketEngine *engine;
+
+    // from QAbstractSocketEngineReceiver
+    void readNotification() override
+    {
+        for (;;) {
+            const qintptr descriptor = engine->accept();
+            if (descriptor == -1) {
+                if (engine->error() != QAbstractSocket::TemporaryError) {
+                    engine->setReadNotificationEnabled(false);
+                    emit static_cast<QTcpServer *>(server->q_ptr)->acceptError(engine->error());
+                }
+                break;
+            }
+            server->acceptedInThread(descriptor);
+        }
+    }
+    void closeNotification() override { readNotification(); }
+    void writeNotification() override {}
+    void exceptionNotification() override {}
+    void connectionNotification() override {}
+#ifndef QT_NO_NETWORKPROXY
+    void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) override {}
+#endif
+};
+
 /*! \internal
 */
 QTcpServerPrivate::QTcpServerPrivate()
@@ -205,6 +269,95 @@ void QTcpServerPrivate::readNotification()
     }
 }
 
+/*! \internal
+
+    Opens acceptThreadCount listening sockets on \a address and \a port,
+    to which the server's own socket is bound with port load balancing, and
+    starts a thread accepting connections for each of them.
+*/
+bool QTcpServerPrivate::startAcceptThreads(const QNetworkProxy &proxy, const QHostAddress &address,
+                                           quint16 port)
+{
+    for (int i = 0; i < acceptThreadCount; ++i) {
+        QAbstractSocketEngine *engine =
+                QAbstractSocketEngine::createSocketEngine(socketType, proxy, nullptr);
+        if (!engine) {
+            serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+            serverSocketErrorString = QTcpServer::tr("Operation on socket is not supported");
+            stopAcceptThreads();
+            return false;
+        }
+        bool ok = engine->initialize(socketType, address.protocol());
+        if (ok) {
+#if defined(Q_OS_UNIX)
+            // See configureCreatedSocket()
+            engine->setOption(QAbstractSocketEngine::AddressReusable, 1);
+#endif
+            ok = engine->setOption(QAbstractSocketEngine::PortLoadBalancing, 1)
+                    && engine->bind(address, port) && engine->listen(listenBacklog);
+        }
+        if (!ok) {
+            serverSocketError = engine->error();
+            serverSocketErrorString = engine->errorString();
+            delete engine;
+            stopAcceptThreads();
+            return false;
+        }
+
+        auto *acceptor = new QTcpServerAcceptor(this, engine);
+        QThread *thread = new QThread;
+        thread->setObjectName(QStringLiteral("QTcpServer accept thread"));
+        acceptor->moveToThread(thread);
+        QObject::connect(thread, &QThread::finished, acceptor, &QObject::deleteLater);
+        thread->start();
+        acceptThreads.append({ thread, acceptor });
+    }
+    setAcceptingInThreads(true);
+    return true;
+}
+
+/*! \internal
+*/
+void QTcpServerPrivate::stopAcceptThreads()
+{
+    for (const AcceptThread &acceptThread : std::as_const(acceptThreads))
+        acceptThread.thread->quit();
+    for (const AcceptThread &acceptThread : std::as_const(acceptThreads)) {
+        acceptThread.thread->wait();
+        delete acceptThread.thread;
+    }
+    acceptThreads.clear();
+}
+
+/*! \internal
+*/
+void QTcpServerPrivate::setAcceptingInThreads(bool enable)
+{
+    for (const AcceptThread &acceptThread : std::as_const(acceptThreads)) {
+        QAbstractSocketEngine *engine = acceptThread.acceptor->engine;
+        QMetaObject::invokeMethod(engine, [engine, enable] {
+            engine->setReadNotificationEnabled(enable);
+        }, Qt::QueuedConnection);
+    }
+}
+
+/*! \internal
+
+    Called in an accept thread with the \a descriptor of a connection it
+    accepted.
+*/
+void QTcpServerPrivate::acceptedInThread(qintptr descriptor)
+{
+    Q_Q(QTcpServer);
+    static const QMetaMethod signal = QMetaMethod::fromSignal(&QTcpServer::connectionAccepted);
+    auto *socket = new QTcpSocket;
+    socket->setSocketDescriptor(descriptor);
+    if (q->isSignalConnected(signal))
+        emit q->connectionAccepted(socket);
+    else
+        delete socket;
+}
+
 /*!
     \internal
     Return the amount of sockets currently in queue for the server.
@@ -317,20 +470,36 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    // With accept threads, this socket only holds the port; the threads'
+    // sockets listen on it, and the system spreads the connections over them.
+    bool useAcceptThreads = false;
+#if QT_CONFIG(thread)
+    useAcceptThreads = d->acceptThreadCount > 0
+#ifndef QT_NO_NETWORKPROXY
+            && proxy.type() == QNetworkProxy::NoProxy
+#endif
+            && d->socketEngine->setOption(QAbstractSocketEngine::PortLoadBalancing, 1);
+#endif
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
         return false;
     }
 
-    if (!d->socketEngine->listen(d->listenBacklog)) {
-        d->serverSocketError = d->socketEngine->error();
-        d->serverSocketErrorString = d->socketEngine->errorString();
-        return false;
-    }
+    if (useAcceptThreads) {
+        if (!d->startAcceptThreads(proxy, addr, d->socketEngine->localPort()))
+            return false;
+    } else {
+        if (!d->socketEngine->listen(d->listenBacklog)) {
+            d->serverSocketError = d->socketEngine->error();
+            d->serverSocketErrorString = d->socketEngine->errorString();
+            return false;
+        }
 
-    d->socketEngine->setReceiver(d);
-    d->socketEngine->setReadNotificationEnabled(true);
+        d->socketEngine->setReceiver(d);
+        d->socketEngine->setReadNotificationEnabled(true);
+    }
 
     d->state = QAbstractSocket::ListeningState;
     d->address = d->socketEngine->localAddress();
@@ -353,7 +522,8 @@ bool QTcpServer::isListening() const
 {
     Q_D(const QTcpServer);
     Q_CHECK_SOCKETENGINE(false);
-    return d->socketEngine->state() == QAbstractSocket::ListeningState;
+    return d->socketEngine->state() == QAbstractSocket::ListeningState
+            || !d->acceptThreads.isEmpty();
 }
 
 /*!
@@ -368,6 +538,7 @@ void QTcpServer::close()
 
     qDeleteAll(d->pendingConnections);
     d->pendingConnections.clear();
+    d->stopAcceptThreads();
 
     if (d->socketEngine) {
         d->socketEngine->close();
@@ -495,7 +666,7 @@ QHostAddress QTcpServer::serverAddress() const
 bool QTcpServer::waitForNewConnection(int msec, bool *timedOut)
 {
     Q_D(QTcpServer);
-    if (d->state != QAbstractSocket::ListeningState)
+    if (d->state != QAbstractSocket::ListeningState || !d->acceptThreads.isEmpty())
         return false;
 
     if (!d->socketEngine->waitForRead(msec, timedOut)) {
@@ -672,6 +843,45 @@ int QTcpServer::listenBacklogSize() const
     return d_func()->listenBacklog;
 }
 
+/*!
+    \since 6.7
+
+    Sets the number of threads that accept connections to \a count. The
+    setting takes effect the next time listen() is called.
+
+    If \a count is greater than 0, listen() opens \a count listening
+    sockets that share the address and port, each in a thread with its own
+    event loop, and the operating system spreads the incoming connections
+    over them. This lets the rate at which connections are accepted scale
+    with the number of processor cores. The accepted connections are
+    delivered with the connectionAccepted() signal in the thread that
+    accepted them; incomingConnection() is not called for them, nor are they
+    added to the pending connections.
+
+    Accept threads require port load balancing (\c SO_REUSEPORT on Linux,
+    \c SO_REUSEPORT_LB on FreeBSD) and are not used with a proxy. If they
+    cannot be used, listen() accepts connections in the server's thread as
+    usual. The default is 0.
+
+    \sa acceptThreadCount(), connectionAccepted()
+*/
+void QTcpServer::setAcceptThreadCount(int count)
+{
+    d_func()->acceptThreadCount = qMax(count, 0);
+}
+
+/*!
+    \since 6.7
+
+    Returns the number of threads that accept connections.
+
+    \sa setAcceptThreadCount()
+*/
+int QTcpServer::acceptThreadCount() const
+{
+    return d_func()->acceptThreadCount;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -702,7 +912,11 @@ QString QTcpServer::errorString() const
 */
 void QTcpServer::pauseAccepting()
 {
-    d_func()->socketEngine->setReadNotificationEnabled(false);
+    Q_D(QTcpServer);
+    if (d->acceptThreads.isEmpty())
+        d->socketEngine->setReadNotificationEnabled(false);
+    else
+        d->setAcceptingInThreads(false);
 }
 
 /*!
@@ -714,7 +928,11 @@ void QTcpServer::pauseAccepting()
 */
 void QTcpServer::resumeAccepting()
 {
-    d_func()->socketEngine->setReadNotificationEnabled(true);
+    Q_D(QTcpServer);
+    if (d->acceptThreads.isEmpty())
+        d->socketEngine->setReadNotificationEnabled(true);
+    else
+        d->setAcceptingInThreads(true);
 }
 
 #ifndef QT_NO_NETWORKPROXY
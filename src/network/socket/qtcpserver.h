@@ -36,6 +36,9 @@ public:
     void setListenBacklogSize(int size);
     int listenBacklogSize() const;
 
+    void setAcceptThreadCount(int count);
+    int acceptThreadCount() const;
+
     quint16 serverPort() const;
     QHostAddress serverAddress() const;
 
@@ -68,6 +71,7 @@ Q_SIGNALS:
     void newConnection();
     void pendingConnectionAvailable(QPrivateSignal);
     void acceptError(QAbstractSocket::SocketError socketError);
+    void connectionAccepted(QTcpSocket *socket);
 
 private:
     Q_DISABLE_COPY(QTcpServer)
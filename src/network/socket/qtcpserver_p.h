@@ -27,6 +27,9 @@
 
 QT_BEGIN_NAMESPACE
 
+class QThread;
+class QTcpServerAcceptor;
+
 class Q_NETWORK_EXPORT QTcpServerPrivate : public QObjectPrivate,
                                            public QAbstractSocketEngineReceiver
 {
@@ -50,6 +53,20 @@ public:
     int listenBacklog = 50;
     int maxConnections;
 
+    // Listening sockets sharing the port, each accepting in its own thread
+    struct AcceptThread
+    {
+        QThread *thread;
+        QTcpServerAcceptor *acceptor;
+    };
+    QList<AcceptThread> acceptThreads;
+    int acceptThreadCount = 0;
+
+    bool startAcceptThreads(const QNetworkProxy &proxy, const QHostAddress &address, quint16 port);
+    void stopAcceptThreads();
+    void setAcceptingInThreads(bool enable);
+    void acceptedInThread(qintptr descriptor);
+
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
     QNetworkProxy resolveProxy(const QHostAddress &address, quint16 port);
@@ -66,6 +66,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -395,6 +396,59 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.7
+
+    Sends the datagrams in \a datagrams to the host addresses and ports they
+    contain, as writeDatagram() does for each of them. Where the operating
+    system supports it, several datagrams are sent with a single system call.
+    Datagrams that set a hop limit, a sender address or an interface index
+    are still sent one by one.
+
+    Returns the number of datagrams sent, which is less than the size of
+    \a datagrams if the socket's send buffer filled up, or -1 if not even
+    the first datagram could be sent. bytesWritten() is emitted once, with
+    the total size of the datagrams that were sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.constFirst().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<QByteArray, 16> data;
+    QVarLengthArray<QIpPacketHeader, 16> headers;
+    data.reserve(datagrams.size());
+    headers.reserve(datagrams.size());
+    for (const QNetworkDatagram &datagram : datagrams) {
+        data.append(datagram.d->data);
+        headers.append(datagram.d->header);
+    }
+
+    const qint64 sent = d->socketEngine->writeDatagrams(data.constData(), headers.constData(),
+                                                        data.size());
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return -1;
+    }
+    qint64 bytes = 0;
+    for (qint64 i = 0; i < sent; ++i)
+        bytes += data[i].size();
+    emit bytesWritten(bytes);
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -440,6 +494,61 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.7
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them along with their sender's host address
+    and port and, if possible, their destination address, port and hop count.
+    Where the operating system supports it, several datagrams are read with a
+    single system call, which is considerably cheaper than calling
+    receiveDatagram() for each of them.
+
+    Returns an empty list if no datagram is pending or an error occurred.
+
+    If \a maxSize is too small, the rest of a datagram will be lost. If
+    \a maxSize is -1 (the default), datagrams of up to 65535 bytes are read
+    in full; passing the largest size the application expects reduces the
+    memory needed for the reception.
+
+    \sa receiveDatagram(), writeDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lld, %lld)", qint64(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    QList<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+    if (maxSize < 0)
+        maxSize = 65535;
+
+    QVarLengthArray<QByteArray, 16> data(maxCount);
+    QVarLengthArray<QIpPacketHeader, 16> headers(maxCount);
+    const qint64 count = d->socketEngine->readDatagrams(data.data(), headers.data(), maxCount,
+                                                        maxSize, QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (count < 0) {
+        // -2 means that no datagram was pending
+        if (count != -2)
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return result;
+    }
+
+    result.reserve(count);
+    for (qint64 i = 0; i < count; ++i) {
+        QNetworkDatagram &datagram = result.emplace_back(std::move(data[i]));
+        datagram.d->header = std::move(headers[i]);
+    }
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
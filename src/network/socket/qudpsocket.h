@@ -47,11 +47,13 @@ public:
     qint64 pendingDatagramSize() const;
     QNetworkDatagram receiveDatagram(qint64 maxSize = -1);
     qint64 readDatagram(char *data, qint64 maxlen, QHostAddress *host = nullptr, quint16 *port = nullptr);
+    QList<QNetworkDatagram> receiveDatagrams(qsizetype maxCount, qint64 maxSize = -1);
 
     qint64 writeDatagram(const QNetworkDatagram &datagram);
     qint64 writeDatagram(const char *data, qint64 len, const QHostAddress &host, quint16 port);
     inline qint64 writeDatagram(const QByteArray &datagram, const QHostAddress &host, quint16 port)
         { return writeDatagram(datagram.constData(), datagram.size(), host, port); }
+    qsizetype writeDatagrams(const QList<QNetworkDatagram> &datagrams);
 
 private:
     Q_DISABLE_COPY_MOVE(QUdpSocket)
@@ -869,6 +869,8 @@ void QKmsDevice::discoverPlanes()
                 plane.zposPropertyId = prop->prop_id;
             } else if (!strcasecmp(prop->name, "blend_op")) {
                 plane.blendOpPropertyId = prop->prop_id;
+            } else if (!strcmp(prop->name, "IN_FENCE_FD")) {
+                plane.inFenceFdPropertyId = prop->prop_id;
             }
         });
 
@@ -949,6 +951,36 @@ void QKmsDevice::threadLocalAtomicReset()
         a.previous_request = nullptr;
     }
 }
+
+// Returns the id of an overlay plane that output's crtc can show on top of,
+// or below, the plane eglfs renders to. It is meant for content that
+// doesn't go through Qt's rendering, like decoded video frames, which can
+// then be scanned out directly by adding the plane's properties to
+// threadLocalAtomicRequest(), and so get committed with the next flip. The
+// same plane is returned for every call for an output; 0 if there is none.
+uint32_t QKmsDevice::overlayPlaneForOutput(const QKmsOutput &output)
+{
+    if (!m_has_atomic_support)
+        return 0;
+
+    const uint32_t eglfsPlaneId = output.eglfs_plane ? output.eglfs_plane->id : 0;
+    for (const QKmsPlane &plane : std::as_const(m_planes)) {
+        if (plane.type == QKmsPlane::OverlayPlane && plane.id != eglfsPlaneId
+                && plane.activeCrtcId == output.crtc_id) {
+            return plane.id;
+        }
+    }
+    for (QKmsPlane &plane : m_planes) {
+        if (plane.type == QKmsPlane::OverlayPlane && plane.id != eglfsPlaneId
+                && !plane.activeCrtcId && (plane.possibleCrtcs & (1 << output.crtc_index))) {
+            plane.activeCrtcId = output.crtc_id;
+            qCDebug(qLcKmsDebug, "Reserved overlay plane %u for crtc id %u",
+                    plane.id, output.crtc_id);
+            return plane.id;
+        }
+    }
+    return 0;
+}
 #endif
 
 void QKmsDevice::parseConnectorProperties(uint32_t connectorId, QKmsOutput *output)
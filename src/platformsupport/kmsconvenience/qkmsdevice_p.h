@@ -144,6 +144,7 @@ struct QKmsPlane
     uint32_t crtcheightPropertyId = 0;
     uint32_t zposPropertyId = 0;
     uint32_t blendOpPropertyId = 0;
+    uint32_t inFenceFdPropertyId = 0;
 
     uint32_t activeCrtcId = 0;
 };
@@ -209,6 +210,7 @@ public:
     drmModeAtomicReq *threadLocalAtomicRequest();
     bool threadLocalAtomicCommit(void *user_data);
     void threadLocalAtomicReset();
+    uint32_t overlayPlaneForOutput(const QKmsOutput &output);
 #endif
     void createScreens();
 
@@ -12,9 +12,12 @@
 
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/private/qtguiglobal_p.h>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
 #include <QtFbSupport/private/qfbvthandler_p.h>
 
 #include <errno.h>
+#include <unistd.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -329,6 +332,67 @@ static void addAtomicFlip(drmModeAtomicReq *request, const QKmsOutput &output, u
 }
 #endif
 
+#if QT_CONFIG(drm_atomic)
+#ifndef EGL_SYNC_NATIVE_FENCE_ANDROID
+#define EGL_SYNC_NATIVE_FENCE_ANDROID 0x3144
+#endif
+#ifndef EGL_NO_NATIVE_FENCE_FD_ANDROID
+#define EGL_NO_NATIVE_FENCE_FD_ANDROID -1
+#endif
+
+namespace {
+struct NativeFenceFunctions
+{
+    typedef EGLSyncKHR (EGLAPIENTRYP CreateSync)(EGLDisplay, EGLenum, const EGLint *);
+    typedef EGLBoolean (EGLAPIENTRYP DestroySync)(EGLDisplay, EGLSyncKHR);
+    typedef EGLint (EGLAPIENTRYP DupNativeFenceFD)(EGLDisplay, EGLSyncKHR);
+
+    explicit NativeFenceFunctions(EGLDisplay display)
+    {
+        const char *extensions = eglQueryString(display, EGL_EXTENSIONS);
+        if (!extensions || !strstr(extensions, "EGL_ANDROID_native_fence_sync"))
+            return;
+        createSync = reinterpret_cast<CreateSync>(eglGetProcAddress("eglCreateSyncKHR"));
+        destroySync = reinterpret_cast<DestroySync>(eglGetProcAddress("eglDestroySyncKHR"));
+        dupNativeFenceFD = reinterpret_cast<DupNativeFenceFD>(
+                eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+    }
+
+    bool isValid() const { return createSync && destroySync && dupNativeFenceFD; }
+
+    CreateSync createSync = nullptr;
+    DestroySync destroySync = nullptr;
+    DupNativeFenceFD dupNativeFenceFD = nullptr;
+};
+} // unnamed namespace
+
+// Returns a sync file that signals once the GL commands issued so far on
+// the current context, the rendering of the frame that was just swapped
+// included, have completed; or -1 if EGL_ANDROID_native_fence_sync is not
+// available. flip() hands it to the plane as IN_FENCE_FD, so that the
+// commit doesn't depend on the driver synchronizing with the GPU implicitly.
+static int renderFenceFd()
+{
+    EGLDisplay display = eglGetCurrentDisplay();
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (display == EGL_NO_DISPLAY || !context)
+        return -1;
+
+    static const NativeFenceFunctions functions(display);
+    if (!functions.isValid())
+        return -1;
+
+    EGLSyncKHR sync = functions.createSync(display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+    if (sync == EGL_NO_SYNC_KHR)
+        return -1;
+    // the fence only gets a file descriptor once it has been flushed
+    context->functions()->glFlush();
+    const int fd = functions.dupNativeFenceFD(display, sync);
+    functions.destroySync(display, sync);
+    return fd == EGL_NO_NATIVE_FENCE_FD_ANDROID ? -1 : fd;
+}
+#endif
+
 void QEglFSKmsGbmScreen::flip()
 {
     // For headless screen just return silently. It is not necessarily an error
@@ -369,11 +433,29 @@ void QEglFSKmsGbmScreen::flip()
     const int fd = device()->fd();
     m_flipPending = true;
 
+#if QT_CONFIG(drm_atomic)
+    // The kernel keeps its own reference to the fence once it's committed
+    int renderFence = -1;
+    auto renderFenceClose = qScopeGuard([&renderFence] {
+        if (renderFence >= 0)
+            close(renderFence);
+    });
+#endif
+
     if (device()->hasAtomicSupport()) {
 #if QT_CONFIG(drm_atomic)
         drmModeAtomicReq *request = device()->threadLocalAtomicRequest();
         if (request) {
             addAtomicFlip(request, thisOutput, fb->fb);
+            static bool explicitFences = qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_EXPLICIT_FENCES");
+            if (explicitFences && thisOutput.eglfs_plane->inFenceFdPropertyId) {
+                renderFence = renderFenceFd();
+                if (renderFence >= 0) {
+                    drmModeAtomicAddProperty(request, thisOutput.eglfs_plane->id,
+                                             thisOutput.eglfs_plane->inFenceFdPropertyId,
+                                             renderFence);
+                }
+            }
             static int zpos = qEnvironmentVariableIntValue("QT_QPA_EGLFS_KMS_ZPOS");
             if (zpos) {
                 drmModeAtomicAddProperty(request, thisOutput.eglfs_plane->id,
@@ -120,6 +120,10 @@ void *QEglFSKmsIntegration::nativeResourceForScreen(const QByteArray &resource,
             return (void *) (qintptr) s->output().crtc_id;
         if (resource == QByteArrayLiteral("dri_connectorid"))
             return (void *) (qintptr) s->output().connector_id;
+#if QT_CONFIG(drm_atomic)
+        if (resource == QByteArrayLiteral("dri_overlay_planeid") && m_device)
+            return (void *) (qintptr) m_device->overlayPlaneForOutput(s->output());
+#endif
     }
     return nullptr;
 }
@@ -253,7 +253,7 @@ static void blankScreen(int fd, bool on)
 }
 
 QLinuxFbScreen::QLinuxFbScreen(const QStringList &args)
-    : mArgs(args), mFbFd(-1), mTtyFd(-1), mBlitter(nullptr)
+    : mArgs(args), mFbFd(-1), mTtyFd(-1), mBackPage(0), mPageHeight(0)
 {
     mMmap.data = nullptr;
 }
@@ -268,8 +268,6 @@ QLinuxFbScreen::~QLinuxFbScreen()
 
     if (mTtyFd != -1)
         resetTty(mTtyFd, mOldTtyMode);
-
-    delete mBlitter;
 }
 
 bool QLinuxFbScreen::initialize()
@@ -284,12 +282,15 @@ bool QLinuxFbScreen::initialize()
     QSize userMmSize;
     QRect userGeometry;
     bool doSwitchToGraphicsMode = true;
+    bool doubleBuffer = false;
 
     // Parse arguments
     for (const QString &arg : std::as_const(mArgs)) {
         QRegularExpressionMatch match;
         if (arg == "nographicsmodeswitch"_L1)
             doSwitchToGraphicsMode = false;
+        else if (arg == "doublebuffer"_L1)
+            doubleBuffer = true;
         else if (arg.contains(mmSizeRx, &match))
             userMmSize = QSize(match.captured(1).toInt(), match.captured(2).toInt());
         else if (arg.contains(sizeRx, &match))
@@ -335,6 +336,9 @@ bool QLinuxFbScreen::initialize()
         return false;
     }
 
+    if (doubleBuffer && !setupDoubleBuffering(&vinfo, &finfo))
+        qWarning("linuxfb: The framebuffer has no room for a second page, not double buffering");
+
     mDepth = determineDepth(vinfo);
     mBytesPerLine = finfo.line_length;
     QRect geometry = determineGeometry(vinfo, userGeometry);
@@ -355,6 +359,12 @@ bool QLinuxFbScreen::initialize()
 
     QFbScreen::initializeCompositor();
     mFbScreenImage = QImage(mMmap.data, geometry.width(), geometry.height(), mBytesPerLine, mFormat);
+    if (mPageHeight) {
+        mBackPage = 1;
+        mFbBackImage = QImage(mMmap.data + mPageHeight * mBytesPerLine, geometry.width(),
+                              geometry.height(), mBytesPerLine, mFormat);
+        mBackDirty = mGeometry;
+    }
 
     mCursor = new QFbCursor(this);
 
@@ -368,6 +378,57 @@ bool QLinuxFbScreen::initialize()
     return true;
 }
 
+// Makes the virtual screen two pages high, with the first one shown, and
+// sets mPageHeight if that worked
+bool QLinuxFbScreen::setupDoubleBuffering(fb_var_screeninfo *vinfo, fb_fix_screeninfo *finfo)
+{
+    if (vinfo->yres_virtual < 2 * vinfo->yres || vinfo->yoffset != 0) {
+        fb_var_screeninfo request = *vinfo;
+        request.yres_virtual = qMax(request.yres_virtual, 2 * request.yres);
+        request.yoffset = 0;
+        request.activate = FB_ACTIVATE_NOW;
+        if (ioctl(mFbFd, FBIOPUT_VSCREENINFO, &request) != 0
+                || ioctl(mFbFd, FBIOGET_VSCREENINFO, vinfo) != 0
+                || ioctl(mFbFd, FBIOGET_FSCREENINFO, finfo) != 0) {
+            return false;
+        }
+    }
+    if (vinfo->yres_virtual < 2 * vinfo->yres || vinfo->yoffset != 0
+            || finfo->smem_len < 2 * vinfo->yres * finfo->line_length) {
+        return false;
+    }
+    mPageHeight = vinfo->yres;
+    return true;
+}
+
+// Copies region of the composited screen image to target. Without a
+// conversion, that is a copy of each line; otherwise QPainter converts with
+// the optimized routines of the raster engine.
+void QLinuxFbScreen::blit(QImage *target, const QRegion &region)
+{
+    if (target->format() == mScreenImage.format() && target->depth() % 8 == 0) {
+        // target wraps the framebuffer; bits() would detach it if grabWindow()
+        // shares it at the moment
+        uchar *bits = const_cast<uchar *>(target->constBits());
+        const int bytesPerPixel = target->depth() / 8;
+        for (const QRect &rect : region) {
+            const QRect r = rect & target->rect();
+            const qsizetype offset = qsizetype(r.left()) * bytesPerPixel;
+            const size_t length = size_t(r.width()) * bytesPerPixel;
+            for (int y = r.top(); y <= r.bottom(); ++y) {
+                memcpy(bits + qsizetype(y) * target->bytesPerLine() + offset,
+                       mScreenImage.constScanLine(y) + offset, length);
+            }
+        }
+        return;
+    }
+
+    QPainter painter(target);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect &rect : region)
+        painter.drawImage(rect, mScreenImage, rect);
+}
+
 QRegion QLinuxFbScreen::doRedraw()
 {
     QRegion touched = QFbScreen::doRedraw();
@@ -375,12 +436,32 @@ QRegion QLinuxFbScreen::doRedraw()
     if (touched.isEmpty())
         return touched;
 
-    if (!mBlitter)
-        mBlitter = new QPainter(&mFbScreenImage);
+    if (!mPageHeight) {
+        blit(&mFbScreenImage, touched);
+        return touched;
+    }
+
+    // The back page also lacks what was drawn to the shown one last time
+    blit(&mFbBackImage, mBackDirty + touched);
+    fb_var_screeninfo vinfo;
+    bool panned = ioctl(mFbFd, FBIOGET_VSCREENINFO, &vinfo) == 0;
+    if (panned) {
+        vinfo.yoffset = mBackPage * mPageHeight;
+        panned = ioctl(mFbFd, FBIOPAN_DISPLAY, &vinfo) == 0;
+    }
+    if (!panned) {
+        qErrnoWarning(errno, "linuxfb: Failed to pan the display, not double buffering");
+        mPageHeight = 0;
+        blit(&mFbScreenImage, touched);
+        return touched;
+    }
+    // Not all drivers wait for the page to be shown
+    quint32 crtc = 0;
+    ioctl(mFbFd, FBIO_WAITFORVSYNC, &crtc);
 
-    mBlitter->setCompositionMode(QPainter::CompositionMode_Source);
-    for (const QRect &rect : touched)
-        mBlitter->drawImage(rect, mScreenImage, rect);
+    std::swap(mFbScreenImage, mFbBackImage);
+    mBackDirty = touched;
+    mBackPage = 1 - mBackPage;
 
     return touched;
 }
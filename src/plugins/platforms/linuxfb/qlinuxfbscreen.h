@@ -6,9 +6,11 @@
 
 #include <QtFbSupport/private/qfbscreen_p.h>
 
+struct fb_var_screeninfo;
+struct fb_fix_screeninfo;
+
 QT_BEGIN_NAMESPACE
 
-class QPainter;
 class QFbCursor;
 
 class QLinuxFbScreen : public QFbScreen
@@ -25,11 +27,14 @@ public:
     QRegion doRedraw() override;
 
 private:
+    bool setupDoubleBuffering(fb_var_screeninfo *vinfo, fb_fix_screeninfo *finfo);
+    void blit(QImage *target, const QRegion &region);
+
     QStringList mArgs;
     int mFbFd;
     int mTtyFd;
 
-    QImage mFbScreenImage;
+    QImage mFbScreenImage; // the page that is shown
     int mBytesPerLine;
     int mOldTtyMode;
 
@@ -38,7 +43,12 @@ private:
         int offset, size;
     } mMmap;
 
-    QPainter *mBlitter;
+    // With double buffering, frames are drawn to the page below the shown
+    // one, which then gets panned to
+    QImage mFbBackImage;
+    QRegion mBackDirty; // drawn to the shown page only
+    int mBackPage;
+    quint32 mPageHeight;
 };
 
 QT_END_NAMESPACE
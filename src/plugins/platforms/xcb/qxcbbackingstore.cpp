@@ -74,6 +74,7 @@ private:
 
     void ensureGC(xcb_drawable_t dst);
     void shmPutImage(xcb_drawable_t drawable, const QRegion &region, const QPoint &offset = QPoint());
+    void waitForShm();
     void flushPixmap(const QRegion &region, bool fullRegion = false);
     void setClip(const QRegion &region);
 
@@ -102,6 +103,8 @@ private:
 
     // When using shared memory this is the region currently shared with the server
     QRegion m_dirtyShm;
+    // Sequence number of a request with a reply sent after the last shm upload
+    unsigned int m_shmFence = 0;
 
     // When not using shared memory this is a temporary buffer which is uploaded
     // as a pixmap region to server
@@ -257,6 +260,11 @@ void QXcbBackingStoreImage::destroy(bool destroyShm)
     }
     m_gc_drawable = 0;
 
+    if (m_shmFence) {
+        xcb_discard_reply(xcb_connection(), m_shmFence);
+        m_shmFence = 0;
+    }
+
     delete m_graphics_buffer;
     m_graphics_buffer = nullptr;
 
@@ -278,10 +286,8 @@ void QXcbBackingStoreImage::flushScrolledRegion(bool clientSideScroll)
     if (m_scrolledRegion.isNull())
         return;
 
-    if (hasShm() && m_dirtyShm.intersects(m_scrolledRegion)) {
-        connection()->sync();
-        m_dirtyShm = QRegion();
-    }
+    if (hasShm() && m_dirtyShm.intersects(m_scrolledRegion))
+        waitForShm();
 
     if (m_clientSideScroll) {
         // Copy scrolled image region from server-side pixmap to client-side memory
@@ -583,7 +589,28 @@ void QXcbBackingStoreImage::shmPutImage(xcb_drawable_t drawable, const QRegion &
                           m_shm_info.shmseg,
                           m_xcb_image->data - m_shm_info.shmaddr);
     }
+    if (region.isEmpty())
+        return;
     m_dirtyShm |= region.translated(offset);
+
+    // Ask for a reply right away, so that by the time the next paint needs
+    // the server to be done with the segment, the reply has usually arrived
+    // and waiting for it does not cost a round trip.
+    if (m_shmFence)
+        xcb_discard_reply(xcb_connection(), m_shmFence);
+    m_shmFence = xcb_get_input_focus(xcb_connection()).sequence;
+}
+
+void QXcbBackingStoreImage::waitForShm()
+{
+    if (m_shmFence) {
+        xcb_get_input_focus_cookie_t cookie = { m_shmFence };
+        free(xcb_get_input_focus_reply(xcb_connection(), cookie, nullptr));
+        m_shmFence = 0;
+    } else {
+        connection()->sync();
+    }
+    m_dirtyShm = QRegion();
 }
 
 void QXcbBackingStoreImage::flushPixmap(const QRegion &region, bool fullRegion)
@@ -703,9 +730,10 @@ void QXcbBackingStoreImage::put(xcb_drawable_t dst, const QRegion &region, const
         const QRect source = bounds.translated(offset);
 
         // First clip in backingstore-local coordinates, and upload
-        // the changed parts of the backingstore to the server.
+        // the changed parts of the flushed region to the server, rect
+        // by rect rather than everything pending within the bounds.
         setClip(source);
-        flushPixmap(source);
+        flushPixmap(region.translated(offset));
 
         // Then clip in window local coordinates, and copy the updated
         // parts of the backingstore image server-side to the window.
@@ -726,10 +754,8 @@ void QXcbBackingStoreImage::preparePaint(const QRegion &region)
 {
     if (hasShm()) {
         // to prevent X from reading from the image region while we're writing to it
-        if (m_dirtyShm.intersects(region)) {
-            connection()->sync();
-            m_dirtyShm = QRegion();
-        }
+        if (m_dirtyShm.intersects(region))
+            waitForShm();
     }
     m_scrolledRegion -= region;
     m_pendingFlush |= region;
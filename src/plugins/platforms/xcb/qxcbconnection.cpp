@@ -966,12 +966,11 @@ bool QXcbConnection::compressEvent(xcb_generic_event_t *event) const
 
     uint responseType = event->response_type & ~0x80;
 
+    // The event queue keeps track of the latest motion events as they are
+    // read, so there is no need to search the queue for them.
     if (responseType == XCB_MOTION_NOTIFY) {
         // compress XCB_MOTION_NOTIFY notify events
-        return m_eventQueue->peek(QXcbEventQueue::PeekRetainMatch,
-                                  [](xcb_generic_event_t *, int type) {
-            return type == XCB_MOTION_NOTIFY;
-        });
+        return m_eventQueue->hasLaterMotion();
     }
 
     // compress XI_* events
@@ -987,24 +986,13 @@ bool QXcbConnection::compressEvent(xcb_generic_event_t *event) const
                     const_cast<QXcbConnection *>(this)->tabletDataForDevice(xdev->sourceid))
                 return false;
 #endif // QT_CONFIG(tabletevent)
-            return m_eventQueue->peek(QXcbEventQueue::PeekRetainMatch,
-                                      [this](xcb_generic_event_t *next, int) {
-                return isXIType(next, XCB_INPUT_MOTION);
-            });
+            return m_eventQueue->hasLaterXIMotion();
         }
 
         // compress XI_TouchUpdate for the same touch point id
         if (isXIType(event, XCB_INPUT_TOUCH_UPDATE)) {
             auto touchUpdateEvent = reinterpret_cast<xcb_input_touch_update_event_t *>(event);
-            uint32_t id = touchUpdateEvent->detail % INT_MAX;
-
-            return m_eventQueue->peek(QXcbEventQueue::PeekRetainMatch,
-                                      [this, &id](xcb_generic_event_t *next, int) {
-                if (!isXIType(next, XCB_INPUT_TOUCH_UPDATE))
-                    return false;
-                auto touchUpdateNextEvent = reinterpret_cast<xcb_input_touch_update_event_t *>(next);
-                return id == touchUpdateNextEvent->detail % INT_MAX;
-            });
+            return m_eventQueue->hasLaterXITouchUpdate(touchUpdateEvent->detail % INT_MAX);
         }
 
         return false;
@@ -101,7 +101,12 @@ bool QXcbGlibEventDispatcher::processEvents(QEventLoop::ProcessEventsFlags flags
 QAbstractEventDispatcher *QXcbEventDispatcher::createEventDispatcher(QXcbConnection *connection)
 {
 #if QT_CONFIG(glib)
-    if (qEnvironmentVariableIsEmpty("QT_NO_GLIB") && QEventDispatcherGlib::versionSupported()) {
+    bool useGlib = qEnvironmentVariableIsEmpty("QT_NO_GLIB");
+#  if QT_CONFIG(epoll)
+    // an explicit request for the epoll backend overrides the glib default
+    useGlib = useGlib && !QEventDispatcherUNIXPrivate::epollRequested();
+#  endif
+    if (useGlib && QEventDispatcherGlib::versionSupported()) {
         qCDebug(lcQpaXcb, "using glib dispatcher");
         return new QXcbGlibEventDispatcher(connection);
     } else
@@ -9,6 +9,10 @@
 #include <QtCore/QMutex>
 #include <QtCore/QDebug>
 
+#include <xcb/xinput.h>
+
+#include <climits>
+
 QT_BEGIN_NAMESPACE
 
 Q_CONSTINIT static QBasicMutex qAppExiting;
@@ -72,6 +76,8 @@ QXcbEventQueue::~QXcbEventQueue()
     flushBufferedEvents();
     while (xcb_generic_event_t *event = takeFirst(QEventLoop::AllEvents))
         free(event);
+    for (const auto &inputEvent : std::as_const(m_inputEvents))
+        free(inputEvent.first);
 
     if (m_head && m_head->fromHeap)
         delete m_head; // the deferred node
@@ -95,7 +101,7 @@ xcb_generic_event_t *QXcbEventQueue::takeFirst(QEventLoop::ProcessEventsFlags fl
         xcb_generic_event_t *event = nullptr;
         while ((event = takeFirst())) {
             if (m_connection->isUserInputEvent(event)) {
-                m_inputEvents << event;
+                m_inputEvents.append({ event, m_takenSerial });
                 continue;
             }
             break;
@@ -103,8 +109,11 @@ xcb_generic_event_t *QXcbEventQueue::takeFirst(QEventLoop::ProcessEventsFlags fl
         return event;
     }
 
-    if (!m_inputEvents.isEmpty())
-        return m_inputEvents.takeFirst();
+    if (!m_inputEvents.isEmpty()) {
+        const auto [event, serial] = m_inputEvents.takeFirst();
+        m_takenSerial = serial;
+        return event;
+    }
     return takeFirst();
 }
 
@@ -116,6 +125,7 @@ xcb_generic_event_t *QXcbEventQueue::takeFirst()
     xcb_generic_event_t *event = nullptr;
     do {
         event = m_head->event;
+        m_takenSerial = m_head->serial;
         if (m_head == m_flushedTail) {
             // defer dequeuing until next successful flush of events
             if (event) // check if not cleared already by some filter
@@ -173,17 +183,49 @@ QXcbEventNode *QXcbEventQueue::qXcbEventNodeFactory(xcb_generic_event_t *event)
     return node;
 }
 
+void QXcbEventQueue::recordCompressibleEvent(xcb_generic_event_t *event, quint64 serial)
+{
+    const uint responseType = event->response_type & ~0x80;
+    if (responseType == XCB_MOTION_NOTIFY) {
+        m_lastMotionSerial.store(serial, std::memory_order_relaxed);
+        return;
+    }
+
+    // The XInput extension has been set up before this thread was started
+    if (responseType != XCB_GE_GENERIC || !m_connection->hasXInput2())
+        return;
+    if (m_connection->isXIType(event, XCB_INPUT_MOTION)) {
+        m_lastXIMotionSerial.store(serial, std::memory_order_relaxed);
+    } else if (m_connection->isXIType(event, XCB_INPUT_TOUCH_UPDATE)) {
+        auto touchUpdateEvent = reinterpret_cast<xcb_input_touch_update_event_t *>(event);
+        QMutexLocker locker(&m_touchUpdateMutex);
+        m_lastXITouchUpdateSerial.insert(touchUpdateEvent->detail % INT_MAX, serial);
+    } else if (m_connection->isXIType(event, XCB_INPUT_TOUCH_END)) {
+        auto touchEndEvent = reinterpret_cast<xcb_input_touch_end_event_t *>(event);
+        QMutexLocker locker(&m_touchUpdateMutex);
+        m_lastXITouchUpdateSerial.remove(touchEndEvent->detail % INT_MAX);
+    }
+}
+
+bool QXcbEventQueue::hasLaterXITouchUpdate(quint32 touchId)
+{
+    QMutexLocker locker(&m_touchUpdateMutex);
+    return m_lastXITouchUpdateSerial.value(touchId) > m_takenSerial;
+}
+
 void QXcbEventQueue::run()
 {
     xcb_generic_event_t *event = nullptr;
     xcb_connection_t *connection = m_connection->xcb_connection();
     QXcbEventNode *tail = m_head;
+    quint64 serial = 0;
 
-    auto enqueueEvent = [&tail, this](xcb_generic_event_t *event) {
+    auto enqueueEvent = [&tail, &serial, this](xcb_generic_event_t *event) {
         if (!isCloseConnectionEvent(event)) {
             tail->next = qXcbEventNodeFactory(event);
             tail = tail->next;
-            m_tail.store(tail, std::memory_order_release);
+            tail->serial = ++serial;
+            recordCompressibleEvent(event, serial);
         } else {
             free(event);
         }
@@ -196,6 +238,8 @@ void QXcbEventQueue::run()
         enqueueEvent(event);
         while (!m_closeConnectionDetected && (event = xcb_poll_for_queued_event(connection)))
             enqueueEvent(event);
+        // Hand over everything that was read in one go
+        m_tail.store(tail, std::memory_order_release);
 
         m_newEventsCondition.wakeOne();
         m_newEventsMutex.unlock();
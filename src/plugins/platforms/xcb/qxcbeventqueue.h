@@ -23,6 +23,7 @@ struct QXcbEventNode {
 
     xcb_generic_event_t *event;
     QXcbEventNode *next = nullptr;
+    quint64 serial = 0;
     bool fromHeap = false;
 };
 
@@ -85,6 +86,14 @@ public:
     bool peekEventQueue(PeekerCallback peeker, void *peekerData = nullptr,
                         PeekOptions option = PeekDefault, qint32 peekerId = -1);
 
+    // Whether the reader has seen another event that supersedes the one
+    // last returned by takeFirst(), for the event compression.
+    bool hasLaterMotion() const
+    { return m_lastMotionSerial.load(std::memory_order_relaxed) > m_takenSerial; }
+    bool hasLaterXIMotion() const
+    { return m_lastXIMotionSerial.load(std::memory_order_relaxed) > m_takenSerial; }
+    bool hasLaterXITouchUpdate(quint32 touchId);
+
     const QXcbEventNode *flushedTail() const { return m_flushedTail; }
     void waitForNewEvents(const QXcbEventNode *sinceFlushedTail,
                           unsigned long time = (std::numeric_limits<unsigned long>::max)());
@@ -92,6 +101,7 @@ public:
 private:
     QXcbEventNode *qXcbEventNodeFactory(xcb_generic_event_t *event);
     void dequeueNode();
+    void recordCompressibleEvent(xcb_generic_event_t *event, quint64 serial);
 
     void sendCloseConnectionEvent() const;
     bool isCloseConnectionEvent(const xcb_generic_event_t *event);
@@ -112,7 +122,16 @@ private:
     bool m_peekerIndexCacheDirty = false;
     QHash<qint32, QXcbEventNode *> m_peekerToNode;
 
-    QList<xcb_generic_event_t *> m_inputEvents;
+    QList<std::pair<xcb_generic_event_t *, quint64>> m_inputEvents;
+
+    // The serials of the latest compressible events, written by the reader
+    // thread as the events arrive, so that the compression does not have to
+    // search the queue for each event it processes.
+    quint64 m_takenSerial = 0;
+    std::atomic<quint64> m_lastMotionSerial { 0 };
+    std::atomic<quint64> m_lastXIMotionSerial { 0 };
+    QMutex m_touchUpdateMutex;
+    QHash<quint32, quint64> m_lastXITouchUpdateSerial;
 
     // debug stats
     quint64 m_nodesOnHeap = 0;
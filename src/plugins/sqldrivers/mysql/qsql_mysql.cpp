@@ -18,6 +18,7 @@
 #include <qstringlist.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtSql/private/qsqlresult_p.h>
+#include <QtSql/private/qsqlstatementcache_p.h>
 
 #ifdef Q_OS_WIN32
 // comment the next line out if you want to use MySQL/embedded on Win32 systems.
@@ -62,9 +63,20 @@ public:
     {}
     MYSQL *mysql = nullptr;
     QString dbName;
+    QSqlStatementCache<MYSQL_STMT *> statementCache;
     bool preparedQuerysEnabled = false;
+
+    void clearStatementCache();
 };
 
+void QMYSQLDriverPrivate::clearStatementCache()
+{
+    statementCache.clear([](MYSQL_STMT *stmt) {
+        if (mysql_stmt_close(stmt))
+            qWarning("QMYSQLDriver: unable to free statement handle");
+    });
+}
+
 static inline QVariant qDateFromString(const QString &val)
 {
 #if !QT_CONFIG(datestring)
@@ -178,6 +190,7 @@ public:
     QList<QMyField> fields;
 
     MYSQL_STMT *stmt = nullptr;
+    QString stmtQuery; // the query stmt was prepared for
     MYSQL_RES *meta = nullptr;
 
     MYSQL_BIND *inBinds = nullptr;
@@ -406,9 +419,21 @@ void QMYSQLResult::cleanup()
     }
 
     if (d->stmt) {
-        if (mysql_stmt_close(d->stmt))
+        QMYSQLDriverPrivate *drv = driver() ? const_cast<QMYSQLDriverPrivate *>(d->drv_d_func())
+                                            : nullptr;
+        if (drv && drv->mysql && drv->statementCache.isEnabled() && !d->stmtQuery.isEmpty()) {
+            // give the statement back to the cache of the driver
+            mysql_stmt_free_result(d->stmt);
+            mysql_stmt_reset(d->stmt);
+            drv->statementCache.insert(d->stmtQuery, d->stmt, [](MYSQL_STMT *stmt) {
+                if (mysql_stmt_close(stmt))
+                    qWarning("QMYSQLResult::cleanup: unable to free statement handle");
+            });
+        } else if (mysql_stmt_close(d->stmt)) {
             qWarning("QMYSQLResult::cleanup: unable to free statement handle");
+        }
         d->stmt = 0;
+        d->stmtQuery.clear();
     }
 
     if (d->meta) {
@@ -869,22 +894,28 @@ bool QMYSQLResult::prepare(const QString& query)
     if (query.isEmpty())
         return false;
 
-    if (!d->stmt)
-        d->stmt = mysql_stmt_init(d->drv_d_func()->mysql);
-    if (!d->stmt) {
-        setLastError(qMakeError(QCoreApplication::translate("QMYSQLResult", "Unable to prepare statement"),
-                     QSqlError::StatementError, d->drv_d_func()));
-        return false;
-    }
+    auto drv = const_cast<QMYSQLDriverPrivate *>(d->drv_d_func());
+    if (std::optional<MYSQL_STMT *> cached = drv->statementCache.take(query)) {
+        d->stmt = *cached;
+    } else {
+        if (!d->stmt)
+            d->stmt = mysql_stmt_init(drv->mysql);
+        if (!d->stmt) {
+            setLastError(qMakeError(QCoreApplication::translate("QMYSQLResult", "Unable to prepare statement"),
+                         QSqlError::StatementError, drv));
+            return false;
+        }
 
-    const QByteArray encQuery = query.toUtf8();
-    r = mysql_stmt_prepare(d->stmt, encQuery.constData(), encQuery.size());
-    if (r != 0) {
-        setLastError(qMakeStmtError(QCoreApplication::translate("QMYSQLResult",
-                     "Unable to prepare statement"), QSqlError::StatementError, d->stmt));
-        cleanup();
-        return false;
+        const QByteArray encQuery = query.toUtf8();
+        r = mysql_stmt_prepare(d->stmt, encQuery.constData(), encQuery.size());
+        if (r != 0) {
+            setLastError(qMakeStmtError(QCoreApplication::translate("QMYSQLResult",
+                         "Unable to prepare statement"), QSqlError::StatementError, d->stmt));
+            cleanup();
+            return false;
+        }
     }
+    d->stmtQuery = query;
 
     const auto paramCount = mysql_stmt_param_count(d->stmt);
     if (paramCount > 0) // allocate memory for outvalues
@@ -1129,6 +1160,8 @@ void QMYSQLDriver::init()
 
 QMYSQLDriver::~QMYSQLDriver()
 {
+    Q_D(QMYSQLDriver);
+    d->clearStatementCache();
     qMySqlConnectionCount--;
     if (qMySqlConnectionCount == 0 && !qMySqlInitHandledByUser)
         qLibraryEnd();
@@ -1315,6 +1348,7 @@ bool QMYSQLDriver::open(const QString &db,
     unsigned int optionFlags = CLIENT_MULTI_STATEMENTS;
     const QList<QStringView> opts(QStringView(connOpts).split(u';', Qt::SkipEmptyParts));
     QString unixSocket;
+    qsizetype statementCacheSize = 0;
 
     // extract the real options from the string
     for (const auto &option : opts) {
@@ -1327,6 +1361,8 @@ bool QMYSQLDriver::open(const QString &db,
                 continue;
             else if (key  == "UNIX_SOCKET"_L1)
                 unixSocket = val.toString();
+            else if (key == "QMYSQL_STATEMENT_CACHE_SIZE"_L1)
+                statementCacheSize = qSqlStatementCacheSize(sv.mid(idx));
             else if (val == "TRUE"_L1 || val == "1"_L1)
                 setOptionFlag(optionFlags, key);
             else
@@ -1396,6 +1432,7 @@ bool QMYSQLDriver::open(const QString &db,
     }
 
     d->preparedQuerysEnabled = checkPreparedQueries(d->mysql);
+    d->statementCache.setCapacity(statementCacheSize);
     d->dbName = db;
 
 #if QT_CONFIG(thread)
@@ -1411,6 +1448,7 @@ void QMYSQLDriver::close()
 {
     Q_D(QMYSQLDriver);
     if (isOpen()) {
+        d->clearStatementCache();
 #if QT_CONFIG(thread)
         mysql_thread_end();
 #endif
@@ -22,6 +22,7 @@
 #include <QSqlQuery>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtSql/private/qsqlresult_p.h>
+#include <QtSql/private/qsqlstatementcache_p.h>
 #include "private/qtools_p.h"
 
 QT_BEGIN_NAMESPACE
@@ -38,27 +39,35 @@ using namespace Qt::StringLiterals;
 
 static constexpr int COLNAMESIZE = 256;
 static constexpr SQLSMALLINT TABLENAMESIZE = 128;
+// the largest value of a column that is fetched into a rowset buffer
+static constexpr SQLLEN MAXROWSETVALUESIZE = 8192;
 //Map Qt parameter types to ODBC types
 static constexpr SQLSMALLINT qParamType[4] = { SQL_PARAM_INPUT, SQL_PARAM_INPUT, SQL_PARAM_OUTPUT, SQL_PARAM_INPUT_OUTPUT };
 
-template<typename C, int SIZE = sizeof(SQLTCHAR)>
-inline static QString fromSQLTCHAR(const C &input, qsizetype size = -1)
+template<int SIZE = sizeof(SQLTCHAR)>
+inline static QString fromSQLChars(const void *input, qsizetype size)
 {
-    // Remove any trailing \0 as some drivers misguidedly append one
-    qsizetype realsize = qMin(size, input.size());
-    if (realsize > 0 && input[realsize - 1] == 0)
-        realsize--;
     if constexpr (SIZE == 1)
-        return QString::fromUtf8(reinterpret_cast<const char *>(input.constData()), realsize);
+        return QString::fromUtf8(static_cast<const char *>(input), size);
     else if constexpr (SIZE == 2)
-        return QString::fromUtf16(reinterpret_cast<const char16_t *>(input.constData()), realsize);
+        return QString::fromUtf16(static_cast<const char16_t *>(input), size);
     else if constexpr (SIZE == 4)
-        return QString::fromUcs4(reinterpret_cast<const char32_t *>(input.constData()), realsize);
+        return QString::fromUcs4(static_cast<const char32_t *>(input), size);
     else
         static_assert(QtPrivate::value_dependent_false<SIZE>(),
                       "Don't know how to handle sizeof(SQLTCHAR) != 1/2/4");
 }
 
+template<typename C, int SIZE = sizeof(SQLTCHAR)>
+inline static QString fromSQLTCHAR(const C &input, qsizetype size = -1)
+{
+    // Remove any trailing \0 as some drivers misguidedly append one
+    qsizetype realsize = qMin(size, input.size());
+    if (realsize > 0 && input[realsize - 1] == 0)
+        realsize--;
+    return fromSQLChars<SIZE>(input.constData(), realsize);
+}
+
 template<int SIZE = sizeof(SQLTCHAR)>
 QStringConverter::Encoding encodingForSqlTChar()
 {
@@ -101,6 +110,10 @@ public:
     bool isFreeTDSDriver = false;
     bool hasSQLFetchScroll = true;
     bool hasMultiResultSets = false;
+    // the number of rows forward-only results fetch at once
+    SQLULEN rowsetSize = 1;
+    // the handles of prepared statements no result uses
+    QSqlStatementCache<SQLHANDLE> statementCache;
 
     bool checkDriver() const;
     void checkUnicode();
@@ -174,6 +187,8 @@ public:
     SQLHANDLE dpEnv() const { return drv_d_func() ? drv_d_func()->hEnv : 0;}
     SQLHANDLE dpDbc() const { return drv_d_func() ? drv_d_func()->hDbc : 0;}
     SQLHANDLE hStmt = nullptr;
+    // the statement cache key of hStmt, empty unless it was prepared
+    QString stmtQuery;
 
     QSqlRecord rInf;
     QVariantList fieldCache;
@@ -185,6 +200,25 @@ public:
 
     bool isStmtHandleValid() const;
     void updateStmtHandleState();
+    SQLRETURN releaseStmtHandle();
+
+    // The buffers a forward-only result fetches blocks of rows into, see
+    // bindRowset(); empty if the rows are fetched one at a time
+    struct RowsetColumn
+    {
+        QByteArray buffer;
+        QList<SQLLEN> indicators;
+        QVariant null;
+        SQLLEN elementSize = 0;
+        SQLSMALLINT cType = 0;
+    };
+    QList<RowsetColumn> rowset;
+    SQLULEN rowsetFetched = 0;  // the number of rows in the buffers
+    SQLULEN rowsetPos = 0;      // the current row in the buffers
+
+    bool bindRowset(QSql::NumericalPrecisionPolicy policy);
+    void unbindRowset();
+    QVariant rowsetValue(int column);
 };
 
 bool QODBCResultPrivate::isStmtHandleValid() const
@@ -197,6 +231,29 @@ void QODBCResultPrivate::updateStmtHandleState()
     disconnectCount = drv_d_func() ? drv_d_func()->disconnectCount : 0;
 }
 
+static void qFreeStmtHandle(SQLHANDLE hStmt)
+{
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+}
+
+// Frees hStmt, or gives it back to the statement cache of the driver if it
+// holds a prepared statement. The caller checks that hStmt is valid.
+SQLRETURN QODBCResultPrivate::releaseStmtHandle()
+{
+    unbindRowset();
+    const QString query = std::exchange(stmtQuery, QString());
+    auto driver = const_cast<QODBCDriverPrivate *>(drv_d_func());
+    if (query.isEmpty() || !driver || !driver->statementCache.isEnabled())
+        return SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+
+    // close the cursor and drop the bindings, but keep the statement
+    SQLFreeStmt(hStmt, SQL_CLOSE);
+    SQLFreeStmt(hStmt, SQL_UNBIND);
+    SQLFreeStmt(hStmt, SQL_RESET_PARAMS);
+    driver->statementCache.insert(query, std::exchange(hStmt, nullptr), qFreeStmtHandle);
+    return SQL_SUCCESS;
+}
+
 struct DiagRecord
 {
     QString description;
@@ -662,6 +719,211 @@ static QSqlField qMakeFieldInfo(const SQLHANDLE hStmt, int i, QString *errorMess
     return f;
 }
 
+// Binds a buffer to each column of a forward-only result, so that a fetch
+// transfers a whole block of rows instead of one. This is only done if the
+// values of all the columns have a small maximum size, since the columns
+// that are not bound would have to be read with SQLGetData(), which the
+// drivers don't need to support for blocks of rows.
+bool QODBCResultPrivate::bindRowset(QSql::NumericalPrecisionPolicy policy)
+{
+    Q_ASSERT(rowset.isEmpty());
+    SQLULEN rowsetSize = drv_d_func() ? drv_d_func()->rowsetSize : 1;
+    if (rowsetSize <= 1)
+        return false;
+
+    QList<RowsetColumn> columns(rInf.count());
+    for (qsizetype i = 0; i < columns.size(); ++i) {
+        RowsetColumn &column = columns[i];
+        const QSqlField info = rInf.field(i);
+        const SQLLEN length = qMax(info.length(), 0);
+        // the same conversions as in QODBCResult::data()
+        switch (info.metaType().id()) {
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            column.cType = info.metaType().id() == QMetaType::LongLong ? SQL_C_SBIGINT
+                                                                       : SQL_C_UBIGINT;
+            column.elementSize = sizeof(SQLBIGINT);
+            column.null = QVariant(QMetaType::fromType<qlonglong>());
+            break;
+        case QMetaType::Int:
+        case QMetaType::Short:
+        case QMetaType::UInt:
+        case QMetaType::UShort:
+            column.cType = info.metaType().id() == QMetaType::Int
+                            || info.metaType().id() == QMetaType::Short ? SQL_C_SLONG
+                                                                        : SQL_C_ULONG;
+            column.elementSize = sizeof(SQLINTEGER);
+            column.null = QVariant(QMetaType::fromType<int>());
+            break;
+        case QMetaType::QDate:
+            column.cType = SQL_C_DATE;
+            column.elementSize = sizeof(DATE_STRUCT);
+            column.null = QVariant(QMetaType::fromType<QDate>());
+            break;
+        case QMetaType::QTime:
+            column.cType = SQL_C_TIME;
+            column.elementSize = sizeof(TIME_STRUCT);
+            column.null = QVariant(QMetaType::fromType<QTime>());
+            break;
+        case QMetaType::QDateTime:
+            column.cType = SQL_C_TIMESTAMP;
+            column.elementSize = sizeof(TIMESTAMP_STRUCT);
+            column.null = QVariant(QMetaType::fromType<QDateTime>());
+            break;
+        case QMetaType::QByteArray:
+            if (!length)
+                return false;
+            column.cType = SQL_C_BINARY;
+            column.elementSize = length;
+            column.null = QVariant(QMetaType::fromType<QByteArray>());
+            break;
+        case QMetaType::QString:
+            if (!length)
+                return false;
+            if (unicode) {
+                column.cType = SQL_C_TCHAR;
+                column.elementSize = (length + 1) * sizeof(SQLTCHAR);
+            } else {
+                // UTF-8 takes up to 4 bytes per character
+                column.cType = SQL_C_CHAR;
+                column.elementSize = length * 4 + 1;
+            }
+            break;
+        case QMetaType::Double:
+            switch (policy) {
+            case QSql::LowPrecisionInt32:
+                column.cType = SQL_C_SLONG;
+                column.elementSize = sizeof(SQLINTEGER);
+                column.null = QVariant(QMetaType::fromType<int>());
+                break;
+            case QSql::LowPrecisionInt64:
+                column.cType = SQL_C_SBIGINT;
+                column.elementSize = sizeof(SQLBIGINT);
+                column.null = QVariant(QMetaType::fromType<qlonglong>());
+                break;
+            case QSql::LowPrecisionDouble:
+                column.cType = SQL_C_DOUBLE;
+                column.elementSize = sizeof(SQLDOUBLE);
+                column.null = QVariant(QMetaType::fromType<double>());
+                break;
+            case QSql::HighPrecision:
+                // room for the sign, the decimal point and an exponent
+                column.cType = SQL_C_CHAR;
+                column.elementSize = length + 32;
+                break;
+            }
+            break;
+        default:
+            column.cType = SQL_C_CHAR;
+            column.elementSize = length + 64;
+            break;
+        }
+        if (column.elementSize > MAXROWSETVALUESIZE)
+            return false;
+    }
+
+    SQLRETURN r = SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, SQLPOINTER(rowsetSize),
+                                 SQL_IS_UINTEGER);
+    if (r == SQL_SUCCESS_WITH_INFO) {
+        // the driver picked a size of its own
+        r = SQLGetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, &rowsetSize, SQL_IS_UINTEGER, nullptr);
+    }
+    if ((r != SQL_SUCCESS && r != SQL_SUCCESS_WITH_INFO) || rowsetSize <= 1) {
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, SQLPOINTER(1), SQL_IS_UINTEGER);
+        return false;
+    }
+
+    rowset = std::move(columns);
+    r = SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowsetFetched, SQL_IS_POINTER);
+    for (qsizetype i = 0; i < rowset.size() && (r == SQL_SUCCESS || r == SQL_SUCCESS_WITH_INFO);
+         ++i) {
+        RowsetColumn &column = rowset[i];
+        column.buffer.resize(column.elementSize * rowsetSize);
+        column.indicators.resize(rowsetSize);
+        r = SQLBindCol(hStmt, SQLUSMALLINT(i + 1), column.cType, column.buffer.data(),
+                       column.elementSize, column.indicators.data());
+    }
+    if (r != SQL_SUCCESS && r != SQL_SUCCESS_WITH_INFO) {
+        qSqlWarning("QODBCResult: Unable to bind the columns for fetching blocks of rows"_L1,
+                    this);
+        unbindRowset();
+        return false;
+    }
+    return true;
+}
+
+void QODBCResultPrivate::unbindRowset()
+{
+    if (!rowset.isEmpty() && hStmt && isStmtHandleValid()) {
+        SQLFreeStmt(hStmt, SQL_UNBIND);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROW_ARRAY_SIZE, SQLPOINTER(1), SQL_IS_UINTEGER);
+        SQLSetStmtAttr(hStmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, SQL_IS_POINTER);
+    }
+    rowset.clear();
+    rowsetFetched = 0;
+    rowsetPos = 0;
+}
+
+// converts the value of column in the current row of the rowset
+QVariant QODBCResultPrivate::rowsetValue(int column)
+{
+    const RowsetColumn &col = rowset.at(column);
+    const SQLLEN length = col.indicators.at(rowsetPos);
+    if (length == SQL_NULL_DATA)
+        return col.null;
+    const char *value = col.buffer.constData() + rowsetPos * col.elementSize;
+
+    // a string needs room for its terminating \0
+    const SQLLEN available = col.cType == SQL_C_BINARY ? col.elementSize : col.elementSize - 1;
+    switch (col.cType) {
+    case SQL_C_SBIGINT:
+        return qint64(*reinterpret_cast<const SQLBIGINT *>(value));
+    case SQL_C_UBIGINT:
+        return quint64(*reinterpret_cast<const SQLUBIGINT *>(value));
+    case SQL_C_SLONG:
+        return int(*reinterpret_cast<const SQLINTEGER *>(value));
+    case SQL_C_ULONG:
+        return uint(*reinterpret_cast<const SQLUINTEGER *>(value));
+    case SQL_C_DOUBLE:
+        return double(*reinterpret_cast<const SQLDOUBLE *>(value));
+    case SQL_C_DATE: {
+        const auto dbuf = reinterpret_cast<const DATE_STRUCT *>(value);
+        return QVariant(QDate(dbuf->year, dbuf->month, dbuf->day)); }
+    case SQL_C_TIME: {
+        const auto tbuf = reinterpret_cast<const TIME_STRUCT *>(value);
+        return QVariant(QTime(tbuf->hour, tbuf->minute, tbuf->second)); }
+    case SQL_C_TIMESTAMP: {
+        const auto dtbuf = reinterpret_cast<const TIMESTAMP_STRUCT *>(value);
+        return QVariant(QDateTime(QDate(dtbuf->year, dtbuf->month, dtbuf->day),
+                                  QTime(dtbuf->hour, dtbuf->minute, dtbuf->second,
+                                        dtbuf->fraction / 1000000))); }
+    default:
+        break;
+    }
+
+    if (length == SQL_NO_TOTAL || length > available) {
+        // The driver described the column as smaller than its values, so
+        // read the whole value of this row again
+        const SQLRETURN r = SQLSetPos(hStmt, SQLSETPOSIROW(rowsetPos + 1), SQL_POSITION,
+                                      SQL_LOCK_NO_CHANGE);
+        if (r != SQL_SUCCESS && r != SQL_SUCCESS_WITH_INFO) {
+            qSqlWarning("QODBCResult::data: Unable to read a truncated value"_L1, this);
+            return QVariant();
+        }
+        if (col.cType == SQL_C_BINARY)
+            return qGetBinaryData(hStmt, column);
+        const QSqlField info = rInf.field(column);
+        return qGetStringData(hStmt, column, info.length(),
+                              unicode && info.metaType().id() == QMetaType::QString);
+    }
+
+    if (col.cType == SQL_C_BINARY)
+        return QByteArray(value, length);
+    if (col.cType == SQL_C_CHAR)
+        return fromSQLChars<1>(value, length);
+    return fromSQLChars(value, length / sizeof(SQLTCHAR));
+}
+
 static size_t qGetODBCVersion(const QString &connOpts)
 {
     if (connOpts.contains("SQL_ATTR_ODBC_VERSION=SQL_OV_ODBC3"_L1, Qt::CaseInsensitive))
@@ -714,7 +976,19 @@ bool QODBCDriverPrivate::setConnectionOptions(const QString& connOpts)
         SQLUINTEGER v = 0;
 
         r = SQL_SUCCESS;
-        if (opt.toUpper() == "SQL_ATTR_ACCESS_MODE"_L1) {
+        if (opt.toUpper() == "QODBC_STATEMENT_CACHE_SIZE"_L1) {
+            statementCache.setCapacity(qSqlStatementCacheSize(tmp.mid(idx)));
+            continue;
+        } else if (opt.toUpper() == "QODBC_ROWSET_SIZE"_L1) {
+            bool ok = false;
+            v = val.toUInt(&ok);
+            if (!ok || v == 0) {
+                qWarning() << "QODBCDriver::open: Unknown option value '" << val << '\'';
+                continue;
+            }
+            rowsetSize = v;
+            continue;
+        } else if (opt.toUpper() == "SQL_ATTR_ACCESS_MODE"_L1) {
             if (val.toUpper() == "SQL_MODE_READ_ONLY"_L1) {
                 v = SQL_MODE_READ_ONLY;
             } else if (val.toUpper() == "SQL_MODE_READ_WRITE"_L1) {
@@ -888,7 +1162,7 @@ QODBCResult::~QODBCResult()
 {
     Q_D(QODBCResult);
     if (d->hStmt && d->isStmtHandleValid() && driver() && driver()->isOpen()) {
-        SQLRETURN r = SQLFreeHandle(SQL_HANDLE_STMT, d->hStmt);
+        SQLRETURN r = d->releaseStmtHandle();
         if (r != SQL_SUCCESS)
             qSqlWarning("QODBCDriver: Unable to free statement handle "_L1
                          + QString::number(r), d);
@@ -903,12 +1177,13 @@ bool QODBCResult::reset (const QString& query)
     d->rInf.clear();
     d->fieldCache.clear();
     d->fieldCacheIdx = 0;
+    d->unbindRowset();
 
     // Always reallocate the statement handle - the statement attributes
     // are not reset if SQLFreeStmt() is called which causes some problems.
     SQLRETURN r;
     if (d->hStmt && d->isStmtHandleValid()) {
-        r = SQLFreeHandle(SQL_HANDLE_STMT, d->hStmt);
+        r = d->releaseStmtHandle();
         if (r != SQL_SUCCESS) {
             qSqlWarning("QODBCResult::reset: Unable to free statement handle"_L1, d);
             return false;
@@ -967,6 +1242,8 @@ bool QODBCResult::reset (const QString& query)
             d->rInf.append(qMakeFieldInfo(d, i));
         }
         d->fieldCache.resize(count);
+        if (isForwardOnly())
+            d->bindRowset(numericalPrecisionPolicy());
     } else {
         setSelect(false);
     }
@@ -1018,6 +1295,13 @@ bool QODBCResult::fetchNext()
     SQLRETURN r;
     d->clearValues();
 
+    if (d->rowsetPos + 1 < d->rowsetFetched) {
+        // the row was fetched with the previous ones
+        ++d->rowsetPos;
+        setAt(at() + 1);
+        return true;
+    }
+
     if (d->hasSQLFetchScroll)
         r = SQLFetchScroll(d->hStmt,
                            SQL_FETCH_NEXT,
@@ -1031,6 +1315,9 @@ bool QODBCResult::fetchNext()
                 "Unable to fetch next"), QSqlError::ConnectionError, d));
         return false;
     }
+    d->rowsetPos = 0;
+    if (!d->rowset.isEmpty() && d->rowsetFetched == 0)
+        return false;
     setAt(at() + 1);
     return true;
 }
@@ -1128,6 +1415,14 @@ QVariant QODBCResult::data(int field)
     if (field < d->fieldCacheIdx)
         return d->fieldCache.at(field);
 
+    if (!d->rowset.isEmpty()) {
+        // convert the whole row, the values are all at hand
+        for (int i = d->fieldCacheIdx; i < d->rowset.size(); ++i)
+            d->fieldCache[i] = d->rowsetValue(i);
+        d->fieldCacheIdx = d->rowset.size();
+        return d->fieldCache.at(field);
+    }
+
     SQLRETURN r(0);
     SQLLEN lengthIndicator = 0;
 
@@ -1262,12 +1557,25 @@ bool QODBCResult::prepare(const QString& query)
 
     d->rInf.clear();
     if (d->hStmt && d->isStmtHandleValid()) {
-        r = SQLFreeHandle(SQL_HANDLE_STMT, d->hStmt);
+        r = d->releaseStmtHandle();
         if (r != SQL_SUCCESS) {
             qSqlWarning("QODBCResult::prepare: Unable to close statement"_L1, d);
             return false;
         }
     }
+
+    // the cursor type is set before preparing, so it is part of the key
+    const QString key = QChar(isForwardOnly() ? u'f' : u's') + query;
+    auto driverPrivate = const_cast<QODBCDriverPrivate *>(d->drv_d_func());
+    if (driverPrivate && driverPrivate->statementCache.isEnabled()) {
+        if (std::optional<SQLHANDLE> cached = driverPrivate->statementCache.take(key)) {
+            d->hStmt = *cached;
+            d->stmtQuery = key;
+            d->updateStmtHandleState();
+            return true;
+        }
+    }
+
     r  = SQLAllocHandle(SQL_HANDLE_STMT,
                          d->dpDbc(),
                          &d->hStmt);
@@ -1308,6 +1616,7 @@ bool QODBCResult::prepare(const QString& query)
                      "Unable to prepare statement"), QSqlError::StatementError, d));
         return false;
     }
+    d->stmtQuery = key;
     return true;
 }
 
@@ -1324,6 +1633,7 @@ bool QODBCResult::exec()
         qSqlWarning("QODBCResult::exec: No statement handle available"_L1, d);
         return false;
     }
+    d->unbindRowset();
 
     if (isSelect())
         SQLCloseCursor(d->hStmt);
@@ -1641,6 +1951,8 @@ bool QODBCResult::exec()
             d->rInf.append(qMakeFieldInfo(d, i));
         }
         d->fieldCache.resize(count);
+        if (isForwardOnly())
+            d->bindRowset(numericalPrecisionPolicy());
     } else {
         setSelect(false);
     }
@@ -1758,6 +2070,7 @@ bool QODBCResult::nextResult()
     d->fieldCache.clear();
     d->fieldCacheIdx = 0;
     setSelect(false);
+    d->unbindRowset();
 
     SQLRETURN r = SQLMoreResults(d->hStmt);
     if (r != SQL_SUCCESS) {
@@ -1780,6 +2093,8 @@ bool QODBCResult::nextResult()
             d->rInf.append(qMakeFieldInfo(d, i));
         }
         d->fieldCache.resize(count);
+        if (isForwardOnly())
+            d->bindRowset(numericalPrecisionPolicy());
     } else {
         setSelect(false);
     }
@@ -1984,6 +2299,7 @@ void QODBCDriver::cleanup()
     SQLRETURN r;
 
     if (d->hDbc) {
+        d->statementCache.clear(qFreeStmtHandle);
         // Open statements/descriptors handles are automatically cleaned up by SQLDisconnect
         if (isOpen()) {
             r = SQLDisconnect(d->hDbc);
@@ -17,6 +17,7 @@
 #include <qlocale.h>
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
+#include <QtSql/private/qsqlstatementcache_p.h>
 #include <QtCore/private/qlocale_tools_p.h>
 
 #include <queue>
@@ -109,6 +110,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind = false) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -123,10 +125,14 @@ public:
     QPSQLDriver::Protocol pro = QPSQLDriver::Version6;
     StatementId currentStmtId = InvalidStatementId;
     int stmtCount = 0;
+    int cursorFetchSize = 0;
+    QSqlStatementCache<QString> statementCache; // names of prepared statements
+    mutable int transactionSerial = 0;
     mutable bool pendingNotifyCheck = false;
     bool hasBackslashEscape = false;
 
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
+    void deallocatePreparedStmt(const QString &stmtId);
     PGresult *exec(const char *stmt);
     PGresult *exec(const QString &stmt);
     StatementId sendQuery(const QString &stmt);
@@ -136,6 +142,7 @@ public:
     void discardResults() const;
     StatementId generateStatementId();
     void checkPendingNotifications() const;
+    void checkTransactionStatus() const;
     QPSQLDriver::Protocol getPSQLVersion();
     bool setEncodingUtf8();
     void setDatestyle();
@@ -168,6 +175,7 @@ PGresult *QPSQLDriverPrivate::exec(const char *stmt)
     // PQexec() silently discards any prior query results that the application didn't eat.
     PGresult *result = PQexec(connection, stmt);
     currentStmtId = result ? generateStatementId() : InvalidStatementId;
+    checkTransactionStatus();
     checkPendingNotifications();
     return result;
 }
@@ -212,6 +220,7 @@ PGresult *QPSQLDriverPrivate::getResult(StatementId stmtId) const
         return nullptr;
     }
     PGresult *result = PQgetResult(connection);
+    checkTransactionStatus();
     checkPendingNotifications();
     return result;
 }
@@ -238,6 +247,15 @@ StatementId QPSQLDriverPrivate::generateStatementId()
     return stmtId;
 }
 
+void QPSQLDriverPrivate::checkTransactionStatus() const
+{
+    // Cursors declared without WITH HOLD only live as long as the transaction
+    // they were declared in. Every time a command leaves the connection
+    // outside of a transaction, a later one is a different transaction.
+    if (PQtransactionStatus(connection) == PQTRANS_IDLE)
+        ++transactionSerial;
+}
+
 void QPSQLDriverPrivate::checkPendingNotifications() const
 {
     Q_Q(const QPSQLDriver);
@@ -256,16 +274,29 @@ public:
 
     QString fieldSerial(qsizetype i) const override { return u'$' + QString::number(i + 1); }
     void deallocatePreparedStmt();
+    void releasePreparedStmt();
 
     std::queue<PGresult*> nextResultSets;
     QString preparedStmtId;
+    QString preparedQuery; // the query preparedStmtId was prepared for
+    QString cursorName;
     PGresult *result = nullptr;
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
+    int cursorRow = 0;      // row of the cursor that result starts with
+    int cursorPosition = 0; // row the next FETCH returns, -1 if unknown
+    int cursorTransaction = -1;
     bool canFetchMoreRows = false;
     bool preparedQueriesEnabled = false;
 
     bool processResults();
+    int resultRow() const;
+    bool useCursor(const QString &query) const;
+    bool declareCursor(const QString &query);
+    bool fetchFromCursor(int first);
+    bool seekCursor(int i);
+    bool fetchLastFromCursor();
+    void closeCursor();
 };
 
 static QSqlError qMakeError(const QString &err, QSqlError::ErrorType type,
@@ -374,19 +405,204 @@ static QMetaType qDecodePSQLType(int t)
     return QMetaType(type);
 }
 
+void QPSQLDriverPrivate::deallocatePreparedStmt(const QString &stmtId)
+{
+    const QString stmt = QStringLiteral("DEALLOCATE ") + stmtId;
+    PGresult *result = exec(stmt);
+
+    if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+        const QString msg = QString::fromUtf8(PQerrorMessage(connection));
+        qWarning("Unable to free statement: %ls", qUtf16Printable(msg));
+    }
+    PQclear(result);
+}
+
 void QPSQLResultPrivate::deallocatePreparedStmt()
 {
-    if (drv_d_func()) {
-        const QString stmt = QStringLiteral("DEALLOCATE ") + preparedStmtId;
-        PGresult *result = drv_d_func()->exec(stmt);
+    if (drv_d_func())
+        const_cast<QPSQLDriverPrivate *>(drv_d_func())->deallocatePreparedStmt(preparedStmtId);
+    preparedStmtId.clear();
+    preparedQuery.clear();
+}
 
-        if (PQresultStatus(result) != PGRES_COMMAND_OK) {
-            const QString msg = QString::fromUtf8(PQerrorMessage(drv_d_func()->connection));
-            qWarning("Unable to free statement: %ls", qUtf16Printable(msg));
-        }
+// gives the prepared statement back to the statement cache of the driver,
+// if it has one
+void QPSQLResultPrivate::releasePreparedStmt()
+{
+    auto driver = const_cast<QPSQLDriverPrivate *>(drv_d_func());
+    if (!driver || !driver->connection || !driver->statementCache.isEnabled()) {
+        deallocatePreparedStmt();
+        return;
+    }
+    driver->statementCache.insert(std::exchange(preparedQuery, QString()),
+                                  std::exchange(preparedStmtId, QString()),
+                                  [driver](const QString &stmtId) {
+        driver->deallocatePreparedStmt(stmtId);
+    });
+}
+
+static QString qMakeCursorName()
+{
+    Q_CONSTINIT static QBasicAtomicInt qCursorCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+    return QStringLiteral("qpsqlcursor_") + QString::number(qCursorCount.fetchAndAddRelaxed(1) + 1, 16);
+}
+
+int QPSQLResultPrivate::resultRow() const
+{
+    Q_Q(const QPSQLResult);
+    if (!cursorName.isEmpty())
+        return q->at() - cursorRow;
+    return q->isForwardOnly() ? 0 : q->at();
+}
+
+bool QPSQLResultPrivate::useCursor(const QString &query) const
+{
+    if (drv_d_func()->cursorFetchSize <= 0)
+        return false;
+    // Only a single statement that returns rows can be declared as a cursor.
+    const QStringView stmt = QStringView(query).trimmed();
+    const qsizetype semicolon = stmt.indexOf(u';');
+    if (semicolon != -1 && semicolon != stmt.size() - 1)
+        return false;
+    for (const QLatin1StringView keyword : { "select"_L1, "with"_L1, "values"_L1, "table"_L1 }) {
+        if (!stmt.startsWith(keyword, Qt::CaseInsensitive))
+            continue;
+        const QChar next = stmt.size() > keyword.size() ? stmt.at(keyword.size()) : QChar();
+        return !next.isLetterOrNumber() && next != u'_';
+    }
+    return false;
+}
+
+bool QPSQLResultPrivate::declareCursor(const QString &query)
+{
+    Q_Q(QPSQLResult);
+    QPSQLDriverPrivate *drv = drv_d_func();
+    QStringView select = QStringView(query).trimmed();
+    if (select.endsWith(u';'))
+        select.chop(1);
+
+    // Outside of a transaction the cursor has to outlive the implicit one
+    // DECLARE runs in, so the server keeps the rows until it is closed.
+    const bool hold = PQtransactionStatus(drv->connection) == PQTRANS_IDLE;
+    const QString name = qMakeCursorName();
+    const QString stmt = QStringLiteral("DECLARE %1 %2 CURSOR %3 FOR %4")
+            .arg(name, q->isForwardOnly() ? "NO SCROLL"_L1 : "SCROLL"_L1,
+                 hold ? "WITH HOLD"_L1 : "WITHOUT HOLD"_L1, select);
+    PGresult *res = drv->exec(stmt);
+    if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to create query"), QSqlError::StatementError, drv, res));
+        PQclear(res);
+        return false;
+    }
+    PQclear(res);
+
+    cursorName = name;
+    cursorTransaction = hold ? -1 : drv->transactionSerial;
+    cursorRow = 0;
+    cursorPosition = 0;
+    if (!fetchFromCursor(0))
+        return false;
+    q->setSelect(true);
+    q->setActive(true);
+    return true;
+}
+
+// Replaces result with the rows of the cursor that start at row first.
+bool QPSQLResultPrivate::fetchFromCursor(int first)
+{
+    Q_Q(QPSQLResult);
+    QPSQLDriverPrivate *drv = drv_d_func();
+    const int fetchSize = drv->cursorFetchSize;
+    QString stmt;
+    if (first != cursorPosition) {
+        if (q->isForwardOnly() && cursorPosition >= 0)
+            stmt = QStringLiteral("MOVE FORWARD %1 FROM %2;").arg(first - cursorPosition).arg(cursorName);
+        else
+            stmt = QStringLiteral("MOVE ABSOLUTE %1 FROM %2;").arg(first).arg(cursorName);
+    }
+    stmt += QStringLiteral("FETCH FORWARD %1 FROM %2").arg(fetchSize).arg(cursorName);
+
+    PGresult *res = drv->exec(stmt);
+    if (PQresultStatus(res) != PGRES_TUPLES_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to fetch row"), QSqlError::StatementError, drv, res));
+        PQclear(res);
+        cursorPosition = -1;
+        return false;
+    }
+    if (result)
         PQclear(result);
+    result = res;
+
+    const int rows = PQntuples(result);
+    cursorRow = first;
+    // Past the end, the cursor stands after the last row, wherever that is.
+    cursorPosition = rows > 0 ? first + rows : -1;
+    if (rows < fetchSize && (rows > 0 || first == 0))
+        currentSize = first + rows;
+    return true;
+}
+
+bool QPSQLResultPrivate::seekCursor(int i)
+{
+    Q_Q(QPSQLResult);
+    if (currentSize >= 0 && i >= currentSize)
+        return false;
+    if (i < cursorRow || i >= cursorRow + PQntuples(result)) {
+        // When moving backwards or to the last row, fetch the rows before
+        // it, so that iterating backwards does not cost one query per row.
+        int first = i;
+        if (i < cursorRow || i == currentSize - 1)
+            first = qMax(0, i - drv_d_func()->cursorFetchSize + 1);
+        if (!fetchFromCursor(first) || i >= cursorRow + PQntuples(result))
+            return false;
     }
-    preparedStmtId.clear();
+    q->setAt(i);
+    return true;
+}
+
+bool QPSQLResultPrivate::fetchLastFromCursor()
+{
+    Q_Q(QPSQLResult);
+    if (currentSize < 0) {
+        QPSQLDriverPrivate *drv = drv_d_func();
+        PGresult *res = drv->exec(QStringLiteral("MOVE ABSOLUTE 0 FROM %1;MOVE ALL FROM %1")
+                                  .arg(cursorName));
+        if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                            "Unable to fetch row"), QSqlError::StatementError, drv, res));
+            PQclear(res);
+            cursorPosition = -1;
+            return false;
+        }
+        const char *tuples = PQcmdTuples(res);
+        currentSize = QByteArray::fromRawData(tuples, qstrlen(tuples)).toInt();
+        cursorPosition = currentSize;
+        PQclear(res);
+    }
+    return currentSize > 0 && seekCursor(currentSize - 1);
+}
+
+void QPSQLResultPrivate::closeCursor()
+{
+    if (cursorName.isEmpty())
+        return;
+    // Don't touch cursors that went away with the transaction they were
+    // declared in, closing those would abort the current transaction.
+    QPSQLDriverPrivate *drv = drv_d_func();
+    if (drv && drv->connection) {
+        const PGTransactionStatusType status = PQtransactionStatus(drv->connection);
+        const bool exists = cursorTransaction == -1
+                ? status != PQTRANS_INERROR
+                : status == PQTRANS_INTRANS && cursorTransaction == drv->transactionSerial;
+        if (exists)
+            PQclear(drv->exec("CLOSE "_L1 + cursorName));
+    }
+    cursorName.clear();
+    cursorTransaction = -1;
+    cursorRow = 0;
+    cursorPosition = 0;
 }
 
 QPSQLResult::QPSQLResult(const QPSQLDriver *db)
@@ -402,7 +618,7 @@ QPSQLResult::~QPSQLResult()
     cleanup();
 
     if (d->preparedQueriesEnabled && !d->preparedStmtId.isNull())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
 }
 
 QVariant QPSQLResult::handle() const
@@ -414,6 +630,7 @@ QVariant QPSQLResult::handle() const
 void QPSQLResult::cleanup()
 {
     Q_D(QPSQLResult);
+    d->closeCursor();
     if (d->result)
         PQclear(d->result);
     d->result = nullptr;
@@ -434,7 +651,7 @@ void QPSQLResult::cleanup()
 
 bool QPSQLResult::fetch(int i)
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
     if (i < 0)
@@ -442,6 +659,12 @@ bool QPSQLResult::fetch(int i)
     if (at() == i)
         return true;
 
+    if (!d->cursorName.isEmpty()) {
+        if (isForwardOnly() && i < at())
+            return false;
+        return d->seekCursor(i);
+    }
+
     if (isForwardOnly()) {
         if (i < at())
             return false;
@@ -465,7 +688,7 @@ bool QPSQLResult::fetchFirst()
     if (at() == 0)
         return true;
 
-    if (isForwardOnly()) {
+    if (isForwardOnly() && d->cursorName.isEmpty()) {
         if (at() == QSql::BeforeFirstRow) {
             // First result has been already fetched by exec() or
             // nextResult(), just check it has at least one row.
@@ -482,10 +705,13 @@ bool QPSQLResult::fetchFirst()
 
 bool QPSQLResult::fetchLast()
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
 
+    if (!d->cursorName.isEmpty() && !isForwardOnly())
+        return d->fetchLastFromCursor();
+
     if (isForwardOnly()) {
         // Cannot seek to last row in forwardOnly mode, so we have to use brute force
         int i = at();
@@ -514,6 +740,9 @@ bool QPSQLResult::fetchNext()
     if (currentRow == QSql::AfterLastRow)
         return false;
 
+    if (!d->cursorName.isEmpty())
+        return d->seekCursor(currentRow + 1);
+
     if (isForwardOnly()) {
         if (!d->canFetchMoreRows)
             return false;
@@ -560,6 +789,12 @@ bool QPSQLResult::nextResult()
 
     setAt(QSql::BeforeFirstRow);
 
+    if (!d->cursorName.isEmpty()) {
+        // a cursor has a single result set
+        cleanup();
+        return false;
+    }
+
     if (isForwardOnly()) {
         if (d->canFetchMoreRows) {
             // Skip all rows from current result set
@@ -596,7 +831,7 @@ QVariant QPSQLResult::data(int i)
         qWarning("QPSQLResult::data: column %d out of range", i);
         return QVariant();
     }
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = d->resultRow();
     int ptype = PQftype(d->result, i);
     QMetaType type = qDecodePSQLType(ptype);
     if (PQgetisnull(d->result, currentRow, i))
@@ -676,8 +911,7 @@ QVariant QPSQLResult::data(int i)
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    const int currentRow = isForwardOnly() ? 0 : at();
-    return PQgetisnull(d->result, currentRow, field);
+    return PQgetisnull(d->result, d->resultRow(), field);
 }
 
 bool QPSQLResult::reset(const QString &query)
@@ -689,6 +923,18 @@ bool QPSQLResult::reset(const QString &query)
     if (!driver()->isOpen() || driver()->isOpenError())
         return false;
 
+    if (d->useCursor(query)) {
+        if (d->declareCursor(query))
+            return true;
+        // Run statements that cannot be declared as a cursor as usual,
+        // unless trying to has aborted the current transaction.
+        if (!d->cursorName.isEmpty()
+            || PQtransactionStatus(d->drv_d_func()->connection) != PQTRANS_IDLE) {
+            return false;
+        }
+        setLastError(QSqlError());
+    }
+
     d->stmtId = d->drv_d_func()->sendQuery(query);
     if (d->stmtId == InvalidStatementId) {
         setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
@@ -717,6 +963,8 @@ int QPSQLResult::size()
 int QPSQLResult::numRowsAffected()
 {
     Q_D(const QPSQLResult);
+    if (!d->cursorName.isEmpty())
+        return d->currentSize;
     const char *tuples = PQcmdTuples(d->result);
     return QByteArray::fromRawData(tuples, qstrlen(tuples)).toInt();
 }
@@ -846,7 +1094,14 @@ bool QPSQLResult::prepare(const QString &query)
     cleanup();
 
     if (!d->preparedStmtId.isEmpty())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
+
+    auto driver = const_cast<QPSQLDriverPrivate *>(d->drv_d_func());
+    if (std::optional<QString> cached = driver->statementCache.take(query)) {
+        d->preparedStmtId = std::move(*cached);
+        d->preparedQuery = query;
+        return true;
+    }
 
     const QString stmtId = qMakePreparedStmtId();
     const QString stmt = QStringLiteral("PREPARE %1 AS ").arg(stmtId).append(d->positionalToNamedBinding(query));
@@ -863,13 +1118,16 @@ bool QPSQLResult::prepare(const QString &query)
 
     PQclear(result);
     d->preparedStmtId = stmtId;
+    d->preparedQuery = query;
     return true;
 }
 
 bool QPSQLResult::exec()
 {
     Q_D(QPSQLResult);
-    if (!d->preparedQueriesEnabled)
+    // A cursor cannot be declared for EXECUTE, so the values are inserted
+    // into the query text instead.
+    if (!d->preparedQueriesEnabled || d->useCursor(lastQuery()))
         return QSqlResult::exec();
 
     cleanup();
@@ -900,6 +1158,60 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    if (!d->preparedQueriesEnabled)
+        return QSqlResult::execBatch(arrayBind);
+
+    QList<QVariantList> columns;
+    for (const QVariant &value : boundValues())
+        columns.append(value.toList());
+    if (columns.isEmpty())
+        return false;
+    const qsizetype rowCount = columns.constFirst().size();
+
+    // Send the EXECUTE statements of many rows as one query string, so that
+    // a batch costs one round trip per block of rows instead of one per row.
+    // The server runs each query string in a single transaction unless one
+    // is already open, so a failing row also discards the rest of its block.
+    constexpr qsizetype RowsPerQuery = 1000;
+    QList<QVariant> rowValues(columns.size());
+    for (qsizetype first = 0; first < rowCount; first += RowsPerQuery) {
+        cleanup();
+
+        QString stmt;
+        const qsizetype end = qMin(rowCount, first + RowsPerQuery);
+        for (qsizetype row = first; row < end; ++row) {
+            for (qsizetype i = 0; i < columns.size(); ++i)
+                rowValues[i] = columns.at(i).value(row);
+            const QString params = qCreateParamString(rowValues, driver());
+            if (params.isEmpty())
+                stmt += QStringLiteral("EXECUTE %1;").arg(d->preparedStmtId);
+            else
+                stmt += QStringLiteral("EXECUTE %1 (%2);").arg(d->preparedStmtId, params);
+        }
+
+        d->stmtId = d->drv_d_func()->sendQuery(stmt);
+        if (d->stmtId == InvalidStatementId) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to send query"), QSqlError::StatementError, d->drv_d_func()));
+            return false;
+        }
+
+        // There is one result per statement and none after a failing one,
+        // so the last result tells whether the whole block succeeded.
+        d->result = d->drv_d_func()->getResult(d->stmtId);
+        while (PGresult *nextResult = d->drv_d_func()->getResult(d->stmtId)) {
+            PQclear(d->result);
+            d->result = nextResult;
+        }
+        if (!d->processResults())
+            return false;
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -1101,6 +1413,7 @@ QPSQLDriver::QPSQLDriver(PGconn *conn, QObject *parent)
 QPSQLDriver::~QPSQLDriver()
 {
     Q_D(QPSQLDriver);
+    d->statementCache.clear([](const QString &) {});
     if (d->connection)
         PQfinish(d->connection);
 }
@@ -1151,6 +1464,32 @@ static QString qQuote(QString s)
     return s;
 }
 
+/*
+   removes an option of the driver, such as QPSQL_CURSOR_FETCH_SIZE, which
+   libpq doesn't know, from the connect options and returns its value
+ */
+static int qTakeIntOption(QString &options, QLatin1StringView option)
+{
+    const qsizetype start = options.indexOf(option);
+    if (start == -1)
+        return 0;
+    qsizetype end = start + option.size();
+    while (end < options.size() && options.at(end).isSpace())
+        ++end;
+    int size = 0;
+    if (end < options.size() && options.at(end) == u'=') {
+        ++end;
+        while (end < options.size() && options.at(end).isSpace())
+            ++end;
+        const qsizetype value = end;
+        while (end < options.size() && options.at(end).isDigit())
+            ++end;
+        size = QStringView(options).sliced(value, end - value).toInt();
+    }
+    options.remove(start, end - start);
+    return size;
+}
+
 bool QPSQLDriver::open(const QString &db,
                        const QString &user,
                        const QString &password,
@@ -1173,9 +1512,13 @@ bool QPSQLDriver::open(const QString &db,
         connectString.append(" port="_L1).append(qQuote(QString::number(port)));
 
     // add any connect options - the server will handle error detection
+    d->cursorFetchSize = 0;
+    int statementCacheSize = 0;
     if (!connOpts.isEmpty()) {
         QString opt = connOpts;
         opt.replace(';'_L1, ' '_L1, Qt::CaseInsensitive);
+        d->cursorFetchSize = qTakeIntOption(opt, "QPSQL_CURSOR_FETCH_SIZE"_L1);
+        statementCacheSize = qTakeIntOption(opt, "QPSQL_STATEMENT_CACHE_SIZE"_L1);
         connectString.append(u' ').append(opt);
     }
 
@@ -1199,6 +1542,7 @@ bool QPSQLDriver::open(const QString &db,
     }
     d->setDatestyle();
     d->setByteaOutput();
+    d->statementCache.setCapacity(statementCacheSize);
 
     setOpen(true);
     setOpenError(false);
@@ -1216,6 +1560,8 @@ void QPSQLDriver::close()
         d->sn = nullptr;
     }
 
+    // the server forgets the prepared statements of the session anyway
+    d->statementCache.clear([](const QString &) {});
     if (d->connection)
         PQfinish(d->connection);
     d->connection = nullptr;
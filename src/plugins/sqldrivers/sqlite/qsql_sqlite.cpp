@@ -13,6 +13,7 @@
 #include <qsqlquery.h>
 #include <QtSql/private/qsqlcachedresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
+#include <QtSql/private/qsqlstatementcache_p.h>
 #include <qstringlist.h>
 #include <qvariant.h>
 #if QT_CONFIG(regularexpression)
@@ -117,6 +118,7 @@ public:
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+    QSqlStatementCache<sqlite3_stmt *> statementCache;
 };
 
 
@@ -132,8 +134,10 @@ public:
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    void releaseStatement();
 
     sqlite3_stmt *stmt = nullptr;
+    QString preparedQuery; // the query stmt was prepared for
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -143,7 +147,7 @@ public:
 void QSQLiteResultPrivate::cleanup()
 {
     Q_Q(QSQLiteResult);
-    finalize();
+    releaseStatement();
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
@@ -159,6 +163,23 @@ void QSQLiteResultPrivate::finalize()
 
     sqlite3_finalize(stmt);
     stmt = nullptr;
+    preparedQuery.clear();
+}
+
+// gives stmt back to the statement cache of the driver, if it has one
+void QSQLiteResultPrivate::releaseStatement()
+{
+    auto driver = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (!stmt || !driver || !driver->statementCache.isEnabled()) {
+        finalize();
+        return;
+    }
+    // the statement must not keep its transaction open, nor point to the
+    // values it was bound to
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    driver->statementCache.insert(std::exchange(preparedQuery, QString()),
+                                  std::exchange(stmt, nullptr), sqlite3_finalize);
 }
 
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
@@ -351,6 +372,13 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    auto driver = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func());
+    if (std::optional<sqlite3_stmt *> cached = driver->statementCache.take(query)) {
+        d->stmt = *cached;
+        d->preparedQuery = query;
+        return true;
+    }
+
     const void *pzTail = nullptr;
     const auto size = int((query.size() + 1) * sizeof(QChar));
 
@@ -373,18 +401,27 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    d->preparedQuery = query;
     return true;
 }
 
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
-    Q_D(QSqlResult);
+    Q_D(QSQLiteResult);
     QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
     QList<QVariant> values = d->values;
     if (values.size() == 0)
         return false;
 
+    // In autocommit mode every row would be committed, and synced to disk,
+    // on its own. Run the batch in one transaction instead; rows executed
+    // before a failing one are still committed, as they were before.
+    sqlite3 *access = d->drv_d_func()->access;
+    const bool ownTransaction = sqlite3_get_autocommit(access)
+            && sqlite3_exec(access, "BEGIN", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+    bool ok = true;
     for (int i = 0; i < values.at(0).toList().size(); ++i) {
         d->values.clear();
         QScopedValueRollback<QHash<QString, QList<int>>> indexesScope(d->indexes);
@@ -393,10 +430,24 @@ bool QSQLiteResult::execBatch(bool arrayBind)
             bindValue(it.key(), values.at(it.value().first()).toList().at(i), QSql::In);
             ++it;
         }
-        if (!exec())
-            return false;
+        if (!exec()) {
+            ok = false;
+            break;
+        }
     }
-    return true;
+
+    if (ownTransaction) {
+        const int res = sqlite3_exec(access, "COMMIT", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            if (ok) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to commit batch"), QSqlError::TransactionError, res));
+            }
+            sqlite3_exec(access, "ROLLBACK", nullptr, nullptr, nullptr);
+            ok = false;
+        }
+    }
+    return ok;
 }
 
 bool QSQLiteResult::exec()
@@ -679,6 +730,29 @@ bool QSQLiteDriver::hasFeature(DriverFeature f) const
    SQLite dbs have no user name, passwords, hosts or ports.
    just file names.
 */
+// Returns the value of a NAME=value connect option, given what follows NAME
+static QStringView qOptionValue(QStringView option)
+{
+    option = option.trimmed();
+    return option.startsWith(u'=') ? option.mid(1).trimmed() : QStringView();
+}
+
+// Appends the PRAGMA statement for a connect option whose value must be one
+// of values to pragmas
+static void qAppendPragma(QStringList *pragmas, QStringView option, QLatin1StringView pragma,
+                          std::initializer_list<QLatin1StringView> values)
+{
+    const QStringView value = qOptionValue(option);
+    for (QLatin1StringView allowed : values) {
+        if (value.compare(allowed, Qt::CaseInsensitive) == 0) {
+            pragmas->append("PRAGMA "_L1 + pragma + u'=' + allowed);
+            return;
+        }
+    }
+    qWarning("QSQLiteDriver::open: Unknown value '%ls' for PRAGMA %s",
+             qUtf16Printable(value.toString()), pragma.data());
+}
+
 bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, const QString &, int, const QString &conOpts)
 {
     Q_D(QSQLiteDriver);
@@ -691,6 +765,9 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     bool openReadOnlyOption = false;
     bool openUriOption = false;
     bool useExtendedResultCodes = true;
+    qsizetype statementCacheSize = 0;
+    // run in this order once the database is open
+    QStringList pragmas;
 #if QT_CONFIG(regularexpression)
     static const auto regexpConnectOption = "QSQLITE_ENABLE_REGEXP"_L1;
     bool defineRegexp = false;
@@ -716,6 +793,22 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
             sharedCache = true;
         } else if (option == "QSQLITE_NO_USE_EXTENDED_RESULT_CODES"_L1) {
             useExtendedResultCodes = false;
+        } else if (option.startsWith("QSQLITE_STATEMENT_CACHE_SIZE"_L1)) {
+            statementCacheSize = qSqlStatementCacheSize(option.mid(28));
+        } else if (option.startsWith("QSQLITE_JOURNAL_MODE"_L1)) {
+            qAppendPragma(&pragmas, option.mid(20), "journal_mode"_L1,
+                          { "DELETE"_L1, "TRUNCATE"_L1, "PERSIST"_L1, "MEMORY"_L1, "WAL"_L1,
+                            "OFF"_L1 });
+        } else if (option.startsWith("QSQLITE_SYNCHRONOUS"_L1)) {
+            qAppendPragma(&pragmas, option.mid(19), "synchronous"_L1,
+                          { "OFF"_L1, "NORMAL"_L1, "FULL"_L1, "EXTRA"_L1 });
+        } else if (option.startsWith("QSQLITE_MMAP_SIZE"_L1)) {
+            bool ok = false;
+            const qint64 size = qOptionValue(option.mid(17)).toLongLong(&ok);
+            if (ok && size >= 0)
+                pragmas.append("PRAGMA mmap_size="_L1 + QString::number(size));
+        } else if (option == "QSQLITE_QUERY_ONLY"_L1) {
+            pragmas.append("PRAGMA query_only=1"_L1);
         }
 #if QT_CONFIG(regularexpression)
         else if (option.startsWith(regexpConnectOption)) {
@@ -744,9 +837,20 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
     const int res = sqlite3_open_v2(db.toUtf8().constData(), &d->access, openMode, nullptr);
 
+    int pragmaRes = SQLITE_OK;
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
         sqlite3_extended_result_codes(d->access, useExtendedResultCodes);
+        for (const QString &pragma : std::as_const(pragmas)) {
+            pragmaRes = sqlite3_exec(d->access, pragma.toUtf8().constData(), nullptr, nullptr,
+                                     nullptr);
+            if (pragmaRes != SQLITE_OK)
+                break;
+        }
+    }
+
+    if (res == SQLITE_OK && pragmaRes == SQLITE_OK) {
+        d->statementCache.setCapacity(statementCacheSize);
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -760,7 +864,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
         return true;
     } else {
         setLastError(qMakeError(d->access, tr("Error opening database"),
-                     QSqlError::ConnectionError, res));
+                     QSqlError::ConnectionError, res != SQLITE_OK ? res : pragmaRes));
         setOpenError(true);
 
         if (d->access) {
@@ -778,6 +882,7 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : std::as_const(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear(sqlite3_finalize);
 
         if (d->access && (d->notificationid.size() > 0)) {
             d->notificationid.clear();
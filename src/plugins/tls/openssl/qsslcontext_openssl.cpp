@@ -19,12 +19,66 @@
 
 #include <QtNetwork/private/qssldiffiehellmanparameters_p.h>
 
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
 #include <vector>
 
 QT_BEGIN_NAMESPACE
 
 Q_GLOBAL_STATIC(bool, forceSecurityLevel)
 
+namespace {
+
+// Client sessions and server ticket keys shared by all contexts.
+struct SharedSessionCache
+{
+    struct Entry
+    {
+        QByteArray sessionASN1;
+        QDeadlineTimer expiry;
+    };
+
+    static constexpr qsizetype MaxSessions = 1024;
+    // Seconds a session is kept if the server gave no lifetime hint
+    static constexpr qint64 DefaultLifetime = 300;
+    // Key name, HMAC secret and AES key, as SSL_CTRL_SET_TLSEXT_TICKET_KEYS
+    // expects them
+    static constexpr qsizetype TicketKeysSize = 80;
+    static constexpr qsizetype TicketKeyNameSize = 16;
+
+    QMutex mutex;
+    QHash<QString, Entry> sessions;
+    QHash<size_t, QByteArray> ticketKeys;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(SharedSessionCache, sharedSessionCache)
+
+// Sessions may only be resumed by connections that would have agreed on
+// the same parameters and identities in a full handshake.
+static size_t sessionConfigurationHash(const QSslConfiguration &configuration)
+{
+    return qHashMulti(0, int(configuration.protocol()), int(configuration.peerVerifyMode()),
+                      configuration.localCertificate(), configuration.caCertificates());
+}
+
+static QByteArray sharedTicketKeys(const QSslConfiguration &configuration)
+{
+    const size_t hash = sessionConfigurationHash(configuration);
+    auto *cache = sharedSessionCache();
+    QMutexLocker locker(&cache->mutex);
+    QByteArray &keys = cache->ticketKeys[hash];
+    if (keys.isEmpty()) {
+        keys.resize(SharedSessionCache::TicketKeysSize);
+        if (q_RAND_bytes(reinterpret_cast<unsigned char *>(keys.data()), int(keys.size())) != 1)
+            keys.clear();
+    }
+    return keys;
+}
+
 namespace QTlsPrivate
 {
 // These callback functions are defined in qtls_openssl.cpp.
@@ -281,6 +335,76 @@ bool QSslContext::cacheSession(SSL* ssl)
     return (session != nullptr);
 }
 
+QString QSslContext::sharedSessionKey(const QString &peerName, quint16 port,
+                                      const QSslConfiguration &configuration)
+{
+    if (peerName.isEmpty())
+        return QString();
+    return peerName + u':' + QString::number(port) + u'/'
+            + QString::number(sessionConfigurationHash(configuration), 16);
+}
+
+SSL_SESSION *QSslContext::sharedSession(const QString &key)
+{
+    if (key.isEmpty())
+        return nullptr;
+
+    QByteArray asn1;
+    {
+        auto *cache = sharedSessionCache();
+        QMutexLocker locker(&cache->mutex);
+        const auto it = cache->sessions.constFind(key);
+        if (it == cache->sessions.cend())
+            return nullptr;
+        if (it->expiry.hasExpired()) {
+            cache->sessions.erase(it);
+            return nullptr;
+        }
+        asn1 = it->sessionASN1;
+    }
+
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(asn1.constData());
+    return q_d2i_SSL_SESSION(nullptr, &data, asn1.size());
+}
+
+void QSslContext::storeSharedSession(const QString &key, SSL_SESSION *session)
+{
+    if (key.isEmpty() || !session)
+        return;
+#ifdef TLS1_3_VERSION
+    if (!q_SSL_SESSION_is_resumable(session))
+        return;
+#endif // TLS1_3_VERSION
+
+    const int sessionSize = q_i2d_SSL_SESSION(session, nullptr);
+    if (sessionSize <= 0)
+        return;
+    QByteArray asn1(sessionSize, Qt::Uninitialized);
+    unsigned char *data = reinterpret_cast<unsigned char *>(asn1.data());
+    if (!q_i2d_SSL_SESSION(session, &data))
+        return;
+
+    const qint64 hint = qint64(q_SSL_SESSION_get_ticket_lifetime_hint(session));
+    const QDeadlineTimer expiry((hint > 0 ? hint : SharedSessionCache::DefaultLifetime) * 1000);
+
+    auto *cache = sharedSessionCache();
+    QMutexLocker locker(&cache->mutex);
+    auto &sessions = cache->sessions;
+    if (sessions.size() >= SharedSessionCache::MaxSessions && !sessions.contains(key)) {
+        sessions.removeIf([](const auto &entry) { return entry.value().expiry.hasExpired(); });
+        if (sessions.size() >= SharedSessionCache::MaxSessions) {
+            // Make room by dropping the session that would expire first
+            auto first = sessions.begin();
+            for (auto it = sessions.begin(); it != sessions.end(); ++it) {
+                if (it->expiry < first->expiry)
+                    first = it;
+            }
+            sessions.erase(first);
+        }
+    }
+    sessions.insert(key, { std::move(asn1), expiry });
+}
+
 QByteArray QSslContext::sessionASN1() const
 {
     return m_sessionASN1;
@@ -663,6 +787,24 @@ QT_WARNING_POP
         q_SSL_CTX_set_verify(sslContext->ctx, verificationMode, verificationCallback);
     }
 
+    // A server context is created for every connection, and each would
+    // encrypt session tickets with its own keys, so that no ticket could be
+    // used to resume with the next connection. Give all server contexts with
+    // the same configuration the same keys and session id context instead.
+    if (!client && !isDtls
+            && !configuration.testSslOption(QSsl::SslOptionDisableSessionTickets)) {
+        QByteArray keys = sharedTicketKeys(configuration);
+        if (keys.isEmpty()
+                || q_SSL_CTX_ctrl(sslContext->ctx, SSL_CTRL_SET_TLSEXT_TICKET_KEYS,
+                                  long(keys.size()), keys.data()) != 1) {
+            qCWarning(lcTlsBackend, "could not set shared session ticket keys");
+        } else {
+            q_SSL_CTX_set_session_id_context(sslContext->ctx,
+                                             reinterpret_cast<const unsigned char *>(keys.constData()),
+                                             SharedSessionCache::TicketKeyNameSize);
+        }
+    }
+
 #ifdef TLS1_3_VERSION
     // NewSessionTicket callback:
     if (mode == QSslSocket::SslClientMode && !isDtls) {
@@ -50,6 +50,13 @@ public:
     void setSessionASN1(const QByteArray &sessionASN1);
     int sessionTicketLifeTimeHint() const;
 
+    // Process-wide cache of client sessions, for connections to the same
+    // peer that do not share a QSslContext.
+    static QString sharedSessionKey(const QString &peerName, quint16 port,
+                                    const QSslConfiguration &configuration);
+    static SSL_SESSION *sharedSession(const QString &key); // caller must free
+    static void storeSharedSession(const QString &key, SSL_SESSION *session);
+
     static void forceAutoTestSecurityLevel();
 
 #ifndef OPENSSL_NO_NEXTPROTONEG
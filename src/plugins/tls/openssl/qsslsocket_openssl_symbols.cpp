@@ -284,6 +284,7 @@ DEFINEFUNC(SSL_CTX *, SSL_CTX_new, const SSL_METHOD *a, a, return nullptr, retur
 DEFINEFUNC2(int, SSL_CTX_set_cipher_list, SSL_CTX *a, a, const char *b, b, return -1, return)
 DEFINEFUNC3(long, SSL_CTX_callback_ctrl, SSL_CTX *ctx, ctx, int dst, dst, GenericCallbackType cb, cb, return 0, return)
 DEFINEFUNC(int, SSL_CTX_set_default_verify_paths, SSL_CTX *a, a, return -1, return)
+DEFINEFUNC3(int, SSL_CTX_set_session_id_context, SSL_CTX *a, a, const unsigned char *b, b, unsigned int c, c, return 0, return)
 DEFINEFUNC3(void, SSL_CTX_set_verify, SSL_CTX *a, a, int b, b, int (*c)(int, X509_STORE_CTX *), c, return, DUMMYARG)
 DEFINEFUNC2(void, SSL_CTX_set_verify_depth, SSL_CTX *a, a, int b, b, return, DUMMYARG)
 DEFINEFUNC2(int, SSL_CTX_use_certificate, SSL_CTX *a, a, X509 *b, b, return -1, return)
@@ -1033,6 +1034,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_CTX_set_cipher_list)
         RESOLVEFUNC(SSL_CTX_callback_ctrl)
         RESOLVEFUNC(SSL_CTX_set_default_verify_paths)
+        RESOLVEFUNC(SSL_CTX_set_session_id_context)
         RESOLVEFUNC(SSL_CTX_set_verify)
         RESOLVEFUNC(SSL_CTX_set_verify_depth)
         RESOLVEFUNC(SSL_CTX_use_certificate)
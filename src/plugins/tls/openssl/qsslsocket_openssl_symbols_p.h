@@ -414,6 +414,7 @@ void q_SSL_CTX_free(SSL_CTX *a);
 SSL_CTX *q_SSL_CTX_new(const SSL_METHOD *a);
 int q_SSL_CTX_set_cipher_list(SSL_CTX *a, const char *b);
 int q_SSL_CTX_set_default_verify_paths(SSL_CTX *a);
+int q_SSL_CTX_set_session_id_context(SSL_CTX *a, const unsigned char *b, unsigned int c);
 void q_SSL_CTX_set_verify(SSL_CTX *a, int b, int (*c)(int, X509_STORE_CTX *));
 void q_SSL_CTX_set_verify_depth(SSL_CTX *a, int b);
 extern "C" {
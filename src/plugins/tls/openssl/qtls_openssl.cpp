@@ -803,6 +803,7 @@ void TlsCryptographOpenSSL::continueHandshake()
     const auto &configuration = q->sslConfiguration();
     // Cache this SSL session inside the QSslContext
     if (!(configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))) {
+        QSslContext::storeSharedSession(sharedSessionKey, q_SSL_get_session(ssl));
         if (!sslContextPointer->cacheSession(ssl)) {
             sslContextPointer.reset(); // we could not cache the session
         } else {
@@ -937,12 +938,15 @@ void TlsCryptographOpenSSL::transmit()
         int pendingBytes;
         while (plainSocket->isValid() && (pendingBytes = q_BIO_pending(writeBio)) > 0
                 && plainSocket->openMode() != QIODevice::NotOpen) {
-            // Read encrypted data from the write BIO into a buffer.
-            data.resize(pendingBytes);
-            int encryptedBytesRead = q_BIO_read(writeBio, data.data(), pendingBytes);
+            // Read encrypted data from the write BIO into a byte array. The
+            // socket queues large arrays without copying them again, so the
+            // records are copied only once on their way to the network.
+            QByteArray encrypted(pendingBytes, Qt::Uninitialized);
+            int encryptedBytesRead = q_BIO_read(writeBio, encrypted.data(), pendingBytes);
+            encrypted.truncate(qMax(encryptedBytesRead, 0));
 
             // Write encrypted data from the buffer to the socket.
-            qint64 actualWritten = plainSocket->write(data.constData(), encryptedBytesRead);
+            qint64 actualWritten = plainSocket->write(encrypted);
 #ifdef QSSLSOCKET_DEBUG
             qCDebug(lcTlsBackend) << "TlsCryptographOpenSSL::transmit: wrote" << encryptedBytesRead
                                   << "encrypted bytes to the socket" << actualWritten << "actual.";
@@ -1229,7 +1233,9 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     Q_ASSERT(q);
     Q_ASSERT(d);
 
-    if (q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence)) {
+    const auto configuration = q->sslConfiguration();
+    if (configuration.testSslOption(QSsl::SslOptionDisableSessionPersistence)
+        && configuration.testSslOption(QSsl::SslOptionDisableSessionSharing)) {
         // We silently ignore, do nothing, remove from cache.
         return 0;
     }
@@ -1253,6 +1259,11 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     }
 #endif // TLS1_3_VERSION
 
+    if (!configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))
+        QSslContext::storeSharedSession(sharedSessionKey, currentSession);
+    if (configuration.testSslOption(QSsl::SslOptionDisableSessionPersistence))
+        return 0;
+
     const int sessionSize = q_i2d_SSL_SESSION(currentSession, nullptr);
     if (sessionSize <= 0) {
         qCWarning(lcTlsBackend, "could not store persistent version of SSL session");
@@ -1385,12 +1396,13 @@ bool TlsCryptographOpenSSL::initSslContext()
         return false;
     }
 
+    const auto verificationPeerName = d->verificationName();
+    QString tlsHostName = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
+    if (tlsHostName.isEmpty())
+        tlsHostName = d->tlsHostName();
+
     if (configuration.protocol() != QSsl::UnknownProtocol && mode == QSslSocket::SslClientMode) {
-        const auto verificationPeerName = d->verificationName();
         // Set server hostname on TLS extension. RFC4366 section 3.1 requires it in ACE format.
-        QString tlsHostName = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
-        if (tlsHostName.isEmpty())
-            tlsHostName = d->tlsHostName();
         QByteArray ace = QUrl::toAce(tlsHostName);
         // only send the SNI header if the URL is valid and not an IP
         if (!ace.isEmpty()
@@ -1405,6 +1417,21 @@ bool TlsCryptographOpenSSL::initSslContext()
         }
     }
 
+    sharedSessionKey.clear();
+    if (mode == QSslSocket::SslClientMode
+        && !configuration.testSslOption(QSsl::SslOptionDisableSessionSharing)) {
+        // If our context has no session to offer, try one from an earlier
+        // connection to the same peer.
+        sharedSessionKey = QSslContext::sharedSessionKey(tlsHostName, q->peerPort(), configuration);
+        if (!q_SSL_get_session(ssl)) {
+            if (SSL_SESSION *session = QSslContext::sharedSession(sharedSessionKey)) {
+                if (!q_SSL_set_session(ssl, session))
+                    qCWarning(lcTlsBackend, "could not set shared SSL session");
+                q_SSL_SESSION_free(session);
+            }
+        }
+    }
+
     // Clear the session.
     errorList.clear();
 
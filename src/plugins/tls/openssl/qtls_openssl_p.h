@@ -102,6 +102,7 @@ private:
 
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
+    QString sharedSessionKey; // see QSslContext::sharedSession()
 
     QList<QSslErrorEntry> errorList;
     QList<QSslError> sslErrors;
@@ -16,8 +16,11 @@
 #include <QtNetwork/qsslcipher.h>
 #include <QtNetwork/qssl.h>
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qdiriterator.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qscopeguard.h>
@@ -354,6 +357,51 @@ QList<QByteArray> fetchSslCertificateData();
 QList<QSslCertificate> systemCaCertificates();
 
 #ifndef Q_OS_DARWIN
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+namespace {
+
+// The certificates parsed from the system CA files, shared by all threads.
+// A file is only parsed again once it has changed on disk.
+struct CaFileCache
+{
+    struct Entry
+    {
+        QDateTime lastModified;
+        qint64 size = -1;
+        QList<QSslCertificate> certificates;
+    };
+
+    QMutex mutex;
+    QHash<QString, Entry> files;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(CaFileCache, caFileCache)
+
+static QList<QSslCertificate> caCertificatesFromFile(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    const QDateTime lastModified = info.lastModified();
+    const qint64 size = info.size();
+
+    auto *cache = caFileCache();
+    {
+        QMutexLocker locker(&cache->mutex);
+        const auto it = cache->files.constFind(fileName);
+        if (it != cache->files.cend() && it->lastModified == lastModified && it->size == size)
+            return it->certificates;
+    }
+
+    // Parse without holding the lock, so that threads loading other files
+    // don't wait for this one.
+    QList<QSslCertificate> certificates = QSslCertificate::fromPath(fileName, QSsl::Pem);
+    QMutexLocker locker(&cache->mutex);
+    cache->files.insert(fileName, { lastModified, size, certificates });
+    return certificates;
+}
+#endif // Q_OS_UNIX && !Q_OS_ANDROID
+
 QList<QSslCertificate> systemCaCertificates()
 {
 #ifdef QSSLSOCKET_DEBUG
@@ -399,7 +447,7 @@ QList<QSslCertificate> systemCaCertificates()
             }
         }
         for (const QString& file : std::as_const(certFiles))
-            systemCerts.append(QSslCertificate::fromPath(file, QSsl::Pem));
+            systemCerts.append(caCertificatesFromFile(file));
     }
 #endif // platform
 #ifdef QSSLSOCKET_DEBUG
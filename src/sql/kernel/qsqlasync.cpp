@@ -0,0 +1,218 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsqlasync_p.h"
+
+#include "qsqldatabase.h"
+#include "qsqlquery.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+    \class QSqlResultSet
+    \inmodule QtSql
+    \ingroup database
+    \since 6.7
+
+    \brief The QSqlResultSet struct holds the outcome of a query that was
+    executed asynchronously.
+
+    QSqlDatabase::execAsync() and QSqlQuery::execAsync() deliver a
+    QSqlResultSet through a QFuture once the query has finished. Since the
+    query ran on another thread, the rows are handed over as a list of
+    records rather than through a QSqlQuery.
+
+    \sa QSqlDatabase::execAsync(), QSqlQuery::execAsync()
+*/
+
+/*!
+    \variable QSqlResultSet::records
+
+    The rows returned by the query, in order. Each record holds the values
+    of one row.
+*/
+
+/*!
+    \variable QSqlResultSet::error
+
+    The error that occurred while opening the connection or executing the
+    query. It is not \l{QSqlError::isValid()}{valid} if the query succeeded.
+*/
+
+/*!
+    \variable QSqlResultSet::numRowsAffected
+
+    The number of rows affected by the query, as QSqlQuery::numRowsAffected()
+    reports it, or -1 if it cannot be determined.
+*/
+
+/*!
+    \variable QSqlResultSet::lastInsertId
+
+    The object ID of the most recently inserted row, as
+    QSqlQuery::lastInsertId() reports it.
+*/
+
+namespace {
+
+// Executes the queries of one connection, in order, on a connection of its
+// own that is cloned from it. Connections belong to the thread that opened
+// them, so the clone is used, and removed, on this thread only.
+class QSqlConnectionThread : public QThread
+{
+public:
+    explicit QSqlConnectionThread(const QString &connectionName)
+        : connectionName(connectionName),
+          cloneName(u"qt_sql_async_connection:"_s + connectionName)
+    {
+        setObjectName(u"QSqlDatabase async "_s + connectionName);
+        context.moveToThread(this);
+    }
+
+    template <typename Functor>
+    void post(Functor &&task)
+    {
+        QMetaObject::invokeMethod(&context, std::forward<Functor>(task), Qt::QueuedConnection);
+    }
+
+    QSqlResultSet execute(const QString &query, const QVariantList &boundValues,
+                          QSql::NumericalPrecisionPolicy precisionPolicy);
+
+protected:
+    void run() override
+    {
+        exec();
+        QSqlDatabase::removeDatabase(cloneName);
+    }
+
+private:
+    const QString connectionName;
+    const QString cloneName;
+    QObject context;
+};
+
+QSqlResultSet QSqlConnectionThread::execute(const QString &query, const QVariantList &boundValues,
+                                            QSql::NumericalPrecisionPolicy precisionPolicy)
+{
+    QSqlResultSet resultSet;
+    QSqlDatabase db = QSqlDatabase::database(cloneName, false);
+    if (!db.isValid())
+        db = QSqlDatabase::cloneDatabase(connectionName, cloneName);
+    if (!db.isOpen() && !db.open()) {
+        resultSet.error = db.lastError();
+        return resultSet;
+    }
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    q.setNumericalPrecisionPolicy(precisionPolicy);
+    bool ok;
+    if (boundValues.isEmpty()) {
+        ok = q.exec(query);
+    } else {
+        ok = q.prepare(query);
+        for (const QVariant &value : boundValues)
+            q.addBindValue(value);
+        ok = ok && q.exec();
+    }
+    if (!ok) {
+        resultSet.error = q.lastError();
+        return resultSet;
+    }
+
+    while (q.next())
+        resultSet.records.append(q.record());
+    resultSet.error = q.lastError();
+    resultSet.numRowsAffected = q.numRowsAffected();
+    resultSet.lastInsertId = q.lastInsertId();
+    return resultSet;
+}
+
+struct QSqlConnectionThreads
+{
+    ~QSqlConnectionThreads()
+    {
+        QHash<QString, QSqlConnectionThread *> running;
+        {
+            QMutexLocker locker(&mutex);
+            running.swap(threads);
+        }
+        for (QSqlConnectionThread *thread : std::as_const(running)) {
+            thread->quit();
+            thread->wait();
+            delete thread;
+        }
+    }
+
+    QMutex mutex;
+    QHash<QString, QSqlConnectionThread *> threads;
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QSqlConnectionThreads, connectionThreads)
+
+QFuture<QSqlResultSet> QSqlAsync::exec(const QString &connectionName, const QString &query,
+                                       const QVariantList &boundValues,
+                                       QSql::NumericalPrecisionPolicy precisionPolicy)
+{
+    auto promise = std::make_shared<QPromise<QSqlResultSet>>();
+    QFuture<QSqlResultSet> future = promise->future();
+    promise->start();
+
+    QSqlConnectionThreads *global = connectionThreads();
+    if (!global || connectionName.isEmpty()) {
+        QSqlResultSet resultSet;
+        resultSet.error = QSqlError(QCoreApplication::translate("QSqlDatabase",
+                                                                "Unable to execute query"),
+                                    global ? QCoreApplication::translate("QSqlDatabase",
+                                                                         "Invalid connection")
+                                           : QCoreApplication::translate("QSqlDatabase",
+                                                                         "Application is exiting"),
+                                    QSqlError::ConnectionError);
+        promise->addResult(std::move(resultSet));
+        promise->finish();
+        return future;
+    }
+
+    QMutexLocker locker(&global->mutex);
+    QSqlConnectionThread *&thread = global->threads[connectionName];
+    if (!thread) {
+        thread = new QSqlConnectionThread(connectionName);
+        thread->start();
+    }
+    thread->post([thread, promise, query, boundValues, precisionPolicy] {
+        if (!promise->isCanceled())
+            promise->addResult(thread->execute(query, boundValues, precisionPolicy));
+        promise->finish();
+    });
+    return future;
+}
+
+void QSqlAsync::removeConnection(const QString &connectionName)
+{
+    if (!connectionThreads.exists() || connectionThreads.isDestroyed())
+        return;
+    QSqlConnectionThreads *global = connectionThreads();
+
+    QMutexLocker locker(&global->mutex);
+    QSqlConnectionThread *thread = global->threads.take(connectionName);
+    if (!thread)
+        return;
+    // Let the queries that were already issued finish; the thread object
+    // itself goes away with its owner's event loop.
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->post([thread] { thread->quit(); });
+}
+
+QT_END_NAMESPACE
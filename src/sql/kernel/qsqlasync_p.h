@@ -0,0 +1,40 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLASYNC_P_H
+#define QSQLASYNC_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QtSql module.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include <QtSql/qsqlresultset.h>
+#include <QtCore/qfuture.h>
+
+QT_REQUIRE_CONFIG(future);
+
+QT_BEGIN_NAMESPACE
+
+class QSqlDriver;
+
+namespace QSqlAsync {
+
+QFuture<QSqlResultSet> exec(const QString &connectionName, const QString &query,
+                            const QVariantList &boundValues,
+                            QSql::NumericalPrecisionPolicy precisionPolicy);
+void removeConnection(const QString &connectionName);
+QString connectionName(const QSqlDriver *driver); // in qsqldatabase.cpp
+
+} // namespace QSqlAsync
+
+QT_END_NAMESPACE
+
+#endif // QSQLASYNC_P_H
@@ -20,14 +20,200 @@ QT_BEGIN_NAMESPACE
    to indicate that we are not interested in the actual values.
 */
 
-static constexpr qsizetype initial_cache_size = 128;
+/*
+   Scrollable results are cached per column. As long as all values of a
+   column have the same type, they are stored back to back without the
+   overhead of a QVariant per cell, strings and byte arrays in one shared
+   buffer, and a QVariant is only created when a value is asked for. The
+   type is taken from the values themselves rather than from the record,
+   since drivers like SQLite do not tell the type of a column up front.
+   Columns mixing types fall back to a list of QVariants.
+*/
+
+QSqlCachedColumn::Storage QSqlCachedColumn::storageFor(QMetaType type)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Long:
+    case QMetaType::Short:
+    case QMetaType::Char:
+    case QMetaType::ULong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+    case QMetaType::Float:
+    case QMetaType::SChar:
+        return Fixed;
+    case QMetaType::QString:
+        return Utf16;
+    case QMetaType::QByteArray:
+        return Bytes;
+    default:
+        return Variants;
+    }
+}
+
+void QSqlCachedColumn::append(const QVariant &value)
+{
+    if (storage == Variants || !appendTyped(value)) {
+        if (storage != Variants)
+            convertToVariants();
+        variants.append(value);
+    }
+    ++rows;
+}
+
+bool QSqlCachedColumn::appendTyped(const QVariant &value)
+{
+    const QMetaType type = value.metaType();
+    const bool null = value.isNull();
+    if (null) {
+        if (!hasNulls) {
+            nullType = type;
+            hasNulls = true;
+        } else if (type != nullType) {
+            return false;
+        }
+    } else if (storage == NoValues) {
+        const Storage newStorage = storageFor(type);
+        if (newStorage == Variants)
+            return false;
+        // give the nulls before the first value their slots
+        if (newStorage == Fixed)
+            bytes.resize(rows * type.sizeOf(), '\0');
+        else
+            ends.resize(rows, 0);
+        valueType = type;
+        storage = newStorage;
+    } else if (type != valueType) {
+        return false;
+    }
+
+    switch (storage) {
+    case NoValues:
+        break;
+    case Fixed:
+        if (null)
+            bytes.append(valueType.sizeOf(), '\0');
+        else
+            bytes.append(static_cast<const char *>(value.constData()), valueType.sizeOf());
+        break;
+    case Utf16:
+        if (!null) {
+            const QString &string = *static_cast<const QString *>(value.constData());
+            if (string.isNull())
+                return false;
+            chars += string;
+        }
+        ends.append(chars.size());
+        break;
+    case Bytes:
+        if (!null) {
+            const QByteArray &array = *static_cast<const QByteArray *>(value.constData());
+            if (array.isNull())
+                return false;
+            bytes += array;
+        }
+        ends.append(bytes.size());
+        break;
+    case Variants:
+        Q_UNREACHABLE();
+    }
+
+    if (rows % 64 == 0)
+        nulls.append(0);
+    if (null)
+        nulls.last() |= Q_UINT64_C(1) << (rows % 64);
+    return true;
+}
+
+void QSqlCachedColumn::convertToVariants()
+{
+    QList<QVariant> values;
+    values.reserve(rows + 1);
+    for (qsizetype row = 0; row < rows; ++row)
+        values.append(value(row));
+    const qsizetype count = rows;
+    clear();
+    variants = std::move(values);
+    rows = count;
+    storage = Variants;
+}
+
+QVariant QSqlCachedColumn::value(qsizetype row) const
+{
+    if (storage == Variants)
+        return variants.at(row);
+    if (nullAt(row))
+        return QVariant(nullType);
+
+    switch (storage) {
+    case Fixed:
+        return QVariant(valueType, bytes.constData() + row * valueType.sizeOf());
+    case Utf16:
+        return QString(chars.constData() + begin(row), ends.at(row) - begin(row));
+    case Bytes:
+        return QByteArray(bytes.constData() + begin(row), ends.at(row) - begin(row));
+    case NoValues:
+    case Variants:
+        break;
+    }
+    Q_UNREACHABLE_RETURN(QVariant());
+}
+
+bool QSqlCachedColumn::isNull(qsizetype row) const
+{
+    if (storage == Variants)
+        return variants.at(row).isNull();
+    return nullAt(row);
+}
+
+void QSqlCachedColumn::removeFirst(qsizetype n)
+{
+    // whole words of the null bitmap only
+    Q_ASSERT(n % 64 == 0 && n <= rows);
+    if (!n)
+        return;
+
+    switch (storage) {
+    case NoValues:
+        break;
+    case Fixed:
+        bytes.remove(0, n * valueType.sizeOf());
+        break;
+    case Utf16:
+    case Bytes: {
+        const qsizetype removed = ends.at(n - 1);
+        if (storage == Utf16)
+            chars.remove(0, removed);
+        else
+            bytes.remove(0, removed);
+        ends.remove(0, n);
+        for (qsizetype &end : ends)
+            end -= removed;
+        break;
+    }
+    case Variants:
+        variants.remove(0, n);
+        rows -= n;
+        return;
+    }
+    nulls.remove(0, n / 64);
+    rows -= n;
+}
 
 void QSqlCachedResultPrivate::cleanup()
 {
     cache.clear();
+    columns.clear();
     atEnd = false;
     colCount = 0;
-    rowCacheEnd = 0;
+    firstRow = 0;
+    rowCount = 0;
 }
 
 void QSqlCachedResultPrivate::init(int count, bool fo)
@@ -36,45 +222,40 @@ void QSqlCachedResultPrivate::init(int count, bool fo)
     cleanup();
     forwardOnly = fo;
     colCount = count;
-    if (fo) {
-        cache.resize(count);
-        rowCacheEnd = count;
-    } else {
-        cache.resize(initial_cache_size * count);
-    }
+    cache.resize(count);
+    if (!fo)
+        columns.resize(count);
 }
 
-int QSqlCachedResultPrivate::nextIndex()
+void QSqlCachedResultPrivate::cacheRow()
 {
     if (forwardOnly)
-        return 0;
-    int newIdx = rowCacheEnd;
-    if (newIdx + colCount > cache.size())
-        cache.resize(qMin(cache.size() * 2, cache.size() + 10000));
-    rowCacheEnd += colCount;
-
-    return newIdx;
-}
-
-bool QSqlCachedResultPrivate::canSeek(int i) const
-{
-    if (forwardOnly || i < 0)
-        return false;
-    return rowCacheEnd >= (i + 1) * colCount;
+        return;
+    for (int i = 0; i < colCount; ++i)
+        columns[i].append(cache.at(i));
+    ++rowCount;
+
+    // Drop the oldest rows in blocks rather than one by one, so that the
+    // column buffers are not moved for every row.
+    if (fetchWindow > 0) {
+        const int excess = rowCount - firstRow - fetchWindow;
+        if (excess >= qMax(64, fetchWindow / 2))
+            dropRows(excess & ~63);
+    }
 }
 
-void QSqlCachedResultPrivate::revertLast()
+void QSqlCachedResultPrivate::dropRows(int count)
 {
-    if (forwardOnly)
-        return;
-    rowCacheEnd -= colCount;
+    for (QSqlCachedColumn &column : columns)
+        column.removeFirst(count);
+    firstRow += count;
 }
 
-inline int QSqlCachedResultPrivate::cacheCount() const
+bool QSqlCachedResultPrivate::canSeek(int i) const
 {
-    Q_ASSERT(!forwardOnly);
-    Q_ASSERT(colCount);
-    return rowCacheEnd / colCount;
+    if (forwardOnly || i < firstRow)
+        return false;
+    return rowCount > i;
 }
 
 //////////////
@@ -115,8 +296,17 @@ bool QSqlCachedResult::fetch(int i)
         setAt(i);
         return true;
     }
-    if (d->rowCacheEnd > 0)
-        setAt(d->cacheCount());
+    if (d->fetchWindow > 0) {
+        // Rows before the window were dropped and have to be fetched
+        // again; rows far ahead of it do not need to be cached at all.
+        // Keep half a window before the row, for scrolling back.
+        if (i < d->firstRow && !rewind())
+            return false;
+        if (!skipTo(i - d->fetchWindow / 2))
+            return false;
+    }
+    if (d->rowCount > 0)
+        setAt(d->rowCount);
     while (at() < i + 1) {
         if (!cacheNext()) {
             if (d->canSeek(i))
@@ -154,6 +344,8 @@ bool QSqlCachedResult::fetchFirst()
         setAt(0);
         return true;
     }
+    if (d->firstRow > 0)
+        return fetch(0);
     return cacheNext();
 }
 
@@ -164,7 +356,7 @@ bool QSqlCachedResult::fetchLast()
         if (d->forwardOnly)
             return false;
         else
-            return fetch(d->cacheCount() - 1);
+            return fetch(d->rowCount - 1);
     }
 
     int i = at();
@@ -181,21 +373,27 @@ bool QSqlCachedResult::fetchLast()
 QVariant QSqlCachedResult::data(int i)
 {
     Q_D(const QSqlCachedResult);
-    int idx = d->forwardOnly ? i : at() * d->colCount + i;
-    if (i >= d->colCount || i < 0 || at() < 0 || idx >= d->rowCacheEnd)
+    if (i >= d->colCount || i < 0 || at() < 0)
+        return QVariant();
+    if (d->forwardOnly)
+        return d->cache.at(i);
+    if (at() < d->firstRow || at() >= d->rowCount)
         return QVariant();
 
-    return d->cache.at(idx);
+    return d->columns.at(i).value(at() - d->firstRow);
 }
 
 bool QSqlCachedResult::isNull(int i)
 {
     Q_D(const QSqlCachedResult);
-    int idx = d->forwardOnly ? i : at() * d->colCount + i;
-    if (i >= d->colCount || i < 0 || at() < 0 || idx >= d->rowCacheEnd)
+    if (i >= d->colCount || i < 0 || at() < 0)
+        return true;
+    if (d->forwardOnly)
+        return d->cache.at(i).isNull();
+    if (at() < d->firstRow || at() >= d->rowCount)
         return true;
 
-    return d->cache.at(idx).isNull();
+    return d->columns.at(i).isNull(at() - d->firstRow);
 }
 
 void QSqlCachedResult::cleanup()
@@ -210,7 +408,10 @@ void QSqlCachedResult::clearValues()
 {
     Q_D(QSqlCachedResult);
     setAt(QSql::BeforeFirstRow);
-    d->rowCacheEnd = 0;
+    for (QSqlCachedColumn &column : d->columns)
+        column.clear();
+    d->firstRow = 0;
+    d->rowCount = 0;
     d->atEnd = false;
 }
 
@@ -220,19 +421,47 @@ bool QSqlCachedResult::cacheNext()
     if (d->atEnd)
         return false;
 
-    if (isForwardOnly()) {
-        d->cache.resize(d->colCount);
-    }
-
-    if (!gotoNext(d->cache, d->nextIndex())) {
-        d->revertLast();
+    if (!gotoNext(d->cache, 0)) {
         d->atEnd = true;
         return false;
     }
+    d->cacheRow();
     setAt(at() + 1);
     return true;
 }
 
+bool QSqlCachedResult::rewind()
+{
+    // Executing the query again resets the cache through init().
+    const bool ok = boundValueCount() > 0 ? exec() : reset(lastQuery());
+    if (!ok)
+        setAt(QSql::AfterLastRow);
+    return ok;
+}
+
+bool QSqlCachedResult::skipTo(int row)
+{
+    Q_D(QSqlCachedResult);
+    if (row <= d->rowCount)
+        return true;
+
+    // The cached rows are not needed once the window moves past them.
+    for (QSqlCachedColumn &column : d->columns)
+        column.clear();
+    d->firstRow = d->rowCount;
+    while (d->rowCount < row) {
+        if (d->atEnd || !gotoNext(d->cache, -1)) {
+            d->atEnd = true;
+            d->firstRow = d->rowCount;
+            setAt(QSql::AfterLastRow);
+            return false;
+        }
+        ++d->rowCount;
+        d->firstRow = d->rowCount;
+    }
+    return true;
+}
+
 int QSqlCachedResult::colCount() const
 {
     Q_D(const QSqlCachedResult);
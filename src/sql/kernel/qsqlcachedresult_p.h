@@ -18,12 +18,14 @@
 #include <QtSql/private/qtsqlglobal_p.h>
 #include "QtSql/qsqlresult.h"
 #include "QtSql/private/qsqlresult_p.h"
-#include <QtCore/qcontainerfwd.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
-class QVariant;
-
 class QSqlCachedResultPrivate;
 
 class Q_SQL_EXPORT QSqlCachedResult: public QSqlResult
@@ -58,6 +60,44 @@ protected:
     void setNumericalPrecisionPolicy(QSql::NumericalPrecisionPolicy policy) override;
 private:
     bool cacheNext();
+    bool rewind();
+    bool skipTo(int row);
+};
+
+class QSqlCachedColumn
+{
+public:
+    void append(const QVariant &value);
+    QVariant value(qsizetype row) const;
+    bool isNull(qsizetype row) const;
+    void removeFirst(qsizetype n);
+    void clear() { *this = QSqlCachedColumn(); }
+
+private:
+    enum Storage : quint8 {
+        NoValues,   // only nulls so far
+        Fixed,      // values of a primitive type, back to back in bytes
+        Utf16,      // strings, back to back in chars
+        Bytes,      // byte arrays, back to back in bytes
+        Variants    // anything else
+    };
+
+    static Storage storageFor(QMetaType type);
+    bool appendTyped(const QVariant &value);
+    void convertToVariants();
+    qsizetype begin(qsizetype row) const { return row ? ends.at(row - 1) : 0; }
+    bool nullAt(qsizetype row) const { return nulls.at(row / 64) & (Q_UINT64_C(1) << (row % 64)); }
+
+    QByteArray bytes;
+    QString chars;
+    QList<qsizetype> ends;
+    QList<quint64> nulls;
+    QList<QVariant> variants;
+    qsizetype rows = 0;
+    QMetaType valueType;
+    QMetaType nullType;
+    bool hasNulls = false;
+    Storage storage = NoValues;
 };
 
 class Q_SQL_EXPORT QSqlCachedResultPrivate: public QSqlResultPrivate
@@ -68,14 +108,17 @@ public:
     using QSqlResultPrivate::QSqlResultPrivate;
 
     bool canSeek(int i) const;
-    inline int cacheCount() const;
     void init(int count, bool fo);
     void cleanup();
-    int nextIndex();
-    void revertLast();
+    void cacheRow();
+    void dropRows(int count);
 
+    // The row gotoNext() fills in; rows of scrollable queries are moved
+    // from there into the typed per-column caches.
     QSqlCachedResult::ValueCache cache;
-    int rowCacheEnd = 0;
+    QList<QSqlCachedColumn> columns;
+    int firstRow = 0; // rows before it were dropped to stay within fetchWindow
+    int rowCount = 0;
     int colCount = 0;
     bool atEnd = false;
 };
@@ -0,0 +1,455 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsqlconnectionpool.h"
+
+#include "qsqldriver.h"
+#include "qsqlquery.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+class QSqlConnectionPoolPrivate
+{
+public:
+    explicit QSqlConnectionPoolPrivate(const QString &connectionName);
+
+    struct IdleConnection
+    {
+        QSqlDatabase db;
+        QDeadlineTimer expiry;
+    };
+
+    QString nextName();
+    void takeExpired(QList<QSqlDatabase> *expired);
+    void release(QSqlDatabase db);
+    void discard(QSqlDatabase &db);
+    static void destroy(QSqlDatabase &db);
+
+    const QString connectionName;
+    QString namePrefix;
+    mutable QMutex mutex;
+    QWaitCondition released;
+    QList<IdleConnection> idle;
+    QSqlError lastError;
+    QString healthCheckQuery;
+    std::chrono::milliseconds idleTimeout = std::chrono::minutes(1);
+    int maximumSize = 10;
+    int size = 0;       // idle and checked out
+    quint64 serial = 0;
+    bool closed = false;
+};
+
+QSqlConnectionPoolPrivate::QSqlConnectionPoolPrivate(const QString &connectionName)
+    : connectionName(connectionName)
+{
+    Q_CONSTINIT static QBasicAtomicInteger<quint64> pools = Q_BASIC_ATOMIC_INITIALIZER(0);
+    namePrefix = u"qt_sql_pool_"_s + QString::number(pools.fetchAndAddRelaxed(1)) + u'_';
+}
+
+QString QSqlConnectionPoolPrivate::nextName()
+{
+    return namePrefix + QString::number(serial++) + u':' + connectionName;
+}
+
+// Called with the mutex locked; the expired connections are destroyed by
+// the caller after unlocking it.
+void QSqlConnectionPoolPrivate::takeExpired(QList<QSqlDatabase> *expired)
+{
+    // idle is ordered by release time, so the oldest come first
+    qsizetype count = 0;
+    while (count < idle.size() && idle.at(count).expiry.hasExpired())
+        ++count;
+    for (qsizetype i = 0; i < count; ++i)
+        expired->append(std::move(idle[i].db));
+    idle.remove(0, count);
+    size -= int(count);
+}
+
+void QSqlConnectionPoolPrivate::release(QSqlDatabase db)
+{
+    if (db.isOpen()) {
+        // Let whichever thread acquires the connection next pull it over.
+        db.driver()->moveToThread(nullptr);
+        QMutexLocker locker(&mutex);
+        if (!closed) {
+            idle.append({ std::move(db), QDeadlineTimer(idleTimeout) });
+            released.wakeOne();
+            return;
+        }
+    }
+    discard(db);
+}
+
+// Destroys a connection that was counted in size.
+void QSqlConnectionPoolPrivate::discard(QSqlDatabase &db)
+{
+    destroy(db);
+    QMutexLocker locker(&mutex);
+    --size;
+    released.wakeOne();
+}
+
+void QSqlConnectionPoolPrivate::destroy(QSqlDatabase &db)
+{
+    const QString name = db.connectionName();
+    db.close();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(name);
+}
+
+/*!
+    \class QSqlConnectionPool
+    \inmodule QtSql
+    \ingroup database
+    \since 6.7
+
+    \brief The QSqlConnectionPool class keeps database connections open for
+    reuse by short-lived tasks on any thread.
+
+    Opening a connection to a database server costs a network handshake and
+    authentication. A QSqlConnectionPool opens connections with the settings
+    of an existing connection, the template, and keeps them open when they
+    are released, so that the next task can acquire one that is already open:
+
+    \code
+    QSqlConnectionPool pool("orders");
+    ...
+    // on any thread:
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    if (connection.isValid()) {
+        QSqlQuery query(connection.database());
+        query.exec("UPDATE stock SET count = count - 1 WHERE id = 42");
+    }
+    // connection goes back to the pool here
+    \endcode
+
+    A connection is used by one thread at a time: acquire() hands it to the
+    calling thread, and it must be released on that same thread, either by
+    destroying the QSqlConnectionPool::Connection or by calling its
+    \l{QSqlConnectionPool::Connection::release()}{release()}. All queries on
+    it must have been finished or destroyed by then, and a transaction that
+    was started on it must have been committed or rolled back.
+
+    At most maximumSize() connections are open at the same time; if all of
+    them are in use, acquire() waits for one to be released. Connections that
+    were idle for longer than idleTimeout() are closed, and before an idle
+    connection is handed out again, it is checked with the
+    healthCheckQuery(). Both happen when a connection is acquired, since the
+    pool does not rely on an event loop.
+
+    The pooled connections are added under generated names, which show up in
+    QSqlDatabase::connectionNames(). They are removed again when they are
+    closed, and when the pool is destroyed or cleared.
+
+    \sa QSqlDatabase::cloneDatabase(), {Threads and the SQL Module}
+*/
+
+/*!
+    \class QSqlConnectionPool::Connection
+    \inmodule QtSql
+    \since 6.7
+
+    \brief The QSqlConnectionPool::Connection class is a database connection
+    checked out from a QSqlConnectionPool.
+
+    The connection goes back to the pool when this object is destroyed or
+    release() is called. Connection objects can be moved, but not copied.
+*/
+
+/*!
+    \fn QSqlConnectionPool::Connection::Connection()
+
+    Constructs an invalid connection.
+*/
+
+/*!
+    \fn QSqlConnectionPool::Connection::Connection(Connection &&other)
+
+    Move-constructs a connection from \a other, which becomes invalid.
+*/
+
+/*!
+    \fn QSqlConnectionPool::Connection &QSqlConnectionPool::Connection::operator=(Connection &&other)
+
+    Move-assigns \a other to this object, releasing the connection this
+    object held, and returns a reference to this object.
+*/
+
+/*!
+    \fn QSqlConnectionPool::Connection::~Connection()
+
+    Releases the connection back to its pool.
+*/
+
+/*!
+    \fn void QSqlConnectionPool::Connection::swap(Connection &other)
+
+    Swaps this connection with \a other. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    \fn bool QSqlConnectionPool::Connection::isValid() const
+
+    Returns \c true if this object holds an open connection; otherwise
+    returns \c false, for example if acquire() timed out.
+*/
+
+/*!
+    \fn QSqlDatabase QSqlConnectionPool::Connection::database() const
+
+    Returns the database connection for use with QSqlQuery. It must not be
+    used any more once the connection was released.
+*/
+
+/*!
+    Releases the connection back to its pool, which closes it if the pool
+    was destroyed in the meantime. Afterwards this object is invalid.
+
+    This must be called on the thread that acquired the connection.
+*/
+void QSqlConnectionPool::Connection::release()
+{
+    if (!d)
+        return;
+    const std::shared_ptr<QSqlConnectionPoolPrivate> pool = std::move(d);
+    pool->release(std::exchange(db, QSqlDatabase()));
+}
+
+/*!
+    Constructs a pool of connections that are cloned from the connection
+    \a connectionName. That connection itself is never used by the pool, and
+    does not need to be open; only its settings are copied.
+*/
+QSqlConnectionPool::QSqlConnectionPool(const QString &connectionName)
+    : d(std::make_shared<QSqlConnectionPoolPrivate>(connectionName))
+{
+}
+
+/*!
+    Destroys the pool and closes its idle connections. Connections that are
+    still checked out are closed when they are released.
+*/
+QSqlConnectionPool::~QSqlConnectionPool()
+{
+    {
+        QMutexLocker locker(&d->mutex);
+        d->closed = true;
+    }
+    clear();
+}
+
+/*!
+    Returns the name of the connection the pooled connections are cloned
+    from.
+*/
+QString QSqlConnectionPool::connectionName() const
+{
+    return d->connectionName;
+}
+
+/*!
+    Sets the maximum number of connections the pool keeps open, idle or in
+    use, to \a size. The default is 10.
+
+    \sa maximumSize(), acquire()
+*/
+void QSqlConnectionPool::setMaximumSize(int size)
+{
+    QMutexLocker locker(&d->mutex);
+    d->maximumSize = qMax(size, 1);
+    d->released.wakeAll();
+}
+
+/*!
+    Returns the maximum number of connections the pool keeps open.
+
+    \sa setMaximumSize()
+*/
+int QSqlConnectionPool::maximumSize() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->maximumSize;
+}
+
+/*!
+    Sets the time after which a connection that was released and not
+    acquired again is closed to \a timeout. The default is one minute.
+
+    \sa idleTimeout()
+*/
+void QSqlConnectionPool::setIdleTimeout(std::chrono::milliseconds timeout)
+{
+    QMutexLocker locker(&d->mutex);
+    d->idleTimeout = timeout;
+}
+
+/*!
+    Returns the time after which an idle connection is closed.
+
+    \sa setIdleTimeout()
+*/
+std::chrono::milliseconds QSqlConnectionPool::idleTimeout() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->idleTimeout;
+}
+
+/*!
+    Sets the statement that is executed on an idle connection before it is
+    handed out by acquire() to \a query, for example \c{SELECT 1}. If it
+    fails, the connection is closed and another one is used. If \a query is
+    empty, the default, connections are only checked to still be open.
+
+    \sa healthCheckQuery()
+*/
+void QSqlConnectionPool::setHealthCheckQuery(const QString &query)
+{
+    QMutexLocker locker(&d->mutex);
+    d->healthCheckQuery = query;
+}
+
+/*!
+    Returns the statement that idle connections are checked with.
+
+    \sa setHealthCheckQuery()
+*/
+QString QSqlConnectionPool::healthCheckQuery() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->healthCheckQuery;
+}
+
+/*!
+    Returns the number of connections the pool has open, idle or in use.
+
+    \sa idleCount(), maximumSize()
+*/
+int QSqlConnectionPool::size() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->size;
+}
+
+/*!
+    Returns the number of open connections that are waiting to be acquired.
+
+    \sa size()
+*/
+int QSqlConnectionPool::idleCount() const
+{
+    QMutexLocker locker(&d->mutex);
+    return int(d->idle.size());
+}
+
+/*!
+    Returns the reason why acquire() last returned an invalid connection.
+*/
+QSqlError QSqlConnectionPool::lastError() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->lastError;
+}
+
+/*!
+    Checks out a connection for use on the calling thread. An idle
+    connection is reused if there is one; otherwise a new connection is
+    opened, unless maximumSize() connections are open already, in which case
+    this function waits for one to be released until \a deadline expires.
+
+    Returns an invalid connection if the deadline expired or a new connection
+    could not be opened; lastError() tells why.
+*/
+QSqlConnectionPool::Connection QSqlConnectionPool::acquire(QDeadlineTimer deadline)
+{
+    for (;;) {
+        QSqlDatabase db;
+        QString newName;
+        QString healthCheckQuery;
+        QList<QSqlDatabase> expired;
+        bool timedOut = false;
+        {
+            QMutexLocker locker(&d->mutex);
+            d->takeExpired(&expired);
+            while (d->idle.isEmpty() && d->size >= d->maximumSize) {
+                if (!d->released.wait(&d->mutex, deadline)) {
+                    timedOut = true;
+                    d->lastError = QSqlError(QCoreApplication::translate("QSqlConnectionPool",
+                                                    "Unable to acquire connection"),
+                                             QCoreApplication::translate("QSqlConnectionPool",
+                                                    "All connections are in use"),
+                                             QSqlError::ConnectionError);
+                    break;
+                }
+            }
+            if (!timedOut) {
+                if (!d->idle.isEmpty()) {
+                    // the most recently used connection is the most likely to work
+                    db = d->idle.takeLast().db;
+                    healthCheckQuery = d->healthCheckQuery;
+                } else {
+                    ++d->size;
+                    newName = d->nextName();
+                }
+            }
+        }
+        for (QSqlDatabase &connection : expired)
+            QSqlConnectionPoolPrivate::destroy(connection);
+        if (timedOut)
+            return Connection();
+
+        if (!newName.isEmpty()) {
+            db = QSqlDatabase::cloneDatabase(d->connectionName, newName);
+            if (!db.open()) {
+                QSqlError error = db.isValid() ? db.lastError()
+                        : QSqlError(QCoreApplication::translate("QSqlConnectionPool",
+                                                                "Unable to acquire connection"),
+                                    QCoreApplication::translate("QSqlConnectionPool",
+                                                                "Invalid connection"),
+                                    QSqlError::ConnectionError);
+                d->discard(db);
+                QMutexLocker locker(&d->mutex);
+                d->lastError = std::move(error);
+                return Connection();
+            }
+            return Connection(d, db);
+        }
+
+        db.driver()->moveToThread(QThread::currentThread());
+        bool healthy = db.isOpen();
+        if (healthy && !healthCheckQuery.isEmpty()) {
+            QSqlQuery query(db);
+            healthy = query.exec(healthCheckQuery);
+        }
+        if (healthy)
+            return Connection(d, db);
+        d->discard(db);
+    }
+}
+
+/*!
+    Closes all idle connections. Connections that are in use are not
+    affected.
+*/
+void QSqlConnectionPool::clear()
+{
+    QList<QSqlConnectionPoolPrivate::IdleConnection> idle;
+    {
+        QMutexLocker locker(&d->mutex);
+        idle.swap(d->idle);
+        d->size -= int(idle.size());
+        d->released.wakeAll();
+    }
+    for (auto &connection : idle)
+        QSqlConnectionPoolPrivate::destroy(connection.db);
+}
+
+QT_END_NAMESPACE
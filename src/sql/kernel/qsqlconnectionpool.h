@@ -0,0 +1,80 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLCONNECTIONPOOL_H
+#define QSQLCONNECTIONPOOL_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqlerror.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qstring.h>
+
+#include <chrono>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlConnectionPoolPrivate;
+
+class Q_SQL_EXPORT QSqlConnectionPool
+{
+public:
+    class Q_SQL_EXPORT Connection
+    {
+    public:
+        Connection() noexcept = default;
+        Connection(Connection &&other) noexcept
+            : d(std::move(other.d)), db(std::exchange(other.db, QSqlDatabase()))
+        {}
+        QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(Connection)
+        ~Connection() { release(); }
+
+        void swap(Connection &other) noexcept
+        {
+            d.swap(other.d);
+            std::swap(db, other.db);
+        }
+
+        bool isValid() const { return db.isValid(); }
+        QSqlDatabase database() const { return db; }
+        void release();
+
+    private:
+        friend class QSqlConnectionPool;
+        Connection(std::shared_ptr<QSqlConnectionPoolPrivate> d, const QSqlDatabase &db)
+            : d(std::move(d)), db(db)
+        {}
+
+        std::shared_ptr<QSqlConnectionPoolPrivate> d;
+        QSqlDatabase db;
+    };
+
+    explicit QSqlConnectionPool(const QString &connectionName
+                                = QLatin1StringView(QSqlDatabase::defaultConnection));
+    ~QSqlConnectionPool();
+
+    QString connectionName() const;
+
+    void setMaximumSize(int size);
+    int maximumSize() const;
+    void setIdleTimeout(std::chrono::milliseconds timeout);
+    std::chrono::milliseconds idleTimeout() const;
+    void setHealthCheckQuery(const QString &query);
+    QString healthCheckQuery() const;
+
+    int size() const;
+    int idleCount() const;
+    QSqlError lastError() const;
+
+    Connection acquire(QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever));
+    void clear();
+
+private:
+    Q_DISABLE_COPY(QSqlConnectionPool)
+    std::shared_ptr<QSqlConnectionPoolPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLCONNECTIONPOOL_H
@@ -12,6 +12,9 @@
 #include "QtCore/qapplicationstatic.h"
 #include "private/qfactoryloader_p.h"
 #include "private/qsqlnulldriver_p.h"
+#if QT_CONFIG(future)
+#include "private/qsqlasync_p.h"
+#endif
 #include "qhash.h"
 #include "qthread.h"
 
@@ -480,6 +483,9 @@ QSqlDatabase QSqlDatabase::database(const QString& connectionName, bool open)
 void QSqlDatabase::removeDatabase(const QString& connectionName)
 {
     QSqlDatabasePrivate::removeDatabase(connectionName);
+#if QT_CONFIG(future)
+    QSqlAsync::removeConnection(connectionName);
+#endif
 }
 
 /*!
@@ -704,6 +710,48 @@ QSqlQuery QSqlDatabase::exec(const QString & query) const
 }
 #endif
 
+#if QT_CONFIG(future)
+QString QSqlAsync::connectionName(const QSqlDriver *driver)
+{
+    const QConnectionDict *dict = dbDict();
+    Q_ASSERT(dict);
+    QReadLocker locker(&dict->lock);
+    for (auto it = dict->cbegin(), end = dict->cend(); it != end; ++it) {
+        if (it.value().driver() == driver)
+            return it.key();
+    }
+    return QString();
+}
+
+/*!
+    \since 6.7
+
+    Executes the SQL statement \a query without blocking the calling
+    thread, and returns a future that delivers the outcome once the
+    statement has finished. If \a boundValues is not empty, \a query is
+    prepared and the values are bound to its placeholders in order, as with
+    QSqlQuery::addBindValue().
+
+    The statements of a connection are executed in the order they were
+    issued, on a thread of the connection's own. That thread uses a
+    connection of its own that is cloned from this one with
+    cloneDatabase(), so it does not see uncommitted changes made through
+    this connection, nor, for example, an SQLite in-memory database. The
+    connection must have been added with a driver name for it to be cloned.
+
+    All rows of the result set are fetched before the future finishes and
+    are available as QSqlResultSet::records. Errors are reported through
+    QSqlResultSet::error rather than lastError().
+
+    \sa QSqlQuery::execAsync(), QSqlResultSet, {Threads and the SQL Module}
+*/
+QFuture<QSqlResultSet> QSqlDatabase::execAsync(const QString &query,
+                                               const QVariantList &boundValues) const
+{
+    return QSqlAsync::exec(d->connName, query, boundValues, numericalPrecisionPolicy());
+}
+#endif
+
 /*!
     Opens the database connection using the current connection
     values. Returns \c true on success; otherwise returns \c false. Error
@@ -6,6 +6,11 @@
 
 #include <QtSql/qtsqlglobal.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <QtSql/qsqlresultset.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -51,6 +56,10 @@ public:
 #if QT_DEPRECATED_SINCE(6, 6)
     QT_DEPRECATED_VERSION_X_6_6("QSqlQuery::exec() instead.")
     QSqlQuery exec(const QString& query = QString()) const;
+#endif
+#if QT_CONFIG(future)
+    QFuture<QSqlResultSet> execAsync(const QString &query,
+                                     const QVariantList &boundValues = {}) const;
 #endif
     QSqlError lastError() const;
     bool isValid() const;
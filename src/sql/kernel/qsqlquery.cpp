@@ -12,6 +12,9 @@
 #include "qsqldriver.h"
 #include "qsqldatabase.h"
 #include "private/qsqlnulldriver_p.h"
+#if QT_CONFIG(future)
+#include "private/qsqlasync_p.h"
+#endif
 
 #ifdef QT_DEBUG_SQL
 #include "qelapsedtimer.h"
@@ -27,6 +30,18 @@ public:
     QAtomicInt ref;
     QSqlResult* sqlResult;
 
+    // the record of the active result set, so that looking up fields by
+    // name doesn't make the driver describe the result on every row
+    QSqlRecord resultRecord;
+    bool resultRecordValid = false;
+
+    QSqlRecord record();
+    void resultSetChanged()
+    {
+        resultRecord = QSqlRecord();
+        resultRecordValid = false;
+    }
+
     static QSqlQueryPrivate* shared_null();
 };
 
@@ -59,6 +74,18 @@ QSqlQueryPrivate::~QSqlQueryPrivate()
     delete sqlResult;
 }
 
+QSqlRecord QSqlQueryPrivate::record()
+{
+    // the shared null result is never active, so it is never written to
+    if (!sqlResult->isActive())
+        return sqlResult->record();
+    if (!resultRecordValid) {
+        resultRecord = sqlResult->record();
+        resultRecordValid = true;
+    }
+    return resultRecord;
+}
+
 /*!
     \class QSqlQuery
     \brief The QSqlQuery class provides a means of executing and
@@ -336,7 +363,7 @@ bool QSqlQuery::isNull(int field) const
 
 bool QSqlQuery::isNull(const QString &name) const
 {
-    qsizetype index = d->sqlResult->record().indexOf(name);
+    qsizetype index = d->record().indexOf(name);
     if (index > -1)
         return isNull(index);
     qWarning("QSqlQuery::isNull: unknown field name '%s'", qPrintable(name));
@@ -384,6 +411,7 @@ bool QSqlQuery::exec(const QString& query)
         d->sqlResult->setNumericalPrecisionPolicy(d->sqlResult->numericalPrecisionPolicy());
         setForwardOnly(fo);
     } else {
+        d->resultSetChanged();
         d->sqlResult->clear();
         d->sqlResult->setActive(false);
         d->sqlResult->setLastError(QSqlError());
@@ -442,12 +470,14 @@ QVariant QSqlQuery::value(int index) const
     Returns the value of the field called \a name in the current record.
     If field \a name does not exist an invalid variant is returned.
 
-    This overload is less efficient than \l{QSqlQuery::}{value()}
+    This overload is less efficient than \l{QSqlQuery::}{value()}. When
+    reading the same fields of many records, look up their indexes once
+    with record().indexOf() after the query has been executed.
 */
 
 QVariant QSqlQuery::value(const QString& name) const
 {
-    qsizetype index = d->sqlResult->record().indexOf(name);
+    qsizetype index = d->record().indexOf(name);
     if (index > -1)
         return value(index);
     qWarning("QSqlQuery::value: unknown field name '%s'", qPrintable(name));
@@ -917,7 +947,7 @@ void QSqlQuery::setForwardOnly(bool forward)
 */
 QSqlRecord QSqlQuery::record() const
 {
-    QSqlRecord rec = d->sqlResult->record();
+    QSqlRecord rec = d->record();
 
     if (isValid()) {
         for (qsizetype i = 0; i < rec.count(); ++i)
@@ -970,6 +1000,7 @@ bool QSqlQuery::prepare(const QString& query)
         setForwardOnly(fo);
         d->sqlResult->setNumericalPrecisionPolicy(d->sqlResult->numericalPrecisionPolicy());
     } else {
+        d->resultSetChanged();
         d->sqlResult->setActive(false);
         d->sqlResult->setLastError(QSqlError());
         d->sqlResult->setAt(QSql::BeforeFirstRow);
@@ -1008,6 +1039,7 @@ bool QSqlQuery::exec()
     QElapsedTimer t;
     t.start();
 #endif
+    d->resultSetChanged();
     d->sqlResult->resetBindCount();
 
     if (d->sqlResult->lastError().isValid())
@@ -1022,6 +1054,43 @@ bool QSqlQuery::exec()
     return retval;
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.7
+
+    Executes the query that was prepared with prepare(), with the values
+    that are currently bound to it, without blocking the calling thread.
+    Returns a future that delivers the outcome once the query has finished.
+
+    The query is executed on the thread of the query's database connection,
+    as described for QSqlDatabase::execAsync(); neither this query nor its
+    lastError() change. Only positional binding is carried over, so the
+    values are bound in the order of boundValues().
+
+    \sa exec(), QSqlDatabase::execAsync(), QSqlResultSet
+*/
+QFuture<QSqlResultSet> QSqlQuery::execAsync() const
+{
+    return QSqlDatabase::database(QSqlAsync::connectionName(driver()), false)
+            .execAsync(lastQuery(), boundValues());
+}
+
+/*!
+    \since 6.7
+    \overload
+
+    Executes the SQL statement \a query on this query's database connection
+    without blocking the calling thread, and returns a future that delivers
+    the outcome once the statement has finished.
+
+    \sa exec(), QSqlDatabase::execAsync(), QSqlResultSet
+*/
+QFuture<QSqlResultSet> QSqlQuery::execAsync(const QString &query) const
+{
+    return QSqlDatabase::database(QSqlAsync::connectionName(driver()), false).execAsync(query);
+}
+#endif // QT_CONFIG(future)
+
 /*! \enum QSqlQuery::BatchExecutionMode
 
     \value ValuesAsRows - Updates multiple rows. Treats every entry in a QVariantList as a value for updating the next row.
@@ -1073,6 +1142,7 @@ bool QSqlQuery::exec()
 */
 bool QSqlQuery::execBatch(BatchExecutionMode mode)
 {
+    d->resultSetChanged();
     d->sqlResult->resetBindCount();
     return d->sqlResult->execBatch(mode == ValuesAsColumns);
 }
@@ -1285,6 +1355,7 @@ QSql::NumericalPrecisionPolicy QSqlQuery::numericalPrecisionPolicy() const
 void QSqlQuery::finish()
 {
     if (isActive()) {
+        d->resultSetChanged();
         d->sqlResult->setLastError(QSqlError());
         d->sqlResult->setAt(QSql::BeforeFirstRow);
         d->sqlResult->detachFromResultSet();
@@ -1325,8 +1396,10 @@ void QSqlQuery::finish()
 */
 bool QSqlQuery::nextResult()
 {
-    if (isActive())
+    if (isActive()) {
+        d->resultSetChanged();
         return d->sqlResult->nextResult();
+    }
     return false;
 }
 
@@ -63,6 +63,9 @@ public:
 
     void setForwardOnly(bool forward);
     bool exec(const QString& query);
+#if QT_CONFIG(future)
+    QFuture<QSqlResultSet> execAsync(const QString &query) const;
+#endif
     QVariant value(int i) const;
     QVariant value(const QString& name) const;
 
@@ -79,6 +82,9 @@ public:
 
     // prepared query support
     bool exec();
+#if QT_CONFIG(future)
+    QFuture<QSqlResultSet> execAsync() const;
+#endif
     enum BatchExecutionMode { ValuesAsRows, ValuesAsColumns };
     bool execBatch(BatchExecutionMode mode = ValuesAsRows);
     bool prepare(const QString& query);
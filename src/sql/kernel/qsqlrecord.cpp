@@ -6,23 +6,122 @@
 #include "qatomic.h"
 #include "qdebug.h"
 #include "qlist.h"
+#include "qmath.h"
 #include "qsqlfield.h"
 #include "qstring.h"
 
+#include <QtCore/private/qstringiterator_p.h>
+
 QT_BEGIN_NAMESPACE
 
+// records with fewer fields are searched linearly
+static constexpr qsizetype MinIndexedFields = 8;
+
 class QSqlRecordPrivate : public QSharedData
 {
 public:
+    QSqlRecordPrivate() = default;
+    QSqlRecordPrivate(const QSqlRecordPrivate &other);
+    ~QSqlRecordPrivate() { releaseNameIndex(nameIndex.loadRelaxed()); }
+
     inline bool contains(qsizetype index) const
     {
       return index >= 0 && index < fields.size();
     }
 
+    int indexOfName(QStringView name) const;
+    // to be called after the names or the order of the fields changed
+    void fieldsChanged() { releaseNameIndex(nameIndex.fetchAndStoreRelaxed(nullptr)); }
+
     QList<QSqlField> fields;
+
+private:
+    // An open addressing hash table of the positions of the fields, plus
+    // one, by their case-folded names. It is built on the first lookup and
+    // shared by the copies of the record as long as they have the same
+    // fields, such as the copies QSqlQuery::record() fills in the values of.
+    struct NameIndex
+    {
+        QAtomicInt ref = 1;
+        QList<int> slots;
+    };
+    const NameIndex *buildNameIndex() const;
+    static void releaseNameIndex(NameIndex *index)
+    {
+        if (index && !index->ref.deref())
+            delete index;
+    }
+
+    mutable QAtomicPointer<NameIndex> nameIndex;
 };
 QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QSqlRecordPrivate)
 
+QSqlRecordPrivate::QSqlRecordPrivate(const QSqlRecordPrivate &other)
+    : QSharedData(other), fields(other.fields)
+{
+    // other is shared with us while it is being copied, so its index can't
+    // be dropped under our feet
+    NameIndex *index = other.nameIndex.loadAcquire();
+    if (index)
+        index->ref.ref();
+    nameIndex.storeRelaxed(index);
+}
+
+// consistent with QString::compare(..., Qt::CaseInsensitive)
+static size_t qHashFieldName(QStringView name) noexcept
+{
+    size_t h = 0;
+    QStringIterator it(name);
+    while (it.hasNext())
+        h = 31 * h + QChar::toCaseFolded(it.next());
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    return h ^ (h >> 16);
+}
+
+const QSqlRecordPrivate::NameIndex *QSqlRecordPrivate::buildNameIndex() const
+{
+    auto index = new NameIndex;
+    index->slots.resize(qNextPowerOfTwo(quint32(fields.size() * 2 - 1)));
+    const qsizetype mask = index->slots.size() - 1;
+    for (int pos = 0; pos < fields.size(); ++pos) {
+        const QString &name = fields.at(pos).name();
+        for (qsizetype i = qHashFieldName(name) & mask;; i = (i + 1) & mask) {
+            const int other = index->slots.at(i) - 1;
+            if (other < 0) {
+                index->slots[i] = pos + 1;
+                break;
+            }
+            // the first field with a name is found
+            if (fields.at(other).name().compare(name, Qt::CaseInsensitive) == 0)
+                break;
+        }
+    }
+
+    // another thread may have been faster
+    NameIndex *current = nullptr;
+    if (!nameIndex.testAndSetOrdered(nullptr, index, current)) {
+        delete index;
+        return current;
+    }
+    return index;
+}
+
+int QSqlRecordPrivate::indexOfName(QStringView name) const
+{
+    const NameIndex *index = nameIndex.loadAcquire();
+    if (!index)
+        index = buildNameIndex();
+    const qsizetype mask = index->slots.size() - 1;
+    for (qsizetype i = qHashFieldName(name) & mask;; i = (i + 1) & mask) {
+        const int pos = index->slots.at(i) - 1;
+        if (pos < 0)
+            return -1;
+        if (fields.at(pos).name().compare(name, Qt::CaseInsensitive) == 0)
+            return pos;
+    }
+}
+
 /*!
     \class QSqlRecord
     \brief The QSqlRecord class encapsulates a database record.
@@ -203,6 +302,8 @@ int QSqlRecord::indexOf(const QString& name) const
     if (idx != -1) {
         tableName = fieldName.left(idx);
         fieldName = fieldName.mid(idx + 1);
+    } else if (d->fields.size() >= MinIndexedFields) {
+        return d->indexOfName(name);
     }
     const int cnt = count();
     for (int i = 0; i < cnt; ++i) {
@@ -248,6 +349,7 @@ void QSqlRecord::append(const QSqlField& field)
 {
     detach();
     d->fields.append(field);
+    d->fieldsChanged();
 }
 
 /*!
@@ -259,6 +361,7 @@ void QSqlRecord::insert(int pos, const QSqlField& field)
 {
    detach();
    d->fields.insert(pos, field);
+   d->fieldsChanged();
 }
 
 /*!
@@ -275,6 +378,7 @@ void QSqlRecord::replace(int pos, const QSqlField& field)
 
     detach();
     d->fields[pos] = field;
+    d->fieldsChanged();
 }
 
 /*!
@@ -291,6 +395,7 @@ void QSqlRecord::remove(int pos)
 
     detach();
     d->fields.remove(pos);
+    d->fieldsChanged();
 }
 
 /*!
@@ -303,6 +408,7 @@ void QSqlRecord::clear()
 {
     detach();
     d->fields.clear();
+    d->fieldsChanged();
 }
 
 /*!
@@ -25,6 +25,7 @@ class Q_SQL_EXPORT QSqlResult
 {
     Q_DECLARE_PRIVATE(QSqlResult)
     friend class QSqlQuery;
+    friend class QSqlQueryModelPrivate;
     friend class QSqlTableModelPrivate;
     // for testing:
     friend class ::tst_QSqlQuery;
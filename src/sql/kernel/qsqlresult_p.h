@@ -95,6 +95,7 @@ public:
     QSql::NumericalPrecisionPolicy precisionPolicy = QSql::LowPrecisionDouble;
     int idx = QSql::BeforeFirstRow;
     int bindCount = 0;
+    int fetchWindow = 0; // rows a QSqlCachedResult keeps at most, 0 for all
     bool active = false;
     bool isSel = false;
     bool forwardOnly = false;
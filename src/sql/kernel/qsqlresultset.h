@@ -0,0 +1,25 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLRESULTSET_H
+#define QSQLRESULTSET_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtSql/qsqlerror.h>
+#include <QtSql/qsqlrecord.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qvariant.h>
+
+QT_BEGIN_NAMESPACE
+
+struct QSqlResultSet
+{
+    QList<QSqlRecord> records;
+    QSqlError error;
+    int numRowsAffected = -1;
+    QVariant lastInsertId;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLRESULTSET_H
@@ -0,0 +1,112 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLSTATEMENTCACHE_P_H
+#define QSQLSTATEMENTCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QtSql module.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+// Keeps the statements a driver prepared once their results are done with
+// them, keyed by the text of their query, so that preparing the same query
+// again on the same connection takes no round trip to the database. A
+// statement is taken out of the cache while a result uses it, so results
+// never share one; when the cache is full, the statement given back the
+// longest time ago is released.
+//
+// The caches are small, a few dozen statements, so they are searched
+// linearly, starting with the most recently used statements.
+template <typename Statement>
+class QSqlStatementCache
+{
+public:
+    QSqlStatementCache() = default;
+    Q_DISABLE_COPY_MOVE(QSqlStatementCache)
+    ~QSqlStatementCache() { Q_ASSERT(entries.isEmpty()); }
+
+    bool isEnabled() const noexcept { return maxSize > 0; }
+    qsizetype capacity() const noexcept { return maxSize; }
+    // only call this while the cache is empty
+    void setCapacity(qsizetype capacity)
+    {
+        Q_ASSERT(entries.isEmpty());
+        maxSize = qMax(capacity, qsizetype(0));
+        entries.reserve(maxSize);
+    }
+    qsizetype size() const noexcept { return entries.size(); }
+
+    std::optional<Statement> take(const QString &query)
+    {
+        for (qsizetype i = entries.size() - 1; i >= 0; --i) {
+            if (entries.at(i).query == query) {
+                Statement statement = std::move(entries[i].statement);
+                entries.removeAt(i);
+                return statement;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // release is called with the statements that don't fit anymore
+    template <typename Release>
+    void insert(const QString &query, Statement statement, Release release)
+    {
+        if (maxSize <= 0) {
+            release(statement);
+            return;
+        }
+        if (entries.size() == maxSize) {
+            release(entries.first().statement);
+            entries.removeFirst();
+        }
+        entries.append({ query, std::move(statement) });
+    }
+
+    template <typename Release>
+    void clear(Release release)
+    {
+        for (Entry &entry : entries)
+            release(entry.statement);
+        entries.clear();
+    }
+
+private:
+    struct Entry {
+        QString query;
+        Statement statement;
+    };
+    QList<Entry> entries; // the most recently used last
+    qsizetype maxSize = 0;
+};
+
+// Parses the value of a <NAME>_STATEMENT_CACHE_SIZE=<n> connect option,
+// given what follows the name
+inline qsizetype qSqlStatementCacheSize(QStringView option)
+{
+    option = option.trimmed();
+    if (!option.startsWith(u'='))
+        return 0;
+    bool ok = false;
+    const int size = option.mid(1).trimmed().toInt(&ok);
+    return ok && size > 0 ? size : 0;
+}
+
+QT_END_NAMESPACE
+
+#endif // QSQLSTATEMENTCACHE_P_H
@@ -7,6 +7,7 @@
 #include <qdebug.h>
 #include <qsqldriver.h>
 #include <qsqlfield.h>
+#include <QtSql/private/qsqlresult_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -49,6 +50,14 @@ void QSqlQueryModelPrivate::prefetch(int limit)
     }
 }
 
+void QSqlQueryModelPrivate::applyFetchWindow()
+{
+    // The window has to hold what fetchMore() fetches ahead of the rows
+    // that are shown, or showing them would run the query over and over.
+    if (QSqlResult *result = const_cast<QSqlResult *>(query.result()))
+        result->d_ptr->fetchWindow = fetchWindow > 0 ? qMax(fetchWindow, 4 * (QSQL_PREFETCH + 1)) : 0;
+}
+
 QSqlQueryModelPrivate::~QSqlQueryModelPrivate()
 {
 }
@@ -178,6 +187,51 @@ bool QSqlQueryModel::canFetchMore(const QModelIndex &parent) const
     return (!parent.isValid() && !d->atEnd);
 }
 
+/*!
+    \since 6.7
+
+    Limits the number of rows the model's query keeps cached on the client
+    to about \a rows. A value of 0, the default, keeps all rows that were
+    fetched.
+
+    Drivers that can only fetch forward, like the SQLite, Oracle and
+    InterBase drivers, have to cache every row they fetched so that the
+    model can go back to it. With a fetch window, such a driver only keeps
+    the rows around the one it fetched most recently. Going back to a row
+    that was dropped executes the query again and fetches forward to it;
+    rows that lie far ahead are skipped without being cached. This keeps the
+    memory used for browsing huge result sets bounded, at the cost of
+    executing the query again when scrolling back a long way. It assumes
+    that executing the query again returns the same rows in the same order,
+    so the query should have an \c{ORDER BY} clause.
+
+    The window is never smaller than a few times the number of rows that
+    fetchMore() fetches at once. Drivers that hold the whole result set, or
+    fetch rows by position, ignore the window.
+
+    \sa fetchWindow(), fetchMore()
+*/
+void QSqlQueryModel::setFetchWindow(int rows)
+{
+    Q_D(QSqlQueryModel);
+    d->fetchWindow = qMax(rows, 0);
+    d->applyFetchWindow();
+}
+
+/*!
+    \since 6.7
+
+    Returns the number of rows the model's query keeps cached, or 0 if it
+    keeps all of them.
+
+    \sa setFetchWindow()
+*/
+int QSqlQueryModel::fetchWindow() const
+{
+    Q_D(const QSqlQueryModel);
+    return d->fetchWindow;
+}
+
 /*!
     \since 5.10
     \reimp
@@ -428,6 +482,7 @@ void QSqlQueryModel::setQuery(QSqlQuery &&query)
     d->query = std::move(query);
     d->rec = newRec;
     d->atEnd = true;
+    d->applyFetchWindow();
 
     if (d->query.isForwardOnly()) {
         d->error = QSqlError("Forward-only queries cannot be used in a data model"_L1,
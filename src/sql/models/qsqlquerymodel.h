@@ -58,6 +58,9 @@ public:
     void fetchMore(const QModelIndex &parent = QModelIndex()) override;
     bool canFetchMore(const QModelIndex &parent = QModelIndex()) const override;
 
+    void setFetchWindow(int rows);
+    int fetchWindow() const;
+
     QHash<int, QByteArray> roleNames() const override;
 
 protected:
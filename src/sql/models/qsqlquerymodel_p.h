@@ -36,6 +36,7 @@ public:
     ~QSqlQueryModelPrivate();
 
     void prefetch(int);
+    void applyFetchWindow();
     void initColOffsets(int size);
     int columnInQuery(int modelColumn) const;
 
@@ -47,6 +48,7 @@ public:
     QList<QHash<int, QVariant>> headers;
     QVarLengthArray<int, 56> colOffsets; // used to calculate indexInQuery of columns
     int nestedResetLevel;
+    int fetchWindow = 0;
 };
 
 // helpers for building SQL expressions
@@ -164,6 +164,153 @@ bool QSqlTableModelPrivate::exec(const QString &stmt, bool prepStatement,
     return true;
 }
 
+/*! \internal
+    Submits the pending changes of an OnManualSubmit model with bulk submit
+    enabled. The rows are visited in the same order as by submitAll(), but
+    consecutive rows that need the same statement are executed as one batch
+    with QSqlQuery::execBatch(). If the driver supports transactions, all of
+    it runs in one transaction, and no row is marked as submitted unless it
+    is committed.
+*/
+bool QSqlTableModelPrivate::submitAllInBulk()
+{
+    Q_Q(QSqlTableModel);
+    QSqlDriver *driver = db.driver();
+    const bool useTransaction = driver->hasFeature(QSqlDriver::Transactions);
+    if (useTransaction && !db.transaction()) {
+        error = db.lastError();
+        return false;
+    }
+
+    if (editQuery.driver() != driver)
+        editQuery = QSqlQuery(db);
+    if (driver->hasFeature(QSqlDriver::SimpleLocking))
+        const_cast<QSqlResult *>(query.result())->detachFromResultSet();
+
+    QString batchStatement;
+    QList<QVariantList> batchValues;    // one list per placeholder
+    QList<int> batchRows;
+    QList<int> executedRows;
+
+    const auto executeBatch = [&]() {
+        if (batchRows.isEmpty())
+            return true;
+        if (!editQuery.prepare(batchStatement)) {
+            error = editQuery.lastError();
+            return false;
+        }
+        if (batchValues.isEmpty()) {
+            // execBatch() needs values to bind
+            for (qsizetype i = 0; i < batchRows.size(); ++i) {
+                if (!editQuery.exec()) {
+                    error = editQuery.lastError();
+                    return false;
+                }
+            }
+        } else {
+            for (const QVariantList &values : std::as_const(batchValues))
+                editQuery.addBindValue(values);
+            if (!editQuery.execBatch()) {
+                error = editQuery.lastError();
+                return false;
+            }
+        }
+        editQuery.finish();
+        executedRows += batchRows;
+        batchRows.clear();
+        batchValues.clear();
+        return true;
+    };
+
+    bool success = true;
+    for (auto it = cache.begin(); success && it != cache.end(); ++it) {
+        const int row = it.key();
+        const ModifiedRow &mrow = it.value();
+        if (mrow.submitted())
+            continue;
+
+        QSqlRecord rec = mrow.rec();
+        QSqlRecord whereValues;
+        QString stmt;
+        switch (mrow.op()) {
+        case Insert:
+            emit q->beforeInsert(rec);
+            stmt = driver->sqlStatement(QSqlDriver::InsertStatement, tableName, rec, true);
+            break;
+        case Update: {
+            emit q->beforeUpdate(row, rec);
+            whereValues = q->primaryValues(row);
+            const QString update = driver->sqlStatement(QSqlDriver::UpdateStatement, tableName,
+                                                        rec, true);
+            const QString where = driver->sqlStatement(QSqlDriver::WhereStatement, tableName,
+                                                       whereValues, true);
+            if (!update.isEmpty() && !where.isEmpty())
+                stmt = SqlTm::concat(update, where);
+            break; }
+        case Delete: {
+            emit q->beforeDelete(row);
+            rec = QSqlRecord();
+            whereValues = q->primaryValues(row);
+            const QString where = driver->sqlStatement(QSqlDriver::WhereStatement, tableName,
+                                                       whereValues, true);
+            if (!where.isEmpty()) {
+                stmt = SqlTm::concat(driver->sqlStatement(QSqlDriver::DeleteStatement, tableName,
+                                                          QSqlRecord(), true),
+                                     where);
+            }
+            break; }
+        case None:
+            Q_ASSERT_X(false, "QSqlTableModel::submitAll()", "Invalid cache operation");
+            break;
+        }
+
+        if (stmt.isEmpty()) {
+            error = QSqlError(mrow.op() == Delete ? "Unable to delete row"_L1
+                                                  : "No Fields to update"_L1,
+                              QString(), QSqlError::StatementError);
+            success = false;
+            break;
+        }
+
+        // the same values as exec() binds
+        QVariantList values;
+        for (int i = 0; i < rec.count(); ++i)
+            if (rec.isGenerated(i))
+                values.append(rec.value(i));
+        for (int i = 0; i < whereValues.count(); ++i)
+            if (whereValues.isGenerated(i) && !whereValues.isNull(i))
+                values.append(whereValues.value(i));
+
+        if (stmt != batchStatement) {
+            success = executeBatch();
+            batchStatement = stmt;
+            batchValues.resize(values.size());
+        }
+        for (qsizetype i = 0; i < values.size(); ++i)
+            batchValues[i].append(values.at(i));
+        batchRows.append(row);
+    }
+    if (success)
+        success = executeBatch();
+
+    if (useTransaction) {
+        if (success && !db.commit()) {
+            error = db.lastError();
+            success = false;
+        }
+        if (!success) {
+            db.rollback();
+            return false;
+        }
+    }
+
+    // without a transaction, the rows executed before an error stay in the
+    // database, as with the row by row path
+    for (int row : std::as_const(executedRows))
+        cache[row].setSubmitted();
+    return success;
+}
+
 /*!
     \class QSqlTableModel
     \brief The QSqlTableModel class provides an editable data model
@@ -698,12 +845,21 @@ bool QSqlTableModel::deleteRowFromTable(int row)
     transactions to be rolled back and resubmitted without
     losing data.
 
+    In OnManualSubmit with bulk submit enabled, the changes are
+    submitted in batches, within a transaction of their own; see
+    setBulkSubmitEnabled().
+
     \sa revertAll(), lastError()
 */
 bool QSqlTableModel::submitAll()
 {
     Q_D(QSqlTableModel);
 
+    if (d->strategy == OnManualSubmit && d->bulkSubmit
+            && d->db.driver()->hasFeature(QSqlDriver::PreparedQueries)) {
+        return d->submitAllInBulk() && select();
+    }
+
     bool success = true;
 
     const auto cachedKeys = d->cache.keys();
@@ -834,6 +990,53 @@ void QSqlTableModel::setEditStrategy(EditStrategy strategy)
     d->strategy = strategy;
 }
 
+/*!
+    \since 6.7
+
+    Sets whether submitAll() submits the changes cached in the
+    \c OnManualSubmit strategy in bulk to \a enable. Bulk submit is
+    disabled by default.
+
+    With bulk submit, consecutive changed rows that need the same
+    statement, for instance inserted rows with the same fields set, are
+    executed as one batch with QSqlQuery::execBatch(), which drivers
+    supporting QSqlDriver::BatchOperations execute in a single round
+    trip. If the driver supports transactions, submitAll() begins one
+    before submitting the changes and commits it afterwards, or rolls it
+    back if a change fails, in which case no change is marked as
+    submitted. The model is repopulated only once, after all the changes
+    are submitted.
+
+    The beforeInsert(), beforeUpdate() and beforeDelete() signals are still
+    emitted for every row, but insertRowIntoTable(), updateRowInTable()
+    and deleteRowFromTable() are not called, so bulk submit should not be
+    enabled on models that reimplement them. submitAll() must not be
+    called in bulk while a transaction is open on the database.
+
+    Bulk submit requires a driver supporting prepared queries; with other
+    drivers, submitAll() submits the rows one by one.
+
+    \sa isBulkSubmitEnabled(), submitAll(), QSqlQuery::execBatch()
+*/
+void QSqlTableModel::setBulkSubmitEnabled(bool enable)
+{
+    Q_D(QSqlTableModel);
+    d->bulkSubmit = enable;
+}
+
+/*!
+    \since 6.7
+
+    Returns whether submitAll() submits the changes in bulk.
+
+    \sa setBulkSubmitEnabled()
+*/
+bool QSqlTableModel::isBulkSubmitEnabled() const
+{
+    Q_D(const QSqlTableModel);
+    return d->bulkSubmit;
+}
+
 /*!
     Returns the current edit strategy.
 
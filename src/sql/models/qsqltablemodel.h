@@ -51,6 +51,9 @@ public:
     virtual void setEditStrategy(EditStrategy strategy);
     EditStrategy editStrategy() const;
 
+    void setBulkSubmitEnabled(bool enable);
+    bool isBulkSubmitEnabled() const;
+
     QSqlIndex primaryKey() const;
     QSqlDatabase database() const;
     int fieldIndex(const QString &fieldName) const;
@@ -43,6 +43,7 @@ public:
 
     bool exec(const QString &stmt, bool prepStatement,
               const QSqlRecord &rec, const QSqlRecord &whereValues);
+    bool submitAllInBulk();
     virtual void revertCachedRow(int row);
     virtual int nameToIndex(const QString &name) const;
     QString strippedFieldName(const QString &name) const;
@@ -56,6 +57,7 @@ public:
 
     QSqlTableModel::EditStrategy strategy;
     bool busyInsertingRows;
+    bool bulkSubmit = false;
 
     QSqlQuery editQuery = { QSqlQuery(nullptr) };
     QSqlIndex primaryIndex;
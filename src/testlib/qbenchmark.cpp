@@ -5,11 +5,19 @@
 #include <QtTest/private/qbenchmark_p.h>
 #include <QtTest/private/qbenchmarkmetric_p.h>
 #include <QtTest/private/qbenchmarktimemeasurers_p.h>
+#include <QtTest/private/qtestresult_p.h>
 
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmath.h>
 #include <QtCore/qset.h>
+#include <QtCore/qstringlist.h>
 #include <QtCore/qdebug.h>
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 QBenchmarkGlobalData *QBenchmarkGlobalData::current;
@@ -52,6 +60,8 @@ QBenchmarkMeasurerBase * QBenchmarkGlobalData::createMeasurer()
 #endif
     } else if (mode_ == EventCounter) {
         measurer = new QBenchmarkEvent;
+    } else if (mode_ == AllocationCounter) {
+        measurer = new QBenchmarkAllocationCounter;
     } else {
         measurer =  new QBenchmarkTimeMeasurer;
     }
@@ -65,6 +75,85 @@ int QBenchmarkGlobalData::adjustMedianIterationCount()
         ? medianIterationCount : measurer->adjustMedianCount(1);
 }
 
+int QBenchmarkGlobalData::adjustWarmupIterationCount()
+{
+    if (warmupIterationCount != -1)
+        return warmupIterationCount;
+    return measurer->needsWarmupIteration() ? 1 : 0;
+}
+
+/*
+    Reads the results to compare with from \a fileName, which was written by
+    the CSV logger. Returns false if the file cannot be read.
+*/
+bool QBenchmarkGlobalData::loadBaseline(const char *fileName)
+{
+    QFile file(QString::fromLocal8Bit(fileName));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    while (!file.atEnd()) {
+        // "function","[globaltag:]tag","metric",value_per_iteration,total,iterations
+        // and, for more than one run, ,samples,mean,stddev,p95
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        const qsizetype keyEnd = line.lastIndexOf(u'"') + 1;
+        if (!line.startsWith(u'"') || keyEnd <= 1)
+            continue;
+        const QStringList fields = line.mid(keyEnd + 1).split(u',');
+        if (fields.size() < 3)
+            continue;
+
+        BaselineEntry entry = {};
+        entry.value = fields.at(0).toDouble();
+        if (fields.size() >= 7) {
+            entry.statistics.samples = fields.at(3).toInt();
+            entry.statistics.mean = fields.at(4).toDouble();
+            entry.statistics.stddev = fields.at(5).toDouble();
+            entry.statistics.p95 = fields.at(6).toDouble();
+        }
+        baseline.insert(line.left(keyEnd), entry);
+    }
+    return true;
+}
+
+/*
+    Returns the statistics of the per-iteration \a values measured in several
+    runs. Values beyond Tukey's fences, 1.5 times the interquartile range
+    below the first or above the third quartile, are rejected as outliers
+    (typically runs that were preempted) before computing the mean, the
+    standard deviation and the 95th percentile.
+*/
+QBenchmarkStatistics QBenchmarkStatistics::fromSamples(QList<qreal> values)
+{
+    QBenchmarkStatistics statistics;
+    if (values.size() < 2)
+        return statistics;
+
+    std::sort(values.begin(), values.end());
+    const auto quantile = [&values](qreal q) {
+        // nearest rank
+        const qsizetype rank = qCeil(q * values.size());
+        return values.at(qBound(qsizetype(0), rank - 1, values.size() - 1));
+    };
+    const qreal q1 = quantile(0.25);
+    const qreal q3 = quantile(0.75);
+    const qreal low = q1 - 1.5 * (q3 - q1);
+    const qreal high = q3 + 1.5 * (q3 - q1);
+    const qsizetype total = values.size();
+    values.removeIf([=](qreal value) { return value < low || value > high; });
+    statistics.outliers = int(total - values.size());
+    statistics.samples = int(values.size());
+
+    statistics.mean = std::accumulate(values.cbegin(), values.cend(), qreal(0)) / values.size();
+    if (values.size() > 1) {
+        qreal sum = 0;
+        for (qreal value : std::as_const(values))
+            sum += (value - statistics.mean) * (value - statistics.mean);
+        statistics.stddev = qSqrt(sum / (values.size() - 1));
+    }
+    statistics.p95 = quantile(0.95);
+    return statistics;
+}
 
 QBenchmarkTestMethodData *QBenchmarkTestMethodData::current;
 
@@ -219,6 +308,104 @@ QList<QBenchmarkMeasurerBase::Measurement> QTest::endBenchmarkMeasurement()
     return QBenchmarkGlobalData::current->measurer->stop();
 }
 
+/*! \internal
+    Returns the columns identifying a result of the current test function in
+    the output of the CSV logger, and in baselines read from it.
+*/
+QString QTest::benchmarkResultKey(QBenchmarkMetric metric)
+{
+    const char *fn = QTestResult::currentTestFunction() ? QTestResult::currentTestFunction()
+        : "UnknownTestFunc";
+    const char *tag = QTestResult::currentDataTag() ? QTestResult::currentDataTag() : "";
+    const char *gtag = QTestResult::currentGlobalDataTag()
+                     ? QTestResult::currentGlobalDataTag()
+                     : "";
+    const char *filler = (tag[0] && gtag[0]) ? ":" : "";
+
+    return QString::asprintf("\"%s\",\"%s%s%s\",\"%s\"", fn, gtag, filler, tag,
+                             benchmarkMetricName(metric));
+}
+
+// two-sided critical values of Student's t distribution at 95%
+static qreal tCritical(qreal degreesOfFreedom)
+{
+    static constexpr qreal table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    const int df = qFloor(degreesOfFreedom);
+    if (df < 1)
+        return table[0];
+    if (df > int(std::size(table)))
+        return 1.960;
+    return table[df - 1];
+}
+
+/*! \internal
+    Compares \a result with the one of the baseline given with -baseline and
+    describes the difference in \a message. With several runs in both, uses
+    Welch's t-test to tell whether the difference is significant.
+
+    Returns true if \a result is significantly worse than the baseline.
+*/
+bool QTest::compareWithBaseline(const QBenchmarkResult &result, QString *message)
+{
+    const QBenchmarkGlobalData *global = QBenchmarkGlobalData::current;
+    const auto it = global->baseline.constFind(benchmarkResultKey(result.measurement.metric));
+    if (it == global->baseline.cend())
+        return false;
+
+    const qreal value = result.measurement.value / result.iterations;
+    const qreal change = qFuzzyIsNull(it->value) ? 0 : (value - it->value) * 100 / it->value;
+    *message = QString::asprintf("%s: %.6g, baseline %.6g (%+.1f%%)",
+                                 benchmarkMetricName(result.measurement.metric),
+                                 value, it->value, change);
+
+    const QBenchmarkStatistics &before = it->statistics;
+    const QBenchmarkStatistics &after = result.statistics;
+    if (before.samples < 2 || after.samples < 2) {
+        *message += QLatin1StringView(", use -median with more than one run for a significance test");
+        return false;
+    }
+
+    const qreal varianceBefore = before.stddev * before.stddev / before.samples;
+    const qreal varianceAfter = after.stddev * after.stddev / after.samples;
+    const qreal standardError = qSqrt(varianceBefore + varianceAfter);
+    bool significant;
+    if (qFuzzyIsNull(standardError)) {
+        significant = !qFuzzyCompare(before.mean, after.mean);
+    } else {
+        const qreal t = (after.mean - before.mean) / standardError;
+        const qreal degreesOfFreedom = (varianceBefore + varianceAfter)
+                * (varianceBefore + varianceAfter)
+                / (varianceBefore * varianceBefore / (before.samples - 1)
+                   + varianceAfter * varianceAfter / (after.samples - 1));
+        significant = qAbs(t) > tCritical(degreesOfFreedom);
+        *message += QString::asprintf(", t = %.2f", t);
+    }
+
+    bool higherIsBetter = false;
+    switch (result.measurement.metric) {
+    case FramesPerSecond:
+    case BitsPerSecond:
+    case BytesPerSecond:
+        higherIsBetter = true;
+        break;
+    default:
+        break;
+    }
+    const bool worse = higherIsBetter ? after.mean < before.mean : after.mean > before.mean;
+
+    if (!significant)
+        *message += QLatin1StringView(", no significant change");
+    else if (worse)
+        *message += QLatin1StringView(", significant regression");
+    else
+        *message += QLatin1StringView(", significant improvement");
+    return significant && worse;
+}
+
 /*!
     Sets the benchmark result for this test function to \a result.
 
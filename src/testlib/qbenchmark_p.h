@@ -25,7 +25,14 @@
 #undef QTESTLIB_USE_PERF_EVENTS
 #endif
 
+#if defined(__GLIBC__) && !defined(QT_ASAN_ENABLED)
+#define QTESTLIB_USE_MALLOC_HOOKS
+#else
+#undef QTESTLIB_USE_MALLOC_HOOKS
+#endif
+
 #include <QtTest/private/qbenchmarkmeasurement_p.h>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtTest/qttestglobal.h>
 #if QT_CONFIG(valgrind)
@@ -35,6 +42,7 @@
 #include <QtTest/private/qbenchmarkperfevents_p.h>
 #endif
 #include <QtTest/private/qbenchmarkevent_p.h>
+#include <QtTest/private/qbenchmarkallocations_p.h>
 #include <QtTest/private/qbenchmarkmetric_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -57,6 +65,20 @@ struct QBenchmarkContext
 };
 Q_DECLARE_TYPEINFO(QBenchmarkContext, Q_RELOCATABLE_TYPE);
 
+// Spread of the per-iteration values of a result over the runs requested
+// with -median, after rejecting outliers. Empty for a single run.
+struct QBenchmarkStatistics
+{
+    int samples = 0;
+    int outliers = 0;
+    qreal mean = 0;
+    qreal stddev = 0;
+    qreal p95 = 0;
+
+    static QBenchmarkStatistics fromSamples(QList<qreal> values);
+};
+Q_DECLARE_TYPEINFO(QBenchmarkStatistics, Q_PRIMITIVE_TYPE);
+
 class QBenchmarkResult
 {
 public:
@@ -64,6 +86,7 @@ public:
     QBenchmarkMeasurerBase::Measurement measurement = { -1, QTest::FramesPerSecond };
     int iterations = -1;
     bool setByMacro = true;
+    QBenchmarkStatistics statistics;
 
     QBenchmarkResult() = default;
 
@@ -95,11 +118,14 @@ public:
 
     QBenchmarkGlobalData();
     ~QBenchmarkGlobalData();
-    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter };
+    enum Mode { WallTime, CallgrindParentProcess, CallgrindChildProcess, PerfCounter, TickCounter, EventCounter,
+                AllocationCounter };
     void setMode(Mode mode);
     Mode mode() const { return mode_; }
     QBenchmarkMeasurerBase *createMeasurer();
     int adjustMedianIterationCount();
+    int adjustWarmupIterationCount();
+    bool loadBaseline(const char *fileName);
 
     QBenchmarkMeasurerBase *measurer = nullptr;
     QBenchmarkContext context;
@@ -110,6 +136,15 @@ public:
     bool verboseOutput = false;
     QString callgrindOutFileBase;
     int minimumTotal = -1;
+    int warmupIterationCount = -1;
+
+    // results of an earlier run, read from the output of the CSV logger
+    struct BaselineEntry
+    {
+        qreal value;
+        QBenchmarkStatistics statistics;
+    };
+    QHash<QString, BaselineEntry> baseline;
 private:
     Mode mode_ = WallTime;
 };
@@ -155,6 +190,9 @@ namespace QTest
 
     void beginBenchmarkMeasurement();
     QList<QBenchmarkMeasurerBase::Measurement> endBenchmarkMeasurement();
+
+    QString benchmarkResultKey(QBenchmarkMetric metric);
+    bool compareWithBaseline(const QBenchmarkResult &result, QString *message);
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,123 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include <QtTest/private/qbenchmarkallocations_p.h>
+#include <QtTest/private/qbenchmark_p.h>
+#include <QtTest/private/qbenchmarkmetric_p.h>
+
+#include <atomic>
+
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The allocation counter counts the calls to malloc(), calloc() and
+    realloc() (and, through them, operator new) made by all threads while
+    a benchmark runs, and the number of bytes they requested.
+
+    It works by interposing these functions: QtTest defines them, so the
+    dynamic linker resolves the calls from the test and the libraries it
+    loads to QtTest before the C library, and they forward to the C
+    library's implementation. This is only possible with glibc, which
+    exports that implementation under another name, and not with a
+    sanitizer, which interposes them itself.
+*/
+
+namespace {
+struct AllocationCounts
+{
+    std::atomic<bool> enabled = false;
+    std::atomic<quint64> allocations = 0;
+    std::atomic<quint64> bytes = 0;
+
+    void count(size_t size) noexcept
+    {
+        if (Q_LIKELY(!enabled.load(std::memory_order_relaxed)))
+            return;
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+};
+}
+
+Q_CONSTINIT static AllocationCounts counts;
+
+QT_END_NAMESPACE
+
+#ifdef QTESTLIB_USE_MALLOC_HOOKS
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+Q_DECL_EXPORT void *malloc(size_t size)
+{
+    QT_PREPEND_NAMESPACE(counts).count(size);
+    return __libc_malloc(size);
+}
+
+Q_DECL_EXPORT void *calloc(size_t count, size_t size)
+{
+    QT_PREPEND_NAMESPACE(counts).count(count * size);
+    return __libc_calloc(count, size);
+}
+
+Q_DECL_EXPORT void *realloc(void *ptr, size_t size)
+{
+    if (size) // otherwise, it frees
+        QT_PREPEND_NAMESPACE(counts).count(size);
+    return __libc_realloc(ptr, size);
+}
+} // extern "C"
+#endif // QTESTLIB_USE_MALLOC_HOOKS
+
+QT_BEGIN_NAMESPACE
+
+QBenchmarkAllocationCounter::QBenchmarkAllocationCounter() = default;
+
+QBenchmarkAllocationCounter::~QBenchmarkAllocationCounter() = default;
+
+bool QBenchmarkAllocationCounter::isAvailable()
+{
+#ifdef QTESTLIB_USE_MALLOC_HOOKS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void QBenchmarkAllocationCounter::start()
+{
+    counts.allocations.store(0, std::memory_order_relaxed);
+    counts.bytes.store(0, std::memory_order_relaxed);
+    counts.enabled.store(true, std::memory_order_relaxed);
+}
+
+QList<QBenchmarkMeasurerBase::Measurement> QBenchmarkAllocationCounter::stop()
+{
+    counts.enabled.store(false, std::memory_order_relaxed);
+    return {
+        { qreal(counts.allocations.load(std::memory_order_relaxed)), QTest::Allocations },
+        { qreal(counts.bytes.load(std::memory_order_relaxed)), QTest::BytesAllocated },
+    };
+}
+
+// Like for the event counter, zero is a valid result that must be accepted
+bool QBenchmarkAllocationCounter::isMeasurementAccepted(Measurement)
+{
+    return true;
+}
+
+int QBenchmarkAllocationCounter::adjustIterationCount(int suggestion)
+{
+    return suggestion;
+}
+
+// The counts are exact, one run is enough
+int QBenchmarkAllocationCounter::adjustMedianCount(int)
+{
+    return 1;
+}
+
+QT_END_NAMESPACE
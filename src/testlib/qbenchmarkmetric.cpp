@@ -46,6 +46,7 @@ static const QBenchmarkMetricKey entries[] = {
     { AlignmentFaults, "AlignmentFaults", "alignment faults" },
     { EmulationFaults, "EmulationFaults", "emulation faults" },
     { RefCPUCycles, "RefCPUCycles", "Reference CPU cycles" },
+    { Allocations, "Allocations", "allocations" },
 };
 static const int NumEntries = sizeof(entries) / sizeof(entries[0]);
 
@@ -88,13 +89,15 @@ static const int NumEntries = sizeof(entries) / sizeof(entries[0]);
   \value MajorPageFaults        Major page faults
   \value AlignmentFaults        Faults caused due to misalignment
   \value EmulationFaults        Faults that needed software emulation
+  \value [since 6.7] Allocations  Heap allocations
 
   \sa QTest::benchmarkMetricName(), QTest::benchmarkMetricUnit()
 
-  Note that \c WalltimeNanoseconds and \c BytesAllocated are
-  only provided for use via \l setBenchmarkResult(), and results
-  in those metrics are not able to be provided automatically
-  by the QTest framework.
+  Note that \c WalltimeNanoseconds is only provided for use via
+  \l setBenchmarkResult(), and results in that metric are not able
+  to be provided automatically by the QTest framework. \c Allocations
+  and \c BytesAllocated are measured by the \c -allocationcounter
+  backend where it is available.
  */
 
 /*!
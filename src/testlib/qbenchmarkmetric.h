@@ -44,6 +44,7 @@ enum QBenchmarkMetric {
     AlignmentFaults,
     EmulationFaults,
     RefCPUCycles,
+    Allocations,
 };
 
 }
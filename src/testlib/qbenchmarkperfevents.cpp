@@ -80,6 +80,10 @@ static QList<PerfEvent> defaultCounters()
         { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES },
         { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS },
         { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+        { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES },
+        { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_REFERENCES },
+        { .type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_MISSES },
+        { .type = PERF_TYPE_SOFTWARE, .config = PERF_COUNT_SW_PAGE_FAULTS },
     };
 }
 
@@ -480,20 +484,34 @@ void QBenchmarkPerfEventsMeasurer::start()
     if (fds.isEmpty()) {
         pid_t pid = 0;      // attach to the current process only
         int cpu = -1;       // on any CPU
-        int group_fd = -1;
         int flags = PERF_FLAG_FD_CLOEXEC;
 
-        fds.reserve(counters.size());
-        for (PerfEvent counter : std::as_const(counters)) {
-            attr.type = counter.type;
-            attr.config = counter.config;
+        // Open all counters as one group, so the kernel schedules them on
+        // the PMU together and their ratios (like instructions per cycle)
+        // come from the same time slices. Only the group leader can be
+        // pinned. A counter that doesn't fit in the group with the ones
+        // before it is opened on its own and multiplexed, its value scaled.
+        auto open = [&](int group_fd) {
             int fd = perf_event_open(&attr, pid, cpu, group_fd, flags);
-            if (fd == -1) {
+            if (fd == -1 && (errno == EACCES || errno == EPERM) && !attr.exclude_kernel) {
                 // probably a paranoid kernel (/proc/sys/kernel/perf_event_paranoid)
                 attr.exclude_kernel = true;
                 attr.exclude_hv = true;
                 fd = perf_event_open(&attr, pid, cpu, group_fd, flags);
             }
+            return fd;
+        };
+
+        fds.reserve(counters.size());
+        for (PerfEvent counter : std::as_const(counters)) {
+            attr.type = counter.type;
+            attr.config = counter.config;
+            attr.pinned = fds.isEmpty();
+            int fd = open(fds.isEmpty() ? -1 : fds.constFirst());
+            if (fd == -1 && !fds.isEmpty()) {
+                attr.pinned = false;
+                fd = open(-1);
+            }
             if (fd == -1) {
                 perror("QBenchmarkPerfEventsMeasurer::start: perf_event_open");
                 exit(1);
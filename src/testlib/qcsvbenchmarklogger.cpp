@@ -49,23 +49,24 @@ void QCsvBenchmarkLogger::addIncident(QAbstractTestLogger::IncidentTypes, const
 
 void QCsvBenchmarkLogger::addBenchmarkResult(const QBenchmarkResult &result)
 {
-    const char *fn = QTestResult::currentTestFunction() ? QTestResult::currentTestFunction()
-        : "UnknownTestFunc";
-    const char *tag = QTestResult::currentDataTag() ? QTestResult::currentDataTag() : "";
-    const char *gtag = QTestResult::currentGlobalDataTag()
-                     ? QTestResult::currentGlobalDataTag()
-                     : "";
-    const char *filler = (tag[0] && gtag[0]) ? ":" : "";
-
-    const char *metric = QTest::benchmarkMetricName(result.measurement.metric);
+    const QByteArray key = QTest::benchmarkResultKey(result.measurement.metric).toUtf8();
 
     char buf[1024];
     // "function","[globaltag:]tag","metric",value_per_iteration,total,iterations
-    qsnprintf(buf, sizeof(buf), "\"%s\",\"%s%s%s\",\"%s\",%.13g,%.13g,%u\n",
-              fn, gtag, filler, tag, metric,
-              result.measurement.value / result.iterations,
+    qsnprintf(buf, sizeof(buf), "%s,%.13g,%.13g,%u",
+              key.constData(), result.measurement.value / result.iterations,
               result.measurement.value, result.iterations);
     outputString(buf);
+
+    // with -median, the spread of the value per iteration over the runs:
+    // ,samples,mean,stddev,p95
+    const QBenchmarkStatistics &statistics = result.statistics;
+    if (statistics.samples > 1) {
+        qsnprintf(buf, sizeof(buf), ",%d,%.13g,%.13g,%.13g",
+                  statistics.samples, statistics.mean, statistics.stddev, statistics.p95);
+        outputString(buf);
+    }
+    outputString("\n");
 }
 
 void QCsvBenchmarkLogger::addMessage(QAbstractTestLogger::MessageTypes, const QString &, const char *, int)
@@ -358,6 +358,21 @@ void QPlainTestLogger::printBenchmarkResults(const QList<QBenchmarkResult> &resu
             }
             Q_FALLTHROUGH();
 
+        case QTest::BranchMisses:
+        case QTest::CacheMisses:
+            if (result.measurement.metric != QTest::Instructions) {
+                const bool branches = result.measurement.metric == QTest::BranchMisses;
+                if (auto total = findResultFor(branches ? QTest::BranchInstructions
+                                                        : QTest::CacheReferences)) {
+                    if (!qIsNull(*total)) {
+                        buf.appendf(", %.2f%% of %s", result.measurement.value * 100 / *total,
+                                    branches ? "branches" : "references");
+                        break;
+                    }
+                }
+            }
+            Q_FALLTHROUGH();
+
         case QTest::InstructionReads:
         case QTest::Events:
         case QTest::BytesAllocated:
@@ -365,12 +380,10 @@ void QPlainTestLogger::printBenchmarkResults(const QList<QBenchmarkResult> &resu
         case QTest::BusCycles:
         case QTest::StalledCycles:
         case QTest::BranchInstructions:
-        case QTest::BranchMisses:
         case QTest::CacheReferences:
         case QTest::CacheReads:
         case QTest::CacheWrites:
         case QTest::CachePrefetches:
-        case QTest::CacheMisses:
         case QTest::CacheReadMisses:
         case QTest::CacheWriteMisses:
         case QTest::CachePrefetchMisses:
@@ -384,6 +397,7 @@ void QPlainTestLogger::printBenchmarkResults(const QList<QBenchmarkResult> &resu
                 buf.appendScaled(result.measurement.value / executionTime, "/sec");
             break;
 
+        case QTest::Allocations:
         case QTest::FramesPerSecond:
         case QTest::CPUTicks:
         case QTest::WalltimeMilliseconds:
@@ -396,6 +410,17 @@ void QPlainTestLogger::printBenchmarkResults(const QList<QBenchmarkResult> &resu
                     QTest::formatResult(result.measurement.value, significantDigits).constData(),
                     result.iterations);
 
+        if (const QBenchmarkStatistics &statistics = result.statistics; statistics.samples > 1) {
+            buf.appendf("     over %d runs: mean %s, stddev %s, p95 %s",
+                        statistics.samples,
+                        QTest::formatResult(statistics.mean, significantDigits).constData(),
+                        QTest::formatResult(statistics.stddev, significantDigits).constData(),
+                        QTest::formatResult(statistics.p95, significantDigits).constData());
+            if (statistics.outliers)
+                buf.appendf(" (%d outliers rejected)", statistics.outliers);
+            buf.append("\n");
+        }
+
         outputMessage(buf);
     }
 }
@@ -772,10 +772,16 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
          " -tickcounter        : Use CPU tick counters to time benchmarks\n"
 #endif
          " -eventcounter       : Counts events received during benchmarks\n"
+#ifdef QTESTLIB_USE_MALLOC_HOOKS
+         " -allocationcounter  : Counts heap allocations during benchmarks\n"
+#endif
          " -minimumvalue n     : Sets the minimum acceptable measurement value\n"
          " -minimumtotal n     : Sets the minimum acceptable total for repeated executions of a test function\n"
          " -iterations  n      : Sets the number of accumulation iterations.\n"
          " -median  n          : Sets the number of median iterations.\n"
+         " -warmup  n          : Sets the number of runs to discard before the median iterations.\n"
+         " -baseline file      : Compares the results with those in file, written by -csv.\n"
+         "                       Fails on significant regressions if both used -median.\n"
          " -vb                 : Print out verbose benchmarking information.\n";
 
     for (int i = 1; i < argc; ++i) {
@@ -954,6 +960,12 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
 #endif
         } else if (strcmp(argv[i], "-eventcounter") == 0) {
             QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::EventCounter);
+        } else if (strcmp(argv[i], "-allocationcounter") == 0) {
+            if (QBenchmarkAllocationCounter::isAvailable()) {
+                QBenchmarkGlobalData::current->setMode(QBenchmarkGlobalData::AllocationCounter);
+            } else {
+                fprintf(stderr, "WARNING: Allocation counting not available. Using the walltime measurer.\n");
+            }
         } else if (strcmp(argv[i], "-minimumvalue") == 0) {
             if (i + 1 >= argc) {
                 fprintf(stderr, "-minimumvalue needs an extra parameter to indicate the minimum time(ms)\n");
@@ -982,6 +994,21 @@ Q_TESTLIB_EXPORT void qtest_qParseArgs(int argc, const char *const argv[], bool
             } else {
                 QBenchmarkGlobalData::current->medianIterationCount = qToInt(argv[++i]);
             }
+        } else if (strcmp(argv[i], "-warmup") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-warmup needs an extra parameter to indicate the number of warmup iterations\n");
+                exit(1);
+            } else {
+                QBenchmarkGlobalData::current->warmupIterationCount = qToInt(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "-baseline") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-baseline needs an extra parameter with the name of the file to compare with\n");
+                exit(1);
+            } else if (!QBenchmarkGlobalData::current->loadBaseline(argv[++i])) {
+                fprintf(stderr, "Could not read benchmark baseline %s\n", argv[i]);
+                exit(1);
+            }
 
         } else if (strcmp(argv[i], "-vb") == 0) {
             QBenchmarkGlobalData::current->verboseOutput = true;
@@ -1085,7 +1112,17 @@ static QList<QBenchmarkResult> qMedian(const QList<QList<QBenchmarkResult>> &con
     const int middle = count / 2;
 
     // ### handle even-sized containers here by doing an arithmetic mean of the two middle items.
-    return containerCopy.at(middle);
+    QList<QBenchmarkResult> median = containerCopy.at(middle);
+    for (qsizetype i = 0; i < median.size(); ++i) {
+        QList<qreal> values;
+        values.reserve(count);
+        for (const QList<QBenchmarkResult> &results : container) {
+            if (i < results.size())
+                values.append(results.at(i).measurement.value / results.at(i).iterations);
+        }
+        median[i].statistics = QBenchmarkStatistics::fromSamples(std::move(values));
+    }
+    return median;
 }
 
 struct QTestDataSetter
@@ -1105,7 +1142,7 @@ void TestMethods::invokeTestOnData(int index) const
     /* Benchmarking: for each median iteration*/
 
     bool isBenchmark = false;
-    int i = (QBenchmarkGlobalData::current->measurer->needsWarmupIteration()) ? -1 : 0;
+    int i = -QBenchmarkGlobalData::current->adjustWarmupIterationCount();
 
     QList<QList<QBenchmarkResult>> resultsList;
     bool minimumTotalReached = false;
@@ -1167,7 +1204,7 @@ void TestMethods::invokeTestOnData(int index) const
 
         QBenchmarkTestMethodData::current->endDataRun();
         if (!QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed()) {
-            if (i > -1)  // iteration -1 is the warmup iteration.
+            if (i > -1)  // negative iterations are the warmup iterations.
                 resultsList.append(QBenchmarkTestMethodData::current->results);
 
             if (isBenchmark && QBenchmarkGlobalData::current->verboseOutput &&
@@ -1200,10 +1237,21 @@ void TestMethods::invokeTestOnData(int index) const
     // If the test is a benchmark, finalize the result after all iterations have finished.
     if (isBenchmark) {
         bool testPassed = !QTestResult::skipCurrentTest() && !QTestResult::currentTestFailed();
+        QList<QBenchmarkResult> results;
+        if (testPassed && QBenchmarkTestMethodData::current->resultsAccepted()) {
+            results = qMedian(resultsList);
+            for (const QBenchmarkResult &result : std::as_const(results)) {
+                QString message;
+                if (QTest::compareWithBaseline(result, &message))
+                    QTestResult::addFailure(qPrintable(message), __FILE__, __LINE__);
+                else if (!message.isEmpty())
+                    QTestLog::info(qPrintable(message), nullptr, 0);
+            }
+        }
         QTestResult::finishedCurrentTestDataCleanup();
         // Only report benchmark figures if the test passed
-        if (testPassed && QBenchmarkTestMethodData::current->resultsAccepted())
-            QTestLog::addBenchmarkResults(qMedian(resultsList));
+        if (!results.isEmpty())
+            QTestLog::addBenchmarkResults(results);
     }
 }
 
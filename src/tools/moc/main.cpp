@@ -20,6 +20,7 @@
 #include <qcommandlineoption.h>
 #include <qcommandlineparser.h>
 #include <qscopedpointer.h>
+#include <qscopeguard.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -155,11 +156,8 @@ static QStringList argumentsFromCommandLineAndFile(const QStringList &arguments,
     return allArguments;
 }
 
-int runMoc(int argc, char **argv)
+int runMoc(const QStringList &commandLine, PreprocessorCache *cache = nullptr)
 {
-    QCoreApplication app(argc, argv);
-    QCoreApplication::setApplicationVersion(QString::fromLatin1(QT_VERSION_STR));
-
     bool autoInclude = true;
     bool defaultInclude = true;
     Preprocessor pp;
@@ -307,6 +305,11 @@ int runMoc(int argc, char **argv)
     depFileRuleNameOption.setValueName(QStringLiteral("rule name"));
     parser.addOption(depFileRuleNameOption);
 
+    QCommandLineOption batchOption(QStringLiteral("batch"));
+    batchOption.setDescription(QStringLiteral("Run moc once for each job in <file>, instead of processing a header. The jobs are separated by empty lines and have one option per line. Must be the only option."));
+    batchOption.setValueName(QStringLiteral("file"));
+    parser.addOption(batchOption);
+
     QCommandLineOption requireCompleTypesOption(QStringLiteral("require-complete-types"));
     requireCompleTypesOption.setDescription(QStringLiteral("Require complete types for better performance"));
     parser.addOption(requireCompleTypesOption);
@@ -319,11 +322,15 @@ int runMoc(int argc, char **argv)
                                  QStringLiteral("MOC generated json output"));
 
     bool hasOptionFiles = false;
-    const QStringList arguments = argumentsFromCommandLineAndFile(app.arguments(), hasOptionFiles);
+    const QStringList arguments = argumentsFromCommandLineAndFile(commandLine, hasOptionFiles);
     if (arguments.isEmpty())
         return 1;
 
     parser.process(arguments);
+    if (parser.isSet(batchOption)) {
+        error("--batch must be the only option");
+        parser.showHelp(1);
+    }
 
     const QStringList files = parser.positionalArguments();
     output = parser.value(outputOption);
@@ -395,6 +402,22 @@ int runMoc(int argc, char **argv)
         p.isFrameworkPath = true;
         pp.includes += p;
     }
+
+    // The jobs of a batch share where they found the files they include
+    // if they use the same include paths
+    QHash<QByteArray, QByteArray> unsharedResolutions;
+    QByteArray includePathsKey;
+    if (cache) {
+        for (const Preprocessor::IncludePath &p : std::as_const(pp.includes))
+            includePathsKey += (p.isFrameworkPath ? "F:" : "I:") + p.path + '\n';
+    }
+    auto &includeResolutions = cache ? cache->includeResolutions[includePathsKey]
+                                     : unsharedResolutions;
+    pp.cache = cache;
+    pp.nonlocalIncludePathResolutionCache.swap(includeResolutions);
+    const auto restoreResolutions = qScopeGuard([&] {
+        pp.nonlocalIncludePathResolutionCache.swap(includeResolutions);
+    });
     const auto defines = parser.values(defineOption);
     for (const QString &arg : defines) {
         QByteArray name = arg.toLocal8Bit();
@@ -642,9 +665,52 @@ int runMoc(int argc, char **argv)
     return 0;
 }
 
+// Runs the jobs in batchFile one after the other, so that the files most
+// of them include are only read and tokenized once.
+static int runBatch(const QString &program, const QString &batchFile)
+{
+    QFile f(batchFile);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error(qPrintable("Cannot open batch file "_L1 + batchFile));
+        return 1;
+    }
+
+    PreprocessorCache cache;
+    int result = 0;
+    QStringList job;
+    const auto runJob = [&] {
+        if (job.isEmpty())
+            return;
+        job.prepend(program);
+        if (runMoc(job, &cache) != 0)
+            result = 1;
+        job.clear();
+    };
+    while (!f.atEnd()) {
+        const QString line = QString::fromLocal8Bit(f.readLine().trimmed());
+        if (line.isEmpty())
+            runJob();
+        else
+            job << line;
+    }
+    runJob();
+    return result;
+}
+
+int mocMain(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QString::fromLatin1(QT_VERSION_STR));
+
+    const QStringList arguments = app.arguments();
+    if (arguments.size() == 3 && (arguments.at(1) == "--batch"_L1 || arguments.at(1) == "-batch"_L1))
+        return runBatch(arguments.at(0), arguments.at(2));
+    return runMoc(arguments);
+}
+
 QT_END_NAMESPACE
 
 int main(int _argc, char **_argv)
 {
-    return QT_PREPEND_NAMESPACE(runMoc)(_argc, _argv);
+    return QT_PREPEND_NAMESPACE(mocMain)(_argc, _argv);
 }
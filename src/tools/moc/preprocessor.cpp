@@ -1090,26 +1090,35 @@ void Preprocessor::preprocess(const QByteArray &filename, Symbols &preprocessed)
                 continue;
             Preprocessor::preprocessedIncludes.insert(include);
 
-            QFile file(QString::fromLocal8Bit(include.constData()));
-            if (!file.open(QFile::ReadOnly))
-                continue;
+            // The tokens don't depend on the macros, so the other headers of
+            // a batch including this file can reuse them. With -E they keep
+            // the whitespace, so they are not shared then.
+            const bool useCache = cache && !preprocessOnly;
+            Symbols tokenized = useCache ? cache->tokenizedIncludes.value(include) : Symbols();
+            if (tokenized.isEmpty()) {
+                QFile file(QString::fromLocal8Bit(include.constData()));
+                if (!file.open(QFile::ReadOnly))
+                    continue;
 
-            QByteArray input = readOrMapFile(&file);
+                QByteArray input = readOrMapFile(&file);
 
-            file.close();
-            if (input.isEmpty())
-                continue;
+                file.close();
+                if (input.isEmpty())
+                    continue;
 
-            Symbols saveSymbols = symbols;
-            int saveIndex = index;
+                // phase 1: get rid of backslash-newlines
+                input = cleaned(input);
 
-            // phase 1: get rid of backslash-newlines
-            input = cleaned(input);
+                // phase 2: tokenize for the preprocessor
+                tokenized = tokenize(input);
+                if (useCache)
+                    cache->tokenizedIncludes.insert(include, tokenized);
+            }
 
-            // phase 2: tokenize for the preprocessor
-            symbols = tokenize(input);
-            input.clear();
+            Symbols saveSymbols = symbols;
+            int saveIndex = index;
 
+            symbols = std::move(tokenized);
             index = 0;
 
             // phase 3: preprocess conditions and substitute macros
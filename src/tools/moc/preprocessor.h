@@ -29,6 +29,15 @@ typedef QHash<MacroName, Macro> Macros;
 
 class QFile;
 
+// Shared by the headers processed in one run of moc --batch: the tokens of
+// the files they include, and where the includes were found, per list of
+// include paths
+struct PreprocessorCache
+{
+    QHash<QByteArray, Symbols> tokenizedIncludes;
+    QHash<QByteArray, QHash<QByteArray, QByteArray>> includeResolutions;
+};
+
 class Preprocessor : public Parser
 {
 public:
@@ -37,6 +46,7 @@ public:
     QList<QByteArray> frameworks;
     QSet<QByteArray> preprocessedIncludes;
     QHash<QByteArray, QByteArray> nonlocalIncludePathResolutionCache;
+    PreprocessorCache *cache = nullptr;
     Macros macros;
     QByteArray resolveInclude(const QByteArray &filename, const QByteArray &relativeTo);
     Symbols preprocessed(const QByteArray &filename, QFile *device);
@@ -160,6 +160,9 @@ int runRcc(int argc, char *argv[])
     QCommandLineOption noZstdOption(QStringLiteral("no-zstd"), QStringLiteral("Disable usage of zstd compression."));
     parser.addOption(noZstdOption);
 
+    QCommandLineOption zstdChunkedOption(QStringLiteral("zstd-chunked"), QStringLiteral("Compress large files with zstd in independent 64 KiB frames, so they can be read without decompressing them entirely."));
+    parser.addOption(zstdChunkedOption);
+
     QCommandLineOption thresholdOption(QStringLiteral("threshold"), QStringLiteral("Threshold to consider compressing files."), QStringLiteral("level"));
     parser.addOption(thresholdOption);
 
@@ -229,6 +232,11 @@ int runRcc(int argc, char *argv[])
         library.setCompressionAlgorithm(RCCResourceLibrary::parseCompressionAlgorithm(parser.value(compressionAlgoOption), &errorMsg));
     if (parser.isSet(noZstdOption))
         library.setNoZstd(true);
+    if (parser.isSet(zstdChunkedOption)) {
+        if (library.noZstd())
+            errorMsg = "--zstd-chunked and --no-zstd both specified."_L1;
+        library.setZstdChunked(true);
+    }
     if (library.compressionAlgorithm() == RCCResourceLibrary::CompressionAlgorithm::Zstd) {
         if (formatVersion < 3)
             errorMsg = "Zstandard compression requires format version 3 or higher"_L1;
@@ -14,8 +14,12 @@
 #include <qlocale.h>
 #include <qstack.h>
 #include <qxmlstream.h>
+#if QT_CONFIG(thread)
+#  include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <utility>
 
 #if QT_CONFIG(zstd)
 #  include <zstd.h>
@@ -32,7 +36,8 @@ enum {
     CONSTANT_COMPRESSLEVEL_DEFAULT = -1,
     CONSTANT_ZSTDCOMPRESSLEVEL_CHECK = 1,   // Zstd level to check if compressing is a good idea
     CONSTANT_ZSTDCOMPRESSLEVEL_STORE = 14,  // Zstd level to actually store the data
-    CONSTANT_COMPRESSTHRESHOLD_DEFAULT = 70
+    CONSTANT_COMPRESSTHRESHOLD_DEFAULT = 70,
+    CONSTANT_ZSTDCHUNKSIZE = 64 * 1024      // Uncompressed size of each frame with --zstd-chunked
 };
 
 void RCCResourceLibrary::write(const char *str, int len)
@@ -72,7 +77,8 @@ public:
         NoFlags = 0x00,
         Compressed = 0x01,
         Directory = 0x02,
-        CompressedZstd = 0x04
+        CompressedZstd = 0x04,
+        CompressedZstdChunked = 0x08
     };
 
 
@@ -91,6 +97,7 @@ public:
     QString resourceName() const;
 
 public:
+    void prepareData(const RCCResourceLibrary &lib);
     qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset, QString *errorMessage);
     qint64 writeDataName(RCCResourceLibrary &, qint64 offset);
     void writeDataInfo(RCCResourceLibrary &lib);
@@ -112,6 +119,12 @@ public:
     qint64 m_nameOffset = 0;
     qint64 m_dataOffset = 0;
     qint64 m_childOffset = 0;
+
+    // set by prepareData()
+    bool m_prepared = false;
+    QByteArray m_data;
+    QByteArray m_notes;
+    QString m_dataError;
 };
 
 RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo, QLocale::Language language,
@@ -217,25 +230,36 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
     }
 }
 
-qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
-    QString *errorMessage)
+#if QT_CONFIG(zstd)
+// Each thread compressing files uses its own context
+static ZSTD_CCtx *zstdContext()
 {
-    const bool text = lib.m_format == RCCResourceLibrary::C_Code;
-    const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
-    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
-    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
-    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
+    struct Context
+    {
+        ZSTD_CCtx *cctx = ZSTD_createCCtx();
+        ~Context() { ZSTD_freeCCtx(cctx); }
+    };
+    static thread_local Context context;
+    return context.cctx;
+}
+#endif
 
-    //capture the offset
-    m_dataOffset = offset;
-    QByteArray data;
+// Reads the file and compresses it if that's worth it. The notes for the
+// verbose output are kept until the data is written. This only changes this
+// RCCFileInfo, so several files can be prepared concurrently.
+void RCCFileInfo::prepareData(const RCCResourceLibrary &lib)
+{
+    if (m_prepared)
+        return;
+    m_prepared = true;
+    QByteArray &data = m_data;
 
     if (!m_isEmpty) {
         //find the data to be written
         QFile file(m_fileInfo.absoluteFilePath());
         if (!file.open(QFile::ReadOnly)) {
-            *errorMessage = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
-            return 0;
+            m_dataError = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
+            return;
         }
 
         data = file.readAll();
@@ -249,10 +273,13 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
             m_compressLevel = 19;   // not ZSTD_maxCLevel(), as 20+ are experimental
         }
         if (m_compressAlgo == RCCResourceLibrary::CompressionAlgorithm::Zstd && !m_noZstd) {
-            if (lib.m_zstdCCtx == nullptr)
-                lib.m_zstdCCtx = ZSTD_createCCtx();
-            qsizetype size = data.size();
-            size = ZSTD_COMPRESSBOUND(size);
+            ZSTD_CCtx *cctx = zstdContext();
+            // Split large files into independent frames, so that they can be
+            // decompressed piecewise when read through QFile.
+            const bool chunked = lib.zstdChunked() && data.size() > CONSTANT_ZSTDCHUNKSIZE;
+            const qsizetype chunkSize = chunked ? qsizetype(CONSTANT_ZSTDCHUNKSIZE) : data.size();
+            const qsizetype chunkCount = (data.size() + chunkSize - 1) / chunkSize;
+            qsizetype size = chunkCount * ZSTD_COMPRESSBOUND(chunkSize);
 
             int compressLevel = m_compressLevel;
             if (compressLevel < 0)
@@ -260,34 +287,43 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
 
             QByteArray compressed(size, Qt::Uninitialized);
             char *dst = const_cast<char *>(compressed.constData());
-            size_t n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                         data.constData(), data.size(),
-                                         compressLevel);
+            auto compress = [&](int level) {
+                size_t total = 0;
+                for (qsizetype offset = 0; offset < data.size(); offset += chunkSize) {
+                    size_t n = ZSTD_compressCCtx(cctx, dst + total, size - total,
+                                                 data.constData() + offset,
+                                                 qMin(chunkSize, data.size() - offset), level);
+                    if (ZSTD_isError(n))
+                        return n;
+                    total += n;
+                }
+                return total;
+            };
+            size_t n = compress(compressLevel);
             if (n * 100.0 < data.size() * 1.0 * (100 - m_compressThreshold) ) {
                 // compressing is worth it
                 if (m_compressLevel < 0) {
                     // heuristic compression, so recompress
-                    n = ZSTD_compressCCtx(lib.m_zstdCCtx, dst, size,
-                                          data.constData(), data.size(),
-                                          CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
+                    n = compress(CONSTANT_ZSTDCOMPRESSLEVEL_STORE);
                 }
                 if (ZSTD_isError(n)) {
                     QString msg = QString::fromLatin1("%1: error: compression with zstd failed: %2\n")
                             .arg(m_name, QString::fromUtf8(ZSTD_getErrorName(n)));
-                    lib.m_errorDevice->write(msg.toUtf8());
+                    m_notes += msg.toUtf8();
                 } else if (lib.verbose()) {
                     QString msg = QString::fromLatin1("%1: note: compressed using zstd (%2 -> %3)\n")
                             .arg(m_name).arg(data.size()).arg(n);
-                    lib.m_errorDevice->write(msg.toUtf8());
+                    m_notes += msg.toUtf8();
                 }
 
-                lib.m_overallFlags |= CompressedZstd;
                 m_flags |= CompressedZstd;
+                if (chunked)
+                    m_flags |= CompressedZstdChunked;
                 data = std::move(compressed);
                 data.truncate(n);
             } else if (lib.verbose()) {
                 QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
-                lib.m_errorDevice->write(msg.toUtf8());
+                m_notes += msg.toUtf8();
             }
         }
 #endif
@@ -305,18 +341,41 @@ qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
                 if (lib.verbose()) {
                     QString msg = QString::fromLatin1("%1: note: compressed using zlib (%2 -> %3)\n")
                             .arg(m_name).arg(data.size()).arg(compressed.size());
-                    lib.m_errorDevice->write(msg.toUtf8());
+                    m_notes += msg.toUtf8();
                 }
                 data = compressed;
-                lib.m_overallFlags |= Compressed;
                 m_flags |= Compressed;
             } else if (lib.verbose()) {
                 QString msg = QString::fromLatin1("%1: note: not compressed\n").arg(m_name);
-                lib.m_errorDevice->write(msg.toUtf8());
+                m_notes += msg.toUtf8();
             }
         }
 #endif // QT_NO_COMPRESS
     }
+}
+
+qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
+    QString *errorMessage)
+{
+    const bool text = lib.m_format == RCCResourceLibrary::C_Code;
+    const bool pass1 = lib.m_format == RCCResourceLibrary::Pass1;
+    const bool pass2 = lib.m_format == RCCResourceLibrary::Pass2;
+    const bool binary = lib.m_format == RCCResourceLibrary::Binary;
+    const bool python = lib.m_format == RCCResourceLibrary::Python_Code;
+
+    //capture the offset
+    m_dataOffset = offset;
+
+    prepareData(lib);
+    if (!m_notes.isEmpty())
+        lib.m_errorDevice->write(std::exchange(m_notes, {}));
+    if (!m_dataError.isEmpty()) {
+        *errorMessage = m_dataError;
+        return 0;
+    }
+    lib.m_overallFlags |= m_flags & (Compressed | CompressedZstd | CompressedZstdChunked);
+    const QByteArray data = std::exchange(m_data, {});
+    m_prepared = false;
 
     // some info
     if (text || pass1) {
@@ -449,20 +508,15 @@ RCCResourceLibrary::RCCResourceLibrary(quint8 formatVersion)
     m_errorDevice(nullptr),
     m_outDevice(nullptr),
     m_formatVersion(formatVersion),
-    m_noZstd(false)
+    m_noZstd(false),
+    m_zstdChunked(false)
 {
     m_out.reserve(30 * 1000 * 1000);
-#if QT_CONFIG(zstd)
-    m_zstdCCtx = nullptr;
-#endif
 }
 
 RCCResourceLibrary::~RCCResourceLibrary()
 {
     delete m_root;
-#if QT_CONFIG(zstd)
-    ZSTD_freeCCtx(m_zstdCCtx);
-#endif
 }
 
 enum RCCXmlTag {
@@ -1145,22 +1199,45 @@ bool RCCResourceLibrary::writeDataBlobs()
     if (!m_root)
         return false;
 
+    QList<RCCFileInfo *> files;
     QStack<RCCFileInfo*> pending;
     pending.push(m_root);
-    qint64 offset = 0;
-    QString errorMessage;
     while (!pending.isEmpty()) {
         RCCFileInfo *file = pending.pop();
         for (auto it = file->m_children.cbegin(); it != file->m_children.cend(); ++it) {
             RCCFileInfo *child = it.value();
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
-            else {
-                offset = child->writeDataBlob(*this, offset, &errorMessage);
-                if (offset == 0) {
-                    m_errorDevice->write(errorMessage.toUtf8());
-                    return false;
-                }
+            else
+                files.append(child);
+        }
+    }
+
+#if QT_CONFIG(thread)
+    // Reading and compressing the files takes most of the time, so it is
+    // done on all cores for a window of files at a time, which keeps the
+    // memory use bounded. The data is still written in the same order.
+    QThreadPool pool;
+    const qsizetype window = qMax(1, pool.maxThreadCount()) * 4;
+#else
+    const qsizetype window = files.size();
+#endif
+    qint64 offset = 0;
+    QString errorMessage;
+    for (qsizetype first = 0; first < files.size(); first += window) {
+        const qsizetype last = qMin(first + window, files.size());
+#if QT_CONFIG(thread)
+        for (qsizetype i = first; i < last; ++i) {
+            RCCFileInfo *file = files.at(i);
+            pool.start([this, file] { file->prepareData(*this); });
+        }
+        pool.waitForDone();
+#endif
+        for (qsizetype i = first; i < last; ++i) {
+            offset = files.at(i)->writeDataBlob(*this, offset, &errorMessage);
+            if (offset == 0) {
+                m_errorDevice->write(errorMessage.toUtf8());
+                return false;
             }
         }
     }
@@ -11,8 +11,6 @@
 #include <qhash.h>
 #include <qstring.h>
 
-typedef struct ZSTD_CCtx_s ZSTD_CCtx;
-
 QT_BEGIN_NAMESPACE
 
 class RCCFileInfo;
@@ -87,6 +85,9 @@ public:
     void setNoZstd(bool v) { m_noZstd = v; }
     bool noZstd() const { return m_noZstd; }
 
+    void setZstdChunked(bool v) { m_zstdChunked = v; }
+    bool zstdChunked() const { return m_zstdChunked; }
+
 private:
     struct Strings {
         Strings();
@@ -124,10 +125,6 @@ private:
     void write(const char *, int len);
     void writeString(const char *s) { write(s, static_cast<int>(strlen(s))); }
 
-#if QT_CONFIG(zstd)
-    ZSTD_CCtx *m_zstdCCtx;
-#endif
-
     const Strings m_strings;
     RCCFileInfo *m_root;
     QStringList m_fileNames;
@@ -150,6 +147,7 @@ private:
     QByteArray m_out;
     quint8 m_formatVersion;
     bool m_noZstd;
+    bool m_zstdChunked;
 };
 
 QT_END_NAMESPACE
@@ -462,15 +462,46 @@ static bool needsTranslation(const DomElement *element)
 // ---  WriteInitialization
 WriteInitialization::WriteInitialization(Uic *uic) :
       m_uic(uic),
-      m_driver(uic->driver()), m_output(uic->output()), m_option(uic->option()),
+      m_driver(uic->driver()), m_driverOutput(uic->output()),
+      m_output(&m_setupUiCode, QIODevice::WriteOnly), m_option(uic->option()),
       m_indent(m_option.indent + m_option.indent),
       m_dindent(m_indent + m_option.indent),
       m_delayedOut(&m_delayedInitialization, QIODevice::WriteOnly),
       m_refreshOut(&m_refreshInitialization, QIODevice::WriteOnly),
-      m_actionOut(&m_delayedActionInitialization, QIODevice::WriteOnly)
+      m_actionOut(&m_delayedActionInitialization, QIODevice::WriteOnly),
+      m_deferredPageConnectionsOut(&m_deferredPageConnections, QIODevice::WriteOnly)
 {
 }
 
+// The widgets in the layouts of node, including nested layouts
+static QList<const DomWidget *> layoutWidgets(const DomWidget *node)
+{
+    QList<const DomWidget *> widgets;
+    QList<const DomLayout *> layouts(node->elementLayout().cbegin(), node->elementLayout().cend());
+    while (!layouts.isEmpty()) {
+        const DomLayout *layout = layouts.takeLast();
+        for (const DomLayoutItem *item : layout->elementItem()) {
+            if (item->kind() == DomLayoutItem::Widget)
+                widgets.append(item->elementWidget());
+            else if (item->kind() == DomLayoutItem::Layout)
+                layouts.append(item->elementLayout());
+        }
+    }
+    return widgets;
+}
+
+static void collectBuddyLabels(const DomWidget *node, QMultiHash<QString, QString> *buddyLabels)
+{
+    for (const DomProperty *p : node->elementProperty()) {
+        if (p->attributeName() == "buddy"_L1 && p->kind() == DomProperty::Cstring)
+            buddyLabels->insert(p->elementCstring(), node->attributeName());
+    }
+    for (const DomWidget *child : node->elementWidget())
+        collectBuddyLabels(child, buddyLabels);
+    for (const DomWidget *child : layoutWidgets(node))
+        collectBuddyLabels(child, buddyLabels);
+}
+
 void WriteInitialization::acceptUI(DomUI *node)
 {
     m_actionGroupChain.push(nullptr);
@@ -485,6 +516,20 @@ void WriteInitialization::acceptUI(DomUI *node)
         m_customSignals = customSlots->elementSignal();
     }
 
+    if (m_option.lazyPages && language::language() == Language::Cpp) {
+        if (const DomTabStops *tabStops = node->elementTabStops()) {
+            const QStringList names = tabStops->elementTabStop();
+            m_referencedNames.unite(QSet<QString>(names.cbegin(), names.cend()));
+        }
+        if (const DomConnections *connections = node->elementConnections()) {
+            for (const DomConnection *connection : connections->elementConnection()) {
+                m_referencedNames.insert(connection->elementSender());
+                m_referencedNames.insert(connection->elementReceiver());
+            }
+        }
+        collectBuddyLabels(node->elementWidget(), &m_buddyLabels);
+    }
+
     acceptLayoutDefault(node->elementLayoutDefault());
     acceptLayoutFunction(node->elementLayoutFunction());
 
@@ -507,6 +552,7 @@ void WriteInitialization::acceptUI(DomUI *node)
     const QString widgetClassName = node->elementWidget()->attributeClass();
 
     const QString parameterType = widgetClassName + " *"_L1;
+    m_mainFormParameterType = parameterType;
     m_output << m_option.indent
              << language::startFunctionDefinition1("setupUi", parameterType, varName, m_option.indent);
 
@@ -522,22 +568,7 @@ void WriteInitialization::acceptUI(DomUI *node)
 
     acceptWidget(node->elementWidget());
 
-    if (!m_buddies.empty())
-        m_output << language::openQtConfig(shortcutConfigKey());
-    for (const Buddy &b : std::as_const(m_buddies)) {
-        const QString buddyVarName = m_driver->widgetVariableName(b.buddyAttributeName);
-        if (buddyVarName.isEmpty()) {
-            fprintf(stderr, "%s: Warning: Buddy assignment: '%s' is not a valid widget.\n",
-                    qPrintable(m_option.messagePrefix()),
-                    qPrintable(b.buddyAttributeName));
-            continue;
-        }
-
-        m_output << m_indent << b.labelVarName << language::derefPointer
-            << "setBuddy(" << buddyVarName << ')' << language::eol;
-    }
-    if (!m_buddies.empty())
-        m_output << language::closeQtConfig(shortcutConfigKey());
+    writeBuddies();
 
     if (node->elementTabStops())
         acceptTabStops(node->elementTabStops());
@@ -554,6 +585,9 @@ void WriteInitialization::acceptUI(DomUI *node)
     if (!m_delayedInitialization.isEmpty())
         m_output << "\n" << m_delayedInitialization << "\n";
 
+    if (!m_deferredPageConnections.isEmpty())
+        m_output << "\n" << m_deferredPageConnections;
+
     if (m_option.autoConnection && m_connectSlotsByName) {
         m_output << "\n" << m_indent << "QMetaObject" << language::qualifier
             << "connectSlotsByName(" << varName << ')' << language::eol;
@@ -581,6 +615,9 @@ void WriteInitialization::acceptUI(DomUI *node)
            << m_refreshInitialization
            << m_option.indent << language::endFunctionDefinition("retranslateUi");
 
+    m_output << m_deferredPageFunctions;
+    m_driverOutput << m_setupUiCode;
+
     m_layoutChain.pop();
     m_widgetChain.pop();
     m_actionGroupChain.pop();
@@ -610,6 +647,174 @@ void WriteInitialization::addWizardPage(const QString &pageVarName, const DomWid
     }
 }
 
+void WriteInitialization::writeBuddies()
+{
+    if (!m_buddies.empty())
+        m_output << language::openQtConfig(shortcutConfigKey());
+    for (const Buddy &b : std::as_const(m_buddies)) {
+        const QString buddyVarName = m_driver->widgetVariableName(b.buddyAttributeName);
+        if (buddyVarName.isEmpty()) {
+            fprintf(stderr, "%s: Warning: Buddy assignment: '%s' is not a valid widget.\n",
+                    qPrintable(m_option.messagePrefix()),
+                    qPrintable(b.buddyAttributeName));
+            continue;
+        }
+
+        m_output << m_indent << b.labelVarName << language::derefPointer
+            << "setBuddy(" << buddyVarName << ')' << language::eol;
+    }
+    if (!m_buddies.empty())
+        m_output << language::closeQtConfig(shortcutConfigKey());
+}
+
+void WriteInitialization::writeZOrder(const DomWidget *node)
+{
+    const QStringList zOrder = node->elementZOrder();
+    for (const QString &name : zOrder) {
+        const QString varName = m_driver->widgetVariableName(name);
+        if (varName.isEmpty()) {
+            fprintf(stderr, "%s: Warning: Z-order assignment: '%s' is not a valid widget.\n",
+                    qPrintable(m_option.messagePrefix()),
+                    name.toLatin1().data());
+        } else {
+            m_output << m_indent << varName << language::derefPointer
+                << (language::language() != Language::Python ? "raise()" : "raise_()") << language::eol;
+        }
+    }
+}
+
+void WriteInitialization::swapFunctionState(FunctionState &state)
+{
+    m_setupUiCode.swap(state.setupCode);
+    m_delayedInitialization.swap(state.delayedInitialization);
+    m_refreshInitialization.swap(state.refreshInitialization);
+    m_delayedActionInitialization.swap(state.delayedActionInitialization);
+    m_deferredPageConnections.swap(state.deferredPageConnections);
+    m_buddies.swap(state.buddies);
+    m_colorBrushHash.swap(state.colorBrushHash);
+    m_fontPropertiesNameMap.swap(state.fontPropertiesNameMap);
+    m_iconPropertiesNameMap.swap(state.iconPropertiesNameMap);
+    m_sizePolicyNameMap.swap(state.sizePolicyNameMap);
+    std::swap(m_firstThemeIcon, state.firstThemeIcon);
+}
+
+struct PageContents
+{
+    QSet<QString> names;
+    QStringList variables;
+    bool canDefer = true;
+};
+
+static void collectPageContents(Driver *driver, const DomLayout *layout, PageContents *contents);
+
+static void collectPageContents(Driver *driver, const DomWidget *node, PageContents *contents)
+{
+    // Actions and button groups are created in setupUi() and may be used
+    // from outside the page
+    if (!node->elementAction().isEmpty() || !node->elementActionGroup().isEmpty()
+        || propertyMap(node->elementAttribute()).contains("buttonGroup"_L1)) {
+        contents->canDefer = false;
+    }
+    for (const DomWidget *child : node->elementWidget()) {
+        contents->names.insert(child->attributeName());
+        contents->variables.append(driver->findOrInsertWidget(child));
+        collectPageContents(driver, child, contents);
+    }
+    for (const DomLayout *layout : node->elementLayout())
+        collectPageContents(driver, layout, contents);
+}
+
+static void collectPageContents(Driver *driver, const DomLayout *layout, PageContents *contents)
+{
+    contents->names.insert(layout->attributeName());
+    contents->variables.append(driver->findOrInsertLayout(layout));
+    for (const DomLayoutItem *item : layout->elementItem()) {
+        switch (item->kind()) {
+        case DomLayoutItem::Widget:
+            contents->names.insert(item->elementWidget()->attributeName());
+            contents->variables.append(driver->findOrInsertWidget(item->elementWidget()));
+            collectPageContents(driver, item->elementWidget(), contents);
+            break;
+        case DomLayoutItem::Layout:
+            collectPageContents(driver, item->elementLayout(), contents);
+            break;
+        case DomLayoutItem::Spacer:
+            contents->variables.append(driver->findOrInsertSpacer(item->elementSpacer()));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static const char *pageContainerClass(const CustomWidgetsInfo *cwi, const QString &className)
+{
+    for (const char *container : {"QTabWidget", "QStackedWidget", "QToolBox"}) {
+        if (cwi->extends(className, container))
+            return container;
+    }
+    return nullptr;
+}
+
+// Returns whether the contents of node, a page of a QTabWidget,
+// QStackedWidget or QToolBox, are created when it first becomes current:
+// the page is not current initially and nothing on it is used from outside.
+bool WriteInitialization::isDeferredPage(const DomWidget *node) const
+{
+    if (!m_option.lazyPages || language::language() != Language::Cpp)
+        return false;
+    const DomWidget *container = m_widgetChain.top();
+    if (!container || !pageContainerClass(m_uic->customWidgetsInfo(), container->attributeClass()))
+        return false;
+
+    int currentIndex = 0;
+    if (const DomProperty *p = propertyMap(container->elementProperty()).value("currentIndex"_L1))
+        currentIndex = p->elementNumber();
+    if (container->elementWidget().indexOf(const_cast<DomWidget *>(node)) == currentIndex)
+        return false;
+
+    PageContents contents;
+    collectPageContents(m_driver, node, &contents);
+    if (!contents.canDefer || contents.variables.isEmpty())
+        return false;
+    for (const QString &name : std::as_const(contents.names)) {
+        if (m_referencedNames.contains(name))
+            return false;
+        for (auto it = m_buddyLabels.constFind(name); it != m_buddyLabels.cend() && it.key() == name; ++it) {
+            if (!contents.names.contains(it.value()))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Creates the contents of a deferred page when it becomes current. The
+// connection is dropped when the form is destroyed, since the Ui object may
+// be gone while the pages are deleted.
+void WriteInitialization::writeDeferredPageConnection(const DomWidget *container,
+                                                      const QString &pageVarName)
+{
+    const QString containerVarName = m_driver->findOrInsertWidget(container);
+    const QString signal = "&"_L1
+            + QLatin1StringView(pageContainerClass(m_uic->customWidgetsInfo(),
+                                                   container->attributeClass()))
+            + "::currentChanged"_L1;
+    const QString formVarName = m_mainFormVarName;
+
+    m_deferredPageConnectionsOut << m_indent << "QObject::connect(" << containerVarName << ", "
+        << signal << ", " << pageVarName << ", [this, " << formVarName << "] {\n"
+        << m_dindent << "if (" << containerVarName << "->currentWidget() == " << pageVarName << ")\n"
+        << m_dindent << m_option.indent << "setupPage_" << pageVarName << '(' << formVarName
+        << ");\n"
+        << m_indent << "});\n"
+        << m_indent << "QObject::connect(" << formVarName << ", &QObject::destroyed, "
+        << pageVarName << ", [" << containerVarName << " = " << containerVarName << ", "
+        << pageVarName << " = " << pageVarName << "] {\n"
+        << m_dindent << "QObject::disconnect(" << containerVarName << ", " << signal << ", "
+        << pageVarName << ", nullptr);\n"
+        << m_indent << "});\n";
+}
+
 void WriteInitialization::acceptWidget(DomWidget *node)
 {
     m_layoutMarginType = m_widgetChain.size() == 1 ? TopLevelMargin : ChildMargin;
@@ -671,6 +876,16 @@ void WriteInitialization::acceptWidget(DomWidget *node)
             m_layoutWidget = true;
         }
     }
+    const bool deferred = isDeferredPage(node);
+    FunctionState outerFunction;
+    PageContents pageContents;
+    if (deferred) {
+        collectPageContents(m_driver, node, &pageContents);
+        for (const QString &variable : std::as_const(pageContents.variables))
+            m_output << m_indent << variable << " = nullptr" << language::eol;
+        swapFunctionState(outerFunction);
+    }
+
     m_widgetChain.push(node);
     m_layoutChain.push(nullptr);
     TreeWalker::acceptWidget(node);
@@ -678,6 +893,44 @@ void WriteInitialization::acceptWidget(DomWidget *node)
     m_widgetChain.pop();
     m_layoutWidget = false;
 
+    if (deferred) {
+        writeZOrder(node);
+        writeBuddies();
+        if (!m_delayedActionInitialization.isEmpty())
+            m_output << "\n" << m_delayedActionInitialization;
+        m_output << "\n" << m_indent << "retranslatePage_" << varName << "()" << language::eol;
+        if (!m_delayedInitialization.isEmpty())
+            m_output << "\n" << m_delayedInitialization << "\n";
+        if (!m_deferredPageConnections.isEmpty())
+            m_output << "\n" << m_deferredPageConnections;
+
+        // The first variable is only set once the page was set up
+        const QString &sentinel = pageContents.variables.constFirst();
+        const QByteArray setupFunction = "setupPage_" + varName.toLatin1();
+        const QByteArray retranslateFunction = "retranslatePage_" + varName.toLatin1();
+        QTextStream str(&m_deferredPageFunctions);
+        str << m_option.indent
+            << language::startFunctionDefinition1(setupFunction.constData(),
+                                                  m_mainFormParameterType, m_mainFormVarName,
+                                                  m_option.indent)
+            << m_indent << "if (" << sentinel << ")\n"
+            << m_dindent << "return" << language::eol;
+        if (m_deferredPageConnections.isEmpty())
+            str << m_indent << "(void)" << m_mainFormVarName << language::eol;
+        str << '\n' << m_setupUiCode
+            << m_option.indent << language::endFunctionDefinition(setupFunction.constData())
+            << m_option.indent << "void " << retranslateFunction << "()\n"
+            << m_option.indent << "{\n"
+            << m_indent << "if (!" << sentinel << ")\n"
+            << m_dindent << "return" << language::eol
+            << m_refreshInitialization
+            << m_option.indent << language::endFunctionDefinition(retranslateFunction.constData());
+
+        swapFunctionState(outerFunction);
+        m_refreshOut << m_indent << "retranslatePage_" << varName << "()" << language::eol;
+        writeDeferredPageConnection(m_widgetChain.top(), varName);
+    }
+
     const DomPropertyMap attributes = propertyMap(node->elementAttribute());
 
     const QString pageDefaultString = u"Page"_s;
@@ -838,18 +1091,8 @@ void WriteInitialization::acceptWidget(DomWidget *node)
     if (node->elementLayout().isEmpty())
         m_layoutChain.pop();
 
-    const QStringList zOrder = node->elementZOrder();
-    for (const QString &name : zOrder) {
-        const QString varName = m_driver->widgetVariableName(name);
-        if (varName.isEmpty()) {
-            fprintf(stderr, "%s: Warning: Z-order assignment: '%s' is not a valid widget.\n",
-                    qPrintable(m_option.messagePrefix()),
-                    name.toLatin1().data());
-        } else {
-            m_output << m_indent << varName << language::derefPointer
-                << (language::language() != Language::Python ? "raise()" : "raise_()") << language::eol;
-        }
-    }
+    if (!deferred)
+        writeZOrder(node);
 }
 
 void WriteInitialization::addButtonGroup(const DomWidget *buttonNode, const QString &varName)
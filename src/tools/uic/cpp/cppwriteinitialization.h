@@ -216,13 +216,21 @@ private:
     QString writeBrushInitialization(const DomBrush *brush);
     void addButtonGroup(const DomWidget *node, const QString &varName);
     void addWizardPage(const QString &pageVarName, const DomWidget *page, const QString &parentWidget);
+    void writeBuddies();
+    void writeZOrder(const DomWidget *node);
+    bool isDeferredPage(const DomWidget *node) const;
+    void writeDeferredPageConnection(const DomWidget *container, const QString &pageVarName);
     bool isCustomWidget(const QString &className) const;
     ConnectionSyntax connectionSyntax(const language::SignalSlot &sender,
                                       const language::SignalSlot &receiver) const;
 
     const Uic *m_uic;
     Driver *m_driver;
-    QTextStream &m_output;
+    QTextStream &m_driverOutput;
+    // setupUi() is collected here first, since parts of it may go into the
+    // functions of deferred pages
+    QString m_setupUiCode;
+    QTextStream m_output;
     const Option &m_option;
     QString m_indent;
     QString m_dindent;
@@ -252,6 +260,31 @@ private:
     IconPropertiesNameMap m_iconPropertiesNameMap;
     SizePolicyNameMap     m_sizePolicyNameMap;
 
+    // With --lazy-pages, the contents of the pages of QTabWidget,
+    // QStackedWidget and QToolBox that are not current are created in a
+    // function of their own when the page first becomes current. What is
+    // written for setupUi() or such a function is swapped out while another
+    // one is written.
+    struct FunctionState
+    {
+        QString setupCode;
+        QString delayedInitialization;
+        QString refreshInitialization;
+        QString delayedActionInitialization;
+        QString deferredPageConnections;
+        QList<Buddy> buddies;
+        ColorBrushHash colorBrushHash;
+        FontPropertiesNameMap fontPropertiesNameMap;
+        IconPropertiesNameMap iconPropertiesNameMap;
+        SizePolicyNameMap sizePolicyNameMap;
+        bool firstThemeIcon = true;
+    };
+    void swapFunctionState(FunctionState &state);
+
+    QSet<QString> m_referencedNames; // by tab stops and connections
+    QMultiHash<QString, QString> m_buddyLabels; // buddy name -> label names
+    QString m_deferredPageFunctions;
+
     class LayoutDefaultHandler {
     public:
         LayoutDefaultHandler();
@@ -280,6 +313,7 @@ private:
 
     QString m_generatedClass;
     QString m_mainFormVarName;
+    QString m_mainFormParameterType;
     QStringList m_customSlots;
     QStringList m_customSignals;
     bool m_mainFormUsedInRetranslateUi = false;
@@ -293,6 +327,9 @@ private:
     QString m_delayedActionInitialization;
     QTextStream m_actionOut;
 
+    QString m_deferredPageConnections;
+    QTextStream m_deferredPageConnectionsOut;
+
     bool m_layoutWidget = false;
     bool m_firstThemeIcon = true;
     bool m_connectSlotsByName = true;
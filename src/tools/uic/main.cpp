@@ -122,6 +122,10 @@ int runUic(int argc, char *argv[])
     idBasedOption.setDescription(u"Use id based function for i18n"_s);
     parser.addOption(idBasedOption);
 
+    QCommandLineOption lazyPagesOption(u"lazy-pages"_s);
+    lazyPagesOption.setDescription(u"C++: Create the contents of the pages of QTabWidget, QStackedWidget and QToolBox that are not current when they first become current. Until then, their widgets are nullptr; call setupPage_<page>(form) to create them earlier."_s);
+    parser.addOption(lazyPagesOption);
+
     QCommandLineOption fromImportsOption(u"from-imports"_s);
     fromImportsOption.setDescription(u"Python: generate imports relative to '.'"_s);
     parser.addOption(fromImportsOption);
@@ -156,6 +160,7 @@ int runUic(int argc, char *argv[])
     driver.option().implicitIncludes = !parser.isSet(noImplicitIncludesOption);
     driver.option().qtNamespace = !parser.isSet(noQtNamespaceOption);
     driver.option().idBased = parser.isSet(idBasedOption);
+    driver.option().lazyPages = parser.isSet(lazyPagesOption);
     driver.option().postfix = parser.value(postfixOption);
     driver.option().translateFunction = parser.value(translateOption);
     driver.option().includeFile = parser.value(includeOption);
@@ -31,6 +31,7 @@ struct Option
     unsigned int useStarImports: 1;
     unsigned int rcPrefix: 1; // Python: Generate "rc_file" instead of "file_rc" import
     unsigned int qtNamespace: 1;
+    unsigned int lazyPages: 1; // C++: create non-current pages of containers on demand
 
     QString inputFile;
     QString outputFile;
@@ -59,6 +60,7 @@ struct Option
           useStarImports(0),
           rcPrefix(0),
           qtNamespace(1),
+          lazyPages(0),
           prefix(QLatin1StringView("Ui_"))
     { indent.fill(u' ', 4); }
 
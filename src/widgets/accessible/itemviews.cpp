@@ -20,6 +20,9 @@
 
 QT_BEGIN_NAMESPACE
 
+// Beyond this many cached children, those that are out of view are released
+static constexpr qsizetype MaxCachedChildren = 2048;
+
 /*
 Implementation of the IAccessible2 table2 interface. Much simpler than
 the other table interfaces since there is only the main table and cells:
@@ -607,9 +610,65 @@ QAccessibleInterface *QAccessibleTable::child(int logicalIndex) const
 
     QAccessible::registerAccessibleInterface(iface);
     childToId.insert(logicalIndex, QAccessible::uniqueId(iface));
+
+    // Clients keep the interfaces they got while handling an event, so
+    // only release them once control returns to the event loop
+    if (childToId.size() > MaxCachedChildren && !m_trimPending) {
+        m_trimPending = true;
+        const QAccessible::Id tableId = QAccessible::uniqueId(const_cast<QAccessibleTable *>(this));
+        QMetaObject::invokeMethod(view(), [tableId] {
+            if (QAccessibleInterface *table = QAccessible::accessibleInterface(tableId))
+                static_cast<QAccessibleTable *>(table)->trimChildCache();
+        }, Qt::QueuedConnection);
+    }
     return iface;
 }
 
+/*!
+    \internal
+    Releases the interfaces of the cells, and of the row headers, that are
+    out of view, except for the current cell. A screen reader walking
+    through a large view would otherwise leave an interface behind for
+    each of its cells; they are made again when asked for.
+*/
+void QAccessibleTable::trimChildCache()
+{
+    m_trimPending = false;
+    if (childToId.size() <= MaxCachedChildren || !view()->model())
+        return;
+
+    const QRect viewport = view()->viewport()->rect();
+    const QModelIndex current = view()->currentIndex();
+    const QModelIndex root = view()->rootIndex();
+    auto isVisible = [&](const QModelIndex &index) {
+        return index == current || view()->visualRect(index).intersects(viewport);
+    };
+    auto isRowVisible = [&](int row) {
+        const QRect rect = view()->visualRect(view()->model()->index(row, 0, root));
+        return rect.bottom() >= viewport.top() && rect.top() <= viewport.bottom();
+    };
+
+    for (auto it = childToId.begin(); it != childToId.end(); ) {
+        QAccessibleInterface *iface = QAccessible::accessibleInterface(it.value());
+        bool keep = true;
+        if (!iface) {
+            keep = false;
+        } else if (iface->role() == QAccessible::Cell || iface->role() == QAccessible::ListItem) {
+            keep = isVisible(static_cast<QAccessibleTableCell *>(iface)->m_index);
+        } else if (iface->role() == QAccessible::RowHeader) {
+            keep = isRowVisible(static_cast<QAccessibleTableHeaderCell *>(iface)->index);
+        }
+
+        if (keep) {
+            ++it;
+        } else {
+            if (iface)
+                QAccessible::deleteAccessibleInterface(it.value());
+            it = childToId.erase(it);
+        }
+    }
+}
+
 void *QAccessibleTable::interface_cast(QAccessible::InterfaceType t)
 {
     if (t == QAccessible::SelectionInterface)
@@ -115,7 +115,9 @@ protected:
 private:
     // the child index for a model index
     inline int logicalIndex(const QModelIndex &index) const;
+    void trimChildCache();
     QAccessible::Role m_role;
+    mutable bool m_trimPending = false;
 };
 
 #if QT_CONFIG(treeview)
@@ -461,6 +461,16 @@
     ItemClipsChildrenToShape.
 
     This flag was introduced in Qt 5.4.
+
+    \value ItemPaintsInAnyThread The item's paint() implementation is safe to
+    call in a thread other than the GUI thread, at the same time as that of
+    other items with this flag. When the item uses DeviceCoordinateCache
+    and is shown in a QGraphicsView with the
+    QGraphicsView::ParallelItemCaching optimization flag set, its cache is
+    rendered on a worker thread whenever it has to be redrawn completely,
+    for instance after the view was zoomed. paint() must then only read
+    state that is not changed while the view paints, and must not use the
+    widget argument, which is \nullptr. This flag was introduced in Qt 6.7.
 */
 
 /*!
@@ -11378,6 +11388,9 @@ QDebug operator<<(QDebug debug, QGraphicsItem::GraphicsItemFlag flag)
     case QGraphicsItem::ItemContainsChildrenInShape:
         str = "ItemContainsChildrenInShape";
         break;
+    case QGraphicsItem::ItemPaintsInAnyThread:
+        str = "ItemPaintsInAnyThread";
+        break;
     }
     debug << str;
     return debug;
@@ -66,7 +66,8 @@ public:
         ItemSendsScenePositionChanges = 0x10000,
         ItemStopsClickFocusPropagation = 0x20000,
         ItemStopsFocusHandling = 0x40000,
-        ItemContainsChildrenInShape = 0x80000
+        ItemContainsChildrenInShape = 0x80000,
+        ItemPaintsInAnyThread = 0x100000
         // NB! Don't forget to increase the d_ptr->flags bit field by 1 when adding a new flag.
     };
     Q_DECLARE_FLAGS(GraphicsItemFlags, GraphicsItemFlag)
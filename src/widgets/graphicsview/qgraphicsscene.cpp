@@ -184,8 +184,10 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qmath.h>
 #include <QtCore/qrect.h>
+#include <QtCore/qsemaphore.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/QMetaMethod>
@@ -210,6 +212,7 @@
 #include <private/qevent_p.h>
 #include <QtGui/private/qeventpoint_p.h>
 #include <private/qobject_p.h>
+#include <private/qthreadpool_p.h>
 #if QT_CONFIG(graphicseffect)
 #include <private/qgraphicseffect_p.h>
 #endif
@@ -4572,10 +4575,19 @@ void QGraphicsScenePrivate::drawItemHelper(QGraphicsItem *item, QPainter *painte
             styleOptionTmp = *option;
             styleOptionTmp.exposedRect = br.adjusted(-1, -1, 1, 1);
 
-            // Render the exposed areas.
+            // Render the exposed areas, unless prerenderItemCaches() already
+            // rendered the whole pixmap.
             pix.setDevicePixelRatio(devicePixelRatio);
-            _q_paintIntoCache(&pix, item, pixmapExposed, itemToPixmap, painter->renderHints(),
-                              &styleOptionTmp, painterStateProtection);
+            const auto prerendered = prerenderedCaches.constFind(item);
+            if (itemCache->allExposed && scrollExposure.isEmpty()
+                && prerendered != prerenderedCaches.cend()
+                && prerendered->itemToPixmap == itemToPixmap
+                && prerendered->image.size() == pix.size()) {
+                pix = QPixmap::fromImage(prerendered->image);
+            } else {
+                _q_paintIntoCache(&pix, item, pixmapExposed, itemToPixmap, painter->renderHints(),
+                                  &styleOptionTmp, painterStateProtection);
+            }
 
             // Reset expose data.
             pixModified = true;
@@ -4604,6 +4616,134 @@ void QGraphicsScenePrivate::drawItemHelper(QGraphicsItem *item, QPainter *painte
     }
 }
 
+/*!
+    \internal
+
+    Renders the device coordinate caches of those \a items that have the
+    ItemPaintsInAnyThread flag and that drawItemHelper() would have to redraw
+    completely when painting into \a widget with \a viewTransform. The
+    caches are rendered into images in parallel on the GUI thread pool and
+    stored in prerenderedCaches, where drawItemHelper() picks them up. The
+    caller clears prerenderedCaches after drawing.
+*/
+void QGraphicsScenePrivate::prerenderItemCaches(const QList<QGraphicsItem *> &items,
+                                                const QTransform &viewTransform, QWidget *widget,
+                                                QPainter::RenderHints renderHints)
+{
+    struct Job
+    {
+        QGraphicsItem *item;
+        QTransform itemToPixmap;
+        QStyleOptionGraphicsItem option;
+        QImage image;
+    };
+    QList<Job> jobs;
+
+    const qreal devicePixelRatio = widget->devicePixelRatio();
+    const QRect viewRect = widget->rect();
+    for (QGraphicsItem *item : items) {
+        QGraphicsItemPrivate *itemd = item->d_ptr.data();
+        if (!(itemd->flags & QGraphicsItem::ItemPaintsInAnyThread)
+            || (itemd->flags & QGraphicsItem::ItemHasNoContents)
+            || itemd->cacheMode != QGraphicsItem::DeviceCoordinateCache
+            || !item->isVisible()) {
+            continue;
+        }
+#if QT_CONFIG(graphicseffect)
+        if (itemd->graphicsEffect && itemd->graphicsEffect->isEnabled())
+            continue;
+#endif
+
+        // Mirror the decisions drawItemHelper() makes, and only render caches
+        // that it would redraw completely.
+        const QRectF brect = item->boundingRect();
+        QRectF adjustedBrect(brect);
+        _q_adjustRect(&adjustedBrect);
+        if (adjustedBrect.isEmpty())
+            continue;
+        const QTransform worldTransform = itemd->itemIsUntransformable()
+                ? item->deviceTransform(viewTransform)
+                : item->sceneTransform() * viewTransform;
+        const QRect deviceRect = worldTransform.mapRect(brect).toRect().adjusted(-1, -1, 1, 1);
+        if (deviceRect.isEmpty() || !viewRect.contains(deviceRect))
+            continue;
+        const QSize maximumCacheSize =
+            itemd->extra(QGraphicsItemPrivate::ExtraMaxDeviceCoordCacheSize).toSize();
+        if (!maximumCacheSize.isEmpty()
+            && (deviceRect.width() > maximumCacheSize.width()
+                || deviceRect.height() > maximumCacheSize.height())) {
+            continue;
+        }
+
+        QGraphicsItemCache *itemCache = itemd->extraItemCache();
+        const QGraphicsItemCache::DeviceData deviceData = itemCache->deviceData.value(widget);
+        bool invertable = true;
+        QTransform diff = deviceData.lastTransform.inverted(&invertable);
+        if (invertable)
+            diff *= worldTransform;
+        if (invertable && diff.type() <= QTransform::TxTranslate && transformIsSimple(worldTransform)) {
+            if (!deviceData.cacheIndent.isNull())
+                continue;
+            QPixmap pix;
+            if (!itemCache->allExposed && QPixmapCache::find(deviceData.key, &pix)
+                && deviceRect.size() == pix.size() / devicePixelRatio) {
+                continue;
+            }
+        }
+
+        Job job{ item, worldTransform, {}, QImage(deviceRect.size() * devicePixelRatio,
+                                                  QImage::Format_ARGB32_Premultiplied) };
+        if (job.image.isNull())
+            continue;
+        job.image.setDevicePixelRatio(devicePixelRatio);
+        const QPointF p = deviceRect.topLeft();
+        if (!p.isNull())
+            job.itemToPixmap *= QTransform::fromTranslate(-p.x(), -p.y());
+        itemd->initStyleOption(&job.option, worldTransform, QRegion(), true);
+        job.option.exposedRect = brect.adjusted(-1, -1, 1, 1);
+        jobs.append(std::move(job));
+    }
+    if (jobs.isEmpty())
+        return;
+
+    const bool stateProtection = painterStateProtection;
+    const auto renderSection = [&jobs, renderHints, stateProtection](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i) {
+            Job &job = jobs[i];
+            job.image.fill(Qt::transparent);
+            QPainter imagePainter(&job.image);
+            imagePainter.setRenderHints(imagePainter.renderHints(), false);
+            imagePainter.setRenderHints(renderHints, true);
+            imagePainter.setWorldTransform(job.itemToPixmap, true);
+            _q_paintItem(job.item, &imagePainter, &job.option, nullptr, false, stateProtection);
+        }
+    };
+
+#if QT_CONFIG(thread)
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    const qsizetype segments = threadPool ? qMin(jobs.size(), qsizetype(threadPool->maxThreadCount())) : 0;
+    if (segments > 0) {
+        QSemaphore semaphore;
+        qsizetype begin = 0;
+        for (qsizetype i = 0; i < segments; ++i) {
+            const qsizetype end = begin + (jobs.size() - begin) / (segments - i);
+            threadPool->start([&, begin, end]() {
+                renderSection(begin, end);
+                semaphore.release(1);
+            });
+            begin = end;
+        }
+        semaphore.acquire(int(segments));
+    } else
+#endif
+    {
+        renderSection(0, jobs.size());
+    }
+
+    for (Job &job : jobs)
+        prerenderedCaches.insert(job.item, { std::move(job.image), job.itemToPixmap });
+}
+
 void QGraphicsScenePrivate::drawItems(QPainter *painter, const QTransform *const viewTransform,
                                       QRegion *exposedRegion, QWidget *widget)
 {
@@ -3,8 +3,14 @@
 
 #include "qgraphicsscene_bsp_p.h"
 
+#include <QtCore/qsemaphore.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
 #include <private/qgraphicsitem_p.h>
+#include <private/qthreadpool_p.h>
+
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -44,6 +50,79 @@ void QGraphicsSceneBspTree::insertItem(QGraphicsItem *item, const QRectF &rect)
     }, rect);
 }
 
+/*
+    Inserts \a items, whose scene rectangles are \a rects, as if insertItem()
+    had been called for each of them in order, but grows each leaf only
+    once. Finding the leaves an item falls into only reads the tree, so for
+    large batches that is split over the threads of the GUI thread pool.
+*/
+void QGraphicsSceneBspTree::insertItems(const QList<QGraphicsItem *> &items, const QList<QRectF> &rects)
+{
+    Q_ASSERT(items.size() == rects.size());
+    if (items.isEmpty() || nodes.isEmpty())
+        return;
+
+    // (leaf index, item index) pairs, one list per segment of the batch
+    using Placements = QList<std::pair<int, qsizetype>>;
+    const auto placeSection = [&](qsizetype begin, qsizetype end, Placements *placements) {
+        placements->reserve(end - begin);
+        for (qsizetype i = begin; i < end; ++i) {
+            climbTree([this, i, placements](QList<QGraphicsItem *> *leaf) {
+                placements->append({ int(leaf - leaves.constData()), i });
+            }, rects.at(i));
+        }
+    };
+
+    static constexpr qsizetype MinimumSegmentSize = 8192;
+    qsizetype segments = 1;
+#if QT_CONFIG(thread)
+    QThreadPool *threadPool = QThreadPoolPrivate::qtGuiInstance();
+    if (threadPool && !threadPool->contains(QThread::currentThread()))
+        segments = qBound(qsizetype(1), items.size() / MinimumSegmentSize, qsizetype(16));
+#endif
+    QVarLengthArray<Placements, 16> placements(segments);
+    if (segments == 1) {
+        placeSection(0, items.size(), &placements[0]);
+    } else {
+#if QT_CONFIG(thread)
+        QSemaphore semaphore;
+        qsizetype begin = 0;
+        for (qsizetype i = 0; i < segments; ++i) {
+            const qsizetype end = begin + (items.size() - begin) / (segments - i);
+            threadPool->start([&, begin, end, i]() {
+                placeSection(begin, end, &placements[i]);
+                semaphore.release(1);
+            });
+            begin = end;
+        }
+        semaphore.acquire(int(segments));
+#endif
+    }
+
+    QVarLengthArray<qsizetype, 256> added(leaves.size(), 0);
+    for (const Placements &section : std::as_const(placements)) {
+        for (const auto &placement : section)
+            ++added[placement.first];
+    }
+
+    // insertItem() prepends, so the last item of the batch comes first.
+    QList<QList<QGraphicsItem *>> newLeaves(leaves.size());
+    for (qsizetype i = 0; i < leaves.size(); ++i) {
+        if (added[i])
+            newLeaves[i].reserve(added[i] + leaves.at(i).size());
+    }
+    for (auto section = placements.crbegin(); section != placements.crend(); ++section) {
+        for (auto placement = section->crbegin(); placement != section->crend(); ++placement)
+            newLeaves[placement->first].append(items.at(placement->second));
+    }
+    for (qsizetype i = 0; i < leaves.size(); ++i) {
+        if (added[i]) {
+            newLeaves[i].append(leaves.at(i));
+            leaves[i].swap(newLeaves[i]);
+        }
+    }
+}
+
 void QGraphicsSceneBspTree::removeItem(QGraphicsItem *item, const QRectF &rect)
 {
     climbTree([item](QList<QGraphicsItem *> *items){
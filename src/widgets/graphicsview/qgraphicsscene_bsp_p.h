@@ -46,6 +46,7 @@ public:
     void clear();
 
     void insertItem(QGraphicsItem *item, const QRectF &rect);
+    void insertItems(const QList<QGraphicsItem *> &items, const QList<QRectF> &rects);
     void removeItem(QGraphicsItem *item, const QRectF &rect);
     void removeItems(const QSet<QGraphicsItem *> &items);
 
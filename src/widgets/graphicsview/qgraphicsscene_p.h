@@ -29,6 +29,8 @@
 #include <QtCore/qmap.h>
 #include <QtCore/qset.h>
 #include <QtGui/qfont.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qpainter.h>
 #include <QtGui/qpalette.h>
 #include <QtWidgets/qstyle.h>
 #include <QtWidgets/qstyleoption.h>
@@ -203,6 +205,17 @@ public:
     void drawItems(QPainter *painter, const QTransform *const viewTransform,
                    QRegion *exposedRegion, QWidget *widget);
 
+    // Device coordinate caches rendered by prerenderItemCaches(), picked up
+    // by drawItemHelper() when the transform matches.
+    struct PrerenderedCache
+    {
+        QImage image;
+        QTransform itemToPixmap;
+    };
+    QHash<QGraphicsItem *, PrerenderedCache> prerenderedCaches;
+    void prerenderItemCaches(const QList<QGraphicsItem *> &items, const QTransform &viewTransform,
+                             QWidget *widget, QPainter::RenderHints renderHints);
+
     void drawSubtreeRecursive(QGraphicsItem *item, QPainter *painter, const QTransform *const,
                               QRegion *exposedRegion, QWidget *widget, qreal parentOpacity = qreal(1.0),
                               const QTransform *const effectTransform = nullptr);
@@ -124,7 +124,12 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
         lastItemCount = indexedItems.size();
     }
 
-    // Insert all unindexed items into the tree.
+    // Insert all unindexed items into the tree. The bounding rects have to be
+    // computed here, but placing the items in the leaves is done in one batch.
+    QList<QGraphicsItem *> batch;
+    QList<QRectF> batchRects;
+    batch.reserve(unindexedItems.size());
+    batchRects.reserve(unindexedItems.size());
     for (int i = 0; i < unindexedItems.size(); ++i) {
         if (QGraphicsItem *item = unindexedItems.at(i)) {
             if (item->d_ptr->itemIsUntransformable()) {
@@ -135,9 +140,11 @@ void QGraphicsSceneBspTreeIndexPrivate::_q_updateIndex()
                 || item->d_ptr->ancestorFlags & QGraphicsItemPrivate::AncestorContainsChildren)
                 continue;
 
-            bsp.insertItem(item, item->d_ptr->sceneEffectiveBoundingRect());
+            batch << item;
+            batchRects << item->d_ptr->sceneEffectiveBoundingRect();
         }
     }
+    bsp.insertItems(batch, batchRects);
     unindexedItems.clear();
 }
 
@@ -193,6 +193,12 @@ static const int QGRAPHICSVIEW_PREALLOC_STYLE_OPTIONS = 503; // largest prime <
     \value IndirectPainting Since Qt 4.6, restore the old painting algorithm
     that calls QGraphicsView::drawItems() and QGraphicsScene::drawItems().
     To be used only for compatibility with old code.
+
+    \value ParallelItemCaching Since Qt 6.7, the device coordinate caches of
+    exposed items that set QGraphicsItem::ItemPaintsInAnyThread are rendered
+    in parallel on worker threads, before the items are drawn, whenever they
+    have to be redrawn completely. This keeps zooming scenes with many cached
+    items smooth. It has no effect together with IndirectPainting.
 */
 
 /*!
@@ -3491,8 +3497,17 @@ void QGraphicsView::paintEvent(QPaintEvent *event)
                 d->scene->d_func()->rectAdjust = 1;
             else
                 d->scene->d_func()->rectAdjust = 2;
+            if (d->optimizationFlags & ParallelItemCaching) {
+                if (!d->scene->d_func()->unpolishedItems.isEmpty())
+                    d->scene->d_func()->_q_polishItems();
+                bool allItems = false;
+                const QList<QGraphicsItem *> itemList = d->findItems(d->exposedRegion, &allItems, viewTransform);
+                d->scene->d_func()->prerenderItemCaches(itemList, viewTransform, viewport(),
+                                                        painter.renderHints());
+            }
             d->scene->d_func()->drawItems(&painter, viewTransformed ? &viewTransform : nullptr,
                                           &d->exposedRegion, viewport());
+            d->scene->d_func()->prerenderedCaches.clear();
             d->scene->d_func()->rectAdjust = oldRectAdjust;
             // Make sure the painter's world transform is restored correctly when
             // drawing without painter state protection (DontSavePainterState).
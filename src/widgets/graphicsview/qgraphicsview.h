@@ -77,7 +77,8 @@ public:
     enum OptimizationFlag {
         DontSavePainterState = 0x1,
         DontAdjustForAntialiasing = 0x2,
-        IndirectPainting = 0x4
+        IndirectPainting = 0x4,
+        ParallelItemCaching = 0x8
     };
     Q_DECLARE_FLAGS(OptimizationFlags, OptimizationFlag)
 
@@ -687,6 +687,8 @@ void QAbstractItemView::setModel(QAbstractItemModel *model)
         disconnect(d->model, SIGNAL(modelReset()), this, SLOT(reset()));
         disconnect(d->model, SIGNAL(layoutChanged()), this, SLOT(_q_layoutChanged()));
     }
+    d->dirtyRootCells = QRegion();
+    d->dirtyChildCells.clear();
     d->model = (model ? model : QAbstractItemModelPrivate::staticEmptyModel());
 
     if (d->model != QAbstractItemModelPrivate::staticEmptyModel()) {
@@ -1126,6 +1128,7 @@ void QAbstractItemView::reset()
     d->editorIndexHash.clear();
     d->indexEditorHash.clear();
     d->persistent.clear();
+    d->discardDirtyCells();
     d->currentIndexSet = false;
     setState(NoState);
     setRootIndex(QModelIndex());
@@ -3371,6 +3374,10 @@ void QAbstractItemView::update(const QModelIndex &index)
     The \a roles which have been changed can either be an empty container (meaning everything
     has changed), or a non-empty container with the subset of roles which have changed.
 
+    The changed items are repainted once control returns to the event loop,
+    so that models changing many items in a row only cause one update of
+    the viewport.
+
     \note: Qt::ToolTipRole is not honored by dataChanged() in the views provided by Qt.
 */
 void QAbstractItemView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
@@ -3390,7 +3397,7 @@ void QAbstractItemView::dataChanged(const QModelIndex &topLeft, const QModelInde
         }
         if (isVisible() && !d->delayedPendingLayout) {
             // otherwise the items will be update later anyway
-            update(topLeft);
+            d->addDirtyCells(topLeft, topLeft);
         }
     } else {
         d->updateEditorData(topLeft, bottomRight);
@@ -3402,9 +3409,7 @@ void QAbstractItemView::dataChanged(const QModelIndex &topLeft, const QModelInde
                 // invalid parameter - call update() to redraw all
                 d->viewport->update();
             } else {
-                const QRect updateRect = d->intersectedRect(d->viewport->rect(), topLeft, bottomRight);
-                if (!updateRect.isEmpty())
-                    d->viewport->update(updateRect);
+                d->addDirtyCells(topLeft, bottomRight);
             }
         }
     }
@@ -3533,6 +3538,7 @@ void QAbstractItemViewPrivate::_q_rowsRemoved(const QModelIndex &index, int star
     Q_UNUSED(start);
     Q_UNUSED(end);
 
+    discardDirtyCells();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3624,6 +3630,7 @@ void QAbstractItemViewPrivate::_q_columnsRemoved(const QModelIndex &index, int s
     Q_UNUSED(start);
     Q_UNUSED(end);
 
+    discardDirtyCells();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3651,6 +3658,7 @@ void QAbstractItemViewPrivate::_q_rowsInserted(const QModelIndex &index, int sta
     Q_UNUSED(start);
     Q_UNUSED(end);
 
+    discardDirtyCells();
 #if QT_CONFIG(accessibility)
     Q_Q(QAbstractItemView);
     if (QAccessible::isActive()) {
@@ -3674,6 +3682,7 @@ void QAbstractItemViewPrivate::_q_columnsInserted(const QModelIndex &index, int
     Q_UNUSED(start);
     Q_UNUSED(end);
 
+    discardDirtyCells();
     Q_Q(QAbstractItemView);
     if (q->isVisible())
         q->updateEditorGeometries();
@@ -3693,6 +3702,8 @@ void QAbstractItemViewPrivate::_q_columnsInserted(const QModelIndex &index, int
 */
 void QAbstractItemViewPrivate::_q_modelDestroyed()
 {
+    dirtyRootCells = QRegion();
+    dirtyChildCells.clear();
     model = QAbstractItemModelPrivate::staticEmptyModel();
     doDelayedReset();
 }
@@ -3704,6 +3715,7 @@ void QAbstractItemViewPrivate::_q_modelDestroyed()
 */
 void QAbstractItemViewPrivate::_q_layoutChanged()
 {
+    discardDirtyCells();
     doDelayedItemsLayout();
 #if QT_CONFIG(accessibility)
     Q_Q(QAbstractItemView);
@@ -3724,6 +3736,86 @@ void QAbstractItemViewPrivate::_q_columnsMoved(const QModelIndex &, int, int, co
   _q_layoutChanged();
 }
 
+/*!
+    \internal
+
+    Records that the items from \a topLeft to \a bottomRight changed. The
+    changes are coalesced until updateDirtyRegion() is called, so that the
+    geometry of the changed items is only computed once per event loop pass,
+    however many times they changed.
+*/
+void QAbstractItemViewPrivate::addDirtyCells(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    // Beyond that many rectangles, adding a cell costs more than updating
+    // a few cells too many
+    constexpr int MaxDirtyRects = 256;
+
+    const QRect cells(QPoint(topLeft.column(), topLeft.row()),
+                      QPoint(bottomRight.column(), bottomRight.row()));
+    const QModelIndex parent = topLeft.parent();
+    QRegion &region = parent.isValid() ? dirtyChildCells[parent] : dirtyRootCells;
+    region += cells;
+    if (region.rectCount() > MaxDirtyRects)
+        region = region.boundingRect();
+    if (!updateTimer.isActive())
+        updateTimer.start(0, q_func());
+}
+
+/*!
+    \internal
+
+    Adds the visible parts of the cells recorded by addDirtyCells() to
+    updateRegion.
+*/
+void QAbstractItemViewPrivate::updateDirtyCells()
+{
+    if (dirtyRootCells.isEmpty() && dirtyChildCells.isEmpty())
+        return;
+
+    const QRect viewportRect = viewport->rect();
+    const auto addCells = [&](const QModelIndex &parent, const QRegion &cells) {
+        // the model may have changed since, see discardDirtyCells()
+        const int lastRow = model->rowCount(parent) - 1;
+        const int lastColumn = model->columnCount(parent) - 1;
+        for (const QRect &range : cells) {
+            if (updateRegion.contains(viewportRect))
+                return;
+            const int bottom = qMin(range.bottom(), lastRow);
+            const int right = qMin(range.right(), lastColumn);
+            if (range.top() > bottom || range.left() > right)
+                continue;
+            const QRect rect = intersectedRect(viewportRect,
+                                               model->index(range.top(), range.left(), parent),
+                                               model->index(bottom, right, parent));
+            if (!rect.isEmpty())
+                updateRegion += rect;
+        }
+    };
+
+    const QRegion rootCells = std::exchange(dirtyRootCells, QRegion());
+    const auto childCells = std::exchange(dirtyChildCells, {});
+    addCells(QModelIndex(), rootCells);
+    for (auto it = childCells.cbegin(), end = childCells.cend(); it != end; ++it) {
+        if (it.key().isValid())
+            addCells(it.key(), it.value());
+    }
+}
+
+/*!
+    \internal
+
+    Forgets the cells recorded by addDirtyCells() when rows or columns
+    moved, and updates the whole viewport instead.
+*/
+void QAbstractItemViewPrivate::discardDirtyCells()
+{
+    if (dirtyRootCells.isEmpty() && dirtyChildCells.isEmpty())
+        return;
+    dirtyRootCells = QRegion();
+    dirtyChildCells.clear();
+    viewport->update();
+}
+
 QRect QAbstractItemViewPrivate::intersectedRect(const QRect rect, const QModelIndex &topLeft, const QModelIndex &bottomRight) const
 {
     Q_Q(const QAbstractItemView);
@@ -4703,6 +4795,31 @@ QModelIndexList QAbstractItemViewPrivate::selectedDraggableIndexes() const
 }
 #endif
 
+#if QT_CONFIG(accessibility)
+/*!
+    \internal
+    Returns the first index of \a selection, as selection.indexes() would,
+    without listing all the others: selecting all of a large model would
+    otherwise make a list of all of its indexes for each selection event.
+*/
+QModelIndex QAbstractItemViewPrivate::firstSelectableIndex(const QItemSelection &selection)
+{
+    for (const QItemSelectionRange &range : selection) {
+        if (!range.isValid() || !range.model())
+            continue;
+        const QModelIndex topLeft = range.topLeft();
+        for (int row = topLeft.row(); row <= range.bottom(); ++row) {
+            for (int column = topLeft.column(); column <= range.right(); ++column) {
+                const QModelIndex index = topLeft.sibling(row, column);
+                if (range.model()->flags(index).testFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled))
+                    return index;
+            }
+        }
+    }
+    return QModelIndex();
+}
+#endif
+
 /*!
     \reimp
 */
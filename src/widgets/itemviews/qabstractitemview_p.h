@@ -77,7 +77,7 @@ public:
 
     void _q_headerDataChanged() { doDelayedItemsLayout(); }
     void _q_scrollerStateChanged();
-    void _q_delegateSizeHintChanged(const QModelIndex &index);
+    virtual void _q_delegateSizeHintChanged(const QModelIndex &index);
 
     void fetchMore();
 
@@ -218,10 +218,15 @@ public:
 
     void updateDirtyRegion() {
         updateTimer.stop();
+        updateDirtyCells();
         viewport->update(updateRegion);
         updateRegion = QRegion();
     }
 
+    void addDirtyCells(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void updateDirtyCells();
+    void discardDirtyCells();
+
     void clearOrRemove();
     void checkPersistentEditorFocus();
 
@@ -311,6 +316,10 @@ public:
     QModelIndexList selectedDraggableIndexes() const;
 #endif
 
+#if QT_CONFIG(accessibility)
+    static QModelIndex firstSelectableIndex(const QItemSelection &selection);
+#endif
+
     void doDelayedReset()
     {
         //we delay the reset of the timer because some views (QTableView)
@@ -390,6 +399,10 @@ public:
     Qt::TextElideMode textElideMode;
 
     QRegion updateRegion; // used for the internal update system
+    // The cells changed since the last update, as columns and rows of their
+    // parent; they are only turned into updateRegion once per event loop pass
+    QRegion dirtyRootCells;
+    QHash<QPersistentModelIndex, QRegion> dirtyChildCells;
     QPoint scrollDelayOffset;
 
     QBasicTimer updateTimer;
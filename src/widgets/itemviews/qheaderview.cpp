@@ -3474,16 +3474,14 @@ bool QHeaderViewPrivate::isSectionSelected(int section) const
 
 bool QHeaderViewPrivate::isFirstVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
+    updateSectionStartPos(section);
     const SectionItem &item = sectionItems.at(section);
     return item.size > 0 && item.calculated_startpos == 0;
 }
 
 bool QHeaderViewPrivate::isLastVisibleSection(int section) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
+    updateSectionStartPos();
     const SectionItem &item = sectionItems.at(section);
     return item.size > 0 && item.calculatedEndPos() == length;
 }
@@ -3689,7 +3687,9 @@ void QHeaderViewPrivate::createSectionItems(int start, int end, int sizePerSecti
     SectionItem *sectiondata = sectionItems.data();
     for (int i = start; i <= end; ++i) {
         length += (sizePerSection - sectiondata[i].size);
-        sectionStartposRecalc |= (sectiondata[i].size != sizePerSection);
+        // only the positions of the sections after this one change
+        if (sectiondata[i].size != sizePerSection && i < firstStaleSectionStartpos)
+            firstStaleSectionStartpos = i + 1;
         sectiondata[i].size = sizePerSection;
         sectiondata[i].resizeMode = mode;
     }
@@ -3914,14 +3914,39 @@ void QHeaderViewPrivate::updateDefaultSectionSizeFromStyle()
     }
 }
 
-void QHeaderViewPrivate::recalcSectionStartPos() const // linear (but fast)
+void QHeaderViewPrivate::recalcSectionStartPos(int from) const // linear (but fast)
 {
+    // The positions before from are known to be up to date, and so is
+    // whether those sections have a uniform size.
     int pixelpos = 0;
-    for (const SectionItem &i : sectionItems) {
+    int uniformSize = -1;
+    if (from > 0) {
+        pixelpos = sectionItems.at(from - 1).calculatedEndPos();
+        uniformSize = uniformSectionSize;
+    } else if (!sectionItems.isEmpty()) {
+        uniformSize = sectionItems.at(0).size;
+    }
+    for (int v = from; v < sectionItems.size(); ++v) {
+        const SectionItem &i = sectionItems.at(v);
         i.calculated_startpos = pixelpos; // write into const mutable
         pixelpos += i.size;
+        if (int(i.size) != uniformSize)
+            uniformSize = -1;
     }
+    uniformSectionSize = uniformSize;
     sectionStartposRecalc = false;
+    firstStaleSectionStartpos = INT_MAX;
+}
+
+// Brings the positions of the sections up to and including visual up to
+// date. Resizing a section only invalidates the positions after it, so
+// this often has nothing, or only the tail of the sections, to do.
+void QHeaderViewPrivate::updateSectionStartPos(int visual) const
+{
+    if (sectionStartposRecalc)
+        recalcSectionStartPos();
+    else if (firstStaleSectionStartpos <= visual && firstStaleSectionStartpos < sectionItems.size())
+        recalcSectionStartPos(firstStaleSectionStartpos);
 }
 
 void QHeaderViewPrivate::resizeSectionItem(int visualIndex, int oldSize, int newSize)
@@ -3942,8 +3967,7 @@ int QHeaderViewPrivate::headerSectionSize(int visual) const
 int QHeaderViewPrivate::headerSectionPosition(int visual) const
 {
     if (visual < sectionCount() && visual >= 0) {
-        if (sectionStartposRecalc)
-            recalcSectionStartPos();
+        updateSectionStartPos(visual);
         return sectionItems.at(visual).calculated_startpos;
     }
     return -1;
@@ -3951,10 +3975,24 @@ int QHeaderViewPrivate::headerSectionPosition(int visual) const
 
 int QHeaderViewPrivate::headerVisualIndexAt(int position) const
 {
-    if (sectionStartposRecalc)
-        recalcSectionStartPos();
     int startidx = 0;
     int endidx = sectionItems.size() - 1;
+    if (sectionStartposRecalc) {
+        recalcSectionStartPos();
+    } else if (firstStaleSectionStartpos <= endidx) {
+        // No need to update the positions when the section is found before them
+        const int staleStart = sectionItems.at(firstStaleSectionStartpos - 1).calculatedEndPos();
+        if (position < staleStart)
+            endidx = firstStaleSectionStartpos - 1;
+        else
+            recalcSectionStartPos(firstStaleSectionStartpos);
+    }
+    if (uniformSectionSize > 0 && !sectionStartposRecalc && firstStaleSectionStartpos > endidx) {
+        if (position < 0)
+            return -1;
+        const int visual = position / uniformSectionSize;
+        return visual <= endidx ? visual : -1;
+    }
     while (startidx <= endidx) {
         int middle = (endidx + startidx) / 2;
         if (sectionItems.at(middle).calculated_startpos > position) {
@@ -271,6 +271,12 @@ public:
 #endif
     QHeaderView::ResizeMode globalResizeMode;
     mutable bool sectionStartposRecalc;
+    // The sections from this one on need their positions updated, unless
+    // sectionStartposRecalc is set, in which case all of them do
+    mutable int firstStaleSectionStartpos = INT_MAX;
+    // The size of all sections when they have the same one (and their
+    // positions are up to date), otherwise -1
+    mutable int uniformSectionSize = -1;
     int resizeContentsPrecision;
     // header sections
 
@@ -311,7 +317,8 @@ public:
     void resizeSectionItem(int visualIndex, int oldSize, int newSize);
     void setDefaultSectionSize(int size);
     void updateDefaultSectionSizeFromStyle();
-    void recalcSectionStartPos() const; // not really const
+    void recalcSectionStartPos(int from = 0) const; // not really const
+    void updateSectionStartPos(int visual = INT_MAX) const;
 
     inline int headerLength() const { // for debugging
         int len = 0;
@@ -645,6 +645,7 @@ void QListView::reset()
     Q_D(QListView);
     d->clear();
     d->hiddenRows.clear();
+    d->layoutItemSizes.clear();
     QAbstractItemView::reset();
 }
 
@@ -659,6 +660,7 @@ void QListView::setRootIndex(const QModelIndex &index)
     // sometimes we get an update before reset() is called
     d->clear();
     d->hiddenRows.clear();
+    d->layoutItemSizes.clear();
 }
 
 /*!
@@ -701,7 +703,10 @@ QSize QListView::contentsSize() const
 void QListView::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
                             const QList<int> &roles)
 {
-    d_func()->commonListView->dataChanged(topLeft, bottomRight);
+    Q_D(QListView);
+    if (topLeft.parent() == d->root)
+        d->invalidateLayoutItemSizes(topLeft.row(), bottomRight.row());
+    d->commonListView->dataChanged(topLeft, bottomRight);
     QAbstractItemView::dataChanged(topLeft, bottomRight, roles);
 }
 
@@ -711,7 +716,9 @@ void QListView::dataChanged(const QModelIndex &topLeft, const QModelIndex &botto
 void QListView::rowsInserted(const QModelIndex &parent, int start, int end)
 {
     Q_D(QListView);
-    // ### be smarter about inserted items
+    // The items are laid out again, but only the new ones have to be measured
+    if (parent == d->root)
+        d->insertLayoutItemSizes(start, end);
     d->clear();
     d->doDelayedItemsLayout();
     QAbstractItemView::rowsInserted(parent, start, end);
@@ -1762,6 +1769,7 @@ QListViewPrivate::QListViewPrivate()
       column(0),
       uniformItemSizes(false),
       batchSize(100),
+      reuseLayoutItemSizes(false),
       showElasticBand(false),
       itemAlignment(Qt::Alignment())
 {
@@ -1784,6 +1792,25 @@ void QListViewPrivate::prepareItemsLayout()
     Q_Q(QListView);
     clear();
 
+    // Anything but inserted or removed rows may have changed the size hints
+    // of all items; so may anything that changes the style option.
+    QStyleOptionViewItem option;
+    q->initViewItemOption(&option);
+    if (!reuseLayoutItemSizes || !rowDelegates.isEmpty() || !columnDelegates.isEmpty()
+        || option.font != layoutItemSizesOption.font
+        || option.decorationSize != layoutItemSizesOption.decorationSize
+        || option.decorationPosition != layoutItemSizesOption.decorationPosition
+        || option.decorationAlignment != layoutItemSizesOption.decorationAlignment
+        || option.displayAlignment != layoutItemSizesOption.displayAlignment
+        || option.textElideMode != layoutItemSizesOption.textElideMode
+        || option.features != layoutItemSizesOption.features
+        || option.styleObject != layoutItemSizesOption.styleObject
+        || option.widget != layoutItemSizesOption.widget) {
+        layoutItemSizes.clear();
+    }
+    layoutItemSizesOption = option;
+    reuseLayoutItemSizes = false;
+
     //take the size as if there were scrollbar in order to prevent scrollbar to blink
     layoutBounds = QRect(QPoint(), q->maximumViewportSize());
 
@@ -1914,6 +1941,74 @@ QSize QListViewPrivate::itemSize(const QStyleOptionViewItem &option, const QMode
     return cachedItemSize;
 }
 
+/*!
+  \internal
+  Returns the size of the item in \a row for the layout, measuring it only
+  if it is not known from a previous layout.
+*/
+QSize QListViewPrivate::layoutItemSize(const QStyleOptionViewItem &option, int row) const
+{
+    if (uniformItemSizes)
+        return itemSize(option, modelIndex(row));
+    if (row < layoutItemSizes.size()) {
+        const QSize size = layoutItemSizes.at(row);
+        if (size.isValid())
+            return size;
+    } else {
+        layoutItemSizes.resize(row + 1);
+    }
+    const QSize size = itemSize(option, modelIndex(row));
+    layoutItemSizes[row] = size;
+    return size;
+}
+
+void QListViewPrivate::insertLayoutItemSizes(int first, int last)
+{
+    if (first < layoutItemSizes.size())
+        layoutItemSizes.insert(first, last - first + 1, QSize());
+    reuseLayoutItemSizes = true;
+}
+
+void QListViewPrivate::removeLayoutItemSizes(int first, int last)
+{
+    if (first < layoutItemSizes.size())
+        layoutItemSizes.remove(first, qMin(last, int(layoutItemSizes.size()) - 1) - first + 1);
+    reuseLayoutItemSizes = true;
+}
+
+void QListViewPrivate::invalidateLayoutItemSizes(int first, int last)
+{
+    for (int row = first; row <= last && row < layoutItemSizes.size(); ++row)
+        layoutItemSizes[row] = QSize();
+}
+
+void QListViewPrivate::_q_rowsRemoved(const QModelIndex &parent, int start, int end)
+{
+    if (parent == root)
+        removeLayoutItemSizes(start, end);
+    QAbstractItemViewPrivate::_q_rowsRemoved(parent, start, end);
+}
+
+void QListViewPrivate::_q_layoutChanged()
+{
+    reuseLayoutItemSizes = false;
+    QAbstractItemViewPrivate::_q_layoutChanged();
+}
+
+void QListViewPrivate::_q_rowsMoved(const QModelIndex &source, int sourceStart, int sourceEnd,
+                                    const QModelIndex &destination, int destinationStart)
+{
+    reuseLayoutItemSizes = false;
+    QAbstractItemViewPrivate::_q_rowsMoved(source, sourceStart, sourceEnd,
+                                           destination, destinationStart);
+}
+
+void QListViewPrivate::_q_delegateSizeHintChanged(const QModelIndex &index)
+{
+    reuseLayoutItemSizes = false;
+    QAbstractItemViewPrivate::_q_delegateSizeHintChanged(index);
+}
+
 QItemSelection QListViewPrivate::selection(const QRect &rect) const
 {
     QItemSelection selection;
@@ -2593,7 +2688,7 @@ void QListModeViewBase::doStaticLayout(const QListViewLayoutInfo &info)
         } else {
             // if we are not using a grid, we need to find the deltas
             if (useItemSize) {
-                QSize hint = itemSize(option, modelIndex(row));
+                QSize hint = layoutItemSize(option, row);
                 if (info.flow == QListView::LeftToRight) {
                     deltaFlowPosition = hint.width() + info.spacing;
                     deltaSegHint = hint.height() + info.spacing;
@@ -3052,7 +3147,7 @@ bool QIconModeViewBase::doBatchedItemLayout(const QListViewLayoutInfo &info, int
         QStyleOptionViewItem option;
         initViewItemOption(&option);
         for (int row = items.size(); row <= info.last; ++row) {
-            QSize size = itemSize(option, modelIndex(row));
+            QSize size = layoutItemSize(option, row);
             QListViewItem item(QRect(0, 0, size.width(), size.height()), row); // default pos
             items.append(item);
         }
@@ -3421,14 +3516,14 @@ void QListView::selectionChanged(const QItemSelection &selected,
 #if QT_CONFIG(accessibility)
     if (QAccessible::isActive()) {
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectableIndex(selected);
         if (sel.isValid()) {
             int entry = visualIndex(sel);
             QAccessibleEvent event(this, QAccessible::SelectionAdd);
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectableIndex(deselected);
         if (desel.isValid()) {
             int entry = visualIndex(desel);
             QAccessibleEvent event(this, QAccessible::SelectionRemove);
@@ -144,6 +144,7 @@ public:
     inline QSize cachedItemSize() const;
     inline QRect viewItemRect(const QListViewItem &item) const;
     inline QSize itemSize(const QStyleOptionViewItem &opt, const QModelIndex &idx) const;
+    inline QSize layoutItemSize(const QStyleOptionViewItem &opt, int row) const;
     inline QAbstractItemDelegate *delegate(const QModelIndex &idx) const;
 
     inline bool isHidden(int row) const;
@@ -273,6 +274,12 @@ public:
 
     bool doItemsLayout(int num);
 
+    void _q_rowsRemoved(const QModelIndex &parent, int start, int end) override;
+    void _q_layoutChanged() override;
+    void _q_rowsMoved(const QModelIndex &source, int sourceStart, int sourceEnd,
+                      const QModelIndex &destination, int destinationStart) override;
+    void _q_delegateSizeHintChanged(const QModelIndex &index) override;
+
     inline QList<QModelIndex> intersectingSet(const QRect &area, bool doLayout = true) const
     {
         if (doLayout) executePostedLayout();
@@ -330,6 +337,10 @@ public:
 
     QModelIndex closestIndex(const QRect &target, const QList<QModelIndex> &candidates) const;
     QSize itemSize(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    QSize layoutItemSize(const QStyleOptionViewItem &option, int row) const;
+    void insertLayoutItemSizes(int first, int last);
+    void removeLayoutItemSizes(int first, int last);
+    void invalidateLayoutItemSizes(int first, int last);
 
     bool selectionAllowed(const QModelIndex &index) const override
         { if (viewMode == QListView::ListMode && !showElasticBand) return index.isValid(); return true; }
@@ -420,6 +431,13 @@ public:
     mutable QSize cachedItemSize;
     int batchSize;
 
+    // The size hints measured by the last layout, by row. A layout that is
+    // only redone because rows were inserted or removed reuses them, so
+    // that only the new rows have to be measured.
+    mutable QList<QSize> layoutItemSizes;
+    QStyleOptionViewItem layoutItemSizesOption;
+    bool reuseLayoutItemSizes;
+
     QRect elasticBand;
     bool showElasticBand;
 
@@ -456,6 +474,8 @@ inline QSize QCommonListViewBase::cachedItemSize() const { return dd->cachedItem
 inline QRect QCommonListViewBase::viewItemRect(const QListViewItem &item) const { return dd->viewItemRect(item); }
 inline QSize QCommonListViewBase::itemSize(const QStyleOptionViewItem &opt, const QModelIndex &idx) const
     { return dd->itemSize(opt, idx); }
+inline QSize QCommonListViewBase::layoutItemSize(const QStyleOptionViewItem &opt, int row) const
+    { return dd->layoutItemSize(opt, row); }
 
 inline QAbstractItemDelegate *QCommonListViewBase::delegate(const QModelIndex &idx) const
     { return qq->itemDelegateForIndex(idx); }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qstyleditemdelegate.h"
+#include "qstyleditemdelegate_p.h"
 
 #include <qabstractitemmodel.h>
 #include <qapplication.h>
@@ -44,36 +45,6 @@
 
 QT_BEGIN_NAMESPACE
 
-class QStyledItemDelegatePrivate : public QAbstractItemDelegatePrivate
-{
-    Q_DECLARE_PUBLIC(QStyledItemDelegate)
-
-public:
-    QStyledItemDelegatePrivate() : factory(nullptr) { }
-
-    static const QWidget *widget(const QStyleOptionViewItem &option)
-    {
-        return option.widget;
-    }
-
-    const QItemEditorFactory *editorFactory() const
-    {
-        return factory ? factory : QItemEditorFactory::defaultFactory();
-    }
-
-    QItemEditorFactory *factory;
-
-    mutable std::array<QModelRoleData, 7> modelRoleData = {
-        QModelRoleData(Qt::FontRole),
-        QModelRoleData(Qt::TextAlignmentRole),
-        QModelRoleData(Qt::ForegroundRole),
-        QModelRoleData(Qt::CheckStateRole),
-        QModelRoleData(Qt::DecorationRole),
-        QModelRoleData(Qt::DisplayRole),
-        QModelRoleData(Qt::BackgroundRole)
-    };
-};
-
 /*!
     \class QStyledItemDelegate
 
@@ -224,6 +195,55 @@ QStyledItemDelegate::~QStyledItemDelegate()
 {
 }
 
+void QStyledItemDelegatePrivate::prefetchRange(const QModelIndex &topLeft,
+                                               const QModelIndex &bottomRight)
+{
+    const QAbstractItemModel *model = topLeft.model();
+    Q_ASSERT(model && model == bottomRight.model());
+    Q_ASSERT(topLeft.parent() == bottomRight.parent());
+
+    prefetched.model = model;
+    prefetched.parent = topLeft.parent();
+    prefetched.top = topLeft.row();
+    prefetched.left = topLeft.column();
+    prefetched.rows = bottomRight.row() - topLeft.row() + 1;
+    prefetched.columns = bottomRight.column() - topLeft.column() + 1;
+
+    // The model fills in the data, so only the roles have to be reset
+    const qsizetype count = qsizetype(prefetched.rows) * prefetched.columns;
+    prefetched.roleData.clear();
+    prefetched.roleData.reserve(count * qsizetype(modelRoleData.size()));
+    for (qsizetype i = 0; i < count; ++i) {
+        for (const QModelRoleData &roleData : modelRoleData)
+            prefetched.roleData.emplaceBack(roleData.role());
+    }
+    model->multiDataForRange(topLeft, bottomRight, prefetched.roleData);
+}
+
+void QStyledItemDelegatePrivate::clearPrefetchedRange()
+{
+    // Keeps the capacity of roleData for the next paint event
+    prefetched.model = nullptr;
+    prefetched.parent = QModelIndex();
+    prefetched.roleData.clear();
+}
+
+// Returns the prefetched data for index, or an empty span if there is none
+QModelRoleDataSpan QStyledItemDelegatePrivate::prefetchedData(const QModelIndex &index) const
+{
+    if (!prefetched.model || index.model() != prefetched.model)
+        return {};
+    const int row = index.row() - prefetched.top;
+    const int column = index.column() - prefetched.left;
+    if (row < 0 || row >= prefetched.rows || column < 0 || column >= prefetched.columns)
+        return {};
+    if (index.parent() != prefetched.parent)
+        return {};
+    const qsizetype roleCount = qsizetype(modelRoleData.size());
+    const qsizetype offset = (qsizetype(row) * prefetched.columns + column) * roleCount;
+    return QModelRoleDataSpan(prefetched.roleData.data() + offset, roleCount);
+}
+
 /*!
     This function returns the string that the delegate will use to display the
     Qt::DisplayRole of the model in \a locale. \a value is the value of the Qt::DisplayRole
@@ -255,8 +275,11 @@ void QStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option,
     option->index = index;
 
     Q_D(const QStyledItemDelegate);
-    QModelRoleDataSpan modelRoleDataSpan = d->modelRoleData;
-    index.multiData(modelRoleDataSpan);
+    QModelRoleDataSpan modelRoleDataSpan = d->prefetchedData(index);
+    if (!modelRoleDataSpan.size()) {
+        modelRoleDataSpan = d->modelRoleData;
+        index.multiData(modelRoleDataSpan);
+    }
 
     const QVariant *value;
     value = modelRoleDataSpan.dataForRole(Qt::FontRole);
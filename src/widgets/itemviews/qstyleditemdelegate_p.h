@@ -0,0 +1,89 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSTYLEDITEMDELEGATE_P_H
+#define QSTYLEDITEMDELEGATE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtWidgets/private/qtwidgetsglobal_p.h>
+#include "qstyleditemdelegate.h"
+#include <private/qabstractitemdelegate_p.h>
+
+#include <qabstractitemmodel.h>
+#include <qitemeditorfactory.h>
+#include <qlist.h>
+#include <qstyleoption.h>
+
+#include <array>
+
+QT_REQUIRE_CONFIG(itemviews);
+
+QT_BEGIN_NAMESPACE
+
+class QStyledItemDelegatePrivate : public QAbstractItemDelegatePrivate
+{
+    Q_DECLARE_PUBLIC(QStyledItemDelegate)
+
+public:
+    QStyledItemDelegatePrivate() : factory(nullptr) { }
+
+    static QStyledItemDelegatePrivate *get(QStyledItemDelegate *delegate)
+    {
+        return delegate->d_func();
+    }
+
+    static const QWidget *widget(const QStyleOptionViewItem &option)
+    {
+        return option.widget;
+    }
+
+    const QItemEditorFactory *editorFactory() const
+    {
+        return factory ? factory : QItemEditorFactory::defaultFactory();
+    }
+
+    // A view that is about to paint a block of cells can fetch the data
+    // initStyleOption() needs for all of them with one call into the model.
+    void prefetchRange(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void clearPrefetchedRange();
+    QModelRoleDataSpan prefetchedData(const QModelIndex &index) const;
+
+    QItemEditorFactory *factory;
+
+    mutable std::array<QModelRoleData, 7> modelRoleData = {
+        QModelRoleData(Qt::FontRole),
+        QModelRoleData(Qt::TextAlignmentRole),
+        QModelRoleData(Qt::ForegroundRole),
+        QModelRoleData(Qt::CheckStateRole),
+        QModelRoleData(Qt::DecorationRole),
+        QModelRoleData(Qt::DisplayRole),
+        QModelRoleData(Qt::BackgroundRole)
+    };
+
+    struct PrefetchedRange
+    {
+        const QAbstractItemModel *model = nullptr;
+        QModelIndex parent;
+        int top = 0;
+        int left = 0;
+        int rows = 0;
+        int columns = 0;
+        // modelRoleData.size() entries per item, row by row
+        QList<QModelRoleData> roleData;
+    };
+    mutable PrefetchedRange prefetched;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTYLEDITEMDELEGATE_P_H
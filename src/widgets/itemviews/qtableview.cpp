@@ -19,6 +19,7 @@
 #include <private/qtableview_p.h>
 #include <private/qheaderview_p.h>
 #include <private/qscrollbar_p.h>
+#include <private/qstyleditemdelegate_p.h>
 #if QT_CONFIG(accessibility)
 #include <qaccessible.h>
 #endif
@@ -1036,6 +1037,47 @@ void QTableViewPrivate::drawCell(QPainter *painter, const QStyleOptionViewItem &
     q->itemDelegateForIndex(index)->paint(painter, opt, index);
 }
 
+/*!
+  \internal
+  Fetches the data that the item delegate needs to paint the cells in the
+  visual rows \a top to \a bottom and columns \a left to \a right with a
+  single call to QAbstractItemModel::multiDataForRange(), instead of one
+  call to multiData() per cell.
+
+  This is only done when all the cells are painted by the same
+  QStyledItemDelegate and the visual block maps to a block of the model,
+  that is when no sections have been moved. Returns the delegate the data
+  was fetched into, which the caller has to clear once the cells have
+  been painted, or \nullptr.
+*/
+QStyledItemDelegatePrivate *QTableViewPrivate::prefetchCellData(int top, int bottom,
+                                                                int left, int right) const
+{
+    // Don't let a huge dirty area make the batch itself the expensive part
+    constexpr qsizetype MaxPrefetchedCells = 4096;
+
+    if (top > bottom || left > right)
+        return nullptr;
+    if (qsizetype(bottom - top + 1) * (right - left + 1) > MaxPrefetchedCells)
+        return nullptr;
+    if (!rowDelegates.isEmpty() || !columnDelegates.isEmpty())
+        return nullptr;
+    if (verticalHeader->sectionsMoved() || horizontalHeader->sectionsMoved())
+        return nullptr;
+    auto *delegate = qobject_cast<QStyledItemDelegate *>(itemDelegate.data());
+    if (!delegate)
+        return nullptr;
+
+    const QModelIndex topLeft = model->index(top, left, root);
+    const QModelIndex bottomRight = model->index(bottom, right, root);
+    if (!topLeft.isValid() || !bottomRight.isValid())
+        return nullptr;
+
+    QStyledItemDelegatePrivate *delegatePrivate = QStyledItemDelegatePrivate::get(delegate);
+    delegatePrivate->prefetchRange(topLeft, bottomRight);
+    return delegatePrivate;
+}
+
 /*!
   \internal
   Get sizeHint width for single Index (providing existing hint and style option)
@@ -1562,6 +1604,8 @@ void QTableView::paintEvent(QPaintEvent *event)
         if (top == -1 || top > bottom)
             continue;
 
+        QStyledItemDelegatePrivate *prefetched = d->prefetchCellData(top, bottom, left, right);
+
         // Paint each row item
         for (int visualRowIndex = top; visualRowIndex <= bottom; ++visualRowIndex) {
             int row = verticalHeader->logicalIndex(visualRowIndex);
@@ -1602,6 +1646,9 @@ void QTableView::paintEvent(QPaintEvent *event)
             alternateBase = !alternateBase && alternate;
         }
 
+        if (prefetched)
+            prefetched->clearPrefetchedRange();
+
         if (showGrid) {
             // Find the bottom right (the last rows/columns might be hidden)
             while (verticalHeader->isSectionHidden(verticalHeader->logicalIndex(bottom))) --bottom;
@@ -3501,14 +3548,14 @@ void QTableView::selectionChanged(const QItemSelection &selected,
 #if QT_CONFIG(accessibility)
     if (QAccessible::isActive()) {
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectableIndex(selected);
         if (sel.isValid()) {
             int entry = d->accessibleTable2Index(sel);
             QAccessibleEvent event(this, QAccessible::SelectionAdd);
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectableIndex(deselected);
         if (desel.isValid()) {
             int entry = d->accessibleTable2Index(desel);
             QAccessibleEvent event(this, QAccessible::SelectionRemove);
@@ -31,6 +31,8 @@ QT_REQUIRE_CONFIG(tableview);
 
 QT_BEGIN_NAMESPACE
 
+class QStyledItemDelegatePrivate;
+
 /** \internal
 *
 * This is a list of span with a binary index to look up quickly a span at a certain index.
@@ -147,6 +149,7 @@ public:
                           const QStyleOptionViewItem &option, QBitArray *drawn,
                           int firstVisualRow, int lastVisualRow, int firstVisualColumn, int lastVisualColumn);
     void drawCell(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index);
+    QStyledItemDelegatePrivate *prefetchCellData(int top, int bottom, int left, int right) const;
     int widthHintForIndex(const QModelIndex &index, int hint, const QStyleOptionViewItem &option) const;
     int heightHintForIndex(const QModelIndex &index, int hint, QStyleOptionViewItem &option) const;
 
@@ -24,6 +24,7 @@
 #include <private/qheaderview_p.h>
 
 #include <algorithm>
+#include <iterator>
 
 QT_BEGIN_NAMESPACE
 
@@ -1382,15 +1383,23 @@ QRect QTreeViewPrivate::intersectedRect(const QRect rect, const QModelIndex &top
     Q_Q(const QTreeView);
 
     const auto parentIdx = topLeft.parent();
+    // the children of a collapsed item are not shown
+    if (parentIdx.isValid() && parentIdx != root && !isIndexExpanded(parentIdx))
+        return QRect();
     executePostedLayout();
     QRect updateRect;
     for (int r = topLeft.row(); r <= bottomRight.row(); ++r) {
         if (isRowHidden(model->index(r, 0, parentIdx)))
             continue;
+        QRect rowRect;
         for (int c = topLeft.column(); c <= bottomRight.column(); ++c) {
             const QModelIndex idx(model->index(r, c, parentIdx));
-            updateRect |= q->visualRect(idx);
+            rowRect |= q->visualRect(idx);
         }
+        // the next rows are further down
+        if (rowRect.isValid() && rowRect.top() > rect.bottom())
+            break;
+        updateRect |= rowRect;
     }
     return rect.intersected(updateRect);
 }
@@ -2767,15 +2776,30 @@ void QTreeView::expandToDepth(int depth)
     QSet<QPersistentModelIndex> old_expandedIndexes;
     old_expandedIndexes = d->expandedIndexes;
     d->expandedIndexes.clear();
-    d->interruptDelayedItemsLayout();
-    d->layout(-1);
-    for (int i = 0; i < d->viewItems.size(); ++i) {
-        if (d->viewItems.at(i).level <= (uint)depth) {
-            d->viewItems[i].expanded = true;
-            d->layout(i);
-            d->storeExpanded(d->viewItems.at(i).index);
+    // Store the expanded items first, so that they are all laid out in one
+    // pass instead of moving the items below each of them separately
+    if (depth >= 0) {
+        QStack<QPair<QModelIndex, int>> parents;
+        parents.push({d->root, 0});
+        while (!parents.isEmpty()) {
+            const QPair<QModelIndex, int> elem = parents.pop();
+            const QModelIndex &parent = elem.first;
+            const int level = elem.second;
+            const int rowCount = d->model->rowCount(parent);
+            for (int row = 0; row < rowCount; ++row) {
+                const QModelIndex child = d->model->index(row, 0, parent);
+                if (!d->isIndexValid(child))
+                    break;
+                if (d->isRowHidden(child))
+                    continue;
+                d->storeExpanded(child);
+                if (level < depth)
+                    parents.push({child, level + 1});
+            }
         }
     }
+    d->interruptDelayedItemsLayout();
+    d->layout(-1);
 
     bool someSignalEnabled = isSignalConnected(QMetaMethod::fromSignal(&QTreeView::collapsed));
     someSignalEnabled |= isSignalConnected(QMetaMethod::fromSignal(&QTreeView::expanded));
@@ -3325,6 +3349,27 @@ void QTreeViewPrivate::layout(int i, bool recursiveExpanding, bool afterIsUninit
         return;
     }
 
+    // Expanding an item inserts its children after it, and every expanded
+    // item among them inserts its own, each time moving all the items that
+    // follow. Lay out the whole subtree at the end instead, and move the
+    // items that follow it only once.
+    if (i >= 0 && !afterIsUninitialized && viewItems.at(i).total == 0
+        && i + 1 < viewItems.size()) {
+        QList<QTreeViewItem> after(std::make_move_iterator(viewItems.begin() + i + 1),
+                                   std::make_move_iterator(viewItems.end()));
+        viewItems.resize(i + 1);
+        layout(i, recursiveExpanding, true);
+        const int inserted = viewItems.size() - (i + 1);
+        if (inserted > 0) {
+            for (QTreeViewItem &item : after) {
+                if (item.parentItem > i)
+                    item.parentItem += inserted;
+            }
+        }
+        viewItems.append(std::move(after));
+        return;
+    }
+
 #if QT_CONFIG(accessibility)
     // QAccessibleTree's rowCount implementation uses viewItems.size(), so
     // we need to invalidate any cached accessibility data structures if
@@ -4038,7 +4083,7 @@ void QTreeView::selectionChanged(const QItemSelection &selected,
         Q_D(QTreeView);
 
         // ### does not work properly for selection ranges.
-        QModelIndex sel = selected.indexes().value(0);
+        QModelIndex sel = QAbstractItemViewPrivate::firstSelectableIndex(selected);
         if (sel.isValid()) {
             int entry = d->accessibleTree2Index(sel);
             Q_ASSERT(entry >= 0);
@@ -4046,7 +4091,7 @@ void QTreeView::selectionChanged(const QItemSelection &selected,
             event.setChild(entry);
             QAccessible::updateAccessibility(&event);
         }
-        QModelIndex desel = deselected.indexes().value(0);
+        QModelIndex desel = QAbstractItemViewPrivate::firstSelectableIndex(deselected);
         if (desel.isValid()) {
             int entry = d->accessibleTree2Index(desel);
             Q_ASSERT(entry >= 0);
@@ -2688,6 +2688,8 @@ bool QApplication::notify(QObject *receiver, QEvent *e)
     bool res = false;
     if (isWidgetType) {
         QWidget * w = static_cast<QWidget *>(receiver);
+        if (e->type() == QEvent::LayoutRequest)
+            QWidgetPrivate::get(w)->flushAncestorLayoutRequests();
         switch (e->type()) {
         case QEvent::ShortcutOverride:
         case QEvent::KeyPress:
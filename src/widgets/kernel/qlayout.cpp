@@ -976,7 +976,7 @@ void QLayout::update()
         if (layout->d_func()->topLevel) {
             Q_ASSERT(layout->parent()->isWidgetType());
             QWidget *mw = static_cast<QWidget*>(layout->parent());
-            QCoreApplication::postEvent(mw, new QEvent(QEvent::LayoutRequest));
+            QWidgetPrivate::get(mw)->postLayoutRequest();
             break;
         }
         layout = static_cast<QLayout*>(layout->parent());
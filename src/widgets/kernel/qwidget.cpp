@@ -142,6 +142,9 @@ QWidgetPrivate::QWidgetPrivate(int version)
       , usesRhiFlush(0)
       , childrenHiddenByWState(0)
       , childrenShownByExpose(0)
+      , layoutRequestPending(0)
+      , polishRequestPending(0)
+      , polishCoveredByParent(0)
 #if defined(Q_OS_WIN)
       , noPaintOnScreen(0)
 #endif
@@ -1010,7 +1013,7 @@ void QWidgetPrivate::init(QWidget *parentWidget, Qt::WindowFlags f)
 
     QEvent e(QEvent::Create);
     QCoreApplication::sendEvent(q, &e);
-    QCoreApplication::postEvent(q, new QEvent(QEvent::PolishRequest));
+    schedulePolish();
 
     extraPaintEngine = nullptr;
 }
@@ -2021,9 +2024,42 @@ void QWidgetPrivate::subtractOpaqueChildren(QRegion &source, const QRect &clipRe
         source -= (r & clipRect);
 }
 
+/*!
+    \internal
+
+    Sets \a begin and \a end to the range of visible siblings stacked above
+    \a widget, collecting the children of its parent the first time. Returns
+    \c false if \a widget is not among them, for instance because it is
+    hidden.
+*/
+bool QWidgetPrivate::StackingOrderCache::siblingsAbove(const QWidget *widget,
+                                                       const Sibling **begin, const Sibling **end)
+{
+    const QWidget *parent = widget->parentWidget();
+    auto it = children.find(parent);
+    if (it == children.end()) {
+        it = children.insert(parent, Children());
+        for (QObject *child : QWidgetPrivate::get(parent)->children) {
+            QWidget *sibling = qobject_cast<QWidget *>(child);
+            if (!sibling || !sibling->isVisible() || sibling->isWindow())
+                continue;
+            it->indexes.insert(sibling, it->siblings.size());
+            it->siblings.append({ sibling, QWidgetPrivate::get(sibling)->effectiveRectFor(sibling->geometry()) });
+        }
+    }
+
+    const auto index = it->indexes.constFind(widget);
+    if (index == it->indexes.cend())
+        return false;
+    *begin = it->siblings.constData() + *index + 1;
+    *end = it->siblings.constData() + it->siblings.size();
+    return true;
+}
+
 //subtract any relatives that are higher up than me --- this is too expensive !!!
 void QWidgetPrivate::subtractOpaqueSiblings(QRegion &sourceRegion, bool *hasDirtySiblingsAbove,
-                                            bool alsoNonOpaque) const
+                                            bool alsoNonOpaque,
+                                            StackingOrderCache *stackingOrderCache) const
 {
     Q_Q(const QWidget);
     static int disableSubtractOpaqueSiblings = qEnvironmentVariableIntValue("QT_NO_SUBTRACTOPAQUESIBLINGS");
@@ -2038,68 +2074,85 @@ void QWidgetPrivate::subtractOpaqueSiblings(QRegion &sourceRegion, bool *hasDirt
 
     QPoint parentOffset = data.crect.topLeft();
 
+    // Returns true when nothing is left of sourceRegion.
+    const auto subtractSibling = [&](QWidget *sibling, const QRect &siblingGeometry) {
+        if (dirtyClipBoundingRect) {
+            clipBoundingRect = sourceRegion.boundingRect();
+            dirtyClipBoundingRect = false;
+        }
+
+        if (!qRectIntersects(siblingGeometry, clipBoundingRect.translated(parentOffset)))
+            return false;
+
+        if (dirtyParentClip) {
+            parentClip = sourceRegion.translated(parentOffset);
+            dirtyParentClip = false;
+        }
+
+        const QPoint siblingPos(sibling->data->crect.topLeft());
+        const QRect siblingClipRect(sibling->d_func()->clipRect());
+        QRegion siblingDirty(parentClip);
+        siblingDirty &= (siblingClipRect.translated(siblingPos));
+        const bool hasMask = sibling->d_func()->extra && sibling->d_func()->extra->hasMask
+                             && !sibling->d_func()->graphicsEffect;
+        if (hasMask)
+            siblingDirty &= sibling->d_func()->extra->mask.translated(siblingPos);
+        if (siblingDirty.isEmpty())
+            return false;
+
+        if (sibling->d_func()->isOpaque || alsoNonOpaque) {
+            if (hasMask) {
+                siblingDirty.translate(-parentOffset);
+                sourceRegion -= siblingDirty;
+            } else {
+                sourceRegion -= siblingGeometry.translated(-parentOffset);
+            }
+        } else {
+            if (hasDirtySiblingsAbove)
+                *hasDirtySiblingsAbove = true;
+            if (sibling->d_func()->children.isEmpty())
+                return false;
+            QRegion opaqueSiblingChildren(sibling->d_func()->getOpaqueChildren());
+            opaqueSiblingChildren.translate(-parentOffset + siblingPos);
+            sourceRegion -= opaqueSiblingChildren;
+        }
+        if (sourceRegion.isEmpty())
+            return true;
+
+        dirtyClipBoundingRect = true;
+        dirtyParentClip = true;
+        return false;
+    };
+
     const QWidget *w = q;
 
     while (w) {
         if (w->isWindow())
             break;
         QWidgetPrivate *pd = w->parentWidget()->d_func();
-        const int myIndex = pd->children.indexOf(const_cast<QWidget *>(w));
         const QRect widgetGeometry = w->d_func()->effectiveRectFor(w->data->crect);
-        for (int i = myIndex + 1; i < pd->children.size(); ++i) {
-            QWidget *sibling = qobject_cast<QWidget *>(pd->children.at(i));
-            if (!sibling || !sibling->isVisible() || sibling->isWindow())
-                continue;
-
-            const QRect siblingGeometry = sibling->d_func()->effectiveRectFor(sibling->data->crect);
-            if (!qRectIntersects(siblingGeometry, widgetGeometry))
-                continue;
-
-            if (dirtyClipBoundingRect) {
-                clipBoundingRect = sourceRegion.boundingRect();
-                dirtyClipBoundingRect = false;
-            }
-
-            if (!qRectIntersects(siblingGeometry, clipBoundingRect.translated(parentOffset)))
-                continue;
-
-            if (dirtyParentClip) {
-                parentClip = sourceRegion.translated(parentOffset);
-                dirtyParentClip = false;
+        const StackingOrderCache::Sibling *begin;
+        const StackingOrderCache::Sibling *end;
+        if (stackingOrderCache && stackingOrderCache->siblingsAbove(w, &begin, &end)) {
+            for (auto sibling = begin; sibling != end; ++sibling) {
+                if (qRectIntersects(sibling->geometry, widgetGeometry)
+                    && subtractSibling(sibling->widget, sibling->geometry)) {
+                    return;
+                }
             }
+        } else {
+            const int myIndex = pd->children.indexOf(const_cast<QWidget *>(w));
+            for (int i = myIndex + 1; i < pd->children.size(); ++i) {
+                QWidget *sibling = qobject_cast<QWidget *>(pd->children.at(i));
+                if (!sibling || !sibling->isVisible() || sibling->isWindow())
+                    continue;
 
-            const QPoint siblingPos(sibling->data->crect.topLeft());
-            const QRect siblingClipRect(sibling->d_func()->clipRect());
-            QRegion siblingDirty(parentClip);
-            siblingDirty &= (siblingClipRect.translated(siblingPos));
-            const bool hasMask = sibling->d_func()->extra && sibling->d_func()->extra->hasMask
-                                 && !sibling->d_func()->graphicsEffect;
-            if (hasMask)
-                siblingDirty &= sibling->d_func()->extra->mask.translated(siblingPos);
-            if (siblingDirty.isEmpty())
-                continue;
-
-            if (sibling->d_func()->isOpaque || alsoNonOpaque) {
-                if (hasMask) {
-                    siblingDirty.translate(-parentOffset);
-                    sourceRegion -= siblingDirty;
-                } else {
-                    sourceRegion -= siblingGeometry.translated(-parentOffset);
+                const QRect siblingGeometry = sibling->d_func()->effectiveRectFor(sibling->data->crect);
+                if (qRectIntersects(siblingGeometry, widgetGeometry)
+                    && subtractSibling(sibling, siblingGeometry)) {
+                    return;
                 }
-            } else {
-                if (hasDirtySiblingsAbove)
-                    *hasDirtySiblingsAbove = true;
-                if (sibling->d_func()->children.isEmpty())
-                    continue;
-                QRegion opaqueSiblingChildren(sibling->d_func()->getOpaqueChildren());
-                opaqueSiblingChildren.translate(-parentOffset + siblingPos);
-                sourceRegion -= opaqueSiblingChildren;
             }
-            if (sourceRegion.isEmpty())
-                return;
-
-            dirtyClipBoundingRect = true;
-            dirtyParentClip = true;
         }
 
         w = w->parentWidget();
@@ -8425,7 +8478,7 @@ void QWidgetPrivate::setVisible(bool visible)
             if (q->parentWidget()->d_func()->layout)
                 q->parentWidget()->d_func()->layout->invalidate();
             else if (q->parentWidget()->isVisible())
-                QCoreApplication::postEvent(q->parentWidget(), new QEvent(QEvent::LayoutRequest));
+                q->parentWidget()->d_func()->postLayoutRequest();
         }
 
         QEvent hideToParentEvent(QEvent::HideToParent);
@@ -9061,6 +9114,7 @@ bool QWidget::event(QEvent *event)
         break;
 
     case QEvent::PolishRequest:
+        d->polishRequestPending = 0;
         ensurePolished();
         break;
 
@@ -10505,7 +10559,71 @@ void QWidgetPrivate::updateGeometry_helper(bool forceUpdate)
             if (parent->d_func()->layout)
                 parent->d_func()->layout->invalidate();
             else if (parent->isVisible())
-                QCoreApplication::postEvent(parent, new QEvent(QEvent::LayoutRequest));
+                parent->d_func()->postLayoutRequest();
+        }
+    }
+}
+
+/*!
+    \internal
+    Posts a LayoutRequest event to this widget. The requests posted to a
+    widget are compressed into one, and the widget is marked, so that
+    flushAncestorLayoutRequests() can tell which of its parents are waiting
+    to be laid out.
+*/
+void QWidgetPrivate::postLayoutRequest()
+{
+    Q_Q(QWidget);
+    layoutRequestPending = 1;
+    QCoreApplication::postEvent(q, new QEvent(QEvent::LayoutRequest));
+}
+
+/*!
+    \internal
+    Makes sure that the widget gets polished once control returns to the
+    event loop, if it wasn't before.
+
+    Polishing a widget polishes its children, so a widget whose parent is
+    still waiting to be polished doesn't need a PolishRequest event of its
+    own. Only the root of a tree of new widgets thus posts one, instead of
+    each of its widgets: this keeps the queue of posted events short, which
+    in turn makes posting and removing events cheaper, for instance when
+    widgets are destroyed. QWidget::setParent() calls this function again
+    for widgets that are moved away from the parent that would have
+    polished them.
+*/
+void QWidgetPrivate::schedulePolish()
+{
+    Q_Q(QWidget);
+    if (polishRequestPending)
+        return;
+    const QWidget *p = q->parentWidget();
+    const QWidgetPrivate *pd = p ? p->d_func() : nullptr;
+    polishCoveredByParent = pd && !pd->polished
+            && (pd->polishRequestPending || pd->polishCoveredByParent);
+    if (polishCoveredByParent)
+        return;
+    polishRequestPending = 1;
+    QCoreApplication::postEvent(q, new QEvent(QEvent::PolishRequest));
+}
+
+/*!
+    \internal
+    Called when the widget is about to handle a LayoutRequest event. Lays
+    out the closest parent in the same window that has a request pending
+    first, which in turn lays out its own parents first: laying out a parent
+    usually resizes its children, so that laying them out before would have
+    been wasted. The posted requests of a window are thus handled from the
+    top down, whatever order they were posted in.
+*/
+void QWidgetPrivate::flushAncestorLayoutRequests()
+{
+    Q_Q(QWidget);
+    layoutRequestPending = 0;
+    for (QWidget *w = q; !w->isWindow() && (w = w->parentWidget()); ) {
+        if (w->d_func()->layoutRequestPending) {
+            QCoreApplication::sendPostedEvents(w, QEvent::LayoutRequest);
+            break;
         }
     }
 }
@@ -10834,6 +10952,10 @@ void QWidget::setParent(QWidget *parent, Qt::WindowFlags f)
     if (d->extra && d->extra->hasWindowContainer)
         QWindowContainer::parentWasChanged(this);
 
+    // the old parent won't polish this widget anymore
+    if (newParent && !d->polished)
+        d->schedulePolish();
+
     QWidget *newtlw = window();
     if (oldtlw != newtlw) {
         QSurface::SurfaceType surfaceType = QSurface::RasterSurface;
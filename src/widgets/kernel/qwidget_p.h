@@ -317,8 +317,31 @@ public:
     QRegion clipRegion() const;
     void setSystemClip(QPaintEngine *paintEngine, qreal devicePixelRatio, const QRegion &region);
     void subtractOpaqueChildren(QRegion &rgn, const QRect &clipRect) const;
+
+    // The visible children of widgets in stacking order, with their effective
+    // geometry, collected once for all the calls to subtractOpaqueSiblings()
+    // during which the widget hierarchy does not change.
+    class StackingOrderCache
+    {
+    public:
+        struct Sibling
+        {
+            QWidget *widget;
+            QRect geometry;
+        };
+        bool siblingsAbove(const QWidget *widget, const Sibling **begin, const Sibling **end);
+
+    private:
+        struct Children
+        {
+            QList<Sibling> siblings;
+            QHash<const QWidget *, qsizetype> indexes;
+        };
+        QHash<const QWidget *, Children> children;
+    };
     void subtractOpaqueSiblings(QRegion &source, bool *hasDirtySiblingsAbove = nullptr,
-                                bool alsoNonOpaque = false) const;
+                                bool alsoNonOpaque = false,
+                                StackingOrderCache *stackingOrderCache = nullptr) const;
     void clipToEffectiveMask(QRegion &region) const;
     void updateIsOpaque();
     void setOpaque(bool opaque);
@@ -418,6 +441,9 @@ public:
     QWidget *childAt_helper(const QPoint &, bool) const;
     QWidget *childAtRecursiveHelper(const QPoint &p, bool) const;
     void updateGeometry_helper(bool forceUpdate);
+    void postLayoutRequest();
+    void schedulePolish();
+    void flushAncestorLayoutRequests();
 
     void getLayoutItemMargins(int *left, int *top, int *right, int *bottom) const;
     void setLayoutItemMargins(int left, int top, int right, int bottom);
@@ -725,6 +751,9 @@ public:
     uint usesRhiFlush : 1;
     uint childrenHiddenByWState : 1;
     uint childrenShownByExpose : 1;
+    uint layoutRequestPending : 1;
+    uint polishRequestPending : 1;
+    uint polishCoveredByParent : 1;
 
     // *************************** Platform specific ************************************
 #if defined(Q_OS_WIN)
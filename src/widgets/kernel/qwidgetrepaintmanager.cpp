@@ -739,6 +739,8 @@ void QWidgetRepaintManager::paintAndFlush()
     // and does not have transparent overlapping siblings, append it to the
     // opaqueNonOverlappedWidgets list and paint it directly without composition.
     QVarLengthArray<QWidget *, 32> opaqueNonOverlappedWidgets;
+    // Many dirty widgets often share their parent; look up its children once.
+    QWidgetPrivate::StackingOrderCache stackingOrderCache;
     for (int i = 0; i < dirtyWidgets.size(); ++i) {
         QWidget *w = dirtyWidgets.at(i);
         QWidgetPrivate *wd = w->d_func();
@@ -753,7 +755,7 @@ void QWidgetRepaintManager::paintAndFlush()
         bool hasDirtySiblingsAbove = false;
         // We know for sure that the widget isn't overlapped if 'isMoved' is true.
         if (!wd->isMoved)
-            wd->subtractOpaqueSiblings(wd->dirty, &hasDirtySiblingsAbove);
+            wd->subtractOpaqueSiblings(wd->dirty, &hasDirtySiblingsAbove, false, &stackingOrderCache);
 
         // Make a copy of the widget's dirty region, to restore it in case there is an opaque
         // render-to-texture child that completely covers the widget, because otherwise the
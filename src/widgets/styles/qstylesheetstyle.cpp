@@ -113,6 +113,9 @@ public:
 
 static QStyleSheetStyleCaches *styleSheetCaches = nullptr;
 
+// Entries in QStyleSheetStyleCaches::sharedStyleRulesCache before it is cleared
+static constexpr qsizetype MaxSharedStyleRules = 4096;
+
 /* RECURSION_GUARD:
  * the QStyleSheetStyle is a proxy. If used with others proxy style, we may end up with something like:
  * QStyleSheetStyle -> ProxyStyle -> QStyleSheetStyle -> OriginalStyle
@@ -1707,8 +1710,10 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
     }
 
     QList<QCss::StyleSheet> objectSs;
+    QStringList objectStyleSheets;
     for (const QObject *o = obj; o; o = parentObject(o)) {
         QString styleSheet = o->property("styleSheet").toString();
+        objectStyleSheets.append(styleSheet);
         if (styleSheet.isEmpty())
             continue;
         StyleSheet ss;
@@ -1733,13 +1738,78 @@ QList<QCss::StyleRule> QStyleSheetStyle::styleRules(const QObject *obj) const
 
     styleSelector.styleSheets += objectSs;
 
+    // Objects that the selectors cannot tell apart get the same rules. The
+    // key does not cover the application style sheet, so start over when
+    // that changes.
+    const QString appStyleSheet = qApp->styleSheet();
+    if (!appStyleSheet.isSharedWith(styleSheetCaches->sharedStyleRulesAppStyleSheet)
+        && appStyleSheet != styleSheetCaches->sharedStyleRulesAppStyleSheet) {
+        styleSheetCaches->sharedStyleRulesCache.clear();
+        styleSheetCaches->sharedStyleRulesAppStyleSheet = appStyleSheet;
+    }
+    QStringList attributeNames;
+    for (const StyleSheet &ss : std::as_const(styleSelector.styleSheets))
+        attributeNames += ss.attributeNames;
+    attributeNames.removeDuplicates();
+    const QString key = sharedStyleRulesKey(obj, objectStyleSheets, attributeNames);
+    QHash<QString, QList<StyleRule>>::const_iterator sharedIt =
+            styleSheetCaches->sharedStyleRulesCache.constFind(key);
+    if (sharedIt != styleSheetCaches->sharedStyleRulesCache.constEnd()) {
+        styleSheetCaches->styleRulesCache.insert(obj, sharedIt.value());
+        return sharedIt.value();
+    }
+
     StyleSelector::NodePtr n;
     n.ptr = const_cast<QObject *>(obj);
     QList<QCss::StyleRule> rules = styleSelector.styleRulesForNode(n);
     styleSheetCaches->styleRulesCache.insert(obj, rules);
+    if (styleSheetCaches->sharedStyleRulesCache.size() >= MaxSharedStyleRules)
+        styleSheetCaches->sharedStyleRulesCache.clear();
+    styleSheetCaches->sharedStyleRulesCache.insert(key, rules);
     return rules;
 }
 
+/*!
+    \internal
+
+    Returns a key that is the same for all objects to which the style
+    sheets apply the same rules: the rules only depend on the base style,
+    on the class, object name and style sheet of \a obj and each of its
+    parents, listed in \a styleSheets, and on the values of the attributes
+    in \a attributeNames that the selectors test.
+*/
+QString QStyleSheetStyle::sharedStyleRulesKey(const QObject *obj, const QStringList &styleSheets,
+                                              const QStringList &attributeNames) const
+{
+    // Length-prefixed, so that no string can be mistaken for a separator
+    const auto appendString = [](QString *key, const QString &string) {
+        if (string.isNull()) {
+            key->append(u'-');
+        } else {
+            key->append(QString::number(string.size()));
+            key->append(u':');
+            key->append(string);
+        }
+    };
+
+    // A selector of its own, since the attribute cache of the one that
+    // matches depends on the values in the selectors
+    QStyleSheetStyleSelector selector;
+    QString key = QString::number(quintptr(baseStyle()), 16);
+    int level = 0;
+    for (const QObject *o = obj; o; o = parentObject(o), ++level) {
+        key.append(u'|');
+        key.append(QString::number(quintptr(o->metaObject()), 16));
+        appendString(&key, o->objectName());
+        appendString(&key, styleSheets.value(level));
+        StyleSelector::NodePtr n;
+        n.ptr = const_cast<QObject *>(o);
+        for (const QString &name : attributeNames)
+            appendString(&key, selector.attributeValue(n, { name, {}, AttributeSelector::NoMatch }));
+    }
+    return key;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // Rendering rules
 static QList<Declaration> declarations(const QList<StyleRule> &styleRules, const QString &part,
@@ -2886,6 +2956,8 @@ void QStyleSheetStyleCaches::objectDestroyed(QObject *o)
 void QStyleSheetStyleCaches::styleDestroyed(QObject *o)
 {
     styleSheetCache.remove(o);
+    // Another style could be created at the same address
+    sharedStyleRulesCache.clear();
 }
 
 /*!
@@ -3034,6 +3106,7 @@ void QStyleSheetStyle::repolish(QApplication *app)
     const QList<const QObject*> allObjects = styleSheetCaches->styleRulesCache.keys();
     styleSheetCaches->styleSheetCache.remove(qApp);
     styleSheetCaches->styleRulesCache.clear();
+    styleSheetCaches->sharedStyleRulesCache.clear();
     styleSheetCaches->hasStyleRuleCache.clear();
     styleSheetCaches->renderRulesCache.clear();
     updateObjects(allObjects);
@@ -3071,6 +3144,7 @@ void QStyleSheetStyle::unpolish(QApplication *app)
     baseStyle()->unpolish(app);
     RECURSION_GUARD(return)
     styleSheetCaches->styleRulesCache.clear();
+    styleSheetCaches->sharedStyleRulesCache.clear();
     styleSheetCaches->hasStyleRuleCache.clear();
     styleSheetCaches->renderRulesCache.clear();
     styleSheetCaches->styleSheetCache.remove(qApp);
@@ -123,6 +123,8 @@ private:
     void setGeometry(QWidget *);
     void unsetStyleSheetFont(QWidget *) const;
     QList<QCss::StyleRule> styleRules(const QObject *obj) const;
+    QString sharedStyleRulesKey(const QObject *obj, const QStringList &styleSheets,
+                                const QStringList &attributeNames) const;
     bool hasStyleRule(const QObject *obj, int part) const;
 
     QHash<QStyle::SubControl, QRect> titleBarLayout(const QWidget *w, const QStyleOptionTitleBar *tb) const;
@@ -151,6 +153,9 @@ public Q_SLOTS:
     void styleDestroyed(QObject *);
 public:
     QHash<const QObject *, QList<QCss::StyleRule>> styleRulesCache;
+    // keyed by QStyleSheetStyle::sharedStyleRulesKey()
+    QHash<QString, QList<QCss::StyleRule>> sharedStyleRulesCache;
+    QString sharedStyleRulesAppStyleSheet;
     QHash<const QObject *, QHash<int, bool> > hasStyleRuleCache;
     typedef QHash<int, QHash<quint64, QRenderRule> > QRenderRules;
     QHash<const QObject *, QRenderRules> renderRulesCache;
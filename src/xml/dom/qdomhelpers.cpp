@@ -78,6 +78,34 @@ bool QDomBuilder::parseDTD(const QString &dtd)
     return true;
 }
 
+/*
+    Returns a string equal to \a str that shares its data with all the other
+    strings equal to it that this builder returned.
+
+    Documents tend to use few different names many times, so this saves the
+    memory of one string per element and attribute.
+*/
+QString QDomBuilder::intern(QStringView str)
+{
+    if (str.isEmpty())
+        return str.isNull() ? QString() : u""_s;
+    auto it = stringPool.constFind(str);
+    if (it == stringPool.cend()) {
+        QString copy = str.toString();
+        it = stringPool.insert(QStringView(copy), copy);
+    }
+    return *it;
+}
+
+// The local names and prefixes of qualified names are new strings
+void QDomBuilder::internNames(QDomNodePrivate *n)
+{
+    if (!n->prefix.isEmpty()) {
+        n->prefix = intern(n->prefix);
+        n->name = intern(n->name);
+    }
+}
+
 bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
                                const QXmlStreamAttributes &atts)
 {
@@ -87,6 +115,8 @@ bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
             nsProcessing ? doc->createElementNS(nsURI, qName) : doc->createElement(qName);
     if (!n)
         return false;
+    if (nsProcessing)
+        internNames(n);
 
     n->setLocation(int(reader->lineNumber()), int(reader->columnNumber()));
 
@@ -94,15 +124,22 @@ bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
     node = n;
 
     // attributes
+    constexpr qsizetype MaxInternedValueSize = 32;
     for (const auto &attr : atts) {
         auto domElement = static_cast<QDomElementPrivate *>(node);
+        const QStringView value = attr.value();
+        const QString internedValue =
+                value.size() <= MaxInternedValueSize ? intern(value) : value.toString();
         if (nsProcessing) {
-            domElement->setAttributeNS(attr.namespaceUri().toString(),
-                                       attr.qualifiedName().toString(),
-                                       attr.value().toString());
+            const QString nsURI = intern(attr.namespaceUri());
+            domElement->setAttributeNS(nsURI, intern(attr.qualifiedName()), internedValue);
+            // the map keeps using the local name, only the prefix is new
+            if (!attr.prefix().isEmpty()) {
+                if (QDomNodePrivate *a = domElement->m_attr->namedItemNS(nsURI, attr.name().toString()))
+                    a->prefix = intern(a->prefix);
+            }
         } else {
-            domElement->setAttribute(attr.qualifiedName().toString(),
-                                     attr.value().toString());
+            domElement->setAttribute(intern(attr.qualifiedName()), internedValue);
         }
     }
 
@@ -327,9 +364,9 @@ bool QDomParser::parseBody()
     while (!reader->atEnd() && !reader->hasError()) {
         switch (reader->tokenType()) {
         case QXmlStreamReader::StartElement:
-            tagStack.push(reader->qualifiedName().toString());
-            if (!domBuilder.startElement(reader->namespaceUri().toString(),
-                                         reader->qualifiedName().toString(),
+            tagStack.push(domBuilder.intern(reader->qualifiedName()));
+            if (!domBuilder.startElement(domBuilder.intern(reader->namespaceUri()),
+                                         tagStack.top(),
                                          reader->attributes())) {
                 domBuilder.fatalError(
                         QDomParser::tr("Error occurred while processing a start element"));
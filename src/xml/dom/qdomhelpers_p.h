@@ -5,6 +5,7 @@
 
 #include <qcoreapplication.h>
 #include <qdom.h>
+#include <qhash.h>
 #include <private/qglobal_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -59,8 +60,15 @@ public:
     bool preserveSpacingOnlyNodes() const
     { return parseOptions & QDomDocument::ParseOption::PreserveSpacingOnlyNodes; }
 
+    QString intern(QStringView str);
+
 private:
     QString dtdInternalSubset(const QString &dtd);
+    void internNames(QDomNodePrivate *n);
+
+    // Names, namespace URIs and short attribute values seen so far. The
+    // keys point to the data of the values, which all nodes share.
+    QHash<QStringView, QString> stringPool;
 
     QDomDocument::ParseResult parseResult;
     QDomDocumentPrivate *doc;
@@ -12,6 +12,9 @@
 
 #include "../testhelper_functions.h"
 
+#include <algorithm>
+#include <numeric>
+
 class tst_QtConcurrentMap : public QObject
 {
     Q_OBJECT
@@ -31,6 +34,7 @@ private slots:
     void mappedReducedInitialValueWithMoveOnlyCallable();
     void mappedReducedDifferentTypeInitialValue();
     void mappedReduceOptionConvertableToResultType();
+    void mappedReducedParallel();
     void assignResult();
     void functionOverloads();
     void noExceptFunctionOverloads();
@@ -212,6 +216,16 @@ void tst_QtConcurrentMap::map()
     }
 #endif
 
+    // large sequences are split into a slice per thread; every item must
+    // still be visited exactly once
+    {
+        QThreadPool pool;
+        pool.setMaxThreadCount(4);
+        QList<int> list(100003, 1);
+        QtConcurrent::map(&pool, list, multiplyBy2InPlace).waitForFinished();
+        QCOMPARE(std::count(list.cbegin(), list.cend(), 2), list.size());
+    }
+
 #if 0
     // not allowed: map() on a const list, where functors try to modify the items in the list
     {
@@ -1657,6 +1671,43 @@ int sleeper(int val)
     return val;
 }
 
+void tst_QtConcurrentMap::mappedReducedParallel()
+{
+    QList<int> list(10000);
+    std::iota(list.begin(), list.end(), 0);
+    const int expectedSum = 2 * (9999 * 10000 / 2);
+
+    QCOMPARE(QtConcurrent::mappedReduced(list, multiplyBy2, intSumReduce,
+                                         ParallelReduce).result(), expectedSum);
+    QCOMPARE(QtConcurrent::blockingMappedReduced<int>(list, multiplyBy2, intSumReduce, 100,
+                                                      ParallelReduce), expectedSum + 100);
+
+    // A reduce function that can merge partial results
+    struct Histogram
+    {
+        void operator()(QHash<int, int> &result, int value) const { ++result[value % 10]; }
+        void operator()(QHash<int, int> &result, const QHash<int, int> &partial) const
+        {
+            for (auto it = partial.cbegin(); it != partial.cend(); ++it)
+                result[it.key()] += it.value();
+        }
+    };
+    const QHash<int, int> histogram =
+            QtConcurrent::blockingMappedReduced<QHash<int, int>>(list, multiplyBy2, Histogram(),
+                                                                 ParallelReduce);
+    QCOMPARE(histogram.size(), 5);
+    for (int digit : { 0, 2, 4, 6, 8 })
+        QCOMPARE(histogram.value(digit), 2000);
+
+    // One that can't falls back to UnorderedReduce
+    auto append = [](QList<int> &result, int value) { result.append(value); };
+    QList<int> appended = QtConcurrent::blockingMappedReduced<QList<int>>(list, multiplyBy2,
+                                                                          append, ParallelReduce);
+    std::sort(appended.begin(), appended.end());
+    QCOMPARE(appended.size(), list.size());
+    QCOMPARE(appended.last(), 2 * 9999);
+}
+
 void tst_QtConcurrentMap::assignResult()
 {
     const QList<int> startList = QList<int>() << 0 << 1 << 2;
@@ -37,6 +37,7 @@ private slots:
     void qMessagePattern_data();
     void qMessagePattern();
     void setMessagePattern();
+    void asyncStderr();
 
     void formatLogMessage_data();
     void formatLogMessage();
@@ -906,6 +907,37 @@ void tst_qmessagehandler::setMessagePattern()
 #endif // QT_CONFIG(process)
 }
 
+void tst_qmessagehandler::asyncStderr()
+{
+#if !QT_CONFIG(process)
+    QSKIP("This test requires QProcess support");
+#elif !defined(Q_OS_UNIX) || defined(Q_OS_ANDROID)
+    QSKIP("Asynchronous logging to stderr is only supported on Unix");
+#else
+    // same as setMessagePattern(), but written from the background thread
+    QProcess process;
+    const QString appExe(backtraceHelperPath());
+
+    QProcessEnvironment environment = m_baseEnvironment;
+    environment.insert("QT_LOGGING_ASYNC", "block");
+    process.setProcessEnvironment(environment);
+
+    process.start(appExe);
+    QVERIFY2(process.waitForStarted(), qPrintable(
+        QString::fromLatin1("Could not start %1: %2").arg(appExe, process.errorString())));
+    process.waitForFinished();
+
+    QByteArray output = process.readAllStandardError();
+    QByteArray expected = "static constructor\n"
+            "[debug] qDebug\n"
+            "[info] qInfo\n"
+            "[warning] qWarning\n"
+            "[critical] qCritical\n"
+            "[warning] qDebug with category\n";
+    QCOMPARE(QString::fromLatin1(output), QString::fromLatin1(expected));
+#endif
+}
+
 Q_DECLARE_METATYPE(QtMsgType)
 
 void tst_qmessagehandler::formatLogMessage_data()
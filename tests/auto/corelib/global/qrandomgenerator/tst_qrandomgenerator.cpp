@@ -85,6 +85,7 @@ private slots:
     void generateReal();
     void qualityReal_data() { generate32_data(); }
     void qualityReal();
+    void bulkGeneration();
 
     void seedStdRandomEngines();
     void stdUniformIntDistribution_data();
@@ -717,6 +718,37 @@ void tst_QRandomGenerator::generateReal()
         QVERIFY_3TIMES(rng.generateDouble() != rng.generateDouble());
 }
 
+void tst_QRandomGenerator::bulkGeneration()
+{
+    // the bulk functions produce the same values as the individual ones
+    QRandomGenerator rng1(1234);
+    QRandomGenerator rng2(1234);
+
+    double doubles[37];
+    rng1.generateDouble(std::begin(doubles), std::end(doubles));
+    for (double d : doubles) {
+        QVERIFY(d >= 0 && d < 1);
+        QCOMPARE(d, rng2.generateDouble());
+    }
+
+    quint32 values[41];
+    rng1.bounded(1000, std::begin(values), std::end(values));
+    for (quint32 v : values) {
+        QVERIFY(v < 1000);
+        QCOMPARE(v, rng2.bounded(1000U));
+    }
+    QCOMPARE(rng1, rng2);
+
+    // empty ranges don't consume anything
+    rng1.generateDouble(doubles, doubles);
+    rng1.bounded(1000, values, values);
+    QCOMPARE(rng1, rng2);
+
+    QRandomGenerator::global()->generateDouble(std::begin(doubles), std::end(doubles));
+    for (double d : doubles)
+        QVERIFY(d >= 0 && d < 1);
+}
+
 void tst_QRandomGenerator::qualityReal()
 {
     QFETCH(uint, control);
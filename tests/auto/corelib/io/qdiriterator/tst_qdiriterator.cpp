@@ -9,6 +9,7 @@
 #include <qdiriterator.h>
 #include <qfileinfo.h>
 #include <qstringlist.h>
+#include <QHash>
 #include <QSet>
 #include <QString>
 
@@ -79,6 +80,7 @@ private slots:
 #endif
     void absoluteFilePathsFromRelativeIteratorPath();
     void recurseWithFilters() const;
+    void symlinkMetaData();
     void longPath();
     void dirorder();
     void relativePaths();
@@ -508,6 +510,45 @@ void tst_QDirIterator::recurseWithFilters() const
     QVERIFY(!it.hasNext());
 }
 
+void tst_QDirIterator::symlinkMetaData()
+{
+#if defined(Q_NO_SYMLINKS) || defined(Q_OS_WIN)
+    QSKIP("Test requires Unix symlinks.");
+#else
+    QHash<QString, QFileInfo> entries;
+    QDirIterator it("entrylist/", QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        const QFileInfo fi = it.nextFileInfo();
+        entries.insert(fi.fileName(), fi);
+    }
+
+    QVERIFY(entries.contains("linktofile.lnk"));
+    const QFileInfo linkToFile = entries.value("linktofile.lnk");
+    QVERIFY(linkToFile.isSymLink());
+    QVERIFY(linkToFile.exists());
+    QVERIFY(linkToFile.isFile());
+    QCOMPARE(linkToFile.size(), QFileInfo("entrylist/file").size());
+
+    QVERIFY(entries.contains("brokenlink.lnk"));
+    const QFileInfo brokenLink = entries.value("brokenlink.lnk");
+    QVERIFY(brokenLink.isSymLink());
+    QVERIFY(!brokenLink.exists());
+    QVERIFY(!brokenLink.isFile());
+    QVERIFY(!brokenLink.isDir());
+
+#  ifndef Q_NO_SYMLINKS_TO_DIRS
+    QVERIFY(entries.contains("linktodirectory.lnk"));
+    const QFileInfo linkToDirectory = entries.value("linktodirectory.lnk");
+    QVERIFY(linkToDirectory.isSymLink());
+    QVERIFY(linkToDirectory.isDir());
+#  endif
+
+    QVERIFY(entries.value("directory").isDir());
+    QVERIFY(!entries.value("directory").isSymLink());
+    QVERIFY(entries.value("file").isFile());
+#endif
+}
+
 void tst_QDirIterator::longPath()
 {
     QDir dir;
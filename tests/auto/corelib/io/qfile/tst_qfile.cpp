@@ -11,6 +11,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
+#include <QBuffer>
 #include <QFile>
 #include <QFileInfo>
 #include <QRandomGenerator>
@@ -256,6 +257,8 @@ private slots:
     void mapOpenMode();
     void mapWrittenFile_data();
     void mapWrittenFile();
+    void readMemoryMapped();
+    void transferTo();
 
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
@@ -3463,6 +3466,109 @@ void tst_QFile::mapWrittenFile()
     file.remove();
 }
 
+void tst_QFile::readMemoryMapped()
+{
+    const QByteArray contents = "first line\nsecond line\n\nlast line without newline";
+    const QString fileName = QDir::currentPath() + '/' + "qfile_memorymapped_testfile";
+    {
+        QFile file(fileName);
+        QVERIFY2(file.open(QIODevice::WriteOnly), msgOpenFailed(file).constData());
+        QCOMPARE(file.write(contents), qint64(contents.size()));
+    }
+
+    QFile file(fileName);
+    const QIODevice::OpenMode om = QIODevice::ReadOnly | QIODevice::MemoryMapped;
+    QVERIFY2(file.open(om), msgOpenFailed(om, file).constData());
+    QCOMPARE(file.openMode(), om);
+
+    // peeking twice hands out the same mapped memory, not two copies
+    QCOMPARE(file.peek(5), QByteArray("first"));
+    QCOMPARE(file.peek(5).constData(), file.peek(5).constData());
+
+    QCOMPARE(file.readLine(), QByteArray("first line\n"));
+    QCOMPARE(file.pos(), qint64(11));
+    char c;
+    QVERIFY(file.getChar(&c));
+    QCOMPARE(c, 's');
+    QCOMPARE(file.read(5), QByteArray("econd"));
+    char buffer[16];
+    QCOMPARE(file.readLine(buffer, sizeof buffer), qint64(6));
+    QCOMPARE(QByteArray(buffer), QByteArray(" line\n"));
+    QCOMPARE(file.readLine(), QByteArray("\n"));
+    QCOMPARE(file.readAll(), QByteArray("last line without newline"));
+    QVERIFY(file.atEnd());
+    QCOMPARE(file.read(1), QByteArray());
+
+    QVERIFY(file.seek(6));
+    QCOMPARE(file.read(buffer, 4), qint64(4));
+    QCOMPARE(QByteArray(buffer, 4), QByteArray("line"));
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.readAll(), contents);
+    file.close();
+
+    // files opened for writing or in text mode are not mapped
+    const QIODevice::OpenMode readWrite = QIODevice::ReadWrite | QIODevice::MemoryMapped;
+    QVERIFY2(file.open(readWrite), msgOpenFailed(readWrite, file).constData());
+    QCOMPARE(file.openMode(), QIODevice::OpenMode(QIODevice::ReadWrite));
+    QCOMPARE(file.readAll(), contents);
+    file.close();
+    const QIODevice::OpenMode text = om | QIODevice::Text;
+    QVERIFY2(file.open(text), msgOpenFailed(text, file).constData());
+    QCOMPARE(file.openMode(), QIODevice::ReadOnly | QIODevice::Text);
+    file.close();
+
+    file.remove();
+}
+
+void tst_QFile::transferTo()
+{
+    QByteArray contents;
+    for (int i = 0; i < 10000; ++i)
+        contents += QByteArray::number(i) + '\n';
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    QFile source(dir.filePath("source"));
+    QVERIFY2(source.open(QIODevice::ReadWrite), msgOpenFailed(source).constData());
+    QCOMPARE(source.write(contents), qint64(contents.size()));
+    QVERIFY(source.seek(0));
+
+    // file to file, in two portions
+    QFile target(dir.filePath("target"));
+    QVERIFY2(target.open(QIODevice::ReadWrite), msgOpenFailed(target).constData());
+    QCOMPARE(target.write("header\n"), qint64(7));
+    QCOMPARE(source.transferTo(&target, 1000), qint64(1000));
+    QCOMPARE(source.pos(), qint64(1000));
+    QCOMPARE(target.pos(), qint64(1007));
+    QCOMPARE(source.transferTo(&target), qint64(contents.size() - 1000));
+    QVERIFY(source.atEnd());
+    QCOMPARE(source.transferTo(&target), qint64(0));
+    QCOMPARE(target.size(), qint64(contents.size() + 7));
+    QVERIFY(target.seek(0));
+    QCOMPARE(target.readAll(), "header\n" + contents);
+    target.close();
+
+    // after data was read into the buffer
+    QVERIFY(source.seek(0));
+    QCOMPARE(source.read(3), contents.left(3));
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(source.transferTo(&buffer), qint64(contents.size() - 3));
+    QCOMPARE(buffer.data(), contents.mid(3));
+
+    // invalid targets
+    const QByteArray warningPrefix = "QIODevice::transferTo (QFile, \""
+            + QDir::toNativeSeparators(source.fileName()).toLocal8Bit() + "\"): ";
+    QTest::ignoreMessage(QtWarningMsg,
+                         (warningPrefix + "Called with an invalid target device").constData());
+    QCOMPARE(source.transferTo(&source), qint64(-1));
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QIODevice::ReadOnly));
+    QTest::ignoreMessage(QtWarningMsg,
+                         (warningPrefix + "Target device is not writable").constData());
+    QCOMPARE(source.transferTo(&readOnly), qint64(-1));
+}
+
 void tst_QFile::openDirectory()
 {
     QFile f1(m_resourcesDir);
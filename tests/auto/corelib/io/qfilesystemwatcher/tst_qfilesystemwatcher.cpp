@@ -66,6 +66,7 @@ private slots:
     void signalsEmittedAfterFileMoved();
 
     void watchUnicodeCharacters();
+    void coalesceChanges();
 #if defined(Q_OS_WIN)
     void watchDirectoryAttributeChanges();
 #endif
@@ -817,6 +818,52 @@ void tst_QFileSystemWatcher::watchUnicodeCharacters()
     QTRY_COMPARE(changedSpy.count(), 1);
 }
 
+void tst_QFileSystemWatcher::coalesceChanges()
+{
+    using namespace std::chrono_literals;
+
+    QTemporaryDir temporaryDirectory(m_tempDirPattern);
+    QVERIFY2(temporaryDirectory.isValid(), qPrintable(temporaryDirectory.errorString()));
+
+    QDir testDir(temporaryDirectory.path());
+    QFile testFile(testDir.filePath("testfile.txt"));
+    QVERIFY(testFile.open(QIODevice::WriteOnly));
+    testFile.close();
+
+    QFileSystemWatcher watcher;
+    QCOMPARE(watcher.coalescingInterval(), 0ms);
+    watcher.setCoalescingInterval(300ms);
+    QCOMPARE(watcher.coalescingInterval(), 300ms);
+    QVERIFY(watcher.addPath(testDir.path()));
+    QVERIFY(watcher.addPath(testFile.fileName()));
+
+    QSignalSpy fileChangedSpy(&watcher, &QFileSystemWatcher::fileChanged);
+    QSignalSpy filesChangedSpy(&watcher, &QFileSystemWatcher::filesChanged);
+    QSignalSpy directoryChangedSpy(&watcher, &QFileSystemWatcher::directoryChanged);
+    QSignalSpy directoriesChangedSpy(&watcher, &QFileSystemWatcher::directoriesChanged);
+
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(testDir.mkdir(QString::number(i)));
+        QVERIFY(testFile.open(QIODevice::WriteOnly | QIODevice::Append));
+        testFile.write("hello\n");
+        testFile.close();
+    }
+
+    QTRY_COMPARE(filesChangedSpy.size(), 1);
+    QTRY_COMPARE(directoriesChangedSpy.size(), 1);
+    QCOMPARE(filesChangedSpy.at(0).at(0).toStringList(), QStringList(testFile.fileName()));
+    QCOMPARE(directoriesChangedSpy.at(0).at(0).toStringList(), QStringList(testDir.path()));
+    QCOMPARE(fileChangedSpy.size(), 1);
+    QCOMPARE(directoryChangedSpy.size(), 1);
+
+    // with coalescing disabled, every change is reported on its own again
+    watcher.setCoalescingInterval(0ms);
+    QVERIFY(testDir.rmdir("0"));
+    QTRY_COMPARE(directoriesChangedSpy.size(), 2);
+    QCOMPARE(directoriesChangedSpy.at(1).at(0).toStringList(), QStringList(testDir.path()));
+    QCOMPARE(directoryChangedSpy.size(), 2);
+}
+
 #if defined(Q_OS_WIN)
 void tst_QFileSystemWatcher::watchDirectoryAttributeChanges()
 {
@@ -491,6 +491,26 @@ private slots:
         usedefaultformat = false;
     }
 
+    void rateLimit()
+    {
+        QLoggingCategory cat("tst.ratelimit");
+        QCOMPARE(cat.rateLimit(), 0);
+        cat.setRateLimit(3);
+        QCOMPARE(cat.rateLimit(), 3);
+
+        // arguments of suppressed messages must not be evaluated
+        int evaluated = 0;
+        for (int i = 0; i < 10; ++i)
+            qCDebug(cat) << ++evaluated;
+        QCOMPARE(evaluated, 3);
+        QCOMPARE(logMessage, QStringLiteral("tst.ratelimit.debug: 3"));
+
+        cat.setRateLimit(0);
+        QCOMPARE(cat.rateLimit(), 0);
+        qCDebug(cat) << "unlimited";
+        QCOMPARE(logMessage, QStringLiteral("tst.ratelimit.debug: unlimited"));
+    }
+
     // Check the Debug, Info, Warning and critical without having category active. should be active.
     void checkNoCategoryLogActive()
     {
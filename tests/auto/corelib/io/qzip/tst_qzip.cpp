@@ -4,6 +4,7 @@
 #include <QTest>
 #include <QDebug>
 #include <QBuffer>
+#include <QRandomGenerator>
 
 #include <private/qzipwriter_p.h>
 #include <private/qzipreader_p.h>
@@ -17,6 +18,7 @@ private slots:
     void symlinks();
     void readTest();
     void createArchive();
+    void createLargeArchive();
 };
 
 void tst_QZip::basicUnpack()
@@ -112,5 +114,34 @@ void tst_QZip::createArchive()
     QCOMPARE(zip2.fileData("My Filename"), fileContents);
 }
 
+void tst_QZip::createLargeArchive()
+{
+    // large enough to be compressed in chunks, which must make up a single
+    // deflate stream, with chunks that repeat earlier data and chunks that
+    // don't compress
+    QByteArray text;
+    for (int i = 0; text.size() < 3 * 1024 * 1024; ++i)
+        text += "line " + QByteArray::number(i % 1000) + " of some compressible text\n";
+    QByteArray noise(2 * 1024 * 1024 + 17, Qt::Uninitialized);
+    QRandomGenerator generator(42);
+    for (char &c : noise)
+        c = char(generator.bounded(256));
+    const QByteArray mixed = text + noise + text.left(1024 * 1024);
+
+    QBuffer buffer;
+    QZipWriter zip(&buffer);
+    zip.addFile("text", text);
+    zip.addFile("mixed", mixed);
+    zip.close();
+    QByteArray zipFile = buffer.buffer();
+    QVERIFY(zipFile.size() < text.size() / 4 + mixed.size());
+
+    QBuffer buffer2(&zipFile);
+    QZipReader zip2(&buffer2);
+    QCOMPARE(zip2.count(), 2);
+    QCOMPARE(zip2.fileData("text"), text);
+    QCOMPARE(zip2.fileData("mixed"), mixed);
+}
+
 QTEST_MAIN(tst_QZip)
 #include "tst_qzip.moc"
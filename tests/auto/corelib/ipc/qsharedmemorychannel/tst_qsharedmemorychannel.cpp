@@ -0,0 +1,184 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QtCore/qthread.h>
+
+#include <QtCore/private/qsharedmemorychannel_p.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void createAndAttach();
+    void attachMissing();
+    void sendAndReceive();
+    void emptyMessage();
+    void tooLarge();
+    void full();
+    void wrapAround();
+    void threads();
+
+private:
+    QString name;
+    int seq = 0;
+};
+
+void tst_QSharedMemoryChannel::init()
+{
+    name = u"tstshmchannel_%1-%2"_s.arg(QCoreApplication::applicationPid()).arg(++seq);
+}
+
+void tst_QSharedMemoryChannel::createAndAttach()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(1000), qPrintable(producer.errorString()));
+    QVERIFY(producer.isValid());
+    QCOMPARE(producer.capacity(), 1000);
+    QCOMPARE(producer.maxMessageSize(), 492);
+
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+    QCOMPARE(consumer.capacity(), producer.capacity());
+
+    // the capacity is rounded up
+    QSharedMemoryChannel other(name + u"-other"_s);
+    QVERIFY2(other.create(1001), qPrintable(other.errorString()));
+    QCOMPARE(other.capacity(), 1008);
+}
+
+void tst_QSharedMemoryChannel::attachMissing()
+{
+    QSharedMemoryChannel consumer(name);
+    QVERIFY(!consumer.attach());
+    QVERIFY(!consumer.isValid());
+    QVERIFY(!consumer.errorString().isEmpty());
+}
+
+void tst_QSharedMemoryChannel::sendAndReceive()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(4096), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    QByteArrayView message;
+    QVERIFY(!consumer.tryPeek(&message));
+
+    QVERIFY(producer.send("hello"));
+    QVERIFY(producer.trySend("world!"));
+
+    QVERIFY(consumer.tryPeek(&message));
+    QCOMPARE(message, "hello");
+    // peeking again returns the same message
+    QCOMPARE(consumer.peek(), "hello");
+    consumer.pop();
+    QCOMPARE(consumer.receive(), "world!");
+    QVERIFY(!consumer.tryPeek(&message));
+}
+
+void tst_QSharedMemoryChannel::emptyMessage()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(4096), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    QVERIFY(producer.send({}));
+    QVERIFY(producer.send("x"));
+
+    const QByteArrayView message = consumer.peek();
+    QVERIFY(!message.isNull());
+    QVERIFY(message.isEmpty());
+    consumer.pop();
+    QCOMPARE(consumer.receive(), "x");
+}
+
+void tst_QSharedMemoryChannel::tooLarge()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(256), qPrintable(producer.errorString()));
+
+    QVERIFY(producer.send(QByteArray(producer.maxMessageSize(), 'a')));
+    QVERIFY(!producer.send(QByteArray(producer.maxMessageSize() + 1, 'a')));
+    QVERIFY(!producer.errorString().isEmpty());
+}
+
+void tst_QSharedMemoryChannel::full()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(64), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    // frames of 16 bytes
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(producer.trySend(QByteArray(8, 'a' + i)));
+    QVERIFY(!producer.trySend("e"));
+
+    QCOMPARE(consumer.receive(), QByteArray(8, 'a'));
+    QVERIFY(producer.trySend("e"));
+    QVERIFY(!producer.trySend("f"));
+}
+
+void tst_QSharedMemoryChannel::wrapAround()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(128), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    // messages of all sizes end up at all offsets of the ring, and some
+    // don't fit before its end
+    for (int round = 0; round < 200; ++round) {
+        const QByteArray message(round % (producer.maxMessageSize() + 1), char('a' + round % 26));
+        QVERIFY(producer.trySend(message));
+        QCOMPARE(consumer.receive(), message);
+    }
+}
+
+void tst_QSharedMemoryChannel::threads()
+{
+    QSharedMemoryChannel producer(name);
+    QVERIFY2(producer.create(1024), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(name);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    // the ring is much smaller than the data, so both sides have to wait
+    // for each other
+    constexpr int MessageCount = 20000;
+    auto messageFor = [](int i) {
+        return QByteArray::number(i).repeated(i % 50);
+    };
+
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        for (int i = 0; i < MessageCount; ++i) {
+            if (!producer.send(messageFor(i)))
+                return;
+        }
+    }));
+    thread->start();
+
+    // drain the channel before checking, so the producer doesn't block
+    int firstMismatch = -1;
+    QByteArray mismatch;
+    for (int i = 0; i < MessageCount; ++i) {
+        QByteArray message = consumer.receive();
+        if (firstMismatch < 0 && message != messageFor(i)) {
+            firstMismatch = i;
+            mismatch = std::move(message);
+        }
+    }
+    QVERIFY(thread->wait());
+    if (firstMismatch >= 0)
+        QCOMPARE(mismatch, messageFor(firstMismatch));
+}
+
+QTEST_MAIN(tst_QSharedMemoryChannel)
+
+#include "tst_qsharedmemorychannel.moc"
@@ -17,6 +17,7 @@
 
 #include <array>
 #include <vector>
+#include <vector>
 #include <deque>
 #include <list>
 
@@ -97,6 +98,7 @@ private slots:
     void modelRoleDataSpan();
 
     void multiData();
+    void multiDataForRange();
 private:
     DynamicTreeModel *m_model;
 };
@@ -2504,5 +2506,57 @@ void tst_QAbstractItemModel::multiData()
     check();
 }
 
+class CellTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    int rowCount(const QModelIndex &) const override { return 10; }
+    int columnCount(const QModelIndex &) const override { return 5; }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        Q_ASSERT(checkIndex(index, CheckIndexOption::IndexIsValid));
+        if (role == Qt::DisplayRole)
+            return index.row() * 100 + index.column();
+        if (role == Qt::ToolTipRole)
+            return QStringLiteral("%1,%2").arg(index.row()).arg(index.column());
+        return QVariant();
+    }
+};
+
+void tst_QAbstractItemModel::multiDataForRange()
+{
+    CellTableModel model;
+    const int rows = 3;
+    const int columns = 2;
+    std::vector<QModelRoleData> data;
+    for (int item = 0; item < rows * columns; ++item) {
+        data.emplace_back(Qt::DisplayRole);
+        data.emplace_back(Qt::ToolTipRole);
+        data.emplace_back(Qt::DecorationRole);
+    }
+    // stale data from a previous call must be cleared
+    data[2].setData(42);
+
+    model.multiDataForRange(model.index(4, 1), model.index(4 + rows - 1, 1 + columns - 1), data);
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            const QModelIndex index = model.index(4 + row, 1 + column);
+            const QModelRoleData *item = &data[(row * columns + column) * 3];
+            QCOMPARE(item[0].data(), index.data(Qt::DisplayRole));
+            QCOMPARE(item[1].data(), index.data(Qt::ToolTipRole));
+            QVERIFY(item[2].data().isNull());
+        }
+    }
+    QCOMPARE(data.front().data().toInt(), 401);
+    QCOMPARE(data.back().role(), int(Qt::DecorationRole));
+
+    // a single item
+    QModelRoleData single[] = { QModelRoleData(Qt::ToolTipRole) };
+    model.multiDataForRange(model.index(9, 4), model.index(9, 4), single);
+    QCOMPARE(single[0].data().toString(), QStringLiteral("9,4"));
+}
+
 QTEST_MAIN(tst_QAbstractItemModel)
 #include "tst_qabstractitemmodel.moc"
@@ -80,6 +80,8 @@ private slots:
 
     void QTBUG93305();
 
+    void manyDisjointRanges();
+
 private:
     QAbstractItemModel *model;
     QItemSelectionModel *selection;
@@ -2916,6 +2918,55 @@ void tst_QItemSelectionModel::QTBUG93305()
     QVERIFY(selection->hasSelection());
     QCOMPARE(spy.size(), 4);
 }
+void tst_QItemSelectionModel::manyDisjointRanges()
+{
+    QStandardItemModel model(300, 2);
+    const auto isExpectedSelected = [](int row) { return row % 3 == 0; };
+
+    // connected before the selection model, so it sees the moved
+    // persistent indexes before the selection model is told about them
+    QItemSelectionModel *observed = nullptr;
+    QList<bool> selectedWhenRemoved;
+    connect(&model, &QAbstractItemModel::rowsRemoved, this, [&] {
+        for (int row = 0; row < model.rowCount(); ++row)
+            selectedWhenRemoved.append(observed->isSelected(model.index(row, 1)));
+    });
+
+    QItemSelectionModel selectionModel(&model);
+    observed = &selectionModel;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        if (isExpectedSelected(row))
+            selectionModel.select(model.index(row, 0), QItemSelectionModel::Select | QItemSelectionModel::Rows);
+    }
+    QCOMPARE(selectionModel.selection().size(), 100);
+    for (int row = 0; row < model.rowCount(); ++row) {
+        QCOMPARE(selectionModel.isSelected(model.index(row, 0)), isExpectedSelected(row));
+        QCOMPARE(selectionModel.isSelected(model.index(row, 1)), isExpectedSelected(row));
+    }
+
+    QSignalSpy spy(&selectionModel, &QItemSelectionModel::selectionChanged);
+    selectionModel.select(model.index(150, 0), QItemSelectionModel::Toggle | QItemSelectionModel::Rows);
+    QCOMPARE(spy.size(), 1);
+    QCOMPARE(spy.at(0).at(0).value<QItemSelection>(), QItemSelection());
+    QCOMPARE(spy.at(0).at(1).value<QItemSelection>(),
+             QItemSelection(model.index(150, 0), model.index(150, 1)));
+    QVERIFY(!selectionModel.isSelected(model.index(150, 1)));
+    selectionModel.select(model.index(150, 0), QItemSelectionModel::Toggle | QItemSelectionModel::Rows);
+    QVERIFY(selectionModel.isSelected(model.index(150, 1)));
+
+    // the selected rows move up by one
+    QVERIFY(model.removeRows(0, 1));
+    QCOMPARE(selectedWhenRemoved.size(), model.rowCount());
+    for (int row = 0; row < model.rowCount(); ++row) {
+        QCOMPARE(selectionModel.isSelected(model.index(row, 1)), isExpectedSelected(row + 1));
+        QCOMPARE(selectedWhenRemoved.at(row), isExpectedSelected(row + 1));
+    }
+
+    // and down by one again
+    QVERIFY(model.insertRows(0, 1));
+    for (int row = 1; row < model.rowCount(); ++row)
+        QCOMPARE(selectionModel.isSelected(model.index(row, 1)), isExpectedSelected(row));
+}
 
 QTEST_MAIN(tst_QItemSelectionModel)
 #include "tst_qitemselectionmodel.moc"
@@ -8,6 +8,7 @@
 #include <QComboBox>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
+#include <QScopeGuard>
 #include <QStringListModel>
 #include <QTableView>
 #include <QTreeView>
@@ -2835,6 +2836,36 @@ void tst_QSortFilterProxyModel::sortStable()
     QCOMPARE(lastItemData, filterModel->index(2,0, firstRoot).data());
 }
 
+void tst_QSortFilterProxyModel::sortLocaleAware()
+{
+    const auto restoreLocale = qScopeGuard([original = QLocale()] {
+        QLocale::setDefault(original);
+    });
+    QLocale::setDefault(QLocale(QLocale::Swedish, QLocale::Sweden));
+
+    QStringList strings = { "\u00e4", "z", "", "a", "\u00e5", "A", "o", "", "\u00f6", "b" };
+    QStringListModel model(strings);
+    QSortFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    proxy.setSortLocaleAware(true);
+
+    std::stable_sort(strings.begin(), strings.end(), [](const QString &s1, const QString &s2) {
+        return s1.localeAwareCompare(s2) < 0;
+    });
+    proxy.sort(0, Qt::AscendingOrder);
+    QStringList sorted;
+    for (int row = 0; row < proxy.rowCount(); ++row)
+        sorted.append(proxy.index(row, 0).data().toString());
+    QCOMPARE(sorted, strings);
+
+    std::reverse(strings.begin(), strings.end());
+    proxy.sort(0, Qt::DescendingOrder);
+    sorted.clear();
+    for (int row = 0; row < proxy.rowCount(); ++row)
+        sorted.append(proxy.index(row, 0).data().toString());
+    QCOMPARE(sorted, strings);
+}
+
 void tst_QSortFilterProxyModel::hiddenColumns()
 {
     class MyStandardItemModel : public QStandardItemModel
@@ -5361,6 +5392,14 @@ void tst_QSortFilterProxyModel::autoAcceptChildRowsBinding()
                                                                            "autoAcceptChildRows");
 }
 
+void tst_QSortFilterProxyModel::concurrentSortFilterBinding()
+{
+    QSortFilterProxyModel proxyModel;
+    QCOMPARE(proxyModel.concurrentSortFilter(), false);
+    QTestPrivate::testReadWritePropertyBasics<QSortFilterProxyModel, bool>(proxyModel, true, false,
+                                                                           "concurrentSortFilter");
+}
+
 void tst_QSortFilterProxyModel::filterCaseSensitivityBinding()
 {
     QSortFilterProxyModel proxyModel;
@@ -5493,5 +5532,52 @@ void tst_QSortFilterProxyModel::createPersistentOnLayoutAboutToBeChanged() // QT
     QCOMPARE(layoutChangedSpy.size(), 1);
 }
 
+void tst_QSortFilterProxyModel::concurrentSortFilter()
+{
+    // enough rows to be split into several tasks
+    QStringList strings;
+    for (int i = 0; i < 50000; ++i)
+        strings.append(QString::number((i * 7919) % 1000));
+    QStringListModel model(strings);
+
+    QSortFilterProxyModel serial;
+    serial.setSourceModel(&model);
+    QSortFilterProxyModel concurrent;
+    concurrent.setConcurrentSortFilter(true);
+    concurrent.setSourceModel(&model);
+
+    const auto compareRows = [&]() {
+        QCOMPARE(concurrent.rowCount(), serial.rowCount());
+        for (int row = 0; row < serial.rowCount(); ++row) {
+            // sorting is stable, so equal strings must keep their source order
+            QCOMPARE(concurrent.mapToSource(concurrent.index(row, 0)),
+                     serial.mapToSource(serial.index(row, 0)));
+        }
+    };
+
+    for (QSortFilterProxyModel *proxy : {&serial, &concurrent})
+        proxy->setFilterRegularExpression("1");
+    compareRows();
+    QVERIFY(concurrent.rowCount() < model.rowCount());
+
+    for (QSortFilterProxyModel *proxy : {&serial, &concurrent})
+        proxy->sort(0);
+    compareRows();
+
+    QSignalSpy layoutChangedSpy(&concurrent, &QAbstractItemModel::layoutChanged);
+    for (QSortFilterProxyModel *proxy : {&serial, &concurrent})
+        proxy->sort(0, Qt::DescendingOrder);
+    compareRows();
+    QCOMPARE(layoutChangedSpy.size(), 1);
+
+    for (QSortFilterProxyModel *proxy : {&serial, &concurrent})
+        proxy->setFilterRegularExpression("^[23]");
+    compareRows();
+
+    for (QSortFilterProxyModel *proxy : {&serial, &concurrent})
+        proxy->invalidate();
+    compareRows();
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 #include "tst_qsortfilterproxymodel.moc"
@@ -89,6 +89,7 @@ private slots:
     void sortColumnTracking2();
 
     void sortStable();
+    void sortLocaleAware();
 
     void hiddenColumns();
     void insertRowsSort();
@@ -150,9 +151,12 @@ private slots:
     void filterRoleBinding();
     void recursiveFilteringEnabledBinding();
     void autoAcceptChildRowsBinding();
+    void concurrentSortFilterBinding();
     void filterCaseSensitivityBinding();
     void filterRegularExpressionBinding();
 
+    void concurrentSortFilter();
+
 protected:
     void buildHierarchy(const QStringList &data, QAbstractItemModel *model);
     void checkHierarchy(const QStringList &data, const QAbstractItemModel *model);
@@ -17,6 +17,12 @@
 #include <QtCore/qt_windows.h>
 #endif
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
 typedef QCoreApplication TestApplication;
 
 class EventSpy : public QObject
@@ -511,6 +517,141 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+// Checks that the calls posted by each thread arrive in the order they were
+// posted, and exactly once.
+class QueuedCallRecorder
+{
+public:
+    explicit QueuedCallRecorder(int producers) : next(producers, 0) { }
+
+    void record(int producer, int sequence)
+    {
+        QMutexLocker locker(&mutex);
+        if (next[producer] != sequence)
+            ++outOfOrder;
+        next[producer] = sequence + 1;
+        ++total;
+    }
+
+    QMutex mutex;
+    QList<int> next;
+    int outOfOrder = 0;
+    int total = 0;
+};
+
+static void postQueuedCalls(QObject *receiver, QueuedCallRecorder *recorder, int producers,
+                            int callsPerProducer, std::atomic<int> *wrongThread = nullptr)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back(QThread::create([=] {
+            for (int i = 0; i < callsPerProducer; ++i) {
+                QMetaObject::invokeMethod(receiver, [=] {
+                    if (wrongThread && receiver->thread() != QThread::currentThread())
+                        ++*wrongThread;
+                    recorder->record(producer, i);
+                }, Qt::QueuedConnection);
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+}
+
+void tst_QCoreApplication::queuedCallsFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int Producers = 8;
+    constexpr int CallsPerProducer = 5000;
+    QObject receiver;
+    QueuedCallRecorder recorder(Producers);
+
+    // post while the receiver's thread is busy delivering
+    std::unique_ptr<QThread> poster(QThread::create(postQueuedCalls, &receiver, &recorder,
+                                                    Producers, CallsPerProducer, nullptr));
+    poster->start();
+    QTRY_COMPARE(recorder.total, Producers * CallsPerProducer);
+    QVERIFY(poster->wait());
+    QCOMPARE(recorder.outOfOrder, 0);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(recorder.total, Producers * CallsPerProducer);
+}
+
+class PriorityRecorder : public QObject
+{
+public:
+    QStringList delivered;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::User) {
+            delivered << u"high"_s;
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+void tst_QCoreApplication::queuedCallsAndPriorities()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    PriorityRecorder receiver;
+    std::unique_ptr<QThread> poster(QThread::create([&receiver] {
+        for (int i = 0; i < 3; ++i) {
+            QMetaObject::invokeMethod(&receiver, [&receiver, i] {
+                receiver.delivered << QString::number(i);
+            }, Qt::QueuedConnection);
+        }
+    }));
+    poster->start();
+    QVERIFY(poster->wait());
+
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User), Qt::HighEventPriority);
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User), Qt::LowEventPriority - 1);
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.delivered, QStringList({ u"high"_s, u"0"_s, u"1"_s, u"2"_s, u"high"_s }));
+}
+
+void tst_QCoreApplication::queuedCallsDuringMoveToThread()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int Producers = 4;
+    constexpr int CallsPerProducer = 5000;
+    QObject *receiver = new QObject;
+    QueuedCallRecorder recorder(Producers);
+    std::atomic<int> wrongThread = 0;
+
+    QThread worker;
+    worker.start();
+    std::unique_ptr<QThread> poster(QThread::create(postQueuedCalls, receiver, &recorder,
+                                                    Producers, CallsPerProducer, &wrongThread));
+    poster->start();
+    QTRY_VERIFY([&] { QMutexLocker locker(&recorder.mutex); return recorder.total > 0; }());
+    receiver->moveToThread(&worker);
+    QVERIFY(poster->wait());
+
+    QTRY_COMPARE([&] { QMutexLocker locker(&recorder.mutex); return recorder.total; }(),
+                 Producers * CallsPerProducer);
+    QCOMPARE(recorder.outOfOrder, 0);
+    QCOMPARE(wrongThread.load(), 0);
+
+    QObject::connect(receiver, &QObject::destroyed, &worker, &QThread::quit, Qt::DirectConnection);
+    receiver->deleteLater();
+    QVERIFY(worker.wait());
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -20,6 +20,9 @@ private slots:
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void queuedCallsFromManyThreads();
+    void queuedCallsAndPriorities();
+    void queuedCallsDuringMoveToThread();
 #endif
     void applicationPid();
 #ifdef QT_BUILD_INTERNAL
@@ -0,0 +1,152 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoopStatistics>
+#include <QtCore/QThread>
+#include <QTest>
+
+#include <numeric>
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    int received = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::User) {
+            ++received;
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+class tst_QEventLoopStatistics : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void empty();
+    void disabled();
+    void postedEvents();
+    void processEvents();
+    void reset();
+    void latencyBuckets();
+};
+
+void tst_QEventLoopStatistics::init()
+{
+    QCoreApplication::sendPostedEvents();
+    QEventLoopStatistics::reset(QThread::currentThread());
+}
+
+void tst_QEventLoopStatistics::cleanup()
+{
+    QEventLoopStatistics::setEnabled(false);
+}
+
+void tst_QEventLoopStatistics::empty()
+{
+    QEventLoopStatistics statistics;
+    QVERIFY(statistics.eventTypes().isEmpty());
+    QVERIFY(statistics.latencyHistogram(QEvent::User).isEmpty());
+    QCOMPARE(statistics.deliveredEventCount(QEvent::User), 0u);
+    QVERIFY(statistics.receiverClasses().isEmpty());
+    QCOMPARE(statistics.receiverEventCount("QObject"), 0u);
+    QCOMPARE(statistics.wakeUpCount(), 0u);
+    QCOMPARE(statistics.processEventsCount(), 0u);
+    QCOMPARE(statistics.processEventsTime(), std::chrono::nanoseconds(0));
+    QCOMPARE(statistics.maximumQueueDepth(), 0);
+
+    statistics = QEventLoopStatistics::forThread(nullptr);
+    QVERIFY(statistics.eventTypes().isEmpty());
+}
+
+void tst_QEventLoopStatistics::disabled()
+{
+    QVERIFY(!QEventLoopStatistics::isEnabled());
+
+    Receiver receiver;
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, 1);
+
+    const auto statistics = QEventLoopStatistics::forThread(QThread::currentThread());
+    QVERIFY(statistics.eventTypes().isEmpty());
+    QCOMPARE(statistics.receiverEventCount("Receiver"), 0u);
+}
+
+void tst_QEventLoopStatistics::postedEvents()
+{
+    QEventLoopStatistics::setEnabled(true);
+    QVERIFY(QEventLoopStatistics::isEnabled());
+
+    Receiver receiver;
+    for (int i = 0; i < 5; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(receiver.received, 5);
+
+    const auto statistics = QEventLoopStatistics::forThread(QThread::currentThread());
+    QCOMPARE(statistics.eventTypes(), QList<int>{ QEvent::User });
+    const QList<quint64> histogram = statistics.latencyHistogram(QEvent::User);
+    QCOMPARE(histogram.size(), QEventLoopStatistics::LatencyBucketCount);
+    QCOMPARE(std::accumulate(histogram.cbegin(), histogram.cend(), quint64(0)), 5u);
+    QCOMPARE(statistics.deliveredEventCount(QEvent::User), 5u);
+
+    QVERIFY(statistics.receiverClasses().contains("Receiver"));
+    QCOMPARE(statistics.receiverEventCount("Receiver"), 5u);
+    QVERIFY(statistics.receiverTime("Receiver") >= std::chrono::nanoseconds(0));
+    QVERIFY(statistics.maximumQueueDepth() >= 5);
+    QVERIFY(statistics.wakeUpCount() >= 5);
+}
+
+void tst_QEventLoopStatistics::processEvents()
+{
+    QEventLoopStatistics::setEnabled(true);
+
+    QCoreApplication::processEvents();
+    QEventLoop loop;
+    loop.processEvents();
+
+    const auto statistics = QEventLoopStatistics::forThread(QThread::currentThread());
+    QCOMPARE(statistics.processEventsCount(), 2u);
+}
+
+void tst_QEventLoopStatistics::reset()
+{
+    QEventLoopStatistics::setEnabled(true);
+
+    Receiver receiver;
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QCoreApplication::sendPostedEvents(&receiver);
+
+    auto statistics = QEventLoopStatistics::forThread(QThread::currentThread());
+    QCOMPARE(statistics.deliveredEventCount(QEvent::User), 1u);
+
+    QEventLoopStatistics::reset(QThread::currentThread());
+    // earlier snapshots are not affected
+    QCOMPARE(statistics.deliveredEventCount(QEvent::User), 1u);
+    statistics = QEventLoopStatistics::forThread(QThread::currentThread());
+    QCOMPARE(statistics.deliveredEventCount(QEvent::User), 0u);
+    QCOMPARE(statistics.receiverEventCount("Receiver"), 0u);
+}
+
+void tst_QEventLoopStatistics::latencyBuckets()
+{
+    using namespace std::chrono_literals;
+    QCOMPARE(QEventLoopStatistics::latencyBucketUpperBound(0), 1us);
+    QCOMPARE(QEventLoopStatistics::latencyBucketUpperBound(1), 2us);
+    QCOMPARE(QEventLoopStatistics::latencyBucketUpperBound(10), 1024us);
+    QCOMPARE(QEventLoopStatistics::latencyBucketUpperBound(QEventLoopStatistics::LatencyBucketCount - 1),
+             std::chrono::microseconds::max());
+}
+
+QTEST_MAIN(tst_QEventLoopStatistics)
+#include "tst_qeventloopstatistics.moc"
@@ -331,6 +331,7 @@ private slots:
     void firstMethod();
 
     void indexOfMethodPMF();
+    void indexOfInHierarchy();
 
     void signalOffset_data();
     void signalOffset();
@@ -2500,8 +2501,12 @@ void tst_QMetaObject::indexOfMethod()
     int idx = object->metaObject()->indexOfMethod(name);
     QVERIFY(idx >= 0);
     QCOMPARE(object->metaObject()->method(idx).methodSignature(), name);
-    QCOMPARE(object->metaObject()->indexOfSlot(name), isSignal ? -1 : idx);
-    QCOMPARE(object->metaObject()->indexOfSignal(name), !isSignal ? -1 : idx);
+    // the second lookups are answered from the cache
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(object->metaObject()->indexOfMethod(name), idx);
+        QCOMPARE(object->metaObject()->indexOfSlot(name), isSignal ? -1 : idx);
+        QCOMPARE(object->metaObject()->indexOfSignal(name), !isSignal ? -1 : idx);
+    }
 }
 
 class Base : public QObject {
@@ -2518,6 +2523,26 @@ public slots:
     int test() {return 1;}
 };
 
+void tst_QMetaObject::indexOfInHierarchy()
+{
+    const QMetaObject &derived = Derived::staticMetaObject;
+    const QMetaObject &base = Base::staticMetaObject;
+
+    // the same names are cached separately for each class
+    for (int i = 0; i < 2; ++i) {
+        const int derivedTest = derived.indexOfMethod("test()");
+        const int baseTest = base.indexOfSlot("test()");
+        QVERIFY(derivedTest >= derived.methodOffset());
+        QVERIFY(baseTest >= base.methodOffset());
+        QVERIFY(baseTest < derived.methodOffset());
+        QCOMPARE(derived.indexOfSlot("baseOnly()"), base.indexOfSlot("baseOnly()"));
+        QCOMPARE(derived.indexOfSignal("test()"), -1);
+        QCOMPARE(derived.indexOfMethod("test( )"), -1);
+        QCOMPARE(derived.indexOfProperty("objectName"), 0);
+        QCOMPARE(derived.indexOfProperty("objectNam"), -1);
+    }
+}
+
 void tst_QMetaObject::firstMethod_data()
 {
     QTest::addColumn<QByteArray>("name");
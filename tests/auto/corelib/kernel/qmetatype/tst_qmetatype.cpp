@@ -696,6 +696,11 @@ void tst_QMetaType::type_fromSubString_data()
     QTest::newRow("intbool") << 0 << 7 << 0;
     QTest::newRow("QMetaType::Type") << 7 << 15 << ::qMetaTypeId<QMetaType::Type>();
     QTest::newRow("double") << 22 << 6 << int(QMetaType::Double);
+    // neighbours of static type names in the sorted lookup table
+    QTest::newRow("in") << 0 << 2 << 0;
+    QTest::newRow("intb") << 0 << 4 << 0;
+    QTest::newRow("ool") << 4 << 3 << 0;
+    QTest::newRow("doublexxx") << 22 << 9 << 0;
 }
 
 void tst_QMetaType::type_fromSubString()
@@ -89,6 +89,7 @@ private slots:
     void qobjectConstCast();
     void uniqConnection();
     void uniqConnectionPtr();
+    void manyReceivers();
     void interfaceIid();
     void deleteQObjectWhenDeletingEvent();
     void overloads();
@@ -146,6 +147,9 @@ private slots:
     void functorReferencesConnection();
     void disconnectDisconnects();
     void singleShotConnection();
+    void batchedConnection();
+    void coalescedConnection();
+    void batchedConnectionAcrossThreads();
     void objectNameBinding();
     void emitToDestroyedClass();
     void declarativeData();
@@ -3621,6 +3625,55 @@ void tst_QObject::uniqConnectionPtr()
     QCOMPARE(r2.sequence_slot4, 2);
 }
 
+void tst_QObject::manyReceivers()
+{
+    // enough receivers for the sender to index its connections
+    constexpr int ReceiverCount = 200;
+    SenderObject s;
+    QList<ReceiverObject *> receivers;
+    for (int i = 0; i < ReceiverCount; ++i) {
+        receivers.append(new ReceiverObject);
+        receivers.last()->reset();
+    }
+    const auto cleanup = qScopeGuard([&] { qDeleteAll(receivers); });
+
+    for (ReceiverObject *r : std::as_const(receivers)) {
+        QVERIFY(connect(&s, &SenderObject::signal1, r, &ReceiverObject::slot1,
+                        Qt::UniqueConnection));
+        QVERIFY(connect(&s, SIGNAL(signal2()), r, SLOT(slot2()), Qt::UniqueConnection));
+    }
+    for (ReceiverObject *r : std::as_const(receivers)) {
+        QVERIFY(!connect(&s, &SenderObject::signal1, r, &ReceiverObject::slot1,
+                         Qt::UniqueConnection));
+        QVERIFY(!connect(&s, SIGNAL(signal2()), r, SLOT(slot2()), Qt::UniqueConnection));
+    }
+    QVERIFY(connect(&s, &SenderObject::signal1, receivers.at(1), &ReceiverObject::slot1));
+
+    QVERIFY(disconnect(&s, &SenderObject::signal1, receivers.at(0), &ReceiverObject::slot1));
+    QVERIFY(!disconnect(&s, &SenderObject::signal1, receivers.at(0), &ReceiverObject::slot1));
+    QVERIFY(disconnect(&s, SIGNAL(signal2()), receivers.at(2), SLOT(slot2())));
+    QVERIFY(!disconnect(&s, &SenderObject::signal3, receivers.at(3), nullptr));
+    delete receivers.takeLast();
+
+    s.emitSignal1();
+    s.emitSignal2();
+    QCOMPARE(receivers.at(0)->count_slot1, 0);
+    QCOMPARE(receivers.at(0)->count_slot2, 1);
+    QCOMPARE(receivers.at(1)->count_slot1, 2);
+    QCOMPARE(receivers.at(2)->count_slot2, 0);
+    for (int i = 3; i < receivers.size(); ++i) {
+        QCOMPARE(receivers.at(i)->count_slot1, 1);
+        QCOMPARE(receivers.at(i)->count_slot2, 1);
+    }
+
+    // the connections can be made again once they are gone
+    QVERIFY(s.disconnect(receivers.at(3)));
+    QVERIFY(connect(&s, &SenderObject::signal1, receivers.at(3), &ReceiverObject::slot1,
+                    Qt::UniqueConnection));
+    QVERIFY(connect(&s, &SenderObject::signal1, receivers.at(0), &ReceiverObject::slot1,
+                    Qt::UniqueConnection));
+}
+
 void tst_QObject::interfaceIid()
 {
     QCOMPARE(QByteArray(qobject_interface_iid<Foo::Bleh *>()),
@@ -8191,6 +8244,118 @@ void tst_QObject::singleShotConnection()
     }
 }
 
+void tst_QObject::batchedConnection()
+{
+    SenderObject sender;
+    QList<int> received;
+    QObject context;
+    connect(&sender, &SenderObject::signal7, &context, [&](int value, const QString &text) {
+        QCOMPARE(text, QString::number(value));
+        received << value;
+    }, static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::BatchedConnection));
+    EventSpy spy;
+    context.installEventFilter(&spy);
+
+    for (int i = 0; i < 10; ++i)
+        emit sender.signal7(i, QString::number(i));
+    QVERIFY(received.isEmpty());
+
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(received, QList<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    QCOMPARE(spy.eventList(), EventSpy::EventList({ { &context, QEvent::MetaCall } }));
+
+    // the next emission starts a new batch
+    spy.clear();
+    received.clear();
+    emit sender.signal7(10, QString::number(10));
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(received, QList<int>({ 10 }));
+    QCOMPARE(spy.eventList().size(), 1);
+
+    // pending emissions are dropped with the posted event
+    received.clear();
+    emit sender.signal7(11, QString::number(11));
+    emit sender.signal7(12, QString::number(12));
+    QCoreApplication::removePostedEvents(&context, QEvent::MetaCall);
+    emit sender.signal7(13, QString::number(13));
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(received, QList<int>({ 13 }));
+
+    // and with the connection's receiver
+    {
+        QObject receiver;
+        connect(&sender, &SenderObject::signal7, &receiver, [&](int value) { received << value; },
+                static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::BatchedConnection));
+        emit sender.signal7(14, QString::number(14));
+    }
+    received.clear();
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+    QCOMPARE(received, QList<int>({ 14 }));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(received, QList<int>({ 14 }));
+}
+
+void tst_QObject::coalescedConnection()
+{
+    SenderObject sender;
+    QList<int> received;
+    QObject context;
+    connect(&sender, &SenderObject::signal7, &context, [&](int value) { received << value; },
+            static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection));
+    // also through the string-based connect()
+    ReceiverObject receiver;
+    receiver.reset();
+    QVERIFY(connect(&sender, SIGNAL(signal1()), &receiver, SLOT(slot1()),
+                    static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::CoalescedConnection)));
+
+    for (int i = 0; i < 10; ++i) {
+        emit sender.signal7(i, QString());
+        sender.emitSignal1();
+    }
+    QVERIFY(received.isEmpty());
+    QCOMPARE(receiver.count_slot1, 0);
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(received, QList<int>({ 9 }));
+    QCOMPARE(receiver.count_slot1, 1);
+
+    emit sender.signal7(10, QString());
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(received, QList<int>({ 9, 10 }));
+}
+
+void tst_QObject::batchedConnectionAcrossThreads()
+{
+    constexpr int Emissions = 100000;
+    SenderObject sender;
+    int received = 0;
+    int outOfOrder = 0;
+    QObject context;
+    connect(&sender, &SenderObject::signal7, &context, [&](int value) {
+        if (value != received)
+            ++outOfOrder;
+        ++received;
+    }, static_cast<Qt::ConnectionType>(Qt::AutoConnection | Qt::BatchedConnection));
+
+    // same thread: delivered directly
+    emit sender.signal7(0, QString());
+    QCOMPARE(received, 1);
+    received = 0;
+
+    QThread thread;
+    sender.moveToThread(&thread);
+    connect(&thread, &QThread::started, &sender, [&] {
+        for (int i = 0; i < Emissions; ++i)
+            emit sender.signal7(i, QString());
+        sender.moveToThread(qApp->thread());
+        thread.quit();
+    });
+    thread.start();
+    QTRY_COMPARE(received, Emissions);
+    QVERIFY(thread.wait());
+    QCOMPARE(outOfOrder, 0);
+}
+
 void tst_QObject::objectNameBinding()
 {
     QObject obj;
@@ -92,6 +92,7 @@ private slots:
     void groupedNotificationConsistency();
     void bindingGroupMovingBindingData();
     void bindingGroupBindingDeleted();
+    void bindingGroupEvaluatesOnce();
     void uninstalledBindingDoesNotEvaluate();
 
     void notify();
@@ -2231,6 +2232,62 @@ void tst_QProperty::bindingGroupBindingDeleted()
     QVERIFY(calledHandler);
 }
 
+void tst_QProperty::bindingGroupEvaluatesOnce()
+{
+    QProperty<int> a(1);
+    QProperty<int> b(2);
+    QProperty<bool> useB(false);
+    int sumEvaluations = 0;
+    int doubledEvaluations = 0;
+    int totalEvaluations = 0;
+    QProperty<int> sum([&](){ ++sumEvaluations; return a + b; });
+    QProperty<int> doubled([&](){ ++doubledEvaluations; return sum * 2; });
+    QProperty<int> total([&](){ ++totalEvaluations; return sum + doubled; });
+    // only depends on b once useB has changed
+    QProperty<int> dynamic([&](){ return useB ? b + total : total.value(); });
+    int nNotifications = 0;
+    auto handler = total.onValueChanged([&](){
+        ++nNotifications;
+        QCOMPARE(total.value(), 3 * (a + b));
+    });
+    QCOMPARE(total.value(), 9);
+
+    sumEvaluations = doubledEvaluations = totalEvaluations = 0;
+    {
+        const QScopedPropertyUpdateGroup guard;
+        a = 2;
+        b = 3;
+    }
+    QCOMPARE(total.value(), 15);
+    QCOMPARE(sumEvaluations, 1);
+    QCOMPARE(doubledEvaluations, 1);
+    QCOMPARE(totalEvaluations, 1);
+    QCOMPARE(nNotifications, 1);
+    QCOMPARE(dynamic.value(), 15);
+
+    // a change which cancels out does not evaluate the bindings further down
+    sumEvaluations = doubledEvaluations = totalEvaluations = 0;
+    {
+        const QScopedPropertyUpdateGroup guard;
+        a = 3;
+        b = 2;
+    }
+    QCOMPARE(sumEvaluations, 1);
+    QCOMPARE(doubledEvaluations, 0);
+    QCOMPARE(totalEvaluations, 0);
+    QCOMPARE(nNotifications, 1);
+
+    // dependencies picked up while the group ends are still honored
+    {
+        const QScopedPropertyUpdateGroup guard;
+        useB = true;
+        b = 4;
+    }
+    QCOMPARE(total.value(), 21);
+    QCOMPARE(dynamic.value(), 25);
+    QCOMPARE(nNotifications, 2);
+}
+
 void tst_QProperty::uninstalledBindingDoesNotEvaluate()
 {
     QProperty<int> i;
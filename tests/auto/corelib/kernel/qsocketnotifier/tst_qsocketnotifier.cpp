@@ -8,6 +8,8 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThread>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -15,6 +17,7 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
 #include <limits>
@@ -35,6 +38,9 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+#endif
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+    void epollDispatcher();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -338,6 +344,54 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if defined(Q_OS_UNIX) && QT_CONFIG(epoll)
+void tst_QSocketNotifier::epollDispatcher()
+{
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    auto dispatcher = new QEventDispatcherUNIX;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+    auto d = static_cast<QEventDispatcherUNIXPrivate *>(QObjectPrivate::get(dispatcher));
+    QVERIFY(d->epollFd >= 0);
+
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    bool pipeActivated = false;
+    bool fileActivated = false;
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        QEventLoop loop;
+        QSocketNotifier pipeNotifier(fds[0], QSocketNotifier::Read);
+        connect(&pipeNotifier, &QSocketNotifier::activated, &loop, [&] {
+            pipeActivated = true;
+            pipeNotifier.setEnabled(false);
+            if (fileActivated)
+                loop.quit();
+        });
+        // epoll refuses regular files; they must still be reported as ready
+        QSocketNotifier fileNotifier(file.handle(), QSocketNotifier::Read);
+        connect(&fileNotifier, &QSocketNotifier::activated, &loop, [&] {
+            fileActivated = true;
+            fileNotifier.setEnabled(false);
+            if (pipeActivated)
+                loop.quit();
+        });
+        QTimer::singleShot(5s, &loop, &QEventLoop::quit);
+        qt_safe_write(fds[1], "a", 1);
+        loop.exec();
+    }));
+    thread->setEventDispatcher(dispatcher);
+    thread->start();
+    QVERIFY(thread->wait(10s));
+
+    QVERIFY(pipeActivated);
+    QVERIFY(fileActivated);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
+#endif
+
 void tst_QSocketNotifier::async_readDatagramSlot()
 {
     char buf[1];
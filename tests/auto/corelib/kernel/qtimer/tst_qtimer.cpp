@@ -18,6 +18,9 @@
 #include <qelapsedtimer.h>
 #include <qproperty.h>
 
+#include <memory>
+#include <vector>
+
 #if defined Q_OS_UNIX
 #include <unistd.h>
 #endif
@@ -69,6 +72,7 @@ private slots:
     void timerFiresOnlyOncePerProcessEvents();
     void timerIdPersistsAfterThreadExit();
     void cancelLongTimer();
+    void manyCoarseTimers();
     void singleShotStaticFunctionZeroTimeout();
     void recurseOnTimeoutAndStopTimer();
     void singleShotToFunctors();
@@ -798,6 +802,72 @@ void tst_QTimer::cancelLongTimer()
     QVERIFY(!timer.isActive());
 }
 
+void tst_QTimer::manyCoarseTimers()
+{
+    using namespace std::chrono_literals;
+
+    // Coarse timers may fire up to 5% early, very coarse ones up to 500 ms.
+    constexpr int Count = 3000;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    std::vector<std::unique_ptr<QTimer>> timers;
+    std::vector<int> intervals;
+    std::vector<qint64> firedAt(Count, -1);
+    int fired = 0;
+    for (int i = 0; i < Count; ++i) {
+        auto timer = std::make_unique<QTimer>();
+        const bool veryCoarse = i % 100 == 0;
+        timer->setTimerType(veryCoarse ? Qt::VeryCoarseTimer : Qt::CoarseTimer);
+        timer->setSingleShot(true);
+        intervals.push_back(veryCoarse ? 1000 : 25 + (i * 37) % 800);
+        connect(timer.get(), &QTimer::timeout, this, [&, i] {
+            if (firedAt[i] < 0)
+                ++fired;
+            firedAt[i] = elapsed.elapsed();
+        });
+        timer->start(intervals.back());
+        timers.push_back(std::move(timer));
+    }
+
+    // stop every third, and restart every fifth of the others
+    int expected = 0;
+    for (int i = 0; i < Count; ++i) {
+        if (i % 3 == 0)
+            timers[i]->stop();
+        else if (i % 5 == 0)
+            timers[i]->start();
+        expected += i % 3 != 0;
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(fired, expected, 5000);
+    for (int i = 0; i < Count; ++i) {
+        if (i % 3 == 0) {
+            QCOMPARE(firedAt[i], -1);
+        } else {
+            const qint64 earliest = intervals[i] % 1000 ? intervals[i] * 95 / 100 - 1
+                                                        : intervals[i] - 500;
+            QVERIFY2(firedAt[i] >= earliest,
+                     QByteArray("timer " + QByteArray::number(i) + " ("
+                                + QByteArray::number(intervals[i]) + "ms) fired after "
+                                + QByteArray::number(firedAt[i]) + "ms"));
+        }
+    }
+
+    // long coarse timers report their remaining time
+    QTimer coarse;
+    coarse.setTimerType(Qt::CoarseTimer);
+    coarse.start(10s);
+    QCOMPARE_GE(coarse.remainingTime(), 9000);
+    QCOMPARE_LE(coarse.remainingTime(), 10500);
+    QTimer veryCoarse;
+    veryCoarse.setTimerType(Qt::VeryCoarseTimer);
+    veryCoarse.start(1h);
+    QCOMPARE_GE(veryCoarse.remainingTime(), 3599000);
+    QCOMPARE_LE(veryCoarse.remainingTime(), 3601000);
+    veryCoarse.stop();
+    QCOMPARE(veryCoarse.remainingTime(), -1);
+}
+
 class TimeoutCounter : public QObject
 {
     Q_OBJECT
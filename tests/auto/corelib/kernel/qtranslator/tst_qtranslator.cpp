@@ -35,6 +35,7 @@ private slots:
     void loadDirectory();
     void dependencies();
     void translationInThreadWhileInstallingTranslator();
+    void cachedTranslations();
 
 private:
     int languageChangeEventCounter;
@@ -393,5 +394,75 @@ void tst_QTranslator::translationInThreadWhileInstallingTranslator()
     QVERIFY(thread.ok);
 }
 
+class CountingTranslator : public QTranslator
+{
+    Q_OBJECT
+public:
+    QString translate(const char *, const char *sourceText, const char *, int) const override
+    {
+        ++calls;
+        return QString::fromUtf8(sourceText).toUpper();
+    }
+    bool isEmpty() const override { return false; }
+
+    mutable int calls = 0;
+};
+
+void tst_QTranslator::cachedTranslations()
+{
+    QTranslator tor;
+    QVERIFY(tor.load("hellotr_la"));
+    QVERIFY(QCoreApplication::installTranslator(&tor));
+
+    // the second round is answered from the cache
+    for (int round = 0; round < 2; ++round) {
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+                 QLatin1String("Hallo Welt!"));
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, 1),
+                 QLatin1String("Hallo 1 Welt!"));
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Hello %n world(s)!", 0, 2),
+                 QLatin1String("Hallo 2 Welten!"));
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Not translated"),
+                 QLatin1String("Not translated"));
+        QCOMPARE(QCoreApplication::translate("QCheckBox", "Hello world!"),
+                 QLatin1String("Hello world!"));
+    }
+
+    // the strings are compared, not their addresses
+    QByteArray context("QPushButton");
+    QCOMPARE(QCoreApplication::translate(context.constData(), "Hello world!"),
+             QLatin1String("Hallo Welt!"));
+    context = "QLineEdit";
+    QCOMPARE(QCoreApplication::translate(context.constData(), "Hello world!"),
+             QLatin1String("Hello world!"));
+
+    // reloading an installed translator invalidates the cache
+    QVERIFY(!tor.load("doesn't exist, same as clearing"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+             QLatin1String("Hello world!"));
+    QVERIFY(tor.load("hellotr_la"));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+             QLatin1String("Hallo Welt!"));
+
+    // so do installing and removing translators
+    {
+        CountingTranslator counting;
+        QVERIFY(QCoreApplication::installTranslator(&counting));
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+                 QLatin1String("HELLO WORLD!"));
+        // subclasses are asked every time
+        QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+                 QLatin1String("HELLO WORLD!"));
+        QCOMPARE(counting.calls, 2);
+        QVERIFY(QCoreApplication::removeTranslator(&counting));
+    }
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+             QLatin1String("Hallo Welt!"));
+
+    QVERIFY(QCoreApplication::removeTranslator(&tor));
+    QCOMPARE(QCoreApplication::translate("QPushButton", "Hello world!"),
+             QLatin1String("Hello world!"));
+}
+
 QTEST_MAIN(tst_QTranslator)
 #include "tst_qtranslator.moc"
@@ -309,6 +309,8 @@ private slots:
     void convertByteArrayToBool_data() const;
     void convertIterables() const;
     void convertConstNonConst() const;
+    void convertMany() const;
+    void compareArithmetic() const;
     void toIntFromQString() const;
     void toIntFromDouble() const;
     void setValue();
@@ -3419,6 +3421,60 @@ void tst_QVariant::valueClassHierarchyConversion() const
    }
 }
 
+void tst_QVariant::convertMany() const
+{
+    const QVariantList values = {
+        42, 2.5, -2.5, true, QString("17"), 7u, qlonglong(-3), QVariant(), QString("x"), QVariant::fromValue('c')
+    };
+
+    std::vector<int> ints(values.size(), -1);
+    QVERIFY(!QVariant::convert(values.constData(), values.size(), ints.data()));
+    const std::vector<int> expectedInts = { 42, 3, -3, 1, 17, 7, -3, 0, 0, 'c' };
+    QCOMPARE(ints, expectedInts);
+    for (qsizetype i = 0; i < values.size(); ++i)
+        QCOMPARE(ints[i], values.at(i).value<int>());
+
+    std::vector<double> doubles(values.size());
+    QVERIFY(!QVariant::convert(values.constData(), values.size(), doubles.data()));
+    for (qsizetype i = 0; i < values.size(); ++i)
+        QCOMPARE(doubles[i], values.at(i).value<double>());
+
+    QStringList strings(values.size(), QString("unchanged"));
+    QVERIFY(!QVariant::convert(values.constData(), values.size(), strings.data()));
+    for (qsizetype i = 0; i < values.size(); ++i)
+        QCOMPARE(strings.at(i), values.at(i).toString());
+
+    const QVariantList numbers = { 1, 2u, 3.0f, qint8(4), true };
+    std::vector<qlonglong> longs(numbers.size());
+    QVERIFY(QVariant::convert(numbers.constData(), numbers.size(), longs.data()));
+    QCOMPARE(longs, std::vector<qlonglong>({ 1, 2, 3, 4, 1 }));
+
+    QVERIFY(QVariant::convert(numbers.constData(), 0, longs.data()));
+    QVERIFY(!QVariant::convert(numbers.constData(), numbers.size(), QMetaType(), longs.data()));
+}
+
+void tst_QVariant::compareArithmetic() const
+{
+    QCOMPARE(QVariant(1), QVariant(1));
+    QCOMPARE_NE(QVariant(1), QVariant(2));
+    QCOMPARE(QVariant::compare(QVariant(1), QVariant(2)), QPartialOrdering::Less);
+    QCOMPARE(QVariant::compare(QVariant(2u), QVariant(1u)), QPartialOrdering::Greater);
+    QCOMPARE(QVariant::compare(QVariant(true), QVariant(false)), QPartialOrdering::Greater);
+    QCOMPARE(QVariant::compare(QVariant(-1.5), QVariant(-1.5)), QPartialOrdering::Equivalent);
+    QCOMPARE(QVariant(0.0), QVariant(-0.0));
+
+    const double nan = qQNaN();
+    QCOMPARE_NE(QVariant(nan), QVariant(nan));
+    QCOMPARE(QVariant::compare(QVariant(nan), QVariant(1.0)), QPartialOrdering::Unordered);
+    QCOMPARE(QVariant::compare(QVariant(float(nan)), QVariant(float(nan))),
+             QPartialOrdering::Unordered);
+
+    // null variants of arithmetic types hold a zero value
+    QCOMPARE(QVariant(QMetaType::fromType<int>()), QVariant(0));
+    QCOMPARE(QVariant::compare(QVariant(QMetaType::fromType<double>()), QVariant(0.5)),
+             QPartialOrdering::Less);
+}
+
 void tst_QVariant::convertBoolToByteArray() const
 {
     QFETCH(QByteArray, input);
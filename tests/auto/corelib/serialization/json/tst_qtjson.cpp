@@ -79,6 +79,7 @@ private Q_SLOTS:
     void toVariantMap();
     void toVariantHash();
     void toVariantList();
+    void toVariantListSharesKeys();
 
     void toJson();
     void toJsonSillyNumericValues();
@@ -121,6 +122,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void stringsAcrossVectorBoundaries();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -1760,6 +1762,24 @@ void tst_QtJson::toVariantList()
     QCOMPARE(vlist.at(3), QVariant::fromValue(nullptr));
 }
 
+void tst_QtJson::toVariantListSharesKeys()
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(
+            R"([{"name": "a", "id": 1}, {"name": "b", "id": 2}, [{"name": "c"}]])");
+    const QVariantList list = doc.array().toVariantList();
+    QCOMPARE(list.size(), 3);
+
+    const QVariantMap first = list.at(0).toMap();
+    const QVariantMap second = list.at(1).toMap();
+    const QVariantMap nested = list.at(2).toList().at(0).toMap();
+    QCOMPARE(first.value("name"), QVariant("a"));
+    QCOMPARE(second.value("name"), QVariant("b"));
+    QCOMPARE(nested.value("name"), QVariant("c"));
+    QCOMPARE(first.firstKey().constData(), second.firstKey().constData());
+    QCOMPARE(first.lastKey().constData(), second.lastKey().constData());
+    QCOMPARE(first.lastKey().constData(), nested.firstKey().constData());
+}
+
 void tst_QtJson::toJson()
 {
     // Test QJsonDocument::Indented format
@@ -3083,6 +3103,36 @@ void tst_QtJson::nesting()
 
 }
 
+void tst_QtJson::stringsAcrossVectorBoundaries()
+{
+    // the parser scans strings and whitespace in 16-byte blocks; exercise
+    // special characters at every position in and around such blocks
+    for (int n = 0; n < 40; ++n) {
+        const QByteArray prefix(n, 'a');
+        const QString expectedPrefix(n, u'a');
+        const QByteArray indent(n, ' ');
+
+        auto parseString = [&](const QByteArray &content) {
+            QJsonParseError error;
+            const QByteArray json = '[' + indent + '"' + content + "\"\n" + indent + ']';
+            QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            if (error.error != QJsonParseError::NoError)
+                qWarning() << json << error.errorString();
+            return doc.array().at(0).toString();
+        };
+
+        QCOMPARE(parseString(prefix), expectedPrefix);
+        QCOMPARE(parseString(prefix + "\\\"" + prefix), expectedPrefix + u'"' + expectedPrefix);
+        QCOMPARE(parseString(prefix + "\xc3\xa9" + prefix), expectedPrefix + u'\u00e9' + expectedPrefix);
+        QCOMPARE(parseString(prefix + "\\u00e9\xc3\xa9" + prefix),
+                 expectedPrefix + u'\u00e9' + u'\u00e9' + expectedPrefix);
+
+        QJsonParseError error;
+        QJsonDocument::fromJson("[\"" + prefix, &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+    }
+}
+
 void tst_QtJson::longStrings()
 {
     // test around 15 and 16 bit boundaries, as these are limits
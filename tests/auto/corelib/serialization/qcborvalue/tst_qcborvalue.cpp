@@ -90,6 +90,9 @@ private slots:
     void fromCborStreamReaderByteArray();
     void fromCborStreamReaderIODevice_data() { fromCbor_data(); }
     void fromCborStreamReaderIODevice();
+    void fromCborSharedSource_data() { fromCbor_data(); }
+    void fromCborSharedSource();
+    void sharedSourceLifetime();
     void validation_data();
     void validation();
     void extendedTypeValidation_data();
@@ -2213,6 +2216,67 @@ void tst_QCborValue::fromCborStreamReaderIODevice()
 
 #include "../cborlargedatavalidation.cpp"
 
+void tst_QCborValue::fromCborSharedSource()
+{
+    auto doCheck = [](const QCborValue &v, const QByteArray &result) {
+        QCborParserError error;
+        QCborValue decoded = QCborValue::fromCbor(result, &error, QCborValue::ShareSourceData);
+        QVERIFY2(error.error == QCborError(), qPrintable(error.errorString()));
+        QCOMPARE(error.offset, result.size());
+        QVERIFY(decoded == v);
+        QVERIFY(v == decoded);
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::sharedSourceLifetime()
+{
+    const QByteArray longBytes(100, '\xff');
+    const QString longText = QString(40, u'a') + QString(40, QChar(0xe9));
+    const QString longKey(64, u'k');
+
+    QCborValue decoded;
+    {
+        QCborMap map;
+        map[longKey] = longText;
+        map[1] = QCborArray{ longBytes, QCborValue(QCborKnownTags::Signature, longBytes) };
+        map[2] = QStringLiteral("short");
+
+        QByteArray data = map.toCborValue().toCbor();
+        QCborParserError error;
+        decoded = QCborValue::fromCbor(data, &error, QCborValue::ShareSourceData);
+        QCOMPARE(error.error, QCborError::NoError);
+        QCOMPARE(decoded, map.toCborValue());
+
+        // modifying the source must not affect the decoded values
+        data.fill('\0');
+    }
+
+    QCborMap map = decoded.toMap();
+    QCOMPARE(map.value(longKey).toString(), longText);
+    QCOMPARE(map.value(1).toArray().at(0).toByteArray(), longBytes);
+    QCOMPARE(map.value(1).toArray().at(1).taggedValue().toByteArray(), longBytes);
+    QCOMPARE(map.value(2).toString(), "short");
+
+    // mutating a decoded value replaces the shared data
+    map[longKey] = QStringLiteral("replaced");
+    QCOMPARE(map.value(longKey).toString(), "replaced");
+    QCOMPARE(decoded.toMap().value(longKey).toString(), longText);
+
+    // a lone string
+    const QByteArray text = QCborValue(longText).toCbor();
+    QCborValue lone = QCborValue::fromCbor(QByteArray(text), nullptr, QCborValue::ShareSourceData);
+    QCOMPARE(lone.toString(), longText);
+
+    // invalid UTF-8 is still reported
+    QByteArray invalid = QCborValue(longText).toCbor();
+    invalid[invalid.size() - 1] = '\xff';
+    QCborParserError error;
+    QCborValue::fromCbor(invalid, &error, QCborValue::ShareSourceData);
+    QCOMPARE(error.error, QCborError::InvalidUtf8String);
+}
+
 void tst_QCborValue::validation_data()
 {
     // Add QCborStreamReader-specific limitations due to use of QByteArray and
@@ -179,6 +179,9 @@ private slots:
 
     void status_QList_QVector();
 
+    void arrays_data();
+    void arrays();
+
     void streamToAndFromQByteArray();
 
     void streamRealDataTypes();
@@ -3189,6 +3192,114 @@ void tst_QDataStream::status_QList_QVector()
     }
 }
 
+void tst_QDataStream::arrays_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+    QTest::addColumn<int>("version");
+
+    QTest::newRow("big endian") << QDataStream::BigEndian << QDataStream::DoublePrecision
+                                << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("little endian") << QDataStream::LittleEndian << QDataStream::DoublePrecision
+                                   << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("single precision") << QDataStream::BigEndian << QDataStream::SinglePrecision
+                                      << int(QDataStream::Qt_DefaultCompiledVersion);
+    QTest::newRow("Qt 3.0") << QDataStream::BigEndian << QDataStream::DoublePrecision
+                            << int(QDataStream::Qt_3_0);
+}
+
+template <typename T>
+static void compareArrayStreaming(QDataStream::ByteOrder byteOrder,
+                                  QDataStream::FloatingPointPrecision precision, int version)
+{
+    QList<T> values;
+    for (int i = 0; i < 1000; ++i)
+        values.append(T(T(i * 7919 - 3000) / T(3)));
+
+    const auto setUp = [&](QDataStream &s) {
+        s.setByteOrder(byteOrder);
+        s.setFloatingPointPrecision(precision);
+        s.setVersion(version);
+    };
+
+    QByteArray expected;
+    {
+        QDataStream out(&expected, QIODevice::WriteOnly);
+        setUp(out);
+        for (T value : std::as_const(values))
+            out << value;
+    }
+
+    QByteArray written;
+    {
+        QDataStream out(&written, QIODevice::WriteOnly);
+        setUp(out);
+        out.writeArray(values.constData(), values.size());
+        QCOMPARE(out.status(), QDataStream::Ok);
+    }
+    QCOMPARE(written, expected);
+
+    QDataStream in(expected);
+    setUp(in);
+    QList<T> read(values.size());
+    in.readArray(read.data(), read.size());
+    QCOMPARE(in.status(), QDataStream::Ok);
+    QVERIFY(in.atEnd());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        T value;
+        QDataStream single(expected.mid(i * (expected.size() / values.size())));
+        setUp(single);
+        single >> value;
+        QCOMPARE(read.at(i), value);
+    }
+
+    // reading past the end fails and zeroes the array
+    QDataStream truncated(expected.chopped(1));
+    setUp(truncated);
+    truncated.readArray(read.data(), read.size());
+    QCOMPARE(truncated.status(), QDataStream::ReadPastEnd);
+    QVERIFY(std::all_of(read.cbegin(), read.cend(), [](T v) { return v == T(0); }));
+
+    // QList uses the same format as before
+    QByteArray list;
+    {
+        QDataStream out(&list, QIODevice::WriteOnly);
+        setUp(out);
+        out << values;
+    }
+    QCOMPARE(list.mid(4), expected);
+    QDataStream listIn(list);
+    setUp(listIn);
+    QList<T> readList;
+    listIn >> readList;
+    QCOMPARE(listIn.status(), QDataStream::Ok);
+    QCOMPARE(readList.size(), values.size());
+}
+
+void tst_QDataStream::arrays()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+    QFETCH(int, version);
+
+    compareArrayStreaming<qint8>(byteOrder, precision, version);
+    if (QTest::currentTestFailed())
+        return;
+    compareArrayStreaming<quint16>(byteOrder, precision, version);
+    if (QTest::currentTestFailed())
+        return;
+    compareArrayStreaming<qint32>(byteOrder, precision, version);
+    if (QTest::currentTestFailed())
+        return;
+    compareArrayStreaming<qint64>(byteOrder, precision, version);
+    if (QTest::currentTestFailed())
+        return;
+    compareArrayStreaming<float>(byteOrder, precision, version);
+    if (QTest::currentTestFailed())
+        return;
+    compareArrayStreaming<double>(byteOrder, precision, version);
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
@@ -0,0 +1,345 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/qjsonstreamreader.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QTest>
+#include <QBuffer>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void basics();
+    void scalars_data();
+    void scalars();
+    void containers();
+    void skipping();
+    void topLevelSequence();
+    void errors_data();
+    void errors();
+    void incremental_data();
+    void incremental();
+    void device();
+};
+
+// Rebuilds a QJsonValue from the current reader position, advancing past it
+static QJsonValue readValue(QJsonStreamReader &reader)
+{
+    switch (reader.type()) {
+    case QJsonStreamReader::Null:
+        reader.next();
+        return QJsonValue::Null;
+    case QJsonStreamReader::False:
+    case QJsonStreamReader::True: {
+        bool b = reader.toBool();
+        reader.next();
+        return b;
+    }
+    case QJsonStreamReader::Double: {
+        QJsonValue v = reader.toDouble();
+        reader.next();
+        return v;
+    }
+    case QJsonStreamReader::String:
+        return reader.readString();
+    case QJsonStreamReader::Array: {
+        QJsonArray array;
+        reader.enterContainer();
+        while (reader.lastError() == QJsonParseError::NoError && reader.hasNext())
+            array.append(readValue(reader));
+        if (reader.lastError() == QJsonParseError::NoError)
+            reader.leaveContainer();
+        return array;
+    }
+    case QJsonStreamReader::Object: {
+        QJsonObject object;
+        reader.enterContainer();
+        while (reader.lastError() == QJsonParseError::NoError && reader.hasNext()) {
+            QString key = reader.readString();
+            object.insert(key, readValue(reader));
+        }
+        if (reader.lastError() == QJsonParseError::NoError)
+            reader.leaveContainer();
+        return object;
+    }
+    case QJsonStreamReader::Invalid:
+        break;
+    }
+    return QJsonValue::Undefined;
+}
+
+void tst_QJsonStreamReader::basics()
+{
+    QJsonStreamReader reader;
+    QCOMPARE(reader.type(), QJsonStreamReader::Invalid);
+    QVERIFY(!reader.isValid());
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Invalid);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.device());
+
+    reader.addData("[1] ");
+    reader.reparse();
+    QVERIFY(reader.isArray());
+    QCOMPARE(reader.currentOffset(), 0);
+
+    reader.clear();
+    QVERIFY(reader.isInvalid());
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::scalars_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QJsonValue>("expected");
+
+    QTest::newRow("null") << QByteArray("[null]") << QJsonValue(QJsonValue::Null);
+    QTest::newRow("false") << QByteArray("[false]") << QJsonValue(false);
+    QTest::newRow("true") << QByteArray("[ true ]") << QJsonValue(true);
+    QTest::newRow("zero") << QByteArray("[0]") << QJsonValue(0);
+    QTest::newRow("integer") << QByteArray("[-1234567]") << QJsonValue(-1234567);
+    QTest::newRow("double") << QByteArray("[1.5e3]") << QJsonValue(1500.);
+    QTest::newRow("empty-string") << QByteArray("[\"\"]") << QJsonValue(QString());
+    QTest::newRow("string") << QByteArray("[\"hello\"]") << QJsonValue("hello");
+    QTest::newRow("escapes") << QByteArray(R"(["a\"b\\c\né"])")
+                             << QJsonValue(u"a\"b\\c\né"_s);
+    QTest::newRow("utf8") << QByteArray("[\"\xc3\xa9\xe2\x82\xac\"]")
+                          << QJsonValue(u"é€"_s);
+}
+
+void tst_QJsonStreamReader::scalars()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QJsonValue, expected);
+
+    QJsonStreamReader reader(data);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Array);
+    QVERIFY(reader.hasNext());
+    if (expected.isDouble() && expected.toDouble() == expected.toInteger())
+        QCOMPARE(reader.toInteger(-1), expected.toInteger());
+    QCOMPARE(readValue(reader), expected);
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(reader.isInvalid());
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::containers()
+{
+    const QByteArray data = R"({"a": [1, 2, {"b": null}], "c": {}, "d": [], "e": "f"})";
+    QJsonStreamReader reader(data);
+    QCOMPARE(readValue(reader), QJsonValue(QJsonDocument::fromJson(data).object()));
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    QVERIFY(reader.isInvalid());
+
+    // walk it by hand
+    reader.clear();
+    reader.addData(data);
+    reader.reparse();
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Object);
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readString(), u"a"_s);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 2);
+    QCOMPARE(reader.toInteger(), 1);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.toInteger(), 2);
+    QVERIFY(reader.leaveContainer());        // skips the rest
+    QCOMPARE(reader.containerDepth(), 1);
+    QCOMPARE(reader.readString(), u"c"_s);
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.readString(), u"d"_s);
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), u"e"_s);
+    QCOMPARE(reader.readString(), u"f"_s);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(reader.isInvalid());
+}
+
+void tst_QJsonStreamReader::skipping()
+{
+    QJsonStreamReader reader(R"([[1, [2, [3]]], {"x": {"y": [true]}}, "end"])");
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.next());
+    QCOMPARE(reader.readString(), u"end"_s);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+
+    // maxRecursion limits how deep next() may skip
+    reader.clear();
+    reader.addData("[[[[1]]]]");
+    reader.reparse();
+    QVERIFY(!reader.next(2));
+    QCOMPARE(reader.lastError(), QJsonParseError::DeepNesting);
+}
+
+void tst_QJsonStreamReader::topLevelSequence()
+{
+    // newline-delimited JSON
+    QJsonStreamReader reader("\xef\xbb\xbf{\"a\":1}\n[2]\n\"three\"\n4\n");
+    QList<QJsonValue> values;
+    while (reader.isValid())
+        values.append(readValue(reader));
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    QCOMPARE(values.size(), 4);
+    QCOMPARE(values.at(0), QJsonValue(QJsonObject({{"a", 1}})));
+    QCOMPARE(values.at(1), QJsonValue(QJsonArray({2})));
+    QCOMPARE(values.at(2), QJsonValue("three"));
+    QCOMPARE(values.at(3), QJsonValue(4));
+
+    // more values can be added later
+    reader.addData("  null ");
+    reader.reparse();
+    QVERIFY(reader.isNull());
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("missing-name-separator") << QByteArray(R"({"a" 1})")
+                                            << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]")
+                                             << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("unterminated-object") << QByteArray(R"({"a": 1 "b": 2})")
+                                         << QJsonParseError::UnterminatedObject;
+    QTest::newRow("nonstring-key") << QByteArray("{1: 2}")
+                                   << QJsonParseError::UnterminatedObject;
+    QTest::newRow("trailing-comma") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("missing-value") << QByteArray(R"({"a":})") << QJsonParseError::MissingObject;
+    QTest::newRow("illegal-literal") << QByteArray("[nul]") << QJsonParseError::IllegalValue;
+    QTest::newRow("illegal-number") << QByteArray("[-]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("illegal-escape") << QByteArray(R"(["\u12x4"])") << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("premature-array") << QByteArray("[1, 2") << QJsonParseError::PrematureEndOfDocument;
+    QTest::newRow("premature-string") << QByteArray("[\"abc") << QJsonParseError::PrematureEndOfDocument;
+    QTest::newRow("premature-literal") << QByteArray("[tr") << QJsonParseError::PrematureEndOfDocument;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonStreamReader reader(data);
+    readValue(reader);
+    QCOMPARE(reader.lastError(), error);
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.next());
+}
+
+void tst_QJsonStreamReader::incremental_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::newRow("scalars") << QByteArray(R"([null, true, false, 12345, -0.25e-3, "text"])");
+    QTest::newRow("nested") << QByteArray(R"({"list": [1, [2, {"k": "v"}]], "empty": {}, "n": []})");
+    QTest::newRow("escapes") << QByteArray(R"(["€😀\"\\", "\t"])");
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, data);
+    const QJsonDocument doc = QJsonDocument::fromJson(data);
+    QVERIFY(!doc.isNull());
+    const QJsonValue expected = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+
+    // feed any split of the data and skip the first container once
+    for (qsizetype split = 0; split <= data.size(); ++split) {
+        QJsonStreamReader reader(data.left(split));
+        if (split < data.size()) {
+            QVERIFY(!reader.next());
+            if (reader.lastError() == QJsonParseError::NoError) {
+                QVERIFY(reader.isInvalid());
+            } else {
+                QCOMPARE(reader.lastError(), QJsonParseError::PrematureEndOfDocument);
+                QVERIFY(reader.isContainer());      // still positioned on it
+            }
+        }
+
+        reader.addData(data.mid(split));
+        reader.reparse();
+        QVERIFY2(reader.isContainer(), QByteArray::number(split));
+        QCOMPARE(reader.currentOffset(), 0);
+        QCOMPARE(readValue(reader), expected);
+        QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    }
+
+    // feed one byte at a time while reading
+    QJsonStreamReader reader;
+    qsizetype fed = 0;
+    auto feed = [&] {
+        if (fed == data.size())
+            return false;
+        reader.addData(data.constData() + fed++, 1);
+        reader.reparse();
+        return true;
+    };
+    int count = 0;
+    while (!reader.isValid() && feed())
+        ;
+    QVERIFY(reader.enterContainer());
+    while (reader.hasNext()) {
+        if (reader.lastError() == QJsonParseError::PrematureEndOfDocument) {
+            QVERIFY(feed());
+            continue;
+        }
+        QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+        if (reader.next())
+            ++count;
+    }
+    QCOMPARE(count, expected.isArray() ? expected.toArray().size() : expected.toObject().size() * 2);
+}
+
+void tst_QJsonStreamReader::device()
+{
+    QByteArray data = "[";
+    for (int i = 0; i < 20000; ++i)
+        data += "{\"index\": " + QByteArray::number(i) + ", \"name\": \"item\"},\n";
+    data += "null]";
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QVERIFY(reader.enterContainer());
+    int sum = 0;
+    int count = 0;
+    while (reader.isObject()) {
+        QVERIFY(reader.enterContainer());
+        QCOMPARE(reader.readString(), u"index"_s);
+        sum += reader.toInteger();
+        QVERIFY(reader.leaveContainer());
+        ++count;
+    }
+    QCOMPARE(reader.lastError(), QJsonParseError::NoError);
+    QCOMPARE(count, 20000);
+    QCOMPARE(sum, 20000 * 19999 / 2);
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.currentOffset(), data.size());
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
@@ -588,6 +588,8 @@ private slots:
     void roundTrip_data() const;
 
     void entityExpansionLimit() const;
+    void longRuns_data() const;
+    void longRuns() const;
 
 private:
     static QByteArray readFile(const QString &filename);
@@ -1828,5 +1830,60 @@ void tst_QXmlStream::roundTrip() const
     QCOMPARE(out, in);
 }
 
+void tst_QXmlStream::longRuns_data() const
+{
+    QTest::addColumn<int>("length");
+
+    // around the block sizes used when skipping over runs of characters
+    for (int length : { 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 1000 })
+        QTest::addRow("%d", length) << length;
+}
+
+void tst_QXmlStream::longRuns() const
+{
+    QFETCH(int, length);
+
+    const QString name = QString(length, u'n') + u"-1.x_Y";
+    const QString value = QString(length, u'v') + u"\"'&<]";
+    const QString text = QString(length, u't') + u"]]" + QString(length, u'é') + u" \t";
+    const QString blanks = QString(length, u' ');
+
+    QString xml;
+    QXmlStreamWriter writer(&xml);
+    writer.writeStartElement(name);
+    writer.writeNamespace(u"urn:test"_s, u"p"_s);
+    writer.writeAttribute(u"urn:test"_s, name, value);
+    writer.writeCharacters(text);
+    writer.writeStartElement(u"child"_s);
+    writer.writeCharacters(blanks + u'\n' + blanks);
+    writer.writeEndElement();
+    writer.writeEndElement();
+
+    QXmlStreamReader reader(xml);
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.name(), name);
+    QCOMPARE(reader.attributes().value(u"urn:test"_s, name), value);
+
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QVERIFY(!reader.isWhitespace());
+    QCOMPARE(reader.text(), text);
+
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.readNext(), QXmlStreamReader::Characters);
+    QVERIFY(reader.isWhitespace());
+    QCOMPARE(reader.text(), blanks + u'\n' + blanks);
+    QCOMPARE(reader.lineNumber(), 2);
+
+    while (!reader.atEnd())
+        reader.readNext();
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+
+    // "]]>" must still be found when it follows a long run
+    QXmlStreamReader invalid(u"<a>" + QString(length, u't') + u"]]></a>");
+    while (!invalid.atEnd())
+        invalid.readNext();
+    QCOMPARE(invalid.error(), QXmlStreamReader::NotWellFormedError);
+}
+
 #include "tst_qxmlstream.moc"
 // vim: et:ts=4:sw=4:sts=4
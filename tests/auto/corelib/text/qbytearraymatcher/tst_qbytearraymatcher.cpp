@@ -28,6 +28,8 @@ private slots:
     void indexIn();
     void staticByteArrayMatcher();
     void haystacksWithMoreThan4GiBWork();
+    void multiByteArrayMatcher_data();
+    void multiByteArrayMatcher();
 };
 
 void tst_QByteArrayMatcher::overloads()
@@ -296,5 +298,78 @@ void tst_QByteArrayMatcher::haystacksWithMoreThan4GiBWork()
 #undef LONG_STRING__64
 #undef LONG_STRING__32
 
+void tst_QByteArrayMatcher::multiByteArrayMatcher_data()
+{
+    QTest::addColumn<QList<QByteArray>>("patterns");
+    QTest::addColumn<QByteArray>("data");
+
+    const QByteArray text = "she sells sea shells by the sea shore; ushers hush her he his hers";
+    QTest::newRow("empty-set") << QList<QByteArray>() << text;
+    QTest::newRow("single") << QList<QByteArray>{ "sea" } << text;
+    QTest::newRow("classic") << QList<QByteArray>{ "he", "she", "his", "hers" } << text;
+    QTest::newRow("one-byte") << QList<QByteArray>{ "s", "h", "e" } << text;
+    QTest::newRow("two-byte") << QList<QByteArray>{ "se", "sh", "he", "ll" } << text;
+    QTest::newRow("duplicates") << QList<QByteArray>{ "sea", "sea", "se" } << text;
+    QTest::newRow("with-empty") << QList<QByteArray>{ "sea", QByteArray(), "e" } << text;
+    QTest::newRow("short-data") << QList<QByteArray>{ "ab", "bc", "abc" } << QByteArray("xabcabc");
+    QTest::newRow("longer-than-data") << QList<QByteArray>{ "abcdefgh", "bc" }
+                                      << QByteArray("abcdefg");
+    QTest::newRow("empty-data") << QList<QByteArray>{ "a", QByteArray() } << QByteArray();
+    QTest::newRow("binary") << QList<QByteArray>{ QByteArray("\0\xff", 2), QByteArray("\xff\0\0", 3) }
+                            << QByteArray("\0\xff\0\0\xff\xff\0\0\0\xff", 10).repeated(5);
+
+    // enough patterns to get past the small-set strategy
+    QList<QByteArray> many;
+    for (int i = 0; i < 200; ++i)
+        many.append(QByteArray::number(i * 7919 % 1000));
+    QByteArray digits;
+    for (int i = 0; i < 500; ++i)
+        digits += QByteArray::number(i * 31 % 997);
+    QTest::newRow("many") << many << digits;
+    QTest::newRow("many-few") << many.mid(0, 40) << digits;
+}
+
+void tst_QByteArrayMatcher::multiByteArrayMatcher()
+{
+    QFETCH(const QList<QByteArray>, patterns);
+    QFETCH(const QByteArray, data);
+
+    // every occurrence of every pattern, ordered by position and pattern index
+    QList<QMultiByteArrayMatcher::Match> expected;
+    for (qsizetype position = 0; position <= data.size(); ++position) {
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            if (QByteArrayView(data).sliced(position).startsWith(patterns.at(i)))
+                expected.append({ position, i });
+        }
+    }
+
+    const QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.matches(data), expected);
+
+    for (qsizetype from : { qsizetype(-5), qsizetype(0), qsizetype(1), qsizetype(17),
+                            data.size() - 1, data.size(), data.size() + 1 }) {
+        QList<QMultiByteArrayMatcher::Match> tail;
+        for (const QMultiByteArrayMatcher::Match &match : expected) {
+            if (match.position >= qMax(from, qsizetype(0)))
+                tail.append(match);
+        }
+        QCOMPARE(matcher.matches(data, from), tail);
+        qsizetype patternIndex = -2;
+        QCOMPARE(matcher.indexIn(data, from, &patternIndex),
+                 tail.isEmpty() ? -1 : tail.first().position);
+        QCOMPARE(patternIndex, tail.isEmpty() ? -1 : tail.first().patternIndex);
+    }
+
+    QMultiByteArrayMatcher other;
+    QCOMPARE(other.indexIn(data), -1);
+    QVERIFY(other.matches(data).isEmpty());
+    other = matcher;
+    QCOMPARE(other.matches(data), expected);
+    other.setPatterns({ "\x01" });
+    QCOMPARE(other.indexIn(data), -1);
+    QCOMPARE(matcher.matches(data), expected);
+}
+
 QTEST_APPLESS_MAIN(tst_QByteArrayMatcher)
 #include "tst_qbytearraymatcher.moc"
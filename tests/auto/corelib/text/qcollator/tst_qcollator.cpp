@@ -20,6 +20,7 @@ private Q_SLOTS:
 
     void compare_data();
     void compare();
+    void sortKeys();
 
     void state();
 };
@@ -321,6 +322,20 @@ void tst_QCollator::compare()
 #endif
 }
 
+void tst_QCollator::sortKeys()
+{
+    const QStringList strings = { "b", "A", "", "a", "c" };
+    QCollator collator(QLocale(QLocale::English));
+    const QList<QCollatorSortKey> keys = collator.sortKeys(strings);
+    QCOMPARE(keys.size(), strings.size());
+    for (qsizetype i = 0; i < strings.size(); ++i) {
+        for (qsizetype j = 0; j < strings.size(); ++j) {
+            QCOMPARE(keys.at(i).compare(keys.at(j)) < 0,
+                     collator.sortKey(strings.at(i)).compare(collator.sortKey(strings.at(j))) < 0);
+        }
+    }
+    QVERIFY(collator.sortKeys({}).isEmpty());
+}
 
 void tst_QCollator::state()
 {
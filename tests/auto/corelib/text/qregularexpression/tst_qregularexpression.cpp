@@ -19,6 +19,8 @@ Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
 Q_DECLARE_METATYPE(QRegularExpression::MatchType)
 Q_DECLARE_METATYPE(QRegularExpression::MatchOptions)
 
+using namespace Qt::StringLiterals;
+
 class tst_QRegularExpression : public QObject
 {
     Q_OBJECT
@@ -63,6 +65,7 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void sharedCompiledPatterns();
 
     void returnsViewsIntoOriginalString();
     void wildcard_data();
@@ -2414,6 +2417,58 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::sharedCompiledPatterns()
+{
+    // objects with the same pattern but different options must not share
+    // their compiled form
+    const QRegularExpression sensitive(u"ab+c"_s);
+    const QRegularExpression insensitive(u"ab+c"_s, QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(sensitive.match(u"abbc"_s).hasMatch());
+    QVERIFY(!sensitive.match(u"ABBC"_s).hasMatch());
+    QVERIFY(insensitive.match(u"ABBC"_s).hasMatch());
+
+    // neither objects with different patterns that share a private
+    QRegularExpression re = sensitive;
+    re.setPattern(u"x(y)"_s);
+    QCOMPARE(re.captureCount(), 1);
+    QCOMPARE(sensitive.captureCount(), 0);
+    re.setPattern(u"ab+c"_s);
+    QCOMPARE(re.captureCount(), 0);
+    QVERIFY(re.match(u"abc"_s).hasMatch());
+
+    // errors are reported by every object using an invalid pattern
+    for (int i = 0; i < 2; ++i) {
+        const QRegularExpression invalid(u"a(b"_s);
+        QVERIFY(!invalid.isValid());
+        QCOMPARE(invalid.patternErrorOffset(), 3);
+        QVERIFY(!invalid.errorString().isEmpty());
+    }
+
+    // temporary objects created by many threads at once, using the same and
+    // different patterns in different threads
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+    QList<QThread *> threads;
+    std::atomic<int> failures = 0;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.append(QThread::create([t, &failures] {
+            for (int i = 0; i < 500; ++i) {
+                const int n = (t + i) % 8;
+                const QRegularExpression re(u"(\\d+)-"_s + QString::number(n));
+                const QRegularExpressionMatch match = re.match(u"x 42-"_s + QString::number(n));
+                if (!match.hasMatch() || match.captured(1) != u"42"_s)
+                    ++failures;
+                if (re.match(u"x 42-"_s + QString::number(n + 1)).hasMatch())
+                    ++failures;
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads))
+        thread->wait();
+    qDeleteAll(threads);
+    QCOMPARE(failures.load(), 0);
+}
+
 void tst_QRegularExpression::returnsViewsIntoOriginalString()
 {
     // https://bugreports.qt.io/browse/QTBUG-98653
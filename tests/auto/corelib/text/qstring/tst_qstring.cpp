@@ -615,6 +615,7 @@ private slots:
     void doubleOut();
     void arg_fillChar_data();
     void arg_fillChar();
+    void format();
     void capacity_data();
     void capacity();
     void section_data();
@@ -6511,6 +6512,58 @@ void tst_QString::doubleOut()
     }
 }
 
+void tst_QString::format()
+{
+    // strings
+    QCOMPARE(QString::format(u"%1 %2 %3", u"a"_s, u"b", "c"_L1), u"a b c"_s);
+    QCOMPARE(QString::format("%1-%2"_L1, QStringView(u"x"), QString()), u"x-"_s);
+    QCOMPARE(QString::format(u"%2 %1", u"a"_s, u"b"_s), u"b a"_s);
+    QCOMPARE(QString::format(u"%1%1", u"ab"_s), u"abab"_s);
+    // placeholders in the arguments are left alone
+    QCOMPARE(QString::format(u"%1 %2", u"%2"_s, u"x"_s), u"%2 x"_s);
+
+    // UTF-8
+    QCOMPARE(QString::format(u"<%1>", QByteArray("\xc3\xa9t\xc3\xa9")), u"<\u00e9t\u00e9>"_s);
+    QCOMPARE(QString::format(u"<%1>", "\xf0\x9f\x98\x80"), u"<\U0001F600>"_s);
+    QCOMPARE(QString::format(u"%1|%2", QByteArray(), "plain"), u"|plain"_s);
+
+    // characters
+    QCOMPARE(QString::format(u"%1%2%3%4", QChar(u'a'), QLatin1Char('b'), u'c', '\xe9'),
+             u"abc\u00e9"_s);
+
+    // integers
+    QCOMPARE(QString::format(u"%1 %2 %3", 0, -42, 42u), u"0 -42 42"_s);
+    QCOMPARE(QString::format(u"%1 %2", std::numeric_limits<qlonglong>::min(),
+                             std::numeric_limits<qulonglong>::max()),
+             QString::number(std::numeric_limits<qlonglong>::min()) + u' '
+             + QString::number(std::numeric_limits<qulonglong>::max()));
+    QCOMPARE(QString::format(u"%1%2", short(-7), uchar(200)), u"-7200"_s);
+
+    // floating-point numbers
+    QCOMPARE(QString::format(u"%1 %2 %3", 1.5, 0.1, -2.f), u"1.5 0.1 -2"_s);
+    QCOMPARE(QString::format(u"%1", 1e100), u"1e+100"_s);
+    QCOMPARE(QString::format(u"%1 %1", 0.25), u"0.25 0.25"_s);
+
+    // numbers are not localized
+    {
+        QLocale original;
+        QLocale::setDefault(QLocale::German);
+        const QString result = QString::format(u"%1 %2", 1.5, 1234567);
+        QLocale::setDefault(original);
+        QCOMPARE(result, u"1.5 1234567"_s);
+    }
+
+    // mixed, and more than 9 arguments
+    QCOMPARE(QString::format(u"%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11",
+                             1, u"2"_s, "3", '4', 5.0, 6u, "7"_L1, u'8', 9ll, 10, 11),
+             u"1 2 3 4 5 6 7 8 9 10 11"_s);
+
+    // as with arg(), missing arguments leave their placeholders
+    QTest::ignoreMessage(QtWarningMsg, "QString::arg: 1 argument(s) missing in %1");
+    QCOMPARE(QString::format(u"%1", 1, 2), u"1"_s);
+    QCOMPARE(QString::format(u"%1 %3", 1), u"1 %3"_s);
+}
+
 void tst_QString::capacity_data()
 {
     length_data();
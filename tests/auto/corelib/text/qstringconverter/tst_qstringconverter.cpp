@@ -129,6 +129,8 @@ private slots:
     void convertUtf8();
     void convertUtf8CharByChar_data() { convertUtf8_data(); }
     void convertUtf8CharByChar();
+    void convertUtf8Runs_data();
+    void convertUtf8Runs();
     void roundtrip_data();
     void roundtrip();
 
@@ -355,6 +357,73 @@ void tst_QStringConverter::convertUtf8CharByChar()
     QCOMPARE(reencoded, ba);
 }
 
+void tst_QStringConverter::convertUtf8Runs_data()
+{
+    QTest::addColumn<QString>("run");
+
+    QTest::newRow("two-byte") << u"\u0430\u0431\u0432\u0433\u03b1\u03b2\u0627\u05d0\u0080\u07ff"_s;
+    QTest::newRow("three-byte") << u"\u4e2d\u6587\u5b57\u7b26\u3042\uac00\u0800\uffff\ud7ff\ue000"_s;
+    QTest::newRow("four-byte") << u"\U0001f600\U0001f44d\U00010000\U0010ffff\U0002070e"_s;
+    QTest::newRow("mixed") << u"\u4e2d\u6587 \U0001f600\u0430\u0431, \u5b57\u7b26\u0627\U0001f44d"_s;
+}
+
+void tst_QStringConverter::convertUtf8Runs()
+{
+    QFETCH(QString, run);
+
+    // long enough for the vectorized code, and ending in ASCII so that no
+    // corruption below leaves an incomplete sequence at the end
+    QString text;
+    while (text.size() < 80)
+        text += run;
+    text += u'.';
+
+    // converting one character at a time never takes the vectorized paths
+    QStringEncoder encoder(QStringEncoder::Utf8);
+    QByteArray utf8;
+    for (qsizetype i = 0; i < text.size(); ++i)
+        utf8 += encoder(QStringView(text).sliced(i, 1));
+    QCOMPARE(text.toUtf8(), utf8);
+    QCOMPARE(QStringEncoder(QStringEncoder::Utf8)(text), utf8);
+    QCOMPARE(QString::fromUtf8(utf8), text);
+    QCOMPARE(QStringDecoder(QStringDecoder::Utf8)(utf8), text);
+
+    // a corrupted byte only affects the character it is in: decoding the
+    // valid parts on either side separately must give the same result
+    const auto isContinuation = [](char c) { return (uchar(c) & 0xc0) == 0x80; };
+    for (qsizetype i = 0; i < utf8.size() - 1; ++i) {
+        qsizetype begin = i;
+        while (isContinuation(utf8.at(begin)))
+            --begin;
+        qsizetype end = i + 1;
+        while (isContinuation(utf8.at(end)))
+            ++end;
+        for (char bad : { '\xff', 'a', '\xc0', '\xe0', '\xed', '\xf4', '\x80', '\xbf' }) {
+            QByteArray corrupt = utf8;
+            corrupt[i] = bad;
+            const QByteArrayView view(corrupt);
+            const QString expected = QString::fromUtf8(view.first(begin))
+                    + QString::fromUtf8(view.sliced(begin, end - begin))
+                    + QString::fromUtf8(view.sliced(end));
+            QCOMPARE(QStringDecoder(QStringDecoder::Utf8)(corrupt), expected);
+            QCOMPARE(QString::fromUtf8(corrupt), expected);
+        }
+    }
+
+    for (qsizetype i = 0; i < text.size() - 1; ++i) {
+        for (char16_t bad : { u'\xd800', u'\xdbff', u'\xdc00', u'a', u'\x80', u'\u0800' }) {
+            QString corrupt = text;
+            corrupt[i] = bad;
+            QStringEncoder encoder(QStringEncoder::Utf8);
+            QByteArray expected;
+            for (qsizetype j = 0; j < corrupt.size(); ++j)
+                expected += encoder(QStringView(corrupt).sliced(j, 1));
+            QCOMPARE(QStringEncoder(QStringEncoder::Utf8)(corrupt), expected);
+            QCOMPARE(QString::fromUtf8(expected), QStringDecoder(QStringDecoder::Utf8)(expected));
+        }
+    }
+}
+
 void tst_QStringConverter::convertL1U16()
 {
     const QLatin1StringView latin1("some plain latin1 text");
@@ -4,6 +4,8 @@
 #include <QTest>
 #include <qstringmatcher.h>
 
+using namespace Qt::StringLiterals;
+
 class tst_QStringMatcher : public QObject
 {
     Q_OBJECT
@@ -16,6 +18,8 @@ private slots:
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
+    void multiStringMatcher_data();
+    void multiStringMatcher();
 };
 
 void tst_QStringMatcher::qstringmatcher()
@@ -146,6 +150,78 @@ void tst_QStringMatcher::assignOperator()
     QCOMPARE(m2.indexIn(hayStack), 3);
 }
 
+void tst_QStringMatcher::multiStringMatcher_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QString text = u"She sells sea shells by the SEA shore; ushers hush her, he, his, HERS"_s;
+    QTest::newRow("classic") << QStringList{ u"he"_s, u"she"_s, u"his"_s, u"hers"_s }
+                             << text << Qt::CaseSensitive;
+    QTest::newRow("classic-ci") << QStringList{ u"he"_s, u"she"_s, u"his"_s, u"hers"_s }
+                                << text << Qt::CaseInsensitive;
+    QTest::newRow("with-empty") << QStringList{ u"sea"_s, QString(), u"e"_s }
+                                << text << Qt::CaseInsensitive;
+    QTest::newRow("empty-set") << QStringList() << text << Qt::CaseSensitive;
+    QTest::newRow("non-latin1") << QStringList{ u"straße"_s, u"ΣΑΣ"_s, u"日本"_s, u"本語"_s }
+                                << u"Die STRASSE, die Straße, die STRAßE; σας ΣΑΣ; 日本語 日本"_s
+                                << Qt::CaseInsensitive;
+    QTest::newRow("non-latin1-cs") << QStringList{ u"straße"_s, u"ΣΑΣ"_s, u"日本"_s, u"本語"_s }
+                                   << u"Die STRASSE, die Straße, die STRAßE; σας ΣΑΣ; 日本語 日本"_s
+                                   << Qt::CaseSensitive;
+    QTest::newRow("surrogates") << QStringList{ u"😀"_s, u"😀😁"_s, u"a😁"_s }
+                                << u"😀a😁😀😁😀"_s << Qt::CaseSensitive;
+
+    QStringList many;
+    for (int i = 0; i < 200; ++i)
+        many.append(QString::number(i * 7919 % 1000));
+    QString digits;
+    for (int i = 0; i < 500; ++i)
+        digits += QString::number(i * 31 % 997);
+    QTest::newRow("many") << many << digits << Qt::CaseSensitive;
+}
+
+void tst_QStringMatcher::multiStringMatcher()
+{
+    QFETCH(const QStringList, patterns);
+    QFETCH(const QString, haystack);
+    QFETCH(const Qt::CaseSensitivity, cs);
+
+    QList<QMultiStringMatcher::Match> expected;
+    for (qsizetype position = 0; position <= haystack.size(); ++position) {
+        for (qsizetype i = 0; i < patterns.size(); ++i) {
+            if (QStringView(haystack).sliced(position).startsWith(patterns.at(i), cs))
+                expected.append({ position, i });
+        }
+    }
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+    QCOMPARE(matcher.matches(haystack), expected);
+
+    for (qsizetype from : { qsizetype(-1), qsizetype(0), qsizetype(5), haystack.size(),
+                            haystack.size() + 1 }) {
+        QList<QMultiStringMatcher::Match> tail;
+        for (const QMultiStringMatcher::Match &match : expected) {
+            if (match.position >= qMax(from, qsizetype(0)))
+                tail.append(match);
+        }
+        QCOMPARE(matcher.matches(haystack, from), tail);
+        qsizetype patternIndex = -2;
+        QCOMPARE(matcher.indexIn(haystack, from, &patternIndex),
+                 tail.isEmpty() ? -1 : tail.first().position);
+        QCOMPARE(patternIndex, tail.isEmpty() ? -1 : tail.first().patternIndex);
+    }
+
+    QMultiStringMatcher other = matcher;
+    other.setCaseSensitivity(cs == Qt::CaseSensitive ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    QCOMPARE(matcher.matches(haystack), expected);
+    other.setCaseSensitivity(cs);
+    QCOMPARE(other.matches(haystack), expected);
+}
+
 QTEST_MAIN(tst_QStringMatcher)
 #include "tst_qstringmatcher.moc"
 
@@ -10,6 +10,8 @@
 
 Q_DECLARE_METATYPE(Qt::SplitBehavior)
 
+using namespace Qt::StringLiterals;
+
 class tst_QStringTokenizer : public QObject
 {
     Q_OBJECT
@@ -19,6 +21,8 @@ private Q_SLOTS:
     void basics_data() const;
     void basics() const;
     void toContainer() const;
+    void singleCharacter_data() const;
+    void singleCharacter() const;
 };
 
 static QStringList skipped(const QStringList &sl)
@@ -135,5 +139,71 @@ void tst_QStringTokenizer::toContainer() const
     }
 }
 
+void tst_QStringTokenizer::singleCharacter_data() const
+{
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<QChar>("needle");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    // tokens of every length up to and beyond the 64-character scan window,
+    // so that separators fall on and around the window boundaries
+    QString gaps;
+    for (int length = 0; length < 140; length += (length < 70 ? 1 : 13)) {
+        gaps += QString(length, u'a');
+        gaps += u',';
+    }
+    QString runs = u",,,,"_s;
+    runs += QString(200, u'b');
+    runs += u",,"_s;
+
+    QTest::addRow("gaps") << gaps << QChar(u',') << Qt::CaseSensitive;
+    QTest::addRow("gaps-ci") << gaps << QChar(u',') << Qt::CaseInsensitive;
+    QTest::addRow("gaps-no-trailing") << gaps.chopped(1) << QChar(u',') << Qt::CaseSensitive;
+    QTest::addRow("runs") << runs << QChar(u',') << Qt::CaseSensitive;
+    QTest::addRow("no-separator") << QString(150, u'c') << QChar(u',') << Qt::CaseSensitive;
+    QTest::addRow("only-separators") << QString(130, u';') << QChar(u';') << Qt::CaseSensitive;
+    QTest::addRow("empty") << QString() << QChar(u',') << Qt::CaseSensitive;
+    QTest::addRow("letter-ci") << QString(gaps).replace(u',', u'X') << QChar(u'x') << Qt::CaseInsensitive;
+    QTest::addRow("kelvin-ci") << u"1k2K3\u212a4"_s.repeated(20) << QChar(u'k') << Qt::CaseInsensitive;
+    QTest::addRow("non-latin1") << QString(gaps).replace(u',', u'\u00b7') << QChar(u'\u00b7')
+                                << Qt::CaseSensitive;
+}
+
+void tst_QStringTokenizer::singleCharacter() const
+{
+    QFETCH(const QString, haystack);
+    QFETCH(const QChar, needle);
+    QFETCH(const Qt::CaseSensitivity, cs);
+
+    QStringList expected;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < haystack.size(); ++i) {
+        if (QStringView(haystack).sliced(i, 1).compare(QStringView(&needle, 1), cs) == 0) {
+            expected.append(haystack.sliced(start, i - start));
+            start = i + 1;
+        }
+    }
+    expected.append(haystack.sliced(start));
+
+    QCOMPARE(toQStringList(qTokenize(haystack, needle, cs)), expected);
+    QCOMPARE(toQStringList(qTokenize(haystack, needle, cs, Qt::SkipEmptyParts)), skipped(expected));
+    QCOMPARE(haystack.split(needle, Qt::KeepEmptyParts, cs), expected);
+    QCOMPARE(haystack.split(needle, Qt::SkipEmptyParts, cs), skipped(expected));
+    QCOMPARE(toQStringList(QStringView(haystack).split(needle, Qt::KeepEmptyParts, cs)), expected);
+
+    // the iterators are forward iterators: copies advance independently
+    const auto tok = qTokenize(haystack, needle, cs);
+    auto it = tok.begin();
+    for (qsizetype i = 0; i < expected.size(); ++i, ++it) {
+        QVERIFY(it != tok.end());
+        auto copy = it;
+        QCOMPARE(toQString(*copy), expected.at(i));
+        if (++copy != tok.end())
+            QCOMPARE(toQString(*copy), expected.at(i + 1));
+        QCOMPARE(toQString(*it), expected.at(i));
+    }
+    QVERIFY(it == tok.end());
+}
+
 QTEST_APPLESS_MAIN(tst_QStringTokenizer)
 #include "tst_qstringtokenizer.moc"
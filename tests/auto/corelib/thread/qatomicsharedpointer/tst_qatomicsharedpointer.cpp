@@ -0,0 +1,122 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QThread>
+
+#include <private/qatomicsharedpointer_p.h>
+
+#include <atomic>
+
+class tst_QAtomicSharedPointer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultConstructed();
+    void loadStore();
+    void exchange();
+    void oldSnapshotOutlivesStore();
+    void concurrentReadersAndWriter();
+};
+
+namespace {
+struct Counted
+{
+    explicit Counted(int value) : value(value) { ++alive; }
+    ~Counted() { --alive; }
+    int value;
+    static inline std::atomic<int> alive = 0;
+};
+}
+
+void tst_QAtomicSharedPointer::defaultConstructed()
+{
+    QAtomicSharedPointer<int> ptr;
+    QVERIFY(ptr.load().isNull());
+    QVERIFY(ptr.read([](const int *p) { return p == nullptr; }));
+}
+
+void tst_QAtomicSharedPointer::loadStore()
+{
+    {
+        QAtomicSharedPointer<Counted> ptr(QSharedPointer<const Counted>::create(1));
+        QCOMPARE(ptr.load()->value, 1);
+        QCOMPARE(ptr.read([](const Counted *p) { return p->value; }), 1);
+
+        ptr.store(QSharedPointer<const Counted>::create(2));
+        QCOMPARE(Counted::alive.load(), 1);
+        QCOMPARE(ptr.load()->value, 2);
+
+        ptr.store({});
+        QCOMPARE(Counted::alive.load(), 0);
+        QVERIFY(ptr.load().isNull());
+
+        ptr.store(QSharedPointer<const Counted>::create(3));
+    }
+    QCOMPARE(Counted::alive.load(), 0);
+}
+
+void tst_QAtomicSharedPointer::exchange()
+{
+    QAtomicSharedPointer<int> ptr(QSharedPointer<const int>::create(1));
+    const QSharedPointer<const int> old = ptr.exchange(QSharedPointer<const int>::create(2));
+    QCOMPARE(*old, 1);
+    QCOMPARE(*ptr.load(), 2);
+}
+
+void tst_QAtomicSharedPointer::oldSnapshotOutlivesStore()
+{
+    {
+        QAtomicSharedPointer<Counted> ptr(QSharedPointer<const Counted>::create(1));
+        const QSharedPointer<const Counted> snapshot = ptr.load();
+        ptr.store(QSharedPointer<const Counted>::create(2));
+        QCOMPARE(Counted::alive.load(), 2);
+        QCOMPARE(snapshot->value, 1);
+    }
+    QCOMPARE(Counted::alive.load(), 0);
+}
+
+void tst_QAtomicSharedPointer::concurrentReadersAndWriter()
+{
+    // The writer publishes pairs of equal values; readers must never see
+    // a torn or freed snapshot
+    using Snapshot = std::pair<int, int>;
+    QAtomicSharedPointer<Snapshot> ptr(QSharedPointer<const Snapshot>::create(0, 0));
+    std::atomic<bool> inconsistent = false;
+    constexpr int Iterations = 10000;
+
+    auto reader = [&] {
+        for (int i = 0; i < Iterations; ++i) {
+            if (i % 2) {
+                const QSharedPointer<const Snapshot> s = ptr.load();
+                if (s->first != s->second)
+                    inconsistent = true;
+            } else if (!ptr.read([](const Snapshot *s) { return s->first == s->second; })) {
+                inconsistent = true;
+            }
+        }
+    };
+    auto writer = [&] {
+        for (int i = 1; i <= Iterations / 10; ++i)
+            ptr.store(QSharedPointer<const Snapshot>::create(i, i));
+    };
+
+    QList<QThread *> threads;
+    for (int i = 0; i < 8; ++i)
+        threads << QThread::create(reader);
+    threads << QThread::create(writer);
+    for (QThread *thread : std::as_const(threads))
+        thread->start();
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    QVERIFY(!inconsistent);
+    QCOMPARE(ptr.load()->first, Iterations / 10);
+}
+
+QTEST_MAIN(tst_QAtomicSharedPointer)
+
+#include "tst_qatomicsharedpointer.moc"
@@ -0,0 +1,128 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QThread>
+
+#include <private/qconcurrentqueue_p.h>
+
+#include <memory>
+
+class tst_QConcurrentQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void capacity();
+    void tryPushPop();
+    void moveOnly();
+    void destroysRemainingValues();
+    void multipleProducersAndConsumers();
+    void readyHandler();
+};
+
+void tst_QConcurrentQueue::capacity()
+{
+    QCOMPARE(QConcurrentQueue<int>(0).capacity(), 2);
+    QCOMPARE(QConcurrentQueue<int>(2).capacity(), 2);
+    QCOMPARE(QConcurrentQueue<int>(5).capacity(), 8);
+    QCOMPARE(QConcurrentQueue<int>(8).capacity(), 8);
+}
+
+void tst_QConcurrentQueue::tryPushPop()
+{
+    QConcurrentQueue<int> queue(4);
+    QVERIFY(!queue.tryPop());
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i)
+            QVERIFY(queue.tryPush(i));
+        QVERIFY(!queue.tryPush(4));
+        for (int i = 0; i < 4; ++i)
+            QCOMPARE(queue.tryPop(), i);
+        QVERIFY(!queue.tryPop());
+    }
+}
+
+void tst_QConcurrentQueue::moveOnly()
+{
+    QConcurrentQueue<std::unique_ptr<int>> queue(2);
+    queue.push(std::make_unique<int>(1));
+    const std::unique_ptr<int> value = queue.pop();
+    QCOMPARE(*value, 1);
+}
+
+void tst_QConcurrentQueue::destroysRemainingValues()
+{
+    auto shared = std::make_shared<int>(0);
+    {
+        QConcurrentQueue<std::shared_ptr<int>> queue(4);
+        queue.push(shared);
+        queue.push(shared);
+        QCOMPARE(shared.use_count(), 3);
+    }
+    QCOMPARE(shared.use_count(), 1);
+}
+
+void tst_QConcurrentQueue::multipleProducersAndConsumers()
+{
+    constexpr int ProducerCount = 4;
+    constexpr int ConsumerCount = 4;
+    constexpr int ValuesPerProducer = 10000;
+    QConcurrentQueue<int> queue(16);
+    std::atomic<qint64> sum = 0;
+
+    QList<QThread *> threads;
+    for (int i = 0; i < ProducerCount; ++i) {
+        threads << QThread::create([&] {
+            for (int value = 1; value <= ValuesPerProducer; ++value)
+                queue.push(value);
+        });
+    }
+    for (int i = 0; i < ConsumerCount; ++i) {
+        threads << QThread::create([&] {
+            for (int n = 0; n < ProducerCount * ValuesPerProducer / ConsumerCount; ++n)
+                sum += queue.pop();
+        });
+    }
+    for (QThread *thread : std::as_const(threads))
+        thread->start();
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    QCOMPARE(sum.load(), qint64(ProducerCount) * ValuesPerProducer * (ValuesPerProducer + 1) / 2);
+    QVERIFY(!queue.tryPop());
+}
+
+void tst_QConcurrentQueue::readyHandler()
+{
+    QConcurrentQueue<int> queue(8);
+    int calls = 0;
+    QList<int> received;
+    queue.setReadyHandler(this, [&] {
+        ++calls;
+        while (std::optional<int> value = queue.tryPop())
+            received << *value;
+    });
+
+    QThread *producer = QThread::create([&] {
+        for (int i = 0; i < 5; ++i)
+            queue.push(i);
+    });
+    producer->start();
+    QVERIFY(producer->wait());
+    delete producer;
+
+    // all values pushed before the handler runs are delivered at once
+    QTRY_COMPARE(received, QList<int>({ 0, 1, 2, 3, 4 }));
+    QCOMPARE(calls, 1);
+
+    queue.push(5);
+    QTRY_COMPARE(received.size(), 6);
+    QCOMPARE(calls, 2);
+}
+
+QTEST_MAIN(tst_QConcurrentQueue)
+
+#include "tst_qconcurrentqueue.moc"
@@ -245,6 +245,7 @@ private slots:
     void cancelAfterFinishWithContinuations();
 
     void unwrap();
+    void coAwait();
 
 private:
     using size_type = std::vector<int>::size_type;
@@ -5306,5 +5307,92 @@ void tst_QFuture::unwrap()
     }
 }
 
+#ifdef __cpp_lib_coroutine
+namespace {
+// A coroutine that starts right away and can't be awaited itself
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { }
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+DetachedTask addOne(QFuture<int> future, int *result, bool *done)
+{
+    *result = co_await future + 1;
+    *done = true;
+}
+
+DetachedTask awaitVoid(QFuture<void> future, bool *done)
+{
+    co_await future;
+    *done = true;
+}
+
+DetachedTask awaitMoveOnly(QFuture<std::unique_ptr<int>> future, int *result)
+{
+    std::unique_ptr<int> value = co_await future;
+    *result = *value;
+}
+} // unnamed namespace
+#endif
+
+void tst_QFuture::coAwait()
+{
+#ifdef __cpp_lib_coroutine
+    // an already finished future doesn't suspend
+    {
+        int result = 0;
+        bool done = false;
+        addOne(QtFuture::makeReadyValueFuture(41), &result, &done);
+        QVERIFY(done);
+        QCOMPARE(result, 42);
+    }
+
+    // a pending one resumes the coroutine when it finishes
+    {
+        QPromise<int> promise;
+        int result = 0;
+        bool done = false;
+        addOne(promise.future(), &result, &done);
+        QVERIFY(!done);
+        promise.start();
+        promise.addResult(1);
+        promise.finish();
+        QVERIFY(done);
+        QCOMPARE(result, 2);
+    }
+
+    // and so does a canceled one
+    {
+        QPromise<void> promise;
+        bool done = false;
+        awaitVoid(promise.future(), &done);
+        QVERIFY(!done);
+        promise.start();
+        promise.future().cancel();
+        promise.finish();
+        QVERIFY(done);
+    }
+
+    {
+        QPromise<std::unique_ptr<int>> promise;
+        int result = 0;
+        awaitMoveOnly(promise.future(), &result);
+        promise.start();
+        promise.addResult(std::make_unique<int>(3));
+        promise.finish();
+        QCOMPARE(result, 3);
+    }
+#else
+    QSKIP("This test requires coroutine support");
+#endif
+}
+
 QTEST_MAIN(tst_QFuture)
 #include "tst_qfuture.moc"
@@ -10,6 +10,7 @@
 #include <qthread.h>
 #include <qwaitcondition.h>
 #include <private/qemulationdetector_p.h>
+#include <private/qreadmostlylock_p.h>
 #include <private/qvolatile_p.h>
 
 #ifdef Q_OS_UNIX
@@ -26,6 +27,8 @@
 
 #include <stdio.h>
 
+#include <shared_mutex>
+
 using namespace std::chrono_literals;
 
 class tst_QReadWriteLock : public QObject
@@ -70,6 +73,8 @@ private slots:
     // recursive locking tests
     void recursiveReadLock();
     void recursiveWriteLock();
+
+    void readMostlyLock();
 };
 
 void tst_QReadWriteLock::constructDestruct()
@@ -1068,6 +1073,49 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+void tst_QReadWriteLock::readMostlyLock()
+{
+    // Writers keep two values equal, readers check that they never see
+    // them differ
+    QReadMostlyLock lock;
+    int first = 0;
+    int second = 0;
+    std::atomic<bool> inconsistent = false;
+    constexpr int Iterations = 10000;
+
+    auto reader = [&] {
+        for (int i = 0; i < Iterations; ++i) {
+            const std::shared_lock locker(lock);
+            if (first != second)
+                inconsistent = true;
+        }
+    };
+    auto writer = [&] {
+        for (int i = 0; i < Iterations / 10; ++i) {
+            const std::unique_lock locker(lock);
+            ++first;
+            QThread::yieldCurrentThread();
+            ++second;
+        }
+    };
+
+    QList<QThread *> threads;
+    for (int i = 0; i < 8; ++i)
+        threads << QThread::create(reader);
+    for (int i = 0; i < 2; ++i)
+        threads << QThread::create(writer);
+    for (QThread *thread : std::as_const(threads))
+        thread->start();
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    QVERIFY(!inconsistent);
+    QCOMPARE(first, 2 * Iterations / 10);
+    QCOMPARE(second, first);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
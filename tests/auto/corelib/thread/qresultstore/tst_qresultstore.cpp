@@ -33,6 +33,7 @@ private slots:
     void filterMode();
     void addCanceledResult();
     void count();
+    void inOrderResults();
     void pendingResultsDoNotLeak_data();
     void pendingResultsDoNotLeak();
 private:
@@ -555,6 +556,36 @@ struct CountedObject
 
 size_t CountedObject::liveCount = 0;
 
+void tst_QtConcurrentResultStore::inOrderResults()
+{
+    QtPrivate::ResultStoreBase store;
+    IntResultsCleaner cleanGuard(store);
+
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(store.addResult(-1, &i), 3 * i);
+        QCOMPARE(store.addResults(-1, &vec0), 3 * i + 1);
+        QCOMPARE(store.count(), 3 * i + 3);
+    }
+
+    // results already present are rejected
+    QCOMPARE(store.addResult(150, &int0), -1);
+    QCOMPARE(store.addResults(0, &vec1), -1);
+
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(store.resultAt(3 * i).value<int>(), i);
+        QCOMPARE(store.resultAt(3 * i + 1).value<int>(), 2);
+        QCOMPARE(store.resultAt(3 * i + 2).value<int>(), 3);
+    }
+
+    // a gap stops the count until it is filled
+    QCOMPARE(store.addResult(301, &int1), 301);
+    QCOMPARE(store.count(), 300);
+    QCOMPARE(store.addResult(300, &int0), 300);
+    QCOMPARE(store.count(), 302);
+    QCOMPARE(store.addResult(-1, &int2), 302);
+    QCOMPARE(store.count(), 303);
+}
+
 void tst_QtConcurrentResultStore::pendingResultsDoNotLeak_data()
 {
     QTest::addColumn<bool>("filterMode");
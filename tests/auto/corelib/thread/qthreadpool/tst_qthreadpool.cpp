@@ -76,6 +76,7 @@ private slots:
     void tryStartCount();
     void priorityStart_data();
     void priorityStart();
+    void workStealing();
     void waitForDone();
     void clear();
     void clearWithAutoDelete();
@@ -1034,6 +1035,34 @@ void tst_QThreadPool::priorityStart()
     QCOMPARE(firstStarted.loadRelaxed(), expected);
 }
 
+void tst_QThreadPool::workStealing()
+{
+    constexpr int Fanout = 8;
+    constexpr int Depth = 4;
+    QAtomicInt runs;
+
+    TestThreadPool threadPool;
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    // every task started from a worker goes to that worker's own queue
+    std::function<void(int)> spawn = [&](int level) {
+        runs.ref();
+        if (level == Depth)
+            return;
+        for (int i = 0; i < Fanout; ++i)
+            threadPool.start([&spawn, level] { spawn(level + 1); });
+    };
+    threadPool.start([&spawn] { spawn(0); });
+    WAIT_FOR_DONE(threadPool);
+
+    int expected = 0;
+    for (int level = 0, n = 1; level <= Depth; ++level, n *= Fanout)
+        expected += n;
+    QCOMPARE(runs.loadRelaxed(), expected);
+}
+
 void tst_QThreadPool::waitForDone()
 {
     QElapsedTimer total, pass;
@@ -2823,6 +2823,20 @@ void tst_QDateTime::fromStringDateFormat_data()
         << QString::fromLatin1("2017-07-01TZ") << Qt::ISODate << QDateTime();
     QTest::newRow("ISO mis-punctuated")
         << QString::fromLatin1("2018/01/30 ") << Qt::ISODate << QDateTime();
+    // RFC 3339 layouts, as commonly found in logs:
+    QTest::newRow("RFC 3339 microseconds Z")
+        << QString::fromLatin1("2023-03-04T05:06:07.123456Z") << Qt::ISODate
+        << QDateTime(QDate(2023, 3, 4), QTime(5, 6, 7, 123), UTC);
+    QTest::newRow("RFC 3339 lower-case, space, offset")
+        << QString::fromLatin1("2023-03-04 05:06:07.5-02:30") << Qt::ISODate
+        << QDateTime(QDate(2023, 3, 4), QTime(7, 36, 7, 500), UTC);
+    QTest::newRow("RFC 3339 rounding up into the next second")
+        << QString::fromLatin1("2023-03-04t05:06:07.9999z") << Qt::ISODate
+        << QDateTime(QDate(2023, 3, 4), QTime(5, 6, 8), UTC);
+    QTest::newRow("RFC 3339 invalid day")
+        << QString::fromLatin1("2023-02-30T05:06:07Z") << Qt::ISODate << QDateTime();
+    QTest::newRow("RFC 3339 invalid offset")
+        << QString::fromLatin1("2023-03-04T05:06:07+24:00") << Qt::ISODate << QDateTime();
 
     // Test Qt::RFC2822Date format (RFC 2822).
     QTest::newRow("RFC 2822 +0100") << QString::fromLatin1("13 Feb 1987 13:24:51 +0100")
@@ -35,6 +35,9 @@ private slots:
     void countBits_data();
     void countBits();
     void countBits2();
+    void findNext_data();
+    void findNext();
+    void largeBitwiseOperators();
     void isEmpty();
     void swap();
     void fill();
@@ -163,6 +166,83 @@ void tst_QBitArray::countBits2()
     }
 }
 
+void tst_QBitArray::findNext_data()
+{
+    QTest::addColumn<QString>("bitField");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("1") << QString("1");
+    QTest::newRow("0") << QString("0");
+    QTest::newRow("01001") << QString("01001");
+    QTest::newRow("11111111") << QString("11111111");
+    QTest::newRow("000000000") << QString("000000000");
+    QTest::newRow("sparse") << QString("0000000000000000000000000000000000000000001000000000000000000000000001");
+    QTest::newRow("dense") << QString("1111111111111111111111111111111111111111110111111111111111111111111110");
+    QTest::newRow("mixed") << QString("1010011100001111000001111100000011111110000000011111111000000000111111111");
+}
+
+void tst_QBitArray::findNext()
+{
+    QFETCH(QString, bitField);
+    const QBitArray bits = QStringToQBitArray(bitField);
+
+    for (qsizetype from = 0; from <= bits.size(); ++from) {
+        qsizetype nextSet = -1;
+        qsizetype nextClear = -1;
+        for (qsizetype i = from; i < bits.size(); ++i) {
+            if (nextSet < 0 && bits.testBit(i))
+                nextSet = i;
+            if (nextClear < 0 && !bits.testBit(i))
+                nextClear = i;
+        }
+        QCOMPARE(bits.findNextSet(from), nextSet);
+        QCOMPARE(bits.findNextClear(from), nextClear);
+    }
+
+    qsizetype count = 0;
+    for (qsizetype i = bits.findNextSet(0); i != -1; i = bits.findNextSet(i + 1))
+        ++count;
+    QCOMPARE(count, bits.count(true));
+}
+
+void tst_QBitArray::largeBitwiseOperators()
+{
+    // arrays of different lengths, longer than a word, and not multiples of
+    // 8 bits
+    QBitArray a(1003);
+    QBitArray b(517);
+    for (qsizetype i = 0; i < a.size(); i += 3)
+        a.setBit(i);
+    for (qsizetype i = 0; i < b.size(); i += 5)
+        b.setBit(i);
+
+    auto check = [&](const QBitArray &result, auto op) {
+        if (result.size() != a.size())
+            return false;
+        for (qsizetype i = 0; i < result.size(); ++i) {
+            const bool x = a.testBit(i);
+            const bool y = i < b.size() && b.testBit(i);
+            if (result.testBit(i) != op(x, y))
+                return false;
+        }
+        return true;
+    };
+    QVERIFY(check(a & b, [](bool x, bool y) { return x && y; }));
+    QVERIFY(check(b & a, [](bool x, bool y) { return x && y; }));
+    QVERIFY(check(a | b, [](bool x, bool y) { return x || y; }));
+    QVERIFY(check(b | a, [](bool x, bool y) { return x || y; }));
+    QVERIFY(check(a ^ b, [](bool x, bool y) { return x != y; }));
+    QVERIFY(check(b ^ a, [](bool x, bool y) { return x != y; }));
+
+    const QBitArray inverted = ~a;
+    QCOMPARE(inverted.size(), a.size());
+    QCOMPARE(inverted.count(true), a.count(false));
+    QCOMPARE(inverted.findNextSet(0), qsizetype(1));
+    QCOMPARE(inverted.findNextClear(0), qsizetype(0));
+    // the padding bits stay cleared
+    QCOMPARE(~inverted, a);
+}
+
 void tst_QBitArray::isEmpty()
 {
     QBitArray a1;
@@ -0,0 +1,271 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/qconcurrentcache.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insertAndLookup();
+    void replace();
+    void cost();
+    void setMaxCost();
+    void clockEviction();
+    void objectOutlivesEviction();
+    void removeAndTake();
+    void clear();
+    void concurrentAccess();
+};
+
+struct Counted
+{
+    static inline QAtomicInt alive = 0;
+    int value;
+    explicit Counted(int v) : value(v) { alive.ref(); }
+    ~Counted() { alive.deref(); }
+};
+
+void tst_QConcurrentCache::empty()
+{
+    QConcurrentCache<int, int> cache;
+    QCOMPARE(cache.maxCost(), 100);
+    QCOMPARE(cache.shardCount(), 16);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.totalCost(), 0);
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.object(1));
+    QVERIFY(!cache.remove(1));
+    QVERIFY(!cache.take(1));
+    QVERIFY(cache.keys().isEmpty());
+
+    QConcurrentCache<int, int> odd(10, 5);
+    QCOMPARE(odd.shardCount(), 8);
+    QConcurrentCache<int, int> single(10, 0);
+    QCOMPARE(single.shardCount(), 1);
+}
+
+void tst_QConcurrentCache::insertAndLookup()
+{
+    QConcurrentCache<QString, QString> cache(1000);
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(cache.insert(QString::number(i), new QString(u"value %1"_s.arg(i)), 2));
+    QCOMPARE(cache.size(), 100);
+    QCOMPARE(cache.count(), 100);
+    QCOMPARE(cache.totalCost(), 200);
+
+    for (int i = 0; i < 100; ++i) {
+        QVERIFY(cache.contains(QString::number(i)));
+        const auto object = cache.object(QString::number(i));
+        QVERIFY(object);
+        QCOMPARE(*object, u"value %1"_s.arg(i));
+        QCOMPARE(*cache[QString::number(i)], *object);
+    }
+    QVERIFY(!cache.contains(u"100"_s));
+
+    QList<QString> keys = cache.keys();
+    QCOMPARE(keys.size(), 100);
+    std::sort(keys.begin(), keys.end(), [](const QString &a, const QString &b) {
+        return a.toInt() < b.toInt();
+    });
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(keys.at(i), QString::number(i));
+}
+
+void tst_QConcurrentCache::replace()
+{
+    QConcurrentCache<int, Counted> cache(10);
+    QVERIFY(cache.insert(1, new Counted(1), 3));
+    QVERIFY(cache.insert(1, new Counted(2), 5));
+    QCOMPARE(Counted::alive.loadRelaxed(), 1);
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 5);
+    QCOMPARE(cache.object(1)->value, 2);
+    cache.clear();
+    QCOMPARE(Counted::alive.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::cost()
+{
+    QConcurrentCache<int, Counted> cache(100);
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(cache.insert(i, new Counted(i), 1 + i % 7));
+        QVERIFY(cache.totalCost() <= cache.maxCost());
+        // the object that was just inserted is never the one evicted
+        QVERIFY(cache.contains(i));
+    }
+    QCOMPARE(Counted::alive.loadRelaxed(), cache.size());
+
+    // objects that cost more than the whole cache are refused, like by QCache
+    QVERIFY(cache.contains(999));
+    QVERIFY(!cache.insert(999, new Counted(-1), 101));
+    QVERIFY(!cache.contains(999));
+    QCOMPARE(Counted::alive.loadRelaxed(), cache.size());
+
+    QVERIFY(cache.insert(-1, new Counted(-1), 100));
+    QCOMPARE(cache.size(), 1);
+    QCOMPARE(cache.totalCost(), 100);
+    cache.clear();
+    QCOMPARE(Counted::alive.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::setMaxCost()
+{
+    QConcurrentCache<int, int> cache(100, 4);
+    for (int i = 0; i < 100; ++i)
+        cache.insert(i, new int(i));
+    QCOMPARE(cache.totalCost(), 100);
+    cache.setMaxCost(30);
+    QCOMPARE(cache.maxCost(), 30);
+    QCOMPARE(cache.totalCost(), 30);
+    QCOMPARE(cache.size(), 30);
+    QCOMPARE(cache.keys().size(), 30);
+    cache.setMaxCost(0);
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+}
+
+void tst_QConcurrentCache::clockEviction()
+{
+    // with a single shard, the eviction order is that of CLOCK
+    QConcurrentCache<int, int> cache(10, 1);
+    for (int i = 0; i < 10; ++i)
+        cache.insert(i, new int(i));
+
+    // the first eviction clears all reference bits on its way
+    cache.insert(10, new int(10));
+    QVERIFY(!cache.contains(0));
+
+    // objects that were used since are spared
+    for (int i = 1; i < 5; ++i)
+        QVERIFY(cache.object(i));
+    for (int i = 11; i < 15; ++i)
+        cache.insert(i, new int(i));
+    for (int i = 1; i < 5; ++i)
+        QVERIFY(cache.contains(i));
+    for (int i = 5; i < 9; ++i)
+        QVERIFY(!cache.contains(i));
+    QCOMPARE(cache.size(), 10);
+}
+
+void tst_QConcurrentCache::objectOutlivesEviction()
+{
+    QConcurrentCache<int, Counted> cache(1);
+    cache.insert(1, new Counted(1));
+    const QSharedPointer<Counted> held = cache.object(1);
+    cache.insert(2, new Counted(2));
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(Counted::alive.loadRelaxed(), 2);
+    QCOMPARE(held->value, 1);
+    cache.clear();
+    QCOMPARE(Counted::alive.loadRelaxed(), 1);
+}
+
+void tst_QConcurrentCache::removeAndTake()
+{
+    QConcurrentCache<int, Counted> cache(100);
+    for (int i = 0; i < 10; ++i)
+        cache.insert(i, new Counted(i), 2);
+
+    QVERIFY(cache.remove(3));
+    QVERIFY(!cache.remove(3));
+    QCOMPARE(cache.size(), 9);
+    QCOMPARE(cache.totalCost(), 18);
+    QCOMPARE(Counted::alive.loadRelaxed(), 9);
+
+    QSharedPointer<Counted> taken = cache.take(5);
+    QVERIFY(taken);
+    QCOMPARE(taken->value, 5);
+    QVERIFY(!cache.contains(5));
+    QCOMPARE(cache.totalCost(), 16);
+    QCOMPARE(Counted::alive.loadRelaxed(), 9);
+    taken.reset();
+    QCOMPARE(Counted::alive.loadRelaxed(), 8);
+
+    // a null object is still an entry
+    QVERIFY(cache.insert(42, nullptr));
+    QVERIFY(cache.contains(42));
+    QVERIFY(cache.remove(42));
+
+    // reusing the entries of removed objects
+    cache.insert(3, new Counted(3), 2);
+    cache.insert(5, new Counted(5), 2);
+    QCOMPARE(cache.size(), 10);
+    QCOMPARE(cache.totalCost(), 20);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(cache.object(i)->value, i);
+    cache.clear();
+    QCOMPARE(Counted::alive.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::clear()
+{
+    QConcurrentCache<int, Counted> cache(1000);
+    for (int i = 0; i < 500; ++i)
+        cache.insert(i, new Counted(i), 2);
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+    QCOMPARE(Counted::alive.loadRelaxed(), 0);
+    QVERIFY(!cache.contains(1));
+
+    cache.insert(1, new Counted(1));
+    QCOMPARE(cache.object(1)->value, 1);
+    cache.clear();
+}
+
+void tst_QConcurrentCache::concurrentAccess()
+{
+    QConcurrentCache<int, Counted> cache(200);
+    constexpr int ThreadCount = 4;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&cache, t] {
+            QRandomGenerator rng(t);
+            for (int i = 0; i < 20000; ++i) {
+                const int key = rng.bounded(500);
+                switch (rng.bounded(8)) {
+                case 0:
+                    cache.remove(key);
+                    break;
+                case 1:
+                case 2:
+                    cache.insert(key, new Counted(key), 1 + key % 3);
+                    break;
+                default:
+                    if (const auto object = cache.object(key))
+                        QCOMPARE(object->value, key);
+                    break;
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QVERIFY(cache.totalCost() <= cache.maxCost());
+    QCOMPARE(cache.keys().size(), cache.size());
+    QCOMPARE(Counted::alive.loadRelaxed(), cache.size());
+    qsizetype totalCost = 0;
+    for (int key : cache.keys())
+        totalCost += 1 + key % 3;
+    QCOMPARE(cache.totalCost(), totalCost);
+    cache.clear();
+    QCOMPARE(Counted::alive.loadRelaxed(), 0);
+}
+
+QTEST_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
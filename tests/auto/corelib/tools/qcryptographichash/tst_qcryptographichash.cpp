@@ -23,6 +23,10 @@ private slots:
     void intermediary_result_data();
     void intermediary_result();
     void sha1();
+    void blockBoundaries_data();
+    void blockBoundaries();
+    void hashMany_data() { hashLength_data(); }
+    void hashMany();
     void sha3_data();
     void sha3();
     void blake2_data();
@@ -196,6 +200,113 @@ void tst_QCryptographicHash::sha1()
              QByteArray("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F"));
 }
 
+static QByteArray blockTestData(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i * 7 + 3);
+    return data;
+}
+
+void tst_QCryptographicHash::blockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QByteArray>("hash");
+
+    QTest::addRow("Sha1-55") << QCryptographicHash::Sha1 << 55
+                              << QByteArray("ddf57317ef34bfee3b6df83d359098930eb278bc");
+    QTest::addRow("Sha224-55") << QCryptographicHash::Sha224 << 55
+                              << QByteArray("703a7d6e61c83903b5db54ddf6dda2268211b47c90bbdac2ed306d8a");
+    QTest::addRow("Sha256-55") << QCryptographicHash::Sha256 << 55
+                              << QByteArray("e7313d333c272e639f790978283f9eb392e843d0f29b7016828bb1daa4aac70b");
+    QTest::addRow("Sha1-56") << QCryptographicHash::Sha1 << 56
+                              << QByteArray("a0d492bb0fc889d0eca3bc137066ab6f4f74f369");
+    QTest::addRow("Sha224-56") << QCryptographicHash::Sha224 << 56
+                              << QByteArray("850fef35478d7a94a417713dbded4a39c18be2b40e6f20f47066d306");
+    QTest::addRow("Sha256-56") << QCryptographicHash::Sha256 << 56
+                              << QByteArray("4324d65f3c103567f5589c710bc08f8523f929a9272e3af36fc968e52abc6c27");
+    QTest::addRow("Sha1-63") << QCryptographicHash::Sha1 << 63
+                              << QByteArray("c55856749bef509bdfe6bfebfc7bf4e793e82132");
+    QTest::addRow("Sha224-63") << QCryptographicHash::Sha224 << 63
+                              << QByteArray("246a939bfdd1eedb1ad51b53a250d197b5752aab09580b7f1df50df7");
+    QTest::addRow("Sha256-63") << QCryptographicHash::Sha256 << 63
+                              << QByteArray("81c80242132f230c3bd41b3e63bbcff16107339549214a99614ff26664625055");
+    QTest::addRow("Sha1-64") << QCryptographicHash::Sha1 << 64
+                              << QByteArray("bede92be29c3874e1b54ddc77988d606fc857a8e");
+    QTest::addRow("Sha224-64") << QCryptographicHash::Sha224 << 64
+                              << QByteArray("e480c1c21ffd3f109fc0cde0daf967c748932b64f8e259d98db17420");
+    QTest::addRow("Sha256-64") << QCryptographicHash::Sha256 << 64
+                              << QByteArray("39e3d7b6b5d075d37d053ad89b24b41bef4f3c29760c84447cab3f3be1882241");
+    QTest::addRow("Sha1-65") << QCryptographicHash::Sha1 << 65
+                              << QByteArray("b05a80522b053d6dc7e0a517d0e70212c7dad11f");
+    QTest::addRow("Sha224-65") << QCryptographicHash::Sha224 << 65
+                              << QByteArray("574507bf89b5d3a0b5dcf4a684a645f27f058f3b11fde279d5b0e462");
+    QTest::addRow("Sha256-65") << QCryptographicHash::Sha256 << 65
+                              << QByteArray("aacca6ff74fdbb296d165a45cecfa04e5127bc008770fbbdd48006f2d2fae95e");
+    QTest::addRow("Sha1-119") << QCryptographicHash::Sha1 << 119
+                              << QByteArray("504e27376a6e0f0dba8295b85cb25dc4dfa17d23");
+    QTest::addRow("Sha224-119") << QCryptographicHash::Sha224 << 119
+                              << QByteArray("6c9c99e7d1090cb995200ccc9fc757a4383d3a1004cc36bc266c7947");
+    QTest::addRow("Sha256-119") << QCryptographicHash::Sha256 << 119
+                              << QByteArray("9ce7368e4daf32341631b492e80359dc9f594b48453cd0dd5bf0b19279cc177e");
+    QTest::addRow("Sha1-120") << QCryptographicHash::Sha1 << 120
+                              << QByteArray("82134b02fb3f702491be9bed581eeab59334acb2");
+    QTest::addRow("Sha224-120") << QCryptographicHash::Sha224 << 120
+                              << QByteArray("d733ebb80612c4699bfca3061aab0cd9e138ef73aecf1d0f23e75340");
+    QTest::addRow("Sha256-120") << QCryptographicHash::Sha256 << 120
+                              << QByteArray("7836b787757e95e58b3ca5aec90b1b004e8deba1e50e9675af9cabf1a13a04b5");
+    QTest::addRow("Sha1-1000") << QCryptographicHash::Sha1 << 1000
+                              << QByteArray("4231a8a50a10fa9758db8ec71fdef855b751048a");
+    QTest::addRow("Sha224-1000") << QCryptographicHash::Sha224 << 1000
+                              << QByteArray("23729dacbd480285c5c68439e2fe22ca5611a63cd6c14d2ec5ae2c85");
+    QTest::addRow("Sha256-1000") << QCryptographicHash::Sha256 << 1000
+                              << QByteArray("1e9bc38cbf860b9ec31918b065f9b52476c549a782e0e7990bed8ce3868d2371");
+}
+
+void tst_QCryptographicHash::blockBoundaries()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const int, size);
+    QFETCH(const QByteArray, hash);
+
+    const QByteArray data = blockTestData(size);
+    QCOMPARE(QCryptographicHash::hash(data, algorithm).toHex(), hash);
+
+    for (int chunkSize : { 1, 7, 63, 64, 65, 100 }) {
+        QCryptographicHash incremental(algorithm);
+        for (qsizetype i = 0; i < data.size(); i += chunkSize)
+            incremental.addData(QByteArrayView(data).sliced(i, qMin<qsizetype>(chunkSize, data.size() - i)));
+        QCOMPARE(incremental.result().toHex(), hash);
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    if (algorithm == QCryptographicHash::NumAlgorithms)
+        QSKIP("No hash to compare with");
+    if (!QCryptographicHash::supportsAlgorithm(algorithm))
+        QSKIP("QCryptographicHash doesn't support this algorithm");
+
+    QCOMPARE(QCryptographicHash::hashMany({}, algorithm), QList<QByteArray>());
+
+    // messages of different lengths, so that both the paired and the
+    // remaining single messages cross block boundaries
+    const QByteArray data = blockTestData(300);
+    QList<QByteArrayView> messages;
+    for (qsizetype size : { 0, 300, 55, 56, 3, 64, 65, 128, 200, 1, 119, 120, 127 })
+        messages.append(QByteArrayView(data).first(size));
+
+    for (qsizetype count = 0; count <= messages.size(); ++count) {
+        const QList<QByteArrayView> subset = messages.first(count);
+        const QList<QByteArray> hashes = QCryptographicHash::hashMany(subset, algorithm);
+        QCOMPARE(hashes.size(), count);
+        for (qsizetype i = 0; i < count; ++i)
+            QCOMPARE(hashes.at(i), QCryptographicHash::hash(subset.at(i), algorithm));
+    }
+}
+
 void tst_QCryptographicHash::sha3_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -0,0 +1,250 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/qdensehash.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+class tst_QDenseHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insertAndLookup();
+    void overwrite();
+    void emplace();
+    void remove();
+    void eraseWhileIterating();
+    void copyAndMove();
+    void reserveAndSqueeze();
+    void moveOnlyValues();
+    void randomOperations();
+};
+
+void tst_QDenseHash::empty()
+{
+    QDenseHash<int, int> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1), 0);
+    QCOMPARE(hash.value(1, 42), 42);
+    QVERIFY(hash.find(1) == hash.end());
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(!hash.remove(1));
+    QCOMPARE(hash.take(1), 0);
+    hash.clear();
+    hash.squeeze();
+    QCOMPARE(hash.capacity(), 0);
+}
+
+void tst_QDenseHash::insertAndLookup()
+{
+    QDenseHash<int, QString> hash;
+    for (int i = 0; i < 10000; ++i)
+        hash.insert(i * 3, QString::number(i));
+    QCOMPARE(hash.size(), 10000);
+    QVERIFY(hash.capacity() >= hash.size());
+
+    for (int i = 0; i < 30000; ++i) {
+        QCOMPARE(hash.contains(i), i % 3 == 0);
+        QCOMPARE(hash.value(i), i % 3 == 0 ? QString::number(i / 3) : QString());
+    }
+
+    auto it = hash.constFind(300);
+    QVERIFY(it != hash.constEnd());
+    QCOMPARE(it.key(), 300);
+    QCOMPARE(it.value(), u"100"_s);
+    QCOMPARE(*it, u"100"_s);
+    QCOMPARE(it->size(), 3);
+
+    qsizetype visited = 0;
+    for (auto i = hash.cbegin(); i != hash.cend(); ++i) {
+        QCOMPARE(i.value(), QString::number(i.key() / 3));
+        ++visited;
+    }
+    QCOMPARE(visited, hash.size());
+    QCOMPARE(hash.keys().size(), hash.size());
+    QCOMPARE(hash.values().size(), hash.size());
+
+    QDenseHash<QString, int> strings = { { u"one"_s, 1 }, { u"two"_s, 2 }, { u"three"_s, 3 } };
+    QCOMPARE(strings.size(), 3);
+    QCOMPARE(strings.value(u"two"_s), 2);
+    QVERIFY(!strings.contains(u"four"_s));
+}
+
+void tst_QDenseHash::overwrite()
+{
+    QDenseHash<int, QString> hash;
+    hash.insert(1, u"a"_s);
+    hash.insert(1, u"b"_s);
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(1), u"b"_s);
+
+    hash[1] += u"c"_s;
+    hash[2] = u"d"_s;
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), u"bc"_s);
+    QCOMPARE(hash.value(2), u"d"_s);
+
+    const auto &constHash = hash;
+    QCOMPARE(constHash[3], QString());
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QDenseHash::emplace()
+{
+    QDenseHash<QString, QString> hash;
+    auto it = hash.emplace(u"key"_s, 3, u'x');
+    QCOMPARE(it.key(), u"key"_s);
+    QCOMPARE(*it, u"xxx"_s);
+    it = hash.emplace(u"key"_s, 2, u'y');
+    QCOMPARE(*it, u"yy"_s);
+    QCOMPARE(hash.size(), 1);
+}
+
+void tst_QDenseHash::remove()
+{
+    QDenseHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 500);
+    QCOMPARE(hash.take(1), 1);
+    QCOMPARE(hash.size(), 499);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1 && i != 1);
+
+    // reusing the deleted slots must not grow the table
+    const qsizetype capacity = hash.capacity();
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 1000; i += 2)
+            hash.insert(i, round);
+        for (int i = 0; i < 1000; i += 2)
+            hash.remove(i);
+    }
+    QCOMPARE(hash.capacity(), capacity);
+    QCOMPARE(hash.size(), 499);
+}
+
+void tst_QDenseHash::eraseWhileIterating()
+{
+    QDenseHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        if (it.key() % 3)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(hash.size(), 334);
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it)
+        QCOMPARE(it.key() % 3, 0);
+}
+
+void tst_QDenseHash::copyAndMove()
+{
+    QDenseHash<int, QString> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, QString::number(i));
+    for (int i = 0; i < 100; i += 3)
+        hash.remove(i);
+
+    QDenseHash<int, QString> copy = hash;
+    QCOMPARE(copy, hash);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(copy.value(i), hash.value(i));
+    copy.insert(1000, u"new"_s);
+    QVERIFY(copy != hash);
+    QVERIFY(!hash.contains(1000));
+
+    QDenseHash<int, QString> moved = std::move(copy);
+    QVERIFY(copy.isEmpty());
+    QCOMPARE(moved.value(1000), u"new"_s);
+
+    copy = moved;
+    QCOMPARE(copy, moved);
+    moved = std::move(hash);
+    QVERIFY(!moved.contains(1000));
+    QCOMPARE(moved.size(), 66);
+
+    copy.swap(moved);
+    QCOMPARE(copy.size(), 66);
+    QCOMPARE(moved.size(), 67);
+}
+
+void tst_QDenseHash::reserveAndSqueeze()
+{
+    QDenseHash<int, int> hash;
+    hash.reserve(1000);
+    const qsizetype capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QCOMPARE(hash.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    hash.insert(1, 1);
+    QCOMPARE(hash.value(1), 1);
+}
+
+void tst_QDenseHash::moveOnlyValues()
+{
+    QDenseHash<int, std::unique_ptr<int>> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.emplace(i, std::make_unique<int>(i));
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(*hash.find(i).value(), i);
+    std::unique_ptr<int> taken = hash.take(42);
+    QCOMPARE(*taken, 42);
+    QVERIFY(!hash.contains(42));
+}
+
+void tst_QDenseHash::randomOperations()
+{
+    QDenseHash<int, int> hash;
+    QHash<int, int> reference;
+    QRandomGenerator rng(42);
+    for (int i = 0; i < 100000; ++i) {
+        const int key = rng.bounded(2000);
+        switch (rng.bounded(4)) {
+        case 0:
+        case 1:
+            hash.insert(key, i);
+            reference.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(hash.remove(key), reference.remove(key));
+            break;
+        case 3:
+            QCOMPARE(hash.value(key, -1), reference.value(key, -1));
+            break;
+        }
+        QCOMPARE(hash.size(), reference.size());
+    }
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(hash.value(it.key()), it.value());
+}
+
+QTEST_APPLESS_MAIN(tst_QDenseHash)
+#include "tst_qdensehash.moc"
@@ -2,18 +2,19 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #define QT_USE_QSTRINGBUILDER
-#define QFLATMAP_ENABLE_STL_COMPATIBLE_INSERT
 
 #include <QTest>
 
-#include <private/qflatmap_p.h>
+#include <qflatmap.h>
 #include <qbytearray.h>
+#include <qrandom.h>
 #include <qstring.h>
 #include <qstringview.h>
 #include <qvarlengtharray.h>
 
 #include <algorithm>
 #include <list>
+#include <map>
 #include <tuple>
 
 static constexpr bool is_even(int n) { return n % 2 == 0; }
@@ -38,6 +39,8 @@ private slots:
     void constAccess();
     void insertion();
     void insertRValuesAndLValues();
+    void insertRange();
+    void lowerBound();
     void removal();
     void extraction();
     void iterators();
@@ -196,6 +199,83 @@ void tst_QFlatMap::insertRValuesAndLValues()
 #undef lvalue
 }
 
+void tst_QFlatMap::insertRange()
+{
+    using Map = QFlatMap<int, QByteArray>;
+    Map m{ { 2, "two" }, { 4, "four" }, { 6, "six" } };
+
+    // unsorted, with duplicates among the new elements and of existing keys
+    const std::vector<Map::value_type> unsorted = {
+        { 5, "five" }, { 4, "FOUR" }, { 1, "one" }, { 5, "FIVE" }, { 3, "three" }, { 7, "seven" }
+    };
+    m.insert(unsorted.cbegin(), unsorted.cend());
+    QCOMPARE(m.keys(), QList<int>({ 1, 2, 3, 4, 5, 6, 7 }));
+    QCOMPARE(m.values(), QList<QByteArray>({ "one", "two", "three", "four", "five", "six", "seven" }));
+
+    // sorted, and all after the existing keys
+    const std::vector<Map::value_type> tail = {
+        { 7, "SEVEN" }, { 8, "eight" }, { 9, "nine" }, { 9, "NINE" }
+    };
+    m.insert(tail.cbegin(), tail.cend());
+    QCOMPARE(m.keys(), QList<int>({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    QCOMPARE(m.value(7), "seven");
+    QCOMPARE(m.value(9), "nine");
+
+    Map empty;
+    empty.insert(unsorted.cbegin(), unsorted.cend());
+    QCOMPARE(empty.keys(), QList<int>({ 1, 3, 4, 5, 7 }));
+    QCOMPARE(empty.value(5), "five");
+
+    QRandomGenerator rng(42);
+    QFlatMap<int, int> random;
+    std::map<int, int> reference;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<const int, int>> batch;
+        for (quint32 n = rng.bounded(200); n; --n)
+            batch.emplace_back(rng.bounded(1000), round);
+        random.insert(batch.cbegin(), batch.cend());
+        reference.insert(batch.cbegin(), batch.cend());
+        QCOMPARE(random.size(), qsizetype(reference.size()));
+        QVERIFY(std::equal(random.cbegin(), random.cend(), reference.cbegin(), reference.cend(),
+                           [](const auto &lhs, const auto &rhs) {
+                               return lhs.first == rhs.first && lhs.second == rhs.second;
+                           }));
+    }
+}
+
+void tst_QFlatMap::lowerBound()
+{
+    QRandomGenerator rng(42);
+    for (qsizetype size : { 0, 1, 2, 3, 15, 16, 17, 100, 1000 }) {
+        QFlatMap<int, int> map;
+        QFlatMap<double, int> doubles;
+        for (qsizetype i = 0; i < size; ++i) {
+            const int key = int(rng.bounded(4 * size)) - int(size);
+            map.insert(key, key);
+            doubles.insert(key / 2.0, key);
+        }
+        const QList<int> keys = map.keys();
+        const QList<double> doubleKeys = doubles.keys();
+
+        for (int key = int(-size) - 2; key < int(3 * size) + 2; ++key) {
+            const auto it = map.lower_bound(key);
+            const qsizetype expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            QCOMPARE(it - map.cbegin(), expected);
+            QCOMPARE(map.find(key) != map.end(), keys.contains(key));
+
+            const double dkey = key / 2.0 + 0.25;
+            const auto dit = doubles.lower_bound(dkey);
+            QCOMPARE(dit - doubles.cbegin(),
+                     std::lower_bound(doubleKeys.begin(), doubleKeys.end(), dkey) - doubleKeys.begin());
+        }
+    }
+
+    // not eligible for the branchless search
+    QFlatMap<int, int, std::greater<int>> descending{ { 1, 1 }, { 5, 5 }, { 3, 3 } };
+    QCOMPARE(descending.lower_bound(4).key(), 3);
+    QCOMPARE(descending.lower_bound(0), descending.end());
+}
+
 void tst_QFlatMap::extraction()
 {
     using Map = QFlatMap<int, QByteArray>;
@@ -0,0 +1,184 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmonotonicarena.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+class tst_QMonotonicArena : public QObject
+{
+    Q_OBJECT
+private slots:
+    void current();
+    void list();
+    void growInPlace();
+    void strings();
+    void hash();
+    void largeAllocations();
+    void outliveArena();
+    void releaseOnOtherThread();
+};
+
+void tst_QMonotonicArena::current()
+{
+    QCOMPARE(QMonotonicArena::current(), nullptr);
+    {
+        QMonotonicArena outer;
+        QCOMPARE(QMonotonicArena::current(), &outer);
+        {
+            QMonotonicArena inner(4096);
+            QCOMPARE(inner.blockSize(), 4096);
+            QCOMPARE(QMonotonicArena::current(), &inner);
+        }
+        QCOMPARE(QMonotonicArena::current(), &outer);
+    }
+    QCOMPARE(QMonotonicArena::current(), nullptr);
+}
+
+void tst_QMonotonicArena::list()
+{
+    QMonotonicArena arena;
+    QList<int> list;
+    for (int i = 0; i < 1000; ++i)
+        list.append(i);
+    QVERIFY(arena.bytesAllocated() >= qsizetype(1000 * sizeof(int)));
+
+    QList<int> copy = list;
+    copy.prepend(-1);
+    QCOMPARE(copy.size(), 1001);
+    QCOMPARE(copy.first(), -1);
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(list.at(i), i);
+        QCOMPARE(copy.at(i + 1), i);
+    }
+
+    QList<std::shared_ptr<int>> owning;
+    for (int i = 0; i < 100; ++i)
+        owning.emplace_back(std::make_shared<int>(i));
+    owning.erase(owning.begin(), owning.begin() + 50);
+    QCOMPARE(owning.size(), 50);
+    QCOMPARE(*owning.front(), 50);
+}
+
+void tst_QMonotonicArena::growInPlace()
+{
+    QMonotonicArena arena;
+    QByteArray data;
+    for (int i = 0; i < 4000; ++i)
+        data.append(char('a' + i % 26));
+    QCOMPARE(data.size(), 4000);
+    QCOMPARE(data.at(3999), char('a' + 3999 % 26));
+
+    // appending reallocates the last allocation, so the arena grows it
+    // instead of handing out a new copy each time
+    QVERIFY(arena.bytesAllocated() < 2 * 4000);
+}
+
+void tst_QMonotonicArena::strings()
+{
+    QMonotonicArena arena(1024);
+    QStringList list;
+    for (int i = 0; i < 500; ++i)
+        list.append(u"item %1"_s.arg(i));
+    const QString joined = list.join(u',');
+    QVERIFY(arena.bytesAllocated() > 0);
+    QCOMPARE(joined.count(u','), 499);
+    QCOMPARE(joined.split(u',').at(321), u"item 321"_s);
+}
+
+void tst_QMonotonicArena::hash()
+{
+    QMonotonicArena arena;
+    QHash<int, QString> hash;
+    for (int i = 0; i < 5000; ++i)
+        hash.insert(i, QString::number(i));
+    QVERIFY(arena.bytesAllocated() > 0);
+    for (int i = 0; i < 5000; i += 2)
+        hash.remove(i);
+    QCOMPARE(hash.size(), 2500);
+
+    QHash<int, QString> copy = hash;
+    copy.insert(-1, u"detached"_s);
+    QCOMPARE(copy.size(), 2501);
+    for (int i = 1; i < 5000; i += 2)
+        QCOMPARE(hash.value(i), QString::number(i));
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(copy.value(-1), u"detached"_s);
+}
+
+void tst_QMonotonicArena::largeAllocations()
+{
+    QMonotonicArena arena(4096);
+    const QByteArray large(100000, 'x');
+    QCOMPARE(arena.bytesAllocated(), 0);
+    QCOMPARE(large.count('x'), 100000);
+
+    const QByteArray small(100, 'y');
+    QVERIFY(arena.bytesAllocated() >= 100);
+}
+
+void tst_QMonotonicArena::outliveArena()
+{
+    QList<QString> list;
+    QHash<QString, int> hash;
+    {
+        QMonotonicArena arena(1024);
+        for (int i = 0; i < 200; ++i) {
+            list.append(QString::number(i));
+            hash.insert(QString::number(i), i);
+        }
+        QVERIFY(arena.bytesAllocated() > 0);
+    }
+
+    // the blocks in use stay valid, and the containers move to the heap
+    // when they grow
+    for (int i = 200; i < 1000; ++i) {
+        list.append(QString::number(i));
+        hash.insert(QString::number(i), i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        QCOMPARE(list.at(i), QString::number(i));
+        QCOMPARE(hash.value(QString::number(i)), i);
+    }
+    list.clear();
+    hash.clear();
+}
+
+void tst_QMonotonicArena::releaseOnOtherThread()
+{
+    auto list = std::make_unique<QList<QByteArray>>();
+    auto hash = std::make_unique<QHash<int, QByteArray>>();
+    {
+        QMonotonicArena arena;
+        for (int i = 0; i < 1000; ++i) {
+            list->append(QByteArray::number(i));
+            hash->insert(i, QByteArray::number(i));
+        }
+    }
+
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        QMonotonicArena arena;
+        QCOMPARE(list->at(999), "999");
+        QCOMPARE(hash->value(999), "999");
+        list.reset();
+        hash.reset();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(!list);
+    QVERIFY(!hash);
+}
+
+QTEST_APPLESS_MAIN(tst_QMonotonicArena)
+#include "tst_qmonotonicarena.moc"
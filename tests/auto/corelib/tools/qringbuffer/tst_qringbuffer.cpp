@@ -19,6 +19,7 @@ private slots:
     void readPointerAtPositionEmptyRead();
     void readPointerAtPositionWithHead();
     void readPointerAtPositionReadTooMuch();
+    void readBlocks();
     void sizeWhenReservedAndChopped();
     void sizeWhenReserved();
     void free();
@@ -104,6 +105,30 @@ void tst_QRingBuffer::readPointerAtPositionReadTooMuch()
     QCOMPARE(length, Q_INT64_C(0));
 }
 
+void tst_QRingBuffer::readBlocks()
+{
+    QRingBuffer ringBuffer;
+    QByteArrayView blocks[4];
+    QCOMPARE(ringBuffer.readBlocks(blocks, 4), 0);
+
+    const QByteArray first(5000, 'a');
+    const QByteArray second(6000, 'b');
+    const QByteArray third(7000, 'c');
+    ringBuffer.append(first);
+    ringBuffer.append(second);
+    ringBuffer.append(third);
+    ringBuffer.free(1000);
+
+    QCOMPARE(ringBuffer.readBlocks(blocks, 4), 3);
+    QCOMPARE(blocks[0], QByteArrayView(first).sliced(1000));
+    QVERIFY(blocks[1].data() == second.constData());
+    QCOMPARE(blocks[1], second);
+    QCOMPARE(blocks[2], third);
+
+    QCOMPARE(ringBuffer.readBlocks(blocks, 2), 2);
+    QCOMPARE(blocks[1], second);
+}
+
 void tst_QRingBuffer::readPointerAtPositionWithHead()
 {
     QRingBuffer ringBuffer;
@@ -41,6 +41,7 @@ private slots:
     void streamAvailableSizes();
     void fromTheme();
     void fromThemeCache();
+    void fromThemeIndex();
 
 #ifndef QT_NO_WIDGETS
     void task184901_badCache();
@@ -813,6 +814,56 @@ void tst_QIcon::fromThemeCache()
     QVERIFY(QIcon::fromTheme("notexist-fallback").isNull());
 }
 
+void tst_QIcon::fromThemeIndex()
+{
+    // keep the index files out of the user's cache
+    QStandardPaths::setTestModeEnabled(true);
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+
+    const QString actions = dir.path() + QLatin1String("/testindex/16x16/actions");
+    QVERIFY(QDir().mkpath(actions));
+    QVERIFY(QDir().mkpath(dir.path() + QLatin1String("/testindex/32x32/actions")));
+    QVERIFY(QFile(QStringLiteral(":/styles/commonstyle/images/standardbutton-open-16.png"))
+        .copy(actions + QLatin1String("/button-open.png")));
+    {
+        QFile index(dir.path() + QLatin1String("/testindex/index.theme"));
+        QVERIFY(index.open(QFile::WriteOnly));
+        index.write("[Icon Theme]\nDirectories=16x16/actions,32x32/actions,48x48/actions\n"
+                    "[16x16/actions]\nSize=16\nType=Fixed\n"
+                    "[32x32/actions]\nSize=32\nType=Fixed\n"
+                    "[48x48/actions]\nSize=48\nType=Fixed\n");
+    }
+    QIcon::setThemeSearchPaths(QStringList() << dir.path());
+    QIcon::setThemeName("testindex");
+
+    QVERIFY(QIcon::hasThemeIcon("button-open"));
+    QCOMPARE(QIcon::fromTheme("button-open").availableSizes(), QList<QSize>() << QSize(16, 16));
+    QCOMPARE(QIcon::fromTheme("button-open-fallback").name(), QString("button-open"));
+    QVERIFY(!QIcon::hasThemeIcon("button-save"));
+
+    // Adding an icon changes the modification time of its directory, which
+    // makes the index stale
+    QTest::qWait(1000); // wait enough to have a different modification time in seconds
+    QVERIFY(QFile(QStringLiteral(":/styles/commonstyle/images/standardbutton-save-16.png"))
+        .copy(actions + QLatin1String("/button-save.png")));
+    QIcon::setThemeSearchPaths(QStringList() << dir.path()); // reload themes
+    QVERIFY(QIcon::hasThemeIcon("button-save"));
+    QVERIFY(QIcon::hasThemeIcon("button-open"));
+    QVERIFY(!QIcon::hasThemeIcon("button-close"));
+
+    // So does adding a directory of the theme
+    QVERIFY(QDir().mkpath(dir.path() + QLatin1String("/testindex/48x48/actions")));
+    QVERIFY(QFile(QStringLiteral(":/styles/commonstyle/images/standardbutton-save-32.png"))
+        .copy(dir.path() + QLatin1String("/testindex/48x48/actions/button-close.png")));
+    QIcon::setThemeSearchPaths(QStringList() << dir.path()); // reload themes
+    QVERIFY(QIcon::hasThemeIcon("button-close"));
+
+    QIcon::setThemeSearchPaths(QStringList());
+    QStandardPaths::setTestModeEnabled(false);
+}
+
 void tst_QIcon::task223279_inconsistentAddFile()
 {
     QIcon icon1;
@@ -171,6 +171,7 @@ private slots:
     void scaled_QTBUG19157();
 
     void convertOverUnPreMul();
+    void convertFloat16RoundTrip();
 
     void scaled_QTBUG35972();
 
@@ -3255,6 +3256,41 @@ void tst_QImage::convertOverUnPreMul()
     }
 }
 
+void tst_QImage::convertFloat16RoundTrip()
+{
+    // wider than the chunks the half-float formats are converted in
+    QImage image(300, 256, QImage::Format_ARGB32);
+    for (int j = 0; j < image.height(); j++) {
+        for (int i = 0; i < image.width(); i++)
+            image.setPixel(i, j, qRgba(i & 0xff, j, (i + j) & 0xff, (i * 7 + j) & 0xff));
+    }
+
+    // every 8-bit value is exact in half precision
+    const QImage opaque = image.convertToFormat(QImage::Format_RGB32);
+    const QImage f16opaque = opaque.convertToFormat(QImage::Format_RGBX16FPx4);
+    QCOMPARE(f16opaque.convertToFormat(QImage::Format_RGB32), opaque);
+    QCOMPARE(f16opaque.convertToFormat(QImage::Format_RGBX32FPx4).convertToFormat(QImage::Format_RGB32), opaque);
+
+    const QImage f16 = image.convertToFormat(QImage::Format_RGBA16FPx4);
+
+    const QImage pm = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const QImage f16pm = f16.convertToFormat(QImage::Format_RGBA16FPx4_Premultiplied);
+    const QImage f32pm = f16.convertToFormat(QImage::Format_RGBA32FPx4_Premultiplied);
+    const QImage pm2 = f16pm.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    const QImage pm3 = f32pm.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int j = 0; j < image.height(); j++) {
+        for (int i = 0; i < image.width(); i++) {
+            const QRgb expected = pm.pixel(i, j);
+            for (QRgb actual : { pm2.pixel(i, j), pm3.pixel(i, j) }) {
+                QCOMPARE(qAlpha(actual), qAlpha(expected));
+                QVERIFY(qAbs(qRed(actual) - qRed(expected)) <= 1);
+                QVERIFY(qAbs(qGreen(actual) - qGreen(expected)) <= 1);
+                QVERIFY(qAbs(qBlue(actual) - qBlue(expected)) <= 1);
+            }
+        }
+    }
+}
+
 void tst_QImage::scaled_QTBUG35972()
 {
     QImage src(532,519,QImage::Format_ARGB32_Premultiplied);
@@ -0,0 +1,181 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QHash>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <qimage.h>
+#include <qimagebatchreader.h>
+
+class tst_QImageBatchReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readMany();
+    void readFailure();
+    void scaledSize();
+    void concurrencyLimit();
+    void memoryBudget();
+    void cancel();
+    void deleteWhileReading();
+
+private:
+    QString writeImage(int index, QSize size = QSize(64, 48));
+
+    QTemporaryDir dir;
+};
+
+void tst_QImageBatchReader::initTestCase()
+{
+    QVERIFY(dir.isValid());
+}
+
+QString tst_QImageBatchReader::writeImage(int index, QSize size)
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(qRgb(index % 256, (index * 7) % 256, 128));
+    const QString fileName = dir.filePath(QString::number(index) + u".png");
+    if (!image.save(fileName))
+        return QString();
+    return fileName;
+}
+
+void tst_QImageBatchReader::readMany()
+{
+    QImageBatchReader reader;
+    QSignalSpy readSpy(&reader, &QImageBatchReader::imageRead);
+    QSignalSpy finishedSpy(&reader, &QImageBatchReader::finished);
+
+    QHash<int, int> indexForId;
+    for (int i = 0; i < 40; ++i) {
+        const QString fileName = writeImage(i);
+        QVERIFY(!fileName.isEmpty());
+        indexForId.insert(reader.read(fileName), i);
+    }
+    QCOMPARE(reader.pendingCount(), 40);
+
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(readSpy.size(), 40);
+    QCOMPARE(reader.pendingCount(), 0);
+    for (const QList<QVariant> &arguments : std::as_const(readSpy)) {
+        const int index = indexForId.take(arguments.at(0).toInt());
+        const QImage image = arguments.at(1).value<QImage>();
+        QCOMPARE(image.size(), QSize(64, 48));
+        QCOMPARE(image.pixel(0, 0), qRgb(index % 256, (index * 7) % 256, 128));
+    }
+    QVERIFY(indexForId.isEmpty());
+}
+
+void tst_QImageBatchReader::readFailure()
+{
+    QImageBatchReader reader;
+    QSignalSpy readSpy(&reader, &QImageBatchReader::imageRead);
+    QSignalSpy failedSpy(&reader, &QImageBatchReader::readFailed);
+    QSignalSpy finishedSpy(&reader, &QImageBatchReader::finished);
+
+    const int good = reader.read(writeImage(0));
+    const int bad = reader.read(dir.filePath(QStringLiteral("does-not-exist.png")));
+
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(0).toInt(), good);
+    QCOMPARE(failedSpy.size(), 1);
+    QCOMPARE(failedSpy.at(0).at(0).toInt(), bad);
+    QVERIFY(!failedSpy.at(0).at(1).toString().isEmpty());
+}
+
+void tst_QImageBatchReader::scaledSize()
+{
+    QImageBatchReader reader;
+    reader.setScaledSize(QSize(16, 12));
+    QCOMPARE(reader.scaledSize(), QSize(16, 12));
+    QSignalSpy readSpy(&reader, &QImageBatchReader::imageRead);
+
+    reader.read(writeImage(1, QSize(160, 120)));
+    QTRY_COMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(1).value<QImage>().size(), QSize(16, 12));
+}
+
+void tst_QImageBatchReader::concurrencyLimit()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    QImageBatchReader reader;
+    reader.setThreadPool(&pool);
+    QCOMPARE(reader.threadPool(), &pool);
+    reader.setMaximumConcurrentReads(2);
+    QCOMPARE(reader.maximumConcurrentReads(), 2);
+
+    QSignalSpy finishedSpy(&reader, &QImageBatchReader::finished);
+    int delivered = 0;
+    connect(&reader, &QImageBatchReader::imageRead, this, [&] { ++delivered; });
+    for (int i = 0; i < 10; ++i)
+        reader.read(writeImage(i));
+    // the queued reads only start as running ones are delivered
+    QVERIFY(pool.activeThreadCount() <= 2);
+    QCOMPARE(reader.pendingCount(), 10);
+
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(delivered, 10);
+}
+
+void tst_QImageBatchReader::memoryBudget()
+{
+    QImageBatchReader reader;
+    // smaller than a single image, so they are decoded one at a time
+    reader.setMemoryBudget(1024);
+    QCOMPARE(reader.memoryBudget(), qsizetype(1024));
+
+    QSignalSpy readSpy(&reader, &QImageBatchReader::imageRead);
+    QSignalSpy finishedSpy(&reader, &QImageBatchReader::finished);
+    for (int i = 0; i < 8; ++i)
+        reader.read(writeImage(i));
+
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(readSpy.size(), 8);
+}
+
+void tst_QImageBatchReader::cancel()
+{
+    QImageBatchReader reader;
+    reader.setMaximumConcurrentReads(1);
+    QSignalSpy readSpy(&reader, &QImageBatchReader::imageRead);
+    QSignalSpy finishedSpy(&reader, &QImageBatchReader::finished);
+
+    for (int i = 0; i < 10; ++i)
+        reader.read(writeImage(i));
+    reader.cancel();
+    QVERIFY(reader.pendingCount() <= 1);
+    QTRY_COMPARE(reader.pendingCount(), 0);
+    QCOMPARE(readSpy.size(), 0);
+    QCOMPARE(finishedSpy.size(), 0);
+
+    // the reader can be used again
+    const int id = reader.read(writeImage(3));
+    QTRY_COMPARE(finishedSpy.size(), 1);
+    QCOMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(0).toInt(), id);
+}
+
+void tst_QImageBatchReader::deleteWhileReading()
+{
+    QThreadPool pool;
+    {
+        QImageBatchReader reader;
+        reader.setThreadPool(&pool);
+        reader.setMemoryBudget(1);
+        for (int i = 0; i < 10; ++i)
+            reader.read(writeImage(i, QSize(400, 300)));
+    }
+    // the reads still running must not block or touch the deleted reader
+    QVERIFY(pool.waitForDone(10000));
+}
+
+QTEST_MAIN(tst_QImageBatchReader)
+#include "tst_qimagebatchreader.moc"
@@ -66,6 +66,10 @@ private slots:
     void setClipRect_data();
     void setClipRect();
 
+    void pngClipRect_data();
+    void pngClipRect();
+    void readIntoExistingBuffer();
+
     void setScaledClipRect_data();
     void setScaledClipRect();
 
@@ -439,6 +443,54 @@ void tst_QImageReader::setClipRect()
     QCOMPARE(originalImage.copy(newRect), image);
 }
 
+void tst_QImageReader::pngClipRect_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QRect>("clipRect");
+    QTest::addColumn<QSize>("scaledSize");
+
+    QTest::newRow("top") << "kollada.png" << QRect(0, 0, 50, 20) << QSize();
+    QTest::newRow("middle") << "kollada.png" << QRect(13, 17, 41, 29) << QSize();
+    QTest::newRow("bottom right") << "kollada.png" << QRect(100, 100, 50, 50) << QSize();
+    QTest::newRow("partly outside") << "kollada.png" << QRect(-10, 20, 50, 50) << QSize();
+    QTest::newRow("scaled") << "kollada.png" << QRect(13, 17, 41, 29) << QSize(20, 10);
+    QTest::newRow("16 bpc") << "kollada-16bpc.png" << QRect(13, 17, 41, 29) << QSize();
+    QTest::newRow("16 bpc scaled") << "kollada-16bpc.png" << QRect(13, 17, 41, 29) << QSize(20, 10);
+}
+
+void tst_QImageReader::pngClipRect()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QRect, clipRect);
+    QFETCH(QSize, scaledSize);
+
+    QImageReader reader(prefix + fileName);
+    reader.setClipRect(clipRect);
+    reader.setScaledSize(scaledSize);
+    QImage image = reader.read();
+    QVERIFY(!image.isNull());
+
+    const QImage clipped = QImage(prefix + fileName).copy(clipRect);
+    if (scaledSize.isValid())
+        QCOMPARE(image.size(), scaledSize);
+    else
+        QCOMPARE(image, clipped);
+}
+
+void tst_QImageReader::readIntoExistingBuffer()
+{
+    const QImage reference(prefix + "kollada.png");
+    QVERIFY(!reference.isNull());
+
+    QByteArray buffer(reference.sizeInBytes(), Qt::Uninitialized);
+    QImage image(reinterpret_cast<uchar *>(buffer.data()), reference.width(), reference.height(),
+                 reference.bytesPerLine(), reference.format());
+    QImageReader reader(prefix + "kollada.png");
+    QVERIFY(reader.read(&image));
+    QCOMPARE(image.constBits(), reinterpret_cast<const uchar *>(buffer.constData()));
+    QCOMPARE(image, reference);
+}
+
 void tst_QImageReader::setScaledClipRect_data()
 {
     QTest::addColumn<QString>("fileName");
@@ -31,6 +31,7 @@ private slots:
     void save_restore();
     void boundaryValues_data();
     void boundaryValues();
+    void playOnImage();
 };
 
 tst_QPicture::tst_QPicture()
@@ -268,6 +269,46 @@ void tst_QPicture::boundaryValues()
     painter.end();
 }
 
+void tst_QPicture::playOnImage()
+{
+    QPicture picture;
+    QPainter painter(&picture);
+    painter.fillRect(0, 0, 500, 500, Qt::white);
+    painter.setPen(QPen(Qt::blue, 3));
+    painter.setBrush(Qt::red);
+    painter.drawEllipse(20, 30, 400, 420);
+    painter.rotate(10);
+    painter.drawRect(100, 50, 200, 300);
+    painter.resetTransform();
+    painter.setClipRect(0, 100, 250, 250);
+    painter.setCompositionMode(QPainter::CompositionMode_Multiply);
+    painter.fillRect(50, 50, 400, 400, QColor(0, 255, 0, 128));
+    painter.end();
+
+    QImage expected(500, 500, QImage::Format_ARGB32_Premultiplied);
+    expected.fill(Qt::transparent);
+    QPainter expectedPainter(&expected);
+    QVERIFY(picture.play(&expectedPainter));
+    expectedPainter.end();
+
+    QImage image(500, 500, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QVERIFY(picture.play(&image));
+    QCOMPARE(image, expected);
+
+    // a picture with a pixmap is played serially
+    QPicture withPixmap;
+    painter.begin(&withPixmap);
+    QPixmap pixmap(10, 10);
+    pixmap.fill(Qt::red);
+    painter.drawPixmap(200, 200, pixmap);
+    painter.end();
+    QImage image2(500, 500, QImage::Format_ARGB32_Premultiplied);
+    image2.fill(Qt::transparent);
+    QVERIFY(withPixmap.play(&image2));
+    QCOMPARE(image2.pixel(205, 205), qRgb(255, 0, 0));
+}
+
 QTEST_MAIN(tst_QPicture)
 #include "tst_qpicture.moc"
 
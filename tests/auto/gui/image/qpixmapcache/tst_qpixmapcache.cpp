@@ -6,6 +6,13 @@
 
 #include <qpixmapcache.h>
 #include "private/qpixmapcache_p.h"
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+#include "private/qsharedimagecache_p.h"
+#include <QtCore/qcoreapplication.h>
+#include <QtGui/qimage.h>
+
+#include <cmath>
+#endif
 
 QT_BEGIN_NAMESPACE // The test requires QT_BUILD_INTERNAL
 Q_AUTOTEST_EXPORT void qt_qpixmapcache_flush_detached_pixmaps();
@@ -42,6 +49,11 @@ private slots:
     void clearDoesNotLeakStringKeys();
     void strictCacheLimit();
     void noCrashOnLargeInsert();
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+    void sharedImageCache();
+    void sharedImageCacheEviction();
+    void sharedCache();
+#endif
 };
 
 static QPixmapCache::KeyData* getPrivate(QPixmapCache::Key &key)
@@ -587,5 +599,111 @@ void tst_QPixmapCache::noCrashOnLargeInsert()
     QVERIFY(true); // no crash
 }
 
+#if QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+static QString uniqueSharedCacheName(const char *function)
+{
+    return u"tst_qpixmapcache-%1-%2"_s.arg(QLatin1StringView(function))
+            .arg(QCoreApplication::applicationPid());
+}
+
+void tst_QPixmapCache::sharedImageCache()
+{
+    const QString name = uniqueSharedCacheName(Q_FUNC_INFO);
+    QSharedImageCache writer(name);
+    QVERIFY(writer.attach(1024 * 1024));
+    QSharedImageCache reader(name);
+    QVERIFY(reader.attach(1024 * 1024));
+    QCOMPARE(reader.dataSize(), writer.dataSize());
+
+    QImage image(31, 17, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x)
+            image.setPixel(x, y, qPremultiply(qRgba(x * 8, y * 15, x ^ y, 128 + x)));
+    }
+    image.setDevicePixelRatio(2);
+
+    QImage found;
+    QVERIFY(!reader.find(u"image", &found));
+    QVERIFY(writer.insert(u"image", image));
+    QVERIFY(reader.find(u"image", &found));
+    QCOMPARE(found, image);
+    QCOMPARE(found.devicePixelRatio(), 2.0);
+    QVERIFY(!reader.find(u"imagf", nullptr));
+
+    // Replacing an entry
+    image.fill(Qt::red);
+    QVERIFY(reader.insert(u"image", image));
+    QVERIFY(writer.find(u"image", &found));
+    QCOMPARE(found, image);
+
+    writer.remove(u"image");
+    QVERIFY(!reader.find(u"image", nullptr));
+
+    QVERIFY(writer.insert(u"image", image));
+    reader.clear();
+    QVERIFY(!writer.find(u"image", nullptr));
+}
+
+void tst_QPixmapCache::sharedImageCacheEviction()
+{
+    QSharedImageCache cache(uniqueSharedCacheName(Q_FUNC_INFO));
+    QVERIFY(cache.attach(256 * 1024));
+
+    // Each image takes about a sixth of the data area
+    const int side = int(std::sqrt(cache.dataSize() / 4 / 6.0));
+    QImage image(side, side, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    for (int i = 0; i < 5; ++i)
+        QVERIFY(cache.insert(QString::number(i), image));
+    for (int i = 0; i < 5; ++i)
+        QVERIFY(cache.find(QString::number(i), nullptr));
+
+    // Using "0" makes "1" the least recently used entry
+    QVERIFY(cache.find(u"0", nullptr));
+    QVERIFY(cache.insert(u"5", image));
+    QVERIFY(cache.insert(u"6", image));
+    QVERIFY(cache.find(u"0", nullptr));
+    QVERIFY(!cache.find(u"1", nullptr));
+    QVERIFY(cache.find(u"6", nullptr));
+
+    // An image that would take more than a quarter of the cache is refused
+    QVERIFY(!cache.insert(u"big", QImage(side * 3, side * 3, QImage::Format_RGB32)));
+    QVERIFY(cache.find(u"6", nullptr));
+}
+
+void tst_QPixmapCache::sharedCache()
+{
+    const QString name = uniqueSharedCacheName(Q_FUNC_INFO);
+    QSharedImageCache other(name);
+    QVERIFY(other.attach(1024 * 1024));
+
+    QVERIFY(QPixmapCache::attachSharedCache(name, 1024));
+    QPixmap pixmap(20, 20);
+    pixmap.fill(Qt::green);
+    QVERIFY(QPixmapCache::insert(u"shared"_s, pixmap));
+    QVERIFY(other.find(u"shared", nullptr));
+
+    // A pixmap inserted by another process is found after a local miss
+    QImage image(10, 10, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::magenta);
+    QVERIFY(other.insert(u"fromOther", image));
+    QPixmap found;
+    QVERIFY(QPixmapCache::find(u"fromOther"_s, &found));
+    QCOMPARE(found.toImage().convertToFormat(image.format()), image);
+
+    // clear() only clears the local cache
+    QPixmapCache::clear();
+    QVERIFY(QPixmapCache::find(u"shared"_s, &found));
+    QCOMPARE(found.size(), pixmap.size());
+
+    QPixmapCache::remove(u"shared"_s);
+    QVERIFY(!other.find(u"shared", nullptr));
+
+    QPixmapCache::detachSharedCache();
+    QPixmapCache::clear();
+    QVERIFY(!QPixmapCache::find(u"fromOther"_s, nullptr));
+}
+#endif // QT_CONFIG(sharedmemory) && QT_CONFIG(systemsemaphore)
+
 QTEST_MAIN(tst_QPixmapCache)
 #include "tst_qpixmapcache.moc"
@@ -64,6 +64,7 @@ private slots:
     void rootPath();
     void readOnly();
     void iconProvider();
+    void lazyIcons();
 
     void rowCount();
 
@@ -87,6 +88,8 @@ private slots:
     void sortPersistentIndex();
     void sort_data();
     void sort();
+    void sortNewFiles_data();
+    void sortNewFiles();
 
     void mkdir();
     void deleteFile();
@@ -308,6 +311,28 @@ void tst_QFileSystemModel::iconProvider()
     QCOMPARE(myModel->fileIcon(myModel->index(QDir::homePath())).pixmap(50, 50), mb);
 }
 
+void tst_QFileSystemModel::lazyIcons()
+{
+    QScopedPointer<QFileSystemModel> model(new QFileSystemModel);
+    CustomFileIconProvider provider;
+    model->setIconProvider(&provider);
+    const QString tmp = flatDirTestPath;
+    QVERIFY(createFiles(model.data(), tmp, QStringList(), 0, { "dir" }));
+
+    const QModelIndex root = model->setRootPath(tmp);
+    QTRY_COMPARE(model->rowCount(root), 1);
+    const QModelIndex dir = model->index(0, 0, root);
+    QSignalSpy spy(model.data(), &QAbstractItemModel::dataChanged);
+
+    // A generic icon is used until the icon of the directory is fetched
+    const QPixmap mb = QApplication::style()->standardIcon(QStyle::SP_MessageBoxCritical).pixmap(50, 50);
+    QVERIFY(model->fileIcon(dir).pixmap(50, 50).toImage() != mb.toImage());
+    QTRY_COMPARE(model->fileIcon(dir).pixmap(50, 50), mb);
+    QVERIFY(!spy.isEmpty());
+    QCOMPARE(spy.constLast().at(0).toModelIndex(), dir);
+    QCOMPARE(spy.constLast().at(2).value<QList<int>>(), QList<int>{ Qt::DecorationRole });
+}
+
 bool tst_QFileSystemModel::createFiles(QFileSystemModel *model, const QString &test_path,
                                        const QStringList &initial_files, int existingFileCount,
                                        const QStringList &initial_dirs)
@@ -884,6 +909,52 @@ void tst_QFileSystemModel::sort()
     }
 }
 
+void tst_QFileSystemModel::sortNewFiles_data()
+{
+    QTest::addColumn<Qt::SortOrder>("order");
+    QTest::newRow("ascending") << Qt::AscendingOrder;
+    QTest::newRow("descending") << Qt::DescendingOrder;
+}
+
+void tst_QFileSystemModel::sortNewFiles()
+{
+    QFETCH(Qt::SortOrder, order);
+    const QString tmp = flatDirTestPath;
+    QScopedPointer<QFileSystemModel> model(new QFileSystemModel);
+    QAbstractItemModelTester tester(model.get());
+    tester.setUseFetchMore(false);
+    QModelIndex root = prepareTestModelRoot(model.data(), tmp);
+    QVERIFY(root.isValid());
+    model->sort(0, order);
+
+    auto entries = [&] {
+        QStringList result;
+        for (int i = 0; i < model->rowCount(root); ++i)
+            result.append(model->index(i, 0, root).data().toString());
+        return result;
+    };
+    auto sorted = [order](QStringList list) {
+        list.sort();
+        if (order == Qt::DescendingOrder)
+            std::reverse(list.begin(), list.end());
+        return list;
+    };
+
+    // Files arriving later are merged with the sorted ones
+    QStringList expected = { "b", "d", "f", "h", "j" };
+    QTRY_COMPARE(entries(), sorted(expected));
+    const QStringList newFiles = { "a", "e", "k" };
+    QVERIFY(createFiles(model.data(), tmp, newFiles, 5));
+    expected += newFiles;
+    QTRY_COMPARE(entries(), sorted(expected));
+
+    QVERIFY(QFile::remove(tmp + "/d"));
+    QVERIFY(createFiles(model.data(), tmp, { "c", "i" }, 7));
+    expected.removeOne("d");
+    expected += { "c", "i" };
+    QTRY_COMPARE(entries(), sorted(expected));
+}
+
 void tst_QFileSystemModel::mkdir()
 {
     QString tmp = flatDirTestPath;
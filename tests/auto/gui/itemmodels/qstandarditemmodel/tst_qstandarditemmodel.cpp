@@ -120,6 +120,9 @@ private slots:
     void setItemPersistentIndex();
     void signalsOnTakeItem();
     void createPersistentOnLayoutAboutToBeChanged();
+    void compactStorage();
+    void compactStorageStructure();
+    void compactStorageSort();
 private:
     QStandardItemModel *m_model = nullptr;
     QPersistentModelIndex persistent;
@@ -1824,5 +1827,156 @@ void tst_QStandardItemModel::createPersistentOnLayoutAboutToBeChanged() // QTBUG
     QCOMPARE(layoutChangedSpy.size(), 1);
 }
 
+void tst_QStandardItemModel::compactStorage()
+{
+    QStandardItemModel model(3, 2);
+    QAbstractItemModelTester mTester(&model, nullptr);
+    QVERIFY(!model.isCompactStorageEnabled());
+    model.setCompactStorageEnabled(true);
+    QVERIFY(model.isCompactStorageEnabled());
+
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy itemChangedSpy(&model, &QStandardItemModel::itemChanged);
+    const QModelIndex index = model.index(1, 1);
+    QVERIFY(model.setData(index, u"text"_s));
+    QVERIFY(model.setData(index, 42, Qt::UserRole));
+    QCOMPARE(dataChangedSpy.size(), 2);
+    // no item was created for the values
+    QCOMPARE(itemChangedSpy.size(), 0);
+    QCOMPARE(dataChangedSpy.at(0).at(2).value<QList<int>>(),
+             QList<int>({ Qt::DisplayRole, Qt::EditRole }));
+    QCOMPARE(dataChangedSpy.at(1).at(2).value<QList<int>>(), QList<int>({ Qt::UserRole }));
+
+    // setting the same value again changes nothing
+    QVERIFY(model.setData(index, u"text"_s, Qt::EditRole));
+    QCOMPARE(dataChangedSpy.size(), 2);
+
+    QCOMPARE(index.data(), u"text"_s);
+    QCOMPARE(index.data(Qt::EditRole), u"text"_s);
+    QCOMPARE(index.data(Qt::UserRole), 42);
+    QCOMPARE(model.itemData(index),
+             (QMap<int, QVariant>{ { Qt::DisplayRole, u"text"_s }, { Qt::UserRole, 42 } }));
+    QCOMPARE(model.index(0, 1).data(), QVariant());
+    QCOMPARE(model.flags(index), model.flags(model.index(0, 0)));
+
+    QVERIFY(model.setItemData(index, { { Qt::UserRole, QVariant() },
+                                       { Qt::ToolTipRole, u"tip"_s } }));
+    QCOMPARE(index.data(Qt::UserRole), QVariant());
+    QCOMPARE(index.data(Qt::ToolTipRole), u"tip"_s);
+    QCOMPARE(dataChangedSpy.size(), 3);
+
+    // asking for the item creates it, with the values of the cell
+    QStandardItem *item = model.item(1, 1);
+    QVERIFY(item);
+    QCOMPARE(item->text(), u"text"_s);
+    QCOMPARE(item->toolTip(), u"tip"_s);
+    QCOMPARE(item->index(), index);
+    QCOMPARE(model.itemFromIndex(index), item);
+    QCOMPARE(model.item(0, 0), nullptr);
+    item->setText(u"changed"_s);
+    QCOMPARE(index.data(), u"changed"_s);
+
+    // an item set in the place of a cell replaces its values
+    QVERIFY(model.setData(model.index(2, 0), u"replaced"_s));
+    model.setItem(2, 0, new QStandardItem(u"item"_s));
+    QCOMPARE(model.index(2, 0).data(), u"item"_s);
+    QCOMPARE(model.index(2, 0).data(Qt::ToolTipRole), QVariant());
+
+    QVERIFY(model.setData(model.index(0, 0), u"clear"_s));
+    QVERIFY(model.clearItemData(model.index(0, 0)));
+    QCOMPARE(model.index(0, 0).data(), QVariant());
+    QCOMPARE(model.item(0, 0), nullptr);
+
+    // disabling compact storage creates the remaining items
+    QVERIFY(model.setData(model.index(0, 1), u"last"_s));
+    model.setCompactStorageEnabled(false);
+    QVERIFY(model.item(0, 1));
+    QCOMPARE(model.item(0, 1)->text(), u"last"_s);
+    QCOMPARE(model.item(1, 0), nullptr);
+}
+
+void tst_QStandardItemModel::compactStorageStructure()
+{
+    QStandardItemModel model;
+    QAbstractItemModelTester mTester(&model, nullptr);
+    model.setCompactStorageEnabled(true);
+    model.setColumnCount(2);
+    model.setRowCount(4);
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 2; ++column)
+            model.setData(model.index(row, column), row * 10 + column);
+    }
+
+    model.insertRows(1, 2);
+    QCOMPARE(model.rowCount(), 6);
+    QCOMPARE(model.index(0, 1).data(), 1);
+    QCOMPARE(model.index(1, 1).data(), QVariant());
+    QCOMPARE(model.index(3, 0).data(), 10);
+
+    model.removeRows(3, 2);
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.index(3, 1).data(), 31);
+
+    model.insertColumns(1, 1);
+    QCOMPARE(model.index(3, 0).data(), 30);
+    QCOMPARE(model.index(3, 1).data(), QVariant());
+    QCOMPARE(model.index(3, 2).data(), 31);
+    model.removeColumns(0, 1);
+    QCOMPARE(model.index(3, 1).data(), 31);
+
+    const QList<QStandardItem *> taken = model.takeRow(0);
+    QCOMPARE(taken.size(), 2);
+    QCOMPARE(taken.at(0), nullptr);
+    QVERIFY(taken.at(1));
+    QCOMPARE(taken.at(1)->data(Qt::DisplayRole), 1);
+    qDeleteAll(taken);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.index(2, 1).data(), 31);
+
+    // the cells in compact storage have no children
+    QVERIFY(!model.hasChildren(model.index(2, 1)));
+    QVERIFY(model.insertRows(0, 1, model.index(2, 1)));
+    QVERIFY(model.item(2, 1));
+    QCOMPARE(model.item(2, 1)->rowCount(), 1);
+    QCOMPARE(model.index(2, 1).data(), 31);
+
+    model.clear();
+    QVERIFY(model.isCompactStorageEnabled());
+    model.setRowCount(1);
+    model.setColumnCount(1);
+    QCOMPARE(model.index(0, 0).data(), QVariant());
+}
+
+void tst_QStandardItemModel::compactStorageSort()
+{
+    QStandardItemModel model(5, 2);
+    QAbstractItemModelTester mTester(&model, nullptr);
+    model.setCompactStorageEnabled(true);
+    const int keys[] = { 3, 1, 4, 0, 2 };
+    for (int row = 0; row < 5; ++row) {
+        model.setData(model.index(row, 1), keys[row] * 100);
+        if (row == 1)
+            continue;
+        if (row == 2)
+            model.setItem(row, 0, new QStandardItem(QString::number(keys[row])));
+        else
+            model.setData(model.index(row, 0), QString::number(keys[row]));
+    }
+
+    QPersistentModelIndex persistent(model.index(2, 1));
+    model.sort(0);
+    // the row without a value in the sort column goes last
+    const int expected[] = { 0, 2, 3, 4, 1 };
+    for (int row = 0; row < 5; ++row)
+        QCOMPARE(model.index(row, 1).data(), expected[row] * 100);
+    QCOMPARE(model.item(3, 0)->text(), u"4"_s);
+    QCOMPARE(persistent.row(), 3);
+
+    model.sort(1, Qt::DescendingOrder);
+    for (int row = 0; row < 5; ++row)
+        QCOMPARE(model.index(row, 1).data(), (4 - row) * 100);
+    QCOMPARE(persistent.row(), 0);
+}
+
 QTEST_MAIN(tst_QStandardItemModel)
 #include "tst_qstandarditemmodel.moc"
@@ -38,6 +38,8 @@ private slots:
     void imageConversion64();
     void imageConversion64PM_data();
     void imageConversion64PM();
+    void imageConversionLarge_data();
+    void imageConversionLarge();
     void imageConversionOverLargerGamut_data();
     void imageConversionOverLargerGamut();
     void imageConversionOverLargerGamut2_data();
@@ -411,6 +413,44 @@ void tst_QColorSpace::imageConversion64PM()
     }
 }
 
+void tst_QColorSpace::imageConversionLarge_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+
+    QTest::newRow("RGB32") << QImage::Format_RGB32;
+    QTest::newRow("ARGB32") << QImage::Format_ARGB32;
+}
+
+void tst_QColorSpace::imageConversionLarge()
+{
+    QFETCH(QImage::Format, format);
+
+    // Large enough to be split over several threads, with a width that is
+    // not a multiple of the SIMD block size.
+    QImage testImage(517, 300, format);
+    for (int y = 0; y < testImage.height(); ++y) {
+        for (int x = 0; x < testImage.width(); ++x)
+            testImage.setPixel(x, y, qRgba(x & 0xff, y & 0xff, (x ^ y) & 0xff, (x + y) & 0xff));
+    }
+    testImage.setColorSpace(QColorSpace::SRgb);
+
+    const QColorTransform transform =
+            QColorSpace(QColorSpace::SRgb).transformationToColorSpace(QColorSpace::ProPhotoRgb);
+    const QImage result = testImage.convertedToColorSpace(QColorSpace::ProPhotoRgb);
+    QCOMPARE(result.format(), format);
+
+    for (int y = 0; y < testImage.height(); ++y) {
+        for (int x = 0; x < testImage.width(); ++x) {
+            const QRgb expected = transform.map(testImage.pixel(x, y));
+            const QRgb actual = result.pixel(x, y);
+            QCOMPARE(qAlpha(actual), qAlpha(expected));
+            QVERIFY(qAbs(qRed(actual) - qRed(expected)) <= 1);
+            QVERIFY(qAbs(qGreen(actual) - qGreen(expected)) <= 1);
+            QVERIFY(qAbs(qBlue(actual) - qBlue(expected)) <= 1);
+        }
+    }
+}
+
 void tst_QColorSpace::imageConversionOverLargerGamut_data()
 {
     QTest::addColumn<QColorSpace::NamedColorSpace>("fromColorSpace");
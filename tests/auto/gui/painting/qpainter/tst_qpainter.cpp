@@ -101,6 +101,8 @@ private slots:
     void drawPath();
     void drawPath2();
     void drawPath3();
+    void strokeRepeatedPath_data();
+    void strokeRepeatedPath();
 
     void drawRoundedRect_data() { fillData(); }
     void drawRoundedRect();
@@ -1348,6 +1350,53 @@ void tst_QPainter::drawPath2()
     }
 }
 
+void tst_QPainter::strokeRepeatedPath_data()
+{
+    QTest::addColumn<QPen>("pen");
+
+    QTest::newRow("solid") << QPen(Qt::black, 5);
+    QTest::newRow("dashed") << QPen(Qt::black, 3, Qt::DashLine);
+    QTest::newRow("round") << QPen(Qt::black, 7, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+}
+
+// Stroking the same path again may reuse its outline; the result has to
+// be the same as stroking a fresh path, also after the pen or the
+// transform changed.
+void tst_QPainter::strokeRepeatedPath()
+{
+    QFETCH(QPen, pen);
+
+    const auto makePath = [] {
+        QPainterPath path;
+        path.moveTo(10, 10);
+        path.cubicTo(80, 0, 20, 90, 90, 90);
+        path.lineTo(50, 30);
+        path.addEllipse(20, 50, 30, 20);
+        return path;
+    };
+    const auto render = [](const QPainterPath &path, const QPen &pen, const QTransform &xf) {
+        QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter p(&image);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setTransform(xf);
+        p.strokePath(path, pen);
+        p.end();
+        return image;
+    };
+
+    const QPainterPath path = makePath();
+    QPen widePen = pen;
+    widePen.setWidthF(pen.widthF() * 2);
+    const QTransform scaled = QTransform::fromScale(0.5, 0.75);
+
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(render(path, pen, QTransform()), render(makePath(), pen, QTransform()));
+        QCOMPARE(render(path, widePen, QTransform()), render(makePath(), widePen, QTransform()));
+        QCOMPARE(render(path, pen, scaled), render(makePath(), pen, scaled));
+    }
+}
+
 void tst_QPainter::drawPath3()
 {
     QImage imgA(100, 100, QImage::Format_RGB32);
@@ -11,6 +11,7 @@
 #include <qdebug.h>
 #include <qpainter.h>
 #include <qrandom.h>
+#include <qmath.h>
 
 #include <math.h>
 
@@ -61,6 +62,9 @@ private slots:
 
     void qtbug3778();
     void qtbug60024();
+
+    void manyEdges_data();
+    void manyEdges();
 };
 
 Q_DECLARE_METATYPE(QPainterPath)
@@ -1528,6 +1532,72 @@ void tst_QPathClipper::qtbug60024()
     QVERIFY(path1.intersected(path2).isEmpty());
 }
 
+void tst_QPathClipper::manyEdges_data()
+{
+    QTest::addColumn<QPathClipper::Operation>("op");
+
+    QTest::newRow("and") << QPathClipper::BoolAnd;
+    QTest::newRow("or") << QPathClipper::BoolOr;
+    QTest::newRow("sub") << QPathClipper::BoolSub;
+}
+
+void tst_QPathClipper::manyEdges()
+{
+    QFETCH(QPathClipper::Operation, op);
+
+    // two overlapping circles made of enough edges for the clipper to index
+    // them, compared against the circles themselves away from their outlines
+    constexpr int Count = 1000;
+    constexpr qreal Radius = 100;
+    const QPointF centers[] = { QPointF(0, 0), QPointF(60, 30) };
+    QPainterPath circles[2];
+    for (int c = 0; c < 2; ++c) {
+        QPolygonF polygon;
+        for (int i = 0; i < Count; ++i) {
+            const qreal angle = 2 * M_PI * i / Count;
+            polygon << centers[c] + Radius * QPointF(qCos(angle), qSin(angle));
+        }
+        circles[c].addPolygon(polygon);
+        circles[c].closeSubpath();
+    }
+
+    const QPainterPath result = QPathClipper(circles[0], circles[1]).clip(op);
+    QVERIFY(!result.isEmpty());
+
+    for (qreal y = -120; y <= 150; y += 7) {
+        for (qreal x = -120; x <= 180; x += 7) {
+            const QPointF point(x, y);
+            bool in[2];
+            bool nearOutline = false;
+            for (int c = 0; c < 2; ++c) {
+                const QPointF d = point - centers[c];
+                const qreal distance = qSqrt(QPointF::dotProduct(d, d));
+                in[c] = distance < Radius;
+                nearOutline |= qAbs(distance - Radius) < 1;
+            }
+            if (nearOutline)
+                continue;
+
+            bool expected = false;
+            switch (op) {
+            case QPathClipper::BoolAnd:
+                expected = in[0] && in[1];
+                break;
+            case QPathClipper::BoolOr:
+                expected = in[0] || in[1];
+                break;
+            case QPathClipper::BoolSub:
+                expected = in[0] && !in[1];
+                break;
+            default:
+                break;
+            }
+            QVERIFY2(result.contains(point) == expected,
+                     qPrintable(QString::fromLatin1("at %1, %2").arg(x).arg(y)));
+        }
+    }
+}
+
 QTEST_MAIN(tst_QPathClipper)
 
 
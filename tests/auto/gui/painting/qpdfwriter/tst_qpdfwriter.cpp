@@ -5,8 +5,11 @@
 #include <QtGlobal>
 #include <QtAlgorithms>
 #include <QTemporaryFile>
+#include <QBuffer>
 
 #include <QtGui/QAbstractTextDocumentLayout>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QPageLayout>
 #include <QtGui/QPdfWriter>
 #include <QtGui/QTextCursor>
@@ -21,6 +24,7 @@ private slots:
     void testPageMetrics_data();
     void testPageMetrics();
     void qtbug59443();
+    void manyPagesAndImages();
 };
 
 void tst_QPdfWriter::basics()
@@ -257,6 +261,47 @@ void tst_QPdfWriter::qtbug59443()
 
 }
 
+void tst_QPdfWriter::manyPagesAndImages()
+{
+    // page contents and images may be compressed on other threads and
+    // written later; every object must still be where the xref table says
+    constexpr int PageCount = 40;
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QPdfWriter writer(&buffer);
+        QPainter painter(&writer);
+        for (int page = 0; page < PageCount; ++page) {
+            if (page)
+                QVERIFY(writer.newPage());
+            QImage image(64 + page, 64, QImage::Format_RGB32);
+            image.fill(QColor::fromHsv(page * 9, 255, 255));
+            painter.drawImage(QPointF(100, 100), image);
+            for (int line = 0; line < 50; ++line)
+                painter.drawText(100, 1000 + line * 100, QString::number(page * 1000 + line));
+        }
+    }
+    const QByteArray pdf = buffer.data();
+
+    const qsizetype xref = pdf.lastIndexOf("\nxref\n");
+    QVERIFY(xref > 0);
+    const QList<QByteArray> lines = pdf.mid(xref + 1).split('\n');
+    QVERIFY(lines.size() > 3);
+    const QList<QByteArray> subsection = lines.at(1).split(' ');
+    QCOMPARE(subsection.size(), 2);
+    const int objectCount = subsection.at(1).toInt();
+    QVERIFY(objectCount > 2 * PageCount);
+    for (int object = 1; object < objectCount; ++object) {
+        const QByteArray entry = lines.at(2 + object);
+        QVERIFY2(entry.endsWith(" n "), entry.constData());
+        const qsizetype offset = entry.left(10).toLongLong();
+        const QByteArray header = QByteArray::number(object) + " 0 obj\n";
+        QVERIFY2(pdf.mid(offset, header.size()) == header, header.constData());
+    }
+    QCOMPARE(pdf.count("/Type /Page\n"), PageCount);
+    QCOMPARE(pdf.count("/Subtype /Image\n"), PageCount);
+}
+
 QTEST_MAIN(tst_QPdfWriter)
 
 #include "tst_qpdfwriter.moc"
@@ -4,6 +4,7 @@
 
 #include <QTest>
 #include <qregion.h>
+#include <QRandomGenerator>
 
 #include <qbitmap.h>
 #include <qpainter.h>
@@ -40,6 +41,7 @@ private slots:
     void intersects_region();
     void intersects_rect_data();
     void intersects_rect();
+    void intersects_manyRects();
     void contains_point();
 
     void operator_plus_data();
@@ -467,6 +469,31 @@ void tst_QRegion::intersects_rect()
     QCOMPARE(region.intersects(rect), intersects);
 }
 
+static QRegion randomRegion(QRandomGenerator *generator, int count)
+{
+    QRegion region;
+    for (int i = 0; i < count; ++i) {
+        region += QRect(generator->bounded(1000), generator->bounded(1000),
+                        1 + generator->bounded(40), 1 + generator->bounded(40));
+    }
+    return region;
+}
+
+void tst_QRegion::intersects_manyRects()
+{
+    QRandomGenerator generator(42);
+    for (int round = 0; round < 50; ++round) {
+        const QRegion r1 = randomRegion(&generator, 100);
+        const QRegion r2 = randomRegion(&generator, 1 + round);
+        QCOMPARE(r1.intersects(r2), !r1.intersected(r2).isEmpty());
+        QCOMPARE(r2.intersects(r1), !r1.intersected(r2).isEmpty());
+
+        const QRect rect(generator.bounded(1000), generator.bounded(1000),
+                         1 + generator.bounded(100), 1 + generator.bounded(100));
+        QCOMPARE(r1.intersects(rect), !r1.intersected(rect).isEmpty());
+    }
+}
+
 void tst_QRegion::contains_point()
 {
     QCOMPARE(QRegion().contains(QPoint(1,1)),false);
@@ -34,6 +34,8 @@ private slots:
     void projectivePathMapping();
     void mapInt();
     void mapPathWithPoint();
+    void mapManyPoints_data();
+    void mapManyPoints();
 
 private:
     void mapping_data();
@@ -700,6 +702,48 @@ void tst_QTransform::mapPathWithPoint()
     QCOMPARE(p.currentPosition(), QPointF(20, 20));
 }
 
+void tst_QTransform::mapManyPoints_data()
+{
+    QTest::addColumn<QTransform>("transform");
+
+    QTest::newRow("translate") << QTransform::fromTranslate(10.5, -3);
+    QTest::newRow("scale") << QTransform::fromScale(2, -0.5).translate(7, 3);
+    QTest::newRow("rotate") << QTransform().rotate(30).translate(-4, 2.25);
+    QTest::newRow("shear") << QTransform().shear(0.5, -1.5).scale(3, 3);
+    QTest::newRow("project") << QTransform().rotate(20, Qt::YAxis).translate(5, 5);
+}
+
+void tst_QTransform::mapManyPoints()
+{
+    QFETCH(QTransform, transform);
+
+    // odd counts leave a remainder after the vectorized loops
+    QPolygonF polygon;
+    QPainterPath path;
+    path.moveTo(0, 0);
+    for (int i = 0; i < 101; ++i) {
+        const QPointF point(i * 1.25 - 50, (i % 7) * 3.5 - i);
+        polygon << point;
+        path.lineTo(point);
+    }
+    path.cubicTo(1, 2, 3, 4, 5, 6);
+
+    const QPolygonF mappedPolygon = transform.map(polygon);
+    QCOMPARE(mappedPolygon.size(), polygon.size());
+    for (int i = 0; i < polygon.size(); ++i)
+        QCOMPARE(mappedPolygon.at(i), transform.map(polygon.at(i)));
+
+    if (transform.type() < QTransform::TxProject) {
+        const QPainterPath mappedPath = transform.map(path);
+        QCOMPARE(mappedPath.elementCount(), path.elementCount());
+        for (int i = 0; i < path.elementCount(); ++i) {
+            const QPainterPath::Element e = mappedPath.elementAt(i);
+            QCOMPARE(e.type, path.elementAt(i).type);
+            QCOMPARE(QPointF(e), transform.map(QPointF(path.elementAt(i))));
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QTransform)
 
 
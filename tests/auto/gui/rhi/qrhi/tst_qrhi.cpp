@@ -4,7 +4,9 @@
 #include <QTest>
 #include <QThread>
 #include <QFile>
+#include <QDir>
 #include <QOffscreenSurface>
+#include <QStandardPaths>
 #include <QPainter>
 #include <qrgbafloat.h>
 #include <qrgba64.h>
@@ -123,6 +125,8 @@ private slots:
 
     void pipelineCache_data();
     void pipelineCache();
+    void persistentPipelineCache_data();
+    void persistentPipelineCache();
     void textureImportOpenGL();
     void renderbufferImportOpenGL();
     void threeDimTexture_data();
@@ -413,7 +417,10 @@ void tst_QRhi::create()
             QRhi::OneDimensionalTextureMipmaps,
             QRhi::HalfAttributes,
             QRhi::RenderToOneDimensionalTexture,
-            QRhi::ThreeDimensionalTextureMipmaps
+            QRhi::ThreeDimensionalTextureMipmaps,
+            QRhi::SecondaryCommandBuffers,
+            QRhi::DrawIndirect,
+            QRhi::DrawIndirectMulti
         };
         for (size_t i = 0; i <sizeof(features) / sizeof(QRhi::Feature); ++i)
             rhi->isFeatureSupported(features[i]);
@@ -4699,6 +4706,64 @@ void tst_QRhi::pipelineCache()
     }
 }
 
+void tst_QRhi::persistentPipelineCache_data()
+{
+    rhiTestData();
+}
+
+void tst_QRhi::persistentPipelineCache()
+{
+    QFETCH(QRhi::Implementation, impl);
+    QFETCH(QRhiInitParams *, initParams);
+
+    QStandardPaths::setTestModeEnabled(true);
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+    const auto cacheFiles = [&cacheDir] {
+        return cacheDir.entryList({ QStringLiteral("qtpipelinecache-*") }, QDir::Files);
+    };
+    for (const QString &fn : cacheFiles())
+        cacheDir.remove(fn);
+
+    QShader vs = loadShader(":/data/simple.vert.qsb");
+    QVERIFY(vs.isValid());
+    QShader fs = loadShader(":/data/simple.frag.qsb");
+    QVERIFY(fs.isValid());
+    QRhiVertexInputLayout inputLayout;
+    inputLayout.setBindings({ { 2 * sizeof(float) } });
+    inputLayout.setAttributes({ { 0, 0, QRhiVertexInputAttribute::Float2, 0 } });
+
+    bool hasData = false;
+    for (int run = 0; run < 2; ++run) {
+        QScopedPointer<QRhi> rhi(QRhi::create(impl, initParams, QRhi::EnablePersistentPipelineCache));
+        if (!rhi)
+            QSKIP("QRhi could not be created, skipping testing the persistent pipeline cache");
+
+        if (!rhi->isFeatureSupported(QRhi::PipelineCacheDataLoadSave))
+            QSKIP("PipelineCacheDataLoadSave is not supported with this backend, skipping test");
+
+        QScopedPointer<QRhiTexture> texture(rhi->newTexture(QRhiTexture::RGBA8, QSize(256, 256), 1, QRhiTexture::RenderTarget));
+        QVERIFY(texture->create());
+        QScopedPointer<QRhiTextureRenderTarget> rt(rhi->newTextureRenderTarget({ texture.data() }));
+        QScopedPointer<QRhiRenderPassDescriptor> rpDesc(rt->newCompatibleRenderPassDescriptor());
+        rt->setRenderPassDescriptor(rpDesc.data());
+        QVERIFY(rt->create());
+        QScopedPointer<QRhiShaderResourceBindings> srb(rhi->newShaderResourceBindings());
+        QVERIFY(srb->create());
+        QScopedPointer<QRhiGraphicsPipeline> pipeline(rhi->newGraphicsPipeline());
+        pipeline->setShaderStages({ { QRhiShaderStage::Vertex, vs }, { QRhiShaderStage::Fragment, fs } });
+        pipeline->setVertexInputLayout(inputLayout);
+        pipeline->setShaderResourceBindings(srb.data());
+        pipeline->setRenderPassDescriptor(rpDesc.data());
+        QVERIFY(pipeline->create());
+
+        if (run == 0)
+            hasData = !rhi->pipelineCacheData().isEmpty();
+    }
+
+    // Only written when the backend had something to save
+    QCOMPARE(cacheFiles().size(), hasData ? 1 : 0);
+}
+
 void tst_QRhi::textureImportOpenGL()
 {
 #ifdef TST_GL
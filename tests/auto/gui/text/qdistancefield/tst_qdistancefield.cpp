@@ -0,0 +1,117 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QtCore/qdir.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qrawfont.h>
+
+#include <QtGui/private/qdistancefield_p.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QDistanceField : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void fromGlyphs_data();
+    void fromGlyphs();
+    void diskCache();
+
+private:
+    static bool sameField(const QDistanceField &a, const QDistanceField &b);
+
+    QTemporaryDir cacheDir;
+    QRawFont font;
+};
+
+void tst_QDistanceField::initTestCase()
+{
+    QVERIFY(cacheDir.isValid());
+    // read once, the first time a distance field is made
+    qputenv("QT_DISTANCEFIELD_DISK_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+
+    font = QRawFont(QFINDTESTDATA("testfont.ttf"), 16);
+    QVERIFY(font.isValid());
+}
+
+bool tst_QDistanceField::sameField(const QDistanceField &a, const QDistanceField &b)
+{
+    if (a.glyph() != b.glyph() || a.width() != b.width() || a.height() != b.height())
+        return false;
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.constScanLine(y), b.constScanLine(y), a.width()) != 0)
+            return false;
+    }
+    return true;
+}
+
+void tst_QDistanceField::fromGlyphs_data()
+{
+    QTest::addColumn<bool>("doubleResolution");
+
+    QTest::newRow("single") << false;
+    QTest::newRow("double") << true;
+}
+
+void tst_QDistanceField::fromGlyphs()
+{
+    QFETCH(bool, doubleResolution);
+
+    const QList<quint32> glyphs = font.glyphIndexesForString(u"The quick brown fox"_s);
+    const QList<QDistanceField> fields = QDistanceField::fromGlyphs(font, glyphs, doubleResolution);
+    QCOMPARE(fields.size(), glyphs.size());
+
+    QRawFont renderFont = font;
+    renderFont.setPixelSize(QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution)
+                            * QT_DISTANCEFIELD_SCALE(doubleResolution));
+    for (qsizetype i = 0; i < glyphs.size(); ++i) {
+        const QDistanceField expected(renderFont.pathForGlyph(glyphs.at(i)), glyphs.at(i),
+                                      doubleResolution);
+        QVERIFY2(sameField(fields.at(i), expected), qPrintable(QString::number(i)));
+        QVERIFY(sameField(QDistanceField(font, glyphs.at(i), doubleResolution), expected));
+    }
+}
+
+void tst_QDistanceField::diskCache()
+{
+    const QList<quint32> glyphs = font.glyphIndexesForString(u"cached"_s);
+    const QList<QDistanceField> fields = QDistanceField::fromGlyphs(font, glyphs);
+    QVERIFY(!QDir(cacheDir.path()).isEmpty());
+
+    // overwrite the cached fields, and check that they are used
+    const QStringList files = QDir(cacheDir.path()).entryList(QDir::Files);
+    for (const QString &name : files) {
+        QFile file(cacheDir.filePath(name));
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QByteArray contents = file.readAll();
+        // keep the header
+        QVERIFY(contents.size() > 16);
+        memset(contents.data() + 16, 0x42, contents.size() - 16);
+        QVERIFY(file.seek(0));
+        QCOMPARE(file.write(contents), contents.size());
+    }
+
+    const QList<QDistanceField> cached = QDistanceField::fromGlyphs(font, glyphs);
+    QCOMPARE(cached.size(), fields.size());
+    for (qsizetype i = 0; i < glyphs.size(); ++i) {
+        QCOMPARE(cached.at(i).glyph(), glyphs.at(i));
+        QCOMPARE(cached.at(i).width(), fields.at(i).width());
+        QCOMPARE(cached.at(i).height(), fields.at(i).height());
+        QCOMPARE(*cached.at(i).constBits(), uchar(0x42));
+    }
+
+    // an invalid file is ignored
+    for (const QString &name : files)
+        QVERIFY(QFile::resize(cacheDir.filePath(name), 3));
+    const QList<QDistanceField> remade = QDistanceField::fromGlyphs(font, glyphs);
+    for (qsizetype i = 0; i < glyphs.size(); ++i)
+        QVERIFY(sameField(remade.at(i), fields.at(i)));
+}
+
+QTEST_MAIN(tst_QDistanceField)
+
+#include "tst_qdistancefield.moc"
@@ -9,6 +9,7 @@
 #include <private/qfontengine_p.h>
 #include <qstringlist.h>
 #include <qlist.h>
+#include <qtextlayout.h>
 
 class tst_QFontMetrics : public QObject
 {
@@ -34,6 +35,8 @@ private slots:
     void zeroWidthMetrics();
     void verticalMetrics_data();
     void verticalMetrics();
+    void latin1Advance_data();
+    void latin1Advance();
 };
 
 void tst_QFontMetrics::same()
@@ -388,5 +391,38 @@ void tst_QFontMetrics::verticalMetrics()
     QVERIFY(fm.ascent() != 0 || fm.descent() != 0);
 }
 
+void tst_QFontMetrics::latin1Advance_data()
+{
+    QTest::addColumn<QFont>("font");
+    QTest::addColumn<QString>("text");
+
+    QFont noShaping;
+    noShaping.setStyleStrategy(QFont::PreferNoShaping);
+    QFont spaced;
+    spaced.setLetterSpacing(QFont::AbsoluteSpacing, 2);
+    const QString latin1 = QStringLiteral("Column header: r\u00e9sum\u00e9 \u00bd AVAT fi ffl");
+    QTest::newRow("default") << QFont() << latin1;
+    QTest::newRow("no-shaping") << noShaping << latin1;
+    QTest::newRow("letter-spacing") << spaced << latin1;
+    QTest::newRow("soft-hyphen") << QFont() << QStringLiteral("soft\u00adhyphen");
+    QTest::newRow("non-latin1") << QFont() << QStringLiteral("a\u2014b");
+}
+
+// The advance of Latin-1 text may be computed without laying the text
+// out, which must give the same result as a layout does.
+void tst_QFontMetrics::latin1Advance()
+{
+    QFETCH(QFont, font);
+    QFETCH(QString, text);
+
+    QTextLayout layout(text, font);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    layout.endLayout();
+
+    QCOMPARE(QFontMetricsF(font).horizontalAdvance(text), line.horizontalAdvance());
+    QCOMPARE(QFontMetrics(font).horizontalAdvance(text), qRound(line.horizontalAdvance()));
+}
+
 QTEST_MAIN(tst_QFontMetrics)
 #include "tst_qfontmetrics.moc"
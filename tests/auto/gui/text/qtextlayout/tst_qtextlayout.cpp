@@ -127,6 +127,7 @@ private slots:
     void min_maximumWidth_data();
     void min_maximumWidth();
     void negativeLineWidth();
+    void repeatedShaping();
 
 private:
     QFont testFont;
@@ -2745,5 +2746,36 @@ void tst_QTextLayout::negativeLineWidth()
     layout.endLayout();
 }
 
+void tst_QTextLayout::repeatedShaping()
+{
+    auto layOut = [](const QString &text, const QFont &font) {
+        QTextLayout layout(text, font);
+        layout.beginLayout();
+        layout.createLine();
+        layout.endLayout();
+        return layout.glyphRuns();
+    };
+
+    QFont font;
+    const QString text = QStringLiteral("Repeated cell text 123");
+    const QList<QGlyphRun> first = layOut(text, font);
+    QVERIFY(!first.isEmpty());
+    // The second layout is shaped from the cache of the font engine
+    QCOMPARE(layOut(text, font), first);
+
+    // Settings that change the shaping result must not share cached results
+    QFont spaced = font;
+    spaced.setLetterSpacing(QFont::AbsoluteSpacing, 3);
+    const QList<QGlyphRun> spacedRuns = layOut(text, spaced);
+    QCOMPARE(spacedRuns.size(), first.size());
+    QVERIFY(spacedRuns.first().boundingRect().width() > first.first().boundingRect().width());
+
+    QFont upper = font;
+    upper.setCapitalization(QFont::AllUppercase);
+    QCOMPARE(layOut(text, upper).first().glyphIndexes(),
+             layOut(text.toUpper(), font).first().glyphIndexes());
+    QVERIFY(layOut(text, upper).first().glyphIndexes() != first.first().glyphIndexes());
+}
+
 QTEST_MAIN(tst_QTextLayout)
 #include "tst_qtextlayout.moc"
@@ -39,6 +39,7 @@ private slots:
     void removal2();
     void removal3();
     void removal4();
+    void removalGarbageCollection();
 
     void undoRedo1();
     void undoRedo2();
@@ -268,6 +269,28 @@ void tst_QTextPieceTable::removal4()
     QCOMPARE(table->plainText(), compare);
 }
 
+void tst_QTextPieceTable::removalGarbageCollection()
+{
+    doc->setUndoRedoEnabled(false);
+    const QString chunk(1000, u'x');
+    const int chunkCount = 200;
+    for (int i = 0; i < chunkCount; ++i)
+        table->insert(table->length() - 1, chunk, charFormatIndex);
+
+    // Keep the document at the same length while replacing all of its text
+    // several times, as when trimming a log
+    for (int i = 0; i < 5 * chunkCount; ++i) {
+        table->insert(table->length() - 1, QString(1000, QChar(u'a' + i % 26)), charFormatIndex);
+        table->remove(0, chunk.size());
+    }
+
+    const QString text = table->plainText();
+    QCOMPARE(text.size(), chunkCount * chunk.size() + 1);
+    QCOMPARE(text.at(0), QChar(u'a' + (4 * chunkCount) % 26));
+    // The removed text has been collected along the way
+    QVERIFY(table->buffer().size() < 3 * text.size());
+}
+
 void tst_QTextPieceTable::undoRedo1()
 {
     table->insert(0, "01234567", charFormatIndex);
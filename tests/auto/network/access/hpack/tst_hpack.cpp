@@ -10,6 +10,7 @@
 
 #include <QtCore/qbytearray.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 #include <string>
@@ -29,6 +30,7 @@ private Q_SLOTS:
     void bitstreamWrite();
     void bitstreamReadWrite();
     void bitstreamCompression();
+    void huffmanAllSymbols();
     void bitstreamErrors();
 
     void lookupTableConstructor();
@@ -234,6 +236,39 @@ void tst_Hpack::bitstreamReadWrite()
     }
 }
 
+void tst_Hpack::huffmanAllSymbols()
+{
+    // Huffman codes are 5 to 30 bits long, encode strings
+    // that use every octet and read them back.
+    QByteArray allOctets;
+    for (int i = 0; i < 256; ++i)
+        allOctets.append(char(i));
+    QByteArray reversed = allOctets;
+    std::reverse(reversed.begin(), reversed.end());
+
+    const QByteArray strings[] = {
+        allOctets,
+        reversed,
+        allOctets.repeated(3) + "a",
+        QByteArray("0"),
+        QByteArray(1000, '\xff'),
+    };
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    for (const QByteArray &string : strings)
+        out.write(string, true);
+
+    BitIStream in(out.begin(), out.end());
+    for (const QByteArray &string : strings) {
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+        QVERIFY(in.error() == StreamError::NoError);
+        QCOMPARE(decoded, string);
+    }
+    QVERIFY(!in.hasMoreBits());
+}
+
 void tst_Hpack::bitstreamCompression()
 {
     // Similar to bitstreamReadWrite but
@@ -81,6 +81,7 @@ private slots:
     void earlyResponse();
     void connectToHost_data();
     void connectToHost();
+    void sharedConnection();
     void maxFrameSize();
     void http2DATAFrames();
 
@@ -721,6 +722,41 @@ void tst_Http2::connectToHost()
     QVERIFY(reply->isFinished());
 }
 
+void tst_Http2::sharedConnection()
+{
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 2;
+
+    ServerPtr targetServer(newServer(defaultServerSettings, H2Type::h2cDirect));
+    QMetaObject::invokeMethod(targetServer.data(), "startServer", Qt::QueuedConnection);
+    runEventLoop();
+
+    QVERIFY(serverPort != 0);
+
+    auto url = requestUrl(H2Type::h2cDirect);
+    url.setPath("/index.html");
+
+    // The server stops listening after accepting its first connection, so
+    // the request of the second manager can only succeed on the same one.
+    QNetworkAccessManager otherManager;
+    for (QNetworkAccessManager *qnam : { manager.get(), &otherManager }) {
+        QNetworkRequest request(url);
+        request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+        request.setAttribute(QNetworkRequest::Http2SharedConnectionAttribute, true);
+        QNetworkReply *reply = qnam->get(request);
+        connect(reply, &QNetworkReply::finished, this, &tst_Http2::replyFinished);
+    }
+
+    runEventLoop();
+    STOP_ON_FAILURE
+
+    QCOMPARE(nRequests, 0);
+    QVERIFY(prefaceOK);
+    QVERIFY(serverGotSettingsACK);
+}
+
 void tst_Http2::maxFrameSize()
 {
 #if !QT_CONFIG(ssl)
@@ -28,6 +28,9 @@ private Q_SLOTS:
     void partialDecompress_data();
     void partialDecompress();
 
+    void reuseAfterPartialRead_data();
+    void reuseAfterPartialRead();
+
     void countAhead_data();
     void countAhead();
     void countAheadByteDataBuffer_data();
@@ -178,6 +181,40 @@ void tst_QDecompressHelper::partialDecompress()
     QCOMPARE(actual, expected);
 }
 
+void tst_QDecompressHelper::reuseAfterPartialRead_data()
+{
+    sharedDecompress_data();
+}
+
+// Test that a decoder given up on halfway through a reply does not leave
+// any state behind for the reply that gets it next
+void tst_QDecompressHelper::reuseAfterPartialRead()
+{
+    QFETCH(QByteArray, encoding);
+    QFETCH(QByteArray, data);
+    QFETCH(QByteArray, expected);
+
+    {
+        QDecompressHelper helper;
+        QVERIFY(helper.setEncoding(encoding));
+        helper.feed(data.left(data.size() / 2));
+        char c;
+        helper.read(&c, 1);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        QDecompressHelper helper;
+        QVERIFY(helper.setEncoding(encoding));
+        helper.feed(data);
+
+        QByteArray actual(expected.size(), Qt::Uninitialized);
+        qsizetype read = helper.read(actual.data(), actual.size());
+
+        QCOMPARE(read, expected.size());
+        QCOMPARE(actual, expected);
+    }
+}
+
 void tst_QDecompressHelper::countAhead_data()
 {
     sharedDecompress_data();
@@ -21,6 +21,9 @@ private Q_SLOTS:
 
     void parseEndOfHeader_data();
     void parseEndOfHeader();
+
+    void getChunkSize_data();
+    void getChunkSize();
 };
 
 void tst_QHttpNetworkReply::parseHeader_data()
@@ -216,6 +219,12 @@ void tst_QHttpNetworkReply::parseEndOfHeader_data()
                                         "Content-Length:\r\n 1024\r\n"
                                         "Content-Encoding: gzip\n\nHTTPBODY")
                           << qint64(88);
+
+    // longer than what readHeader() looks at at once
+    QTest::newRow("long") << ("X-Long: " + QByteArray(10000, 'a') + "\r\n\r\nHTTPBODY")
+                          << qint64(10012);
+
+    QTest::newRow("no-headers") << QByteArray("\r\nHTTPBODY") << qint64(2);
 }
 
 void tst_QHttpNetworkReply::parseEndOfHeader()
@@ -230,6 +239,37 @@ void tst_QHttpNetworkReply::parseEndOfHeader()
     QHttpNetworkReplyPrivate *replyPrivate = reply.replyPrivate();
     qint64 headerBytes = replyPrivate->readHeader(&socket);
     QCOMPARE(headerBytes, lengths);
+    QCOMPARE(socket.readAll(), QByteArray("HTTPBODY"));
+}
+
+void tst_QHttpNetworkReply::getChunkSize_data()
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<qint64>("chunkSize");
+    QTest::addColumn<qint64>("bytes");
+
+    QTest::newRow("simple") << QByteArray("1a\r\nDATA") << qint64(0x1a) << qint64(4);
+    QTest::newRow("extension") << QByteArray("ff;name=value\r\nDATA") << qint64(0xff) << qint64(15);
+    QTest::newRow("blank-line") << QByteArray("\r\n10\r\nDATA") << qint64(0x10) << qint64(6);
+    QTest::newRow("last") << QByteArray("0\r\n\r\n") << qint64(0) << qint64(3);
+    QTest::newRow("incomplete") << QByteArray("10\r") << qint64(-1) << qint64(3);
+}
+
+void tst_QHttpNetworkReply::getChunkSize()
+{
+    QFETCH(QByteArray, input);
+    QFETCH(qint64, chunkSize);
+    QFETCH(qint64, bytes);
+
+    TestHeaderSocket socket(input);
+    TestHeaderReply reply;
+    QHttpNetworkReplyPrivate *replyPrivate = reply.replyPrivate();
+
+    qint64 size = 0;
+    QCOMPARE(replyPrivate->getChunkSize(&socket, &size), bytes);
+    QCOMPARE(size, chunkSize);
+    // only the size line is consumed
+    QCOMPARE(socket.readAll(), input.sliced(bytes));
 }
 
 QTEST_MAIN(tst_QHttpNetworkReply)
@@ -26,6 +26,7 @@ private slots:
     void setCookiesFromUrl();
     void cookiesForUrl_data();
     void cookiesForUrl();
+    void manyDomains();
 #if defined(QT_BUILD_INTERNAL) && QT_CONFIG(topleveldomain)
     void effectiveTLDs_data();
     void effectiveTLDs();
@@ -399,6 +400,49 @@ void tst_QNetworkCookieJar::cookiesForUrl()
     QCOMPARE(result, expectedResult);
 }
 
+void tst_QNetworkCookieJar::manyDomains()
+{
+    MyCookieJar jar;
+    QList<QNetworkCookie> expectedAll;
+    for (int i = 0; i < 100; ++i) {
+        QNetworkCookie cookie("a", "b");
+        cookie.setDomain(QString::fromLatin1(".host%1.example.com").arg(i));
+        cookie.setPath("/");
+        QVERIFY(jar.insertCookie(cookie));
+        expectedAll += cookie;
+    }
+    QNetworkCookie parent("parent", "c");
+    parent.setDomain(".example.com");
+    parent.setPath("/");
+    QVERIFY(jar.insertCookie(parent));
+    QNetworkCookie exact("exact", "d");
+    exact.setDomain("www.host42.example.com");
+    exact.setPath("/");
+    QVERIFY(jar.insertCookie(exact));
+    expectedAll << parent << exact;
+    QCOMPARE(jar.allCookies(), expectedAll);
+
+    const QList<QNetworkCookie> expected = { expectedAll.at(42), parent, exact };
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://www.host42.example.com/")), expected);
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://host42.example.com/")),
+             QList<QNetworkCookie>({ expectedAll.at(42), parent }));
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://www.example.org/")), QList<QNetworkCookie>());
+
+    // Replacing a cookie moves it to the end
+    QNetworkCookie replaced = expectedAll.at(42);
+    replaced.setValue("e");
+    QVERIFY(jar.insertCookie(replaced));
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://www.host42.example.com/")),
+             QList<QNetworkCookie>({ parent, exact, replaced }));
+
+    QVERIFY(jar.deleteCookie(parent));
+    QVERIFY(!jar.deleteCookie(parent));
+    QCOMPARE(jar.cookiesForUrl(QUrl("http://www.host42.example.com/")),
+             QList<QNetworkCookie>({ exact, replaced }));
+    QCOMPARE(jar.allCookies().size(), 101);
+    QCOMPARE(jar.allCookies().last(), replaced);
+}
+
 // This test requires private API.
 #if defined(QT_BUILD_INTERNAL) && QT_CONFIG(topleveldomain)
 void tst_QNetworkCookieJar::effectiveTLDs_data()
@@ -296,6 +296,8 @@ private Q_SLOTS:
     void ioGetFromHttpStatus100();
     void ioGetFromHttpNoHeaders_data();
     void ioGetFromHttpNoHeaders();
+    void ioGetFromHttpToFile();
+    void ioGetFromHttpToFileInSegments();
     void ioGetFromHttpWithCache_data();
     void ioGetFromHttpWithCache();
 
@@ -328,6 +330,7 @@ private Q_SLOTS:
     void ioPostToHttpFromMiddleOfFileFiveBytes();
     void ioPostToHttpFromMiddleOfQBufferFiveBytes();
     void ioPostToHttpNoBufferFlag();
+    void ioPostToHttpStreamedNoBufferFlag();
     void ioPostToHttpUploadProgress();
     void emitAllUploadProgressSignals();
     void ioPostToHttpEmptyUploadProgress();
@@ -378,6 +381,7 @@ private Q_SLOTS:
 
     void httpReUsingConnectionSequential_data();
     void httpReUsingConnectionSequential();
+    void httpConnectionCountNotShared();
     void httpReUsingConnectionFromFinishedSlot_data();
     void httpReUsingConnectionFromFinishedSlot();
 
@@ -413,6 +417,7 @@ private Q_SLOTS:
     void getFromHttpIntoBufferCanReadLine();
 
     void ioGetFromHttpWithoutContentLength();
+    void ioGetFromHttpReadChunk();
 
     void ioGetFromHttpBrokenChunkedEncoding();
     void qtbug12908compressedHttpReply();
@@ -4049,6 +4054,191 @@ void tst_QNetworkReply::ioGetFromHttpNoHeaders()
     QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
 }
 
+void tst_QNetworkReply::ioGetFromHttpToFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString fileName = tempDir.filePath(u"download"_s);
+
+    QByteArray body(300 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < body.size(); ++i)
+        body[i] = char('a' + i % 26);
+    {
+        MiniHttpServer server("HTTP/1.0 200 OK\r\nContent-Length: "
+                              + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+        server.doClose = true;
+
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute, fileName);
+        QNetworkReplyPtr reply(manager.get(request));
+        QSignalSpy readyReadSpy(reply.data(), &QNetworkReply::readyRead);
+        QSignalSpy progressSpy(reply.data(), &QNetworkReply::downloadProgress);
+
+        QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt(), 200);
+        // the data went to the file only
+        QCOMPARE(readyReadSpy.size(), 0);
+        QCOMPARE(reply->bytesAvailable(), 0);
+        QVERIFY(!progressSpy.isEmpty());
+        QCOMPARE(progressSpy.last().at(0).toLongLong(), body.size());
+
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), body);
+    }
+
+    // an error reply is delivered as usual, and leaves the file alone
+    QVERIFY(QFile::remove(fileName));
+    {
+        MiniHttpServer server("HTTP/1.0 404 Not Found\r\nContent-Length: 9\r\n\r\nnot found");
+        server.doClose = true;
+
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute, fileName);
+        QNetworkReplyPtr reply(manager.get(request));
+
+        QCOMPARE(waitForFinish(reply), int(Failure));
+        QCOMPARE(reply->error(), QNetworkReply::ContentNotFoundError);
+        QCOMPARE(reply->readAll(), QByteArray("not found"));
+        QVERIFY(!QFile::exists(fileName));
+    }
+
+    // a file that can't be opened fails the reply
+    {
+        MiniHttpServer server("HTTP/1.0 200 OK\r\nContent-Length: 4\r\n\r\nbody");
+        server.doClose = true;
+
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute,
+                             tempDir.filePath(u"missing/download"_s));
+        QNetworkReplyPtr reply(manager.get(request));
+
+        QCOMPARE(waitForFinish(reply), int(Failure));
+        QCOMPARE(reply->error(), QNetworkReply::UnknownContentError);
+    }
+}
+
+// Serves body, and the byte ranges of it that are asked for, closing the
+// connection after every reply
+class RangeHttpServer : public QTcpServer
+{
+public:
+    QByteArray body;
+    bool honorRanges = true;
+    QList<QByteArray> ranges; // the Range headers received
+
+    RangeHttpServer(const QByteArray &body) : body(body) { listen(QHostAddress::AnyIPv4); }
+
+private:
+    QHash<QTcpSocket *, QByteArray> requests;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(socketDescriptor);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+            QByteArray &request = requests[socket];
+            request += socket->readAll();
+            if (!request.contains("\r\n\r\n"))
+                return;
+            QByteArray range;
+            for (const QByteArray &line : request.split('\n')) {
+                if (line.toLower().startsWith("range:"))
+                    range = line.mid(6).trimmed();
+            }
+            request.clear();
+
+            QByteArray response;
+            qsizetype first = 0;
+            qsizetype last = body.size() - 1;
+            if (!range.isEmpty()) {
+                ranges.append(range);
+                const QList<QByteArray> bounds = range.mid(6).split('-');
+                if (honorRanges) {
+                    first = bounds.at(0).toLongLong();
+                    last = bounds.at(1).toLongLong();
+                }
+            }
+            if (!range.isEmpty() && honorRanges) {
+                response = "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes "
+                        + QByteArray::number(first) + '-' + QByteArray::number(last) + '/'
+                        + QByteArray::number(body.size()) + "\r\n";
+            } else {
+                response = "HTTP/1.1 200 OK\r\n";
+            }
+            response += "Accept-Ranges: bytes\r\nETag: \"v1\"\r\nConnection: close\r\n"
+                        "Content-Length: " + QByteArray::number(last - first + 1) + "\r\n\r\n";
+            socket->write(response + body.mid(first, last - first + 1));
+            socket->disconnectFromHost();
+        });
+    }
+};
+
+void tst_QNetworkReply::ioGetFromHttpToFileInSegments()
+{
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString fileName = tempDir.filePath(u"download"_s);
+
+    QByteArray body(3 * 1024 * 1024 + 1000, Qt::Uninitialized);
+    for (qsizetype i = 0; i < body.size(); ++i)
+        body[i] = char('a' + i % 23);
+    const qsizetype segmentSize = body.size() / 3;
+    {
+        RangeHttpServer server(body);
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute, fileName);
+        request.setAttribute(QNetworkRequest::DownloadSegmentsAttribute, 3);
+        QNetworkReplyPtr reply(manager.get(request));
+        QSignalSpy progressSpy(reply.data(), &QNetworkReply::downloadProgress);
+
+        QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(server.ranges.size(), 2);
+        QVERIFY(server.ranges.contains("bytes=" + QByteArray::number(segmentSize) + '-'
+                                       + QByteArray::number(2 * segmentSize - 1)));
+        QVERIFY(server.ranges.contains("bytes=" + QByteArray::number(2 * segmentSize) + '-'
+                                       + QByteArray::number(body.size() - 1)));
+        QVERIFY(!progressSpy.isEmpty());
+        QCOMPARE(progressSpy.last().at(0).toLongLong(), body.size());
+
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY(file.readAll() == body);
+    }
+
+    // small resources are not split
+    {
+        RangeHttpServer server(body.left(1024));
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute, fileName);
+        request.setAttribute(QNetworkRequest::DownloadSegmentsAttribute, 3);
+        QNetworkReplyPtr reply(manager.get(request));
+
+        QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+        QVERIFY(server.ranges.isEmpty());
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), body.left(1024));
+    }
+
+    // a server that answers range requests with the whole resource fails
+    // the download
+    {
+        RangeHttpServer server(body);
+        server.honorRanges = false;
+        QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+        request.setAttribute(QNetworkRequest::DownloadFileAttribute, fileName);
+        request.setAttribute(QNetworkRequest::DownloadSegmentsAttribute, 3);
+        QNetworkReplyPtr reply(manager.get(request));
+
+        QCOMPARE(waitForFinish(reply), int(Failure));
+        QCOMPARE(reply->error(), QNetworkReply::ProtocolFailure);
+    }
+}
+
 void tst_QNetworkReply::ioGetFromHttpWithCache_data()
 {
     qRegisterMetaType<MyMemoryCache::CachedContent>();
@@ -5089,6 +5279,59 @@ void tst_QNetworkReply::ioPostToHttpNoBufferFlag()
     QCOMPARE(reply->error(), QNetworkReply::ContentReSendError);
 }
 
+void tst_QNetworkReply::ioPostToHttpStreamedNoBufferFlag()
+{
+    // Replies once the last chunk of the request body has arrived
+    class ChunkedUploadServer : public MiniHttpServer
+    {
+    public:
+        ChunkedUploadServer(const QByteArray &data) : MiniHttpServer(data) {}
+        void reply() override
+        {
+            if (receivedData.endsWith("\r\n0\r\n\r\n"))
+                MiniHttpServer::reply();
+        }
+    };
+
+    QByteArray data = QByteArray("daaaaaaataaaaaaa");
+    // create a sequential QIODevice by feeding the data into a local TCP server
+    SocketPair socketpair;
+    QTRY_VERIFY(socketpair.create()); //QTRY_VERIFY as a workaround for QTBUG-24451
+    socketpair.endPoints[0]->write(data);
+
+    ChunkedUploadServer server("HTTP/1.0 200 OK\r\nContent-Length: 2\r\n\r\nOK");
+    QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+    request.setRawHeader("Content-Type", "application/octet-stream");
+    // disallow buffering, without giving a content length
+    request.setAttribute(QNetworkRequest::DoNotBufferUploadDataAttribute, true);
+    QNetworkReplyPtr reply(manager.post(request, socketpair.endPoints[1]));
+    socketpair.endPoints[0]->close();
+
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QCOMPARE(reply->readAll(), QByteArray("OK"));
+
+    const qsizetype endOfHeader = server.receivedData.indexOf("\r\n\r\n") + 4;
+    const QByteArray header = server.receivedData.left(endOfHeader);
+    QVERIFY(header.contains("Transfer-Encoding: chunked\r\n"));
+    QVERIFY(!header.contains("Content-Length"));
+
+    // the data may have been split into several chunks
+    QByteArray body;
+    qsizetype pos = endOfHeader;
+    while (true) {
+        const qsizetype endOfSize = server.receivedData.indexOf("\r\n", pos);
+        QVERIFY(endOfSize != -1);
+        bool ok = false;
+        const qsizetype chunkSize = server.receivedData.mid(pos, endOfSize - pos).toLongLong(&ok, 16);
+        QVERIFY(ok);
+        if (chunkSize == 0)
+            break;
+        body += server.receivedData.mid(endOfSize + 2, chunkSize);
+        pos = endOfSize + 2 + chunkSize + 2;
+    }
+    QCOMPARE(body, data);
+}
+
 #if QT_CONFIG(ssl)
 class SslServer : public QTcpServer
 {
@@ -6321,6 +6564,39 @@ void tst_QNetworkReply::httpReUsingConnectionSequential()
     reply2->deleteLater();
 }
 
+void tst_QNetworkReply::httpConnectionCountNotShared()
+{
+    QByteArray response("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+    MiniHttpServer server(response);
+    server.multiple = true;
+    server.doClose = false;
+
+    QUrl url;
+    url.setScheme("http");
+    url.setPort(server.serverPort());
+    url.setHost("127.0.0.1");
+
+    auto get = [&](const QNetworkRequest &request) {
+        QNetworkReplyPtr reply(manager.get(request));
+        return waitForFinish(reply) == Success && reply->error() == QNetworkReply::NoError;
+    };
+
+    QNetworkRequest request(url);
+    QVERIFY(get(request));
+    QVERIFY(get(request));
+    QCOMPARE(server.totalConnections, 1);
+
+    // a request asking for a different number of connections per host
+    // does not reuse the connection set up for the default
+    QHttp1Configuration http1;
+    http1.setNumberOfConnectionsPerHost(64);
+    request.setHttp1Configuration(http1);
+    QVERIFY(get(request));
+    QCOMPARE(server.totalConnections, 2);
+    QVERIFY(get(request));
+    QCOMPARE(server.totalConnections, 2);
+}
+
 class HttpReUsingConnectionFromFinishedSlot : public QObject
 {
     Q_OBJECT
@@ -7049,6 +7325,31 @@ void tst_QNetworkReply::ioGetFromHttpWithoutContentLength()
     QCOMPARE(reply->error(), QNetworkReply::NoError);
 }
 
+void tst_QNetworkReply::ioGetFromHttpReadChunk()
+{
+    QByteArray body;
+    for (int i = 0; i < 10000; ++i)
+        body += QByteArray::number(i) + ' ';
+    QByteArray dataToSend("HTTP/1.0 200 OK\r\nContent-Length: "
+                          + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+    MiniHttpServer server(dataToSend);
+    server.doClose = true;
+
+    QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+    QNetworkReplyPtr reply(manager.get(request));
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+
+    // a partially read chunk is returned too
+    QByteArray received = reply->read(3);
+    QCOMPARE(received.size(), 3);
+    for (QByteArray chunk = reply->readChunk(); !chunk.isEmpty(); chunk = reply->readChunk())
+        received += chunk;
+    QCOMPARE(received, body);
+    QCOMPARE(reply->bytesAvailable(), 0);
+    QVERIFY(reply->readChunk().isEmpty());
+}
+
 // Is handled somewhere else too, introduced this special test to have it more accessible
 void tst_QNetworkReply::ioGetFromHttpBrokenChunkedEncoding()
 {
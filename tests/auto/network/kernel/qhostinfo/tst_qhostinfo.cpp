@@ -79,6 +79,7 @@ private slots:
     void multipleDifferentLookups();
 
     void cache();
+    void negativeCache();
 
     void abortHostLookup();
 protected slots:
@@ -671,6 +672,35 @@ void tst_QHostInfo::cache()
     QCOMPARE(lookupsDoneCounter, 2);
 }
 
+void tst_QHostInfo::negativeCache()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    // reset slot counter
+    lookupsDoneCounter = 0;
+
+    bool valid = true;
+    int id = -1;
+    QHostInfo result = qt_qhostinfo_lookup("invalid" TEST_DOMAIN, this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QVERIFY(!valid);
+    if (lookupResults.error() != QHostInfo::HostNotFound)
+        QSKIP("The name could not be looked up, the network may be unavailable");
+
+    // lookup second time, the failure should come directly
+    valid = false;
+    result = qt_qhostinfo_lookup("invalid" TEST_DOMAIN, this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.error(), QHostInfo::HostNotFound);
+    QVERIFY(result.addresses().isEmpty());
+
+    // the slot should have been called once
+    QCOMPARE(lookupsDoneCounter, 1);
+}
+
 void tst_QHostInfo::resultsReady(const QHostInfo &hi)
 {
     QVERIFY(QThread::currentThread() == thread());
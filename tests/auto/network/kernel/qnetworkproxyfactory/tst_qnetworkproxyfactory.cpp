@@ -14,6 +14,7 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QList>
+#include <QScopeGuard>
 #include <QSysInfo>
 #include <QThread>
 
@@ -46,6 +47,7 @@ private slots:
     void systemProxyForQuery_local();
     void genericSystemProxy();
     void genericSystemProxy_data();
+    void systemProxyCache();
 
 private:
     QString formatProxyName(const QNetworkProxy & proxy) const;
@@ -261,6 +263,46 @@ void tst_QNetworkProxyFactory::genericSystemProxy_data()
 #endif
 }
 
+void tst_QNetworkProxyFactory::systemProxyCache()
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MACOS) || defined(Q_OS_ANDROID) || QT_CONFIG(libproxy)
+    QSKIP("Generic system proxy not available on this platform.");
+#else
+    const QNetworkProxyQuery query(QUrl("http://example.com/"));
+    auto firstProxyHost = [&query] {
+        return QNetworkProxyFactory::proxyForQuery(query).constFirst().hostName();
+    };
+    auto cleanup = qScopeGuard([] {
+        qunsetenv("http_proxy");
+        QNetworkProxyFactory::setSystemProxyCacheLifetime(0);
+        QNetworkProxyFactory::setUseSystemConfiguration(false);
+    });
+
+    QCOMPARE(QNetworkProxyFactory::systemProxyCacheLifetime(), 0);
+    QNetworkProxyFactory::setUseSystemConfiguration(true);
+    qputenv("http_proxy", "http://first.example.com:8080");
+    QCOMPARE(firstProxyHost(), u"first.example.com");
+    qputenv("http_proxy", "http://second.example.com:8080");
+    QCOMPARE(firstProxyHost(), u"second.example.com");
+
+    QNetworkProxyFactory::setSystemProxyCacheLifetime(60 * 1000);
+    QCOMPARE(QNetworkProxyFactory::systemProxyCacheLifetime(), 60 * 1000);
+    QCOMPARE(firstProxyHost(), u"second.example.com");
+    qputenv("http_proxy", "http://third.example.com:8080");
+    // the decision for the host is reused, but not for other hosts
+    QCOMPARE(firstProxyHost(), u"second.example.com");
+    QCOMPARE(QNetworkProxyFactory::proxyForQuery(QNetworkProxyQuery(QUrl("http://example.org/")))
+                     .constFirst().hostName(),
+             u"third.example.com");
+
+    // changing the lifetime clears the cache
+    QNetworkProxyFactory::setSystemProxyCacheLifetime(1);
+    QCOMPARE(firstProxyHost(), u"third.example.com");
+    qputenv("http_proxy", "http://fourth.example.com:8080");
+    QTRY_COMPARE(firstProxyHost(), u"fourth.example.com");
+#endif
+}
+
 class QSPFQThread : public QThread
 {
 protected:
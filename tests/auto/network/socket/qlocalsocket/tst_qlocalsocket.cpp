@@ -124,6 +124,9 @@ private slots:
 
     void serverBindingsAndProperties();
 
+    void fileDescriptorPassing();
+    void sequentialPackets();
+
 protected slots:
     void socketClosedSlot();
 };
@@ -1817,6 +1820,97 @@ void tst_QLocalSocket::serverBindingsAndProperties()
     QCOMPARE(sockOpts.value(), QLocalServer::OtherAccessOption);
 }
 
+void tst_QLocalSocket::fileDescriptorPassing()
+{
+#ifdef Q_OS_UNIX
+    CrashSafeLocalServer server;
+    QVERIFY2(server.listen("fileDescriptorPassing"), qUtf8Printable(server.errorString()));
+
+    QLocalSocket client;
+    client.connectToServer("fileDescriptorPassing");
+    QVERIFY(client.waitForConnected(3000));
+    QVERIFY(server.waitForNewConnection(3000));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+
+    int pipes[2];
+    QCOMPARE(::pipe(pipes), 0);
+
+    // the descriptor travels with "b"; the socket keeps its own copy
+    QCOMPARE(client.write("a"), qint64(1));
+    QVERIFY(client.writeFileDescriptors({ pipes[1] }));
+    QCOMPARE(client.write("b"), qint64(1));
+    ::close(pipes[1]);
+    while (client.bytesToWrite() > 0)
+        QVERIFY(client.waitForBytesWritten(3000));
+
+    while (serverSocket->bytesAvailable() < 2)
+        QVERIFY(serverSocket->waitForReadyRead(3000));
+    QCOMPARE(serverSocket->readAll(), "ab");
+
+    const QList<int> descriptors = serverSocket->readFileDescriptors();
+    QCOMPARE(descriptors.size(), 1);
+    QVERIFY(serverSocket->readFileDescriptors().isEmpty());
+
+    // the received descriptor refers to the same pipe
+    QCOMPARE(::write(descriptors.first(), "x", 1), ssize_t(1));
+    ::close(descriptors.first());
+    char c = 0;
+    QCOMPARE(::read(pipes[0], &c, 1), ssize_t(1));
+    QCOMPARE(c, 'x');
+    ::close(pipes[0]);
+#else
+    QLocalSocket socket;
+    QVERIFY(!socket.writeFileDescriptors({}));
+    QSKIP("File descriptors can only be passed on Unix");
+#endif
+}
+
+void tst_QLocalSocket::sequentialPackets()
+{
+#if defined(Q_OS_LINUX) || defined(Q_OS_FREEBSD)
+    CrashSafeLocalServer server;
+    server.setSocketOptions(QLocalServer::SequentialPacketOption);
+    QVERIFY2(server.listen("sequentialPackets"), qUtf8Printable(server.errorString()));
+
+    QLocalSocket client;
+    client.setSocketOptions(QLocalSocket::SequentialPacketOption);
+    client.connectToServer("sequentialPackets");
+    QVERIFY(client.waitForConnected(3000));
+    QVERIFY(server.waitForNewConnection(3000));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+    QVERIFY(serverSocket->socketOptions().testFlag(QLocalSocket::SequentialPacketOption));
+
+    const ByteArrayList sent = { "first", QByteArray(100000, 'x'), "3" };
+    for (const QByteArray &message : sent)
+        QCOMPARE(client.write(message), qint64(message.size()));
+    // each message is sent with one system call
+    while (client.bytesToWrite() > 0)
+        QVERIFY(client.waitForBytesWritten(3000));
+
+    ByteArrayList received;
+    while (received.size() < sent.size()) {
+        if (!serverSocket->hasPendingMessages())
+            QVERIFY(serverSocket->waitForReadyRead(3000));
+        while (serverSocket->hasPendingMessages()) {
+            const qint64 size = serverSocket->pendingMessageSize();
+            received << serverSocket->readMessage();
+            QCOMPARE(qint64(received.constLast().size()), size);
+        }
+    }
+    QCOMPARE(received, sent);
+    QCOMPARE(serverSocket->pendingMessageSize(), qint64(-1));
+
+    // a client of the wrong type can't connect
+    QLocalSocket streamClient;
+    streamClient.connectToServer("sequentialPackets");
+    QVERIFY(!streamClient.waitForConnected(3000));
+#else
+    QSKIP("SOCK_SEQPACKET Unix domain sockets are not supported on this platform");
+#endif
+}
+
 QTEST_MAIN(tst_QLocalSocket)
 #include "tst_qlocalsocket.moc"
 
@@ -35,6 +35,8 @@
 #include <QNetworkProxy>
 #include <QSet>
 #include <QList>
+#include <QMutex>
+#include <QThread>
 
 #include "../../../network-settings.h"
 
@@ -91,6 +93,7 @@ private slots:
     void canAccessPendingConnectionsWhileNotListening();
 
     void pauseAccepting();
+    void acceptThreads();
 
     void pendingConnectionAvailable_data();
     void pendingConnectionAvailable();
@@ -1108,6 +1111,61 @@ private:
     QList<qintptr> m_socketDescriptors;
 };
 
+void tst_QTcpServer::acceptThreads()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+#if !defined(Q_OS_LINUX) && !defined(Q_OS_FREEBSD)
+    QSKIP("Connections are only spread over accept threads on Linux and FreeBSD");
+#endif
+
+    QTcpServer server;
+    QCOMPARE(server.acceptThreadCount(), 0);
+    server.setAcceptThreadCount(4);
+    QCOMPARE(server.acceptThreadCount(), 4);
+
+    QMutex mutex;
+    QSet<QThread *> acceptingThreads;
+    bool socketsInAcceptingThread = true;
+    connect(&server, &QTcpServer::connectionAccepted, this, [&](QTcpSocket *socket) {
+        {
+            QMutexLocker locker(&mutex);
+            acceptingThreads.insert(QThread::currentThread());
+            socketsInAcceptingThread &= socket->thread() == QThread::currentThread();
+        }
+        connect(socket, &QAbstractSocket::disconnected, socket, &QObject::deleteLater);
+        socket->write("x");
+        socket->disconnectFromHost();
+    }, Qt::DirectConnection);
+    QSignalSpy newConnectionSpy(&server, &QTcpServer::newConnection);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QVERIFY(server.isListening());
+
+    const int NumSockets = 64;
+    QTcpSocket sockets[NumSockets];
+    for (QTcpSocket &socket : sockets)
+        socket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    for (QTcpSocket &socket : sockets) {
+        QVERIFY(socket.waitForReadyRead(5000));
+        QCOMPARE(socket.readAll(), QByteArray("x"));
+        QVERIFY(socket.state() == QAbstractSocket::UnconnectedState
+                || socket.waitForDisconnected(5000));
+    }
+
+    QCOMPARE(newConnectionSpy.size(), 0);
+    QVERIFY(!server.hasPendingConnections());
+    {
+        QMutexLocker locker(&mutex);
+        QVERIFY(socketsInAcceptingThread);
+        QVERIFY(!acceptingThreads.contains(QThread::currentThread()));
+        QVERIFY(acceptingThreads.size() <= 4);
+    }
+
+    server.close();
+    QVERIFY(!server.isListening());
+}
+
 void tst_QTcpServer::pendingConnectionAvailable_data()
 {
     QTest::addColumn<bool>("useDerivedServer");
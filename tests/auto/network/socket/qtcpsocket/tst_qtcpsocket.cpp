@@ -174,6 +174,8 @@ private slots:
     void serverDisconnectWithBuffered();
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
+    void writeManyChunks();
+    void connectionAttemptDelay();
     void readNotificationsAfterBind();
 
 protected slots:
@@ -3194,6 +3196,82 @@ void tst_QTcpSocket::writeOnReadBufferOverflow()
     delete socket;
 }
 
+// Test that a write buffer consisting of many shared chunks is sent
+// completely and in order
+void tst_QTcpSocket::writeManyChunks()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer tcpServer;
+    QTcpSocket *socket = newSocket();
+
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    QTcpSocket *newConnection = tcpServer.nextPendingConnection();
+    QVERIFY(newConnection != nullptr);
+
+    QByteArray received;
+    connect(newConnection, &QIODevice::readyRead, this, [&] {
+        received += newConnection->readAll();
+    });
+
+    // Large enough to be appended to the write buffer without copying
+    QByteArray expected;
+    for (int i = 0; i < 300; ++i) {
+        const QByteArray chunk(4096 + i, char('a' + i % 26));
+        QCOMPARE(socket->write(chunk), qint64(chunk.size()));
+        expected += chunk;
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 10000);
+    QCOMPARE(received, expected);
+    QCOMPARE(socket->bytesToWrite(), Q_INT64_C(0));
+
+    delete newConnection;
+    delete socket;
+}
+
+void tst_QTcpSocket::connectionAttemptDelay()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    using namespace std::chrono_literals;
+    QTcpSocket *socket = newSocket();
+    QCOMPARE(socket->connectionAttemptDelay(), 250ms);
+    socket->setConnectionAttemptDelay(-1ms);
+    QCOMPARE(socket->connectionAttemptDelay(), 0ms);
+    socket->setConnectionAttemptDelay(100ms);
+    QCOMPARE(socket->connectionAttemptDelay(), 100ms);
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+
+    // The first address is not routable, so connecting to it either fails
+    // or hangs; in both cases the second one must be used without waiting
+    // for the connect timeout.
+    const QString name = QStringLiteral("qt-test-server-first-unreachable");
+    QHostInfo info;
+    info.setHostName(name);
+    info.setAddresses(QList<QHostAddress>() << QHostAddress("192.0.2.1")
+                                            << QHostAddress(QHostAddress::LocalHost));
+    qt_qhostinfo_cache_inject(name, info);
+
+    QElapsedTimer timer;
+    timer.start();
+    socket->connectToHost(name, tcpServer.serverPort());
+    QTRY_COMPARE_WITH_TIMEOUT(socket->state(), QAbstractSocket::ConnectedState, 10000);
+    QVERIFY(timer.elapsed() < 10000);
+    QCOMPARE(socket->peerAddress(), QHostAddress(QHostAddress::LocalHost));
+
+    delete socket;
+}
+
 // Test that the socket does not enable the read notifications in bind()
 void tst_QTcpSocket::readNotificationsAfterBind()
 {
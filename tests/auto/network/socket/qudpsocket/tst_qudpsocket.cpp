@@ -82,6 +82,7 @@ private slots:
     void outOfProcessConnectedClientServerTest();
     void outOfProcessUnconnectedClientServerTest();
     void zeroLengthDatagram();
+    void batchDatagrams();
     void multicastTtlOption_data();
     void multicastTtlOption();
     void multicastLoopbackOption_data();
@@ -1235,6 +1236,66 @@ void tst_QUdpSocket::zeroLengthDatagram()
     QCOMPARE(receiver.readDatagram(&buf, 1), qint64(0));
 }
 
+void tst_QUdpSocket::batchDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    QVERIFY(receiver.receiveDatagrams(10).isEmpty());
+
+    // More than go into one system call, starting with an empty one
+    QUdpSocket sender;
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < 100; ++i) {
+        datagrams.append(QNetworkDatagram(QByteArray(i, char('a' + i % 26)),
+                                          QHostAddress::LocalHost, receiver.localPort()));
+    }
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    qsizetype sent = 0;
+    while (sent < datagrams.size()) {
+        const qsizetype result = sender.writeDatagrams(datagrams.mid(sent));
+        QVERIFY2(result > 0, QtNetworkSettings::msgSocketError(sender).constData());
+        sent += result;
+    }
+    QVERIFY(!bytesWrittenSpy.isEmpty());
+    qint64 bytesWritten = 0;
+    for (const QList<QVariant> &arguments : std::as_const(bytesWrittenSpy))
+        bytesWritten += arguments.at(0).toLongLong();
+    qint64 expectedBytes = 0;
+    for (const QNetworkDatagram &datagram : std::as_const(datagrams))
+        expectedBytes += datagram.data().size();
+    QCOMPARE(bytesWritten, expectedBytes);
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < datagrams.size()) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(1000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += receiver.receiveDatagrams(datagrams.size() - received.size());
+    }
+    QVERIFY(!receiver.hasPendingDatagrams());
+
+    for (int i = 0; i < datagrams.size(); ++i) {
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(received.at(i).senderPort(), int(sender.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(receiver.localPort()));
+    }
+
+    // Datagrams longer than maxSize are truncated
+    QCOMPARE(sender.writeDatagrams({ datagrams.at(99), datagrams.at(50) }), qsizetype(2));
+    received.clear();
+    while (received.size() < 2) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(1000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += receiver.receiveDatagrams(2, 60);
+    }
+    QCOMPARE(received.at(0).data(), datagrams.at(99).data().left(60));
+    QCOMPARE(received.at(1).data(), datagrams.at(50).data());
+}
+
 void tst_QUdpSocket::multicastTtlOption_data()
 {
     QTest::addColumn<QHostAddress>("bindAddress");
@@ -214,6 +214,7 @@ private slots:
     void listTest();
     void treeTest();
     void tableTest();
+    void largeTableTest();
 
     void uniqueIdTest();
     void calendarWidgetTest();
@@ -3400,6 +3401,57 @@ void tst_QAccessibility::tableTest()
     QTestAccessibility::clearEvents();
 }
 
+void tst_QAccessibility::largeTableTest()
+{
+    auto tvHolder = std::make_unique<QTableWidget>(2000, 10);
+    auto tableView = tvHolder.get();
+    tableView->resize(400, 300);
+    tableView->show();
+    QVERIFY(QTest::qWaitForWindowExposed(tableView));
+
+    QAccessibleInterface *iface = QAccessible::queryAccessibleInterface(tableView);
+    QAccessibleTableInterface *table = iface->tableInterface();
+    QVERIFY(table);
+
+    // visit every cell, like a screen reader reading the whole table
+    QAccessibleInterface *first = table->cellAt(0, 0);
+    QVERIFY(first);
+    const QAccessible::Id firstId = QAccessible::uniqueId(first);
+    QAccessible::Id lastId = 0;
+    for (int row = 0; row < 2000; ++row) {
+        for (int column = 0; column < 10; ++column) {
+            QAccessibleInterface *cell = table->cellAt(row, column);
+            QVERIFY(cell);
+            lastId = QAccessible::uniqueId(cell);
+        }
+    }
+    // the interfaces stay valid until control returns to the event loop
+    QVERIFY(QAccessible::accessibleInterface(lastId));
+
+    // then those of the cells out of view are released, but not those of
+    // the visible ones
+    QTRY_VERIFY(!QAccessible::accessibleInterface(lastId));
+    QVERIFY(QAccessible::accessibleInterface(firstId));
+    QCOMPARE(table->cellAt(0, 0), first);
+
+    // and they are made again when asked for
+    QAccessibleInterface *last = table->cellAt(1999, 9);
+    QVERIFY(last);
+    QCOMPARE(last->tableCellInterface()->rowIndex(), 1999);
+    QCOMPARE(last->tableCellInterface()->columnIndex(), 9);
+    QCOMPARE(iface->indexOfChild(last), 2000 * 11 + 10);
+
+    // selecting everything sends a single event for the first cell
+    QTestAccessibility::clearEvents();
+    tableView->selectAll();
+    QAccessibleEvent event(tableView, QAccessible::SelectionAdd);
+    event.setChild(12);
+    QVERIFY(QTestAccessibility::containsEvent(&event));
+
+    tvHolder.reset();
+    QTestAccessibility::clearEvents();
+}
+
 void tst_QAccessibility::uniqueIdTest()
 {
     // Test that an ID isn't reassigned to another interface right away when an accessible interface
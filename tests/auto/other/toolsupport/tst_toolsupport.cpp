@@ -117,9 +117,9 @@ void tst_toolsupport::offsets_data()
 #ifdef Q_PROCESSOR_X86
         // x86 32-bit has weird alignment rules. Refer to QtPrivate::AlignOf in
         // qglobal.h for more details.
-        data << 264 << 424;
+        data << 272 << 440;
 #else
-        data << 300 << 424;
+        data << 308 << 440;
 #endif
     }
 #endif
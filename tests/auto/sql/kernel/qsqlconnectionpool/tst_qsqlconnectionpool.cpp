@@ -0,0 +1,225 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qthread.h>
+#include <QtSql/qsqlconnectionpool.h>
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqldriver.h>
+#include <QtSql/qsqlquery.h>
+
+using namespace Qt::StringLiterals;
+using namespace std::chrono_literals;
+
+class tst_QSqlConnectionPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void reuse();
+    void invalidTemplate();
+    void maximumSize();
+    void waitForRelease();
+    void idleTimeout();
+    void healthCheck();
+    void otherThread();
+    void destroyWhileCheckedOut();
+
+private:
+    QTemporaryDir dir;
+    const QString templateName = u"tst_qsqlconnectionpool"_s;
+};
+
+void tst_QSqlConnectionPool::initTestCase()
+{
+    if (!QSqlDatabase::isDriverAvailable(u"QSQLITE"_s))
+        QSKIP("This test requires the SQLite driver");
+    QVERIFY(dir.isValid());
+    QSqlDatabase db = QSqlDatabase::addDatabase(u"QSQLITE"_s, templateName);
+    db.setDatabaseName(dir.filePath(u"pool.sqlite"_s));
+    QVERIFY(db.open());
+    QSqlQuery q(db);
+    QVERIFY(q.exec(u"create table items (id integer)"_s));
+    QVERIFY(q.exec(u"insert into items values (1)"_s));
+    db.close();
+}
+
+void tst_QSqlConnectionPool::cleanupTestCase()
+{
+    QSqlDatabase::removeDatabase(templateName);
+}
+
+void tst_QSqlConnectionPool::reuse()
+{
+    QSqlConnectionPool pool(templateName);
+    QCOMPARE(pool.connectionName(), templateName);
+    QCOMPARE(pool.size(), 0);
+
+    QString name;
+    {
+        QSqlConnectionPool::Connection connection = pool.acquire();
+        QVERIFY(connection.isValid());
+        QVERIFY(connection.database().isOpen());
+        name = connection.database().connectionName();
+        QVERIFY(name != templateName);
+        QVERIFY(QSqlDatabase::contains(name));
+        QCOMPARE(pool.size(), 1);
+        QCOMPARE(pool.idleCount(), 0);
+    }
+    QCOMPARE(pool.size(), 1);
+    QCOMPARE(pool.idleCount(), 1);
+
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    QVERIFY(connection.isValid());
+    QCOMPARE(connection.database().connectionName(), name);
+    QSqlQuery q(connection.database());
+    QVERIFY(q.exec(u"select id from items"_s));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+    q = QSqlQuery();
+
+    connection.release();
+    QVERIFY(!connection.isValid());
+    pool.clear();
+    QCOMPARE(pool.size(), 0);
+    QVERIFY(!QSqlDatabase::contains(name));
+}
+
+void tst_QSqlConnectionPool::invalidTemplate()
+{
+    QSqlConnectionPool pool(u"tst_qsqlconnectionpool_missing"_s);
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    QVERIFY(!connection.isValid());
+    QVERIFY(pool.lastError().isValid());
+    QCOMPARE(pool.size(), 0);
+}
+
+void tst_QSqlConnectionPool::maximumSize()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setMaximumSize(2);
+    QCOMPARE(pool.maximumSize(), 2);
+
+    QSqlConnectionPool::Connection first = pool.acquire();
+    QSqlConnectionPool::Connection second = pool.acquire();
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+    QVERIFY(first.database().connectionName() != second.database().connectionName());
+    QVERIFY(!pool.lastError().isValid());
+
+    QSqlConnectionPool::Connection third = pool.acquire(QDeadlineTimer(50ms));
+    QVERIFY(!third.isValid());
+    QCOMPARE(pool.lastError().type(), QSqlError::ConnectionError);
+    QCOMPARE(pool.size(), 2);
+
+    const QString name = second.database().connectionName();
+    second.release();
+    third = pool.acquire(QDeadlineTimer(50ms));
+    QVERIFY(third.isValid());
+    QCOMPARE(third.database().connectionName(), name);
+}
+
+void tst_QSqlConnectionPool::waitForRelease()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setMaximumSize(1);
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    QVERIFY(connection.isValid());
+
+    std::unique_ptr<QThread> thread(QThread::create([&pool] {
+        QSqlConnectionPool::Connection other = pool.acquire();
+        if (other.isValid())
+            QSqlQuery(u"select id from items"_s, other.database());
+    }));
+    thread->start();
+    QVERIFY(!thread->wait(100ms));
+    connection.release();
+    QVERIFY(thread->wait(10s));
+    QCOMPARE(pool.size(), 1);
+    QCOMPARE(pool.idleCount(), 1);
+}
+
+void tst_QSqlConnectionPool::idleTimeout()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setIdleTimeout(0ms);
+    QCOMPARE(pool.idleTimeout(), 0ms);
+
+    QString name = pool.acquire().database().connectionName();
+    QCOMPARE(pool.idleCount(), 1);
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    QVERIFY(connection.isValid());
+    QVERIFY(connection.database().connectionName() != name);
+    QVERIFY(!QSqlDatabase::contains(name));
+    QCOMPARE(pool.size(), 1);
+}
+
+void tst_QSqlConnectionPool::healthCheck()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setHealthCheckQuery(u"select 1"_s);
+    QCOMPARE(pool.healthCheckQuery(), u"select 1"_s);
+
+    QString name = pool.acquire().database().connectionName();
+    QCOMPARE(pool.acquire().database().connectionName(), name);
+
+    // A connection that fails the check is replaced by a new one.
+    pool.setHealthCheckQuery(u"select id from tst_qsqlconnectionpool_missing"_s);
+    QSqlConnectionPool::Connection connection = pool.acquire();
+    QVERIFY(connection.isValid());
+    QVERIFY(connection.database().connectionName() != name);
+    QVERIFY(!QSqlDatabase::contains(name));
+    QCOMPARE(pool.size(), 1);
+}
+
+void tst_QSqlConnectionPool::otherThread()
+{
+    QSqlConnectionPool pool(templateName);
+    pool.setMaximumSize(1);
+
+    QString name;
+    int value = 0;
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        QSqlConnectionPool::Connection connection = pool.acquire();
+        if (!connection.isValid())
+            return;
+        name = connection.database().connectionName();
+        QSqlQuery q(u"select id from items"_s, connection.database());
+        if (q.next())
+            value = q.value(0).toInt();
+    }));
+    thread->start();
+    QVERIFY(thread->wait(10s));
+    QCOMPARE(value, 1);
+
+    // the connection the thread used can be used here once it was released
+    QSqlConnectionPool::Connection connection = pool.acquire(QDeadlineTimer(1s));
+    QVERIFY(connection.isValid());
+    QCOMPARE(connection.database().connectionName(), name);
+    QCOMPARE(connection.database().driver()->thread(), QThread::currentThread());
+    QSqlQuery q(u"select id from items"_s, connection.database());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+}
+
+void tst_QSqlConnectionPool::destroyWhileCheckedOut()
+{
+    QSqlConnectionPool::Connection connection;
+    QString name;
+    {
+        QSqlConnectionPool pool(templateName);
+        connection = pool.acquire();
+        QVERIFY(connection.isValid());
+        name = connection.database().connectionName();
+    }
+    QVERIFY(connection.database().isOpen());
+    connection.release();
+    QVERIFY(!QSqlDatabase::contains(name));
+}
+
+QTEST_MAIN(tst_QSqlConnectionPool)
+#include "tst_qsqlconnectionpool.moc"
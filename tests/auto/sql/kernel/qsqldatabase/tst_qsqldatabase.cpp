@@ -15,6 +15,7 @@
 #include <qvariant.h>
 #include <qdatetime.h>
 #include <qdebug.h>
+#include <qthread.h>
 
 #include "tst_databases.h"
 
@@ -168,6 +169,8 @@ private slots:
 
     void sqlite_enableRegexp_data() { generic_data("QSQLITE"); }
     void sqlite_enableRegexp();
+    void sqlite_pragmaOptions_data() { generic_data("QSQLITE"); }
+    void sqlite_pragmaOptions();
 
     void sqlite_openError();
 
@@ -2216,6 +2219,71 @@ void tst_QSqlDatabase::sqlite_enableRegexp()
     QFAIL_SQL(q, next());
 }
 
+void tst_QSqlDatabase::sqlite_pragmaOptions()
+{
+    QFETCH(QString, dbName);
+    if (dbName.endsWith(":memory:"))
+        QSKIP("WAL mode is meaningless for :memory: databases");
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const auto restore = qScopeGuard([&db] {
+        db.close();
+        db.setConnectOptions("QSQLITE_JOURNAL_MODE=DELETE");
+        db.open();
+        db.close();
+        db.setConnectOptions(QString());
+        db.open();
+    });
+
+    db.close();
+    db.setConnectOptions("QSQLITE_JOURNAL_MODE=wal;QSQLITE_SYNCHRONOUS=NORMAL;"
+                         "QSQLITE_MMAP_SIZE=65536");
+    QVERIFY_SQL(db, open());
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("PRAGMA journal_mode"));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toString(), QString("wal"));
+    QVERIFY_SQL(q, exec("PRAGMA synchronous"));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+
+    TableScope ts(db, "pragma_options", __FILE__);
+    QVERIFY_SQL(q, exec(QString("CREATE TABLE %1(id INTEGER)").arg(ts.tableName())));
+    QVERIFY_SQL(q, exec(QString("INSERT INTO %1 VALUES(1)").arg(ts.tableName())));
+
+    // A reader on another thread sees the committed rows only, and can't
+    // write to the database
+    QVERIFY_SQL(db, transaction());
+    QVERIFY_SQL(q, exec(QString("INSERT INTO %1 VALUES(2)").arg(ts.tableName())));
+    int readerCount = -1;
+    bool readerWrote = true;
+    std::unique_ptr<QThread> reader(QThread::create([&] {
+        const QString readerName = dbName + ":reader";
+        {
+            QSqlDatabase readerDb = QSqlDatabase::cloneDatabase(dbName, readerName);
+            readerDb.setConnectOptions("QSQLITE_QUERY_ONLY;QSQLITE_MMAP_SIZE=65536");
+            if (readerDb.open()) {
+                QSqlQuery rq(readerDb);
+                if (rq.exec(QString("SELECT COUNT(*) FROM %1").arg(ts.tableName())) && rq.next())
+                    readerCount = rq.value(0).toInt();
+                readerWrote = rq.exec(QString("INSERT INTO %1 VALUES(3)").arg(ts.tableName()));
+            }
+        }
+        QSqlDatabase::removeDatabase(readerName);
+    }));
+    reader->start();
+    QVERIFY(reader->wait());
+    QVERIFY_SQL(db, commit());
+    QCOMPARE(readerCount, 1);
+    QVERIFY(!readerWrote);
+
+    db.close();
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QSQLiteDriver::open: Unknown value 'SOMETIMES' for PRAGMA synchronous");
+    db.setConnectOptions("QSQLITE_SYNCHRONOUS=SOMETIMES");
+    QVERIFY_SQL(db, open());
+}
+
 void tst_QSqlDatabase::sqlite_openError()
 {
     // see QTBUG-70506
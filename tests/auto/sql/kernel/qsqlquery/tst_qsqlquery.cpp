@@ -126,6 +126,10 @@ private slots:
     void invalidQuery();
     void batchExec_data() { generic_data(); }
     void batchExec();
+    void batchExecManyRows_data() { generic_data(); }
+    void batchExecManyRows();
+    void execAsync_data() { generic_data(); }
+    void execAsync();
     void QTBUG_43874_data() { generic_data(); }
     void QTBUG_43874();
     void oraArrayBind_data() { generic_data("QOCI"); }
@@ -142,6 +146,12 @@ private slots:
     void psql_bindWithDoubleColonCastOperator();
     void psql_specialFloatValues_data() { generic_data("QPSQL"); }
     void psql_specialFloatValues();
+    void psql_cursorFetch_data() { generic_data("QPSQL"); }
+    void psql_cursorFetch();
+    void statementCache_data() { generic_data(); }
+    void statementCache();
+    void odbc_rowsetFetch_data() { generic_data("QODBC"); }
+    void odbc_rowsetFetch();
     void queryOnInvalidDatabase_data() { generic_data(); }
     void queryOnInvalidDatabase();
     void createQueryOnClosedDatabase_data() { generic_data(); }
@@ -225,6 +235,9 @@ private slots:
     void sqlite_real_data() { generic_data("QSQLITE"); }
     void sqlite_real();
 
+    void sqlite_cachedValues_data() { generic_data("QSQLITE"); }
+    void sqlite_cachedValues();
+
     void prepared_query_json_row_data() { generic_data(); }
     void prepared_query_json_row();
 
@@ -2572,6 +2585,96 @@ void tst_QSqlQuery::QTBUG_43874()
     QCOMPARE(q.value(0).toInt(), 1);
 }
 
+void tst_QSqlQuery::batchExecManyRows()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    TableScope ts(db, "qtest_batch_many", __FILE__);
+    const auto &tableName = ts.tableName();
+
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int, name varchar(20))")
+                        .arg(tableName)));
+
+    // Enough rows for drivers that send a batch in blocks to need several
+    constexpr int RowCount = 2500;
+    QVariantList idCol;
+    QVariantList nameCol;
+    for (int i = 0; i < RowCount; ++i) {
+        idCol.append(i);
+        nameCol.append(QString::number(i));
+    }
+
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 (id, name) values (?, ?)")
+                           .arg(tableName)));
+    q.addBindValue(idCol);
+    q.addBindValue(nameCol);
+    QVERIFY_SQL(q, execBatch());
+
+    QVERIFY_SQL(q, exec(QLatin1String("select id, name from %1 order by id").arg(tableName)));
+    for (int i = 0; i < RowCount; ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), i);
+        QCOMPARE(q.value(1).toString(), QString::number(i));
+    }
+    QVERIFY(!q.next());
+
+    // The batch must not leave a transaction open behind the caller's back
+    if (db.driver()->hasFeature(QSqlDriver::Transactions)) {
+        QVERIFY(db.transaction());
+        QVERIFY(db.commit());
+    }
+}
+
+void tst_QSqlQuery::execAsync()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    TableScope ts(db, "qtest_async", __FILE__);
+    const auto &tableName = ts.tableName();
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int, name varchar(20))")
+                        .arg(tableName)));
+    QVERIFY_SQL(q, exec(QLatin1String("insert into %1 values (1, 'one')").arg(tableName)));
+    QVERIFY_SQL(q, exec(QLatin1String("insert into %1 values (2, 'two')").arg(tableName)));
+
+    QFuture<QSqlResultSet> future =
+            db.execAsync(QLatin1String("select id, name from %1 order by id").arg(tableName));
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QSqlResultSet resultSet = future.result();
+    QVERIFY2(!resultSet.error.isValid(), qPrintable(resultSet.error.text()));
+    QCOMPARE(resultSet.records.size(), 2);
+    QCOMPARE(resultSet.records.at(0).value(0).toInt(), 1);
+    QCOMPARE(resultSet.records.at(0).value("name").toString(), u"one");
+    QCOMPARE(resultSet.records.at(1).value(0).toInt(), 2);
+    QCOMPARE(resultSet.records.at(1).value("name").toString(), u"two");
+
+    // A prepared query with bound values, executed on the connection's thread
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 values (?, ?)").arg(tableName)));
+    q.addBindValue(3);
+    q.addBindValue(u"three"_s);
+    resultSet = q.execAsync().result();
+    QVERIFY2(!resultSet.error.isValid(), qPrintable(resultSet.error.text()));
+    QVERIFY(resultSet.records.isEmpty());
+    QCOMPARE(resultSet.numRowsAffected, 1);
+    QVERIFY(!q.isActive());
+
+    QVERIFY_SQL(q, exec(QLatin1String("select name from %1 where id = 3").arg(tableName)));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toString(), u"three");
+    q.finish();
+
+    const QString missing = qTableName("qtest_async_missing", __FILE__, db);
+    resultSet = q.execAsync("select * from " + missing).result();
+    QVERIFY(resultSet.error.isValid());
+    QVERIFY(resultSet.records.isEmpty());
+}
+
 void tst_QSqlQuery::oraArrayBind()
 {
     QFETCH(QString, dbName);
@@ -2882,6 +2985,229 @@ void tst_QSqlQuery::psql_specialFloatValues()
     }
 }
 
+void tst_QSqlQuery::psql_cursorFetch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("cursorFetch"); });
+    QSqlDatabase cursorDb = QSqlDatabase::cloneDatabase(db, "cursorFetch");
+    cursorDb.setConnectOptions(cursorDb.connectOptions() + ";QPSQL_CURSOR_FETCH_SIZE=3");
+    QVERIFY_SQL(cursorDb, open());
+    TableScope ts(cursorDb, "cursorfetch", __FILE__);
+
+    QSqlQuery q(cursorDb);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int)").arg(ts.tableName())));
+    QVERIFY_SQL(q, exec(QLatin1String("insert into %1 select generate_series(0, 9)")
+                            .arg(ts.tableName())));
+    const QString select = QLatin1String("select id from %1 order by id").arg(ts.tableName());
+
+    // Scrollable navigation across fetch blocks
+    QVERIFY_SQL(q, exec(select));
+    QVERIFY(q.isSelect());
+    QCOMPARE(q.record().count(), 1);
+    for (int i = 0; i < 4; ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), i);
+    }
+    QVERIFY(q.seek(8));
+    QCOMPARE(q.value(0).toInt(), 8);
+    QVERIFY(q.previous());
+    QCOMPARE(q.value(0).toInt(), 7);
+    QVERIFY(q.seek(1));
+    QCOMPARE(q.value(0).toInt(), 1);
+    QVERIFY(q.last());
+    QCOMPARE(q.at(), 9);
+    QCOMPARE(q.value(0).toInt(), 9);
+    QCOMPARE(q.size(), 10);
+    QVERIFY(!q.next());
+    QVERIFY(q.first());
+    QCOMPARE(q.value(0).toInt(), 0);
+
+    // Other statements can run while a cursor is being read
+    QSqlQuery forwardOnly(cursorDb);
+    forwardOnly.setForwardOnly(true);
+    QVERIFY_SQL(forwardOnly, exec(select));
+    int expected = 0;
+    while (forwardOnly.next()) {
+        QCOMPARE(forwardOnly.value(0).toInt(), expected++);
+        QSqlQuery other(cursorDb);
+        QVERIFY_SQL(other, exec("select 1"));
+    }
+    QVERIFY(!forwardOnly.lastError().isValid());
+    QCOMPARE(expected, 10);
+
+    // Bound values and cursors inside a transaction
+    QVERIFY_SQL(cursorDb, transaction());
+    QVERIFY_SQL(q, prepare(QLatin1String("select id from %1 where id >= ? order by id")
+                               .arg(ts.tableName())));
+    q.addBindValue(5);
+    QVERIFY_SQL(q, exec());
+    expected = 5;
+    while (q.next())
+        QCOMPARE(q.value(0).toInt(), expected++);
+    QCOMPARE(expected, 10);
+    QVERIFY_SQL(cursorDb, commit());
+
+    // The cursor went away with the transaction; starting a new one and
+    // reusing the query must not trip over it
+    QVERIFY_SQL(cursorDb, transaction());
+    QVERIFY_SQL(q, exec(select));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 0);
+    q.finish();
+    QVERIFY_SQL(q, exec("select 1"));
+    QVERIFY_SQL(cursorDb, commit());
+
+    // Statements that cannot be declared as a cursor still work
+    QVERIFY_SQL(q, exec(QLatin1String("select id from %1 order by id for update")
+                            .arg(ts.tableName())));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 0);
+}
+
+void tst_QSqlQuery::statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString driverName = db.driverName();
+    if (driverName != "QSQLITE"_L1 && driverName != "QPSQL"_L1
+        && driverName != "QMYSQL"_L1 && driverName != "QODBC"_L1) {
+        QSKIP("The driver has no statement cache");
+    }
+
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("statementCache"); });
+    QSqlDatabase cacheDb = QSqlDatabase::cloneDatabase(db, "statementCache");
+    cacheDb.setConnectOptions(cacheDb.connectOptions() + u';' + driverName
+                              + "_STATEMENT_CACHE_SIZE=2"_L1);
+    QVERIFY_SQL(cacheDb, open());
+    TableScope ts(cacheDb, "statementcache", __FILE__);
+    QSqlQuery create(cacheDb);
+    QVERIFY_SQL(create, exec(QLatin1String("create table %1 (id int)").arg(ts.tableName())));
+
+    // Each query reuses the statement of the previous one, which must not
+    // keep its bound values
+    const QString insert = QLatin1String("insert into %1 values (?)").arg(ts.tableName());
+    for (int i = 0; i < 5; ++i) {
+        QSqlQuery q(cacheDb);
+        QVERIFY_SQL(q, prepare(insert));
+        q.addBindValue(i);
+        QVERIFY_SQL(q, exec());
+    }
+
+    // Two active queries with the same text don't share a statement
+    const QString select = QLatin1String("select id from %1 where id >= ? order by id")
+                                   .arg(ts.tableName());
+    QSqlQuery first(cacheDb);
+    first.setForwardOnly(true);
+    QVERIFY_SQL(first, prepare(select));
+    first.addBindValue(0);
+    QVERIFY_SQL(first, exec());
+    QVERIFY(first.next());
+    QCOMPARE(first.value(0).toInt(), 0);
+    QSqlQuery second(cacheDb);
+    QVERIFY_SQL(second, prepare(select));
+    second.addBindValue(3);
+    QVERIFY_SQL(second, exec());
+    QVERIFY(second.next());
+    QCOMPARE(second.value(0).toInt(), 3);
+    QVERIFY(first.next());
+    QCOMPARE(first.value(0).toInt(), 1);
+
+    // More statements than the cache holds
+    for (int round = 0; round < 2; ++round) {
+        for (int limit = 1; limit <= 4; ++limit) {
+            QSqlQuery q(cacheDb);
+            QVERIFY_SQL(q, prepare(QLatin1String("select count(*) from %1 where id < %2")
+                                       .arg(ts.tableName()).arg(limit)));
+            QVERIFY_SQL(q, exec());
+            QVERIFY(q.next());
+            QCOMPARE(q.value(0).toInt(), limit);
+        }
+    }
+
+    // The cached statements go away with the connection
+    first.finish();
+    second.finish();
+    cacheDb.close();
+    QVERIFY_SQL(cacheDb, open());
+    QSqlQuery q(cacheDb);
+    QVERIFY_SQL(q, prepare(select));
+    q.addBindValue(4);
+    QVERIFY_SQL(q, exec());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 4);
+    QVERIFY(!q.next());
+}
+
+void tst_QSqlQuery::odbc_rowsetFetch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("rowsetFetch"); });
+    QSqlDatabase rowsetDb = QSqlDatabase::cloneDatabase(db, "rowsetFetch");
+    rowsetDb.setConnectOptions(rowsetDb.connectOptions() + ";QODBC_ROWSET_SIZE=4");
+    QVERIFY_SQL(rowsetDb, open());
+    TableScope ts(rowsetDb, "rowsetfetch", __FILE__);
+
+    QSqlQuery q(rowsetDb);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int, name varchar(20))")
+                            .arg(ts.tableName())));
+    QVERIFY_SQL(q, prepare(QLatin1String("insert into %1 values (?, ?)").arg(ts.tableName())));
+    for (int i = 0; i < 10; ++i) {
+        q.addBindValue(i);
+        q.addBindValue(i % 3 ? QVariant(QString::number(i).repeated(i + 1))
+                             : QVariant(QMetaType::fromType<QString>()));
+        QVERIFY_SQL(q, exec());
+    }
+
+    // The rows come in blocks of 4, the last one incomplete
+    const QString select = QLatin1String("select id, name from %1 order by id")
+                                   .arg(ts.tableName());
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, exec(select));
+    int expected = 0;
+    while (q.next()) {
+        QCOMPARE(q.at(), expected);
+        QCOMPARE(q.value(0).toInt(), expected);
+        if (expected % 3) {
+            QCOMPARE(q.value(1).toString(), QString::number(expected).repeated(expected + 1));
+        } else {
+            QVERIFY(q.isNull(1));
+        }
+        ++expected;
+    }
+    QVERIFY(!q.lastError().isValid());
+    QCOMPARE(expected, 10);
+
+    // Seeking forward skips rows within and across blocks
+    QVERIFY_SQL(q, exec(select));
+    QVERIFY(q.seek(2));
+    QCOMPARE(q.value(0).toInt(), 2);
+    QVERIFY(q.seek(6));
+    QCOMPARE(q.value(0).toInt(), 6);
+    QVERIFY(q.next());
+    QCOMPARE(q.value(1).toString(), QString::number(7).repeated(8));
+    QVERIFY(q.last());
+    QCOMPARE(q.at(), 9);
+
+    // The same statement executed again starts over
+    QVERIFY_SQL(q, prepare(QLatin1String("select id from %1 where id >= ? order by id")
+                               .arg(ts.tableName())));
+    for (int start : { 1, 5 }) {
+        q.addBindValue(start);
+        QVERIFY_SQL(q, exec());
+        expected = start;
+        while (q.next())
+            QCOMPARE(q.value(0).toInt(), expected++);
+        QCOMPARE(expected, 10);
+    }
+}
+
 /* For task 157397: Using QSqlQuery with an invalid QSqlDatabase
    does not set the last error of the query.
    This test function will output some warnings, that's ok.
@@ -4277,6 +4603,51 @@ void tst_QSqlQuery::sqlite_real()
     QCOMPARE(q.value(0).toDouble(), 5.6);
 }
 
+void tst_QSqlQuery::sqlite_cachedValues()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    TableScope ts(db, "sqlitecachedvalues", __FILE__);
+
+    QSqlQuery q(db);
+    // SQLite lets the values of a column have different types; the name
+    // column keeps to strings and nulls, the any column mixes everything.
+    QVERIFY_SQL(q, exec(QLatin1String("CREATE TABLE %1 (id INTEGER, name TEXT, any)")
+                        .arg(ts.tableName())));
+    QVERIFY_SQL(q, exec(QLatin1String("INSERT INTO %1 (id, name, any) VALUES "
+                                      "(1, NULL, NULL), (2, 'two', 42), (3, '', 'text'), "
+                                      "(4, NULL, x'0001'), (5, 'five', 2.5), (6, NULL, NULL)")
+                        .arg(ts.tableName())));
+
+    const QVariant nullString = QVariant(QMetaType::fromType<QString>());
+    const QVariantList names = { nullString, u"two"_s, u""_s, nullString, u"five"_s, nullString };
+    const QVariantList anys = { nullString, qlonglong(42), u"text"_s,
+                                QByteArray("\0\1", 2), 2.5, nullString };
+
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT id, name, any FROM %1 ORDER BY id")
+                        .arg(ts.tableName())));
+    // Walk forward, filling the cache, and backwards, reading from it
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < names.size(); ++i) {
+            const int row = pass ? int(names.size()) - 1 - i : i;
+            QVERIFY(q.seek(row));
+            QCOMPARE(q.value(0), QVariant(qlonglong(row + 1)));
+            QCOMPARE(q.value(1), names.at(row));
+            QCOMPARE(q.isNull(1), names.at(row).isNull());
+            QCOMPARE(q.value(1).toString().isEmpty(), names.at(row).toString().isEmpty());
+            QCOMPARE(q.value(2), anys.at(row));
+            QCOMPARE(q.value(2).metaType(), anys.at(row).metaType());
+            QCOMPARE(q.isNull(2), anys.at(row).isNull());
+        }
+    }
+    QVERIFY(q.last());
+    QCOMPARE(q.at(), int(names.size()) - 1);
+    QVERIFY(!q.next());
+    QVERIFY(q.previous());
+    QCOMPARE(q.value(0), QVariant(qlonglong(names.size())));
+}
+
 void tst_QSqlQuery::prepared_query_json_row()
 {
     QFETCH(QString, dbName);
@@ -27,6 +27,7 @@ private slots:
     void setGenerated();
     void remove();
     void position();
+    void positionWideRecord();
     void operator_Assign();
     void isNull();
     void isGenerated();
@@ -349,6 +350,48 @@ void tst_QSqlRecord::position()
     }
 }
 
+void tst_QSqlRecord::positionWideRecord()
+{
+    // wide records look up their fields through an index
+    QSqlRecord wide;
+    for (int i = 0; i < 40; ++i)
+        wide.append(QSqlField(QString::number(i).prepend(u"Field"), QMetaType(QMetaType::Int),
+                              QStringLiteral("table")));
+    wide.append(QSqlField(QStringLiteral("FIELD3"), QMetaType(QMetaType::Int)));
+    wide.append(QSqlField(QString::fromUtf8("Stra\u00DFe"), QMetaType(QMetaType::Int)));
+
+    for (int i = 0; i < 40; ++i) {
+        QCOMPARE(wide.indexOf(QString::number(i).prepend(u"field")), i);
+        QCOMPARE(wide.indexOf(QString::number(i).prepend(u"table.FIELD")), i);
+    }
+    // the first field with a name is found
+    QCOMPARE(wide.indexOf(QStringLiteral("field3")), 3);
+    QCOMPARE(wide.indexOf(QString::fromUtf8("STRA\u00DFE")), 41);
+    QCOMPARE(wide.indexOf(QStringLiteral("field40")), -1);
+    QCOMPARE(wide.indexOf(QString()), -1);
+
+    // copies with other values share the index, copies with other fields don't
+    QSqlRecord values = wide;
+    values.setValue(QStringLiteral("field7"), 7);
+    QCOMPARE(values.value(7).toInt(), 7);
+    QCOMPARE(values.indexOf(QStringLiteral("field39")), 39);
+
+    QSqlRecord changed = wide;
+    changed.remove(3);
+    QCOMPARE(changed.indexOf(QStringLiteral("field3")), 39);
+    QCOMPARE(changed.indexOf(QStringLiteral("field4")), 3);
+    changed.insert(0, QSqlField(QStringLiteral("field4"), QMetaType(QMetaType::Int)));
+    QCOMPARE(changed.indexOf(QStringLiteral("field4")), 0);
+    changed.replace(0, QSqlField(QStringLiteral("other"), QMetaType(QMetaType::Int)));
+    QCOMPARE(changed.indexOf(QStringLiteral("other")), 0);
+    QCOMPARE(changed.indexOf(QStringLiteral("field4")), 4);
+    changed.append(QSqlField(QStringLiteral("last"), QMetaType(QMetaType::Int)));
+    QCOMPARE(changed.indexOf(QStringLiteral("LAST")), changed.count() - 1);
+
+    QCOMPARE(wide.indexOf(QStringLiteral("field3")), 3);
+    QCOMPARE(wide.indexOf(QStringLiteral("other")), -1);
+}
+
 void tst_QSqlRecord::remove()
 {
     createTestRecord();
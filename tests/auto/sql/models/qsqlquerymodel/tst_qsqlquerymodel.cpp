@@ -46,6 +46,8 @@ private slots:
     void setHeaderData();
     void fetchMore_data() { generic_data(); }
     void fetchMore();
+    void fetchWindow_data() { generic_data(); }
+    void fetchWindow();
 
     //problem specific tests
     void withSortFilterProxyModel_data() { generic_data(); }
@@ -466,6 +468,34 @@ void tst_QSqlQueryModel::fetchMore()
     }
 }
 
+void tst_QSqlQueryModel::fetchWindow()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQueryModel model;
+    QCOMPARE(model.fetchWindow(), 0);
+    model.setFetchWindow(1);
+    QCOMPARE(model.fetchWindow(), 1);
+    model.setQuery(QSqlQuery("select id from " + qTableName("many", __FILE__, db)
+                             + " order by id", db));
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+    while (model.canFetchMore())
+        model.fetchMore();
+    QCOMPARE(model.rowCount(), 2048);
+
+    // Forwards, backwards and jumping around; rows that dropped out of the
+    // window have to come back the same
+    for (int row = 0; row < model.rowCount(); ++row)
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), row);
+    for (int row = model.rowCount() - 1; row >= 0; row -= 7)
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), row);
+    for (int row : { 2047, 3, 1500, 0, 1024, 2046 })
+        QCOMPARE(model.data(model.index(row, 0)).toInt(), row);
+    QVERIFY2(!model.lastError().isValid(), qPrintable(model.lastError().text()));
+}
+
 // For task 149491: When used with QSortFilterProxyModel, a view and a
 // database that doesn't support the QuerySize feature, blank rows was
 // appended if the query returned more than 256 rows and setQuery()
@@ -61,6 +61,8 @@ private slots:
     void insertColumns();
     void submitAll_data() { generic_data(); }
     void submitAll();
+    void bulkSubmitAll_data() { generic_data(); }
+    void bulkSubmitAll();
     void setData_data()  { generic_data(); }
     void setData();
     void setRecord_data()  { generic_data(); }
@@ -1064,6 +1066,64 @@ void tst_QSqlTableModel::submitAll()
     QCOMPARE(model.data(model.index(1, 1)).toString(), QString("trond"));
 }
 
+void tst_QSqlTableModel::bulkSubmitAll()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const auto pktest = qTableName("pktest", __FILE__, db);
+
+    QSqlTableModel model(0, db);
+    model.setTable(pktest);
+    model.setSort(0, Qt::AscendingOrder);
+    model.setEditStrategy(QSqlTableModel::OnManualSubmit);
+    QVERIFY(!model.isBulkSubmitEnabled());
+    model.setBulkSubmitEnabled(true);
+    QVERIFY(model.isBulkSubmitEnabled());
+    QVERIFY_SQL(model, select());
+    QCOMPARE(model.rowCount(), 0);
+
+    QSqlRecord rec = model.record();
+    for (int i = 1; i <= 10; ++i) {
+        rec.setValue(0, i);
+        rec.setValue(1, QString("row%1").arg(i));
+        QVERIFY(model.insertRecord(-1, rec));
+    }
+    QVERIFY_SQL(model, submitAll());
+    QVERIFY(!model.isDirty());
+    QCOMPARE(model.rowCount(), 10);
+    QCOMPARE(model.data(model.index(0, 1)).toString(), QString("row1"));
+    QCOMPARE(model.data(model.index(9, 1)).toString(), QString("row10"));
+
+    QVERIFY(model.setData(model.index(0, 1), "first"));
+    QVERIFY(model.setData(model.index(1, 1), "second"));
+    QVERIFY(model.removeRows(8, 2));
+    QVERIFY_SQL(model, submitAll());
+    QVERIFY(!model.isDirty());
+    QCOMPARE(model.rowCount(), 8);
+    QCOMPARE(model.data(model.index(0, 1)).toString(), QString("first"));
+    QCOMPARE(model.data(model.index(1, 1)).toString(), QString("second"));
+    QCOMPARE(model.data(model.index(7, 0)).toInt(), 8);
+
+    // the second row violates the primary key
+    rec.setValue(0, 20);
+    rec.setValue(1, QString("row20"));
+    QVERIFY(model.insertRecord(-1, rec));
+    rec.setValue(0, 1);
+    QVERIFY(model.insertRecord(-1, rec));
+    QVERIFY(!model.submitAll());
+    QVERIFY(model.isDirty());
+    if (db.driver()->hasFeature(QSqlDriver::Transactions)) {
+        // nothing was committed
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, exec("select count(*) from " + pktest));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 8);
+    }
+    model.revertAll();
+    QVERIFY(!model.isDirty());
+}
+
 void tst_QSqlTableModel::removeRow()
 {
     QFETCH(QString, dbName);
@@ -23,6 +23,7 @@ private slots:
     void overlappedItems();
     void movingItems_data();
     void movingItems();
+    void manyItems();
     void connectedToSceneRectChanged();
     void items();
     void boundingRectPointIntersection_data();
@@ -145,6 +146,30 @@ void tst_QGraphicsSceneIndex::movingItems()
     QCOMPARE(scene.items(QRectF(0, 0, 1000, 1000)).size(), 11);
 }
 
+void tst_QGraphicsSceneIndex::manyItems()
+{
+    // Enough items for the BSP tree to be built on several threads
+    QGraphicsScene bspScene(0, 0, 2000, 2000);
+    QGraphicsScene linearScene(0, 0, 2000, 2000);
+    linearScene.setItemIndexMethod(QGraphicsScene::NoIndex);
+    for (int i = 0; i < 40000; ++i) {
+        const QRectF rect((i * 37) % 1990, (i * 53) % 1990, 1 + i % 13, 1 + i % 7);
+        bspScene.addRect(rect)->setData(0, i);
+        linearScene.addRect(rect)->setData(0, i);
+    }
+
+    const auto ids = [](const QList<QGraphicsItem *> &items) {
+        QList<int> result;
+        for (QGraphicsItem *item : items)
+            result << item->data(0).toInt();
+        return result;
+    };
+    for (const QRectF &rect : { QRectF(0, 0, 10, 10), QRectF(995, 995, 20, 20),
+                                QRectF(500, 0, 1, 2000), QRectF(0, 0, 2000, 2000) }) {
+        QCOMPARE(ids(bspScene.items(rect)), ids(linearScene.items(rect)));
+    }
+}
+
 void tst_QGraphicsSceneIndex::connectedToSceneRectChanged()
 {
 
@@ -4,6 +4,7 @@
 
 #include <QTest>
 #include <QSignalSpy>
+#include <QThread>
 #include <QTimer>
 
 #include <qgraphicsitem.h>
@@ -192,6 +193,7 @@ private slots:
     void optimizationFlags_dontSavePainterState();
     void optimizationFlags_dontSavePainterState2_data();
     void optimizationFlags_dontSavePainterState2();
+    void optimizationFlags_parallelItemCaching();
     void levelOfDetail_data();
     void levelOfDetail();
     void scrollBarRanges_data();
@@ -2805,6 +2807,57 @@ public:
     qreal lastLod;
 };
 
+void tst_QGraphicsView::optimizationFlags_parallelItemCaching()
+{
+    class ThreadItem : public QGraphicsRectItem
+    {
+    public:
+        using QGraphicsRectItem::QGraphicsRectItem;
+        void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override
+        {
+            paintThread.storeRelease(QThread::currentThread());
+            QGraphicsRectItem::paint(painter, option, widget);
+        }
+        QAtomicPointer<QThread> paintThread;
+    };
+
+    QGraphicsScene scene(0, 0, 200, 200);
+    QList<ThreadItem *> items;
+    for (int i = 0; i < 16; ++i) {
+        ThreadItem *item = new ThreadItem(0, 0, 20, 20);
+        item->setPos((i % 4) * 50, (i / 4) * 50);
+        item->setBrush(Qt::red);
+        item->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+        item->setFlag(QGraphicsItem::ItemPaintsInAnyThread);
+        scene.addItem(item);
+        items << item;
+    }
+
+    QGraphicsView serialView(&scene);
+    serialView.setFrameStyle(QFrame::NoFrame);
+    serialView.resize(300, 300);
+    QGraphicsView parallelView(&scene);
+    parallelView.setFrameStyle(QFrame::NoFrame);
+    parallelView.resize(300, 300);
+    parallelView.setOptimizationFlag(QGraphicsView::ParallelItemCaching);
+
+    for (qreal scale : { 1.0, 1.25 }) {
+        serialView.setTransform(QTransform::fromScale(scale, scale));
+        parallelView.setTransform(QTransform::fromScale(scale, scale));
+
+        const QImage parallel = parallelView.grab().toImage();
+        for (ThreadItem *item : std::as_const(items)) {
+            QVERIFY(item->paintThread.loadAcquire());
+            QVERIFY(item->paintThread.loadAcquire() != QThread::currentThread());
+            item->paintThread.storeRelease(nullptr);
+        }
+        const QImage serial = serialView.grab().toImage();
+        for (ThreadItem *item : std::as_const(items))
+            QCOMPARE(item->paintThread.loadAcquire(), QThread::currentThread());
+        QCOMPARE(parallel, serial);
+    }
+}
+
 void tst_QGraphicsView::levelOfDetail_data()
 {
     QTest::addColumn<QTransform>("transform");
@@ -98,6 +98,7 @@ private slots:
 
     void checkIntersectedRect_data();
     void checkIntersectedRect();
+    void coalesceDataChanged();
 
     void task221955_selectedEditor();
     void task250754_fontChange();
@@ -1230,6 +1231,50 @@ void tst_QAbstractItemView::checkIntersectedRect()
     }
 }
 
+void tst_QAbstractItemView::coalesceDataChanged()
+{
+    class TableView : public QTableView
+    {
+    public:
+        QAbstractItemViewPrivate *d() const
+        {
+            return static_cast<QAbstractItemViewPrivate *>(qt_widget_private(const_cast<TableView *>(this)));
+        }
+    };
+
+    QStandardItemModel model(10, 4);
+    QStandardItem *parentItem = model.item(0, 0);
+    parentItem->appendRow(new QStandardItem);
+    TableView view;
+    view.setModel(&model);
+    view.resize(400, 400);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QTRY_VERIFY(!view.d()->delayedPendingLayout);
+    QTRY_VERIFY(!view.d()->updateTimer.isActive());
+
+    // Changes are only recorded until the next event loop pass
+    for (int i = 0; i < 1000; ++i)
+        emit model.dataChanged(model.index(1, 1), model.index(1, 1));
+    emit model.dataChanged(model.index(2, 1), model.index(2, 1));
+    emit model.dataChanged(model.index(5, 0), model.index(6, 3));
+    const QModelIndex child = model.index(0, 0, parentItem->index());
+    emit model.dataChanged(child, child);
+    QCOMPARE(view.d()->dirtyRootCells, QRegion(1, 1, 1, 2) + QRegion(0, 5, 4, 2));
+    QCOMPARE(view.d()->dirtyChildCells.size(), 1);
+    QCOMPARE(view.d()->dirtyChildCells.value(parentItem->index()), QRegion(0, 0, 1, 1));
+    QVERIFY(view.d()->updateTimer.isActive());
+
+    QTRY_VERIFY(!view.d()->updateTimer.isActive());
+    QVERIFY(view.d()->dirtyRootCells.isEmpty());
+    QVERIFY(view.d()->dirtyChildCells.isEmpty());
+
+    // The recorded rows are forgotten when rows move
+    emit model.dataChanged(model.index(8, 0), model.index(8, 0));
+    model.insertRow(0);
+    QVERIFY(view.d()->dirtyRootCells.isEmpty());
+}
+
 void tst_QAbstractItemView::task221955_selectedEditor()
 {
     if (!QGuiApplicationPrivate::platformIntegration()->hasCapability(QPlatformIntegration::WindowActivation))
@@ -157,6 +157,8 @@ private slots:
     void scrollOnRemove_data();
     void scrollOnRemove();
     void wordWrapNullIcon();
+    void sizeHintsReusedOnInsertAndRemove_data();
+    void sizeHintsReusedOnInsertAndRemove();
 };
 
 // Testing get/set functions
@@ -3196,6 +3198,66 @@ void tst_QListView::wordWrapNullIcon()
     listView.indexAt(QPoint(0, 0));
 }
 
+class SizeHintCountingDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override
+    {
+        ++calls;
+        return QStyledItemDelegate::sizeHint(option, index);
+    }
+
+    mutable int calls = 0;
+};
+
+void tst_QListView::sizeHintsReusedOnInsertAndRemove_data()
+{
+    QTest::addColumn<QListView::ViewMode>("viewMode");
+
+    QTest::newRow("ListMode") << QListView::ListMode;
+    QTest::newRow("IconMode") << QListView::IconMode;
+}
+
+void tst_QListView::sizeHintsReusedOnInsertAndRemove()
+{
+    QFETCH(QListView::ViewMode, viewMode);
+
+    QStringList list;
+    for (int i = 0; i < 100; ++i)
+        list << QString::number(i);
+    QStringListModel model(list);
+    QListView view;
+    SizeHintCountingDelegate delegate;
+    view.setItemDelegate(&delegate);
+    view.setViewMode(viewMode);
+    view.setModel(&model);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(delegate.calls >= model.rowCount());
+
+    // Only the new row has to be measured, plus the row that
+    // updateGeometries() uses for the scroll bar step
+    delegate.calls = 0;
+    model.insertRows(50, 1);
+    model.setData(model.index(50), QStringLiteral("new"));
+    const QRect lastRect = view.visualRect(model.index(model.rowCount() - 1));
+    QVERIFY(lastRect.isValid());
+    QVERIFY(delegate.calls <= 3);
+
+    delegate.calls = 0;
+    model.removeRows(10, 5);
+    QVERIFY(view.visualRect(model.index(model.rowCount() - 1)).isValid());
+    QVERIFY(delegate.calls <= 2);
+
+    // Anything else still measures all items again
+    delegate.calls = 0;
+    view.setFont(QFont(view.font().family(), view.font().pointSize() + 2));
+    QVERIFY(view.visualRect(model.index(model.rowCount() - 1)).isValid());
+    QVERIFY(delegate.calls >= model.rowCount());
+}
+
 
 QTEST_MAIN(tst_QListView)
 #include "tst_qlistview.moc"
@@ -427,6 +427,7 @@ private slots:
 
     void changeHeaderData();
     void viewOptions();
+    void paintPrefetchesCellData();
 
     void taskQTBUG_7232_AllowUserToControlSingleStep();
 
@@ -4647,6 +4648,66 @@ void tst_QTableView::viewOptions()
     QVERIFY(options.showDecorationSelected);
 }
 
+class RangeCountingModel : public QStandardItemModel
+{
+public:
+    using QStandardItemModel::QStandardItemModel;
+
+    void multiDataForRange(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                           QModelRoleDataSpan roleDataSpan) const override
+    {
+        ++rangeCalls;
+        QStandardItemModel::multiDataForRange(topLeft, bottomRight, roleDataSpan);
+    }
+
+    mutable int rangeCalls = 0;
+};
+
+class TextRecordingDelegate : public QStyledItemDelegate
+{
+public:
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override
+    {
+        QStyledItemDelegate::initStyleOption(option, index);
+        texts[QPoint(index.column(), index.row())] = option->text;
+    }
+
+    mutable QHash<QPoint, QString> texts;
+};
+
+void tst_QTableView::paintPrefetchesCellData()
+{
+    RangeCountingModel model(4, 3);
+    for (int row = 0; row < model.rowCount(); ++row) {
+        for (int column = 0; column < model.columnCount(); ++column)
+            model.setItem(row, column, new QStandardItem(QString("%1,%2").arg(row).arg(column)));
+    }
+    QTableView view;
+    TextRecordingDelegate delegate;
+    view.setItemDelegate(&delegate);
+    view.setModel(&model);
+    view.resize(400, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const auto verifyTexts = [&]() {
+        QCOMPARE(delegate.texts.size(), model.rowCount() * model.columnCount());
+        for (auto it = delegate.texts.cbegin(); it != delegate.texts.cend(); ++it)
+            QCOMPARE(it.value(), model.index(it.key().y(), it.key().x()).data().toString());
+    };
+
+    QTRY_VERIFY(model.rangeCalls > 0);
+    verifyTexts();
+
+    // Moved sections don't map to a block of the model any more
+    view.horizontalHeader()->moveSection(0, 2);
+    model.rangeCalls = 0;
+    delegate.texts.clear();
+    view.viewport()->repaint();
+    QCOMPARE(model.rangeCalls, 0);
+    verifyTexts();
+}
+
 void tst_QTableView::taskQTBUG_30653_doItemsLayout()
 {
     QWidget topLevel;
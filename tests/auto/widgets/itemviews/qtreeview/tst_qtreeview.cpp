@@ -136,6 +136,7 @@ private slots:
     void expandAndCollapse_data();
     void expandAndCollapse();
     void expandAndCollapseAll();
+    void expandWithExpandedDescendants();
     void expandWithNoChildren();
 #if QT_CONFIG(animation)
     void quickExpandCollapse();
@@ -1769,6 +1770,57 @@ void tst_QTreeView::expandAndCollapseAll()
     QCOMPARE(count, 13);
 }
 
+void tst_QTreeView::expandWithExpandedDescendants()
+{
+    QStandardItemModel model;
+    for (int i1 = 0; i1 < 3; ++i1) {
+        QStandardItem *s1 = new QStandardItem(QString::number(i1));
+        model.appendRow(s1);
+        for (int i2 = 0; i2 < 3; ++i2) {
+            QStandardItem *s2 = new QStandardItem(QStringLiteral("%1 - %2").arg(i1).arg(i2));
+            s1->appendRow(s2);
+            for (int i3 = 0; i3 < 3; ++i3)
+                s2->appendRow(new QStandardItem(QStringLiteral("%1 - %2 - %3").arg(i1).arg(i2).arg(i3)));
+        }
+    }
+    QTreeView view;
+    view.setModel(&model);
+    view.resize(300, 1200);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const auto visibleItems = [&view, &model]() {
+        QList<QPair<QModelIndex, QRect>> items;
+        for (QModelIndex index = model.index(0, 0); index.isValid(); index = view.indexBelow(index))
+            items.append({ index, view.visualRect(index) });
+        return items;
+    };
+
+    view.expandAll();
+    const auto expandedItems = visibleItems();
+    QCOMPARE(expandedItems.size(), 39);
+
+    // The children of the item in the middle stay expanded, so they are laid
+    // out again together with it, and the items after it have to follow
+    const QModelIndex middle = model.index(1, 0);
+    view.collapse(middle);
+    QCOMPARE(visibleItems().size(), 3 + 9 + 9);
+    view.expand(middle);
+    QCOMPARE(visibleItems(), expandedItems);
+    const QModelIndex lastOfMiddle = model.index(2, 0, model.index(2, 0, middle));
+    QCOMPARE(view.indexBelow(lastOfMiddle), model.index(2, 0));
+    QCOMPARE(view.indexAbove(model.index(2, 0)), lastOfMiddle);
+
+    view.expandToDepth(0);
+    QCOMPARE(visibleItems().size(), 3 + 9);
+    QVERIFY(view.isExpanded(middle));
+    QVERIFY(!view.isExpanded(model.index(0, 0, middle)));
+
+    view.collapseAll();
+    view.expandToDepth(1);
+    QCOMPARE(visibleItems(), expandedItems);
+}
+
 void tst_QTreeView::expandWithNoChildren()
 {
     QTreeView tree;
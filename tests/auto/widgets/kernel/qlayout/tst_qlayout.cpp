@@ -46,6 +46,7 @@ private slots:
     void adjustSizeShouldMakeSureLayoutIsActivated();
     void testRetainSizeWhenHidden();
     void removeWidget();
+    void layoutRequestsTopDown();
 };
 
 tst_QLayout::tst_QLayout()
@@ -397,5 +398,43 @@ void tst_QLayout::removeWidget()
     QVERIFY(!childLayout.isNull());
 }
 
+class LayoutRequestRecorder : public QObject
+{
+public:
+    QList<QObject *> receivers;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::LayoutRequest)
+            receivers.append(watched);
+        return false;
+    }
+};
+
+void tst_QLayout::layoutRequestsTopDown()
+{
+    QWidget outer;
+    QVBoxLayout *outerLayout = new QVBoxLayout(&outer);
+    QWidget *inner = new QWidget;
+    QVBoxLayout *innerLayout = new QVBoxLayout(inner);
+    innerLayout->addWidget(new QLabel("label"));
+    outerLayout->addWidget(inner);
+    outer.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&outer));
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+
+    LayoutRequestRecorder recorder;
+    outer.installEventFilter(&recorder);
+    inner->installEventFilter(&recorder);
+
+    // the parent's request is handled first, although it was posted last
+    innerLayout->invalidate();
+    outerLayout->invalidate();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::LayoutRequest);
+    QVERIFY(recorder.receivers.size() >= 2);
+    QCOMPARE(recorder.receivers.at(0), &outer);
+    QCOMPARE(recorder.receivers.at(1), inner);
+}
+
 QTEST_MAIN(tst_QLayout)
 #include "tst_qlayout.moc"
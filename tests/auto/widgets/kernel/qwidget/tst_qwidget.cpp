@@ -280,6 +280,7 @@ private slots:
     void clean_qt_x11_enforce_cursor();
 
     void childEvents();
+    void polishRequests();
     void render();
     void renderChildFillsBackground();
     void renderTargetOffset();
@@ -7816,6 +7817,36 @@ void tst_QWidget::childEvents()
     }
 }
 
+void tst_QWidget::polishRequests()
+{
+    QWidget widget;
+    QWidget *child = new QWidget(&widget);
+    QWidget *grandChild = new QWidget(child);
+    QWidget movedChild(&widget);
+    movedChild.setParent(nullptr);
+
+    EventRecorder spy;
+    child->installEventFilter(&spy);
+    grandChild->installEventFilter(&spy);
+    movedChild.installEventFilter(&spy);
+
+    // the children are polished along with their parent, only the widget
+    // that was moved away needs a request of its own
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::PolishRequest);
+    QVERIFY(child->testAttribute(Qt::WA_WState_Polished));
+    QVERIFY(grandChild->testAttribute(Qt::WA_WState_Polished));
+    QVERIFY(movedChild.testAttribute(Qt::WA_WState_Polished));
+
+    const EventRecorder::EventList expected = EventRecorder::EventList()
+            << qMakePair(child, QEvent::Polish)
+            << qMakePair(grandChild, QEvent::Polish)
+            << qMakePair(child, QEvent::ChildPolished)
+            << qMakePair(static_cast<QWidget *>(&movedChild), QEvent::PolishRequest)
+            << qMakePair(static_cast<QWidget *>(&movedChild), QEvent::Polish);
+    QVERIFY2(spy.eventList() == expected,
+             EventRecorder::msgEventListMismatch(expected, spy.eventList()).constData());
+}
+
 class RenderWidget : public QWidget
 {
 public:
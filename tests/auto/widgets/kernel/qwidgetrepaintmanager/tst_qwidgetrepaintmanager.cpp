@@ -260,6 +260,7 @@ private slots:
     void fastMove();
     void moveAccross();
     void moveInOutOverlapped();
+    void manyOverlappingSiblings();
 
 protected:
     /*
@@ -722,6 +723,46 @@ void tst_QWidgetRepaintManager::moveInOutOverlapped()
     QVERIFY(waitForFlush(&scene));
     QVERIFY(compareWidget(&scene));
 }
+
+/*!
+    Opaque siblings are subtracted from the dirty region of a widget in the
+    same way when the stacking order of the siblings is looked up only once
+    for all dirty widgets.
+*/
+void tst_QWidgetRepaintManager::manyOverlappingSiblings()
+{
+    QWidget parent;
+    parent.resize(300, 300);
+    QList<QWidget *> children;
+    for (int i = 0; i < 100; ++i) {
+        QWidget *child = (i % 7 == 3) ? new QWidget(&parent)
+                                      : new OpaqueWidget(Qt::green, &parent);
+        child->setGeometry((i % 10) * 25, (i / 10) * 25, 40, 40);
+        if (i % 11 == 5)
+            child->hide();
+        children << child;
+    }
+    parent.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&parent));
+
+    QWidgetPrivate::StackingOrderCache stackingOrderCache;
+    for (QWidget *child : std::as_const(children)) {
+        QRegion expected(child->rect());
+        bool expectedHasDirtySiblingsAbove = false;
+        QWidgetPrivate::get(child)->subtractOpaqueSiblings(expected, &expectedHasDirtySiblingsAbove);
+
+        QRegion actual(child->rect());
+        bool actualHasDirtySiblingsAbove = false;
+        QWidgetPrivate::get(child)->subtractOpaqueSiblings(actual, &actualHasDirtySiblingsAbove,
+                                                           false, &stackingOrderCache);
+        QCOMPARE(actual, expected);
+        QCOMPARE(actualHasDirtySiblingsAbove, expectedHasDirtySiblingsAbove);
+    }
+
+    for (QWidget *child : std::as_const(children))
+        child->update();
+    QVERIFY(compareWidget(&parent));
+}
 #endif //# defined(QT_BUILD_INTERNAL)
 
 QTEST_MAIN(tst_QWidgetRepaintManager)
@@ -64,6 +64,7 @@ private slots:
     void reparentWithNoChildStyleSheet();
     void reparentWithChildStyleSheet();
     void dynamicProperty();
+    void sharedStyleRules();
     // NB! Invoking this slot after layoutSpacing crashes on Mac.
     void namespaces();
 #ifdef Q_OS_MAC
@@ -649,6 +650,49 @@ void tst_QStyleSheetStyle::dynamicProperty()
     QVERIFY(COLOR(pb2) == Qt::blue);
 }
 
+void tst_QStyleSheetStyle::sharedStyleRules()
+{
+    // Widgets that only differ in what the selectors test must not share rules
+    qApp->setStyleSheet(QString());
+    QWidget parent;
+    parent.setStyleSheet("QLabel { color: red }"
+                         "QLabel[level=\"high\"] { color: green }"
+                         "QLabel#special { color: blue }"
+                         "QFrame QLabel { color: yellow }");
+    QLabel plain1(&parent);
+    QLabel plain2(&parent);
+    QLabel high(&parent);
+    high.setProperty("level", "high");
+    QLabel special(&parent);
+    special.setObjectName("special");
+    QFrame frame(&parent);
+    QLabel framed(&frame);
+
+    QCOMPARE(COLOR(plain1), QColor(Qt::red));
+    QCOMPARE(COLOR(plain2), QColor(Qt::red));
+    QCOMPARE(COLOR(high), QColor(Qt::green));
+    QCOMPARE(COLOR(special), QColor(Qt::blue));
+    QCOMPARE(COLOR(framed), QColor(Qt::yellow));
+
+    plain2.setProperty("level", "high");
+    plain2.style()->unpolish(&plain2);
+    plain2.style()->polish(&plain2);
+    QCOMPARE(COLOR(plain2), QColor(Qt::green));
+
+    // A different style sheet with otherwise identical widgets
+    QWidget otherParent;
+    otherParent.setStyleSheet("QLabel { color: white }");
+    QLabel other(&otherParent);
+    QCOMPARE(COLOR(other), QColor(Qt::white));
+
+    // The application style sheet is not part of what is compared
+    qApp->setStyleSheet("QLabel { background: white }");
+    QLabel plain3(&parent);
+    QCOMPARE(COLOR(plain3), QColor(Qt::red));
+    QCOMPARE(BACKGROUND(plain3), QColor(Qt::white));
+    qApp->setStyleSheet(QString());
+}
+
 #ifdef Q_OS_MAC
 void tst_QStyleSheetStyle::layoutSpacing()
 {
@@ -106,6 +106,7 @@ private slots:
     void DTDInternalSubset_data() const;
     void QTBUG49113_dontCrashWithNegativeIndex() const;
     void standalone();
+    void sharedNames() const;
 
     void cleanupTestCase() const;
 
@@ -2315,5 +2316,39 @@ void tst_QDom::DTDInternalSubset_data() const
        << internalSubset0;
 }
 
+void tst_QDom::sharedNames() const
+{
+    // equal names and values are shared between nodes while parsing;
+    // modifying one node must not affect the others
+    const QString xml = u"<r xmlns:p='urn:p'>"
+                        u"<p:e p:a='v' b='v'/><p:e p:a='v' b='v'/><e b='v'/>"
+                        u"</r>"_s;
+    QDomDocument doc;
+    QVERIFY(doc.setContent(xml, QDomDocument::ParseOption::UseNamespaceProcessing));
+
+    const QDomNodeList elements = doc.documentElement().childNodes();
+    QCOMPARE(elements.size(), 3);
+    for (int i = 0; i < 2; ++i) {
+        const QDomElement e = elements.at(i).toElement();
+        QCOMPARE(e.localName(), "e");
+        QCOMPARE(e.prefix(), "p");
+        QCOMPARE(e.namespaceURI(), "urn:p");
+        QCOMPARE(e.attributeNS(u"urn:p"_s, u"a"_s), "v");
+        QCOMPARE(e.attributeNode(u"a"_s).prefix(), "p");
+        QCOMPARE(e.attribute(u"b"_s), "v");
+    }
+    QCOMPARE(elements.at(2).toElement().namespaceURI(), QString());
+
+    QDomElement first = elements.at(0).toElement();
+    first.setPrefix(u"q"_s);
+    first.setAttribute(u"b"_s, u"w"_s);
+    first.setTagName(u"f"_s);
+    const QDomElement second = elements.at(1).toElement();
+    QCOMPARE(second.prefix(), "p");
+    QCOMPARE(second.localName(), "e");
+    QCOMPARE(second.attribute(u"b"_s), "v");
+    QCOMPARE(elements.at(2).toElement().attribute(u"b"_s), "v");
+}
+
 QTEST_MAIN(tst_QDom)
 #include "tst_qdom.moc"
@@ -31,6 +31,8 @@ class tst_QSortFilterProxyModel : public QObject
 private slots:
     void clearFilter_data();
     void clearFilter();
+    void filterAndSort_data();
+    void filterAndSort();
     void setSourceModel();
 
 private:
@@ -94,6 +96,38 @@ void tst_QSortFilterProxyModel::clearFilter()
     QCOMPARE(proxy.rowCount(), itemCount);
 }
 
+void tst_QSortFilterProxyModel::filterAndSort_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("concurrent");
+
+    for (int thousandItemCount : { 100, 1000 }) {
+        for (bool concurrent : { false, true }) {
+            QTest::addRow("%dK%s", thousandItemCount, concurrent ? " concurrently" : "")
+                    << thousandItemCount * 1000 << concurrent;
+        }
+    }
+}
+
+void tst_QSortFilterProxyModel::filterAndSort()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, concurrent);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setConcurrentSortFilter(concurrent);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    QBENCHMARK_ONCE {
+        proxy.setFilterRegularExpression(QStringLiteral("[13579]$"));
+        proxy.sort(0, Qt::DescendingOrder);
+    }
+    QCOMPARE(proxy.rowCount(), itemCount / 2);
+}
+
 void tst_QSortFilterProxyModel::setSourceModel()
 {
     QStringListModel model1;
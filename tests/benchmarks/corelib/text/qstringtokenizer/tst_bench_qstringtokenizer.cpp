@@ -21,6 +21,8 @@ private slots:
     void tokenize_qlatin1string_qstring() const { tokenize<QLatin1String, QString>(); }
     void tokenize_qstring_qlatin1string_data() const { tokenize_data(); }
     void tokenize_qstring_qlatin1string() const { tokenize<QString, QLatin1String>(); }
+    void tokenize_qstring_qchar_data() const { tokenize_data(); }
+    void tokenize_qstring_qchar() const { tokenize<QString, QChar>(); }
 };
 
 template<typename T>
@@ -38,6 +40,12 @@ QLatin1String fromByteArray<QLatin1String>(QByteArrayView v)
     return QLatin1String(v.data(), v.size());
 }
 
+template<>
+QChar fromByteArray<QChar>(QByteArrayView v)
+{
+    return QLatin1Char(v.front());
+}
+
 void tst_QStringTokenizer::tokenize_data() const
 {
     QTest::addColumn<QByteArray>("input");
@@ -50,6 +58,12 @@ void tst_QStringTokenizer::tokenize_data() const
     QTest::addRow("short-sentence-spaces-case-insensitive")
             << shortSentence << QByteArray(" ") << false << 4;
 
+    QByteArray csv;
+    for (int i = 0; i < 1000; ++i)
+        csv += QByteArray::number(i) + ",field" + QByteArray::number(i % 7) + ",,\"quoted\"," + QByteArray::number(i * 0.25) + "\n";
+    QTest::addRow("csv-commas") << csv << QByteArray(",") << true << 4001;
+    QTest::addRow("csv-commas-case-insensitive") << csv << QByteArray(",") << false << 4001;
+
     QTest::addRow("short-sentence-se") << shortSentence << QByteArray("se") << true << 3;
     QTest::addRow("short-sentence-se-case-insensitive")
             << shortSentence << QByteArray("Se") << false << 3;
@@ -100,6 +114,11 @@ void tst_QStringTokenizer::tokenize() const
     QFETCH(bool, caseSensitive);
     QFETCH(int, expectedCount);
 
+    if constexpr (std::is_same_v<U, QChar>) {
+        if (separator.size() != 1)
+            QSKIP("The separator is not a single character");
+    }
+
     T haystack = fromByteArray<T>(input);
     U needle = fromByteArray<U>(separator);
 
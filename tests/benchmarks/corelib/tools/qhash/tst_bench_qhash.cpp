@@ -4,6 +4,7 @@
 
 #include "tst_bench_qhash.h"
 
+#include <QDenseHash>
 #include <QFile>
 #include <QHash>
 #include <QString>
@@ -11,6 +12,10 @@
 #include <QUuid>
 #include <QTest>
 
+struct IntValue
+{
+    int a, b, c, d;
+};
 
 class tst_QHash : public QObject
 {
@@ -36,10 +41,17 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_int_data() { intData(); }
+    void lookup_int() { lookup_int_template<QHash<int, IntValue>>(); }
+    void lookup_int_dense_data() { intData(); }
+    void lookup_int_dense() { lookup_int_template<QDenseHash<int, IntValue>>(); }
+
 private:
     void data();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    void intData();
+    template <typename Hash> void lookup_int_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -144,6 +156,30 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::intData()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("1000000") << 1000000;
+}
+
+template <typename Hash> void tst_QHash::lookup_int_template()
+{
+    // an integer to struct map, half of the lookups miss
+    QFETCH(int, size);
+    Hash hash;
+    for (int i = 0; i < size; ++i)
+        hash.insert(i * 2, IntValue{ i, i, i, i });
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 2 * size; ++i)
+            sum += hash.value(i).a;
+    }
+    QVERIFY(sum != 0 || size == 0);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
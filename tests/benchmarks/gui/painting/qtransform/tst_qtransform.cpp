@@ -65,6 +65,10 @@ private slots:
     void mapToPolygon();
     void mapQPainterPath_data();
     void mapQPainterPath();
+    void mapLargeQPolygonF_data();
+    void mapLargeQPolygonF();
+    void mapLargeQPainterPath_data();
+    void mapLargeQPainterPath();
     void isIdentity_data();
     void isIdentity();
     void isAffine_data();
@@ -433,6 +437,34 @@ void tst_QTransform::mapQPainterPath()
     }
 }
 
+SINGLE_DATA_IMPLEMENTATION(mapLargeQPolygonF)
+
+void tst_QTransform::mapLargeQPolygonF()
+{
+    QFETCH(QTransform, transform);
+    QTransform x = transform;
+    QPolygonF poly;
+    for (int i = 0; i < 10000; ++i)
+        poly << QPointF(i % 100, i / 100);
+    QBENCHMARK {
+        [[maybe_unused]] auto r = x.map(poly);
+    }
+}
+
+SINGLE_DATA_IMPLEMENTATION(mapLargeQPainterPath)
+
+void tst_QTransform::mapLargeQPainterPath()
+{
+    QFETCH(QTransform, transform);
+    QTransform x = transform;
+    QPainterPath path;
+    for (int i = 0; i < 1000; ++i)
+        path.addEllipse(i % 100, i / 10, 100, 100);
+    QBENCHMARK {
+        [[maybe_unused]] auto r = x.map(path);
+    }
+}
+
 SINGLE_DATA_IMPLEMENTATION(isIdentity)
 
 void tst_QTransform::isIdentity()
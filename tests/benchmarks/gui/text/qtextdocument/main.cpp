@@ -5,12 +5,16 @@
 #include <QTextDocument>
 #include <qtest.h>
 
+#include <private/qtextdocumentlayout_p.h>
+
 class tst_QTextDocument : public QObject
 {
     Q_OBJECT
 private slots:
     void mightBeRichText_data();
     void mightBeRichText();
+    void lazyLayout_data();
+    void lazyLayout();
 };
 
 void tst_QTextDocument::mightBeRichText_data()
@@ -41,6 +45,36 @@ void tst_QTextDocument::mightBeRichText()
     }
 }
 
+void tst_QTextDocument::lazyLayout_data()
+{
+    QTest::addColumn<bool>("toEnd");
+    QTest::newRow("first-screen") << false;
+    QTest::newRow("whole-document") << true;
+}
+
+// Lays out a large plain text document, like a log file, either as far as
+// a view showing its first screen needs, or completely.
+void tst_QTextDocument::lazyLayout()
+{
+    QFETCH(bool, toEnd);
+    QString text;
+    for (int i = 0; i < 50000; ++i) {
+        text += QLatin1StringView("2023-08-01 12:00:00.000 [info] Message number ")
+                + QString::number(i) + QLatin1StringView(" from the worker thread\n");
+    }
+
+    QBENCHMARK {
+        QTextDocument document;
+        document.setPageSize(QSizeF(600, -1));
+        auto *layout = static_cast<QTextDocumentLayout *>(document.documentLayout());
+        document.setPlainText(text);
+        if (toEnd)
+            layout->documentSize();
+        else
+            layout->ensureLayouted(800);
+    }
+}
+
 QTEST_MAIN(tst_QTextDocument)
 
 #include "main.moc"
@@ -0,0 +1,316 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+// Load tests of QNetworkAccessManager against local HTTP/1.1 and HTTP/2
+// servers, running in a thread of their own: many requests are kept in
+// flight at a given concurrency, to measure the throughput and the latency
+// as seen by an application, not those of a single request.
+//
+// requests() reports the time taken by a batch of RequestsPerBatch requests,
+// so the number of requests per second is RequestsPerBatch divided by it.
+// Run it with -allocationcounter to get the allocations and the bytes
+// allocated per batch instead, which includes the copies of the data.
+// latency() reports the 99th percentile of the time from get() until the
+// reply finished.
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qtimer.h>
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qhttp2configuration.h>
+#include <QtNetwork/qnetworkaccessmanager.h>
+#include <QtNetwork/qnetworkreply.h>
+#include <QtNetwork/qnetworkrequest.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+
+#include "../../../../auto/network/access/http2/http2srv.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+using namespace Qt::StringLiterals;
+using namespace std::chrono_literals;
+
+enum class Protocol {
+    Http1,
+    Http2
+};
+
+static constexpr int RequestsPerBatch = 200;
+static constexpr int LatencySamples = 1000;
+
+// Answers every GET request on any number of keep-alive connections with the
+// same response.
+class Http1Server : public QTcpServer
+{
+    Q_OBJECT
+public:
+    explicit Http1Server(const QByteArray &body)
+        : response("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: application/octet-stream\r\n"
+                   "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                   "\r\n" + body)
+    {
+    }
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        auto socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(socketDescriptor);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] {
+            QByteArray &pending = requests[socket];
+            pending += socket->readAll();
+            // the requests have no body
+            qsizetype end;
+            while ((end = pending.indexOf("\r\n\r\n")) >= 0) {
+                pending.remove(0, end + 4);
+                socket->write(response);
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+            requests.remove(socket);
+            socket->deleteLater();
+        });
+    }
+
+private:
+    const QByteArray response;
+    QHash<QTcpSocket *, QByteArray> requests;
+};
+
+// The servers work in the worker thread, so they are deleted from there
+struct ServerDeleter
+{
+    void operator()(QTcpServer *server) const
+    {
+        if (auto http2Server = qobject_cast<Http2Server *>(server))
+            http2Server->stopSendingDATAFrames();
+        QMetaObject::invokeMethod(server, &QObject::deleteLater, Qt::QueuedConnection);
+    }
+};
+using ServerPtr = std::unique_ptr<QTcpServer, ServerDeleter>;
+
+class tst_QNetworkAccessManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void requests_data();
+    void requests();
+    void latency_data();
+    void latency();
+
+private:
+    void startServer();
+    void runLoad(int requestCount, int concurrency, QList<qint64> *latencies = nullptr);
+
+    QThread workerThread;
+    ServerPtr server;
+    std::unique_ptr<QNetworkAccessManager> manager;
+    QNetworkRequest request;
+};
+
+static QHttp2Configuration http2Configuration()
+{
+    QHttp2Configuration config;
+    config.setStreamReceiveWindowSize(Http2::qtDefaultStreamReceiveWindowSize);
+    config.setSessionReceiveWindowSize(Http2::maxSessionReceiveWindowSize);
+    config.setServerPushEnabled(false);
+    return config;
+}
+
+// What the HTTP/2 server expects the client to send
+static RawSettings clientSettings(const QHttp2Configuration &config)
+{
+    RawSettings settings;
+    settings[Http2::Settings::ENABLE_PUSH_ID] = config.serverPushEnabled();
+    settings[Http2::Settings::INITIAL_WINDOW_SIZE_ID] = config.streamReceiveWindowSize();
+    if (config.maxFrameSize() != Http2::minPayloadLimit)
+        settings[Http2::Settings::MAX_FRAME_SIZE_ID] = config.maxFrameSize();
+    return settings;
+}
+
+void tst_QNetworkAccessManager::initTestCase()
+{
+    workerThread.start();
+}
+
+void tst_QNetworkAccessManager::cleanupTestCase()
+{
+    workerThread.quit();
+    workerThread.wait();
+}
+
+void tst_QNetworkAccessManager::init()
+{
+    manager = std::make_unique<QNetworkAccessManager>();
+}
+
+void tst_QNetworkAccessManager::cleanup()
+{
+    manager.reset();
+    server.reset();
+}
+
+// Starts the server for the current data row and prepares the request
+void tst_QNetworkAccessManager::startServer()
+{
+    QFETCH(const Protocol, protocol);
+    QFETCH(const int, concurrency);
+    QFETCH(const int, bodySize);
+    const QByteArray body(bodySize, 'x');
+
+    quint16 port = 0;
+    if (protocol == Protocol::Http1) {
+        auto http1Server = new Http1Server(body);
+        server.reset(http1Server);
+        http1Server->moveToThread(&workerThread);
+        QMetaObject::invokeMethod(http1Server, [http1Server, &port] {
+            if (http1Server->listen(QHostAddress::LocalHost))
+                port = http1Server->serverPort();
+        }, Qt::BlockingQueuedConnection);
+    } else {
+        const RawSettings serverSettings = {
+            { Http2::Settings::MAX_CONCURRENT_STREAMS_ID, 100 }
+        };
+        auto http2Server = new Http2Server(H2Type::h2cDirect, serverSettings,
+                                           clientSettings(http2Configuration()));
+        server.reset(http2Server);
+        http2Server->setResponseBody(body);
+        connect(http2Server, &Http2Server::receivedRequest, http2Server,
+                [http2Server](quint32 streamID) {
+            http2Server->sendResponse(streamID, false);
+        });
+        http2Server->moveToThread(&workerThread);
+
+        QSignalSpy started(http2Server, &Http2Server::serverStarted);
+        QMetaObject::invokeMethod(http2Server, &Http2Server::startServer, Qt::QueuedConnection);
+        QVERIFY(started.wait());
+        port = started.constFirst().constFirst().value<quint16>();
+    }
+    QVERIFY(port != 0);
+
+    request = QNetworkRequest(QUrl(u"http://127.0.0.1:%1/index.html"_s.arg(port)));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, protocol == Protocol::Http2);
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, protocol == Protocol::Http2);
+    request.setAttribute(QNetworkRequest::Http2CleartextAllowedAttribute,
+                         protocol == Protocol::Http2);
+    request.setHttp2Configuration(http2Configuration());
+
+    // Open the connections before measuring
+    runLoad(concurrency, concurrency);
+}
+
+// Sends requestCount requests, keeping up to concurrency of them in flight
+void tst_QNetworkAccessManager::runLoad(int requestCount, int concurrency,
+                                        QList<qint64> *latencies)
+{
+    QEventLoop loop;
+    int started = 0;
+    int finished = 0;
+    bool failed = false;
+
+    std::function<void()> startRequest = [&] {
+        QElapsedTimer timer;
+        timer.start();
+        QNetworkReply *reply = manager->get(request);
+        ++started;
+        connect(reply, &QNetworkReply::finished, &loop, [&, reply, timer] {
+            if (latencies)
+                latencies->append(timer.nsecsElapsed());
+            reply->readAll();
+            if (reply->error() != QNetworkReply::NoError)
+                failed = true;
+            reply->deleteLater();
+
+            if (++finished == requestCount || failed)
+                loop.quit();
+            else if (started < requestCount)
+                startRequest();
+        });
+    };
+
+    for (int i = 0; i < qMin(requestCount, concurrency); ++i)
+        startRequest();
+    QTimer::singleShot(60s, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    QVERIFY(!failed);
+    QCOMPARE(finished, requestCount);
+}
+
+static void addRows()
+{
+    QTest::addColumn<Protocol>("protocol");
+    QTest::addColumn<int>("concurrency");
+    QTest::addColumn<int>("bodySize");
+
+    // QNetworkAccessManager uses up to six HTTP/1.1 connections per host,
+    // and multiplexes all requests over one HTTP/2 connection
+    QTest::newRow("http1-1-4KiB") << Protocol::Http1 << 1 << 4096;
+    QTest::newRow("http1-6-4KiB") << Protocol::Http1 << 6 << 4096;
+    QTest::newRow("http1-32-4KiB") << Protocol::Http1 << 32 << 4096;
+    QTest::newRow("http1-6-1MiB") << Protocol::Http1 << 6 << 1024 * 1024;
+    QTest::newRow("http2-1-4KiB") << Protocol::Http2 << 1 << 4096;
+    QTest::newRow("http2-32-4KiB") << Protocol::Http2 << 32 << 4096;
+    QTest::newRow("http2-100-4KiB") << Protocol::Http2 << 100 << 4096;
+    QTest::newRow("http2-32-1MiB") << Protocol::Http2 << 32 << 1024 * 1024;
+}
+
+void tst_QNetworkAccessManager::requests_data()
+{
+    addRows();
+}
+
+void tst_QNetworkAccessManager::requests()
+{
+    QFETCH(const int, concurrency);
+    startServer();
+    if (QTest::currentTestFailed())
+        return;
+
+    QBENCHMARK {
+        runLoad(RequestsPerBatch, concurrency);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_QNetworkAccessManager::latency_data()
+{
+    addRows();
+}
+
+void tst_QNetworkAccessManager::latency()
+{
+    QFETCH(const int, concurrency);
+    startServer();
+    if (QTest::currentTestFailed())
+        return;
+
+    QList<qint64> latencies;
+    latencies.reserve(LatencySamples);
+    runLoad(LatencySamples, concurrency, &latencies);
+    if (QTest::currentTestFailed())
+        return;
+
+    std::sort(latencies.begin(), latencies.end());
+    const qint64 p99 = latencies.at(latencies.size() * 99 / 100);
+    QTest::setBenchmarkResult(p99, QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(tst_QNetworkAccessManager)
+
+#include "tst_bench_qnetworkaccessmanager.moc"
@@ -22,6 +22,8 @@ private slots:
     void benchFieldName();
     void benchFieldIndex_data() { generic_data("QPSQL"); }
     void benchFieldIndex();
+    void benchIndexOf_data();
+    void benchIndexOf();
 
 private:
     void generic_data(const QString &engine = QString());
@@ -107,4 +109,27 @@ void tst_QSqlRecord::benchFieldIndex()
     }
 }
 
+void tst_QSqlRecord::benchIndexOf_data()
+{
+    QTest::addColumn<int>("fieldCount");
+    QTest::newRow("4 fields") << 4;
+    QTest::newRow("16 fields") << 16;
+    QTest::newRow("64 fields") << 64;
+}
+
+void tst_QSqlRecord::benchIndexOf()
+{
+    QFETCH(int, fieldCount);
+    QSqlRecord record;
+    QStringList names;
+    for (int i = 0; i < fieldCount; ++i) {
+        names.append(QString("column_%1").arg(i));
+        record.append(QSqlField(names.last().toUpper(), QMetaType(QMetaType::Int)));
+    }
+    QBENCHMARK {
+        for (const QString &name : std::as_const(names))
+            record.indexOf(name);
+    }
+}
+
 #include "tst_bench_qsqlrecord.moc"
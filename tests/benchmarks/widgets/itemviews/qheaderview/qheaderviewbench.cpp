@@ -32,6 +32,7 @@ private slots:
     void cleanup();
     void visualIndexAtSpecial_data()   {setupTestData();}
     void visualIndexAt_data()          {setupTestData();}
+    void resizeSectionBench_data()     {setupTestData();}
     void hideShowBench_data()          {setupTestData();}
     void swapSectionsBench_data()      {setupTestData();}
     void moveSectionBench_data()       {setupTestData();}
@@ -42,6 +43,7 @@ private slots:
 
     void visualIndexAtSpecial();
     void visualIndexAt();
+    void resizeSectionBench();
     void hideShowBench();
     void swapSectionsBench();
     void moveSectionBench();
@@ -141,6 +143,22 @@ void BenchQHeaderView::visualIndexAt()
     }
 }
 
+void BenchQHeaderView::resizeSectionBench()
+{
+    // Like resizing sections to their contents while scrolling: each
+    // resize is followed by lookups in front of and behind the section.
+    const int center = m_hv->count() / 2;
+    int testnum = 0;
+
+    QBENCHMARK {
+        ++testnum;
+        const int section = center + testnum % 50;
+        m_hv->resizeSection(section, 20 + testnum % 10);
+        m_hv->visualIndexAt(m_hv->sectionPosition(section));
+        m_hv->visualIndexAt(m_hv->length() - 1);
+    }
+}
+
 void BenchQHeaderView::hideShowBench()
 {
     int n = 0;
@@ -3,6 +3,7 @@
 
 #include <qtest.h>
 
+#include <QtWidgets/QBoxLayout>
 #include <QtWidgets/QLayout>
 #include <QtGui/QPainter>
 
@@ -89,6 +90,10 @@ private slots:
     void updatePartial();
     void updateComplex_data();
     void updateComplex();
+    void construct_data();
+    void construct();
+    void constructAndShow_data();
+    void constructAndShow();
 
 private:
     UpdateWidget widget;
@@ -213,6 +218,48 @@ void tst_QWidget::updateComplex()
     }
 }
 
+void tst_QWidget::construct_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void tst_QWidget::construct()
+{
+    QFETCH(int, count);
+
+    // the children are polished and destroyed along with their parent,
+    // without being shown
+    QBENCHMARK {
+        QWidget parent;
+        for (int i = 0; i < count; ++i)
+            new QWidget(&parent);
+        QApplication::processEvents();
+    }
+}
+
+void tst_QWidget::constructAndShow_data()
+{
+    construct_data();
+}
+
+void tst_QWidget::constructAndShow()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        QWidget parent;
+        QVBoxLayout *layout = new QVBoxLayout(&parent);
+        for (int i = 0; i < count; ++i)
+            layout->addWidget(new QWidget(&parent));
+        parent.show();
+        QApplication::processEvents();
+    }
+}
+
 QTEST_MAIN(tst_QWidget)
 
 #include "tst_qwidget.moc"